@@ -47,4 +47,3 @@ if(KWIVER_ENABLE_ARROWS)
 endif()
 
 include( kwiver-depends-ZeroMQ )
-include( kwiver-depends-OpenMP )
@@ -8,6 +8,7 @@
 #include "bundle_adjust.h"
 
 #include <vital/io/eigen_io.h>
+#include <vital/util/trace.h>
 #include <vital/vital_config.h>
 
 #include <arrows/ceres/options.h>
@@ -287,6 +288,8 @@ ::optimize( kwiver::vital::simple_camera_perspective_map& cameras,
             const std::set< vital::landmark_id_t >& to_fix_landmarks_in,
             kwiver::vital::sfm_constraints_sptr constraints ) const
 {
+  KWIVER_TRACE_SCOPE( "ceres::bundle_adjust" );
+
   if( !tracks )
   {
     // TODO throw an exception for missing input data
@@ -426,7 +429,8 @@ ::optimize( kwiver::vital::simple_camera_perspective_map& cameras,
 
       vector_2d pt = fts->feature->loc();
       problem.AddResidualBlock( create_cost_func( d_->lens_distortion_type,
-                                                  pt.x(), pt.y() ),
+                                                  pt.x(), pt.y(),
+                                                  d_->analytic_jacobians ),
                                 loss_func,
                                 intr_params_ptr,
                                 &cam_itr->second[ 0 ],
@@ -594,7 +598,14 @@ ::optimize( kwiver::vital::simple_camera_perspective_map& cameras,
   }
 
   ::ceres::Solver::Summary summary;
-  ::ceres::Solve( d_->options, &problem, &summary );
+  {
+    KWIVER_TRACE_SCOPE( "ceres::bundle_adjust::solve" );
+    ::ceres::Solve( d_->tuned_options( d_->camera_params.size(),
+                                       d_->landmark_params.size(),
+                                       problem.NumResiduals() ),
+                    &problem, &summary );
+  }
+  d_->report_timing( logger(), summary );
   if( d_->log_full_report )
   {
     LOG_DEBUG( logger(), "Ceres Full Report:\n" << summary.FullReport() );
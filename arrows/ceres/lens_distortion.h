@@ -20,6 +20,47 @@ namespace arrows {
 
 namespace ceres {
 
+/// Class to hold the identity distortion function and traits
+class distortion_none
+{
+public:
+  // the number of distortion coefficients
+  static const int num_coeffs = 0;
+
+  /// Function to apply no distortion
+  /// \param [in] dist_coeffs: unused
+  /// \param [in] source_xy: 2D point in normalized image coordinates
+  /// \param [out] distorted_xy: copy of \p source_xy
+  template < typename T >
+
+  static void
+  apply( VITAL_UNUSED const T* dist_coeffs,
+         const T* source_xy,
+         T* distorted_xy )
+  {
+    distorted_xy[ 0 ] = source_xy[ 0 ];
+    distorted_xy[ 1 ] = source_xy[ 1 ];
+  }
+
+  /// Function to compute the Jacobians of the distortion
+  /// \param [in] dist_coeffs: unused
+  /// \param [in] source_xy: unused
+  /// \param [out] d_source: 2x2 row-major Jacobian with respect to
+  /// \p source_xy
+  /// \param [out] d_coeffs: unused
+  static void
+  jacobians( VITAL_UNUSED const double* dist_coeffs,
+             VITAL_UNUSED const double* source_xy,
+             double* d_source,
+             VITAL_UNUSED double* d_coeffs )
+  {
+    d_source[ 0 ] = 1.0;
+    d_source[ 1 ] = 0.0;
+    d_source[ 2 ] = 0.0;
+    d_source[ 3 ] = 1.0;
+  }
+};
+
 /// Class to hold to distortion function and traits
 class distortion_poly_radial
 {
@@ -52,6 +93,41 @@ class distortion_poly_radial
     distorted_xy[ 0 ] = x * scale;
     distorted_xy[ 1 ] = y * scale;
   }
+
+  /// Function to compute the Jacobians of the distortion
+  /// \param [in] dist_coeffs: radial distortion coefficients (2)
+  /// \param [in] source_xy: 2D point in normalized image coordinates
+  /// \param [out] d_source: 2x2 row-major Jacobian with respect to
+  /// \p source_xy
+  /// \param [out] d_coeffs: 2x2 row-major Jacobian with respect to
+  /// \p dist_coeffs
+  static void
+  jacobians( const double* dist_coeffs,
+             const double* source_xy,
+             double* d_source,
+             double* d_coeffs )
+  {
+    const double x = source_xy[ 0 ];
+    const double y = source_xy[ 1 ];
+    const double k1 = dist_coeffs[ 0 ];
+    const double k2 = dist_coeffs[ 1 ];
+
+    const double r2 = x * x + y * y;
+    const double r4 = r2 * r2;
+    const double scale = 1.0 + k1 * r2 + k2 * r4;
+    // derivative of the scale with respect to r2, times 2
+    const double dscale = 2.0 * ( k1 + 2.0 * k2 * r2 );
+
+    d_source[ 0 ] = scale + x * x * dscale;
+    d_source[ 1 ] = x * y * dscale;
+    d_source[ 2 ] = d_source[ 1 ];
+    d_source[ 3 ] = scale + y * y * dscale;
+
+    d_coeffs[ 0 ] = x * r2;
+    d_coeffs[ 1 ] = x * r4;
+    d_coeffs[ 2 ] = y * r2;
+    d_coeffs[ 3 ] = y * r4;
+  }
 };
 
 /// Class to hold to distortion function and traits
@@ -96,6 +172,55 @@ class distortion_poly_radial_tangential
     distorted_xy[ 1 ] = y * scale + T( 2 ) * p2 * xy + p1 *
                         ( r2 + T( 2 ) * y2 );
   }
+
+  /// Function to compute the Jacobians of the distortion
+  /// \param [in] dist_coeffs: radial (3) and tangential (2) distortion
+  ///                            coefficients
+  /// \param [in] source_xy: 2D point in normalized image coordinates
+  /// \param [out] d_source: 2x2 row-major Jacobian with respect to
+  /// \p source_xy
+  /// \param [out] d_coeffs: 2x5 row-major Jacobian with respect to
+  /// \p dist_coeffs
+  static void
+  jacobians( const double* dist_coeffs,
+             const double* source_xy,
+             double* d_source,
+             double* d_coeffs )
+  {
+    const double x = source_xy[ 0 ];
+    const double y = source_xy[ 1 ];
+    const double k1 = dist_coeffs[ 0 ];
+    const double k2 = dist_coeffs[ 1 ];
+    const double p1 = dist_coeffs[ 2 ];
+    const double p2 = dist_coeffs[ 3 ];
+    const double k3 = dist_coeffs[ 4 ];
+
+    const double x2 = x * x;
+    const double y2 = y * y;
+    const double xy = x * y;
+    const double r2 = x2 + y2;
+    const double r4 = r2 * r2;
+    const double r6 = r4 * r2;
+    const double scale = 1.0 + k1 * r2 + k2 * r4 + k3 * r6;
+    // derivative of the scale with respect to r2, times 2
+    const double dscale = 2.0 * ( k1 + 2.0 * k2 * r2 + 3.0 * k3 * r4 );
+
+    d_source[ 0 ] = scale + x2 * dscale + 2.0 * p1 * y + 6.0 * p2 * x;
+    d_source[ 1 ] = xy * dscale + 2.0 * p1 * x + 2.0 * p2 * y;
+    d_source[ 2 ] = d_source[ 1 ];
+    d_source[ 3 ] = scale + y2 * dscale + 2.0 * p2 * x + 6.0 * p1 * y;
+
+    d_coeffs[ 0 ] = x * r2;
+    d_coeffs[ 1 ] = x * r4;
+    d_coeffs[ 2 ] = 2.0 * xy;
+    d_coeffs[ 3 ] = r2 + 2.0 * x2;
+    d_coeffs[ 4 ] = x * r6;
+    d_coeffs[ 5 ] = y * r2;
+    d_coeffs[ 6 ] = y * r4;
+    d_coeffs[ 7 ] = r2 + 2.0 * y2;
+    d_coeffs[ 8 ] = 2.0 * xy;
+    d_coeffs[ 9 ] = y * r6;
+  }
 };
 
 /// Class to hold to distortion function and traits
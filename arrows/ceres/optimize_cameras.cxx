@@ -216,7 +216,8 @@ ::optimize(vital::camera_map_sptr & cameras,
       }
       vector_2d pt = fts->feature->loc();
       problem.AddResidualBlock(create_cost_func(d_->lens_distortion_type,
-                                                pt.x(), pt.y()),
+                                                pt.x(), pt.y(),
+                                                d_->analytic_jacobians),
                                loss_func,
                                intr_params_ptr,
                                &cam_itr->second[0],
@@ -278,7 +279,10 @@ ::optimize(vital::camera_map_sptr & cameras,
   }
 
   ::ceres::Solver::Summary summary;
-  ::ceres::Solve(d_->options, &problem, &summary);
+  ::ceres::Solve(d_->tuned_options(camera_params.size(), 0,
+                                   problem.NumResiduals()),
+                 &problem, &summary);
+  d_->report_timing(logger(), summary);
   if( d_->verbose )
   {
     LOG_DEBUG(logger(), "Ceres Full Report:\n" << summary.FullReport());
@@ -331,7 +335,8 @@ ::optimize(vital::camera_perspective_sptr& camera,
   {
     vector_2d pt = features[i]->loc();
     problem.AddResidualBlock(create_cost_func(d_->lens_distortion_type,
-                                              pt.x(), pt.y()),
+                                              pt.x(), pt.y(),
+                                              d_->analytic_jacobians),
                              loss_func,
                              &cam_intrinsic_params[0],
                              &cam_extrinsic_params[0],
@@ -361,7 +366,10 @@ ::optimize(vital::camera_perspective_sptr& camera,
   }
 
   ::ceres::Solver::Summary summary;
-  ::ceres::Solve(d_->options, &problem, &summary);
+  ::ceres::Solve(d_->tuned_options(1, 0,
+                                   problem.NumResiduals()),
+                 &problem, &summary);
+  d_->report_timing(logger(), summary);
   if( d_->verbose )
   {
     LOG_DEBUG(logger(), "Ceres Full Report:\n" << summary.FullReport());
@@ -14,15 +14,35 @@
 
 #include <vital/math_constants.h>
 
+#include <algorithm>
+#include <thread>
+
 using namespace kwiver::vital;
 using namespace kwiver::arrows::mvg;
 
+#if CERES_VERSION_MAJOR > 2 || \
+    ( CERES_VERSION_MAJOR == 2 && CERES_VERSION_MINOR >= 1 )
+#define KWIVER_CERES_HAS_CUDA
+#endif
+
 namespace kwiver {
 
 namespace arrows {
 
 namespace ceres {
 
+namespace {
+
+// Largest problems, in cameras, for which auto tuning picks each Schur solver
+constexpr size_t max_dense_schur_cameras = 200;
+constexpr size_t max_cuda_dense_schur_cameras = 1000;
+constexpr size_t max_sparse_schur_cameras = 5000;
+
+// Fewest residuals per thread for which auto tuning adds threads
+constexpr int min_residuals_per_thread = 1000;
+
+} // namespace <anonymous>
+
 void
 solver_options
 ::get_configuration( config_block_sptr config ) const
@@ -30,8 +50,10 @@ ::get_configuration( config_block_sptr config ) const
   ::ceres::Solver::Options const& o = this->options;
   config->set_value( "num_threads", o.num_threads,
                      "Number of threads to use" );
+#if CERES_VERSION_MAJOR < 2
   config->set_value( "num_linear_solver_threads", o.num_linear_solver_threads,
                      "Number of threads to use in the linear solver" );
+#endif
   config->set_value( "max_num_iterations", o.max_num_iterations,
                      "Maximum number of iteration of allow" );
   config->set_value( "function_tolerance", o.function_tolerance,
@@ -49,6 +71,27 @@ ::get_configuration( config_block_sptr config ) const
   config->set_value( "preconditioner_type", o.preconditioner_type,
                      "Preconditioner to use." +
                      ceres_options< ::ceres::PreconditionerType >() );
+  config->set_value( "dense_linear_algebra_library_type",
+                     o.dense_linear_algebra_library_type,
+                     "Library used by dense linear solvers, including the "
+                     "reduced camera system of DENSE_SCHUR.  CUDA requires "
+                     "Ceres 2.1 or later built with CUDA." +
+                     ceres_options< ::ceres::DenseLinearAlgebraLibraryType >() );
+  config->set_value( "sparse_linear_algebra_library_type",
+                     o.sparse_linear_algebra_library_type,
+                     "Library used by sparse linear solvers." +
+                     ceres_options< ::ceres::SparseLinearAlgebraLibraryType >() );
+  config->set_value( "auto_tune_solver", this->auto_tune,
+                     "If true, choose linear_solver_type, preconditioner_type "
+                     "and num_threads for each problem from its number of "
+                     "cameras and residuals.  DENSE_SCHUR is used for small "
+                     "problems, and for larger ones with CUDA dense linear "
+                     "algebra, SPARSE_SCHUR for medium problems, and "
+                     "ITERATIVE_SCHUR for the largest.  The configured values "
+                     "are kept if the chosen ones are not supported." );
+  config->set_value( "log_solver_timing", this->log_timing,
+                     "If true, log the solver used and the time spent in each "
+                     "stage of every solve." );
   config->set_value( "trust_region_strategy_type",
                      o.trust_region_strategy_type,
                      "Trust region step compution algorithm used by Ceres." +
@@ -71,18 +114,123 @@ ::set_configuration( config_block_sptr config )
   options.vname = config->get_value< vtype >(#vname, options.vname );
 
   GET_VALUE( int,    num_threads );
+#if CERES_VERSION_MAJOR < 2
   GET_VALUE( int,    num_linear_solver_threads );
+#endif
   GET_VALUE( int,    max_num_iterations );
   GET_VALUE( double, function_tolerance );
   GET_VALUE( double, gradient_tolerance );
   GET_VALUE( double, parameter_tolerance );
   GET_VALUE( ::ceres::LinearSolverType, linear_solver_type );
   GET_VALUE( ::ceres::PreconditionerType, preconditioner_type );
+  GET_VALUE( ::ceres::DenseLinearAlgebraLibraryType,
+             dense_linear_algebra_library_type );
+  GET_VALUE( ::ceres::SparseLinearAlgebraLibraryType,
+             sparse_linear_algebra_library_type );
   GET_VALUE( ::ceres::TrustRegionStrategyType, trust_region_strategy_type );
   GET_VALUE( ::ceres::DoglegType, dogleg_type );
   GET_VALUE( bool, update_state_every_iteration );
 
 #undef GET_VALUE
+
+  this->auto_tune = config->get_value< bool >( "auto_tune_solver",
+                                               this->auto_tune );
+  this->log_timing = config->get_value< bool >( "log_solver_timing",
+                                                this->log_timing );
+}
+
+::ceres::Solver::Options
+solver_options
+::tuned_options( size_t num_cameras, size_t num_landmarks,
+                 int num_residuals ) const
+{
+  ::ceres::Solver::Options o = this->options;
+  if( !this->auto_tune )
+  {
+    return o;
+  }
+
+  // The Schur solvers eliminate the landmarks, leaving a system in the
+  // cameras whose dense factorization grows with the cube of their number
+  size_t max_dense_cameras = max_dense_schur_cameras;
+#ifdef KWIVER_CERES_HAS_CUDA
+  if( o.dense_linear_algebra_library_type == ::ceres::CUDA )
+  {
+    max_dense_cameras = max_cuda_dense_schur_cameras;
+  }
+#endif
+  bool const have_sparse =
+    ::ceres::IsSparseLinearAlgebraLibraryTypeAvailable(
+      o.sparse_linear_algebra_library_type );
+  if( num_landmarks == 0 )
+  {
+    // with no landmarks to eliminate, solve the normal equations directly
+    o.linear_solver_type = num_cameras <= max_dense_cameras
+                           ? ::ceres::DENSE_QR
+                           : have_sparse ? ::ceres::SPARSE_NORMAL_CHOLESKY
+                                         : ::ceres::CGNR;
+    o.preconditioner_type = ::ceres::JACOBI;
+  }
+  else if( num_cameras <= max_dense_cameras )
+  {
+    o.linear_solver_type = ::ceres::DENSE_SCHUR;
+    o.preconditioner_type = ::ceres::JACOBI;
+  }
+  else if( num_cameras <= max_sparse_schur_cameras && have_sparse )
+  {
+    o.linear_solver_type = ::ceres::SPARSE_SCHUR;
+    o.preconditioner_type = ::ceres::JACOBI;
+  }
+  else
+  {
+    o.linear_solver_type = ::ceres::ITERATIVE_SCHUR;
+    o.preconditioner_type = ::ceres::SCHUR_JACOBI;
+  }
+
+  // Residuals and Jacobians are evaluated in parallel over residual blocks,
+  // which only pays off with enough of them per thread
+  int const max_threads =
+    static_cast< int >( std::max( 1u, std::thread::hardware_concurrency() ) );
+  o.num_threads =
+    std::min( max_threads,
+              std::max( 1, num_residuals / min_residuals_per_thread ) );
+#if CERES_VERSION_MAJOR < 2
+  o.num_linear_solver_threads = o.num_threads;
+#endif
+
+  std::string msg;
+  if( !o.IsValid( &msg ) )
+  {
+    return this->options;
+  }
+  return o;
+}
+
+void
+solver_options
+::report_timing( vital::logger_handle_t logger,
+                 ::ceres::Solver::Summary const& summary ) const
+{
+  if( !this->log_timing )
+  {
+    return;
+  }
+  LOG_INFO( logger,
+            "Solved " << summary.num_residuals << " residuals in "
+            << summary.num_parameter_blocks << " parameter blocks with "
+            << ::ceres::LinearSolverTypeToString(
+                 summary.linear_solver_type_used ) << " ("
+            << ::ceres::PreconditionerTypeToString(
+                 summary.preconditioner_type_used ) << ", "
+            << ::ceres::DenseLinearAlgebraLibraryTypeToString(
+                 summary.dense_linear_algebra_library_type ) << ") on "
+            << summary.num_threads_used << " threads in "
+            << summary.total_time_in_seconds << " s: preprocessing "
+            << summary.preprocessor_time_in_seconds << " s, residuals "
+            << summary.residual_evaluation_time_in_seconds << " s, Jacobians "
+            << summary.jacobian_evaluation_time_in_seconds
+            << " s, linear solver "
+            << summary.linear_solver_time_in_seconds << " s" );
 }
 
 // ----------------------------------------------------------------------------
@@ -91,7 +239,8 @@ ::camera_options( const camera_options& other )
   : mvg::camera_options( other ),
     camera_intrinsic_share_type( other.camera_intrinsic_share_type ),
     camera_path_smoothness( other.camera_path_smoothness ),
-    camera_forward_motion_damping( other.camera_forward_motion_damping )
+    camera_forward_motion_damping( other.camera_forward_motion_damping ),
+    analytic_jacobians( other.analytic_jacobians )
 {
 }
 
@@ -117,6 +266,11 @@ ::get_configuration( config_block_sptr config ) const
                      "distances.  It causes the algorithm to prefer focal length change "
                      "over fast motion along the principal ray. "
                      "If set to zero the regularization is disabled." );
+  config->set_value( "analytic_jacobians", this->analytic_jacobians,
+                     "If true, compute the Jacobians of the reprojection "
+                     "errors in closed form rather than by automatic "
+                     "differentiation.  This is faster and is used for all "
+                     "lens distortion types except RATIONAL_RADIAL_TANGENTIAL." );
 }
 
 void
@@ -129,6 +283,7 @@ ::set_configuration( config_block_sptr config )
   GET_VALUE( CameraIntrinsicShareType, camera_intrinsic_share_type );
   GET_VALUE( double, camera_path_smoothness );
   GET_VALUE( double, camera_forward_motion_damping );
+  GET_VALUE( bool, analytic_jacobians );
 #undef GET_VALUE
 }
 
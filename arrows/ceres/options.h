@@ -11,6 +11,7 @@
 #include <arrows/ceres/types.h>
 #include <arrows/mvg/camera_options.h>
 #include <vital/config/config_block.h>
+#include <vital/logger/logger.h>
 #include <vital/types/sfm_constraints.h>
 #include <vital/vital_config.h>
 
@@ -36,8 +37,30 @@ class solver_options
   /// Set the member variables from the config block.
   void set_configuration( vital::config_block_sptr config );
 
+  /// Return the solver options to use for a problem of the given size.
+  ///
+  /// If \c auto_tune is set, the linear solver, preconditioner, and number
+  /// of threads are chosen from the size of the problem. Otherwise, or if
+  /// the chosen options are not supported by this build of Ceres, this
+  /// returns \c options unchanged.
+  ///
+  /// \param num_cameras number of cameras in the problem
+  /// \param num_landmarks number of landmarks optimized in the problem
+  /// \param num_residuals number of residuals in the problem
+  ::ceres::Solver::Options
+  tuned_options( size_t num_cameras, size_t num_landmarks,
+                 int num_residuals ) const;
+
+  /// Log the time spent in each stage of a solve if \c log_timing is set.
+  void report_timing( vital::logger_handle_t logger,
+                      ::ceres::Solver::Summary const& summary ) const;
+
   /// Ceres solver options.
   ::ceres::Solver::Options options;
+  /// choose the linear solver and threads from the problem size
+  bool auto_tune = false;
+  /// log the time taken by each solve
+  bool log_timing = false;
 };
 
 /// Camera options class
@@ -196,6 +219,8 @@ struct camera_options : public mvg::camera_options
   double camera_path_smoothness = 0.0;
   /// scale of camera forward motion damping regularization
   double camera_forward_motion_damping = 0.0;
+  /// compute reprojection Jacobians in closed form where available
+  bool analytic_jacobians = true;
 };
 
 /// Return the number of distortion parameters required for each type.
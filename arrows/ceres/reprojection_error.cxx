@@ -14,6 +14,11 @@
 #include <ceres/ceres.h>
 #include <ceres/rotation.h>
 
+#include <Eigen/Core>
+
+#include <array>
+#include <limits>
+
 namespace kwiver {
 
 namespace arrows {
@@ -200,22 +205,193 @@ class rpe_distortion
   double y_;
 };
 
+// Helper function to form the cross product matrix of a vector
+inline Eigen::Matrix3d
+cross_product_matrix( Eigen::Vector3d const& v )
+{
+  Eigen::Matrix3d m;
+  m <<    0.0, -v[ 2 ],  v[ 1 ],
+       v[ 2 ],     0.0, -v[ 0 ],
+      -v[ 1 ],  v[ 0 ],     0.0;
+  return m;
+}
+
+// Ceres reprojection error (RPE) cost function with analytic derivatives,
+// templated over distortion type
+// The template parameter should be a struct as for rpe_distortion, which
+// also contains
+//  - jacobians a function with signature \code
+//        void (*)(const double* coeffs, const double* in_point,
+//                 double* d_point, double* d_coeffs);
+//    \endcode
+//    giving the row-major Jacobians of the distorted point with respect to
+//    the point (2x2) and the coefficients (2xndp)
+// Data parameter blocks are the same as for rpe_distortion.  The residuals
+// match those of the auto-differentiated functors, but the Jacobians are
+// evaluated directly rather than by propagating dual numbers through every
+// operation.
+template < typename DF >
+class rpe_analytic
+  : public ::ceres::SizedCostFunction< 2, 5 + DF::num_coeffs, 6, 3 >
+{
+public:
+  // number of intrinsic parameters
+  static const int nip = 5 + DF::num_coeffs;
+
+  /// Constructor
+  rpe_analytic( const double x, const double y )
+    : x_( x ), y_( y ) {}
+
+  /// Evaluate the residuals and, if requested, their Jacobians
+  /// \param [in] parameters: intrinsics, pose and point data blocks
+  /// \param [out] residuals
+  /// \param [out] jacobians: row-major Jacobians of each block, or null
+  bool
+  Evaluate( double const* const* parameters,
+            double* residuals,
+            double** jacobians ) const override
+  {
+    using mat2x3_t = Eigen::Matrix< double, 2, 3, Eigen::RowMajor >;
+    using mat2x2_t = Eigen::Matrix< double, 2, 2, Eigen::RowMajor >;
+
+    const double* intrinsics = parameters[ 0 ];
+    const double* pose = parameters[ 1 ];
+    const Eigen::Map< const Eigen::Vector3d > rotation( pose );
+    const Eigen::Map< const Eigen::Vector3d > center( pose + 3 );
+    const Eigen::Map< const Eigen::Vector3d > point( parameters[ 2 ] );
+
+    // Rotate the point into the camera frame; for small angles Ceres uses
+    // the first order rotation, as AngleAxisRotatePoint does
+    Eigen::Matrix3d R;
+    ::ceres::AngleAxisToRotationMatrix( pose, R.data() );
+    const Eigen::Vector3d p = point - center;
+    const Eigen::Vector3d q = R * p;
+
+    // Project the point into 2D and apply distortion
+    const double xy[ 2 ] = { q[ 0 ] / q[ 2 ], q[ 1 ] / q[ 2 ] };
+    double distorted_xy[ 2 ];
+    DF::apply( intrinsics + 5, xy, distorted_xy );
+    const double& u = distorted_xy[ 0 ];
+    const double& v = distorted_xy[ 1 ];
+
+    // Apply the intrinsic calibration matrix
+    const double& focal = intrinsics[ 0 ];
+    const double& aspect_ratio = intrinsics[ 3 ];
+    const double& skew = intrinsics[ 4 ];
+    const double focal_y = focal / aspect_ratio;
+    residuals[ 0 ] = intrinsics[ 1 ] + focal * u + skew * v - x_;
+    residuals[ 1 ] = intrinsics[ 2 ] + focal_y * v - y_;
+
+    if( !jacobians )
+    {
+      return true;
+    }
+
+    mat2x2_t d_distorted;
+    std::array< double, 2 * DF::num_coeffs > d_coeffs;
+    DF::jacobians( intrinsics + 5, xy, d_distorted.data(), d_coeffs.data() );
+
+    mat2x2_t d_image;
+    d_image << focal, skew,
+                 0.0, focal_y;
+
+    if( jacobians[ 0 ] )
+    {
+      Eigen::Map< Eigen::Matrix< double, 2, nip, Eigen::RowMajor > >
+        J( jacobians[ 0 ] );
+      J.template leftCols< 5 >() <<
+        u, 1.0, 0.0, 0.0, v,
+        v / aspect_ratio, 0.0, 1.0, -focal_y * v / aspect_ratio, 0.0;
+      for( int i = 0; i < DF::num_coeffs; ++i )
+      {
+        const Eigen::Vector2d d_distorted_i{ d_coeffs[ i ],
+                                             d_coeffs[ DF::num_coeffs + i ] };
+        J.col( 5 + i ) = d_image * d_distorted_i;
+      }
+    }
+
+    if( jacobians[ 1 ] || jacobians[ 2 ] )
+    {
+      const double inv_z = 1.0 / q[ 2 ];
+      mat2x3_t d_xy;
+      d_xy << inv_z,   0.0, -xy[ 0 ] * inv_z,
+                0.0, inv_z, -xy[ 1 ] * inv_z;
+
+      // Jacobians with respect to the rotated point and the point
+      const mat2x3_t d_q = d_image * d_distorted * d_xy;
+      const mat2x3_t d_point = d_q * R;
+
+      if( jacobians[ 1 ] )
+      {
+        Eigen::Matrix3d d_rotation;
+        const double theta2 = rotation.squaredNorm();
+        if( theta2 > std::numeric_limits< double >::epsilon() )
+        {
+          // Derivative of a rotated vector with respect to the rotation
+          // vector, from Gallego and Yezzi, "A Compact Formula for the
+          // Derivative of a 3-D Rotation in Exponential Coordinates"
+          d_rotation =
+            -R * cross_product_matrix( p ) *
+            ( rotation * rotation.transpose() +
+              ( R.transpose() - Eigen::Matrix3d::Identity() ) *
+              cross_product_matrix( rotation ) ) / theta2;
+        }
+        else
+        {
+          d_rotation = -cross_product_matrix( p );
+        }
+
+        Eigen::Map< Eigen::Matrix< double, 2, 6, Eigen::RowMajor > >
+          J( jacobians[ 1 ] );
+        J.template leftCols< 3 >() = d_q * d_rotation;
+        J.template rightCols< 3 >() = -d_point;
+      }
+
+      if( jacobians[ 2 ] )
+      {
+        Eigen::Map< mat2x3_t > J( jacobians[ 2 ] );
+        J = d_point;
+      }
+    }
+    return true;
+  }
+
+  /// Cost function factory
+  static ::ceres::CostFunction*
+  create( const double x, const double y )
+  {
+    return new rpe_analytic< DF >( x, y );
+  }
+
+  double x_;
+  double y_;
+};
+
 // Factory to create Ceres cost functions for each lens distortion type
 ::ceres::CostFunction*
-create_cost_func( LensDistortionType ldt, double x, double y )
+create_cost_func( LensDistortionType ldt, double x, double y,
+                  bool analytic_jacobians )
 {
   switch( ldt )
   {
     case POLYNOMIAL_RADIAL_DISTORTION:
-      return rpe_distortion< distortion_poly_radial >::create( x, y );
+      return analytic_jacobians
+             ? rpe_analytic< distortion_poly_radial >::create( x, y )
+             : rpe_distortion< distortion_poly_radial >::create( x, y );
     case POLYNOMIAL_RADIAL_TANGENTIAL_DISTORTION:
-      return rpe_distortion< distortion_poly_radial_tangential >
-	      ::create( x, y );
+      return analytic_jacobians
+             ? rpe_analytic< distortion_poly_radial_tangential >
+               ::create( x, y )
+             : rpe_distortion< distortion_poly_radial_tangential >
+               ::create( x, y );
     case RATIONAL_RADIAL_TANGENTIAL_DISTORTION:
+      // No analytic Jacobians are implemented for the rational model
       return rpe_distortion< distortion_ratpoly_radial_tangential >
 	      ::create( x, y );
     default:
-      return rpe_no_distortion::create( x, y );
+      return analytic_jacobians
+             ? rpe_analytic< distortion_none >::create( x, y )
+             : rpe_no_distortion::create( x, y );
   }
 }
 
@@ -22,9 +22,15 @@ namespace arrows {
 namespace ceres {
 
 /// Factory to create Ceres cost functions for each lens distortion type
+///
+/// If \p analytic_jacobians is true, the cost functions for no distortion
+/// and the polynomial models compute their Jacobians in closed form rather
+/// than by automatic differentiation.  The rational model is always
+/// automatically differentiated.
 KWIVER_ALGO_CERES_EXPORT
 ::ceres::CostFunction*
-create_cost_func( mvg::LensDistortionType ldt, double x, double y );
+create_cost_func( mvg::LensDistortionType ldt, double x, double y,
+                  bool analytic_jacobians = false );
 
 } // namespace ceres
 
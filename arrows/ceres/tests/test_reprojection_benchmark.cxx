@@ -0,0 +1,288 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Benchmark closed form against automatically differentiated reprojection
+/// Jacobians.
+///
+/// Each test builds the bundle adjustment scene of test_bundle_adjust.cxx for
+/// one lens distortion model, then times evaluating the residuals and
+/// Jacobians of every observation, and a full bundle adjustment, with each
+/// kind of Jacobian. Both must reach the same solution. Speedups depend on
+/// the machine and compiler, so they are checked only against a floor passed
+/// as \c --min-speedup=<ratio>.
+
+#include <test_scene.h>
+
+#include <arrows/ceres/bundle_adjust.h>
+#include <arrows/ceres/options.h>
+#include <arrows/ceres/reprojection_error.h>
+
+#include <arrows/mvg/metrics.h>
+#include <arrows/mvg/projected_track_set.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+
+using namespace kwiver::vital;
+
+using kwiver::arrows::mvg::LensDistortionType;
+using kwiver::arrows::mvg::projected_tracks;
+using kwiver::arrows::mvg::reprojection_rmse;
+using kwiver::arrows::ceres::create_cost_func;
+using kwiver::arrows::ceres::num_distortion_params;
+
+namespace {
+
+double g_min_speedup = 0.0;
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+
+  std::string const min_speedup_flag = "--min-speedup=";
+  for( int i = 1; i < argc; ++i )
+  {
+    std::string const arg = argv[ i ];
+    if( !arg.compare( 0, min_speedup_flag.size(), min_speedup_flag ) )
+    {
+      g_min_speedup = std::stod( arg.substr( min_speedup_flag.size() ) );
+    }
+  }
+
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using clock_t = std::chrono::steady_clock;
+
+constexpr size_t passes = 20;
+
+// ----------------------------------------------------------------------------
+struct benchmark_scene
+{
+  benchmark_scene( Eigen::VectorXd const& dc )
+  {
+    simple_camera_intrinsics K{ 1000, vector_2d{ 640, 480 } };
+    K.set_dist_coeffs( dc );
+
+    landmarks = kwiver::testing::cube_corners( 2.0 );
+    cameras = kwiver::testing::camera_seq( 20, K );
+    tracks = projected_tracks( landmarks, cameras );
+  }
+
+  landmark_map_sptr landmarks;
+  camera_map_sptr cameras;
+  feature_track_set_sptr tracks;
+};
+
+// ----------------------------------------------------------------------------
+// Parameter blocks and cost function of one observation
+struct residual_block
+{
+  std::vector< double > intrinsics;
+  double pose[ 6 ];
+  double point[ 3 ];
+  std::unique_ptr< ::ceres::CostFunction > cost_func;
+};
+
+// ----------------------------------------------------------------------------
+std::vector< residual_block >
+make_residual_blocks( benchmark_scene const& scene,
+                      LensDistortionType dist_type, bool analytic_jacobians )
+{
+  auto const cam_map = scene.cameras->cameras();
+  auto const lm_map = scene.landmarks->landmarks();
+  auto const ndp = num_distortion_params( dist_type );
+
+  std::vector< residual_block > blocks;
+  for( auto const& t : scene.tracks->tracks() )
+  {
+    auto const& lm = *lm_map.at( t->id() );
+    for( auto const& ts : *t )
+    {
+      auto const fts = std::dynamic_pointer_cast< feature_track_state >( ts );
+      auto const cam = std::dynamic_pointer_cast< camera_perspective >(
+        cam_map.at( ts->frame() ) );
+      auto const K = cam->intrinsics();
+
+      residual_block block;
+      block.intrinsics = { K->focal_length(), K->principal_point().x(),
+                           K->principal_point().y(), K->aspect_ratio(),
+                           K->skew() };
+      auto dc = K->dist_coeffs();
+      dc.resize( ndp, 0.0 );
+      block.intrinsics.insert( block.intrinsics.end(), dc.begin(), dc.end() );
+
+      vector_3d const rot = cam->rotation().rodrigues();
+      std::copy( rot.data(), rot.data() + 3, block.pose );
+      std::copy( cam->center().data(), cam->center().data() + 3,
+                 block.pose + 3 );
+      std::copy( lm.loc().data(), lm.loc().data() + 3, block.point );
+
+      auto const& loc = fts->feature->loc();
+      block.cost_func.reset(
+        create_cost_func( dist_type, loc.x(), loc.y(), analytic_jacobians ) );
+      blocks.push_back( std::move( block ) );
+    }
+  }
+  return blocks;
+}
+
+// ----------------------------------------------------------------------------
+// Time evaluating the residuals and Jacobians of every block, returning the
+// evaluations per second
+double
+time_evaluation( char const* name, std::vector< residual_block >& blocks )
+{
+  double residuals[ 2 ];
+  std::vector< double > jacobian_data( 2 * ( 5 + 8 + 6 + 3 ) );
+  double* jacobians[ 3 ] = { jacobian_data.data(),
+                             jacobian_data.data() + 2 * ( 5 + 8 ),
+                             jacobian_data.data() + 2 * ( 5 + 8 + 6 ) };
+
+  auto const start = clock_t::now();
+  for( size_t pass = 0; pass < passes; ++pass )
+  {
+    for( auto& block : blocks )
+    {
+      double* parameters[ 3 ] =
+        { block.intrinsics.data(), block.pose, block.point };
+      block.cost_func->Evaluate( parameters, residuals, jacobians );
+    }
+  }
+  auto const elapsed = clock_t::now() - start;
+
+  auto const count = static_cast< double >( blocks.size() * passes );
+  auto const rate =
+    count / std::chrono::duration< double >( elapsed ).count();
+  std::cout << std::left << std::setw( 10 ) << name
+            << std::right << std::setw( 12 ) << std::fixed
+            << std::setprecision( 0 ) << rate << " evaluations/s\n";
+  return rate;
+}
+
+// ----------------------------------------------------------------------------
+// Time a bundle adjustment of the noisy scene, returning the seconds taken
+double
+time_bundle_adjust( char const* name, benchmark_scene const& scene,
+                    char const* dist_type, bool analytic_jacobians,
+                    double& end_rmse )
+{
+  kwiver::arrows::ceres::bundle_adjust ba;
+  auto cfg = ba.get_configuration();
+  cfg->set_value( "lens_distortion_type", dist_type );
+  cfg->set_value( "analytic_jacobians", analytic_jacobians );
+  cfg->set_value( "optimize_dist_k1", false );
+  cfg->set_value( "optimize_dist_k2", false );
+  cfg->set_value( "optimize_dist_k3", false );
+  cfg->set_value( "optimize_dist_p1_p2", false );
+  ba.set_configuration( cfg );
+
+  auto landmarks = kwiver::testing::noisy_landmarks( scene.landmarks, 0.1 );
+  auto cameras = kwiver::testing::noisy_cameras( scene.cameras, 0.1, 0.1 );
+
+  auto const start = clock_t::now();
+  ba.optimize( cameras, landmarks, scene.tracks );
+  auto const seconds =
+    std::chrono::duration< double >( clock_t::now() - start ).count();
+
+  end_rmse = reprojection_rmse( cameras->cameras(), landmarks->landmarks(),
+                                scene.tracks->tracks() );
+  std::cout << std::left << std::setw( 10 ) << name
+            << std::right << std::setw( 12 ) << std::fixed
+            << std::setprecision( 4 ) << seconds << " s bundle adjust\n";
+  return seconds;
+}
+
+// ----------------------------------------------------------------------------
+struct benchmark_test
+{
+  char const* const distortion_model;
+  LensDistortionType const distortion_type;
+  int const distortion_coefficients_dimension;
+};
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+void
+PrintTo( benchmark_test const& v, ::std::ostream* os )
+{
+  (*os) << v.distortion_model << '/' << v.distortion_coefficients_dimension;
+}
+
+// ----------------------------------------------------------------------------
+class reprojection_benchmark : public ::testing::TestWithParam<benchmark_test>
+{
+};
+
+// ----------------------------------------------------------------------------
+TEST_P(reprojection_benchmark, evaluate)
+{
+  auto const& param = GetParam();
+  Eigen::VectorXd dc{ 5 };
+  dc << -0.01, 0.002, 0.001, -0.005, -0.004;
+  dc.conservativeResize( param.distortion_coefficients_dimension );
+  benchmark_scene const scene{ dc };
+
+  auto autodiff_blocks =
+    make_residual_blocks( scene, param.distortion_type, false );
+  auto analytic_blocks =
+    make_residual_blocks( scene, param.distortion_type, true );
+
+  auto const autodiff_rate = time_evaluation( "autodiff", autodiff_blocks );
+  auto const analytic_rate = time_evaluation( "analytic", analytic_blocks );
+  auto const speedup = analytic_rate / autodiff_rate;
+  std::cout << "speedup " << std::setprecision( 2 ) << speedup << std::endl;
+  if( g_min_speedup > 0.0 )
+  {
+    EXPECT_LE( g_min_speedup, speedup ) << param.distortion_model;
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST_P(reprojection_benchmark, bundle_adjust)
+{
+  auto const& param = GetParam();
+  Eigen::VectorXd dc{ 5 };
+  dc << -0.01, 0.002, 0.001, -0.005, -0.004;
+  dc.conservativeResize( param.distortion_coefficients_dimension );
+  benchmark_scene const scene{ dc };
+
+  double autodiff_rmse = 0.0;
+  double analytic_rmse = 0.0;
+  auto const autodiff_seconds =
+    time_bundle_adjust( "autodiff", scene, param.distortion_model, false,
+                        autodiff_rmse );
+  auto const analytic_seconds =
+    time_bundle_adjust( "analytic", scene, param.distortion_model, true,
+                        analytic_rmse );
+  std::cout << "speedup " << std::setprecision( 2 )
+            << autodiff_seconds / analytic_seconds << std::endl;
+
+  EXPECT_NEAR( 0.0, autodiff_rmse, 1e-5 );
+  EXPECT_NEAR( 0.0, analytic_rmse, 1e-5 );
+}
+
+// ----------------------------------------------------------------------------
+#define DISTORTION( t, k ) \
+  benchmark_test{ #t, kwiver::arrows::mvg::t, k }
+
+INSTANTIATE_TEST_CASE_P(
+  ,
+  reprojection_benchmark,
+  ::testing::Values(
+    DISTORTION( NO_DISTORTION, 0 ),
+    DISTORTION( POLYNOMIAL_RADIAL_DISTORTION, 2 ),
+    DISTORTION( POLYNOMIAL_RADIAL_TANGENTIAL_DISTORTION, 5 )
+));
@@ -15,6 +15,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <memory>
+
 using namespace kwiver::vital;
 
 using kwiver::arrows::mvg::LensDistortionType;
@@ -35,10 +38,11 @@ int main(int argc, char** argv)
 static void
 test_reprojection_error(
   camera_perspective const& cam, landmark const& lm, feature const& f,
-  LensDistortionType dist_type )
+  LensDistortionType dist_type, bool analytic_jacobians )
 {
   ::ceres::CostFunction* cost_func =
-      create_cost_func(dist_type, f.loc().x(), f.loc().y());
+      create_cost_func(dist_type, f.loc().x(), f.loc().y(),
+                       analytic_jacobians);
 
   double pose[6];
   vector_3d rot = cam.rotation().rodrigues();
@@ -164,7 +168,63 @@ TEST_P(reprojection_error, compare_projections)
       SCOPED_TRACE( "At track frame " + std::to_string( ts->frame() ) );
 
       auto cam_ptr = std::dynamic_pointer_cast<camera_perspective>(ci->second);
-      test_reprojection_error( *cam_ptr, lm, feat, dist_type );
+      test_reprojection_error( *cam_ptr, lm, feat, dist_type, false );
+      test_reprojection_error( *cam_ptr, lm, feat, dist_type, true );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Compare closed form Jacobians to those computed by automatic differentiation
+TEST_P(reprojection_error, analytic_jacobians)
+{
+  auto const dist_type = GetParam().distortion_type;
+  auto const dc_dim = GetParam().distortion_coefficients_dimension;
+
+  int const ndp = static_cast<int>( num_distortion_params( dist_type ) );
+  std::vector<double> intrinsics = { 1000.0, 640.0, 480.0, 1.1, 0.3 };
+  Eigen::VectorXd const dc = distortion_coefficients( std::min( dc_dim, ndp ) );
+  intrinsics.insert( intrinsics.end(), dc.data(), dc.data() + dc.size() );
+  intrinsics.resize( 5 + ndp, 0.0 );
+
+  double point[3] = { 0.5, -0.7, 1.2 };
+
+  // Test a general rotation as well as the first order, small angle case
+  for ( double const angle_scale : { 1.0, 1e-9, 0.0 } )
+  {
+    SCOPED_TRACE( "At angle scale " + std::to_string( angle_scale ) );
+
+    double pose[6] = { 0.3 * angle_scale, -0.5 * angle_scale,
+                       0.2 * angle_scale, 1.0, -2.0, -10.0 };
+    double* parameters[3] = { &intrinsics[0], pose, point };
+    int const sizes[3] = { 5 + ndp, 6, 3 };
+
+    vector_2d residuals[2];
+    std::vector<double> jacobians[2][3];
+    for ( int k = 0; k < 2; ++k )
+    {
+      std::unique_ptr< ::ceres::CostFunction > cost_func{
+        create_cost_func( dist_type, 600.0, 400.0, k == 1 ) };
+
+      double* jacobian_ptrs[3];
+      for ( int b = 0; b < 3; ++b )
+      {
+        jacobians[k][b].resize( 2 * sizes[b] );
+        jacobian_ptrs[b] = jacobians[k][b].data();
+      }
+      ASSERT_TRUE( cost_func->Evaluate( parameters, residuals[k].data(),
+                                        jacobian_ptrs ) );
+    }
+
+    EXPECT_NEAR( 0.0, ( residuals[1] - residuals[0] ).norm(), 1e-9 );
+    for ( int b = 0; b < 3; ++b )
+    {
+      for ( size_t i = 0; i < jacobians[0][b].size(); ++i )
+      {
+        EXPECT_NEAR( jacobians[0][b][i], jacobians[1][b][i],
+                     1e-9 * std::max( 1.0, std::fabs( jacobians[0][b][i] ) ) )
+          << "Jacobian " << b << " element " << i;
+      }
     }
   }
 }
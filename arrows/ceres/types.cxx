@@ -68,6 +68,8 @@ CERES_ENUM_HELPERS( ::ceres, LinearSolverType )
 CERES_ENUM_HELPERS( ::ceres, PreconditionerType )
 CERES_ENUM_HELPERS( ::ceres, TrustRegionStrategyType )
 CERES_ENUM_HELPERS( ::ceres, DoglegType )
+CERES_ENUM_HELPERS( ::ceres, DenseLinearAlgebraLibraryType )
+CERES_ENUM_HELPERS( ::ceres, SparseLinearAlgebraLibraryType )
 
 CERES_ENUM_HELPERS( kwiver::arrows::ceres, LossFunctionType )
 CERES_ENUM_HELPERS( kwiver::arrows::ceres, CameraIntrinsicShareType )
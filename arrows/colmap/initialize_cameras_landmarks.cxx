@@ -0,0 +1,430 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of COLMAP initialize_cameras_landmarks algorithm
+
+#include <arrows/colmap/initialize_cameras_landmarks.h>
+
+#include <arrows/colmap/sfm_database.h>
+
+#include <vital/types/camera_perspective.h>
+#include <vital/types/landmark.h>
+#include <vital/types/similarity.h>
+
+#include <colmap/base/reconstruction_manager.h>
+#include <colmap/controllers/incremental_mapper.h>
+
+#include <kwiversys/SystemTools.hxx>
+
+#include <Eigen/Geometry>
+
+#include <cmath>
+#include <unordered_set>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace colmap_arrow {
+
+using namespace kwiver::vital;
+
+// ----------------------------------------------------------------------------
+class initialize_cameras_landmarks::priv
+{
+public:
+  // Intrinsics of frames without camera: image size from the constraints or
+  // the extent of the features, focal length from the constraints
+  simple_camera_intrinsics default_intrinsics(
+    std::vector< track_sptr > const& tracks,
+    camera_map::map_camera_t const& cameras,
+    sfm_constraints_sptr const& constraints ) const;
+
+  // Align the reconstruction to the existing cameras, or to the camera
+  // position priors
+  void align(
+    camera_map::map_camera_t& cameras,
+    landmark_map::map_landmark_t& landmarks,
+    camera_map::map_camera_t const& priors,
+    sfm_constraints_sptr const& constraints ) const;
+
+  kwiver::vital::logger_handle_t m_logger;
+
+  std::string database_path = "colmap_sfm.db";
+  bool keep_database = false;
+  database_options db_options;
+  bool init_intrinsics_from_metadata = true;
+  int num_threads = -1;
+  int min_num_matches = 15;
+  int min_model_size = 10;
+  bool refine_focal_length = true;
+  bool refine_principal_point = false;
+  bool refine_extra_params = true;
+};
+
+// ----------------------------------------------------------------------------
+simple_camera_intrinsics
+initialize_cameras_landmarks::priv
+::default_intrinsics(
+  std::vector< track_sptr > const& tracks,
+  camera_map::map_camera_t const& cameras,
+  sfm_constraints_sptr const& constraints ) const
+{
+  int width = 0, height = 0;
+  if( !constraints ||
+      !constraints->get_image_width( -1, width ) ||
+      !constraints->get_image_height( -1, height ) )
+  {
+    width = height = 0;
+
+    // Use the image size of an existing camera
+    for( auto const& c : cameras )
+    {
+      auto const cam =
+        std::dynamic_pointer_cast< camera_perspective >( c.second );
+      if( cam && cam->intrinsics()->image_width() )
+      {
+        width = static_cast< int >( cam->intrinsics()->image_width() );
+        height = static_cast< int >( cam->intrinsics()->image_height() );
+        break;
+      }
+    }
+  }
+
+  if( width <= 0 || height <= 0 )
+  {
+    vector_2d extent{ 1.0, 1.0 };
+    for( auto const& t : tracks )
+    {
+      for( auto const& ts : *t )
+      {
+        auto const fts = std::dynamic_pointer_cast< feature_track_state >( ts );
+        if( fts && fts->feature )
+        {
+          extent = extent.cwiseMax( fts->feature->loc() );
+        }
+      }
+    }
+    width = static_cast< int >( std::ceil( extent.x() ) );
+    height = static_cast< int >( std::ceil( extent.y() ) );
+    LOG_WARN( m_logger, "Image size is unknown; assuming "
+                        << width << "x" << height
+                        << " from the extent of the features" );
+  }
+
+  float focal_length = 0.0f;
+  if( !init_intrinsics_from_metadata || !constraints ||
+      !constraints->get_focal_length_prior( -1, focal_length ) )
+  {
+    focal_length = 0.0f;
+  }
+
+  return { focal_length, { 0.5 * width, 0.5 * height }, 1.0, 0.0, {},
+           static_cast< unsigned >( width ),
+           static_cast< unsigned >( height ) };
+}
+
+// ----------------------------------------------------------------------------
+void
+initialize_cameras_landmarks::priv
+::align(
+  camera_map::map_camera_t& cameras,
+  landmark_map::map_landmark_t& landmarks,
+  camera_map::map_camera_t const& priors,
+  sfm_constraints_sptr const& constraints ) const
+{
+  std::vector< vector_3d > from, to;
+  for( auto const& c : cameras )
+  {
+    auto const p = priors.find( c.first );
+    auto const prior = ( p == priors.end() ? nullptr :
+      std::dynamic_pointer_cast< camera_perspective >( p->second ) );
+
+    vector_3d center;
+    if( prior )
+    {
+      center = prior->center();
+    }
+    else if( !constraints ||
+             !constraints->get_camera_position_prior_local( c.first, center ) )
+    {
+      continue;
+    }
+
+    from.push_back(
+      std::static_pointer_cast< camera_perspective >( c.second )->center() );
+    to.push_back( center );
+  }
+
+  if( from.size() < 3 )
+  {
+    LOG_DEBUG( m_logger, "Fewer than three camera priors; "
+                         "the reconstruction is not aligned" );
+    return;
+  }
+
+  Eigen::Map< Eigen::Matrix< double, 3, Eigen::Dynamic > const > const
+  src{ from.front().data(), 3, static_cast< Eigen::Index >( from.size() ) };
+  Eigen::Map< Eigen::Matrix< double, 3, Eigen::Dynamic > const > const
+  dst{ to.front().data(), 3, static_cast< Eigen::Index >( to.size() ) };
+  similarity_d const sim{ Eigen::Matrix4d{ Eigen::umeyama( src, dst, true ) } };
+
+  auto const inv_rotation = sim.rotation().inverse();
+  for( auto& c : cameras )
+  {
+    auto const cam =
+      std::static_pointer_cast< simple_camera_perspective >( c.second );
+    cam->set_center( sim * cam->center() );
+    cam->set_rotation( cam->rotation() * inv_rotation );
+  }
+
+  // Landmarks of tracks merged by COLMAP are shared
+  std::unordered_set< landmark const* > moved;
+  for( auto& l : landmarks )
+  {
+    if( moved.insert( l.second.get() ).second )
+    {
+      auto const lm = std::static_pointer_cast< landmark_d >( l.second );
+      lm->set_loc( sim * lm->loc() );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+initialize_cameras_landmarks
+::initialize_cameras_landmarks()
+  : d_{ new priv }
+{
+  attach_logger( "arrows.colmap.initialize_cameras_landmarks" );
+  d_->m_logger = logger();
+}
+
+// ----------------------------------------------------------------------------
+initialize_cameras_landmarks
+::~initialize_cameras_landmarks()
+{
+}
+
+// ----------------------------------------------------------------------------
+config_block_sptr
+initialize_cameras_landmarks
+::get_configuration() const
+{
+  auto config = vital::algo::initialize_cameras_landmarks::get_configuration();
+
+  config->set_value( "database_path", d_->database_path,
+                     "Path of the COLMAP database to which the tracks are "
+                     "written. An existing file is replaced." );
+  config->set_value( "keep_database", d_->keep_database,
+                     "Keep the database after the reconstruction, for "
+                     "inspection with COLMAP." );
+  config->set_value( "camera_model", d_->db_options.camera_model,
+                     "COLMAP camera model: SIMPLE_PINHOLE, PINHOLE, "
+                     "SIMPLE_RADIAL, RADIAL or OPENCV." );
+  config->set_value( "single_camera", d_->db_options.single_camera,
+                     "If true, all frames share one set of intrinsics." );
+  config->set_value( "match_window", d_->db_options.match_window,
+                     "Largest frame gap between two observations of a track "
+                     "written as a match. Zero matches all observations of a "
+                     "track with each other, which grows with the square of "
+                     "the track length." );
+  config->set_value( "init_intrinsics_from_metadata",
+                     d_->init_intrinsics_from_metadata,
+                     "Use the focal length of the metadata as a prior for "
+                     "frames without camera." );
+  config->set_value( "num_threads", d_->num_threads,
+                     "Number of threads of the mapper; -1 uses all cores." );
+  config->set_value( "min_num_matches", d_->min_num_matches,
+                     "Minimum number of matches for a pair of frames to be "
+                     "used by the mapper." );
+  config->set_value( "min_model_size", d_->min_model_size,
+                     "Minimum number of registered frames of a "
+                     "reconstruction." );
+  config->set_value( "refine_focal_length", d_->refine_focal_length,
+                     "Refine the focal length in bundle adjustment." );
+  config->set_value( "refine_principal_point", d_->refine_principal_point,
+                     "Refine the principal point in bundle adjustment." );
+  config->set_value( "refine_extra_params", d_->refine_extra_params,
+                     "Refine the distortion parameters in bundle "
+                     "adjustment." );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+initialize_cameras_landmarks
+::set_configuration( config_block_sptr in_config )
+{
+  auto config = this->get_configuration();
+  config->merge_config( in_config );
+
+  d_->database_path = config->get_value< std::string >( "database_path" );
+  d_->keep_database = config->get_value< bool >( "keep_database" );
+  d_->db_options.camera_model =
+    config->get_value< std::string >( "camera_model" );
+  d_->db_options.single_camera = config->get_value< bool >( "single_camera" );
+  d_->db_options.match_window = config->get_value< unsigned >( "match_window" );
+  d_->init_intrinsics_from_metadata =
+    config->get_value< bool >( "init_intrinsics_from_metadata" );
+  d_->num_threads = config->get_value< int >( "num_threads" );
+  d_->min_num_matches = config->get_value< int >( "min_num_matches" );
+  d_->min_model_size = config->get_value< int >( "min_model_size" );
+  d_->refine_focal_length = config->get_value< bool >( "refine_focal_length" );
+  d_->refine_principal_point =
+    config->get_value< bool >( "refine_principal_point" );
+  d_->refine_extra_params = config->get_value< bool >( "refine_extra_params" );
+}
+
+// ----------------------------------------------------------------------------
+bool
+initialize_cameras_landmarks
+::check_configuration( config_block_sptr config ) const
+{
+  auto const model = config->get_value< std::string >(
+    "camera_model", d_->db_options.camera_model );
+  if( !is_supported_camera_model( model ) )
+  {
+    LOG_ERROR( logger(), "Unsupported COLMAP camera model " << model );
+    return false;
+  }
+
+  if( config->get_value< std::string >(
+        "database_path", d_->database_path ).empty() )
+  {
+    LOG_ERROR( logger(), "A database path is required" );
+    return false;
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+initialize_cameras_landmarks
+::initialize(
+  camera_map_sptr& cameras,
+  landmark_map_sptr& landmarks,
+  feature_track_set_sptr tracks,
+  sfm_constraints_sptr constraints ) const
+{
+  if( !tracks )
+  {
+    return;
+  }
+
+  // Frames to reconstruct, with any existing cameras as priors
+  camera_map::map_camera_t priors;
+  if( cameras )
+  {
+    priors = cameras->cameras();
+  }
+  else
+  {
+    for( auto const f : tracks->all_frame_ids() )
+    {
+      priors.emplace( f, nullptr );
+    }
+  }
+
+  // Tracks to reconstruct
+  std::vector< track_sptr > selected_tracks = tracks->tracks();
+  if( landmarks )
+  {
+    auto const& lms = landmarks->landmarks();
+    selected_tracks.erase(
+      std::remove_if( selected_tracks.begin(), selected_tracks.end(),
+                      [ &lms ]( track_sptr const& t ){
+                        return !lms.count( t->id() );
+                      } ),
+      selected_tracks.end() );
+  }
+
+  kwiversys::SystemTools::RemoveFile( d_->database_path );
+
+  database_index index;
+  {
+    colmap::Database database{ d_->database_path };
+    index = write_database(
+      database, priors, selected_tracks,
+      d_->default_intrinsics( selected_tracks, priors, constraints ),
+      d_->db_options );
+  }
+  LOG_DEBUG( logger(), "Wrote " << index.frames.size() << " frames and "
+                                << selected_tracks.size() << " tracks to "
+                                << d_->database_path );
+
+  colmap::IncrementalMapperOptions options;
+  options.num_threads = d_->num_threads;
+  options.min_num_matches = d_->min_num_matches;
+  options.min_model_size = d_->min_model_size;
+  options.multiple_models = false;
+  options.extract_colors = false;
+  options.ba_refine_focal_length = d_->refine_focal_length;
+  options.ba_refine_principal_point = d_->refine_principal_point;
+  options.ba_refine_extra_params = d_->refine_extra_params;
+
+  // No image is read, since the colors are not extracted
+  colmap::ReconstructionManager reconstructions;
+  colmap::IncrementalMapperController mapper{
+    &options, "", d_->database_path, &reconstructions };
+
+  if( m_callback )
+  {
+    mapper.AddCallback(
+      colmap::IncrementalMapperController::NEXT_IMAGE_REG_CALLBACK,
+      [ & ]{
+        camera_map::map_camera_t cams;
+        landmark_map::map_landmark_t lms;
+        read_reconstruction( reconstructions.Get( reconstructions.Size() - 1 ),
+                             index, cams, lms );
+        if( !m_callback( std::make_shared< simple_camera_map >( cams ),
+                         std::make_shared< simple_landmark_map >( lms ),
+                         nullptr ) )
+        {
+          mapper.Stop();
+        }
+      } );
+  }
+
+  mapper.Start();
+  mapper.Wait();
+
+  if( !d_->keep_database )
+  {
+    kwiversys::SystemTools::RemoveFile( d_->database_path );
+  }
+
+  // Keep the reconstruction with the most frames
+  colmap::Reconstruction const* best = nullptr;
+  for( size_t i = 0; i < reconstructions.Size(); ++i )
+  {
+    auto const& r = reconstructions.Get( i );
+    if( !best || r.NumRegImages() > best->NumRegImages() )
+    {
+      best = &r;
+    }
+  }
+
+  camera_map::map_camera_t new_cameras;
+  landmark_map::map_landmark_t new_landmarks;
+  if( best )
+  {
+    read_reconstruction( *best, index, new_cameras, new_landmarks );
+    d_->align( new_cameras, new_landmarks, priors, constraints );
+  }
+  LOG_INFO( logger(), "COLMAP reconstructed " << new_cameras.size()
+                      << " of " << priors.size() << " frames and "
+                      << new_landmarks.size() << " landmarks" );
+
+  cameras = std::make_shared< simple_camera_map >( new_cameras );
+  landmarks = std::make_shared< simple_landmark_map >( new_landmarks );
+}
+
+} // namespace colmap_arrow
+
+} // namespace arrows
+
+} // namespace kwiver
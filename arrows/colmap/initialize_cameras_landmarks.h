@@ -0,0 +1,74 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header for COLMAP initialize_cameras_landmarks algorithm
+
+#ifndef KWIVER_ARROWS_COLMAP_INITIALIZE_CAMERAS_LANDMARKS_H_
+#define KWIVER_ARROWS_COLMAP_INITIALIZE_CAMERAS_LANDMARKS_H_
+
+#include <arrows/colmap/kwiver_algo_colmap_export.h>
+
+#include <vital/algo/initialize_cameras_landmarks.h>
+
+#include <memory>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace colmap_arrow {
+
+/// Initialize cameras and landmarks with the COLMAP incremental mapper.
+///
+/// The feature tracks and any existing cameras are written to a COLMAP
+/// database in one transaction, the multi-threaded COLMAP mapper is run on
+/// the database, and the largest reconstruction is read back. Feature
+/// matching is taken from the tracks, so no images are needed.
+///
+/// Existing cameras are priors of their intrinsics. When at least three of
+/// them, or of the camera position priors of the constraints, are
+/// reconstructed, the reconstruction is aligned to them; otherwise it is in
+/// the arbitrary frame chosen by COLMAP. The progress callback is called
+/// from the mapper thread after each image is registered.
+class KWIVER_ALGO_COLMAP_EXPORT initialize_cameras_landmarks
+  : public vital::algo::initialize_cameras_landmarks
+{
+public:
+  PLUGIN_INFO( "colmap",
+               "Run the COLMAP incremental mapper on feature tracks"
+               " to initialize cameras and landmarks." )
+
+  initialize_cameras_landmarks();
+  virtual ~initialize_cameras_landmarks();
+
+  /// Get this algorithm's \link vital::config_block configuration block
+  /// \endlink
+  vital::config_block_sptr get_configuration() const override;
+  /// Set this algorithm's properties via a config block
+  void set_configuration( vital::config_block_sptr config ) override;
+  /// Check that the algorithm's currently configuration is valid
+  bool check_configuration( vital::config_block_sptr config ) const override;
+
+  /// Initialize the camera and landmark parameters given a set of feature
+  /// tracks
+  void initialize(
+    vital::camera_map_sptr& cameras,
+    vital::landmark_map_sptr& landmarks,
+    vital::feature_track_set_sptr tracks,
+    vital::sfm_constraints_sptr constraints = nullptr ) const override;
+
+private:
+  class priv;
+
+  std::unique_ptr< priv > const d_;
+};
+
+} // namespace colmap_arrow
+
+} // namespace arrows
+
+} // namespace kwiver
+
+#endif
@@ -0,0 +1,42 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Plugin algorithm registration for COLMAP Arrow
+
+#include <arrows/colmap/kwiver_algo_colmap_plugin_export.h>
+
+#include <vital/algo/algorithm_factory.h>
+
+#include <arrows/colmap/initialize_cameras_landmarks.h>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace colmap_arrow {
+
+// ----------------------------------------------------------------------------
+extern "C"
+KWIVER_ALGO_COLMAP_PLUGIN_EXPORT
+void
+register_factories( kwiver::vital::plugin_loader& vpm )
+{
+  kwiver::vital::algorithm_registrar reg( vpm, "arrows.colmap" );
+
+  if( reg.is_module_loaded() )
+  {
+    return;
+  }
+
+  reg.register_algorithm< initialize_cameras_landmarks >();
+
+  reg.mark_module_as_loaded();
+}
+
+} // namespace colmap_arrow
+
+} // namespace arrows
+
+} // namespace kwiver
@@ -0,0 +1,394 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of COLMAP database exchange functions
+
+#include <arrows/colmap/sfm_database.h>
+
+#include <vital/types/camera_perspective.h>
+#include <vital/types/feature_track_set.h>
+#include <vital/types/landmark.h>
+
+#include <colmap/estimators/two_view_geometry.h>
+#include <colmap/feature/types.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace colmap_arrow {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Parameters of the supported camera models are the focal lengths, the
+// principal point, then the leading OpenCV distortion coefficients
+struct camera_model_layout
+{
+  char const* name;
+  size_t num_focal;
+  size_t num_dist;
+};
+
+constexpr camera_model_layout supported_models[] = {
+  { "SIMPLE_PINHOLE", 1, 0 },
+  { "PINHOLE", 2, 0 },
+  { "SIMPLE_RADIAL", 1, 1 },
+  { "RADIAL", 1, 2 },
+  { "OPENCV", 2, 4 },
+};
+
+// ----------------------------------------------------------------------------
+camera_model_layout const*
+find_camera_model( std::string const& name )
+{
+  for( auto const& model : supported_models )
+  {
+    if( name == model.name )
+    {
+      return &model;
+    }
+  }
+  return nullptr;
+}
+
+// ----------------------------------------------------------------------------
+// COLMAP puts the center of the top left pixel at (0.5, 0.5), vital at (0, 0)
+constexpr double pixel_offset = 0.5;
+
+// ----------------------------------------------------------------------------
+colmap::Camera
+to_colmap( vital::camera_intrinsics const& K, bool prior_focal_length,
+           camera_model_layout const& model )
+{
+  auto const pp = K.principal_point();
+  auto const width =
+    K.image_width() ? K.image_width() : static_cast< size_t >( 2 * pp.x() );
+  auto const height =
+    K.image_height() ? K.image_height() : static_cast< size_t >( 2 * pp.y() );
+
+  auto f = K.focal_length();
+  if( f <= 0.0 )
+  {
+    // Same guess as COLMAP for images without focal length metadata
+    f = 1.2 * std::max( width, height );
+    prior_focal_length = false;
+  }
+
+  std::vector< double > params;
+  params.push_back( f );
+  if( model.num_focal == 2 )
+  {
+    params.push_back( f / K.aspect_ratio() );
+  }
+  params.push_back( pp.x() + pixel_offset );
+  params.push_back( pp.y() + pixel_offset );
+
+  auto const d = K.dist_coeffs();
+  for( size_t i = 0; i < model.num_dist; ++i )
+  {
+    params.push_back( i < d.size() ? d[ i ] : 0.0 );
+  }
+
+  colmap::Camera camera;
+  camera.SetModelIdFromName( model.name );
+  camera.SetWidth( width );
+  camera.SetHeight( height );
+  camera.SetParams( params );
+  camera.SetPriorFocalLength( prior_focal_length );
+  return camera;
+}
+
+// ----------------------------------------------------------------------------
+vital::camera_intrinsics_sptr
+to_vital( colmap::Camera const& camera )
+{
+  auto const* const model = find_camera_model( camera.ModelName() );
+  if( !model )
+  {
+    return nullptr;
+  }
+
+  auto const& params = camera.Params();
+  auto const f = params[ 0 ];
+  auto const fy = ( model->num_focal == 2 ? params[ 1 ] : f );
+  auto const pp = vital::vector_2d{ params[ model->num_focal ],
+                                    params[ model->num_focal + 1 ] };
+
+  Eigen::VectorXd d( model->num_dist );
+  for( size_t i = 0; i < model->num_dist; ++i )
+  {
+    d[ i ] = params[ model->num_focal + 2 + i ];
+  }
+
+  return std::make_shared< vital::simple_camera_intrinsics >(
+    f, pp - vital::vector_2d{ pixel_offset, pixel_offset }, f / fy, 0.0, d,
+    static_cast< unsigned >( camera.Width() ),
+    static_cast< unsigned >( camera.Height() ) );
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+bool
+is_supported_camera_model( std::string const& name )
+{
+  return find_camera_model( name ) != nullptr;
+}
+
+// ----------------------------------------------------------------------------
+database_index
+write_database(
+  colmap::Database& database,
+  vital::camera_map::map_camera_t const& cameras,
+  std::vector< vital::track_sptr > const& tracks,
+  vital::simple_camera_intrinsics const& default_intrinsics,
+  database_options const& options )
+{
+  auto const* const model = find_camera_model( options.camera_model );
+  if( !model )
+  {
+    throw std::invalid_argument(
+      "unsupported COLMAP camera model " + options.camera_model );
+  }
+
+  database_index index;
+  index.frames.reserve( cameras.size() );
+  for( auto const& c : cameras )
+  {
+    index.frames.push_back( c.first );
+  }
+  index.tracks.resize( index.frames.size() );
+
+  colmap::DatabaseTransaction transaction{ &database };
+
+  // Cameras and images
+  colmap::camera_t shared_camera_id = 0;
+  for( size_t i = 0; i < index.frames.size(); ++i )
+  {
+    auto const image_id = static_cast< colmap::image_t >( i + 1 );
+    auto const cam =
+      std::dynamic_pointer_cast< vital::camera_perspective >(
+        cameras.at( index.frames[ i ] ) );
+
+    colmap::camera_t camera_id = shared_camera_id;
+    if( !camera_id )
+    {
+      auto camera =
+        cam ? to_colmap( *cam->intrinsics(), true, *model )
+            : to_colmap( default_intrinsics,
+                         default_intrinsics.focal_length() > 0.0, *model );
+      camera.SetCameraId( image_id );
+      camera_id = database.WriteCamera( camera, true );
+      if( options.single_camera )
+      {
+        shared_camera_id = camera_id;
+      }
+    }
+
+    colmap::Image image;
+    image.SetImageId( image_id );
+    image.SetName( std::to_string( index.frames[ i ] ) );
+    image.SetCameraId( camera_id );
+    if( cam )
+    {
+      auto const q = cam->rotation().quaternion();
+      image.SetQvecPrior( Eigen::Vector4d{ q.w(), q.x(), q.y(), q.z() } );
+      image.SetTvecPrior( cam->translation() );
+    }
+    database.WriteImage( image, true );
+  }
+
+  // Keypoints and matches
+  std::vector< colmap::FeatureKeypoints > keypoints( index.frames.size() );
+  std::unordered_map< colmap::image_pair_t, colmap::FeatureMatches > matches;
+
+  struct observation
+  {
+    vital::frame_id_t frame;
+    size_t image;
+    colmap::point2D_t keypoint;
+  };
+
+  std::vector< observation > observations;
+  for( auto const& t : tracks )
+  {
+    observations.clear();
+    for( auto const& ts : *t )
+    {
+      auto const fts =
+        std::dynamic_pointer_cast< vital::feature_track_state >( ts );
+      if( !fts || !fts->feature )
+      {
+        continue;
+      }
+
+      auto const f = fts->frame();
+      auto const it =
+        std::lower_bound( index.frames.begin(), index.frames.end(), f );
+      if( it == index.frames.end() || *it != f )
+      {
+        continue;
+      }
+
+      auto const i = static_cast< size_t >( it - index.frames.begin() );
+      auto const& loc = fts->feature->loc();
+      observations.push_back(
+        { f, i, static_cast< colmap::point2D_t >( keypoints[ i ].size() ) } );
+      keypoints[ i ].emplace_back(
+        static_cast< float >( loc.x() + pixel_offset ),
+        static_cast< float >( loc.y() + pixel_offset ) );
+      index.tracks[ i ].push_back( t->id() );
+    }
+
+    // Track states are in frame order, so the first image of each pair has
+    // the lower ID, as COLMAP expects
+    for( size_t a = 0; a < observations.size(); ++a )
+    {
+      auto const& oa = observations[ a ];
+      for( size_t b = a + 1; b < observations.size(); ++b )
+      {
+        auto const& ob = observations[ b ];
+        if( options.match_window &&
+            ob.frame - oa.frame > options.match_window )
+        {
+          break;
+        }
+        if( ob.image == oa.image )
+        {
+          continue;
+        }
+
+        auto const pair_id = colmap::Database::ImagePairToPairId(
+          static_cast< colmap::image_t >( oa.image + 1 ),
+          static_cast< colmap::image_t >( ob.image + 1 ) );
+        matches[ pair_id ].emplace_back( oa.keypoint, ob.keypoint );
+      }
+    }
+  }
+
+  for( size_t i = 0; i < keypoints.size(); ++i )
+  {
+    database.WriteKeypoints( static_cast< colmap::image_t >( i + 1 ),
+                             keypoints[ i ] );
+  }
+
+  for( auto& m : matches )
+  {
+    colmap::image_t image_id1, image_id2;
+    colmap::Database::PairIdToImagePair( m.first, &image_id1, &image_id2 );
+    database.WriteMatches( image_id1, image_id2, m.second );
+
+    // The tracks are taken as verified; COLMAP still rejects outliers when
+    // estimating the geometry of the reconstruction
+    colmap::TwoViewGeometry geometry;
+    geometry.config = colmap::TwoViewGeometry::UNCALIBRATED;
+    geometry.inlier_matches = std::move( m.second );
+    database.WriteTwoViewGeometry( image_id1, image_id2, geometry );
+  }
+
+  return index;
+}
+
+// ----------------------------------------------------------------------------
+void
+read_reconstruction(
+  colmap::Reconstruction const& reconstruction,
+  database_index const& index,
+  vital::camera_map::map_camera_t& cameras,
+  vital::landmark_map::map_landmark_t& landmarks )
+{
+  // Cameras
+  std::unordered_map< colmap::camera_t, vital::camera_intrinsics_sptr >
+  intrinsics;
+  for( auto const image_id : reconstruction.RegImageIds() )
+  {
+    if( image_id < 1 || image_id > index.frames.size() )
+    {
+      continue;
+    }
+
+    auto const& image = reconstruction.Image( image_id );
+    auto& K = intrinsics[ image.CameraId() ];
+    if( !K )
+    {
+      K = to_vital( reconstruction.Camera( image.CameraId() ) );
+      if( !K )
+      {
+        continue;
+      }
+    }
+
+    auto const& qvec = image.Qvec();
+    auto cam = std::make_shared< vital::simple_camera_perspective >();
+    cam->set_rotation(
+      vital::rotation_d{
+        Eigen::Quaterniond{ qvec[ 0 ], qvec[ 1 ], qvec[ 2 ], qvec[ 3 ] } } );
+    cam->set_translation( image.Tvec() );
+    cam->set_intrinsics( K );
+    cameras[ index.frames[ image_id - 1 ] ] = cam;
+  }
+
+  // Landmark of each track, with the number of observations of the track
+  // it has
+  std::unordered_map< vital::track_id_t,
+                      std::pair< size_t, vital::landmark_sptr > > support;
+  std::vector< vital::track_id_t > point_tracks;
+  for( auto const& p : reconstruction.Points3D() )
+  {
+    auto const& point = p.second;
+
+    point_tracks.clear();
+    for( auto const& e : point.Track().Elements() )
+    {
+      if( e.image_id < 1 || e.image_id > index.tracks.size() )
+      {
+        continue;
+      }
+
+      auto const& image_tracks = index.tracks[ e.image_id - 1 ];
+      if( e.point2D_idx < image_tracks.size() )
+      {
+        point_tracks.push_back( image_tracks[ e.point2D_idx ] );
+      }
+    }
+    if( point_tracks.empty() )
+    {
+      continue;
+    }
+
+    auto lm = std::make_shared< vital::landmark_d >( point.XYZ() );
+    lm->set_observations(
+      static_cast< unsigned >( point.Track().Length() ) );
+
+    std::sort( point_tracks.begin(), point_tracks.end() );
+    for( auto b = point_tracks.begin(); b != point_tracks.end(); )
+    {
+      auto const e = std::upper_bound( b, point_tracks.end(), *b );
+      auto const count = static_cast< size_t >( e - b );
+      auto& s = support[ *b ];
+      if( count > s.first )
+      {
+        s = { count, lm };
+      }
+      b = e;
+    }
+  }
+
+  for( auto const& s : support )
+  {
+    landmarks[ s.first ] = s.second.second;
+  }
+}
+
+} // namespace colmap_arrow
+
+} // namespace arrows
+
+} // namespace kwiver
@@ -0,0 +1,112 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Exchange of structure from motion data with COLMAP databases
+
+#ifndef KWIVER_ARROWS_COLMAP_SFM_DATABASE_H_
+#define KWIVER_ARROWS_COLMAP_SFM_DATABASE_H_
+
+#include <arrows/colmap/kwiver_algo_colmap_export.h>
+
+#include <vital/types/camera_intrinsics.h>
+#include <vital/types/camera_map.h>
+#include <vital/types/landmark_map.h>
+#include <vital/types/track.h>
+
+#include <colmap/base/database.h>
+#include <colmap/base/reconstruction.h>
+
+#include <string>
+#include <vector>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace colmap_arrow {
+
+// ----------------------------------------------------------------------------
+/// Options controlling how tracks and cameras are written to a database.
+struct KWIVER_ALGO_COLMAP_EXPORT database_options
+{
+  /// Name of the COLMAP camera model of the images.
+  std::string camera_model = "SIMPLE_RADIAL";
+
+  /// Share one camera model among all images.
+  bool single_camera = true;
+
+  /// Largest frame gap between two observations of a track written as a
+  /// match; zero matches every pair of observations.
+  unsigned match_window = 0;
+};
+
+// ----------------------------------------------------------------------------
+/// Correspondence between a database and the frames and tracks written to it.
+struct KWIVER_ALGO_COLMAP_EXPORT database_index
+{
+  /// Frame of each image; image \c i has the COLMAP image ID \c i + 1.
+  std::vector< vital::frame_id_t > frames;
+
+  /// Track of each keypoint of each image.
+  std::vector< std::vector< vital::track_id_t > > tracks;
+};
+
+/// Test if a COLMAP camera model can be converted to and from vital.
+///
+/// The supported models are SIMPLE_PINHOLE, PINHOLE, SIMPLE_RADIAL, RADIAL
+/// and OPENCV.
+KWIVER_ALGO_COLMAP_EXPORT
+bool is_supported_camera_model( std::string const& name );
+
+/// Write feature tracks and camera priors to a COLMAP database.
+///
+/// One image is written for each frame in \p cameras, in increasing frame
+/// order. Non-null perspective cameras are written as priors of the
+/// intrinsics and pose of their image; the other images are given
+/// \p default_intrinsics, whose focal length is a prior only if it is
+/// positive. Intrinsics must have an image size.
+///
+/// Observations of \p tracks on those frames are written as keypoints, and
+/// each pair of observations of a track, within the match window, as a
+/// match which has been geometrically verified. Everything is written in a
+/// single transaction.
+///
+/// \returns The correspondence from images and keypoints to frames and
+///          tracks, needed by read_reconstruction()
+KWIVER_ALGO_COLMAP_EXPORT
+database_index write_database(
+  colmap::Database& database,
+  vital::camera_map::map_camera_t const& cameras,
+  std::vector< vital::track_sptr > const& tracks,
+  vital::simple_camera_intrinsics const& default_intrinsics,
+  database_options const& options = {} );
+
+/// Convert a COLMAP reconstruction to cameras and landmarks.
+///
+/// A camera is added for the frame of each registered image, and a landmark
+/// for each track observed by a 3D point. When COLMAP has merged several
+/// tracks into one point, the point is the landmark of each of them; when
+/// it has split a track, the landmark of the track is the point with the
+/// most observations of it.
+///
+/// \param reconstruction Reconstruction of a database written by
+///                       write_database()
+/// \param index Value returned by write_database()
+/// \param [out] cameras Map to which cameras are added
+/// \param [out] landmarks Map to which landmarks are added
+KWIVER_ALGO_COLMAP_EXPORT
+void read_reconstruction(
+  colmap::Reconstruction const& reconstruction,
+  database_index const& index,
+  vital::camera_map::map_camera_t& cameras,
+  vital::landmark_map::map_landmark_t& landmarks );
+
+} // namespace colmap_arrow
+
+} // namespace arrows
+
+} // namespace kwiver
+
+#endif
@@ -0,0 +1,134 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include <test_scene.h>
+
+#include <arrows/colmap/initialize_cameras_landmarks.h>
+#include <arrows/colmap/sfm_database.h>
+#include <arrows/mvg/metrics.h>
+#include <arrows/mvg/projected_track_set.h>
+
+#include <vital/plugin_loader/plugin_manager.h>
+
+#include <kwiversys/SystemTools.hxx>
+
+#include <gtest/gtest.h>
+
+using namespace kwiver::vital;
+namespace kac = kwiver::arrows::colmap_arrow;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+constexpr frame_id_t num_frames = 20;
+constexpr landmark_id_t num_landmarks = 100;
+
+// ----------------------------------------------------------------------------
+struct sfm_scene
+{
+  sfm_scene()
+    : landmarks{ kwiver::testing::noisy_landmarks(
+                   kwiver::testing::init_landmarks( num_landmarks ), 1.0 ) },
+      cameras{ kwiver::testing::camera_seq( num_frames ) },
+      tracks{ kwiver::arrows::mvg::projected_tracks( landmarks, cameras ) }
+  {
+  }
+
+  landmark_map_sptr landmarks;
+  camera_map_sptr cameras;
+  feature_track_set_sptr tracks;
+};
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+TEST(sfm_database, write_database)
+{
+  sfm_scene scene;
+  std::string const path = "test_sfm_database.db";
+  kwiversys::SystemTools::RemoveFile( path );
+
+  camera_map::map_camera_t frames;
+  for ( frame_id_t f = 0; f < num_frames; ++f )
+  {
+    frames.emplace( f, nullptr );
+  }
+  frames[ 0 ] = scene.cameras->cameras().at( 0 );
+
+  simple_camera_intrinsics const K{ 0.0, { 640, 480 }, 1.0, 0.0, {},
+                                    1280, 960 };
+  kac::database_options options;
+  options.camera_model = "PINHOLE";
+  options.match_window = 1;
+
+  colmap::Database database{ path };
+  auto const index =
+    kac::write_database( database, frames, scene.tracks->tracks(), K,
+                         options );
+
+  ASSERT_EQ( num_frames, index.frames.size() );
+  EXPECT_EQ( 7, index.frames[ 7 ] );
+  EXPECT_EQ( num_landmarks, index.tracks[ 7 ].size() );
+
+  EXPECT_EQ( num_frames, database.NumImages() );
+  EXPECT_EQ( 1, database.NumCameras() );
+  EXPECT_EQ( num_landmarks, database.NumKeypointsForImage( 8 ) );
+  EXPECT_EQ( ( num_frames - 1 ) * num_landmarks, database.NumInlierMatches() );
+
+  // The camera of the first frame is the prior of the shared intrinsics
+  auto const camera = database.ReadCamera( 1 );
+  EXPECT_TRUE( camera.HasPriorFocalLength() );
+  ASSERT_EQ( 4, camera.Params().size() );
+  EXPECT_DOUBLE_EQ( 1000.0, camera.Params()[ 0 ] );
+  EXPECT_DOUBLE_EQ( 640.5, camera.Params()[ 2 ] );
+
+  database.Close();
+  kwiversys::SystemTools::RemoveFile( path );
+}
+
+// ----------------------------------------------------------------------------
+TEST(sfm_database, initialize_cameras_landmarks)
+{
+  plugin_manager::instance().load_all_plugins();
+  EXPECT_NE( nullptr, algo::initialize_cameras_landmarks::create( "colmap" ) );
+
+  sfm_scene scene;
+  kac::initialize_cameras_landmarks init;
+  auto config = init.get_configuration();
+  config->set_value( "database_path", "test_initialize.db" );
+  config->set_value( "camera_model", "SIMPLE_PINHOLE" );
+  ASSERT_TRUE( init.check_configuration( config ) );
+  init.set_configuration( config );
+
+  // The true cameras are the priors, so the solution is aligned to them
+  camera_map_sptr cameras = scene.cameras;
+  landmark_map_sptr landmarks;
+  init.initialize( cameras, landmarks, scene.tracks );
+
+  ASSERT_EQ( num_frames, cameras->size() );
+  EXPECT_EQ( num_landmarks, landmarks->size() );
+
+  auto const rmse = kwiver::arrows::mvg::reprojection_rmse(
+    cameras->cameras(), landmarks->landmarks(), scene.tracks->tracks() );
+  EXPECT_LE( rmse, 1e-3 );
+
+  for ( auto const& c : cameras->cameras() )
+  {
+    auto const cam =
+      std::dynamic_pointer_cast< camera_perspective >( c.second );
+    auto const truth =
+      std::dynamic_pointer_cast< camera_perspective >(
+        scene.cameras->cameras().at( c.first ) );
+    ASSERT_NE( nullptr, cam );
+    EXPECT_LE( ( cam->center() - truth->center() ).norm(), 1e-3 );
+  }
+
+  EXPECT_FALSE( kwiversys::SystemTools::FileExists( "test_initialize.db" ) );
+}
@@ -0,0 +1,608 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "bench.h"
+
+#include <vital/algo/algorithm_factory.h>
+#include <vital/algo/detect_features.h>
+#include <vital/algo/estimate_homography.h>
+#include <vital/algo/extract_descriptors.h>
+#include <vital/algo/filter_features.h>
+#include <vital/algo/image_filter.h>
+#include <vital/algo/image_io.h>
+#include <vital/algo/match_features.h>
+
+#include <vital/config/config_block_io.h>
+
+#include <vital/types/descriptor_set.h>
+#include <vital/types/feature_set.h>
+#include <vital/types/image_container.h>
+#include <vital/types/match_set.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace kv = kwiver::vital;
+namespace kva = kwiver::vital::algo;
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Sizes of the generated inputs
+struct bench_sizes
+{
+  size_t width = 1280;
+  size_t height = 720;
+  size_t num_images = 4;
+  size_t num_features = 2000;
+  size_t num_points = 500;
+  double outlier_fraction = 0.3;
+};
+
+// ----------------------------------------------------------------------------
+// Inputs shared by the benchmarks. Everything is generated from a fixed seed
+// so that runs are comparable.
+struct bench_inputs
+{
+  bench_sizes sizes;
+  std::vector< kv::image_container_sptr > images;
+  std::mt19937 rng{ 5489u };
+};
+
+// One iteration of a benchmark; takes the iteration number and returns the
+// number of items (features, matches, inliers, ...) it produced
+using bench_iteration = std::function< size_t ( size_t ) >;
+
+// Binds an algorithm to the inputs of its type
+using bench_setup =
+  std::function< bench_iteration ( kv::algorithm_sptr const&,
+                                    bench_inputs& ) >;
+
+// ----------------------------------------------------------------------------
+// Make a gray image of random rectangles over a noisy background, which gives
+// detectors corners and edges at every scale
+kv::image_container_sptr
+make_image( size_t width, size_t height, std::mt19937& rng )
+{
+  kv::image_of< uint8_t > image( width, height );
+
+  std::normal_distribution< double > noise( 0.0, 4.0 );
+  for( size_t j = 0; j < height; ++j )
+  {
+    for( size_t i = 0; i < width; ++i )
+    {
+      auto const value = 128.0 + noise( rng );
+      image( i, j ) = static_cast< uint8_t >(
+        std::min( 255.0, std::max( 0.0, value ) ) );
+    }
+  }
+
+  std::uniform_int_distribution< size_t > x( 0, width - 1 );
+  std::uniform_int_distribution< size_t > y( 0, height - 1 );
+  std::uniform_int_distribution< size_t > extent( 4, 64 );
+  std::uniform_int_distribution< int > intensity( 0, 255 );
+  for( size_t n = 0; n < width * height / 2000; ++n )
+  {
+    auto const x0 = x( rng );
+    auto const y0 = y( rng );
+    auto const x1 = std::min( width, x0 + extent( rng ) );
+    auto const y1 = std::min( height, y0 + extent( rng ) );
+    auto const value = static_cast< uint8_t >( intensity( rng ) );
+    for( size_t j = y0; j < y1; ++j )
+    {
+      for( size_t i = x0; i < x1; ++i )
+      {
+        image( i, j ) = value;
+      }
+    }
+  }
+
+  return std::make_shared< kv::simple_image_container >( image );
+}
+
+// ----------------------------------------------------------------------------
+// Make features at random locations within an image
+kv::feature_set_sptr
+make_features( bench_sizes const& sizes, std::mt19937& rng )
+{
+  std::uniform_real_distribution< double > x( 16.0, sizes.width - 16.0 );
+  std::uniform_real_distribution< double > y( 16.0, sizes.height - 16.0 );
+  std::uniform_real_distribution< double > scale( 1.0, 8.0 );
+  std::uniform_real_distribution< double > angle( -3.14159, 3.14159 );
+  std::uniform_real_distribution< double > magnitude( 0.0, 1.0 );
+
+  std::vector< kv::feature_sptr > features;
+  for( size_t n = 0; n < sizes.num_features; ++n )
+  {
+    features.push_back(
+      std::make_shared< kv::feature_d >(
+        kv::vector_2d{ x( rng ), y( rng ) },
+        magnitude( rng ), scale( rng ), angle( rng ) ) );
+  }
+  return std::make_shared< kv::simple_feature_set >( features );
+}
+
+// ----------------------------------------------------------------------------
+// Make random 256-bit binary descriptors, as produced by ORB or BRISK
+kv::descriptor_set_sptr
+make_descriptors( size_t count, std::mt19937& rng )
+{
+  std::uniform_int_distribution< int > byte( 0, 255 );
+
+  std::vector< kv::descriptor_sptr > descriptors;
+  for( size_t n = 0; n < count; ++n )
+  {
+    auto d = std::make_shared< kv::descriptor_dynamic< uint8_t > >( 32 );
+    for( size_t k = 0; k < 32; ++k )
+    {
+      d->raw_data()[ k ] = static_cast< uint8_t >( byte( rng ) );
+    }
+    descriptors.push_back( d );
+  }
+  return std::make_shared< kv::simple_descriptor_set >( descriptors );
+}
+
+// ----------------------------------------------------------------------------
+// Image at iteration i, cycling through the inputs
+kv::image_container_sptr
+image_at( bench_inputs& inputs, size_t i )
+{
+  if( inputs.images.empty() )
+  {
+    for( size_t n = 0; n < inputs.sizes.num_images; ++n )
+    {
+      inputs.images.push_back(
+        make_image( inputs.sizes.width, inputs.sizes.height, inputs.rng ) );
+    }
+  }
+  return inputs.images[ i % inputs.images.size() ];
+}
+
+// ----------------------------------------------------------------------------
+bench_iteration
+setup_detect_features( kv::algorithm_sptr const& algorithm,
+                       bench_inputs& inputs )
+{
+  auto const algo =
+    std::dynamic_pointer_cast< kva::detect_features >( algorithm );
+  image_at( inputs, 0 );
+  return [ algo, &inputs ]( size_t i ){
+           auto const f = algo->detect( image_at( inputs, i ) );
+           return f ? f->size() : 0;
+         };
+}
+
+// ----------------------------------------------------------------------------
+bench_iteration
+setup_extract_descriptors( kv::algorithm_sptr const& algorithm,
+                           bench_inputs& inputs )
+{
+  auto const algo =
+    std::dynamic_pointer_cast< kva::extract_descriptors >( algorithm );
+  image_at( inputs, 0 );
+  auto const features = make_features( inputs.sizes, inputs.rng );
+  return [ algo, features, &inputs ]( size_t i ){
+           // Extractors may drop features, so each call gets its own set
+           auto f = features;
+           auto const d = algo->extract( image_at( inputs, i ), f );
+           return d ? d->size() : 0;
+         };
+}
+
+// ----------------------------------------------------------------------------
+// Match a set of features against a shifted, shuffled copy whose descriptors
+// have a few bits flipped
+bench_iteration
+setup_match_features( kv::algorithm_sptr const& algorithm,
+                      bench_inputs& inputs )
+{
+  auto const algo =
+    std::dynamic_pointer_cast< kva::match_features >( algorithm );
+
+  auto const feat1 = make_features( inputs.sizes, inputs.rng );
+  auto const desc1 = make_descriptors( feat1->size(), inputs.rng );
+  auto const features1 = feat1->features();
+
+  std::vector< size_t > order( feat1->size() );
+  std::iota( order.begin(), order.end(), size_t{ 0 } );
+  std::shuffle( order.begin(), order.end(), inputs.rng );
+
+  std::uniform_int_distribution< int > bit( 0, 255 );
+  std::vector< kv::feature_sptr > features;
+  std::vector< kv::descriptor_sptr > descriptors;
+  for( auto const n : order )
+  {
+    auto f = std::make_shared< kv::feature_d >( *features1[ n ] );
+    f->set_loc( f->get_loc() + kv::vector_2d{ 5.0, 3.0 } );
+    features.push_back( f );
+
+    auto const d = desc1->at( n )->clone();
+    auto* const bytes =
+      std::dynamic_pointer_cast< kv::descriptor_dynamic< uint8_t > >( d )
+      ->raw_data();
+    for( int k = 0; k < 8; ++k )
+    {
+      auto const b = bit( inputs.rng );
+      bytes[ b / 8 ] ^= static_cast< uint8_t >( 1 << ( b % 8 ) );
+    }
+    descriptors.push_back( d );
+  }
+  auto const feat2 = std::make_shared< kv::simple_feature_set >( features );
+  auto const desc2 =
+    std::make_shared< kv::simple_descriptor_set >( descriptors );
+
+  return [ = ]( size_t ){
+           auto const m = algo->match( feat1, desc1, feat2, desc2 );
+           return m ? m->size() : 0;
+         };
+}
+
+// ----------------------------------------------------------------------------
+// Estimate a homography from noisy correspondences with outliers
+bench_iteration
+setup_estimate_homography( kv::algorithm_sptr const& algorithm,
+                           bench_inputs& inputs )
+{
+  auto const algo =
+    std::dynamic_pointer_cast< kva::estimate_homography >( algorithm );
+  auto const& sizes = inputs.sizes;
+
+  Eigen::Matrix3d h;
+  h << 0.9, 0.05, 20.0,
+       -0.04, 1.1, -10.0,
+       1e-5, 2e-5, 1.0;
+
+  std::uniform_real_distribution< double > x( 0.0, sizes.width );
+  std::uniform_real_distribution< double > y( 0.0, sizes.height );
+  std::uniform_real_distribution< double > unit( 0.0, 1.0 );
+  std::normal_distribution< double > noise( 0.0, 0.5 );
+
+  std::vector< kv::vector_2d > pts1, pts2;
+  for( size_t n = 0; n < sizes.num_points; ++n )
+  {
+    kv::vector_2d const p{ x( inputs.rng ), y( inputs.rng ) };
+    pts1.push_back( p );
+    if( unit( inputs.rng ) < sizes.outlier_fraction )
+    {
+      pts2.push_back( { x( inputs.rng ), y( inputs.rng ) } );
+    }
+    else
+    {
+      Eigen::Vector3d const q = h * Eigen::Vector3d{ p.x(), p.y(), 1.0 };
+      pts2.push_back(
+        q.head< 2 >() / q.z() +
+        kv::vector_2d{ noise( inputs.rng ), noise( inputs.rng ) } );
+    }
+  }
+
+  return [ = ]( size_t ){
+           std::vector< bool > inliers;
+           algo->estimate( pts1, pts2, inliers );
+           return static_cast< size_t >(
+             std::count( inliers.begin(), inliers.end(), true ) );
+         };
+}
+
+// ----------------------------------------------------------------------------
+bench_iteration
+setup_filter_features( kv::algorithm_sptr const& algorithm,
+                       bench_inputs& inputs )
+{
+  auto const algo =
+    std::dynamic_pointer_cast< kva::filter_features >( algorithm );
+  auto const features = make_features( inputs.sizes, inputs.rng );
+  auto const descriptors =
+    make_descriptors( features->size(), inputs.rng );
+  return [ = ]( size_t ){
+           auto const f = algo->filter( features, descriptors ).first;
+           return f ? f->size() : 0;
+         };
+}
+
+// ----------------------------------------------------------------------------
+bench_iteration
+setup_image_filter( kv::algorithm_sptr const& algorithm,
+                    bench_inputs& inputs )
+{
+  auto const algo =
+    std::dynamic_pointer_cast< kva::image_filter >( algorithm );
+  image_at( inputs, 0 );
+  return [ algo, &inputs ]( size_t i ){
+           return algo->filter( image_at( inputs, i ) ) ? 1 : 0;
+         };
+}
+
+// ----------------------------------------------------------------------------
+std::map< std::string, bench_setup > const&
+bench_setups()
+{
+  static std::map< std::string, bench_setup > const setups = {
+    { kva::detect_features::static_type_name(), setup_detect_features },
+    { kva::estimate_homography::static_type_name(),
+      setup_estimate_homography },
+    { kva::extract_descriptors::static_type_name(),
+      setup_extract_descriptors },
+    { kva::filter_features::static_type_name(), setup_filter_features },
+    { kva::image_filter::static_type_name(), setup_image_filter },
+    { kva::match_features::static_type_name(), setup_match_features },
+  };
+  return setups;
+}
+
+// ----------------------------------------------------------------------------
+// Peak resident set size of this process in kilobytes, or zero if unknown
+size_t
+peak_memory_kb()
+{
+#ifndef _WIN32
+  rusage usage;
+  if( getrusage( RUSAGE_SELF, &usage ) == 0 )
+  {
+#ifdef __APPLE__
+    return static_cast< size_t >( usage.ru_maxrss / 1024 );
+#else
+    return static_cast< size_t >( usage.ru_maxrss );
+#endif
+  }
+#endif
+  return 0;
+}
+
+// ----------------------------------------------------------------------------
+// Nearest-rank percentile of sorted values
+double
+percentile( std::vector< double > const& sorted, double p )
+{
+  auto const rank = static_cast< size_t >(
+    std::ceil( p / 100.0 * static_cast< double >( sorted.size() ) ) );
+  return sorted[ std::min( sorted.size(), std::max( rank, size_t{ 1 } ) ) -
+                 1 ];
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+bench_applet
+::bench_applet()
+{}
+
+// ----------------------------------------------------------------------------
+void
+bench_applet
+::add_command_options()
+{
+  std::string types;
+  for( auto const& s : bench_setups() )
+  {
+    types += ( types.empty() ? "" : ", " ) + s.first;
+  }
+
+  m_cmd_options->custom_help( wrap_text(
+    "[options]\n"
+    "This program runs an algorithm implementation repeatedly and reports "
+    "its throughput, latency percentiles and peak memory. Images are "
+    "generated unless image files are given. Supported algorithm types "
+    "are: " + types + "." ) );
+
+  m_cmd_options->add_options()                                    //
+    ( "h,help", "Display applet usage." )                         //
+    ( "t,type", "Algorithm type to benchmark.",
+    ::cxxopts::value< std::string >(), "type" )                   //
+    ( "i,impl", "Implementation of the algorithm to benchmark.",
+    ::cxxopts::value< std::string >(), "name" )                   //
+    ( "c,config", "Specify configuration file. The algorithm is "
+      "configured from its \"algorithm\" block.",
+    ::cxxopts::value< std::string >(), "file" )                   //
+    ( "s,setting", "Set an algorithm parameter.",
+    ::cxxopts::value< std::vector< std::string > >(), "key=value" ) //
+    ( "image", "Image file to use as input; may be repeated.",
+    ::cxxopts::value< std::vector< std::string > >(), "file" )    //
+    ( "n,iterations", "Number of timed iterations.",
+    ::cxxopts::value< size_t >()->default_value( "20" ), "count" ) //
+    ( "warmup", "Number of untimed iterations run first.",
+    ::cxxopts::value< size_t >()->default_value( "2" ), "count" ) //
+    ( "width", "Width of generated images.",
+    ::cxxopts::value< size_t >()->default_value( "1280" ), "pixels" ) //
+    ( "height", "Height of generated images.",
+    ::cxxopts::value< size_t >()->default_value( "720" ), "pixels" ) //
+    ( "features", "Number of generated features and descriptors.",
+    ::cxxopts::value< size_t >()->default_value( "2000" ), "count" ) //
+    ( "points", "Number of generated point correspondences.",
+    ::cxxopts::value< size_t >()->default_value( "500" ), "count" );
+}
+
+// ----------------------------------------------------------------------------
+int
+bench_applet
+::run()
+{
+  auto& cmd_args = command_args();
+
+  if( cmd_args[ "help" ].as< bool >() )
+  {
+    std::cout << m_cmd_options->help();
+    return EXIT_SUCCESS;
+  }
+
+  // Assemble configuration
+  auto config = find_configuration( "applets/bench.conf" );
+  if( cmd_args.count( "config" ) )
+  {
+    auto const& config_filename = cmd_args[ "config" ].as< std::string >();
+    config->merge_config( kv::read_config_file( config_filename ) );
+  }
+  if( cmd_args.count( "impl" ) )
+  {
+    config->set_value(
+      "algorithm:type", cmd_args[ "impl" ].as< std::string >() );
+  }
+
+  std::string type;
+  if( cmd_args.count( "type" ) )
+  {
+    type = cmd_args[ "type" ].as< std::string >();
+  }
+  auto const setup = bench_setups().find( type );
+  if( setup == bench_setups().end() )
+  {
+    std::cerr << "Missing or unsupported algorithm type \"" << type
+              << "\".\n" << m_cmd_options->help();
+    return EXIT_FAILURE;
+  }
+
+  auto const impl =
+    config->get_value< std::string >( "algorithm:type", "" );
+  if( !kv::has_algorithm_impl_name( type, impl ) )
+  {
+    std::cerr << "No implementation \"" << impl << "\" of " << type
+              << " is registered." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if( cmd_args.count( "setting" ) )
+  {
+    for( auto const& setting :
+         cmd_args[ "setting" ].as< std::vector< std::string > >() )
+    {
+      auto const split = setting.find( '=' );
+      if( split == std::string::npos )
+      {
+        std::cerr << "Invalid setting \"" << setting
+                  << "\"; expected key=value." << std::endl;
+        return EXIT_FAILURE;
+      }
+      config->set_value( "algorithm:" + impl + ":" +
+                         setting.substr( 0, split ),
+                         setting.substr( split + 1 ) );
+    }
+  }
+
+  if( !kv::algorithm::check_nested_algo_configuration(
+        type, "algorithm", config ) )
+  {
+    std::cerr << "Invalid algorithm config" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  kv::algorithm_sptr algorithm;
+  kv::algorithm::set_nested_algo_configuration(
+    type, "algorithm", config, algorithm );
+  if( !algorithm )
+  {
+    std::cerr << "Failed to initialize algorithm." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bench_inputs inputs;
+  inputs.sizes.width = cmd_args[ "width" ].as< size_t >();
+  inputs.sizes.height = cmd_args[ "height" ].as< size_t >();
+  inputs.sizes.num_features = cmd_args[ "features" ].as< size_t >();
+  inputs.sizes.num_points = cmd_args[ "points" ].as< size_t >();
+  if( !inputs.sizes.width || !inputs.sizes.height )
+  {
+    std::cerr << "Image size must not be zero." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if( cmd_args.count( "image" ) )
+  {
+    if( !kva::image_io::check_nested_algo_configuration(
+          "image_reader", config ) )
+    {
+      std::cerr << "Invalid image_reader config" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    kva::image_io_sptr reader;
+    kva::image_io::set_nested_algo_configuration(
+      "image_reader", config, reader );
+    for( auto const& filename :
+         cmd_args[ "image" ].as< std::vector< std::string > >() )
+    {
+      inputs.images.push_back( reader->load( filename ) );
+    }
+  }
+
+  auto const iterations = cmd_args[ "iterations" ].as< size_t >();
+  auto const warmup = cmd_args[ "warmup" ].as< size_t >();
+  if( !iterations )
+  {
+    std::cerr << "At least one iteration is required." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  auto const iteration = setup->second( algorithm, inputs );
+  auto const setup_memory = peak_memory_kb();
+
+  for( size_t i = 0; i < warmup; ++i )
+  {
+    iteration( i );
+  }
+
+  using clock = std::chrono::steady_clock;
+  std::vector< double > latencies;
+  size_t items = 0;
+  auto const start = clock::now();
+  for( size_t i = 0; i < iterations; ++i )
+  {
+    auto const t0 = clock::now();
+    items += iteration( warmup + i );
+    latencies.push_back(
+      std::chrono::duration< double, std::milli >( clock::now() - t0 )
+      .count() );
+  }
+  auto const elapsed =
+    std::chrono::duration< double >( clock::now() - start ).count();
+  auto const peak_memory = peak_memory_kb();
+
+  std::sort( latencies.begin(), latencies.end() );
+
+  std::cout << std::fixed << std::setprecision( 3 )
+            << type << " \"" << impl << "\", " << iterations
+            << " iterations\n"
+            << "  throughput:   " << iterations / elapsed << " calls/s, "
+            << items / elapsed << " items/s\n"
+            << "  items/call:   "
+            << static_cast< double >( items ) / iterations << "\n"
+            << "  latency (ms): min " << latencies.front()
+            << ", p50 " << percentile( latencies, 50.0 )
+            << ", p90 " << percentile( latencies, 90.0 )
+            << ", p99 " << percentile( latencies, 99.0 )
+            << ", max " << latencies.back() << "\n";
+  if( peak_memory )
+  {
+    std::cout << "  peak memory:  " << peak_memory << " kB ("
+              << ( peak_memory - setup_memory ) << " kB above setup)\n";
+  }
+  else
+  {
+    std::cout << "  peak memory:  n/a\n";
+  }
+
+  return EXIT_SUCCESS;
+}
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
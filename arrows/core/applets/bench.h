@@ -0,0 +1,40 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_ARROWS_CORE_APPLETS_BENCH_H_
+#define KWIVER_ARROWS_CORE_APPLETS_BENCH_H_
+
+#include <vital/applets/kwiver_applet.h>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+class bench_applet : public tools::kwiver_applet
+{
+public:
+  bench_applet();
+
+  PLUGIN_INFO( "bench",
+               "Benchmark an algorithm implementation.\n\n"
+               "This program loads any registered implementation of a "
+               "supported algorithm type, runs it repeatedly on "
+               "standardized images or synthetic feature, descriptor and "
+               "point sets, and reports its throughput, latency "
+               "percentiles and peak memory." );
+
+  void add_command_options() override;
+
+  int run() override;
+};
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
+
+#endif
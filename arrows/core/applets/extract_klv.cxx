@@ -0,0 +1,221 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "extract_klv.h"
+
+#include <vital/algo/metadata_map_io.h>
+#include <vital/algo/video_input.h>
+
+#include <vital/config/config_block_io.h>
+
+#include <vital/types/metadata_map.h>
+
+#include <vital/util/thread_pool.h>
+
+#include <kwiversys/SystemTools.hxx>
+
+#include <future>
+#include <iostream>
+#include <vector>
+
+namespace kv = kwiver::vital;
+namespace kva = kwiver::vital::algo;
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Algorithms used to extract the metadata of one video. Each video gets its
+// own, since the algorithms are not safe to share between threads.
+struct extraction_job
+{
+  std::string input_filename;
+  std::string output_filename;
+  kva::video_input_sptr input;
+  kva::metadata_map_io_sptr serializer;
+};
+
+// ----------------------------------------------------------------------------
+// Read all metadata from the job's video and serialize it. Returns the number
+// of frames read.
+size_t
+extract( extraction_job const& job )
+{
+  job.input->open( job.input_filename );
+
+  kv::metadata_map::map_metadata_t frame_metadata;
+  kv::timestamp timestamp;
+  while( job.input->next_frame( timestamp ) )
+  {
+    frame_metadata.emplace(
+      timestamp.get_frame(), job.input->frame_metadata() );
+  }
+  job.input->close();
+
+  job.serializer->save(
+    job.output_filename,
+    std::make_shared< kv::simple_metadata_map >( frame_metadata ) );
+  return frame_metadata.size();
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+extract_klv_applet
+::extract_klv_applet()
+{}
+
+// ----------------------------------------------------------------------------
+void
+extract_klv_applet
+::add_command_options()
+{
+  m_cmd_options->custom_help( wrap_text(
+    "[options] video-file...\n"
+    "This program extracts the metadata of each video file into a file of "
+    "the same name in the output directory. Imagery is not decoded." ) );
+  m_cmd_options->positional_help( "\n  video-file  - names of video files." );
+
+  m_cmd_options->add_options()                        //
+    ( "h,help", "Display applet usage." )             //
+    ( "c,config", "Specify configuration file.",
+    ::cxxopts::value< std::string >(), "file" )       //
+    ( "d,output-dir", "Directory in which to write metadata files. "
+      "Defaults to current directory.",
+    ::cxxopts::value< std::string >(), "path" )       //
+    ( "e,exporter", "Choose the format of the exported metadata. "
+      "Current options are: csv, json, klv-json.",
+    ::cxxopts::value< std::string >(), "format" )     //
+
+    // positional parameters
+    ( "video-file", "Video input files",
+    ::cxxopts::value< std::vector< std::string > >() );
+
+  m_cmd_options->parse_positional( "video-file" );
+}
+
+// ----------------------------------------------------------------------------
+int
+extract_klv_applet
+::run()
+{
+  auto& cmd_args = command_args();
+
+  if( cmd_args[ "help" ].as< bool >() )
+  {
+    std::cout << m_cmd_options->help();
+    return EXIT_SUCCESS;
+  }
+
+  if( !cmd_args.count( "video-file" ) )
+  {
+    std::cerr << "Missing video file name.\n" << m_cmd_options->help();
+    return EXIT_FAILURE;
+  }
+
+  auto const& input_filenames =
+    cmd_args[ "video-file" ].as< std::vector< std::string > >();
+
+  // Assemble configuration
+  auto config = find_configuration( "applets/extract_klv.conf" );
+  if( cmd_args.count( "config" ) )
+  {
+    auto const& config_filename = cmd_args[ "config" ].as< std::string >();
+    config->merge_config( kv::read_config_file( config_filename ) );
+  }
+  if( cmd_args.count( "exporter" ) )
+  {
+    config->set_value(
+      "metadata_serializer:type", cmd_args[ "exporter" ].as< std::string >() );
+  }
+
+  if( !kva::video_input::check_nested_algo_configuration(
+        "video_reader", config ) )
+  {
+    std::cerr << "Invalid video_reader config" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if( !kva::metadata_map_io::check_nested_algo_configuration(
+        "metadata_serializer", config ) )
+  {
+    std::cerr << "Invalid metadata_serializer config" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string output_directory = ".";
+  if( cmd_args.count( "output-dir" ) )
+  {
+    output_directory = cmd_args[ "output-dir" ].as< std::string >();
+  }
+
+  auto const extension =
+    ( config->get_value< std::string >( "metadata_serializer:type" ) == "csv" )
+    ? ".csv" : ".json";
+
+  // Create every job's algorithms up front, on this thread
+  std::vector< extraction_job > jobs;
+  for( auto const& input_filename : input_filenames )
+  {
+    extraction_job job;
+    job.input_filename = input_filename;
+    job.output_filename =
+      kwiversys::SystemTools::JoinPath(
+        { "", output_directory,
+          kwiversys::SystemTools::GetFilenameWithoutLastExtension(
+            input_filename ) + extension } );
+    kva::video_input
+    ::set_nested_algo_configuration( "video_reader", config, job.input );
+    kva::metadata_map_io
+    ::set_nested_algo_configuration(
+      "metadata_serializer", config, job.serializer );
+    if( !job.input || !job.serializer )
+    {
+      std::cerr << "Failed to initialize algorithms." << std::endl;
+      return EXIT_FAILURE;
+    }
+    jobs.emplace_back( std::move( job ) );
+  }
+
+  // Extract in parallel
+  auto& pool = kv::thread_pool::instance();
+  std::vector< std::future< size_t > > results;
+  for( auto const& job : jobs )
+  {
+    results.emplace_back( pool.enqueue( extract, std::cref( job ) ) );
+  }
+
+  // Report in input order
+  auto result = EXIT_SUCCESS;
+  for( size_t i = 0; i < jobs.size(); ++i )
+  {
+    try
+    {
+      auto const frame_count = results[ i ].get();
+      std::cout << "Wrote metadata for " << frame_count << " frames of \""
+                << jobs[ i ].input_filename << "\" to \""
+                << jobs[ i ].output_filename << "\"." << std::endl;
+    }
+    catch( std::exception const& e )
+    {
+      std::cerr << "Failed to extract metadata from \""
+                << jobs[ i ].input_filename << "\": " << e.what()
+                << std::endl;
+      result = EXIT_FAILURE;
+    }
+  }
+
+  return result;
+}
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
@@ -0,0 +1,38 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_ARROWS_CORE_APPLETS_EXTRACT_KLV_H_
+#define KWIVER_ARROWS_CORE_APPLETS_EXTRACT_KLV_H_
+
+#include <vital/applets/kwiver_applet.h>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+class extract_klv_applet : public tools::kwiver_applet
+{
+public:
+  extract_klv_applet();
+
+  PLUGIN_INFO( "extract-klv",
+               "Extract KLV metadata from many videos.\n\n"
+               "This program writes the metadata of each given video to its "
+               "own JSON or CSV file, without decoding imagery. Videos are "
+               "processed in parallel." );
+
+  void add_command_options() override;
+
+  int run() override;
+};
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
+
+#endif
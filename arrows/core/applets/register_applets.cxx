@@ -11,7 +11,9 @@
 #include <vital/plugin_loader/plugin_loader.h>
 #include <vital/applets/applet_registrar.h>
 
+#include <arrows/core/applets/bench.h>
 #include <arrows/core/applets/dump_klv.h>
+#include <arrows/core/applets/extract_klv.h>
 #include <arrows/core/applets/render_mesh.h>
 #include <arrows/core/applets/transcode.h>
 
@@ -33,7 +35,9 @@ register_factories( kwiver::vital::plugin_loader& vpm )
   }
 
   // -- register applets --
+  reg.register_tool< bench_applet >();
   reg.register_tool< dump_klv >();
+  reg.register_tool< extract_klv_applet >();
   reg.register_tool< render_mesh >();
   reg.register_tool< transcode_applet >();
 
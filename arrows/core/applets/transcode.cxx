@@ -10,6 +10,7 @@
 #include <vital/config/config_block_io.h>
 
 #include <iostream>
+#include <limits>
 
 namespace kv = kwiver::vital;
 namespace kva = kwiver::vital::algo;
@@ -52,6 +53,25 @@ check_input( kva::video_input_sptr const& input,
   }
 }
 
+// ----------------------------------------------------------------------------
+kv::frame_id_t
+frame_arg( cxxopts::ParseResult const& cmd_args, std::string const& name,
+           kv::frame_id_t default_value )
+{
+  if( !cmd_args.count( name ) )
+  {
+    return default_value;
+  }
+
+  auto const value = cmd_args[ name ].as< kv::frame_id_t >();
+  if( value < 1 )
+  {
+    std::cerr << "--" << name << ": Frame numbers start at 1." << std::endl;
+    exit( EXIT_FAILURE );
+  }
+  return value;
+}
+
 // ----------------------------------------------------------------------------
 void
 check_output( kva::video_output_sptr const& output,
@@ -86,7 +106,15 @@ ::add_command_options()
     ::cxxopts::value< std::string >(), "file" )  //
     ( "o,output", "Specify output video file.",
     ::cxxopts::value< std::string >(), "file" )  //
-    ( "copy-video", "Directly copy raw video without modification." )
+    ( "start-frame", "First frame to write. Defaults to the first frame.",
+    ::cxxopts::value< kv::frame_id_t >(), "frame" )  //
+    ( "end-frame", "Last frame to write. Defaults to the last frame.",
+    ::cxxopts::value< kv::frame_id_t >(), "frame" )  //
+    ( "copy-video",
+      "Directly copy raw video without modification. Frames before the "
+      "first keyframe, such as those at a start frame in the middle of a "
+      "group of pictures, are encoded instead, which requires the output to "
+      "use the input's codec." )
     ( "copy-metadata", "Directly copy raw metadata without modification." );
 }
 
@@ -122,6 +150,17 @@ ::run()
 
   auto const& output_filename = cmd_args[ "output" ].as< std::string >();
 
+  // Parse frame range
+  auto const start_frame = frame_arg( cmd_args, "start-frame", 1 );
+  auto const end_frame =
+    frame_arg(
+      cmd_args, "end-frame", std::numeric_limits< kv::frame_id_t >::max() );
+  if( end_frame < start_frame )
+  {
+    std::cerr << "--end-frame must not be before --start-frame." << std::endl;
+    return EXIT_FAILURE;
+  }
+
   // Assemble configuration
   auto config = find_configuration( "applets/transcode.conf" );
   if( cmd_args.count( "config" ) )
@@ -150,13 +189,28 @@ ::run()
   check_output( output, cmd_args );
   output->open( output_filename, video_settings.get() );
 
-  // Transcode frames
+  // Skip to the start frame, seeking if possible
   kv::timestamp timestamp;
-  for( input->next_frame( timestamp );
-       !input->end_of_video();
+  auto const can_seek =
+    input->get_implementation_capabilities().has_capability(
+      kva::video_input::IS_SEEKABLE );
+  if( !( start_frame > 1 && can_seek &&
+         input->seek_frame( timestamp, start_frame ) ) )
+  {
+    input->next_frame( timestamp );
+  }
+  while( !input->end_of_video() && timestamp.get_frame() < start_frame )
+  {
+    input->next_frame( timestamp );
+  }
+
+  // Transcode frames
+  auto copying_video = false;
+  for( ; !input->end_of_video() && timestamp.get_frame() <= end_frame;
        input->next_frame( timestamp ) )
   {
-    // Transcode image
+    // Transcode image. When copying, frames are encoded until a keyframe,
+    // after which the packets are copied without decoding them again
     if( cmd_args.count( "copy-video" ) )
     {
       auto const image = input->raw_frame_image();
@@ -166,7 +220,12 @@ ::run()
                   << "." << std::endl;
         exit(-1);
       }
-      output->add_image( *image );
+      copying_video = copying_video || image->is_keyframe;
+    }
+
+    if( copying_video )
+    {
+      output->add_image( *input->raw_frame_image() );
     }
     else
     {
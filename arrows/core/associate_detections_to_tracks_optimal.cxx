@@ -0,0 +1,462 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of associate_detections_to_tracks_optimal
+
+#include "associate_detections_to_tracks_optimal.h"
+
+#include <vital/exceptions/base.h>
+#include <vital/types/object_track_set.h>
+#include <vital/util/thread_pool.h>
+#include <vital/vital_config.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+using namespace kwiver::vital;
+
+namespace {
+
+constexpr unsigned no_match = std::numeric_limits< unsigned >::max();
+
+/// An admissible pairing of a track with a detection
+struct edge
+{
+  unsigned track;
+  unsigned detection;
+  double cost;
+};
+
+/// A connected component of the graph of admissible pairings
+struct component
+{
+  std::vector< unsigned > tracks;
+  std::vector< unsigned > detections;
+  std::vector< edge > edges;
+};
+
+// ----------------------------------------------------------------------------
+/// Find the representative of node \p n, compressing the path to it
+unsigned
+find_root( std::vector< unsigned >& parent, unsigned n )
+{
+  while( parent[n] != n )
+  {
+    parent[n] = parent[ parent[n] ];
+    n = parent[n];
+  }
+  return n;
+}
+
+// ----------------------------------------------------------------------------
+/// Solve a square assignment problem
+///
+/// This is the shortest augmenting path form of the Hungarian method, which
+/// takes O(n^3) time. Entries of \p cost, stored row-major, may be infinite
+/// to forbid a pairing, provided a finite assignment exists.
+///
+/// \returns the column assigned to each row
+std::vector< size_t >
+solve_assignment( std::vector< double > const& cost, size_t n )
+{
+  double const inf = std::numeric_limits< double >::infinity();
+
+  // Potentials and matches are indexed from 1; column 0 is a sentinel
+  std::vector< double > u( n + 1, 0.0 ), v( n + 1, 0.0 );
+  std::vector< size_t > row_of( n + 1, 0 ), way( n + 1, 0 );
+
+  std::vector< double > min_slack( n + 1 );
+  std::vector< char > used( n + 1 );
+
+  for( size_t i = 1; i <= n; ++i )
+  {
+    row_of[0] = i;
+    size_t j0 = 0;
+    std::fill( min_slack.begin(), min_slack.end(), inf );
+    std::fill( used.begin(), used.end(), 0 );
+
+    do
+    {
+      used[j0] = 1;
+      size_t const i0 = row_of[j0];
+      double delta = inf;
+      size_t j1 = 0;
+
+      double const* const row = cost.data() + ( i0 - 1 ) * n;
+      for( size_t j = 1; j <= n; ++j )
+      {
+        if( !used[j] )
+        {
+          double const slack = row[ j - 1 ] - u[i0] - v[j];
+          if( slack < min_slack[j] )
+          {
+            min_slack[j] = slack;
+            way[j] = j0;
+          }
+          if( min_slack[j] < delta )
+          {
+            delta = min_slack[j];
+            j1 = j;
+          }
+        }
+      }
+
+      for( size_t j = 0; j <= n; ++j )
+      {
+        if( used[j] )
+        {
+          u[ row_of[j] ] += delta;
+          v[j] -= delta;
+        }
+        else
+        {
+          min_slack[j] -= delta;
+        }
+      }
+      j0 = j1;
+    }
+    while( row_of[j0] != 0 );
+
+    // Flip the matches along the augmenting path
+    do
+    {
+      size_t const j1 = way[j0];
+      row_of[j0] = row_of[j1];
+      j0 = j1;
+    }
+    while( j0 );
+  }
+
+  std::vector< size_t > result( n );
+  for( size_t j = 1; j <= n; ++j )
+  {
+    result[ row_of[j] - 1 ] = j - 1;
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+/// Assign the detections of a component to its tracks
+///
+/// The problem is made square by giving each track a column for staying
+/// unassigned, at \p unassigned_cost, and each detection a row for the
+/// same, at no cost. The dummy rows and columns may pair freely.
+void
+solve_component( component const& c, double unassigned_cost,
+                 std::vector< unsigned >& matches )
+{
+  double const inf = std::numeric_limits< double >::infinity();
+  size_t const nt = c.tracks.size();
+  size_t const nd = c.detections.size();
+  size_t const n = nt + nd;
+
+  // A single pairing needs no solver
+  if( c.edges.size() == 1 )
+  {
+    matches[ c.edges.front().track ] = c.edges.front().detection;
+    return;
+  }
+
+  std::vector< double > cost( n * n, inf );
+  for( size_t t = 0; t < nt; ++t )
+  {
+    cost[ t * n + nd + t ] = unassigned_cost;
+  }
+  for( size_t d = 0; d < nd; ++d )
+  {
+    double* const row = cost.data() + ( nt + d ) * n;
+    row[d] = 0.0;
+    std::fill( row + nd, row + n, 0.0 );
+  }
+
+  // Edges refer to the tracks and detections of the full problem
+  auto const local = []( std::vector< unsigned > const& ids, unsigned id )
+  {
+    return static_cast< size_t >(
+      std::lower_bound( ids.begin(), ids.end(), id ) - ids.begin() );
+  };
+  for( auto const& e : c.edges )
+  {
+    cost[ local( c.tracks, e.track ) * n +
+          local( c.detections, e.detection ) ] = e.cost;
+  }
+
+  auto const assignment = solve_assignment( cost, n );
+  for( size_t t = 0; t < nt; ++t )
+  {
+    if( assignment[t] < nd )
+    {
+      matches[ c.tracks[t] ] = c.detections[ assignment[t] ];
+    }
+  }
+}
+
+} // end namespace
+
+/// Private implementation class
+class associate_detections_to_tracks_optimal::priv
+{
+public:
+  /// Constructor
+  priv()
+    : threshold( 0.50 )
+    , higher_is_better( true )
+    , m_logger( vital::get_logger(
+        "arrows.core.associate_detections_to_tracks_optimal" ) )
+  {
+  }
+
+  /// Threshold to apply on the matrix
+  double threshold;
+
+  /// Whether to take values above or below the threshold
+  bool higher_is_better;
+
+  /// Logger handle
+  vital::logger_handle_t m_logger;
+};
+
+/// Constructor
+associate_detections_to_tracks_optimal
+::associate_detections_to_tracks_optimal()
+  : d_( new priv )
+{
+}
+
+/// Destructor
+associate_detections_to_tracks_optimal
+::~associate_detections_to_tracks_optimal() noexcept
+{
+}
+
+/// Get this alg's \link vital::config_block configuration block \endlink
+vital::config_block_sptr
+associate_detections_to_tracks_optimal
+::get_configuration() const
+{
+  // get base config from base class
+  vital::config_block_sptr config = algorithm::get_configuration();
+
+  config->set_value( "threshold", d_->threshold,
+    "Threshold to apply on the matrix. Pairs which do not pass it are "
+    "never assigned, and leaving a track unassigned costs as much as an "
+    "assignment with this value." );
+
+  config->set_value( "higher_is_better", d_->higher_is_better,
+    "Whether values above or below the threshold indicate a better fit." );
+
+  return config;
+}
+
+/// Set this algo's properties via a config block
+void
+associate_detections_to_tracks_optimal
+::set_configuration( vital::config_block_sptr in_config )
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config( in_config );
+
+  d_->threshold = config->get_value<double>( "threshold" );
+  d_->higher_is_better = config->get_value<bool>( "higher_is_better" );
+}
+
+bool
+associate_detections_to_tracks_optimal
+::check_configuration( VITAL_UNUSED vital::config_block_sptr config ) const
+{
+  return true;
+}
+
+/// Associate object detections to object tracks
+bool
+associate_detections_to_tracks_optimal
+::associate( kwiver::vital::timestamp ts,
+             kwiver::vital::image_container_sptr /* image */,
+             kwiver::vital::object_track_set_sptr tracks,
+             kwiver::vital::detected_object_set_sptr detections,
+             kwiver::vital::matrix_d matrix,
+             kwiver::vital::object_track_set_sptr& output,
+             kwiver::vital::detected_object_set_sptr& unused ) const
+{
+  auto all_detections = detections;
+  auto all_tracks = tracks->tracks();
+
+  const unsigned track_count = static_cast< unsigned >( all_tracks.size() );
+  const unsigned det_count = static_cast< unsigned >( all_detections->size() );
+
+  if( matrix.size() &&
+      ( static_cast< size_t >( matrix.rows() ) != track_count ||
+        static_cast< size_t >( matrix.cols() ) != det_count ) )
+  {
+    VITAL_THROW( invalid_value,
+                 "Association matrix does not match the tracks and "
+                 "detections" );
+  }
+
+  // Costs are minimized, so negate scores where higher is better
+  const double sign = ( d_->higher_is_better ? -1.0 : 1.0 );
+  const double unassigned_cost = sign * d_->threshold;
+  const double invalid_value = std::numeric_limits< double >::max();
+
+  // Gather the admissible pairings of each track in parallel
+  std::vector< std::vector< edge > > track_edges(
+    matrix.size() ? track_count : 0 );
+
+  auto const gather = [ & ]( size_t begin, size_t end )
+  {
+    for( auto t = begin; t < end; ++t )
+    {
+      for( unsigned d = 0; d < det_count; ++d )
+      {
+        double const value = matrix( t, d );
+
+        if( std::isnan( value ) || std::abs( value ) == invalid_value )
+        {
+          continue;
+        }
+        if( d_->higher_is_better ? value >= d_->threshold
+                                 : value <= d_->threshold )
+        {
+          track_edges[t].push_back(
+            { static_cast< unsigned >( t ), d, sign * value } );
+        }
+      }
+    }
+  };
+
+  vital::thread_pool::instance().parallel_for(
+    track_edges.size(), 64, gather );
+
+  // Join tracks and detections which share an edge; detection d is node
+  // track_count + d
+  std::vector< unsigned > parent( track_count + det_count );
+  std::iota( parent.begin(), parent.end(), 0u );
+
+  for( auto const& edges : track_edges )
+  {
+    for( auto const& e : edges )
+    {
+      auto const a = find_root( parent, e.track );
+      auto const b = find_root( parent, track_count + e.detection );
+      if( a != b )
+      {
+        parent[ std::max( a, b ) ] = std::min( a, b );
+      }
+    }
+  }
+
+  // Collect the components with at least one edge, in increasing order of
+  // their members
+  std::vector< component > components;
+  std::vector< unsigned > component_of( parent.size(), no_match );
+
+  auto const component_for = [ & ]( unsigned node ) -> component&
+  {
+    auto const root = find_root( parent, node );
+    if( component_of[ root ] == no_match )
+    {
+      component_of[ root ] = static_cast< unsigned >( components.size() );
+      components.emplace_back();
+    }
+    return components[ component_of[ root ] ];
+  };
+
+  for( unsigned t = 0; t < track_edges.size(); ++t )
+  {
+    if( !track_edges[t].empty() )
+    {
+      auto& c = component_for( t );
+      c.tracks.push_back( t );
+      c.edges.insert( c.edges.end(),
+                      track_edges[t].begin(), track_edges[t].end() );
+    }
+  }
+  for( unsigned d = 0; d < det_count; ++d )
+  {
+    auto const root = find_root( parent, track_count + d );
+    if( component_of[ root ] != no_match )
+    {
+      components[ component_of[ root ] ].detections.push_back( d );
+    }
+  }
+
+  // Solve the largest components first so that the threads stay busy
+  std::vector< size_t > order( components.size() );
+  std::iota( order.begin(), order.end(), size_t{ 0 } );
+  std::sort( order.begin(), order.end(),
+    [ &components ]( size_t a, size_t b )
+    {
+      return components[a].tracks.size() + components[a].detections.size() >
+             components[b].tracks.size() + components[b].detections.size();
+    } );
+
+  std::vector< unsigned > best_indices( track_count, no_match );
+
+  vital::thread_pool::instance().parallel_for(
+    order.size(), 1,
+    [ & ]( size_t begin, size_t end )
+    {
+      for( auto i = begin; i < end; ++i )
+      {
+        solve_component( components[ order[i] ], unassigned_cost,
+                         best_indices );
+      }
+    } );
+
+  std::vector< vital::track_sptr > tracks_to_output;
+  std::vector< bool > detections_used( det_count, false );
+
+  for( unsigned t = 0; t < track_count; ++t )
+  {
+    unsigned best_index = best_indices[t];
+
+    if( best_index < det_count )
+    {
+      vital::track_state_sptr new_track_state(
+        new vital::object_track_state( ts,
+                all_detections->at(best_index) ) );
+
+      vital::track_sptr adj_track(
+        all_tracks[t]->clone( vital::clone_type::SHALLOW ) );
+      adj_track->append( new_track_state );
+      tracks_to_output.push_back( adj_track );
+
+      detections_used[best_index] = true;
+    }
+    else
+    {
+      tracks_to_output.push_back( all_tracks[t] );
+    }
+  }
+
+  std::vector< vital::detected_object_sptr > unused_dets;
+
+  for( unsigned i = 0; i < det_count; ++i )
+  {
+    if( !detections_used[i] )
+    {
+      unused_dets.push_back( all_detections->at(i) );
+    }
+  }
+
+  output = vital::object_track_set_sptr(
+    new object_track_set( tracks_to_output ) );
+  unused = vital::detected_object_set_sptr(
+    new vital::detected_object_set( unused_dets ) );
+
+  return ( unused->size() != all_detections->size() );
+}
+
+} // end namespace core
+} // end namespace arrows
+} // end namespace kwiver
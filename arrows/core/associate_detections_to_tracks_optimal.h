@@ -0,0 +1,80 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_ARROWS_ASSOCIATE_DETECTIONS_TO_TRACKS_OPTIMAL_H_
+#define KWIVER_ARROWS_ASSOCIATE_DETECTIONS_TO_TRACKS_OPTIMAL_H_
+
+#include <vital/vital_config.h>
+#include <arrows/core/kwiver_algo_core_export.h>
+
+#include <vital/algo/algorithm.h>
+#include <vital/algo/associate_detections_to_tracks.h>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+/// Associate detections to tracks by optimal assignment on the input matrix
+///
+/// Entries of the matrix which do not pass the threshold are excluded, as
+/// are entries equal to the largest double, which matrix computations use to
+/// mark pairs that were not scored. The remaining entries form a sparse
+/// bipartite graph between tracks and detections, which is split into its
+/// connected components. Each component is solved independently, in
+/// parallel on the thread pool, for the assignment that minimizes the total
+/// cost, where a track left unassigned costs as much as the threshold.
+class KWIVER_ALGO_CORE_EXPORT associate_detections_to_tracks_optimal
+  : public vital::algo::associate_detections_to_tracks
+{
+public:
+
+  PLUGIN_INFO( "optimal",
+               "Associate detections to tracks via optimal assignment on the "
+               "thresholded input matrix." )
+
+  /// Default Constructor
+  associate_detections_to_tracks_optimal();
+
+  /// Destructor
+  virtual ~associate_detections_to_tracks_optimal() noexcept;
+
+  /// Get this algorithm's \link vital::config_block configuration block \endlink
+  virtual vital::config_block_sptr get_configuration() const;
+
+  /// Set this algorithm's properties via a config block
+  virtual void set_configuration(vital::config_block_sptr config);
+
+  /// Check that the algorithm's currently configuration is valid
+  virtual bool check_configuration(vital::config_block_sptr config) const;
+
+  /// Use cost matrices to assign detections to existing tracks
+  ///
+  /// \param ts frame ID
+  /// \param image contains the input image for the current frame
+  /// \param tracks active track set from the last frame
+  /// \param detections detected object sets from the current frame
+  /// \param matrix matrix containing detection to track association scores
+  /// \param output the output updated detection set
+  /// \param unused output detection set for any detections not associated
+  /// \returns whether or not any tracks were updated
+  virtual bool
+  associate( kwiver::vital::timestamp ts,
+             kwiver::vital::image_container_sptr image,
+             kwiver::vital::object_track_set_sptr tracks,
+             kwiver::vital::detected_object_set_sptr detections,
+             kwiver::vital::matrix_d matrix,
+             kwiver::vital::object_track_set_sptr& output,
+             kwiver::vital::detected_object_set_sptr& unused ) const;
+
+private:
+  /// private implementation class
+  class priv;
+  const std::unique_ptr<priv> d_;
+};
+
+} // end namespace core
+} // end namespace arrows
+} // end namespace kwiver
+
+#endif
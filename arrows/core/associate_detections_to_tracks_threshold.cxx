@@ -10,6 +10,7 @@
 #include <vital/algo/detected_object_filter.h>
 #include <vital/types/object_track_set.h>
 #include <vital/exceptions/algorithm.h>
+#include <vital/util/thread_pool.h>
 #include <vital/vital_config.h>
 
 #include <string>
@@ -113,42 +114,57 @@ ::associate( kwiver::vital::timestamp ts,
   std::vector< vital::track_sptr > tracks_to_output;
   std::vector< bool > detections_used( all_detections->size(), false );
 
-  for( unsigned t = 0; t < all_tracks.size(); ++t )
-  {
-    double best_score = ( d_->higher_is_better ? -1 : 1 ) *
-      std::numeric_limits<double>::max();
-
-    unsigned best_index = std::numeric_limits< unsigned >::max();
+  // Find the best detection of each track in parallel
+  const unsigned det_count = static_cast< unsigned >( all_detections->size() );
+  const unsigned no_match = std::numeric_limits< unsigned >::max();
+  std::vector< unsigned > best_indices( all_tracks.size(), no_match );
 
-    for( unsigned d = 0; d < all_detections->size(); ++d )
+  auto const find_best = [ & ]( size_t begin, size_t end )
+  {
+    for( auto t = begin; t < end; ++t )
     {
-      double value = matrix( t, d );
+      double best_score = ( d_->higher_is_better ? -1 : 1 ) *
+        std::numeric_limits<double>::max();
 
-      if( d_->higher_is_better )
+      for( unsigned d = 0; d < det_count; ++d )
       {
-        if( value >= d_->threshold && value > best_score )
+        double value = matrix( t, d );
+
+        if( d_->higher_is_better )
         {
-          best_score = value;
-          best_index = d;
+          if( value >= d_->threshold && value > best_score )
+          {
+            best_score = value;
+            best_indices[t] = d;
+          }
         }
-      }
-      else
-      {
-        if( value <= d_->threshold && value < best_score )
+        else
         {
-          best_score = value;
-          best_index = d;
+          if( value <= d_->threshold && value < best_score )
+          {
+            best_score = value;
+            best_indices[t] = d;
+          }
         }
       }
     }
+  };
+
+  vital::thread_pool::instance().parallel_for(
+    all_tracks.size(), 64, find_best );
+
+  for( unsigned t = 0; t < all_tracks.size(); ++t )
+  {
+    unsigned best_index = best_indices[t];
 
-    if( best_index < all_detections->size() )
+    if( best_index < det_count )
     {
       vital::track_state_sptr new_track_state(
         new vital::object_track_state( ts,
                 all_detections->at(best_index) ) );
 
-      vital::track_sptr adj_track( all_tracks[t]->clone() );
+      vital::track_sptr adj_track(
+        all_tracks[t]->clone( vital::clone_type::SHALLOW ) );
       adj_track->append( new_track_state );
       tracks_to_output.push_back( adj_track );
 
@@ -7,6 +7,7 @@
 
 #include <map>
 #include <algorithm>
+#include <future>
 #include <iterator>
 #include <limits>
 
@@ -22,6 +23,7 @@ using namespace kwiver::vital;
 #include <vital/algo/image_io.h>
 #include <vital/algo/match_features.h>
 #include <vital/algo/estimate_fundamental_matrix.h>
+#include <vital/util/thread_pool.h>
 #include <kwiversys/SystemTools.hxx>
 
 namespace kwiver {
@@ -32,10 +34,32 @@ class close_loops_appearance_indexed::priv
 {
 public:
   priv();
+  ~priv();
 
   typedef std::pair<feature_track_state_sptr, feature_track_state_sptr> fs_match;
   typedef std::vector<fs_match> matches_vec;
 
+  typedef std::map<unsigned int, std::vector<feature_track_state_sptr>> node_id_to_feat_map;
+
+  /// A putative loop closing frame and the result of its verification
+  struct candidate
+  {
+    /// The putatively matching frame
+    frame_id_t frame;
+
+    /// The feature track states on the matching frame
+    std::vector<feature_track_state_sptr> states;
+
+    /// The cross-validated matches to the current frame
+    matches_vec matches;
+
+    /// True if the fundamental matrix estimation failed
+    bool estimation_failed = false;
+
+    /// Inlier flags for the matches, if geometric verification was done
+    std::vector<bool> inliers;
+  };
+
   kwiver::vital::feature_track_set_sptr
   detect(
     kwiver::vital::feature_track_set_sptr feat_tracks,
@@ -59,7 +83,13 @@ class close_loops_appearance_indexed::priv
     kwiver::vital::frame_id_t frame_number,
     std::vector<frame_id_t> const &putative_matches);
 
-  typedef std::map<unsigned int, std::vector<feature_track_state_sptr>> node_id_to_feat_map;
+  void
+  verify_candidate(
+    node_id_to_feat_map const &cur_node_map,
+    candidate &c);
+
+  /// Wait for the previous frame to be added to the bag of words index
+  void wait_for_index_update();
 
   node_id_to_feat_map make_node_map(const std::vector<feature_track_state_sptr> &feats);
 
@@ -101,6 +131,15 @@ class close_loops_appearance_indexed::priv
 
   // Must have this inlier fraction to accept a loop completion
   float m_min_loop_inlier_fraction;
+
+  // The number of putative matches verified concurrently
+  unsigned m_verification_batch_size;
+
+  // Add keyframes to the bag of words index in the background
+  bool m_async_index_update;
+
+  // The pending addition of the last keyframe to the bag of words index
+  std::future<void> m_index_update;
 };
 
 // ----------------------------------------------------------------------------
@@ -113,10 +152,34 @@ ::priv()
   m_max_loop_attempts_per_frame(200),
   m_tracks_in_common_to_skip_loop_closing(0),
   m_skip_loop_detection_track_i_over_u_threshold(0.5),
-  m_min_loop_inlier_fraction(0.5)
+  m_min_loop_inlier_fraction(0.5),
+  m_verification_batch_size(16),
+  m_async_index_update(true)
 {
 }
 
+close_loops_appearance_indexed::priv
+::~priv()
+{
+  if (m_index_update.valid())
+  {
+    m_index_update.wait();
+  }
+}
+
+// ----------------------------------------------------------------------------
+
+void
+close_loops_appearance_indexed::priv
+::wait_for_index_update()
+{
+  if (m_index_update.valid())
+  {
+    // rethrows any exception from the update
+    m_index_update.get();
+  }
+}
+
 // ----------------------------------------------------------------------------
 
 close_loops_appearance_indexed::priv::node_id_to_feat_map
@@ -219,180 +282,224 @@ ::verify_and_add_image_matches_node_id_guided(
 
   auto cur_node_map = make_node_map(cur_frame_fts);
   int num_failed_loop_attempts_in_a_row = 0;
-  //loop over putatively matching frames
-  for (auto fn_match : putative_matches)
+  bool attempts_exhausted = false;
+  size_t next_match = 0;
+  const size_t batch_size = std::max(m_verification_batch_size, 1u);
+
+  // Putative matches are verified in batches on the thread pool.  Matching
+  // and geometric verification only read the tracks, so the candidates of a
+  // batch are checked concurrently against the tracks as they were before the
+  // batch.  The verified matches are then stitched in order.
+  while (!attempts_exhausted && next_match < putative_matches.size())
   {
-
-    if (fn_match == frame_number)
+    std::vector<candidate> batch;
+    while (batch.size() < batch_size && next_match < putative_matches.size())
     {
-      continue; // no sense matching an image to itself
-    }
-
-    //get active tracks on fn match
-    auto match_frame_track_ids = feat_tracks->active_track_ids(fn_match);
-    std::set<track_id_t> tracks_in_common, union_of_tracks;
-    std::set_intersection(cur_frame_track_ids.begin(), cur_frame_track_ids.end(),
-                          match_frame_track_ids.begin(), match_frame_track_ids.end(),
-                          std::inserter(tracks_in_common, tracks_in_common.begin()));
+      auto fn_match = putative_matches[next_match++];
+      if (fn_match == frame_number)
+      {
+        continue; // no sense matching an image to itself
+      }
 
-    std::set_union(cur_frame_track_ids.begin(), cur_frame_track_ids.end(),
-                   match_frame_track_ids.begin(), match_frame_track_ids.end(),
-                   std::inserter(union_of_tracks, union_of_tracks.begin()));
+      //get active tracks on fn match
+      auto match_frame_track_ids = feat_tracks->active_track_ids(fn_match);
+      std::set<track_id_t> tracks_in_common, union_of_tracks;
+      std::set_intersection(cur_frame_track_ids.begin(), cur_frame_track_ids.end(),
+                            match_frame_track_ids.begin(), match_frame_track_ids.end(),
+                            std::inserter(tracks_in_common, tracks_in_common.begin()));
 
-    double i_over_u = static_cast<double>(tracks_in_common.size()) /
-                      static_cast<double>(union_of_tracks.size());
+      std::set_union(cur_frame_track_ids.begin(), cur_frame_track_ids.end(),
+                     match_frame_track_ids.begin(), match_frame_track_ids.end(),
+                     std::inserter(union_of_tracks, union_of_tracks.begin()));
 
-    if (i_over_u > m_skip_loop_detection_track_i_over_u_threshold)
-    {
-      continue;
-    }
+      double i_over_u = static_cast<double>(tracks_in_common.size()) /
+                        static_cast<double>(union_of_tracks.size());
 
-    // how many tracks to fn_match and frame_number have in common?  Too many?  Don't match.
+      // how many tracks to fn_match and frame_number have in common?  Too many?  Don't match.
+      if (i_over_u > m_skip_loop_detection_track_i_over_u_threshold)
+      {
+        continue;
+      }
 
-    ++num_failed_loop_attempts_in_a_row;
-    if (num_failed_loop_attempts_in_a_row > m_max_loop_attempts_per_frame)
-    {
-      break;
+      batch.emplace_back();
+      batch.back().frame = fn_match;
+      batch.back().states = feat_tracks->frame_feature_track_states(fn_match);
     }
 
-    auto match_frame_fts = feat_tracks->frame_feature_track_states(fn_match);
-
-    auto match_node_map = make_node_map(match_frame_fts);
-    matches_vec validated_matches;
+    vital::thread_pool::instance().parallel_for(batch.size(), 1,
+      [&](size_t begin, size_t end)
+      {
+        for (size_t i = begin; i < end; ++i)
+        {
+          verify_candidate(cur_node_map, batch[i]);
+        }
+      });
 
-    //ok now we do the matching.
-    //loop over node ids in the current frame
-    for (auto fc : cur_node_map)
+    for (auto &c : batch)
     {
-      //find the matching node id in the putative matching frame
-      auto node_id = fc.first;
-      auto fm = match_node_map.find(node_id);
-      if (fm == match_node_map.end())
+      ++num_failed_loop_attempts_in_a_row;
+      if (num_failed_loop_attempts_in_a_row > m_max_loop_attempts_per_frame)
+      {
+        attempts_exhausted = true;
+        break;
+      }
+
+      auto const &validated_matches = c.matches;
+      if (validated_matches.size() < m_min_loop_inlier_matches)
       {
-        //no features with the same node in the putative matching frame
         continue;
       }
 
-      auto &cur_feat_vec = fc.second;
-      auto &match_feat_vec = fm->second;
-      matches_vec matches_forward, matches_reverse;
+      // earlier candidates in the batch may have joined these tracks already
+      size_t already_joined_matches = 0;
+      for (auto &vm : validated_matches)
+      {
+        if (vm.first->track()->id() == vm.second->track()->id())
+        {
+          ++already_joined_matches;
+        }
+      }
 
-      do_matching( cur_feat_vec, match_feat_vec, matches_forward);
-      if (matches_forward.empty())
+      if (already_joined_matches == validated_matches.size())
       {
+        num_failed_loop_attempts_in_a_row = 0;
         continue;
       }
-      do_matching( match_feat_vec, cur_feat_vec, matches_reverse);
-      if (matches_reverse.empty())
+
+      auto const &inliers = c.inliers;
+      if (c.estimation_failed)
       {
         continue;
       }
-      // cross-validate the matches
-      for (auto m_f : matches_forward)
+      if (m_f_estimator)
       {
-        for (auto m_r : matches_reverse)
+        unsigned num_inliers =
+          static_cast<unsigned>(std::count(inliers.begin(), inliers.end(), true));
+
+        float inlier_fraction = static_cast<double>(num_inliers) / static_cast<double>(validated_matches.size());
+
+        if (num_inliers < m_min_loop_inlier_matches || inlier_fraction < m_min_loop_inlier_fraction)
         {
-          if (m_f.first == m_r.second && m_f.second == m_r.first)
-          {
-            validated_matches.push_back(m_f);
-            break;
-          }
+          continue;
         }
       }
-    }
 
-    if (validated_matches.size() < m_min_loop_inlier_matches)
-    {
-      continue;
-    }
+      num_failed_loop_attempts_in_a_row = 0;
 
-    size_t already_joined_matches = 0;
-    for (auto &vm : validated_matches)
-    {
-      if (vm.first->track()->id() == vm.second->track()->id())
+      int num_stitched_tracks = 0;
+      for(size_t i = 0; i < validated_matches.size(); ++i)
       {
-        ++already_joined_matches;
-      }
-    }
+        if (!inliers.empty())
+        {
+          if (!inliers[i])
+          {
+            continue;
+          }
+        }
+        auto &m = validated_matches[i];
+        track_sptr t1 = m.first->track();
+        track_sptr t2 = m.second->track();
+        //t1's states should be after t2
+        if (t1->last_frame() < t2->last_frame())
+        {
+          std::swap(t1, t2);
+        }
 
-    if (already_joined_matches == validated_matches.size())
-    {
-      num_failed_loop_attempts_in_a_row = 0;
-      continue;
-    }
+        if (feat_tracks->merge_tracks(t1, t2))
+        {
+          //tracks will not merge if t1 and t2 are already the same track
+          ++num_stitched_tracks;
+        }
+      }
 
-    std::vector<bool> inliers;
-    //do geometric verification here
-    if (m_f_estimator)
-    {
-      std::vector<vector_2d> pts_right, pts_left;
-      for (auto &m : validated_matches)
+      if (num_stitched_tracks > 0)
       {
-        pts_right.push_back(m.first->feature->loc());
-        pts_left.push_back(m.second->feature->loc());
+        LOG_DEBUG(m_logger, "Stitched " << num_stitched_tracks <<
+          " tracks between frames " << frame_number <<
+          " and " << c.frame);
+
+        ++num_successfully_matched_pairs;
       }
+    }
+  }
 
-      auto F = m_f_estimator->estimate(pts_right, pts_left, inliers,
-                              m_geometric_verification_inlier_threshold);
+  LOG_DEBUG(m_logger, "Of " << putative_matches.size() << " putative matches "
+    << num_successfully_matched_pairs << " pairs were verified");
 
-      if (!F)
-      {
-        continue;
-      }
+  return feat_tracks;
+}
 
-      unsigned num_inliers =
-        static_cast<unsigned>(std::count(inliers.begin(), inliers.end(), true));
+// ----------------------------------------------------------------------------
 
-      float inlier_fraction = static_cast<double>(num_inliers) / static_cast<double>(validated_matches.size());
+void
+close_loops_appearance_indexed::priv
+::verify_candidate(node_id_to_feat_map const &cur_node_map,
+                   candidate &c)
+{
+  auto match_node_map = make_node_map(c.states);
+  matches_vec &validated_matches = c.matches;
 
-      if (num_inliers < m_min_loop_inlier_matches || inlier_fraction < m_min_loop_inlier_fraction)
-      {
-        continue;
-      }
+  //ok now we do the matching.
+  //loop over node ids in the current frame
+  for (auto const &fc : cur_node_map)
+  {
+    //find the matching node id in the putative matching frame
+    auto node_id = fc.first;
+    auto fm = match_node_map.find(node_id);
+    if (fm == match_node_map.end())
+    {
+      //no features with the same node in the putative matching frame
+      continue;
     }
 
-    num_failed_loop_attempts_in_a_row = 0;
+    auto &cur_feat_vec = fc.second;
+    auto &match_feat_vec = fm->second;
+    matches_vec matches_forward, matches_reverse;
 
-    int num_stitched_tracks = 0;
-    for(size_t i = 0; i < validated_matches.size(); ++i)
+    do_matching( cur_feat_vec, match_feat_vec, matches_forward);
+    if (matches_forward.empty())
+    {
+      continue;
+    }
+    do_matching( match_feat_vec, cur_feat_vec, matches_reverse);
+    if (matches_reverse.empty())
+    {
+      continue;
+    }
+    // cross-validate the matches
+    for (auto m_f : matches_forward)
     {
-      if (!inliers.empty())
+      for (auto m_r : matches_reverse)
       {
-        if (!inliers[i])
+        if (m_f.first == m_r.second && m_f.second == m_r.first)
         {
-          continue;
+          validated_matches.push_back(m_f);
+          break;
         }
       }
-      auto &m = validated_matches[i];
-      track_sptr t1 = m.first->track();
-      track_sptr t2 = m.second->track();
-      //t1's states should be after t2
-      if (t1->last_frame() < t2->last_frame())
-      {
-        std::swap(t1, t2);
-      }
-
-      if (feat_tracks->merge_tracks(t1, t2))
-      {
-        //tracks will not merge if t1 and t2 are already the same track
-        ++num_stitched_tracks;
-      }
     }
+  }
 
-    if (num_stitched_tracks > 0)
-    {
-      LOG_DEBUG(m_logger, "Stitched " << num_stitched_tracks <<
-        " tracks between frames " << frame_number <<
-        " and " << fn_match);
+  if (validated_matches.size() < m_min_loop_inlier_matches)
+  {
+    return;
+  }
 
-      ++num_successfully_matched_pairs;
+  //do geometric verification here
+  if (m_f_estimator)
+  {
+    std::vector<vector_2d> pts_right, pts_left;
+    for (auto &m : validated_matches)
+    {
+      pts_right.push_back(m.first->feature->loc());
+      pts_left.push_back(m.second->feature->loc());
     }
-  }
 
-  LOG_DEBUG(m_logger, "Of " << putative_matches.size() << " putative matches "
-    << num_successfully_matched_pairs << " pairs were verified");
+    auto F = m_f_estimator->estimate(pts_right, pts_left, c.inliers,
+                            m_geometric_verification_inlier_threshold);
 
-  return feat_tracks;
+    c.estimation_failed = !F;
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -563,6 +670,10 @@ ::detect(kwiver::vital::feature_track_set_sptr feat_tracks,
     return feat_tracks;
   }
 
+  // the last keyframe may be among the candidates, and the index is not
+  // safe to query while it is being updated
+  wait_for_index_update();
+
   std::vector<frame_id_t> putative_matching_images;
 
   auto fd = std::dynamic_pointer_cast<feature_track_set_frame_data>(feat_tracks->frame_data(frame_number));
@@ -586,6 +697,24 @@ ::detect(kwiver::vital::feature_track_set_sptr feat_tracks,
   {
     auto desc = feat_tracks->frame_descriptors(frame_number);
 
+    if (m_async_index_update)
+    {
+      putative_matching_images = m_bow->query(desc);
+
+      // verification reads the node ids the query assigned, so the index
+      // update, which assigns them again, starts after it
+      feat_tracks = verify_and_add_image_matches_node_id_guided(
+        feat_tracks, frame_number, putative_matching_images);
+
+      auto bow = m_bow;
+      m_index_update = vital::thread_pool::instance().enqueue(
+        [bow, desc, frame_number]()
+        {
+          bow->append_to_index(desc, frame_number);
+        });
+      return feat_tracks;
+    }
+
     putative_matching_images =
       m_bow->query_and_append(desc, frame_number);
   }
@@ -663,6 +792,19 @@ ::get_configuration() const
     d_->m_min_loop_inlier_fraction,
     "inlier fraction must be this high to accept a loop completion");
 
+  config->set_value("verification_batch_size",
+    d_->m_verification_batch_size,
+    "the number of putative loop closures to verify concurrently on the "
+    "thread pool before stitching their tracks. Candidates in a batch are "
+    "verified against the tracks as they were before the batch. Set to 1 to "
+    "verify each candidate after stitching the previous one. The fundamental "
+    "matrix estimator must allow concurrent calls when this is above 1.");
+
+  config->set_value("async_index_update",
+    d_->m_async_index_update,
+    "add keyframes to the bag of words index in the background, after "
+    "their loop closures have been verified, instead of before returning");
+
   return config;
 }
 
@@ -687,6 +829,9 @@ ::set_configuration(vital::config_block_sptr in_config)
     "match_features", config, mf);
   d_->m_matcher = mf;
 
+  // finish any update to the index being replaced
+  d_->wait_for_index_update();
+
   algo::match_descriptor_sets_sptr bow;
   algo::match_descriptor_sets::set_nested_algo_configuration(
     "bag_of_words_matching", config, bow);
@@ -719,6 +864,14 @@ ::set_configuration(vital::config_block_sptr in_config)
   d_->m_min_loop_inlier_fraction =
     config->get_value<float>("m_min_loop_inlier_fraction",
       d_->m_min_loop_inlier_fraction);
+
+  d_->m_verification_batch_size =
+    config->get_value<unsigned>("verification_batch_size",
+      d_->m_verification_batch_size);
+
+  d_->m_async_index_update =
+    config->get_value<bool>("async_index_update",
+      d_->m_async_index_update);
 }
 
 // ----------------------------------------------------------------------------
@@ -747,6 +900,14 @@ ::check_configuration(vital::config_block_sptr config) const
     config_valid = false;
   }
 
+  if (config->get_value<unsigned>("verification_batch_size",
+                                  d_->m_verification_batch_size) < 1)
+  {
+    LOG_ERROR(d_->m_logger,
+      "verification_batch_size must be at least 1");
+    config_valid = false;
+  }
+
   return config_valid;
 }
 
@@ -10,12 +10,19 @@
 #include <vital/algo/detected_object_filter.h>
 #include <vital/types/object_track_set.h>
 #include <vital/exceptions/algorithm.h>
+#include <vital/util/thread_pool.h>
 #include <vital/vital_config.h>
 
 #include <string>
 #include <vector>
 #include <atomic>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
 
 namespace kwiver {
 namespace arrows {
@@ -121,72 +128,173 @@ ::compute( VITAL_UNUSED kwiver::vital::timestamp ts,
   if( filtered_tracks.empty() || filtered_dets->empty() )
   {
     matrix = kwiver::vital::matrix_d();
+    considered = detections;
+    return false;
   }
-  else
+
+  matrix = kwiver::vital::matrix_d::Constant(
+    filtered_tracks.size(), filtered_dets->size(), invalid_value );
+
+  // Gather the center and descriptor of each detection once
+  const unsigned det_count = static_cast< unsigned >( filtered_dets->size() );
+  std::vector< vector_2d > det_centers( det_count );
+  std::vector< detected_object::descriptor_scptr > det_features( det_count );
+
+  for( unsigned d = 0; d < det_count; ++d )
   {
-    matrix = kwiver::vital::matrix_d( filtered_tracks.size(), filtered_dets->size() );
+    auto const& det = filtered_dets->at( d );
+    det_centers[d] = det->bounding_box().center();
+    det_features[d] = det->descriptor();
+  }
 
-    for( unsigned t = 0; t < filtered_tracks.size(); ++t )
+  // Bin detections in a grid of cells max_distance wide, so that only
+  // detections in the 3x3 cells around a track need to be considered
+  const double max_distance = d_->m_max_distance;
+  const bool gated = ( max_distance > 0.0 );
+
+  std::unordered_map< std::uint64_t, std::vector< unsigned > > grid;
+
+  auto const cell_of = [ max_distance ]( double x ) -> std::int64_t
+  {
+    return static_cast< std::int64_t >( std::floor( x / max_distance ) );
+  };
+  auto const cell_key = []( std::int64_t cx, std::int64_t cy ) -> std::uint64_t
+  {
+    return ( static_cast< std::uint64_t >( cx ) << 32 ) ^
+           ( static_cast< std::uint64_t >( cy ) & 0xffffffff );
+  };
+
+  if( gated )
+  {
+    for( unsigned d = 0; d < det_count; ++d )
     {
-      for( unsigned d = 0; d < filtered_dets->size(); ++d )
+      if( det_features[d] )
       {
-        track_sptr trk = filtered_tracks[t];
-        detected_object_sptr det = filtered_dets->at(d);
+        grid[ cell_key( cell_of( det_centers[d][0] ),
+                        cell_of( det_centers[d][1] ) ) ].push_back( d );
+      }
+    }
+  }
 
-        auto det_features = det->descriptor();
-        auto trk_features = decltype(det_features){};
+  // Score the pairs of each track in parallel
+  std::exception_ptr error;
+  std::mutex error_mutex;
 
-        if( !trk->empty() )
+  auto const score_tracks = [ & ]( size_t begin, size_t end )
+  {
+    try
+    {
+      std::vector< unsigned > candidates;
+
+      for( auto t = begin; t < end; ++t )
+      {
+        auto const& trk = filtered_tracks[t];
+
+        if( trk->empty() )
         {
-          object_track_state* trk_state =
-            dynamic_cast< object_track_state* >( trk->back().get() );
+          continue;
+        }
 
-          if( trk_state->detection() )
-          {
-            double dist = d_->m_max_distance;
+        auto const trk_state =
+          dynamic_cast< object_track_state const* >( trk->back().get() );
 
-            if( d_->m_max_distance > 0.0 )
-            {
-              auto center1 = trk_state->detection()->bounding_box().center();
-              auto center2 = det->bounding_box().center();
+        if( !trk_state || !trk_state->detection() )
+        {
+          continue;
+        }
 
-              dist = ( center1[0] - center2[0] ) * ( center1[0] - center2[0] );
-              dist += ( ( center1[1] - center2[1] ) * ( center1[1] - center2[1] ) );
-              dist = std::sqrt( dist );
-            }
+        auto const trk_features = trk_state->detection()->descriptor();
 
-            if( d_->m_max_distance <= 0.0 || dist < d_->m_max_distance )
+        if( !trk_features )
+        {
+          continue;
+        }
+
+        auto const trk_center =
+          trk_state->detection()->bounding_box().center();
+
+        candidates.clear();
+
+        if( gated )
+        {
+          auto const cx = cell_of( trk_center[0] );
+          auto const cy = cell_of( trk_center[1] );
+
+          for( auto x = cx - 1; x <= cx + 1; ++x )
+          {
+            for( auto y = cy - 1; y <= cy + 1; ++y )
             {
-              trk_features = trk_state->detection()->descriptor();
+              auto const cell = grid.find( cell_key( x, y ) );
+
+              if( cell != grid.end() )
+              {
+                candidates.insert( candidates.end(),
+                                   cell->second.begin(), cell->second.end() );
+              }
             }
           }
         }
 
-        if( det_features && trk_features )
+        auto const score = [ & ]( unsigned d )
         {
-          if( det_features->size() != trk_features->size() )
+          auto const& features = det_features[d];
+
+          if( !features )
+          {
+            return;
+          }
+          if( gated &&
+              ( trk_center - det_centers[d] ).norm() >= max_distance )
+          {
+            return;
+          }
+          if( features->size() != trk_features->size() )
           {
             throw std::runtime_error( "Invalid descriptor dimensions" );
           }
 
           double sum_sqr = 0.0;
 
-          for( auto pos1 = det_features->raw_data(),
+          for( auto pos1 = features->raw_data(),
                     pos2 = trk_features->raw_data(),
-                    end = pos1 + det_features->size();
-               pos1 != end; ++pos1, ++pos2 )
+                    stop = pos1 + features->size();
+               pos1 != stop; ++pos1, ++pos2 )
           {
             sum_sqr += ( ( *pos1 - *pos2 ) * ( *pos1 - *pos2 ) );
           }
 
           matrix( t, d ) = std::sqrt( sum_sqr );
+        };
+
+        if( gated )
+        {
+          for( auto const d : candidates )
+          {
+            score( d );
+          }
         }
         else
         {
-          matrix( t, d ) = invalid_value;
+          for( unsigned d = 0; d < det_count; ++d )
+          {
+            score( d );
+          }
         }
       }
     }
+    catch( ... )
+    {
+      std::lock_guard< std::mutex > lock( error_mutex );
+      error = std::current_exception();
+    }
+  };
+
+  thread_pool::instance().parallel_for(
+    filtered_tracks.size(), 16, score_tracks );
+
+  if( error )
+  {
+    std::rethrow_exception( error );
   }
 
   considered = detections;
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <limits>
 #include <set>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
@@ -92,6 +93,37 @@ find_track( const track_sptr& trk, track_info_buffer_sptr buffer )
   return ( result == end || result->tid == ti.tid ) ? result : end;
 }
 
+// ----------------------------------------------------------------------------
+// Map a point through a homography matrix
+vector_2d
+map_point( Eigen::Matrix3d const& h, vector_2d const& p )
+{
+  Eigen::Vector3d const q = h * Eigen::Vector3d( p.x(), p.y(), 1.0 );
+  return q.head< 2 >() / q.z();
+}
+
+// ----------------------------------------------------------------------------
+// Keep at most max_points evenly spaced pairs of corresponding points
+void
+decimate_points( std::vector< vector_2d >& pts_a,
+                 std::vector< vector_2d >& pts_b, unsigned max_points )
+{
+  auto const n = pts_a.size();
+  if( max_points == 0 || n <= max_points )
+  {
+    return;
+  }
+
+  for( size_t i = 0; i < max_points; ++i )
+  {
+    auto const j = i * n / max_points;
+    pts_a[ i ] = pts_a[ j ];
+    pts_b[ i ] = pts_b[ j ];
+  }
+  pts_a.resize( max_points );
+  pts_b.resize( max_points );
+}
+
 // ----------------------------------------------------------------------------
 // Reset all is found flags
 void
@@ -119,7 +151,13 @@ class compute_ref_homography_core::priv
     minimum_inliers( 4 ),
     frames_since_reset( 0 ),
     allow_ref_frame_regression( true ),
-    min_ref_frame( 0 )
+    min_ref_frame( 0 ),
+    chain_homographies( false ),
+    chain_max_points( 200 ),
+    chain_max_error( 2.0 ),
+    chain_valid( false ),
+    chain_ref( 0 ),
+    chain_h( Eigen::Matrix3d::Identity() )
   {
   }
 
@@ -163,6 +201,39 @@ class compute_ref_homography_core::priv
   /// estimation fails.
   frame_id_t min_ref_frame;
 
+  /// Compose frame-to-frame homographies instead of estimating each frame
+  /// against its reference frame from the track history
+  bool chain_homographies;
+
+  /// Maximum number of points used for each estimation when chaining
+  unsigned chain_max_points;
+
+  /// RMS error in reference frame pixels at which a chained homography is
+  /// estimated again directly against the reference locations of tracks
+  double chain_max_error;
+
+  /// A reference location of a track, for measuring chaining drift
+  struct anchor_t
+  {
+    vector_2d ref_loc;
+    frame_id_t last_seen;
+  };
+
+  /// Is there a previous frame to chain from?
+  bool chain_valid;
+
+  /// Reference frame of the current chain
+  frame_id_t chain_ref;
+
+  /// Homography from the previous frame to the reference frame
+  Eigen::Matrix3d chain_h;
+
+  /// Feature locations on the previous frame
+  std::unordered_map< track_id_t, vector_2d > chain_prev;
+
+  /// Reference locations of tracks seen recently
+  std::unordered_map< track_id_t, anchor_t > chain_anchors;
+
   vital::logger_handle_t m_logger;
 
   /// Estimate the homography between two corresponding points sets
@@ -247,8 +318,147 @@ class compute_ref_homography_core::priv
     return is_bad_homog;
   }
 
+  /// Estimate the reference homography of a frame by chaining
+  f2f_homography_sptr estimate_chained( frame_id_t frame_number,
+                                        feature_track_set_sptr tracks );
+
 };
 
+// ----------------------------------------------------------------------------
+f2f_homography_sptr
+compute_ref_homography_core::priv
+::estimate_chained( frame_id_t frame_number, feature_track_set_sptr tracks )
+{
+  // Only the features on this frame are looked at, so the cost of a frame
+  // does not grow with the length of the tracks
+  std::vector< std::pair< track_id_t, vector_2d > > cur_locs;
+  for( auto const& ts : tracks->frame_states( frame_number ) )
+  {
+    auto const fts = std::dynamic_pointer_cast< feature_track_state >( ts );
+    auto const trk = ts->track();
+    if( fts && fts->feature && trk )
+    {
+      cur_locs.emplace_back( trk->id(), fts->feature->loc() );
+    }
+  }
+
+  // Chain the homography to the previous frame onto that of the previous
+  // frame to the reference
+  bool chained = false;
+  if( this->chain_valid )
+  {
+    std::vector< vector_2d > pts_cur, pts_prev;
+    for( auto const& l : cur_locs )
+    {
+      auto const i = this->chain_prev.find( l.first );
+      if( i != this->chain_prev.end() )
+      {
+        pts_cur.push_back( l.second );
+        pts_prev.push_back( i->second );
+      }
+    }
+    decimate_points( pts_cur, pts_prev, this->chain_max_points );
+
+    homography_sptr h;
+    if( !this->compute_homography( pts_cur, pts_prev, h ) )
+    {
+      this->chain_h = this->chain_h * h->matrix();
+      this->chain_h /= this->chain_h( 2, 2 );
+      chained = true;
+    }
+  }
+
+  if( !chained )
+  {
+    LOG_DEBUG( m_logger, "Starting new reference frame " << frame_number );
+    this->chain_ref = frame_number;
+    this->chain_h = Eigen::Matrix3d::Identity();
+    this->chain_anchors.clear();
+    this->min_ref_frame = frame_number;
+  }
+  else
+  {
+    // Measure how far the chain has drifted from the reference locations of
+    // the tracks, and estimate against those if it is too far
+    std::vector< vector_2d > pts_cur, pts_ref;
+    for( auto const& l : cur_locs )
+    {
+      auto const i = this->chain_anchors.find( l.first );
+      if( i != this->chain_anchors.end() )
+      {
+        pts_cur.push_back( l.second );
+        pts_ref.push_back( i->second.ref_loc );
+      }
+    }
+    decimate_points( pts_cur, pts_ref, this->chain_max_points );
+
+    if( pts_cur.size() >= this->minimum_inliers )
+    {
+      double sum_sqr = 0.0;
+      for( size_t i = 0; i < pts_cur.size(); ++i )
+      {
+        sum_sqr +=
+          ( map_point( this->chain_h, pts_cur[ i ] ) - pts_ref[ i ] )
+          .squaredNorm();
+      }
+
+      auto const rms = std::sqrt( sum_sqr / pts_cur.size() );
+      homography_sptr h;
+      if( rms > this->chain_max_error &&
+          !this->compute_homography( pts_cur, pts_ref, h ) )
+      {
+        LOG_DEBUG( m_logger,
+                   "Re-anchoring frame " << frame_number <<
+                   " with chaining error " << rms );
+        this->chain_h = h->matrix();
+        this->chain_h /= this->chain_h( 2, 2 );
+      }
+    }
+  }
+
+  // Remember this frame's features for the next frame, and give new tracks
+  // reference locations
+  this->chain_prev.clear();
+  for( auto const& l : cur_locs )
+  {
+    this->chain_prev.emplace( l.first, l.second );
+    auto const i = this->chain_anchors.find( l.first );
+    if( i == this->chain_anchors.end() )
+    {
+      this->chain_anchors.emplace(
+        l.first,
+        anchor_t{ map_point( this->chain_h, l.second ), frame_number } );
+    }
+    else
+    {
+      i->second.last_seen = frame_number;
+    }
+  }
+
+  // Forget tracks not seen in a while
+  for( auto i = this->chain_anchors.begin();
+       i != this->chain_anchors.end(); )
+  {
+    if( frame_number - i->second.last_seen >= this->forget_track_threshold )
+    {
+      i = this->chain_anchors.erase( i );
+    }
+    else
+    {
+      ++i;
+    }
+  }
+
+  this->chain_valid = true;
+
+  if( !chained )
+  {
+    return std::make_shared< f2f_homography >( frame_number );
+  }
+  return std::make_shared< f2f_homography >(
+    this->chain_h, frame_number, this->chain_ref );
+}
+
 // ----------------------------------------------------------------------------
 compute_ref_homography_core
 ::compute_ref_homography_core()
@@ -297,6 +507,25 @@ ::get_configuration() const
                     "reference frame, A, when a frame M < N has a reference "
                     "frame B > A (assuming frames were sequentially iterated "
                     "over with this algorithm).");
+  config->set_value("chain_homographies", d_->chain_homographies,
+                    "Estimate the homography from each frame to the previous "
+                    "frame and compose it with that of the previous frame, "
+                    "instead of estimating against the reference frame "
+                    "through the track history. The cost of each frame is "
+                    "then independent of the length of the tracks, which "
+                    "suits long videos at high frame rates. "
+                    "min_track_length, use_backproject_error and "
+                    "allow_ref_frame_regression do not apply.");
+  config->set_value("chain_max_points", d_->chain_max_points,
+                    "When chaining, the maximum number of evenly sampled "
+                    "point pairs to estimate each homography from. Set to 0 "
+                    "to use all of them.");
+  config->set_value("chain_max_error", d_->chain_max_error,
+                    "When chaining, the RMS distance (in pixels) between "
+                    "where the chained homography maps the tracks and their "
+                    "locations in the reference frame above which the "
+                    "homography is estimated directly against those "
+                    "locations, bounding the drift.");
 
   return config;
 }
@@ -323,6 +552,9 @@ ::set_configuration( vital::config_block_sptr in_config )
   d_->inlier_scale = config->get_value<double>( "inlier_scale" );
   d_->minimum_inliers = config->get_value<int>( "min_matches_threshold" );
   d_->allow_ref_frame_regression = config->get_value<bool>( "allow_ref_frame_regression" );
+  d_->chain_homographies = config->get_value<bool>( "chain_homographies" );
+  d_->chain_max_points = config->get_value<unsigned>( "chain_max_points" );
+  d_->chain_max_error = config->get_value<double>( "chain_max_error" );
 
   // Square the threshold ahead of time for efficiency
   d_->backproject_threshold_sqr = d_->backproject_threshold_sqr *
@@ -350,6 +582,11 @@ ::estimate( frame_id_t frame_number,
   LOG_DEBUG( logger(),
              "Starting ref homography estimation for frame " << frame_number );
 
+  if( d_->chain_homographies )
+  {
+    return d_->estimate_chained( frame_number, tracks );
+  }
+
   // Get active tracks for the current frame
   std::vector< track_sptr > active_tracks = tracks->active_tracks( frame_number );
 
@@ -6,7 +6,11 @@
 /// \brief depth estimation utility functions.
 
 #include <arrows/core/depth_utils.h>
+#include <vital/exceptions.h>
 #include <vital/math_constants.h>
+#include <vital/util/thread_pool.h>
+#include <vital/util/transform_image.h>
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
@@ -447,6 +451,246 @@ find_similar_cameras_angles(camera_perspective const& ref_camera,
   return std::make_shared<camera_perspective_map>(selected_cameras);
 }
 
+//*****************************************************************************
+
+namespace {
+
+// Approximate number of pixels back-projected by each parallel task
+constexpr size_t pixels_per_chunk = 16384;
+
+/// The inputs of one depth map prepared for back-projection
+struct depth_map_view
+{
+  image_of<double> depth;
+  image_of<double> uncertainty;
+  image_of<unsigned char> color;
+  camera_perspective_sptr camera;
+  int i0 = 0;
+  int j0 = 0;
+  bool linear = false;
+  // maps homogeneous image coordinates to world ray directions
+  matrix_3x3d ray_matrix;
+};
+
+/// A range of rows of one depth map back-projected by a single task
+struct row_chunk
+{
+  size_t map;
+  int begin;
+  int end;
+  std::vector<vector_3d> positions;
+  std::vector<rgb_color> colors;
+};
+
+/// Back-project the rows of a chunk, keeping the pixels which pass the filter
+void
+back_project_rows(depth_map_view const& dm, double max_uncertainty,
+                  row_chunk& chunk)
+{
+  int const ni = static_cast<int>(dm.depth.width());
+  const bool has_uncertainty = max_uncertainty > 0.0 &&
+                               dm.uncertainty.size() > 0;
+  const bool has_color = dm.color.size() > 0;
+  const bool gray = has_color && dm.color.depth() < 3;
+  vector_3d const center = dm.camera->center();
+  matrix_3x3d const R_t = dm.camera->rotation().matrix().transpose();
+  auto const& intrinsics = *dm.camera->intrinsics();
+
+  std::vector<double> ray_x(ni), ray_y(ni), ray_z(ni);
+  for (int j = chunk.begin; j < chunk.end; ++j)
+  {
+    double const v = static_cast<double>(j + dm.j0);
+    if (dm.linear)
+    {
+      // the ray direction is affine in the column along a scanline
+      vector_3d const base = dm.ray_matrix * vector_3d(dm.i0, v, 1.0);
+      vector_3d const step = dm.ray_matrix.col(0);
+      for (int i = 0; i < ni; ++i)
+      {
+        ray_x[i] = base.x() + i * step.x();
+        ray_y[i] = base.y() + i * step.y();
+        ray_z[i] = base.z() + i * step.z();
+      }
+    }
+    else
+    {
+      for (int i = 0; i < ni; ++i)
+      {
+        vector_2d const npt =
+          intrinsics.unmap(vector_2d(i + dm.i0, v));
+        vector_3d const ray = R_t * vector_3d(npt.x(), npt.y(), 1.0);
+        ray_x[i] = ray.x();
+        ray_y[i] = ray.y();
+        ray_z[i] = ray.z();
+      }
+    }
+
+    for (int i = 0; i < ni; ++i)
+    {
+      double const d = dm.depth(i, j);
+      if (!(d > 0.0) || !std::isfinite(d) ||
+          (has_uncertainty && !(dm.uncertainty(i, j) <= max_uncertainty)))
+      {
+        continue;
+      }
+      chunk.positions.emplace_back(center.x() + d * ray_x[i],
+                                   center.y() + d * ray_y[i],
+                                   center.z() + d * ray_z[i]);
+      if (has_color)
+      {
+        int const x = i + dm.i0;
+        int const y = j + dm.j0;
+        chunk.colors.emplace_back(dm.color(x, y, 0),
+                                  dm.color(x, y, gray ? 0 : 1),
+                                  dm.color(x, y, gray ? 0 : 2));
+      }
+    }
+  }
+}
+
+}
+
+/// Back-project a batch of depth maps into a single world point cloud
+pointcloud_sptr
+depth_maps_to_pointcloud(std::vector<image_container_sptr> const& depths,
+                         std::vector<camera_perspective_sptr> const& cameras,
+                         std::vector<image_container_sptr> const& uncertainties,
+                         double max_uncertainty,
+                         std::vector<image_container_sptr> const& colors,
+                         std::vector<bounding_box<int>> const& crops)
+{
+  size_t const num_maps = depths.size();
+  if (cameras.size() != num_maps ||
+      (!uncertainties.empty() && uncertainties.size() != num_maps) ||
+      (!colors.empty() && colors.size() != num_maps) ||
+      (!crops.empty() && crops.size() != num_maps))
+  {
+    VITAL_THROW(invalid_value,
+                "Depth map inputs must have an entry for each depth map");
+  }
+
+  std::vector<depth_map_view> maps(num_maps);
+  std::vector<row_chunk> chunks;
+  for (size_t m = 0; m < num_maps; ++m)
+  {
+    depth_map_view& dm = maps[m];
+    if (!depths[m] || !cameras[m])
+    {
+      VITAL_THROW(invalid_value, "Depth map or camera is missing");
+    }
+    cast_image(depths[m]->get_image(), dm.depth);
+    dm.camera = cameras[m];
+    if (!crops.empty() && crops[m].is_valid())
+    {
+      dm.i0 = crops[m].min_x();
+      dm.j0 = crops[m].min_y();
+    }
+    int const ni = static_cast<int>(dm.depth.width());
+    int const nj = static_cast<int>(dm.depth.height());
+
+    if (!uncertainties.empty() && uncertainties[m])
+    {
+      cast_image(uncertainties[m]->get_image(), dm.uncertainty);
+      if (dm.uncertainty.width() != dm.depth.width() ||
+          dm.uncertainty.height() != dm.depth.height())
+      {
+        VITAL_THROW(invalid_value,
+                    "Uncertainty image does not match depth map size");
+      }
+    }
+    if (!colors.empty())
+    {
+      if (!colors[m])
+      {
+        VITAL_THROW(invalid_value, "Color image is missing");
+      }
+      cast_image(colors[m]->get_image(), dm.color);
+      if (dm.i0 < 0 || dm.j0 < 0 ||
+          ni + dm.i0 > static_cast<int>(dm.color.width()) ||
+          nj + dm.j0 > static_cast<int>(dm.color.height()))
+      {
+        VITAL_THROW(invalid_value,
+                    "Depth map crop lies outside of the color image");
+      }
+    }
+
+    auto const intrinsics = dm.camera->intrinsics();
+    auto const dist = intrinsics->dist_coeffs();
+    dm.linear = std::all_of(dist.begin(), dist.end(),
+                            [](double c) { return c == 0.0; });
+    dm.ray_matrix = dm.camera->rotation().matrix().transpose() *
+                    matrix_3x3d(intrinsics->as_matrix().inverse());
+
+    if (ni == 0)
+    {
+      continue;
+    }
+    int const rows_per_chunk =
+      std::max(1, static_cast<int>(pixels_per_chunk / ni));
+    for (int j = 0; j < nj; j += rows_per_chunk)
+    {
+      chunks.push_back({ m, j, std::min(nj, j + rows_per_chunk), {}, {} });
+    }
+  }
+
+  vital::thread_pool::instance().parallel_for(
+    chunks.size(), 1,
+    [&](size_t begin, size_t end)
+    {
+      for (size_t c = begin; c < end; ++c)
+      {
+        back_project_rows(maps[chunks[c].map], max_uncertainty, chunks[c]);
+      }
+    });
+
+  size_t num_points = 0;
+  for (auto const& chunk : chunks)
+  {
+    num_points += chunk.positions.size();
+  }
+  std::vector<vector_3d> positions;
+  std::vector<rgb_color> point_colors;
+  positions.reserve(num_points);
+  point_colors.reserve(colors.empty() ? 0 : num_points);
+  for (auto const& chunk : chunks)
+  {
+    positions.insert(positions.end(),
+                     chunk.positions.begin(), chunk.positions.end());
+    point_colors.insert(point_colors.end(),
+                        chunk.colors.begin(), chunk.colors.end());
+  }
+
+  auto cloud = std::make_shared<pointcloud_d>(positions);
+  if (!point_colors.empty())
+  {
+    cloud->set_color(point_colors);
+  }
+  return cloud;
+}
+
+/// Back-project a depth map into a world point cloud
+pointcloud_sptr
+depth_map_to_pointcloud(image_container_sptr const& depth,
+                        camera_perspective_sptr const& camera,
+                        image_container_sptr const& uncertainty,
+                        double max_uncertainty,
+                        image_container_sptr const& color,
+                        bounding_box<int> const& crop)
+{
+  std::vector<image_container_sptr> uncertainties;
+  std::vector<image_container_sptr> colors;
+  if (uncertainty)
+  {
+    uncertainties.push_back(uncertainty);
+  }
+  if (color)
+  {
+    colors.push_back(color);
+  }
+  return depth_maps_to_pointcloud({ depth }, { camera }, uncertainties,
+                                  max_uncertainty, colors, { crop });
+}
+
 } //end namespace core
 } //end namespace arrows
 } //end namespace kwiver
@@ -18,6 +18,8 @@
 #include <vital/types/camera_perspective_map.h>
 #include <vital/types/camera_perspective.h>
 #include <vital/types/bounding_box.h>
+#include <vital/types/image_container.h>
+#include <vital/types/pointcloud.h>
 
 using namespace kwiver::vital;
 
@@ -232,6 +234,52 @@ find_similar_cameras_angles(camera_perspective const& ref_camera,
                             camera_perspective_map const& cameras,
                             double max_angle,
                             unsigned max_count = 0);
+/// Back-project a batch of depth maps into a single world point cloud
+///
+/// Each depth map holds the depth along the principal axis of its camera at
+/// each pixel.  Pixels with a positive finite depth are back-projected into
+/// world coordinates and all maps are concatenated, in order, into one point
+/// cloud.  The pixels of all maps are processed in parallel; maps for cameras
+/// without lens distortion use an incremental ray per scanline.
+///
+/// The depth map may be cropped from the camera image, in which case
+/// \p crops holds the crop box of each map.  The optional color images
+/// are the uncropped source images and are sampled through the same crop,
+/// as in depth_to_vtk.  The optional uncertainty images have the size of the
+/// depth maps.  Any of these vectors may be empty; otherwise they must have
+/// an entry for each depth map.
+///
+/// \param depths          The depth maps to convert
+/// \param cameras         The camera of each depth map
+/// \param uncertainties   The optional depth standard deviation of each map
+/// \param max_uncertainty Drop points with a larger uncertainty, if positive
+/// \param colors          The optional source RGB image of each map
+/// \param crops           The optional crop box of each map in its image
+/// \returns a point cloud of the back-projected points, with colors if given
+KWIVER_ALGO_CORE_EXPORT
+kwiver::vital::pointcloud_sptr
+depth_maps_to_pointcloud(
+  std::vector<kwiver::vital::image_container_sptr> const& depths,
+  std::vector<kwiver::vital::camera_perspective_sptr> const& cameras,
+  std::vector<kwiver::vital::image_container_sptr> const& uncertainties = {},
+  double max_uncertainty = 0.0,
+  std::vector<kwiver::vital::image_container_sptr> const& colors = {},
+  std::vector<kwiver::vital::bounding_box<int>> const& crops = {});
+
+/// Back-project a depth map into a world point cloud
+///
+/// This is depth_maps_to_pointcloud for a single depth map; null
+/// \p uncertainty or \p color images are ignored.
+KWIVER_ALGO_CORE_EXPORT
+kwiver::vital::pointcloud_sptr
+depth_map_to_pointcloud(
+  kwiver::vital::image_container_sptr const& depth,
+  kwiver::vital::camera_perspective_sptr const& camera,
+  kwiver::vital::image_container_sptr const& uncertainty = nullptr,
+  double max_uncertainty = 0.0,
+  kwiver::vital::image_container_sptr const& color = nullptr,
+  kwiver::vital::bounding_box<int> const& crop = {});
+
 } //end namespace core
 } //end namespace arrows
 } //end namespace kwiver
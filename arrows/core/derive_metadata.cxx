@@ -14,8 +14,14 @@
 #include <vital/types/rotation.h>
 
 #include <vital/math_constants.h>
+#include <vital/util/tokenize.h>
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 #include <cmath>
 
@@ -411,6 +417,167 @@ compute_wavelength( std::string const& image_source )
   return "";
 }
 
+// ----------------------------------------------------------------------------
+// Fields derived by this algorithm, in the order in which they are computed
+enum derived_field
+{
+  FIELD_WAVELENGTH,
+  FIELD_SLANT_RANGE,
+  FIELD_AVERAGE_GSD,
+  FIELD_VNIIRS,
+  FIELD_COUNT,
+};
+
+// ----------------------------------------------------------------------------
+// Dependencies of a derived field. The inputs are read after the fields
+// before it have been added, so a field may depend on those.
+struct field_info
+{
+  char const* name;
+  kv::vital_metadata_tag tag;
+  std::vector< kv::vital_metadata_tag > inputs;
+  bool uses_image;
+
+  // Field which, when enabled, must have been derived for this one to be
+  derived_field prerequisite;
+};
+
+// ----------------------------------------------------------------------------
+field_info const&
+get_field_info( derived_field field )
+{
+  static field_info const table[ FIELD_COUNT ] = {
+    { "wavelength", kv::VITAL_META_WAVELENGTH,
+      { kv::VITAL_META_IMAGE_SOURCE_SENSOR,
+        kv::VITAL_META_WAVELENGTH },
+      false, FIELD_COUNT },
+    { "slant_range", kv::VITAL_META_SLANT_RANGE,
+      { kv::VITAL_META_SLANT_RANGE,
+        kv::VITAL_META_PLATFORM_HEADING_ANGLE,
+        kv::VITAL_META_PLATFORM_PITCH_ANGLE,
+        kv::VITAL_META_PLATFORM_ROLL_ANGLE,
+        kv::VITAL_META_SENSOR_REL_AZ_ANGLE,
+        kv::VITAL_META_SENSOR_REL_EL_ANGLE,
+        kv::VITAL_META_SENSOR_REL_ROLL_ANGLE,
+        kv::VITAL_META_SENSOR_LOCATION,
+        kv::VITAL_META_FRAME_CENTER },
+      false, FIELD_COUNT },
+    { "average_gsd", kv::VITAL_META_AVERAGE_GSD,
+      { kv::VITAL_META_SLANT_RANGE,
+        kv::VITAL_META_PLATFORM_HEADING_ANGLE,
+        kv::VITAL_META_PLATFORM_PITCH_ANGLE,
+        kv::VITAL_META_PLATFORM_ROLL_ANGLE,
+        kv::VITAL_META_SENSOR_REL_AZ_ANGLE,
+        kv::VITAL_META_SENSOR_REL_EL_ANGLE,
+        kv::VITAL_META_SENSOR_REL_ROLL_ANGLE,
+        kv::VITAL_META_SENSOR_HORIZONTAL_FOV,
+        kv::VITAL_META_SENSOR_VERTICAL_FOV,
+        kv::VITAL_META_TARGET_WIDTH },
+      true, FIELD_SLANT_RANGE },
+    // The RER and SNR estimates do not yet depend on the image content, so
+    // only the GSD and frame dimensions affect VNIIRS
+    { "vniirs", kv::VITAL_META_VNIIRS,
+      { kv::VITAL_META_AVERAGE_GSD },
+      true, FIELD_AVERAGE_GSD },
+  };
+
+  return table[ field ];
+}
+
+// ----------------------------------------------------------------------------
+// Compute the value of a derived field.
+//
+// Returns false if the field does not apply to this metadata, and throws
+// invalid_value if the metadata is insufficient to derive it.
+bool
+compute_field( derived_field field,
+               kwiver::vital::metadata_sptr const& metadata,
+               kwiver::vital::image_container_scptr const& image,
+               kwiver::vital::metadata_value& value )
+{
+  switch( field )
+  {
+    case FIELD_WAVELENGTH:
+    {
+      auto const& image_source =
+        metadata->find( kv::VITAL_META_IMAGE_SOURCE_SENSOR );
+      if( !image_source || metadata->has( kv::VITAL_META_WAVELENGTH ) )
+      {
+        return false;
+      }
+
+      auto const wavelength = compute_wavelength( image_source.as_string() );
+      value = wavelength;
+      return !wavelength.empty();
+    }
+    case FIELD_SLANT_RANGE:
+      value = compute_slant_range( metadata );
+      return true;
+    case FIELD_AVERAGE_GSD:
+      if( !image )
+      {
+        return false;
+      }
+      value = compute_gsd( metadata, image->width(), image->height() );
+      return true;
+    case FIELD_VNIIRS:
+    {
+      auto const& gsd = metadata->find( kv::VITAL_META_AVERAGE_GSD );
+      if( !image || !gsd )
+      {
+        return false;
+      }
+
+      auto const rer = compute_rer( image );
+      auto const snr = compute_snr( image );
+      value = compute_vniirs( gsd.as_double(), rer, snr );
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Parse a list of field names; returns false if any name is unknown
+bool
+parse_fields( std::string const& list, bool ( &enabled )[ FIELD_COUNT ] )
+{
+  std::vector< std::string > names;
+  kv::tokenize( list, names, ", ", kv::TokenizeTrimEmpty );
+
+  std::fill( enabled, enabled + FIELD_COUNT, false );
+  for( auto const& name : names )
+  {
+    bool found = false;
+    for( int f = 0; f < FIELD_COUNT; ++f )
+    {
+      if( name == get_field_info( static_cast< derived_field >( f ) ).name )
+      {
+        enabled[ f ] = found = true;
+      }
+    }
+    if( !found )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+// Inputs and result of the last computation of a derived field
+struct field_cache
+{
+  bool valid = false;
+  std::vector< std::pair< bool, kv::metadata_value > > inputs;
+  size_t width = 0;
+  size_t height = 0;
+
+  bool derived = false;
+  kv::metadata_value value;
+};
+
 } // namespace <anonymous>
 
 //END helpers
@@ -419,9 +586,89 @@ compute_wavelength( std::string const& image_source )
 
 //BEGIN algorithm interface
 
+// ----------------------------------------------------------------------------
+class derive_metadata::priv
+{
+public:
+  // Derive the enabled fields of one metadata packet
+  void derive( kv::metadata_sptr const& metadata,
+               kv::image_container_scptr const& image,
+               field_cache* cache );
+
+  bool enabled[ FIELD_COUNT ] = { true, true, true, true };
+
+  // Last computation of each field for each metadata stream, keyed by the
+  // stream index, or by position for packets without one
+  std::map< std::pair< bool, int >, std::vector< field_cache > > caches;
+};
+
+// ----------------------------------------------------------------------------
+void
+derive_metadata::priv
+::derive( kv::metadata_sptr const& metadata,
+          kv::image_container_scptr const& image,
+          field_cache* cache )
+{
+  bool derived[ FIELD_COUNT ] = {};
+
+  for( int f = 0; f < FIELD_COUNT; ++f )
+  {
+    auto const field = static_cast< derived_field >( f );
+    auto const& info = get_field_info( field );
+    auto& c = cache[ f ];
+
+    if( !this->enabled[ f ] ||
+        ( info.prerequisite != FIELD_COUNT &&
+          this->enabled[ info.prerequisite ] &&
+          !derived[ info.prerequisite ] ) )
+    {
+      continue;
+    }
+
+    // Gather the inputs as they are now, including earlier derived fields
+    std::vector< std::pair< bool, kv::metadata_value > > inputs;
+    inputs.reserve( info.inputs.size() );
+    for( auto const tag : info.inputs )
+    {
+      auto const& item = metadata->find( tag );
+      inputs.emplace_back( item.is_valid(),
+                           item ? item.data() : kv::metadata_value{} );
+    }
+
+    size_t const width = ( info.uses_image && image ? image->width() : 0 );
+    size_t const height = ( info.uses_image && image ? image->height() : 0 );
+
+    // Only compute the field again if its inputs have changed
+    if( !c.valid || c.inputs != inputs ||
+        c.width != width || c.height != height )
+    {
+      try
+      {
+        c.derived = compute_field( field, metadata, image, c.value );
+      }
+      catch ( kv::invalid_value const& e )
+      {
+        c.derived = false;
+      }
+
+      c.valid = true;
+      c.inputs = std::move( inputs );
+      c.width = width;
+      c.height = height;
+    }
+
+    if( c.derived )
+    {
+      metadata->add( info.tag, c.value );
+      derived[ f ] = true;
+    }
+  }
+}
+
 // ----------------------------------------------------------------------------
 derive_metadata
 ::derive_metadata()
+  : d_{ new priv }
 {
   this->set_capability( CAN_USE_FRAME_IMAGE, true );
 }
@@ -437,25 +684,55 @@ vital::config_block_sptr
 derive_metadata
 ::get_configuration() const
 {
-  // No configuration; return from base class
-  return vital::algo::metadata_filter::get_configuration();
+  auto config = vital::algo::metadata_filter::get_configuration();
+
+  std::stringstream fields;
+  std::stringstream all_fields;
+  for( int f = 0; f < FIELD_COUNT; ++f )
+  {
+    auto const name = get_field_info( static_cast< derived_field >( f ) ).name;
+    all_fields << ( f ? ", " : "" ) << name;
+    if( d_->enabled[ f ] )
+    {
+      fields << ( fields.tellp() > 0 ? ", " : "" ) << name;
+    }
+  }
+
+  config->set_value(
+    "fields", fields.str(),
+    "Comma-separated list of the fields to derive, out of: " +
+    all_fields.str() + ". Fields not listed are left as they are in the "
+    "input metadata." );
+
+  return config;
 }
 
 // ----------------------------------------------------------------------------
 void
 derive_metadata
-::set_configuration( vital::config_block_sptr )
+::set_configuration( vital::config_block_sptr in_config )
 {
-  // No configuration
+  auto config = this->get_configuration();
+  config->merge_config( in_config );
+
+  bool enabled[ FIELD_COUNT ];
+  if( !parse_fields( config->get_value< std::string >( "fields" ), enabled ) )
+  {
+    VITAL_THROW( kv::algorithm_configuration_exception,
+                 type_name(), impl_name(), "unknown derived field" );
+  }
+  std::copy( enabled, enabled + FIELD_COUNT, d_->enabled );
+  d_->caches.clear();
 }
 
 // ----------------------------------------------------------------------------
 bool
 derive_metadata
-::check_configuration( vital::config_block_sptr ) const
+::check_configuration( vital::config_block_sptr config ) const
 {
-  // No configuration, so always return true
-  return true;
+  bool enabled[ FIELD_COUNT ];
+  return parse_fields(
+    config->get_value< std::string >( "fields", "" ), enabled );
 }
 
 // ----------------------------------------------------------------------------
@@ -466,50 +743,23 @@ ::filter( kwiver::vital::metadata_vector const& input_metadata,
 {
   kv::metadata_vector updated_values;
 
-  for( auto const& metadata : input_metadata )
+  for( size_t i = 0; i < input_metadata.size(); ++i )
   {
+    auto const& metadata = input_metadata[ i ];
+
     // Deep copy metadata
     auto updated_metadata = kv::metadata_sptr( metadata->clone() );
 
-    try
-    {
-      // Compute wavelength
-      auto const& image_source =
-        metadata->find( kv::VITAL_META_IMAGE_SOURCE_SENSOR );
-      if( image_source && !metadata->has( kv::VITAL_META_WAVELENGTH ) )
-      {
-        auto const wavelength = compute_wavelength( image_source.as_string() );
-        if( !wavelength.empty() )
-        {
-          updated_metadata->add< kv::VITAL_META_WAVELENGTH >( wavelength );
-        }
-      }
+    auto const& stream_index =
+      metadata->find( kv::VITAL_META_VIDEO_DATA_STREAM_INDEX );
+    auto const key =
+      stream_index
+      ? std::make_pair( true, stream_index.get< int >() )
+      : std::make_pair( false, static_cast< int >( i ) );
+    auto& cache = d_->caches[ key ];
+    cache.resize( FIELD_COUNT );
 
-      // Compute slant range. Must be inserted before GSD calculation
-      auto const slant_range = compute_slant_range( updated_metadata );
-      updated_metadata->add< kv::VITAL_META_SLANT_RANGE >( slant_range );
-
-      if( input_image )
-      {
-        auto const frame_width = input_image->width();
-        auto const frame_height = input_image->height();
-
-        // Compute GSD
-        auto const gsd =
-          compute_gsd( updated_metadata, frame_width, frame_height );
-        updated_metadata->add< kv::VITAL_META_AVERAGE_GSD >( gsd );
-
-        // Compute VNIIRS
-        auto const rer = compute_rer( input_image );
-        auto const snr = compute_snr( input_image );
-        auto const vniirs = compute_vniirs( gsd, rer, snr );
-        updated_metadata->add< kv::VITAL_META_VNIIRS >( vniirs );
-      }
-    }
-    catch ( kv::invalid_value const& e )
-    {
-      // Fail silently
-    }
+    d_->derive( updated_metadata, input_image, cache.data() );
 
     updated_values.push_back( updated_metadata );
   }
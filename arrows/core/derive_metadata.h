@@ -12,12 +12,20 @@
 
 #include <vital/algo/metadata_filter.h>
 
+#include <memory>
+
 namespace kwiver {
 
 namespace arrows {
 
 namespace core {
 
+/// Fills in metadata values which can be calculated from other metadata.
+///
+/// The derived fields are the sensor wavelength, slant range, average GSD
+/// and VNIIRS. Each is only computed again when one of the metadata values
+/// or frame dimensions it depends on differs from the previous frame of the
+/// same metadata stream; otherwise its previous value is reused.
 class KWIVER_ALGO_CORE_EXPORT derive_metadata
   : public vital::algo::metadata_filter
 {
@@ -42,6 +50,11 @@ class KWIVER_ALGO_CORE_EXPORT derive_metadata
   kwiver::vital::metadata_vector filter(
     kwiver::vital::metadata_vector const& input_metadata,
     kwiver::vital::image_container_scptr const& input_image ) override;
+
+private:
+  class priv;
+
+  std::unique_ptr< priv > const d_;
 };
 
 } // namespace core
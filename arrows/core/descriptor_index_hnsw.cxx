@@ -0,0 +1,790 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of the core descriptor_index_hnsw algorithm
+
+#include "descriptor_index_hnsw.h"
+
+#include <vital/exceptions/base.h>
+#include <vital/exceptions/io.h>
+#include <vital/util/mapped_file.h>
+#include <vital/util/thread_pool.h>
+
+#include <kwiversys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <unordered_set>
+#include <utility>
+
+#include <cmath>
+#include <cstdint>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+namespace {
+
+// Number of queries handed to a thread at a time
+constexpr size_t queries_per_chunk = 16;
+
+using node_id = uint32_t;
+
+// A node as squared distance and id
+using candidate_t = std::pair< float, node_id >;
+
+// Header of a saved index, followed by the descriptors, the bottom layer
+// links, the level of each node padded to a multiple of four bytes, and the
+// upper layer links of each node in turn
+struct file_header
+{
+  char magic[ 8 ];
+  uint64_t dimension;
+  uint64_t count;
+  uint64_t max_links;
+  uint64_t entry;
+  int64_t max_level;
+};
+
+constexpr char file_magic[ 8 ] = { 'K', 'W', 'H', 'N', 'S', 'W', '0', '1' };
+
+// ----------------------------------------------------------------------------
+float
+squared_distance( float const* a, float const* b, size_t dimension )
+{
+  float sum = 0.0f;
+  for( size_t i = 0; i < dimension; ++i )
+  {
+    auto const diff = a[ i ] - b[ i ];
+    sum += diff * diff;
+  }
+  return sum;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+// Private implementation class
+class descriptor_index_hnsw::priv
+{
+public:
+  priv() { reset(); }
+
+  void reset();
+  void update_pointers();
+  void own_storage();
+
+  std::vector< float > to_values(
+    std::vector< vital::descriptor_sptr > const& descriptors,
+    size_t& dimension ) const;
+
+  float const* vector( node_id n ) const
+  {
+    return m_vectors + static_cast< size_t >( n ) * m_dimension;
+  }
+  float distance( float const* a, node_id b ) const
+  {
+    return squared_distance( a, vector( b ), m_dimension );
+  }
+
+  size_t capacity( int level ) const
+  {
+    return level ? m_links : 2 * m_links;
+  }
+  // Links of a node on a level, as the number of links followed by the ids
+  node_id const* links( node_id n, int level ) const
+  {
+    if( level )
+    {
+      return m_upper_links[ n ].data() + ( level - 1 ) * ( m_links + 1 );
+    }
+    return m_links0 + static_cast< size_t >( n ) * ( 2 * m_links + 1 );
+  }
+  node_id* mutable_links( node_id n, int level )
+  {
+    return const_cast< node_id* >( links( n, level ) );
+  }
+
+  int random_level();
+  void insert( float const* values );
+  void connect( node_id n, node_id other, int level );
+  void select_neighbors( std::vector< candidate_t >& candidates,
+                         size_t m ) const;
+
+  candidate_t greedy_search( float const* query, candidate_t entry,
+                             int level ) const;
+  void search_level( float const* query,
+                     std::vector< candidate_t > const& entry_points,
+                     size_t ef, int level,
+                     std::vector< candidate_t >& result ) const;
+  void find_nearest( float const* query, size_t k,
+                     std::vector< size_t >& indices,
+                     std::vector< double >& distances ) const;
+
+  size_t max_links{ 16 };
+  size_t ef_construction{ 200 };
+  size_t ef_search{ 64 };
+
+  // Structure of the graph, fixed when the first descriptor is added
+  size_t m_dimension;
+  size_t m_links;
+  size_t m_count;
+  node_id m_entry;
+  int m_max_level;
+
+  // The descriptors and bottom layer links are views of either the owned
+  // vectors or of a loaded file
+  vital::mapped_file m_file;
+  std::vector< float > m_owned_vectors;
+  std::vector< node_id > m_owned_links0;
+  float const* m_vectors;
+  node_id const* m_links0;
+
+  std::vector< uint8_t > m_levels;
+  std::vector< std::vector< node_id > > m_upper_links;
+  std::mt19937 m_random;
+};
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw::priv
+::reset()
+{
+  m_dimension = 0;
+  m_links = max_links;
+  m_count = 0;
+  m_entry = 0;
+  m_max_level = -1;
+  m_file.close();
+  m_owned_vectors.clear();
+  m_owned_links0.clear();
+  m_levels.clear();
+  m_upper_links.clear();
+  m_random.seed( std::mt19937::default_seed );
+  update_pointers();
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw::priv
+::update_pointers()
+{
+  m_vectors = m_owned_vectors.data();
+  m_links0 = m_owned_links0.data();
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw::priv
+::own_storage()
+{
+  if( m_file.is_open() )
+  {
+    m_owned_vectors.assign( m_vectors, m_vectors + m_count * m_dimension );
+    m_owned_links0.assign(
+      m_links0, m_links0 + m_count * ( 2 * m_links + 1 ) );
+    m_file.close();
+    update_pointers();
+  }
+}
+
+// ----------------------------------------------------------------------------
+std::vector< float >
+descriptor_index_hnsw::priv
+::to_values( std::vector< vital::descriptor_sptr > const& descriptors,
+             size_t& dimension ) const
+{
+  std::vector< float > values;
+  for( auto const& desc : descriptors )
+  {
+    if( !desc )
+    {
+      VITAL_THROW( vital::invalid_value, "Null descriptor" );
+    }
+
+    auto const d = desc->as_double();
+    if( !dimension )
+    {
+      dimension = d.size();
+      values.reserve( descriptors.size() * dimension );
+    }
+    if( !d.size() || d.size() != dimension )
+    {
+      VITAL_THROW( vital::invalid_value,
+                   "Descriptor of size " + std::to_string( d.size() ) +
+                   " does not match the index descriptor size " +
+                   std::to_string( dimension ) );
+    }
+    values.insert( values.end(), d.begin(), d.end() );
+  }
+  return values;
+}
+
+// ----------------------------------------------------------------------------
+int
+descriptor_index_hnsw::priv
+::random_level()
+{
+  // Levels are geometrically distributed, each 1 / m_links as populated
+  // as the one below
+  std::uniform_real_distribution< double > uniform( 0.0, 1.0 );
+  auto const level = -std::log( 1.0 - uniform( m_random ) ) /
+                     std::log( static_cast< double >( m_links ) );
+  return static_cast< int >(
+    std::min( level, static_cast< double >(
+                       std::numeric_limits< uint8_t >::max() ) ) );
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw::priv
+::insert( float const* values )
+{
+  auto const id = static_cast< node_id >( m_count );
+  auto const level = random_level();
+
+  m_owned_vectors.insert( m_owned_vectors.end(),
+                          values, values + m_dimension );
+  m_owned_links0.resize( m_owned_links0.size() + 2 * m_links + 1, 0 );
+  m_levels.push_back( static_cast< uint8_t >( level ) );
+  m_upper_links.emplace_back( level * ( m_links + 1 ), 0 );
+  update_pointers();
+  ++m_count;
+
+  if( m_max_level < 0 )
+  {
+    m_entry = id;
+    m_max_level = level;
+    return;
+  }
+
+  // Descend through the levels above the new node greedily, then link the
+  // node to its nearest neighbors on each of its levels
+  auto const* const query = vector( id );
+  auto entry = candidate_t{ distance( query, m_entry ), m_entry };
+  for( auto l = m_max_level; l > level; --l )
+  {
+    entry = greedy_search( query, entry, l );
+  }
+
+  std::vector< candidate_t > entry_points{ entry };
+  std::vector< candidate_t > found;
+  for( auto l = std::min( level, m_max_level ); l >= 0; --l )
+  {
+    search_level( query, entry_points, ef_construction, l, found );
+    entry_points = found;
+
+    select_neighbors( found, capacity( l ) );
+    auto* const l_links = mutable_links( id, l );
+    l_links[ 0 ] = static_cast< node_id >( found.size() );
+    for( size_t i = 0; i < found.size(); ++i )
+    {
+      l_links[ i + 1 ] = found[ i ].second;
+      connect( found[ i ].second, id, l );
+    }
+  }
+
+  if( level > m_max_level )
+  {
+    m_entry = id;
+    m_max_level = level;
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw::priv
+::connect( node_id n, node_id other, int level )
+{
+  auto* const n_links = mutable_links( n, level );
+  auto const cap = capacity( level );
+  if( n_links[ 0 ] < cap )
+  {
+    n_links[ ++n_links[ 0 ] ] = other;
+    return;
+  }
+
+  // The node is full, so keep the best of its links and the new one
+  auto const* const n_vector = vector( n );
+  std::vector< candidate_t > candidates;
+  candidates.reserve( cap + 1 );
+  candidates.emplace_back( distance( n_vector, other ), other );
+  for( size_t i = 1; i <= cap; ++i )
+  {
+    candidates.emplace_back( distance( n_vector, n_links[ i ] ),
+                             n_links[ i ] );
+  }
+  std::sort( candidates.begin(), candidates.end() );
+  select_neighbors( candidates, cap );
+
+  n_links[ 0 ] = static_cast< node_id >( candidates.size() );
+  for( size_t i = 0; i < candidates.size(); ++i )
+  {
+    n_links[ i + 1 ] = candidates[ i ].second;
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw::priv
+::select_neighbors( std::vector< candidate_t >& candidates, size_t m ) const
+{
+  if( candidates.size() <= m )
+  {
+    return;
+  }
+
+  // Keep the nearest candidates that are nearer to the node than to any
+  // already kept, which spreads the links in different directions
+  std::vector< candidate_t > selected;
+  selected.reserve( m );
+  for( auto const& c : candidates )
+  {
+    if( selected.size() >= m )
+    {
+      break;
+    }
+
+    auto const* const c_vector = vector( c.second );
+    auto const keep =
+      std::none_of( selected.begin(), selected.end(),
+                    [ & ]( candidate_t const& s ){
+                      return distance( c_vector, s.second ) < c.first;
+                    } );
+    if( keep )
+    {
+      selected.push_back( c );
+    }
+  }
+  candidates.swap( selected );
+}
+
+// ----------------------------------------------------------------------------
+candidate_t
+descriptor_index_hnsw::priv
+::greedy_search( float const* query, candidate_t entry, int level ) const
+{
+  for( auto changed = true; changed; )
+  {
+    changed = false;
+    auto const* const l_links = links( entry.second, level );
+    for( node_id i = 1; i <= l_links[ 0 ]; ++i )
+    {
+      auto const d = distance( query, l_links[ i ] );
+      if( d < entry.first )
+      {
+        entry = { d, l_links[ i ] };
+        changed = true;
+      }
+    }
+  }
+  return entry;
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw::priv
+::search_level( float const* query,
+                std::vector< candidate_t > const& entry_points,
+                size_t ef, int level,
+                std::vector< candidate_t >& result ) const
+{
+  std::unordered_set< node_id > visited;
+  std::priority_queue< candidate_t, std::vector< candidate_t >,
+                       std::greater< candidate_t > > to_expand;
+  std::priority_queue< candidate_t > best;
+  for( auto const& e : entry_points )
+  {
+    visited.insert( e.second );
+    to_expand.push( e );
+    best.push( e );
+  }
+  while( best.size() > ef )
+  {
+    best.pop();
+  }
+
+  // Expand the nearest unexpanded node until it is farther than all of the
+  // ef best nodes found
+  while( !to_expand.empty() )
+  {
+    auto const c = to_expand.top();
+    if( c.first > best.top().first )
+    {
+      break;
+    }
+    to_expand.pop();
+
+    auto const* const l_links = links( c.second, level );
+    for( node_id i = 1; i <= l_links[ 0 ]; ++i )
+    {
+      auto const n = l_links[ i ];
+      if( !visited.insert( n ).second )
+      {
+        continue;
+      }
+
+      auto const d = distance( query, n );
+      if( best.size() < ef || d < best.top().first )
+      {
+        to_expand.emplace( d, n );
+        best.emplace( d, n );
+        if( best.size() > ef )
+        {
+          best.pop();
+        }
+      }
+    }
+  }
+
+  result.resize( best.size() );
+  for( auto i = result.size(); i > 0; --i )
+  {
+    result[ i - 1 ] = best.top();
+    best.pop();
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw::priv
+::find_nearest( float const* query, size_t k,
+                std::vector< size_t >& indices,
+                std::vector< double >& distances ) const
+{
+  indices.clear();
+  distances.clear();
+  if( !k || !m_count )
+  {
+    return;
+  }
+
+  auto entry = candidate_t{ distance( query, m_entry ), m_entry };
+  for( auto l = m_max_level; l > 0; --l )
+  {
+    entry = greedy_search( query, entry, l );
+  }
+
+  std::vector< candidate_t > found;
+  search_level( query, { entry }, std::max( ef_search, k ), 0, found );
+  found.resize( std::min( found.size(), k ) );
+
+  indices.reserve( found.size() );
+  distances.reserve( found.size() );
+  for( auto const& c : found )
+  {
+    indices.push_back( c.second );
+    distances.push_back( std::sqrt( static_cast< double >( c.first ) ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+descriptor_index_hnsw
+::descriptor_index_hnsw()
+  : d{ new priv{} }
+{
+  attach_logger( "arrows.core.descriptor_index_hnsw" );
+}
+
+// ----------------------------------------------------------------------------
+descriptor_index_hnsw
+::~descriptor_index_hnsw()
+{
+}
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+descriptor_index_hnsw
+::get_configuration() const
+{
+  // get base config from base class
+  vital::config_block_sptr config =
+    vital::algo::descriptor_index::get_configuration();
+
+  config->set_value( "max_links", d->max_links,
+                     "Maximum number of links of each descriptor on each "
+                     "level of the graph, doubled on the bottom level. More "
+                     "links improve recall on high dimensional descriptors "
+                     "at the cost of memory and search time. This is fixed "
+                     "when the first descriptor is added to the index." );
+  config->set_value( "ef_construction", d->ef_construction,
+                     "Number of candidate neighbors considered when adding "
+                     "a descriptor. Larger values build a better graph more "
+                     "slowly." );
+  config->set_value( "ef_search", d->ef_search,
+                     "Number of candidates kept while searching. Larger "
+                     "values find the true nearest descriptors more often "
+                     "but search more slowly. At least the number of "
+                     "requested neighbors are always kept." );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw
+::set_configuration( vital::config_block_sptr in_config )
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config( in_config );
+
+  d->max_links = config->get_value< size_t >( "max_links" );
+  d->ef_construction = config->get_value< size_t >( "ef_construction" );
+  d->ef_search = config->get_value< size_t >( "ef_search" );
+  if( !d->m_count )
+  {
+    d->m_links = d->max_links;
+  }
+}
+
+// ----------------------------------------------------------------------------
+bool
+descriptor_index_hnsw
+::check_configuration( vital::config_block_sptr in_config ) const
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config( in_config );
+
+  if( config->get_value< size_t >( "max_links" ) < 2 )
+  {
+    LOG_ERROR( logger(), "max_links must be at least 2" );
+    return false;
+  }
+  if( config->get_value< size_t >( "ef_construction" ) < 1 ||
+      config->get_value< size_t >( "ef_search" ) < 1 )
+  {
+    LOG_ERROR( logger(), "ef_construction and ef_search must be at least 1" );
+    return false;
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw
+::add( std::vector< vital::descriptor_sptr > const& descriptors )
+{
+  // Check every descriptor before changing the index
+  auto dimension = d->m_dimension;
+  auto const values = d->to_values( descriptors, dimension );
+  if( d->m_count + descriptors.size() >
+      std::numeric_limits< node_id >::max() )
+  {
+    VITAL_THROW( vital::invalid_value,
+                 "Too many descriptors for an HNSW index" );
+  }
+  if( descriptors.empty() )
+  {
+    return;
+  }
+
+  d->own_storage();
+  d->m_dimension = dimension;
+  d->m_owned_vectors.reserve( values.size() + d->m_owned_vectors.size() );
+  d->m_owned_links0.reserve(
+    d->m_owned_links0.size() +
+    descriptors.size() * ( 2 * d->m_links + 1 ) );
+  for( size_t i = 0; i < descriptors.size(); ++i )
+  {
+    d->insert( values.data() + i * dimension );
+  }
+}
+
+// ----------------------------------------------------------------------------
+size_t
+descriptor_index_hnsw
+::size() const
+{
+  return d->m_count;
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw
+::clear()
+{
+  d->reset();
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw
+::find_nearest(
+  std::vector< vital::descriptor_sptr > const& queries,
+  size_t K,
+  std::vector< std::vector< size_t > >& indices,
+  std::vector< std::vector< double > >& distances ) const
+{
+  indices.clear();
+  distances.clear();
+  indices.resize( queries.size() );
+  distances.resize( queries.size() );
+  if( !d->m_count )
+  {
+    return;
+  }
+
+  auto dimension = d->m_dimension;
+  auto const values = d->to_values( queries, dimension );
+  vital::thread_pool::instance().parallel_for(
+    queries.size(), queries_per_chunk,
+    [ & ]( size_t begin, size_t end ){
+      for( auto i = begin; i < end; ++i )
+      {
+        d->find_nearest( values.data() + i * dimension, K,
+                         indices[ i ], distances[ i ] );
+      }
+    } );
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw
+::save( std::string const& filename ) const
+{
+  // The file may be the one the index was loaded from, which must not be
+  // truncated while it is mapped
+  d->own_storage();
+
+  std::ofstream out( filename, std::ios::binary );
+  if( !out )
+  {
+    VITAL_THROW( vital::file_write_exception, filename,
+                 "Could not open the file for writing" );
+  }
+
+  file_header header;
+  std::memcpy( header.magic, file_magic, sizeof( file_magic ) );
+  header.dimension = d->m_dimension;
+  header.count = d->m_count;
+  header.max_links = d->m_links;
+  header.entry = d->m_entry;
+  header.max_level = d->m_max_level;
+
+  auto const write =
+    [ &out ]( void const* data, size_t size ){
+      out.write( static_cast< char const* >( data ),
+                 static_cast< std::streamsize >( size ) );
+    };
+  write( &header, sizeof( header ) );
+  write( d->m_vectors, d->m_count * d->m_dimension * sizeof( float ) );
+  write( d->m_links0,
+         d->m_count * ( 2 * d->m_links + 1 ) * sizeof( node_id ) );
+  write( d->m_levels.data(), d->m_levels.size() );
+  char const padding[ sizeof( node_id ) ] = {};
+  write( padding, ( sizeof( node_id ) - d->m_count % sizeof( node_id ) ) %
+                  sizeof( node_id ) );
+  for( auto const& l : d->m_upper_links )
+  {
+    write( l.data(), l.size() * sizeof( node_id ) );
+  }
+
+  if( !out.flush() )
+  {
+    VITAL_THROW( vital::file_write_exception, filename,
+                 "Could not write the index" );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_index_hnsw
+::load( std::string const& filename )
+{
+  if( !kwiversys::SystemTools::FileExists( filename ) )
+  {
+    VITAL_THROW( vital::file_not_found_exception, filename,
+                 "File does not exist" );
+  }
+
+  vital::mapped_file file;
+  if( !file.open( filename ) )
+  {
+    VITAL_THROW( vital::file_not_read_exception, filename,
+                 "Could not map the file" );
+  }
+
+  file_header header;
+  if( file.size() < sizeof( header ) )
+  {
+    VITAL_THROW( vital::invalid_file, filename, "Not an HNSW index" );
+  }
+  std::memcpy( &header, file.data(), sizeof( header ) );
+  if( std::memcmp( header.magic, file_magic, sizeof( file_magic ) ) )
+  {
+    VITAL_THROW( vital::invalid_file, filename, "Not an HNSW index" );
+  }
+
+  auto const count = static_cast< size_t >( header.count );
+  auto const links = static_cast< size_t >( header.max_links );
+  auto const vectors_offset = sizeof( header );
+  auto const links0_offset =
+    vectors_offset + count * header.dimension * sizeof( float );
+  auto const levels_offset =
+    links0_offset + count * ( 2 * links + 1 ) * sizeof( node_id );
+  auto const upper_offset =
+    levels_offset + ( count + sizeof( node_id ) - 1 ) / sizeof( node_id ) *
+                    sizeof( node_id );
+  if( links < 2 || count > std::numeric_limits< node_id >::max() ||
+      ( count && ( !header.dimension || header.entry >= count ) ) ||
+      upper_offset > file.size() )
+  {
+    VITAL_THROW( vital::invalid_file, filename, "Truncated or invalid index" );
+  }
+
+  auto const* const levels =
+    reinterpret_cast< uint8_t const* >( file.data() + levels_offset );
+  auto const* upper =
+    reinterpret_cast< node_id const* >( file.data() + upper_offset );
+  size_t upper_size = 0;
+  for( size_t i = 0; i < count; ++i )
+  {
+    upper_size += levels[ i ] * ( links + 1 );
+  }
+  if( upper_offset + upper_size * sizeof( node_id ) != file.size() )
+  {
+    VITAL_THROW( vital::invalid_file, filename, "Truncated or invalid index" );
+  }
+
+  d->reset();
+  d->m_dimension = static_cast< size_t >( header.dimension );
+  d->m_links = links;
+  d->m_count = count;
+  d->m_entry = static_cast< node_id >( header.entry );
+  d->m_max_level = static_cast< int >( header.max_level );
+  d->m_levels.assign( levels, levels + count );
+  d->m_upper_links.resize( count );
+  for( size_t i = 0; i < count; ++i )
+  {
+    auto const n = levels[ i ] * ( links + 1 );
+    d->m_upper_links[ i ].assign( upper, upper + n );
+    upper += n;
+  }
+
+  // The descriptors and bottom layer stay in the mapped file until the index
+  // is modified
+  if( count )
+  {
+    d->m_vectors =
+      reinterpret_cast< float const* >( file.data() + vectors_offset );
+    d->m_links0 =
+      reinterpret_cast< node_id const* >( file.data() + links0_offset );
+    d->m_file = std::move( file );
+  }
+}
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
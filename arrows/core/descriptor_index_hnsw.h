@@ -0,0 +1,88 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header defining the core descriptor_index_hnsw algorithm
+
+#ifndef KWIVER_ARROWS_CORE_DESCRIPTOR_INDEX_HNSW_H_
+#define KWIVER_ARROWS_CORE_DESCRIPTOR_INDEX_HNSW_H_
+
+#include <arrows/core/kwiver_algo_core_export.h>
+
+#include <vital/algo/descriptor_index.h>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+/// Approximate nearest descriptor search with a hierarchical navigable small
+/// world (HNSW) graph.
+///
+/// Each descriptor is a node of a layered proximity graph, linked to at most
+/// max_links nearby nodes on each layer it belongs to (twice that on the
+/// bottom layer). A query descends greedily through the sparse upper layers
+/// and then explores the bottom layer, visiting a few thousand descriptors
+/// instead of the whole collection. Descriptors are stored as floats.
+///
+/// Descriptors are inserted incrementally, one at a time. Queries do not
+/// modify the graph, so batched queries run in parallel on the vital thread
+/// pool. A saved index is memory mapped when loaded, so the descriptors and
+/// bottom layer of a large index are paged in on demand rather than read up
+/// front; they are copied into memory only when descriptors are added.
+class KWIVER_ALGO_CORE_EXPORT descriptor_index_hnsw
+  : public vital::algo::descriptor_index
+{
+public:
+  PLUGIN_INFO( "hnsw",
+               "Approximate nearest descriptor search with a hierarchical "
+               "navigable small world graph." )
+
+  descriptor_index_hnsw();
+  virtual ~descriptor_index_hnsw();
+
+  /// Get this algorithm's \link vital::config_block configuration block
+  /// \endlink.
+  virtual vital::config_block_sptr get_configuration() const;
+  /// Set this algorithm's properties via a config block.
+  virtual void set_configuration( vital::config_block_sptr config );
+  /// Check that the algorithm's currently configuration is valid.
+  virtual bool check_configuration( vital::config_block_sptr config ) const;
+
+  /// Add descriptors to the index, in order
+  virtual void add( std::vector< vital::descriptor_sptr > const& descriptors );
+
+  /// Return the number of descriptors in the index
+  virtual size_t size() const;
+
+  /// Remove all descriptors from the index
+  virtual void clear();
+
+  /// Find the approximate K nearest descriptors of each query, in parallel
+  virtual void find_nearest(
+    std::vector< vital::descriptor_sptr > const& queries,
+    size_t K,
+    std::vector< std::vector< size_t > >& indices,
+    std::vector< std::vector< double > >& distances ) const;
+
+  /// Write the index to a file
+  virtual void save( std::string const& filename ) const;
+
+  /// Replace the index with one read from a file written by save()
+  virtual void load( std::string const& filename );
+
+private:
+  class priv;
+
+  std::unique_ptr< priv > const d;
+};
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
+
+#endif
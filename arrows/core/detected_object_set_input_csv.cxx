@@ -9,6 +9,8 @@
 
 #include <vital/util/tokenize.h>
 #include <vital/util/data_stream_reader.h>
+#include <vital/util/mapped_file.h>
+#include <vital/util/text_lines.h>
 #include <vital/exceptions.h>
 #include <vital/vital_config.h>
 
@@ -39,6 +41,8 @@ class detected_object_set_input_csv::priv
     , m_first( true )
     , m_frame_number( 0 )
     , m_delim( "," )
+    , m_mapped( false )
+    , m_next_record( 0 )
   {
   }
 
@@ -46,6 +50,9 @@ class detected_object_set_input_csv::priv
 
   bool get_input();
   void add_detection();
+  bool read_all_mapped();
+  bool next_mapped_set( kwiver::vital::detected_object_set_sptr& set,
+                        std::string& image_name );
 
   // --------------------------------------------------------------------------
   detected_object_set_input_csv* m_parent;
@@ -57,6 +64,21 @@ class detected_object_set_input_csv::priv
   std::vector< std::string > m_input_buffer;
   kwiver::vital::detected_object_set_sptr m_current_set;
   std::string m_image_name;
+
+  // File to map in place of reading the stream, if opened by name
+  std::string m_filename;
+
+  // Detections of a mapped file, and the next one to return
+  struct record
+  {
+    int frame;
+    std::string image_name;
+    kwiver::vital::detected_object_sptr detection;
+  };
+
+  bool m_mapped;
+  std::vector< record > m_records;
+  size_t m_next_record;
 };
 
 // ----------------------------------------------------------------------------
@@ -94,11 +116,30 @@ check_configuration( VITAL_UNUSED vital::config_block_sptr config) const
   return true;
 }
 
+// ----------------------------------------------------------------------------
+void
+detected_object_set_input_csv::
+open( std::string const& filename )
+{
+  vital::algo::detected_object_set_input::open( filename );
+  d->m_filename = filename;
+}
+
 // ----------------------------------------------------------------------------
 bool
 detected_object_set_input_csv::
 read_set( kwiver::vital::detected_object_set_sptr & set, std::string& image_name )
 {
+  if ( d->m_first && d->read_all_mapped() )
+  {
+    d->m_first = false;
+  }
+
+  if ( d->m_mapped )
+  {
+    return d->next_mapped_set( set, image_name );
+  }
+
   if ( d->m_first )
   {
     d->m_first = false;
@@ -159,6 +200,10 @@ new_stream()
 {
   d->m_first = true;
   d->m_stream_reader = std::make_shared< kwiver::vital::data_stream_reader>( stream() );
+  d->m_filename.clear();
+  d->m_mapped = false;
+  d->m_records.clear();
+  d->m_next_record = 0;
 }
 
 // ----------------------------------------------------------------------------
@@ -228,4 +273,100 @@ add_detection()
   m_image_name = m_input_buffer[1];
 }
 
+// ----------------------------------------------------------------------------
+bool
+detected_object_set_input_csv::priv::
+read_all_mapped()
+{
+  kwiver::vital::mapped_file file;
+  if ( m_filename.empty() || ! file.open( m_filename ) )
+  {
+    return false;
+  }
+
+  auto const begin = file.data();
+  auto const& delim = m_delim;
+  m_records = kwiver::vital::parse_data_lines< record >(
+    begin, begin + file.size(),
+    [ begin, &delim ]( kwiver::vital::text_span const& line,
+                       std::vector< record >& out )
+    {
+      thread_local std::vector< kwiver::vital::text_span > fields;
+      fields.clear();
+      kwiver::vital::tokenize_span( line, fields, delim, false );
+
+      // Test the minimum number of fields.
+      if ( fields.size() < 7 || ! ( fields.size() & 0x001 ) )
+      {
+        std::stringstream str;
+        str << ( fields.size() < 7 ? "Too few field" : "Invalid format" )
+            << " in input at line "
+            << kwiver::vital::line_number( begin, line.begin ) << std::endl
+            << "\"" << line.str() << "\"";
+        VITAL_THROW( kwiver::vital::invalid_data, str.str() );
+      }
+
+      // Create DOT object if classifiers are present
+      kwiver::vital::detected_object_type_sptr dot;
+      if ( fields.size() > 7 )
+      {
+        dot = std::make_shared<kwiver::vital::detected_object_type>();
+        for ( size_t i = 7; i < fields.size(); i += 2 )
+        {
+          dot->set_score( fields[i].str(),
+                          kwiver::vital::span_to_double( fields[i+1] ) );
+        }
+      }
+
+      const kwiver::vital::bounding_box_d bbox(
+        kwiver::vital::span_to_double( fields[2] ),
+        kwiver::vital::span_to_double( fields[3] ),
+        kwiver::vital::span_to_double( fields[4] ),
+        kwiver::vital::span_to_double( fields[5] ) );
+
+      const double confid( kwiver::vital::span_to_double( fields[6] ) );
+
+      out.push_back( {
+        static_cast< int >( kwiver::vital::span_to_integer( fields[0] ) ),
+        fields[1].str(),
+        std::make_shared<kwiver::vital::detected_object>( bbox, confid, dot ) } );
+    } );
+
+  m_mapped = true;
+  m_next_record = 0;
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+bool
+detected_object_set_input_csv::priv::
+next_mapped_set( kwiver::vital::detected_object_set_sptr& set,
+                 std::string& image_name )
+{
+  if ( m_next_record >= m_records.size() )
+  {
+    m_parent->stream().setstate( std::ios::eofbit );
+    return false;
+  }
+
+  // Consecutive lines of the same frame make up a set
+  auto const frame = m_records[ m_next_record ].frame;
+  set = std::make_shared<kwiver::vital::detected_object_set>();
+  while ( m_next_record < m_records.size() &&
+          m_records[ m_next_record ].frame == frame )
+  {
+    auto const& r = m_records[ m_next_record++ ];
+    set->add( r.detection );
+    image_name = r.image_name;
+  }
+
+  // The stream would reach its end with the last set
+  if ( m_next_record >= m_records.size() )
+  {
+    m_parent->stream().setstate( std::ios::eofbit );
+  }
+
+  return true;
+}
+
 } } } // end namespace
@@ -38,6 +38,11 @@ class KWIVER_ALGO_CORE_EXPORT detected_object_set_input_csv
   virtual void set_configuration(vital::config_block_sptr config);
   virtual bool check_configuration(vital::config_block_sptr config) const;
 
+  /// Open a file of detections
+  ///
+  /// Files opened by name are memory mapped and parsed in parallel.
+  virtual void open( std::string const& filename );
+
   virtual bool read_set( kwiver::vital::detected_object_set_sptr & set, std::string& image_name );
 
 private:
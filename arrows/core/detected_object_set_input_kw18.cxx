@@ -9,6 +9,8 @@
 
 #include <vital/util/tokenize.h>
 #include <vital/util/data_stream_reader.h>
+#include <vital/util/mapped_file.h>
+#include <vital/util/text_lines.h>
 #include <vital/exceptions.h>
 #include <vital/vital_config.h>
 
@@ -55,10 +57,14 @@ class detected_object_set_input_kw18::priv
   ~priv() { }
 
   void read_all();
+  bool read_all_mapped();
 
   detected_object_set_input_kw18* m_parent;
   bool m_first;
 
+  // File to map in place of reading the stream, if opened by name
+  std::string m_filename;
+
   int m_current_idx;
   int m_last_idx;
 
@@ -95,6 +101,15 @@ check_configuration( VITAL_UNUSED vital::config_block_sptr config ) const
   return true;
 }
 
+// ----------------------------------------------------------------------------
+void
+detected_object_set_input_kw18::
+open( std::string const& filename )
+{
+  vital::algo::detected_object_set_input::open( filename );
+  d->m_filename = filename;
+}
+
 // ----------------------------------------------------------------------------
 bool
 detected_object_set_input_kw18::
@@ -141,6 +156,7 @@ detected_object_set_input_kw18::
 new_stream()
 {
   d->m_first = true;
+  d->m_filename.clear();
 }
 
 // ----------------------------------------------------------------------------
@@ -148,11 +164,15 @@ void
 detected_object_set_input_kw18::priv::
 read_all()
 {
+  m_detected_sets.clear();
+  if ( read_all_mapped() )
+  {
+    return;
+  }
+
   std::string line;
   kwiver::vital::data_stream_reader stream_reader( m_parent->stream() );
 
-  m_detected_sets.clear();
-
   while ( stream_reader.getline( line ) )
   {
     std::vector< std::string > col;
@@ -200,4 +220,77 @@ read_all()
   } // ...while !eof
 } // read_all
 
+// ----------------------------------------------------------------------------
+bool
+detected_object_set_input_kw18::priv::
+read_all_mapped()
+{
+  kwiver::vital::mapped_file file;
+  if ( m_filename.empty() || ! file.open( m_filename ) )
+  {
+    return false;
+  }
+
+  struct record
+  {
+    int frame;
+    kwiver::vital::detected_object_sptr detection;
+  };
+
+  auto const records = kwiver::vital::parse_data_lines< record >(
+    file.data(), file.data() + file.size(),
+    []( kwiver::vital::text_span const& line, std::vector< record >& out )
+    {
+      thread_local std::vector< kwiver::vital::text_span > col;
+      col.clear();
+      kwiver::vital::tokenize_span( line, col, " ", true );
+
+      if ( ( col.size() < 18 ) || ( col.size() > 20 ) )
+      {
+        std::stringstream str;
+        str << "This is not a kw18 kw19 or kw20 file; found " << col.size()
+            << " columns in\n\"" << line.str() << "\"";
+        VITAL_THROW( kwiver::vital::invalid_data, str.str() );
+      }
+
+      kwiver::vital::bounding_box_d bbox(
+        kwiver::vital::span_to_double( col[COL_MIN_X] ),
+        kwiver::vital::span_to_double( col[COL_MIN_Y] ),
+        kwiver::vital::span_to_double( col[COL_MAX_X] ),
+        kwiver::vital::span_to_double( col[COL_MAX_Y] ) );
+
+      double conf(1.0);
+      if ( col.size() == 19 )
+      {
+        conf = kwiver::vital::span_to_double( col[COL_CONFIDENCE] );
+      }
+
+      out.push_back( {
+        static_cast< int >( kwiver::vital::span_to_integer( col[COL_FRAME] ) ),
+        std::make_shared< kwiver::vital::detected_object >( bbox, conf ) } );
+    } );
+
+  // Group the detections by frame in file order
+  kwiver::vital::detected_object_set_sptr set;
+  int set_index = 0;
+  for ( auto const& r : records )
+  {
+    if ( ! set || r.frame != set_index )
+    {
+      auto& entry = m_detected_sets[ r.frame ];
+      if ( ! entry )
+      {
+        entry = std::make_shared< kwiver::vital::detected_object_set >();
+      }
+      set = entry;
+      set_index = r.frame;
+    }
+    set->add( r.detection );
+  }
+
+  // The whole file has been read, as if from the stream
+  m_parent->stream().setstate( std::ios::eofbit );
+  return true;
+} // read_all_mapped
+
 } } } // end namespace
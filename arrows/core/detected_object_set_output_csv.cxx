@@ -7,12 +7,23 @@
 
 #include "detected_object_set_output_csv.h"
 
+#include <vital/util/format_buffer.h>
+
+#include <algorithm>
+#include <cstring>
 #include <ctime>
+#include <vector>
 
 namespace kwiver {
 namespace arrows {
 namespace core {
 
+namespace {
+
+using class_entry_t = std::pair< std::string const*, double >;
+
+} // end namespace
+
 // ----------------------------------------------------------------------------
 class detected_object_set_output_csv::priv
 {
@@ -30,6 +41,9 @@ class detected_object_set_output_csv::priv
   bool m_first;
   int m_frame_number;
   std::string m_delim;
+
+  // Classes of the detection being written, reused between detections
+  std::vector< class_entry_t > m_classes;
 };
 
 // ----------------------------------------------------------------------------
@@ -99,12 +113,14 @@ write_set( const kwiver::vital::detected_object_set_sptr set, std::string const&
     d->m_first = false;
   } // end first
 
-  // process all detections
+  // process all detections, formatting them into a buffer written to the
+  // stream in blocks
+  kwiver::vital::format_buffer out( stream(), 1 << 16 );
   auto ie =  set->cend();
   for ( auto det = set->cbegin(); det != ie; ++det )
   {
     const kwiver::vital::bounding_box_d bbox( (*det)->bounding_box() );
-    stream() << d->m_frame_number << d->m_delim
+    out      << d->m_frame_number << d->m_delim
              << image_name << d->m_delim
              << bbox.min_x() << d->m_delim // 2: TL-x
              << bbox.min_y() << d->m_delim // 3: TL-y
@@ -117,18 +133,31 @@ write_set( const kwiver::vital::detected_object_set_sptr set, std::string const&
     const auto cm( (*det)->type() );
     if ( cm )
     {
-      const auto name_list( cm->class_names() );
-      for( auto name : name_list )
+      // Classes in the order of class_names(), without copying the names
+      d->m_classes.assign( cm->begin(), cm->end() );
+      std::stable_sort( d->m_classes.begin(), d->m_classes.end(),
+        []( class_entry_t const& a, class_entry_t const& b )
+        { return a.second > b.second; } );
+
+      for( auto const& entry : d->m_classes )
       {
+        if ( entry.second < kwiver::vital::detected_object_type::INVALID_SCORE )
+        {
+          break;
+        }
+
         // Write out the <name> <score> pair
-        stream() << d->m_delim << name << d->m_delim << cm->score( name );
+        out << d->m_delim << *entry.first << d->m_delim << entry.second;
       } // end foreach
     }
 
-    stream() << std::endl;
+    out << '\n';
 
   } // end foreach
 
+  out.flush();
+  stream().flush();
+
   // Put each set on a new frame
   ++d->m_frame_number;
 }
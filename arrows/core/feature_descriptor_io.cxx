@@ -10,9 +10,13 @@
 #include <fstream>
 
 #include <vital/exceptions.h>
+#include <vital/types/packed_descriptor_set.h>
+#include <vital/util/mapped_file.h>
 #include <vital/vital_config.h>
 #include <cereal/archives/portable_binary.hpp>
 
+#include <cstring>
+
 using namespace kwiver::vital;
 
 namespace kwiver {
@@ -25,11 +29,22 @@ class feature_descriptor_io::priv
 public:
   /// Constructor
   priv()
-  : write_float_features(false)
+  : write_float_features(false),
+    write_columnar(false),
+    map_descriptors(false)
   {
   }
 
+  void load_columnar(std::string const& filename,
+                     vital::feature_set_sptr& feat,
+                     vital::descriptor_set_sptr& desc) const;
+  void save_columnar(std::string const& filename,
+                     vital::feature_set_sptr feat,
+                     vital::descriptor_set_sptr desc) const;
+
   bool write_float_features;
+  bool write_columnar;
+  bool map_descriptors;
 };
 
 // Constructor
@@ -58,6 +73,17 @@ ::get_configuration() const
   config->set_value("write_float_features", d_->write_float_features,
                     "Convert features to use single precision floats "
                     "instead of doubles when writing to save space");
+  config->set_value("write_columnar", d_->write_columnar,
+                    "Write the columnar format, in which the keypoints and "
+                    "the descriptors of a file are each stored in one array "
+                    "and read by memory mapping the file, instead of the "
+                    "Cereal serialization. Both formats are read.");
+  config->set_value("map_descriptors", d_->map_descriptors,
+                    "When reading the columnar format, refer to the "
+                    "descriptors in the read-only file mapping instead of "
+                    "copying them. Only enable this if no algorithm modifies "
+                    "descriptors in place, and the files are not rewritten "
+                    "while loaded.");
 
   return config;
 }
@@ -75,6 +101,8 @@ ::set_configuration(vital::config_block_sptr in_config)
 
   d_->write_float_features = config->get_value<bool>("write_float_features",
                                                      d_->write_float_features);
+  d_->write_columnar = config->get_value<bool>("write_columnar");
+  d_->map_descriptors = config->get_value<bool>("map_descriptors");
 }
 
 // ----------------------------------------------------------------------------
@@ -136,6 +164,22 @@ save_descriptors(Archive & ar, descriptor_set_sptr const& descriptors)
   // dimensionality of each descriptor
   cereal::size_type dim = descriptors->at(0)->size();
   ar( cereal::make_size_tag( dim ) );
+
+  // write packed descriptors directly from their buffer
+  if( auto packed =
+        std::dynamic_pointer_cast<packed_descriptor_set<T> >(descriptors) )
+  {
+    for( size_t i = 0; i < packed->size(); ++i )
+    {
+      const T* data = packed->row(i);
+      for(unsigned x = 0; x < dim; ++x, ++data)
+      {
+        ar( *data );
+      }
+    }
+    return;
+  }
+
   for( descriptor_sptr const d : *descriptors )
   {
     if( !d )
@@ -175,31 +219,15 @@ read_descriptors(Archive & ar, size_t num_desc)
   cereal::size_type dim;
   ar( cereal::make_size_tag( dim ) );
 
-  std::vector<descriptor_sptr> descriptors;
-  descriptors.reserve(num_desc);
-  for( size_t i = 0; i < num_desc; ++i )
+  // read all descriptors into one contiguous buffer
+  std::vector<T> data(num_desc * dim);
+  T* d = data.data();
+  for( size_t i = 0; i < data.size(); ++i, ++d )
   {
-    std::shared_ptr<descriptor_array_of<T> > d;
-    // allocate fixed vectors for common dimensions
-    switch( dim )
-    {
-      case 128:
-        d = std::make_shared<descriptor_fixed<T,128> >();
-        break;
-      case 64:
-        d = std::make_shared<descriptor_fixed<T,64> >();
-        break;
-      default:
-        d = std::make_shared<descriptor_dynamic<T> >(dim);
-    }
-    T* data = d->raw_data();
-    for(unsigned x = 0; x < dim; ++x, ++data)
-    {
-      ar( *data );
-    }
-    descriptors.push_back(d);
+    ar( *d );
   }
-  return std::make_shared<vital::simple_descriptor_set>(descriptors);
+  return std::make_shared<vital::packed_descriptor_set<T> >(std::move(data),
+                                                            dim);
 }
 
 // ----------------------------------------------------------------------------
@@ -244,6 +272,368 @@ uint8_t code_from_typeid(std::type_info const& tid)
   return 0;
 }
 
+// ----------------------------------------------------------------------------
+// Header of the columnar format, in native byte order
+struct columnar_header
+{
+  char magic[4];
+  uint16_t version;
+  uint8_t feature_type;
+  uint8_t descriptor_type;
+  uint64_t num_feat;
+  uint64_t num_desc;
+  uint64_t dim;
+};
+
+// ----------------------------------------------------------------------------
+// Byte offsets of the columns of the columnar format, each aligned to 8 bytes
+struct columnar_layout
+{
+  columnar_layout(columnar_header const& h)
+  {
+    size_t const fs = h.feature_type ? size_t{1} << (h.feature_type & 0xf) : 0;
+    size_t const ds =
+      h.descriptor_type ? size_t{1} << (h.descriptor_type & 0xf) : 0;
+    size_t const n = static_cast<size_t>(h.num_feat);
+
+    loc = align(sizeof(columnar_header));
+    magnitude = align(loc + 2 * n * fs);
+    scale = align(magnitude + n * fs);
+    angle = align(scale + n * fs);
+    covar = align(angle + n * fs);
+    color = align(covar + 3 * n * fs);
+    descriptors = align(color + 3 * n);
+    total = descriptors + static_cast<size_t>(h.num_desc * h.dim) * ds;
+  }
+
+  static size_t align(size_t offset) { return (offset + 7) & ~size_t{7}; }
+
+  size_t loc;
+  size_t magnitude;
+  size_t scale;
+  size_t angle;
+  size_t covar;
+  size_t color;
+  size_t descriptors;
+  size_t total;
+};
+
+// ----------------------------------------------------------------------------
+// Write features of type T into the columns of a columnar buffer
+template <typename T>
+void
+write_columnar_features(char* buffer, columnar_layout const& layout,
+                        std::vector<feature_sptr> const& features)
+{
+  auto const loc = reinterpret_cast<T*>(buffer + layout.loc);
+  auto const magnitude = reinterpret_cast<T*>(buffer + layout.magnitude);
+  auto const scale = reinterpret_cast<T*>(buffer + layout.scale);
+  auto const angle = reinterpret_cast<T*>(buffer + layout.angle);
+  auto const covar = reinterpret_cast<T*>(buffer + layout.covar);
+  auto const color = reinterpret_cast<uint8_t*>(buffer + layout.color);
+  for( size_t i = 0; i < features.size(); ++i )
+  {
+    auto const& f = features[i];
+    if( !f )
+    {
+      VITAL_THROW( vital::invalid_data,"not able to write a Null feature");
+    }
+    feature_<T> converted;
+    auto fi = dynamic_cast<feature_<T> const*>(f.get());
+    if( !fi )
+    {
+      converted = feature_<T>(*f);
+      fi = &converted;
+    }
+    loc[2 * i] = fi->get_loc()[0];
+    loc[2 * i + 1] = fi->get_loc()[1];
+    magnitude[i] = fi->get_magnitude();
+    scale[i] = fi->get_scale();
+    angle[i] = fi->get_angle();
+    std::memcpy(covar + 3 * i, fi->get_covar().data(), 3 * sizeof(T));
+    color[3 * i] = fi->get_color().r;
+    color[3 * i + 1] = fi->get_color().g;
+    color[3 * i + 2] = fi->get_color().b;
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Read the features of type T from the columns of a columnar buffer
+//
+// The features are stored in one array shared by the returned pointers.
+template <typename T>
+vital::feature_set_sptr
+read_columnar_features(char const* buffer, columnar_layout const& layout,
+                       size_t num_feat)
+{
+  auto const loc = reinterpret_cast<T const*>(buffer + layout.loc);
+  auto const magnitude = reinterpret_cast<T const*>(buffer + layout.magnitude);
+  auto const scale = reinterpret_cast<T const*>(buffer + layout.scale);
+  auto const angle = reinterpret_cast<T const*>(buffer + layout.angle);
+  auto const covar = reinterpret_cast<T const*>(buffer + layout.covar);
+  auto const color = reinterpret_cast<uint8_t const*>(buffer + layout.color);
+
+  typedef std::vector<feature_<T>, Eigen::aligned_allocator<feature_<T> > >
+    storage_t;
+  auto const storage = std::make_shared<storage_t>(num_feat);
+  std::vector<feature_sptr> features;
+  features.reserve(num_feat);
+  for( size_t i = 0; i < num_feat; ++i )
+  {
+    feature_<T>& f = (*storage)[i];
+    f.set_loc(Eigen::Matrix<T, 2, 1>(loc[2 * i], loc[2 * i + 1]));
+    f.set_magnitude(magnitude[i]);
+    f.set_scale(scale[i]);
+    f.set_angle(angle[i]);
+    covariance_<2, T> c;
+    c.set_data(const_cast<T*>(covar + 3 * i));
+    f.set_covar(c);
+    f.set_color(rgb_color(color[3 * i], color[3 * i + 1], color[3 * i + 2]));
+    features.push_back(feature_sptr(storage, &f));
+  }
+  return std::make_shared<vital::simple_feature_set>(features);
+}
+
+// ----------------------------------------------------------------------------
+// Write descriptors of type T into a columnar buffer
+template <typename T>
+void
+write_columnar_descriptors(char* buffer, columnar_layout const& layout,
+                           descriptor_set_sptr const& descriptors, size_t dim)
+{
+  auto out = reinterpret_cast<T*>(buffer + layout.descriptors);
+  if( auto packed =
+        std::dynamic_pointer_cast<packed_descriptor_set<T> >(descriptors) )
+  {
+    for( size_t i = 0; i < packed->size(); ++i, out += dim )
+    {
+      std::memcpy(out, packed->row(i), dim * sizeof(T));
+    }
+    return;
+  }
+
+  for( descriptor_sptr const d : *descriptors )
+  {
+    if( !d )
+    {
+      VITAL_THROW( vital::invalid_data, "not able to write a Null descriptor");
+    }
+    if( d->size() != dim )
+    {
+      VITAL_THROW( vital::invalid_data, std::string("descriptor dimension is not ")
+                                + "consistent, should be " + std::to_string(dim)
+                                + ", is " + std::to_string(d->size()));
+    }
+    auto dt = std::dynamic_pointer_cast<descriptor_array_of<T> >(d);
+    if( !dt )
+    {
+      VITAL_THROW( vital::invalid_data, std::string("saving descriptors of type ")
+                                + typeid(T).name() + " but received type "
+                                + d->data_type().name());
+    }
+    std::memcpy(out, dt->raw_data(), dim * sizeof(T));
+    out += dim;
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Read descriptors of type T from a columnar buffer
+//
+// If \p mapping is given, the descriptors refer to it instead of a copy.
+template <typename T>
+vital::descriptor_set_sptr
+read_columnar_descriptors(char const* buffer, columnar_layout const& layout,
+                          size_t num_desc, size_t dim,
+                          std::shared_ptr<mapped_file> const& mapping)
+{
+  auto const data = reinterpret_cast<T const*>(buffer + layout.descriptors);
+  if( mapping )
+  {
+    return std::make_shared<vital::packed_descriptor_set<T> >(
+      std::shared_ptr<T>(mapping, const_cast<T*>(data)),
+      num_desc, dim, dim);
+  }
+  return std::make_shared<vital::packed_descriptor_set<T> >(
+    std::vector<T>(data, data + num_desc * dim), dim);
+}
+
+}
+
+// ----------------------------------------------------------------------------
+// Load the columnar format by mapping the file
+void
+feature_descriptor_io::priv
+::load_columnar(std::string const& filename,
+                vital::feature_set_sptr& feat,
+                vital::descriptor_set_sptr& desc) const
+{
+  auto const mapping = std::make_shared<mapped_file>();
+  if( !mapping->open(filename) )
+  {
+    VITAL_THROW( vital::file_not_read_exception, filename,
+                 "Unable to map file" );
+  }
+
+  columnar_header header;
+  if( mapping->size() < sizeof(header) )
+  {
+    VITAL_THROW( vital::invalid_data, "Truncated KWIVER feature/descriptor "
+                                      "file: " + filename );
+  }
+  std::memcpy(&header, mapping->data(), sizeof(header));
+  if( header.version != 1 )
+  {
+    VITAL_THROW( vital::invalid_data, "Unknown columnar file format version: "
+                               + std::to_string(header.version) );
+  }
+
+  columnar_layout const layout(header);
+  if( mapping->size() < layout.total )
+  {
+    VITAL_THROW( vital::invalid_data, "Truncated KWIVER feature/descriptor "
+                                      "file: " + filename );
+  }
+
+  char const* const buffer = mapping->data();
+  size_t const num_feat = static_cast<size_t>(header.num_feat);
+  size_t const num_desc = static_cast<size_t>(header.num_desc);
+  size_t const dim = static_cast<size_t>(header.dim);
+
+  feat = feature_set_sptr();
+  if( num_feat > 0 )
+  {
+    switch( header.feature_type )
+    {
+      case type_traits<float>::code:
+        feat = read_columnar_features<float>(buffer, layout, num_feat);
+        break;
+      case type_traits<double>::code:
+        feat = read_columnar_features<double>(buffer, layout, num_feat);
+        break;
+      default:
+        VITAL_THROW( vital::invalid_data, "unknown feature type code: "
+                                  + std::to_string(header.feature_type));
+    }
+  }
+
+  desc = descriptor_set_sptr();
+  if( num_desc > 0 )
+  {
+    // without map_descriptors the mapping is released on return
+    auto const desc_mapping =
+      this->map_descriptors ? mapping : std::shared_ptr<mapped_file>();
+    switch( header.descriptor_type )
+    {
+#define DO_CASE(T)                                                    \
+      case type_traits<T>::code:                                      \
+        desc = read_columnar_descriptors<T>(buffer, layout, num_desc, \
+                                            dim, desc_mapping);       \
+        break
+
+      DO_CASE(uint8_t);
+      DO_CASE(int8_t);
+      DO_CASE(uint16_t);
+      DO_CASE(int16_t);
+      DO_CASE(uint32_t);
+      DO_CASE(int32_t);
+      DO_CASE(uint64_t);
+      DO_CASE(int64_t);
+      DO_CASE(float);
+      DO_CASE(double);
+#undef DO_CASE
+
+      default:
+        VITAL_THROW( vital::invalid_data, "unknown descriptor type code: "
+                                  + std::to_string(header.descriptor_type));
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Save the columnar format
+void
+feature_descriptor_io::priv
+::save_columnar(std::string const& filename,
+                vital::feature_set_sptr feat,
+                vital::descriptor_set_sptr desc) const
+{
+  columnar_header header;
+  std::memcpy(header.magic, "KWFC", 4);
+  header.version = 1;
+  header.feature_type = 0;
+  header.descriptor_type = 0;
+  header.num_feat = 0;
+  header.num_desc = 0;
+  header.dim = 0;
+
+  std::vector<feature_sptr> features;
+  if( feat && feat->size() > 0 )
+  {
+    features = feat->features();
+    header.num_feat = features.size();
+    header.feature_type = this->write_float_features || !features[0]
+                        ? type_traits<float>::code
+                        : code_from_typeid(features[0]->data_type());
+  }
+  if( desc && desc->size() > 0 )
+  {
+    header.num_desc = desc->size();
+    descriptor_sptr const first = desc->at(0);
+    if( first )
+    {
+      header.dim = first->size();
+      header.descriptor_type = code_from_typeid(first->data_type());
+    }
+  }
+
+  columnar_layout const layout(header);
+  std::vector<char> buffer(layout.total, 0);
+  std::memcpy(buffer.data(), &header, sizeof(header));
+
+  if( header.num_feat > 0 )
+  {
+    switch( header.feature_type )
+    {
+      case type_traits<float>::code:
+        write_columnar_features<float>(buffer.data(), layout, features);
+        break;
+      case type_traits<double>::code:
+        write_columnar_features<double>(buffer.data(), layout, features);
+        break;
+      default:
+        VITAL_THROW( vital::invalid_data, "features must be float or double");
+    }
+  }
+
+  if( header.num_desc > 0 )
+  {
+    size_t const dim = static_cast<size_t>(header.dim);
+    switch( header.descriptor_type )
+    {
+#define DO_CASE(T)                                                         \
+      case type_traits<T>::code:                                           \
+        write_columnar_descriptors<T>(buffer.data(), layout, desc, dim);   \
+        break
+
+      DO_CASE(uint8_t);
+      DO_CASE(int8_t);
+      DO_CASE(uint16_t);
+      DO_CASE(int16_t);
+      DO_CASE(uint32_t);
+      DO_CASE(int32_t);
+      DO_CASE(uint64_t);
+      DO_CASE(int64_t);
+      DO_CASE(float);
+      DO_CASE(double);
+#undef DO_CASE
+
+      default:
+        VITAL_THROW( vital::invalid_data, "descriptor type not supported" );
+    }
+  }
+
+  std::ofstream ofile( filename.c_str(), std::ios::binary);
+  ofile.write(buffer.data(), buffer.size());
 }
 
 // ----------------------------------------------------------------------------
@@ -260,6 +650,12 @@ ::load_(std::string const& filename,
   // read "magic numbers" to validate this file as a KWIVER feature descriptor file
   char file_id[5] = {0};
   ifile.read(file_id, 4);
+  if (std::strncmp(file_id, "KWFC", 4) == 0)
+  {
+    ifile.close();
+    d_->load_columnar(filename, feat, desc);
+    return;
+  }
   if (std::strncmp(file_id, "KWFD", 4) != 0)
   {
     VITAL_THROW( vital::invalid_data, "Does not look like a KWIVER feature/descriptor file: "
@@ -353,6 +749,12 @@ ::save_(std::string const& filename,
     return;
   }
 
+  if( d_->write_columnar )
+  {
+    d_->save_columnar(filename, feat, desc);
+    return;
+  }
+
   // open output file
   std::ofstream ofile( filename.c_str(), std::ios::binary);
   // write "magic numbers" to identify this file as a KWIVER feature descriptor file
@@ -0,0 +1,327 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of image_filter_tiled
+
+#include "image_filter_tiled.h"
+
+#include <vital/exceptions/algorithm.h>
+#include <vital/types/image_container.h>
+#include <vital/types/image_tiling.h>
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
+using namespace kwiver::vital;
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+/// Private implementation class
+class image_filter_tiled::priv
+{
+public:
+  /// The region of \p img to tile
+  bounding_box_i region( image const& img ) const;
+
+  /// Take an idle nested filter, creating one if none are idle
+  algo::image_filter_sptr acquire();
+
+  /// Return a nested filter taken with acquire()
+  void release( algo::image_filter_sptr filter );
+
+  unsigned tile_width = 1024;
+  unsigned tile_height = 1024;
+  unsigned overlap = 32;
+  int roi_x = 0;
+  int roi_y = 0;
+  unsigned roi_width = 0;
+  unsigned roi_height = 0;
+  unsigned max_instances = 1;
+
+  /// The configured nested filter
+  algo::image_filter_sptr filter;
+
+  /// Configuration used to create more nested filters
+  config_block_sptr config;
+
+  std::mutex mutex;
+  std::vector< algo::image_filter_sptr > idle;
+};
+
+// ----------------------------------------------------------------------------
+bounding_box_i
+image_filter_tiled::priv
+::region( image const& img ) const
+{
+  int const width = static_cast< int >( img.width() );
+  int const height = static_cast< int >( img.height() );
+  bounding_box_i const full( 0, 0, width, height );
+  bounding_box_i const roi(
+    roi_x, roi_y,
+    roi_width ? roi_x + static_cast< int >( roi_width ) : width,
+    roi_height ? roi_y + static_cast< int >( roi_height ) : height );
+  return intersection( full, roi );
+}
+
+// ----------------------------------------------------------------------------
+algo::image_filter_sptr
+image_filter_tiled::priv
+::acquire()
+{
+  {
+    std::lock_guard< std::mutex > lock( mutex );
+    if( !idle.empty() )
+    {
+      auto result = idle.back();
+      idle.pop_back();
+      return result;
+    }
+  }
+  algo::image_filter_sptr result;
+  algo::image_filter
+    ::set_nested_algo_configuration( "filter", config, result );
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+void
+image_filter_tiled::priv
+::release( algo::image_filter_sptr filter )
+{
+  std::lock_guard< std::mutex > lock( mutex );
+  idle.push_back( filter );
+}
+
+// ----------------------------------------------------------------------------
+image_filter_tiled
+::image_filter_tiled()
+  : d_( new priv )
+{
+  attach_logger( "arrows.core.image_filter_tiled" );
+}
+
+// ----------------------------------------------------------------------------
+image_filter_tiled
+::~image_filter_tiled()
+{
+}
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+image_filter_tiled
+::get_configuration() const
+{
+  // get base config from base class
+  vital::config_block_sptr config = algorithm::get_configuration();
+
+  config->set_value( "tile_width", d_->tile_width,
+    "Width of each tile in pixels." );
+  config->set_value( "tile_height", d_->tile_height,
+    "Height of each tile in pixels." );
+  config->set_value( "overlap", d_->overlap,
+    "Number of pixels shared by neighboring tiles. This should be at least "
+    "twice the distance from which the nested filter reads neighboring "
+    "pixels, so that the kept part of each tile is not affected by its "
+    "edges." );
+  config->set_value( "roi_x", d_->roi_x,
+    "Left edge of the region of interest." );
+  config->set_value( "roi_y", d_->roi_y,
+    "Top edge of the region of interest." );
+  config->set_value( "roi_width", d_->roi_width,
+    "Width of the region of interest. Zero extends it to the right edge "
+    "of the image." );
+  config->set_value( "roi_height", d_->roi_height,
+    "Height of the region of interest. Zero extends it to the bottom edge "
+    "of the image." );
+  config->set_value( "max_instances", d_->max_instances,
+    "Largest number of nested filters run in parallel. Each one is a "
+    "separate instance, so the nested filter need not be thread safe." );
+
+  // nested algorithm configurations
+  algo::image_filter
+    ::get_nested_algo_configuration( "filter", config, d_->filter );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+image_filter_tiled
+::set_configuration( vital::config_block_sptr in_config )
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config( in_config );
+
+  d_->tile_width = config->get_value< unsigned >( "tile_width" );
+  d_->tile_height = config->get_value< unsigned >( "tile_height" );
+  d_->overlap = config->get_value< unsigned >( "overlap" );
+  d_->roi_x = config->get_value< int >( "roi_x" );
+  d_->roi_y = config->get_value< int >( "roi_y" );
+  d_->roi_width = config->get_value< unsigned >( "roi_width" );
+  d_->roi_height = config->get_value< unsigned >( "roi_height" );
+  d_->max_instances =
+    std::max( 1u, config->get_value< unsigned >( "max_instances" ) );
+
+  algo::image_filter
+    ::set_nested_algo_configuration( "filter", config, d_->filter );
+
+  std::lock_guard< std::mutex > lock( d_->mutex );
+  d_->config = config;
+  d_->idle.clear();
+  if( d_->filter )
+  {
+    d_->idle.push_back( d_->filter );
+  }
+}
+
+// ----------------------------------------------------------------------------
+bool
+image_filter_tiled
+::check_configuration( vital::config_block_sptr config ) const
+{
+  auto const tile_width = config->get_value< unsigned >( "tile_width" );
+  auto const tile_height = config->get_value< unsigned >( "tile_height" );
+  if( tile_width == 0 || tile_height == 0 )
+  {
+    LOG_ERROR( logger(), "Tile width and height must be positive" );
+    return false;
+  }
+  auto const overlap = config->get_value< unsigned >( "overlap" );
+  if( overlap >= tile_width || overlap >= tile_height )
+  {
+    LOG_ERROR( logger(), "Tile overlap must be smaller than the tile size" );
+    return false;
+  }
+  return algo::image_filter
+    ::check_nested_algo_configuration( "filter", config );
+}
+
+// ----------------------------------------------------------------------------
+vital::image_container_sptr
+image_filter_tiled
+::filter( vital::image_container_sptr image_data )
+{
+  if( !d_->filter )
+  {
+    VITAL_THROW( algorithm_configuration_exception, type_name(), impl_name(),
+                 "Nested filter not initialized." );
+  }
+  if( !image_data )
+  {
+    return nullptr;
+  }
+
+  auto const img = image_data->get_image();
+  image_tiling const tiling( d_->region( img ), d_->tile_width,
+                             d_->tile_height, d_->overlap );
+
+  // filter consecutive runs of tiles, one nested filter per run
+  std::vector< image_container_sptr > filtered( tiling.size() );
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto const filter_tiles = [ & ]( size_t begin, size_t end )
+  {
+    auto const filter = d_->acquire();
+    try
+    {
+      for( size_t t = begin; t < end; ++t )
+      {
+        filtered[ t ] = filter->filter(
+          std::make_shared< simple_image_container >(
+            tiling.view( img, t ) ) );
+      }
+    }
+    catch( ... )
+    {
+      std::lock_guard< std::mutex > lock( error_mutex );
+      error = std::current_exception();
+    }
+    d_->release( filter );
+  };
+
+  size_t const runs = std::min< size_t >( d_->max_instances, tiling.size() );
+  if( runs > 1 )
+  {
+    thread_pool::instance().parallel_for(
+      tiling.size(), ( tiling.size() + runs - 1 ) / runs, filter_tiles );
+  }
+  else if( tiling.size() )
+  {
+    filter_tiles( 0, tiling.size() );
+  }
+  if( error )
+  {
+    std::rethrow_exception( error );
+  }
+
+  // check that the filtered tiles can be joined
+  image first;
+  for( size_t t = 0; t < tiling.size(); ++t )
+  {
+    auto const tile = tiling.tile( t );
+    if( !filtered[ t ] ||
+        filtered[ t ]->width() != static_cast< size_t >( tile.width() ) ||
+        filtered[ t ]->height() != static_cast< size_t >( tile.height() ) )
+    {
+      VITAL_THROW( algorithm_exception, type_name(), impl_name(),
+                   "Nested filter did not return an image of the tile size" );
+    }
+    auto const result = filtered[ t ]->get_image();
+    if( t == 0 )
+    {
+      first = result;
+    }
+    else if( result.pixel_traits() != first.pixel_traits() ||
+             result.depth() != first.depth() )
+    {
+      VITAL_THROW( algorithm_exception, type_name(), impl_name(),
+                   "Nested filter returned tiles of different pixel types" );
+    }
+  }
+  if( !first.size() )
+  {
+    return image_data;
+  }
+
+  // start from the input outside of the region, or from zeros
+  bool const interleaved = first.depth() > 1 && first.d_step() == 1;
+  image output( img.width(), img.height(), first.depth(), interleaved,
+                first.pixel_traits() );
+  if( img.pixel_traits() == first.pixel_traits() &&
+      img.depth() == first.depth() )
+  {
+    output.copy_from( img );
+  }
+  else
+  {
+    std::fill_n( static_cast< char* >( output.memory()->data() ),
+                 output.memory()->size(), 0 );
+  }
+
+  // keep the core of each filtered tile
+  for( size_t t = 0; t < tiling.size(); ++t )
+  {
+    auto const tile = tiling.tile( t );
+    auto const core = tiling.core( t );
+    auto const width = static_cast< size_t >( core.width() );
+    auto const height = static_cast< size_t >( core.height() );
+    auto dest = output.crop( static_cast< size_t >( core.min_x() ),
+                             static_cast< size_t >( core.min_y() ),
+                             width, height );
+    dest.copy_from( filtered[ t ]->get_image().crop(
+      static_cast< size_t >( core.min_x() - tile.min_x() ),
+      static_cast< size_t >( core.min_y() - tile.min_y() ),
+      width, height ) );
+  }
+  return std::make_shared< simple_image_container >( output );
+}
+
+} // end namespace core
+} // end namespace arrows
+} // end namespace kwiver
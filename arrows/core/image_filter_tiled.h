@@ -0,0 +1,63 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief image_filter adaptor that filters tiles of the image
+
+#ifndef KWIVER_ARROWS_CORE_IMAGE_FILTER_TILED_H_
+#define KWIVER_ARROWS_CORE_IMAGE_FILTER_TILED_H_
+
+#include <vital/algo/image_filter.h>
+
+#include <arrows/core/kwiver_algo_core_export.h>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+/// An image filter that runs a nested filter on tiles of the image
+///
+/// The region of interest is divided into overlapping tiles with
+/// vital::image_tiling, which are filtered separately, optionally with
+/// several filter instances working in parallel. The output keeps the core
+/// of each filtered tile, so the overlap should cover the reach of the
+/// nested filter. Pixels outside the region of interest are copied from the
+/// input when the output has the same pixel type and depth, and are zero
+/// otherwise.
+class KWIVER_ALGO_CORE_EXPORT image_filter_tiled
+  : public vital::algo::image_filter
+{
+public:
+  PLUGIN_INFO( "tiled",
+               "Wrapper that runs an image filter on overlapping tiles of "
+               "a region of interest and joins the filtered tiles." )
+
+  /// Constructor
+  image_filter_tiled();
+
+  /// Destructor
+  virtual ~image_filter_tiled();
+
+  /// Get this algorithm's \link vital::config_block configuration block \endlink
+  virtual vital::config_block_sptr get_configuration() const;
+  /// Set this algorithm's properties via a config block
+  virtual void set_configuration( vital::config_block_sptr config );
+  /// Check that the algorithm's configuration config_block is valid
+  virtual bool check_configuration( vital::config_block_sptr config ) const;
+
+  /// Filter the region of interest of the provided image
+  virtual vital::image_container_sptr
+  filter( vital::image_container_sptr image_data );
+
+private:
+  /// private implementation class
+  class priv;
+  const std::unique_ptr< priv > d_;
+};
+
+} // end namespace core
+} // end namespace arrows
+} // end namespace kwiver
+
+#endif
@@ -0,0 +1,320 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of image_object_detector_tiled
+
+#include "image_object_detector_tiled.h"
+
+#include <vital/exceptions/algorithm.h>
+#include <vital/types/detected_object_set.h>
+#include <vital/types/image_container.h>
+#include <vital/types/image_tiling.h>
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
+using namespace kwiver::vital;
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+/// Private implementation class
+class image_object_detector_tiled::priv
+{
+public:
+  /// The region of \p img to tile
+  bounding_box_i region( image const& img ) const;
+
+  /// Take an idle nested detector, creating one if none are idle
+  algo::image_object_detector_sptr acquire();
+
+  /// Return a nested detector taken with acquire()
+  void release( algo::image_object_detector_sptr detector );
+
+  unsigned tile_width = 1024;
+  unsigned tile_height = 1024;
+  unsigned overlap = 64;
+  int roi_x = 0;
+  int roi_y = 0;
+  unsigned roi_width = 0;
+  unsigned roi_height = 0;
+  double nms_threshold = 0.5;
+  unsigned max_instances = 1;
+
+  /// The configured nested detector
+  algo::image_object_detector_sptr detector;
+
+  /// Configuration used to create more nested detectors
+  config_block_sptr config;
+
+  std::mutex mutex;
+  std::vector< algo::image_object_detector_sptr > idle;
+};
+
+// ----------------------------------------------------------------------------
+bounding_box_i
+image_object_detector_tiled::priv
+::region( image const& img ) const
+{
+  int const width = static_cast< int >( img.width() );
+  int const height = static_cast< int >( img.height() );
+  bounding_box_i const full( 0, 0, width, height );
+  bounding_box_i const roi(
+    roi_x, roi_y,
+    roi_width ? roi_x + static_cast< int >( roi_width ) : width,
+    roi_height ? roi_y + static_cast< int >( roi_height ) : height );
+  return intersection( full, roi );
+}
+
+// ----------------------------------------------------------------------------
+algo::image_object_detector_sptr
+image_object_detector_tiled::priv
+::acquire()
+{
+  {
+    std::lock_guard< std::mutex > lock( mutex );
+    if( !idle.empty() )
+    {
+      auto result = idle.back();
+      idle.pop_back();
+      return result;
+    }
+  }
+  algo::image_object_detector_sptr result;
+  algo::image_object_detector
+    ::set_nested_algo_configuration( "detector", config, result );
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+void
+image_object_detector_tiled::priv
+::release( algo::image_object_detector_sptr detector )
+{
+  std::lock_guard< std::mutex > lock( mutex );
+  idle.push_back( detector );
+}
+
+// ----------------------------------------------------------------------------
+image_object_detector_tiled
+::image_object_detector_tiled()
+  : d_( new priv )
+{
+  attach_logger( "arrows.core.image_object_detector_tiled" );
+}
+
+// ----------------------------------------------------------------------------
+image_object_detector_tiled
+::~image_object_detector_tiled()
+{
+}
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+image_object_detector_tiled
+::get_configuration() const
+{
+  // get base config from base class
+  vital::config_block_sptr config = algorithm::get_configuration();
+
+  config->set_value( "tile_width", d_->tile_width,
+    "Width of each tile in pixels." );
+  config->set_value( "tile_height", d_->tile_height,
+    "Height of each tile in pixels." );
+  config->set_value( "overlap", d_->overlap,
+    "Number of pixels shared by neighboring tiles. This should be at least "
+    "the size of the largest object to detect, so that each object is "
+    "whole in some tile." );
+  config->set_value( "roi_x", d_->roi_x,
+    "Left edge of the region of interest." );
+  config->set_value( "roi_y", d_->roi_y,
+    "Top edge of the region of interest." );
+  config->set_value( "roi_width", d_->roi_width,
+    "Width of the region of interest. Zero extends it to the right edge "
+    "of the image." );
+  config->set_value( "roi_height", d_->roi_height,
+    "Height of the region of interest. Zero extends it to the bottom edge "
+    "of the image." );
+  config->set_value( "nms_threshold", d_->nms_threshold,
+    "Largest intersection over union allowed between merged detections. "
+    "Less confident detections overlapping more than this are dropped." );
+  config->set_value( "max_instances", d_->max_instances,
+    "Largest number of nested detectors run in parallel. Each one is a "
+    "separate instance, so the nested detector need not be thread safe." );
+
+  // nested algorithm configurations
+  algo::image_object_detector
+    ::get_nested_algo_configuration( "detector", config, d_->detector );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+image_object_detector_tiled
+::set_configuration( vital::config_block_sptr in_config )
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config( in_config );
+
+  d_->tile_width = config->get_value< unsigned >( "tile_width" );
+  d_->tile_height = config->get_value< unsigned >( "tile_height" );
+  d_->overlap = config->get_value< unsigned >( "overlap" );
+  d_->roi_x = config->get_value< int >( "roi_x" );
+  d_->roi_y = config->get_value< int >( "roi_y" );
+  d_->roi_width = config->get_value< unsigned >( "roi_width" );
+  d_->roi_height = config->get_value< unsigned >( "roi_height" );
+  d_->nms_threshold = config->get_value< double >( "nms_threshold" );
+  d_->max_instances =
+    std::max( 1u, config->get_value< unsigned >( "max_instances" ) );
+
+  algo::image_object_detector
+    ::set_nested_algo_configuration( "detector", config, d_->detector );
+
+  std::lock_guard< std::mutex > lock( d_->mutex );
+  d_->config = config;
+  d_->idle.clear();
+  if( d_->detector )
+  {
+    d_->idle.push_back( d_->detector );
+  }
+}
+
+// ----------------------------------------------------------------------------
+bool
+image_object_detector_tiled
+::check_configuration( vital::config_block_sptr config ) const
+{
+  auto const tile_width = config->get_value< unsigned >( "tile_width" );
+  auto const tile_height = config->get_value< unsigned >( "tile_height" );
+  if( tile_width == 0 || tile_height == 0 )
+  {
+    LOG_ERROR( logger(), "Tile width and height must be positive" );
+    return false;
+  }
+  auto const overlap = config->get_value< unsigned >( "overlap" );
+  if( overlap >= tile_width || overlap >= tile_height )
+  {
+    LOG_ERROR( logger(), "Tile overlap must be smaller than the tile size" );
+    return false;
+  }
+  return algo::image_object_detector
+    ::check_nested_algo_configuration( "detector", config );
+}
+
+// ----------------------------------------------------------------------------
+vital::detected_object_set_sptr
+image_object_detector_tiled
+::detect( vital::image_container_sptr image_data ) const
+{
+  return batch_detect( { image_data } ).front();
+}
+
+// ----------------------------------------------------------------------------
+std::vector< vital::detected_object_set_sptr >
+image_object_detector_tiled
+::batch_detect( std::vector< vital::image_container_sptr > const& images ) const
+{
+  if( !d_->detector )
+  {
+    VITAL_THROW( algorithm_configuration_exception, type_name(), impl_name(),
+                 "Nested detector not initialized." );
+  }
+
+  // gather the tiles of all images
+  std::vector< image_container_sptr > tiles;
+  std::vector< size_t > tile_image;
+  std::vector< bounding_box_i > tile_box;
+  for( size_t i = 0; i < images.size(); ++i )
+  {
+    if( !images[ i ] )
+    {
+      continue;
+    }
+    auto const img = images[ i ]->get_image();
+    image_tiling const tiling( d_->region( img ), d_->tile_width,
+                               d_->tile_height, d_->overlap );
+    for( size_t t = 0; t < tiling.size(); ++t )
+    {
+      tiles.push_back(
+        std::make_shared< simple_image_container >( tiling.view( img, t ) ) );
+      tile_image.push_back( i );
+      tile_box.push_back( tiling.tile( t ) );
+    }
+  }
+
+  // detect on consecutive runs of tiles, one nested detector per run
+  std::vector< detected_object_set_sptr > tile_detections( tiles.size() );
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto const detect_tiles = [ & ]( size_t begin, size_t end )
+  {
+    auto const detector = d_->acquire();
+    try
+    {
+      auto const results = detector->batch_detect(
+        { tiles.begin() + begin, tiles.begin() + end } );
+      std::copy_n( results.begin(), std::min( results.size(), end - begin ),
+                   tile_detections.begin() + begin );
+    }
+    catch( ... )
+    {
+      std::lock_guard< std::mutex > lock( error_mutex );
+      error = std::current_exception();
+    }
+    d_->release( detector );
+  };
+
+  size_t const runs = std::min< size_t >( d_->max_instances, tiles.size() );
+  if( runs > 1 )
+  {
+    thread_pool::instance().parallel_for(
+      tiles.size(), ( tiles.size() + runs - 1 ) / runs, detect_tiles );
+  }
+  else if( !tiles.empty() )
+  {
+    detect_tiles( 0, tiles.size() );
+  }
+  if( error )
+  {
+    std::rethrow_exception( error );
+  }
+
+  // move the detections of each tile into its image and merge them
+  std::vector< std::vector< detected_object_sptr > > image_detections(
+    images.size() );
+  for( size_t t = 0; t < tiles.size(); ++t )
+  {
+    if( !tile_detections[ t ] )
+    {
+      continue;
+    }
+    bounding_box_d::vector_type const offset(
+      tile_box[ t ].min_x(), tile_box[ t ].min_y() );
+    for( auto const& det : *tile_detections[ t ] )
+    {
+      auto const moved = det->clone();
+      auto bbox = moved->bounding_box();
+      moved->set_bounding_box( translate( bbox, offset ) );
+      image_detections[ tile_image[ t ] ].push_back( moved );
+    }
+  }
+
+  std::vector< detected_object_set_sptr > output;
+  for( auto& detections : image_detections )
+  {
+    output.push_back(
+      detected_object_set( detections )
+        .non_max_suppression( d_->nms_threshold ) );
+  }
+  return output;
+}
+
+} // end namespace core
+} // end namespace arrows
+} // end namespace kwiver
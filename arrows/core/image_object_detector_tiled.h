@@ -0,0 +1,67 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief image_object_detector adaptor that detects on tiles of the image
+
+#ifndef KWIVER_ARROWS_CORE_IMAGE_OBJECT_DETECTOR_TILED_H_
+#define KWIVER_ARROWS_CORE_IMAGE_OBJECT_DETECTOR_TILED_H_
+
+#include <vital/algo/image_object_detector.h>
+
+#include <arrows/core/kwiver_algo_core_export.h>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+/// An object detector that runs a nested detector on tiles of the image
+///
+/// The region of interest is divided into overlapping tiles with
+/// vital::image_tiling. The tiles are passed to the nested detector in
+/// batches, optionally with several detector instances working in parallel,
+/// and the detections of all tiles are merged with non-maximum suppression.
+class KWIVER_ALGO_CORE_EXPORT image_object_detector_tiled
+  : public vital::algo::image_object_detector
+{
+public:
+  PLUGIN_INFO( "tiled",
+               "Wrapper that runs an object detector on overlapping tiles "
+               "of a region of interest and merges the detections with "
+               "non-maximum suppression." )
+
+  /// Constructor
+  image_object_detector_tiled();
+
+  /// Destructor
+  virtual ~image_object_detector_tiled();
+
+  /// Get this algorithm's \link vital::config_block configuration block \endlink
+  virtual vital::config_block_sptr get_configuration() const;
+  /// Set this algorithm's properties via a config block
+  virtual void set_configuration( vital::config_block_sptr config );
+  /// Check that the algorithm's configuration config_block is valid
+  virtual bool check_configuration( vital::config_block_sptr config ) const;
+
+  /// Find all objects in the region of interest of the provided image
+  virtual vital::detected_object_set_sptr
+  detect( vital::image_container_sptr image_data ) const;
+
+  /// Find all objects in the region of interest of each provided image
+  ///
+  /// The tiles of all images are given to the nested detector together.
+  virtual std::vector< vital::detected_object_set_sptr >
+  batch_detect( std::vector< vital::image_container_sptr > const& images ) const;
+
+private:
+  /// private implementation class
+  class priv;
+  const std::unique_ptr< priv > d_;
+};
+
+} // end namespace core
+} // end namespace arrows
+} // end namespace kwiver
+
+#endif
@@ -5,6 +5,9 @@
 #include "interpolate_track_spline.h"
 
 #include <vital/types/object_track_set.h>
+#include <vital/util/thread_pool.h>
+
+#include <exception>
 
 using namespace kwiver::vital;
 
@@ -76,67 +79,115 @@ ::check_configuration( vital::config_block_sptr /*config*/ ) const
 }
 
 // ----------------------------------------------------------------------------
-track_sptr
-interpolate_track_spline::
-interpolate( track_sptr input_track )
+std::vector< spline_track_box >
+interpolate_track_spline
+::interpolate_boxes( track const& input_track )
 {
-  if ( !input_track ) return nullptr;
-
   // Extract states, for easier iteration over intervals to be filled
-  std::map< frame_id_t, std::pair< time_usec_t, detected_object_sptr > > states;
-  for ( auto const& sp : *input_track )
+  std::vector< spline_track_box > states;
+  for ( auto const& sp : input_track )
   {
-    auto const osp = std::dynamic_pointer_cast< object_track_state >( sp );
+    auto const osp = dynamic_cast< object_track_state* >( sp.get() );
     if ( !osp ) continue;
 
-    auto const detection = osp->detection();
+    auto const& detection = osp->detection();
     if ( !detection ) continue;
 
-    states.emplace( osp->frame(), std::make_pair( osp->time(), detection ) );
+    states.push_back( { osp->frame(), osp->time(), detection->bounding_box(),
+                        detection->confidence(), detection } );
   }
 
-  // Create result track
-  auto new_track = track::create( input_track->data() );
-  new_track->set_id( input_track->id() );
-
-  auto append = [&new_track]( frame_id_t frame, time_usec_t time,
-                              detected_object_sptr detection ){
-    new_track->append(
-      std::make_shared< object_track_state >( frame, time, detection ) );
-  };
+  std::vector< spline_track_box > boxes;
+  if ( states.empty() ) return boxes;
+  boxes.reserve( static_cast< size_t >(
+    states.back().frame - states.front().frame + 1 ) );
 
   // Iterate over intervals to be filled
-  for ( auto i = states.begin(), n = states.begin();; i = n )
+  for ( size_t i = 0;; ++i )
   {
-    append( i->first, i->second.first, i->second.second );
-    if ( ( ++n ) == states.end() ) break;
+    auto const& s0 = states[ i ];
+    boxes.push_back( s0 );
+    if ( i + 1 == states.size() ) break;
 
     // Get end points of interval
-    auto const f0 = i->first;
-    auto const f1 = n->first;
+    auto const& s1 = states[ i + 1 ];
+    auto const f0 = s0.frame;
+    auto const f1 = s1.frame;
     auto const xk = 1.0 / static_cast< double >( f1 - f0 );
 
-    auto const& p0 = i->second.second->bounding_box();
-    auto const& p1 = n->second.second->bounding_box();
-    auto const c0 = i->second.second->confidence();
-    auto const c1 = n->second.second->confidence();
-
     // Iterate over frame numbers in interval
     for ( auto fn = f0 + 1; fn < f1; ++fn )
     {
       auto const x = static_cast< double >( fn - f0 ) * xk;
-      auto const tn = lerp( i->second.first, n->second.first, x );
+      auto const c = ( x * x * s0.confidence ) +
+                     ( ( 1.0 - x ) * ( 1.0 - x ) * s1.confidence );
+      boxes.push_back( { fn, lerp( s0.time, s1.time, x ),
+                         lerp( s0.box, s1.box, x ), c, nullptr } );
+    }
+  }
+
+  return boxes;
+}
+
+// ----------------------------------------------------------------------------
+track_sptr
+interpolate_track_spline::
+interpolate( track_sptr input_track )
+{
+  if ( !input_track ) return nullptr;
 
-      auto const& bbox = lerp( p0, p1, x );
-      auto const c = ( pow( x, 2.0 ) * c0 ) + ( pow( 1.0 - x, 2.0 ) * c1 );
+  // Create result track
+  auto new_track = track::create( input_track->data() );
+  new_track->set_id( input_track->id() );
 
-      auto const d = std::make_shared< detected_object >( bbox, c );
-      new_track->append(
-        std::make_shared< object_track_state >( fn, tn, d ) );
+  for ( auto& b : interpolate_boxes( *input_track ) )
+  {
+    auto detection = std::move( b.detection );
+    if ( !detection )
+    {
+      detection = std::make_shared< detected_object >( b.box, b.confidence );
     }
+    new_track->append(
+      std::make_shared< object_track_state >( b.frame, b.time,
+                                              std::move( detection ) ) );
   }
 
   return new_track;
 }
 
+// ----------------------------------------------------------------------------
+std::vector< track_sptr >
+interpolate_track_spline::
+batch_interpolate( std::vector< track_sptr > const& tracks )
+{
+  std::vector< track_sptr > result( tracks.size() );
+  std::vector< std::exception_ptr > errors( tracks.size() );
+
+  vital::thread_pool::instance().parallel_for(
+    tracks.size(), 16,
+    [ & ]( size_t begin, size_t end )
+    {
+      for ( auto i = begin; i < end; ++i )
+      {
+        try
+        {
+          result[ i ] = interpolate( tracks[ i ] );
+        }
+        catch ( ... )
+        {
+          errors[ i ] = std::current_exception();
+        }
+      }
+    } );
+
+  for ( auto const& error : errors )
+  {
+    if ( error ) std::rethrow_exception( error );
+  }
+
+  do_callback( static_cast< int >( tracks.size() ),
+               static_cast< int >( tracks.size() ) );
+  return result;
+}
+
 } } } // end namespace
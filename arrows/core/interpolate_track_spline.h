@@ -11,11 +11,30 @@
 #include <arrows/core/kwiver_algo_core_export.h>
 
 #include <vital/algo/interpolate_track.h>
+#include <vital/types/bounding_box.h>
+#include <vital/types/detected_object.h>
+
+#include <vector>
 
 namespace kwiver {
 namespace arrows {
 namespace core {
 
+/// A box of an object track, as read or interpolated from a track
+///
+/// This is a plain value, so that the boxes of many frames may be computed
+/// without allocating a track state and detection for each.
+struct spline_track_box
+{
+  vital::frame_id_t frame;
+  vital::time_usec_t time;
+  vital::bounding_box_d box;
+  double confidence;
+
+  /// Detection of the state this box was read from, or null if interpolated
+  vital::detected_object_sptr detection;
+};
+
 /// Fills in missing track segments using spline interpolation
 ///
 /// This class generates additional track states in between known states using
@@ -46,6 +65,17 @@ class KWIVER_ALGO_CORE_EXPORT interpolate_track_spline
   virtual kwiver::vital::track_sptr interpolate(
     kwiver::vital::track_sptr init_states ) override;
 
+  /// Interpolates the states of several tracks in parallel
+  virtual std::vector< kwiver::vital::track_sptr > batch_interpolate(
+    std::vector< kwiver::vital::track_sptr > const& tracks ) override;
+
+  /// Computes the boxes of every frame of a track
+  ///
+  /// This gives the boxes interpolate() fills the track with, without
+  /// creating track states. States without a detection are ignored.
+  static std::vector< spline_track_box > interpolate_boxes(
+    kwiver::vital::track const& init_states );
+
 protected:
   /// private implementation class
   class priv;
@@ -7,6 +7,9 @@
 
 #include "keyframe_selector_basic.h"
 #include <vital/types/feature_track_set.h>
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
 
 using namespace kwiver::vital;
 
@@ -14,6 +17,58 @@ namespace kwiver {
 namespace arrows {
 namespace core {
 
+namespace {
+
+/// Sorted IDs of the tracks active on a frame
+std::vector<track_id_t>
+active_track_ids(track_set const& tracks, frame_id_t frame)
+{
+  std::vector<track_id_t> ids;
+  for (auto const& t : tracks.active_tracks(frame))
+  {
+    ids.push_back(t->id());
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+/// Fraction of the tracks on either of two frames that are on both,
+/// as computed by track_set::percentage_tracked
+double
+fraction_tracked(std::vector<track_id_t> const& ids1,
+                 std::vector<track_id_t> const& ids2)
+{
+  size_t num_common = 0;
+  auto i1 = ids1.begin();
+  auto i2 = ids2.begin();
+  while (i1 != ids1.end() && i2 != ids2.end())
+  {
+    if (*i1 < *i2)
+    {
+      ++i1;
+    }
+    else if (*i2 < *i1)
+    {
+      ++i2;
+    }
+    else
+    {
+      ++num_common;
+      ++i1;
+      ++i2;
+    }
+  }
+
+  auto const num_union = ids1.size() + ids2.size() - num_common;
+  if (num_union == 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(num_common) / num_union;
+}
+
+} // end namespace
+
 class keyframe_selector_basic::priv {
 public:
   priv()
@@ -156,40 +211,80 @@ ::continuing_keyframe_selection(
     ftracks->all_feature_frame_data().rbegin()->first + 1;
 
   frame_id_t last_frame_id = tracks->last_frame();
+  if (next_candidate_keyframe_id > last_frame_id)
+  {
+    return;
+  }
 
-  for ( ; next_candidate_keyframe_id <= last_frame_id ;
-        ++next_candidate_keyframe_id)
+  // Get the tracks on each candidate frame in parallel. Reading the tracks of
+  // one frame first lets track sets build any frame index they build on
+  // demand before reading from several threads.
+  auto key_ids = active_track_ids(*tracks, last_keyframe_id);
+  auto const num_candidates =
+    static_cast<size_t>(last_frame_id - next_candidate_keyframe_id + 1);
+  std::vector<std::vector<track_id_t>> candidate_ids(num_candidates);
+  auto& pool = thread_pool::instance();
+  pool.parallel_for(num_candidates, 16,
+    [&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        candidate_ids[i] = active_track_ids(
+          *tracks, next_candidate_keyframe_id + static_cast<frame_id_t>(i));
+      }
+    });
+
+  // Decide whether each frame is a keyframe, which depends on the last
+  // keyframe before it. Frames are compared to the last keyframe in parallel
+  // a window at a time, and the window starts over after the first frame in
+  // it that is a keyframe.
+  auto const window = std::max<size_t>(64, 4 * pool.num_threads());
+  std::vector<char> is_keyframe(num_candidates, 0);
+  size_t first = 0;
+  while (first < num_candidates)
   {
-    auto active_tracks = tracks->active_tracks(next_candidate_keyframe_id);
-    if (active_tracks.empty())
+    auto const last = std::min(first + window, num_candidates);
+    pool.parallel_for(last - first, 8,
+      [&](size_t begin, size_t end)
+      {
+        for (size_t i = first + begin; i < first + end; ++i)
+        {
+          auto const& ids = candidate_ids[i];
+          double percentage_tracked = fraction_tracked(key_ids, ids);
+          is_keyframe[i] = !ids.empty() &&
+            percentage_tracked <=
+              (1.0 - fraction_tracks_lost_to_necessitate_new_keyframe) &&
+            ids.size() >= keyframe_min_feature_count;
+        }
+      });
+
+    auto const next_keyframe =
+      std::find(is_keyframe.begin() + first, is_keyframe.begin() + last, 1);
+    if (next_keyframe == is_keyframe.begin() + last)
     {
-      //absolutely no tracks for this frame so it was skipped when reading.
-      continue;
+      first = last;
     }
-
-    bool is_keyframe = true;
-    double percentage_tracked =
-      tracks->percentage_tracked(last_keyframe_id, next_candidate_keyframe_id);
-    if ( percentage_tracked >
-        (1.0 - fraction_tracks_lost_to_necessitate_new_keyframe))
+    else
     {
-      is_keyframe = false;
+      first = static_cast<size_t>(next_keyframe - is_keyframe.begin());
+      key_ids = candidate_ids[first];
+      ++first;
     }
+  }
 
-    //ok we could make this a keyframe.  Does it have enough features?
-    if (active_tracks.size() < keyframe_min_feature_count)
+  for (size_t i = 0; i < num_candidates; ++i)
+  {
+    if (candidate_ids[i].empty())
     {
-      is_keyframe = false;
+      //absolutely no tracks for this frame so it was skipped when reading.
+      continue;
     }
 
     //add it's metadata to tracks
     auto ftsfd = std::make_shared<feature_track_set_frame_data>();
-    ftsfd->is_keyframe = is_keyframe;
-    tracks->set_frame_data(ftsfd, next_candidate_keyframe_id);
-    if (is_keyframe)
-    {
-      last_keyframe_id = next_candidate_keyframe_id;
-    }
+    ftsfd->is_keyframe = is_keyframe[i] != 0;
+    tracks->set_frame_data(
+      ftsfd, next_candidate_keyframe_id + static_cast<frame_id_t>(i));
   }
 }
 
@@ -0,0 +1,361 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of the core match_features_bruteforce algorithm
+
+#include "match_features_bruteforce.h"
+
+#include <vital/types/packed_descriptor_set.h>
+#include <vital/util/enum_converter.h>
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+
+#include <cstdint>
+#include <cstring>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+namespace {
+
+enum distance_metric
+{
+  METRIC_auto,
+  METRIC_hamming,
+  METRIC_l2,
+};
+
+ENUM_CONVERTER( metric_converter, distance_metric,
+                { "auto", METRIC_auto },
+                { "hamming", METRIC_hamming },
+                { "l2", METRIC_l2 } );
+
+// Number of query rows handed to a thread at a time
+constexpr size_t rows_per_chunk = 64;
+
+// ----------------------------------------------------------------------------
+inline unsigned
+popcount( uint64_t v )
+{
+#if defined( __GNUC__ ) || defined( __clang__ )
+  return static_cast< unsigned >( __builtin_popcountll( v ) );
+#else
+  v = v - ( ( v >> 1 ) & 0x5555555555555555ull );
+  v = ( v & 0x3333333333333333ull ) + ( ( v >> 2 ) & 0x3333333333333333ull );
+  v = ( v + ( v >> 4 ) ) & 0x0F0F0F0F0F0F0F0Full;
+  return static_cast< unsigned >( ( v * 0x0101010101010101ull ) >> 56 );
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Number of differing bits between two byte strings, a word at a time
+struct hamming_distance
+{
+  using value_t = unsigned;
+
+  static double ratio_factor( double ratio ) { return ratio; }
+
+  value_t
+  operator()( vital::byte const* a, vital::byte const* b, size_t n ) const
+  {
+    value_t result = 0;
+    size_t i = 0;
+    for( ; i + sizeof( uint64_t ) <= n; i += sizeof( uint64_t ) )
+    {
+      uint64_t wa, wb;
+      std::memcpy( &wa, a + i, sizeof( uint64_t ) );
+      std::memcpy( &wb, b + i, sizeof( uint64_t ) );
+      result += popcount( wa ^ wb );
+    }
+    for( ; i < n; ++i )
+    {
+      result += popcount( static_cast< uint64_t >( a[ i ] ^ b[ i ] ) );
+    }
+    return result;
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Squared Euclidean distance, accumulated in a type wide enough for T
+template < typename T >
+struct l2_distance
+{
+  using value_t =
+    typename std::conditional< std::is_integral< T >::value,
+                               uint64_t, T >::type;
+  using diff_t =
+    typename std::conditional< std::is_integral< T >::value,
+                               int64_t, T >::type;
+
+  // Distances are squared, so the ratio must be too
+  static double ratio_factor( double ratio ) { return ratio * ratio; }
+
+  value_t
+  operator()( T const* a, T const* b, size_t n ) const
+  {
+    value_t result = 0;
+    for( size_t i = 0; i < n; ++i )
+    {
+      auto const diff =
+        static_cast< diff_t >( a[ i ] ) - static_cast< diff_t >( b[ i ] );
+      result += static_cast< value_t >( diff * diff );
+    }
+    return result;
+  }
+};
+
+// ----------------------------------------------------------------------------
+// The nearest and second nearest rows of a train set to one query row
+template < typename Value >
+struct neighbors
+{
+  unsigned index = std::numeric_limits< unsigned >::max();
+  Value best = std::numeric_limits< Value >::max();
+  Value second = std::numeric_limits< Value >::max();
+};
+
+// ----------------------------------------------------------------------------
+// Find the two nearest rows of train to each row of query
+template < typename T, typename Distance >
+std::vector< neighbors< typename Distance::value_t > >
+nearest_neighbors( vital::packed_descriptor_set< T > const& query,
+                   vital::packed_descriptor_set< T > const& train,
+                   Distance const& distance )
+{
+  using value_t = typename Distance::value_t;
+
+  std::vector< neighbors< value_t > > result( query.size() );
+  auto const dim = query.dimension();
+  auto const train_size = train.size();
+  vital::thread_pool::instance().parallel_for(
+    query.size(), rows_per_chunk,
+    [ & ]( size_t begin, size_t end ){
+      for( auto i = begin; i < end; ++i )
+      {
+        auto const q = query.row( i );
+        auto& n = result[ i ];
+        for( size_t j = 0; j < train_size; ++j )
+        {
+          auto const value = distance( q, train.row( j ), dim );
+          if( value < n.best )
+          {
+            n.second = n.best;
+            n.best = value;
+            n.index = static_cast< unsigned >( j );
+          }
+          else if( value < n.second )
+          {
+            n.second = value;
+          }
+        }
+      }
+    } );
+  return result;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+// Private implementation class
+class match_features_bruteforce::priv
+{
+public:
+  template < typename T, typename Distance >
+  std::vector< vital::match >
+  match( vital::packed_descriptor_set< T > const& desc1,
+         vital::packed_descriptor_set< T > const& desc2,
+         Distance const& distance ) const;
+
+  distance_metric metric{ METRIC_auto };
+  double ratio_threshold{ 0.0 };
+  bool cross_check{ true };
+};
+
+// ----------------------------------------------------------------------------
+template < typename T, typename Distance >
+std::vector< vital::match >
+match_features_bruteforce::priv
+::match( vital::packed_descriptor_set< T > const& desc1,
+         vital::packed_descriptor_set< T > const& desc2,
+         Distance const& distance ) const
+{
+  auto const forward = nearest_neighbors( desc1, desc2, distance );
+  decltype( nearest_neighbors( desc2, desc1, distance ) ) backward;
+  if( cross_check )
+  {
+    backward = nearest_neighbors( desc2, desc1, distance );
+  }
+
+  auto const ratio_factor = Distance::ratio_factor( ratio_threshold );
+
+  std::vector< vital::match > result;
+  for( unsigned i = 0; i < forward.size(); ++i )
+  {
+    auto const& n = forward[ i ];
+    if( n.index >= desc2.size() )
+    {
+      continue;
+    }
+    if( ratio_threshold > 0.0 &&
+        !( static_cast< double >( n.best ) <
+           ratio_factor * static_cast< double >( n.second ) ) )
+    {
+      continue;
+    }
+    if( cross_check && backward[ n.index ].index != i )
+    {
+      continue;
+    }
+    result.emplace_back( i, n.index );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+match_features_bruteforce
+::match_features_bruteforce()
+  : d{ new priv{} }
+{
+  attach_logger( "arrows.core.match_features_bruteforce" );
+}
+
+// ----------------------------------------------------------------------------
+match_features_bruteforce
+::~match_features_bruteforce()
+{
+}
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+match_features_bruteforce
+::get_configuration() const
+{
+  // get base config from base class
+  vital::config_block_sptr config = match_features::get_configuration();
+
+  config->set_value( "distance", metric_converter().to_string( d->metric ),
+                     "Distance between descriptors. 'auto' uses Hamming "
+                     "distance for byte descriptors and Euclidean distance "
+                     "otherwise. Hamming distance requires byte descriptors. "
+                     "Possible options are: " +
+                     metric_converter().element_name_string() );
+  config->set_value( "ratio_threshold", d->ratio_threshold,
+                     "Keep a match only if its distance is less than this "
+                     "fraction of the distance to the second best candidate, "
+                     "as in the ratio test of D. Lowe's SIFT paper. A value "
+                     "of 0 disables the test." );
+  config->set_value( "cross_check", d->cross_check,
+                     "Keep a match only if each descriptor is the best match "
+                     "of the other." );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+match_features_bruteforce
+::set_configuration( vital::config_block_sptr in_config )
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config( in_config );
+
+  d->metric = config->get_enum_value< metric_converter >( "distance" );
+  d->ratio_threshold = config->get_value< double >( "ratio_threshold" );
+  d->cross_check = config->get_value< bool >( "cross_check" );
+}
+
+// ----------------------------------------------------------------------------
+bool
+match_features_bruteforce
+::check_configuration( vital::config_block_sptr in_config ) const
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config( in_config );
+
+  auto const ratio_threshold = config->get_value< double >( "ratio_threshold" );
+  if( ratio_threshold < 0.0 || ratio_threshold > 1.0 )
+  {
+    LOG_ERROR( logger(), "ratio_threshold must be in [0, 1] but instead was "
+               << ratio_threshold );
+    return false;
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+vital::match_set_sptr
+match_features_bruteforce
+::match( VITAL_UNUSED vital::feature_set_sptr feat1,
+         vital::descriptor_set_sptr desc1,
+         VITAL_UNUSED vital::feature_set_sptr feat2,
+         vital::descriptor_set_sptr desc2 ) const
+{
+  // Only perform matching if both descriptor sets are non-empty
+  if( !desc1 || !desc2 || desc1->empty() || desc2->empty() ||
+      !desc1->at( 0 ) )
+  {
+    return vital::match_set_sptr();
+  }
+
+  auto const& type = desc1->at( 0 )->data_type();
+  auto const metric =
+    ( d->metric != METRIC_auto )
+    ? d->metric
+    : ( type == typeid( vital::byte ) ? METRIC_hamming : METRIC_l2 );
+  if( metric == METRIC_hamming && type != typeid( vital::byte ) )
+  {
+    LOG_ERROR( logger(), "Hamming distance requires byte descriptors" );
+    return vital::match_set_sptr();
+  }
+
+  try
+  {
+#define MATCH_CASE( T, ... )                                              \
+    if( type == typeid( T ) )                                             \
+    {                                                                     \
+      auto const packed1 = vital::packed_descriptor_set< T >::from( *desc1 ); \
+      auto const packed2 = vital::packed_descriptor_set< T >::from( *desc2 ); \
+      if( packed1->dimension() != packed2->dimension() )                  \
+      {                                                                   \
+        LOG_ERROR( logger(), "Descriptor dimensions do not match" );      \
+        return vital::match_set_sptr();                                   \
+      }                                                                   \
+      return std::make_shared< vital::simple_match_set >(                 \
+        __VA_ARGS__ );                                                    \
+    }
+
+    MATCH_CASE( vital::byte,
+                metric == METRIC_hamming
+                ? d->match( *packed1, *packed2, hamming_distance{} )
+                : d->match( *packed1, *packed2,
+                            l2_distance< vital::byte >{} ) );
+    MATCH_CASE( float,
+                d->match( *packed1, *packed2, l2_distance< float >{} ) );
+    MATCH_CASE( double,
+                d->match( *packed1, *packed2, l2_distance< double >{} ) );
+
+#undef MATCH_CASE
+  }
+  catch( vital::invalid_value const& e )
+  {
+    LOG_ERROR( logger(), "Unable to pack descriptors: " << e.what() );
+    return vital::match_set_sptr();
+  }
+
+  LOG_ERROR( logger(), "Unsupported descriptor type: " << type.name() );
+  return vital::match_set_sptr();
+}
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
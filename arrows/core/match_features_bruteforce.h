@@ -0,0 +1,71 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header defining the core match_features_bruteforce algorithm
+
+#ifndef KWIVER_ARROWS_CORE_MATCH_FEATURES_BRUTEFORCE_H_
+#define KWIVER_ARROWS_CORE_MATCH_FEATURES_BRUTEFORCE_H_
+
+#include <arrows/core/kwiver_algo_core_export.h>
+
+#include <vital/algo/match_features.h>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+/// Match descriptors by exhaustive search, without external dependencies.
+///
+/// Byte descriptors are compared by Hamming distance and floating point
+/// descriptors by Euclidean distance, unless configured otherwise.
+/// Descriptors are packed into contiguous rows if they are not already, and
+/// query rows are divided among the threads of the vital thread pool.
+/// Matches may be filtered by Lowe's ratio test and by cross checking.
+class KWIVER_ALGO_CORE_EXPORT match_features_bruteforce
+  : public vital::algo::match_features
+{
+public:
+  PLUGIN_INFO( "brute_force",
+               "Feature matcher using brute force matching (exhaustive "
+               "search) of packed descriptors." )
+
+  match_features_bruteforce();
+  virtual ~match_features_bruteforce();
+
+  /// Get this algorithm's \link vital::config_block configuration block
+  /// \endlink.
+  virtual vital::config_block_sptr get_configuration() const;
+  /// Set this algorithm's properties via a config block.
+  virtual void set_configuration( vital::config_block_sptr config );
+  /// Check that the algorithm's currently configuration is valid.
+  virtual bool check_configuration( vital::config_block_sptr config ) const;
+
+  /// Match one set of features and corresponding descriptors to another
+  ///
+  /// \param [in] feat1 the first set of features to match
+  /// \param [in] desc1 the descriptors corresponding to \a feat1
+  /// \param [in] feat2 the second set of features to match
+  /// \param [in] desc2 the descriptors corresponding to \a feat2
+  /// \returns a set of matching indices from \a feat1 to \a feat2
+  virtual vital::match_set_sptr
+  match( vital::feature_set_sptr feat1, vital::descriptor_set_sptr desc1,
+         vital::feature_set_sptr feat2,
+         vital::descriptor_set_sptr desc2 ) const;
+
+private:
+  class priv;
+
+  std::unique_ptr< priv > const d;
+};
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
+
+#endif
@@ -0,0 +1,570 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Bounding volume hierarchy for repeated closest point and ray intersection
+/// queries on a triangular mesh.
+
+#include "mesh_bvh.h"
+
+#include <arrows/core/mesh_intersect.h>
+
+#include <vital/exceptions/base.h>
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+
+#include <cmath>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+using namespace kwiver::vital;
+
+namespace {
+
+// Number of queries handed to a thread at a time
+constexpr size_t queries_per_chunk = 256;
+
+// Number of bins in which split positions are evaluated along each axis
+constexpr size_t num_bins = 16;
+
+// Largest number of triangles left in a leaf when splitting would not lower
+// its cost
+constexpr size_t max_leaf_size = 8;
+
+// Cost of visiting a node relative to testing one triangle
+constexpr double traversal_cost = 1.0;
+
+// Relative slack by which boxes are grown in queries, so that rounding in the
+// box tests never prunes a triangle which the triangle tests would accept
+constexpr double box_slack = 1e-12;
+
+// ----------------------------------------------------------------------------
+// Axis aligned bounding box
+struct box
+{
+  vector_3d lower{ vector_3d::Constant(
+                     std::numeric_limits< double >::infinity() ) };
+  vector_3d upper{ vector_3d::Constant(
+                     -std::numeric_limits< double >::infinity() ) };
+
+  void
+  extend( vector_3d const& p )
+  {
+    lower = lower.cwiseMin( p );
+    upper = upper.cwiseMax( p );
+  }
+
+  void
+  extend( box const& other )
+  {
+    lower = lower.cwiseMin( other.lower );
+    upper = upper.cwiseMax( other.upper );
+  }
+
+  // Half of the surface area, or zero for an empty box
+  double
+  half_area() const
+  {
+    if( ( upper.array() < lower.array() ).any() )
+    {
+      return 0.0;
+    }
+
+    vector_3d const e = upper - lower;
+    return e[ 0 ] * e[ 1 ] + e[ 1 ] * e[ 2 ] + e[ 2 ] * e[ 0 ];
+  }
+};
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+// Private implementation class
+class mesh_bvh::priv
+{
+public:
+  // A node holds the triangles in [begin, end) if it is a leaf, in which case
+  // second_child is zero. Otherwise its first child follows it in the array.
+  struct node
+  {
+    box bounds;
+    size_t begin;
+    size_t end;
+    size_t second_child;
+  };
+
+  // A triangle with its un-normalized normal (b-a)x(c-a)
+  struct triangle
+  {
+    point_3d a;
+    point_3d b;
+    point_3d c;
+    vector_3d n;
+  };
+
+  // Result of a query on one triangle
+  struct hit
+  {
+    int face;
+    double dist;
+    double u;
+    double v;
+  };
+
+  explicit priv( mesh const& m );
+
+  size_t build_node( std::vector< box > const& bounds,
+                     std::vector< vector_3d > const& centroids,
+                     size_t begin, size_t end );
+
+  hit closest_point( vector_3d const& p ) const;
+  hit intersect( vector_3d const& p, vector_3d const& d ) const;
+
+  point_3d
+  interpolate( int face, double u, double v ) const
+  {
+    auto const& t = m_triangles[ m_tree_index[ face ] ];
+    return point_3d{ ( 1.0 - u - v ) * t.a.value() +
+                     u * t.b.value() + v * t.c.value() };
+  }
+
+  // Triangles in tree order
+  std::vector< triangle > m_triangles;
+  // Face index of each triangle in tree order
+  std::vector< int > m_faces;
+  // Position in tree order of each face
+  std::vector< size_t > m_tree_index;
+  std::vector< node > m_nodes;
+};
+
+// ----------------------------------------------------------------------------
+mesh_bvh::priv
+::priv( mesh const& m )
+{
+  if( m.faces().regularity() != 3 )
+  {
+    VITAL_THROW( invalid_value,
+                 "Bounding volume hierarchy requires a triangular mesh." );
+  }
+
+  auto const& verts = m.vertices< 3 >();
+  auto const& faces =
+    static_cast< mesh_regular_face_array< 3 > const& >( m.faces() );
+  auto const num_faces = faces.size();
+
+  std::vector< box > bounds( num_faces );
+  std::vector< vector_3d > centroids( num_faces );
+  for( size_t i = 0; i < num_faces; ++i )
+  {
+    for( size_t j = 0; j < 3; ++j )
+    {
+      bounds[ i ].extend( verts[ faces[ i ][ j ] ] );
+    }
+    centroids[ i ] = 0.5 * ( bounds[ i ].lower + bounds[ i ].upper );
+  }
+
+  m_faces.resize( num_faces );
+  std::iota( m_faces.begin(), m_faces.end(), 0 );
+  if( num_faces )
+  {
+    m_nodes.reserve( 2 * num_faces / max_leaf_size + 1 );
+    build_node( bounds, centroids, 0, num_faces );
+  }
+
+  m_triangles.reserve( num_faces );
+  m_tree_index.resize( num_faces );
+  for( size_t i = 0; i < num_faces; ++i )
+  {
+    auto const& f = faces[ m_faces[ i ] ];
+    vector_3d const a = verts[ f[ 0 ] ];
+    vector_3d const b = verts[ f[ 1 ] ];
+    vector_3d const c = verts[ f[ 2 ] ];
+    m_triangles.push_back( { point_3d{ a }, point_3d{ b }, point_3d{ c },
+                             ( b - a ).cross( c - a ) } );
+    m_tree_index[ m_faces[ i ] ] = i;
+  }
+}
+
+// ----------------------------------------------------------------------------
+size_t
+mesh_bvh::priv
+::build_node( std::vector< box > const& bounds,
+              std::vector< vector_3d > const& centroids,
+              size_t begin, size_t end )
+{
+  auto const index = m_nodes.size();
+  m_nodes.push_back( { {}, begin, end, 0 } );
+
+  box node_bounds, centroid_bounds;
+  for( auto i = begin; i < end; ++i )
+  {
+    node_bounds.extend( bounds[ m_faces[ i ] ] );
+    centroid_bounds.extend( centroids[ m_faces[ i ] ] );
+  }
+  m_nodes[ index ].bounds = node_bounds;
+
+  auto const count = end - begin;
+  vector_3d const extent = centroid_bounds.upper - centroid_bounds.lower;
+  if( count == 1 || extent.maxCoeff() <= 0.0 )
+  {
+    return index;
+  }
+
+  // Find the binned split of least surface area heuristic cost
+  auto const bin_of =
+    [ & ]( int face, int axis ){
+      auto const b = static_cast< size_t >(
+        num_bins * ( centroids[ face ][ axis ] -
+                     centroid_bounds.lower[ axis ] ) / extent[ axis ] );
+      return std::min( b, num_bins - 1 );
+    };
+
+  auto best_cost = std::numeric_limits< double >::infinity();
+  int best_axis = -1;
+  size_t best_bin = 0;
+  for( int axis = 0; axis < 3; ++axis )
+  {
+    if( extent[ axis ] <= 0.0 )
+    {
+      continue;
+    }
+
+    std::array< box, num_bins > bin_bounds;
+    std::array< size_t, num_bins > bin_counts{};
+    for( auto i = begin; i < end; ++i )
+    {
+      auto const b = bin_of( m_faces[ i ], axis );
+      bin_bounds[ b ].extend( bounds[ m_faces[ i ] ] );
+      ++bin_counts[ b ];
+    }
+
+    // Sweep from the upper end to find the cost of each upper side
+    std::array< double, num_bins > upper_cost;
+    box upper_bounds;
+    size_t upper_count = 0;
+    for( auto b = num_bins - 1; b > 0; --b )
+    {
+      upper_bounds.extend( bin_bounds[ b ] );
+      upper_count += bin_counts[ b ];
+      upper_cost[ b ] = upper_bounds.half_area() * upper_count;
+    }
+
+    // Sweep from the lower end, splitting after bin b
+    box lower_bounds;
+    size_t lower_count = 0;
+    for( size_t b = 0; b + 1 < num_bins; ++b )
+    {
+      lower_bounds.extend( bin_bounds[ b ] );
+      lower_count += bin_counts[ b ];
+      if( lower_count == 0 || lower_count == count )
+      {
+        continue;
+      }
+
+      auto const cost = lower_bounds.half_area() * lower_count +
+                        upper_cost[ b + 1 ];
+      if( cost < best_cost )
+      {
+        best_cost = cost;
+        best_axis = axis;
+        best_bin = b;
+      }
+    }
+  }
+
+  auto const leaf_cost = static_cast< double >( count );
+  auto const node_area = node_bounds.half_area();
+  auto const split_cost =
+    node_area > 0.0 ? traversal_cost + best_cost / node_area : leaf_cost;
+  if( best_axis < 0 || ( count <= max_leaf_size && split_cost >= leaf_cost ) )
+  {
+    return index;
+  }
+
+  auto const middle = std::partition(
+    m_faces.begin() + begin, m_faces.begin() + end,
+    [ & ]( int face ){ return bin_of( face, best_axis ) <= best_bin; } );
+  auto const mid = static_cast< size_t >( middle - m_faces.begin() );
+
+  build_node( bounds, centroids, begin, mid );
+  auto const child1 = build_node( bounds, centroids, mid, end );
+  m_nodes[ index ].second_child = child1;
+  return index;
+}
+
+// ----------------------------------------------------------------------------
+mesh_bvh::priv::hit
+mesh_bvh::priv
+::closest_point( vector_3d const& p ) const
+{
+  hit result{ -1, std::numeric_limits< double >::infinity(), 0.0, 0.0 };
+  if( m_nodes.empty() )
+  {
+    return result;
+  }
+
+  auto const box_distance =
+    [ &p ]( box const& b ){
+      return ( p - p.cwiseMax( b.lower ).cwiseMin( b.upper ) ).squaredNorm();
+    };
+
+  point_3d const query{ p };
+  std::vector< size_t > stack{ 0 };
+  while( !stack.empty() )
+  {
+    auto const index = stack.back();
+    auto const& n = m_nodes[ index ];
+    stack.pop_back();
+
+    if( box_distance( n.bounds ) >
+        result.dist * result.dist * ( 1.0 + box_slack ) )
+    {
+      continue;
+    }
+
+    if( !n.second_child )
+    {
+      // Keep the lowest face index among equally near triangles, as a search
+      // of the faces in order would
+      for( auto i = n.begin; i < n.end; ++i )
+      {
+        auto const& t = m_triangles[ i ];
+        double dist, u, v;
+        if( mesh_triangle_closest_point( query, t.a, t.b, t.c, t.n,
+                                         dist, u, v ) &&
+            ( dist < result.dist ||
+              ( dist == result.dist && m_faces[ i ] < result.face ) ) )
+        {
+          result = hit{ m_faces[ i ], dist, u, v };
+        }
+      }
+      continue;
+    }
+
+    // Visit the nearer child first
+    auto const first = index + 1;
+    auto const second = n.second_child;
+    if( box_distance( m_nodes[ first ].bounds ) <
+        box_distance( m_nodes[ second ].bounds ) )
+    {
+      stack.push_back( second );
+      stack.push_back( first );
+    }
+    else
+    {
+      stack.push_back( first );
+      stack.push_back( second );
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+mesh_bvh::priv::hit
+mesh_bvh::priv
+::intersect( vector_3d const& p, vector_3d const& d ) const
+{
+  hit result{ -1, std::numeric_limits< double >::infinity(), 0.0, 0.0 };
+  if( m_nodes.empty() )
+  {
+    return result;
+  }
+
+  // Intersect the ray with the slabs of a box, returning the distance at
+  // which it enters the box, or infinity if it misses
+  auto const inv_d = d.cwiseInverse();
+  auto const entry_distance =
+    [ & ]( box const& b ){
+      auto t_min = 0.0;
+      auto t_max = std::numeric_limits< double >::infinity();
+      for( int k = 0; k < 3; ++k )
+      {
+        if( d[ k ] == 0.0 )
+        {
+          if( p[ k ] < b.lower[ k ] || p[ k ] > b.upper[ k ] )
+          {
+            return std::numeric_limits< double >::infinity();
+          }
+          continue;
+        }
+
+        auto t0 = ( b.lower[ k ] - p[ k ] ) * inv_d[ k ];
+        auto t1 = ( b.upper[ k ] - p[ k ] ) * inv_d[ k ];
+        if( t0 > t1 )
+        {
+          std::swap( t0, t1 );
+        }
+        t_min = std::max( t_min, t0 );
+        t_max = std::min( t_max, t1 );
+      }
+      return t_min <= t_max + box_slack * std::abs( t_max ) ? t_min
+                            : std::numeric_limits< double >::infinity();
+    };
+
+  point_3d const origin{ p };
+  std::vector< size_t > stack{ 0 };
+  while( !stack.empty() )
+  {
+    auto const index = stack.back();
+    auto const& n = m_nodes[ index ];
+    stack.pop_back();
+
+    auto const entry = entry_distance( n.bounds );
+    if( std::isinf( entry ) || entry > result.dist * ( 1.0 + box_slack ) )
+    {
+      continue;
+    }
+
+    if( !n.second_child )
+    {
+      // Keep the highest face index among equally near triangles, as
+      // mesh_intersect() does
+      for( auto i = n.begin; i < n.end; ++i )
+      {
+        auto const& t = m_triangles[ i ];
+        auto dist = result.dist;
+        double u, v;
+        if( mesh_intersect_triangle_min_dist( origin, d, t.a, t.b, t.c, t.n,
+                                              dist, u, v ) &&
+            ( dist < result.dist || m_faces[ i ] > result.face ) )
+        {
+          result = hit{ m_faces[ i ], dist, u, v };
+        }
+      }
+      continue;
+    }
+
+    // Visit the child the ray enters first first
+    auto const first = index + 1;
+    auto const second = n.second_child;
+    if( entry_distance( m_nodes[ first ].bounds ) <
+        entry_distance( m_nodes[ second ].bounds ) )
+    {
+      stack.push_back( second );
+      stack.push_back( first );
+    }
+    else
+    {
+      stack.push_back( first );
+      stack.push_back( second );
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+mesh_bvh
+::mesh_bvh( mesh const& mesh )
+  : d{ new priv{ mesh } }
+{
+}
+
+// ----------------------------------------------------------------------------
+mesh_bvh
+::~mesh_bvh()
+{
+}
+
+// ----------------------------------------------------------------------------
+size_t
+mesh_bvh
+::size() const
+{
+  return d->m_triangles.size();
+}
+
+// ----------------------------------------------------------------------------
+int
+mesh_bvh
+::closest_point( point_3d const& p, point_3d& cp, double& u, double& v ) const
+{
+  auto const h = d->closest_point( p.value() );
+  if( h.face >= 0 )
+  {
+    u = h.u;
+    v = h.v;
+    cp = d->interpolate( h.face, u, v );
+  }
+  return h.face;
+}
+
+// ----------------------------------------------------------------------------
+int
+mesh_bvh
+::intersect( point_3d const& p, vector_3d const& dir,
+             double& dist, double& u, double& v ) const
+{
+  auto const h = d->intersect( p.value(), dir );
+  dist = h.dist;
+  if( h.face >= 0 )
+  {
+    u = h.u;
+    v = h.v;
+  }
+  return h.face;
+}
+
+// ----------------------------------------------------------------------------
+void
+mesh_bvh
+::closest_points( std::vector< point_3d > const& points,
+                  std::vector< int >& faces,
+                  std::vector< point_3d >& closest,
+                  std::vector< vector_2d >& uv ) const
+{
+  faces.resize( points.size() );
+  closest.resize( points.size() );
+  uv.resize( points.size() );
+  thread_pool::instance().parallel_for(
+    points.size(), queries_per_chunk,
+    [ & ]( size_t begin, size_t end ){
+      for( auto i = begin; i < end; ++i )
+      {
+        faces[ i ] = closest_point( points[ i ], closest[ i ],
+                                    uv[ i ][ 0 ], uv[ i ][ 1 ] );
+      }
+    } );
+}
+
+// ----------------------------------------------------------------------------
+void
+mesh_bvh
+::intersect( std::vector< point_3d > const& points,
+             std::vector< vector_3d > const& directions,
+             std::vector< int >& faces,
+             std::vector< double >& dists,
+             std::vector< vector_2d >& uv ) const
+{
+  if( points.size() != directions.size() )
+  {
+    VITAL_THROW( invalid_value,
+                 "Number of ray directions must match number of points." );
+  }
+
+  faces.resize( points.size() );
+  dists.resize( points.size() );
+  uv.resize( points.size() );
+  thread_pool::instance().parallel_for(
+    points.size(), queries_per_chunk,
+    [ & ]( size_t begin, size_t end ){
+      for( auto i = begin; i < end; ++i )
+      {
+        faces[ i ] = intersect( points[ i ], directions[ i ],
+                                dists[ i ], uv[ i ][ 0 ], uv[ i ][ 1 ] );
+      }
+    } );
+}
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
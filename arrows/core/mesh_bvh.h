@@ -0,0 +1,107 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Bounding volume hierarchy for repeated closest point and ray intersection
+/// queries on a triangular mesh.
+
+#ifndef KWIVER_ARROWS_CORE_MESH_BVH_H
+#define KWIVER_ARROWS_CORE_MESH_BVH_H
+
+#include <arrows/core/kwiver_algo_core_export.h>
+
+#include <vital/types/mesh.h>
+#include <vital/types/point.h>
+
+#include <memory>
+#include <vector>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+/// Bounding volume hierarchy over the triangles of a mesh
+///
+/// The hierarchy is built once over a copy of the triangles, split with the
+/// surface area heuristic and stored as a flat array of nodes in depth first
+/// order, with the triangles of each leaf adjacent in memory. Queries do not
+/// modify the hierarchy, so they may be made concurrently, and the batch
+/// queries run in parallel on the vital thread pool.
+///
+/// Results match mesh_intersect() and mesh_closest_point() on the same mesh,
+/// including their choice among equally near triangles, but the mesh need
+/// not have face normals. Rays hit only triangles facing them, as given by
+/// the order of their vertices.
+class KWIVER_ALGO_CORE_EXPORT mesh_bvh
+{
+public:
+  /// Build the hierarchy over the triangles of a mesh
+  ///
+  /// \param mesh  a triangular mesh
+  /// \throws vital::invalid_value if the mesh is not triangular
+  explicit mesh_bvh( vital::mesh const& mesh );
+  ~mesh_bvh();
+
+  /// Number of triangles in the hierarchy
+  size_t size() const;
+
+  /// Find the closest point on the mesh to a reference point
+  ///
+  /// \param [in]   p     reference point to get closest distance to
+  /// \param [out]  cp    the closest point on the mesh
+  /// \param [out]  u     barycentric coordinate of the closest point
+  /// \param [out]  v     barycentric coordinate of the closest point
+  /// \returns      the face index of the closest triangle, or -1 if the mesh
+  ///               has no faces
+  int closest_point( vital::point_3d const& p, vital::point_3d& cp,
+                     double& u, double& v ) const;
+
+  /// Intersect a ray from a point with the mesh
+  ///
+  /// \param [in]   p     point that is the start of the ray
+  /// \param [in]   dir   direction of the ray
+  /// \param [out]  dist  the distance to the mesh along the ray
+  /// \param [out]  u     barycentric coordinate of the intersection
+  /// \param [out]  v     barycentric coordinate of the intersection
+  /// \returns      the face index of the intersected triangle, or -1 if the
+  ///               ray hits no triangle
+  int intersect( vital::point_3d const& p, vital::vector_3d const& dir,
+                 double& dist, double& u, double& v ) const;
+
+  /// Find the closest points on the mesh to many reference points
+  ///
+  /// Each output has one entry per point, as closest_point() would return.
+  /// Barycentric coordinates are stored as (u, v).
+  void closest_points( std::vector< vital::point_3d > const& points,
+                       std::vector< int >& faces,
+                       std::vector< vital::point_3d >& closest,
+                       std::vector< vital::vector_2d >& uv ) const;
+
+  /// Intersect many rays with the mesh
+  ///
+  /// Each output has one entry per ray, as intersect() would return.
+  /// Barycentric coordinates are stored as (u, v).
+  ///
+  /// \throws vital::invalid_value if there are not as many directions as
+  ///                               points
+  void intersect( std::vector< vital::point_3d > const& points,
+                  std::vector< vital::vector_3d > const& directions,
+                  std::vector< int >& faces,
+                  std::vector< double >& dists,
+                  std::vector< vital::vector_2d >& uv ) const;
+
+private:
+  class priv;
+
+  std::unique_ptr< priv > const d;
+};
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
+#endif // KWIVER_ARROWS_CORE_MESH_BVH_H
@@ -7,9 +7,11 @@
 
 #include "mesh_operations.h"
 #include <algorithm>
-#include <map>
+#include <atomic>
+#include <limits>
 #include <vital/exceptions.h>
 #include <vital/logger/logger.h>
+#include <vital/util/thread_pool.h>
 #include <Eigen/Geometry>
 
 namespace kwiver {
@@ -18,27 +20,124 @@ namespace core {
 
 using namespace kwiver::vital;
 
+namespace {
+
+// Faces handled by each task of the parallel loops below
+constexpr size_t face_chunk = 1 << 14;
+
+// Replace each count by the sum of the counts before it, and return the
+// total.  Chunks are summed in parallel and then offset by the sums of the
+// chunks before them, also in parallel.
+unsigned
+exclusive_scan(std::vector<unsigned>& counts)
+{
+  size_t const n = counts.size();
+  size_t const chunks = (n + face_chunk - 1) / face_chunk;
+  std::vector<unsigned> starts(chunks);
+  auto& pool = thread_pool::instance();
+
+  pool.parallel_for(chunks, 1, [&](size_t begin, size_t end)
+  {
+    for (size_t c = begin; c < end; ++c)
+    {
+      size_t const last = std::min(n, (c + 1) * face_chunk);
+      unsigned sum = 0;
+      for (size_t i = c * face_chunk; i < last; ++i)
+      {
+        sum += counts[i];
+      }
+      starts[c] = sum;
+    }
+  });
+
+  unsigned total = 0;
+  for (auto& start : starts)
+  {
+    unsigned const sum = start;
+    start = total;
+    total += sum;
+  }
+
+  pool.parallel_for(chunks, 1, [&](size_t begin, size_t end)
+  {
+    for (size_t c = begin; c < end; ++c)
+    {
+      size_t const last = std::min(n, (c + 1) * face_chunk);
+      unsigned offset = starts[c];
+      for (size_t i = c * face_chunk; i < last; ++i)
+      {
+        unsigned const count = counts[i];
+        counts[i] = offset;
+        offset += count;
+      }
+    }
+  });
+
+  return total;
+}
+
+// Map the groups of faces to the groups of the faces they were split into,
+// where face f became the faces starting at offset(f).  Groups left without
+// faces are dropped, as make_group does.
+template <class Offset>
+void
+remap_groups(mesh_face_array_base const& faces,
+             mesh_face_array_base& new_faces,
+             Offset const& offset)
+{
+  std::vector<std::pair<std::string, unsigned int> > groups;
+  for (auto const& g : faces.groups())
+  {
+    unsigned const end = offset(g.second);
+    if (end > (groups.empty() ? 0 : groups.back().second))
+    {
+      groups.emplace_back(g.first, end);
+    }
+  }
+  new_faces.set_groups(groups);
+}
+
+}
+
 /// Subdivide mesh faces into triangle
 std::unique_ptr<mesh_regular_face_array<3> >
 mesh_triangulate(mesh_face_array_base const& faces)
 {
-  std::unique_ptr<mesh_regular_face_array<3> >
-    tris(new mesh_regular_face_array<3>);
-  int group = -1;
-  if (faces.has_groups())
-  {
-    group = 0;
-  }
-  for (unsigned int f=0; f<faces.size(); ++f)
+  auto& pool = thread_pool::instance();
+  unsigned const num_faces = faces.size();
+
+  // each face of n vertices becomes a fan of n-2 triangles
+  std::vector<unsigned> offsets(num_faces);
+  pool.parallel_for(num_faces, face_chunk, [&](size_t begin, size_t end)
   {
-    for (unsigned i=2; i<faces.num_verts(f); ++i)
+    for (size_t f = begin; f < end; ++f)
     {
-      tris->push_back(mesh_tri(faces(f, 0), faces(f, i-1), faces(f, i)));
+      unsigned const n = faces.num_verts(f);
+      offsets[f] = (n > 2) ? n - 2 : 0;
     }
-    if (group >= 0 && f+1 >= faces.groups()[group].second)
+  });
+  unsigned const num_tris = exclusive_scan(offsets);
+
+  std::unique_ptr<mesh_regular_face_array<3> >
+    tris(new mesh_regular_face_array<3>(num_tris));
+  pool.parallel_for(num_faces, face_chunk, [&](size_t begin, size_t end)
+  {
+    for (size_t f = begin; f < end; ++f)
     {
-      tris->make_group(faces.groups()[group++].first);
+      unsigned t = offsets[f];
+      for (unsigned i=2; i<faces.num_verts(f); ++i)
+      {
+        (*tris)[t++] = mesh_tri(faces(f, 0), faces(f, i-1), faces(f, i));
+      }
     }
+  });
+
+  if (faces.has_groups())
+  {
+    remap_groups(faces, *tris, [&](unsigned f)
+    {
+      return (f < num_faces) ? offsets[f] : num_tris;
+    });
   }
   return tris;
 }
@@ -47,22 +146,23 @@ mesh_triangulate(mesh_face_array_base const& faces)
 std::unique_ptr<mesh_regular_face_array<3> >
 mesh_triangulate(mesh_regular_face_array<4> const& faces)
 {
+  unsigned const num_faces = faces.size();
   std::unique_ptr<mesh_regular_face_array<3> >
-    tris(new mesh_regular_face_array<3>);
-  int group = -1;
-  if (faces.has_groups())
+    tris(new mesh_regular_face_array<3>(2 * num_faces));
+  thread_pool::instance().parallel_for(num_faces, face_chunk,
+    [&](size_t begin, size_t end)
   {
-    group = 0;
-  }
-  for (unsigned int f=0; f<faces.size(); ++f)
-  {
-    const mesh_regular_face<4>& face = faces[f];
-    tris->push_back(mesh_tri(face[0], face[1], face[2]));
-    tris->push_back(mesh_tri(face[0], face[2], face[3]));
-    if (group >= 0 && f+1 >= faces.groups()[group].second)
+    for (size_t f = begin; f < end; ++f)
     {
-      tris->make_group(faces.groups()[group++].first);
+      const mesh_regular_face<4>& face = faces[f];
+      (*tris)[2*f] = mesh_tri(face[0], face[1], face[2]);
+      (*tris)[2*f+1] = mesh_tri(face[0], face[2], face[3]);
     }
+  });
+
+  if (faces.has_groups())
+  {
+    remap_groups(faces, *tris, [](unsigned f) { return 2 * f; });
   }
   return tris;
 }
@@ -92,50 +192,157 @@ mesh_triangulate(mesh& mesh)
 
 namespace {
 
-// Helper function to find intersection of edge between two vertices and a plane.
-// If the intersection has already been computed (from the other half edge)
-// reuse the previously computed point, otherwise compute a new one.
-// Returns the index of the intersection point.
-unsigned
-edge_plane_intersection(unsigned i1, unsigned i2,
-                        vital::mesh_vertex_array<3>& vertices,
-                        std::vector<double> const& dist,
-                        std::map<std::pair<unsigned, unsigned>, unsigned>& new_vert_map)
+// How a triangle lies with respect to a clipping plane
+enum class tri_side
 {
-  vital::vector_3d const& v1 = vertices[i1];
-  vital::vector_3d const& v2 = vertices[i2];
-  double const& d1 = dist[i1];
-  double const& d2 = dist[i2];
+  inside,   // entirely on the positive side, unchanged
+  kept,     // touching the plane on the positive side, unchanged
+  outside,  // removed
+  crossing, // split by the plane
+};
+
+// Find how a triangle lies with respect to the plane, given the signed
+// distances of the vertices to it.  If a triangle crosses the plane,
+// re-order the indices such that the first (ind[0]) is on the opposite side
+// of the plane from the others (ind[1] and ind[2]).
+tri_side
+classify(mesh_regular_face<3> const& tri, std::vector<double> const& dist,
+         unsigned ind[3])
+{
+  ind[0] = tri[0];
+  ind[1] = tri[1];
+  ind[2] = tri[2];
+  // enumerate the 8 possible combinations of which side of the plane
+  // the vertices lie on
+  uint8_t mode = ((dist[tri[0]] > 0.0) ? 4 : 0)
+               + ((dist[tri[1]] > 0.0) ? 2 : 0)
+               + ((dist[tri[2]] > 0.0) ? 1 : 0);
+  switch(mode)
+  {
+  case 7:
+    return tri_side::inside;
+  case 0:
+    return tri_side::outside;
+  case 1:
+  case 6:
+    std::rotate(ind, ind + 2, ind + 3); // [2, 0, 1]
+    break;
+  case 2:
+  case 5:
+    std::rotate(ind, ind + 1, ind + 3); // [1, 2, 0]
+    break;
+  case 3:
+  case 4:
+    // use the initial order [0, 1, 2]
+    break;
+  default:
+    VITAL_THROW( vital::invalid_data, "invalid triangle clipping case");
+  }
+
+  if (std::abs(dist[ind[0]]) < 1e-8)
+  {
+    return (dist[ind[1]] > 0.0) ? tri_side::kept : tri_side::outside;
+  }
+  return tri_side::crossing;
+}
 
-  auto key = (i1 > i2) ? std::make_pair(i2, i1)
-                       : std::make_pair(i1, i2);
+// Key of the edge between two vertices, the same for both half edges
+uint64_t
+edge_key(unsigned i1, unsigned i2)
+{
+  return (i1 > i2) ? (uint64_t{i2} << 32 | i1)
+                   : (uint64_t{i1} << 32 | i2);
+}
 
-  auto iter = new_vert_map.find(key);
-  if (iter != new_vert_map.end())
+// The vertices where the edges crossing a plane intersect it
+class edge_intersections
+{
+public:
+  // Record the crossing edges from their keys, which may be repeated
+  explicit edge_intersections(std::vector<uint64_t>&& keys)
+    : keys_(std::move(keys))
   {
-    return iter->second;
+    thread_pool::instance().parallel_sort(keys_.begin(), keys_.end());
+    keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
   }
 
-  // epsilon to avoid creating duplicate vertices
-  constexpr double eps = 1e-3;
-  double lambda = -d1 / (d2 - d1);
-  if (lambda <= eps)
+  // Intersect the edges with the plane, adding new vertices to the end of
+  // vertices in the order of the edge keys
+  void
+  intersect(vital::mesh_vertex_array<3>& vertices,
+            std::vector<double> const& dist)
   {
-    new_vert_map[key] = i1;
-    return i1;
+    auto& pool = thread_pool::instance();
+    size_t const num_edges = keys_.size();
+    verts_.resize(num_edges);
+
+    // epsilon to avoid creating duplicate vertices
+    constexpr double eps = 1e-3;
+    // marks the edges which need a new vertex until it is numbered
+    constexpr unsigned new_vertex = std::numeric_limits<unsigned>::max();
+    std::vector<double> lambdas(num_edges);
+    std::vector<unsigned> offsets(num_edges);
+    pool.parallel_for(num_edges, face_chunk, [&](size_t begin, size_t end)
+    {
+      for (size_t e = begin; e < end; ++e)
+      {
+        unsigned const i1 = static_cast<unsigned>(keys_[e] >> 32);
+        unsigned const i2 = static_cast<unsigned>(keys_[e]);
+        double const lambda = -dist[i1] / (dist[i2] - dist[i1]);
+        lambdas[e] = lambda;
+        offsets[e] = 0;
+        if (lambda <= eps)
+        {
+          verts_[e] = i1;
+        }
+        else if (lambda >= 1.0 - eps)
+        {
+          verts_[e] = i2;
+        }
+        else
+        {
+          verts_[e] = new_vertex;
+          offsets[e] = 1;
+        }
+      }
+    });
+
+    unsigned const first_new = vertices.size();
+    std::vector<vital::vector_3d> new_verts(exclusive_scan(offsets));
+    pool.parallel_for(num_edges, face_chunk, [&](size_t begin, size_t end)
+    {
+      for (size_t e = begin; e < end; ++e)
+      {
+        if (verts_[e] == new_vertex)
+        {
+          vital::vector_3d const& v1 = vertices[keys_[e] >> 32];
+          vital::vector_3d const& v2 =
+            vertices[static_cast<unsigned>(keys_[e])];
+          new_verts[offsets[e]] = v1 + lambdas[e] * (v2 - v1);
+          verts_[e] = first_new + offsets[e];
+        }
+      }
+    });
+
+    for (auto const& v : new_verts)
+    {
+      vertices.push_back(v);
+    }
   }
-  if (lambda >= 1.0 - eps)
+
+  // Get the intersection vertex of the edge between two vertices
+  unsigned
+  vertex(unsigned i1, unsigned i2) const
   {
-    new_vert_map[key] = i2;
-    return i2;
+    auto const it = std::lower_bound(keys_.begin(), keys_.end(),
+                                     edge_key(i1, i2));
+    return verts_[it - keys_.begin()];
   }
-  vital::vector_3d isect = v1 + lambda * (v2 - v1);
-  unsigned new_vert_ind = vertices.size();
-  vertices.push_back(isect);
-  new_vert_map[key] = new_vert_ind;
 
-  return new_vert_ind;
-}
+private:
+  std::vector<uint64_t> keys_;
+  std::vector<unsigned> verts_;
+};
 
 // choose which diagonal to use when splitting a quad into tris
 // pick the combination with the most even area distribution
@@ -143,7 +350,7 @@ edge_plane_intersection(unsigned i1, unsigned i2,
 // if returns false: use {i1, i2, i3} and {i3, i4, i1}
 bool
 choose_cut(unsigned i1, unsigned i2, unsigned i3, unsigned i4,
-           vital::mesh_vertex_array<3>& vertices)
+           vital::mesh_vertex_array<3> const& vertices)
 {
   vital::vector_3d const& v1 = vertices[i1];
   vital::vector_3d const& v2 = vertices[i2];
@@ -178,94 +385,136 @@ clip_mesh(mesh& mesh,
     return false;
   }
 
-  bool clipped = false;
-  std::vector<double> dist;
-  dist.reserve(vertices.size());
-  for (auto const& vert : vertices)
-  {
-    dist.push_back(vert.homogeneous().dot(plane));
-  }
+  auto& pool = thread_pool::instance();
 
-  // keep track of which edge intersection vertices have been added
-  std::map<std::pair<unsigned, unsigned>, unsigned> new_vert_map;
+  std::vector<double> dist(vertices.size());
+  pool.parallel_for(dist.size(), face_chunk, [&](size_t begin, size_t end)
+  {
+    for (size_t v = begin; v < end; ++v)
+    {
+      dist[v] = vertices[v].homogeneous().dot(plane);
+    }
+  });
 
   using tri_array = vital::mesh_regular_face_array<3>;
   auto const& triangles = static_cast< const tri_array& >(mesh.faces());
-  std::unique_ptr<tri_array> clipped_tris(new tri_array);
-  for (auto const& tri : triangles)
+  unsigned const num_tris = triangles.size();
+
+  // find the edges crossing the plane, two per crossing triangle
+  std::atomic<bool> clipped{false};
+  std::vector<unsigned> offsets(num_tris);
+  pool.parallel_for(num_tris, face_chunk, [&](size_t begin, size_t end)
   {
-    unsigned ind[3] = { tri[0], tri[1], tri[2] };
-    // enumerate the 8 possible combinations of which side of the plane
-    // the vertices lie on
-    uint8_t mode = ((dist[tri[0]] > 0.0) ? 4 : 0)
-                 + ((dist[tri[1]] > 0.0) ? 2 : 0)
-                 + ((dist[tri[2]] > 0.0) ? 1 : 0);
-    // if a triangle crosses the plane (modes 1-6) re-order the indices
-    // such that the first (ind[0]) is on the opposite side of the plane
-    // from the others (ind[1] and ind[2])
-    switch(mode)
+    bool any_clipped = false;
+    unsigned ind[3];
+    for (size_t t = begin; t < end; ++t)
+    {
+      auto const side = classify(triangles[t], dist, ind);
+      any_clipped = any_clipped || side != tri_side::inside;
+      offsets[t] = (side == tri_side::crossing) ? 2 : 0;
+    }
+    if (any_clipped)
     {
-    case 7:
-      clipped_tris->push_back(tri);
-      continue;
-    case 0:
       clipped = true;
-      continue;
-    case 1:
-    case 6:
-      std::rotate(ind, ind + 2, ind + 3); // [2, 0, 1]
-      break;
-    case 2:
-    case 5:
-      std::rotate(ind, ind + 1, ind + 3); // [1, 2, 0]
-      break;
-    case 3:
-    case 4:
-      // use the initial order [0, 1, 2]
-      break;
-    default:
-      VITAL_THROW( vital::invalid_data, "invalid triangle clipping case");
     }
-    clipped = true;
+  });
 
-    if (std::abs(dist[ind[0]]) < 1e-8)
+  std::vector<uint64_t> keys(exclusive_scan(offsets));
+  pool.parallel_for(num_tris, face_chunk, [&](size_t begin, size_t end)
+  {
+    unsigned ind[3];
+    for (size_t t = begin; t < end; ++t)
     {
-      if (dist[ind[1]] > 0.0)
+      if (classify(triangles[t], dist, ind) == tri_side::crossing)
       {
-        clipped_tris->push_back(tri);
+        keys[offsets[t]] = edge_key(ind[0], ind[1]);
+        keys[offsets[t] + 1] = edge_key(ind[0], ind[2]);
       }
-      continue;
     }
+  });
 
-    // compute (or lookup) new edge-plane intersection vertices
-    unsigned new_vert_ind1 = edge_plane_intersection(ind[0], ind[1], vertices,
-                                                     dist, new_vert_map);
-    unsigned new_vert_ind2 = edge_plane_intersection(ind[0], ind[2], vertices,
-                                                     dist, new_vert_map);
+  // compute the edge-plane intersection vertices, once per edge
+  edge_intersections isect(std::move(keys));
+  isect.intersect(vertices, dist);
 
-    if (new_vert_ind1 == new_vert_ind2)
+  // count, then write, the triangles covering the subset of each triangle
+  // on the positive side of the plane
+  auto const num_clipped_tris = [&](size_t t)
+  {
+    unsigned ind[3];
+    switch (classify(triangles[t], dist, ind))
     {
-      continue;
+    case tri_side::inside:
+    case tri_side::kept:
+      return 1u;
+    case tri_side::outside:
+      return 0u;
+    default:
+      break;
     }
-
-    // add new triangles covering the subset on the positive side of the plane
-    if (dist[ind[0]] > 0.0)
+    if (isect.vertex(ind[0], ind[1]) == isect.vertex(ind[0], ind[2]))
     {
-      clipped_tris->push_back({ind[0], new_vert_ind1, new_vert_ind2});
+      return 0u;
     }
-    else if (choose_cut(new_vert_ind1, ind[1], ind[2], new_vert_ind2, vertices))
+    return (dist[ind[0]] > 0.0) ? 1u : 2u;
+  };
+
+  pool.parallel_for(num_tris, face_chunk, [&](size_t begin, size_t end)
+  {
+    for (size_t t = begin; t < end; ++t)
     {
-      // add the new edge between ind[1] and new_vert_ind2
-      clipped_tris->push_back({ new_vert_ind1, ind[1], new_vert_ind2 });
-      clipped_tris->push_back({ ind[1], ind[2], new_vert_ind2 });
+      offsets[t] = num_clipped_tris(t);
     }
-    else
+  });
+
+  std::unique_ptr<tri_array> clipped_tris(
+    new tri_array(exclusive_scan(offsets)));
+  pool.parallel_for(num_tris, face_chunk, [&](size_t begin, size_t end)
+  {
+    unsigned ind[3];
+    for (size_t t = begin; t < end; ++t)
     {
-      // add the new edge between ind[2] and new_vert_ind1
-      clipped_tris->push_back({ new_vert_ind1, ind[1], ind[2]});
-      clipped_tris->push_back({ ind[2], new_vert_ind2, new_vert_ind1 });
+      auto const& tri = triangles[t];
+      unsigned const out = offsets[t];
+      switch (classify(tri, dist, ind))
+      {
+      case tri_side::inside:
+      case tri_side::kept:
+        (*clipped_tris)[out] = tri;
+        continue;
+      case tri_side::outside:
+        continue;
+      default:
+        break;
+      }
+
+      unsigned const new_vert_ind1 = isect.vertex(ind[0], ind[1]);
+      unsigned const new_vert_ind2 = isect.vertex(ind[0], ind[2]);
+      if (new_vert_ind1 == new_vert_ind2)
+      {
+        continue;
+      }
+
+      if (dist[ind[0]] > 0.0)
+      {
+        (*clipped_tris)[out] = { ind[0], new_vert_ind1, new_vert_ind2 };
+      }
+      else if (choose_cut(new_vert_ind1, ind[1], ind[2], new_vert_ind2,
+                          vertices))
+      {
+        // add the new edge between ind[1] and new_vert_ind2
+        (*clipped_tris)[out] = { new_vert_ind1, ind[1], new_vert_ind2 };
+        (*clipped_tris)[out + 1] = { ind[1], ind[2], new_vert_ind2 };
+      }
+      else
+      {
+        // add the new edge between ind[2] and new_vert_ind1
+        (*clipped_tris)[out] = { new_vert_ind1, ind[1], ind[2] };
+        (*clipped_tris)[out + 1] = { ind[2], new_vert_ind2, new_vert_ind1 };
+      }
     }
-  }
+  });
+
   mesh.set_faces(std::move(clipped_tris));
   return clipped;
 }
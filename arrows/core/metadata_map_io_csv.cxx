@@ -14,12 +14,19 @@
 #include <vital/types/geo_polygon.h>
 #include <vital/types/geodesy.h>
 #include <vital/util/string.h>
+#include <vital/util/thread_pool.h>
 #include <vital/util/tokenize.h>
 
 #include <vital/range/iota.h>
 
+#include <algorithm>
+#include <cmath>
+#include <exception>
 #include <iomanip>
 #include <iterator>
+#include <limits>
+#include <map>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <typeinfo>
@@ -48,12 +55,30 @@ class metadata_map_io_csv::priv
   std::vector< std::string > column_names;
   std::string overrides_string;
   std::vector< std::string > column_overrides;
-  uint64_t every_n_microseconds;
-  uint64_t every_n_frames;
+  uint64_t every_n_microseconds{ 0 };
+  uint64_t every_n_frames{ 0 };
 };
 
 namespace {
 
+// ----------------------------------------------------------------------------
+// Write a quoted field, doubling the quotes within it
+void
+write_quoted( std::ostream& os, std::string const& data )
+{
+  // TODO: handle other pathalogical characters such as newlines
+  os << '"';
+  for( auto const c : data )
+  {
+    os << c;
+    if( c == '"' )
+    {
+      os << c;
+    }
+  }
+  os << "\",";
+}
+
 // ----------------------------------------------------------------------------
 struct write_visitor {
   template< class T >
@@ -66,8 +91,9 @@ struct write_visitor {
     }
     else
     {
-      // TODO: handle pathalogical characters such as quotes or newlines
-      os << "\"" << data << "\",";
+      std::stringstream ss;
+      ss << data;
+      write_quoted( os, ss.str() );
     }
   }
 
@@ -87,8 +113,7 @@ template<>
 void
 write_visitor::operator()< std::string >( std::string const& data ) const
 {
-  // TODO: handle other pathalogical characters such as quotes or newlines
-  os << "\"" << data << "\",";
+  write_quoted( os, data );
 }
 
 // ----------------------------------------------------------------------------
@@ -123,9 +148,9 @@ get_column_count( std::type_info const& type )
 }
 
 // ----------------------------------------------------------------------------
-// Get the special name for a particular subvalue, if it exists
-std::string const*
-get_special_column_name( kv::vital_metadata_tag tag, size_t index )
+// Get the special names of the subvalues of tags which have them
+std::map< kv::vital_metadata_tag, std::vector< std::string > > const&
+get_special_column_names()
 {
   static std::map< kv::vital_metadata_tag,
                    std::vector< std::string > > const map = {
@@ -152,6 +177,15 @@ get_special_column_name( kv::vital_metadata_tag tag, size_t index )
         "Lower Left Corner Latitude (EPSG:4326)", } },
   };
 
+  return map;
+}
+
+// ----------------------------------------------------------------------------
+// Get the special name for a particular subvalue, if it exists
+std::string const*
+get_special_column_name( kv::vital_metadata_tag tag, size_t index )
+{
+  auto const& map = get_special_column_names();
   auto const it = map.find( tag );
   return ( it != map.end() ) ? &it->second.at( index ) : nullptr;
 }
@@ -276,6 +310,258 @@ parse_column_id( std::string const& s )
   return result;
 }
 
+// ----------------------------------------------------------------------------
+// Determine what subvalue a column title written by save_() refers to.
+column_id
+parse_column_title( std::string const& s )
+{
+  auto const result = parse_column_id( s );
+  if( result.tag != kv::VITAL_META_UNKNOWN )
+  {
+    return result;
+  }
+
+  for( auto const& entry : get_special_column_names() )
+  {
+    auto const& names = entry.second;
+    auto const it = std::find( names.begin(), names.end(), s );
+    if( it != names.end() )
+    {
+      return { entry.first, static_cast< size_t >( it - names.begin() ) };
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+// Split a line of a CSV file into its fields, removing quotes.
+void
+split_csv_line( std::string const& line, std::vector< std::string >& fields )
+{
+  fields.clear();
+  fields.emplace_back();
+
+  bool quoted = false;
+  for( size_t i = 0; i < line.size(); ++i )
+  {
+    auto const c = line[ i ];
+    if( quoted )
+    {
+      if( c != '"' )
+      {
+        fields.back().push_back( c );
+      }
+      else if( i + 1 < line.size() && line[ i + 1 ] == '"' )
+      {
+        fields.back().push_back( c );
+        ++i;
+      }
+      else
+      {
+        quoted = false;
+      }
+    }
+    else if( c == '"' )
+    {
+      quoted = true;
+    }
+    else if( c == ',' )
+    {
+      fields.emplace_back();
+    }
+    else if( c != '\r' || i + 1 != line.size() )
+    {
+      fields.back().push_back( c );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+struct read_visitor
+{
+  template< class T >
+  kv::metadata_value
+  operator()() const;
+
+  std::string const& field;
+};
+
+// ----------------------------------------------------------------------------
+template<>
+kv::metadata_value
+read_visitor
+::operator()< bool >() const
+{
+  if( field == "true" || field == "1" )
+  {
+    return true;
+  }
+  if( field == "false" || field == "0" )
+  {
+    return false;
+  }
+  throw std::invalid_argument( "not a boolean: " + field );
+}
+
+// ----------------------------------------------------------------------------
+template<>
+kv::metadata_value
+read_visitor
+::operator()< int >() const
+{
+  return std::stoi( field );
+}
+
+// ----------------------------------------------------------------------------
+template<>
+kv::metadata_value
+read_visitor
+::operator()< uint64_t >() const
+{
+  return static_cast< uint64_t >( std::stoull( field ) );
+}
+
+// ----------------------------------------------------------------------------
+template<>
+kv::metadata_value
+read_visitor
+::operator()< double >() const
+{
+  return std::stod( field );
+}
+
+// ----------------------------------------------------------------------------
+template<>
+kv::metadata_value
+read_visitor
+::operator()< std::string >() const
+{
+  return field;
+}
+
+// ----------------------------------------------------------------------------
+template<>
+kv::metadata_value
+read_visitor
+::operator()< kv::geo_point >() const
+{
+  throw std::logic_error( "geo_point should have been split" );
+}
+
+// ----------------------------------------------------------------------------
+template<>
+kv::metadata_value
+read_visitor
+::operator()< kv::geo_polygon >() const
+{
+  throw std::logic_error( "geo_polygon should have been split" );
+}
+
+// ----------------------------------------------------------------------------
+// Read a time written as hh:mm:ss.ssssss, or as a number of microseconds.
+uint64_t
+parse_microseconds( std::string const& field )
+{
+  std::istringstream ss{ field };
+  uint64_t hours, minutes, seconds, microseconds;
+  char c1, c2, c3;
+  if( ss >> hours >> c1 >> minutes >> c2 >> seconds >> c3 >> microseconds &&
+      c1 == ':' && c2 == ':' && c3 == '.' )
+  {
+    return ( ( hours * 60 + minutes ) * 60 + seconds ) * 1000000 +
+           microseconds;
+  }
+  return std::stoull( field );
+}
+
+// ----------------------------------------------------------------------------
+// Build the metadata packet held by the fields of one row.
+kv::metadata_sptr
+parse_csv_row( std::vector< std::string > const& fields,
+               std::vector< column_id > const& columns,
+               kv::frame_id_t& frame )
+{
+  frame = std::stoll( fields.at( 0 ) );
+
+  // The frame number is not written as a column of its own
+  auto const packet = std::make_shared< kv::metadata >();
+  packet->add< kv::VITAL_META_VIDEO_FRAME_NUMBER >(
+    static_cast< uint64_t >( frame ) );
+
+  // Subvalues of composite values, gathered until all are known
+  std::map< kv::vital_metadata_tag, std::vector< double > > parts;
+
+  auto const count = std::min( fields.size() - 1, columns.size() );
+  for( auto const i : kvr::iota( count ) )
+  {
+    auto const& field = fields[ i + 1 ];
+    auto const& id = columns[ i ];
+    if( field.empty() || id.tag == kv::VITAL_META_UNKNOWN )
+    {
+      continue;
+    }
+
+    auto const& type = kv::tag_traits_by_tag( id.tag ).type();
+    auto const column_count = get_column_count( type );
+    if( column_count > 1 )
+    {
+      auto& values = parts[ id.tag ];
+      values.resize( column_count,
+                     std::numeric_limits< double >::quiet_NaN() );
+      if( id.index < column_count )
+      {
+        values[ id.index ] = std::stod( field );
+      }
+    }
+    else if( id.tag == kv::VITAL_META_VIDEO_MICROSECONDS )
+    {
+      packet->add< kv::VITAL_META_VIDEO_MICROSECONDS >(
+        parse_microseconds( field ) );
+    }
+    else
+    {
+      packet->add( id.tag,
+                   kv::visit_metadata_types_return< kv::metadata_value >(
+                     read_visitor{ field }, type ) );
+    }
+  }
+
+  for( auto const& part : parts )
+  {
+    auto const& values = part.second;
+    if( std::any_of( values.begin(), values.end(),
+                     []( double v ){ return std::isnan( v ); } ) )
+    {
+      continue;
+    }
+
+    if( kv::tag_traits_by_tag( part.first ).type() == typeid( kv::geo_point ) )
+    {
+      packet->add( part.first,
+                   kv::geo_point{ kv::geo_point::geo_3d_point_t{
+                                    values[ 0 ], values[ 1 ], values[ 2 ] },
+                                  kv::SRID::lat_lon_WGS84 } );
+    }
+    else
+    {
+      kv::polygon corners;
+      for( size_t j = 0; j + 1 < values.size(); j += 2 )
+      {
+        corners.push_back( values[ j ], values[ j + 1 ] );
+      }
+      packet->add( part.first,
+                   kv::geo_polygon{ corners, kv::SRID::lat_lon_WGS84 } );
+    }
+  }
+
+  return packet;
+}
+
+// Rows are parsed this many at a time, in parallel, so only one batch of the
+// text is ever held in memory
+size_t const rows_per_batch = 1024;
+size_t const rows_per_task = 32;
+
 }
 
 // ----------------------------------------------------------------------------
@@ -401,9 +687,96 @@ ::get_configuration() const
 // ----------------------------------------------------------------------------
 kv::metadata_map_sptr
 metadata_map_io_csv
-::load_( VITAL_UNUSED std::istream& fin, std::string const& filename ) const
+::load_( std::istream& fin, std::string const& filename ) const
 {
-  throw kv::file_write_exception( filename, "not implemented" );
+  if( !fin )
+  {
+    VITAL_THROW( kv::file_not_read_exception, filename,
+                 "Could not read from stream" );
+  }
+
+  kv::metadata_map::map_metadata_t metadata_map;
+
+  std::string line;
+  std::vector< std::string > fields;
+  if( !std::getline( fin, line ) )
+  {
+    return std::make_shared< kv::simple_metadata_map >( metadata_map );
+  }
+
+  // Match the columns of the header to metadata tags
+  split_csv_line( line, fields );
+  if( fields.at( 0 ) != "Frame ID" )
+  {
+    VITAL_THROW( kv::file_not_read_exception, filename,
+                 "Missing \"Frame ID\" column" );
+  }
+
+  std::vector< column_id > columns;
+  for( size_t i = 1; i < fields.size(); ++i )
+  {
+    columns.push_back( parse_column_title( fields[ i ] ) );
+    if( columns.back().tag == kv::VITAL_META_UNKNOWN && !fields[ i ].empty() )
+    {
+      LOG_WARN( logger(), "Ignoring unknown column \"" << fields[ i ] << "\"" );
+    }
+  }
+
+  std::vector< std::string > lines( rows_per_batch );
+  std::vector< std::pair< kv::frame_id_t, kv::metadata_sptr > >
+    rows( rows_per_batch );
+  std::vector< std::exception_ptr > errors( rows_per_batch );
+  size_t row_number = 1;
+  size_t count;
+  do
+  {
+    for( count = 0; count < rows_per_batch; )
+    {
+      if( !std::getline( fin, lines[ count ] ) )
+      {
+        break;
+      }
+      if( !lines[ count ].empty() && lines[ count ] != "\r" )
+      {
+        ++count;
+      }
+    }
+
+    kv::thread_pool::instance().parallel_for(
+      count, rows_per_task,
+      [ & ]( size_t begin, size_t end ){
+        std::vector< std::string > row;
+        for( auto i = begin; i < end; ++i )
+        {
+          errors[ i ] = nullptr;
+          try
+          {
+            split_csv_line( lines[ i ], row );
+            rows[ i ].second = parse_csv_row( row, columns, rows[ i ].first );
+          }
+          catch( std::exception const& e )
+          {
+            errors[ i ] = std::make_exception_ptr(
+              kv::file_not_read_exception(
+                filename, "Could not parse row " +
+                          std::to_string( row_number + i ) + ": " +
+                          e.what() ) );
+          }
+        }
+      } );
+
+    for( auto const i : kvr::iota( count ) )
+    {
+      if( errors[ i ] )
+      {
+        std::rethrow_exception( errors[ i ] );
+      }
+      metadata_map[ rows[ i ].first ].push_back( std::move( rows[ i ].second ) );
+    }
+    row_number += count;
+  } while( count == rows_per_batch );
+
+  return std::make_shared< kv::simple_metadata_map >( metadata_map );
 }
 
 // ----------------------------------------------------------------------------
@@ -25,15 +25,21 @@ class KWIVER_ALGO_CORE_EXPORT metadata_map_io_csv
 {
 public:
   PLUGIN_INFO( "csv",
-               "Metadata map writer using CSV format." )
+               "Metadata map reader and writer using CSV format." )
 
   metadata_map_io_csv();
   virtual ~metadata_map_io_csv();
 
-  /// Unimplemented.
+  /// Implementation specific load functionality.
+  ///
+  /// Load metadata from a CSV file as written by save_(). Each row becomes a
+  /// packet of the frame in its first column, which is also restored as the
+  /// packet's frame number. Columns are matched to tags by their titles;
+  /// columns with unknown titles are ignored. Rows are parsed in parallel, a
+  /// batch at a time.
   ///
   /// \param filename the path to the file the load
-  /// \throws kwiver::vital::file_write_exception not implemented
+  /// \throws kwiver::vital::file_not_read_exception if a row cannot be parsed
   kwiver::vital::metadata_map_sptr load_(
     std::istream& fin, std::string const& filename ) const override;
 
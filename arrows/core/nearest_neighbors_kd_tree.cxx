@@ -0,0 +1,444 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of the core nearest_neighbors_kd_tree algorithm
+
+#include "nearest_neighbors_kd_tree.h"
+
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include <cmath>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+namespace {
+
+// Number of queries handed to a thread at a time
+constexpr size_t queries_per_chunk = 256;
+
+using vector_t = vital::point_3d::vector_type;
+
+// A candidate point as squared distance and index in tree order
+using candidate_t = std::pair< double, size_t >;
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+// Private implementation class
+class nearest_neighbors_kd_tree::priv
+{
+public:
+  // A node is a leaf if it has no children, in which case it holds the points
+  // in [begin, end). Otherwise, points in the first child are no greater than
+  // split along axis, and points in the second child are no less than it.
+  struct node
+  {
+    size_t begin;
+    size_t end;
+    size_t children[ 2 ];
+    double split;
+    int axis;
+  };
+
+  void build( std::vector< vital::point_3d > const& points );
+  size_t build_node( std::vector< vector_t > const& points,
+                     size_t begin, size_t end );
+
+  void nearest( vector_t const& query, size_t k,
+                std::vector< candidate_t >& result ) const;
+  void nearest( size_t node_index, vector_t const& query, size_t k,
+                std::vector< candidate_t >& result ) const;
+
+  void within_radius( vector_t const& query, double r2,
+                      std::vector< candidate_t >& result ) const;
+  void within_radius( size_t node_index, vector_t const& query, double r2,
+                      std::vector< candidate_t >& result ) const;
+
+  void find_nearest( vital::point_3d const& point, int K,
+                     std::vector< int >& indices,
+                     std::vector< double >& distances ) const;
+  void find_within_radius( vital::point_3d const& point, double r,
+                           std::vector< int >& indices ) const;
+
+  size_t leaf_size{ 10 };
+
+  bool m_built{ false };
+  // Points in tree order
+  std::vector< vector_t > m_points;
+  // Original index of each point in tree order
+  std::vector< int > m_indices;
+  std::vector< node > m_nodes;
+};
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree::priv
+::build( std::vector< vital::point_3d > const& points )
+{
+  std::vector< vector_t > values;
+  values.reserve( points.size() );
+  for( auto const& p : points )
+  {
+    values.push_back( p.value() );
+  }
+
+  m_indices.resize( points.size() );
+  std::iota( m_indices.begin(), m_indices.end(), 0 );
+  m_nodes.clear();
+  if( !values.empty() )
+  {
+    build_node( values, 0, values.size() );
+  }
+
+  m_points.clear();
+  m_points.reserve( values.size() );
+  for( auto const i : m_indices )
+  {
+    m_points.push_back( values[ i ] );
+  }
+  m_built = true;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+nearest_neighbors_kd_tree::priv
+::build_node( std::vector< vector_t > const& points, size_t begin, size_t end )
+{
+  auto const index = m_nodes.size();
+  m_nodes.push_back( { begin, end, { 0, 0 }, 0.0, -1 } );
+  if( end - begin <= std::max< size_t >( leaf_size, 1 ) )
+  {
+    return index;
+  }
+
+  // Split along the axis of greatest extent
+  vector_t lower = points[ m_indices[ begin ] ];
+  vector_t upper = lower;
+  for( auto i = begin + 1; i < end; ++i )
+  {
+    lower = lower.cwiseMin( points[ m_indices[ i ] ] );
+    upper = upper.cwiseMax( points[ m_indices[ i ] ] );
+  }
+  int axis;
+  ( upper - lower ).maxCoeff( &axis );
+
+  auto const first = m_indices.begin() + begin;
+  auto const middle = m_indices.begin() + ( begin + end ) / 2;
+  std::nth_element( first, middle, m_indices.begin() + end,
+                    [ &points, axis ]( int lhs, int rhs ){
+                      return points[ lhs ][ axis ] < points[ rhs ][ axis ];
+                    } );
+
+  auto const split = points[ *middle ][ axis ];
+  auto const mid = ( begin + end ) / 2;
+  auto const child0 = build_node( points, begin, mid );
+  auto const child1 = build_node( points, mid, end );
+
+  auto& n = m_nodes[ index ];
+  n.children[ 0 ] = child0;
+  n.children[ 1 ] = child1;
+  n.split = split;
+  n.axis = axis;
+  return index;
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree::priv
+::nearest( vector_t const& query, size_t k,
+           std::vector< candidate_t >& result ) const
+{
+  result.clear();
+  if( k && !m_nodes.empty() )
+  {
+    result.reserve( k + 1 );
+    nearest( 0, query, k, result );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree::priv
+::nearest( size_t node_index, vector_t const& query, size_t k,
+           std::vector< candidate_t >& result ) const
+{
+  auto const& n = m_nodes[ node_index ];
+  if( n.axis < 0 )
+  {
+    // Keep the k nearest candidates sorted by distance
+    for( auto i = n.begin; i < n.end; ++i )
+    {
+      candidate_t const c{ ( m_points[ i ] - query ).squaredNorm(), i };
+      if( result.size() < k || c < result.back() )
+      {
+        result.insert(
+          std::upper_bound( result.begin(), result.end(), c ), c );
+        if( result.size() > k )
+        {
+          result.pop_back();
+        }
+      }
+    }
+    return;
+  }
+
+  // Search the side containing the query first, then the other side only if
+  // the splitting plane is nearer than the farthest candidate
+  auto const diff = query[ n.axis ] - n.split;
+  auto const near_side = diff < 0.0 ? 0 : 1;
+  nearest( n.children[ near_side ], query, k, result );
+  if( result.size() < k || diff * diff <= result.back().first )
+  {
+    nearest( n.children[ 1 - near_side ], query, k, result );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree::priv
+::within_radius( vector_t const& query, double r2,
+                 std::vector< candidate_t >& result ) const
+{
+  result.clear();
+  if( !m_nodes.empty() )
+  {
+    within_radius( 0, query, r2, result );
+  }
+  std::sort( result.begin(), result.end() );
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree::priv
+::within_radius( size_t node_index, vector_t const& query, double r2,
+                 std::vector< candidate_t >& result ) const
+{
+  auto const& n = m_nodes[ node_index ];
+  if( n.axis < 0 )
+  {
+    for( auto i = n.begin; i < n.end; ++i )
+    {
+      auto const d2 = ( m_points[ i ] - query ).squaredNorm();
+      if( d2 <= r2 )
+      {
+        result.emplace_back( d2, i );
+      }
+    }
+    return;
+  }
+
+  auto const diff = query[ n.axis ] - n.split;
+  auto const near_side = diff < 0.0 ? 0 : 1;
+  within_radius( n.children[ near_side ], query, r2, result );
+  if( diff * diff <= r2 )
+  {
+    within_radius( n.children[ 1 - near_side ], query, r2, result );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree::priv
+::find_nearest( vital::point_3d const& point, int K,
+                std::vector< int >& indices,
+                std::vector< double >& distances ) const
+{
+  std::vector< candidate_t > candidates;
+  nearest( point.value(), static_cast< size_t >( std::max( K, 0 ) ),
+           candidates );
+
+  indices.clear();
+  distances.clear();
+  indices.reserve( candidates.size() );
+  distances.reserve( candidates.size() );
+  for( auto const& c : candidates )
+  {
+    indices.push_back( m_indices[ c.second ] );
+    distances.push_back( std::sqrt( c.first ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree::priv
+::find_within_radius( vital::point_3d const& point, double r,
+                      std::vector< int >& indices ) const
+{
+  std::vector< candidate_t > candidates;
+  within_radius( point.value(), r * r, candidates );
+
+  indices.clear();
+  indices.reserve( candidates.size() );
+  for( auto const& c : candidates )
+  {
+    indices.push_back( m_indices[ c.second ] );
+  }
+}
+
+// ----------------------------------------------------------------------------
+nearest_neighbors_kd_tree
+::nearest_neighbors_kd_tree()
+  : d{ new priv{} }
+{
+  attach_logger( "arrows.core.nearest_neighbors_kd_tree" );
+}
+
+// ----------------------------------------------------------------------------
+nearest_neighbors_kd_tree
+::~nearest_neighbors_kd_tree()
+{
+}
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+nearest_neighbors_kd_tree
+::get_configuration() const
+{
+  // get base config from base class
+  vital::config_block_sptr config =
+    vital::algo::nearest_neighbors::get_configuration();
+
+  config->set_value( "leaf_size", d->leaf_size,
+                     "Maximum number of points in a leaf of the tree. Larger "
+                     "leaves make the tree faster to build and shallower to "
+                     "search, at the cost of more distance computations." );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree
+::set_configuration( vital::config_block_sptr in_config )
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config( in_config );
+
+  d->leaf_size = config->get_value< size_t >( "leaf_size" );
+}
+
+// ----------------------------------------------------------------------------
+bool
+nearest_neighbors_kd_tree
+::check_configuration( vital::config_block_sptr in_config ) const
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config( in_config );
+
+  if( config->get_value< size_t >( "leaf_size" ) < 1 )
+  {
+    LOG_ERROR( logger(), "leaf_size must be at least 1" );
+    return false;
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree
+::build( std::vector< vital::point_3d >& points ) const
+{
+  d->build( points );
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree
+::find_nearest_point(
+  vital::point_3d& point,
+  int K,
+  std::vector< int >& indices,
+  std::vector< double >& distances ) const
+{
+  if( !d->m_built )
+  {
+    LOG_ERROR( logger(), "The search tree must be built first." );
+    return;
+  }
+  d->find_nearest( point, K, indices, distances );
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree
+::find_nearest_points(
+  std::vector< vital::point_3d >& vec,
+  int K,
+  std::vector< std::vector< int > >& indices,
+  std::vector< std::vector< double > >& distances ) const
+{
+  if( !d->m_built )
+  {
+    LOG_ERROR( logger(), "The search tree must be built first." );
+    return;
+  }
+
+  indices.resize( vec.size() );
+  distances.resize( vec.size() );
+  vital::thread_pool::instance().parallel_for(
+    vec.size(), queries_per_chunk,
+    [ & ]( size_t begin, size_t end ){
+      for( auto i = begin; i < end; ++i )
+      {
+        d->find_nearest( vec[ i ], K, indices[ i ], distances[ i ] );
+      }
+    } );
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree
+::find_within_radius(
+  vital::point_3d& point,
+  double r,
+  std::vector< int >& indices ) const
+{
+  if( !d->m_built )
+  {
+    LOG_ERROR( logger(), "The search tree must be built first." );
+    return;
+  }
+  d->find_within_radius( point, r, indices );
+}
+
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors_kd_tree
+::find_within_radius_points(
+  std::vector< vital::point_3d >& vec,
+  double r,
+  std::vector< std::vector< int > >& indices ) const
+{
+  if( !d->m_built )
+  {
+    LOG_ERROR( logger(), "The search tree must be built first." );
+    return;
+  }
+
+  indices.resize( vec.size() );
+  vital::thread_pool::instance().parallel_for(
+    vec.size(), queries_per_chunk,
+    [ & ]( size_t begin, size_t end ){
+      for( auto i = begin; i < end; ++i )
+      {
+        d->find_within_radius( vec[ i ], r, indices[ i ] );
+      }
+    } );
+}
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
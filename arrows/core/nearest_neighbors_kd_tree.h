@@ -0,0 +1,113 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header defining the core nearest_neighbors_kd_tree algorithm
+
+#ifndef KWIVER_ARROWS_CORE_NEAREST_NEIGHBORS_KD_TREE_H_
+#define KWIVER_ARROWS_CORE_NEAREST_NEIGHBORS_KD_TREE_H_
+
+#include <arrows/core/kwiver_algo_core_export.h>
+
+#include <vital/algo/nearest_neighbors.h>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace core {
+
+/// Find nearest points with a k-d tree, without external dependencies.
+///
+/// The tree is built once over a copy of the points, stored in tree order so
+/// that the points of each leaf are adjacent in memory. Each node is split
+/// at the median of the axis of greatest extent. Queries do not modify the
+/// tree, so the batch queries run in parallel on the vital thread pool.
+///
+/// Nearest points are returned in order of increasing distance, as are points
+/// within a radius. Outputs are replaced, not appended to.
+class KWIVER_ALGO_CORE_EXPORT nearest_neighbors_kd_tree
+  : public vital::algo::nearest_neighbors
+{
+public:
+  PLUGIN_INFO( "kd_tree",
+               "K-d tree search to find nearest points." )
+
+  nearest_neighbors_kd_tree();
+  virtual ~nearest_neighbors_kd_tree();
+
+  /// Get this algorithm's \link vital::config_block configuration block
+  /// \endlink.
+  virtual vital::config_block_sptr get_configuration() const;
+  /// Set this algorithm's properties via a config block.
+  virtual void set_configuration( vital::config_block_sptr config );
+  /// Check that the algorithm's currently configuration is valid.
+  virtual bool check_configuration( vital::config_block_sptr config ) const;
+
+  /// Build the search tree
+  ///
+  /// /param [in] points the set of points to build the search tree from
+  virtual void build( std::vector< vital::point_3d >& points ) const;
+
+  /// Find the K nearest neighbors for target point against
+  /// the points in the search tree.
+  ///
+  /// /param [in] point the point to search against
+  /// /param [in] K the number of nearest points for each point
+  /// /param [out] indices the indices for the K nearest points
+  /// /param [out] distances the distance to each nearest point
+  virtual void find_nearest_point(
+    vital::point_3d& point,
+    int K,
+    std::vector< int >& indices,
+    std::vector< double >& distances ) const;
+
+  /// Find the K nearest neighbors for multiple target points against
+  /// the points in the search tree, in parallel.
+  ///
+  /// /param [in] vec the points to search against
+  /// /param [in] K the number of nearest points for each point
+  /// /param [out] indices the indices for the K nearest points
+  /// /param [out] distances the distance to each nearest point
+  virtual void find_nearest_points(
+    std::vector< vital::point_3d >& vec,
+    int K,
+    std::vector< std::vector< int > >& indices,
+    std::vector< std::vector< double > >& distances ) const;
+
+  /// Find all the nearest neighbors within a radius of a target point
+  /// against the points in the search tree.
+  ///
+  /// /param [in] point the points to search against
+  /// /param [in] r the radius of the sphere to search over
+  /// /param [out] indices the indices for the nearest points
+  virtual void find_within_radius(
+    vital::point_3d& point,
+    double r,
+    std::vector< int >& indices ) const;
+
+  /// Find all the nearest neighbors within a radius of each target point
+  /// against the points in the search tree, in parallel.
+  ///
+  /// /param [in] vec the points to search against
+  /// /param [in] r the radius of the sphere to search over
+  /// /param [out] indices the indices for the nearest points to each point
+  virtual void find_within_radius_points(
+    std::vector< vital::point_3d >& vec,
+    double r,
+    std::vector< std::vector< int > >& indices ) const;
+
+private:
+  class priv;
+
+  std::unique_ptr< priv > const d;
+};
+
+} // namespace core
+
+} // namespace arrows
+
+} // namespace kwiver
+
+#endif
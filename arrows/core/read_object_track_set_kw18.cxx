@@ -9,6 +9,8 @@
 
 #include <vital/util/tokenize.h>
 #include <vital/util/data_stream_reader.h>
+#include <vital/util/mapped_file.h>
+#include <vital/util/text_lines.h>
 #include <vital/vital_config.h>
 
 namespace kwiver {
@@ -64,6 +66,15 @@ class read_object_track_set_kw18::priv
   vital::frame_id_t m_last_idx;
 
   void read_all();
+  bool read_all_mapped();
+  void add_state( vital::frame_id_t frame_index, vital::time_usec_t frame_time,
+                  int track_index, vital::detected_object_sptr const& det );
+
+  // File to map in place of reading the stream, if opened by name
+  std::string m_filename;
+
+  // Track states were last added to
+  vital::track_sptr m_last_track;
 
   // Map of object tracks indexed by frame number. Each set contains all tracks
   // referenced (active) on that individual frame.
@@ -102,6 +113,23 @@ ::check_configuration( VITAL_UNUSED vital::config_block_sptr config ) const
   return true;
 }
 
+// ----------------------------------------------------------------------------
+void
+read_object_track_set_kw18
+::open( std::string const& filename )
+{
+  vital::algo::read_object_track_set::open( filename );
+  d->m_filename = filename;
+}
+
+// ----------------------------------------------------------------------------
+void
+read_object_track_set_kw18
+::new_stream()
+{
+  d->m_filename.clear();
+}
+
 // ----------------------------------------------------------------------------
 bool
 read_object_track_set_kw18
@@ -160,11 +188,17 @@ void
 read_object_track_set_kw18::priv
 ::read_all()
 {
-  std::string line;
-  vital::data_stream_reader stream_reader( m_parent->stream() );
-
   m_tracks_by_frame_id.clear();
   m_all_tracks.clear();
+  m_last_track.reset();
+
+  if( read_all_mapped() )
+  {
+    return;
+  }
+
+  std::string line;
+  vital::data_stream_reader stream_reader( m_parent->stream() );
 
   while( stream_reader.getline( line ) )
   {
@@ -214,32 +248,113 @@ ::read_all()
     vital::detected_object_sptr det =
       std::make_shared< vital::detected_object >( bbox, conf );
 
-    // Create new object track state
-    vital::track_state_sptr ots =
-      std::make_shared< vital::object_track_state >( frame_index, frame_time, det );
+    add_state( frame_index, frame_time, track_index, det );
+  }
+}
 
-    // Assign object track state to track
-    vital::track_sptr trk;
+// ----------------------------------------------------------------------------
+bool
+read_object_track_set_kw18::priv
+::read_all_mapped()
+{
+  vital::mapped_file file;
+  if( m_filename.empty() || !file.open( m_filename ) )
+  {
+    return false;
+  }
 
-    if( m_all_tracks.count( track_index ) == 0 )
-    {
-      trk = vital::track::create();
-      trk->set_id( track_index );
-      m_all_tracks[ track_index ] = trk;
-    }
-    else
+  struct record
+  {
+    vital::frame_id_t frame_index;
+    vital::time_usec_t frame_time;
+    int track_index;
+    vital::detected_object_sptr det;
+  };
+
+  auto const& delim = m_delim;
+  auto const records = vital::parse_data_lines< record >(
+    file.data(), file.data() + file.size(),
+    [ &delim ]( vital::text_span const& line, std::vector< record >& out )
     {
-      trk = m_all_tracks[ track_index ];
-    }
+      thread_local std::vector< vital::text_span > col;
+      col.clear();
+      vital::tokenize_span( line, col, delim, true );
+
+      if( ( col.size() < 18 ) || ( col.size() > 20 ) )
+      {
+        std::stringstream str;
+
+        str << "This is not a kw18 kw19 or kw20 file; found "
+            << col.size() << " columns in\n\"" << line.str() << "\"";
+
+        VITAL_THROW( vital::invalid_data, str.str() );
+      }
+
+      vital::bounding_box_d bbox(
+        vital::span_to_double( col[COL_MIN_X] ),
+        vital::span_to_double( col[COL_MIN_Y] ),
+        vital::span_to_double( col[COL_MAX_X] ),
+        vital::span_to_double( col[COL_MAX_Y] ) );
+
+      double conf = 1.0;
+
+      if( col.size() == 19 )
+      {
+        conf = vital::span_to_double( col[COL_CONFIDENCE] );
+      }
+
+      out.push_back( {
+        static_cast< int >( vital::span_to_integer( col[COL_FRAME] ) ),
+        static_cast< vital::time_usec_t >(
+          vital::span_to_double( col[COL_TIME] ) ),
+        static_cast< int >( vital::span_to_integer( col[COL_ID] ) ),
+        std::make_shared< vital::detected_object >( bbox, conf ) } );
+    } );
+
+  // Build the tracks in file order
+  for( auto const& r : records )
+  {
+    add_state( r.frame_index, r.frame_time, r.track_index, r.det );
+  }
 
-    trk->append( ots );
+  // The whole file has been read, as if from the stream
+  m_parent->stream().setstate( std::ios::eofbit );
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+read_object_track_set_kw18::priv
+::add_state( vital::frame_id_t frame_index, vital::time_usec_t frame_time,
+             int track_index, vital::detected_object_sptr const& det )
+{
+  // Create new object track state
+  vital::track_state_sptr ots =
+    std::make_shared< vital::object_track_state >( frame_index, frame_time, det );
 
-    // Add track to indexes
-    if( !m_batch_load )
+  // Assign object track state to track; the states of a track are usually
+  // on consecutive lines
+  vital::track_sptr trk = m_last_track;
+
+  if( !trk || trk->id() != track_index )
+  {
+    auto& entry = m_all_tracks[ track_index ];
+    if( !entry )
     {
-      m_tracks_by_frame_id[ frame_index ].push_back( trk );
-      m_last_idx = std::max( m_last_idx, frame_index );
+      entry = vital::track::create();
+      entry->set_id( track_index );
     }
+    trk = entry;
+    m_last_track = trk;
+  }
+
+  trk->append( ots );
+
+  // Add track to indexes
+  if( !m_batch_load )
+  {
+    m_tracks_by_frame_id[ frame_index ].push_back( trk );
+    m_last_idx = std::max( m_last_idx, frame_index );
   }
 }
 
@@ -32,9 +32,16 @@ class KWIVER_ALGO_CORE_EXPORT read_object_track_set_kw18
   virtual void set_configuration( vital::config_block_sptr config );
   virtual bool check_configuration( vital::config_block_sptr config ) const;
 
+  /// Open a file of tracks
+  ///
+  /// Files opened by name are memory mapped and parsed in parallel.
+  virtual void open( std::string const& filename );
+
   virtual bool read_set( kwiver::vital::object_track_set_sptr& set );
 
 private:
+  virtual void new_stream();
+
   class priv;
   std::unique_ptr< priv > d;
 };
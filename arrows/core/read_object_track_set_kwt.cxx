@@ -0,0 +1,131 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of read_object_track_set_kwt
+
+#include "read_object_track_set_kwt.h"
+
+#include <vital/io/track_set_io.h>
+#include <vital/vital_config.h>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+// ----------------------------------------------------------------------------
+class read_object_track_set_kwt::priv
+{
+public:
+  bool m_batch_load = true;
+
+  // File to map in place of reading the stream, if opened by name
+  std::string m_filename;
+
+  std::unique_ptr< vital::kwt_reader > m_reader;
+  vital::frame_id_t m_current_idx = 0;
+};
+
+// ----------------------------------------------------------------------------
+read_object_track_set_kwt
+::read_object_track_set_kwt()
+  : d( new read_object_track_set_kwt::priv )
+{
+}
+
+read_object_track_set_kwt
+::~read_object_track_set_kwt()
+{
+}
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+read_object_track_set_kwt
+::get_configuration() const
+{
+  auto config = vital::algorithm::get_configuration();
+
+  config->set_value( "batch_load", d->m_batch_load,
+                     "If true, the first read returns all tracks. Otherwise "
+                     "each read returns the track states of one frame." );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+read_object_track_set_kwt
+::set_configuration( vital::config_block_sptr config )
+{
+  d->m_batch_load = config->get_value< bool >( "batch_load", d->m_batch_load );
+}
+
+// ----------------------------------------------------------------------------
+bool
+read_object_track_set_kwt
+::check_configuration( VITAL_UNUSED vital::config_block_sptr config ) const
+{
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+read_object_track_set_kwt
+::open( std::string const& filename )
+{
+  vital::algo::read_object_track_set::open( filename );
+  d->m_filename = filename;
+}
+
+// ----------------------------------------------------------------------------
+void
+read_object_track_set_kwt
+::new_stream()
+{
+  d->m_filename.clear();
+  d->m_reader.reset();
+  d->m_current_idx = 0;
+}
+
+// ----------------------------------------------------------------------------
+bool
+read_object_track_set_kwt
+::read_set( vital::object_track_set_sptr& set )
+{
+  auto const first = !d->m_reader;
+  if( first )
+  {
+    if( d->m_filename.empty() )
+    {
+      d->m_reader.reset( new vital::kwt_reader( stream() ) );
+    }
+    else
+    {
+      d->m_reader.reset( new vital::kwt_reader( d->m_filename ) );
+    }
+  }
+
+  if( d->m_batch_load )
+  {
+    if( !first )
+    {
+      return false;
+    }
+
+    set = d->m_reader->read_all();
+    return true;
+  }
+
+  auto const& frames = d->m_reader->frames();
+  if( frames.empty() || d->m_current_idx > frames.back() )
+  {
+    return false;
+  }
+
+  set = d->m_reader->read_frame( d->m_current_idx );
+  ++d->m_current_idx;
+  return true;
+}
+
+} } } // end namespace
@@ -0,0 +1,58 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Interface for read_object_track_set_kwt
+
+#ifndef KWIVER_ARROWS_READ_OBJECT_TRACK_SET_KWT_H
+#define KWIVER_ARROWS_READ_OBJECT_TRACK_SET_KWT_H
+
+#include <vital/vital_config.h>
+#include <arrows/core/kwiver_algo_core_export.h>
+
+#include <vital/algo/read_object_track_set.h>
+
+#include <memory>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+/// Reader of object tracks in the compact binary KWT format
+///
+/// With batch_load set, the first read returns all tracks. Otherwise each
+/// read returns the states of one frame, from frame zero to the last frame
+/// with tracks, as tracks with a single state.
+class KWIVER_ALGO_CORE_EXPORT read_object_track_set_kwt
+  : public vital::algo::read_object_track_set
+{
+public:
+  PLUGIN_INFO( "kwt",
+               "Object track set compact binary reader." )
+
+  read_object_track_set_kwt();
+  virtual ~read_object_track_set_kwt();
+
+  virtual vital::config_block_sptr get_configuration() const;
+  virtual void set_configuration( vital::config_block_sptr config );
+  virtual bool check_configuration( vital::config_block_sptr config ) const;
+
+  /// Open a file of tracks
+  ///
+  /// Files opened by name are memory mapped, and only the frames read are
+  /// decoded.
+  virtual void open( std::string const& filename );
+
+  virtual bool read_set( kwiver::vital::object_track_set_sptr& set );
+
+private:
+  virtual void new_stream();
+
+  class priv;
+  std::unique_ptr< priv > d;
+};
+
+} } } // end namespace
+
+#endif // KWIVER_ARROWS_READ_OBJECT_TRACK_SET_KWT_H
@@ -0,0 +1,523 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of the binary track descriptor set reader
+
+#include "read_track_descriptor_set_binary.h"
+
+#include <vital/exceptions/io.h>
+#include <vital/types/compressed_descriptor.h>
+#include <vital/vital_config.h>
+
+#include <kwiversys/SystemTools.hxx>
+
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <cstdint>
+#include <cstring>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+namespace {
+
+// Encodings of the raw descriptor, as written by
+// write_track_descriptor_set_binary
+enum : uint8_t
+{
+  ENCODING_DOUBLE = 0,
+  ENCODING_FLOAT = 1,
+  ENCODING_FLOAT16 = 2,
+  ENCODING_INT8 = 3,
+};
+
+// ----------------------------------------------------------------------------
+/// Bounds checked reading of values from a byte buffer
+class record_reader
+{
+public:
+  record_reader( std::string const& buffer )
+    : m_data( buffer.data() ), m_end( buffer.data() + buffer.size() )
+  {}
+
+  template < typename T >
+  T
+  take()
+  {
+    T value;
+    std::memcpy( &value, bytes( sizeof( T ) ), sizeof( T ) );
+    return value;
+  }
+
+  std::string
+  take_string()
+  {
+    auto const size = take< uint32_t >();
+    return std::string( bytes( size ), size );
+  }
+
+  char const*
+  bytes( size_t count )
+  {
+    if( static_cast< size_t >( m_end - m_data ) < count )
+    {
+      VITAL_THROW( vital::invalid_data,
+                   "Truncated binary track descriptor record" );
+    }
+    auto const result = m_data;
+    m_data += count;
+    return result;
+  }
+
+private:
+  char const* m_data;
+  char const* m_end;
+};
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+class read_track_descriptor_set_binary::priv
+{
+public:
+  priv()
+    : m_batch_load( true )
+    , m_read_raw_descriptor( true )
+    , m_done( false )
+    , m_current_frame( 0 )
+  {}
+
+  struct index_entry
+  {
+    uint64_t offset;
+    int64_t frame;
+    std::string uid;
+  };
+
+  void load_index( std::istream& stream );
+  void scan_records( std::istream& stream, uint64_t size );
+  void add_entry( index_entry entry );
+  vital::track_descriptor_sptr read( std::istream& stream, size_t index );
+  vital::track_descriptor_sptr decode( std::string const& record,
+                                       bool read_raw ) const;
+
+  bool m_batch_load;
+  bool m_read_raw_descriptor;
+
+  std::unique_ptr< std::ifstream > m_file;
+  std::vector< index_entry > m_index;
+  std::unordered_map< std::string, size_t > m_by_uid;
+  std::map< int64_t, std::vector< size_t > > m_by_frame;
+
+  bool m_done;
+  int64_t m_current_frame;
+  std::string m_record;
+};
+
+// ----------------------------------------------------------------------------
+void
+read_track_descriptor_set_binary::priv
+::add_entry( index_entry entry )
+{
+  auto const i = m_index.size();
+  m_by_uid.emplace( entry.uid, i );
+  if( entry.frame >= 0 )
+  {
+    m_by_frame[ entry.frame ].push_back( i );
+  }
+  m_index.push_back( std::move( entry ) );
+}
+
+// ----------------------------------------------------------------------------
+void
+read_track_descriptor_set_binary::priv
+::load_index( std::istream& stream )
+{
+  m_index.clear();
+  m_by_uid.clear();
+  m_by_frame.clear();
+  m_done = false;
+  m_current_frame = 0;
+
+  stream.clear();
+  stream.seekg( 0, std::ios::end );
+  auto const end = stream.tellg();
+  if( end <= 0 )
+  {
+    // An empty stream holds no descriptors
+    return;
+  }
+  uint64_t const size = static_cast< uint64_t >( end );
+
+  char magic[ 8 ];
+  stream.seekg( 0 );
+  if( size < 8 || !stream.read( magic, 8 ) ||
+      std::memcmp( magic, "KWTDSB01", 8 ) != 0 )
+  {
+    VITAL_THROW( vital::invalid_data,
+                 "Not a binary track descriptor file" );
+  }
+
+  // The footer gives the offset of the index; without it, rebuild the index
+  // from the records
+  std::string footer( 16, '\0' );
+  if( size >= 24 )
+  {
+    stream.seekg( size - 16 );
+    stream.read( &footer[ 0 ], 16 );
+  }
+  uint64_t index_offset = 0;
+  std::memcpy( &index_offset, footer.data(), sizeof( index_offset ) );
+  if( footer.compare( 8, 8, "KWTDEND1" ) != 0 ||
+      index_offset < 8 || index_offset > size - 16 )
+  {
+    scan_records( stream, size );
+    return;
+  }
+
+  std::string index( size - 16 - index_offset, '\0' );
+  stream.seekg( index_offset );
+  stream.read( &index[ 0 ], index.size() );
+
+  record_reader reader( index );
+  if( std::memcmp( reader.bytes( 8 ), "KWTDIX01", 8 ) != 0 )
+  {
+    VITAL_THROW( vital::invalid_data,
+                 "Binary track descriptor index not found" );
+  }
+  auto const count = reader.take< uint64_t >();
+  for( uint64_t i = 0; i < count; ++i )
+  {
+    index_entry entry;
+    entry.offset = reader.take< uint64_t >();
+    entry.frame = reader.take< int64_t >();
+    entry.uid = reader.take_string();
+    add_entry( std::move( entry ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+read_track_descriptor_set_binary::priv
+::scan_records( std::istream& stream, uint64_t size )
+{
+  uint64_t offset = 8;
+  stream.clear();
+  stream.seekg( offset );
+
+  uint32_t length;
+  while( offset + sizeof( length ) <= size &&
+         stream.read( reinterpret_cast< char* >( &length ), sizeof( length ) ) &&
+         offset + sizeof( length ) + length <= size )
+  {
+    m_record.resize( length );
+    if( !stream.read( &m_record[ 0 ], length ) )
+    {
+      break;
+    }
+
+    auto const desc = decode( m_record, false );
+    auto const& history = desc->get_history();
+    add_entry( { offset,
+                 history.empty() ? -1 : history.back().get_timestamp().get_frame(),
+                 desc->get_uid().value() } );
+    offset += sizeof( length ) + length;
+  }
+}
+
+// ----------------------------------------------------------------------------
+vital::track_descriptor_sptr
+read_track_descriptor_set_binary::priv
+::read( std::istream& stream, size_t index )
+{
+  uint32_t length;
+  stream.clear();
+  stream.seekg( m_index[ index ].offset );
+  if( !stream.read( reinterpret_cast< char* >( &length ), sizeof( length ) ) )
+  {
+    VITAL_THROW( vital::invalid_data,
+                 "Truncated binary track descriptor record" );
+  }
+  m_record.resize( length );
+  if( !stream.read( &m_record[ 0 ], length ) )
+  {
+    VITAL_THROW( vital::invalid_data,
+                 "Truncated binary track descriptor record" );
+  }
+  return decode( m_record, m_read_raw_descriptor );
+}
+
+// ----------------------------------------------------------------------------
+vital::track_descriptor_sptr
+read_track_descriptor_set_binary::priv
+::decode( std::string const& record, bool read_raw ) const
+{
+  record_reader reader( record );
+
+  auto const uid = reader.take_string();
+  auto desc = vital::track_descriptor::create( reader.take_string() );
+  desc->set_uid( vital::uid( uid ) );
+
+  auto const num_ids = reader.take< uint32_t >();
+  for( uint32_t i = 0; i < num_ids; ++i )
+  {
+    desc->add_track_id( reader.take< uint64_t >() );
+  }
+
+  auto const encoding = reader.take< uint8_t >();
+  auto const size = reader.take< uint32_t >();
+  size_t element_bytes = 0;
+  switch( encoding )
+  {
+    case ENCODING_DOUBLE: element_bytes = sizeof( double ); break;
+    case ENCODING_FLOAT: element_bytes = sizeof( float ); break;
+    case ENCODING_FLOAT16: element_bytes = sizeof( uint16_t ); break;
+    case ENCODING_INT8: element_bytes = sizeof( int8_t ); break;
+    default:
+      VITAL_THROW( vital::invalid_data,
+                   "Unknown binary track descriptor encoding" );
+  }
+  size_t const header_bytes = encoding == ENCODING_INT8 ? 2 * sizeof( float ) : 0;
+  auto const raw = reader.bytes( header_bytes + size * element_bytes );
+
+  if( read_raw )
+  {
+    desc->resize_descriptor( size );
+    double* const out = desc->get_descriptor()->raw_data();
+    switch( encoding )
+    {
+      case ENCODING_DOUBLE:
+        std::memcpy( out, raw, size * sizeof( double ) );
+        break;
+      case ENCODING_FLOAT:
+        for( size_t i = 0; i < size; ++i )
+        {
+          float value;
+          std::memcpy( &value, raw + i * sizeof( float ), sizeof( float ) );
+          out[ i ] = value;
+        }
+        break;
+      case ENCODING_FLOAT16:
+      {
+        std::vector< uint16_t > halves( size );
+        std::memcpy( halves.data(), raw, size * sizeof( uint16_t ) );
+        vital::descriptor_float16( std::move( halves ) ).decode( out );
+        break;
+      }
+      case ENCODING_INT8:
+      {
+        float offset, scale;
+        std::memcpy( &offset, raw, sizeof( float ) );
+        std::memcpy( &scale, raw + sizeof( float ), sizeof( float ) );
+        auto const codes = reinterpret_cast< int8_t const* >( raw + header_bytes );
+        vital::descriptor_int8(
+          offset, scale, std::vector< int8_t >( codes, codes + size ) ).decode( out );
+        break;
+      }
+    }
+  }
+
+  auto const num_history = reader.take< uint32_t >();
+  for( uint32_t i = 0; i < num_history; ++i )
+  {
+    auto const frame = reader.take< int64_t >();
+    auto const time = reader.take< int64_t >();
+    double box[ 8 ];
+    for( auto& v : box )
+    {
+      v = reader.take< double >();
+    }
+    desc->add_history_entry(
+      vital::track_descriptor::history_entry(
+        vital::timestamp( time, frame ),
+        vital::bounding_box_d( box[ 0 ], box[ 1 ], box[ 2 ], box[ 3 ] ),
+        vital::bounding_box_d( box[ 4 ], box[ 5 ], box[ 6 ], box[ 7 ] ) ) );
+  }
+
+  return desc;
+}
+
+// ----------------------------------------------------------------------------
+read_track_descriptor_set_binary
+::read_track_descriptor_set_binary()
+  : d( new read_track_descriptor_set_binary::priv )
+{
+}
+
+read_track_descriptor_set_binary
+::~read_track_descriptor_set_binary()
+{
+}
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+read_track_descriptor_set_binary
+::get_configuration() const
+{
+  auto config = vital::algorithm::get_configuration();
+
+  config->set_value( "batch_load", d->m_batch_load,
+                     "Return every descriptor from the first read_set call, "
+                     "instead of those ending on each frame in turn." );
+  config->set_value( "read_raw_descriptor", d->m_read_raw_descriptor,
+                     "Decode the raw descriptors. If false, descriptors "
+                     "are returned without them." );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+read_track_descriptor_set_binary
+::set_configuration( vital::config_block_sptr config_in )
+{
+  auto config = this->get_configuration();
+  config->merge_config( config_in );
+
+  d->m_batch_load = config->get_value< bool >( "batch_load" );
+  d->m_read_raw_descriptor = config->get_value< bool >( "read_raw_descriptor" );
+}
+
+// ----------------------------------------------------------------------------
+bool
+read_track_descriptor_set_binary
+::check_configuration( VITAL_UNUSED vital::config_block_sptr config ) const
+{
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+read_track_descriptor_set_binary
+::open( std::string const& filename )
+{
+  this->close();
+
+  if( !kwiversys::SystemTools::FileExists( filename ) )
+  {
+    VITAL_THROW( vital::path_not_exists, filename );
+  }
+  if( kwiversys::SystemTools::FileIsDirectory( filename ) )
+  {
+    VITAL_THROW( vital::path_not_a_file, filename );
+  }
+
+  std::unique_ptr< std::ifstream > file(
+    new std::ifstream( filename, std::ios::in | std::ios::binary ) );
+  if( !*file )
+  {
+    VITAL_THROW( vital::file_not_found_exception, filename, "open failed" );
+  }
+
+  d->m_file = std::move( file );
+  try
+  {
+    this->use_stream( d->m_file.get() );
+  }
+  catch( vital::invalid_data const& e )
+  {
+    this->close();
+    VITAL_THROW( vital::invalid_file, filename, e.what() );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+read_track_descriptor_set_binary
+::close()
+{
+  vital::algo::read_track_descriptor_set::close();
+  d->m_file.reset();
+  d->m_index.clear();
+  d->m_by_uid.clear();
+  d->m_by_frame.clear();
+}
+
+// ----------------------------------------------------------------------------
+void
+read_track_descriptor_set_binary
+::new_stream()
+{
+  d->load_index( stream() );
+}
+
+// ----------------------------------------------------------------------------
+bool
+read_track_descriptor_set_binary
+::read_set( kwiver::vital::track_descriptor_set_sptr& set )
+{
+  vital::track_descriptor_set descs;
+
+  if( d->m_batch_load )
+  {
+    if( d->m_done )
+    {
+      return false;
+    }
+    for( size_t i = 0; i < d->m_index.size(); ++i )
+    {
+      descs.push_back( d->read( stream(), i ) );
+    }
+    d->m_done = true;
+  }
+  else
+  {
+    if( d->m_by_frame.empty() ||
+        d->m_current_frame > d->m_by_frame.rbegin()->first )
+    {
+      return false;
+    }
+    auto const it = d->m_by_frame.find( d->m_current_frame++ );
+    if( it != d->m_by_frame.end() )
+    {
+      for( auto const i : it->second )
+      {
+        descs.push_back( d->read( stream(), i ) );
+      }
+    }
+  }
+
+  set = std::make_shared< vital::track_descriptor_set >( std::move( descs ) );
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+read_track_descriptor_set_binary
+::num_descriptors() const
+{
+  return d->m_index.size();
+}
+
+// ----------------------------------------------------------------------------
+vital::track_descriptor_sptr
+read_track_descriptor_set_binary
+::read_descriptor( size_t index )
+{
+  if( index >= d->m_index.size() )
+  {
+    throw std::out_of_range( std::to_string( index ) );
+  }
+  return d->read( stream(), index );
+}
+
+// ----------------------------------------------------------------------------
+vital::track_descriptor_sptr
+read_track_descriptor_set_binary
+::find_descriptor( vital::uid const& uid )
+{
+  auto const it = d->m_by_uid.find( uid.value() );
+  if( it == d->m_by_uid.end() )
+  {
+    return nullptr;
+  }
+  return d->read( stream(), it->second );
+}
+
+} } } // end namespace
@@ -0,0 +1,83 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Interface for read_track_descriptor_set_binary
+
+#ifndef KWIVER_ARROWS_READ_TRACK_DESCRIPTOR_SET_BINARY_H
+#define KWIVER_ARROWS_READ_TRACK_DESCRIPTOR_SET_BINARY_H
+
+#include <arrows/core/kwiver_algo_core_export.h>
+
+#include <vital/algo/read_track_descriptor_set.h>
+#include <vital/types/uid.h>
+
+#include <memory>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+/// Track descriptor set reader for the format of
+/// write_track_descriptor_set_binary
+///
+/// Only the index is read when a file is opened; descriptors are read when
+/// requested, either all at once, by the frame of their last history entry,
+/// or individually by position or uid. A file without an index, such as one
+/// whose writer was not closed, is scanned to rebuild it. Raw descriptors are
+/// decoded to doubles.
+class KWIVER_ALGO_CORE_EXPORT read_track_descriptor_set_binary
+  : public vital::algo::read_track_descriptor_set
+{
+public:
+  PLUGIN_INFO( "binary",
+               "Track descriptor set reader for an indexed binary format." )
+
+  read_track_descriptor_set_binary();
+  virtual ~read_track_descriptor_set_binary();
+
+  virtual vital::config_block_sptr get_configuration() const;
+  virtual void set_configuration( vital::config_block_sptr config );
+  virtual bool check_configuration( vital::config_block_sptr config ) const;
+
+  /// Open a file for reading in binary mode
+  ///
+  /// \throws path_not_exists, path_not_a_file, file_not_found_exception
+  ///         as for the base class.
+  /// \throws invalid_file If the file is not in the binary format.
+  virtual void open( std::string const& filename );
+
+  virtual void close();
+
+  /// Read the descriptors of the file
+  ///
+  /// With batch_load, the first call returns every descriptor and later
+  /// calls return false. Otherwise, each call returns the descriptors whose
+  /// last history entry is on the next frame, starting from frame 0, until
+  /// the last such frame has been returned.
+  virtual bool read_set( kwiver::vital::track_descriptor_set_sptr& set );
+
+  /// The number of descriptors in the file
+  size_t num_descriptors() const;
+
+  /// Read the descriptor at position \p index of the file
+  ///
+  /// \throws std::out_of_range If \p index is not less than
+  ///                           num_descriptors().
+  vital::track_descriptor_sptr read_descriptor( size_t index );
+
+  /// Read the descriptor with the given uid, or return null if there is none
+  vital::track_descriptor_sptr find_descriptor( vital::uid const& uid );
+
+protected:
+  virtual void new_stream();
+
+private:
+  class priv;
+  std::unique_ptr< priv > d;
+};
+
+} } } // end namespace
+
+#endif // KWIVER_ARROWS_READ_TRACK_DESCRIPTOR_SET_BINARY_H
@@ -9,6 +9,7 @@
 
 #include <vital/algo/algorithm_factory.h>
 
+#include <arrows/core/associate_detections_to_tracks_optimal.h>
 #include <arrows/core/associate_detections_to_tracks_threshold.h>
 #include <arrows/core/class_probablity_filter.h>
 #include <arrows/core/close_loops_bad_frames_only.h>
@@ -21,6 +22,7 @@
 #include <arrows/core/convert_image_bypass.h>
 #include <arrows/core/create_detection_grid.h>
 #include <arrows/core/derive_metadata.h>
+#include <arrows/core/descriptor_index_hnsw.h>
 #include <arrows/core/detect_features_filtered.h>
 #include <arrows/core/detected_object_set_input_csv.h>
 #include <arrows/core/detected_object_set_input_kw18.h>
@@ -36,13 +38,19 @@
 #include <arrows/core/filter_features_scale.h>
 #include <arrows/core/filter_tracks.h>
 #include <arrows/core/handle_descriptor_request_core.h>
+#include <arrows/core/image_filter_tiled.h>
+#include <arrows/core/image_object_detector_tiled.h>
 #include <arrows/core/initialize_object_tracks_threshold.h>
 #include <arrows/core/interpolate_track_spline.h>
 #include <arrows/core/keyframe_selector_basic.h>
+#include <arrows/core/match_features_bruteforce.h>
 #include <arrows/core/match_features_fundamental_matrix.h>
 #include <arrows/core/match_features_homography.h>
 #include <arrows/core/metadata_map_io_csv.h>
+#include <arrows/core/nearest_neighbors_kd_tree.h>
 #include <arrows/core/read_object_track_set_kw18.h>
+#include <arrows/core/read_object_track_set_kwt.h>
+#include <arrows/core/read_track_descriptor_set_binary.h>
 #include <arrows/core/read_track_descriptor_set_csv.h>
 #include <arrows/core/track_features_augment_keyframes.h>
 #include <arrows/core/track_features_core.h>
@@ -53,9 +61,12 @@
 #include <arrows/core/video_input_image_list.h>
 #include <arrows/core/video_input_metadata_filter.h>
 #include <arrows/core/video_input_pos.h>
+#include <arrows/core/video_input_segmented.h>
 #include <arrows/core/video_input_splice.h>
 #include <arrows/core/video_input_split.h>
 #include <arrows/core/write_object_track_set_kw18.h>
+#include <arrows/core/write_object_track_set_kwt.h>
+#include <arrows/core/write_track_descriptor_set_binary.h>
 #include <arrows/core/write_track_descriptor_set_csv.h>
 
 namespace kwiver {
@@ -75,6 +86,7 @@ register_factories( kwiver::vital::plugin_loader& vpm )
     return;
   }
 
+  reg.register_algorithm< associate_detections_to_tracks_optimal >();
   reg.register_algorithm< associate_detections_to_tracks_threshold >();
   reg.register_algorithm< class_probablity_filter >();
   reg.register_algorithm< close_loops_appearance_indexed >();
@@ -87,6 +99,7 @@ register_factories( kwiver::vital::plugin_loader& vpm )
   reg.register_algorithm< convert_image_bypass >();
   reg.register_algorithm< create_detection_grid >();
   reg.register_algorithm< derive_metadata >();
+  reg.register_algorithm< descriptor_index_hnsw >();
   reg.register_algorithm< detect_features_filtered >();
   reg.register_algorithm< detected_object_set_input_csv >();
   reg.register_algorithm< detected_object_set_input_kw18 >();
@@ -102,13 +115,19 @@ register_factories( kwiver::vital::plugin_loader& vpm )
   reg.register_algorithm< filter_features_scale >();
   reg.register_algorithm< filter_tracks >();
   reg.register_algorithm< handle_descriptor_request_core >();
+  reg.register_algorithm< image_filter_tiled >();
+  reg.register_algorithm< image_object_detector_tiled >();
   reg.register_algorithm< initialize_object_tracks_threshold >();
   reg.register_algorithm< interpolate_track_spline >();
   reg.register_algorithm< keyframe_selector_basic >();
+  reg.register_algorithm< match_features_bruteforce >();
   reg.register_algorithm< match_features_fundamental_matrix >();
   reg.register_algorithm< match_features_homography >();
   reg.register_algorithm< metadata_map_io_csv >();
+  reg.register_algorithm< nearest_neighbors_kd_tree >();
   reg.register_algorithm< read_object_track_set_kw18 >();
+  reg.register_algorithm< read_object_track_set_kwt >();
+  reg.register_algorithm< read_track_descriptor_set_binary >();
   reg.register_algorithm< read_track_descriptor_set_csv >();
   reg.register_algorithm< track_features_augment_keyframes >();
   reg.register_algorithm< track_features_core >();
@@ -119,9 +138,12 @@ register_factories( kwiver::vital::plugin_loader& vpm )
   reg.register_algorithm< video_input_image_list >();
   reg.register_algorithm< video_input_metadata_filter >();
   reg.register_algorithm< video_input_pos >();
+  reg.register_algorithm< video_input_segmented >();
   reg.register_algorithm< video_input_splice >();
   reg.register_algorithm< video_input_split >();
   reg.register_algorithm< write_object_track_set_kw18 >();
+  reg.register_algorithm< write_object_track_set_kwt >();
+  reg.register_algorithm< write_track_descriptor_set_binary >();
   reg.register_algorithm< write_track_descriptor_set_csv >();
 
   reg.mark_module_as_loaded();
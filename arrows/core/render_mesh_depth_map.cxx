@@ -10,60 +10,236 @@
 #include <vital/types/camera_perspective.h>
 #include <vital/types/image.h>
 #include <vital/types/vector.h>
+#include <vital/util/thread_pool.h>
 #include <vital/util/transform_image.h>
+
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 namespace kwiver {
 namespace arrows {
 namespace core {
 
+namespace {
+
+// Width and height in pixels of the tiles into which images are divided
+constexpr int tile_size = 64;
+
+// Number of vertices projected by a thread at a time
+constexpr size_t vertices_per_chunk = 4096;
+
+// The triangles of a mesh seen in one image, sorted into tiles of the image,
+// and the image of the minimum of a value interpolated over them
+struct tiled_raster
+{
+  std::vector<vital::vector_2d> points;
+  std::vector<double> values;
+  // Indices of the triangles overlapping each tile, in mesh order
+  std::vector<std::vector<unsigned>> bins;
+  unsigned tiles_x = 0;
+  vital::image_of<double> image;
+};
+
+// Prepare a raster of the given size filled with infinity
+void init_raster(tiled_raster& raster, size_t width, size_t height)
+{
+  raster.image.set_size(width, height, 1);
+  transform_image(raster.image, [](double){ return std::numeric_limits<double>::infinity(); } );
+  raster.tiles_x = static_cast<unsigned>((width + tile_size - 1) / tile_size);
+  auto const tiles_y = (height + tile_size - 1) / tile_size;
+  raster.bins.assign(raster.tiles_x * tiles_y, {});
+}
+
+// Add each triangle to the bins of the tiles its bounding box overlaps,
+// skipping those for which skip(triangle) is true
+template <typename Skip>
+void bin_triangles(tiled_raster& raster,
+                   vital::mesh_regular_face_array<3> const& triangles,
+                   Skip const& skip)
+{
+  int const width = static_cast<int>(raster.image.width());
+  int const height = static_cast<int>(raster.image.height());
+  for (unsigned f = 0; f < triangles.size(); ++f)
+  {
+    auto const& tri = triangles[f];
+    if (skip(tri))
+    {
+      continue;
+    }
+
+    vital::vector_2d const& v1 = raster.points[tri[0]];
+    vital::vector_2d const& v2 = raster.points[tri[1]];
+    vital::vector_2d const& v3 = raster.points[tri[2]];
+    vital::vector_2d const lower = v1.cwiseMin(v2).cwiseMin(v3);
+    vital::vector_2d const upper = v1.cwiseMax(v2).cwiseMax(v3);
+    // also skips triangles with a vertex that did not project
+    if (!(upper.x() >= 0.0 && upper.y() >= 0.0 &&
+          lower.x() < width && lower.y() < height))
+    {
+      continue;
+    }
+
+    // pad by a pixel so that rounding in the scan iterator never reaches
+    // outside the tiles the triangle is binned in
+    int const x0 = static_cast<int>(std::max(0.0, std::floor(lower.x()) - 1.0)) / tile_size;
+    int const y0 = static_cast<int>(std::max(0.0, std::floor(lower.y()) - 1.0)) / tile_size;
+    int const x1 = static_cast<int>(std::min(width - 1.0, std::ceil(upper.x()) + 1.0)) / tile_size;
+    int const y1 = static_cast<int>(std::min(height - 1.0, std::ceil(upper.y()) + 1.0)) / tile_size;
+    for (int ty = y0; ty <= y1; ++ty)
+    {
+      for (int tx = x0; tx <= x1; ++tx)
+      {
+        raster.bins[ty * raster.tiles_x + tx].push_back(f);
+      }
+    }
+  }
+}
+
+// Render the triangles of one tile into the pixels of that tile only, so that
+// distinct tiles may be rendered concurrently
+void render_tile(tiled_raster& raster,
+                 vital::mesh_regular_face_array<3> const& triangles,
+                 size_t tile)
+{
+  auto& img = raster.image;
+  int const x_begin = static_cast<int>(tile % raster.tiles_x) * tile_size;
+  int const y_begin = static_cast<int>(tile / raster.tiles_x) * tile_size;
+  int const x_end = std::min(x_begin + tile_size, static_cast<int>(img.width()));
+  int const y_end = std::min(y_begin + tile_size, static_cast<int>(img.height()));
+
+  for (auto const f : raster.bins[tile])
+  {
+    auto const& tri = triangles[f];
+    vital::vector_2d const& v1 = raster.points[tri[0]];
+    vital::vector_2d const& v2 = raster.points[tri[1]];
+    vital::vector_2d const& v3 = raster.points[tri[2]];
+
+    // interpolate over the whole triangle as render_triangle() does, so that
+    // pixels get the same values however the image is tiled
+    triangle_scan_iterator tsi(v1, v2, v3);
+    auto Vd = triangle_attribute_vector(v1, v2, v3, raster.values[tri[0]],
+                                        raster.values[tri[1]], raster.values[tri[2]]);
+    for (tsi.reset(); tsi.next(); )
+    {
+      int y = tsi.scan_y();
+      if (y < y_begin || y >= y_end)
+        continue;
+      int min_x = std::max(x_begin, tsi.start_x());
+      int max_x = std::min(x_end - 1, tsi.end_x());
+
+      double new_i = Vd.y() * y + Vd.z();
+      for (int x = min_x; x <= max_x; ++x)
+      {
+        double value = new_i + Vd.x() * x;
+        if (value < img(x, y))
+        {
+          img(x, y) = value;
+        }
+      }
+    }
+  }
+}
+
+// Render the tiles of all rasters together on the thread pool
+void render_rasters(std::vector<tiled_raster>& rasters,
+                    vital::mesh_regular_face_array<3> const& triangles)
+{
+  std::vector<size_t> first_tile(rasters.size() + 1, 0);
+  for (size_t i = 0; i < rasters.size(); ++i)
+  {
+    first_tile[i + 1] = first_tile[i] + rasters[i].bins.size();
+  }
+
+  vital::thread_pool::instance().parallel_for(first_tile.back(), 1,
+    [&](size_t begin, size_t end)
+    {
+      for (auto t = begin; t < end; ++t)
+      {
+        auto const r = static_cast<size_t>(
+          std::upper_bound(first_tile.begin(), first_tile.end(), t) - first_tile.begin()) - 1;
+        render_tile(rasters[r], triangles, t - first_tile[r]);
+      }
+    } );
+}
+
+} // end anonymous namespace
+
 /// This function renders a depth map of a triangular mesh seen by a camera
 vital::image_container_sptr render_mesh_depth_map(vital::mesh_sptr mesh, vital::camera_perspective_sptr camera)
+{
+  return render_mesh_depth_maps(mesh, { camera }).front();
+}
+
+/// This function renders depth maps of a triangular mesh seen by several cameras
+std::vector<vital::image_container_sptr>
+render_mesh_depth_maps(vital::mesh_sptr mesh,
+                       std::vector<vital::camera_perspective_sptr> const& cameras)
 {
   vital::mesh_vertex_array<3>& vertices = dynamic_cast< vital::mesh_vertex_array<3>& >(mesh->vertices());
 
-  std::vector<vital::vector_2d> points_2d(vertices.size());
-  std::vector<double> depths(vertices.size());
-  for (unsigned int i = 0; i < vertices.size(); ++i)
+  std::vector<tiled_raster> rasters(cameras.size());
+  for (size_t c = 0; c < cameras.size(); ++c)
   {
-    points_2d[i] = camera->project(vertices[i]);
-    depths[i] = camera->depth(vertices[i]);
+    init_raster(rasters[c], cameras[c]->image_width(), cameras[c]->image_height());
   }
 
-  vital::image_of<double> zbuffer(camera->image_width(), camera->image_height(), 1);
-  // fill each pixel with infinity
-  transform_image(zbuffer, [](double){ return std::numeric_limits<double>::infinity(); } );
-
   if (mesh->faces().regularity() == 3)
   {
     auto const& triangles = static_cast< const vital::mesh_regular_face_array<3>& >(mesh->faces());
-    for (auto const& tri : triangles)
-    {
-      double const& d1 = depths[tri[0]];
-      double const& d2 = depths[tri[1]];
-      double const& d3 = depths[tri[2]];
-      // for now, skip any triangle that is even partly behind the camera
-      // TODO clip triangles that are partly behind the camera
-      if (d1 <= 0.0 || d2 <= 0.0 || d3 <= 0.0)
+
+    // project the mesh into each camera and sort its triangles into tiles
+    vital::thread_pool::instance().parallel_for(cameras.size(), 1,
+      [&](size_t begin, size_t end)
       {
-        continue;
-      }
+        for (auto c = begin; c < end; ++c)
+        {
+          auto const& camera = cameras[c];
+          auto& raster = rasters[c];
+          std::vector<double> depths(vertices.size());
+          raster.points.resize(vertices.size());
+          vital::thread_pool::instance().parallel_for(vertices.size(), vertices_per_chunk,
+            [&](size_t v_begin, size_t v_end)
+            {
+              for (auto i = v_begin; i < v_end; ++i)
+              {
+                raster.points[i] = camera->project(vertices[i]);
+                depths[i] = camera->depth(vertices[i]);
+              }
+            } );
 
-      vital::vector_2d const& v1 = points_2d[tri[0]];
-      vital::vector_2d const& v2 = points_2d[tri[1]];
-      vital::vector_2d const& v3 = points_2d[tri[2]];
+          // for now, skip any triangle that is even partly behind the camera
+          // TODO clip triangles that are partly behind the camera
+          bin_triangles(raster, triangles,
+            [&depths](vital::mesh_regular_face<3> const& tri)
+            {
+              return depths[tri[0]] <= 0.0 || depths[tri[1]] <= 0.0 || depths[tri[2]] <= 0.0;
+            } );
 
-      render_triangle(v1, v2, v3,
-                      -1.0 / d1, -1.0 / d2, -1.0 / d3,
-                      zbuffer);
-    }
-    transform_image(zbuffer, [](double d){ return std::isinf(d) ? d : (-1.0 / d); } );
+          // render inverse depth, which is linear in image space
+          raster.values.resize(vertices.size());
+          for (size_t i = 0; i < depths.size(); ++i)
+          {
+            raster.values[i] = -1.0 / depths[i];
+          }
+        }
+      } );
+
+    render_rasters(rasters, triangles);
   }
   else
   {
     LOG_ERROR(vital::get_logger("arrows.core.render_mesh_depth_map" ), "The mesh has to be triangular.");
   }
-  return std::make_shared<vital::simple_image_container>(zbuffer);
+
+  std::vector<vital::image_container_sptr> depth_maps;
+  depth_maps.reserve(rasters.size());
+  for (auto& raster : rasters)
+  {
+    transform_image(raster.image, [](double d){ return std::isinf(d) ? d : (-1.0 / d); } );
+    depth_maps.push_back(std::make_shared<vital::simple_image_container>(raster.image));
+  }
+  return depth_maps;
 }
 
 /// This function renders a height map of a triangular mesh
@@ -87,26 +263,26 @@ vital::image_container_sptr render_mesh_height_map(vital::mesh_sptr mesh, vital:
     {
       vital::mesh_vertex_array<3>& vertices = dynamic_cast< vital::mesh_vertex_array<3>& >(mesh->vertices());
 
-      std::vector<vital::vector_2d> points_2d(vertices.size());
-      for (unsigned int i = 0; i < vertices.size(); ++i)
-      {
-        points_2d[i] = camera->project(vertices[i]);
-      }
+      std::vector<tiled_raster> rasters(1);
+      auto& raster = rasters.front();
+      init_raster(raster, camera->image_width(), camera->image_height());
+      raster.points.resize(vertices.size());
+      raster.values.resize(vertices.size());
+      vital::thread_pool::instance().parallel_for(vertices.size(), vertices_per_chunk,
+        [&](size_t begin, size_t end)
+        {
+          for (auto i = begin; i < end; ++i)
+          {
+            raster.points[i] = camera->project(vertices[i]);
+            raster.values[i] = -vertices[i](2);
+          }
+        } );
 
       auto const& triangles = static_cast< const vital::mesh_regular_face_array<3>& >(mesh->faces());
-      double h1, h2, h3;
-      for (unsigned int f = 0; f < triangles.size(); ++f)
-      {
-        vital::vector_2d& v1 = points_2d[triangles(f, 0)];
-        vital::vector_2d& v2 = points_2d[triangles(f, 1)];
-        vital::vector_2d& v3 = points_2d[triangles(f, 2)];
+      bin_triangles(raster, triangles, [](vital::mesh_regular_face<3> const&){ return false; } );
+      render_rasters(rasters, triangles);
 
-        h1 = -vertices[triangles(f, 0)](2);
-        h2 = -vertices[triangles(f, 1)](2);
-        h3 = -vertices[triangles(f, 2)](2);
-
-        render_triangle(v1, v2, v3, h1, h2, h3, height_map);
-      }
+      height_map = raster.image;
       transform_image(height_map, [](double h){ return std::isinf(h) ? h : -h; } );
     }
   }
@@ -15,6 +15,8 @@
 #include <vital/types/image_container.h>
 #include <vital/types/mesh.h>
 
+#include <vector>
+
 namespace kwiver {
 namespace arrows {
 namespace core {
@@ -28,6 +30,21 @@ KWIVER_ALGO_CORE_EXPORT
 vital::image_container_sptr render_mesh_depth_map(kwiver::vital::mesh_sptr mesh,
                                                   kwiver::vital::camera_perspective_sptr camera);
 
+/// This function renders depth maps of a triangular mesh seen by several cameras
+///
+/// The mesh is projected into each camera and its triangles are sorted into
+/// tiles of the image. The tiles of all images are then rendered together in
+/// parallel on the vital thread pool. Each depth map is the same as
+/// render_mesh_depth_map() would render for its camera.
+///
+/// \param mesh [in]
+/// \param cameras [in]
+/// \return a depth map for each camera
+KWIVER_ALGO_CORE_EXPORT
+std::vector<vital::image_container_sptr>
+render_mesh_depth_maps(kwiver::vital::mesh_sptr mesh,
+                       std::vector<kwiver::vital::camera_perspective_sptr> const& cameras);
+
 /// This function renders a height map of a triangular mesh
 ///
 /// \param mesh [in]
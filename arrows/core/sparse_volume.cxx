@@ -0,0 +1,237 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of a sparse volume of voxel bricks
+
+#include "sparse_volume.h"
+
+#include <vital/types/undistortion_grid.h>
+#include <vital/util/thread_pool.h>
+#include <vital/util/transform_image.h>
+
+#include <algorithm>
+#include <mutex>
+
+#include <cmath>
+
+using namespace kwiver::vital;
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+namespace {
+
+// Number of bits of each brick coordinate in a brick key
+constexpr unsigned key_bits = 21;
+
+// Number of depth map rows handed to a thread at a time
+constexpr size_t rows_per_chunk = 8;
+
+using brick_coords_t = std::array< size_t, 3 >;
+
+} // end anonymous namespace
+
+constexpr size_t sparse_volume::npos;
+
+// ----------------------------------------------------------------------------
+sparse_volume
+::sparse_volume( size_t ni, size_t nj, size_t nk, unsigned brick_size )
+{
+  reset( ni, nj, nk, brick_size );
+}
+
+// ----------------------------------------------------------------------------
+void
+sparse_volume
+::reset( size_t ni, size_t nj, size_t nk, unsigned brick_size )
+{
+  m_dims = { { ni, nj, nk } };
+  m_brick_size = std::max( brick_size, 1u );
+  m_index.clear();
+  m_origins.clear();
+  m_data.clear();
+}
+
+// ----------------------------------------------------------------------------
+uint64_t
+sparse_volume
+::key( size_t bi, size_t bj, size_t bk ) const
+{
+  return static_cast< uint64_t >( bi ) |
+         ( static_cast< uint64_t >( bj ) << key_bits ) |
+         ( static_cast< uint64_t >( bk ) << ( 2 * key_bits ) );
+}
+
+// ----------------------------------------------------------------------------
+size_t
+sparse_volume
+::allocate_brick( size_t bi, size_t bj, size_t bk )
+{
+  auto const result = m_index.emplace( key( bi, bj, bk ), m_origins.size() );
+  if( result.second )
+  {
+    m_origins.push_back( { { bi * m_brick_size,
+                             bj * m_brick_size,
+                             bk * m_brick_size } } );
+    m_data.resize( m_data.size() + brick_voxels(), 0.0 );
+  }
+  return result.first->second;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+sparse_volume
+::find_brick( size_t bi, size_t bj, size_t bk ) const
+{
+  auto const it = m_index.find( key( bi, bj, bk ) );
+  return it == m_index.end() ? npos : it->second;
+}
+
+// ----------------------------------------------------------------------------
+bool
+sparse_volume
+::is_allocated( size_t i, size_t j, size_t k ) const
+{
+  return find_brick( i / m_brick_size, j / m_brick_size,
+                     k / m_brick_size ) != npos;
+}
+
+// ----------------------------------------------------------------------------
+double
+sparse_volume
+::value( size_t i, size_t j, size_t k, double background ) const
+{
+  auto const b = find_brick( i / m_brick_size, j / m_brick_size,
+                             k / m_brick_size );
+  if( b == npos )
+  {
+    return background;
+  }
+
+  auto const& o = m_origins[ b ];
+  return brick_data( b )[ ( ( k - o[ 2 ] ) * m_brick_size +
+                            ( j - o[ 1 ] ) ) * m_brick_size + ( i - o[ 0 ] ) ];
+}
+
+// ----------------------------------------------------------------------------
+image_of< double >
+sparse_volume
+::to_image( double background ) const
+{
+  image_of< double > result( m_dims[ 0 ], m_dims[ 1 ], m_dims[ 2 ] );
+  transform_image( result, [ background ]( double ){ return background; } );
+
+  for( size_t b = 0; b < m_origins.size(); ++b )
+  {
+    auto const& o = m_origins[ b ];
+    auto const ni = std::min< size_t >( m_brick_size, m_dims[ 0 ] - o[ 0 ] );
+    auto const nj = std::min< size_t >( m_brick_size, m_dims[ 1 ] - o[ 1 ] );
+    auto const nk = std::min< size_t >( m_brick_size, m_dims[ 2 ] - o[ 2 ] );
+    auto const* voxel = brick_data( b );
+    for( size_t k = 0; k < nk; ++k )
+    {
+      for( size_t j = 0; j < nj; ++j )
+      {
+        auto const* row = voxel + ( k * m_brick_size + j ) * m_brick_size;
+        for( size_t i = 0; i < ni; ++i )
+        {
+          result( o[ 0 ] + i, o[ 1 ] + j, o[ 2 ] + k ) = row[ i ];
+        }
+      }
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+void
+allocate_surface_bricks( sparse_volume& volume,
+                         camera_perspective const& camera,
+                         image_of< double > const& depth,
+                         image_of< double > const& weight,
+                         vector_3d const& origin,
+                         vector_3d const& spacing,
+                         double band )
+{
+  auto const brick_size = static_cast< double >( volume.brick_size() );
+  vector_3d const brick_extent = brick_size * spacing;
+  Eigen::Array< double, 3, 1 > const num_bricks{
+    std::ceil( volume.width() / brick_size ),
+    std::ceil( volume.height() / brick_size ),
+    std::ceil( volume.depth() / brick_size ) };
+
+  // march in steps of half a brick so that no brick along a ray is skipped
+  // by more than a corner
+  double const step = 0.5 * brick_extent.minCoeff();
+  auto const undistortion = cached_undistortion_grid( camera.intrinsics() );
+  auto const R_inv = camera.rotation().inverse();
+  vector_3d const center = camera.center();
+  bool const weighted = weight.size() > 0;
+
+  std::mutex mutex;
+  std::vector< brick_coords_t > bricks;
+  thread_pool::instance().parallel_for(
+    depth.height(), rows_per_chunk,
+    [ & ]( size_t begin, size_t end ){
+      std::vector< brick_coords_t > found;
+      for( auto v = begin; v < end; ++v )
+      {
+        for( size_t u = 0; u < depth.width(); ++u )
+        {
+          double const d = depth( u, v );
+          if( !( d > 0.0 ) || !std::isfinite( d ) ||
+              ( weighted && !( weight( u, v ) > 0.0 ) ) )
+          {
+            continue;
+          }
+
+          // world displacement per unit of camera depth along the ray
+          vector_2d const n = undistortion->unmap( vector_2d( u, v ) );
+          vector_3d const dir = R_inv * vector_3d( n.x(), n.y(), 1.0 );
+          double const ds = step / dir.norm();
+          double const s_end = d + band;
+          for( double s = std::max( d - band, 0.0 ); ; s += ds )
+          {
+            s = std::min( s, s_end );
+            Eigen::Array< double, 3, 1 > const b =
+              ( ( center + s * dir - origin ).array() /
+                brick_extent.array() ).floor();
+            if( ( b >= 0.0 ).all() && ( b < num_bricks ).all() )
+            {
+              brick_coords_t const coords{ {
+                static_cast< size_t >( b[ 0 ] ),
+                static_cast< size_t >( b[ 1 ] ),
+                static_cast< size_t >( b[ 2 ] ) } };
+              if( found.empty() || found.back() != coords )
+              {
+                found.push_back( coords );
+              }
+            }
+            if( s >= s_end )
+            {
+              break;
+            }
+          }
+        }
+      }
+
+      std::sort( found.begin(), found.end() );
+      found.erase( std::unique( found.begin(), found.end() ), found.end() );
+      std::lock_guard< std::mutex > lock( mutex );
+      bricks.insert( bricks.end(), found.begin(), found.end() );
+    } );
+
+  // allocate in a fixed order so that brick indices do not depend on threads
+  std::sort( bricks.begin(), bricks.end() );
+  for( auto const& b : bricks )
+  {
+    volume.allocate_brick( b[ 0 ], b[ 1 ], b[ 2 ] );
+  }
+}
+
+} // end namespace core
+} // end namespace arrows
+} // end namespace kwiver
@@ -0,0 +1,151 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header for a sparse volume of voxel bricks
+
+#ifndef KWIVER_ARROWS_CORE_SPARSE_VOLUME_H_
+#define KWIVER_ARROWS_CORE_SPARSE_VOLUME_H_
+
+#include <arrows/core/kwiver_algo_core_export.h>
+
+#include <vital/types/camera_perspective.h>
+#include <vital/types/image.h>
+#include <vital/types/vector.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+/// A volume of voxels which stores only the cubic bricks of voxels it uses
+///
+/// The volume is divided into bricks of brick_size() voxels on a side. Each
+/// allocated brick is stored densely and found through a hash map from its
+/// brick coordinates, so memory scales with the number of allocated bricks
+/// rather than with the extent of the volume. The voxels of all bricks are
+/// stored contiguously in order of allocation, and within a brick with the
+/// first index varying fastest.
+///
+/// Bricks at the upper boundaries may extend past the volume dimensions;
+/// voxels outside the volume are stored but never read.
+class KWIVER_ALGO_CORE_EXPORT sparse_volume
+{
+public:
+  /// Index returned by find_brick() for bricks which are not allocated
+  static constexpr size_t npos = std::numeric_limits< size_t >::max();
+
+  /// Construct an empty volume
+  sparse_volume() = default;
+
+  /// Construct a volume with no bricks allocated
+  ///
+  /// \param ni         number of voxels along the first axis
+  /// \param nj         number of voxels along the second axis
+  /// \param nk         number of voxels along the third axis
+  /// \param brick_size number of voxels along each side of a brick
+  sparse_volume( size_t ni, size_t nj, size_t nk, unsigned brick_size = 8 );
+
+  /// Set the dimensions of the volume and release all bricks
+  void reset( size_t ni, size_t nj, size_t nk, unsigned brick_size = 8 );
+
+  /// Number of voxels along the first axis
+  size_t width() const { return m_dims[ 0 ]; }
+  /// Number of voxels along the second axis
+  size_t height() const { return m_dims[ 1 ]; }
+  /// Number of voxels along the third axis
+  size_t depth() const { return m_dims[ 2 ]; }
+
+  /// Number of voxels along each side of a brick
+  unsigned brick_size() const { return m_brick_size; }
+  /// Number of voxels in a brick
+  size_t brick_voxels() const
+  { return static_cast< size_t >( m_brick_size ) * m_brick_size * m_brick_size; }
+
+  /// Number of allocated bricks
+  size_t num_bricks() const { return m_origins.size(); }
+
+  /// Allocate the brick at brick coordinates (bi, bj, bk)
+  ///
+  /// The voxels of a new brick are set to zero. Allocating a brick which is
+  /// already allocated has no effect. Allocation may move the voxel data of
+  /// all bricks.
+  ///
+  /// \returns the index of the brick
+  size_t allocate_brick( size_t bi, size_t bj, size_t bk );
+
+  /// Index of the brick at brick coordinates (bi, bj, bk), or npos
+  size_t find_brick( size_t bi, size_t bj, size_t bk ) const;
+
+  /// Voxel coordinates of the first voxel of brick \p b
+  std::array< size_t, 3 > const& brick_origin( size_t b ) const
+  { return m_origins[ b ]; }
+
+  /// Voxels of brick \p b
+  double* brick_data( size_t b )
+  { return m_data.data() + b * brick_voxels(); }
+  /// Voxels of brick \p b
+  double const* brick_data( size_t b ) const
+  { return m_data.data() + b * brick_voxels(); }
+
+  /// Voxels of all bricks, brick after brick
+  double* data() { return m_data.data(); }
+  /// Voxels of all bricks, brick after brick
+  double const* data() const { return m_data.data(); }
+
+  /// Check if the voxel at (i, j, k) is in an allocated brick
+  bool is_allocated( size_t i, size_t j, size_t k ) const;
+
+  /// Value of the voxel at (i, j, k), or \p background if not allocated
+  double value( size_t i, size_t j, size_t k, double background = 0.0 ) const;
+
+  /// Convert to a dense volume stored as a 3D image
+  ///
+  /// \param background the value of voxels in unallocated bricks
+  vital::image_of< double > to_image( double background = 0.0 ) const;
+
+private:
+  uint64_t key( size_t bi, size_t bj, size_t bk ) const;
+
+  std::array< size_t, 3 > m_dims{ { 0, 0, 0 } };
+  unsigned m_brick_size = 8;
+  std::unordered_map< uint64_t, size_t > m_index;
+  std::vector< std::array< size_t, 3 > > m_origins;
+  std::vector< double > m_data;
+};
+
+/// Allocate the bricks of a volume near the surface seen in a depth map
+///
+/// Allocates each brick through which the ray of a pixel center passes within
+/// \p band of the depth at that pixel, measured along the optical axis as
+/// camera depth is. Pixels with no depth or weight are skipped. The rays of
+/// all pixels are marched in parallel on the vital thread pool.
+///
+/// \param volume  the volume in which to allocate bricks
+/// \param camera  the camera that produced the depth map
+/// \param depth   the depth map
+/// \param weight  weight of each depth, or an empty image for full weight
+/// \param origin  world coordinates of the first corner of the volume
+/// \param spacing size of a voxel in each dimension
+/// \param band    distance from each depth within which to allocate
+KWIVER_ALGO_CORE_EXPORT
+void
+allocate_surface_bricks( sparse_volume& volume,
+                         vital::camera_perspective const& camera,
+                         vital::image_of< double > const& depth,
+                         vital::image_of< double > const& weight,
+                         vital::vector_3d const& origin,
+                         vital::vector_3d const& spacing,
+                         double band );
+
+} // end namespace core
+} // end namespace arrows
+} // end namespace kwiver
+
+#endif
@@ -0,0 +1,243 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test optimal association of detections to tracks
+
+#include <test_gtest.h>
+
+#include <arrows/core/associate_detections_to_tracks_optimal.h>
+
+#include <vital/plugin_loader/plugin_manager.h>
+#include <vital/types/detected_object_set.h>
+#include <vital/types/object_track_set.h>
+
+#include <limits>
+#include <random>
+
+namespace kv = kwiver::vital;
+
+using kwiver::arrows::core::associate_detections_to_tracks_optimal;
+
+namespace {
+
+constexpr double invalid_value = std::numeric_limits< double >::max();
+constexpr unsigned no_match = std::numeric_limits< unsigned >::max();
+
+// ----------------------------------------------------------------------------
+struct problem
+{
+  problem( unsigned num_tracks, unsigned num_detections )
+    : matrix( num_tracks, num_detections ),
+      detections( std::make_shared< kv::detected_object_set >() )
+  {
+    matrix.setConstant( invalid_value );
+    for( unsigned t = 0; t < num_tracks; ++t )
+    {
+      auto const trk = kv::track::create();
+      trk->set_id( t );
+      trk->append( std::make_shared< kv::object_track_state >( 0, 0 ) );
+      tracks.push_back( trk );
+    }
+    for( unsigned d = 0; d < num_detections; ++d )
+    {
+      detections->add( std::make_shared< kv::detected_object >(
+        kv::bounding_box_d{ 0.0, 0.0, 1.0, 1.0 } ) );
+    }
+  }
+
+  // The detection assigned to each track
+  std::vector< unsigned >
+  associate( double threshold, bool higher_is_better,
+             kv::detected_object_set_sptr* unused_out = nullptr ) const
+  {
+    associate_detections_to_tracks_optimal algo;
+    auto config = algo.get_configuration();
+    config->set_value( "threshold", threshold );
+    config->set_value( "higher_is_better", higher_is_better );
+    algo.set_configuration( config );
+
+    kv::object_track_set_sptr output;
+    kv::detected_object_set_sptr unused;
+    algo.associate( kv::timestamp{ 1, 1 }, nullptr,
+                    std::make_shared< kv::object_track_set >( tracks ),
+                    detections, matrix, output, unused );
+    if( unused_out )
+    {
+      *unused_out = unused;
+    }
+
+    std::vector< unsigned > result;
+    for( auto const& trk : output->tracks() )
+    {
+      result.push_back( no_match );
+      if( trk->size() == 2 )
+      {
+        auto const state =
+          std::dynamic_pointer_cast< kv::object_track_state >( trk->back() );
+        for( unsigned d = 0; d < detections->size(); ++d )
+        {
+          if( detections->at( d ) == state->detection() )
+          {
+            result.back() = d;
+          }
+        }
+      }
+    }
+    return result;
+  }
+
+  kv::matrix_d matrix;
+  std::vector< kv::track_sptr > tracks;
+  kv::detected_object_set_sptr detections;
+};
+
+// ----------------------------------------------------------------------------
+// Total cost of an assignment, with unassigned tracks costing the threshold
+double
+total_cost( kv::matrix_d const& matrix, std::vector< unsigned > const& match,
+            double threshold )
+{
+  double result = 0.0;
+  for( size_t t = 0; t < match.size(); ++t )
+  {
+    result += ( match[ t ] == no_match ? threshold : matrix( t, match[ t ] ) );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+// Find the lowest total cost by trying every assignment
+double
+brute_force_cost( kv::matrix_d const& matrix, double threshold, size_t t,
+                  std::vector< bool >& taken )
+{
+  if( t == static_cast< size_t >( matrix.rows() ) )
+  {
+    return 0.0;
+  }
+
+  auto best = threshold + brute_force_cost( matrix, threshold, t + 1, taken );
+  for( size_t d = 0; d < taken.size(); ++d )
+  {
+    if( !taken[ d ] && matrix( t, d ) <= threshold )
+    {
+      taken[ d ] = true;
+      best = std::min( best, matrix( t, d ) +
+                       brute_force_cost( matrix, threshold, t + 1, taken ) );
+      taken[ d ] = false;
+    }
+  }
+  return best;
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST ( associate_detections_to_tracks_optimal, conflict )
+{
+  // Greedy assignment would give detection 0 to both tracks
+  problem p{ 2, 2 };
+  p.matrix( 0, 0 ) = 0.1;
+  p.matrix( 0, 1 ) = 0.2;
+  p.matrix( 1, 0 ) = 0.15;
+
+  kv::detected_object_set_sptr unused;
+  auto const match = p.associate( 0.5, false, &unused );
+  EXPECT_EQ( ( std::vector< unsigned >{ 1, 0 } ), match );
+  EXPECT_EQ( 0, unused->size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( associate_detections_to_tracks_optimal, higher_is_better )
+{
+  problem p{ 3, 2 };
+  p.matrix( 0, 0 ) = 0.9;
+  p.matrix( 0, 1 ) = 0.8;
+  p.matrix( 1, 0 ) = 0.85;
+  p.matrix( 2, 1 ) = 0.3;
+
+  kv::detected_object_set_sptr unused;
+  auto const match = p.associate( 0.5, true, &unused );
+  EXPECT_EQ( ( std::vector< unsigned >{ 1, 0, no_match } ), match );
+  EXPECT_EQ( 0, unused->size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( associate_detections_to_tracks_optimal, unassigned )
+{
+  problem p{ 2, 3 };
+  p.matrix( 0, 2 ) = 0.7;
+
+  kv::detected_object_set_sptr unused;
+  auto const match = p.associate( 0.5, false, &unused );
+  EXPECT_EQ( ( std::vector< unsigned >{ no_match, no_match } ), match );
+  EXPECT_EQ( 3, unused->size() );
+
+  p.matrix.resize( 0, 0 );
+  EXPECT_EQ( ( std::vector< unsigned >{ no_match, no_match } ),
+             p.associate( 0.5, false ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( associate_detections_to_tracks_optimal, mismatched_matrix )
+{
+  problem p{ 2, 3 };
+  p.matrix.resize( 3, 2 );
+  EXPECT_THROW( p.associate( 0.5, false ), kv::invalid_value );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( associate_detections_to_tracks_optimal, random )
+{
+  std::mt19937 rng( 7 );
+  std::uniform_real_distribution< double > uniform( 0.0, 1.0 );
+  constexpr double threshold = 0.6;
+
+  for( int trial = 0; trial < 100; ++trial )
+  {
+    SCOPED_TRACE( trial );
+
+    std::uniform_int_distribution< unsigned > size( 1, 6 );
+    problem p{ size( rng ), size( rng ) };
+    for( Eigen::Index t = 0; t < p.matrix.rows(); ++t )
+    {
+      for( Eigen::Index d = 0; d < p.matrix.cols(); ++d )
+      {
+        // leave some pairs unscored, so the graph splits into components
+        if( uniform( rng ) < 0.6 )
+        {
+          p.matrix( t, d ) = uniform( rng );
+        }
+      }
+    }
+
+    auto const match = p.associate( threshold, false );
+    ASSERT_EQ( p.tracks.size(), match.size() );
+
+    std::vector< bool > taken( p.detections->size(), false );
+    for( size_t t = 0; t < match.size(); ++t )
+    {
+      if( match[ t ] != no_match )
+      {
+        EXPECT_LE( p.matrix( t, match[ t ] ), threshold );
+        EXPECT_FALSE( taken[ match[ t ] ] );
+        taken[ match[ t ] ] = true;
+      }
+    }
+
+    std::fill( taken.begin(), taken.end(), false );
+    EXPECT_NEAR( brute_force_cost( p.matrix, threshold, 0, taken ),
+                 total_cost( p.matrix, match, threshold ), 1e-9 );
+  }
+}
@@ -0,0 +1,202 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test appearance indexed loop closure
+
+#include <test_gtest.h>
+
+#include <arrows/core/close_loops_appearance_indexed.h>
+
+#include <vital/algo/algorithm_factory.h>
+#include <vital/algo/match_descriptor_sets.h>
+#include <vital/plugin_loader/plugin_manager.h>
+#include <vital/types/feature_track_set.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace kv = kwiver::vital;
+namespace algo = kwiver::vital::algo;
+
+using kwiver::arrows::core::close_loops_appearance_indexed;
+
+namespace {
+
+constexpr int num_features = 21;
+
+std::mutex index_mutex;
+std::vector< kv::frame_id_t > indexed_frames;
+std::vector< size_t > indexed_on_query;
+
+// ----------------------------------------------------------------------------
+// Return the frames of the first track segment as candidates for every query,
+// taking a while to add frames to the index
+class test_bow : public algo::match_descriptor_sets
+{
+public:
+  PLUGIN_INFO( "test_bow", "Returns fixed loop closure candidates." )
+
+  void set_configuration( kv::config_block_sptr ) override {}
+  bool check_configuration( kv::config_block_sptr ) const override
+  {
+    return true;
+  }
+
+  void
+  append_to_index( kv::descriptor_set_sptr const,
+                   kv::frame_id_t frame ) override
+  {
+    std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+    std::lock_guard< std::mutex > lock( index_mutex );
+    indexed_frames.push_back( frame );
+  }
+
+  std::vector< kv::frame_id_t >
+  query( kv::descriptor_set_sptr const ) override
+  {
+    std::lock_guard< std::mutex > lock( index_mutex );
+    indexed_on_query.push_back( indexed_frames.size() );
+    return { 3, 2, 1, 0 };
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Make two segments of tracks, on frames 0-3 and 4-7, which see the same
+// features; each vocabulary node holds three features with equally distant
+// descriptors, as matching needs a second best match within the node
+kv::feature_track_set_sptr
+make_tracks()
+{
+  kv::byte const codes[] = { 0x03, 0x0c, 0x30 };
+
+  std::vector< kv::track_sptr > tracks;
+  for( kv::track_id_t id = 0; id < 2 * num_features; ++id )
+  {
+    auto const j = static_cast< int >( id % num_features );
+    auto const t = kv::track::create();
+    t->set_id( id );
+
+    auto const first_frame = ( id < num_features ? 0 : 4 );
+    for( auto f = first_frame; f < first_frame + 4; ++f )
+    {
+      auto const desc =
+        std::make_shared< kv::descriptor_fixed< kv::byte, 32 > >();
+      std::fill( desc->raw_data(), desc->raw_data() + 32,
+                 codes[ j % 3 ] );
+      desc->set_node_id( static_cast< unsigned >( j / 3 ) );
+
+      auto const feat = std::make_shared< kv::feature_d >(
+        kv::vector_2d{ 10.0 * j, 5.0 * f } );
+      t->append(
+        std::make_shared< kv::feature_track_state >( f, feat, desc ) );
+    }
+    tracks.push_back( t );
+  }
+
+  auto const result = std::make_shared< kv::feature_track_set >( tracks );
+  for( kv::frame_id_t f = 4; f < 8; ++f )
+  {
+    auto const fd = std::make_shared< kv::feature_track_set_frame_data >();
+    fd->is_keyframe = true;
+    result->set_frame_data( fd, f );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< close_loops_appearance_indexed >
+make_closer( unsigned batch_size, bool async )
+{
+  auto const closer = std::make_shared< close_loops_appearance_indexed >();
+  auto const config = closer->get_configuration();
+  config->set_value( "match_features:type", "brute_force" );
+  config->set_value( "bag_of_words_matching:type", "test_bow" );
+  config->set_value( "min_loop_inlier_matches", num_features / 2 );
+  config->set_value( "verification_batch_size", batch_size );
+  config->set_value( "async_index_update", async );
+  EXPECT_TRUE( closer->check_configuration( config ) );
+  closer->set_configuration( config );
+  return closer;
+}
+
+// ----------------------------------------------------------------------------
+// Stitch the second segment's frames in order, as a tracker would
+kv::feature_track_set_sptr
+stitch_all( close_loops_appearance_indexed const& closer )
+{
+  auto tracks = make_tracks();
+  for( kv::frame_id_t f = 4; f < 8; ++f )
+  {
+    tracks = closer.stitch( f, tracks, nullptr );
+  }
+  return tracks;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+
+  kv::plugin_manager::instance().add_factory(
+    new kv::algorithm_factory_0< test_bow >(
+      test_bow::static_type_name(), test_bow::_plugin_name ) );
+
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST ( close_loops_appearance_indexed, batches_match_serial )
+{
+  for( auto const async : { false, true } )
+  {
+    for( auto const batch_size : { 1u, 3u, 16u } )
+    {
+      SCOPED_TRACE( "Batch size: " + std::to_string( batch_size ) +
+                    ( async ? ", async" : "" ) );
+
+      auto const tracks = stitch_all( *make_closer( batch_size, async ) );
+
+      // Each feature is now a single track over both segments
+      ASSERT_EQ( num_features, tracks->size() );
+      for( auto const& t : tracks->tracks() )
+      {
+        EXPECT_EQ( 8, t->size() );
+        EXPECT_EQ( 0, t->first_frame() );
+        EXPECT_EQ( 7, t->last_frame() );
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( close_loops_appearance_indexed, async_index_update )
+{
+  indexed_frames.clear();
+  indexed_on_query.clear();
+
+  {
+    auto const closer = make_closer( 4, true );
+    stitch_all( *closer );
+  }
+
+  // Each query sees every earlier keyframe in the index, and all keyframes
+  // are indexed by the time the algorithm is destroyed
+  EXPECT_EQ( ( std::vector< size_t >{ 0, 1, 2, 3 } ), indexed_on_query );
+  EXPECT_EQ( ( std::vector< kv::frame_id_t >{ 4, 5, 6, 7 } ), indexed_frames );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( close_loops_appearance_indexed, batch_size_zero )
+{
+  close_loops_appearance_indexed closer;
+  auto const config = closer.get_configuration();
+  config->set_value( "verification_batch_size", 0 );
+  EXPECT_FALSE( closer.check_configuration( config ) );
+}
@@ -0,0 +1,258 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test computing association matrices from features
+
+#include <test_gtest.h>
+
+#include <arrows/core/associate_detections_to_tracks_threshold.h>
+#include <arrows/core/compute_association_matrix_from_features.h>
+
+#include <vital/plugin_loader/plugin_manager.h>
+#include <vital/types/detected_object_set.h>
+#include <vital/types/object_track_set.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace kv = kwiver::vital;
+
+using kwiver::arrows::core::associate_detections_to_tracks_threshold;
+using kwiver::arrows::core::compute_association_matrix_from_features;
+
+namespace {
+
+constexpr double invalid_value = std::numeric_limits< double >::max();
+
+// ----------------------------------------------------------------------------
+kv::detected_object_sptr
+make_detection( double x, double y, std::vector< double > features )
+{
+  auto const type = std::make_shared< kv::detected_object_type >();
+  type->set_score( "object", 1.0 );
+
+  auto const det = std::make_shared< kv::detected_object >(
+    kv::bounding_box_d{ x - 2.0, y - 2.0, x + 2.0, y + 2.0 }, 1.0, type );
+  if( !features.empty() )
+  {
+    det->set_descriptor(
+      std::make_shared< kv::detected_object::descriptor_t >(
+        features.size(), features.data() ) );
+  }
+  return det;
+}
+
+// ----------------------------------------------------------------------------
+kv::track_sptr
+make_track( kv::track_id_t id, kv::detected_object_sptr const& det )
+{
+  auto const trk = kv::track::create();
+  trk->set_id( id );
+  trk->append( std::make_shared< kv::object_track_state >( 0, 0, det ) );
+  return trk;
+}
+
+// ----------------------------------------------------------------------------
+// Score every pair of tracks and detections
+kv::matrix_d
+reference_matrix( std::vector< kv::track_sptr > const& tracks,
+                  kv::detected_object_set const& detections,
+                  double max_distance )
+{
+  kv::matrix_d result( tracks.size(), detections.size() );
+  for( size_t t = 0; t < tracks.size(); ++t )
+  {
+    auto const state =
+      std::dynamic_pointer_cast< kv::object_track_state >( tracks[ t ]->back() );
+    auto const trk_det = state->detection();
+    for( size_t d = 0; d < detections.size(); ++d )
+    {
+      auto const det = detections.at( d );
+      auto const distance =
+        ( trk_det->bounding_box().center() -
+          det->bounding_box().center() ).norm();
+
+      result( t, d ) = invalid_value;
+      if( det->descriptor() && trk_det->descriptor() &&
+          ( max_distance <= 0.0 || distance < max_distance ) )
+      {
+        auto const det_features = det->descriptor()->as_double();
+        auto const trk_features = trk_det->descriptor()->as_double();
+        double sum_sqr = 0.0;
+        for( size_t i = 0; i < det_features.size(); ++i )
+        {
+          auto const diff = det_features[ i ] - trk_features[ i ];
+          sum_sqr += diff * diff;
+        }
+        result( t, d ) = std::sqrt( sum_sqr );
+      }
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< compute_association_matrix_from_features >
+make_algorithm( double max_distance )
+{
+  auto const algo =
+    std::make_shared< compute_association_matrix_from_features >();
+  auto config = algo->get_configuration();
+  config->set_value( "max_distance", max_distance );
+  config->set_value( "filter:type", "class_probablity_filter" );
+  algo->set_configuration( config );
+  return algo;
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+class compute_association_matrix_from_features_test : public ::testing::Test
+{
+public:
+  void SetUp() override
+  {
+    std::mt19937 rng( 42 );
+    std::uniform_real_distribution< double > position( -100.0, 100.0 );
+    std::uniform_real_distribution< double > feature( 0.0, 1.0 );
+
+    auto const random_detection =
+      [ & ]( size_t index ){
+        // leave some detections without a descriptor
+        std::vector< double > features;
+        if( index % 7 )
+        {
+          features = { feature( rng ), feature( rng ), feature( rng ) };
+        }
+        auto const x = position( rng );
+        return make_detection( x, position( rng ), features );
+      };
+
+    for( size_t i = 0; i < 200; ++i )
+    {
+      detections->add( random_detection( i ) );
+    }
+    for( size_t i = 0; i < 150; ++i )
+    {
+      tracks.push_back(
+        make_track( static_cast< kv::track_id_t >( i ),
+                    random_detection( i ) ) );
+    }
+  }
+
+  std::vector< kv::track_sptr > tracks;
+  kv::detected_object_set_sptr detections =
+    std::make_shared< kv::detected_object_set >();
+};
+
+// ----------------------------------------------------------------------------
+TEST_F ( compute_association_matrix_from_features_test, gated )
+{
+  for( double const max_distance : { 15.0, 40.0 } )
+  {
+    SCOPED_TRACE( max_distance );
+
+    auto const algo = make_algorithm( max_distance );
+    kv::matrix_d matrix;
+    kv::detected_object_set_sptr considered;
+    EXPECT_TRUE(
+      algo->compute( {}, nullptr,
+                     std::make_shared< kv::object_track_set >( tracks ),
+                     detections, matrix, considered ) );
+    EXPECT_EQ( detections, considered );
+
+    auto const expected =
+      reference_matrix( tracks, *detections, max_distance );
+    ASSERT_EQ( expected.rows(), matrix.rows() );
+    ASSERT_EQ( expected.cols(), matrix.cols() );
+    EXPECT_TRUE( expected == matrix );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST_F ( compute_association_matrix_from_features_test, ungated )
+{
+  auto const algo = make_algorithm( -1.0 );
+  kv::matrix_d matrix;
+  kv::detected_object_set_sptr considered;
+  algo->compute( {}, nullptr,
+                 std::make_shared< kv::object_track_set >( tracks ),
+                 detections, matrix, considered );
+
+  auto const expected = reference_matrix( tracks, *detections, -1.0 );
+  EXPECT_TRUE( expected == matrix );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F ( compute_association_matrix_from_features_test, mismatched_descriptors )
+{
+  tracks.push_back( make_track( 1000, make_detection( 0.0, 0.0, { 1.0 } ) ) );
+  detections->add( make_detection( 0.0, 1.0, { 1.0, 2.0 } ) );
+
+  auto const algo = make_algorithm( 10.0 );
+  kv::matrix_d matrix;
+  kv::detected_object_set_sptr considered;
+  EXPECT_THROW(
+    algo->compute( {}, nullptr,
+                   std::make_shared< kv::object_track_set >( tracks ),
+                   detections, matrix, considered ),
+    std::runtime_error );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F ( compute_association_matrix_from_features_test, associate )
+{
+  auto const compute = make_algorithm( 40.0 );
+  kv::matrix_d matrix;
+  kv::detected_object_set_sptr considered;
+  auto const track_set = std::make_shared< kv::object_track_set >( tracks );
+  compute->compute( {}, nullptr, track_set, detections, matrix, considered );
+
+  associate_detections_to_tracks_threshold associate;
+  auto config = associate.get_configuration();
+  config->set_value( "threshold", 0.5 );
+  config->set_value( "higher_is_better", false );
+  associate.set_configuration( config );
+
+  kv::object_track_set_sptr output;
+  kv::detected_object_set_sptr unused;
+  associate.associate( kv::timestamp{ 1, 1 }, nullptr, track_set, detections,
+                       matrix, output, unused );
+
+  // each track is extended by its closest detection under the threshold
+  auto const output_tracks = output->tracks();
+  ASSERT_EQ( tracks.size(), output_tracks.size() );
+  size_t used = 0;
+  for( size_t t = 0; t < tracks.size(); ++t )
+  {
+    Eigen::Index best = 0;
+    auto const best_score = matrix.row( t ).minCoeff( &best );
+    if( best_score <= 0.5 )
+    {
+      ASSERT_EQ( 2, output_tracks[ t ]->size() );
+      auto const state = std::dynamic_pointer_cast< kv::object_track_state >(
+        output_tracks[ t ]->back() );
+      EXPECT_EQ( detections->at( static_cast< size_t >( best ) ),
+                 state->detection() );
+      ++used;
+    }
+    else
+    {
+      EXPECT_EQ( 1, output_tracks[ t ]->size() );
+    }
+  }
+  EXPECT_GT( used, 0 );
+  EXPECT_LE( detections->size() - used, unused->size() );
+}
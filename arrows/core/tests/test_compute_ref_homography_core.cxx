@@ -0,0 +1,276 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test core reference homography estimation
+
+#include <test_gtest.h>
+
+#include <arrows/core/compute_ref_homography_core.h>
+
+#include <vital/algo/algorithm_factory.h>
+#include <vital/algo/estimate_homography.h>
+#include <vital/plugin_loader/plugin_manager.h>
+
+#include <Eigen/Geometry>
+#include <Eigen/LU>
+#include <Eigen/QR>
+
+#include <algorithm>
+#include <cmath>
+
+namespace kv = kwiver::vital;
+namespace algo = kwiver::vital::algo;
+
+using kwiver::arrows::core::compute_ref_homography_core;
+
+namespace {
+
+// Horizontal offset added to every estimated homography
+double estimate_bias = 0.0;
+
+// ----------------------------------------------------------------------------
+kv::vector_2d
+map_point( Eigen::Matrix3d const& h, kv::vector_2d const& p )
+{
+  return ( h * p.homogeneous() ).hnormalized();
+}
+
+// ----------------------------------------------------------------------------
+// Solve exactly for the homography through noise free points, then offset it
+// by estimate_bias
+class test_estimator : public algo::estimate_homography
+{
+public:
+  PLUGIN_INFO( "test_exact", "Fits a homography to noise free points." )
+
+  using algo::estimate_homography::estimate;
+
+  void set_configuration( kv::config_block_sptr ) override {}
+  bool check_configuration( kv::config_block_sptr ) const override
+  {
+    return true;
+  }
+
+  kv::homography_sptr
+  estimate( std::vector< kv::vector_2d > const& pts1,
+            std::vector< kv::vector_2d > const& pts2,
+            std::vector< bool >& inliers,
+            double ) const override
+  {
+    Eigen::MatrixXd a{ 2 * pts1.size(), 8 };
+    Eigen::VectorXd b{ 2 * pts1.size() };
+    for( size_t i = 0; i < pts1.size(); ++i )
+    {
+      auto const x = pts1[ i ].x();
+      auto const y = pts1[ i ].y();
+      auto const u = pts2[ i ].x();
+      auto const v = pts2[ i ].y();
+      a.row( 2 * i ) << x, y, 1, 0, 0, 0, -u * x, -u * y;
+      a.row( 2 * i + 1 ) << 0, 0, 0, x, y, 1, -v * x, -v * y;
+      b( 2 * i ) = u;
+      b( 2 * i + 1 ) = v;
+    }
+    Eigen::VectorXd const h = a.colPivHouseholderQr().solve( b );
+
+    Eigen::Matrix3d m;
+    m << h( 0 ), h( 1 ), h( 2 ), h( 3 ), h( 4 ), h( 5 ), h( 6 ), h( 7 ), 1.0;
+
+    Eigen::Matrix3d offset = Eigen::Matrix3d::Identity();
+    offset( 0, 2 ) = estimate_bias;
+
+    inliers.assign( pts1.size(), true );
+    return std::make_shared< kv::homography_< double > >( offset * m );
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Tracks of a grid of points through frames 0 to \p num_frames - 1, where
+// \p motion(n) maps frame 0 to frame n
+template < typename Motion >
+kv::feature_track_set_sptr
+make_tracks( kv::frame_id_t num_frames, Motion motion )
+{
+  std::vector< kv::track_sptr > tracks;
+  for( int i = 0; i < 6; ++i )
+  {
+    for( int j = 0; j < 6; ++j )
+    {
+      auto const t = kv::track::create();
+      t->set_id( static_cast< kv::track_id_t >( tracks.size() ) );
+      kv::vector_2d const p{ 100.0 + 80.0 * i, 50.0 + 70.0 * j };
+      for( kv::frame_id_t n = 0; n < num_frames; ++n )
+      {
+        auto const fts = std::make_shared< kv::feature_track_state >( n );
+        fts->feature =
+          std::make_shared< kv::feature_d >( map_point( motion( n ), p ) );
+        t->append( fts );
+      }
+      tracks.push_back( t );
+    }
+  }
+  return std::make_shared< kv::feature_track_set >( tracks );
+}
+
+// ----------------------------------------------------------------------------
+// Frame 0 to frame n translation of \p step pixels per frame
+Eigen::Matrix3d
+translation( kv::frame_id_t n, double step )
+{
+  Eigen::Matrix3d h = Eigen::Matrix3d::Identity();
+  h( 0, 2 ) = step * n;
+  h( 1, 2 ) = -0.5 * step * n;
+  return h;
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< compute_ref_homography_core >
+make_chained( double max_error )
+{
+  auto const algo = std::make_shared< compute_ref_homography_core >();
+  auto const config = algo->get_configuration();
+  config->set_value( "estimator:type", "test_exact" );
+  config->set_value( "chain_homographies", true );
+  config->set_value( "chain_max_error", max_error );
+  EXPECT_TRUE( algo->check_configuration( config ) );
+  algo->set_configuration( config );
+  return algo;
+}
+
+// ----------------------------------------------------------------------------
+// Largest distance between where \p h maps the grid points on frame \p n and
+// their locations on frame 0
+double
+max_error( kv::feature_track_set_sptr const& tracks, kv::frame_id_t n,
+           Eigen::Matrix3d const& h )
+{
+  double result = 0.0;
+  for( auto const& t : tracks->tracks() )
+  {
+    auto const ref = std::dynamic_pointer_cast< kv::feature_track_state >(
+      *t->find( 0 ) )->feature->loc();
+    auto const cur = std::dynamic_pointer_cast< kv::feature_track_state >(
+      *t->find( n ) )->feature->loc();
+    result = std::max( result, ( map_point( h, cur ) - ref ).norm() );
+  }
+  return result;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+
+  auto& vpm = kv::plugin_manager::instance();
+  vpm.add_factory( new kv::algorithm_factory_0< test_estimator >(
+    test_estimator::static_type_name(), test_estimator::_plugin_name ) );
+
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST ( compute_ref_homography_core, chained_composition )
+{
+  estimate_bias = 0.0;
+
+  // A different similarity with some perspective between each pair of frames
+  kv::frame_id_t const num_frames = 12;
+  auto const motion = []( kv::frame_id_t n )
+  {
+    Eigen::Matrix3d h = Eigen::Matrix3d::Identity();
+    for( kv::frame_id_t k = 1; k <= n; ++k )
+    {
+      auto const angle = 0.01 * k;
+      auto const scale = 1.0 + 0.002 * ( k % 3 );
+      Eigen::Matrix3d step;
+      step << scale * std::cos( angle ), -scale * std::sin( angle ), 3.0 * k,
+              scale * std::sin( angle ),  scale * std::cos( angle ), -2.0,
+              1e-6 * k,                   -1e-6,                     1.0;
+      h = step * h;
+    }
+    return h;
+  };
+  auto const tracks = make_tracks( num_frames, motion );
+
+  // Disable re-anchoring so that every homography is composed
+  auto const algo = make_chained( 1e9 );
+  for( kv::frame_id_t n = 0; n < num_frames; ++n )
+  {
+    auto const h = algo->estimate( n, tracks );
+    ASSERT_NE( nullptr, h );
+    EXPECT_EQ( n, h->from_id() );
+    EXPECT_EQ( 0, h->to_id() );
+
+    Eigen::Matrix3d const expected = motion( n ).inverse();
+    Eigen::Matrix3d const actual = h->homography()->matrix();
+    EXPECT_TRUE( actual.isApprox( expected / expected( 2, 2 ), 1e-6 ) )
+      << "frame " << n << "\n" << actual << "\n" << expected;
+    EXPECT_LT( max_error( tracks, n, actual ), 1e-6 ) << "frame " << n;
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( compute_ref_homography_core, chained_drift )
+{
+  // Each estimate is off by the bias, so composing them drifts by the bias
+  // every frame
+  estimate_bias = 0.6;
+
+  kv::frame_id_t const num_frames = 10;
+  auto const tracks = make_tracks(
+    num_frames, []( kv::frame_id_t n ){ return translation( n, 4.0 ); } );
+
+  auto const algo = make_chained( 1e9 );
+  for( kv::frame_id_t n = 0; n < num_frames; ++n )
+  {
+    auto const h = algo->estimate( n, tracks );
+    EXPECT_NEAR( estimate_bias * n,
+                 max_error( tracks, n, h->homography()->matrix() ), 1e-6 )
+      << "frame " << n;
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( compute_ref_homography_core, chained_reanchor )
+{
+  estimate_bias = 0.6;
+  double const chain_max_error = 2.0;
+
+  kv::frame_id_t const num_frames = 16;
+  auto const tracks = make_tracks(
+    num_frames, []( kv::frame_id_t n ){ return translation( n, 4.0 ); } );
+
+  // The chain drifts by the bias each frame until the drift exceeds the
+  // maximum error, when the homography is estimated against the reference
+  // locations directly, leaving only the bias of that estimate
+  auto const algo = make_chained( chain_max_error );
+  double expected = 0.0;
+  size_t reanchors = 0;
+  for( kv::frame_id_t n = 0; n < num_frames; ++n )
+  {
+    if( n > 0 )
+    {
+      expected += estimate_bias;
+      if( expected > chain_max_error )
+      {
+        expected = estimate_bias;
+        ++reanchors;
+      }
+    }
+
+    auto const h = algo->estimate( n, tracks );
+    EXPECT_EQ( 0, h->to_id() );
+
+    auto const error = max_error( tracks, n, h->homography()->matrix() );
+    EXPECT_NEAR( expected, error, 1e-6 ) << "frame " << n;
+    EXPECT_LE( error, chain_max_error ) << "frame " << n;
+  }
+
+  // Re-anchored on frames 4, 7, 10 and 13
+  EXPECT_EQ( 4, reanchors );
+}
@@ -0,0 +1,153 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include <gtest/gtest.h>
+
+#include <arrows/core/depth_utils.h>
+
+#include <vital/exceptions.h>
+#include <vital/types/camera_intrinsics.h>
+#include <vital/types/camera_perspective.h>
+#include <vital/types/image_container.h>
+
+using namespace kwiver::vital;
+using namespace kwiver::arrows::core;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+const unsigned width = 40;
+const unsigned height = 30;
+
+// ----------------------------------------------------------------------------
+camera_perspective_sptr
+make_camera(simple_camera_intrinsics::vector_t const& dist =
+              simple_camera_intrinsics::vector_t())
+{
+  auto K = std::make_shared<simple_camera_intrinsics>(
+    50.0, vector_2d(20.0, 15.0), 1.0, 0.0, dist, width, height);
+  auto cam = std::make_shared<simple_camera_perspective>(
+    vector_3d(1.0, -2.0, 10.0), rotation_d(), K);
+  cam->look_at(vector_3d(0.0, 0.0, 0.0), vector_3d(0.0, 1.0, 0.0));
+  return cam;
+}
+
+// ----------------------------------------------------------------------------
+image_container_sptr
+make_depth(unsigned ni, unsigned nj)
+{
+  image_of<float> depth(ni, nj);
+  for (unsigned j = 0; j < nj; ++j)
+  {
+    for (unsigned i = 0; i < ni; ++i)
+    {
+      depth(i, j) = 8.0f + 0.05f * i + 0.02f * j;
+    }
+  }
+  return std::make_shared<simple_image_container>(depth);
+}
+
+// ----------------------------------------------------------------------------
+void
+check_round_trip(camera_perspective_sptr const& cam)
+{
+  auto depth = make_depth(width, height);
+  auto cloud = depth_map_to_pointcloud(depth, cam);
+  auto const points = cloud->positions();
+  ASSERT_EQ(width * height, points.size());
+  EXPECT_FALSE(cloud->has_colors());
+
+  for (unsigned j = 0, n = 0; j < height; ++j)
+  {
+    for (unsigned i = 0; i < width; ++i, ++n)
+    {
+      double const d = depth->get_image().at<float>(i, j);
+      EXPECT_NEAR(d, cam->depth(points[n]), 1e-6);
+      vector_2d const pt = cam->project(points[n]);
+      EXPECT_NEAR(i, pt.x(), 1e-6);
+      EXPECT_NEAR(j, pt.y(), 1e-6);
+    }
+  }
+}
+
+}
+
+// ----------------------------------------------------------------------------
+TEST(depth_utils, depth_map_to_pointcloud)
+{
+  check_round_trip(make_camera());
+}
+
+// ----------------------------------------------------------------------------
+TEST(depth_utils, depth_map_to_pointcloud_distortion)
+{
+  simple_camera_intrinsics::vector_t dist(2);
+  dist << -0.1, 0.01;
+  check_round_trip(make_camera(dist));
+}
+
+// ----------------------------------------------------------------------------
+TEST(depth_utils, depth_maps_to_pointcloud_filter)
+{
+  auto cam = make_camera();
+  unsigned const ni = 10;
+  unsigned const nj = 8;
+  bounding_box<int> const crop(5, 4, 5 + ni, 4 + nj);
+
+  image_of<double> depth(ni, nj);
+  image_of<double> uncertainty(ni, nj);
+  for (unsigned j = 0; j < nj; ++j)
+  {
+    for (unsigned i = 0; i < ni; ++i)
+    {
+      depth(i, j) = (i == 0 && j == 0) ? 0.0 : 5.0;
+      uncertainty(i, j) = (i % 2) ? 1.0 : 0.1;
+    }
+  }
+  image_of<unsigned char> color(width, height, 3);
+  for (unsigned j = 0; j < height; ++j)
+  {
+    for (unsigned i = 0; i < width; ++i)
+    {
+      color(i, j, 0) = static_cast<unsigned char>(i);
+      color(i, j, 1) = static_cast<unsigned char>(j);
+      color(i, j, 2) = 7;
+    }
+  }
+
+  std::vector<image_container_sptr> const depths(
+    2, std::make_shared<simple_image_container>(depth));
+  std::vector<image_container_sptr> const uncertainties(
+    2, std::make_shared<simple_image_container>(uncertainty));
+  std::vector<image_container_sptr> const colors(
+    2, std::make_shared<simple_image_container>(color));
+  std::vector<camera_perspective_sptr> const cameras(2, cam);
+
+  auto cloud = depth_maps_to_pointcloud(depths, cameras, uncertainties, 0.5,
+                                        colors, { crop, crop });
+
+  // odd columns are too uncertain and the first pixel has no depth
+  auto const points = cloud->positions();
+  auto const point_colors = cloud->colors();
+  ASSERT_EQ(2 * (ni * nj / 2 - 1), points.size());
+  ASSERT_EQ(points.size(), point_colors.size());
+  for (size_t n = 0; n < points.size(); ++n)
+  {
+    vector_2d const pt = cam->project(points[n]);
+    EXPECT_NEAR(point_colors[n].r, pt.x(), 1e-6);
+    EXPECT_NEAR(point_colors[n].g, pt.y(), 1e-6);
+    EXPECT_EQ(7, point_colors[n].b);
+    EXPECT_EQ(0, (static_cast<int>(std::round(pt.x())) - crop.min_x()) % 2);
+  }
+
+  EXPECT_THROW(depth_maps_to_pointcloud(depths, { cam }),
+               invalid_value);
+}
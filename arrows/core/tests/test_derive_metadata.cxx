@@ -82,7 +82,7 @@ class derive_metadata : public ::testing::Test
   void
   SetUp()
   {
-    auto algo = kwiver::arrows::core::derive_metadata{};
+    kwiver::arrows::core::derive_metadata algo;
     derived_metadata = algo.filter( make_metadata(), make_image() );
   }
 
@@ -110,3 +110,67 @@ TEST_F( derive_metadata, compute_derived )
     derived_metadata.at( 0 )->find( kv::VITAL_META_WAVELENGTH ).as_string();
   EXPECT_EQ( std::string{ "NIR" }, wavelength );
 }
+
+// ----------------------------------------------------------------------------
+TEST_F( derive_metadata, changed_inputs )
+{
+  kwiver::arrows::core::derive_metadata algo;
+  auto const image = make_image();
+
+  auto const first = algo.filter( make_metadata(), image );
+  auto const gsd = first.at( 0 )->find( kv::VITAL_META_AVERAGE_GSD );
+  ASSERT_TRUE( gsd );
+
+  // Same inputs give the same values
+  auto const repeated = algo.filter( make_metadata(), image );
+  EXPECT_EQ( gsd.as_double(),
+             repeated.at( 0 )->find( kv::VITAL_META_AVERAGE_GSD ).as_double() );
+
+  // A changed input changes the fields which depend on it
+  auto changed = make_metadata();
+  changed.at( 0 )->add< kv::VITAL_META_SLANT_RANGE >( 2 * 13296.55762 );
+  changed.at( 0 )->add< kv::VITAL_META_IMAGE_SOURCE_SENSOR >( "EO" );
+  auto const result = algo.filter( changed, image );
+  EXPECT_NEAR( 2 * gsd.as_double(),
+               result.at( 0 )->find( kv::VITAL_META_AVERAGE_GSD ).as_double(),
+               0.001 );
+  EXPECT_GT( first.at( 0 )->find( kv::VITAL_META_VNIIRS ).as_double(),
+             result.at( 0 )->find( kv::VITAL_META_VNIIRS ).as_double() );
+  EXPECT_EQ( "VIS",
+             result.at( 0 )->find( kv::VITAL_META_WAVELENGTH ).as_string() );
+
+  // So does a different frame size
+  auto const small_image = std::make_shared< kv::simple_image_container >(
+    kv::image{ 640, 360 } );
+  auto const resized = algo.filter( make_metadata(), small_image );
+  EXPECT_NEAR( 2 * gsd.as_double(),
+               resized.at( 0 )->find( kv::VITAL_META_AVERAGE_GSD ).as_double(),
+               0.001 );
+
+  // Without an image, only the fields which do not need one are derived
+  auto const no_image = algo.filter( make_metadata(), nullptr );
+  EXPECT_FALSE( no_image.at( 0 )->has( kv::VITAL_META_AVERAGE_GSD ) );
+  EXPECT_FALSE( no_image.at( 0 )->has( kv::VITAL_META_VNIIRS ) );
+  EXPECT_TRUE( no_image.at( 0 )->has( kv::VITAL_META_WAVELENGTH ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F( derive_metadata, selected_fields )
+{
+  kwiver::arrows::core::derive_metadata algo;
+  auto config = algo.get_configuration();
+  EXPECT_EQ( "wavelength, slant_range, average_gsd, vniirs",
+             config->get_value< std::string >( "fields" ) );
+
+  config->set_value( "fields", "wavelength,average_gsd" );
+  EXPECT_TRUE( algo.check_configuration( config ) );
+  algo.set_configuration( config );
+
+  auto const result = algo.filter( make_metadata(), make_image() );
+  EXPECT_TRUE( result.at( 0 )->has( kv::VITAL_META_WAVELENGTH ) );
+  EXPECT_TRUE( result.at( 0 )->has( kv::VITAL_META_AVERAGE_GSD ) );
+  EXPECT_FALSE( result.at( 0 )->has( kv::VITAL_META_VNIIRS ) );
+
+  config->set_value( "fields", "wavelength, frame_corners" );
+  EXPECT_FALSE( algo.check_configuration( config ) );
+}
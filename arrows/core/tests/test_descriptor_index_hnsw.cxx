@@ -0,0 +1,201 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test core HNSW descriptor index
+
+#include <test_gtest.h>
+#include <test_tmpfn.h>
+
+#include <arrows/core/descriptor_index_hnsw.h>
+
+#include <vital/exceptions/base.h>
+#include <vital/exceptions/io.h>
+#include <vital/plugin_loader/plugin_manager.h>
+
+#include <algorithm>
+#include <random>
+
+#include <cstdio>
+
+namespace kv = kwiver::vital;
+
+using kwiver::arrows::core::descriptor_index_hnsw;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+std::vector< kv::descriptor_sptr >
+random_descriptors( size_t count, size_t size, unsigned seed )
+{
+  std::mt19937 rng( seed );
+  std::uniform_real_distribution< double > dist( 0.0, 1.0 );
+  std::vector< kv::descriptor_sptr > result;
+  for( size_t i = 0; i < count; ++i )
+  {
+    auto const desc = std::make_shared< kv::descriptor_dynamic< double > >( size );
+    std::generate( desc->raw_data(), desc->raw_data() + size,
+                   [ & ]{ return dist( rng ); } );
+    result.push_back( desc );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+// Indices of the k descriptors nearest to a query
+std::vector< size_t >
+exact_nearest( std::vector< kv::descriptor_sptr > const& descriptors,
+               kv::descriptor_sptr const& query, size_t k )
+{
+  auto const q = query->as_double();
+  std::vector< std::pair< double, size_t > > order;
+  for( size_t i = 0; i < descriptors.size(); ++i )
+  {
+    auto const d = descriptors[ i ]->as_double();
+    double sum = 0.0;
+    for( size_t j = 0; j < d.size(); ++j )
+    {
+      sum += ( d[ j ] - q[ j ] ) * ( d[ j ] - q[ j ] );
+    }
+    order.emplace_back( sum, i );
+  }
+  std::partial_sort( order.begin(), order.begin() + k, order.end() );
+
+  std::vector< size_t > result;
+  for( size_t i = 0; i < k; ++i )
+  {
+    result.push_back( order[ i ].second );
+  }
+  return result;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST ( descriptor_index_hnsw, empty )
+{
+  descriptor_index_hnsw index;
+  EXPECT_EQ( 0, index.size() );
+
+  std::vector< std::vector< size_t > > indices;
+  std::vector< std::vector< double > > distances;
+  index.find_nearest( random_descriptors( 3, 8, 1 ), 5, indices, distances );
+  ASSERT_EQ( 3, indices.size() );
+  ASSERT_EQ( 3, distances.size() );
+  for( size_t i = 0; i < 3; ++i )
+  {
+    EXPECT_TRUE( indices[ i ].empty() );
+    EXPECT_TRUE( distances[ i ].empty() );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( descriptor_index_hnsw, recall )
+{
+  auto const descriptors = random_descriptors( 3000, 16, 2 );
+  auto const queries = random_descriptors( 50, 16, 3 );
+  constexpr size_t k = 10;
+
+  descriptor_index_hnsw index;
+  // Adding in batches gives consecutive indices
+  index.add( { descriptors.begin(), descriptors.begin() + 1000 } );
+  index.add( { descriptors.begin() + 1000, descriptors.end() } );
+  ASSERT_EQ( descriptors.size(), index.size() );
+
+  std::vector< std::vector< size_t > > indices;
+  std::vector< std::vector< double > > distances;
+  index.find_nearest( queries, k, indices, distances );
+  ASSERT_EQ( queries.size(), indices.size() );
+
+  size_t found = 0;
+  for( size_t i = 0; i < queries.size(); ++i )
+  {
+    ASSERT_EQ( k, indices[ i ].size() );
+    ASSERT_EQ( k, distances[ i ].size() );
+    EXPECT_TRUE( std::is_sorted( distances[ i ].begin(),
+                                 distances[ i ].end() ) );
+
+    auto const exact = exact_nearest( descriptors, queries[ i ], k );
+    for( auto const n : indices[ i ] )
+    {
+      found += std::count( exact.begin(), exact.end(), n );
+    }
+  }
+  EXPECT_GE( found, queries.size() * k * 95 / 100 );
+
+  // Each descriptor is its own nearest neighbor
+  index.find_nearest( { descriptors[ 1234 ] }, 1, indices, distances );
+  ASSERT_EQ( 1, indices[ 0 ].size() );
+  EXPECT_EQ( 1234, indices[ 0 ][ 0 ] );
+  EXPECT_NEAR( 0.0, distances[ 0 ][ 0 ], 1e-6 );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( descriptor_index_hnsw, mismatched_size )
+{
+  descriptor_index_hnsw index;
+  index.add( random_descriptors( 10, 8, 4 ) );
+
+  // Nothing is added from a batch with an invalid descriptor
+  auto batch = random_descriptors( 5, 8, 5 );
+  batch.push_back( random_descriptors( 1, 4, 6 )[ 0 ] );
+  EXPECT_THROW( index.add( batch ), kv::invalid_value );
+  EXPECT_EQ( 10, index.size() );
+
+  std::vector< std::vector< size_t > > indices;
+  std::vector< std::vector< double > > distances;
+  EXPECT_THROW(
+    index.find_nearest( random_descriptors( 1, 4, 7 ), 1, indices, distances ),
+    kv::invalid_value );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( descriptor_index_hnsw, save_and_load )
+{
+  auto const descriptors = random_descriptors( 500, 12, 8 );
+  auto const queries = random_descriptors( 20, 12, 9 );
+  auto const filename =
+    kwiver::testing::temp_file_name( "test_descriptor_index_hnsw-", ".hnsw" );
+
+  descriptor_index_hnsw index;
+  index.add( descriptors );
+  index.save( filename );
+
+  std::vector< std::vector< size_t > > indices, loaded_indices;
+  std::vector< std::vector< double > > distances, loaded_distances;
+  index.find_nearest( queries, 5, indices, distances );
+
+  {
+    descriptor_index_hnsw loaded;
+    loaded.load( filename );
+    ASSERT_EQ( descriptors.size(), loaded.size() );
+    loaded.find_nearest( queries, 5, loaded_indices, loaded_distances );
+    EXPECT_EQ( indices, loaded_indices );
+    EXPECT_EQ( distances, loaded_distances );
+
+    // A loaded index can grow and be saved over the file it came from
+    auto const more = random_descriptors( 10, 12, 10 );
+    loaded.add( more );
+    EXPECT_EQ( descriptors.size() + more.size(), loaded.size() );
+    loaded.save( filename );
+    loaded.find_nearest( { more[ 3 ] }, 1, loaded_indices, loaded_distances );
+    EXPECT_EQ( descriptors.size() + 3, loaded_indices[ 0 ][ 0 ] );
+  }
+
+  descriptor_index_hnsw reloaded;
+  reloaded.load( filename );
+  EXPECT_EQ( descriptors.size() + 10, reloaded.size() );
+  std::remove( filename.c_str() );
+
+  EXPECT_THROW( reloaded.load( filename ), kv::file_not_found_exception );
+}
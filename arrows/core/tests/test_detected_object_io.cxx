@@ -5,11 +5,21 @@
 /// \file
 /// \brief test detected object io
 
+#include <test_tmpfn.h>
+
 #include <arrows/core/detected_object_set_input_csv.h>
+#include <arrows/core/detected_object_set_input_kw18.h>
 #include <arrows/core/detected_object_set_output_csv.h>
+#include <arrows/core/read_object_track_set_kw18.h>
+#include <arrows/core/read_object_track_set_kwt.h>
+#include <arrows/core/write_object_track_set_kwt.h>
+
+#include <vital/exceptions.h>
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <memory>
@@ -80,6 +90,91 @@ make_dos()
   return do_set;
 }
 
+// ----------------------------------------------------------------------------
+// Write text to a temporary file, removed when the object is destroyed
+struct temp_text_file
+{
+  explicit temp_text_file( std::string const& text )
+    : name( kwiver::testing::temp_file_name( "test-", ".txt" ) )
+  {
+    std::ofstream( name, std::ios::binary ) << text;
+  }
+
+  ~temp_text_file() { std::remove( name.c_str() ); }
+
+  std::string const name;
+};
+
+// ----------------------------------------------------------------------------
+void
+expect_equal( kwiver::vital::detected_object_set_sptr const& expected,
+              kwiver::vital::detected_object_set_sptr const& actual )
+{
+  ASSERT_EQ( expected->size(), actual->size() );
+  for ( size_t i = 0; i < expected->size(); ++i )
+  {
+    auto const& e = expected->at( i );
+    auto const& a = actual->at( i );
+    EXPECT_EQ( e->bounding_box(), a->bounding_box() );
+    EXPECT_EQ( e->confidence(), a->confidence() );
+    ASSERT_EQ( !!e->type(), !!a->type() );
+    if ( e->type() )
+    {
+      EXPECT_EQ( e->type()->class_names(), a->type()->class_names() );
+      for ( auto const& name : e->type()->class_names() )
+      {
+        EXPECT_EQ( e->type()->score( name ), a->type()->score( name ) );
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Read every set of a file, both mapped and from a stream, and compare them
+template < typename Reader >
+void
+compare_file_and_stream( std::string const& text )
+{
+  temp_text_file const file{ text };
+  std::stringstream str{ text };
+
+  Reader file_reader;
+  Reader stream_reader;
+  file_reader.open( file.name );
+  stream_reader.use_stream( &str );
+
+  kwiver::vital::detected_object_set_sptr expected, actual;
+  std::string expected_name, actual_name;
+  for ( ;; )
+  {
+    bool const more = stream_reader.read_set( expected, expected_name );
+    ASSERT_EQ( more, file_reader.read_set( actual, actual_name ) );
+    EXPECT_EQ( stream_reader.at_eof(), file_reader.at_eof() );
+    if ( ! more )
+    {
+      break;
+    }
+    EXPECT_EQ( expected_name, actual_name );
+    expect_equal( expected, actual );
+  }
+}
+
+// ----------------------------------------------------------------------------
+std::string
+kw18_line( int id, int frame, double x, double y, double time,
+           double confidence )
+{
+  std::ostringstream str;
+  str.precision( 17 );
+  str << id << " 1 " << frame << " 0 0 0 0 0 0 " << x << " " << y << " "
+      << x + 10.5 << " " << y + 20.25 << " 0 0 0 0 " << time;
+  if ( confidence >= 0 )
+  {
+    str << " " << confidence;
+  }
+  return str.str();
+}
+
 } // end namespace
 
 // ----------------------------------------------------------------------------
@@ -117,3 +212,215 @@ TEST(detected_object_io, stream_io)
   EXPECT_FALSE( reader.read_set( idos, name ) );
   EXPECT_TRUE( reader.at_eof() );
 }
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_io, csv_file_io)
+{
+  std::string text =
+    "# frame, image, box, confidence, classes\n"
+    "1,image_1,10,20,30,40,0.5,person,0.25,vehicle,0.75\n"
+    "1,image_1,1.5,2.5,3.5,4.5,0.875\r\n"
+    "\n"
+    "2,image_2,5,6,7,8,1e-3 # trailing comment\n";
+  for ( int i = 0; i < 5000; ++i )
+  {
+    text += std::to_string( 3 + i / 7 ) + ",image," + std::to_string( i ) +
+            ".125,0.1,17,18.333333333333332,0.3,clam,0.06\n";
+  }
+
+  compare_file_and_stream< kac::detected_object_set_input_csv >( text );
+  compare_file_and_stream< kac::detected_object_set_input_csv >( "" );
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_io, csv_file_errors)
+{
+  temp_text_file const few{ "1,image,1,2,3,4,0.5\n\n1,image,1,2\n" };
+  kac::detected_object_set_input_csv reader;
+  reader.open( few.name );
+
+  kwiver::vital::detected_object_set_sptr set;
+  std::string name;
+  try
+  {
+    reader.read_set( set, name );
+    FAIL() << "Expected invalid_data";
+  }
+  catch ( kwiver::vital::invalid_data const& e )
+  {
+    EXPECT_NE( std::string::npos,
+               std::string( e.what() ).find( "Too few field in input at line 3" ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_io, kw18_file_io)
+{
+  std::string text = "# kw18 header\n";
+  for ( int i = 0; i < 5000; ++i )
+  {
+    text += kw18_line( i % 13, ( i * 7 ) % 101, i * 0.1, i / 3.0, i,
+                       ( i % 2 ? -1.0 : i / 5000.0 ) ) + "\n";
+  }
+
+  compare_file_and_stream< kac::detected_object_set_input_kw18 >( text );
+
+  temp_text_file const bad{ text + "1 2 3\n" };
+  kac::detected_object_set_input_kw18 reader;
+  reader.open( bad.name );
+
+  kwiver::vital::detected_object_set_sptr set;
+  std::string name;
+  EXPECT_THROW( reader.read_set( set, name ), kwiver::vital::invalid_data );
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_io, kw18_track_file_io)
+{
+  std::string text;
+  for ( int i = 0; i < 5000; ++i )
+  {
+    text += kw18_line( ( i / 10 ) % 37, i / 20, i * 0.1, i / 3.0, i * 1000.0,
+                       ( i % 3 ? -1.0 : 0.5 ) ) + "\n";
+  }
+
+  for ( bool const batch : { true, false } )
+  {
+    SCOPED_TRACE( batch );
+
+    auto config = kwiver::vital::config_block::empty_config();
+    config->set_value( "batch_load", batch );
+
+    temp_text_file const file{ text };
+    std::stringstream str{ text };
+
+    kac::read_object_track_set_kw18 file_reader;
+    kac::read_object_track_set_kw18 stream_reader;
+    file_reader.set_configuration( config );
+    stream_reader.set_configuration( config );
+    file_reader.open( file.name );
+    stream_reader.use_stream( &str );
+
+    for ( int n = 0; n < 300; ++n )
+    {
+      kwiver::vital::object_track_set_sptr expected, actual;
+      bool const more = stream_reader.read_set( expected );
+      ASSERT_EQ( more, file_reader.read_set( actual ) );
+      if ( ! expected )
+      {
+        break;
+      }
+
+      auto const expected_tracks = expected->tracks();
+      auto const actual_tracks = actual->tracks();
+      ASSERT_EQ( expected_tracks.size(), actual_tracks.size() );
+      for ( size_t t = 0; t < expected_tracks.size(); ++t )
+      {
+        auto const& et = expected_tracks[ t ];
+        auto const& at = actual_tracks[ t ];
+        EXPECT_EQ( et->id(), at->id() );
+        ASSERT_EQ( et->size(), at->size() );
+        for ( auto e = et->begin(), a = at->begin(); e != et->end(); ++e, ++a )
+        {
+          auto const es =
+            std::static_pointer_cast< kwiver::vital::object_track_state >( *e );
+          auto const as =
+            std::static_pointer_cast< kwiver::vital::object_track_state >( *a );
+          EXPECT_EQ( es->frame(), as->frame() );
+          EXPECT_EQ( es->time(), as->time() );
+          EXPECT_EQ( es->detection()->bounding_box(),
+                     as->detection()->bounding_box() );
+          EXPECT_EQ( es->detection()->confidence(),
+                     as->detection()->confidence() );
+        }
+      }
+      if ( batch )
+      {
+        break;
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_io, kwt_track_io)
+{
+  std::string text;
+  for ( int i = 0; i < 500; ++i )
+  {
+    text += kw18_line( i % 37, i / 37, i * 0.1, i / 3.0, i / 37 * 1000.0,
+                       0.5 ) + "\n";
+  }
+
+  std::stringstream kw18{ text };
+  kac::read_object_track_set_kw18 kw18_reader;
+  kw18_reader.use_stream( &kw18 );
+  kwiver::vital::object_track_set_sptr tracks;
+  ASSERT_TRUE( kw18_reader.read_set( tracks ) );
+
+  // Write the tracks both to a file and to a stream
+  auto const file_name = kwiver::testing::temp_file_name( "test-", ".kwt" );
+  std::stringstream str;
+  {
+    kac::write_object_track_set_kwt file_writer;
+    kac::write_object_track_set_kwt stream_writer;
+    file_writer.open( file_name );
+    stream_writer.use_stream( &str );
+    file_writer.write_set( tracks );
+    stream_writer.write_set( tracks );
+    file_writer.close();
+    stream_writer.close();
+  }
+
+  for ( bool const batch : { true, false } )
+  {
+    SCOPED_TRACE( batch );
+
+    auto config = kwiver::vital::config_block::empty_config();
+    config->set_value( "batch_load", batch );
+
+    str.clear();
+    str.seekg( 0 );
+
+    kac::read_object_track_set_kwt file_reader;
+    kac::read_object_track_set_kwt stream_reader;
+    file_reader.set_configuration( config );
+    stream_reader.set_configuration( config );
+    file_reader.open( file_name );
+    stream_reader.use_stream( &str );
+
+    size_t states = 0;
+    kwiver::vital::object_track_set_sptr actual, expected;
+    kwiver::vital::frame_id_t frame = 0;
+    while ( file_reader.read_set( actual ) )
+    {
+      ASSERT_TRUE( stream_reader.read_set( expected ) );
+      ASSERT_EQ( expected->size(), actual->size() );
+      for ( auto const& trk : actual->tracks() )
+      {
+        auto const original = tracks->get_track( trk->id() );
+        ASSERT_TRUE( original );
+        ASSERT_EQ( batch ? original->size() : 1, trk->size() );
+        for ( auto const& ts : *trk )
+        {
+          auto const os = std::static_pointer_cast<
+            kwiver::vital::object_track_state >( *original->find( ts->frame() ) );
+          auto const as =
+            std::static_pointer_cast< kwiver::vital::object_track_state >( ts );
+          EXPECT_EQ( batch ? ts->frame() : frame, ts->frame() );
+          EXPECT_EQ( os->time(), as->time() );
+          EXPECT_EQ( os->detection()->bounding_box(),
+                     as->detection()->bounding_box() );
+          EXPECT_EQ( os->detection()->confidence(),
+                     as->detection()->confidence() );
+          ++states;
+        }
+      }
+      ++frame;
+    }
+    EXPECT_FALSE( stream_reader.read_set( expected ) );
+    EXPECT_EQ( 500, states );
+  }
+
+  std::remove( file_name.c_str() );
+}
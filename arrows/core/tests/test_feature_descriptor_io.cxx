@@ -5,6 +5,7 @@
 #include <test_tmpfn.h>
 
 #include <arrows/core/feature_descriptor_io.h>
+#include <vital/types/packed_descriptor_set.h>
 #include <vital/plugin_loader/plugin_manager.h>
 
 #include <gtest/gtest.h>
@@ -326,3 +327,85 @@ TEST(feature_descriptor_io, write_mixed_descriptor_type)
     << "Expected exception saving a mixture of descriptor types";
   EXPECT_EQ(0, std::remove(filename.c_str()));
 }
+
+namespace {
+
+// ----------------------------------------------------------------------------
+kwiver::vital::config_block_sptr
+columnar_config(bool map_descriptors)
+{
+  auto config = kwiver::vital::config_block::empty_config();
+  config->set_value("write_columnar", true);
+  config->set_value("map_descriptors", map_descriptors);
+  return config;
+}
+
+}
+
+// ----------------------------------------------------------------------------
+// Test writing and reading the columnar format
+TEST(feature_descriptor_io, read_write_columnar)
+{
+  using namespace kwiver::arrows;
+  auto const filename = kwiver::testing::temp_file_name( "test-", ".kwfd" );
+
+  feature_set_sptr features = make_n_features<double>(50);
+  descriptor_set_sptr descriptors = make_n_descriptors<uint8_t>(50, 96);
+
+  for( bool map_descriptors : { false, true } )
+  {
+    core::feature_descriptor_io fd_io;
+    fd_io.set_configuration(columnar_config(map_descriptors));
+    fd_io.save(filename, features, descriptors);
+
+    feature_set_sptr loaded_features;
+    descriptor_set_sptr loaded_descriptors;
+    fd_io.load(filename, loaded_features, loaded_descriptors);
+
+    EXPECT_TRUE(equal_feature_set(features, loaded_features));
+    EXPECT_TRUE(equal_descriptor_set(descriptors, loaded_descriptors));
+    EXPECT_NE(nullptr,
+      std::dynamic_pointer_cast<packed_descriptor_set<uint8_t> >(
+        loaded_descriptors));
+
+    // the default configuration reads the columnar format too
+    core::feature_descriptor_io default_io;
+    default_io.load(filename, loaded_features, loaded_descriptors);
+    EXPECT_TRUE(equal_feature_set(features, loaded_features));
+    EXPECT_TRUE(equal_descriptor_set(descriptors, loaded_descriptors));
+  }
+
+  // only features, converted to float
+  auto config = columnar_config(false);
+  config->set_value("write_float_features", true);
+  core::feature_descriptor_io fd_io;
+  fd_io.set_configuration(config);
+  fd_io.save(filename, make_n_features<float>(20), descriptor_set_sptr{});
+
+  feature_set_sptr loaded_features;
+  descriptor_set_sptr loaded_descriptors;
+  fd_io.load(filename, loaded_features, loaded_descriptors);
+  EXPECT_EQ(nullptr, loaded_descriptors);
+  EXPECT_TRUE(equal_feature_set(make_n_features<float>(20), loaded_features));
+  EXPECT_EQ(0, std::remove(filename.c_str()));
+}
+
+// ----------------------------------------------------------------------------
+// Test writing a mix of descriptor dimensions in the columnar format
+TEST(feature_descriptor_io, write_columnar_mixed_descriptor_dim)
+{
+  using namespace kwiver::arrows;
+  auto const filename = kwiver::testing::temp_file_name( "test-", ".kwfd" );
+
+  descriptor_set_sptr descriptors1 = make_n_descriptors<float>(50, 128);
+  descriptor_set_sptr descriptors2 = make_n_descriptors<float>(50, 64);
+  std::vector<descriptor_sptr> desc1 = descriptors1->descriptors();
+  desc1.insert(desc1.end(), descriptors2->cbegin(), descriptors2->cend());
+  descriptor_set_sptr descriptors = std::make_shared<simple_descriptor_set>(desc1);
+
+  core::feature_descriptor_io fd_io;
+  fd_io.set_configuration(columnar_config(false));
+  EXPECT_THROW(fd_io.save(filename, feature_set_sptr{}, descriptors),
+               kwiver::vital::invalid_data)
+    << "Expected exception saving a mixture of descriptor dimensions";
+}
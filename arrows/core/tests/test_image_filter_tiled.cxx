@@ -0,0 +1,169 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test tiled image filter
+
+#include <test_gtest.h>
+
+#include <arrows/core/image_filter_tiled.h>
+
+#include <vital/algo/algorithm_factory.h>
+#include <vital/plugin_loader/plugin_manager.h>
+#include <vital/types/image_container.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace kv = kwiver::vital;
+namespace algo = kwiver::vital::algo;
+
+using kwiver::arrows::core::image_filter_tiled;
+
+namespace {
+
+std::atomic< int > num_filters{ 0 };
+
+// ----------------------------------------------------------------------------
+// Average each pixel with its horizontal neighbors, clamped at the edges
+class test_filter : public algo::image_filter
+{
+public:
+  PLUGIN_INFO( "test_horizontal_mean",
+               "Averages each pixel with its horizontal neighbors." )
+
+  test_filter() { ++num_filters; }
+
+  void set_configuration( kv::config_block_sptr ) override {}
+  bool check_configuration( kv::config_block_sptr ) const override
+  {
+    return true;
+  }
+
+  kv::image_container_sptr
+  filter( kv::image_container_sptr image_data ) override
+  {
+    kv::image_of< kv::byte > const in{ image_data->get_image() };
+    kv::image_of< kv::byte > out{ in.width(), in.height(), in.depth() };
+    int const last = static_cast< int >( in.width() ) - 1;
+    for( size_t k = 0; k < in.depth(); ++k )
+    {
+      for( size_t j = 0; j < in.height(); ++j )
+      {
+        for( int i = 0; i <= last; ++i )
+        {
+          int const sum = in( std::max( i - 1, 0 ), j, k ) + in( i, j, k ) +
+                          in( std::min( i + 1, last ), j, k );
+          out( i, j, k ) = static_cast< kv::byte >( sum / 3 );
+        }
+      }
+    }
+    return std::make_shared< kv::simple_image_container >( out );
+  }
+};
+
+// ----------------------------------------------------------------------------
+kv::image_container_sptr
+make_image()
+{
+  kv::image_of< kv::byte > img{ 50, 37, 2 };
+  for( size_t k = 0; k < img.depth(); ++k )
+  {
+    for( size_t j = 0; j < img.height(); ++j )
+    {
+      for( size_t i = 0; i < img.width(); ++i )
+      {
+        img( i, j, k ) = static_cast< kv::byte >( ( i * 37 + j * 11 + k ) % 251 );
+      }
+    }
+  }
+  return std::make_shared< kv::simple_image_container >( img );
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< image_filter_tiled >
+make_filter( unsigned max_instances )
+{
+  auto config = kv::config_block::empty_config();
+  config->set_value( "tile_width", 16 );
+  config->set_value( "tile_height", 12 );
+  config->set_value( "overlap", 4 );
+  config->set_value( "max_instances", max_instances );
+  config->set_value( "filter:type", "test_horizontal_mean" );
+
+  auto filter = std::make_shared< image_filter_tiled >();
+  filter->set_configuration( config );
+  EXPECT_TRUE( filter->check_configuration( filter->get_configuration() ) );
+  return filter;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+
+  kv::plugin_manager::instance().add_factory(
+    new kv::algorithm_factory_0< test_filter >(
+      test_filter::static_type_name(), test_filter::_plugin_name ) );
+
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST ( image_filter_tiled, matches_full_image )
+{
+  auto const input = make_image();
+  auto const expected = test_filter{}.filter( input );
+
+  for( auto const max_instances : { 1u, 3u } )
+  {
+    SCOPED_TRACE( "Instances: " + std::to_string( max_instances ) );
+
+    auto const filter = make_filter( max_instances );
+    // count the configured instance and those created while processing
+    num_filters = 1;
+    auto const result = filter->filter( input );
+    ASSERT_NE( nullptr, result );
+    EXPECT_TRUE( kv::equal_content( expected->get_image(),
+                                    result->get_image() ) );
+    EXPECT_GE( static_cast< int >( max_instances ), num_filters );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( image_filter_tiled, region_of_interest )
+{
+  auto const input = make_image();
+  auto const expected = test_filter{}.filter( input );
+
+  auto const filter = make_filter( 1 );
+  auto config = kv::config_block::empty_config();
+  config->set_value( "roi_x", 10 );
+  config->set_value( "roi_y", 5 );
+  config->set_value( "roi_width", 25 );
+  filter->set_configuration( config );
+
+  // the edges of the region see only pixels inside it, so compare within
+  auto const result = filter->filter( input )->get_image();
+  auto const in = input->get_image();
+  for( size_t j = 0; j < in.height(); ++j )
+  {
+    for( size_t i = 0; i < in.width(); ++i )
+    {
+      bool const inside = i >= 11 && i < 34 && j >= 5;
+      bool const outside = i < 10 || i >= 35 || j < 5;
+      auto const& ref = ( inside ? expected->get_image() : in );
+      if( inside || outside )
+      {
+        ASSERT_EQ( ref.at< kv::byte >( i, j, 1 ),
+                   result.at< kv::byte >( i, j, 1 ) )
+          << "at " << i << ", " << j;
+      }
+    }
+  }
+}
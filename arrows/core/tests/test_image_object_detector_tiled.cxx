@@ -0,0 +1,183 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test tiled object detector
+
+#include <test_gtest.h>
+
+#include <arrows/core/image_object_detector_tiled.h>
+
+#include <vital/algo/algorithm_factory.h>
+#include <vital/plugin_loader/plugin_manager.h>
+#include <vital/types/detected_object_set.h>
+#include <vital/types/image_container.h>
+
+#include <atomic>
+#include <set>
+#include <tuple>
+
+namespace kv = kwiver::vital;
+namespace algo = kwiver::vital::algo;
+
+using kwiver::arrows::core::image_object_detector_tiled;
+
+namespace {
+
+std::atomic< int > num_detectors{ 0 };
+
+constexpr int object_size = 8;
+
+// ----------------------------------------------------------------------------
+// Detect an object below and right of each marked pixel
+class test_detector : public algo::image_object_detector
+{
+public:
+  PLUGIN_INFO( "test_markers",
+               "Detects an object at each marked pixel." )
+
+  test_detector() { ++num_detectors; }
+
+  void set_configuration( kv::config_block_sptr ) override {}
+  bool check_configuration( kv::config_block_sptr ) const override
+  {
+    return true;
+  }
+
+  kv::detected_object_set_sptr
+  detect( kv::image_container_sptr image_data ) const override
+  {
+    auto result = std::make_shared< kv::detected_object_set >();
+    kv::image_of< kv::byte > const img{ image_data->get_image() };
+    for( size_t j = 0; j < img.height(); ++j )
+    {
+      for( size_t i = 0; i < img.width(); ++i )
+      {
+        if( img( i, j ) )
+        {
+          kv::bounding_box_d const box(
+            i, j, i + object_size, j + object_size );
+          result->add( std::make_shared< kv::detected_object >(
+            box, img( i, j ) / 255.0 ) );
+        }
+      }
+    }
+    return result;
+  }
+};
+
+using marker = std::tuple< int, int >;
+
+std::set< marker > const markers = {
+  marker{ 3, 4 }, marker{ 15, 9 }, marker{ 30, 30 }, marker{ 61, 2 },
+  marker{ 40, 44 }, marker{ 70, 50 } };
+
+// ----------------------------------------------------------------------------
+kv::image_container_sptr
+make_image()
+{
+  kv::image_of< kv::byte > img{ 80, 60, 1 };
+  for( size_t j = 0; j < img.height(); ++j )
+  {
+    for( size_t i = 0; i < img.width(); ++i )
+    {
+      img( i, j ) = 0;
+    }
+  }
+  for( auto const& m : markers )
+  {
+    img( std::get< 0 >( m ), std::get< 1 >( m ) ) = 200;
+  }
+  return std::make_shared< kv::simple_image_container >( img );
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< image_object_detector_tiled >
+make_detector( unsigned max_instances )
+{
+  auto config = kv::config_block::empty_config();
+  config->set_value( "tile_width", 32 );
+  config->set_value( "tile_height", 24 );
+  config->set_value( "overlap", 10 );
+  config->set_value( "max_instances", max_instances );
+  config->set_value( "detector:type", "test_markers" );
+
+  auto detector = std::make_shared< image_object_detector_tiled >();
+  detector->set_configuration( config );
+  EXPECT_TRUE( detector->check_configuration(
+    detector->get_configuration() ) );
+  return detector;
+}
+
+// ----------------------------------------------------------------------------
+std::set< marker >
+detected_markers( kv::detected_object_set_sptr const& detections )
+{
+  std::set< marker > result;
+  for( auto const& det : *detections )
+  {
+    auto const box = det->bounding_box();
+    EXPECT_EQ( object_size, box.width() );
+    EXPECT_EQ( object_size, box.height() );
+    result.emplace( static_cast< int >( box.min_x() ),
+                    static_cast< int >( box.min_y() ) );
+  }
+  return result;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+
+  kv::plugin_manager::instance().add_factory(
+    new kv::algorithm_factory_0< test_detector >(
+      test_detector::static_type_name(), test_detector::_plugin_name ) );
+
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST ( image_object_detector_tiled, merges_tiles )
+{
+  auto const input = make_image();
+
+  for( auto const max_instances : { 1u, 4u } )
+  {
+    SCOPED_TRACE( "Instances: " + std::to_string( max_instances ) );
+
+    auto const detector = make_detector( max_instances );
+    // count the configured instance and those created while processing
+    num_detectors = 1;
+    auto const detections = detector->detect( input );
+    ASSERT_NE( nullptr, detections );
+    // each object is found once, though several are in more than one tile
+    EXPECT_EQ( markers.size(), detections->size() );
+    EXPECT_EQ( markers, detected_markers( detections ) );
+    EXPECT_GE( static_cast< int >( max_instances ), num_detectors );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( image_object_detector_tiled, region_of_interest )
+{
+  auto const detector = make_detector( 1 );
+  auto config = kv::config_block::empty_config();
+  config->set_value( "roi_x", 10 );
+  config->set_value( "roi_y", 5 );
+  config->set_value( "roi_width", 50 );
+  config->set_value( "roi_height", 40 );
+  detector->set_configuration( config );
+
+  auto const results = detector->batch_detect( { make_image(), make_image() } );
+  ASSERT_EQ( 2, results.size() );
+  std::set< marker > const expected = {
+    marker{ 15, 9 }, marker{ 30, 30 }, marker{ 40, 44 } };
+  EXPECT_EQ( expected, detected_markers( results[ 0 ] ) );
+  EXPECT_EQ( expected, detected_markers( results[ 1 ] ) );
+}
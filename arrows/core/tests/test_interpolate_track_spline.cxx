@@ -98,3 +98,88 @@ TEST(interpolate_track_spline, linear)
   check_track_state( new_track, 18, { 230, 230, 280, 280 }, 0.68 );
   check_track_state( new_track, 25, { 200, 300, 250, 350 }, 0.375 );
 }
+
+// ----------------------------------------------------------------------------
+TEST(interpolate_track_spline, empty)
+{
+  kac::interpolate_track_spline its;
+
+  auto key_track = kv::track::create();
+  key_track->set_id( 5 );
+  key_track->append( std::make_shared< kv::object_track_state >( 3, 0 ) );
+
+  auto new_track = its.interpolate( key_track );
+  ASSERT_NE( nullptr, new_track );
+  EXPECT_EQ( 5, new_track->id() );
+  EXPECT_TRUE( new_track->empty() );
+  EXPECT_EQ( nullptr, its.interpolate( nullptr ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(interpolate_track_spline, batch)
+{
+  kac::interpolate_track_spline its;
+
+  std::vector< kv::track_sptr > key_tracks;
+  for ( int t = 0; t < 100; ++t )
+  {
+    auto key_track = kv::track::create();
+    key_track->set_id( t );
+    for ( int k = 0; k < 5; ++k )
+    {
+      auto const f = t + k * ( 3 + t % 7 );
+      add_track_state( key_track, f, { 1.0 * f, 2.0 * t, 1.0 * f + 10, 50 },
+                       0.1 * k );
+    }
+    key_tracks.push_back( key_track );
+  }
+
+  int calls = 0;
+  its.set_progress_callback( [ &calls ]( int, int ){ ++calls; } );
+
+  auto const new_tracks = its.batch_interpolate( key_tracks );
+  ASSERT_EQ( key_tracks.size(), new_tracks.size() );
+  EXPECT_LT( 0, calls );
+
+  for ( size_t t = 0; t < key_tracks.size(); ++t )
+  {
+    auto const expected = its.interpolate( key_tracks[ t ] );
+    auto const boxes = its.interpolate_boxes( *key_tracks[ t ] );
+    auto const& actual = new_tracks[ t ];
+
+    ASSERT_EQ( expected->size(), actual->size() );
+    ASSERT_EQ( expected->size(), boxes.size() );
+    EXPECT_EQ( expected->id(), actual->id() );
+    EXPECT_EQ( key_tracks[ t ]->last_frame() - key_tracks[ t ]->first_frame() + 1,
+               static_cast< kv::frame_id_t >( actual->size() ) );
+
+    for ( size_t i = 0; i < boxes.size(); ++i )
+    {
+      auto const& b = boxes[ i ];
+      auto const es = std::static_pointer_cast< kv::object_track_state >(
+        *( expected->begin() + i ) );
+      auto const as = std::static_pointer_cast< kv::object_track_state >(
+        *( actual->begin() + i ) );
+      EXPECT_EQ( actual, as->track() );
+      for ( auto const& s : { as, es } )
+      {
+        EXPECT_EQ( b.frame, s->frame() );
+        EXPECT_EQ( b.time, s->time() );
+        EXPECT_EQ( b.box, s->detection()->bounding_box() );
+        EXPECT_EQ( b.confidence, s->detection()->confidence() );
+      }
+
+      // Key states keep their detection
+      auto const key = key_tracks[ t ]->find( b.frame );
+      if ( key != key_tracks[ t ]->end() )
+      {
+        EXPECT_EQ( std::static_pointer_cast< kv::object_track_state >( *key )->detection(),
+                   b.detection );
+      }
+      else
+      {
+        EXPECT_EQ( nullptr, b.detection );
+      }
+    }
+  }
+}
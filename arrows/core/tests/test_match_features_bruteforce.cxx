@@ -0,0 +1,226 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test core brute force feature matching
+
+#include <test_gtest.h>
+
+#include <arrows/core/match_features_bruteforce.h>
+
+#include <vital/plugin_loader/plugin_manager.h>
+#include <vital/types/packed_descriptor_set.h>
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <random>
+
+namespace kv = kwiver::vital;
+namespace algo = kwiver::vital::algo;
+
+using kwiver::arrows::core::match_features_bruteforce;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+constexpr size_t num_desc = 300;
+
+// ----------------------------------------------------------------------------
+// Random descriptors, and a shuffled and perturbed copy of them
+template < typename T, typename Generator, typename Perturb >
+std::pair< kv::descriptor_set_sptr, kv::descriptor_set_sptr >
+make_sets( size_t dim, std::vector< unsigned >& permutation,
+           Generator generate, Perturb perturb )
+{
+  std::mt19937 rng( 1234 );
+  std::vector< T > data1( num_desc * dim );
+  for( auto& value : data1 )
+  {
+    value = generate( rng );
+  }
+
+  permutation.resize( num_desc );
+  std::iota( permutation.begin(), permutation.end(), 0u );
+  std::shuffle( permutation.begin(), permutation.end(), rng );
+
+  std::vector< T > data2( data1.size() );
+  for( size_t i = 0; i < num_desc; ++i )
+  {
+    auto const src = data1.begin() + i * dim;
+    auto const dst = data2.begin() + permutation[ i ] * dim;
+    std::copy( src, src + dim, dst );
+    perturb( rng, &*dst );
+  }
+
+  return { std::make_shared< kv::packed_descriptor_set< T > >(
+             std::move( data1 ), dim ),
+           std::make_shared< kv::packed_descriptor_set< T > >(
+             std::move( data2 ), dim ) };
+}
+
+// ----------------------------------------------------------------------------
+std::map< unsigned, unsigned >
+match_map( algo::match_features const& matcher,
+           kv::descriptor_set_sptr const& desc1,
+           kv::descriptor_set_sptr const& desc2 )
+{
+  std::map< unsigned, unsigned > result;
+  auto const matches = matcher.match( nullptr, desc1, nullptr, desc2 );
+  if( matches )
+  {
+    for( auto const& m : matches->matches() )
+    {
+      result.emplace( m.first, m.second );
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+void
+configure( match_features_bruteforce& matcher,
+           double ratio_threshold, bool cross_check,
+           std::string const& distance = "auto" )
+{
+  auto const config = matcher.get_configuration();
+  config->set_value( "ratio_threshold", ratio_threshold );
+  config->set_value( "cross_check", cross_check );
+  config->set_value( "distance", distance );
+  ASSERT_TRUE( matcher.check_configuration( config ) );
+  matcher.set_configuration( config );
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST ( match_features_bruteforce, create )
+{
+  EXPECT_NE( nullptr, algo::match_features::create( "brute_force" ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( match_features_bruteforce, hamming )
+{
+  std::vector< unsigned > permutation;
+  auto const sets = make_sets< kv::byte >(
+    32, permutation,
+    []( std::mt19937& rng ){
+      return static_cast< kv::byte >( rng() );
+    },
+    []( std::mt19937& rng, kv::byte* d ){
+      // Flip a few bits
+      for( int i = 0; i < 4; ++i )
+      {
+        auto const bit = rng() % 256;
+        d[ bit / 8 ] ^= static_cast< kv::byte >( 1 << ( bit % 8 ) );
+      }
+    } );
+
+  match_features_bruteforce matcher;
+  configure( matcher, 0.8, true );
+  auto const matches = match_map( matcher, sets.first, sets.second );
+  ASSERT_EQ( num_desc, matches.size() );
+  for( auto const& m : matches )
+  {
+    EXPECT_EQ( permutation[ m.first ], m.second );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( match_features_bruteforce, l2 )
+{
+  std::vector< unsigned > permutation;
+  auto const sets = make_sets< float >(
+    128, permutation,
+    []( std::mt19937& rng ){
+      return std::uniform_real_distribution< float >( 0.0f, 1.0f )( rng );
+    },
+    []( std::mt19937& rng, float* d ){
+      std::normal_distribution< float > noise( 0.0f, 0.01f );
+      for( size_t i = 0; i < 128; ++i )
+      {
+        d[ i ] += noise( rng );
+      }
+    } );
+
+  match_features_bruteforce matcher;
+  configure( matcher, 0.8, true );
+  auto const matches = match_map( matcher, sets.first, sets.second );
+  ASSERT_EQ( num_desc, matches.size() );
+  for( auto const& m : matches )
+  {
+    EXPECT_EQ( permutation[ m.first ], m.second );
+  }
+
+  // Non-packed descriptor sets give the same result
+  kv::simple_descriptor_set const simple1{ sets.first->descriptors() };
+  kv::simple_descriptor_set const simple2{ sets.second->descriptors() };
+  EXPECT_EQ( matches, match_map(
+    matcher, std::make_shared< kv::simple_descriptor_set >( simple1 ),
+    std::make_shared< kv::simple_descriptor_set >( simple2 ) ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( match_features_bruteforce, ratio_and_cross_check )
+{
+  // The first query is equally near the first two train descriptors, and the
+  // third query is nearer to the last train descriptor than the second is
+  auto const query = std::make_shared< kv::packed_descriptor_set< double > >(
+    std::vector< double >{ 0.0, 0.0,
+                           10.0, 0.0,
+                           9.5, 0.0 }, 2 );
+  auto const train = std::make_shared< kv::packed_descriptor_set< double > >(
+    std::vector< double >{ -1.0, 0.0,
+                           1.0, 0.0,
+                           9.0, 0.0 }, 2 );
+
+  match_features_bruteforce matcher;
+  configure( matcher, 0.0, false );
+  EXPECT_EQ( ( std::map< unsigned, unsigned >{ { 0, 0 }, { 1, 2 }, { 2, 2 } } ),
+             match_map( matcher, query, train ) );
+
+  configure( matcher, 0.0, true );
+  EXPECT_EQ( ( std::map< unsigned, unsigned >{ { 0, 0 }, { 2, 2 } } ),
+             match_map( matcher, query, train ) );
+
+  configure( matcher, 0.5, false );
+  EXPECT_EQ( ( std::map< unsigned, unsigned >{ { 1, 2 }, { 2, 2 } } ),
+             match_map( matcher, query, train ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( match_features_bruteforce, invalid )
+{
+  auto const bytes = std::make_shared< kv::packed_descriptor_set< kv::byte > >(
+    std::vector< kv::byte >{ 1, 2, 3, 4 }, 2 );
+  auto const floats = std::make_shared< kv::packed_descriptor_set< float > >(
+    std::vector< float >{ 1, 2, 3, 4 }, 2 );
+  auto const wide = std::make_shared< kv::packed_descriptor_set< float > >(
+    std::vector< float >{ 1, 2, 3, 4 }, 4 );
+
+  match_features_bruteforce matcher;
+  configure( matcher, 0.0, false, "hamming" );
+  EXPECT_EQ( nullptr, matcher.match( nullptr, floats, nullptr, floats ) );
+  EXPECT_NE( nullptr, matcher.match( nullptr, bytes, nullptr, bytes ) );
+
+  configure( matcher, 0.0, false );
+  EXPECT_EQ( nullptr, matcher.match( nullptr, floats, nullptr, wide ) );
+  EXPECT_EQ( nullptr, matcher.match( nullptr, floats, nullptr, bytes ) );
+  EXPECT_EQ( nullptr, matcher.match(
+    nullptr, floats, nullptr,
+    std::make_shared< kv::packed_descriptor_set< float > >() ) );
+
+  auto const config = matcher.get_configuration();
+  config->set_value( "ratio_threshold", 1.5 );
+  EXPECT_FALSE( matcher.check_configuration( config ) );
+}
@@ -0,0 +1,189 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test the mesh bounding volume hierarchy
+
+#include <test_gtest.h>
+#include <test_scene.h>
+
+#include <arrows/core/mesh_bvh.h>
+#include <arrows/core/mesh_intersect.h>
+
+#include <vital/exceptions/base.h>
+
+#include <random>
+
+#include <cmath>
+
+using namespace kwiver::vital;
+using namespace kwiver::arrows::core;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Two wavy sheets, one above the other, so that rays may hit several faces
+mesh_sptr
+generate_mesh()
+{
+  auto const lower = kwiver::testing::grid_mesh( 30, 20, 0.5 );
+  auto const upper = kwiver::testing::grid_mesh( 20, 30, 0.5,
+                                                 { 1.0, -2.0, 2.0 } );
+  auto verts = new mesh_vertex_array< 3 >;
+  auto faces = new mesh_regular_face_array< 3 >;
+  for( auto const& m : { lower, upper } )
+  {
+    auto const offset = static_cast< unsigned >( verts->size() );
+    for( auto v : m->vertices< 3 >() )
+    {
+      v[ 2 ] += 0.5 * std::sin( v[ 0 ] ) * std::cos( 0.7 * v[ 1 ] );
+      verts->push_back( v );
+    }
+    auto const& f =
+      static_cast< mesh_regular_face_array< 3 > const& >( m->faces() );
+    for( size_t i = 0; i < f.size(); ++i )
+    {
+      faces->push_back( { f[ i ][ 0 ] + offset, f[ i ][ 1 ] + offset,
+                          f[ i ][ 2 ] + offset } );
+    }
+  }
+
+  auto const result =
+    std::make_shared< mesh >( std::unique_ptr< mesh_vertex_array_base >( verts ),
+                              std::unique_ptr< mesh_face_array_base >( faces ) );
+  result->compute_face_normals( false );
+  return result;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST ( mesh_bvh, closest_point )
+{
+  auto const m = generate_mesh();
+  mesh_bvh const bvh{ *m };
+  EXPECT_EQ( m->num_faces(), bvh.size() );
+
+  std::mt19937 rng( 7 );
+  std::uniform_real_distribution< double > x( -3.0, 18.0 );
+  std::uniform_real_distribution< double > z( -3.0, 5.0 );
+  std::vector< point_3d > points;
+  for( int i = 0; i < 100; ++i )
+  {
+    points.emplace_back( x( rng ), x( rng ), z( rng ) );
+  }
+
+  std::vector< int > faces;
+  std::vector< point_3d > closest;
+  std::vector< vector_2d > uv;
+  bvh.closest_points( points, faces, closest, uv );
+  ASSERT_EQ( points.size(), faces.size() );
+
+  for( size_t i = 0; i < points.size(); ++i )
+  {
+    point_3d expected_cp, cp;
+    double expected_u, expected_v, u, v;
+    auto const expected =
+      mesh_closest_point( points[ i ], *m, expected_cp, expected_u,
+                          expected_v );
+
+    EXPECT_EQ( expected, bvh.closest_point( points[ i ], cp, u, v ) );
+    EXPECT_EQ( expected, faces[ i ] );
+    EXPECT_NEAR( 0.0, ( expected_cp.value() - cp.value() ).norm(), 1e-12 );
+    EXPECT_NEAR( 0.0, ( expected_cp.value() - closest[ i ].value() ).norm(),
+                 1e-12 );
+    EXPECT_NEAR( expected_u, uv[ i ][ 0 ], 1e-12 );
+    EXPECT_NEAR( expected_v, uv[ i ][ 1 ], 1e-12 );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( mesh_bvh, intersect )
+{
+  auto const m = generate_mesh();
+  mesh_bvh const bvh{ *m };
+
+  std::mt19937 rng( 11 );
+  std::uniform_real_distribution< double > x( -3.0, 18.0 );
+  std::uniform_real_distribution< double > z( -3.0, 6.0 );
+  std::normal_distribution< double > dir( 0.0, 1.0 );
+  std::vector< point_3d > points;
+  std::vector< vector_3d > directions;
+  for( int i = 0; i < 200; ++i )
+  {
+    points.emplace_back( x( rng ), x( rng ), z( rng ) );
+    directions.emplace_back( dir( rng ), dir( rng ), dir( rng ) );
+  }
+  // Include rays along the axes, whose direction has zero components
+  points.emplace_back( 3.3, 4.1, 6.0 );
+  directions.emplace_back( 0.0, 0.0, -1.0 );
+  points.emplace_back( -3.0, 4.1, 0.1 );
+  directions.emplace_back( 1.0, 0.0, 0.0 );
+
+  std::vector< int > faces;
+  std::vector< double > dists;
+  std::vector< vector_2d > uv;
+  bvh.intersect( points, directions, faces, dists, uv );
+  ASSERT_EQ( points.size(), faces.size() );
+
+  size_t hits = 0;
+  for( size_t i = 0; i < points.size(); ++i )
+  {
+    double expected_dist, expected_u, expected_v, dist, u, v;
+    auto const expected = mesh_intersect( points[ i ], directions[ i ], *m,
+                                          expected_dist, expected_u,
+                                          expected_v );
+
+    EXPECT_EQ( expected, bvh.intersect( points[ i ], directions[ i ],
+                                        dist, u, v ) );
+    EXPECT_EQ( expected, faces[ i ] );
+    if( expected < 0 )
+    {
+      continue;
+    }
+    ++hits;
+
+    EXPECT_DOUBLE_EQ( expected_dist, dist );
+    EXPECT_DOUBLE_EQ( expected_dist, dists[ i ] );
+
+    // The barycentric coordinates give the point where the ray hits
+    auto const& f = static_cast< mesh_regular_face_array< 3 > const& >(
+      m->faces() )[ expected ];
+    auto const& verts = m->vertices< 3 >();
+    vector_3d const hit = ( 1.0 - u - v ) * verts[ f[ 0 ] ] +
+                          u * verts[ f[ 1 ] ] + v * verts[ f[ 2 ] ];
+    EXPECT_NEAR( 0.0, ( points[ i ].value() + dist * directions[ i ] -
+                        hit ).norm(), 1e-9 );
+  }
+  EXPECT_GT( hits, 20 );
+  EXPECT_LT( hits, points.size() - 20 );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( mesh_bvh, invalid_mesh )
+{
+  EXPECT_THROW( mesh_bvh{ *kwiver::testing::cube_mesh( 1.0 ) },
+                invalid_value );
+
+  mesh const empty{ std::unique_ptr< mesh_vertex_array_base >(
+                      new mesh_vertex_array< 3 > ),
+                    std::unique_ptr< mesh_face_array_base >(
+                      new mesh_regular_face_array< 3 > ) };
+  mesh_bvh const bvh{ empty };
+  EXPECT_EQ( 0, bvh.size() );
+
+  point_3d cp;
+  double dist, u, v;
+  EXPECT_EQ( -1, bvh.closest_point( { 0.0, 0.0, 0.0 }, cp, u, v ) );
+  EXPECT_EQ( -1, bvh.intersect( { 0.0, 0.0, 0.0 }, { 0.0, 0.0, 1.0 },
+                                dist, u, v ) );
+}
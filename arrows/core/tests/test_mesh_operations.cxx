@@ -87,6 +87,44 @@ TEST(mesh_operations, triangulate_mesh)
   EXPECT_EQ( mesh->num_faces(), 12 );
 }
 
+// ----------------------------------------------------------------------------
+TEST(mesh_operations, triangulate_mesh_groups)
+{
+  mesh_regular_face_array<4> quads;
+  quads.push_back({ 0, 1, 2, 3 });
+  quads.push_back({ 4, 5, 6, 7 });
+  quads.make_group( "a" );
+  quads.push_back({ 0, 4, 5, 1 });
+  quads.make_group( "b" );
+
+  auto const tris = kwiver::arrows::core::mesh_triangulate( quads );
+  ASSERT_EQ( 6, tris->size() );
+  ASSERT_EQ( 2, tris->groups().size() );
+  EXPECT_EQ( "a", tris->groups()[0].first );
+  EXPECT_EQ( 4, tris->groups()[0].second );
+  EXPECT_EQ( "b", tris->groups()[1].first );
+  EXPECT_EQ( 6, tris->groups()[1].second );
+  EXPECT_EQ( 5, ( *tris )[4][2] );
+
+  // Faces of fewer than three vertices add no triangles, and groups left
+  // without triangles are dropped
+  mesh_face_array faces;
+  faces.push_back({ 0, 1, 2, 3, 4 });
+  faces.make_group( "a" );
+  faces.push_back({ 0, 1 });
+  faces.make_group( "b" );
+  faces.push_back({ 2, 3, 4 });
+  faces.make_group( "c" );
+
+  auto const fans = kwiver::arrows::core::mesh_triangulate( faces );
+  ASSERT_EQ( 4, fans->size() );
+  ASSERT_EQ( 2, fans->groups().size() );
+  EXPECT_EQ( "a", fans->groups()[0].first );
+  EXPECT_EQ( 3, fans->groups()[0].second );
+  EXPECT_EQ( "c", fans->groups()[1].first );
+  EXPECT_EQ( 4, fans->groups()[1].second );
+}
+
 // ----------------------------------------------------------------------------
 TEST(mesh_operations, clip_mesh)
 {
@@ -0,0 +1,152 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test reading and writing metadata maps as CSV
+
+#include <arrows/core/metadata_map_io_csv.h>
+
+#include <vital/exceptions/io.h>
+#include <vital/types/geo_point.h>
+#include <vital/types/geo_polygon.h>
+#include <vital/types/geodesy.h>
+#include <vital/types/metadata.h>
+#include <vital/types/metadata_map.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <sstream>
+
+namespace kv = kwiver::vital;
+
+using kwiver::arrows::core::metadata_map_io_csv;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+kv::metadata_sptr
+make_packet( kv::frame_id_t frame, int seed )
+{
+  auto const packet = std::make_shared< kv::metadata >();
+  packet->add< kv::VITAL_META_VIDEO_FRAME_NUMBER >(
+    static_cast< uint64_t >( frame ) );
+  packet->add< kv::VITAL_META_UNIX_TIMESTAMP >( 1000000 + seed );
+  packet->add< kv::VITAL_META_VIDEO_MICROSECONDS >(
+    3723000000 + seed * 33367 );
+  packet->add< kv::VITAL_META_SENSOR_HORIZONTAL_FOV >( 12.5 + seed );
+  packet->add< kv::VITAL_META_PLATFORM_DESIGNATION >( "a, \"platform\"" );
+  packet->add< kv::VITAL_META_VIDEO_KEY_FRAME >( seed % 2 == 0 );
+  packet->add< kv::VITAL_META_SENSOR_LOCATION >(
+    kv::geo_point{ kv::geo_point::geo_3d_point_t{ -73.75, 42.75, 100.5 },
+                   kv::SRID::lat_lon_WGS84 } );
+
+  kv::polygon corners;
+  corners.push_back( -73.5, 42.5 );
+  corners.push_back( -73.25, 42.5 );
+  corners.push_back( -73.25, 42.25 );
+  corners.push_back( -73.5, 42.25 );
+  packet->add< kv::VITAL_META_CORNER_POINTS >(
+    kv::geo_polygon{ corners, kv::SRID::lat_lon_WGS84 } );
+  return packet;
+}
+
+// ----------------------------------------------------------------------------
+void
+expect_same_packet( kv::metadata const& expected, kv::metadata const& actual )
+{
+  EXPECT_EQ( expected.size(), actual.size() );
+  for( auto const& entry : expected )
+  {
+    auto const tag = entry.first;
+    SCOPED_TRACE( kv::tag_traits_by_tag( tag ).enum_name() );
+    ASSERT_TRUE( actual.has( tag ) );
+    EXPECT_EQ( entry.second->data(), actual.find( tag ).data() );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+check_round_trip( metadata_map_io_csv& io )
+{
+  kv::metadata_map::map_metadata_t map;
+  for( kv::frame_id_t frame = 1; frame <= 1500; ++frame )
+  {
+    map[ frame ] = { make_packet( frame, frame ) };
+  }
+  map[ 7 ].push_back( make_packet( 7, 70 ) );
+
+  std::stringstream ss;
+  io.save_( ss, std::make_shared< kv::simple_metadata_map >( map ),
+            "test.csv" );
+
+  auto const loaded = io.load_( ss, "test.csv" )->metadata();
+  ASSERT_EQ( map.size(), loaded.size() );
+  for( auto const& entry : map )
+  {
+    auto const& packets = loaded.at( entry.first );
+    ASSERT_EQ( entry.second.size(), packets.size() );
+    for( size_t i = 0; i < packets.size(); ++i )
+    {
+      expect_same_packet( *entry.second[ i ], *packets[ i ] );
+    }
+  }
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST ( metadata_map_io_csv, round_trip )
+{
+  metadata_map_io_csv io;
+  check_round_trip( io );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( metadata_map_io_csv, round_trip_enum_names )
+{
+  metadata_map_io_csv io;
+  auto config = io.get_configuration();
+  config->set_value( "write_enum_names", true );
+  io.set_configuration( config );
+  check_round_trip( io );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( metadata_map_io_csv, load )
+{
+  metadata_map_io_csv io;
+
+  std::stringstream empty;
+  EXPECT_TRUE( io.load_( empty, "test.csv" )->metadata().empty() );
+
+  // Unknown columns and empty fields are skipped
+  std::stringstream ss;
+  ss << "\"Frame ID\",\"Something Else\",\"UNIX_TIMESTAMP\",\r\n"
+     << "5,whatever,,\r\n"
+     << "6,,42,\r\n";
+  auto const loaded = io.load_( ss, "test.csv" )->metadata();
+  ASSERT_EQ( 2, loaded.size() );
+  EXPECT_EQ( 1, loaded.at( 5 ).at( 0 )->size() );
+  EXPECT_EQ( 42, loaded.at( 6 ).at( 0 )->find(
+                   kv::VITAL_META_UNIX_TIMESTAMP ).as_uint64() );
+
+  std::stringstream bad;
+  bad << "\"Frame ID\",\"UNIX_TIMESTAMP\",\n"
+      << "5,not a number,\n";
+  EXPECT_THROW( io.load_( bad, "test.csv" ), kv::file_not_read_exception );
+
+  std::stringstream no_header;
+  no_header << "5,1,\n";
+  EXPECT_THROW( io.load_( no_header, "test.csv" ),
+                kv::file_not_read_exception );
+}
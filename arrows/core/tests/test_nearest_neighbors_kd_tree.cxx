@@ -0,0 +1,254 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test core k-d tree nearest neighbor search
+
+#include <test_gtest.h>
+
+#include <arrows/core/nearest_neighbors_kd_tree.h>
+
+#include <vital/plugin_loader/plugin_manager.h>
+
+#include <algorithm>
+#include <random>
+
+namespace kv = kwiver::vital;
+namespace algo = kwiver::vital::algo;
+
+using kwiver::arrows::core::nearest_neighbors_kd_tree;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+std::vector< kv::point_3d >
+random_points( size_t count, unsigned seed )
+{
+  std::mt19937 rng( seed );
+  std::uniform_real_distribution< double > dist( -10.0, 10.0 );
+  std::vector< kv::point_3d > result;
+  for( size_t i = 0; i < count; ++i )
+  {
+    result.emplace_back( dist( rng ), dist( rng ), dist( rng ) );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+// Indices of points sorted by distance to a query, then by index
+std::vector< int >
+sorted_by_distance( std::vector< kv::point_3d > const& points,
+                    kv::point_3d const& query )
+{
+  std::vector< std::pair< double, int > > order;
+  for( size_t i = 0; i < points.size(); ++i )
+  {
+    order.emplace_back( ( points[ i ].value() - query.value() ).norm(),
+                        static_cast< int >( i ) );
+  }
+  std::sort( order.begin(), order.end() );
+
+  std::vector< int > result;
+  for( auto const& o : order )
+  {
+    result.push_back( o.second );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+void
+configure( nearest_neighbors_kd_tree& tree, size_t leaf_size )
+{
+  auto const config = tree.get_configuration();
+  config->set_value( "leaf_size", leaf_size );
+  ASSERT_TRUE( tree.check_configuration( config ) );
+  tree.set_configuration( config );
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST ( nearest_neighbors_kd_tree, create )
+{
+  EXPECT_NE( nullptr, algo::nearest_neighbors::create( "kd_tree" ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( nearest_neighbors_kd_tree, known_points )
+{
+  std::vector< kv::point_3d > pts{
+    { -0.361, -0.386, 0.139 }, { 0.074, 0.739, -0.573 },
+    { -1.158, 0.405, 0.785 }, { -0.220, 0.664, 0.624 },
+    { 0.474, -0.771, 0.960 }, { 0.837, -1.734, -0.050 },
+    { -1.126, -0.955, 0.120 }, { 1.040, 0.761, -0.483 },
+    { -1.620, 1.493, 0.902 }, { -1.726, 1.788, 0.482 },
+    { 0.685, 1.055, 0.612 }, { 0.486, -1.450, 0.934 },
+    { 1.268, 0.018, -1.081 }, { -0.949, 0.508, -1.410 },
+    { -0.122, 0.224, 1.778 } };
+  std::vector< kv::point_3d > test_pts{
+    { -1.905, 2.166, 0.518 }, { 1.410, 1.327, -0.202 },
+    { -0.800, -0.870, 1.200 }, { 1.630, -3.100, -0.900 } };
+
+  nearest_neighbors_kd_tree tree;
+  configure( tree, 2 );
+  tree.build( pts );
+
+  std::vector< std::vector< int > > indices;
+  std::vector< std::vector< double > > distances;
+  tree.find_nearest_points( test_pts, 3, indices, distances );
+  ASSERT_EQ( test_pts.size(), indices.size() );
+  ASSERT_EQ( test_pts.size(), distances.size() );
+
+  for( size_t i = 0; i < test_pts.size(); ++i )
+  {
+    auto const expected = sorted_by_distance( pts, test_pts[ i ] );
+    ASSERT_EQ( 3, indices[ i ].size() );
+    ASSERT_EQ( 3, distances[ i ].size() );
+    for( size_t k = 0; k < 3; ++k )
+    {
+      EXPECT_EQ( expected[ k ], indices[ i ][ k ] ) << "Query: " << i;
+      EXPECT_NEAR(
+        ( pts[ expected[ k ] ].value() - test_pts[ i ].value() ).norm(),
+        distances[ i ][ k ], 1e-12 );
+    }
+  }
+
+  // Points within 1.1 of each query, in order of distance
+  tree.find_within_radius_points( test_pts, 1.1, indices );
+  ASSERT_EQ( test_pts.size(), indices.size() );
+  for( size_t i = 0; i < test_pts.size(); ++i )
+  {
+    std::vector< int > expected;
+    for( auto const j : sorted_by_distance( pts, test_pts[ i ] ) )
+    {
+      if( ( pts[ j ].value() - test_pts[ i ].value() ).norm() <= 1.1 )
+      {
+        expected.push_back( j );
+      }
+    }
+    EXPECT_EQ( expected, indices[ i ] ) << "Query: " << i;
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( nearest_neighbors_kd_tree, random_points )
+{
+  auto pts = random_points( 2000, 1234 );
+  auto queries = random_points( 200, 5678 );
+
+  for( auto const leaf_size : { 1, 10, 5000 } )
+  {
+    SCOPED_TRACE( "Leaf size: " + std::to_string( leaf_size ) );
+
+    nearest_neighbors_kd_tree tree;
+    configure( tree, leaf_size );
+    tree.build( pts );
+
+    for( auto& q : queries )
+    {
+      auto const expected = sorted_by_distance( pts, q );
+
+      for( auto const K : { 1, 5 } )
+      {
+        std::vector< int > indices;
+        std::vector< double > distances;
+        tree.find_nearest_point( q, K, indices, distances );
+        EXPECT_EQ( std::vector< int >( expected.begin(),
+                                       expected.begin() + K ), indices );
+        EXPECT_TRUE( std::is_sorted( distances.begin(), distances.end() ) );
+      }
+
+      std::vector< int > within;
+      tree.find_within_radius( q, 2.0, within );
+      std::vector< int > expected_within;
+      for( auto const j : expected )
+      {
+        if( ( pts[ j ].value() - q.value() ).norm() > 2.0 )
+        {
+          break;
+        }
+        expected_within.push_back( j );
+      }
+      EXPECT_EQ( expected_within, within );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( nearest_neighbors_kd_tree, batch_matches_single )
+{
+  auto pts = random_points( 5000, 42 );
+  auto queries = random_points( 1000, 43 );
+
+  nearest_neighbors_kd_tree tree;
+  tree.build( pts );
+
+  // Outputs are replaced, not appended to
+  std::vector< std::vector< int > > indices( 3, { -1 } );
+  std::vector< std::vector< double > > distances( 7, { -1.0 } );
+  tree.find_nearest_points( queries, 4, indices, distances );
+  ASSERT_EQ( queries.size(), indices.size() );
+  ASSERT_EQ( queries.size(), distances.size() );
+
+  std::vector< std::vector< int > > within( 2, { -1 } );
+  tree.find_within_radius_points( queries, 1.5, within );
+  ASSERT_EQ( queries.size(), within.size() );
+
+  for( size_t i = 0; i < queries.size(); ++i )
+  {
+    std::vector< int > single_indices;
+    std::vector< double > single_distances;
+    tree.find_nearest_point( queries[ i ], 4, single_indices,
+                             single_distances );
+    EXPECT_EQ( single_indices, indices[ i ] );
+    EXPECT_EQ( single_distances, distances[ i ] );
+
+    std::vector< int > single_within;
+    tree.find_within_radius( queries[ i ], 1.5, single_within );
+    EXPECT_EQ( single_within, within[ i ] );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( nearest_neighbors_kd_tree, degenerate )
+{
+  nearest_neighbors_kd_tree tree;
+  configure( tree, 1 );
+
+  kv::point_3d query{ 1.0, 2.0, 3.0 };
+  std::vector< int > indices;
+  std::vector< double > distances;
+
+  // Identical points still split into a valid tree
+  std::vector< kv::point_3d > same( 50, query );
+  tree.build( same );
+  tree.find_nearest_point( query, 60, indices, distances );
+  EXPECT_EQ( 50, indices.size() );
+  EXPECT_EQ( std::vector< double >( 50, 0.0 ), distances );
+  tree.find_within_radius( query, 0.0, indices );
+  EXPECT_EQ( 50, indices.size() );
+
+  // An empty tree has no neighbors
+  std::vector< kv::point_3d > none;
+  tree.build( none );
+  tree.find_nearest_point( query, 3, indices, distances );
+  EXPECT_TRUE( indices.empty() );
+  EXPECT_TRUE( distances.empty() );
+  tree.find_within_radius( query, 10.0, indices );
+  EXPECT_TRUE( indices.empty() );
+
+  auto const config = tree.get_configuration();
+  config->set_value( "leaf_size", 0 );
+  EXPECT_FALSE( tree.check_configuration( config ) );
+}
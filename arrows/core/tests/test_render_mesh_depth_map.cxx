@@ -3,6 +3,7 @@
 // https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
 
 #include <gtest/gtest.h>
+#include <test_scene.h>
 
 #include <vital/plugin_loader/plugin_manager.h>
 
@@ -13,6 +14,7 @@
 #include <vital/types/image_container.h>
 #include <vital/types/mesh.h>
 #include <vital/types/vector.h>
+#include <vital/util/transform_image.h>
 #include <memory>
 
 using namespace kwiver::vital;
@@ -242,3 +244,70 @@ TEST(render_mesh_height_map, camera_rpc)
 
   EXPECT_NEAR( real_height_bary, measured_height_bary, 1e-2 );
 }
+
+// ----------------------------------------------------------------------------
+TEST(render_mesh_depth_map, multiple_cameras)
+{
+  // A grid which spans several tiles of each image
+  mesh_sptr mesh = kwiver::testing::grid_mesh(40, 30, 0.25, {-5.0, -4.0, 0.0});
+  auto& verts = dynamic_cast<mesh_vertex_array<3>&>(mesh->vertices());
+  for (auto& v : verts)
+  {
+    v.z() = std::sin(v.x()) * std::cos(v.y());
+  }
+
+  camera_intrinsics_sptr camera_intrinsic(new simple_camera_intrinsics(780, {300, 250},
+                                                                       1.0, 0.0, {},
+                                                                       640, 480));
+  std::vector<camera_perspective_sptr> cameras;
+  for (int i = 0; i < 4; ++i)
+  {
+    auto cam = std::make_shared<simple_camera_perspective>(vector_3d(i - 2.0, 0.5 * i, 10.0),
+                                                           rotation_d(), camera_intrinsic);
+    cam->look_at(vector_3d(0.0, 0.0, 0.0), vector_3d(0.0, 1.0, 0.0));
+    cameras.push_back(cam);
+  }
+
+  auto const depth_maps = kwiver::arrows::core::render_mesh_depth_maps(mesh, cameras);
+  ASSERT_EQ(cameras.size(), depth_maps.size());
+
+  // Each depth map is the same as rendering every triangle in turn
+  auto const& triangles = static_cast<mesh_regular_face_array<3> const&>(mesh->faces());
+  for (size_t c = 0; c < cameras.size(); ++c)
+  {
+    SCOPED_TRACE("Camera " + std::to_string(c));
+    image_of<double> expected(640, 480, 1);
+    transform_image(expected, [](double){ return std::numeric_limits<double>::infinity(); });
+    for (auto const& tri : triangles)
+    {
+      kwiver::arrows::core::render_triangle(
+        cameras[c]->project(verts[tri[0]]),
+        cameras[c]->project(verts[tri[1]]),
+        cameras[c]->project(verts[tri[2]]),
+        -1.0 / cameras[c]->depth(verts[tri[0]]),
+        -1.0 / cameras[c]->depth(verts[tri[1]]),
+        -1.0 / cameras[c]->depth(verts[tri[2]]),
+        expected);
+    }
+
+    image_of<double> const actual(depth_maps[c]->get_image());
+    ASSERT_EQ(640, actual.width());
+    ASSERT_EQ(480, actual.height());
+    size_t num_finite = 0;
+    for (unsigned j = 0; j < 480; ++j)
+    {
+      for (unsigned i = 0; i < 640; ++i)
+      {
+        double const e = std::isinf(expected(i, j)) ? expected(i, j) : -1.0 / expected(i, j);
+        ASSERT_EQ(e, actual(i, j)) << "at " << i << ", " << j;
+        num_finite += std::isinf(e) ? 0 : 1;
+      }
+    }
+    EXPECT_GT(num_finite, 10000);
+  }
+
+  // Rendering one camera gives the same depth map
+  image_of<double> const single(
+    kwiver::arrows::core::render_mesh_depth_map(mesh, cameras[1])->get_image());
+  EXPECT_TRUE(equal_content(single, image_of<double>(depth_maps[1]->get_image())));
+}
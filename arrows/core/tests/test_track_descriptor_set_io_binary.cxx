@@ -0,0 +1,233 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test binary track descriptor set reading and writing
+
+#include <test_gtest.h>
+#include <test_tmpfn.h>
+
+#include <arrows/core/read_track_descriptor_set_binary.h>
+#include <arrows/core/write_track_descriptor_set_binary.h>
+
+#include <vital/exceptions/io.h>
+#include <vital/plugin_loader/plugin_manager.h>
+
+#include <fstream>
+#include <sstream>
+
+#include <cstdio>
+
+namespace kv = kwiver::vital;
+
+using kwiver::arrows::core::read_track_descriptor_set_binary;
+using kwiver::arrows::core::write_track_descriptor_set_binary;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+kv::track_descriptor_sptr
+make_descriptor( int i )
+{
+  auto desc = kv::track_descriptor::create( "cnn" );
+  desc->set_uid( kv::uid( "desc_" + std::to_string( i ) ) );
+  desc->add_track_id( i );
+  desc->add_track_id( 100 + i );
+  desc->resize_descriptor( 32 );
+  for( size_t j = 0; j < 32; ++j )
+  {
+    desc->at( j ) = 0.25 * i - 0.125 * j;
+  }
+  for( int f = 0; f <= i % 4; ++f )
+  {
+    desc->add_history_entry(
+      kv::track_descriptor::history_entry(
+        kv::timestamp( 1000 * f, f ),
+        kv::bounding_box_d( f, i, f + 10.5, i + 20.5 ),
+        kv::bounding_box_d( -f, -i, f, i ) ) );
+  }
+  return desc;
+}
+
+// ----------------------------------------------------------------------------
+kv::track_descriptor_set_sptr
+make_set( int first, int count )
+{
+  auto set = std::make_shared< kv::track_descriptor_set >();
+  for( int i = first; i < first + count; ++i )
+  {
+    set->push_back( make_descriptor( i ) );
+  }
+  return set;
+}
+
+// ----------------------------------------------------------------------------
+void
+expect_equal( kv::track_descriptor const& expected,
+              kv::track_descriptor const& actual, double tolerance )
+{
+  EXPECT_EQ( expected.get_uid(), actual.get_uid() );
+  EXPECT_EQ( expected.get_type(), actual.get_type() );
+  EXPECT_EQ( expected.get_track_ids(), actual.get_track_ids() );
+  ASSERT_EQ( expected.descriptor_size(), actual.descriptor_size() );
+  for( size_t j = 0; j < expected.descriptor_size(); ++j )
+  {
+    EXPECT_NEAR( expected.at( j ), actual.at( j ), tolerance );
+  }
+
+  auto const& eh = expected.get_history();
+  auto const& ah = actual.get_history();
+  ASSERT_EQ( eh.size(), ah.size() );
+  for( size_t j = 0; j < eh.size(); ++j )
+  {
+    EXPECT_EQ( eh[ j ].get_timestamp(), ah[ j ].get_timestamp() );
+    EXPECT_EQ( eh[ j ].get_image_location(), ah[ j ].get_image_location() );
+    EXPECT_EQ( eh[ j ].get_world_location(), ah[ j ].get_world_location() );
+  }
+}
+
+// ----------------------------------------------------------------------------
+kv::config_block_sptr
+encoding_config( std::string const& encoding )
+{
+  auto config = kv::config_block::empty_config();
+  config->set_value( "descriptor_encoding", encoding );
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+// Name of a temporary file, removed when the object is destroyed
+struct temp_file
+{
+  explicit temp_file( char const* suffix )
+    : name( kwiver::testing::temp_file_name(
+              "test_track_descriptor_set_io_binary-", suffix ) )
+  {
+  }
+
+  ~temp_file() { std::remove( name.c_str() ); }
+
+  std::string const name;
+};
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST ( track_descriptor_set_io_binary, encodings )
+{
+  temp_file const file{ ".kwtd" };
+  auto const& filename = file.name;
+  auto const set = make_set( 0, 12 );
+
+  // Largest element is 2.75 in magnitude, range is 6.625
+  std::map< std::string, double > const tolerance = {
+    { "double", 0.0 }, { "float", 1e-6 },
+    { "float16", 2.75 / 1024 }, { "int8", 6.625 / 254 } };
+
+  for( auto const& t : tolerance )
+  {
+    write_track_descriptor_set_binary writer;
+    EXPECT_TRUE( writer.check_configuration( encoding_config( t.first ) ) );
+    writer.set_configuration( encoding_config( t.first ) );
+    writer.open( filename );
+    writer.write_set( make_set( 0, 5 ) );
+    writer.write_set( make_set( 5, 7 ) );
+    writer.close();
+
+    read_track_descriptor_set_binary reader;
+    reader.open( filename );
+    ASSERT_EQ( 12, reader.num_descriptors() );
+
+    kv::track_descriptor_set_sptr read;
+    ASSERT_TRUE( reader.read_set( read ) );
+    ASSERT_EQ( 12, read->size() );
+    for( size_t i = 0; i < set->size(); ++i )
+    {
+      SCOPED_TRACE( t.first );
+      expect_equal( *( *set )[ i ], *( *read )[ i ], t.second );
+    }
+    EXPECT_FALSE( reader.read_set( read ) );
+  }
+
+  EXPECT_FALSE( write_track_descriptor_set_binary().check_configuration(
+    encoding_config( "int4" ) ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( track_descriptor_set_io_binary, random_access )
+{
+  temp_file const file{ ".kwtd" };
+  auto const& filename = file.name;
+  auto const set = make_set( 0, 20 );
+  {
+    write_track_descriptor_set_binary writer;
+    writer.set_configuration( encoding_config( "double" ) );
+    writer.open( filename );
+    writer.write_set( set );
+    // The index is written when the writer is destroyed
+  }
+
+  read_track_descriptor_set_binary reader;
+  reader.open( filename );
+  ASSERT_EQ( 20, reader.num_descriptors() );
+
+  expect_equal( *( *set )[ 13 ], *reader.read_descriptor( 13 ), 0.0 );
+  expect_equal( *( *set )[ 2 ], *reader.read_descriptor( 2 ), 0.0 );
+  expect_equal( *( *set )[ 7 ],
+                *reader.find_descriptor( kv::uid( "desc_7" ) ), 0.0 );
+  EXPECT_EQ( nullptr, reader.find_descriptor( kv::uid( "missing" ) ) );
+  EXPECT_THROW( reader.read_descriptor( 20 ), std::out_of_range );
+
+  // Without batch loading, descriptors are returned on their last frame
+  auto config = kv::config_block::empty_config();
+  config->set_value( "batch_load", false );
+  reader.set_configuration( config );
+  reader.open( filename );
+
+  kv::track_descriptor_set_sptr read;
+  for( int frame = 0; frame < 4; ++frame )
+  {
+    ASSERT_TRUE( reader.read_set( read ) );
+    EXPECT_EQ( 5, read->size() );
+    for( auto const& desc : *read )
+    {
+      EXPECT_EQ( frame, desc->get_history().back().get_timestamp().get_frame() );
+    }
+  }
+  EXPECT_FALSE( reader.read_set( read ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( track_descriptor_set_io_binary, missing_index )
+{
+  auto const set = make_set( 0, 6 );
+
+  // A stream whose writer was never closed has no index
+  std::stringstream stream;
+  write_track_descriptor_set_binary writer;
+  writer.use_stream( &stream );
+  writer.write_set( set );
+
+  read_track_descriptor_set_binary reader;
+  reader.use_stream( &stream );
+  ASSERT_EQ( 6, reader.num_descriptors() );
+  expect_equal( *( *set )[ 4 ],
+                *reader.find_descriptor( kv::uid( "desc_4" ) ), 1e-6 );
+
+  temp_file const file{ ".csv" };
+  {
+    std::ofstream csv( file.name );
+    csv << "# 1:descriptor_uid, 2:descriptor_type\n";
+  }
+  EXPECT_THROW( reader.open( file.name ), kv::invalid_file );
+}
@@ -0,0 +1,259 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test core feature tracking
+
+#include <test_gtest.h>
+
+#include <arrows/core/track_features_core.h>
+
+#include <vital/algo/algorithm_factory.h>
+#include <vital/algo/detect_features.h>
+#include <vital/algo/extract_descriptors.h>
+#include <vital/plugin_loader/plugin_manager.h>
+#include <vital/types/packed_descriptor_set.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <thread>
+
+namespace kv = kwiver::vital;
+namespace algo = kwiver::vital::algo;
+
+using kwiver::arrows::core::track_features_core;
+
+namespace {
+
+std::atomic< int > num_detections{ 0 };
+
+// ----------------------------------------------------------------------------
+// Frame number stored in the first pixel of a test image
+kv::frame_id_t
+image_frame( kv::image_container_sptr const& image )
+{
+  return image->get_image().at< kv::byte >( 0, 0 );
+}
+
+// ----------------------------------------------------------------------------
+// Detect a fixed grid of features, taking longer on some frames
+class test_detector : public algo::detect_features
+{
+public:
+  PLUGIN_INFO( "test_grid", "Detects a fixed grid of features." )
+
+  void set_configuration( kv::config_block_sptr ) override {}
+  bool check_configuration( kv::config_block_sptr ) const override
+  {
+    return true;
+  }
+
+  kv::feature_set_sptr
+  detect( kv::image_container_sptr image_data,
+          kv::image_container_sptr ) const override
+  {
+    ++num_detections;
+    auto const frame = image_frame( image_data );
+    std::this_thread::sleep_for( std::chrono::milliseconds( frame % 3 ) );
+
+    std::vector< kv::feature_sptr > features;
+    for( int i = 0; i < 20; ++i )
+    {
+      features.push_back(
+        std::make_shared< kv::feature_d >(
+          kv::vector_2d{ i * 3.0, static_cast< double >( frame ) } ) );
+    }
+    return std::make_shared< kv::simple_feature_set >( features );
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Describe each feature by its column, perturbed on some frames so that
+// tracks both continue and end
+class test_extractor : public algo::extract_descriptors
+{
+public:
+  PLUGIN_INFO( "test_column", "Describes features by their column." )
+
+  void set_configuration( kv::config_block_sptr ) override {}
+  bool check_configuration( kv::config_block_sptr ) const override
+  {
+    return true;
+  }
+
+  kv::descriptor_set_sptr
+  extract( kv::image_container_sptr image_data,
+           kv::feature_set_sptr& features,
+           kv::image_container_sptr ) const override
+  {
+    auto const frame = image_frame( image_data );
+    std::vector< double > data;
+    for( auto const& f : features->features() )
+    {
+      // Uneven spacing avoids ties in matching, which the tracker resolves
+      // by the order of its tracks in memory
+      auto const column = f->loc()[ 0 ] / 3.0;
+      data.push_back( column * ( 1.0 + 0.01 * column ) );
+      data.push_back(
+        ( static_cast< int >( column ) + frame ) % 7 == 0 ? 100.0 : 0.0 );
+    }
+    return std::make_shared< kv::packed_descriptor_set< double > >(
+      std::move( data ), 2 );
+  }
+};
+
+// ----------------------------------------------------------------------------
+kv::image_container_sptr
+make_image( kv::frame_id_t frame )
+{
+  kv::image_of< kv::byte > image{ 8, 8 };
+  image( 0, 0 ) = static_cast< kv::byte >( frame );
+  return std::make_shared< kv::simple_image_container >( image );
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< track_features_core >
+make_tracker( unsigned max_prefetch_frames )
+{
+  auto const tracker = std::make_shared< track_features_core >();
+  auto const config = tracker->get_configuration();
+  config->set_value( "feature_detector:type", "test_grid" );
+  config->set_value( "descriptor_extractor:type", "test_column" );
+  config->set_value( "feature_matcher:type", "brute_force" );
+  config->set_value( "max_prefetch_frames", max_prefetch_frames );
+  EXPECT_TRUE( tracker->check_configuration( config ) );
+  tracker->set_configuration( config );
+  return tracker;
+}
+
+// ----------------------------------------------------------------------------
+// Track ids mapped to the frames and feature locations of their states
+using track_summary =
+  std::map< kv::track_id_t,
+            std::vector< std::pair< kv::frame_id_t, kv::vector_2d > > >;
+
+track_summary
+summarize( kv::feature_track_set_sptr const& tracks )
+{
+  track_summary result;
+  for( auto const& t : tracks->tracks() )
+  {
+    auto& states = result[ t->id() ];
+    for( auto const& s : *t )
+    {
+      auto const fts =
+        std::dynamic_pointer_cast< kv::feature_track_state >( s );
+      states.emplace_back( s->frame(), fts->feature->loc() );
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+// Track frames, offering up to read_ahead frames in advance as the
+// track_features applet does
+kv::feature_track_set_sptr
+run_tracker( algo::track_features const& tracker,
+             std::vector< kv::frame_id_t > const& frames,
+             size_t read_ahead )
+{
+  kv::feature_track_set_sptr tracks;
+  for( size_t i = 0; i < frames.size(); ++i )
+  {
+    for( auto j = i + 1; j < std::min( frames.size(), i + 1 + read_ahead );
+         ++j )
+    {
+      tracker.prefetch( frames[ j ], make_image( frames[ j ] ) );
+    }
+    tracks = tracker.track( tracks, frames[ i ], make_image( frames[ i ] ) );
+  }
+  return tracks;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+
+  auto& vpm = kv::plugin_manager::instance();
+  vpm.add_factory( new kv::algorithm_factory_0< test_detector >(
+    test_detector::static_type_name(), test_detector::_plugin_name ) );
+  vpm.add_factory( new kv::algorithm_factory_0< test_extractor >(
+    test_extractor::static_type_name(), test_extractor::_plugin_name ) );
+
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST ( track_features_core, prefetch_disabled )
+{
+  auto const tracker = make_tracker( 0 );
+  EXPECT_FALSE( tracker->prefetch( 1, make_image( 1 ) ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( track_features_core, prefetch_same_tracks )
+{
+  std::vector< kv::frame_id_t > frames;
+  for( kv::frame_id_t f = 1; f <= 24; ++f )
+  {
+    frames.push_back( f );
+  }
+
+  num_detections = 0;
+  auto const expected = summarize( run_tracker( *make_tracker( 0 ), frames,
+                                                0 ) );
+  EXPECT_EQ( frames.size(), num_detections );
+  ASSERT_GT( expected.size(), 20 );
+
+  for( auto const max_prefetch_frames : { 1u, 3u, 8u } )
+  {
+    SCOPED_TRACE( "Prefetch frames: " +
+                  std::to_string( max_prefetch_frames ) );
+
+    // Each frame is detected once however far ahead it is offered, whether
+    // it is accepted or not
+    for( auto const read_ahead : { 1u, 3u, 12u } )
+    {
+      num_detections = 0;
+      auto const tracker = make_tracker( max_prefetch_frames );
+      EXPECT_EQ( expected,
+                 summarize( run_tracker( *tracker, frames, read_ahead ) ) );
+      EXPECT_EQ( frames.size(), num_detections );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( track_features_core, prefetch_skipped_frames )
+{
+  auto const tracker = make_tracker( 2 );
+
+  // Frames offered but never tracked are dropped, freeing capacity
+  EXPECT_TRUE( tracker->prefetch( 2, make_image( 2 ) ) );
+  EXPECT_TRUE( tracker->prefetch( 3, make_image( 3 ) ) );
+  EXPECT_TRUE( tracker->prefetch( 3, make_image( 3 ) ) );
+  EXPECT_FALSE( tracker->prefetch( 4, make_image( 4 ) ) );
+
+  auto tracks = tracker->track( nullptr, 1, make_image( 1 ) );
+  EXPECT_FALSE( tracker->prefetch( 4, make_image( 4 ) ) );
+  tracks = tracker->track( tracks, 3, make_image( 3 ) );
+  EXPECT_TRUE( tracker->prefetch( 4, make_image( 4 ) ) );
+  EXPECT_TRUE( tracker->prefetch( 5, make_image( 5 ) ) );
+  tracks = tracker->track( tracks, 4, make_image( 4 ) );
+  tracks = tracker->track( tracks, 5, make_image( 5 ) );
+
+  auto const expected_tracker = make_tracker( 0 );
+  auto expected = expected_tracker->track( nullptr, 1, make_image( 1 ) );
+  for( kv::frame_id_t f : { 3, 4, 5 } )
+  {
+    expected = expected_tracker->track( expected, f, make_image( f ) );
+  }
+  EXPECT_EQ( summarize( expected ), summarize( tracks ) );
+}
@@ -27,6 +27,42 @@ track_set_sptr make_track_set_impl( std::vector< track_sptr > const& tracks )
   return std::make_shared<track_set>( std::move( tsi ) );
 }
 
+// ----------------------------------------------------------------------------
+track_set_sptr make_columnar_track_set( std::vector< track_sptr > const& tracks )
+{
+  auto tsi = std::unique_ptr<track_set_implementation>{
+    new kwiver::arrows::core::columnar_track_set_impl{ tracks } };
+  return std::make_shared<track_set>( std::move( tsi ) );
+}
+
+// ----------------------------------------------------------------------------
+// Check that the entries of a frame are the states on it, in order of track id
+void check_frame_entries(
+  kwiver::arrows::core::columnar_track_set_impl const& tsi, frame_id_t frame )
+{
+  std::map<track_id_t, track_state_sptr> expected;
+  for ( auto const& t : tsi.tracks() )
+  {
+    auto const itr = t->find( frame );
+    if ( itr != t->end() )
+    {
+      expected.emplace( t->id(), *itr );
+    }
+  }
+
+  auto const entries = tsi.frame_entries( frame );
+  ASSERT_EQ( expected.size(),
+             static_cast<size_t>( entries.second - entries.first ) );
+  auto e = entries.first;
+  for ( auto const& x : expected )
+  {
+    EXPECT_EQ( x.first, e->track_id );
+    EXPECT_EQ( x.second, e->state );
+    ++e;
+  }
+  EXPECT_EQ( expected.size(), tsi.num_active_tracks( frame ) );
+}
+
 }
 
 // ----------------------------------------------------------------------------
@@ -109,3 +145,238 @@ TEST(frame_index_track_set_impl, merge_functions)
 
   test_track_set_merge(test_set_1, test_set_2);
 }
+
+// ----------------------------------------------------------------------------
+TEST(columnar_track_set_impl, accessor_functions)
+{
+  auto test_set = kwiver::vital::testing::make_simple_track_set(1);
+
+  test_set = make_columnar_track_set( test_set->tracks() );
+
+  kwiver::vital::testing::test_track_set_accessors( test_set );
+}
+
+// ----------------------------------------------------------------------------
+TEST(columnar_track_set_impl, modifier_functions)
+{
+  auto test_set = kwiver::vital::testing::make_simple_track_set(1);
+
+  test_set = make_columnar_track_set( test_set->tracks() );
+
+  kwiver::vital::testing::test_track_set_modifiers( test_set );
+}
+
+// ----------------------------------------------------------------------------
+TEST(columnar_track_set_impl, matches_simple)
+{
+  auto tracks = kwiver::testing::generate_tracks();
+
+  auto ctracks = make_columnar_track_set( tracks->tracks() );
+
+  EXPECT_EQ( tracks->size(), ctracks->size() );
+  EXPECT_EQ( tracks->empty(), ctracks->empty() );
+  EXPECT_EQ( tracks->first_frame(), ctracks->first_frame() );
+  EXPECT_EQ( tracks->last_frame(), ctracks->last_frame() );
+
+  auto all_frames_s = tracks->all_frame_ids();
+  auto all_frames_c = ctracks->all_frame_ids();
+  EXPECT_TRUE( std::equal( all_frames_s.begin(), all_frames_s.end(),
+                           all_frames_c.begin() ) );
+
+  EXPECT_IDS_EQ( tracks->all_track_ids(), ctracks->all_track_ids() );
+  for ( auto const frame : all_frames_s )
+  {
+    EXPECT_TRACKS_EQ( tracks->active_tracks( frame ),
+                      ctracks->active_tracks( frame ) );
+    EXPECT_TRACKS_EQ( tracks->inactive_tracks( frame ),
+                      ctracks->inactive_tracks( frame ) );
+    EXPECT_TRACKS_EQ( tracks->new_tracks( frame ),
+                      ctracks->new_tracks( frame ) );
+    EXPECT_TRACKS_EQ( tracks->terminated_tracks( frame ),
+                      ctracks->terminated_tracks( frame ) );
+    EXPECT_EQ( tracks->active_track_ids( frame ),
+               ctracks->active_track_ids( frame ) );
+    EXPECT_EQ( tracks->num_active_tracks( frame ),
+               ctracks->num_active_tracks( frame ) );
+    EXPECT_EQ( tracks->percentage_tracked( frame, frame + 10 ),
+               ctracks->percentage_tracked( frame, frame + 10 ) );
+  }
+  EXPECT_TRACKS_EQ( tracks->tracks(), ctracks->tracks() );
+  EXPECT_TRUE( ctracks->active_tracks( tracks->last_frame() + 1 ).empty() );
+  EXPECT_EQ( tracks->size(),
+             ctracks->inactive_tracks( tracks->last_frame() + 1 ).size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(columnar_track_set_impl, frame_entries)
+{
+  using kwiver::arrows::core::columnar_track_set_impl;
+
+  auto const tracks = kwiver::testing::generate_tracks()->tracks();
+
+  // entries are ordered by track id however the tracks are given
+  std::vector<track_sptr> reversed( tracks.rbegin(), tracks.rend() );
+  columnar_track_set_impl tsi{ reversed };
+  for ( auto frame = tsi.first_frame(); frame <= tsi.last_frame(); ++frame )
+  {
+    check_frame_entries( tsi, frame );
+  }
+
+  auto const none = tsi.frame_entries( tsi.last_frame() + 1 );
+  EXPECT_EQ( none.first, none.second );
+
+  // entries without any tracks
+  columnar_track_set_impl empty_tsi;
+  auto const empty_entries = empty_tsi.frame_entries( 0 );
+  EXPECT_EQ( empty_entries.first, empty_entries.second );
+  EXPECT_EQ( 0, empty_tsi.first_frame() );
+  EXPECT_EQ( 0, empty_tsi.last_frame() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(columnar_track_set_impl, notify_states)
+{
+  using kwiver::arrows::core::columnar_track_set_impl;
+
+  auto t1 = track::create();
+  t1->set_id( 7 );
+  auto t2 = track::create();
+  t2->set_id( 3 );
+  for ( frame_id_t f = 10; f < 15; ++f )
+  {
+    t1->append( std::make_shared<track_state>( f ) );
+  }
+  t2->append( std::make_shared<track_state>( 12 ) );
+
+  columnar_track_set_impl tsi{ { t1 } };
+  tsi.insert( t2 );
+  EXPECT_EQ( 10, tsi.first_frame() );
+  EXPECT_EQ( 14, tsi.last_frame() );
+  check_frame_entries( tsi, 12 );
+
+  // new states extend the frame range in either direction
+  auto const early = std::make_shared<track_state>( 5 );
+  ASSERT_TRUE( t2->insert( early ) );
+  tsi.notify_new_state( early );
+  auto const late = std::make_shared<track_state>( 20 );
+  ASSERT_TRUE( t2->append( late ) );
+  tsi.notify_new_state( late );
+  EXPECT_EQ( 5, tsi.first_frame() );
+  EXPECT_EQ( 20, tsi.last_frame() );
+  EXPECT_EQ( 1, tsi.num_active_tracks( 5 ) );
+  EXPECT_EQ( 0, tsi.num_active_tracks( 6 ) );
+  EXPECT_EQ( ( std::set<frame_id_t>{ 5, 10, 11, 12, 13, 14, 20 } ),
+             tsi.all_frame_ids() );
+  check_frame_entries( tsi, 12 );
+
+  // removing the end states shrinks the frame range again
+  ASSERT_TRUE( t2->remove( early ) );
+  tsi.notify_removed_state( early );
+  ASSERT_TRUE( t2->remove( late ) );
+  tsi.notify_removed_state( late );
+  EXPECT_EQ( 10, tsi.first_frame() );
+  EXPECT_EQ( 14, tsi.last_frame() );
+
+  EXPECT_TRUE( tsi.remove( t1 ) );
+  EXPECT_FALSE( tsi.remove( t1 ) );
+  EXPECT_EQ( 12, tsi.first_frame() );
+  EXPECT_EQ( 12, tsi.last_frame() );
+  EXPECT_EQ( std::vector<track_sptr>{ t2 }, tsi.active_tracks( 12 ) );
+  EXPECT_EQ( std::vector<track_sptr>{ t2 }, tsi.inactive_tracks( 13 ) );
+
+  EXPECT_TRUE( tsi.remove( t2 ) );
+  EXPECT_TRUE( tsi.empty() );
+  EXPECT_TRUE( tsi.all_frame_ids().empty() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(columnar_track_set_impl, merge_relabels_entries)
+{
+  using kwiver::arrows::core::columnar_track_set_impl;
+
+  auto t1 = track::create();
+  t1->set_id( 9 );
+  auto t2 = track::create();
+  t2->set_id( 2 );
+  auto t3 = track::create();
+  t3->set_id( 5 );
+  for ( frame_id_t f = 0; f < 3; ++f )
+  {
+    t2->append( std::make_shared<track_state>( f ) );
+    t3->append( std::make_shared<track_state>( f ) );
+  }
+  for ( frame_id_t f = 3; f < 6; ++f )
+  {
+    t1->append( std::make_shared<track_state>( f ) );
+    t3->append( std::make_shared<track_state>( f ) );
+  }
+
+  columnar_track_set_impl tsi{ { t1, t2, t3 } };
+  EXPECT_FALSE( tsi.merge_tracks( t3, t2 ) );
+  EXPECT_TRUE( tsi.merge_tracks( t1, t2 ) );
+  EXPECT_EQ( 2, tsi.size() );
+  EXPECT_FALSE( tsi.contains( t1 ) );
+
+  for ( frame_id_t f = 0; f < 6; ++f )
+  {
+    check_frame_entries( tsi, f );
+    EXPECT_EQ( ( std::set<track_id_t>{ 2, 5 } ), tsi.active_track_ids( f ) );
+  }
+  EXPECT_EQ( 1.0, tsi.percentage_tracked( 0, 5 ) );
+  EXPECT_TRACKS_EQ( std::vector<track_sptr>{ t2 }, tsi.terminated_tracks( 5 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(columnar_track_set_impl, clone)
+{
+  auto tracks = kwiver::testing::generate_tracks();
+  auto ctracks = make_columnar_track_set( tracks->tracks() );
+
+  auto fd = std::make_shared<feature_track_set_frame_data>();
+  fd->is_keyframe = true;
+  ctracks->set_frame_data( fd, 4 );
+
+  auto const cloned = ctracks->clone();
+  EXPECT_EQ( ctracks->size(), cloned->size() );
+  EXPECT_IDS_EQ( ctracks->all_track_ids(), cloned->all_track_ids() );
+  EXPECT_EQ( ctracks->all_frame_ids(), cloned->all_frame_ids() );
+  for ( auto const frame : ctracks->all_frame_ids() )
+  {
+    EXPECT_EQ( ctracks->active_track_ids( frame ),
+               cloned->active_track_ids( frame ) );
+  }
+  EXPECT_NE( ctracks->get_track( 1 ), cloned->get_track( 1 ) );
+  ASSERT_TRUE( cloned->frame_data( 4 ) );
+  EXPECT_NE( fd, cloned->frame_data( 4 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(columnar_track_set_impl, remove_frame_data)
+{
+  auto test_set = kwiver::vital::testing::make_simple_track_set(1);
+
+  test_set = make_columnar_track_set(test_set->tracks());
+
+  auto fd1 = std::make_shared<feature_track_set_frame_data>();
+  fd1->is_keyframe = true;
+  auto td1 = std::static_pointer_cast<track_set_frame_data>(fd1);
+  EXPECT_EQ(0, test_set->all_frame_data().size());
+  test_set->set_frame_data(td1, 1);
+  EXPECT_EQ(1, test_set->all_frame_data().size());
+  test_set->remove_frame_data(1);
+  EXPECT_EQ(0, test_set->all_frame_data().size());
+}
+
+// ----------------------------------------------------------------------------
+TEST(columnar_track_set_impl, merge_functions)
+{
+  using namespace kwiver::vital::testing;
+
+  auto test_set_1 = kwiver::vital::testing::make_simple_track_set(1);
+  test_set_1 = make_columnar_track_set(test_set_1->tracks());
+
+  auto test_set_2 = kwiver::vital::testing::make_simple_track_set(2);
+  test_set_2 = make_columnar_track_set(test_set_2->tracks());
+
+  test_track_set_merge(test_set_1, test_set_2);
+}
@@ -212,6 +212,55 @@ TEST_F(video_input_image_list, is_good)
   EXPECT_EQ( num_expected_frames, num_frames );
 }
 
+// ----------------------------------------------------------------------------
+TEST_F(video_input_image_list, read_ahead_and_cache)
+{
+  // make config block
+  auto config = kwiver::vital::config_block::empty_config();
+
+  if( !set_config(config, data_dir) )
+  {
+    return;
+  }
+  config->set_value( "read_ahead", 4 );
+  config->set_value( "cache_size_mb", 64 );
+
+  kwiver::arrows::core::video_input_image_list viil;
+
+  EXPECT_TRUE( viil.check_configuration( config ) );
+  viil.set_configuration( config );
+
+  kwiver::vital::path_t list_file = data_dir + "/" + list_file_name;
+  viil.open( list_file );
+
+  kwiver::vital::timestamp ts;
+
+  int num_frames = 0;
+  while ( viil.next_frame( ts ) )
+  {
+    auto img = viil.frame_image();
+
+    ++num_frames;
+    EXPECT_EQ( ts.get_frame(), decode_barcode(*img) )
+      << "Frame number should match barcode in frame image";
+  }
+  EXPECT_EQ( num_expected_frames, num_frames );
+
+  // Seeking back should give the cached image
+  ASSERT_TRUE( viil.seek_frame( ts, 3 ) );
+  auto const img = viil.frame_image();
+  EXPECT_EQ( 3, decode_barcode(*img) );
+  ASSERT_TRUE( viil.seek_frame( ts, 20 ) );
+  EXPECT_EQ( 20, decode_barcode(*viil.frame_image()) );
+  ASSERT_TRUE( viil.seek_frame( ts, 3 ) );
+  EXPECT_EQ( img, viil.frame_image() );
+
+  // Seeking around, with images read ahead from each position
+  test_seek_frame( viil );
+
+  viil.close();
+}
+
 // ----------------------------------------------------------------------------
 TEST_F(video_input_image_list, seek_frame)
 {
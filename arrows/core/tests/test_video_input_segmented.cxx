@@ -0,0 +1,290 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test reading images and metadata with video_input_segmented
+
+#include <test_gtest.h>
+
+#include <arrows/core/video_input_segmented.h>
+#include <arrows/tests/test_video_input.h>
+
+#include <vital/algo/algorithm_factory.h>
+#include <vital/plugin_loader/plugin_manager.h>
+
+#include <memory>
+#include <string>
+#include <iostream>
+
+kwiver::vital::path_t g_data_dir;
+
+namespace algo = kwiver::vital::algo;
+static std::string list_file_name = "video_as_images/frame_list.txt";
+
+// ----------------------------------------------------------------------------
+int
+main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+
+  GET_ARG(1, g_data_dir);
+
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+class video_input_segmented : public ::testing::Test
+{
+  TEST_ARG(data_dir);
+};
+
+// ----------------------------------------------------------------------------
+TEST_F(video_input_segmented, create)
+{
+  EXPECT_NE( nullptr, algo::video_input::create("segmented") );
+}
+
+// ----------------------------------------------------------------------------
+static
+bool
+set_config(kwiver::vital::config_block_sptr config)
+{
+  config->set_value( "num_workers", 3 );
+  config->set_value( "chunk_frames", 7 );
+  config->set_value( "video_source:type", "image_list" );
+  if ( kwiver::vital::has_algorithm_impl_name( "image_io", "ocv" ) )
+  {
+    config->set_value( "video_source:image_list:image_reader:type", "ocv" );
+  }
+  else if ( kwiver::vital::has_algorithm_impl_name( "image_io", "vxl" ) )
+  {
+    config->set_value( "video_source:image_list:image_reader:type", "vxl" );
+  }
+  else
+  {
+    std::cout << "Skipping tests since there is no image reader." << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+TEST_F(video_input_segmented, next_frame)
+{
+  // Make config block
+  auto config = kwiver::vital::config_block::empty_config();
+
+  if( !set_config(config) )
+  {
+    return;
+  }
+
+  kwiver::arrows::core::video_input_segmented vis;
+
+  EXPECT_TRUE( vis.check_configuration( config ) );
+  vis.set_configuration( config );
+
+  kwiver::vital::path_t list_file = data_dir + "/" + list_file_name;
+  vis.open( list_file );
+
+  kwiver::vital::timestamp ts;
+
+  int num_frames = 0;
+  while ( vis.next_frame( ts ) )
+  {
+    auto img = vis.frame_image();
+
+    ++num_frames;
+    EXPECT_TRUE( vis.good() );
+    EXPECT_EQ( num_frames, ts.get_frame() )
+      << "Frame numbers should be sequential";
+    EXPECT_EQ( ts.get_frame(), decode_barcode(*img) )
+      << "Frame number should match barcode in frame image";
+  }
+
+  EXPECT_FALSE( vis.next_frame(ts) );
+  EXPECT_FALSE( vis.good() );
+  EXPECT_TRUE( vis.end_of_video() );
+  EXPECT_EQ( num_expected_frames, num_frames );
+  EXPECT_EQ( num_expected_frames, vis.num_frames() );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F(video_input_segmented, seek_frame)
+{
+  // Make config block
+  auto config = kwiver::vital::config_block::empty_config();
+
+  if( !set_config(config) )
+  {
+    return;
+  }
+
+  kwiver::arrows::core::video_input_segmented vis;
+
+  EXPECT_TRUE( vis.check_configuration( config ) );
+  vis.set_configuration( config );
+
+  kwiver::vital::path_t list_file = data_dir + "/" + list_file_name;
+  vis.open( list_file );
+
+  test_seek_frame( vis );
+
+  vis.close();
+}
+
+// ----------------------------------------------------------------------------
+TEST_F(video_input_segmented, next_then_seek_then_next)
+{
+  // Make config block
+  auto config = kwiver::vital::config_block::empty_config();
+
+  if( !set_config(config) )
+  {
+    return;
+  }
+
+  kwiver::arrows::core::video_input_segmented vis;
+
+  EXPECT_TRUE( vis.check_configuration( config ) );
+  vis.set_configuration( config );
+
+  kwiver::vital::path_t list_file = data_dir + "/" + list_file_name;
+  vis.open( list_file );
+
+  test_next_then_seek_then_next( vis );
+
+  vis.close();
+}
+
+// ----------------------------------------------------------------------------
+TEST_F(video_input_segmented, single_segment)
+{
+  // Make config block
+  auto config = kwiver::vital::config_block::empty_config();
+
+  if( !set_config(config) )
+  {
+    return;
+  }
+
+  // Frames 17 through 33 of 50
+  config->set_value( "segment_count", 3 );
+  config->set_value( "segment_index", 1 );
+
+  kwiver::arrows::core::video_input_segmented vis;
+
+  EXPECT_TRUE( vis.check_configuration( config ) );
+  vis.set_configuration( config );
+
+  kwiver::vital::path_t list_file = data_dir + "/" + list_file_name;
+  vis.open( list_file );
+
+  EXPECT_EQ( 17, vis.num_frames() );
+
+  kwiver::vital::timestamp ts;
+
+  kwiver::vital::timestamp::frame_t frame_number = 16;
+  while ( vis.next_frame( ts ) )
+  {
+    auto img = vis.frame_image();
+
+    ++frame_number;
+    EXPECT_EQ( frame_number, ts.get_frame() )
+      << "Frame numbers should be those of the whole video";
+    EXPECT_EQ( ts.get_frame(), decode_barcode(*img) )
+      << "Frame number should match barcode in frame image";
+  }
+  EXPECT_EQ( 33, frame_number );
+  EXPECT_TRUE( vis.end_of_video() );
+
+  // Seeks outside the segment fail
+  EXPECT_FALSE( vis.seek_frame( ts, 16 ) );
+  EXPECT_FALSE( vis.seek_frame( ts, 34 ) );
+  EXPECT_TRUE( vis.seek_frame( ts, 20 ) );
+  EXPECT_EQ( 20, ts.get_frame() );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F(video_input_segmented, invalid_segment)
+{
+  auto config = kwiver::vital::config_block::empty_config();
+  config->set_value( "video_source:type", "image_list" );
+  config->set_value( "segment_count", 2 );
+  config->set_value( "segment_index", 2 );
+
+  kwiver::arrows::core::video_input_segmented vis;
+  EXPECT_FALSE( vis.check_configuration( config ) );
+}
+
+// ----------------------------------------------------------------------------
+// The POS reader needs no image reader, so these tests always run the workers
+static
+void
+set_pos_config( kwiver::vital::config_block_sptr config,
+                std::string const& data_dir )
+{
+  config->set_value( "num_workers", 3 );
+  config->set_value( "chunk_frames", 4 );
+  config->set_value( "video_source:type", "pos" );
+  config->set_value( "video_source:pos:metadata_directory",
+                     data_dir + "/video_as_images/pos" );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F(video_input_segmented, ordered_metadata)
+{
+  auto config = kwiver::vital::config_block::empty_config();
+  set_pos_config( config, data_dir );
+
+  kwiver::arrows::core::video_input_segmented vis;
+
+  EXPECT_TRUE( vis.check_configuration( config ) );
+  vis.set_configuration( config );
+
+  kwiver::vital::path_t list_file = data_dir + "/" + list_file_name;
+  vis.open( list_file );
+
+  kwiver::vital::timestamp ts;
+
+  int num_frames = 0;
+  while ( vis.next_frame( ts ) )
+  {
+    ++num_frames;
+    EXPECT_TRUE( vis.good() );
+    EXPECT_EQ( num_frames, ts.get_frame() )
+      << "Frame numbers should be sequential";
+    EXPECT_EQ( 1, vis.frame_metadata().size() );
+  }
+
+  EXPECT_EQ( num_expected_frames, num_frames );
+  EXPECT_TRUE( vis.end_of_video() );
+  EXPECT_FALSE( vis.good() );
+
+  // Seek backwards and forwards, restarting the workers each time
+  for ( kwiver::vital::timestamp::frame_t frame : { 23, 2, 50, 9 } )
+  {
+    ASSERT_TRUE( vis.seek_frame( ts, frame ) );
+    EXPECT_EQ( frame, ts.get_frame() );
+    EXPECT_EQ( frame, vis.frame_timestamp().get_frame() );
+  }
+
+  num_frames = 9;
+  while ( vis.next_frame( ts ) )
+  {
+    ++num_frames;
+    EXPECT_EQ( num_frames, ts.get_frame() );
+  }
+  EXPECT_EQ( num_expected_frames, num_frames );
+
+  EXPECT_FALSE( vis.seek_frame( ts, 0 ) );
+  EXPECT_FALSE( vis.seek_frame( ts, 51 ) );
+
+  // Closing with workers mid-chunk must not hang
+  ASSERT_TRUE( vis.seek_frame( ts, 5 ) );
+  vis.close();
+  EXPECT_FALSE( vis.good() );
+}
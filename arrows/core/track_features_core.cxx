@@ -8,11 +8,15 @@
 #include "track_features_core.h"
 
 #include <algorithm>
+#include <deque>
+#include <future>
 #include <numeric>
 #include <iostream>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <iterator>
 
@@ -26,6 +30,8 @@
 
 #include <vital/io/metadata_io.h>
 
+#include <vital/util/thread_pool.h>
+
 #include <vital/exceptions/algorithm.h>
 #include <vital/exceptions/image.h>
 
@@ -44,12 +50,64 @@ class track_features_core::priv
 public:
   /// Constructor
   priv()
-    : features_dir("")
+    : features_dir(""),
+      max_prefetch_frames(0)
+  {
+  }
+
+  /// Features and descriptors computed for one frame
+  typedef std::pair<feature_set_sptr, descriptor_set_sptr> features_t;
+
+  /// Features being computed or loaded in advance for one frame
+  struct prefetch_t
+  {
+    frame_id_t frame;
+    /// True if the features are loaded from the features directory
+    bool from_file;
+    std::future<features_t> features;
+  };
+
+  /// Path of the file caching the features of a frame
+  path_t features_file(image_container_sptr const& image_data,
+                       frame_id_t frame_number) const
+  {
+    metadata_sptr md = image_data->get_metadata();
+    std::string basename = basename_from_metadata(md, frame_number);
+    return features_dir + "/" + basename + ".kwfd";
+  }
+
+  /// Remove and return the features prefetched for a frame, if any
+  ///
+  /// Frames offered before this one were skipped by the caller, so their
+  /// features are discarded.
+  prefetch_t take_prefetched(frame_id_t frame_number)
   {
+    std::lock_guard<std::mutex> lock(prefetch_mutex);
+    auto it = std::find_if(prefetched.begin(), prefetched.end(),
+      [frame_number](prefetch_t const& p)
+      {
+        return p.frame == frame_number;
+      });
+    if( it == prefetched.end() )
+    {
+      return prefetch_t{frame_number, false, {}};
+    }
+    auto result = std::move(*it);
+    prefetched.erase(prefetched.begin(), it + 1);
+    return result;
   }
 
   config_path_t features_dir;
 
+  /// Maximum number of frames on which features are computed in advance
+  unsigned max_prefetch_frames;
+
+  /// Guards the fields below
+  std::mutex prefetch_mutex;
+
+  /// Frames being prefetched, in the order they were offered
+  std::deque<prefetch_t> prefetched;
+
   /// The feature detector algorithm to use
   vital::algo::detect_features_sptr detector;
 
@@ -92,6 +150,16 @@ ::get_configuration() const
                     "detection and description files.\n"
                     "Using this directory requires a feature_io algorithm.");
 
+  config->set_value("max_prefetch_frames", d_->max_prefetch_frames,
+                    "Maximum number of future frames on which to detect "
+                    "features and extract descriptors in the background, on "
+                    "the thread pool, while earlier frames are matched. "
+                    "Features cached in features_dir are loaded in the "
+                    "background instead. This requires the caller to offer "
+                    "frames in advance. "
+                    "Tracking results do not depend on this value. "
+                    "0 disables prefetching.");
+
   // Sub-algorithm implementation name + sub_config block
   // - Feature Detector algorithm
   algo::detect_features::
@@ -128,6 +196,14 @@ ::set_configuration(vital::config_block_sptr in_config)
 
   d_->features_dir = config->get_value<config_path_t>("features_dir",
                                                       d_->features_dir);
+  d_->max_prefetch_frames =
+    config->get_value<unsigned>("max_prefetch_frames");
+
+  // features prefetched with the old algorithms are no longer valid
+  {
+    std::lock_guard<std::mutex> lock(d_->prefetch_mutex);
+    d_->prefetched.clear();
+  }
 
   // Setting nested algorithm instances via setter methods instead of directly
   // assigning to instance property.
@@ -244,19 +320,27 @@ ::track(feature_track_set_sptr prev_tracks,
     }
   }
 
+  // features computed or loaded in advance, if the frame was prefetched
+  priv::prefetch_t prefetched = d_->take_prefetched(frame_number);
+
   // see if there are existing features cached on disk
   if( (!curr_feat || curr_feat->size() == 0 ||
        !curr_desc || curr_desc->size() == 0 ) &&
       d_->feature_io && d_->features_dir != "" )
   {
-    metadata_sptr md = image_data->get_metadata();
-    std::string basename = basename_from_metadata(md, frame_number);
-    path_t kwfd_file = d_->features_dir + "/" + basename + ".kwfd";
+    path_t kwfd_file = d_->features_file(image_data, frame_number);
     if( ST::FileExists( kwfd_file ) )
     {
       feature_set_sptr feat;
       descriptor_set_sptr desc;
-      d_->feature_io->load(kwfd_file, feat, desc);
+      if( prefetched.from_file && prefetched.features.valid() )
+      {
+        std::tie(feat, desc) = prefetched.features.get();
+      }
+      else
+      {
+        d_->feature_io->load(kwfd_file, feat, desc);
+      }
       if( feat && feat->size() > 0 && desc && desc->size() > 0 )
       {
         LOG_DEBUG( logger(), "Loaded features on frame " << frame_number
@@ -292,29 +376,39 @@ ::track(feature_track_set_sptr prev_tracks,
     }
   }
 
-  // compute features and descriptors from the image
+  // compute features and descriptors from the image, unless they were
+  // computed in advance; those are only usable if neither was found above
   bool features_computed = false;
-  if( !curr_feat || curr_feat->size() == 0 )
+  if( !prefetched.from_file && prefetched.features.valid() &&
+      ( !curr_feat || curr_feat->size() == 0 ) &&
+      ( !curr_desc || curr_desc->size() == 0 ) )
   {
-    LOG_DEBUG( logger(), "Computing new features on frame "<<frame_number);
-    // detect features on the current frame
-    curr_feat = d_->detector->detect(image_data, mask);
+    LOG_DEBUG( logger(), "Using prefetched features on frame "<<frame_number);
+    std::tie(curr_feat, curr_desc) = prefetched.features.get();
     features_computed = true;
   }
-  if( !curr_desc || curr_desc->size() == 0 )
+  else
   {
-    LOG_DEBUG( logger(), "Computing new descriptors on frame "<<frame_number);
-    // extract descriptors on the current frame
-    curr_desc = d_->extractor->extract(image_data, curr_feat, mask);
-    features_computed = true;
+    if( !curr_feat || curr_feat->size() == 0 )
+    {
+      LOG_DEBUG( logger(), "Computing new features on frame "<<frame_number);
+      // detect features on the current frame
+      curr_feat = d_->detector->detect(image_data, mask);
+      features_computed = true;
+    }
+    if( !curr_desc || curr_desc->size() == 0 )
+    {
+      LOG_DEBUG( logger(), "Computing new descriptors on frame "<<frame_number);
+      // extract descriptors on the current frame
+      curr_desc = d_->extractor->extract(image_data, curr_feat, mask);
+      features_computed = true;
+    }
   }
 
   // cache features if they were just computed and feature I/O is enabled
   if( features_computed && d_->feature_io && d_->features_dir != "")
   {
-    metadata_sptr md = image_data->get_metadata();
-    std::string basename = basename_from_metadata(md, frame_number);
-    path_t kwfd_file = d_->features_dir + "/" + basename + ".kwfd";
+    path_t kwfd_file = d_->features_file(image_data, frame_number);
 
     // make the enclosing directory if it does not already exist
     const kwiver::vital::path_t fd_dir = ST::GetFilenamePath( kwfd_file );
@@ -489,6 +583,93 @@ ::track(feature_track_set_sptr prev_tracks,
   return updated_track_set;
 }
 
+/// Begin computing features on a future frame
+bool
+track_features_core
+::prefetch(frame_id_t frame_number,
+           image_container_sptr image_data,
+           image_container_sptr mask) const
+{
+  if( !d_->max_prefetch_frames || !image_data )
+  {
+    return false;
+  }
+
+  // features cached on disk are loaded instead of computed
+  path_t kwfd_file;
+  if( d_->feature_io && d_->features_dir != "" )
+  {
+    kwfd_file = d_->features_file(image_data, frame_number);
+    if( !ST::FileExists( kwfd_file ) )
+    {
+      kwfd_file.clear();
+    }
+  }
+  bool const from_file = !kwfd_file.empty();
+
+  if( !from_file )
+  {
+    if( !d_->detector || !d_->extractor )
+    {
+      return false;
+    }
+
+    // leave a mismatched mask for track() to report
+    if( mask && mask->size() > 0 &&
+        ( image_data->width() != mask->width() ||
+          image_data->height() != mask->height() ) )
+    {
+      return false;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(d_->prefetch_mutex);
+  for( auto const& p : d_->prefetched )
+  {
+    if( p.frame == frame_number )
+    {
+      return true;
+    }
+  }
+  if( d_->prefetched.size() >= d_->max_prefetch_frames )
+  {
+    return false;
+  }
+
+  std::future<priv::features_t> features;
+  if( from_file )
+  {
+    LOG_DEBUG( logger(), "Prefetching features on frame " << frame_number
+                         << " from " << kwfd_file );
+    auto const feature_io = d_->feature_io;
+    features = vital::thread_pool::instance().enqueue(
+      [feature_io, kwfd_file]()
+      {
+        feature_set_sptr feat;
+        descriptor_set_sptr desc;
+        feature_io->load(kwfd_file, feat, desc);
+        return priv::features_t(feat, desc);
+      });
+  }
+  else
+  {
+    LOG_DEBUG( logger(), "Prefetching features on frame "<<frame_number);
+    auto const detector = d_->detector;
+    auto const extractor = d_->extractor;
+    features = vital::thread_pool::instance().enqueue(
+      [detector, extractor, image_data, mask]()
+      {
+        // the extractor may replace the features it is given
+        feature_set_sptr feat = detector->detect(image_data, mask);
+        descriptor_set_sptr desc = extractor->extract(image_data, feat, mask);
+        return priv::features_t(feat, desc);
+      });
+  }
+  d_->prefetched.push_back(
+    priv::prefetch_t{frame_number, from_file, std::move(features)});
+  return true;
+}
+
 } // end namespace core
 } // end namespace arrows
 } // end namespace kwiver
@@ -85,6 +85,28 @@ class KWIVER_ALGO_CORE_EXPORT track_features_core
         vital::image_container_sptr image_data,
         vital::image_container_sptr mask = {}) const override;
 
+  /// Begin detecting features and extracting descriptors on a future frame
+  ///
+  /// When max_prefetch_frames is non-zero, features for up to that many
+  /// frames are computed on the vital thread pool while earlier frames are
+  /// matched. Frames must be offered in the order in which they will be
+  /// tracked; offered frames which are skipped are discarded once a later
+  /// frame is tracked. Frames which already have features cached on disk
+  /// have them loaded by the feature_io algorithm instead.
+  ///
+  /// Detector, extractor and feature_io calls may run concurrently for
+  /// different frames when prefetching, so the configured algorithms must
+  /// allow this.
+  ///
+  /// \param [in] frame_number the frame number of the future frame
+  /// \param [in] image_data the image pixels for the future frame
+  /// \param [in] mask Optional mask image, as for track()
+  /// \returns true if the frame is being prefetched
+  bool
+  prefetch(vital::frame_id_t frame_number,
+           vital::image_container_sptr image_data,
+           vital::image_container_sptr mask = {}) const override;
+
 private:
   /// private implementation class
   class priv;
@@ -537,6 +537,682 @@ ::clone( vital::clone_type ct ) const
 #endif
 }
 
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Compare tracks, or entries of a column, to a track id
+struct id_less
+{
+  bool operator()( track_sptr const& t, track_id_t tid ) const
+  {
+    return t->id() < tid;
+  }
+  bool operator()( track_id_t tid, track_sptr const& t ) const
+  {
+    return tid < t->id();
+  }
+  bool operator()( columnar_track_set_impl::entry const& e,
+                   track_id_t tid ) const
+  {
+    return e.track_id < tid;
+  }
+  bool operator()( track_id_t tid,
+                   columnar_track_set_impl::entry const& e ) const
+  {
+    return tid < e.track_id;
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Follow track redirects left by merging, as merge_tracks does
+track_sptr
+follow_redirects( track_sptr t )
+{
+  std::shared_ptr<track_data_redirect> tdr;
+  while( t && t->empty() &&
+         (tdr = std::dynamic_pointer_cast<track_data_redirect>(t->data())) )
+  {
+    t = tdr->redirect_track;
+  }
+  return t;
+}
+
+} // end anonymous namespace
+
+// ----------------------------------------------------------------------------
+columnar_track_set_impl
+::columnar_track_set_impl()
+  : base_frame_(0)
+{
+}
+
+/// Constructor from a vector of tracks
+columnar_track_set_impl
+::columnar_track_set_impl( const std::vector< track_sptr >& tracks )
+  : base_frame_(0)
+{
+  this->set_tracks(tracks);
+}
+
+/// Return the number of tracks in the set
+size_t
+columnar_track_set_impl
+::size() const
+{
+  return tracks_.size();
+}
+
+/// Return whether or not there are any tracks in the set
+bool
+columnar_track_set_impl
+::empty() const
+{
+  return tracks_.empty();
+}
+
+/// Return true if the set contains a specific track
+bool
+columnar_track_set_impl
+::contains( vital::track_sptr t ) const
+{
+  return t && this->get_track(t->id()) == t;
+}
+
+/// Assign a vector of track shared pointers to this container
+void
+columnar_track_set_impl
+::set_tracks( std::vector< vital::track_sptr > const& tracks )
+{
+  tracks_.clear();
+  for (auto const& t : tracks)
+  {
+    if (t)
+    {
+      tracks_.push_back(t);
+    }
+  }
+
+  // keep the first of any tracks with the same id
+  std::stable_sort(tracks_.begin(), tracks_.end(), track_less);
+  tracks_.erase(
+    std::unique(tracks_.begin(), tracks_.end(),
+                [](track_sptr const& a, track_sptr const& b)
+                { return a->id() == b->id(); }),
+    tracks_.end());
+
+  // adding tracks in order of id appends to the end of every column
+  columns_.clear();
+  base_frame_ = 0;
+  for (auto const& t : tracks_)
+  {
+    this->add_states(*t);
+  }
+}
+
+/// Insert a track shared pointer into this container
+void
+columnar_track_set_impl
+::insert( vital::track_sptr const& t )
+{
+  this->insert(track_sptr(t));
+}
+
+/// Insert a track shared pointer into this container
+void
+columnar_track_set_impl
+::insert( vital::track_sptr&& t )
+{
+  if (!t)
+  {
+    return;
+  }
+
+  auto const itr =
+    std::lower_bound(tracks_.begin(), tracks_.end(), t->id(), id_less());
+  if (itr != tracks_.end() && (*itr)->id() == t->id())
+  {
+    return;
+  }
+  this->add_states(*t);
+  tracks_.insert(itr, std::move(t));
+}
+
+/// Notify the container that a new state has been added to an existing track
+void
+columnar_track_set_impl
+::notify_new_state( vital::track_state_sptr ts )
+{
+  auto const t = ts ? ts->track() : nullptr;
+  if (t)
+  {
+    this->add_state(t->id(), ts);
+  }
+}
+
+/// Notify the container that a state has been removed from an existing track
+void
+columnar_track_set_impl
+::notify_removed_state( vital::track_state_sptr ts )
+{
+  if (!ts)
+  {
+    return;
+  }
+
+  // the state no longer knows its track, so look for the state itself
+  auto const column = this->find_column(ts->frame());
+  if (!column)
+  {
+    return;
+  }
+  for (auto const& e : *column)
+  {
+    if (e.state == ts)
+    {
+      this->remove_state(e.track_id, ts->frame(), ts.get());
+      return;
+    }
+  }
+}
+
+/// Remove a track from the set and return true if successful
+bool
+columnar_track_set_impl
+::remove( vital::track_sptr t )
+{
+  if (!t)
+  {
+    return false;
+  }
+  auto const itr =
+    std::lower_bound(tracks_.begin(), tracks_.end(), t->id(), id_less());
+  if (itr == tracks_.end() || *itr != t)
+  {
+    return false;
+  }
+  tracks_.erase(itr);
+
+  for (auto const& ts : *t)
+  {
+    this->remove_state(t->id(), ts->frame(), ts.get());
+  }
+  return true;
+}
+
+/// Merge the pair of tracks t1 and t2, if possible
+bool
+columnar_track_set_impl
+::merge_tracks( vital::track_sptr t1, vital::track_sptr t2 )
+{
+  t1 = follow_redirects(t1);
+  t2 = follow_redirects(t2);
+  if (!t1 || !t2)
+  {
+    return false;
+  }
+
+  // the states of t1 move to t2, so their entries must be relabeled
+  std::vector<track_state_sptr> const moved(t1->begin(), t1->end());
+  if (!track_set_implementation::merge_tracks(t1, t2))
+  {
+    return false;
+  }
+  for (auto const& ts : moved)
+  {
+    this->remove_state(t1->id(), ts->frame(), ts.get());
+    this->add_state(t2->id(), ts);
+  }
+  return true;
+}
+
+/// Return a vector of track shared pointers
+std::vector< track_sptr >
+columnar_track_set_impl
+::tracks() const
+{
+  return tracks_;
+}
+
+/// Return the set of all frame IDs covered by these tracks
+std::set<frame_id_t>
+columnar_track_set_impl
+::all_frame_ids() const
+{
+  std::set<frame_id_t> ids;
+  for (size_t i = 0; i < columns_.size(); ++i)
+  {
+    if (!columns_[i].empty())
+    {
+      ids.insert(ids.end(), base_frame_ + static_cast<frame_id_t>(i));
+    }
+  }
+  return ids;
+}
+
+/// Return the set of all track IDs in this track set
+std::set<track_id_t>
+columnar_track_set_impl
+::all_track_ids() const
+{
+  std::set<track_id_t> ids;
+  for (auto const& t : tracks_)
+  {
+    ids.insert(ids.end(), t->id());
+  }
+  return ids;
+}
+
+/// Return the first (smallest) frame number containing tracks
+frame_id_t
+columnar_track_set_impl
+::first_frame() const
+{
+  if (columns_.empty())
+  {
+    return track_set_implementation::first_frame();
+  }
+  return base_frame_;
+}
+
+/// Return the last (largest) frame number containing tracks
+frame_id_t
+columnar_track_set_impl
+::last_frame() const
+{
+  if (columns_.empty())
+  {
+    return track_set_implementation::last_frame();
+  }
+  return base_frame_ + static_cast<frame_id_t>(columns_.size()) - 1;
+}
+
+/// Return the track in the set with the specified id.
+track_sptr const
+columnar_track_set_impl
+::get_track( track_id_t tid ) const
+{
+  auto const itr =
+    std::lower_bound(tracks_.begin(), tracks_.end(), tid, id_less());
+  if (itr != tracks_.end() && (*itr)->id() == tid)
+  {
+    return *itr;
+  }
+  return track_sptr();
+}
+
+/// Return the tracks of the entries of a column which satisfy a predicate
+template < typename Predicate >
+std::vector< track_sptr >
+columnar_track_set_impl
+::entry_tracks( column_t const* column, Predicate const& predicate ) const
+{
+  std::vector<track_sptr> result;
+  if (!column)
+  {
+    return result;
+  }
+
+  // both entries and tracks are sorted by id, so each search starts where
+  // the last one ended
+  auto itr = tracks_.begin();
+  for (auto const& e : *column)
+  {
+    itr = std::lower_bound(itr, tracks_.end(), e.track_id, id_less());
+    if (itr == tracks_.end())
+    {
+      break;
+    }
+    if ((*itr)->id() == e.track_id && predicate(**itr))
+    {
+      result.push_back(*itr);
+    }
+  }
+  return result;
+}
+
+/// Return all tracks active on a frame.
+std::vector< track_sptr >
+columnar_track_set_impl
+::active_tracks( frame_id_t offset ) const
+{
+  return this->entry_tracks(this->find_column(offset_to_frame(offset)),
+                            [](track const&) { return true; });
+}
+
+/// Return the ids of all tracks active on a frame.
+std::set< track_id_t >
+columnar_track_set_impl
+::active_track_ids( frame_id_t offset ) const
+{
+  std::set<track_id_t> ids;
+  if (auto const column = this->find_column(offset_to_frame(offset)))
+  {
+    for (auto const& e : *column)
+    {
+      ids.insert(ids.end(), e.track_id);
+    }
+  }
+  return ids;
+}
+
+/// Return the number of tracks active on a frame.
+size_t
+columnar_track_set_impl
+::num_active_tracks( frame_id_t offset ) const
+{
+  auto const column = this->find_column(offset_to_frame(offset));
+  return column ? column->size() : 0;
+}
+
+/// Return all tracks not active on a frame.
+std::vector< track_sptr >
+columnar_track_set_impl
+::inactive_tracks( frame_id_t offset ) const
+{
+  std::vector<track_sptr> inactive_tracks;
+  auto const column = this->find_column(offset_to_frame(offset));
+  if (!column)
+  {
+    return tracks_;
+  }
+
+  // walk the sorted tracks and entries together
+  auto e = column->begin();
+  for (auto const& t : tracks_)
+  {
+    while (e != column->end() && e->track_id < t->id())
+    {
+      ++e;
+    }
+    if (e == column->end() || e->track_id != t->id())
+    {
+      inactive_tracks.push_back(t);
+    }
+  }
+  return inactive_tracks;
+}
+
+/// Return all new tracks on a given frame.
+std::vector< track_sptr >
+columnar_track_set_impl
+::new_tracks( frame_id_t offset ) const
+{
+  frame_id_t const frame_number = offset_to_frame(offset);
+  return this->entry_tracks(this->find_column(frame_number),
+    [frame_number](track const& t)
+    {
+      return t.first_frame() == frame_number;
+    });
+}
+
+/// Return all terminated tracks on a given frame.
+std::vector< track_sptr >
+columnar_track_set_impl
+::terminated_tracks( frame_id_t offset ) const
+{
+  frame_id_t const frame_number = offset_to_frame(offset);
+  return this->entry_tracks(this->find_column(frame_number),
+    [frame_number](track const& t)
+    {
+      return t.last_frame() == frame_number;
+    });
+}
+
+/// Return the percentage of tracks successfully tracked to the next frame.
+double
+columnar_track_set_impl
+::percentage_tracked( frame_id_t offset1, frame_id_t offset2 ) const
+{
+  static column_t const no_entries;
+  auto const column1 = this->find_column(offset_to_frame(offset1));
+  auto const column2 = this->find_column(offset_to_frame(offset2));
+  auto const& entries1 = column1 ? *column1 : no_entries;
+  auto const& entries2 = column2 ? *column2 : no_entries;
+
+  // count the ids common to both frames
+  size_t num_common = 0;
+  auto e1 = entries1.begin();
+  auto e2 = entries2.begin();
+  while (e1 != entries1.end() && e2 != entries2.end())
+  {
+    if (e1->track_id < e2->track_id)
+    {
+      ++e1;
+    }
+    else if (e2->track_id < e1->track_id)
+    {
+      ++e2;
+    }
+    else
+    {
+      ++num_common;
+      ++e1;
+      ++e2;
+    }
+  }
+
+  auto const num_union = entries1.size() + entries2.size() - num_common;
+  if (num_union == 0)
+  {
+    return 0.0;
+  }
+  return static_cast<double>(num_common) / num_union;
+}
+
+/// Return a vector of state data corresponding to the tracks on the given frame.
+std::vector<track_state_sptr>
+columnar_track_set_impl
+::frame_states( frame_id_t offset ) const
+{
+  std::vector<track_state_sptr> vdata;
+  if (auto const column = this->find_column(offset_to_frame(offset)))
+  {
+    vdata.reserve(column->size());
+    for (auto const& e : *column)
+    {
+      vdata.push_back(e.state);
+    }
+  }
+  return vdata;
+}
+
+/// Return the entries of the states on the given frame
+std::pair< columnar_track_set_impl::entry const*,
+           columnar_track_set_impl::entry const* >
+columnar_track_set_impl
+::frame_entries( frame_id_t offset ) const
+{
+  auto const column = this->find_column(offset_to_frame(offset));
+  if (!column)
+  {
+    return { nullptr, nullptr };
+  }
+  return { column->data(), column->data() + column->size() };
+}
+
+/// Return the additional data associated with all tracks on the given frame
+track_set_frame_data_sptr
+columnar_track_set_impl
+::frame_data( frame_id_t offset ) const
+{
+  frame_id_t frame_number = offset_to_frame(offset);
+  auto itr = frame_data_.find(frame_number);
+  if ( itr != frame_data_.end() )
+  {
+    return itr->second;
+  }
+  return nullptr;
+}
+
+/// Removes the frame data for the frame offset
+bool
+columnar_track_set_impl
+::remove_frame_data( frame_id_t offset )
+{
+  frame_id_t frame_number = offset_to_frame(offset);
+  auto itr = frame_data_.find(frame_number);
+  if (itr != frame_data_.end())
+  {
+    frame_data_.erase(itr);
+    return true;
+  }
+  return false;
+}
+
+/// Set additional data associated with all tracks on the given frame
+bool
+columnar_track_set_impl
+::set_frame_data( track_set_frame_data_sptr data,
+                  frame_id_t offset )
+{
+  frame_id_t frame_number = offset_to_frame(offset);
+  if ( !data )
+  {
+    // remove the data on the specified frame
+    auto itr = frame_data_.find(frame_number);
+    if ( itr == frame_data_.end() )
+    {
+      return false;
+    }
+    frame_data_.erase(itr);
+  }
+  else
+  {
+    frame_data_[frame_number] = data;
+  }
+  return true;
+}
+
+track_set_implementation_uptr
+columnar_track_set_impl
+::clone( vital::clone_type ct ) const
+{
+  std::vector<track_sptr> cloned_tracks;
+  cloned_tracks.reserve(tracks_.size());
+  for ( auto const& trk : tracks_ )
+  {
+    cloned_tracks.push_back( trk->clone( ct ) );
+  }
+
+  std::unique_ptr<columnar_track_set_impl> the_clone{
+    new columnar_track_set_impl( cloned_tracks ) };
+
+  // clone the frame data
+  for ( auto const& fd : frame_data_ )
+  {
+    the_clone->frame_data_.emplace( fd.first, fd.second->clone() );
+  }
+
+#if __GNUC__ > 4 || __clang_major__ > 3
+  return the_clone;
+#else
+  return std::move( the_clone );
+#endif
+}
+
+/// Return the column of a frame, or nullptr if it has no states
+columnar_track_set_impl::column_t const*
+columnar_track_set_impl
+::find_column( frame_id_t frame ) const
+{
+  if (frame < base_frame_ ||
+      frame - base_frame_ >= static_cast<frame_id_t>(columns_.size()))
+  {
+    return nullptr;
+  }
+  auto const& column = columns_[static_cast<size_t>(frame - base_frame_)];
+  return column.empty() ? nullptr : &column;
+}
+
+/// Add entries for the states of a track
+void
+columnar_track_set_impl
+::add_states( track const& t )
+{
+  for (auto const& ts : t)
+  {
+    this->add_state(t.id(), ts);
+  }
+}
+
+/// Add an entry for a state
+void
+columnar_track_set_impl
+::add_state( track_id_t tid, track_state_sptr const& ts )
+{
+  frame_id_t const frame = ts->frame();
+
+  // grow the index to cover the frame
+  if (columns_.empty())
+  {
+    base_frame_ = frame;
+    columns_.resize(1);
+  }
+  else if (frame < base_frame_)
+  {
+    columns_.insert(columns_.begin(),
+                    static_cast<size_t>(base_frame_ - frame), column_t{});
+    base_frame_ = frame;
+  }
+  else if (frame - base_frame_ >= static_cast<frame_id_t>(columns_.size()))
+  {
+    columns_.resize(static_cast<size_t>(frame - base_frame_) + 1);
+  }
+
+  // new tracks usually have the largest id, so try the end first
+  auto& column = columns_[static_cast<size_t>(frame - base_frame_)];
+  if (column.empty() || column.back().track_id < tid)
+  {
+    column.push_back({ tid, ts });
+    return;
+  }
+  auto const itr =
+    std::lower_bound(column.begin(), column.end(), tid, id_less());
+  if (itr == column.end() || itr->track_id != tid)
+  {
+    column.insert(itr, { tid, ts });
+  }
+}
+
+/// Remove the entry for a state of a track
+void
+columnar_track_set_impl
+::remove_state( track_id_t tid, frame_id_t frame, track_state const* ts )
+{
+  if (frame < base_frame_ ||
+      frame - base_frame_ >= static_cast<frame_id_t>(columns_.size()))
+  {
+    return;
+  }
+  auto& column = columns_[static_cast<size_t>(frame - base_frame_)];
+  auto const itr =
+    std::lower_bound(column.begin(), column.end(), tid, id_less());
+  if (itr != column.end() && itr->track_id == tid && itr->state.get() == ts)
+  {
+    column.erase(itr);
+    if (column.empty())
+    {
+      this->trim_columns();
+    }
+  }
+}
+
+/// Drop empty columns from both ends of the index
+void
+columnar_track_set_impl
+::trim_columns()
+{
+  while (!columns_.empty() && columns_.back().empty())
+  {
+    columns_.pop_back();
+  }
+  auto const first = std::find_if(columns_.begin(), columns_.end(),
+                                  [](column_t const& c) { return !c.empty(); });
+  base_frame_ += static_cast<frame_id_t>(first - columns_.begin());
+  columns_.erase(columns_.begin(), first);
+}
+
 } // end namespace core
 } // end namespace arrows
 } // end namespace kwiver
@@ -14,6 +14,8 @@
 
 #include <map>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace kwiver {
 namespace arrows {
@@ -153,6 +155,193 @@ class KWIVER_ALGO_CORE_EXPORT frame_index_track_set_impl
   mutable std::map<vital::frame_id_t, std::set<vital::track_state_sptr> > frame_map_;
 };
 
+/// A track set implementation storing the states of each frame contiguously
+///
+/// Tracks are kept in a vector sorted by id, and the states on each frame
+/// are kept in a column, a vector of (track id, state) entries sorted by
+/// track id. Columns are indexed directly by frame number, so finding the
+/// states on a frame takes constant time, and the index is kept up to date
+/// on every change rather than rebuilt on demand. Results are ordered by
+/// track id, so they do not depend on where states are allocated.
+///
+/// Memory for the index is proportional to the range of frame numbers, so
+/// this suits sets of densely numbered frames, such as the frames of a
+/// video. As with frame_index_track_set_impl, states added to or removed
+/// from tracks already in the set must be reported with notify_new_state()
+/// and notify_removed_state(). Track ids must not change while in the set.
+class KWIVER_ALGO_CORE_EXPORT columnar_track_set_impl
+  : public vital::track_set_implementation
+{
+public:
+  /// A state on a frame and the id of its track
+  struct entry
+  {
+    vital::track_id_t track_id;
+    vital::track_state_sptr state;
+  };
+
+  /// Default Constructor
+  columnar_track_set_impl();
+
+  /// Constructor from a vector of tracks
+  explicit columnar_track_set_impl( const std::vector< vital::track_sptr >& tracks );
+
+  /// Destructor
+  virtual ~columnar_track_set_impl() = default;
+
+  /// Return the number of tracks in the set
+  virtual size_t size() const;
+
+  /// Return whether or not there are any tracks in the set
+  virtual bool empty() const;
+
+  /// Return true if the set contains a specific track
+  virtual bool contains( vital::track_sptr t ) const;
+
+  /// Assign a vector of track shared pointers to this container
+  virtual void set_tracks( std::vector< vital::track_sptr > const& tracks );
+
+  /// Insert a track shared pointer into this container
+  //@{
+  virtual void insert( vital::track_sptr const& t );
+  virtual void insert( vital::track_sptr&& t );
+  //@}
+
+  /// Notify the container that a new state has been added to an existing track
+  virtual void notify_new_state( vital::track_state_sptr ts );
+
+  /// Notify the container that a state has been removed from an existing track
+  virtual void notify_removed_state( vital::track_state_sptr ts );
+
+  /// Remove a track from the set and return true if successful
+  virtual bool remove( vital::track_sptr t );
+
+  /// Merge the pair of tracks \p t1 and \p t2, if possible
+  virtual bool merge_tracks( vital::track_sptr t1, vital::track_sptr t2 );
+
+  /// Return a vector of track shared pointers, ordered by id
+  virtual std::vector< vital::track_sptr > tracks() const;
+
+  /// Return the set of all frame IDs covered by these tracks
+  virtual std::set< vital::frame_id_t > all_frame_ids() const;
+
+  /// Return the set of all track IDs in this track set
+  virtual std::set< vital::track_id_t > all_track_ids() const;
+
+  /// Return the first (smallest) frame number containing tracks
+  virtual vital::frame_id_t first_frame() const;
+
+  /// Return the last (largest) frame number containing tracks
+  virtual vital::frame_id_t last_frame() const;
+
+  /// Return the track in this set with the specified id.
+  virtual vital::track_sptr const get_track( vital::track_id_t tid ) const;
+
+  /// Return all tracks active on a frame.
+  virtual std::vector< vital::track_sptr>
+  active_tracks( vital::frame_id_t offset = -1 ) const;
+
+  /// Return the ids of all tracks active on a frame.
+  virtual std::set< vital::track_id_t >
+  active_track_ids( vital::frame_id_t offset = -1 ) const;
+
+  /// Return the number of tracks active on a frame.
+  virtual size_t num_active_tracks( vital::frame_id_t offset = -1 ) const;
+
+  /// Return all tracks inactive on a frame.
+  virtual std::vector< vital::track_sptr >
+  inactive_tracks( vital::frame_id_t offset = -1 ) const;
+
+  /// Return all tracks newly initialized on the given frame.
+  virtual std::vector< vital::track_sptr >
+  new_tracks( vital::frame_id_t offset = -1 ) const;
+
+  /// Return all tracks terminated on the given frame.
+  virtual std::vector< vital::track_sptr >
+  terminated_tracks( vital::frame_id_t offset = -1 ) const;
+
+  /// Return the percentage of tracks successfully tracked between two frames.
+  virtual double percentage_tracked( vital::frame_id_t offset1 = -2,
+                                     vital::frame_id_t offset2 = -1 ) const;
+
+  /// Return a vector of state data corresponding to the tracks on the given frame.
+  virtual std::vector< vital::track_state_sptr >
+  frame_states( vital::frame_id_t offset = -1 ) const;
+
+  /// Return the entries of the states on the given frame, ordered by track id
+  ///
+  /// This gives access to the states on a frame without copying any shared
+  /// pointers. The range is valid until the set is next modified.
+  ///
+  /// \returns pointers to the first entry and one past the last entry
+  std::pair< entry const*, entry const* >
+  frame_entries( vital::frame_id_t offset = -1 ) const;
+
+  /// Returns all frame data as map of frame index to track_set_frame_data
+  virtual vital::track_set_frame_data_map_t all_frame_data() const
+  {
+    return frame_data_;
+  }
+
+  /// Return the additional data associated with all tracks on the given frame
+  virtual vital::track_set_frame_data_sptr
+  frame_data( vital::frame_id_t offset = -1 ) const;
+
+  /// Removes the frame data for the frame offset
+  virtual bool remove_frame_data( vital::frame_id_t offset );
+
+  /// Set additional frame data associated with all tracks for all frames
+  virtual bool set_frame_data( vital::track_set_frame_data_map_t const& fmap )
+  {
+    frame_data_ = fmap;
+    return true;
+  }
+
+  /// Set additional data associated with all tracks on the given frame
+  virtual bool set_frame_data( vital::track_set_frame_data_sptr data,
+                               vital::frame_id_t offset = -1 );
+
+  vital::track_set_implementation_uptr clone(
+    vital::clone_type = vital::clone_type::DEEP ) const override;
+
+protected:
+  /// The frame data map
+  vital::track_set_frame_data_map_t frame_data_;
+
+private:
+  typedef std::vector< entry > column_t;
+
+  /// Return the column of a frame, or nullptr if it has no states
+  column_t const* find_column( vital::frame_id_t frame ) const;
+
+  /// Add entries for the states of a track
+  void add_states( vital::track const& t );
+
+  /// Add an entry for a state, unless its track already has one on the frame
+  void add_state( vital::track_id_t tid, vital::track_state_sptr const& ts );
+
+  /// Remove the entry for a state of a track
+  void remove_state( vital::track_id_t tid, vital::frame_id_t frame,
+                     vital::track_state const* ts );
+
+  /// Drop empty columns from both ends of the index
+  void trim_columns();
+
+  /// Return the tracks of a run of entries, ordered by id
+  template < typename Predicate >
+  std::vector< vital::track_sptr >
+  entry_tracks( column_t const* column, Predicate const& predicate ) const;
+
+  /// All tracks, sorted by id
+  std::vector< vital::track_sptr > tracks_;
+
+  /// The frame number of the first column
+  vital::frame_id_t base_frame_;
+
+  /// The states on each frame from base_frame_ on, sorted by track id
+  std::vector< column_t > columns_;
+};
+
 } // end namespace core
 } // end namespace arrows
 } // end namespace kwiver
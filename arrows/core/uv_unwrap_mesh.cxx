@@ -108,7 +108,8 @@ void uv_unwrap_mesh::unwrap(kwiver::vital::mesh_sptr mesh) const
                  "This algorithm expects a regular mesh with triangular faces.");
   }
 
-  const mesh_face_array_base& faces = mesh->faces();
+  const auto& faces =
+    static_cast<const mesh_regular_face_array<3>&>(mesh->faces());
   const mesh_vertex_array<3>& vertices = dynamic_cast<const mesh_vertex_array<3>&>(mesh->vertices());
 
   // Map each triangle in 2d. The longest edge should be horizontal and its left point is (0, 0)
@@ -117,9 +118,9 @@ void uv_unwrap_mesh::unwrap(kwiver::vital::mesh_sptr mesh) const
   for (unsigned int f = 0; f < mesh->num_faces(); ++f)
   {
     // face 3d points
-    vector_3d pt1 = vertices[faces(f, 0)];
-    vector_3d pt2 = vertices[faces(f, 1)];
-    vector_3d pt3 = vertices[faces(f, 2)];
+    vector_3d pt1 = vertices[faces[f][0]];
+    vector_3d pt2 = vertices[faces[f][1]];
+    vector_3d pt3 = vertices[faces[f][2]];
 
     // triangle edges
     vector_3d pt1pt2 = pt2 - pt1;
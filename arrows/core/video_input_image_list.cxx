@@ -20,11 +20,16 @@
 
 #include <vital/range/iota.h>
 
+#include <vital/util/thread_pool.h>
+
 #include <kwiversys/Directory.hxx>
 #include <kwiversys/SystemTools.hxx>
 
 #include <algorithm>
 #include <fstream>
+#include <future>
+#include <list>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -67,6 +72,8 @@ class video_input_image_list::priv
   std::vector< std::string > c_search_path;
   std::vector< std::string > c_allowed_extensions;
   bool c_sort_by_time = false;
+  unsigned c_read_ahead = 0;
+  size_t c_cache_size_mb = 0;
 
   // Local state
   std::vector< kv::path_t > m_files;
@@ -79,9 +86,25 @@ class video_input_image_list::priv
   vital::metadata_map::map_metadata_t m_metadata_map;
   std::map< kv::path_t, kv::metadata_sptr > m_metadata_by_path;
 
+  // Images being read ahead, by index in m_files
+  std::map< size_t, std::shared_future< kv::image_container_sptr > >
+    m_pending;
+
+  // Recently read images, most recent first
+  using cache_entry_t = std::pair< kv::path_t, kv::image_container_sptr >;
+  std::list< cache_entry_t > m_cache;
+  std::map< kv::path_t, std::list< cache_entry_t >::iterator > m_cache_index;
+  size_t m_cache_bytes = 0;
+
   // Processing classes
   vital::algo::image_io_sptr m_image_reader;
 
+  kv::image_container_sptr load_image( size_t index );
+  void read_ahead( size_t index );
+  void cache_image( kv::path_t const& file,
+                    kv::image_container_sptr const& image );
+  void clear_images();
+
   void read_from_file( std::string const& filename );
   void read_from_directory( std::string const& dirname );
   void sort_by_time( std::vector< kv::path_t >& files );
@@ -146,6 +169,18 @@ ::get_configuration() const
     "sort_by_time", d->c_sort_by_time,
     "Instead of accepting the input list as-is, sort the input file list "
     "based on the timestamp metadata provided for the file." );
+  config->set_value(
+    "read_ahead", d->c_read_ahead,
+    "Number of images after the current one to read in the background on "
+    "the vital thread pool, so that reading overlaps processing. "
+    "The image reader must support concurrent loads. "
+    "Set to 0 to read each image only when it is requested." );
+  config->set_value(
+    "cache_size_mb", d->c_cache_size_mb,
+    "Maximum memory, in megabytes, used to keep recently read images, so "
+    "that seeking back to one does not read it again. Cached images are "
+    "shared with earlier callers of frame_image(). Set to 0 to disable "
+    "the cache." );
 
   image_io::get_nested_algo_configuration(
     "image_reader", config, d->m_image_reader );
@@ -176,6 +211,9 @@ ::set_configuration( vital::config_block_sptr in_config )
 
   // Read standalone variables
   d->c_sort_by_time = config->get_value< bool >( "sort_by_time" );
+  d->c_read_ahead = config->get_value< unsigned >( "read_ahead" );
+  d->c_cache_size_mb = config->get_value< size_t >( "cache_size_mb" );
+  d->clear_images();
 
   // Setup actual reader algorithm
   image_io::set_nested_algo_configuration(
@@ -236,6 +274,7 @@ ::close()
   d->m_current_file = d->m_files.end();
   d->m_frame_number = 0;
   d->m_image = nullptr;
+  d->clear_images();
 }
 
 // ----------------------------------------------------------------------------
@@ -376,11 +415,11 @@ ::frame_image()
     LOG_DEBUG( logger(),
                "reading image from file \"" << *d->m_current_file << "\"" );
 
-    // Read image file
-    //
-    // This call returns a *new* image container; this is good since
-    // we are going to pass it downstream using the sptr
-    d->m_image = d->m_image_reader->load( *d->m_current_file );
+    // Read image file, unless it was read ahead or is still cached
+    auto const index =
+      static_cast< size_t >( d->m_current_file - d->m_files.cbegin() );
+    d->m_image = d->load_image( index );
+    d->read_ahead( index );
   }
   return d->m_image;
 }
@@ -592,6 +631,111 @@ ::read_from_directory( std::string const& dirname )
   }
 }
 
+// ----------------------------------------------------------------------------
+kv::image_container_sptr
+video_input_image_list::priv
+::load_image( size_t index )
+{
+  auto const& file = m_files[ index ];
+
+  auto const c = m_cache_index.find( file );
+  if ( c != m_cache_index.end() )
+  {
+    m_cache.splice( m_cache.begin(), m_cache, c->second );
+    return c->second->second;
+  }
+
+  kv::image_container_sptr image;
+  auto const p = m_pending.find( index );
+  if ( p != m_pending.end() )
+  {
+    auto const pending = p->second;
+    m_pending.erase( p );
+    image = pending.get();
+  }
+  else
+  {
+    image = m_image_reader->load( file );
+  }
+
+  cache_image( file, image );
+  return image;
+}
+
+// ----------------------------------------------------------------------------
+void
+video_input_image_list::priv
+::read_ahead( size_t index )
+{
+  auto const end = std::min( index + 1 + c_read_ahead, m_files.size() );
+
+  // Forget images no longer ahead of the current one, e.g. after a seek;
+  // their reads finish on their own
+  for ( auto p = m_pending.begin(); p != m_pending.end(); )
+  {
+    if ( p->first <= index || p->first >= end )
+    {
+      p = m_pending.erase( p );
+    }
+    else
+    {
+      ++p;
+    }
+  }
+
+  for ( auto i = index + 1; i < end; ++i )
+  {
+    auto const& file = m_files[ i ];
+    if ( m_pending.count( i ) || m_cache_index.count( file ) )
+    {
+      continue;
+    }
+
+    // The task holds its own reference to the reader, so it may outlive
+    // this object
+    auto const reader = m_image_reader;
+    m_pending.emplace(
+      i, kv::thread_pool::instance().enqueue(
+        [ reader, file ](){ return reader->load( file ); } ).share() );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+video_input_image_list::priv
+::cache_image( kv::path_t const& file, kv::image_container_sptr const& image )
+{
+  size_t const max_bytes = c_cache_size_mb * 1024 * 1024;
+  size_t const bytes = image ? image->size() : 0;
+  if ( !image || !max_bytes || bytes > max_bytes )
+  {
+    return;
+  }
+
+  m_cache.emplace_front( file, image );
+  m_cache_index[ file ] = m_cache.begin();
+  m_cache_bytes += bytes;
+
+  while ( m_cache_bytes > max_bytes )
+  {
+    auto const& oldest = m_cache.back();
+    m_cache_bytes -= oldest.second->size();
+    m_cache_index.erase( oldest.first );
+    m_cache.pop_back();
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+video_input_image_list::priv
+::clear_images()
+{
+  m_pending.clear();
+  m_cache.clear();
+  m_cache_index.clear();
+  m_cache_bytes = 0;
+}
+
 // ----------------------------------------------------------------------------
 kv::metadata_sptr
 video_input_image_list::priv
@@ -25,6 +25,9 @@ namespace core {
 /// Example config:
 ///   # select reader type
 ///   image_reader:type = vxl
+///   # read up to 4 images ahead and keep 256 MB of recent images
+///   read_ahead = 4
+///   cache_size_mb = 256
 class KWIVER_ALGO_CORE_EXPORT video_input_image_list
   : public vital::algo::video_input
 {
@@ -28,10 +28,21 @@ class video_input_metadata_filter::priv
 
   kv::metadata_vector transform_current_frame_metadata() const;
 
+  void reset_cache();
+
   vital::algo::video_input_sptr video_input;
   vital::algo::metadata_filter_sptr metadata_filter;
 
   bool filter_uses_image = true;
+
+  // Filtered metadata of the last frame asked for, so that asking again for
+  // the metadata of the same frame does not run the filter again
+  bool has_frame_metadata = false;
+  kv::timestamp::frame_t frame_metadata_frame = 0;
+  kv::metadata_vector frame_metadata;
+
+  // Filtered metadata of the whole video
+  kv::metadata_map_sptr metadata_map;
 };
 
 // ----------------------------------------------------------------------------
@@ -68,6 +79,16 @@ ::transform_current_frame_metadata() const
     this->video_input->frame_metadata(), this->current_image_for_transform() );
 }
 
+// ----------------------------------------------------------------------------
+void
+video_input_metadata_filter::priv
+::reset_cache()
+{
+  this->has_frame_metadata = false;
+  this->frame_metadata.clear();
+  this->metadata_map.reset();
+}
+
 // ----------------------------------------------------------------------------
 video_input_metadata_filter
 ::video_input_metadata_filter()
@@ -110,6 +131,8 @@ ::set_configuration( vital::config_block_sptr in_config )
   vital::algo::metadata_filter::set_nested_algo_configuration(
     "metadata_filter", config, m_d->metadata_filter );
 
+  m_d->reset_cache();
+
   if( m_d->metadata_filter )
   {
     auto const& caps = m_d->metadata_filter->get_implementation_capabilities();
@@ -142,6 +165,7 @@ ::open( std::string name )
                  type_name(), impl_name(), "invalid video_input." );
   }
   m_d->video_input->open( name );
+  m_d->reset_cache();
 
   auto const& vi_caps = m_d->video_input->get_implementation_capabilities();
 
@@ -173,6 +197,7 @@ ::close()
   {
     m_d->video_input->close();
   }
+  m_d->reset_cache();
 }
 
 // ----------------------------------------------------------------------------
@@ -227,7 +252,21 @@ ::frame_metadata()
     return {};
   }
 
-  return m_d->transform_current_frame_metadata();
+  auto const ts = m_d->video_input->frame_timestamp();
+  if( !ts.has_valid_frame() )
+  {
+    return m_d->transform_current_frame_metadata();
+  }
+
+  if( !m_d->has_frame_metadata ||
+      m_d->frame_metadata_frame != ts.get_frame() )
+  {
+    m_d->frame_metadata = m_d->transform_current_frame_metadata();
+    m_d->frame_metadata_frame = ts.get_frame();
+    m_d->has_frame_metadata = true;
+  }
+
+  return m_d->frame_metadata;
 }
 
 // ----------------------------------------------------------------------------
@@ -257,6 +296,13 @@ ::metadata_map()
     return m_d->video_input->metadata_map();
   }
 
+  // Filtering the metadata of the whole video may mean decoding every frame,
+  // so the result is kept until the video or configuration changes
+  if( m_d->metadata_map )
+  {
+    return m_d->metadata_map;
+  }
+
   auto out = vital::metadata_map::map_metadata_t{};
 
   if( m_d->filter_uses_image )
@@ -291,7 +337,8 @@ ::metadata_map()
       m_d->video_input->seek_frame( ts, previous_frame );
     }
 
-    return std::make_shared< kv::simple_metadata_map >( out );
+    m_d->metadata_map = std::make_shared< kv::simple_metadata_map >( out );
+    return m_d->metadata_map;
   }
   else
   {
@@ -307,7 +354,8 @@ ::metadata_map()
         i.first, m_d->transform_frame_metadata( i.second, nullptr ) );
     }
 
-    return std::make_shared< kv::simple_metadata_map >( out );
+    m_d->metadata_map = std::make_shared< kv::simple_metadata_map >( out );
+    return m_d->metadata_map;
   }
 }
 
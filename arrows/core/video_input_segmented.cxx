@@ -0,0 +1,694 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "video_input_segmented.h"
+
+#include <vital/vital_config.h>
+#include <vital/vital_types.h>
+#include <vital/exceptions.h>
+#include <vital/optional.h>
+#include <vital/util/bounded_buffer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+using frame_t = kwiver::vital::timestamp::frame_t;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// An entry in the buffer of a worker thread
+struct segment_frame
+{
+  enum kind_t
+  {
+    // A decoded frame
+    FRAME,
+    // All frames of the worker's current chunk have been sent
+    END_OF_CHUNK,
+    // The worker has exited; no more entries will follow
+    FINISHED,
+  };
+
+  segment_frame( kind_t kind = FRAME )
+    : kind( kind )
+  { }
+
+  kind_t kind;
+  kwiver::vital::timestamp timestamp;
+  kwiver::vital::image_container_sptr image;
+  kwiver::vital::metadata_vector metadata;
+  std::exception_ptr error;
+};
+
+// ----------------------------------------------------------------------------
+struct segment_worker
+{
+  vital::algo::video_input_sptr source;
+  std::unique_ptr< vital::bounded_buffer< segment_frame > > buffer;
+  std::thread thread;
+  bool finished;
+};
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+class video_input_segmented::priv
+{
+public:
+  priv( video_input_segmented& parent ) :
+  parent( parent ),
+  c_num_workers( 4 ),
+  c_chunk_frames( 60 ),
+  c_segment_count( 0 ),
+  c_segment_index( 0 ),
+  d_parallel( false ),
+  d_started( false ),
+  d_at_eov( true ),
+  d_first_frame( 1 ),
+  d_last_frame( 0 ),
+  d_chunk_origin( 1 ),
+  d_num_chunks( 0 ),
+  d_next_chunk( 0 ),
+  d_stop( false )
+  { }
+
+  vital::algo::video_input_sptr create_source() const;
+
+  void start_workers( frame_t first_frame );
+  void stop_workers();
+  void run_worker( segment_worker& worker, size_t index );
+  bool next_parallel( kwiver::vital::timestamp& ts );
+
+  video_input_segmented& parent;
+
+  // Configuration values
+  unsigned int c_num_workers;
+  unsigned int c_chunk_frames;
+  unsigned int c_segment_count;
+  unsigned int c_segment_index;
+  vital::config_block_sptr c_config;
+
+  // Source which answers everything not served by the workers
+  vital::algo::video_input_sptr d_video_source;
+
+  // True if frames are coming from the worker threads
+  bool d_parallel;
+  bool d_started;
+  bool d_at_eov;
+
+  // Range of frames produced by this reader
+  frame_t d_first_frame;
+  frame_t d_last_frame;
+
+  // Chunks of c_chunk_frames frames, counted from d_chunk_origin
+  frame_t d_chunk_origin;
+  size_t d_num_chunks;
+  size_t d_next_chunk;
+
+  std::atomic< bool > d_stop;
+  std::vector< std::unique_ptr< segment_worker > > d_workers;
+  kwiver::vital::optional< segment_frame > d_current;
+};
+
+// ----------------------------------------------------------------------------
+vital::algo::video_input_sptr
+video_input_segmented::priv
+::create_source() const
+{
+  vital::algo::video_input_sptr source;
+  vital::algo::video_input::
+    set_nested_algo_configuration( "video_source", c_config, source );
+
+  if ( ! source )
+  {
+    VITAL_THROW( kwiver::vital::algorithm_configuration_exception,
+                 parent.type_name(), parent.impl_name(),
+                 "invalid video_input algorithm for video source" );
+  }
+
+  return source;
+}
+
+// ----------------------------------------------------------------------------
+void
+video_input_segmented::priv
+::start_workers( frame_t first_frame )
+{
+  d_chunk_origin = first_frame;
+  d_num_chunks = static_cast< size_t >(
+    ( d_last_frame - first_frame + c_chunk_frames ) / c_chunk_frames );
+  d_next_chunk = 0;
+  d_at_eov = false;
+  d_stop = false;
+
+  for ( size_t i = 0; i < d_workers.size(); ++i )
+  {
+    auto& worker = *d_workers[ i ];
+
+    // Room for a whole chunk and its end marker lets each worker decode its
+    // next chunk while earlier chunks are being consumed
+    worker.buffer.reset(
+      new vital::bounded_buffer< segment_frame >( c_chunk_frames + 1 ) );
+    worker.finished = false;
+    worker.thread = std::thread( &priv::run_worker, this, std::ref( worker ), i );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+video_input_segmented::priv
+::stop_workers()
+{
+  d_stop = true;
+
+  // Drain the buffers so that no worker stays blocked on a full buffer
+  for ( auto& worker : d_workers )
+  {
+    if ( ! worker->buffer )
+    {
+      continue;
+    }
+
+    while ( ! worker->finished )
+    {
+      worker->finished =
+        ( worker->buffer->Receive().kind == segment_frame::FINISHED );
+    }
+    worker->thread.join();
+    worker->buffer.reset();
+  }
+
+  d_current.reset();
+}
+
+// ----------------------------------------------------------------------------
+void
+video_input_segmented::priv
+::run_worker( segment_worker& worker, size_t index )
+{
+  segment_frame finished( segment_frame::FINISHED );
+
+  try
+  {
+    for ( size_t chunk = index;
+          chunk < d_num_chunks && ! d_stop;
+          chunk += d_workers.size() )
+    {
+      frame_t const first =
+        d_chunk_origin + static_cast< frame_t >( chunk * c_chunk_frames );
+      frame_t const last =
+        std::min< frame_t >( first + c_chunk_frames - 1, d_last_frame );
+
+      kwiver::vital::timestamp ts;
+      bool status = worker.source->seek_frame( ts, first );
+      if ( ! status )
+      {
+        LOG_ERROR( parent.logger(), "Could not seek to frame " << first
+                   << "; frames " << first << " to " << last
+                   << " will be missing" );
+      }
+
+      while ( status && ! d_stop && ts.get_frame() <= last )
+      {
+        segment_frame frame;
+        frame.timestamp = ts;
+        frame.image = worker.source->frame_image();
+        frame.metadata = worker.source->frame_metadata();
+        worker.buffer->Send( frame );
+
+        status = ts.get_frame() < last && worker.source->next_frame( ts );
+      }
+
+      worker.buffer->Send( segment_frame( segment_frame::END_OF_CHUNK ) );
+    }
+  }
+  catch ( ... )
+  {
+    finished.error = std::current_exception();
+  }
+
+  worker.buffer->Send( finished );
+}
+
+// ----------------------------------------------------------------------------
+bool
+video_input_segmented::priv
+::next_parallel( kwiver::vital::timestamp& ts )
+{
+  // Chunk n is always produced by worker n % number of workers
+  while ( d_next_chunk < d_num_chunks )
+  {
+    auto& worker = *d_workers[ d_next_chunk % d_workers.size() ];
+    if ( worker.finished )
+    {
+      ++d_next_chunk;
+      continue;
+    }
+
+    auto next = worker.buffer->Receive();
+    switch ( next.kind )
+    {
+      case segment_frame::FRAME:
+        ts = next.timestamp;
+        d_current = std::move( next );
+        return true;
+
+      case segment_frame::END_OF_CHUNK:
+        ++d_next_chunk;
+        break;
+
+      case segment_frame::FINISHED:
+        worker.finished = true;
+        if ( next.error )
+        {
+          d_current.reset();
+          std::rethrow_exception( next.error );
+        }
+        ++d_next_chunk;
+        break;
+    }
+  }
+
+  d_current.reset();
+  d_at_eov = true;
+  return false;
+}
+
+// ----------------------------------------------------------------------------
+video_input_segmented
+::video_input_segmented()
+  : d( new video_input_segmented::priv( *this ) )
+{
+  attach_logger( "arrows.core.video_input_segmented" );
+}
+
+// ----------------------------------------------------------------------------
+video_input_segmented
+::~video_input_segmented()
+{
+  this->close();
+}
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+video_input_segmented
+::get_configuration() const
+{
+  // get base config from base class
+  vital::config_block_sptr config = vital::algo::video_input::get_configuration();
+
+  config->set_value( "num_workers", d->c_num_workers,
+                     "Number of threads, each with its own instance of the video "
+                     "source, which decode chunks of the video concurrently. "
+                     "Not used when segment_count is set." );
+
+  config->set_value( "chunk_frames", d->c_chunk_frames,
+                     "Number of consecutive frames decoded by one worker before it "
+                     "moves on to its next chunk. Each chunk costs one seek, so "
+                     "this should be several times the keyframe interval of the "
+                     "video. Each worker buffers up to this many decoded frames." );
+
+  config->set_value( "segment_count", d->c_segment_count,
+                     "If non-zero, the video is divided into this many contiguous "
+                     "segments of near equal length, and only the segment selected "
+                     "by segment_index is read, in the calling thread." );
+
+  config->set_value( "segment_index", d->c_segment_index,
+                     "Zero-based index of the segment to read when segment_count "
+                     "is set." );
+
+  vital::algo::video_input::
+    get_nested_algo_configuration( "video_source", config, d->d_video_source );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+video_input_segmented
+::set_configuration( vital::config_block_sptr in_config )
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config( in_config );
+
+  d->c_num_workers =
+    config->get_value<unsigned int>( "num_workers", d->c_num_workers );
+  d->c_chunk_frames =
+    config->get_value<unsigned int>( "chunk_frames", d->c_chunk_frames );
+  d->c_segment_count =
+    config->get_value<unsigned int>( "segment_count", d->c_segment_count );
+  d->c_segment_index =
+    config->get_value<unsigned int>( "segment_index", d->c_segment_index );
+
+  // Keep the configuration to create the worker sources from
+  d->c_config = config;
+
+  vital::algo::video_input::
+    set_nested_algo_configuration( "video_source", config, d->d_video_source );
+
+  if ( d->d_video_source )
+  {
+    typedef vital::algo::video_input vi;
+
+    auto const& caps = d->d_video_source->get_implementation_capabilities();
+
+    set_capability( vi::HAS_EOV, caps.capability( vi::HAS_EOV ) );
+    set_capability( vi::HAS_FRAME_NUMBERS, caps.capability( vi::HAS_FRAME_NUMBERS ) );
+    set_capability( vi::HAS_FRAME_DATA, caps.capability( vi::HAS_FRAME_DATA ) );
+    set_capability( vi::HAS_FRAME_TIME, caps.capability( vi::HAS_FRAME_TIME ) );
+    set_capability( vi::HAS_METADATA, caps.capability( vi::HAS_METADATA ) );
+    set_capability( vi::HAS_ABSOLUTE_FRAME_TIME,
+                    caps.capability( vi::HAS_ABSOLUTE_FRAME_TIME ) );
+    set_capability( vi::HAS_TIMEOUT, false );
+    set_capability( vi::IS_SEEKABLE, caps.capability( vi::IS_SEEKABLE ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+bool
+video_input_segmented
+::check_configuration( vital::config_block_sptr config ) const
+{
+  bool status = vital::algo::video_input::
+    check_nested_algo_configuration( "video_source", config );
+
+  if ( config->get_value<unsigned int>( "chunk_frames", 1 ) < 1 ||
+       config->get_value<unsigned int>( "num_workers", 1 ) < 1 )
+  {
+    LOG_ERROR( logger(), "chunk_frames and num_workers must be positive" );
+    status = false;
+  }
+
+  auto const segment_count =
+    config->get_value<unsigned int>( "segment_count", 0 );
+  if ( segment_count &&
+       config->get_value<unsigned int>( "segment_index", 0 ) >= segment_count )
+  {
+    LOG_ERROR( logger(), "segment_index must be less than segment_count" );
+    status = false;
+  }
+
+  return status;
+}
+
+// ----------------------------------------------------------------------------
+void
+video_input_segmented
+::open( std::string name )
+{
+  this->close();
+
+  if ( ! d->d_video_source )
+  {
+    VITAL_THROW( kwiver::vital::algorithm_configuration_exception,
+                 type_name(), impl_name(),
+                 "invalid video_input algorithm for video source" );
+  }
+
+  d->d_video_source->open( name );
+
+  auto const num_frames = static_cast< frame_t >( d->d_video_source->num_frames() );
+  bool const can_segment = d->d_video_source->seekable() && num_frames > 0;
+
+  d->d_started = false;
+  d->d_at_eov = false;
+  d->d_first_frame = 1;
+  d->d_last_frame = std::numeric_limits< frame_t >::max();
+
+  if ( d->c_segment_count )
+  {
+    if ( ! can_segment )
+    {
+      VITAL_THROW( kwiver::vital::video_config_exception,
+                   "Video must be seekable and report its length to be read in segments" );
+    }
+
+    // Segment boundaries fall at the nearest frames to equal fractions
+    auto const k = static_cast< frame_t >( d->c_segment_count );
+    auto const i = static_cast< frame_t >( d->c_segment_index );
+    d->d_first_frame = ( num_frames * i ) / k + 1;
+    d->d_last_frame = ( num_frames * ( i + 1 ) ) / k;
+    d->d_at_eov = ( d->d_first_frame > d->d_last_frame );
+    return;
+  }
+
+  if ( ! can_segment || d->c_num_workers < 2 )
+  {
+    if ( ! can_segment )
+    {
+      LOG_WARN( logger(), "Video is not seekable or does not report its "
+                          "length; it will be decoded sequentially" );
+    }
+    return;
+  }
+
+  // Open all the worker sources before any work is started
+  d->d_last_frame = num_frames;
+  auto const num_chunks = static_cast< size_t >(
+    ( num_frames + d->c_chunk_frames - 1 ) / d->c_chunk_frames );
+  auto const num_workers = std::min< size_t >( d->c_num_workers, num_chunks );
+  for ( size_t i = 0; i < num_workers; ++i )
+  {
+    std::unique_ptr< segment_worker > worker( new segment_worker );
+    worker->source = d->create_source();
+    worker->source->open( name );
+    worker->finished = true;
+    d->d_workers.push_back( std::move( worker ) );
+  }
+
+  d->d_parallel = true;
+  d->start_workers( 1 );
+}
+
+// ----------------------------------------------------------------------------
+void
+video_input_segmented
+::close()
+{
+  if ( d->d_parallel )
+  {
+    d->stop_workers();
+    for ( auto& worker : d->d_workers )
+    {
+      worker->source->close();
+    }
+    d->d_workers.clear();
+    d->d_parallel = false;
+  }
+
+  if ( d->d_video_source )
+  {
+    d->d_video_source->close();
+  }
+
+  d->d_started = false;
+  d->d_at_eov = true;
+}
+
+// ----------------------------------------------------------------------------
+bool
+video_input_segmented
+::end_of_video() const
+{
+  if ( d->d_parallel )
+  {
+    return d->d_at_eov;
+  }
+
+  return d->d_at_eov || ! d->d_video_source || d->d_video_source->end_of_video();
+}
+
+// ----------------------------------------------------------------------------
+bool
+video_input_segmented
+::good() const
+{
+  if ( d->d_parallel )
+  {
+    return d->d_current.has_value();
+  }
+
+  return d->d_started && ! d->d_at_eov && d->d_video_source->good();
+}
+
+// ----------------------------------------------------------------------------
+bool
+video_input_segmented
+::seekable() const
+{
+  return d->d_video_source && d->d_video_source->seekable();
+}
+
+// ----------------------------------------------------------------------------
+size_t
+video_input_segmented
+::num_frames() const
+{
+  if ( ! d->d_video_source )
+  {
+    return 0;
+  }
+
+  if ( d->c_segment_count )
+  {
+    return static_cast< size_t >(
+      std::max< frame_t >( d->d_last_frame - d->d_first_frame + 1, 0 ) );
+  }
+
+  return d->d_video_source->num_frames();
+}
+
+// ----------------------------------------------------------------------------
+bool
+video_input_segmented
+::next_frame( kwiver::vital::timestamp& ts,   // returns timestamp
+              VITAL_UNUSED uint32_t     timeout )
+{
+  if ( d->d_at_eov )
+  {
+    return false;
+  }
+
+  if ( d->d_parallel )
+  {
+    return d->next_parallel( ts );
+  }
+
+  bool status;
+  if ( ! d->d_started && d->d_first_frame > 1 )
+  {
+    status = d->d_video_source->seek_frame( ts, d->d_first_frame );
+  }
+  else
+  {
+    status = d->d_video_source->next_frame( ts );
+  }
+  d->d_started = true;
+
+  if ( ! status || ts.get_frame() > d->d_last_frame )
+  {
+    d->d_at_eov = true;
+    return false;
+  }
+
+  return true;
+} // video_input_segmented::next_frame
+
+// ----------------------------------------------------------------------------
+bool
+video_input_segmented
+::seek_frame( kwiver::vital::timestamp& ts,   // returns timestamp
+              kwiver::vital::timestamp::frame_t frame_number,
+              VITAL_UNUSED uint32_t             timeout )
+{
+  if ( ! d->d_video_source ||
+       frame_number < d->d_first_frame || frame_number > d->d_last_frame )
+  {
+    return false;
+  }
+
+  if ( d->d_parallel )
+  {
+    d->stop_workers();
+    d->start_workers( frame_number );
+    return d->next_parallel( ts );
+  }
+
+  d->d_started = true;
+  d->d_at_eov = false;
+  return d->d_video_source->seek_frame( ts, frame_number );
+} // video_input_segmented::seek_frame
+
+// ----------------------------------------------------------------------------
+kwiver::vital::timestamp
+video_input_segmented
+::frame_timestamp() const
+{
+  if ( d->d_parallel )
+  {
+    return d->d_current ? d->d_current->timestamp : kwiver::vital::timestamp{};
+  }
+
+  if ( ! this->good() )
+  {
+    return {};
+  }
+
+  return d->d_video_source->frame_timestamp();
+}
+
+// ----------------------------------------------------------------------------
+kwiver::vital::image_container_sptr
+video_input_segmented
+::frame_image()
+{
+  if ( d->d_parallel )
+  {
+    return d->d_current ? d->d_current->image : nullptr;
+  }
+
+  if ( ! this->good() )
+  {
+    return nullptr;
+  }
+
+  return d->d_video_source->frame_image();
+}
+
+// ----------------------------------------------------------------------------
+kwiver::vital::metadata_vector
+video_input_segmented
+::frame_metadata()
+{
+  if ( d->d_parallel )
+  {
+    return d->d_current ? d->d_current->metadata : kwiver::vital::metadata_vector{};
+  }
+
+  if ( ! this->good() )
+  {
+    return {};
+  }
+
+  return d->d_video_source->frame_metadata();
+}
+
+// ----------------------------------------------------------------------------
+kwiver::vital::metadata_map_sptr
+video_input_segmented
+::metadata_map()
+{
+  if ( ! d->d_video_source )
+  {
+    return nullptr;
+  }
+
+  // The workers never touch the primary source, so it is free to scan
+  return d->d_video_source->metadata_map();
+}
+
+// ----------------------------------------------------------------------------
+kwiver::vital::video_settings_uptr
+video_input_segmented
+::implementation_settings() const
+{
+  if ( ! d->d_video_source )
+  {
+    return nullptr;
+  }
+
+  return d->d_video_source->implementation_settings();
+}
+
+} } }     // end namespace
@@ -0,0 +1,79 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef ARROWS_CORE_VIDEO_INPUT_SEGMENTED_H
+#define ARROWS_CORE_VIDEO_INPUT_SEGMENTED_H
+
+#include <vital/algo/video_input.h>
+
+#include <arrows/core/kwiver_algo_core_export.h>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+// ----------------------------------------------------------------------------
+/// Video input that decodes segments of a single video concurrently.
+///
+/// This class opens the same video several times with a nested seekable
+/// video input. By default, the frames are divided into consecutive chunks
+/// which are dealt out round-robin to worker threads, each decoding into its
+/// own buffer, and are returned as a single stream in the original order.
+///
+/// Alternatively, when \c segment_count is set, only one of that many
+/// contiguous segments of the video is read, without any threads. Several
+/// pipelines, each configured with a different \c segment_index, can then
+/// process the whole video in parallel. Frame numbers are those of the
+/// complete video in both modes.
+class KWIVER_ALGO_CORE_EXPORT video_input_segmented
+  : public vital::algo::video_input
+{
+public:
+  PLUGIN_INFO( "segmented",
+               "Decodes segments of a single video concurrently." );
+
+  /// Constructor
+  video_input_segmented();
+  virtual ~video_input_segmented();
+
+  /// Get this algorithm's \link vital::config_block configuration block \endlink
+  virtual vital::config_block_sptr get_configuration() const;
+
+  /// Set this algorithm's properties via a config block
+  virtual void set_configuration(vital::config_block_sptr config);
+
+  /// Check that the algorithm's currently configuration is valid
+  virtual bool check_configuration(vital::config_block_sptr config) const;
+
+  virtual void open( std::string name );
+  virtual void close();
+
+  virtual bool end_of_video() const;
+  virtual bool good() const;
+  virtual bool seekable() const;
+  virtual size_t num_frames() const;
+
+  virtual bool next_frame( kwiver::vital::timestamp& ts,
+                           uint32_t timeout = 0 );
+
+  virtual bool seek_frame( kwiver::vital::timestamp& ts,
+                           kwiver::vital::timestamp::frame_t frame_number,
+                           uint32_t timeout = 0 );
+
+  virtual kwiver::vital::timestamp frame_timestamp() const;
+  virtual kwiver::vital::image_container_sptr frame_image();
+  virtual kwiver::vital::metadata_vector frame_metadata();
+  virtual kwiver::vital::metadata_map_sptr metadata_map();
+
+  kwiver::vital::video_settings_uptr implementation_settings() const override;
+
+private:
+  /// private implementation class
+  class priv;
+  const std::unique_ptr<priv> d;
+};
+
+} } } // end namespace
+
+#endif // ARROWS_CORE_VIDEO_INPUT_SEGMENTED_H
@@ -7,6 +7,7 @@
 
 #include "write_object_track_set_kw18.h"
 
+#include <vital/util/format_buffer.h>
 #include <vital/vital_config.h>
 
 #include <time.h>
@@ -66,6 +67,9 @@ write_object_track_set_kw18
 void write_object_track_set_kw18
 ::close()
 {
+  // Lines are formatted into a buffer written to the stream in blocks
+  vital::format_buffer out( stream() );
+
   for( auto trk_pair : d->m_tracks )
   {
     auto trk_ptr = trk_pair.second;
@@ -85,7 +89,7 @@ ::close()
       const vital::bounding_box_d empty_box = vital::bounding_box_d( -1, -1, -1, -1 );
       vital::bounding_box_d bbox = ( det ? det->bounding_box() : empty_box );
 
-      stream() << trk_ptr->id() << " "     // 1: track id
+      out      << trk_ptr->id() << " "     // 1: track id
                << trk_ptr->size() << " "   // 2: track length
                << ts->frame() << " "       // 3: frame number
                << "0 "                     // 4: tracking plane x
@@ -103,11 +107,14 @@ ::close()
                << "0 "                     // 16: world-loc y
                << "0 "                     // 17: world-loc z
                << ts->time() << " "        // 18: timestamp
-               << det->confidence()        // 19: confidence
-               << std::endl;
+               << ( det ? det->confidence() : -1.0 ) // 19: confidence
+               << '\n';
     }
   }
 
+  out.flush();
+  stream().flush();
+
   write_object_track_set::close();
 }
 
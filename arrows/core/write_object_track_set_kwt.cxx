@@ -0,0 +1,110 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of write_object_track_set_kwt
+
+#include "write_object_track_set_kwt.h"
+
+#include <vital/exceptions.h>
+#include <vital/io/track_set_io.h>
+#include <vital/vital_config.h>
+
+#include <fstream>
+#include <map>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+// ----------------------------------------------------------------------------
+class write_object_track_set_kwt::priv
+{
+public:
+  // Latest version of each track written
+  std::map< vital::track_id_t, vital::track_sptr > m_tracks;
+
+  // Binary file opened by name
+  std::unique_ptr< std::ofstream > m_file;
+};
+
+// ----------------------------------------------------------------------------
+write_object_track_set_kwt
+::write_object_track_set_kwt()
+  : d( new write_object_track_set_kwt::priv )
+{
+}
+
+write_object_track_set_kwt
+::~write_object_track_set_kwt()
+{
+}
+
+// ----------------------------------------------------------------------------
+void
+write_object_track_set_kwt
+::set_configuration( VITAL_UNUSED vital::config_block_sptr config )
+{
+}
+
+// ----------------------------------------------------------------------------
+bool
+write_object_track_set_kwt
+::check_configuration( VITAL_UNUSED vital::config_block_sptr config ) const
+{
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+write_object_track_set_kwt
+::open( std::string const& filename )
+{
+  std::unique_ptr< std::ofstream > file(
+    new std::ofstream( filename, std::ios::binary ) );
+
+  if( !*file )
+  {
+    VITAL_THROW( vital::file_not_found_exception, filename, "open failed" );
+  }
+
+  use_stream( file.get() );
+  d->m_file = std::move( file );
+}
+
+// ----------------------------------------------------------------------------
+void
+write_object_track_set_kwt
+::write_set(
+  kwiver::vital::object_track_set_sptr const& set,
+  kwiver::vital::timestamp const& /*ts*/,
+  std::string const& /*frame_identifier*/ )
+{
+  for( auto const& trk : set->tracks() )
+  {
+    d->m_tracks[ trk->id() ] = trk;
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+write_object_track_set_kwt
+::close()
+{
+  std::vector< vital::track_sptr > tracks;
+  tracks.reserve( d->m_tracks.size() );
+  for( auto const& trk_pair : d->m_tracks )
+  {
+    tracks.push_back( trk_pair.second );
+  }
+  d->m_tracks.clear();
+
+  vital::write_kwt( stream(), vital::object_track_set{ tracks } );
+  stream().flush();
+
+  write_object_track_set::close();
+  d->m_file.reset();
+}
+
+} } } // end namespace
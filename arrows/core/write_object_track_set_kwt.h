@@ -0,0 +1,56 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Interface for write_object_track_set_kwt
+
+#ifndef KWIVER_ARROWS_WRITE_OBJECT_TRACK_SET_KWT_H
+#define KWIVER_ARROWS_WRITE_OBJECT_TRACK_SET_KWT_H
+
+#include <vital/vital_config.h>
+#include <arrows/core/kwiver_algo_core_export.h>
+
+#include <vital/algo/write_object_track_set.h>
+
+#include <memory>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+/// Writer of object tracks in the compact binary KWT format
+///
+/// Tracks are collected as they are written and the file is written on
+/// close. See vital::write_kwt for the format.
+class KWIVER_ALGO_CORE_EXPORT write_object_track_set_kwt
+  : public vital::algo::write_object_track_set
+{
+public:
+  PLUGIN_INFO( "kwt",
+               "Object track set compact binary writer." )
+
+  write_object_track_set_kwt();
+  ~write_object_track_set_kwt();
+
+  void set_configuration( vital::config_block_sptr config ) override;
+  bool check_configuration( vital::config_block_sptr config ) const override;
+
+  /// Open a file for writing, in binary mode
+  void open( std::string const& filename ) override;
+
+  void write_set(
+    kwiver::vital::object_track_set_sptr const& set,
+    kwiver::vital::timestamp const& ts = {},
+    std::string const& frame_identifier = {} ) override;
+
+  void close() override;
+
+private:
+  class priv;
+  std::unique_ptr< priv > d;
+};
+
+} } } // end namespace
+
+#endif // KWIVER_ARROWS_WRITE_OBJECT_TRACK_SET_KWT_H
@@ -0,0 +1,315 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of the binary track descriptor set writer
+
+#include "write_track_descriptor_set_binary.h"
+
+#include <vital/exceptions/io.h>
+#include <vital/types/compressed_descriptor.h>
+#include <vital/vital_config.h>
+
+#include <fstream>
+
+#include <cstdint>
+#include <cstring>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+namespace {
+
+// Encodings of the raw descriptor, shared with the reader
+enum : uint8_t
+{
+  ENCODING_DOUBLE = 0,
+  ENCODING_FLOAT = 1,
+  ENCODING_FLOAT16 = 2,
+  ENCODING_INT8 = 3,
+};
+
+// ----------------------------------------------------------------------------
+template < typename T >
+void
+append( std::string& buffer, T value )
+{
+  buffer.append( reinterpret_cast< char const* >( &value ), sizeof( value ) );
+}
+
+// ----------------------------------------------------------------------------
+void
+append_string( std::string& buffer, std::string const& value )
+{
+  append< uint32_t >( buffer, static_cast< uint32_t >( value.size() ) );
+  buffer.append( value );
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+class write_track_descriptor_set_binary::priv
+{
+public:
+  priv()
+    : m_encoding( "float" )
+    , m_started( false )
+    , m_offset( 0 )
+  {}
+
+  struct index_entry
+  {
+    uint64_t offset;
+    int64_t frame;
+    std::string uid;
+  };
+
+  void write( std::ostream& stream, std::string const& bytes );
+  void start( std::ostream& stream );
+  void encode( vital::track_descriptor const& desc );
+
+  std::string m_encoding;
+
+  std::unique_ptr< std::ofstream > m_file;
+  bool m_started;
+  uint64_t m_offset;
+  std::vector< index_entry > m_index;
+  std::string m_record;
+};
+
+// ----------------------------------------------------------------------------
+void
+write_track_descriptor_set_binary::priv
+::write( std::ostream& stream, std::string const& bytes )
+{
+  stream.write( bytes.data(), bytes.size() );
+  m_offset += bytes.size();
+}
+
+// ----------------------------------------------------------------------------
+void
+write_track_descriptor_set_binary::priv
+::start( std::ostream& stream )
+{
+  if( !m_started )
+  {
+    m_offset = 0;
+    m_index.clear();
+    write( stream, "KWTDSB01" );
+    m_started = true;
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+write_track_descriptor_set_binary::priv
+::encode( vital::track_descriptor const& desc )
+{
+  m_record.clear();
+
+  append_string( m_record, desc.get_uid().value() );
+  append_string( m_record, desc.get_type() );
+
+  auto const& track_ids = desc.get_track_ids();
+  append< uint32_t >( m_record, static_cast< uint32_t >( track_ids.size() ) );
+  for( auto const id : track_ids )
+  {
+    append< uint64_t >( m_record, id );
+  }
+
+  auto const& raw = desc.get_descriptor();
+  size_t const size = raw ? raw->size() : 0;
+  double const* const values = raw ? raw->raw_data() : nullptr;
+  if( m_encoding == "double" )
+  {
+    append< uint8_t >( m_record, ENCODING_DOUBLE );
+    append< uint32_t >( m_record, static_cast< uint32_t >( size ) );
+    m_record.append( reinterpret_cast< char const* >( values ),
+                     size * sizeof( double ) );
+  }
+  else if( m_encoding == "float" )
+  {
+    append< uint8_t >( m_record, ENCODING_FLOAT );
+    append< uint32_t >( m_record, static_cast< uint32_t >( size ) );
+    for( size_t i = 0; i < size; ++i )
+    {
+      append< float >( m_record, static_cast< float >( values[ i ] ) );
+    }
+  }
+  else
+  {
+    std::unique_ptr< vital::compressed_descriptor > encoded;
+    if( m_encoding == "float16" )
+    {
+      append< uint8_t >( m_record, ENCODING_FLOAT16 );
+      encoded.reset( new vital::descriptor_float16( values, size ) );
+    }
+    else
+    {
+      append< uint8_t >( m_record, ENCODING_INT8 );
+      encoded.reset( new vital::descriptor_int8( values, size ) );
+    }
+    append< uint32_t >( m_record, static_cast< uint32_t >( size ) );
+    m_record.append( reinterpret_cast< char const* >( encoded->as_bytes() ),
+                     encoded->num_bytes() );
+  }
+
+  auto const& history = desc.get_history();
+  append< uint32_t >( m_record, static_cast< uint32_t >( history.size() ) );
+  for( auto const& h : history )
+  {
+    append< int64_t >( m_record, h.get_timestamp().get_frame() );
+    append< int64_t >( m_record, h.get_timestamp().get_time_usec() );
+    for( auto const* box : { &h.get_image_location(), &h.get_world_location() } )
+    {
+      append< double >( m_record, box->min_x() );
+      append< double >( m_record, box->min_y() );
+      append< double >( m_record, box->max_x() );
+      append< double >( m_record, box->max_y() );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+write_track_descriptor_set_binary
+::write_track_descriptor_set_binary()
+  : d( new write_track_descriptor_set_binary::priv )
+{
+}
+
+write_track_descriptor_set_binary
+::~write_track_descriptor_set_binary()
+{
+  // Finish a file opened by this writer; streams given to use_stream may
+  // no longer exist
+  if( d->m_file )
+  {
+    this->close();
+  }
+}
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+write_track_descriptor_set_binary
+::get_configuration() const
+{
+  auto config = vital::algorithm::get_configuration();
+
+  config->set_value( "descriptor_encoding", d->m_encoding,
+                     "Encoding of the raw descriptors: double, float, "
+                     "float16 (half precision) or int8 (codes with a per "
+                     "descriptor offset and scale)." );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+write_track_descriptor_set_binary
+::set_configuration( vital::config_block_sptr config_in )
+{
+  auto config = this->get_configuration();
+  config->merge_config( config_in );
+
+  d->m_encoding = config->get_value< std::string >( "descriptor_encoding" );
+}
+
+// ----------------------------------------------------------------------------
+bool
+write_track_descriptor_set_binary
+::check_configuration( vital::config_block_sptr config ) const
+{
+  auto const encoding =
+    config->get_value< std::string >( "descriptor_encoding", d->m_encoding );
+  if( encoding != "double" && encoding != "float" &&
+      encoding != "float16" && encoding != "int8" )
+  {
+    LOG_ERROR( logger(), "Unknown descriptor_encoding \"" << encoding << "\"" );
+    return false;
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+write_track_descriptor_set_binary
+::open( std::string const& filename )
+{
+  this->close();
+
+  std::unique_ptr< std::ofstream > file(
+    new std::ofstream( filename, std::ios::out | std::ios::binary ) );
+  if( !*file )
+  {
+    VITAL_THROW( vital::file_not_found_exception, filename, "open failed" );
+  }
+
+  this->use_stream( file.get() );
+  d->m_file = std::move( file );
+  d->start( stream() );
+}
+
+// ----------------------------------------------------------------------------
+void
+write_track_descriptor_set_binary
+::close()
+{
+  if( d->m_started )
+  {
+    std::string index = "KWTDIX01";
+    append< uint64_t >( index, d->m_index.size() );
+    for( auto const& entry : d->m_index )
+    {
+      append< uint64_t >( index, entry.offset );
+      append< int64_t >( index, entry.frame );
+      append_string( index, entry.uid );
+    }
+    append< uint64_t >( index, d->m_offset );
+    index.append( "KWTDEND1" );
+
+    d->write( stream(), index );
+    stream().flush();
+    d->m_started = false;
+  }
+
+  vital::algo::write_track_descriptor_set::close();
+  d->m_file.reset();
+}
+
+// ----------------------------------------------------------------------------
+void
+write_track_descriptor_set_binary
+::write_set( const kwiver::vital::track_descriptor_set_sptr set )
+{
+  if( !set )
+  {
+    return;
+  }
+
+  d->start( stream() );
+
+  for( auto const& desc : *set )
+  {
+    if( !desc )
+    {
+      continue;
+    }
+
+    d->encode( *desc );
+
+    auto const& history = desc->get_history();
+    d->m_index.push_back(
+      { d->m_offset,
+        history.empty() ? -1 : history.back().get_timestamp().get_frame(),
+        desc->get_uid().value() } );
+
+    std::string length;
+    append< uint32_t >( length, static_cast< uint32_t >( d->m_record.size() ) );
+    d->write( stream(), length );
+    d->write( stream(), d->m_record );
+  }
+}
+
+} } } // end namespace
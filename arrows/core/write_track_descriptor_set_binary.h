@@ -0,0 +1,64 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Interface for write_track_descriptor_set_binary
+
+#ifndef KWIVER_ARROWS_WRITE_TRACK_DESCRIPTOR_SET_BINARY_H
+#define KWIVER_ARROWS_WRITE_TRACK_DESCRIPTOR_SET_BINARY_H
+
+#include <arrows/core/kwiver_algo_core_export.h>
+
+#include <vital/algo/write_track_descriptor_set.h>
+
+#include <memory>
+
+namespace kwiver {
+namespace arrows {
+namespace core {
+
+/// Track descriptor set writer for an indexed binary format
+///
+/// The file starts with the magic "KWTDSB01", followed by one record per
+/// track descriptor. A record is its length as a uint32, then the uid and
+/// type, the track ids, the raw descriptor in the configured encoding, and
+/// the history with image and world boxes. When the writer is closed, an
+/// index of the offset, last history frame and uid of every record is
+/// appended, followed by the offset of the index and the magic "KWTDEND1",
+/// so that readers can find any descriptor without parsing the others.
+/// Integers and floats are stored in native byte order.
+///
+/// The raw descriptors are stored as doubles, floats, half precision floats
+/// or int8 codes with a per descriptor offset and scale, trading precision
+/// for up to an eighth of the size.
+class KWIVER_ALGO_CORE_EXPORT write_track_descriptor_set_binary
+  : public vital::algo::write_track_descriptor_set
+{
+public:
+  PLUGIN_INFO( "binary",
+               "Track descriptor set writer for an indexed binary format." )
+
+  write_track_descriptor_set_binary();
+  virtual ~write_track_descriptor_set_binary();
+
+  virtual vital::config_block_sptr get_configuration() const;
+  virtual void set_configuration( vital::config_block_sptr config );
+  virtual bool check_configuration( vital::config_block_sptr config ) const;
+
+  /// Open a file for writing in binary mode
+  virtual void open( std::string const& filename );
+
+  /// Append the index and close the file
+  virtual void close();
+
+  virtual void write_set( const kwiver::vital::track_descriptor_set_sptr set );
+
+private:
+  class priv;
+  std::unique_ptr< priv > d;
+};
+
+} } } // end namespace
+
+#endif // KWIVER_ARROWS_WRITE_TRACK_DESCRIPTOR_SET_BINARY_H
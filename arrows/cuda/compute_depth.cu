@@ -0,0 +1,401 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef COMPUTE_DEPTH_CU_
+#define COMPUTE_DEPTH_CU_
+
+// STD include
+#include <math.h>
+#include "cuda_error_check.h"
+
+//*****************************************************************************
+// Kernels for plane sweep depth estimation with TV-L1 refinement
+//
+// These follow the super3d implementation in single precision.  The cost
+// volume is stored slice after slice with the first image index varying
+// fastest, so that adjacent threads read adjacent costs.
+//*****************************************************************************
+
+namespace {
+
+// Number of threads along each dimension of a 2D block
+constexpr int block_dim = 16;
+
+//*****************************************************************************
+
+// Bilinear interpolation of an image at (x, y), which must lie within the
+// image bounds
+__device__ float bilinearSample(float const* img, int ni, int nj,
+                                float x, float y)
+{
+  int x0 = static_cast<int>(floorf(x));
+  int y0 = static_cast<int>(floorf(y));
+  int x1 = min(x0 + 1, ni - 1);
+  int y1 = min(y0 + 1, nj - 1);
+  float fx = x - x0;
+  float fy = y - y0;
+  float top = img[y0 * ni + x0] + fx * (img[y0 * ni + x1] - img[y0 * ni + x0]);
+  float bot = img[y1 * ni + x0] + fx * (img[y1 * ni + x1] - img[y1 * ni + x0]);
+  return top + fy * (bot - top);
+}
+
+//*****************************************************************************
+
+// Bilinear interpolation of a mask at (x, y), true if any neighbor with
+// non-zero weight is set
+__device__ bool bilinearMask(unsigned char const* mask, int ni, int nj,
+                             float x, float y)
+{
+  int x0 = static_cast<int>(floorf(x));
+  int y0 = static_cast<int>(floorf(y));
+  int x1 = min(x0 + 1, ni - 1);
+  int y1 = min(y0 + 1, nj - 1);
+  float fx = x - x0;
+  float fy = y - y0;
+  return (mask[y0 * ni + x0] && fx < 1.0f && fy < 1.0f) ||
+         (mask[y0 * ni + x1] && fx > 0.0f && fy < 1.0f) ||
+         (mask[y1 * ni + x0] && fx < 1.0f && fy > 0.0f) ||
+         (mask[y1 * ni + x1] && fx > 0.0f && fy > 0.0f);
+}
+
+//*****************************************************************************
+
+// Compute one slice of the cost volume
+//
+// Each support frame is warped to the reference view by the homography of
+// the slice plane, stored as a row-major 3x3 matrix per frame, and the mean
+// absolute difference to the reference image over the frames that see the
+// pixel is the cost.  Pixels seen by no frame have infinite cost.
+__global__ void costSliceKernel(float const* ref, unsigned char const* refMask,
+                                int ni, int nj,
+                                float const* const* frames,
+                                unsigned char const* const* masks,
+                                int const* frameDims,
+                                float const* homographies,
+                                int numFrames, int refFrame,
+                                float* slice)
+{
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  int j = blockIdx.y * blockDim.y + threadIdx.y;
+  if (i >= ni || j >= nj)
+  {
+    return;
+  }
+
+  int const id = j * ni + i;
+  bool const refMasked = refMask && refMask[id];
+  float const refValue = ref[id];
+  float sum = 0.0f;
+  int count = 0;
+  for (int f = 0; f < numFrames; ++f)
+  {
+    if (f == refFrame || refMasked)
+    {
+      continue;
+    }
+
+    float const* H = homographies + 9 * f;
+    float const w = H[6] * i + H[7] * j + H[8];
+    float const x = (H[0] * i + H[1] * j + H[2]) / w;
+    float const y = (H[3] * i + H[4] * j + H[5]) / w;
+    int const fni = frameDims[2 * f];
+    int const fnj = frameDims[2 * f + 1];
+    if (!(x >= 0.0f && y >= 0.0f && x <= fni - 1 && y <= fnj - 1))
+    {
+      continue;
+    }
+    if (masks && masks[f] && bilinearMask(masks[f], fni, fnj, x, y))
+    {
+      continue;
+    }
+
+    sum += fabsf(refValue - bilinearSample(frames[f], fni, fnj, x, y));
+    ++count;
+  }
+
+  if (refMasked)
+  {
+    slice[id] = 0.0f;
+  }
+  else
+  {
+    slice[id] = count > 0 ? sum / count : INFINITY;
+  }
+}
+
+//*****************************************************************************
+
+// Initialize the depth to the slice of minimum cost and compute the square
+// root of the range of costs at each pixel
+__global__ void initDepthKernel(float const* cost, int ni, int nj, int S,
+                                float* sqrtRange, float* d)
+{
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  int j = blockIdx.y * blockDim.y + threadIdx.y;
+  if (i >= ni || j >= nj)
+  {
+    return;
+  }
+
+  size_t const id = j * ni + i;
+  size_t const sliceSize = static_cast<size_t>(ni) * nj;
+  float minCost = INFINITY;
+  float maxCost = -INFINITY;
+  int minK = 0;
+  for (int k = 0; k < S; ++k)
+  {
+    float const c = cost[k * sliceSize + id];
+    if (c < minCost)
+    {
+      minCost = c;
+      minK = k;
+    }
+    if (c > maxCost)
+    {
+      maxCost = c;
+    }
+  }
+  sqrtRange[id] = sqrtf(maxCost - minCost);
+  d[id] = (minK + 0.5f) / S;
+}
+
+//*****************************************************************************
+
+// Search for the slice that minimizes the data term plus the coupling to the
+// current depth, within the range of slices that can improve on it
+__global__ void minSearchKernel(float* a, float const* d, float const* cost,
+                                float const* sqrtRange, int ni, int nj, int S,
+                                float theta, float lambda)
+{
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  int j = blockIdx.y * blockDim.y + threadIdx.y;
+  if (i >= ni || j >= nj)
+  {
+    return;
+  }
+
+  size_t const id = j * ni + i;
+  size_t const sliceSize = static_cast<size_t>(ni) * nj;
+  float const* col = cost + id;
+  float const sqrt_range = sqrtRange[id];
+  if (!isfinite(sqrt_range))
+  {
+    a[id] = d[id];
+    return;
+  }
+
+  int const lastPlane = S - 1;
+  float const coeff = 1.0f / (2.0f * theta * lambda * S * S);
+  float const rangeCoeff = sqrtf(2.0f * theta * lambda);
+  int const r = min(lastPlane,
+                    max(0, static_cast<int>(S * rangeCoeff * sqrt_range)));
+  float const dij = d[id] * S - 0.5f;
+  int const initK = min(lastPlane, max(0, static_cast<int>(dij)));
+  int const minK = max(0, initK - r);
+  int const maxK = min(lastPlane, initK + r);
+
+  int bestK = initK;
+  float const diff = dij - bestK;
+  float bestE = coeff * diff * diff + col[bestK * sliceSize];
+  for (int k = minK; k <= maxK; ++k)
+  {
+    float const c = col[k * sliceSize];
+    if (k == initK || c < 0.0f || c > bestE)
+    {
+      continue;
+    }
+    float const dd = dij - k;
+    float const e = coeff * dd * dd + c;
+    if (e < bestE)
+    {
+      bestE = e;
+      bestK = k;
+    }
+  }
+
+  // fit a parabola to estimate the subsample offset for the best k
+  float offset = 0.0f;
+  if (bestK > 0 && bestK < lastPlane)
+  {
+    float const c = col[bestK * sliceSize];
+    float const diff2 = 2.0f * coeff * (dij - bestK);
+    float const ym1 = col[(bestK - 1) * sliceSize] + diff2 + coeff;
+    float const yp1 = col[(bestK + 1) * sliceSize] - diff2 + coeff;
+    float const d1 = yp1 - ym1;
+    float const d2 = 2.0f * c - ym1 - yp1;
+    offset = d2 == 0.0f ? 0.0f : d1 / (2.0f * d2);
+  }
+  a[id] = (bestK + offset + 0.5f) / S;
+}
+
+//*****************************************************************************
+
+// Gradient ascent on the dual variable q, truncated to the unit ball
+__global__ void huberDualKernel(float* qx, float* qy, float const* d,
+                                float const* g, int ni, int nj,
+                                float step, float epsilon)
+{
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  int j = blockIdx.y * blockDim.y + threadIdx.y;
+  if (i >= ni - 1 || j >= nj - 1)
+  {
+    return;
+  }
+
+  int const id = j * ni + i;
+  float const stepsilon1 = 1.0f + step * epsilon;
+  float const dij = d[id];
+  float x = (qx[id] + step * g[id] * (d[id + 1] - dij)) / stepsilon1;
+  float y = (qy[id] + step * g[id] * (d[id + ni] - dij)) / stepsilon1;
+
+  // truncate vectors
+  float mag = x * x + y * y;
+  if (mag > 1.0f)
+  {
+    mag = sqrtf(mag);
+    x /= mag;
+    y /= mag;
+  }
+  qx[id] = x;
+  qy[id] = y;
+}
+
+//*****************************************************************************
+
+// Copy the dual variable into the last corner, as the CPU version does
+__global__ void huberCornerKernel(float* qx, float* qy, int ni, int nj)
+{
+  int const id = (nj - 1) * ni + ni - 1;
+  qx[id] = qx[id - 1];
+  qy[id] = qy[id - ni];
+}
+
+//*****************************************************************************
+
+// Semi-implicit descent on the depth using the divergence of q
+__global__ void huberPrimalKernel(float const* qx, float const* qy, float* d,
+                                  float const* a, float const* g,
+                                  int ni, int nj, float theta, float step)
+{
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  int j = blockIdx.y * blockDim.y + threadIdx.y;
+  if (i >= ni || j >= nj)
+  {
+    return;
+  }
+
+  int const id = j * ni + i;
+  float divx = qx[id];
+  float divy = qy[id];
+  if (i > 0) divx -= qx[id - 1];
+  if (j > 0) divy -= qy[id - ni];
+
+  float const denom = 1.0f + step / theta;
+  d[id] = (d[id] + step * (g[id] * (divx + divy) + a[id] / theta)) / denom;
+}
+
+//*****************************************************************************
+
+// Compute the standard deviation of the depth under the distribution given
+// by the costs
+__global__ void uncertaintyKernel(float const* cost, float const* d,
+                                  int ni, int nj, int S, float* uncertainty)
+{
+  int i = blockIdx.x * blockDim.x + threadIdx.x;
+  int j = blockIdx.y * blockDim.y + threadIdx.y;
+  if (i >= ni || j >= nj)
+  {
+    return;
+  }
+
+  // This scale is 1/(2*sigma) converted from [0,255] to [0,1]
+  float const costScale = 255.0f / (2.0f * 5.0f);
+  size_t const id = j * ni + i;
+  size_t const sliceSize = static_cast<size_t>(ni) * nj;
+  float const dij = d[id];
+  float sumW = 0.0f;
+  float var = 0.0f;
+  for (int k = 0; k < S; ++k)
+  {
+    float const diff = (k + 0.5f) / S - dij;
+    float const w = expf(-cost[k * sliceSize + id] * costScale);
+    sumW += w;
+    var += w * diff * diff;
+  }
+  uncertainty[id] = sqrtf(var / sumW);
+}
+
+//*****************************************************************************
+
+dim3 imageGrid(int ni, int nj)
+{
+  return dim3((ni - 1) / block_dim + 1, (nj - 1) / block_dim + 1, 1);
+}
+
+} // end anonymous namespace
+
+//*****************************************************************************
+
+void cuda_depth_cost_slice(float const* d_ref, unsigned char const* d_ref_mask,
+                           int ni, int nj,
+                           float const* const* d_frames,
+                           unsigned char const* const* d_masks,
+                           int const* d_frame_dims,
+                           float const* d_homographies,
+                           int num_frames, int ref_frame,
+                           float* d_slice)
+{
+  dim3 dimBlock(block_dim, block_dim, 1);
+  costSliceKernel << < imageGrid(ni, nj), dimBlock >> >(
+    d_ref, d_ref_mask, ni, nj, d_frames, d_masks, d_frame_dims,
+    d_homographies, num_frames, ref_frame, d_slice);
+  CudaErrorCheck(cudaPeekAtLastError());
+}
+
+//*****************************************************************************
+
+void cuda_depth_init(float const* d_cost, int ni, int nj, int S,
+                     float* d_sqrt_range, float* d_depth)
+{
+  dim3 dimBlock(block_dim, block_dim, 1);
+  initDepthKernel << < imageGrid(ni, nj), dimBlock >> >(
+    d_cost, ni, nj, S, d_sqrt_range, d_depth);
+  CudaErrorCheck(cudaPeekAtLastError());
+}
+
+//*****************************************************************************
+
+void cuda_depth_refine_step(float const* d_cost, float const* d_sqrt_range,
+                            float const* d_g, float* d_a, float* d_depth,
+                            float* d_qx, float* d_qy, int ni, int nj, int S,
+                            float theta, float lambda, float epsilon)
+{
+  dim3 dimBlock(block_dim, block_dim, 1);
+  dim3 dimGrid = imageGrid(ni, nj);
+  float const step = 0.25f / theta;
+  minSearchKernel << < dimGrid, dimBlock >> >(
+    d_a, d_depth, d_cost, d_sqrt_range, ni, nj, S, theta, lambda);
+  CudaErrorCheck(cudaPeekAtLastError());
+  huberDualKernel << < dimGrid, dimBlock >> >(
+    d_qx, d_qy, d_depth, d_g, ni, nj, step, epsilon);
+  CudaErrorCheck(cudaPeekAtLastError());
+  huberCornerKernel << < 1, 1 >> >(d_qx, d_qy, ni, nj);
+  CudaErrorCheck(cudaPeekAtLastError());
+  huberPrimalKernel << < dimGrid, dimBlock >> >(
+    d_qx, d_qy, d_depth, d_a, d_g, ni, nj, theta, step);
+  CudaErrorCheck(cudaPeekAtLastError());
+}
+
+//*****************************************************************************
+
+void cuda_depth_uncertainty(float const* d_cost, float const* d_depth,
+                            int ni, int nj, int S, float* d_uncertainty)
+{
+  dim3 dimBlock(block_dim, block_dim, 1);
+  uncertaintyKernel << < imageGrid(ni, nj), dimBlock >> >(
+    d_cost, d_depth, ni, nj, S, d_uncertainty);
+  CudaErrorCheck(cudaPeekAtLastError());
+}
+
+#endif
@@ -0,0 +1,688 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Source file for compute_depth on the GPU
+
+#include <arrows/cuda/compute_depth.h>
+#include <arrows/cuda/cuda_error_check.h>
+#include <arrows/cuda/cuda_memory.h>
+
+#include <vital/exceptions/image.h>
+#include <vital/types/image_container.h>
+#include <vital/types/matrix.h>
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include <cuda_runtime.h>
+
+using namespace kwiver::vital;
+
+void cuda_depth_cost_slice(float const* d_ref, unsigned char const* d_ref_mask,
+                           int ni, int nj,
+                           float const* const* d_frames,
+                           unsigned char const* const* d_masks,
+                           int const* d_frame_dims,
+                           float const* d_homographies,
+                           int num_frames, int ref_frame,
+                           float* d_slice);
+
+void cuda_depth_init(float const* d_cost, int ni, int nj, int S,
+                     float* d_sqrt_range, float* d_depth);
+
+void cuda_depth_refine_step(float const* d_cost, float const* d_sqrt_range,
+                            float const* d_g, float* d_a, float* d_depth,
+                            float* d_qx, float* d_qy, int ni, int nj, int S,
+                            float theta, float lambda, float epsilon);
+
+void cuda_depth_uncertainty(float const* d_cost, float const* d_depth,
+                            int ni, int nj, int S, float* d_uncertainty);
+
+namespace kwiver {
+namespace arrows {
+namespace cuda {
+
+namespace {
+
+//*****************************************************************************
+
+/// A pinhole camera as the matrices used by the plane sweep
+struct sweep_camera
+{
+  matrix_3x3d K;
+  matrix_3x3d R;
+  vector_3d center;
+};
+
+//*****************************************************************************
+
+/// The volume swept by planes of constant offset along a world normal
+///
+/// This matches the super3d world_angled_frustum.  Slice 0 is the plane at
+/// the minimum offset and slice 1 the plane at the maximum offset.
+class angled_frustum
+{
+public:
+  angled_frustum(sweep_camera const& ref, vector_3d const& normal,
+                 double min_offset, double max_offset)
+    : KR_inv_((ref.K * ref.R).inverse()),
+      center_(ref.center),
+      normal_(normal),
+      min_offset_(min_offset),
+      offset_range_(max_offset - min_offset)
+  {
+  }
+
+  /// World point on the plane of a slice seen at reference pixel (i, j)
+  vector_3d point_at_depth_on_axis(double i, double j, double slice) const
+  {
+    vector_3d const ray = KR_inv_ * vector_3d(i, j, 1.0);
+    double const offset = min_offset_ + offset_range_ * slice;
+    return center_ + ray * ((offset - normal_.dot(center_)) /
+                            normal_.dot(ray));
+  }
+
+  /// Homography from reference pixels to frame pixels through a slice plane
+  matrix_3x3d homography(sweep_camera const& cam, double slice) const
+  {
+    double const offset = min_offset_ + offset_range_ * slice;
+    matrix_3x3d const plane =
+      matrix_3x3d::Identity() +
+      (center_ - cam.center) * normal_.transpose() /
+      (offset - normal_.dot(center_));
+    return cam.K * cam.R * plane * KR_inv_;
+  }
+
+private:
+  matrix_3x3d KR_inv_;
+  vector_3d center_;
+  vector_3d normal_;
+  double min_offset_;
+  double offset_range_;
+};
+
+//*****************************************************************************
+
+sweep_camera
+to_sweep_camera(camera_perspective const& camera)
+{
+  return { camera.intrinsics()->as_matrix(),
+           camera.rotation().matrix(),
+           camera.center() };
+}
+
+//*****************************************************************************
+
+/// Convert a byte image to grey in [0, 1] using the weights of vil
+image_of<float>
+to_grey(image const& img)
+{
+  if (img.pixel_traits() != image_pixel_traits_of<uint8_t>())
+  {
+    VITAL_THROW(image_type_mismatch_exception,
+                "cuda compute_depth requires 8-bit frames");
+  }
+
+  image_of<float> grey(img.width(), img.height(), 1);
+  for (size_t j = 0; j < img.height(); ++j)
+  {
+    for (size_t i = 0; i < img.width(); ++i)
+    {
+      float value;
+      if (img.depth() >= 3)
+      {
+        value = 0.2125f * img.at<uint8_t>(i, j, 0) +
+                0.7154f * img.at<uint8_t>(i, j, 1) +
+                0.0721f * img.at<uint8_t>(i, j, 2);
+      }
+      else
+      {
+        value = img.at<uint8_t>(i, j, 0);
+      }
+      grey(i, j) = value / 255.0f;
+    }
+  }
+  return grey;
+}
+
+//*****************************************************************************
+
+/// Convert a mask image to one byte per pixel, or return false
+bool
+to_mask(image_container_sptr const& mask_in, image_of<uint8_t>& mask)
+{
+  if (!mask_in)
+  {
+    return false;
+  }
+  image const& img = mask_in->get_image();
+  bool const is_bool = img.pixel_traits() == image_pixel_traits_of<bool>();
+  if (!is_bool && img.pixel_traits() != image_pixel_traits_of<uint8_t>())
+  {
+    // unsupported pixel format
+    return false;
+  }
+
+  // take only the first channel
+  mask.set_size(img.width(), img.height(), 1);
+  for (size_t j = 0; j < img.height(); ++j)
+  {
+    for (size_t i = 0; i < img.width(); ++i)
+    {
+      mask(i, j) = is_bool ? img.at<bool>(i, j) : img.at<uint8_t>(i, j) >= 128;
+    }
+  }
+  return true;
+}
+
+//*****************************************************************************
+
+/// Copy the pixels of an image to the GPU in row-major order
+template <typename T>
+cuda_ptr<T>
+copy_to_gpu(image_of<T> const& img)
+{
+  size_t const size = img.width() * img.height();
+  std::vector<T> temp(size);
+  for (size_t j = 0; j < img.height(); ++j)
+  {
+    for (size_t i = 0; i < img.width(); ++i)
+    {
+      temp[j * img.width() + i] = img(i, j);
+    }
+  }
+
+  auto d_img = make_cuda_mem<T>(size);
+  CudaErrorCheck(cudaMemcpy(d_img.get(), temp.data(), size * sizeof(T),
+                            cudaMemcpyHostToDevice));
+  return d_img;
+}
+
+//*****************************************************************************
+
+/// Copy a row-major image from the GPU
+image_of<double>
+copy_from_gpu(float const* d_img, size_t ni, size_t nj)
+{
+  std::vector<float> temp(ni * nj);
+  CudaErrorCheck(cudaMemcpy(temp.data(), d_img, temp.size() * sizeof(float),
+                            cudaMemcpyDeviceToHost));
+  image_of<double> img(ni, nj, 1);
+  for (size_t j = 0; j < nj; ++j)
+  {
+    for (size_t i = 0; i < ni; ++i)
+    {
+      img(i, j) = temp[j * ni + i];
+    }
+  }
+  return img;
+}
+
+//*****************************************************************************
+
+/// Compute gradient weights from the 3x3 Sobel gradient, as super3d does
+image_of<float>
+compute_g(image_of<float> const& ref, image_of<uint8_t> const* mask,
+          double alpha)
+{
+  size_t const ni = ref.width();
+  size_t const nj = ref.height();
+  bool const invalid_mask = !mask || mask->width() != ni ||
+                            mask->height() != nj;
+
+  image_of<float> g(ni, nj, 1);
+  for (size_t j = 0; j < nj; ++j)
+  {
+    for (size_t i = 0; i < ni; ++i)
+    {
+      if (!invalid_mask && !(*mask)(i, j))
+      {
+        g(i, j) = 1.0f;
+        continue;
+      }
+
+      // the gradient is zero on the image border
+      double dx = 0.0, dy = 0.0;
+      if (i > 0 && j > 0 && i + 1 < ni && j + 1 < nj)
+      {
+        dx = (ref(i + 1, j - 1) + 2.0 * ref(i + 1, j) + ref(i + 1, j + 1) -
+              ref(i - 1, j - 1) - 2.0 * ref(i - 1, j) - ref(i - 1, j + 1)) / 8.0;
+        dy = (ref(i - 1, j + 1) + 2.0 * ref(i, j + 1) + ref(i + 1, j + 1) -
+              ref(i - 1, j - 1) - 2.0 * ref(i, j - 1) - ref(i + 1, j - 1)) / 8.0;
+      }
+      g(i, j) = static_cast<float>(std::exp(-alpha * std::sqrt(dx * dx + dy * dy)));
+    }
+  }
+  return g;
+}
+
+//*****************************************************************************
+
+/// Convert a normalized height map into a depth map and scale uncertainty
+image_of<double>
+height_map_to_depth_map(sweep_camera const& camera,
+                        image_of<double> const& height_map,
+                        double depth_min, double depth_max,
+                        image_of<double>* uncertainty)
+{
+  matrix_3x3d const M = camera.K * camera.R;
+  vector_3d const v = M.inverse().row(2).transpose();
+  double const o = v.dot(M * camera.center);
+  double const scale = depth_max - depth_min;
+
+  image_of<double> depth(height_map.width(), height_map.height(), 1);
+  for (size_t j = 0; j < height_map.height(); ++j)
+  {
+    for (size_t i = 0; i < height_map.width(); ++i)
+    {
+      double const h = height_map(i, j) * scale + depth_min;
+      double const s = 1.0 / v.dot(vector_3d(i, j, 1.0));
+      depth(i, j) = (h - o) * s;
+      if (uncertainty)
+      {
+        (*uncertainty)(i, j) *= scale * std::abs(s);
+      }
+    }
+  }
+  return depth;
+}
+
+} // end anonymous namespace
+
+//*****************************************************************************
+
+/// Private implementation class
+class compute_depth::priv
+{
+public:
+  /// Constructor
+  priv()
+    : theta0(1.0),
+      theta_end(0.001),
+      lambda(0.65),
+      gw_alpha(20),
+      epsilon(0.01),
+      iterations(2000),
+      world_plane_normal(0.0, 0.0, 1.0),
+      depth_sample_rate(0.5),
+      callback_interval(-1),    //default is no callback
+      uncertainty_in_callback(false),
+      m_logger(vital::get_logger("arrows.cuda.compute_depth"))
+  {
+  }
+
+  double theta0;
+  double theta_end;
+  double lambda;
+  double gw_alpha;
+  double epsilon;
+  unsigned int iterations;
+  vector_3d world_plane_normal;
+  double depth_sample_rate;
+  int callback_interval;
+  bool uncertainty_in_callback;
+
+  compute_depth::callback_t callback;
+
+  /// Logger handle
+  vital::logger_handle_t m_logger;
+};
+
+//*****************************************************************************
+
+/// Constructor
+compute_depth::compute_depth()
+  : d_(new priv)
+{
+}
+
+//*****************************************************************************
+
+/// Destructor
+compute_depth::~compute_depth()
+{
+}
+
+//*****************************************************************************
+
+/// Get this algorithm's \link vital::config_block configuration block \endlink
+vital::config_block_sptr
+compute_depth::get_configuration() const
+{
+  // get base config from base class
+  vital::config_block_sptr config = vital::algo::compute_depth::get_configuration();
+  config->set_value("iterations", d_->iterations,
+                    "Number of iterations to run optimizer");
+  config->set_value("theta0", d_->theta0,
+                    "Begin value of quadratic relaxation term");
+  config->set_value("theta_end", d_->theta_end,
+                    "End value of quadratic relaxation term");
+  config->set_value("lambda", d_->lambda,
+                    "Weight of the data term");
+  config->set_value("gw_alpha", d_->gw_alpha,
+                    "gradient weighting term");
+  config->set_value("epsilon", d_->epsilon,
+                    "Huber norm term, trade off between L1 and L2 norms");
+  config->set_value("world_plane_normal", "0 0 1",
+                    "up direction in world space");
+  config->set_value("callback_interval", d_->callback_interval,
+                    "number of iterations between updates (-1 turns off updates)");
+  config->set_value("uncertainty_in_callback", d_->uncertainty_in_callback,
+                    "If true, compute the uncertainty in each callback for a "
+                    "live preview at additional computational cost. "
+                    "Otherwise, uncertainty is only computed at the end.");
+  config->set_value("depth_sample_rate", d_->depth_sample_rate,
+                    "Specifies the maximum sampling rate, in pixels, of the "
+                    "depth steps projected into support views.  This rate "
+                    "determines the number of depth slices in the cost "
+                    "volume.  Smaller values create more depth slices.");
+
+  return config;
+}
+
+//*****************************************************************************
+
+/// Set this algorithm's properties via a config block
+void
+compute_depth::set_configuration(vital::config_block_sptr in_config)
+{
+  // Starting with our generated vital::config_block to ensure that
+  // assumed values are present. An alternative is to check for key
+  // presence before performing a get_value() call.
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config(in_config);
+
+  d_->iterations = config->get_value<unsigned int>("iterations", d_->iterations);
+  d_->theta0 = config->get_value<double>("theta0", d_->theta0);
+  d_->theta_end = config->get_value<double>("theta_end", d_->theta_end);
+  d_->lambda = config->get_value<double>("lambda", d_->lambda);
+  d_->gw_alpha = config->get_value<double>("gw_alpha", d_->gw_alpha);
+  d_->epsilon = config->get_value<double>("epsilon", d_->epsilon);
+  d_->callback_interval = config->get_value<int>("callback_interval",
+                                                 d_->callback_interval);
+  d_->uncertainty_in_callback =
+    config->get_value<bool>("uncertainty_in_callback",
+                            d_->uncertainty_in_callback);
+  d_->depth_sample_rate = config->get_value<double>("depth_sample_rate",
+                                                    d_->depth_sample_rate);
+
+  std::istringstream ss(config->get_value<std::string>("world_plane_normal",
+                                                       "0 0 1"));
+  ss >> d_->world_plane_normal[0] >> d_->world_plane_normal[1]
+     >> d_->world_plane_normal[2];
+  d_->world_plane_normal.normalize();
+}
+
+//*****************************************************************************
+
+/// Check that the algorithm's currently configuration is valid
+bool
+compute_depth::check_configuration( VITAL_UNUSED vital::config_block_sptr config ) const
+{
+  return true;
+}
+
+//*****************************************************************************
+
+//Compute the depth and return the uncertainty by reference
+image_container_sptr
+compute_depth
+::compute(std::vector<kwiver::vital::image_container_sptr> const& frames_in,
+          std::vector<kwiver::vital::camera_perspective_sptr> const& cameras_in,
+          double depth_min, double depth_max,
+          unsigned int ref_frame,
+          vital::bounding_box<int> const& roi,
+          kwiver::vital::image_container_sptr& depth_uncertainty,
+          std::vector<kwiver::vital::image_container_sptr> const& masks_in) const
+{
+  int const num_frames = static_cast<int>(frames_in.size());
+
+  // convert cameras, cropping the reference camera to the region of interest
+  std::vector<sweep_camera> cameras;
+  for (auto const& cam : cameras_in)
+  {
+    cameras.push_back(to_sweep_camera(*cam));
+  }
+  sweep_camera& ref_cam = cameras[ref_frame];
+  ref_cam.K(0, 2) -= roi.min_x();
+  ref_cam.K(1, 2) -= roi.min_y();
+  int const ni = roi.width();
+  int const nj = roi.height();
+
+  // convert frames and upload them to the GPU
+  std::vector<cuda_ptr<float> > d_frames;
+  std::vector<float*> h_frame_ptrs;
+  std::vector<int> h_frame_dims;
+  image_of<float> ref;
+  for (int f = 0; f < num_frames; ++f)
+  {
+    image_of<float> grey = to_grey(frames_in[f]->get_image());
+    if (f == static_cast<int>(ref_frame))
+    {
+      ref = image_of<float>(ni, nj, 1);
+      for (int j = 0; j < nj; ++j)
+      {
+        for (int i = 0; i < ni; ++i)
+        {
+          ref(i, j) = grey(i + roi.min_x(), j + roi.min_y());
+        }
+      }
+    }
+    h_frame_dims.push_back(static_cast<int>(grey.width()));
+    h_frame_dims.push_back(static_cast<int>(grey.height()));
+    d_frames.push_back(copy_to_gpu(grey));
+    h_frame_ptrs.push_back(d_frames.back().get());
+  }
+  auto d_ref = copy_to_gpu(ref);
+  auto d_frame_ptrs = make_cuda_mem<float*>(num_frames);
+  CudaErrorCheck(cudaMemcpy(d_frame_ptrs.get(), h_frame_ptrs.data(),
+                            num_frames * sizeof(float*),
+                            cudaMemcpyHostToDevice));
+  auto d_frame_dims = make_cuda_mem<int>(2 * num_frames);
+  CudaErrorCheck(cudaMemcpy(d_frame_dims.get(), h_frame_dims.data(),
+                            2 * num_frames * sizeof(int),
+                            cudaMemcpyHostToDevice));
+
+  // convert optional masks and upload them to the GPU
+  std::vector<cuda_ptr<unsigned char> > d_masks;
+  cuda_ptr<unsigned char*> d_mask_ptrs;
+  cuda_ptr<unsigned char> d_ref_mask;
+  image_of<uint8_t> ref_mask;
+  bool has_ref_mask = false;
+  if (!masks_in.empty())
+  {
+    std::vector<unsigned char*> h_mask_ptrs(num_frames, nullptr);
+    for (int f = 0; f < num_frames; ++f)
+    {
+      image_of<uint8_t> mask;
+      if (f >= static_cast<int>(masks_in.size()) || !to_mask(masks_in[f], mask))
+      {
+        continue;
+      }
+      if (f == static_cast<int>(ref_frame))
+      {
+        has_ref_mask = true;
+        ref_mask = image_of<uint8_t>(ni, nj, 1);
+        for (int j = 0; j < nj; ++j)
+        {
+          for (int i = 0; i < ni; ++i)
+          {
+            ref_mask(i, j) = mask(i + roi.min_x(), j + roi.min_y());
+          }
+        }
+        d_ref_mask = copy_to_gpu(ref_mask);
+      }
+      else
+      {
+        d_masks.push_back(copy_to_gpu(mask));
+        h_mask_ptrs[f] = d_masks.back().get();
+      }
+    }
+    d_mask_ptrs = make_cuda_mem<unsigned char*>(num_frames);
+    CudaErrorCheck(cudaMemcpy(d_mask_ptrs.get(), h_mask_ptrs.data(),
+                              num_frames * sizeof(unsigned char*),
+                              cudaMemcpyHostToDevice));
+  }
+
+  angled_frustum const ws(ref_cam, d_->world_plane_normal,
+                          depth_min, depth_max);
+
+  // compute the number of depth slices needed to properly sample the data
+  double max_dist = 0.0;
+  for (unsigned i = 0; i < 3; ++i)
+  {
+    for (unsigned j = 0; j < 3; ++j)
+    {
+      auto const near = ws.point_at_depth_on_axis((ni * i) / 2,
+                                                  (nj * j) / 2, 0.0);
+      auto const far = ws.point_at_depth_on_axis((ni * i) / 2,
+                                                 (nj * j) / 2, 1.0);
+      for (auto const& cam : cameras)
+      {
+        vector_3d const p1 = cam.K * cam.R * (near - cam.center);
+        vector_3d const p2 = cam.K * cam.R * (far - cam.center);
+        double const dist = (p2.hnormalized() - p1.hnormalized()).norm();
+        max_dist = std::max(max_dist, dist);
+      }
+    }
+  }
+  int const S = static_cast<int>(max_dist / d_->depth_sample_rate);
+  if (S <= 0)
+  {
+    LOG_WARN(d_->m_logger, "Depth range projects to no depth slices");
+    return nullptr;
+  }
+
+  LOG_DEBUG(d_->m_logger, "Computing cost volume of size ("
+                          << ni << ", " << nj << ", " << S << ")");
+  size_t const slice_size = static_cast<size_t>(ni) * nj;
+  auto d_cost = make_cuda_mem<float>(slice_size * S);
+  auto d_homographies = make_cuda_mem<float>(9 * num_frames);
+  std::vector<float> h_homographies(9 * num_frames);
+  for (int k = 0; k < S; ++k)
+  {
+    if (d_->callback)
+    {
+      unsigned percent_complete = (50 * k) / S;
+      std::stringstream ss;
+      ss << "Computing cost volume slice " << k << " of " << S;
+      if (!d_->callback(nullptr, ss.str(), percent_complete, nullptr))
+      {
+        // user terminated processing early through the callback
+        return nullptr;
+      }
+    }
+
+    double const s = (k + 0.5) / S;
+    for (int f = 0; f < num_frames; ++f)
+    {
+      Eigen::Matrix<float, 3, 3, Eigen::RowMajor> const H =
+        ws.homography(cameras[f], s).cast<float>();
+      std::copy(H.data(), H.data() + 9, h_homographies.begin() + 9 * f);
+    }
+    CudaErrorCheck(cudaMemcpy(d_homographies.get(), h_homographies.data(),
+                              h_homographies.size() * sizeof(float),
+                              cudaMemcpyHostToDevice));
+    cuda_depth_cost_slice(d_ref.get(), d_ref_mask.get(), ni, nj,
+                          d_frame_ptrs.get(), d_mask_ptrs.get(),
+                          d_frame_dims.get(), d_homographies.get(),
+                          num_frames, static_cast<int>(ref_frame),
+                          d_cost.get() + k * slice_size);
+  }
+
+  LOG_DEBUG(d_->m_logger, "Computing g weighting");
+  auto d_g = copy_to_gpu(compute_g(ref, has_ref_mask ? &ref_mask : nullptr,
+                                   d_->gw_alpha));
+
+  LOG_DEBUG(d_->m_logger, "Refining Depth");
+  auto d_sqrt_range = make_cuda_mem<float>(slice_size);
+  auto d_depth = make_cuda_mem<float>(slice_size);
+  auto d_a = make_cuda_mem<float>(slice_size);
+  auto d_qx = make_cuda_mem<float>(slice_size);
+  auto d_qy = make_cuda_mem<float>(slice_size);
+  auto d_uncertainty = make_cuda_mem<float>(slice_size);
+  CudaErrorCheck(cudaMemset(d_qx.get(), 0, slice_size * sizeof(float)));
+  CudaErrorCheck(cudaMemset(d_qy.get(), 0, slice_size * sizeof(float)));
+  cuda_depth_init(d_cost.get(), ni, nj, S, d_sqrt_range.get(), d_depth.get());
+
+  double theta = d_->theta0;
+  double const denom = std::log(10.0);
+  double const orders = std::log(d_->theta0) / denom -
+                        std::log(d_->theta_end) / denom;
+  double const beta = orders / static_cast<double>(d_->iterations);
+
+  for (unsigned int iter = 1; iter <= d_->iterations; iter++)
+  {
+    cuda_depth_refine_step(d_cost.get(), d_sqrt_range.get(), d_g.get(),
+                           d_a.get(), d_depth.get(), d_qx.get(), d_qy.get(),
+                           ni, nj, S, static_cast<float>(theta),
+                           static_cast<float>(d_->lambda),
+                           static_cast<float>(d_->epsilon));
+    theta = std::pow(10.0, std::log(theta) / denom - beta);
+
+    if (d_->callback)
+    {
+      image_container_sptr result = nullptr;
+      image_container_sptr result_u = nullptr;
+      if (d_->callback_interval > 0 && !(iter % d_->callback_interval))
+      {
+        auto height_map = copy_from_gpu(d_depth.get(), ni, nj);
+        image_of<double> uncertainty;
+        if (d_->uncertainty_in_callback)
+        {
+          cuda_depth_uncertainty(d_cost.get(), d_depth.get(), ni, nj, S,
+                                 d_uncertainty.get());
+          uncertainty = copy_from_gpu(d_uncertainty.get(), ni, nj);
+        }
+        auto depth = height_map_to_depth_map(
+          ref_cam, height_map, depth_min, depth_max,
+          d_->uncertainty_in_callback ? &uncertainty : nullptr);
+        result = std::make_shared<simple_image_container>(depth);
+        if (d_->uncertainty_in_callback)
+        {
+          result_u = std::make_shared<simple_image_container>(uncertainty);
+        }
+      }
+      unsigned percent_complete = 50 + (50 * iter) / d_->iterations;
+      std::stringstream ss;
+      ss << "Depth refinement iteration " << iter
+         << " of " << d_->iterations;
+      // if the callback returns false, that means
+      // the user has requested early termination
+      if (!d_->callback(result, ss.str(), percent_complete, result_u))
+      {
+        break;
+      }
+    }
+  }
+
+  cuda_depth_uncertainty(d_cost.get(), d_depth.get(), ni, nj, S,
+                         d_uncertainty.get());
+  CudaErrorCheck(cudaDeviceSynchronize());
+  auto height_map = copy_from_gpu(d_depth.get(), ni, nj);
+  auto uncertainty = copy_from_gpu(d_uncertainty.get(), ni, nj);
+
+  // map depth from normalized range back into true depth
+  auto depth = height_map_to_depth_map(ref_cam, height_map,
+                                       depth_min, depth_max, &uncertainty);
+
+  // Setting the value by reference
+  depth_uncertainty = std::make_shared<simple_image_container>(uncertainty);
+
+  return std::make_shared<simple_image_container>(depth);
+}
+
+//*****************************************************************************
+
+void compute_depth::set_callback(callback_t cb)
+{
+  kwiver::vital::algo::compute_depth::set_callback(cb);
+  d_->callback = cb;
+}
+
+} // end namespace cuda
+} // end namespace arrows
+} // end namespace kwiver
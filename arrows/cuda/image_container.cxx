@@ -0,0 +1,149 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of the image container in CUDA device memory
+
+#include <arrows/cuda/image_container.h>
+#include <arrows/cuda/cuda_error_check.h>
+#include <arrows/cuda/cuda_memory.h>
+
+#include <cuda_runtime.h>
+
+namespace kwiver {
+namespace arrows {
+namespace cuda {
+
+namespace {
+
+/// Allocate device memory shared by copies of a container
+std::shared_ptr< unsigned char >
+make_shared_cuda_mem( size_t num_bytes )
+{
+  if( num_bytes == 0 )
+  {
+    return nullptr;
+  }
+  return std::shared_ptr< unsigned char >(
+    make_cuda_mem< unsigned char >( num_bytes ).release(),
+    cuda_deleter< unsigned char >() );
+}
+
+/// Check if an image is stored with the layout of the device memory
+bool
+has_device_layout( vital::image const& img )
+{
+  auto const depth = static_cast< ptrdiff_t >( img.depth() );
+  return img.w_step() == depth &&
+         img.h_step() == depth * static_cast< ptrdiff_t >( img.width() ) &&
+         ( img.depth() == 1 || img.d_step() == 1 );
+}
+
+}
+
+// ----------------------------------------------------------------------------
+image_container
+::image_container( size_t width, size_t height, size_t depth,
+                   vital::image_pixel_traits const& pt )
+  : data_( make_shared_cuda_mem( width * height * depth * pt.num_bytes ) ),
+    width_( width ),
+    height_( height ),
+    depth_( depth ),
+    traits_( pt )
+{
+}
+
+// ----------------------------------------------------------------------------
+image_container
+::image_container( vital::image const& vital_image )
+  : image_container( vital_image.width(), vital_image.height(),
+                     vital_image.depth(), vital_image.pixel_traits() )
+{
+  if( !data_ )
+  {
+    return;
+  }
+
+  // images with other memory layouts are copied to the device layout first
+  vital::image host_image = vital_image;
+  if( !has_device_layout( host_image ) )
+  {
+    host_image = vital::image( width_, height_, depth_, true, traits_ );
+    host_image.copy_from( vital_image );
+  }
+  CudaErrorCheck( cudaMemcpy( data_.get(), host_image.first_pixel(), size(),
+                              cudaMemcpyHostToDevice ) );
+}
+
+// ----------------------------------------------------------------------------
+image_container
+::image_container( vital::image_container const& image_cont )
+  : image_container( image_cont.get_image() )
+{
+  set_metadata( image_cont.get_metadata() );
+}
+
+// ----------------------------------------------------------------------------
+image_container
+::image_container( cuda::image_container const& other )
+  : vital::image_container( other ),
+    data_( other.data_ ),
+    width_( other.width_ ),
+    height_( other.height_ ),
+    depth_( other.depth_ ),
+    traits_( other.traits_ )
+{
+}
+
+// ----------------------------------------------------------------------------
+size_t
+image_container
+::size() const
+{
+  return width_ * height_ * depth_ * traits_.num_bytes;
+}
+
+// ----------------------------------------------------------------------------
+vital::image
+image_container
+::get_image() const
+{
+  std::lock_guard< std::mutex > lock( host_mutex_ );
+  if( data_ && !host_image_.first_pixel() )
+  {
+    host_image_ = vital::image( width_, height_, depth_, true, traits_ );
+    CudaErrorCheck( cudaMemcpy( host_image_.first_pixel(), data_.get(),
+                                size(), cudaMemcpyDeviceToHost ) );
+  }
+  return host_image_;
+}
+
+// ----------------------------------------------------------------------------
+void*
+image_container
+::device_data()
+{
+  std::lock_guard< std::mutex > lock( host_mutex_ );
+  host_image_ = vital::image( traits_ );
+  return data_.get();
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< image_container >
+image_container_to_cuda( vital::image_container_sptr const& img )
+{
+  if( !img )
+  {
+    return nullptr;
+  }
+  if( auto cuda_img = std::dynamic_pointer_cast< image_container >( img ) )
+  {
+    return cuda_img;
+  }
+  return std::make_shared< image_container >( *img );
+}
+
+}  // end namespace cuda
+}  // end namespace arrows
+}  // end namespace kwiver
@@ -0,0 +1,104 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header file for an image container in CUDA device memory
+
+#ifndef KWIVER_ARROWS_CUDA_IMAGE_CONTAINER_H_
+#define KWIVER_ARROWS_CUDA_IMAGE_CONTAINER_H_
+
+#include <arrows/cuda/kwiver_algo_cuda_export.h>
+
+#include <vital/types/image_container.h>
+
+#include <memory>
+#include <mutex>
+
+namespace kwiver {
+namespace arrows {
+namespace cuda {
+
+/// This image container keeps its pixels in CUDA device memory
+///
+/// The pixels are stored contiguously with interleaved channels, so the
+/// value of channel \c k of pixel (\c i, \c j) is at index
+/// <tt>(j * width + i) * depth + k</tt>.  GPU algorithms can check for this
+/// container and use device_data() without a transfer.  The pixels are
+/// copied to host memory only when get_image() is called; the host copy is
+/// kept until the device data is next accessed for writing.
+///
+/// Copies of the container share the device memory.
+class KWIVER_ALGO_CUDA_EXPORT image_container
+  : public vital::image_container
+{
+public:
+
+  /// Constructor - allocate an uninitialized device image
+  image_container( size_t width, size_t height, size_t depth,
+                   vital::image_pixel_traits const& pt );
+
+  /// Constructor - upload a vital image to the device
+  explicit image_container( vital::image const& vital_image );
+
+  /// Constructor - upload the image of any image container to the device
+  explicit image_container( vital::image_container const& image_cont );
+
+  /// Copy Constructor
+  image_container( cuda::image_container const& other );
+
+  /// The size of the image data in bytes
+  size_t size() const override;
+
+  /// The width of the image in pixels
+  size_t width() const override { return width_; }
+
+  /// The height of the image in pixels
+  size_t height() const override { return height_; }
+
+  /// The depth (or number of channels) of the image
+  size_t depth() const override { return depth_; }
+
+  /// The type of each pixel value
+  vital::image_pixel_traits const& pixel_traits() const { return traits_; }
+
+  /// Get an in-memory image class to access the data
+  ///
+  /// The first call copies the pixels from the device.  Changes made to the
+  /// returned image are not copied back.
+  vital::image get_image() const override;
+  using vital::image_container::get_image;
+
+  /// Access the pixels in device memory for reading
+  void const* device_data() const { return data_.get(); }
+
+  /// Access the pixels in device memory for writing
+  ///
+  /// This discards the host copy of the pixels, if any.
+  void* device_data();
+
+protected:
+
+  std::shared_ptr< unsigned char > data_;
+  size_t width_;
+  size_t height_;
+  size_t depth_;
+  vital::image_pixel_traits traits_;
+
+  mutable std::mutex host_mutex_;
+  mutable vital::image host_image_;
+};
+
+/// Get a CUDA image container for any image container
+///
+/// If \a img is actually a cuda::image_container then return it.  Otherwise,
+/// upload the image data to the GPU.
+KWIVER_ALGO_CUDA_EXPORT
+std::shared_ptr< image_container >
+image_container_to_cuda( vital::image_container_sptr const& img );
+
+}  // end namespace cuda
+}  // end namespace arrows
+}  // end namespace kwiver
+
+#endif
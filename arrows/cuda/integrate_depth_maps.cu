@@ -136,21 +136,11 @@ __device__ int computeVoxelIDDepth(int coordinates[3])
 
 //*****************************************************************************
 
-// Main kernel for adding a depth map to the volume
-__global__ void depthMapKernel(double* depths, double* weights, double matrixK[size4x4], double matrixRT[size4x4],
-  double* output, int z_offset)
+// Compute the weighted ray potential of a depth map at a voxel, or zero if
+// the voxel does not project onto a valid depth
+__device__ double integrateVoxel(int voxelIndex[3], double* depths, double* weights,
+  double matrixK[size4x4], double matrixRT[size4x4])
 {
-  // Get voxel coordinate according to thread id
-  int voxelIndex[3] = { (int)(blockIdx.x * blockDim.x + threadIdx.x),
-                        (int)(blockIdx.y * blockDim.y + threadIdx.y),
-                        (int)blockIdx.z + z_offset };
-  if (voxelIndex[0] >= c_gridDims.x ||
-      voxelIndex[1] >= c_gridDims.y ||
-      voxelIndex[2] >= c_gridDims.z)
-  {
-    return;
-  }
-
   double voxelCenterCoordinate[3];
   computeVoxelCenter(voxelIndex, voxelCenterCoordinate);
 
@@ -162,7 +152,7 @@ __global__ void depthMapKernel(double* depths, double* weights, double matrixK[s
   double voxelCenterHomogen[3];
   transformFrom4Matrix(matrixK, voxelCenterCamera, voxelCenterHomogen);
   if (voxelCenterHomogen[2] < 0)
-    return;
+    return 0.0;
 
   // Get voxel center on depth map coord
   double voxelCenterDepthMap[2];
@@ -176,21 +166,72 @@ __global__ void depthMapKernel(double* depths, double* weights, double matrixK[s
 
   // Test if coordinate are inside depth map
   if (pixel[0] < 0 || pixel[1] < 0 || pixel[0] >= c_depthMapDims.x || pixel[1] >= c_depthMapDims.y)
-    return;
+    return 0.0;
 
   // Compute the ID on depthmap values according to pixel position and depth map dimensions
   int depthMapId = computeVoxelIDDepth(pixel);
   double depth = depths[depthMapId];
   double weight = weights ? weights[depthMapId] : 1.0;
   if (depth <= 0 || weight <= 0)
-    return;
+    return 0.0;
 
-  int gridId = computeVoxelIDGrid(voxelIndex);  // Get the distance between voxel and camera
+  // Get the distance between voxel and camera
   double realDepth = voxelCenterCamera[2];
   double newValue;
   rayPotential(realDepth, depth, newValue);
+  return weight * newValue;
+}
+
+//*****************************************************************************
+
+// Main kernel for adding a depth map to the volume
+__global__ void depthMapKernel(double* depths, double* weights, double matrixK[size4x4], double matrixRT[size4x4],
+  double* output, int z_offset)
+{
+  // Get voxel coordinate according to thread id
+  int voxelIndex[3] = { (int)(blockIdx.x * blockDim.x + threadIdx.x),
+                        (int)(blockIdx.y * blockDim.y + threadIdx.y),
+                        (int)blockIdx.z + z_offset };
+  if (voxelIndex[0] >= c_gridDims.x ||
+      voxelIndex[1] >= c_gridDims.y ||
+      voxelIndex[2] >= c_gridDims.z)
+  {
+    return;
+  }
+
+  int gridId = computeVoxelIDGrid(voxelIndex);
   // Update the value to the output
-  output[gridId] += weight * newValue;
+  output[gridId] += integrateVoxel(voxelIndex, depths, weights, matrixK, matrixRT);
+}
+
+//*****************************************************************************
+
+// Kernel for adding a depth map to the bricks of a sparse volume
+//
+// Each block processes one brick.  The first voxel of each brick is given by
+// three consecutive entries of origins, and the voxels of each brick are
+// stored consecutively in output with the first index varying fastest.
+__global__ void depthMapBrickKernel(double* depths, double* weights, double matrixK[size4x4], double matrixRT[size4x4],
+  int* origins, int brickSize, double* output, int brick_offset)
+{
+  int brick = blockIdx.x + brick_offset;
+  int brickVoxels = brickSize * brickSize * brickSize;
+  int* origin = origins + 3 * brick;
+  double* brickOutput = output + static_cast<size_t>(brick) * brickVoxels;
+  for (int v = threadIdx.x; v < brickVoxels; v += blockDim.x)
+  {
+    int voxelIndex[3] = { origin[0] + v % brickSize,
+                          origin[1] + (v / brickSize) % brickSize,
+                          origin[2] + v / (brickSize * brickSize) };
+    if (voxelIndex[0] >= c_gridDims.x ||
+        voxelIndex[1] >= c_gridDims.y ||
+        voxelIndex[2] >= c_gridDims.z)
+    {
+      continue;
+    }
+
+    brickOutput[v] += integrateVoxel(voxelIndex, depths, weights, matrixK, matrixRT);
+  }
 }
 
 //*****************************************************************************
@@ -262,4 +303,47 @@ void launch_depth_kernel(double * d_depth, double * d_conf,
   }
 }
 
+//*****************************************************************************
+
+void launch_depth_brick_kernel(double * d_depth, double * d_conf,
+                               int h_depthMapDims[2], double d_K[size4x4],
+                               double d_RT[size4x4], int* d_origins,
+                               int num_bricks, int brick_size,
+                               double* d_volume,
+                               unsigned max_voxels_per_launch)
+{
+  auto logger = kwiver::vital::get_logger("arrows.cuda.integrate_depth_maps");
+
+  int brick_voxels = brick_size * brick_size * brick_size;
+  int brick_step = num_bricks;
+  if (max_voxels_per_launch > 0)
+  {
+    brick_step = max_voxels_per_launch / brick_voxels;
+  }
+  if (brick_step == 0)
+  {
+    brick_step = 1;
+    LOG_WARN(logger, brick_voxels << " voxels per brick exceeds "
+                     << max_voxels_per_launch);
+  }
+
+  // One block per brick, with a thread per voxel up to the block size limit
+  dim3 dimBlock(brick_voxels < 256 ? brick_voxels : 256, 1, 1);
+
+  CudaErrorCheck(cudaMemcpyToSymbol(c_depthMapDims, h_depthMapDims,
+                                    2 * sizeof(int)));
+  CudaErrorCheck(cudaDeviceSynchronize());
+  for (int offset = 0; offset < num_bricks; offset += brick_step)
+  {
+    int count = num_bricks - offset < brick_step ? num_bricks - offset
+                                                 : brick_step;
+    LOG_DEBUG(logger, "Launching brick kernel with offset=" << offset);
+    depthMapBrickKernel << < count, dimBlock >> >(d_depth, d_conf, d_K, d_RT,
+                                                  d_origins, brick_size,
+                                                  d_volume, offset);
+    CudaErrorCheck(cudaPeekAtLastError());
+    CudaErrorCheck(cudaDeviceSynchronize());
+  }
+}
+
 #endif
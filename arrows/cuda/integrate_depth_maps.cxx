@@ -8,7 +8,9 @@
 #include <arrows/cuda/integrate_depth_maps.h>
 #include <arrows/cuda/cuda_error_check.h>
 #include <arrows/cuda/cuda_memory.h>
+#include <arrows/cuda/image_container.h>
 #include <arrows/core/depth_utils.h>
+#include <arrows/core/sparse_volume.h>
 #include <sstream>
 #include <cuda_runtime.h>
 #include <cuda.h>
@@ -24,6 +26,12 @@ void launch_depth_kernel(double * d_depth, double * d_weight, int depthmap_dims[
                          double d_K[16], double d_RT[16], double* output,
                          unsigned max_voxels_per_launch);
 
+void launch_depth_brick_kernel(double * d_depth, double * d_weight,
+                               int depthmap_dims[2], double d_K[16],
+                               double d_RT[16], int* d_origins,
+                               int num_bricks, int brick_size, double* output,
+                               unsigned max_voxels_per_launch);
+
 namespace kwiver {
 namespace arrows {
 namespace cuda {
@@ -42,6 +50,7 @@ class integrate_depth_maps::priv
       grid_spacing {1.0, 1.0, 1.0},
       voxel_spacing_factor(1.0),
       max_voxels_per_launch(20000000),
+      brick_size(8),
       m_logger(vital::get_logger("arrows.cuda.integrate_depth_maps"))
   {
   }
@@ -65,6 +74,18 @@ class integrate_depth_maps::priv
   // Maximum number of voxels to process in a single kernel launch
   unsigned max_voxels_per_launch;
 
+  // number of voxels along each side of a brick of a sparse volume
+  unsigned brick_size;
+
+  // compute the voxel spacing and grid dimensions of a bounding region and
+  // copy the constants of the integration to the GPU
+  //
+  // returns the distance within which a voxel is near a depth
+  double setup(vector_3d const& minpt_bound,
+               vector_3d const& maxpt_bound,
+               std::vector<camera_perspective_sptr> const& cameras,
+               vector_3d& spacing);
+
   // Logger handle
   vital::logger_handle_t m_logger;
 };
@@ -115,6 +136,9 @@ integrate_depth_maps::get_configuration() const
                     "launch.  Processing too much data at once on the GPU "
                     "can cause the GPU to time out.  Set to zero for "
                     "unlimited.");
+  config->set_value("brick_size", d_->brick_size,
+                    "Number of voxels along each side of the bricks in which "
+                    "a sparse volume is allocated.");
 
   std::ostringstream stream;
   stream << d_->grid_spacing[0] << " "
@@ -154,6 +178,8 @@ integrate_depth_maps::set_configuration(vital::config_block_sptr in_config)
   d_->max_voxels_per_launch =
     config->get_value<unsigned>("max_voxels_per_launch",
                                 d_->max_voxels_per_launch);
+  d_->brick_size =
+    config->get_value<unsigned>("brick_size", d_->brick_size);
 
   std::ostringstream ostream;
   ostream << d_->grid_spacing[0] << " "
@@ -180,6 +206,18 @@ cuda_ptr<double>
 copy_img_to_gpu(kwiver::vital::image_container_sptr h_img)
 {
   size_t size = h_img->height() * h_img->width();
+
+  // depth maps already on the GPU are copied without a host round trip
+  auto const* d_src = dynamic_cast<cuda::image_container const*>(h_img.get());
+  if (d_src && d_src->depth() == 1 &&
+      d_src->pixel_traits() == image_pixel_traits_of<double>())
+  {
+    auto d_img = make_cuda_mem<double>(size);
+    CudaErrorCheck(cudaMemcpy(d_img.get(), d_src->device_data(),
+                              size * sizeof(double),
+                              cudaMemcpyDeviceToDevice));
+    return d_img;
+  }
   std::unique_ptr<double[]> temp(new double[size]);
 
   //copy to cuda format
@@ -233,15 +271,12 @@ void copy_camera_to_gpu(kwiver::vital::camera_perspective_sptr camera,
 
 //*****************************************************************************
 
-void
-integrate_depth_maps::integrate(
-  vector_3d const& minpt_bound,
-  vector_3d const& maxpt_bound,
-  std::vector<image_container_sptr> const& depth_maps,
-  std::vector<image_container_sptr> const& weight_maps,
-  std::vector<camera_perspective_sptr> const& cameras,
-  image_container_sptr& volume,
-  vector_3d &spacing) const
+double
+integrate_depth_maps::priv
+::setup(vector_3d const& minpt_bound,
+        vector_3d const& maxpt_bound,
+        std::vector<camera_perspective_sptr> const& cameras,
+        vector_3d& spacing)
 {
   double pixel_to_world_scale;
   pixel_to_world_scale =
@@ -251,29 +286,46 @@ integrate_depth_maps::integrate(
   vector_3d diff = maxpt_bound - minpt_bound;
   vector_3d orig = minpt_bound;
 
-  spacing = vector_3d(d_->grid_spacing);
-  spacing *= pixel_to_world_scale * d_->voxel_spacing_factor;
+  spacing = vector_3d(grid_spacing);
+  spacing *= pixel_to_world_scale * voxel_spacing_factor;
   double max_spacing = spacing.maxCoeff();
 
   for (int i = 0; i < 3; i++)
   {
-    d_->grid_dims[i] = static_cast<int>((diff[i] / spacing[i]));
+    grid_dims[i] = static_cast<int>((diff[i] / spacing[i]));
   }
 
-  LOG_DEBUG( logger(), "voxel size: " << spacing[0]
+  LOG_DEBUG( m_logger, "voxel size: " << spacing[0]
                        << " "         << spacing[1]
                        << " "         << spacing[2] );
-  LOG_DEBUG( logger(), "grid: " << d_->grid_dims[0]
-                       << " "   << d_->grid_dims[1]
-                       << " "   << d_->grid_dims[2] );
-
-  LOG_INFO( logger(), "initialize" );
-  cuda_initalize(d_->grid_dims, orig.data(), spacing.data(),
-                 d_->ray_potential_thickness * max_spacing,
-                 d_->ray_potential_rho,
-                 d_->ray_potential_eta,
-                 d_->ray_potential_epsilon,
-                 d_->ray_potential_delta * max_spacing);
+  LOG_DEBUG( m_logger, "grid: " << grid_dims[0]
+                       << " "   << grid_dims[1]
+                       << " "   << grid_dims[2] );
+
+  LOG_INFO( m_logger, "initialize" );
+  cuda_initalize(grid_dims, orig.data(), spacing.data(),
+                 ray_potential_thickness * max_spacing,
+                 ray_potential_rho,
+                 ray_potential_eta,
+                 ray_potential_epsilon,
+                 ray_potential_delta * max_spacing);
+
+  return ray_potential_delta * max_spacing;
+}
+
+//*****************************************************************************
+
+void
+integrate_depth_maps::integrate(
+  vector_3d const& minpt_bound,
+  vector_3d const& maxpt_bound,
+  std::vector<image_container_sptr> const& depth_maps,
+  std::vector<image_container_sptr> const& weight_maps,
+  std::vector<camera_perspective_sptr> const& cameras,
+  image_container_sptr& volume,
+  vector_3d &spacing) const
+{
+  d_->setup(minpt_bound, maxpt_bound, cameras, spacing);
   const size_t vsize = static_cast<size_t>(d_->grid_dims[0]) *
                        static_cast<size_t>(d_->grid_dims[1]) *
                        static_cast<size_t>(d_->grid_dims[2]);
@@ -318,6 +370,99 @@ integrate_depth_maps::integrate(
                     1, d_->grid_dims[0], d_->grid_dims[0] * d_->grid_dims[1]));
 }
 
+//*****************************************************************************
+
+void
+integrate_depth_maps::integrate_sparse(
+  vector_3d const& minpt_bound,
+  vector_3d const& maxpt_bound,
+  std::vector<image_container_sptr> const& depth_maps,
+  std::vector<image_container_sptr> const& weight_maps,
+  std::vector<camera_perspective_sptr> const& cameras,
+  core::sparse_volume& volume,
+  vector_3d &spacing) const
+{
+  double const band = d_->setup(minpt_bound, maxpt_bound, cameras, spacing);
+  volume.reset(d_->grid_dims[0], d_->grid_dims[1], d_->grid_dims[2],
+               d_->brick_size);
+
+  // find the bricks near every surface on the host before integrating any
+  // depth map so that each brick receives the contributions of all of them
+  auto weight_image = [&](size_t i)
+  {
+    if (i < weight_maps.size())
+    {
+      auto weight = weight_maps[i];
+      if (weight->width() == depth_maps[i]->width() &&
+          weight->height() == depth_maps[i]->height())
+      {
+        return image_of<double>{ weight->get_image() };
+      }
+    }
+    return image_of<double>{};
+  };
+  for (size_t i = 0; i < depth_maps.size(); i++)
+  {
+    core::allocate_surface_bricks(volume, *cameras[i],
+                                  image_of<double>{ depth_maps[i]->get_image() },
+                                  weight_image(i), minpt_bound, spacing,
+                                  band);
+  }
+
+  auto const num_bricks = volume.num_bricks();
+  auto const vsize = num_bricks * volume.brick_voxels();
+  LOG_INFO( logger(), "allocated " << num_bricks << " bricks of "
+                      << volume.brick_voxels() << " voxels" );
+  if (num_bricks == 0)
+  {
+    return;
+  }
+
+  std::vector<int> h_origins;
+  h_origins.reserve(3 * num_bricks);
+  for (size_t b = 0; b < num_bricks; ++b)
+  {
+    for (auto const c : volume.brick_origin(b))
+    {
+      h_origins.push_back(static_cast<int>(c));
+    }
+  }
+  auto d_origins = make_cuda_mem<int>(h_origins.size());
+  CudaErrorCheck(cudaMemcpy(d_origins.get(), h_origins.data(),
+                            h_origins.size() * sizeof(int),
+                            cudaMemcpyHostToDevice));
+
+  cuda_ptr<double> d_volume = init_volume_on_gpu(vsize);
+  cuda_ptr<double> d_K = make_cuda_mem<double>(16);
+  cuda_ptr<double> d_RT = make_cuda_mem<double>(16);
+
+  for (size_t i = 0; i < depth_maps.size(); i++)
+  {
+    int depthmap_dims[2];
+    depthmap_dims[0] = static_cast<int>(depth_maps[i]->width());
+    depthmap_dims[1] = static_cast<int>(depth_maps[i]->height());
+    cuda_ptr<double> d_depth = copy_img_to_gpu(depth_maps[i]);
+    cuda_ptr<double> d_weight = nullptr;
+    if (weight_image(i).size() > 0)
+    {
+      d_weight = copy_img_to_gpu(weight_maps[i]);
+    }
+    copy_camera_to_gpu(cameras[i], d_K.get(), d_RT.get());
+
+    // run code on device
+    LOG_INFO( logger(), "depth map " << i );
+    launch_depth_brick_kernel(d_depth.get(), d_weight.get(), depthmap_dims,
+                              d_K.get(), d_RT.get(), d_origins.get(),
+                              static_cast<int>(num_bricks),
+                              static_cast<int>(volume.brick_size()),
+                              d_volume.get(), d_->max_voxels_per_launch);
+  }
+
+  // Transfer data from device to host
+  CudaErrorCheck(cudaMemcpy(volume.data(), d_volume.get(),
+                            vsize * sizeof(double), cudaMemcpyDeviceToHost));
+}
+
 } // end namespace cuda
 } // end namespace arrows
 } // end namespace kwiver
@@ -16,6 +16,11 @@
 
 namespace kwiver {
 namespace arrows {
+
+namespace core {
+class sparse_volume;
+}
+
 namespace cuda {
 
 class KWIVER_ALGO_CUDA_EXPORT integrate_depth_maps
@@ -63,6 +68,29 @@ class KWIVER_ALGO_CUDA_EXPORT integrate_depth_maps
               kwiver::vital::image_container_sptr& volume,
               kwiver::vital::vector_3d &spacing) const;
 
+  /// Integrate multiple depth maps with per-pixel weights into a sparse volume
+  ///
+  /// The bricks of voxels within ray_potential_delta of a depth in some depth
+  /// map are found on the host, and only those bricks are stored and
+  /// integrated on the GPU.  Each allocated voxel has the value integrate()
+  /// would give it.
+  ///
+  /// \param [in]     minpt_bound the min point of the bounding region
+  /// \param [in]     maxpt_bound the max point of the bounding region
+  /// \param [in]     depth_maps  the set of floating point depth map images
+  /// \param [in]     weight_maps the set of floating point [0,1] weight maps
+  /// \param [in]     cameras     the set of cameras, one for each depth map
+  /// \param [out]    volume      the fused volumetric data
+  /// \param [out]    spacing     the spacing between voxels in each dimension
+  void
+    integrate_sparse(kwiver::vital::vector_3d const& minpt_bound,
+                     kwiver::vital::vector_3d const& maxpt_bound,
+                     std::vector<kwiver::vital::image_container_sptr> const& depth_maps,
+                     std::vector<kwiver::vital::image_container_sptr> const& weight_maps,
+                     std::vector<kwiver::vital::camera_perspective_sptr> const& cameras,
+                     core::sparse_volume& volume,
+                     kwiver::vital::vector_3d &spacing) const;
+
 private:
   /// private implementation class
   class priv;
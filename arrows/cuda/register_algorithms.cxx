@@ -8,6 +8,7 @@
 #include <arrows/cuda/kwiver_algo_cuda_plugin_export.h>
 #include <vital/algo/algorithm_factory.h>
 
+#include <arrows/cuda/compute_depth.h>
 #include <arrows/cuda/integrate_depth_maps.h>
 
 namespace kwiver {
@@ -26,6 +27,7 @@ register_factories( kwiver::vital::plugin_loader& vpm )
     return;
   }
 
+  reg.register_algorithm< compute_depth >();
   reg.register_algorithm< integrate_depth_maps >();
 
   reg.mark_module_as_loaded();
@@ -16,6 +16,8 @@
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <sstream>
 #include <exception>
@@ -57,6 +59,8 @@ class darknet_detector::priv
     , m_resize_i( 0 )
     , m_resize_j( 0 )
     , m_chip_step( 100 )
+    , m_chip_nms_threshold( 1.0 )
+    , m_batch_size( 1 )
     , m_names( 0 )
     , m_boxes( 0 )
     , m_probs( 0 )
@@ -81,6 +85,8 @@ class darknet_detector::priv
   int m_resize_i;
   int m_resize_j;
   int m_chip_step;
+  double m_chip_nms_threshold;
+  int m_batch_size;
 
   // Needed to operate the model
   char **m_names;                 // list of classes/labels
@@ -89,9 +95,26 @@ class darknet_detector::priv
   box *m_boxes;                   // detection boxes
   float **m_probs;                //
 
+  // An image passed through the network, and the transform from its
+  // detections back to the source image
+  struct network_input
+  {
+    cv::Mat image;
+    size_t source;
+    double scale;
+    int shift_i;
+    int shift_j;
+    double source_scale;
+  };
+
   // Helper functions
   image cvmat_to_image( const cv::Mat& src );
-  vital::detected_object_set_sptr process_image( const cv::Mat& cv_image );
+  void add_network_inputs( const cv::Mat& cv_image, size_t source,
+                           std::vector< network_input >& inputs );
+  std::vector< vital::detected_object_set_sptr >
+  process_images( const std::vector< network_input >& inputs );
+  vital::detected_object_set_sptr extract_detections( int batch_index,
+                                                      int width, int height );
 
   kwiver::vital::logger_handle_t m_logger;
 };
@@ -143,6 +166,15 @@ get_configuration() const
     "Height resolution after resizing" );
   config->set_value( "chip_step", d->m_chip_step,
     "When in chip mode, the chip step size between chips." );
+  config->set_value( "chip_nms_threshold", d->m_chip_nms_threshold,
+    "When in chip mode, detections of overlapping chips are merged by "
+    "removing those overlapping a more confident detection of the same class "
+    "with an intersection over union above this threshold. A value of 1 or "
+    "more leaves the detections of all chips." );
+  config->set_value( "batch_size", d->m_batch_size,
+    "Number of images or chips passed through the network together. Chips "
+    "of a frame, and frames given to batch_detect, are grouped into batches "
+    "of this size. Limited to the batch size the network config allocates." );
 
   return config;
 }
@@ -170,6 +202,9 @@ set_configuration( vital::config_block_sptr config_in )
   this->d->m_resize_i    = config->get_value< int >( "resize_ni" );
   this->d->m_resize_j    = config->get_value< int >( "resize_nj" );
   this->d->m_chip_step   = config->get_value< int >( "chip_step" );
+  this->d->m_chip_nms_threshold =
+    config->get_value< double >( "chip_nms_threshold" );
+  this->d->m_batch_size  = config->get_value< int >( "batch_size" );
 
   // the size of this array is a mystery - probably has to match some
   //  constant in net description
@@ -190,7 +225,18 @@ set_configuration( vital::config_block_sptr config_in )
     load_weights( &d->m_net, const_cast< char* >( d->m_weight_file.c_str() ) );
   }
 
-  set_batch_network( &d->m_net, 1 );
+  // layers are allocated for the batch of the network config, so larger
+  // batches can not be run
+  if( d->m_batch_size > d->m_net.batch )
+  {
+    LOG_WARN( logger(), "batch_size " << d->m_batch_size << " exceeds the "
+              "network config batch of " << d->m_net.batch << "; using "
+              << d->m_net.batch );
+    d->m_batch_size = d->m_net.batch;
+  }
+  d->m_batch_size = std::max( d->m_batch_size, 1 );
+
+  set_batch_network( &d->m_net, d->m_batch_size );
 
   // This assumes that there are no other users of random number
   // generator in this application.
@@ -252,97 +298,192 @@ check_configuration( vital::config_block_sptr config ) const
 vital::detected_object_set_sptr
 darknet_detector::
 detect( vital::image_container_sptr image_data ) const
+{
+  return batch_detect( { image_data } ).front();
+} // darknet_detector::detect
+
+// ----------------------------------------------------------------------------
+std::vector< vital::detected_object_set_sptr >
+darknet_detector::
+batch_detect( std::vector< vital::image_container_sptr > const& images ) const
 {
   kwiver::vital::scoped_cpu_timer t( "Time to Detect Objects" );
 
-  cv::Mat cv_image = kwiver::arrows::ocv::image_container::vital_to_ocv( image_data->get_image(), kwiver::arrows::ocv::image_container::BGR_COLOR );
+  // collect the network inputs of all images so that batches may span the
+  // chips of several images
+  std::vector< priv::network_input > inputs;
+  for( size_t i = 0; i < images.size(); ++i )
+  {
+    cv::Mat cv_image = kwiver::arrows::ocv::image_container::vital_to_ocv(
+      images[i]->get_image(), kwiver::arrows::ocv::image_container::BGR_COLOR );
+    d->add_network_inputs( cv_image, i, inputs );
+  }
+
+  std::vector< vital::detected_object_set_sptr > detections( images.size() );
+  for( auto& dets : detections )
+  {
+    dets = std::make_shared< vital::detected_object_set >();
+  }
 
-  cv::Mat cv_resized_image;
+  // run detector and map detections back to their source images
+  auto const input_dets = d->process_images( inputs );
+  for( size_t i = 0; i < inputs.size(); ++i )
+  {
+    auto const& input = inputs[i];
+    vital::detected_object_set_sptr new_dets = input_dets[i];
+
+    scale_detections( new_dets, 1.0 / input.scale );
+    if( input.shift_i != 0 || input.shift_j != 0 )
+    {
+      shift_detections( new_dets, input.shift_i, input.shift_j );
+    }
+    if( input.source_scale != 1.0 )
+    {
+      scale_detections( new_dets, 1.0 / input.source_scale );
+    }
+
+    detections[ input.source ]->add( new_dets );
+  }
 
-  vital::detected_object_set_sptr detections;
+  // merge the detections that overlapping chips found of the same objects
+  if( d->m_chip_nms_threshold < 1.0 &&
+      ( d->m_resize_option == "chip" ||
+        d->m_resize_option == "chip_and_original" ) )
+  {
+    vital::nms_options options;
+    options.iou_threshold = d->m_chip_nms_threshold;
+    options.class_aware = true;
+    for( auto& dets : detections )
+    {
+      dets = vital::non_max_suppression( *dets, options );
+    }
+  }
+
+  return detections;
+} // darknet_detector::batch_detect
+
+// ----------------------------------------------------------------------------
+void
+darknet_detector::priv::
+add_network_inputs( const cv::Mat& cv_image, size_t source,
+                    std::vector< network_input >& inputs )
+{
+  cv::Mat cv_resized_image;
 
   // resizes image if enabled
   double scale_factor = 1.0;
 
-  if( d->m_resize_option != "disabled" )
+  if( m_resize_option != "disabled" )
   {
     scale_factor = format_image( cv_image, cv_resized_image,
-      d->m_resize_option, d->m_scale, d->m_resize_i, d->m_resize_j );
+      m_resize_option, m_scale, m_resize_i, m_resize_j );
   }
   else
   {
     cv_resized_image = cv_image;
   }
 
-  // run detector
-  if( d->m_resize_option != "chip" && d->m_resize_option != "chip_and_original" )
+  if( m_resize_option != "chip" && m_resize_option != "chip_and_original" )
   {
-    detections = d->process_image( cv_resized_image );
-
-    // rescales output detections if required
-    scale_detections( detections, 1.0 / scale_factor );
+    inputs.push_back( { cv_resized_image, source, scale_factor, 0, 0, 1.0 } );
+    return;
   }
-  else
+
+  // Chip up scaled image
+  for( int li = 0; li < cv_resized_image.cols - m_resize_i + m_chip_step; li += m_chip_step )
   {
-    detections = std::make_shared< vital::detected_object_set >();
+    int ti = std::min( li + m_resize_i, cv_resized_image.cols );
 
-    // Chip up and process scaled image
-    for( int li = 0; li < cv_resized_image.cols - d->m_resize_i + d->m_chip_step; li += d->m_chip_step )
+    for( int lj = 0; lj < cv_resized_image.rows - m_resize_j + m_chip_step; lj += m_chip_step )
     {
-      int ti = std::min( li + d->m_resize_i, cv_resized_image.cols );
+      int tj = std::min( lj + m_resize_j, cv_resized_image.rows );
 
-      for( int lj = 0; lj < cv_resized_image.rows - d->m_resize_j + d->m_chip_step; lj += d->m_chip_step )
-      {
-        int tj = std::min( lj + d->m_resize_j, cv_resized_image.rows );
+      cv::Mat cropped_image = cv_resized_image( cv::Rect( li, lj, ti-li, tj-lj ) );
+      cv::Mat scaled_crop;
 
-        cv::Mat cropped_image = cv_resized_image( cv::Rect( li, lj, ti-li, tj-lj ) );
-        cv::Mat scaled_crop;
+      double scaled_crop_scale = scale_image_maintaining_ar(
+        cropped_image, scaled_crop, m_resize_i, m_resize_j );
 
-        double scaled_crop_scale = scale_image_maintaining_ar(
-          cropped_image, scaled_crop, d->m_resize_i, d->m_resize_j );
+      inputs.push_back( { scaled_crop, source, scaled_crop_scale,
+                          li, lj, scale_factor } );
+    }
+  }
 
-        vital::detected_object_set_sptr new_dets = d->process_image( scaled_crop );
+  // Process full sized image if enabled
+  if( m_resize_option == "chip_and_original" )
+  {
+    cv::Mat scaled_original;
 
-        scale_detections( new_dets, 1.0 / scaled_crop_scale );
-        shift_detections( new_dets, li, lj );
-        scale_detections( new_dets, 1.0 / scale_factor );
+    double scaled_original_scale = scale_image_maintaining_ar( cv_image,
+      scaled_original, m_resize_i, m_resize_j );
 
-        detections->add( new_dets );
-      }
-    }
+    inputs.push_back( { scaled_original, source, scaled_original_scale,
+                        0, 0, 1.0 } );
+  }
+}
 
-    // Process full sized image if enabled
-    if( d->m_resize_option == "chip_and_original" )
-    {
-      cv::Mat scaled_original;
+// ----------------------------------------------------------------------------
+std::vector< vital::detected_object_set_sptr >
+darknet_detector::priv::
+process_images( const std::vector< network_input >& inputs )
+{
+  std::vector< vital::detected_object_set_sptr > detections;
+  detections.reserve( inputs.size() );
+
+  const size_t input_size =
+    static_cast< size_t >( m_net.w ) * m_net.h * m_net.c;
+  std::vector< float > X;
+  std::vector< int > widths, heights;
 
-      double scaled_original_scale = scale_image_maintaining_ar( cv_image,
-        scaled_original, d->m_resize_i, d->m_resize_j );
+  for( size_t first = 0; first < inputs.size(); first += m_batch_size )
+  {
+    const int n = static_cast< int >(
+      std::min( inputs.size() - first, static_cast< size_t >( m_batch_size ) ) );
+    if( m_net.batch != n )
+    {
+      set_batch_network( &m_net, n );
+    }
 
-      vital::detected_object_set_sptr new_dets = d->process_image( scaled_original );
+    // copies and converts to floating pixel value, one network input each
+    X.assign( n * input_size, 0.0f );
+    widths.resize( n );
+    heights.resize( n );
+    for( int b = 0; b < n; ++b )
+    {
+      image im = cvmat_to_image( inputs[ first + b ].image );
+      image sized = resize_image( im, m_net.w, m_net.h );
+      const size_t sized_size =
+        static_cast< size_t >( sized.w ) * sized.h * sized.c;
+      std::memcpy( X.data() + b * input_size, sized.data,
+                   std::min( sized_size, input_size ) * sizeof( float ) );
+      widths[b] = im.w;
+      heights[b] = im.h;
+
+      free_image( im );
+      free_image( sized );
+    }
 
-      scale_detections( new_dets, 1.0 / scaled_original_scale );
+    // run the batch through network
+    network_predict( m_net, X.data() );
 
-      detections->add( new_dets );
+    for( int b = 0; b < n; ++b )
+    {
+      detections.push_back( extract_detections( b, widths[b], heights[b] ) );
     }
   }
 
   return detections;
-} // darknet_detector::detect
+}
 
 // ----------------------------------------------------------------------------
 vital::detected_object_set_sptr
 darknet_detector::priv::
-process_image( const cv::Mat& cv_image )
+extract_detections( int batch_index, int width, int height )
 {
-  // copies and converts to floating pixel value.
-  image im = cvmat_to_image( cv_image );
-  // show_image( im, "first version" );
-
-  image sized = resize_image( im, m_net.w, m_net.h );
-  // show_image( sized, "sized version" );
-
-  layer l = m_net.layers[m_net.n - 1];     // last network layer (output?)
+  // last network layer, viewed as the output of a single batch entry
+  layer l = m_net.layers[m_net.n - 1];
+  l.output += batch_index * l.outputs;
+  l.batch = 1;
   const size_t l_size = l.w * l.h * l.n;
 
   m_boxes = (box*) calloc( l_size, sizeof( box ) );
@@ -352,12 +493,6 @@ process_image( const cv::Mat& cv_image )
     m_probs[j] = (float*) calloc( l.classes + 1, sizeof( float*) );
   }
 
-  // pointer the image data
-  float* X = sized.data;
-
-  // run image through network
-  network_predict( m_net, X );
-
   // get boxes around detected objects
   get_region_boxes( l,        // i: network output layer
                     1, 1,     // i: w, h -
@@ -392,27 +527,27 @@ process_image( const cv::Mat& cv_image )
   {
     const box b = m_boxes[i];
 
-    int left  = ( b.x - b.w / 2. ) * im.w;
-    int right = ( b.x + b.w / 2. ) * im.w;
-    int top   = ( b.y - b.h / 2. ) * im.h;
-    int bot   = ( b.y + b.h / 2. ) * im.h;
+    int left  = ( b.x - b.w / 2. ) * width;
+    int right = ( b.x + b.w / 2. ) * width;
+    int top   = ( b.y - b.h / 2. ) * height;
+    int bot   = ( b.y + b.h / 2. ) * height;
 
     // clip box to image bounds
     if( left < 0 )
     {
       left = 0;
     }
-    if( right > im.w - 1 )
+    if( right > width - 1 )
     {
-      right = im.w - 1;
+      right = width - 1;
     }
     if( top < 0 )
     {
       top = 0;
     }
-    if( bot > im.h - 1 )
+    if( bot > height - 1 )
     {
-      bot = im.h - 1;
+      bot = height - 1;
     }
 
     kwiver::vital::bounding_box_d bbox( left, top, right, bot );
@@ -444,8 +579,6 @@ process_image( const cv::Mat& cv_image )
   }
 
   // Free allocated memory
-  free_image(im);
-  free_image(sized);
   free( m_boxes );
   free_ptrs( (void**)m_probs, l_size );
 
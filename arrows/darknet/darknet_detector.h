@@ -34,6 +34,9 @@ class KWIVER_ALGO_DARKNET_EXPORT darknet_detector
   vital::detected_object_set_sptr detect(
     vital::image_container_sptr image_data ) const override;
 
+  std::vector< vital::detected_object_set_sptr > batch_detect(
+    std::vector< vital::image_container_sptr > const& images ) const override;
+
 private:
   class priv;
   const std::unique_ptr<priv> d;
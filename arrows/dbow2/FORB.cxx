@@ -104,30 +104,52 @@ void FORB::meanValue(const std::vector<FORB::pDescriptor> &descriptors,
 
 // --------------------------------------------------------------------------
 
-double FORB::distance(const FORB::TDescriptor &a,
-  const FORB::TDescriptor &b)
+/// Number of bits set in a 64 bit word, with the compiler builtin where
+/// available so that it becomes a popcount instruction
+static inline uint64_t popcount64(uint64_t v)
 {
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<uint64_t>(__builtin_popcountll(v));
+#else
   // Bit count function got from:
   // http://graphics.stanford.edu/~seander/bithacks.html#CountBitsSetKernighan
+  v = v - ((v >> 1) & (uint64_t)~(uint64_t)0/3);
+  v = (v & (uint64_t)~(uint64_t)0/15*3) + ((v >> 2) &
+    (uint64_t)~(uint64_t)0/15*3);
+  v = (v + (v >> 4)) & (uint64_t)~(uint64_t)0/255*15;
+  return (uint64_t)(v * ((uint64_t)~(uint64_t)0/255)) >>
+    (sizeof(uint64_t) - 1) * CHAR_BIT;
+#endif
+}
+
+// --------------------------------------------------------------------------
+
+double FORB::distance(const FORB::TDescriptor &a,
+  const FORB::TDescriptor &b)
+{
   // This implementation assumes that a.cols (CV_8U) % sizeof(uint64_t) == 0
 
   const uint64_t *pa, *pb;
   pa = a.ptr<uint64_t>(); // a & b are actually CV_8U
   pb = b.ptr<uint64_t>();
 
-  uint64_t v, ret = 0;
-  for(size_t i = 0; i < a.cols / sizeof(uint64_t); ++i, ++pa, ++pb)
+  // ORB descriptors are 32 bytes, so unroll by four words
+  const size_t n = a.cols / sizeof(uint64_t);
+  uint64_t ret0 = 0, ret1 = 0, ret2 = 0, ret3 = 0;
+  size_t i = 0;
+  for(; i + 4 <= n; i += 4)
+  {
+    ret0 += popcount64(pa[i] ^ pb[i]);
+    ret1 += popcount64(pa[i + 1] ^ pb[i + 1]);
+    ret2 += popcount64(pa[i + 2] ^ pb[i + 2]);
+    ret3 += popcount64(pa[i + 3] ^ pb[i + 3]);
+  }
+  for(; i < n; ++i)
   {
-    v = *pa ^ *pb;
-    v = v - ((v >> 1) & (uint64_t)~(uint64_t)0/3);
-    v = (v & (uint64_t)~(uint64_t)0/15*3) + ((v >> 2) &
-      (uint64_t)~(uint64_t)0/15*3);
-    v = (v + (v >> 4)) & (uint64_t)~(uint64_t)0/255*15;
-    ret += (uint64_t)(v * ((uint64_t)~(uint64_t)0/255)) >>
-      (sizeof(uint64_t) - 1) * CHAR_BIT;
+    ret0 += popcount64(pa[i] ^ pb[i]);
   }
 
-  return static_cast<double>(ret);
+  return static_cast<double>(ret0 + ret1 + ret2 + ret3);
 
   // // If uint64_t is not defined in your system, you can try this
   // // portable approach
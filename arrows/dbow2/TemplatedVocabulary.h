@@ -47,8 +47,14 @@
 #include <fstream>
 #include <string>
 #include <algorithm>
+#include <memory>
+#include <cstring>
+#include <stdint.h>
 #include <opencv2/core.hpp>
 
+#include <vital/util/mapped_file.h>
+#include <vital/util/thread_pool.h>
+
 #include "FeatureVector.h"
 #include "BowVector.h"
 #include "ScoringObject.h"
@@ -147,7 +153,8 @@ class TemplatedVocabulary
   virtual inline bool empty() const;
 
   /**
-   * Transforms a set of descriptores into a bow vector
+   * Transforms a set of descriptores into a bow vector.
+   * The features are quantized in parallel
    * @param features
    * @param v (out) bow vector of weighted words
    */
@@ -155,7 +162,8 @@ class TemplatedVocabulary
     const;
 
   /**
-   * Transform a set of descriptors into a bow vector and a feature vector
+   * Transform a set of descriptors into a bow vector and a feature vector.
+   * The features are quantized in parallel
    * @param features
    * @param v (out) bow vector
    * @param fv (out) feature vector of nodes and feature indexes
@@ -260,11 +268,18 @@ class TemplatedVocabulary
   void save(const std::string &filename) const;
 
   /**
-   * Loads the vocabulary from a file
+   * Loads the vocabulary from a file written by save or saveBinary
    * @param filename
    */
   void load(const std::string &filename);
 
+  /**
+   * Saves the vocabulary into a binary file that load maps into memory.
+   * Only cv::Mat descriptors are supported
+   * @param filename
+   */
+  void saveBinary(const std::string &filename) const;
+
   /**
    * Saves the vocabulary to a file storage structure
    * @param fn node in file storage
@@ -409,6 +424,27 @@ class TemplatedVocabulary
    */
   void setNodeWeights(const std::vector<std::vector<TDescriptor> > &features);
 
+  /**
+   * Returns the word, weight and node of each of a set of features,
+   * quantizing the features in parallel
+   * @param features
+   * @param ids (out) word id of each feature
+   * @param weights (out) word weight of each feature
+   * @param nids (out) if given, node id "levelsup" levels up of each feature
+   * @param levelsup
+   */
+  void transformAll(const std::vector<TDescriptor> &features,
+    std::vector<WordId> &ids, std::vector<WordValue> &weights,
+    std::vector<NodeId> *nids = NULL, int levelsup = 0) const;
+
+  /**
+   * Loads the vocabulary from a binary file written by saveBinary.
+   * The node descriptors refer to the mapped file rather than copies
+   * @param filename
+   * @return false if the file is not a binary vocabulary
+   */
+  bool loadBinary(const std::string &filename);
+
 protected:
 
   /// Branching factor
@@ -433,6 +469,9 @@ class TemplatedVocabulary
   /// this condition holds: m_words[wid]->word_id == wid
   std::vector<Node*> m_words;
 
+  /// Binary vocabulary file holding the node descriptors, if mapped
+  std::shared_ptr<kwiver::vital::mapped_file> m_mapping;
+
 };
 
 // --------------------------------------------------------------------------
@@ -554,6 +593,7 @@ TemplatedVocabulary<TDescriptor,F>::operator=
   this->m_words.clear();
 
   this->m_nodes = voc.m_nodes;
+  this->m_mapping = voc.m_mapping;
   this->createWords();
 
   return *this;
@@ -567,6 +607,7 @@ void TemplatedVocabulary<TDescriptor,F>::create(
 {
   m_nodes.clear();
   m_words.clear();
+  m_mapping.reset();
 
   // expected_nodes = Sum_{i=0..L} ( k^i )
   int expected_nodes =
@@ -1090,20 +1131,19 @@ void TemplatedVocabulary<TDescriptor,F>::transform(
   LNorm norm;
   bool must = m_scoring_object->mustNormalize(norm);
 
-  typename std::vector<TDescriptor>::const_iterator fit;
+  std::vector<WordId> ids;
+  std::vector<WordValue> weights;
+  transformAll(features, ids, weights);
 
   if(m_weighting == TF || m_weighting == TF_IDF)
   {
-    for(fit = features.begin(); fit < features.end(); ++fit)
+    for(size_t i = 0; i < features.size(); ++i)
     {
-      WordId id;
-      WordValue w;
       // w is the idf value if TF_IDF, 1 if TF
-
-      transform(*fit, id, w);
+      const WordValue w = weights[i];
 
       // not stopped
-      if(w > 0) v.addWeight(id, w);
+      if(w > 0) v.addWeight(ids[i], w);
     }
 
     if(!v.empty() && !must)
@@ -1117,16 +1157,13 @@ void TemplatedVocabulary<TDescriptor,F>::transform(
   }
   else // IDF || BINARY
   {
-    for(fit = features.begin(); fit < features.end(); ++fit)
+    for(size_t i = 0; i < features.size(); ++i)
     {
-      WordId id;
-      WordValue w;
       // w is idf if IDF, or 1 if BINARY
-
-      transform(*fit, id, w);
+      const WordValue w = weights[i];
 
       // not stopped
-      if(w > 0) v.addIfNotExist(id, w);
+      if(w > 0) v.addIfNotExist(ids[i], w);
 
     } // if add_features
   } // if m_weighting == ...
@@ -1153,24 +1190,22 @@ void TemplatedVocabulary<TDescriptor,F>::transform(
   LNorm norm;
   bool must = m_scoring_object->mustNormalize(norm);
 
-  typename std::vector<TDescriptor>::const_iterator fit;
+  std::vector<WordId> ids;
+  std::vector<WordValue> weights;
+  std::vector<NodeId> nids;
+  transformAll(features, ids, weights, &nids, levelsup);
 
   if(m_weighting == TF || m_weighting == TF_IDF)
   {
-    unsigned int i_feature = 0;
-    for(fit = features.begin(); fit < features.end(); ++fit, ++i_feature)
+    for(unsigned int i_feature = 0; i_feature < features.size(); ++i_feature)
     {
-      WordId id;
-      NodeId nid;
-      WordValue w;
       // w is the idf value if TF_IDF, 1 if TF
-
-      transform(*fit, id, w, &nid, levelsup);
+      const WordValue w = weights[i_feature];
 
       if(w > 0) // not stopped
       {
-        v.addWeight(id, w);
-        fv.addFeature(nid, i_feature);
+        v.addWeight(ids[i_feature], w);
+        fv.addFeature(nids[i_feature], i_feature);
       }
     }
 
@@ -1185,20 +1220,15 @@ void TemplatedVocabulary<TDescriptor,F>::transform(
   }
   else // IDF || BINARY
   {
-    unsigned int i_feature = 0;
-    for(fit = features.begin(); fit < features.end(); ++fit, ++i_feature)
+    for(unsigned int i_feature = 0; i_feature < features.size(); ++i_feature)
     {
-      WordId id;
-      NodeId nid;
-      WordValue w;
       // w is idf if IDF, or 1 if BINARY
-
-      transform(*fit, id, w, &nid, levelsup);
+      const WordValue w = weights[i_feature];
 
       if(w > 0) // not stopped
       {
-        v.addIfNotExist(id, w);
-        fv.addFeature(nid, i_feature);
+        v.addIfNotExist(ids[i_feature], w);
+        fv.addFeature(nids[i_feature], i_feature);
       }
     }
   } // if m_weighting == ...
@@ -1232,7 +1262,6 @@ void TemplatedVocabulary<TDescriptor,F>::transform(const TDescriptor &feature,
   WordId &word_id, WordValue &weight, NodeId *nid, int levelsup) const
 {
   // propagate the feature down the tree
-  std::vector<NodeId> nodes;
   typename std::vector<NodeId>::const_iterator nit;
 
   // level at which the node must be stored in nid, if given
@@ -1245,7 +1274,7 @@ void TemplatedVocabulary<TDescriptor,F>::transform(const TDescriptor &feature,
   do
   {
     ++current_level;
-    nodes = m_nodes[final_id].children;
+    const std::vector<NodeId> &nodes = m_nodes[final_id].children;
     final_id = nodes[0];
 
     double best_d = F::distance(feature, m_nodes[final_id].descriptor);
@@ -1273,6 +1302,33 @@ void TemplatedVocabulary<TDescriptor,F>::transform(const TDescriptor &feature,
 
 // --------------------------------------------------------------------------
 
+template<class TDescriptor, class F>
+void TemplatedVocabulary<TDescriptor,F>::transformAll(
+  const std::vector<TDescriptor> &features,
+  std::vector<WordId> &ids, std::vector<WordValue> &weights,
+  std::vector<NodeId> *nids, int levelsup) const
+{
+  const size_t n = features.size();
+  ids.resize(n);
+  weights.resize(n);
+  if(nids != NULL) nids->resize(n);
+
+  // each feature descends the tree independently; the results are
+  // accumulated by the caller in feature order, so they do not depend on
+  // the number of threads
+  kwiver::vital::thread_pool::instance().parallel_for(n, 64,
+    [&](size_t begin, size_t end)
+  {
+    for(size_t i = begin; i < end; ++i)
+    {
+      transform(features[i], ids[i], weights[i],
+        nids != NULL ? &(*nids)[i] : NULL, levelsup);
+    }
+  });
+}
+
+// --------------------------------------------------------------------------
+
 template<class TDescriptor, class F>
 NodeId TemplatedVocabulary<TDescriptor,F>::getParentNode
   (WordId wid, int levelsup) const
@@ -1361,6 +1417,8 @@ void TemplatedVocabulary<TDescriptor,F>::save(const std::string &filename) const
 template<class TDescriptor, class F>
 void TemplatedVocabulary<TDescriptor,F>::load(const std::string &filename)
 {
+  if(loadBinary(filename)) return;
+
   cv::FileStorage fs(filename.c_str(), cv::FileStorage::READ);
   if(!fs.isOpened()) throw std::string("Could not open file ") + filename;
 
@@ -1369,6 +1427,203 @@ void TemplatedVocabulary<TDescriptor,F>::load(const std::string &filename)
 
 // --------------------------------------------------------------------------
 
+/// Header of a binary vocabulary file
+///
+/// The header is followed, in native byte order, by the weight of each node
+/// (double), the parent of each node, the offset of the children of each
+/// node into the child list plus the end offset, the child list, and the
+/// node of each word (all uint32).  The descriptor bytes of every node,
+/// zeros for the root, follow at the next multiple of 8 bytes.
+struct BinaryVocabularyHeader
+{
+  char magic[8];
+  uint32_t k;
+  uint32_t L;
+  uint32_t scoring;
+  uint32_t weighting;
+  uint32_t nodes;
+  uint32_t words;
+  uint32_t children;
+  uint32_t descriptor_cols;
+  uint32_t descriptor_type;
+  uint32_t descriptor_bytes;
+  uint32_t reserved[4];
+};
+
+static const char binary_vocabulary_magic[8] =
+  { 'K', 'W', 'D', 'B', 'O', 'W', '0', '1' };
+
+// --------------------------------------------------------------------------
+
+template<class TDescriptor, class F>
+void TemplatedVocabulary<TDescriptor,F>::saveBinary(
+  const std::string &filename) const
+{
+  const size_t n = m_nodes.size();
+
+  BinaryVocabularyHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, binary_vocabulary_magic, sizeof(header.magic));
+  header.k = m_k;
+  header.L = m_L;
+  header.scoring = m_scoring;
+  header.weighting = m_weighting;
+  header.nodes = static_cast<uint32_t>(n);
+  header.words = static_cast<uint32_t>(m_words.size());
+  if(n > 1)
+  {
+    const cv::Mat &d = m_nodes[1].descriptor;
+    header.descriptor_cols = d.cols;
+    header.descriptor_type = d.type();
+    header.descriptor_bytes = static_cast<uint32_t>(d.cols * d.elemSize());
+  }
+
+  std::vector<WordValue> weights(n);
+  std::vector<uint32_t> parents(n), offsets(n + 1), children, words;
+  for(size_t i = 0; i < n; ++i)
+  {
+    weights[i] = m_nodes[i].weight;
+    parents[i] = m_nodes[i].parent;
+    offsets[i] = static_cast<uint32_t>(children.size());
+    children.insert(children.end(),
+      m_nodes[i].children.begin(), m_nodes[i].children.end());
+  }
+  offsets[n] = static_cast<uint32_t>(children.size());
+  header.children = offsets[n];
+  for(size_t w = 0; w < m_words.size(); ++w)
+    words.push_back(m_words[w]->id);
+
+  std::ofstream f(filename.c_str(), std::ios::out | std::ios::binary);
+  if(!f) throw std::string("Could not open file ") + filename;
+
+  f.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  f.write(reinterpret_cast<const char*>(weights.data()),
+    weights.size() * sizeof(WordValue));
+  f.write(reinterpret_cast<const char*>(parents.data()),
+    parents.size() * sizeof(uint32_t));
+  f.write(reinterpret_cast<const char*>(offsets.data()),
+    offsets.size() * sizeof(uint32_t));
+  f.write(reinterpret_cast<const char*>(children.data()),
+    children.size() * sizeof(uint32_t));
+  f.write(reinterpret_cast<const char*>(words.data()),
+    words.size() * sizeof(uint32_t));
+
+  const size_t written = sizeof(header) + n * sizeof(WordValue) +
+    (2 * n + 1 + children.size() + words.size()) * sizeof(uint32_t);
+  const char padding[8] = { 0 };
+  f.write(padding, (8 - written % 8) % 8);
+
+  std::vector<char> bytes(header.descriptor_bytes, 0);
+  for(size_t i = 0; i < n; ++i)
+  {
+    if(i > 0)
+    {
+      const cv::Mat d = m_nodes[i].descriptor.isContinuous() ?
+        m_nodes[i].descriptor : m_nodes[i].descriptor.clone();
+      if(d.total() * d.elemSize() != bytes.size())
+        throw std::string("Inconsistent descriptor size writing ") + filename;
+      std::memcpy(bytes.data(), d.data, bytes.size());
+    }
+    f.write(bytes.data(), bytes.size());
+  }
+
+  if(!f) throw std::string("Could not write file ") + filename;
+}
+
+// --------------------------------------------------------------------------
+
+template<class TDescriptor, class F>
+bool TemplatedVocabulary<TDescriptor,F>::loadBinary(const std::string &filename)
+{
+  std::shared_ptr<kwiver::vital::mapped_file> mapping =
+    std::make_shared<kwiver::vital::mapped_file>(filename);
+
+  BinaryVocabularyHeader header;
+  if(!mapping->is_open() || mapping->size() < sizeof(header))
+    return false;
+  std::memcpy(&header, mapping->data(), sizeof(header));
+  if(std::memcmp(header.magic, binary_vocabulary_magic,
+                 sizeof(header.magic)) != 0)
+    return false;
+
+  const size_t n = header.nodes;
+  const size_t table_bytes = sizeof(header) + n * sizeof(WordValue) +
+    (2 * n + 1 + header.children + header.words) * sizeof(uint32_t);
+  const size_t descriptor_offset = (table_bytes + 7) / 8 * 8;
+  if(n == 0 ||
+     mapping->size() < descriptor_offset + n * header.descriptor_bytes)
+    throw std::string("Truncated vocabulary file ") + filename;
+
+  const char *p = mapping->data() + sizeof(header);
+  std::vector<WordValue> weights(n);
+  std::vector<uint32_t> parents(n), offsets(n + 1),
+    children(header.children), words(header.words);
+  std::memcpy(weights.data(), p, n * sizeof(WordValue));
+  p += n * sizeof(WordValue);
+  std::memcpy(parents.data(), p, n * sizeof(uint32_t));
+  p += n * sizeof(uint32_t);
+  std::memcpy(offsets.data(), p, (n + 1) * sizeof(uint32_t));
+  p += (n + 1) * sizeof(uint32_t);
+  std::memcpy(children.data(), p, children.size() * sizeof(uint32_t));
+  p += children.size() * sizeof(uint32_t);
+  std::memcpy(words.data(), p, words.size() * sizeof(uint32_t));
+
+  // reject ids that would index outside the tree
+  for(size_t i = 0; i < n; ++i)
+  {
+    if(parents[i] >= n || offsets[i] > offsets[i + 1] ||
+       offsets[i + 1] > children.size())
+      throw std::string("Invalid vocabulary file ") + filename;
+  }
+  for(size_t i = 0; i < children.size(); ++i)
+    if(children[i] >= n) throw std::string("Invalid vocabulary file ") + filename;
+  for(size_t w = 0; w < words.size(); ++w)
+    if(words[w] >= n) throw std::string("Invalid vocabulary file ") + filename;
+
+  m_words.clear();
+  m_nodes.clear();
+
+  m_k = header.k;
+  m_L = header.L;
+  m_scoring = (ScoringType)header.scoring;
+  m_weighting = (WeightingType)header.weighting;
+
+  createScoringObject();
+
+  // the node descriptors are headers on the read-only mapping, which is
+  // shared with any copies of this vocabulary
+  char *descriptors =
+    const_cast<char*>(mapping->data()) + descriptor_offset;
+
+  m_nodes.resize(n);
+  for(size_t i = 0; i < n; ++i)
+  {
+    Node &node = m_nodes[i];
+    node.id = static_cast<NodeId>(i);
+    node.parent = parents[i];
+    node.weight = weights[i];
+    node.children.assign(children.begin() + offsets[i],
+      children.begin() + offsets[i + 1]);
+    if(i > 0)
+    {
+      node.descriptor = cv::Mat(1, header.descriptor_cols,
+        header.descriptor_type, descriptors + i * header.descriptor_bytes);
+    }
+  }
+
+  m_words.resize(words.size());
+  for(size_t w = 0; w < words.size(); ++w)
+  {
+    m_nodes[words[w]].word_id = static_cast<WordId>(w);
+    m_words[w] = &m_nodes[words[w]];
+  }
+
+  m_mapping = mapping;
+  return true;
+}
+
+// --------------------------------------------------------------------------
+
 template<class TDescriptor, class F>
 void TemplatedVocabulary<TDescriptor,F>::save(cv::FileStorage &f,
   const std::string &name) const
@@ -1472,6 +1727,7 @@ void TemplatedVocabulary<TDescriptor,F>::load(const cv::FileStorage &fs,
 {
   m_words.clear();
   m_nodes.clear();
+  m_mapping.reset();
 
   cv::FileNode fvoc = fs[name];
 
@@ -44,8 +44,11 @@
 #include <vital/algo/extract_descriptors.h>
 #include <vital/algo/image_io.h>
 #include <vital/algo/match_features.h>
+#include <vital/util/resource_cache.h>
 #include <kwiversys/SystemTools.hxx>
 
+#include <cstring>
+
 using namespace kwiver::vital;
 
 namespace kwiver {
@@ -90,7 +93,8 @@ class match_descriptor_sets::priv
   kwiver::vital::logger_handle_t m_logger;
 
   // The vocabulary tree
-  std::shared_ptr<OrbVocabulary> m_voc;
+  // Shared with every other matcher loading the same vocabulary file
+  std::shared_ptr<const OrbVocabulary> m_voc;
 
   // The inverted file database
   std::shared_ptr<OrbDatabase> m_db;
@@ -110,6 +114,9 @@ class match_descriptor_sets::priv
   // The path to the vocabulary
   std::string vocabulary_path;
 
+  // The path to the memory mapped binary copy of the vocabulary
+  std::string binary_vocabulary_path;
+
   std::map<DBoW2::EntryId, kwiver::vital::frame_id_t> m_entry_to_frame;
 
   int m_max_num_candidate_matches_from_vocabulary_tree;
@@ -124,6 +131,7 @@ match_descriptor_sets::priv
 ::priv()
   :training_image_list_path("")
   ,vocabulary_path("kwiver_voc.yml.gz")
+  ,binary_vocabulary_path("")
   ,m_max_num_candidate_matches_from_vocabulary_tree(10)
   ,m_levels_up(2)
 {
@@ -139,8 +147,11 @@ ::setup_voc()
   if (!m_voc)
   {
     //first time we will make the voc.  Then just load it.
+    //The binary copy is mapped rather than parsed, so prefer it.
+    bool const use_binary = !binary_vocabulary_path.empty() &&
+      kwiversys::SystemTools::FileExists(binary_vocabulary_path, true);
     try {
-      load_vocabulary(vocabulary_path);
+      load_vocabulary(use_binary ? binary_vocabulary_path : vocabulary_path);
     }
     catch (const path_not_a_file &e)
     {
@@ -158,6 +169,12 @@ ::setup_voc()
       train_vocabulary(training_image_list_path, vocabulary_path);
     }
 
+    if (!use_binary && !binary_vocabulary_path.empty())
+    {
+      LOG_INFO(m_logger, "Saving binary vocabulary ...");
+      m_voc->saveBinary(binary_vocabulary_path);
+    }
+
     m_db = std::make_shared<OrbDatabase>(*m_voc, true, 3);
   }
 }
@@ -327,8 +344,9 @@ ::train(
 
   const DBoW2::ScoringType score = DBoW2::L1_NORM;
 
-  m_voc = std::make_shared<OrbVocabulary>(k, L, weight, score);
-  m_voc->create(features);
+  auto voc = std::make_shared<OrbVocabulary>(k, L, weight, score);
+  voc->create(features);
+  m_voc = voc;
 
   // save the vocabulary to disk
   LOG_INFO(m_logger, "Saving vocabulary ...");
@@ -351,8 +369,9 @@ ::load_vocabulary(std::string voc_file_path)
     throw path_not_a_file(voc_file_path);
   }
 
-
-  m_voc = std::make_shared<OrbVocabulary>(voc_file_path);
+  m_voc = resource_cache::instance().get<OrbVocabulary>(
+    resource_cache::file_key(voc_file_path),
+    [&]{ return std::make_shared<OrbVocabulary>(voc_file_path); });
 }
 
 //-----------------------------------------------------------------------------
@@ -440,10 +459,7 @@ ::descriptor_to_mat(descriptor_sptr desc) const
   auto const num_bytes = desc->num_bytes();
   cv::Mat desc_mat = cv::Mat(1, static_cast<int>(num_bytes), CV_8UC1);
 
-  for(unsigned int bn = 0; bn < num_bytes; ++bn, ++db)
-  {
-    desc_mat.at<unsigned char>(0, bn) = *db;
-  }
+  std::memcpy(desc_mat.data, db, num_bytes);
   return desc_mat;
 }
 
@@ -512,6 +528,12 @@ get_configuration() const
     d_->vocabulary_path,
     "path to the vocabulary file");
 
+  config->set_value("binary_vocabulary_path",
+    d_->binary_vocabulary_path,
+    "path to a binary copy of the vocabulary, which is memory mapped "
+    "instead of parsed when loading. If set and the file does not exist, "
+    "it is written after the vocabulary is loaded or trained.");
+
   return config;
 }
 
@@ -552,6 +574,10 @@ set_configuration(vital::config_block_sptr config_in)
 
   d_->vocabulary_path =
     config->get_value<std::string>("vocabulary_path", d_->vocabulary_path);
+
+  d_->binary_vocabulary_path =
+    config->get_value<std::string>("binary_vocabulary_path",
+      d_->binary_vocabulary_path);
 }
 
 // ------------------------------------------------------------------
@@ -17,6 +17,7 @@
 #include <arrows/klv/klv_demuxer.h>
 #include <arrows/klv/klv_metadata.h>
 #include <arrows/klv/klv_muxer.h>
+#include <arrows/klv/klv_read_write.h>
 #include <arrows/klv/misp_time.h>
 
 #include <vital/exceptions/io.h>
@@ -25,9 +26,13 @@
 #include <vital/range/iota.h>
 
 #include <vital/types/image_container.h>
+#include <vital/types/image_memory_pool.h>
 #include <vital/types/timestamp.h>
 
+#include <vital/util/bounded_buffer.h>
+#include <vital/util/file_md5.h>
 #include <vital/util/tokenize.h>
+#include <vital/util/trace.h>
 
 #include <vital/optional.h>
 #include <vital/vital_config.h>
@@ -46,11 +51,17 @@ extern "C" {
 #include <libswscale/swscale.h>
 }
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fstream>
 #include <iomanip>
 #include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 namespace kv = kwiver::vital;
@@ -65,6 +76,9 @@ namespace ffmpeg {
 
 namespace {
 
+// First line of a cached keyframe index file
+char const* const keyframe_index_header = "# kwiver ffmpeg keyframe index v1";
+
 // ----------------------------------------------------------------------------
 struct ffmpeg_klv_stream
 {
@@ -83,8 +97,8 @@ struct ffmpeg_klv_stream
   kv::metadata_sptr vital_metadata( uint64_t timestamp, bool smooth_packets );
 
   AVStream* stream;
-  std::multimap< int64_t, std::vector< uint8_t > > buffer;
-  std::vector< uint8_t > bytes;
+  std::multimap< int64_t, packet_uptr > buffer;
+  std::shared_ptr< klv::klv_bytes_t const > bytes;
   std::vector< klv::klv_packet > packets;
   klv::klv_timeline timeline;
   klv::klv_demuxer demuxer;
@@ -117,9 +131,13 @@ ::send_packet( AVPacket* packet )
   {
     return;
   }
-  auto const begin = packet->data;
-  auto const end = begin + packet->size;
-  buffer.emplace( packet->pts, std::vector< uint8_t >{ begin, end } );
+
+  // Referencing the packet avoids copying its data until it is parsed
+  packet_uptr packet_ref{
+    throw_error_null( av_packet_alloc(), "Could not allocate packet" ) };
+  throw_error_code( av_packet_ref( packet_ref.get(), packet ),
+                    "Could not give packet to KLV stream" );
+  buffer.emplace( packet->pts, std::move( packet_ref ) );
 }
 
 // ----------------------------------------------------------------------------
@@ -129,11 +147,26 @@ ::advance( kv::optional< uint64_t > backup_timestamp, int64_t max_pts )
 {
   packets.clear();
 
+  // Parsed KLV values may refer into the bytes parsed before, so new data
+  // goes into a new buffer along with any incomplete packet left over
+  if( buffer.empty() ||
+      ( buffer.begin()->first > max_pts &&
+        buffer.begin()->first != AV_NOPTS_VALUE ) )
+  {
+    return;
+  }
+
+  auto next_bytes = std::make_shared< klv::klv_bytes_t >();
+  if( bytes )
+  {
+    next_bytes->assign( bytes->begin(), bytes->end() );
+  }
   for( auto it = buffer.begin(); it != buffer.end(); )
   {
     if( it->first <= max_pts || it->first == AV_NOPTS_VALUE )
     {
-      bytes.insert( bytes.end(), it->second.begin(), it->second.end() );
+      auto const data = it->second->data;
+      next_bytes->insert( next_bytes->end(), data, data + it->second->size );
       it = buffer.erase( it );
     }
     else
@@ -141,14 +174,17 @@ ::advance( kv::optional< uint64_t > backup_timestamp, int64_t max_pts )
       break;
     }
   }
+  bytes = next_bytes;
 
-  auto it = &*bytes.cbegin();
-  while( it != &*bytes.cend() )
+  klv::klv_read_buffer_scope const scope{ bytes };
+  auto const bytes_end = bytes->data() + bytes->size();
+  auto it = bytes->data();
+  while( it != bytes_end )
   {
     try
     {
       auto const length =
-        static_cast< size_t >( std::distance( it, &*bytes.cend() ) );
+        static_cast< size_t >( std::distance( it, bytes_end ) );
       packets.emplace_back( klv::klv_read_packet( it, length ) );
     }
     catch( kv::metadata_buffer_overflow const& )
@@ -160,13 +196,19 @@ ::advance( kv::optional< uint64_t > backup_timestamp, int64_t max_pts )
     {
       LOG_ERROR( kv::get_logger( "klv" ),
         "Error while parsing KLV packet: " << e.what() );
-      it = &*bytes.cend();
+      it = bytes_end;
     }
   }
 
-  // Weirdness here to get around CentOS compiler bug
-  bytes.erase( bytes.begin(),
-               bytes.begin() + std::distance( &*bytes.cbegin(), it ) );
+  // Keep only the incomplete packet, if any, for next time
+  if( it == bytes_end )
+  {
+    bytes.reset();
+  }
+  else if( it != bytes->data() )
+  {
+    bytes = std::make_shared< klv::klv_bytes_t const >( it, bytes_end );
+  }
 
   if( packets.empty() )
   {
@@ -182,7 +224,7 @@ ffmpeg_klv_stream
 ::reset()
 {
   buffer.clear();
-  bytes.clear();
+  bytes.reset();
   packets.clear();
   timeline.clear();
   demuxer.reset();
@@ -210,6 +252,104 @@ ::vital_metadata( uint64_t timestamp, bool smooth_packets )
   return result;
 }
 
+// ----------------------------------------------------------------------------
+bool
+is_blank( std::string const& s )
+{
+  return std::all_of( s.begin(), s.end(), isspace );
+}
+
+// ----------------------------------------------------------------------------
+// Decode timestamp of \p packet, or its presentation timestamp if unknown.
+int64_t
+packet_timestamp( AVPacket const& packet )
+{
+  return ( packet.dts != AV_NOPTS_VALUE ) ? packet.dts : packet.pts;
+}
+
+// ----------------------------------------------------------------------------
+// Build a filter graph from \p description, fed by a buffer source created
+// with \p source_args and draining into a buffer sink. If \p hw_frames_ctx is
+// given, the buffer source accepts frames residing on that hardware device.
+void
+create_filter_graph(
+  std::string const& description, std::string const& source_args,
+  AVBufferRef* hw_frames_ctx, filter_graph_uptr& graph,
+  AVFilterContext*& source_context, AVFilterContext*& sink_context )
+{
+  source_context = nullptr;
+  sink_context = nullptr;
+
+  // Allocate filter graph
+  graph.reset(
+    throw_error_null(
+      avfilter_graph_alloc(), "Could not allocate filter graph" ) );
+
+  // Create the input buffer
+  throw_error_code(
+    avfilter_graph_create_filter(
+      &source_context, avfilter_get_by_name( "buffer" ),
+      "in", source_args.c_str(), NULL, graph.get() ),
+    "Could not create buffer source" );
+
+  if( hw_frames_ctx )
+  {
+    auto const params =
+      throw_error_null(
+        av_buffersrc_parameters_alloc(),
+        "Could not allocate buffer source parameters" );
+    params->hw_frames_ctx = hw_frames_ctx;
+    auto const err = av_buffersrc_parameters_set( source_context, params );
+    av_free( params );
+    throw_error_code( err, "Could not give hardware frames to buffer source" );
+  }
+
+  // Create the output buffer
+  throw_error_code(
+    avfilter_graph_create_filter(
+      &sink_context, avfilter_get_by_name( "buffersink" ),
+      "out", NULL, NULL, graph.get() ),
+    "Could not create buffer sink" );
+
+  // Create the input node
+  filter_in_out_uptr output{
+    throw_error_null(
+      avfilter_inout_alloc(),
+      "Could not allocate filter output" ) };
+  output->name = av_strdup( "in" );
+  output->filter_ctx = source_context;
+  output->pad_idx = 0;
+  output->next = NULL;
+
+  // Create the output node
+  filter_in_out_uptr input{
+    throw_error_null(
+      avfilter_inout_alloc(),
+      "Could not allocate filter input" ) };
+  input->name = av_strdup( "out" );
+  input->filter_ctx = sink_context;
+  input->pad_idx = 0;
+  input->next = NULL;
+
+  // Parse graph
+  {
+    auto input_ptr = input.release();
+    auto output_ptr = output.release();
+    auto const err =
+      avfilter_graph_parse_ptr(
+        graph.get(), description.c_str(),
+        &input_ptr, &output_ptr, NULL );
+    avfilter_inout_free( &input_ptr );
+    avfilter_inout_free( &output_ptr );
+    throw_error_code( err, "Could not parse filter graph" );
+  }
+
+  // Configure graph
+  throw_error_code(
+    avfilter_graph_config( graph.get(), NULL ),
+    "Could not configure filter graph" );
+}
+
 } // namespace <anonymous>
 
 // ----------------------------------------------------------------------------
@@ -231,6 +371,8 @@ class ffmpeg_video_input::priv
 
     kv::image_container_sptr convert_image();
     kv::metadata_vector const& convert_metadata();
+    bool apply_filter(
+      AVFilterContext* source_context, AVFilterContext* sink_context );
 
     open_video_state* parent;
     kv::logger_handle_t logger;
@@ -249,19 +391,37 @@ class ffmpeg_video_input::priv
   };
 
   struct open_video_state {
+    // Location of a keyframe in the video stream
+    struct keyframe_entry {
+      int64_t pts;
+      int64_t pos;
+    };
+
+    // Keyframes of the video, keyed by frame number
+    using keyframe_index_t = std::map< kv::frame_id_t, keyframe_entry >;
+
     open_video_state( priv& parent, std::string const& path );
     ~open_video_state();
 
     bool try_codec();
-    void init_filters();
+    void init_filters( AVPixelFormat pix_fmt, int width, int height );
+    void init_hardware_filters( AVFrame const& hw_frame );
+    std::string filter_source_args(
+      int pix_fmt, int width, int height ) const;
     bool advance();
     void seek( kv::frame_id_t frame_number );
+    void reposition( int64_t timestamp, int64_t pos, int flags );
+    keyframe_index_t const& keyframe_index();
+    void build_keyframe_index();
+    bool load_keyframe_index( std::string const& index_path );
+    void save_keyframe_index( std::string const& index_path ) const;
     void set_video_metadata( kv::metadata& md );
     AVRational curr_time() const;
     AVRational duration() const;
     AVRational frame_rate() const;
     size_t num_frames() const;
     kv::frame_id_t frame_number() const;
+    kv::frame_id_t frame_number( int64_t pts ) const;
     kv::timestamp timestamp() const;
     kv::video_settings_uptr implementation_settings() const;
 
@@ -279,12 +439,22 @@ class ffmpeg_video_input::priv
     filter_graph_uptr filter_graph;
     AVFilterContext* filter_sink_context;
     AVFilterContext* filter_source_context;
+    AVPixelFormat filter_pix_fmt;
+    int filter_width;
+    int filter_height;
+
+    filter_graph_uptr hardware_filter_graph;
+    AVFilterContext* hardware_filter_sink_context;
+    AVFilterContext* hardware_filter_source_context;
 
     sws_context_uptr image_conversion_context;
 
     int64_t start_ts;
     std::map< int64_t, klv::misp_timestamp > pts_to_misp_ts;
 
+    // Built on the first seek
+    kv::optional< keyframe_index_t > keyframes;
+
     std::list< ffmpeg_klv_stream > klv_streams;
     kv::metadata_map_sptr all_metadata;
 
@@ -293,6 +463,23 @@ class ffmpeg_video_input::priv
     bool at_eof;
   };
 
+  // A frame fully decoded and converted by the decode-ahead thread
+  struct prefetched_frame {
+    prefetched_frame();
+
+    // Marks the end of the decode-ahead thread's output
+    bool is_end;
+    // Set if the end was caused by an error while decoding
+    std::exception_ptr error;
+
+    bool is_valid;
+    kv::timestamp timestamp;
+    kv::image_container_sptr image;
+    kv::video_raw_image_sptr raw_image;
+    kv::metadata_vector metadata;
+    kv::video_raw_metadata_sptr raw_metadata;
+  };
+
   ffmpeg_video_input& parent;
   kv::logger_handle_t logger;
 
@@ -302,13 +489,26 @@ class ffmpeg_video_input::priv
   bool klv_enabled;
   bool use_misp_timestamps;
   bool smooth_klv_packets;
+  double klv_retention;
   std::string unknown_stream_behavior;
   std::string filter_description;
+  std::string hardware_filter_description;
+  bool keyframe_index_enabled;
+  std::string keyframe_index_directory;
   bool cuda_enabled;
   int cuda_device_index;
+  int decode_ahead;
 
   kv::optional< open_video_state > video;
 
+  // Only present while decoding ahead, in which case the decode-ahead thread
+  // owns video and the caller only sees current
+  std::unique_ptr< kv::bounded_buffer< prefetched_frame > > prefetch_buffer;
+  std::thread prefetch_thread;
+  std::atomic< bool > prefetch_stop;
+  bool prefetch_ended;
+  kv::optional< prefetched_frame > current;
+
   priv( ffmpeg_video_input& parent );
   ~priv();
 
@@ -317,6 +517,13 @@ class ffmpeg_video_input::priv
   bool is_valid() const;
   void open( std::string const& path );
   void close();
+  bool advance();
+  void seek( kv::frame_id_t frame_number );
+
+  void start_prefetch();
+  void stop_prefetch();
+  void prefetch_loop();
+  prefetched_frame capture_frame();
 
   void hardware_init();
   void cuda_init();
@@ -325,6 +532,8 @@ class ffmpeg_video_input::priv
 #ifdef KWIVER_ENABLE_FFMPEG_CUDA
   AVCUDADeviceContext* cuda_device() const;
 #endif
+
+  klv::klv_timeline_retention klv_retention_limits() const;
 };
 
 // ----------------------------------------------------------------------------
@@ -337,21 +546,33 @@ ::priv( ffmpeg_video_input& parent )
     klv_enabled{ true },
     use_misp_timestamps{ false },
     smooth_klv_packets{ false },
+    klv_retention{ 0.0 },
     unknown_stream_behavior{ "klv" },
     filter_description{ "yadif=deint=1" },
+    hardware_filter_description{},
+    keyframe_index_enabled{ true },
+    keyframe_index_directory{},
 #ifdef KWIVER_ENABLE_FFMPEG_CUDA
     cuda_enabled{ true },
 #else
     cuda_enabled{ false },
 #endif
     cuda_device_index{ 0 },
-    video{}
+    decode_ahead{ 0 },
+    video{},
+    prefetch_buffer{},
+    prefetch_thread{},
+    prefetch_stop{ false },
+    prefetch_ended{ false },
+    current{}
 {}
 
 // ----------------------------------------------------------------------------
 ffmpeg_video_input::priv
 ::~priv()
-{}
+{
+  stop_prefetch();
+}
 
 // ----------------------------------------------------------------------------
 bool
@@ -379,7 +600,17 @@ bool
 ffmpeg_video_input::priv
 ::is_valid() const
 {
-  return is_open() && video->frame;
+  if( !is_open() )
+  {
+    return false;
+  }
+
+  if( prefetch_buffer )
+  {
+    return current && current->is_valid;
+  }
+
+  return video->frame.has_value();
 }
 
 // ----------------------------------------------------------------------------
@@ -389,6 +620,11 @@ ::open( std::string const& path )
 {
   hardware_init();
   video.emplace( *this, path );
+
+  if( decode_ahead > 0 )
+  {
+    start_prefetch();
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -396,9 +632,169 @@ void
 ffmpeg_video_input::priv
 ::close()
 {
+  stop_prefetch();
   video.reset();
 }
 
+// ----------------------------------------------------------------------------
+bool
+ffmpeg_video_input::priv
+::advance()
+{
+  if( !prefetch_buffer )
+  {
+    return video->advance();
+  }
+
+  if( prefetch_ended )
+  {
+    current.reset();
+    return false;
+  }
+
+  auto next = prefetch_buffer->Receive();
+  if( next.is_end )
+  {
+    prefetch_ended = true;
+    current.reset();
+    if( next.error )
+    {
+      std::rethrow_exception( next.error );
+    }
+    return false;
+  }
+
+  current = std::move( next );
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_input::priv
+::seek( kv::frame_id_t frame_number )
+{
+  if( !prefetch_buffer )
+  {
+    video->seek( frame_number );
+    return;
+  }
+
+  // The decoder has to be ours again before it can be repositioned
+  stop_prefetch();
+  try
+  {
+    video->seek( frame_number );
+  }
+  catch( ... )
+  {
+    start_prefetch();
+    throw;
+  }
+  start_prefetch();
+}
+
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_input::priv
+::start_prefetch()
+{
+  // Whatever frame the decoder is on becomes the caller's current frame
+  if( video->frame )
+  {
+    current = capture_frame();
+  }
+  else
+  {
+    current.reset();
+  }
+
+  prefetch_buffer.reset(
+    new kv::bounded_buffer< prefetched_frame >( decode_ahead ) );
+  prefetch_stop = false;
+  prefetch_ended = false;
+  prefetch_thread = std::thread{ &priv::prefetch_loop, this };
+}
+
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_input::priv
+::stop_prefetch()
+{
+  if( !prefetch_buffer )
+  {
+    return;
+  }
+
+  // Drain the buffer so the thread is never left blocked on a full buffer;
+  // it always finishes by sending an end marker
+  prefetch_stop = true;
+  while( !prefetch_ended )
+  {
+    prefetch_ended = prefetch_buffer->Receive().is_end;
+  }
+
+  prefetch_thread.join();
+  prefetch_buffer.reset();
+  current.reset();
+}
+
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_input::priv
+::prefetch_loop()
+{
+  prefetched_frame end_marker;
+  end_marker.is_end = true;
+
+  try
+  {
+    while( !prefetch_stop && video->advance() )
+    {
+      prefetch_buffer->Send( capture_frame() );
+    }
+  }
+  catch( ... )
+  {
+    end_marker.error = std::current_exception();
+  }
+
+  prefetch_buffer->Send( end_marker );
+}
+
+// ----------------------------------------------------------------------------
+ffmpeg_video_input::priv::prefetched_frame
+ffmpeg_video_input::priv
+::capture_frame()
+{
+  prefetched_frame result;
+  if( !video->frame )
+  {
+    return result;
+  }
+
+  // Convert everything now, while the KLV state matches this frame
+  result.is_valid = true;
+  result.timestamp = video->timestamp();
+  result.image = video->frame->convert_image();
+  result.raw_image = video->frame->raw_image;
+  result.metadata = video->frame->convert_metadata();
+  result.raw_metadata = video->frame->raw_metadata;
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+ffmpeg_video_input::priv::prefetched_frame
+::prefetched_frame()
+  : is_end{ false },
+    error{},
+    is_valid{ false },
+    timestamp{},
+    image{},
+    raw_image{},
+    metadata{},
+    raw_metadata{}
+{}
+
 // ----------------------------------------------------------------------------
 void
 ffmpeg_video_input::priv
@@ -445,6 +841,20 @@ ::hardware_device() const
     hardware_device_context->data );
 }
 
+// ----------------------------------------------------------------------------
+klv::klv_timeline_retention
+ffmpeg_video_input::priv
+::klv_retention_limits() const
+{
+  klv::klv_timeline_retention result;
+  result.max_duration =
+    ( klv_retention > 0.0 )
+    ? static_cast< uint64_t >( klv_retention * 1000000.0 + 0.5 )
+    : 0;
+  result.max_entries = 0;
+  return result;
+}
+
 // ----------------------------------------------------------------------------
 #ifdef KWIVER_ENABLE_FFMPEG_CUDA
 AVCUDADeviceContext*
@@ -505,12 +915,33 @@ ::convert_image()
     return image;
   }
 
+  // Run the frame through the filter graph on the hardware device, so that
+  // e.g. resizing happens before the frame is downloaded
+  if( frame->hw_frames_ctx &&
+      !is_blank( parent->parent->hardware_filter_description ) )
+  {
+    if( !parent->hardware_filter_graph )
+    {
+      parent->init_hardware_filters( *frame );
+    }
+
+    if( !apply_filter(
+          parent->hardware_filter_source_context,
+          parent->hardware_filter_sink_context ) )
+    {
+      return nullptr;
+    }
+  }
+
   // Transfer frame data from hardware device
   if( frame->hw_frames_ctx )
   {
     throw_error_code(
       av_hwframe_transfer_data( processed_frame.get(), frame.get(), 0 ),
       "Could not read frame data from hardware device" );
+    throw_error_code(
+      av_frame_copy_props( processed_frame.get(), frame.get() ),
+      "Could not copy frame properties from hardware frame" );
     av_frame_unref( frame.get() );
     av_frame_move_ref( frame.get(), processed_frame.get() );
   }
@@ -518,33 +949,21 @@ ::convert_image()
   // Run the frame through the filter graph
   if( parent->filter_source_context && parent->filter_sink_context )
   {
-    int recv_err;
-    do{
-      throw_error_code(
-        av_buffersrc_add_frame_flags(
-          parent->filter_source_context, frame.get(),
-          AV_BUFFERSRC_FLAG_KEEP_REF ),
-        "Could not feed frame to filter graph" );
-
-      av_frame_unref( processed_frame.get() );
-      recv_err =
-        av_buffersink_get_frame(
-          parent->filter_sink_context, processed_frame.get() );
+    // The hardware filters may have changed the frame's format or size
+    if( frame->format != parent->filter_pix_fmt ||
+        frame->width != parent->filter_width ||
+        frame->height != parent->filter_height )
+    {
+      parent->init_filters(
+        static_cast< AVPixelFormat >( frame->format ),
+        frame->width, frame->height );
+    }
 
-      if( recv_err == AVERROR_EOF )
-      {
-        return nullptr;
-      }
-      if( recv_err == AVERROR( EAGAIN ) )
-      {
-        continue;
-      }
-      throw_error_code( recv_err, "Could not read frame from filter graph" );
-    } while(
-      recv_err == AVERROR( EAGAIN ) ||
-      processed_frame->best_effort_timestamp != frame->best_effort_timestamp );
-    av_frame_unref( frame.get() );
-    av_frame_move_ref( frame.get(), processed_frame.get() );
+    if( !apply_filter(
+          parent->filter_source_context, parent->filter_sink_context ) )
+    {
+      return nullptr;
+    }
   }
 
   // Determine pixel formats
@@ -553,16 +972,17 @@ ::convert_image()
   auto const dst_pix_fmt = AV_PIX_FMT_RGB24;
   size_t const depth = 3;
 
-  // Determine image dimensions
-  auto const params = parent->video_stream->codecpar;
-  auto const width = static_cast< size_t >( params->width );
-  auto const height = static_cast< size_t >( params->height );
+  // Determine image dimensions; filters may have resized the frame
+  auto const width = static_cast< size_t >( frame->width );
+  auto const height = static_cast< size_t >( frame->height );
   auto const image_size = width * height * depth;
 
   // Allocate enough space for the output image
-  if( !image_memory || image_memory->size() < image_size )
+  // Memory still referenced by an earlier image must not be overwritten
+  if( !image_memory || image_memory.use_count() > 1 ||
+      image_memory->size() < image_size )
   {
-    image_memory = std::make_shared< kv::image_memory >( image_size );
+    image_memory = kv::image_memory_pool::instance().acquire( image_size );
   }
 
   // Get image converter
@@ -601,6 +1021,39 @@ ::convert_image()
       depth, depth * width, 1 ) );
 }
 
+// ----------------------------------------------------------------------------
+bool
+ffmpeg_video_input::priv::frame_state
+::apply_filter(
+  AVFilterContext* source_context, AVFilterContext* sink_context )
+{
+  int recv_err;
+  do{
+    throw_error_code(
+      av_buffersrc_add_frame_flags(
+        source_context, frame.get(), AV_BUFFERSRC_FLAG_KEEP_REF ),
+      "Could not feed frame to filter graph" );
+
+    av_frame_unref( processed_frame.get() );
+    recv_err = av_buffersink_get_frame( sink_context, processed_frame.get() );
+
+    if( recv_err == AVERROR_EOF )
+    {
+      return false;
+    }
+    if( recv_err == AVERROR( EAGAIN ) )
+    {
+      continue;
+    }
+    throw_error_code( recv_err, "Could not read frame from filter graph" );
+  } while(
+    recv_err == AVERROR( EAGAIN ) ||
+    processed_frame->best_effort_timestamp != frame->best_effort_timestamp );
+  av_frame_unref( frame.get() );
+  av_frame_move_ref( frame.get(), processed_frame.get() );
+  return true;
+}
+
 // ----------------------------------------------------------------------------
 kv::metadata_vector const&
 ffmpeg_video_input::priv::frame_state
@@ -668,9 +1121,16 @@ ::open_video_state( priv& parent, std::string const& path )
     filter_graph{ nullptr },
     filter_sink_context{ nullptr },
     filter_source_context{ nullptr },
+    filter_pix_fmt{ AV_PIX_FMT_NONE },
+    filter_width{ 0 },
+    filter_height{ 0 },
+    hardware_filter_graph{ nullptr },
+    hardware_filter_sink_context{ nullptr },
+    hardware_filter_source_context{ nullptr },
     image_conversion_context{ nullptr },
     start_ts{ 0 },
     pts_to_misp_ts{},
+    keyframes{},
     klv_streams{},
     all_metadata{ nullptr },
     frame{},
@@ -720,6 +1180,7 @@ ::open_video_state( priv& parent, std::string const& path )
              params->codec_id == AV_CODEC_ID_SMPTE_KLV )
     {
       klv_streams.emplace_back( stream );
+      klv_streams.back().demuxer.set_retention( parent.klv_retention_limits() );
     }
     else if( parent.klv_enabled &&
              params->codec_id == AV_CODEC_ID_NONE )
@@ -731,6 +1192,8 @@ ::open_video_state( priv& parent, std::string const& path )
         LOG_INFO( logger,
           "Treating unknown stream " << stream->index << " as KLV" );
         klv_streams.emplace_back( stream );
+        klv_streams.back().demuxer.set_retention(
+          parent.klv_retention_limits() );
       }
       else
       {
@@ -818,6 +1281,31 @@ ::open_video_state( priv& parent, std::string const& path )
     LOG_INFO(
       logger, "Successfully loaded codec: " << pretty_codec_name( codec ) );
   }
+  else
+  {
+    // Without a decoder, time starts at the first video packet
+    packet_uptr tmp_packet{
+      throw_error_null(
+        av_packet_alloc(), "Could not allocate packet memory" ) };
+    while( av_read_frame( format_context.get(), tmp_packet.get() ) >= 0 )
+    {
+      auto const is_video = tmp_packet->stream_index == video_stream->index;
+      if( is_video )
+      {
+        start_ts = packet_timestamp( *tmp_packet );
+      }
+      av_packet_unref( tmp_packet.get() );
+      if( is_video )
+      {
+        break;
+      }
+    }
+
+    throw_error_code(
+      av_seek_frame(
+        format_context.get(), video_stream->index, 0, AVSEEK_FLAG_FRAME ),
+      "Could not seek to beginning of video" );
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -865,7 +1353,11 @@ ::try_codec()
   }
 
   // Initialize filter graph
-  init_filters();
+  init_filters(
+    codec_context->hw_device_ctx
+    ? codec_context->sw_pix_fmt
+    : codec_context->pix_fmt,
+    codec_context->width, codec_context->height );
 
   // Start time taken from the first decodable frame
   throw_error_code(
@@ -922,86 +1414,49 @@ ::try_codec()
 // ----------------------------------------------------------------------------
 void
 ffmpeg_video_input::priv::open_video_state
-::init_filters()
+::init_filters( AVPixelFormat pix_fmt, int width, int height )
 {
   // Check for empty filter string
-  if( std::all_of(
-    parent->filter_description.begin(),
-    parent->filter_description.end(), isspace ) )
+  if( is_blank( parent->filter_description ) )
   {
     return;
   }
 
-  // Allocate filter graph
-  filter_graph.reset(
-    throw_error_null(
-      avfilter_graph_alloc(), "Could not allocate filter graph" ) );
-
-  // Create the input buffer
-  {
-    auto const pix_fmt =
-      codec_context->hw_device_ctx
-      ? codec_context->sw_pix_fmt
-      : codec_context->pix_fmt;
-    std::stringstream ss;
-    ss << "video_size=" << codec_context->width << "x"
-                        << codec_context->height
-      << ":pix_fmt=" << pix_fmt
-      << ":time_base=" << video_stream->time_base.num << "/"
-                       << video_stream->time_base.den
-      << ":pixel_aspect=" << codec_context->sample_aspect_ratio.num << "/"
-                          << codec_context->sample_aspect_ratio.den;
-    throw_error_code(
-      avfilter_graph_create_filter(
-        &filter_source_context, avfilter_get_by_name( "buffer" ),
-        "in", ss.str().c_str(), NULL, filter_graph.get() ),
-      "Could not create buffer source" );
-  }
-
-  // Create the output buffer
-  throw_error_code(
-    avfilter_graph_create_filter(
-      &filter_sink_context, avfilter_get_by_name( "buffersink" ),
-      "out", NULL, NULL, filter_graph.get() ),
-    "Could not create buffer sink" );
-
-  // Create the input node
-  filter_in_out_uptr output{
-    throw_error_null(
-      avfilter_inout_alloc(),
-      "Could not allocate filter output" ) };
-  output->name = av_strdup( "in" );
-  output->filter_ctx = filter_source_context;
-  output->pad_idx = 0;
-  output->next = NULL;
+  create_filter_graph(
+    parent->filter_description,
+    filter_source_args( pix_fmt, width, height ), nullptr,
+    filter_graph, filter_source_context, filter_sink_context );
 
-  // Create the output node
-  filter_in_out_uptr input{
-    throw_error_null(
-      avfilter_inout_alloc(),
-      "Could not allocate filter input" ) };
-  input->name = av_strdup( "out" );
-  input->filter_ctx = filter_sink_context;
-  input->pad_idx = 0;
-  input->next = NULL;
+  filter_pix_fmt = pix_fmt;
+  filter_width = width;
+  filter_height = height;
+}
 
-  // Parse graph
-  {
-    auto input_ptr = input.release();
-    auto output_ptr = output.release();
-    auto const err =
-      avfilter_graph_parse_ptr(
-        filter_graph.get(), parent->filter_description.c_str(),
-        &input_ptr, &output_ptr, NULL );
-    avfilter_inout_free( &input_ptr );
-    avfilter_inout_free( &output_ptr );
-    throw_error_code( err, "Could not parse filter graph" );
-  }
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_input::priv::open_video_state
+::init_hardware_filters( AVFrame const& hw_frame )
+{
+  create_filter_graph(
+    parent->hardware_filter_description,
+    filter_source_args( hw_frame.format, hw_frame.width, hw_frame.height ),
+    hw_frame.hw_frames_ctx, hardware_filter_graph,
+    hardware_filter_source_context, hardware_filter_sink_context );
+}
 
-  // Configure graph
-  throw_error_code(
-    avfilter_graph_config( filter_graph.get(), NULL ),
-    "Could not configure filter graph" );
+// ----------------------------------------------------------------------------
+std::string
+ffmpeg_video_input::priv::open_video_state
+::filter_source_args( int pix_fmt, int width, int height ) const
+{
+  std::stringstream ss;
+  ss << "video_size=" << width << "x" << height
+    << ":pix_fmt=" << pix_fmt
+    << ":time_base=" << video_stream->time_base.num << "/"
+                     << video_stream->time_base.den
+    << ":pixel_aspect=" << codec_context->sample_aspect_ratio.num << "/"
+                        << codec_context->sample_aspect_ratio.den;
+  return ss.str();
 }
 
 // ----------------------------------------------------------------------------
@@ -1028,6 +1483,7 @@ ::advance()
     throw_error_null( av_packet_alloc(), "Could not allocate packet" ) };
   while( !at_eof && !frame.has_value() )
   {
+    auto packet_is_frame = false;
     if( !new_frame.is_draining )
     {
       // Read next packet
@@ -1053,17 +1509,12 @@ ::advance()
         throw_error_code( read_err, "Could not read next packet from file" );
 
         // Video packet
-        if( parent->imagery_enabled &&
-            packet->stream_index == video_stream->index )
+        if( packet->stream_index == video_stream->index )
         {
-          // Record packet as raw image
-          new_frame.raw_image->packets.emplace_back(
-            throw_error_null(
-              av_packet_alloc(), "Could not allocate packet" ) );
-          throw_error_code(
-            av_packet_ref(
-              new_frame.raw_image->packets.back().get(), packet.get() ),
-            "Could not give packet to raw image cache" );
+          // Without a decoder, each packet stands in for a frame, in decode
+          // order so that frame numbers increase
+          auto const frame_pts =
+            parent->imagery_enabled ? packet->pts : packet_timestamp( *packet );
 
           // Find MISP timestamp
           for( auto const tag_type : { klv::MISP_TIMESTAMP_TAG_STRING,
@@ -1075,17 +1526,39 @@ ::advance()
             if( it != packet->data + packet->size )
             {
               auto const timestamp = klv::read_misp_timestamp( it );
-              pts_to_misp_ts.emplace( packet->pts, timestamp );
+              pts_to_misp_ts.emplace( frame_pts, timestamp );
               break;
             }
           }
 
-          // Send packet to decoder
-          auto const send_err =
-            avcodec_send_packet( codec_context.get(), packet.get() );
-          if( send_err != AVERROR_INVALIDDATA )
+          if( parent->imagery_enabled )
+          {
+            // Record packet as raw image
+            new_frame.raw_image->packets.emplace_back(
+              throw_error_null(
+                av_packet_alloc(), "Could not allocate packet" ) );
+            throw_error_code(
+              av_packet_ref(
+                new_frame.raw_image->packets.back().get(), packet.get() ),
+              "Could not give packet to raw image cache" );
+
+            // Send packet to decoder
+            auto const send_err =
+              avcodec_send_packet( codec_context.get(), packet.get() );
+            if( send_err != AVERROR_INVALIDDATA )
+            {
+              throw_error_code( send_err, "Decoder rejected packet" );
+            }
+          }
+          else
           {
-            throw_error_code( send_err, "Decoder rejected packet" );
+            // Fill in what the frame would have told us
+            auto const params = video_stream->codecpar;
+            new_frame.frame->best_effort_timestamp = frame_pts;
+            new_frame.frame->key_frame = !!( packet->flags & AV_PKT_FLAG_KEY );
+            new_frame.frame->width = params->width;
+            new_frame.frame->height = params->height;
+            packet_is_frame = true;
           }
         }
 
@@ -1113,7 +1586,11 @@ ::advance()
       }
     }
 
-    if( parent->imagery_enabled )
+    if( packet_is_frame )
+    {
+      frame = std::move( new_frame );
+    }
+    else if( parent->imagery_enabled )
     {
       // Receive decoded frame
       auto const recv_err =
@@ -1140,6 +1617,19 @@ ::advance()
     }
   }
 
+  // A raw image can start a copied video if it begins with a keyframe packet
+  // which the decoder returned at once, so no other packet this frame or any
+  // later frame depends on was sent before it
+  if( frame.has_value() && parent->imagery_enabled )
+  {
+    auto& raw_image = *frame->raw_image;
+    raw_image.time_base = video_stream->time_base;
+    raw_image.is_keyframe =
+      !raw_image.packets.empty() &&
+      ( raw_image.packets.front()->flags & AV_PKT_FLAG_KEY ) &&
+      raw_image.packets.front()->pts == frame->frame->best_effort_timestamp;
+  }
+
   // Advance KLV
   for( auto& stream : klv_streams )
   {
@@ -1156,7 +1646,7 @@ ::advance()
     stream.advance( backup_timestamp, max_pts );
   }
 
-  return !parent->imagery_enabled || frame.has_value();
+  return frame.has_value();
 }
 
 // ----------------------------------------------------------------------------
@@ -1169,6 +1659,70 @@ ::seek( kv::frame_id_t frame_number )
     return;
   }
 
+  auto const& index = keyframe_index();
+  auto next_keyframe = index.upper_bound( frame_number );
+  auto tried_estimate = false;
+  auto from_start = false;
+  while( true )
+  {
+    if( next_keyframe != index.begin() )
+    {
+      // Jump to the nearest prior keyframe not yet ruled out
+      --next_keyframe;
+      reposition(
+        next_keyframe->second.pts, next_keyframe->second.pos,
+        AVSEEK_FLAG_BACKWARD );
+    }
+    else if( index.empty() && !tried_estimate )
+    {
+      // No index; let the demuxer find a keyframe near the expected timestamp
+      tried_estimate = true;
+      reposition(
+        start_ts + av_rescale_q(
+          frame_number, av_inv_q( frame_rate() ), video_stream->time_base ),
+        -1, AVSEEK_FLAG_BACKWARD );
+    }
+    else
+    {
+      from_start = true;
+      reposition( 0, -1, AVSEEK_FLAG_FRAME );
+    }
+
+    // Decode only the frames between the keyframe and the target
+    do
+    {
+      advance();
+      if( at_eof )
+      {
+        throw_error(
+          "Could not seek to frame ", frame_number, ": End of file reached" );
+      }
+    } while( this->frame_number() < frame_number );
+
+    if( this->frame_number() == frame_number )
+    {
+      return;
+    }
+
+    if( from_start )
+    {
+      throw_error(
+        "Could not seek to frame ", frame_number,
+        ": Could not acquire image" );
+    }
+
+    // The demuxer landed past the target; try again from further back
+    LOG_DEBUG(
+      logger, "Seek to frame " << frame_number << " overshot to frame "
+      << this->frame_number() << "; retrying from an earlier position" );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_input::priv::open_video_state
+::reposition( int64_t timestamp, int64_t pos, int flags )
+{
   // Clear current state
   at_eof = false;
   frame.reset();
@@ -1177,37 +1731,180 @@ ::seek( kv::frame_id_t frame_number )
     stream.reset();
   }
 
-  // Seek to desired frame
-  auto converted_timestamp =
-    av_make_q( static_cast< int >( frame_number ), 1 );
-  converted_timestamp =
-    av_div_q( converted_timestamp, video_stream->time_base );
-  converted_timestamp = av_div_q( converted_timestamp, frame_rate() );
+  // Byte offsets are more reliable than timestamps in formats such as
+  // MPEG-TS, where timestamp seeking is only a bisection estimate
+  auto const format_flags = format_context->iformat->flags;
+  if( pos >= 0 &&
+      ( format_flags & AVFMT_TS_DISCONT ) &&
+      !( format_flags & AVFMT_NO_BYTE_SEEK ) )
+  {
+    throw_error_code(
+      av_seek_frame(
+        format_context.get(), video_stream->index, pos, AVSEEK_FLAG_BYTE ),
+      "Could not seek to byte position ", pos );
+  }
+  else
+  {
+    throw_error_code(
+      av_seek_frame(
+        format_context.get(), video_stream->index, timestamp, flags ),
+      "Could not seek to timestamp ", timestamp );
+  }
 
-  throw_error_code(
-    av_seek_frame(
-      format_context.get(), video_stream->index, converted_timestamp.num,
-      AVSEEK_FLAG_BACKWARD ),
-    "Could not seek to frame ", frame_number );
   if( codec_context )
   {
     avcodec_flush_buffers( codec_context.get() );
   }
+}
+
+// ----------------------------------------------------------------------------
+ffmpeg_video_input::priv::open_video_state::keyframe_index_t const&
+ffmpeg_video_input::priv::open_video_state
+::keyframe_index()
+{
+  if( keyframes )
+  {
+    return *keyframes;
+  }
 
-  do
+  keyframes.emplace();
+  if( !parent->keyframe_index_enabled )
   {
-    advance();
-    if( at_eof )
+    return *keyframes;
+  }
+
+  // Index files are named after the video contents, so they remain valid
+  // when the video is moved or renamed
+  std::string index_path;
+  if( !parent->keyframe_index_directory.empty() )
+  {
+    auto const md5 = kv::file_md5( path );
+    if( md5.empty() )
     {
-      throw_error(
-        "Could not seek to frame ", frame_number, ": End of file reached" );
+      LOG_WARN(
+        logger, "Could not compute MD5 of " << path
+        << "; keyframe index will not be cached" );
+    }
+    else
+    {
+      index_path =
+        parent->keyframe_index_directory + "/" + md5 + ".keyframes";
+    }
+  }
+
+  if( index_path.empty() || !load_keyframe_index( index_path ) )
+  {
+    build_keyframe_index();
+    if( !index_path.empty() )
+    {
+      save_keyframe_index( index_path );
+    }
+  }
+
+  LOG_DEBUG(
+    logger, "Keyframe index contains " << keyframes->size() << " keyframes" );
+  return *keyframes;
+}
+
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_input::priv::open_video_state
+::build_keyframe_index()
+{
+  LOG_INFO( logger, "Building keyframe index for " << path );
+
+  // Scan with a separate demuxer so the current read position is untouched
+  format_context_uptr scan_context;
+  try
+  {
+    AVFormatContext* ptr = nullptr;
+    throw_error_code(
+      avformat_open_input( &ptr, path.c_str(), NULL, NULL ),
+      "Could not open input stream" );
+    scan_context.reset( ptr );
+
+    throw_error_code(
+      avformat_find_stream_info( scan_context.get(), NULL ),
+      "Could not read stream information" );
+  }
+  catch( std::exception const& e )
+  {
+    LOG_WARN( logger, "Could not build keyframe index: " << e.what() );
+    return;
+  }
+
+  // Only packet headers are needed; nothing is decoded
+  packet_uptr packet{
+    throw_error_null( av_packet_alloc(), "Could not allocate packet memory" ) };
+  while( av_read_frame( scan_context.get(), packet.get() ) >= 0 )
+  {
+    if( packet->stream_index == video_stream->index &&
+        ( packet->flags & AV_PKT_FLAG_KEY ) &&
+        packet->pts != AV_NOPTS_VALUE )
+    {
+      keyframes->emplace(
+        frame_number( packet->pts ),
+        keyframe_entry{ packet->pts, packet->pos } );
     }
-  } while( this->frame_number() < frame_number );
+    av_packet_unref( packet.get() );
+  }
+}
+
+// ----------------------------------------------------------------------------
+bool
+ffmpeg_video_input::priv::open_video_state
+::load_keyframe_index( std::string const& index_path )
+{
+  std::ifstream file{ index_path };
+  if( !file )
+  {
+    return false;
+  }
+
+  std::string header;
+  if( !std::getline( file, header ) || header != keyframe_index_header )
+  {
+    LOG_WARN( logger, "Ignoring unrecognized keyframe index " << index_path );
+    return false;
+  }
+
+  // Frame numbers depend on the start timestamp chosen by the codec, so only
+  // the stream positions are stored
+  keyframe_index_t result;
+  keyframe_entry entry;
+  while( file >> entry.pts >> entry.pos )
+  {
+    result.emplace( frame_number( entry.pts ), entry );
+  }
+
+  if( !file.eof() )
+  {
+    LOG_WARN( logger, "Ignoring corrupt keyframe index " << index_path );
+    return false;
+  }
+
+  LOG_DEBUG( logger, "Loaded keyframe index " << index_path );
+  keyframes = std::move( result );
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_input::priv::open_video_state
+::save_keyframe_index( std::string const& index_path ) const
+{
+  kwiversys::SystemTools::MakeDirectory( parent->keyframe_index_directory );
+
+  std::ofstream file{ index_path };
+  file << keyframe_index_header << "\n";
+  for( auto const& entry : *keyframes )
+  {
+    file << entry.second.pts << " " << entry.second.pos << "\n";
+  }
 
-  if( this->frame_number() > frame_number )
+  if( !file )
   {
-    throw_error(
-      "Could not seek to frame ", frame_number, ": Could not acquire image" );
+    LOG_WARN( logger, "Could not write keyframe index " << index_path );
   }
 }
 
@@ -1235,9 +1932,12 @@ ::set_video_metadata( kv::metadata& md )
     md.add< kv::VITAL_META_VIDEO_FRAME_RATE >( av_q2d( frame_rate() ) );
   }
 
+  // Without imagery there is no decoder; fall back to the stream parameters
+  auto const params = video_stream->codecpar;
+
   // Add bitrate
-  auto bitrate = codec_context->bit_rate;
-  if( !bitrate )
+  auto bitrate = codec_context ? codec_context->bit_rate : params->bit_rate;
+  if( !bitrate && codec_context )
   {
     bitrate = codec_context->bit_rate_tolerance;
   }
@@ -1284,15 +1984,19 @@ ::set_video_metadata( kv::metadata& md )
   std::string compression_type;
   std::string compression_profile;
   std::string compression_level;
-  switch( codec_context->codec_id )
+  auto const codec_id =
+    codec_context ? codec_context->codec_id : params->codec_id;
+  auto const profile = codec_context ? codec_context->profile : params->profile;
+  auto const level = codec_context ? codec_context->level : params->level;
+  switch( codec_id )
   {
     case AV_CODEC_ID_MPEG2VIDEO:
     {
       compression_type = "H.262";
-      auto const profile_it = h262_profiles.find( codec_context->profile );
+      auto const profile_it = h262_profiles.find( profile );
       compression_profile =
         ( profile_it == h262_profiles.end() ) ? "Other" : profile_it->second;
-      auto const level_it = h262_levels.find( codec_context->level );
+      auto const level_it = h262_levels.find( level );
       compression_level =
         ( level_it == h262_levels.end() ) ? "Other" : level_it->second;
       break;
@@ -1300,22 +2004,22 @@ ::set_video_metadata( kv::metadata& md )
     case AV_CODEC_ID_H264:
     {
       compression_type = "H.264";
-      auto const profile_it = h264_profiles.find( codec_context->profile );
+      auto const profile_it = h264_profiles.find( profile );
       compression_profile =
         ( profile_it == h264_profiles.end() ) ? "Other" : profile_it->second;
       std::stringstream ss;
-      ss << std::setprecision( 2 ) << ( codec_context->level / 10.0 );
+      ss << std::setprecision( 2 ) << ( level / 10.0 );
       compression_level = ss.str();
       break;
     }
     case AV_CODEC_ID_H265:
     {
       compression_type = "H.265";
-      auto const profile_it = h265_profiles.find( codec_context->profile );
+      auto const profile_it = h265_profiles.find( profile );
       compression_profile =
         ( profile_it == h265_profiles.end() ) ? "Other" : profile_it->second;
       std::stringstream ss;
-      ss << std::setprecision( 2 ) << ( codec_context->level / 30.0 );
+      ss << std::setprecision( 2 ) << ( level / 30.0 );
       compression_level = ss.str();
       break;
     }
@@ -1399,8 +2103,18 @@ ::frame_number() const
     return -1;
   }
 
+  return frame_number( frame->frame->best_effort_timestamp );
+}
+
+// ----------------------------------------------------------------------------
+kv::frame_id_t
+ffmpeg_video_input::priv::open_video_state
+::frame_number( int64_t pts ) const
+{
+  auto const time =
+    av_mul_q( av_make_q( pts - start_ts, 1 ), video_stream->time_base );
   return static_cast< kv::frame_id_t >(
-    av_q2d( av_mul_q( curr_time(), frame_rate() ) ) + 0.5 );
+    av_q2d( av_mul_q( time, frame_rate() ) ) + 0.5 );
 }
 
 // ----------------------------------------------------------------------------
@@ -1488,10 +2202,21 @@ ::get_configuration() const
     "deinterlacing only to frames which are interlaced.  "
     "See details at https://ffmpeg.org/ffmpeg-filters.html" );
 
+  config->set_value(
+    "hardware_filter_desc", d->hardware_filter_description,
+    "A string describing a libavfilter pipeline to apply to hardware-decoded "
+    "frames while they are still on the device, before they are downloaded "
+    "and converted to RGB on the CPU. For example, \"scale_cuda=1920:1080\" "
+    "resizes frames on the GPU, which greatly reduces the cost of the "
+    "download and conversion for high resolution video. Ignored when frames "
+    "are decoded in software. Empty by default." );
+
   config->set_value(
     "imagery_enabled", d->imagery_enabled,
     "When set to false, will not attempt to process any imagery found in the "
-    "video file. This may be useful if only processing metadata."
+    "video file. Video packets are then demuxed but never decoded, each one "
+    "standing in for a frame, so frames are reported in decode order with "
+    "metadata but no image. This is much faster if only processing metadata."
   );
 
   config->set_value(
@@ -1515,11 +2240,39 @@ ::get_configuration() const
     "standard for each frame with the current value of every existing tag. "
     "Otherwise, will report packets as they appear in the source video." );
 
+  config->set_value(
+    "klv_retention", d->klv_retention,
+    "Number of seconds of KLV history to keep in memory. Values which ended "
+    "longer ago than this are discarded, which bounds memory use when reading "
+    "long or live streams. Set to 0 to keep all history (default)." );
+
   config->set_value(
     "unknown_stream_behavior", d->unknown_stream_behavior,
     "Set to 'klv' to treat unknown streams as KLV. "
     "Set to 'ignore' to ignore unknown streams (default)." );
 
+  config->set_value(
+    "keyframe_index_enabled", d->keyframe_index_enabled,
+    "When set to true, the first seek scans the packets of the video to "
+    "build an index of its keyframes. Later seeks then jump directly to the "
+    "nearest keyframe before the requested frame and decode only the frames "
+    "in between. When set to false, the demuxer's own (often inexact) "
+    "timestamp seeking is used instead." );
+
+  config->set_value(
+    "keyframe_index_directory", d->keyframe_index_directory,
+    "Directory in which to cache keyframe indices between runs, one file per "
+    "video named by the MD5 of its contents. Computing the MD5 requires "
+    "reading the whole file, but is much cheaper than rebuilding the index. "
+    "Indices are not cached if empty (default)." );
+
+  config->set_value(
+    "decode_ahead", d->decode_ahead,
+    "Number of frames to demux, decode and convert ahead of the caller in a "
+    "background thread, so that decoding overlaps with the processing of "
+    "earlier frames. Each buffered frame holds a full RGB image. Set to 0 "
+    "(default) to decode synchronously in next_frame()." );
+
   config->set_value(
     "cuda_enabled", d->cuda_enabled,
     "When set to true, uses CUDA/CUVID to accelerate video decoding." );
@@ -1557,6 +2310,10 @@ ::set_configuration( kv::config_block_sptr in_config )
     config->get_value< std::string >(
       "filter_desc", d->filter_description );
 
+  d->hardware_filter_description =
+    config->get_value< std::string >(
+      "hardware_filter_desc", d->hardware_filter_description );
+
   d->imagery_enabled =
     config->get_value< bool >( "imagery_enabled", d->imagery_enabled );
 
@@ -1571,10 +2328,21 @@ ::set_configuration( kv::config_block_sptr in_config )
     config->get_value< bool >(
       "smooth_klv_packets", d->smooth_klv_packets );
 
+  d->klv_retention =
+    config->get_value< double >( "klv_retention", d->klv_retention );
+
   d->unknown_stream_behavior =
     config->get_value< std::string >(
       "unknown_stream_behavior", d->unknown_stream_behavior );
 
+  d->keyframe_index_enabled =
+    config->get_value< bool >(
+      "keyframe_index_enabled", d->keyframe_index_enabled );
+
+  d->keyframe_index_directory =
+    config->get_value< std::string >(
+      "keyframe_index_directory", d->keyframe_index_directory );
+
   d->cuda_enabled =
     config->get_value< bool >(
       "cuda_enabled", d->cuda_enabled );
@@ -1589,6 +2357,9 @@ ::set_configuration( kv::config_block_sptr in_config )
   d->cuda_device_index =
     config->get_value< int >(
       "cuda_device_index", d->cuda_device_index );
+
+  d->decode_ahead =
+    std::max( config->get_value< int >( "decode_ahead", d->decode_ahead ), 0 );
 }
 
 // ----------------------------------------------------------------------------
@@ -1643,9 +2414,11 @@ ffmpeg_video_input
 ::next_frame( kv::timestamp& ts,
               VITAL_UNUSED uint32_t timeout )
 {
+  KWIVER_TRACE_SCOPE( "ffmpeg_video_input::next_frame" );
+
   d->assert_open( "next_frame()" );
 
-  if( d->video->advance() )
+  if( d->advance() )
   {
     ts = frame_timestamp();
     return true;
@@ -1678,7 +2451,7 @@ ::seek_frame( kv::timestamp& ts,
 
   try
   {
-    d->video->seek( frame_number - 1 );
+    d->seek( frame_number - 1 );
     ts = frame_timestamp();
     return true;
   }
@@ -1699,6 +2472,12 @@ ::frame_image()
     return nullptr;
   }
 
+  if( d->prefetch_buffer )
+  {
+    return d->current->image;
+  }
+
+  KWIVER_TRACE_SCOPE( "ffmpeg_video_input::convert_image" );
   return d->video->frame->convert_image();
 }
 
@@ -1712,6 +2491,11 @@ ::raw_frame_image()
     return nullptr;
   }
 
+  if( d->prefetch_buffer )
+  {
+    return d->current->raw_image;
+  }
+
   return d->video->frame->raw_image;
 }
 
@@ -1725,6 +2509,11 @@ ::frame_timestamp() const
     return {};
   }
 
+  if( d->prefetch_buffer )
+  {
+    return d->current->timestamp;
+  }
+
   return d->video->timestamp();
 }
 
@@ -1738,6 +2527,11 @@ ::frame_metadata()
     return {};
   }
 
+  if( d->prefetch_buffer )
+  {
+    return d->current->metadata;
+  }
+
   return d->video->frame->convert_metadata();
 }
 
@@ -1751,6 +2545,11 @@ ::raw_frame_metadata()
     return nullptr;
   }
 
+  if( d->prefetch_buffer )
+  {
+    return d->current->raw_metadata;
+  }
+
   return d->video->frame->raw_metadata;
 }
 
@@ -1784,6 +2583,11 @@ bool
 ffmpeg_video_input
 ::end_of_video() const
 {
+  if( d->is_open() && d->prefetch_buffer )
+  {
+    return d->prefetch_ended;
+  }
+
   return !d->is_open() || d->video->at_eof;
 }
 
@@ -11,15 +11,26 @@
 #include "arrows/ffmpeg/ffmpeg_video_raw_image.h"
 #include "arrows/ffmpeg/ffmpeg_video_settings.h"
 
+#include <arrows/klv/klv_frame_encoder.h>
+#include <arrows/klv/klv_metadata.h>
+
 #include <vital/optional.h>
+#include <vital/util/bounded_buffer.h>
 
 extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavformat/avformat.h>
+#include <libavutil/hwcontext.h>
 #include <libavutil/imgutils.h>
 #include <libswscale/swscale.h>
 }
 
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <thread>
+
 namespace kv = kwiver::vital;
 
 namespace kwiver {
@@ -46,14 +57,18 @@ class ffmpeg_video_output::impl
     operator=( open_video_state&& ) = default;
 
     bool try_codec( ffmpeg_video_settings const& settings );
+    bool init_cuda_upload();
 
     void add_image(
       kv::image_container_sptr const& image, kv::timestamp const& ts );
     void add_image( vital::video_raw_image const& image );
+    void add_metadata( kv::metadata const& md );
 
     bool write_next_packet();
     void write_remaining_packets();
+    void write_ready_klv( bool flush );
 
+    int64_t video_pts( size_t frame_number ) const;
     int64_t next_video_pts() const;
 
     impl* parent;
@@ -66,14 +81,25 @@ class ffmpeg_video_output::impl
     codec_context_uptr codec_context;
     AVCodec const* codec;
     sws_context_uptr image_conversion_context;
+    std::unique_ptr< klv::klv_frame_encoder > klv_encoder;
+    kv::optional< int64_t > raw_ts_offset;
   };
 
+  // An empty task marks the end of the queue
+  using encode_task = std::function< void() >;
+
   impl();
   ~impl();
 
   bool is_open() const;
   void assert_open( std::string const& fn_name ) const;
 
+  void start_encode();
+  void stop_encode();
+  void encode_loop();
+  void encode( encode_task const& task );
+  void check_encode_error() const;
+
   void hardware_init();
   void cuda_init();
 
@@ -93,8 +119,19 @@ class ffmpeg_video_output::impl
   size_t bitrate;
   bool cuda_enabled;
   int cuda_device_index;
+  bool cuda_upload;
+  size_t klv_encode_ahead;
+  size_t encode_ahead;
+  int encoder_threads;
 
   kv::optional< open_video_state > video;
+
+  // Only present while encoding ahead, in which case the encode thread owns
+  // video and the caller only queues work for it
+  std::unique_ptr< kv::bounded_buffer< encode_task > > encode_buffer;
+  std::thread encode_thread;
+  std::atomic< bool > encode_failed;
+  std::exception_ptr encode_error;
 };
 
 // ----------------------------------------------------------------------------
@@ -112,7 +149,15 @@ ::impl()
     cuda_enabled{ false },
 #endif
     cuda_device_index{ 0 },
-    video{}
+    cuda_upload{ true },
+    klv_encode_ahead{ 4 },
+    encode_ahead{ 0 },
+    encoder_threads{ 0 },
+    video{},
+    encode_buffer{},
+    encode_thread{},
+    encode_failed{ false },
+    encode_error{}
 {
   ffmpeg_init();
 }
@@ -143,6 +188,88 @@ ::assert_open( std::string const& fn_name ) const
   }
 }
 
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_output::impl
+::start_encode()
+{
+  encode_buffer.reset(
+    new kv::bounded_buffer< encode_task >(
+      static_cast< int >( encode_ahead ) ) );
+  encode_failed = false;
+  encode_error = nullptr;
+  encode_thread = std::thread{ &impl::encode_loop, this };
+}
+
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_output::impl
+::stop_encode()
+{
+  if( !encode_buffer )
+  {
+    return;
+  }
+
+  // The encode thread finishes everything queued before the end marker
+  encode_buffer->Send( encode_task{} );
+  encode_thread.join();
+  encode_buffer.reset();
+}
+
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_output::impl
+::encode_loop()
+{
+  for( auto task = encode_buffer->Receive(); task;
+       task = encode_buffer->Receive() )
+  {
+    // After a failure, the rest of the queue is dropped; the caller sees the
+    // error on its next call
+    if( encode_failed )
+    {
+      continue;
+    }
+
+    try
+    {
+      task();
+    }
+    catch( ... )
+    {
+      encode_error = std::current_exception();
+      encode_failed = true;
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_output::impl
+::encode( encode_task const& task )
+{
+  if( !encode_buffer )
+  {
+    task();
+    return;
+  }
+
+  check_encode_error();
+  encode_buffer->Send( task );
+}
+
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_output::impl
+::check_encode_error() const
+{
+  if( encode_failed )
+  {
+    std::rethrow_exception( encode_error );
+  }
+}
+
 // ----------------------------------------------------------------------------
 void
 ffmpeg_video_output::impl
@@ -219,7 +346,14 @@ ::ffmpeg_video_output() : d{ new impl{} }
 // ----------------------------------------------------------------------------
 ffmpeg_video_output::~ffmpeg_video_output()
 {
-  close();
+  try
+  {
+    close();
+  }
+  catch( std::exception const& e )
+  {
+    LOG_ERROR( logger(), "Could not finish writing video: " << e.what() );
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -263,6 +397,35 @@ ::get_configuration() const
     "Integer index of the CUDA-enabled device to use for encoding. "
     "Defaults to 0."
   );
+  config->set_value(
+    "cuda_upload", d->cuda_upload,
+    "When set to true and encoding with NVENC, uploads RGB frames to the GPU "
+    "and lets the encoder convert them to YUV there, instead of converting "
+    "them on the CPU. Falls back to CPU conversion if the encoder does not "
+    "accept RGB frames. Defaults to true."
+  );
+  config->set_value(
+    "klv_encode_ahead", d->klv_encode_ahead,
+    "Number of frames of KLV to serialize on worker threads before the "
+    "writing thread waits for them. Serializing large packets, such as "
+    "ST0903 VMTI sets, then overlaps with video encoding. Set to 0 to wait "
+    "for each frame's KLV as it is added. Defaults to 4."
+  );
+  config->set_value(
+    "encode_ahead", d->encode_ahead,
+    "Number of frames to queue for a background thread which converts, "
+    "encodes and writes them, so that encoding overlaps with the processing "
+    "of later frames. Each queued frame holds a reference to its image. "
+    "Errors from the background thread are reported by the next call to "
+    "add_image(), add_metadata() or close(). Set to 0 (default) to encode "
+    "synchronously in add_image()."
+  );
+  config->set_value(
+    "encoder_threads", d->encoder_threads,
+    "Number of threads the codec may use to encode frames and slices in "
+    "parallel. Set to 0 (default) to let FFmpeg choose based on the number "
+    "of CPU cores, or to 1 to encode on one thread."
+  );
 
   return config;
 }
@@ -303,6 +466,15 @@ ::set_configuration( kv::config_block_sptr config )
   d->cuda_device_index =
     config->get_value< int >(
       "cuda_device_index", d->cuda_device_index );
+  d->cuda_upload =
+    config->get_value< bool >( "cuda_upload", d->cuda_upload );
+
+  d->klv_encode_ahead =
+    config->get_value< size_t >( "klv_encode_ahead", d->klv_encode_ahead );
+  d->encode_ahead =
+    config->get_value< size_t >( "encode_ahead", d->encode_ahead );
+  d->encoder_threads =
+    config->get_value< int >( "encoder_threads", d->encoder_threads );
 }
 
 // ----------------------------------------------------------------------------
@@ -334,6 +506,11 @@ ::open(
 
   d->hardware_init();
   d->video.emplace( *d, video_name, *settings );
+
+  if( d->encode_ahead > 0 )
+  {
+    d->start_encode();
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -341,7 +518,17 @@ void
 ffmpeg_video_output
 ::close()
 {
+  // Finish the queued frames before writing the end of the video
+  d->stop_encode();
   d->video.reset();
+
+  if( d->encode_failed )
+  {
+    auto const error = d->encode_error;
+    d->encode_failed = false;
+    d->encode_error = nullptr;
+    std::rethrow_exception( error );
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -358,7 +545,9 @@ ffmpeg_video_output
 ::add_image( kv::image_container_sptr const& image, kv::timestamp const& ts )
 {
   d->assert_open( "add_image()" );
-  d->video->add_image( image, ts );
+
+  auto const video = &*d->video;
+  d->encode( [ video, image, ts ](){ video->add_image( image, ts ); } );
 }
 
 // ----------------------------------------------------------------------------
@@ -367,15 +556,45 @@ ffmpeg_video_output
 ::add_image( vital::video_raw_image const& image )
 {
   d->assert_open( "add_image()" );
-  d->video->add_image( image );
+
+  if( !d->encode_buffer )
+  {
+    d->video->add_image( image );
+    return;
+  }
+
+  // The caller keeps its packets, so queue copies of them
+  auto const& ffmpeg_image =
+    dynamic_cast< ffmpeg_video_raw_image const& >( image );
+  auto const copy = std::make_shared< ffmpeg_video_raw_image >();
+  for( auto const& packet : ffmpeg_image.packets )
+  {
+    copy->packets.emplace_back(
+      throw_error_null(
+        av_packet_clone( packet.get() ), "Could not copy packet" ) );
+  }
+
+  auto const video = &*d->video;
+  d->encode( [ video, copy ](){ video->add_image( *copy ); } );
 }
 
 // ----------------------------------------------------------------------------
 void
 ffmpeg_video_output
-::add_metadata( VITAL_UNUSED kwiver::vital::metadata const& md )
+::add_metadata( kwiver::vital::metadata const& md )
 {
-  // TODO
+  d->assert_open( "add_metadata()" );
+
+  if( !d->encode_buffer )
+  {
+    d->video->add_metadata( md );
+    return;
+  }
+
+  // Metadata describes the frame added before it, so it is queued after it
+  std::shared_ptr< kv::metadata const > const copy{ md.clone() };
+  auto const video = &*d->video;
+  d->encode( [ video, copy ](){ video->add_metadata( *copy ); } );
 }
 
 // ----------------------------------------------------------------------------
@@ -392,7 +611,13 @@ ::implementation_settings() const
   result->frame_rate = d->video->video_stream->avg_frame_rate;
   avcodec_parameters_from_context( result->parameters.get(),
                                    d->video->codec_context.get() );
-  result->klv_stream_count = 0; // TODO
+  if( auto const frames_ref = d->video->codec_context->hw_frames_ctx )
+  {
+    // Report the format of the frames rather than that they are on the GPU
+    result->parameters->format =
+      reinterpret_cast< AVHWFramesContext* >( frames_ref->data )->sw_format;
+  }
+  result->klv_stream_count = d->video->metadata_stream ? 1 : 0;
   return kwiver::vital::video_settings_uptr{ result };
 }
 
@@ -409,7 +634,9 @@ ::open_video_state(
     metadata_stream{ nullptr },
     codec_context{ nullptr },
     codec{ nullptr },
-    image_conversion_context{ nullptr }
+    image_conversion_context{ nullptr },
+    klv_encoder{},
+    raw_ts_offset{}
 {
   // Allocate output format context
   {
@@ -496,6 +723,27 @@ ::open_video_state(
   LOG_INFO(
     parent.logger, "Using output codec " << pretty_codec_name( codec ) );
 
+  // Create KLV stream
+  if( settings.klv_stream_count )
+  {
+    if( settings.klv_stream_count > 1 )
+    {
+      LOG_WARN(
+        parent.logger,
+        "Multiple KLV streams are not currently supported; all KLV will be "
+        "written to one stream" );
+    }
+
+    metadata_stream =
+      throw_error_null(
+        avformat_new_stream( format_context.get(), nullptr ),
+        "Could not allocate KLV stream" );
+    metadata_stream->time_base = video_stream->time_base;
+    metadata_stream->codecpar->codec_type = AVMEDIA_TYPE_DATA;
+    metadata_stream->codecpar->codec_id = AV_CODEC_ID_SMPTE_KLV;
+    klv_encoder.reset( new klv::klv_frame_encoder );
+  }
+
   av_dump_format(
     format_context.get(), video_stream->index, video_name.c_str(), 1 );
 
@@ -523,6 +771,15 @@ ffmpeg_video_output::impl::open_video_state
   {
     write_remaining_packets();
 
+    try
+    {
+      write_ready_klv( true );
+    }
+    catch( std::exception const& e )
+    {
+      LOG_ERROR( parent->logger, "Could not write KLV: " << e.what() );
+    }
+
     // Write closing bytes of video format
     auto err = av_write_trailer( format_context.get() );
     if( err < 0 )
@@ -613,6 +870,22 @@ ::try_codec( ffmpeg_video_settings const& settings )
   video_stream->codecpar->height = codec_context->height;
   video_stream->codecpar->format = codec_context->pix_fmt;
 
+  // Let the codec encode on several threads, by frame or by slice, as it
+  // supports
+  codec_context->thread_count = parent->encoder_threads;
+  codec_context->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
+#ifdef KWIVER_ENABLE_FFMPEG_CUDA
+  if( parent->cuda_upload && parent->cuda_device() &&
+      is_hardware_codec( codec ) && !init_cuda_upload() )
+  {
+    LOG_DEBUG(
+      parent->logger,
+      "Output codec " << pretty_codec_name( codec ) << " does not accept "
+      "RGB frames on the GPU; converting frames on the CPU" );
+  }
+#endif
+
   auto const err = avcodec_open2( codec_context.get(), codec, nullptr );
   if( err < 0 )
   {
@@ -626,12 +899,63 @@ ::try_codec( ffmpeg_video_settings const& settings )
   return true;
 }
 
+// ----------------------------------------------------------------------------
+bool
+ffmpeg_video_output::impl::open_video_state
+::init_cuda_upload()
+{
+  // NVENC converts RGB to YUV itself, so frames can be uploaded as RGB with
+  // a padding byte, which needs no color conversion on the CPU.
+  // AV_PIX_FMT_0BGR32 is RGB0 in memory on little-endian machines
+  auto const rgb_format = AV_PIX_FMT_0BGR32;
+  auto supports_cuda = false;
+  auto supports_rgb = false;
+  for( auto fmt = codec->pix_fmts; fmt && *fmt != AV_PIX_FMT_NONE; ++fmt )
+  {
+    supports_cuda = supports_cuda || *fmt == AV_PIX_FMT_CUDA;
+    supports_rgb = supports_rgb || *fmt == rgb_format;
+  }
+  if( !supports_cuda || !supports_rgb )
+  {
+    return false;
+  }
+
+  auto frames_ref =
+    throw_error_null(
+      av_hwframe_ctx_alloc( parent->hardware_device_context.get() ),
+      "Could not allocate hardware frames context" );
+  auto const frames_context =
+    reinterpret_cast< AVHWFramesContext* >( frames_ref->data );
+  frames_context->format = AV_PIX_FMT_CUDA;
+  frames_context->sw_format = rgb_format;
+  frames_context->width = codec_context->width;
+  frames_context->height = codec_context->height;
+
+  auto const err = av_hwframe_ctx_init( frames_ref );
+  if( err < 0 )
+  {
+    av_buffer_unref( &frames_ref );
+    LOG_WARN(
+      parent->logger,
+      "Could not initialize hardware frames: " << error_string( err ) );
+    return false;
+  }
+
+  // The codec context takes ownership of the reference
+  codec_context->pix_fmt = AV_PIX_FMT_CUDA;
+  codec_context->hw_frames_ctx = frames_ref;
+  return true;
+}
+
 // ----------------------------------------------------------------------------
 void
 ffmpeg_video_output::impl::open_video_state
 ::add_image( kv::image_container_sptr const& image,
              VITAL_UNUSED kv::timestamp const& ts )
 {
+  // Frames uploaded to the GPU are converted to YUV by the encoder
+  auto const upload = codec_context->hw_frames_ctx != nullptr;
+
   // Create frame object to represent incoming image
   frame_uptr frame{
     throw_error_null( av_frame_alloc(), "Could not allocate frame" ) };
@@ -646,6 +970,18 @@ ::add_image( kv::image_container_sptr const& image,
     default:
       throw_error( "Image has unsupported depth: ", image->depth() );
   }
+  if( upload )
+  {
+    if( static_cast< int >( image->width() ) != codec_context->width ||
+        static_cast< int >( image->height() ) != codec_context->height )
+    {
+      throw_error(
+        "Image size ", image->width(), "x", image->height(),
+        " does not match video size ", codec_context->width, "x",
+        codec_context->height );
+    }
+    frame->format = AV_PIX_FMT_0BGR32;
+  }
 
   if( image->get_image().pixel_traits() !=
       kv::image_pixel_traits_of< uint8_t >() )
@@ -659,6 +995,28 @@ ::add_image( kv::image_container_sptr const& image,
     av_frame_get_buffer( frame.get(), 32 ), "Could not allocate frame data" );
 
   // Give the frame the raw pixel data
+  if( upload )
+  {
+    // Gray is repeated into each color, and the padding byte is ignored
+    auto const& src = image->get_image();
+    auto const c_step = image->depth() == 1 ? 0 : src.d_step();
+    auto const first = static_cast< uint8_t const* >( src.first_pixel() );
+    for( size_t i = 0; i < image->height(); ++i )
+    {
+      auto ptr = first + static_cast< ptrdiff_t >( i ) * src.h_step();
+      auto out = frame->data[ 0 ] + i * frame->linesize[ 0 ];
+      for( size_t j = 0; j < image->width(); ++j )
+      {
+        out[ 0 ] = ptr[ 0 ];
+        out[ 1 ] = ptr[ c_step ];
+        out[ 2 ] = ptr[ 2 * c_step ];
+        out[ 3 ] = 0xff;
+        out += 4;
+        ptr += src.w_step();
+      }
+    }
+  }
+  else
   {
     size_t index = 0;
     auto ptr = static_cast< uint8_t* >( image->get_image().first_pixel() );
@@ -686,34 +1044,48 @@ ::add_image( kv::image_container_sptr const& image,
   frame_uptr converted_frame{
     throw_error_null( av_frame_alloc(), "Could not allocate frame" ) };
 
-  // Fill in a few mandatory fields
-  converted_frame->width = image->width();
-  converted_frame->height = image->height();
-  converted_frame->format = codec_context->pix_fmt;
-
-  // Allocate storage based on those fields
-  throw_error_code(
-    av_frame_get_buffer( converted_frame.get(), 32 ),
-    "Could not allocate frame data" );
+  if( upload )
+  {
+    // Copy the frame into GPU memory from the encoder's pool
+    throw_error_code(
+      av_hwframe_get_buffer(
+        codec_context->hw_frames_ctx, converted_frame.get(), 0 ),
+      "Could not allocate hardware frame" );
+    throw_error_code(
+      av_hwframe_transfer_data( converted_frame.get(), frame.get(), 0 ),
+      "Could not upload frame to GPU" );
+  }
+  else
+  {
+    // Fill in a few mandatory fields
+    converted_frame->width = image->width();
+    converted_frame->height = image->height();
+    converted_frame->format = codec_context->pix_fmt;
 
-  // Specify which conversion to perform
-  image_conversion_context.reset(
-    throw_error_null(
-      sws_getCachedContext(
-        image_conversion_context.release(),
-        image->width(), image->height(),
-        static_cast< AVPixelFormat >( frame->format ),
-        image->width(), image->height(),
-        static_cast< AVPixelFormat >( converted_frame->format ),
-        SWS_BICUBIC, nullptr, nullptr, nullptr ),
-      "Could not create image conversion context" ) );
-
-  // Convert the pixel format
-  throw_error_code(
-    sws_scale(
-      image_conversion_context.get(), frame->data, frame->linesize,
-      0, image->height(), converted_frame->data, converted_frame->linesize ),
-    "Could not convert frame image to target pixel format" );
+    // Allocate storage based on those fields
+    throw_error_code(
+      av_frame_get_buffer( converted_frame.get(), 32 ),
+      "Could not allocate frame data" );
+
+    // Specify which conversion to perform
+    image_conversion_context.reset(
+      throw_error_null(
+        sws_getCachedContext(
+          image_conversion_context.release(),
+          image->width(), image->height(),
+          static_cast< AVPixelFormat >( frame->format ),
+          image->width(), image->height(),
+          static_cast< AVPixelFormat >( converted_frame->format ),
+          SWS_BICUBIC, nullptr, nullptr, nullptr ),
+        "Could not create image conversion context" ) );
+
+    // Convert the pixel format
+    throw_error_code(
+      sws_scale(
+        image_conversion_context.get(), frame->data, frame->linesize,
+        0, image->height(), converted_frame->data, converted_frame->linesize ),
+      "Could not convert frame image to target pixel format" );
+  }
 
   // Try to send image to video encoder
   converted_frame->pts = next_video_pts();
@@ -736,13 +1108,57 @@ ::add_image( kv::video_raw_image const& image )
     dynamic_cast< ffmpeg_video_raw_image const& >( image );
   for( auto const& packet : ffmpeg_image.packets )
   {
+    packet_uptr copy{
+      throw_error_null(
+        av_packet_clone( packet.get() ), "Could not copy packet" ) };
+
+    if( ffmpeg_image.time_base.num > 0 )
+    {
+      // Copied packets keep their timing relative to each other, shifted to
+      // follow the frames already written
+      av_packet_rescale_ts(
+        copy.get(), ffmpeg_image.time_base, video_stream->time_base );
+      auto const first_ts =
+        copy->dts != AV_NOPTS_VALUE ? copy->dts : copy->pts;
+      if( !raw_ts_offset && first_ts != AV_NOPTS_VALUE )
+      {
+        raw_ts_offset = next_video_pts() - first_ts;
+      }
+      if( raw_ts_offset && copy->pts != AV_NOPTS_VALUE )
+      {
+        copy->pts += *raw_ts_offset;
+      }
+      if( raw_ts_offset && copy->dts != AV_NOPTS_VALUE )
+      {
+        copy->dts += *raw_ts_offset;
+      }
+    }
+    copy->stream_index = video_stream->index;
+
     throw_error_code(
-      av_interleaved_write_frame( format_context.get(), packet.get() ),
+      av_interleaved_write_frame( format_context.get(), copy.get() ),
       "Could not write frame to file" );
   }
   ++frame_count;
 }
 
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_output::impl::open_video_state
+::add_metadata( kv::metadata const& md )
+{
+  auto const klv_md = dynamic_cast< klv::klv_metadata const* >( &md );
+  if( !klv_md || !klv_encoder )
+  {
+    return;
+  }
+
+  // Metadata describes the most recently added frame
+  auto const pts = video_pts( frame_count ? frame_count - 1 : 0 );
+  klv_encoder->send_frame( static_cast< uint64_t >( pts ), klv_md->klv() );
+  write_ready_klv( false );
+}
+
 // ----------------------------------------------------------------------------
 bool
 ffmpeg_video_output::impl::open_video_state
@@ -780,16 +1196,57 @@ ::write_remaining_packets()
   while( write_next_packet() ) {}
 }
 
+// ----------------------------------------------------------------------------
+void
+ffmpeg_video_output::impl::open_video_state
+::write_ready_klv( bool flush )
+{
+  // Write frames as soon as they are serialized, and wait for the oldest one
+  // only when too many are in flight. Frames are received in the order they
+  // were sent, so timestamps never go backwards
+  while( klv_encoder && klv_encoder->pending_frames() &&
+         ( flush || klv_encoder->frame_ready() ||
+           klv_encoder->pending_frames() > parent->klv_encode_ahead ) )
+  {
+    auto const frame = klv_encoder->receive_frame();
+    for( auto const& bytes : frame.packets )
+    {
+      packet_uptr packet{
+        throw_error_null( av_packet_alloc(), "Could not allocate packet" ) };
+      throw_error_code(
+        av_new_packet( packet.get(), static_cast< int >( bytes.size() ) ),
+        "Could not allocate KLV packet data" );
+      std::memcpy( packet->data, bytes.data(), bytes.size() );
+      packet->stream_index = metadata_stream->index;
+      packet->pts = static_cast< int64_t >( frame.timestamp );
+      packet->dts = packet->pts;
+      av_packet_rescale_ts(
+        packet.get(), video_stream->time_base, metadata_stream->time_base );
+      throw_error_code(
+        av_interleaved_write_frame( format_context.get(), packet.get() ),
+        "Could not write KLV packet to file" );
+    }
+  }
+}
+
 // ----------------------------------------------------------------------------
 int64_t
 ffmpeg_video_output::impl::open_video_state
-::next_video_pts() const
+::video_pts( size_t frame_number ) const
 {
   return static_cast< int64_t >(
-    frame_count / av_q2d( video_stream->time_base ) /
+    frame_number / av_q2d( video_stream->time_base ) /
     av_q2d( codec_context->framerate ) + 0.5 );
 }
 
+// ----------------------------------------------------------------------------
+int64_t
+ffmpeg_video_output::impl::open_video_state
+::next_video_pts() const
+{
+  return video_pts( frame_count );
+}
+
 } // namespace ffmpeg
 
 } // namespace arrows
@@ -14,7 +14,7 @@ namespace arrows {
 namespace ffmpeg {
 
 ffmpeg_video_raw_image
-::ffmpeg_video_raw_image() : packets{}
+::ffmpeg_video_raw_image() : packets{}, time_base{ 0, 1 }
 {}
 
 } // namespace ffmpeg
@@ -33,6 +33,9 @@ struct KWIVER_ALGO_FFMPEG_EXPORT ffmpeg_video_raw_image
   operator=( ffmpeg_video_raw_image const& ) = delete;
 
   std::list< packet_uptr > packets;
+
+  /// Time base of the timestamps of the packets.
+  AVRational time_base;
 };
 using ffmpeg_video_raw_image_sptr = std::shared_ptr< ffmpeg_video_raw_image >;
 
@@ -0,0 +1,106 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Benchmark decoding, seeking and KLV extraction with ffmpeg_video_input.
+///
+/// Each test reads an H.264 MPEG-TS video with KLV in one configuration,
+/// reporting frames per second, metadata per second, memory per frame and
+/// seek latency. Results are recorded as test properties, so
+/// \c --gtest_output=json:<file> gives a machine-readable report. Rates depend
+/// on the machine, so they are checked only against a floor passed as
+/// \c --min-fps=<frames/s>.
+
+#include <test_gtest.h>
+
+#include <arrows/ffmpeg/ffmpeg_video_input.h>
+#include <arrows/tests/test_video_input_benchmark.h>
+#include <vital/plugin_loader/plugin_manager.h>
+
+#include <string>
+
+kwiver::vital::path_t g_data_dir;
+
+namespace ffmpeg = kwiver::arrows::ffmpeg;
+namespace kv = kwiver::vital;
+
+namespace {
+
+double g_min_fps = 0.0;
+
+std::string const klv_video_name = "videos/aphill_klv_10s.ts";
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+
+  GET_ARG( 1, g_data_dir );
+  g_min_fps = benchmark_min_fps( argc, argv );
+
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+class ffmpeg_video_input_benchmark : public ::testing::Test
+{
+  TEST_ARG( data_dir );
+
+protected:
+  // Benchmark the KLV video with the given settings
+  video_benchmark_result
+  run( kv::config_block_sptr const& settings )
+  {
+    ffmpeg::ffmpeg_video_input input;
+    auto config = input.get_configuration();
+    config->merge_config( settings );
+    EXPECT_TRUE( input.check_configuration( config ) );
+    input.set_configuration( config );
+    return benchmark_video_input( input, data_dir + "/" + klv_video_name );
+  }
+};
+
+// ----------------------------------------------------------------------------
+TEST_F ( ffmpeg_video_input_benchmark, cpu )
+{
+  auto config = kv::config_block::empty_config();
+  config->set_value( "cuda_enabled", false );
+  auto const result = run( config );
+  report_video_benchmark( result, g_min_fps );
+  EXPECT_LT( 0u, result.metadata );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F ( ffmpeg_video_input_benchmark, cpu_decode_ahead )
+{
+  auto config = kv::config_block::empty_config();
+  config->set_value( "cuda_enabled", false );
+  config->set_value( "decode_ahead", 4 );
+  report_video_benchmark( run( config ), g_min_fps );
+}
+
+// ----------------------------------------------------------------------------
+// Without imagery, the frame rate is the KLV extraction rate
+TEST_F ( ffmpeg_video_input_benchmark, klv_only )
+{
+  auto config = kv::config_block::empty_config();
+  config->set_value( "imagery_enabled", false );
+  auto const result = run( config );
+  report_video_benchmark( result, g_min_fps );
+  EXPECT_LT( 0u, result.metadata );
+}
+
+#ifdef KWIVER_ENABLE_FFMPEG_CUDA
+// ----------------------------------------------------------------------------
+TEST_F ( ffmpeg_video_input_benchmark, cuda )
+{
+  auto config = kv::config_block::empty_config();
+  config->set_value( "cuda_enabled", true );
+  report_video_benchmark( run( config ), g_min_fps );
+}
+#endif
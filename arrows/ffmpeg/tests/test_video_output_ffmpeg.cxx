@@ -226,6 +226,45 @@ TEST_F ( ffmpeg_video_output, round_trip )
   expect_eq_videos( src_path, tmp_path, image_epsilon );
 }
 
+// ----------------------------------------------------------------------------
+// Test that encoding on a background thread writes the same video as
+// encoding synchronously.
+TEST_F ( ffmpeg_video_output, round_trip_encode_ahead )
+{
+  auto const src_path = data_dir + "/" + short_video_name;
+  auto const tmp_path =
+    kwiver::testing::temp_file_name( "test-ffmpeg-output-", ".ts" );
+
+  kv::timestamp ts;
+  ffmpeg::ffmpeg_video_input is;
+  is.open( src_path );
+
+  ffmpeg::ffmpeg_video_output os;
+  auto config = os.get_configuration();
+  config->set_value( "encode_ahead", 4 );
+  os.set_configuration( config );
+  os.open( tmp_path, is.implementation_settings().get() );
+  _tmp_file_deleter tmp_file_deleter{ tmp_path };
+
+  // Write to a temporary file
+  for( is.next_frame( ts ); !is.end_of_video(); is.next_frame( ts ) )
+  {
+    auto const image = is.frame_image();
+    os.add_image( image, ts );
+  }
+  os.close();
+  is.close();
+
+  auto image_epsilon = 6.5;
+  if( is.get_configuration()->get_value< bool >( "cuda_enabled", false ) )
+  {
+    image_epsilon = 10.5;
+  }
+
+  // Read the temporary file back in
+  expect_eq_videos( src_path, tmp_path, image_epsilon );
+}
+
 TEST_F ( ffmpeg_video_output, round_trip_direct )
 {
   auto const src_path = data_dir + "/" + short_video_name;
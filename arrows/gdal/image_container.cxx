@@ -274,20 +274,34 @@ image_container
 ::get_image(unsigned x_offset, unsigned y_offset,
             unsigned width, unsigned height) const
 {
-  vital::image img( width, height, depth(), false, pixel_traits_ );
+  return get_image( x_offset, y_offset, width, height, width, height );
+}
+
+// ----------------------------------------------------------------------------
+/// Get a window of the image resampled to a given size
+vital::image
+image_container
+::get_image(unsigned x_offset, unsigned y_offset,
+            unsigned width, unsigned height,
+            unsigned out_width, unsigned out_height) const
+{
+  vital::image img( out_width, out_height, depth(), false, pixel_traits_ );
 
   // Loop over bands and copy data
-  CPLErr err;
   for (size_t i = 1; i <= depth(); ++i)
   {
-    GDALRasterBand* band = gdal_dataset_->GetRasterBand(i);
+    GDALRasterBand* band = gdal_dataset_->GetRasterBand(static_cast<int>(i));
     auto bandType = band->GetRasterDataType();
-    err = band->RasterIO(GF_Read, x_offset, y_offset, width, height,
+    CPLErr err = band->RasterIO(GF_Read, x_offset, y_offset, width, height,
       static_cast<void*>(reinterpret_cast<GByte*>(
         img.first_pixel()) + (i-1)*img.d_step()*img.pixel_traits().num_bytes),
-      width, height, bandType, 0, 0);
+      out_width, out_height, bandType, 0, 0);
 
-    (void) err;
+    if ( err != CE_None )
+    {
+      VITAL_THROW( vital::file_not_read_exception,
+                   gdal_dataset_->GetDescription(), CPLGetLastErrorMsg() );
+    }
   }
 
   return img;
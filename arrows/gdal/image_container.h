@@ -53,6 +53,17 @@ class KWIVER_ALGO_GDAL_EXPORT image_container
   virtual vital::image get_image(unsigned x_offset, unsigned y_offset,
                                  unsigned width, unsigned height) const;
 
+  /// Get a window of the image resampled to a given size
+  ///
+  /// Only the window is read. When the requested size is smaller than the
+  /// window, GDAL reads from the overview in the file closest to that
+  /// resolution, if there is one.
+  ///
+  /// \throws vital::file_not_read_exception if GDAL fails to read the window
+  vital::image get_image(unsigned x_offset, unsigned y_offset,
+                         unsigned width, unsigned height,
+                         unsigned out_width, unsigned out_height) const;
+
   char **get_raw_metadata_for_domain(const char *domain);
 protected:
 
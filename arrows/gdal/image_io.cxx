@@ -10,8 +10,11 @@
 #include <arrows/gdal/image_container.h>
 
 #include <vital/exceptions/algorithm.h>
+#include <vital/exceptions/image.h>
 #include <vital/vital_config.h>
 
+#include <algorithm>
+
 namespace kwiver {
 namespace arrows {
 namespace gdal {
@@ -27,6 +30,45 @@ ::load_(const std::string& filename) const
   return vital::image_container_sptr( new gdal::image_container( filename ) );
 }
 
+/// Load a window of an image from the file
+///
+/// \param filename the path to the file the load
+/// \param x_offset column of the first pixel of the window
+/// \param y_offset row of the first pixel of the window
+/// \param width width of the window
+/// \param height height of the window
+/// \param level decimation level
+/// \returns an image container refering to the loaded window
+vital::image_container_sptr
+image_io
+::load_window_(const std::string& filename,
+               unsigned x_offset, unsigned y_offset,
+               unsigned width, unsigned height, unsigned level) const
+{
+  // Opening the dataset does not read any pixels
+  auto const full = std::make_shared< gdal::image_container >( filename );
+
+  if ( !width || !height ||
+       size_t{ x_offset } + width > full->width() ||
+       size_t{ y_offset } + height > full->height() )
+  {
+    VITAL_THROW( vital::image_size_mismatch_exception,
+                 "Window does not fit in the image",
+                 full->width(), full->height(),
+                 size_t{ x_offset } + width, size_t{ y_offset } + height );
+  }
+
+  auto const step = size_t{ 1 } << std::min( level, 31u );
+  auto const out_width = static_cast< unsigned >( ( width + step - 1 ) / step );
+  auto const out_height = static_cast< unsigned >( ( height + step - 1 ) / step );
+
+  auto const result = std::make_shared< vital::simple_image_container >(
+    full->get_image( x_offset, y_offset, width, height,
+                     out_width, out_height ) );
+  result->set_metadata( full->get_metadata() );
+  return result;
+}
+
 /// Save image image to a file
 ///
 /// \param filename the path to the file to save.
@@ -34,6 +34,23 @@ class KWIVER_ALGO_GDAL_EXPORT image_io
   /// \returns an image container refering to the loaded image
   virtual vital::image_container_sptr load_(const std::string& filename) const;
 
+  /// Implementation specific windowed load functionality.
+  ///
+  /// Reads only the window from the file, using overviews in the file
+  /// when they are close to the requested resolution.
+  ///
+  /// \param filename the path to the file the load
+  /// \param x_offset column of the first pixel of the window
+  /// \param y_offset row of the first pixel of the window
+  /// \param width width of the window
+  /// \param height height of the window
+  /// \param level decimation level
+  /// \returns an image container refering to the loaded window
+  virtual vital::image_container_sptr load_window_(
+    const std::string& filename,
+    unsigned x_offset, unsigned y_offset, unsigned width, unsigned height,
+    unsigned level) const;
+
   /// Implementation specific save functionality.
   ///
   /// \param filename the path to the file to save
@@ -9,6 +9,7 @@
 
 #include <arrows/gdal/image_io.h>
 #include <arrows/tests/test_image.h>
+#include <vital/exceptions/image.h>
 #include <vital/plugin_loader/plugin_manager.h>
 #include <vital/types/metadata.h>
 #include <vital/types/metadata_traits.h>
@@ -229,6 +230,42 @@ TEST_F(image_io, load_jpeg)
   }
 }
 
+// ----------------------------------------------------------------------------
+TEST_F(image_io, load_window)
+{
+  kwiver::arrows::gdal::image_io img_io;
+
+  kwiver::vital::path_t file_path = data_dir + "/" + geotiff_file_name;
+  auto full_ptr = img_io.load(file_path);
+  auto win_ptr = img_io.load_window(file_path, 3, 5, 20, 11);
+
+  EXPECT_EQ( win_ptr->width(), 20 );
+  EXPECT_EQ( win_ptr->height(), 11 );
+  EXPECT_EQ( win_ptr->depth(), 1 );
+
+  kwiver::vital::image_of<uint16_t> full(full_ptr->get_image());
+  kwiver::vital::image_of<uint16_t> win(win_ptr->get_image());
+  for ( unsigned y = 0; y < 11; ++y )
+  {
+    for ( unsigned x = 0; x < 20; ++x )
+    {
+      EXPECT_EQ( win(x, y), full(x + 3, y + 5) )
+        << "Incorrect value at window pixel (" << x << "," << y << ")";
+    }
+  }
+
+  // The window is decimated and the metadata is of the whole image
+  auto dec_ptr = img_io.load_window(file_path, 3, 5, 20, 11, 2);
+  EXPECT_EQ( dec_ptr->width(), 5 );
+  EXPECT_EQ( dec_ptr->height(), 3 );
+  test_rpc_metadata(dec_ptr->get_metadata());
+
+  EXPECT_THROW( img_io.load_window(file_path, 16, 0, 17, 8),
+                kwiver::vital::image_size_mismatch_exception );
+  EXPECT_THROW( img_io.load_window(file_path, 0, 0, 0, 8),
+                kwiver::vital::image_size_mismatch_exception );
+}
+
 // ----------------------------------------------------------------------------
 class get_image : public ::testing::Test
 {
@@ -247,3 +284,4 @@ TEST_F(get_image, crop)
   test_get_image_crop<uint8_t>( img_cont );
 }
 
+
@@ -2829,7 +2829,10 @@ klv_0601_local_set_format
 ::klv_0601_local_set_format()
   : klv_local_set_format{ klv_0601_traits_lookup() },
     m_checksum_format{ { KLV_0601_CHECKSUM, 2 } }
-{}
+{
+  // Consumers typically use only a few of the many tags in each packet
+  set_deferred( true );
+}
 
 // ----------------------------------------------------------------------------
 klv_uds_key
@@ -0,0 +1,934 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Implementation of direct conversion between ST0903 VMTI and detections.
+
+#include "klv_0903_detections.h"
+
+#include <arrows/klv/klv_0903.h>
+#include <arrows/klv/klv_0903_vmask_set.h>
+#include <arrows/klv/klv_0903_vobject_set.h>
+#include <arrows/klv/klv_0903_vtarget_pack.h>
+#include <arrows/klv/klv_blob.h>
+#include <arrows/klv/klv_read_write.h>
+#include <arrows/klv/klv_util.h>
+
+#include <vital/types/detected_object_type.h>
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace kv = kwiver::vital;
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace klv {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Version of ST0903 whose tags are written
+constexpr uint64_t vmti_version = 5;
+
+// The Precision Timestamp is always written with its full eight bytes
+constexpr size_t timestamp_length = 8;
+
+// Bytes of the IMAP-encoded object confidence; a step of about 0.002 percent
+constexpr size_t object_confidence_length = 2;
+
+constexpr double nan = std::numeric_limits< double >::quiet_NaN();
+
+// ----------------------------------------------------------------------------
+kv::interval< double > const&
+object_confidence_interval()
+{
+  static kv::interval< double > const interval{ 0.0, 100.0 };
+  return interval;
+}
+
+// ----------------------------------------------------------------------------
+// Call fn( tag, value, length ) for each non-empty entry of the local set in
+// the length bytes at data, without decoding the values.
+template < class Func >
+void
+for_each_entry( klv_read_iter_t data, size_t length, Func fn )
+{
+  auto const tracker = track_it( data, length );
+  while( tracker.remaining() )
+  {
+    auto const tag =
+      klv_read_ber_oid< klv_lds_key >( data, tracker.remaining() );
+    auto const length_of_value =
+      klv_read_ber< size_t >( data, tracker.remaining() );
+    tracker.verify( length_of_value );
+    if( length_of_value )
+    {
+      fn( tag, data, length_of_value );
+    }
+    data += length_of_value;
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Call fn( item, length ) for each item of the series in the length bytes at
+// data.
+template < class Func >
+void
+for_each_item( klv_read_iter_t data, size_t length, Func fn )
+{
+  auto const tracker = track_it( data, length );
+  while( tracker.remaining() )
+  {
+    auto const length_of_item =
+      klv_read_ber< size_t >( data, tracker.remaining() );
+    fn( data, tracker.verify( length_of_item ) );
+    data += length_of_item;
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Location and class of one target, as read from its vTarget pack.
+struct target_fields
+{
+  uint64_t id = 0;
+
+  // Pixel numbers, or zero if absent
+  uint64_t centroid = 0;
+  uint64_t top_left = 0;
+  uint64_t bottom_right = 0;
+
+  // One-based, or zero if absent
+  uint64_t centroid_row = 0;
+  uint64_t centroid_column = 0;
+
+  // Pixel numbers of the mask polygon vertices
+  std::vector< uint64_t > polygon;
+
+  double confidence = nan;
+
+  std::string class_name;
+  double class_score = nan;
+
+  // Keep the object with the highest confidence as the class
+  void add_object( std::string const& name, double score )
+  {
+    if( name.empty() )
+    {
+      return;
+    }
+
+    if( class_name.empty() ||
+        ( !std::isnan( score ) &&
+          ( std::isnan( class_score ) || score > class_score ) ) )
+    {
+      class_name = name;
+      class_score = score;
+    }
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Appends targets to the columns of a result, interning class names.
+class column_builder
+{
+public:
+  column_builder( klv_0903_detections& result )
+    : m_result( result )
+  {
+    for( size_t i = 0; i < result.class_names.size(); ++i )
+    {
+      m_class_indices.emplace( result.class_names[ i ], i );
+    }
+  }
+
+  void append( target_fields const& target );
+
+  size_t class_index( std::string const& name );
+
+private:
+  // Zero-based row and column of a one-based pixel number
+  bool pixel_position( uint64_t pixel, double& row, double& column ) const
+  {
+    auto const width = m_result.frame_width;
+    if( !pixel || !width )
+    {
+      return false;
+    }
+    row = static_cast< double >( ( pixel - 1 ) / width );
+    column = static_cast< double >( ( pixel - 1 ) % width );
+    return true;
+  }
+
+  klv_0903_detections& m_result;
+  std::unordered_map< std::string, size_t > m_class_indices;
+};
+
+// ----------------------------------------------------------------------------
+void
+column_builder
+::append( target_fields const& target )
+{
+  // The boundary is preferred to the mask polygon, which is preferred to the
+  // centroid
+  double min_x, min_y, max_x, max_y;
+  double row, column;
+  if( pixel_position( target.top_left, min_y, min_x ) &&
+      pixel_position( target.bottom_right, max_y, max_x ) )
+  {
+    if( max_x < min_x )
+    {
+      std::swap( min_x, max_x );
+    }
+    if( max_y < min_y )
+    {
+      std::swap( min_y, max_y );
+    }
+  }
+  else if( !target.polygon.empty() &&
+           pixel_position( target.polygon.front(), min_y, min_x ) )
+  {
+    max_x = min_x;
+    max_y = min_y;
+    for( auto const pixel : target.polygon )
+    {
+      if( pixel_position( pixel, row, column ) )
+      {
+        min_x = std::min( min_x, column );
+        max_x = std::max( max_x, column );
+        min_y = std::min( min_y, row );
+        max_y = std::max( max_y, row );
+      }
+    }
+  }
+  else if( target.centroid_row && target.centroid_column )
+  {
+    min_x = max_x = static_cast< double >( target.centroid_column - 1 );
+    min_y = max_y = static_cast< double >( target.centroid_row - 1 );
+  }
+  else if( pixel_position( target.centroid, min_y, min_x ) )
+  {
+    max_x = min_x;
+    max_y = min_y;
+  }
+  else
+  {
+    return;
+  }
+
+  // Boxes cover whole pixels
+  m_result.id.push_back( target.id );
+  m_result.min_x.push_back( min_x );
+  m_result.min_y.push_back( min_y );
+  m_result.max_x.push_back( max_x + 1.0 );
+  m_result.max_y.push_back( max_y + 1.0 );
+  m_result.confidence.push_back( target.confidence );
+  m_result.class_index.push_back(
+    target.class_name.empty()
+    ? klv_0903_detections::no_class
+    : class_index( target.class_name ) );
+  m_result.class_score.push_back( target.class_score );
+}
+
+// ----------------------------------------------------------------------------
+size_t
+column_builder
+::class_index( std::string const& name )
+{
+  auto const result =
+    m_class_indices.emplace( name, m_result.class_names.size() );
+  if( result.second )
+  {
+    m_result.class_names.push_back( name );
+  }
+  return result.first->second;
+}
+
+// ----------------------------------------------------------------------------
+void
+read_vobject( klv_read_iter_t data, size_t length, target_fields& target )
+{
+  std::string ontology;
+  std::string ontology_class;
+  double score = nan;
+  for_each_entry(
+    data, length,
+    [ & ]( klv_lds_key tag, klv_read_iter_t value, size_t length_of_value ){
+      switch( tag )
+      {
+        case KLV_0903_VOBJECT_ONTOLOGY:
+          ontology = klv_read_string( value, length_of_value );
+          break;
+        case KLV_0903_VOBJECT_ONTOLOGY_CLASS:
+          ontology_class = klv_read_string( value, length_of_value );
+          break;
+        case KLV_0903_VOBJECT_CONFIDENCE:
+          score = klv_read_imap( object_confidence_interval(), value,
+                                 length_of_value ) / 100.0;
+          break;
+        default:
+          break;
+      }
+    } );
+  target.add_object( ontology_class.empty() ? ontology : ontology_class,
+                     score );
+}
+
+// ----------------------------------------------------------------------------
+void
+read_vtarget( klv_read_iter_t data, size_t length, column_builder& builder )
+{
+  auto const tracker = track_it( data, length );
+  target_fields target;
+  target.id = klv_read_ber_oid< uint64_t >( data, tracker.remaining() );
+  for_each_entry(
+    data, tracker.remaining(),
+    [ & ]( klv_lds_key tag, klv_read_iter_t value, size_t length_of_value ){
+      switch( tag )
+      {
+        case KLV_0903_VTARGET_CENTROID:
+          target.centroid = klv_read_int< uint64_t >( value, length_of_value );
+          break;
+        case KLV_0903_VTARGET_BOUNDARY_TOP_LEFT:
+          target.top_left = klv_read_int< uint64_t >( value, length_of_value );
+          break;
+        case KLV_0903_VTARGET_BOUNDARY_BOTTOM_RIGHT:
+          target.bottom_right =
+            klv_read_int< uint64_t >( value, length_of_value );
+          break;
+        case KLV_0903_VTARGET_CONFIDENCE_LEVEL:
+          target.confidence =
+            klv_read_int< uint64_t >( value, length_of_value ) / 100.0;
+          break;
+        case KLV_0903_VTARGET_CENTROID_ROW:
+          target.centroid_row =
+            klv_read_int< uint64_t >( value, length_of_value );
+          break;
+        case KLV_0903_VTARGET_CENTROID_COLUMN:
+          target.centroid_column =
+            klv_read_int< uint64_t >( value, length_of_value );
+          break;
+        case KLV_0903_VTARGET_VMASK:
+          // Only the polygon is used; the bitmask series is skipped
+          for_each_entry(
+            value, length_of_value,
+            [ & ]( klv_lds_key mask_tag, klv_read_iter_t mask,
+                   size_t length_of_mask ){
+              if( mask_tag == KLV_0903_VMASK_POLYGON )
+              {
+                for_each_item(
+                  mask, length_of_mask,
+                  [ & ]( klv_read_iter_t vertex, size_t length_of_vertex ){
+                    target.polygon.push_back(
+                      klv_read_int< uint64_t >( vertex, length_of_vertex ) );
+                  } );
+              }
+            } );
+          break;
+        case KLV_0903_VTARGET_VOBJECT:
+          read_vobject( value, length_of_value, target );
+          break;
+        case KLV_0903_VTARGET_VOBJECT_SERIES:
+          for_each_item(
+            value, length_of_value,
+            [ & ]( klv_read_iter_t object, size_t length_of_object ){
+              read_vobject( object, length_of_object, target );
+            } );
+          break;
+        default:
+          break;
+      }
+    } );
+  builder.append( target );
+}
+
+// ----------------------------------------------------------------------------
+template < class T >
+T const*
+find_value( klv_local_set const& set, klv_lds_key tag )
+{
+  auto const it = set.find( tag );
+  return ( it == set.end() ) ? nullptr : it->second.get_ptr< T >();
+}
+
+// ----------------------------------------------------------------------------
+void
+read_vobject( klv_local_set const& set, target_fields& target )
+{
+  auto const ontology =
+    find_value< std::string >( set, KLV_0903_VOBJECT_ONTOLOGY );
+  auto const ontology_class =
+    find_value< std::string >( set, KLV_0903_VOBJECT_ONTOLOGY_CLASS );
+  auto const score =
+    find_value< klv_lengthy< double > >( set, KLV_0903_VOBJECT_CONFIDENCE );
+  auto const& name =
+    ( ontology_class && !ontology_class->empty() )
+    ? *ontology_class
+    : ( ontology ? *ontology : std::string{} );
+  target.add_object( name, score ? score->value / 100.0 : nan );
+}
+
+// ----------------------------------------------------------------------------
+void
+read_vtarget( klv_0903_vtarget_pack const& pack, column_builder& builder )
+{
+  auto const& set = pack.set;
+  target_fields target;
+  target.id = pack.id;
+
+  auto const get_uint =
+    [ & ]( klv_lds_key tag ) -> uint64_t {
+      auto const value = find_value< uint64_t >( set, tag );
+      return value ? *value : 0;
+    };
+  target.centroid = get_uint( KLV_0903_VTARGET_CENTROID );
+  target.top_left = get_uint( KLV_0903_VTARGET_BOUNDARY_TOP_LEFT );
+  target.bottom_right = get_uint( KLV_0903_VTARGET_BOUNDARY_BOTTOM_RIGHT );
+  target.centroid_row = get_uint( KLV_0903_VTARGET_CENTROID_ROW );
+  target.centroid_column = get_uint( KLV_0903_VTARGET_CENTROID_COLUMN );
+
+  if( auto const confidence =
+        find_value< uint64_t >( set, KLV_0903_VTARGET_CONFIDENCE_LEVEL ) )
+  {
+    target.confidence = *confidence / 100.0;
+  }
+
+  if( auto const mask =
+        find_value< klv_local_set >( set, KLV_0903_VTARGET_VMASK ) )
+  {
+    if( auto const polygon =
+          find_value< std::vector< uint64_t > >(
+            *mask, KLV_0903_VMASK_POLYGON ) )
+    {
+      target.polygon = *polygon;
+    }
+  }
+
+  if( auto const object =
+        find_value< klv_local_set >( set, KLV_0903_VTARGET_VOBJECT ) )
+  {
+    read_vobject( *object, target );
+  }
+
+  if( auto const objects =
+        find_value< std::vector< klv_local_set > >(
+          set, KLV_0903_VTARGET_VOBJECT_SERIES ) )
+  {
+    for( auto const& object : *objects )
+    {
+      read_vobject( object, target );
+    }
+  }
+
+  builder.append( target );
+}
+
+// ----------------------------------------------------------------------------
+// Zero-based index of the pixel containing coordinate x, clamped to the
+// frame if its size is known.
+uint64_t
+pixel_index( double x, uint64_t size )
+{
+  if( !( x >= 0.0 ) )
+  {
+    return 0;
+  }
+
+  auto const result = static_cast< uint64_t >( x );
+  return ( size && result >= size ) ? size - 1 : result;
+}
+
+// ----------------------------------------------------------------------------
+// Values of the tags written for one target.
+struct target_entries
+{
+  uint64_t id;
+  uint64_t centroid;
+  uint64_t top_left;
+  uint64_t bottom_right;
+  uint64_t confidence;
+  bool has_confidence;
+  std::string const* class_name;
+  double class_score;
+};
+
+// ----------------------------------------------------------------------------
+target_entries
+make_target_entries( klv_0903_detections const& value, size_t i )
+{
+  auto const width = value.frame_width;
+  auto const height = value.frame_height;
+  auto const pixel_number =
+    [ width ]( uint64_t row, uint64_t column ){
+      return row * width + column + 1;
+    };
+
+  auto const min_column = pixel_index( value.min_x[ i ], width );
+  auto const min_row = pixel_index( value.min_y[ i ], height );
+  auto const max_column =
+    std::max( min_column, pixel_index( std::ceil( value.max_x[ i ] ) - 1.0,
+                                       width ) );
+  auto const max_row =
+    std::max( min_row, pixel_index( std::ceil( value.max_y[ i ] ) - 1.0,
+                                    height ) );
+
+  target_entries result;
+  result.id = value.id[ i ];
+  result.centroid =
+    pixel_number( ( min_row + max_row ) / 2, ( min_column + max_column ) / 2 );
+  result.top_left = pixel_number( min_row, min_column );
+  result.bottom_right = pixel_number( max_row, max_column );
+
+  auto const confidence = value.confidence[ i ];
+  result.has_confidence = !std::isnan( confidence );
+  result.confidence =
+    result.has_confidence
+    ? static_cast< uint64_t >(
+        std::round( std::min( std::max( confidence, 0.0 ), 1.0 ) * 100.0 ) )
+    : 0;
+
+  auto const class_index = value.class_index[ i ];
+  result.class_name =
+    ( class_index < value.class_names.size() &&
+      !value.class_names[ class_index ].empty() )
+    ? &value.class_names[ class_index ]
+    : nullptr;
+  result.class_score = value.class_score[ i ];
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+uint_length( uint64_t value )
+{
+  return std::max< size_t >( klv_int_length( value ), 1 );
+}
+
+// ----------------------------------------------------------------------------
+size_t
+entry_length( klv_lds_key tag, size_t length_of_value )
+{
+  return klv_ber_oid_length( tag ) + klv_ber_length( length_of_value ) +
+         length_of_value;
+}
+
+// ----------------------------------------------------------------------------
+void
+write_entry_header( klv_lds_key tag, size_t length_of_value,
+                    klv_write_iter_t& data, size_t max_length )
+{
+  auto const tracker = track_it( data, max_length );
+  klv_write_ber_oid( tag, data, tracker.remaining() );
+  klv_write_ber( length_of_value, data, tracker.remaining() );
+  tracker.verify( length_of_value );
+}
+
+// ----------------------------------------------------------------------------
+void
+write_uint_entry( klv_lds_key tag, uint64_t value, size_t length_of_value,
+                  klv_write_iter_t& data, size_t max_length )
+{
+  auto const tracker = track_it( data, max_length );
+  write_entry_header( tag, length_of_value, data, tracker.remaining() );
+  klv_write_int( value, data, length_of_value );
+}
+
+// ----------------------------------------------------------------------------
+size_t
+vobject_length( target_entries const& target )
+{
+  return entry_length( KLV_0903_VOBJECT_ONTOLOGY_CLASS,
+                       klv_string_length( *target.class_name ) ) +
+         ( std::isnan( target.class_score )
+           ? 0
+           : entry_length( KLV_0903_VOBJECT_CONFIDENCE,
+                           object_confidence_length ) );
+}
+
+// ----------------------------------------------------------------------------
+// Length of the vTarget pack, without the series item length
+size_t
+vtarget_length( target_entries const& target )
+{
+  auto result =
+    klv_ber_oid_length( target.id ) +
+    entry_length( KLV_0903_VTARGET_CENTROID,
+                  uint_length( target.centroid ) ) +
+    entry_length( KLV_0903_VTARGET_BOUNDARY_TOP_LEFT,
+                  uint_length( target.top_left ) ) +
+    entry_length( KLV_0903_VTARGET_BOUNDARY_BOTTOM_RIGHT,
+                  uint_length( target.bottom_right ) );
+  if( target.has_confidence )
+  {
+    result += entry_length( KLV_0903_VTARGET_CONFIDENCE_LEVEL, 1 );
+  }
+  if( target.class_name )
+  {
+    result += entry_length( KLV_0903_VTARGET_VOBJECT,
+                            vobject_length( target ) );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+void
+write_vtarget( target_entries const& target, klv_write_iter_t& data,
+               size_t max_length )
+{
+  auto const tracker = track_it( data, max_length );
+  klv_write_ber_oid( target.id, data, tracker.remaining() );
+  write_uint_entry( KLV_0903_VTARGET_CENTROID, target.centroid,
+                    uint_length( target.centroid ),
+                    data, tracker.remaining() );
+  write_uint_entry( KLV_0903_VTARGET_BOUNDARY_TOP_LEFT, target.top_left,
+                    uint_length( target.top_left ),
+                    data, tracker.remaining() );
+  write_uint_entry( KLV_0903_VTARGET_BOUNDARY_BOTTOM_RIGHT,
+                    target.bottom_right, uint_length( target.bottom_right ),
+                    data, tracker.remaining() );
+  if( target.has_confidence )
+  {
+    write_uint_entry( KLV_0903_VTARGET_CONFIDENCE_LEVEL, target.confidence, 1,
+                      data, tracker.remaining() );
+  }
+  if( target.class_name )
+  {
+    write_entry_header( KLV_0903_VTARGET_VOBJECT, vobject_length( target ),
+                        data, tracker.remaining() );
+
+    auto const length_of_name = klv_string_length( *target.class_name );
+    write_entry_header( KLV_0903_VOBJECT_ONTOLOGY_CLASS, length_of_name,
+                        data, tracker.remaining() );
+    klv_write_string( *target.class_name, data, length_of_name );
+
+    if( !std::isnan( target.class_score ) )
+    {
+      write_entry_header( KLV_0903_VOBJECT_CONFIDENCE,
+                          object_confidence_length,
+                          data, tracker.remaining() );
+      klv_write_imap(
+        std::min( std::max( target.class_score, 0.0 ), 1.0 ) * 100.0,
+        object_confidence_interval(), data, object_confidence_length );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+std::vector< target_entries >
+make_all_target_entries( klv_0903_detections const& value )
+{
+  std::vector< target_entries > result;
+  result.reserve( value.size() );
+  for( size_t i = 0; i < value.size(); ++i )
+  {
+    result.push_back( make_target_entries( value, i ) );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+// Length of the vTarget series, without its tag and length
+size_t
+vtarget_series_length( std::vector< target_entries > const& targets )
+{
+  size_t result = 0;
+  for( auto const& target : targets )
+  {
+    auto const length_of_item = vtarget_length( target );
+    result += klv_ber_length( length_of_item ) + length_of_item;
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+detections_length( klv_0903_detections const& value,
+                   size_t length_of_series )
+{
+  auto const count = static_cast< uint64_t >( value.size() );
+  auto result =
+    entry_length( KLV_0903_PRECISION_TIMESTAMP, timestamp_length ) +
+    entry_length( KLV_0903_VERSION, uint_length( vmti_version ) ) +
+    entry_length( KLV_0903_NUM_TARGETS_DETECTED, uint_length( count ) ) +
+    entry_length( KLV_0903_NUM_TARGETS_REPORTED, uint_length( count ) );
+  if( value.frame_width )
+  {
+    result += entry_length( KLV_0903_FRAME_WIDTH,
+                            uint_length( value.frame_width ) );
+  }
+  if( value.frame_height )
+  {
+    result += entry_length( KLV_0903_FRAME_HEIGHT,
+                            uint_length( value.frame_height ) );
+  }
+  if( count )
+  {
+    result += entry_length( KLV_0903_VTARGET_SERIES, length_of_series );
+  }
+  return result;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+constexpr size_t klv_0903_detections::no_class;
+
+// ----------------------------------------------------------------------------
+void
+klv_0903_detections
+::clear()
+{
+  timestamp = 0;
+  frame_width = 0;
+  frame_height = 0;
+  id.clear();
+  min_x.clear();
+  min_y.clear();
+  max_x.clear();
+  max_y.clear();
+  confidence.clear();
+  class_index.clear();
+  class_score.clear();
+}
+
+// ----------------------------------------------------------------------------
+void
+klv_0903_read_detections( klv_read_iter_t& data, size_t length,
+                          klv_0903_detections& result )
+{
+  result.clear();
+
+  // Target pixel numbers depend on the frame width, which may come after the
+  // targets, so the frame fields are found first
+  klv_read_iter_t series = nullptr;
+  size_t length_of_series = 0;
+  for_each_entry(
+    data, length,
+    [ & ]( klv_lds_key tag, klv_read_iter_t value, size_t length_of_value ){
+      switch( tag )
+      {
+        case KLV_0903_PRECISION_TIMESTAMP:
+          result.timestamp =
+            klv_read_int< uint64_t >( value, length_of_value );
+          break;
+        case KLV_0903_FRAME_WIDTH:
+          result.frame_width =
+            klv_read_int< uint64_t >( value, length_of_value );
+          break;
+        case KLV_0903_FRAME_HEIGHT:
+          result.frame_height =
+            klv_read_int< uint64_t >( value, length_of_value );
+          break;
+        case KLV_0903_VTARGET_SERIES:
+          series = value;
+          length_of_series = length_of_value;
+          break;
+        default:
+          break;
+      }
+    } );
+
+  if( series )
+  {
+    column_builder builder{ result };
+    for_each_item(
+      series, length_of_series,
+      [ & ]( klv_read_iter_t item, size_t length_of_item ){
+        read_vtarget( item, length_of_item, builder );
+      } );
+  }
+
+  data += length;
+}
+
+// ----------------------------------------------------------------------------
+void
+klv_0903_read_detections( klv_local_set const& set,
+                          klv_0903_detections& result )
+{
+  result.clear();
+
+  if( auto const timestamp =
+        find_value< uint64_t >( set, KLV_0903_PRECISION_TIMESTAMP ) )
+  {
+    result.timestamp = *timestamp;
+  }
+  if( auto const width = find_value< uint64_t >( set, KLV_0903_FRAME_WIDTH ) )
+  {
+    result.frame_width = *width;
+  }
+  if( auto const height =
+        find_value< uint64_t >( set, KLV_0903_FRAME_HEIGHT ) )
+  {
+    result.frame_height = *height;
+  }
+
+  if( auto const series =
+        find_value< std::vector< klv_0903_vtarget_pack > >(
+          set, KLV_0903_VTARGET_SERIES ) )
+  {
+    column_builder builder{ result };
+    for( auto const& pack : *series )
+    {
+      read_vtarget( pack, builder );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+size_t
+klv_0903_detections_length( klv_0903_detections const& value )
+{
+  return detections_length(
+    value, vtarget_series_length( make_all_target_entries( value ) ) );
+}
+
+// ----------------------------------------------------------------------------
+void
+klv_0903_write_detections( klv_0903_detections const& value,
+                           klv_write_iter_t& data, size_t max_length )
+{
+  if( value.size() && !value.frame_width )
+  {
+    VITAL_THROW( kv::metadata_exception,
+                 "ST0903 targets cannot be written without a frame width" );
+  }
+
+  auto const targets = make_all_target_entries( value );
+  auto const length_of_series = vtarget_series_length( targets );
+  if( detections_length( value, length_of_series ) > max_length )
+  {
+    VITAL_THROW( kv::metadata_buffer_overflow,
+                 "writing ST0903 detections overflows buffer" );
+  }
+
+  auto const tracker = track_it( data, max_length );
+  auto const count = static_cast< uint64_t >( value.size() );
+  write_uint_entry( KLV_0903_PRECISION_TIMESTAMP, value.timestamp,
+                    timestamp_length, data, tracker.remaining() );
+  write_uint_entry( KLV_0903_VERSION, vmti_version,
+                    uint_length( vmti_version ), data, tracker.remaining() );
+  write_uint_entry( KLV_0903_NUM_TARGETS_DETECTED, count,
+                    uint_length( count ), data, tracker.remaining() );
+  write_uint_entry( KLV_0903_NUM_TARGETS_REPORTED, count,
+                    uint_length( count ), data, tracker.remaining() );
+  if( value.frame_width )
+  {
+    write_uint_entry( KLV_0903_FRAME_WIDTH, value.frame_width,
+                      uint_length( value.frame_width ),
+                      data, tracker.remaining() );
+  }
+  if( value.frame_height )
+  {
+    write_uint_entry( KLV_0903_FRAME_HEIGHT, value.frame_height,
+                      uint_length( value.frame_height ),
+                      data, tracker.remaining() );
+  }
+  if( !count )
+  {
+    return;
+  }
+
+  write_entry_header( KLV_0903_VTARGET_SERIES, length_of_series,
+                      data, tracker.remaining() );
+  for( auto const& target : targets )
+  {
+    auto const length_of_item = vtarget_length( target );
+    klv_write_ber( length_of_item, data, tracker.remaining() );
+    write_vtarget( target, data, tracker.verify( length_of_item ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+klv_packet
+klv_0903_detections_packet( klv_0903_detections const& value )
+{
+  klv_bytes_t bytes( klv_0903_detections_length( value ) );
+  auto it = bytes.data();
+  klv_0903_write_detections( value, it, bytes.size() );
+  return { klv_0903_key(), klv_blob{ bytes } };
+}
+
+// ----------------------------------------------------------------------------
+kv::detected_object_set_sptr
+klv_0903_to_detected_object_set( klv_0903_detections const& value )
+{
+  std::vector< kv::detected_object_sptr > objects;
+  objects.reserve( value.size() );
+  for( size_t i = 0; i < value.size(); ++i )
+  {
+    kv::detected_object_type_sptr type;
+    auto const class_index = value.class_index[ i ];
+    if( class_index < value.class_names.size() )
+    {
+      auto const score = value.class_score[ i ];
+      type = std::make_shared< kv::detected_object_type >(
+        value.class_names[ class_index ], std::isnan( score ) ? 1.0 : score );
+    }
+
+    auto const confidence = value.confidence[ i ];
+    auto const object =
+      std::make_shared< kv::detected_object >(
+        kv::bounding_box_d{ value.min_x[ i ], value.min_y[ i ],
+                            value.max_x[ i ], value.max_y[ i ] },
+        std::isnan( confidence ) ? 1.0 : confidence, type );
+    object->set_index( value.id[ i ] );
+    objects.push_back( object );
+  }
+  return std::make_shared< kv::detected_object_set >( objects );
+}
+
+// ----------------------------------------------------------------------------
+void
+klv_0903_from_detected_object_set( kv::detected_object_set const& set,
+                                   klv_0903_detections& result )
+{
+  result.id.clear();
+  result.min_x.clear();
+  result.min_y.clear();
+  result.max_x.clear();
+  result.max_y.clear();
+  result.confidence.clear();
+  result.class_index.clear();
+  result.class_score.clear();
+
+  column_builder builder{ result };
+  for( size_t i = 0; i < set.size(); ++i )
+  {
+    auto const object = set.at( i );
+    if( !object )
+    {
+      continue;
+    }
+
+    auto const box = object->bounding_box();
+    result.id.push_back( object->index() ? object->index() : i + 1 );
+    result.min_x.push_back( box.min_x() );
+    result.min_y.push_back( box.min_y() );
+    result.max_x.push_back( box.max_x() );
+    result.max_y.push_back( box.max_y() );
+    result.confidence.push_back( object->confidence() );
+
+    std::string name;
+    double score = nan;
+    auto const type = object->type();
+    if( type && type->size() )
+    {
+      type->get_most_likely( name, score );
+    }
+    result.class_index.push_back(
+      name.empty() ? klv_0903_detections::no_class
+                   : builder.class_index( name ) );
+    result.class_score.push_back( score );
+  }
+}
+
+} // namespace klv
+
+} // namespace arrows
+
+} // namespace kwiver
@@ -0,0 +1,172 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Declaration of direct conversion between ST0903 VMTI and detections.
+
+#ifndef KWIVER_ARROWS_KLV_KLV_0903_DETECTIONS_H_
+#define KWIVER_ARROWS_KLV_KLV_0903_DETECTIONS_H_
+
+#include <arrows/klv/kwiver_algo_klv_export.h>
+
+#include <arrows/klv/klv_packet.h>
+#include <arrows/klv/klv_set.h>
+
+#include <vital/types/detected_object_set.h>
+
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace klv {
+
+// ----------------------------------------------------------------------------
+/// Image-space detections of one ST0903 VMTI local set, stored by column.
+///
+/// Only the fields needed to locate and classify each target are kept. Boxes
+/// are in pixel coordinates with the top left corner of the image at (0, 0);
+/// a target boundary covering pixel columns 2 to 5 therefore spans
+/// \c min_x = 2 to \c max_x = 6.
+struct KWIVER_ALGO_KLV_EXPORT klv_0903_detections
+{
+  /// Value of \c class_index for targets with no class.
+  static constexpr size_t no_class = std::numeric_limits< size_t >::max();
+
+  /// Number of targets.
+  size_t size() const { return id.size(); }
+
+  /// Remove all targets and reset the frame fields.
+  ///
+  /// \c class_names is kept, so that class indices stay the same across the
+  /// frames of a stream.
+  void clear();
+
+  /// MISP precision timestamp, or zero if not known.
+  uint64_t timestamp = 0;
+
+  /// Frame size in pixels, or zero if not known.
+  uint64_t frame_width = 0;
+  uint64_t frame_height = 0;
+
+  /// \name Columns indexed by target
+  ///@{
+  std::vector< uint64_t > id;
+  std::vector< double > min_x;
+  std::vector< double > min_y;
+  std::vector< double > max_x;
+  std::vector< double > max_y;
+
+  /// Detection confidence in [0, 1], or NaN if not given.
+  std::vector< double > confidence;
+
+  /// Index into \c class_names of the most likely class, or \c no_class.
+  std::vector< size_t > class_index;
+
+  /// Confidence in [0, 1] of the most likely class, or NaN if not given.
+  std::vector< double > class_score;
+  ///@}
+
+  /// Ontology class names referred to by \c class_index.
+  std::vector< std::string > class_names;
+};
+
+// ----------------------------------------------------------------------------
+/// Read the detections of an ST0903 local set directly from its bytes.
+///
+/// This is equivalent to parsing the set with \c klv_0903_local_set_format and
+/// calling the \c klv_local_set overload, but only the target location,
+/// confidence and object tags are decoded; all other tags, including masks
+/// other than polygons, features, trackers and chips, are skipped over
+/// without being parsed. Targets whose location cannot be decoded, such as
+/// those given by pixel number in a set with no frame width, are left out.
+///
+/// \param[in,out] data Iterator to the bytes of the local set, without the
+/// packet key or length. Set to the end of the set on success.
+/// \param length Number of bytes in the local set.
+/// \param[out] result Detections read. Cleared first.
+///
+/// \throws metadata_exception If the set is malformed.
+KWIVER_ALGO_KLV_EXPORT
+void
+klv_0903_read_detections( klv_read_iter_t& data, size_t length,
+                          klv_0903_detections& result );
+
+// ----------------------------------------------------------------------------
+/// Read the detections of a parsed ST0903 local set.
+///
+/// Only the tags listed for the byte overload are accessed, so unused
+/// subsets of a deferred set are never parsed.
+KWIVER_ALGO_KLV_EXPORT
+void
+klv_0903_read_detections( klv_local_set const& set,
+                          klv_0903_detections& result );
+
+// ----------------------------------------------------------------------------
+/// Return the number of bytes in the ST0903 local set written for \p value.
+KWIVER_ALGO_KLV_EXPORT
+size_t
+klv_0903_detections_length( klv_0903_detections const& value );
+
+// ----------------------------------------------------------------------------
+/// Write \p value as the bytes of an ST0903 local set.
+///
+/// The set holds the timestamp, version, target counts, frame size and one
+/// vTarget pack per detection with its centroid, boundary, confidence and
+/// most likely class. The checksum is left to \c klv_write_packet.
+///
+/// \param value Detections to write.
+/// \param[in,out] data Iterator to the output buffer. Set to the end of the
+/// written bytes on success.
+/// \param max_length Size of the output buffer.
+///
+/// \throws metadata_buffer_overflow If the set does not fit in
+/// \p max_length bytes.
+/// \throws metadata_exception If \p value has targets but no frame width,
+/// which is needed to number the pixels.
+KWIVER_ALGO_KLV_EXPORT
+void
+klv_0903_write_detections( klv_0903_detections const& value,
+                           klv_write_iter_t& data, size_t max_length );
+
+// ----------------------------------------------------------------------------
+/// Create an ST0903 packet holding \p value.
+///
+/// The packet value is the set's bytes, which \c klv_write_packet writes
+/// as is, so the vTarget packs are never built as \c klv_local_set objects.
+KWIVER_ALGO_KLV_EXPORT
+klv_packet
+klv_0903_detections_packet( klv_0903_detections const& value );
+
+// ----------------------------------------------------------------------------
+/// Create a detected object set from \p value.
+///
+/// The index of each detected object is its target ID. Targets with no
+/// confidence get a confidence of one.
+KWIVER_ALGO_KLV_EXPORT
+kwiver::vital::detected_object_set_sptr
+klv_0903_to_detected_object_set( klv_0903_detections const& value );
+
+// ----------------------------------------------------------------------------
+/// Fill the target columns of \p result from \p set.
+///
+/// Target IDs are the detected object indices, or the one-based position of
+/// each object in \p set for objects with an index of zero. The frame fields
+/// of \p result are left as they are, and should be set by the caller.
+KWIVER_ALGO_KLV_EXPORT
+void
+klv_0903_from_detected_object_set(
+  kwiver::vital::detected_object_set const& set,
+  klv_0903_detections& result );
+
+} // namespace klv
+
+} // namespace arrows
+
+} // namespace kwiver
+
+#endif
@@ -178,7 +178,14 @@ ::read_typed( klv_read_iter_t& data, size_t length ) const
   }
 
   // Read correlations
-  if( result.rho_length )
+  if( result.rho_length && !result.sparse && result.rho_uses_imap )
+  {
+    // Dense IMAP correlations all share one specification
+    tracker.verify( rho_count * result.rho_length );
+    result.rho =
+      klv_read_imap_n( { -1.0, 1.0 }, data, result.rho_length, rho_count );
+  }
+  else if( result.rho_length )
   {
     for( auto const i : kvr::iota< size_t >( rho_count ) )
     {
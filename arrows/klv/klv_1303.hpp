@@ -15,6 +15,7 @@
 #include <vital/range/iota.h>
 
 #include <numeric>
+#include <type_traits>
 
 namespace kv = kwiver::vital;
 namespace kvr = kwiver::vital::range;
@@ -135,6 +136,18 @@ klv_1303_mdap_format< Format >
   }
 
   // Array data elements
+  if( result.apa == KLV_1303_APA_IMAP &&
+      std::is_same< element_t, double >::value && result.element_size &&
+      length_of_array <= tracker.remaining() / result.element_size )
+  {
+    // Decode the whole array at once, sharing the IMAP terms
+    auto const elements =
+      klv_read_imap_n( *result.imap_params, data,
+                       result.element_size, length_of_array );
+    result.elements.assign( elements.begin(), elements.end() );
+    return result;
+  }
+
   result.elements.reserve( length_of_array );
   for( size_t i = 0; i < length_of_array; ++i )
   {
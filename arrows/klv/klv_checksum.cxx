@@ -8,8 +8,6 @@
 #include "klv_checksum.h"
 
 #include <iomanip>
-#include <numeric>
-#include <vector>
 
 #include <cstddef>
 
@@ -21,20 +19,108 @@ namespace arrows {
 
 namespace klv {
 
+namespace {
+
+// Number of bytes consumed per step of the sliced CRC loops
+constexpr size_t crc_slice_count = 8;
+
+// ----------------------------------------------------------------------------
+// Lookup tables for a most-significant-bit-first CRC of \c T's width.
+//
+// Entry [ k ][ b ] holds the CRC contribution of byte b followed by k zero
+// bytes, which lets the main loops fold eight input bytes in per step
+// ("slicing-by-8") instead of shifting in one bit at a time.
+template < class T >
+struct crc_tables
+{
+  explicit crc_tables( T polynomial )
+  {
+    constexpr auto shift = sizeof( T ) * 8 - 8;
+    constexpr auto high_bit = static_cast< T >( T{ 1 } << ( shift + 7 ) );
+    for( size_t byte = 0; byte < 256; ++byte )
+    {
+      auto crc = static_cast< T >( byte << shift );
+      for( size_t i = 0; i < 8; ++i )
+      {
+        crc = ( crc & high_bit )
+              ? static_cast< T >( ( crc << 1 ) ^ polynomial )
+              : static_cast< T >( crc << 1 );
+      }
+      table[ 0 ][ byte ] = crc;
+    }
+    for( size_t k = 1; k < crc_slice_count; ++k )
+    {
+      for( size_t byte = 0; byte < 256; ++byte )
+      {
+        auto const prev = table[ k - 1 ][ byte ];
+        table[ k ][ byte ] =
+          static_cast< T >( ( prev << 8 ) ^ table[ 0 ][ prev >> shift ] );
+      }
+    }
+  }
+
+  // Fold a single byte into the CRC
+  T
+  step( T crc, uint8_t byte ) const
+  {
+    constexpr auto shift = sizeof( T ) * 8 - 8;
+    return static_cast< T >(
+      ( crc << 8 ) ^ table[ 0 ][ ( ( crc >> shift ) ^ byte ) & 0xFF ] );
+  }
+
+  T table[ crc_slice_count ][ 256 ];
+};
+
+// ----------------------------------------------------------------------------
+crc_tables< uint16_t > const&
+crc_16_ccitt_tables()
+{
+  static crc_tables< uint16_t > const tables{ 0x1021 };
+  return tables;
+}
+
+// ----------------------------------------------------------------------------
+crc_tables< uint32_t > const&
+crc_32_mpeg_tables()
+{
+  static crc_tables< uint32_t > const tables{ 0x04C11DB7 };
+  return tables;
+}
+
+} // namespace <anonymous>
+
 // ----------------------------------------------------------------------------
 uint16_t
 klv_running_sum_16( klv_read_iter_t data_begin, klv_read_iter_t data_end,
                     uint16_t initial_value, bool parity )
 {
-  // Counter to check even / odd byte
-  size_t i = parity;
-  auto accumulator =
-    [ &i ]( uint16_t sum, uint8_t byte ) -> uint16_t {
-      uint16_t const new_value = ( ++i % 2 ) ? ( byte << 8 ) : byte;
-      return sum + new_value;
-    };
+  auto it = data_begin;
 
-  return std::accumulate( data_begin, data_end, initial_value, accumulator );
+  // An odd parity means the first byte is the low half of a word
+  uint16_t sum = initial_value;
+  if( parity && it != data_end )
+  {
+    sum += *it++;
+  }
+
+  // Sum whole words in a wide accumulator; only the low 16 bits matter, and
+  // the simple loop body lets the compiler vectorize it
+  uint64_t wide_sum = 0;
+  auto const word_count = static_cast< size_t >( data_end - it ) / 2;
+  for( size_t i = 0; i < word_count; ++i )
+  {
+    wide_sum += ( static_cast< uint64_t >( it[ 2 * i ] ) << 8 ) |
+                it[ 2 * i + 1 ];
+  }
+  it += word_count * 2;
+  sum += static_cast< uint16_t >( wide_sum );
+
+  // A trailing odd byte is the high half of a word
+  if( it != data_end )
+  {
+    sum += static_cast< uint16_t >( *it << 8 );
+  }
+  return sum;
 }
 
 // ----------------------------------------------------------------------------
@@ -42,30 +128,33 @@ uint16_t
 klv_crc_16_ccitt( klv_read_iter_t data_begin, klv_read_iter_t data_end,
                   uint16_t initial_value )
 {
-  // Based on http://srecord.sourceforge.net/crc16-ccitt.html
-  auto accumulator =
-    []( uint16_t crc, uint8_t byte ) -> uint16_t {
-      constexpr uint16_t polynomial = 0x1021;
-      for( size_t i = 0; i < 8; ++i )
-      {
-        bool const high_bit = crc & 0x8000;
-        crc <<= 1;
-        crc += static_cast< bool >( byte & ( 1 << ( 7 - i ) ) );
-        if( high_bit )
-        {
-          crc ^= polynomial;
-        }
-      }
-      return crc;
-    };
-
-  // CRC of given data
-  auto crc =
-    std::accumulate( data_begin, data_end, initial_value, accumulator );
+  // Based on http://srecord.sourceforge.net/crc16-ccitt.html. That algorithm
+  // shifts message bits in and then appends 16 zero bits; the table-driven
+  // form below is equivalent once those zero bits are pushed through the
+  // initial value instead
+  auto crc = initial_value;
+  for( size_t i = 0; i < 16; ++i )
+  {
+    crc = ( crc & 0x8000 ) ? ( ( crc << 1 ) ^ 0x1021 ) : ( crc << 1 );
+  }
 
-  // Proper CRC-16 pads input with 16 bits of zeros at the end
-  std::vector< uint8_t > const padding = { 0x00, 0x00 };
-  return std::accumulate( padding.cbegin(), padding.cend(), crc, accumulator );
+  auto const& tables = crc_16_ccitt_tables();
+  auto const& t = tables.table;
+  auto it = data_begin;
+  for(; data_end - it >= static_cast< ptrdiff_t >( crc_slice_count );
+      it += crc_slice_count )
+  {
+    crc = t[ 7 ][ ( ( crc >> 8 ) ^ it[ 0 ] ) & 0xFF ] ^
+          t[ 6 ][ ( crc ^ it[ 1 ] ) & 0xFF ] ^
+          t[ 5 ][ it[ 2 ] ] ^ t[ 4 ][ it[ 3 ] ] ^
+          t[ 3 ][ it[ 4 ] ] ^ t[ 2 ][ it[ 5 ] ] ^
+          t[ 1 ][ it[ 6 ] ] ^ t[ 0 ][ it[ 7 ] ];
+  }
+  for(; it != data_end; ++it )
+  {
+    crc = tables.step( crc, *it );
+  }
+  return crc;
 }
 
 // ----------------------------------------------------------------------------
@@ -73,24 +162,27 @@ uint32_t
 klv_crc_32_mpeg( klv_read_iter_t data_begin, klv_read_iter_t data_end,
                  uint32_t initial_value )
 {
-  auto accumulator =
-    []( uint32_t crc, uint8_t byte ) -> uint32_t {
-      constexpr uint32_t polynomial = 0x04C11DB7;
-      crc ^= static_cast< uint32_t >( byte ) << 24;
-      for( size_t i = 0; i < 8; ++i )
-      {
-        bool const high_bit = crc & 0x80000000;
-        crc <<= 1;
-        if( high_bit )
-        {
-          crc ^= polynomial;
-        }
-      }
-      return crc;
-    };
-
-  // CRC of given data
-  return std::accumulate( data_begin, data_end, initial_value, accumulator );
+  auto const& tables = crc_32_mpeg_tables();
+  auto const& t = tables.table;
+  auto crc = initial_value;
+  auto it = data_begin;
+  for(; data_end - it >= static_cast< ptrdiff_t >( crc_slice_count );
+      it += crc_slice_count )
+  {
+    auto const high = crc ^ ( static_cast< uint32_t >( it[ 0 ] ) << 24 |
+                              static_cast< uint32_t >( it[ 1 ] ) << 16 |
+                              static_cast< uint32_t >( it[ 2 ] ) << 8 |
+                              static_cast< uint32_t >( it[ 3 ] ) );
+    crc = t[ 7 ][ high >> 24 ] ^ t[ 6 ][ ( high >> 16 ) & 0xFF ] ^
+          t[ 5 ][ ( high >> 8 ) & 0xFF ] ^ t[ 4 ][ high & 0xFF ] ^
+          t[ 3 ][ it[ 4 ] ] ^ t[ 2 ][ it[ 5 ] ] ^
+          t[ 1 ][ it[ 6 ] ] ^ t[ 0 ][ it[ 7 ] ];
+  }
+  for(; it != data_end; ++it )
+  {
+    crc = tables.step( crc, *it );
+  }
+  return crc;
 }
 
 // ----------------------------------------------------------------------------
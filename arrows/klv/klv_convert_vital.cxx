@@ -30,6 +30,9 @@ namespace {
 
 // ----------------------------------------------------------------------------
 using kld = klv_lengthy< double >;
+using direct_map_t =
+  std::vector< std::pair< klv_lds_key, kv::vital_metadata_tag > >;
+
 struct klv_to_vital_visitor
 {
   template < class T,
@@ -89,50 +92,41 @@ assemble_geo_point( klv_value const& latitude,
 // to enforce precedence of e.g. newer or more precise tags over deprecated or
 // less precise ones
 kv::optional< kv::geo_point >
-parse_geo_point( klv_timeline const& klv_data,
+parse_geo_point( klv_timeline_cursor& klv_data,
                  klv_top_level_tag standard,
                  uint64_t timestamp,
-                 std::vector< klv_lds_key > const& latitude_tags,
-                 std::vector< klv_lds_key > const& longitude_tags,
-                 std::vector< klv_lds_key > const& elevation_tags )
+                 std::initializer_list< klv_lds_key > latitude_tags,
+                 std::initializer_list< klv_lds_key > longitude_tags,
+                 std::initializer_list< klv_lds_key > elevation_tags )
 {
-  klv_value latitude;
-  for( auto const tag : latitude_tags )
-  {
-    latitude = klv_data.at( standard, tag, timestamp );
-    if( latitude.valid() )
-    {
-      break;
-    }
-  }
+  // Return the first valid value of the given tags
+  auto const first_valid =
+    [ & ]( std::initializer_list< klv_lds_key > tags ) -> klv_value const& {
+      static klv_value const empty;
+      for( auto const tag : tags )
+      {
+        auto const& value = klv_data.at( standard, tag, timestamp );
+        if( value.valid() )
+        {
+          return value;
+        }
+      }
+      return empty;
+    };
+
+  auto const& latitude = first_valid( latitude_tags );
   if( !latitude.valid() )
   {
     return kv::nullopt;
   }
 
-  klv_value longitude;
-  for( auto const tag : longitude_tags )
-  {
-    longitude = klv_data.at( standard, tag, timestamp );
-    if( longitude.valid() )
-    {
-      break;
-    }
-  }
+  auto const& longitude = first_valid( longitude_tags );
   if( !longitude.valid() )
   {
     return kv::nullopt;
   }
 
-  klv_value elevation;
-  for( auto const tag : elevation_tags )
-  {
-    elevation = klv_data.at( standard, tag, timestamp );
-    if( elevation.valid() )
-    {
-      break;
-    }
-  }
+  auto const& elevation = first_valid( elevation_tags );
 
   return assemble_geo_point( latitude, longitude, elevation );
 }
@@ -140,12 +134,12 @@ parse_geo_point( klv_timeline const& klv_data,
 // ----------------------------------------------------------------------------
 void
 klv_0104_parse_datetime_to_unix(
-  klv_timeline const& klv_data, uint64_t timestamp, kv::metadata& vital_data,
+  klv_timeline_cursor& klv_data, uint64_t timestamp, kv::metadata& vital_data,
   klv_lds_key klv_tag, kv::vital_metadata_tag vital_tag )
 {
   constexpr auto standard = KLV_PACKET_MISB_0104_UNIVERSAL_SET;
 
-  auto const datetime = klv_data.at( standard, klv_tag, timestamp );
+  auto const& datetime = klv_data.at( standard, klv_tag, timestamp );
   if( datetime.valid() )
   {
     try
@@ -164,7 +158,7 @@ klv_0104_parse_datetime_to_unix(
 
 // ----------------------------------------------------------------------------
 void
-klv_0102_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
+klv_0102_to_vital_metadata( klv_timeline_cursor& klv_data, uint64_t timestamp,
                             kv::metadata& vital_data )
 {
   constexpr auto standard = KLV_PACKET_MISB_0102_LOCAL_SET;
@@ -173,21 +167,21 @@ klv_0102_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
   vital_data.add< kv::VITAL_META_UNIX_TIMESTAMP >( timestamp );
 
   // Check if there is a ST0102 embedded in ST0601
-  auto const st0601 =
+  auto const& st0601 =
     klv_data.at( KLV_PACKET_MISB_0601_LOCAL_SET,
                  KLV_0601_SECURITY_LOCAL_SET, timestamp );
 
   // Get the tag from any ST0102 source
   auto const get_tag_value =
-    [ & ]( klv_0102_tag tag ){
-      auto result = klv_data.at( standard, tag, timestamp );
+    [ & ]( klv_0102_tag tag ) -> klv_value const& {
+      auto const& result = klv_data.at( standard, tag, timestamp );
       if( !result.valid() && st0601.valid() )
       {
         auto const& st0601_set = st0601.get< klv_local_set >();
         auto const it = st0601_set.find( tag );
         if( it != st0601_set.end() )
         {
-          result = it->second;
+          return it->second;
         }
       }
       return result;
@@ -195,7 +189,7 @@ klv_0102_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
 
   // Convert the security classification to a string
   {
-    auto const value = get_tag_value( KLV_0102_SECURITY_CLASSIFICATION );
+    auto const& value = get_tag_value( KLV_0102_SECURITY_CLASSIFICATION );
     if( value.valid() )
     {
       std::stringstream ss;
@@ -207,7 +201,7 @@ klv_0102_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
 
 // ----------------------------------------------------------------------------
 void
-klv_0104_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
+klv_0104_to_vital_metadata( klv_timeline_cursor& klv_data, uint64_t timestamp,
                             kv::metadata& vital_data )
 {
   constexpr auto standard = KLV_PACKET_MISB_0104_UNIVERSAL_SET;
@@ -215,7 +209,8 @@ klv_0104_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
   // Add the timestamp
   vital_data.add< kv::VITAL_META_UNIX_TIMESTAMP >( timestamp );
 
-  static std::map< klv_lds_key, kv::vital_metadata_tag > const direct_map = {
+  // Where two KLV tags map to one vital tag, the later takes precedence
+  static direct_map_t const direct_map = {
     { KLV_0104_PLATFORM_HEADING_ANGLE,
       kv::VITAL_META_PLATFORM_HEADING_ANGLE },
     { KLV_0104_PLATFORM_PITCH_ANGLE,
@@ -250,7 +245,7 @@ klv_0104_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
   {
     auto const klv_tag = entry.first;
     auto const vital_tag = entry.second;
-    auto const value = klv_data.at( standard, klv_tag, timestamp );
+    auto const& value = klv_data.at( standard, klv_tag, timestamp );
     if( value.valid() )
     {
       auto const converted_value = klv_to_vital_value( value );
@@ -327,7 +322,7 @@ klv_0104_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
 
 // ----------------------------------------------------------------------------
 void
-klv_0601_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
+klv_0601_to_vital_metadata( klv_timeline_cursor& klv_data, uint64_t timestamp,
                             kv::metadata& vital_data )
 {
   constexpr auto standard = KLV_PACKET_MISB_0601_LOCAL_SET;
@@ -335,7 +330,8 @@ klv_0601_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
   // Add the timestamp
   vital_data.add< kv::VITAL_META_UNIX_TIMESTAMP >( timestamp );
 
-  static std::map< klv_lds_key, kv::vital_metadata_tag > const direct_map = {
+  // Where two KLV tags map to one vital tag, the later takes precedence
+  static direct_map_t const direct_map = {
     { KLV_0601_MISSION_ID,
       kv::VITAL_META_MISSION_ID },
     { KLV_0601_PLATFORM_TAIL_NUMBER,
@@ -424,7 +420,7 @@ klv_0601_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
   {
     auto const klv_tag = entry.first;
     auto const vital_tag = entry.second;
-    auto const value = klv_data.at( standard, klv_tag, timestamp );
+    auto const& value = klv_data.at( standard, klv_tag, timestamp );
     if( value.valid() )
     {
       auto const converted_value = klv_to_vital_value( value );
@@ -433,7 +429,7 @@ klv_0601_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
   }
 
   // Convert enum to integer
-  auto const icing_detected =
+  auto const& icing_detected =
     klv_data.at( standard, KLV_0601_ICING_DETECTED, timestamp );
   if( icing_detected.valid() )
   {
@@ -446,7 +442,7 @@ klv_0601_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
   }
 
   // Convert enum to integer
-  auto const sensor_fov_name =
+  auto const& sensor_fov_name =
     klv_data.at( standard, KLV_0601_SENSOR_FOV_NAME, timestamp );
   if( sensor_fov_name.valid() )
   {
@@ -573,7 +569,7 @@ klv_0601_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
 
 // ----------------------------------------------------------------------------
 void
-klv_1108_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
+klv_1108_to_vital_metadata( klv_timeline_cursor& klv_data, uint64_t timestamp,
                             kv::metadata& vital_data )
 {
   constexpr auto standard = KLV_PACKET_MISB_1108_LOCAL_SET;
@@ -590,16 +586,16 @@ klv_1108_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
   for( auto const& metric : metrics )
   {
     klv_local_set const* best_metric_set = nullptr;
-    for( auto const& metric_set_entry :
+    for( auto const metric_set_entry :
          klv_data.all_at( standard, KLV_1108_METRIC_LOCAL_SET, timestamp ) )
     {
-      if( !metric_set_entry.valid() )
+      if( !metric_set_entry->valid() )
       {
         continue;
       }
 
-      auto const& metric_set = metric_set_entry.get< klv_local_set >();
-      auto const name_entry = metric_set.at( KLV_1108_METRIC_SET_NAME );
+      auto const& metric_set = metric_set_entry->get< klv_local_set >();
+      auto const& name_entry = metric_set.at( KLV_1108_METRIC_SET_NAME );
       if( !name_entry.valid() )
       {
         continue;
@@ -636,12 +632,28 @@ klv_1108_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp,
 kv::metadata_sptr
 klv_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp )
 {
-  auto const result = std::make_shared< klv_metadata >();
-  klv_0102_to_vital_metadata( klv_data, timestamp, *result );
-  klv_0104_to_vital_metadata( klv_data, timestamp, *result );
-  klv_0601_to_vital_metadata( klv_data, timestamp, *result );
-  klv_1108_to_vital_metadata( klv_data, timestamp, *result );
-  return result;
+  return klv_to_vital_metadata(
+    klv_data, std::vector< uint64_t >{ timestamp } ).front();
+}
+
+// ----------------------------------------------------------------------------
+std::vector< kv::metadata_sptr >
+klv_to_vital_metadata( klv_timeline const& klv_data,
+                       std::vector< uint64_t > const& timestamps )
+{
+  klv_timeline_cursor cursor{ klv_data };
+  std::vector< kv::metadata_sptr > results;
+  results.reserve( timestamps.size() );
+  for( auto const timestamp : timestamps )
+  {
+    auto const result = std::make_shared< klv_metadata >();
+    klv_0102_to_vital_metadata( cursor, timestamp, *result );
+    klv_0104_to_vital_metadata( cursor, timestamp, *result );
+    klv_0601_to_vital_metadata( cursor, timestamp, *result );
+    klv_1108_to_vital_metadata( cursor, timestamp, *result );
+    results.emplace_back( result );
+  }
+  return results;
 }
 
 } // namespace klv
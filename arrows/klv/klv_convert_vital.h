@@ -9,6 +9,8 @@
 
 #include <vital/types/metadata.h>
 
+#include <vector>
+
 namespace kwiver {
 
 namespace arrows {
@@ -38,6 +40,24 @@ KWIVER_ALGO_KLV_EXPORT
 kwiver::vital::metadata_sptr
 klv_to_vital_metadata( klv_timeline const& klv_data, uint64_t timestamp );
 
+// ----------------------------------------------------------------------------
+/// Create a \c metadata object for each of \p timestamps from \p klv_data.
+///
+/// The results are the same as calling the single-timestamp overload for each
+/// timestamp in turn, but each tag is searched for in the timeline only once
+/// for the whole batch, which is much cheaper when converting many frames.
+/// Timestamps in increasing order are converted fastest.
+///
+/// \param klv_data Timeline of KLV data.
+/// \param timestamps
+///   MISP Precision Timestamps (microseconds) of the frames to convert.
+///
+/// \return The vital-friendly metadata for each of \p timestamps, in order.
+KWIVER_ALGO_KLV_EXPORT
+std::vector< kwiver::vital::metadata_sptr >
+klv_to_vital_metadata( klv_timeline const& klv_data,
+                       std::vector< uint64_t > const& timestamps );
+
 } // namespace klv
 
 } // namespace arrows
@@ -70,7 +70,8 @@ indexify_1108( klv_local_set const& parent_set,
 // ----------------------------------------------------------------------------
 klv_demuxer
 ::klv_demuxer( klv_timeline& timeline )
-  : m_frame_timestamp{ 0 }, m_prev_frame_timestamp{ 0 }, m_timeline( timeline ) {}
+  : m_frame_timestamp{ 0 }, m_prev_frame_timestamp{ 0 }, m_timeline( timeline ),
+    m_retention{ 0, 0 }, m_archive{ nullptr } {}
 
 // ----------------------------------------------------------------------------
 void
@@ -117,6 +118,8 @@ ::send_frame( std::vector< klv_packet > const& packets,
   {
     demux_packet( packet );
   }
+
+  evict();
 }
 
 // ----------------------------------------------------------------------------
@@ -224,6 +227,67 @@ ::reset()
   m_timeline.clear();
 }
 
+// ----------------------------------------------------------------------------
+klv_timeline_retention const&
+klv_demuxer
+::retention() const
+{
+  return m_retention;
+}
+
+// ----------------------------------------------------------------------------
+void
+klv_demuxer
+::set_retention( klv_timeline_retention const& retention )
+{
+  m_retention = retention;
+}
+
+// ----------------------------------------------------------------------------
+void
+klv_demuxer
+::set_archive( klv_timeline_archive* archive )
+{
+  m_archive = archive;
+}
+
+// ----------------------------------------------------------------------------
+void
+klv_demuxer
+::evict()
+{
+  if( !m_retention.is_limited() )
+  {
+    return;
+  }
+
+  klv_timeline evicted;
+  auto const evicted_ptr = m_archive ? &evicted : nullptr;
+  if( m_retention.max_duration &&
+      m_frame_timestamp > m_retention.max_duration )
+  {
+    auto const cutoff = m_frame_timestamp - m_retention.max_duration;
+    m_timeline.erase_before( cutoff, evicted_ptr );
+
+    // New entries start no earlier than the current frame, so older cancel
+    // points can no longer truncate anything
+    for( auto it = m_cancel_points.begin(); it != m_cancel_points.end(); )
+    {
+      it = ( it->second < cutoff ) ? m_cancel_points.erase( it )
+                                   : std::next( it );
+    }
+  }
+  if( m_retention.max_entries )
+  {
+    m_timeline.erase_excess( m_retention.max_entries, evicted_ptr );
+  }
+
+  if( m_archive && evicted.size() )
+  {
+    m_archive->write( evicted );
+  }
+}
+
 // ----------------------------------------------------------------------------
 template< class T >
 void
@@ -484,8 +548,9 @@ ::demux_single_entry( klv_top_level_tag standard, klv_lds_key tag,
     auto const cancel_range = m_cancel_points.equal_range( key );
     for( auto it = cancel_range.first; it != cancel_range.second; ++it )
     {
+      // A value arriving at the same time as a cancellation supersedes it
       auto const cancel_time = it->second;
-      if( cancel_time >= adjusted_interval.lower() )
+      if( cancel_time > adjusted_interval.lower() )
       {
         adjusted_interval.truncate_upper( cancel_time );
       }
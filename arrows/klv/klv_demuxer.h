@@ -6,6 +6,7 @@
 /// Declaration of KLV demuxer.
 
 #include "klv_timeline.h"
+#include "klv_timeline_archive.h"
 
 namespace kwiver {
 
@@ -39,9 +40,28 @@ class KWIVER_ALGO_KLV_EXPORT klv_demuxer
   timeline() const;
 
   /// Reset the object to a state equivalent to if it had just been constructed.
+  ///
+  /// Does not reset retention settings.
   void
   reset();
 
+  /// Return the current retention settings.
+  klv_timeline_retention const&
+  retention() const;
+
+  /// Limit the history kept in the timeline.
+  ///
+  /// Entries beyond the limits are evicted after each frame is sent. By
+  /// default, all history is kept.
+  void
+  set_retention( klv_timeline_retention const& retention );
+
+  /// Set an archive to receive evicted history, or \c nullptr to discard it.
+  ///
+  /// The archive must outlive this object, or be unset first.
+  void
+  set_archive( klv_timeline_archive* archive );
+
 private:
   using key_t = typename klv_timeline::key_t;
 
@@ -67,6 +87,8 @@ class KWIVER_ALGO_KLV_EXPORT klv_demuxer
                            interval_t const& time_interval,
                            klv_value const& value );
 
+  void evict();
+
   template< class T >
   void demux_list( klv_top_level_tag standard,
                    klv_lds_key tag,
@@ -77,6 +99,8 @@ class KWIVER_ALGO_KLV_EXPORT klv_demuxer
   uint64_t m_prev_frame_timestamp;
   std::multimap< klv_timeline::key_t, uint64_t > m_cancel_points;
   klv_timeline& m_timeline;
+  klv_timeline_retention m_retention;
+  klv_timeline_archive* m_archive;
 };
 
 } // namespace klv
@@ -0,0 +1,122 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Implementation of the asynchronous KLV frame encoder.
+
+#include "klv_frame_encoder.h"
+
+#include <vital/util/thread_pool.h>
+
+#include <chrono>
+#include <stdexcept>
+
+namespace kv = kwiver::vital;
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace klv {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+klv_frame_encoder::frame_t
+encode_frame( uint64_t timestamp, std::vector< klv_packet > const& packets )
+{
+  klv_frame_encoder::frame_t result{ timestamp, {} };
+  result.packets.reserve( packets.size() );
+  for( auto const& packet : packets )
+  {
+    klv_bytes_t bytes( klv_packet_length( packet ) );
+    auto it = &*bytes.begin();
+    klv_write_packet( packet, it, bytes.size() );
+    result.packets.emplace_back( std::move( bytes ) );
+  }
+  return result;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+klv_frame_encoder
+::klv_frame_encoder()
+  : m_frames{}, m_prev_timestamp{ 0 }
+{}
+
+// ----------------------------------------------------------------------------
+klv_frame_encoder
+::~klv_frame_encoder()
+{
+  reset();
+}
+
+// ----------------------------------------------------------------------------
+void
+klv_frame_encoder
+::send_frame( uint64_t timestamp, std::vector< klv_packet > packets )
+{
+  if( timestamp < m_prev_timestamp )
+  {
+    throw std::logic_error( "klv_frame_encoder: frames sent out of order" );
+  }
+  m_prev_timestamp = timestamp;
+
+  m_frames.emplace_back(
+    kv::thread_pool::instance().enqueue(
+      encode_frame, timestamp, std::move( packets ) ) );
+}
+
+// ----------------------------------------------------------------------------
+size_t
+klv_frame_encoder
+::pending_frames() const
+{
+  return m_frames.size();
+}
+
+// ----------------------------------------------------------------------------
+bool
+klv_frame_encoder
+::frame_ready() const
+{
+  return !m_frames.empty() &&
+         m_frames.front().wait_for( std::chrono::seconds{ 0 } ) ==
+         std::future_status::ready;
+}
+
+// ----------------------------------------------------------------------------
+klv_frame_encoder::frame_t
+klv_frame_encoder
+::receive_frame()
+{
+  if( m_frames.empty() )
+  {
+    throw std::logic_error( "klv_frame_encoder: no frames pending" );
+  }
+
+  auto future = std::move( m_frames.front() );
+  m_frames.pop_front();
+  return future.get();
+}
+
+// ----------------------------------------------------------------------------
+void
+klv_frame_encoder
+::reset()
+{
+  for( auto& frame : m_frames )
+  {
+    frame.wait();
+  }
+  m_frames.clear();
+  m_prev_timestamp = 0;
+}
+
+} // namespace klv
+
+} // namespace arrows
+
+} // namespace kwiver
@@ -0,0 +1,85 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Declaration of the asynchronous KLV frame encoder.
+
+#ifndef KWIVER_ARROWS_KLV_KLV_FRAME_ENCODER_H_
+#define KWIVER_ARROWS_KLV_KLV_FRAME_ENCODER_H_
+
+#include <arrows/klv/klv_packet.h>
+#include <arrows/klv/kwiver_algo_klv_export.h>
+
+#include <deque>
+#include <future>
+#include <vector>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace klv {
+
+// ----------------------------------------------------------------------------
+/// Serializes the KLV packets of successive frames on worker threads.
+///
+/// Writing large packets, such as ST0903 VMTI sets, can take long enough to
+/// stall a video encoder sharing the thread. This class moves that work onto
+/// the vital thread pool: frames are sent as they become available, and their
+/// serialized packets are received later, always in the order the frames were
+/// sent.
+class KWIVER_ALGO_KLV_EXPORT klv_frame_encoder
+{
+public:
+  /// Serialized packets of one frame.
+  struct frame_t
+  {
+    uint64_t timestamp;
+    std::vector< klv_bytes_t > packets;
+  };
+
+  klv_frame_encoder();
+  klv_frame_encoder( klv_frame_encoder const& ) = delete;
+
+  /// Waits for any frames still being serialized.
+  ~klv_frame_encoder();
+
+  klv_frame_encoder&
+  operator=( klv_frame_encoder const& ) = delete;
+
+  /// Begin serializing the \p packets of the frame at \p timestamp.
+  ///
+  /// \throws logic_error If \p timestamp is less than that of the previously
+  /// sent frame.
+  void send_frame( uint64_t timestamp, std::vector< klv_packet > packets );
+
+  /// Return the number of frames sent but not yet received.
+  size_t pending_frames() const;
+
+  /// Return whether the oldest pending frame has been serialized, so that
+  /// \c receive_frame() would not block.
+  bool frame_ready() const;
+
+  /// Return the serialized packets of the oldest pending frame, waiting for
+  /// them if necessary.
+  ///
+  /// \throws logic_error If no frames are pending.
+  /// \throws metadata_exception If a packet could not be serialized.
+  frame_t receive_frame();
+
+  /// Wait for and discard all pending frames.
+  void reset();
+
+private:
+  std::deque< std::future< frame_t > > m_frames;
+  uint64_t m_prev_timestamp;
+};
+
+} // namespace klv
+
+} // namespace arrows
+
+} // namespace kwiver
+
+#endif
@@ -11,6 +11,7 @@
 
 namespace kv = kwiver::vital;
 #include <algorithm>
+#include <functional>
 
 namespace kwiver {
 
@@ -18,6 +19,13 @@ namespace arrows {
 
 namespace klv {
 
+namespace {
+
+// Innermost klv_read_buffer_scope on this thread
+thread_local klv_read_buffer_scope* active_read_buffer_scope = nullptr;
+
+} // namespace
+
 // ----------------------------------------------------------------------------
 uint64_t
 _imap_infinity( bool sign_bit, size_t length )
@@ -210,16 +218,15 @@ klv_write_float( double value, klv_write_iter_t& data, size_t length )
   }
 }
 
+namespace {
+
 // ----------------------------------------------------------------------------
+// Decode an IMAP integer, given terms already calculated for its
+// specification.
 double
-klv_read_imap(
-  vital::interval< double > const& interval,
-  klv_read_iter_t& data, size_t length )
+_decode_imap( uint64_t int_value, vital::interval< double > const& interval,
+              size_t length, _imap_terms const& terms, double precision )
 {
-  // Section 8.1.2
-  _check_range_length( interval, length );
-
-  auto const int_value = klv_read_int< uint64_t >( data, length );
   auto value = static_cast< double >( int_value );
 
   // Section 8.2.2
@@ -258,16 +265,57 @@ klv_read_imap(
   }
 
   // Normal value
-  auto const terms = _calculate_imap_terms( interval, length );
   value =
     terms.backward_scale * ( value - terms.zero_offset ) + interval.lower();
 
   // Return exactly zero if applicable, overriding rounding errors. IMAP
   // specification considers this important
-  auto const precision = klv_imap_precision( interval, length );
   return ( std::abs( value ) < precision / 2.0 ) ? 0.0 : value;
 }
 
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+double
+klv_read_imap(
+  vital::interval< double > const& interval,
+  klv_read_iter_t& data, size_t length )
+{
+  // Section 8.1.2
+  _check_range_length( interval, length );
+
+  auto const int_value = klv_read_int< uint64_t >( data, length );
+  return _decode_imap( int_value, interval, length,
+                       _calculate_imap_terms( interval, length ),
+                       klv_imap_precision( interval, length ) );
+}
+
+// ----------------------------------------------------------------------------
+std::vector< double >
+klv_read_imap_n(
+  vital::interval< double > const& interval,
+  klv_read_iter_t& data, size_t length, size_t count )
+{
+  // Section 8.1.2
+  _check_range_length( interval, length );
+
+  auto const terms = _calculate_imap_terms( interval, length );
+  auto const precision = klv_imap_precision( interval, length );
+
+  // Only move the caller's iterator once every value has been read
+  auto it = data;
+  std::vector< double > result;
+  result.reserve( count );
+  for( size_t i = 0; i < count; ++i )
+  {
+    auto const int_value = klv_read_int< uint64_t >( it, length );
+    result.push_back(
+      _decode_imap( int_value, interval, length, terms, precision ) );
+  }
+  data = it;
+  return result;
+}
+
 // ----------------------------------------------------------------------------
 void
 klv_write_imap( double value, vital::interval< double > const& interval,
@@ -385,6 +433,40 @@ klv_string_length( std::string const& value )
   return std::max< size_t >( value.size(), 1 );
 }
 
+// ----------------------------------------------------------------------------
+klv_read_buffer_scope
+::klv_read_buffer_scope( std::shared_ptr< klv_bytes_t const > const& buffer )
+  : m_buffer{ buffer }, m_outer{ active_read_buffer_scope }
+{
+  active_read_buffer_scope = this;
+}
+
+// ----------------------------------------------------------------------------
+klv_read_buffer_scope
+::~klv_read_buffer_scope()
+{
+  active_read_buffer_scope = m_outer;
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< klv_bytes_t const >
+klv_read_buffer_scope
+::find( klv_read_iter_t data, size_t length )
+{
+  for( auto scope = active_read_buffer_scope; scope; scope = scope->m_outer )
+  {
+    auto const& buffer = scope->m_buffer;
+    if( buffer && !buffer->empty() &&
+        std::less_equal< klv_read_iter_t >{}( buffer->data(), data ) &&
+        std::less_equal< klv_read_iter_t >{}(
+          data + length, buffer->data() + buffer->size() ) )
+    {
+      return buffer;
+    }
+  }
+  return nullptr;
+}
+
 } // namespace klv
 
 } // namespace arrows
@@ -47,7 +47,9 @@
 
 #include <vital/util/interval.h>
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <cstdlib>
 
@@ -236,6 +238,27 @@ double
 klv_read_flint( vital::interval< double > const& interval,
                 klv_read_iter_t& data, size_t length );
 
+// ----------------------------------------------------------------------------
+/// Read \p count consecutive flint values of the same specification.
+///
+/// The result is the same as calling \c klv_read_flint \p count times, but
+/// the range is checked and the scale computed only once.
+///
+/// \param interval Mapped range.
+/// \param[in,out] data Iterator to sequence of \c uint8_t. Set to end of
+/// read bytes on success, left as is on error.
+/// \param length Number of bytes in each value.
+/// \param count Number of values to read.
+///
+/// \returns Floating-point numbers mapped from the read integers.
+///
+/// \throws metadata_type_overflow When the read values are too large for \c
+/// T.
+template < class T >
+std::vector< double >
+klv_read_flint_n( vital::interval< double > const& interval,
+                  klv_read_iter_t& data, size_t length, size_t count );
+
 // ----------------------------------------------------------------------------
 /// Map a floating-point number within a range to an integer and write it to a
 /// sequence of bytes.
@@ -342,6 +365,29 @@ klv_read_imap(
   vital::interval< double > const& interval,
   klv_read_iter_t& data, size_t length );
 
+// ----------------------------------------------------------------------------
+/// Read \p count consecutive IMAP-encoded values of the same specification.
+///
+/// The result is the same as calling \c klv_read_imap \p count times, but
+/// the IMAP terms, which require several logarithms and exponentials, are
+/// computed only once.
+///
+/// \param interval Mapped range.
+/// \param[in,out] data Iterator to sequence of \c uint8_t. Set to end of read
+/// bytes on success, left as is on error.
+/// \param length Number of bytes in each value.
+/// \param count Number of values to read.
+///
+/// \returns Floating-point numbers decoded from \p data buffer.
+///
+/// \throws metadata_type_overflow When \p length is greater than the size of a
+/// \c uint64_t or the span of \p interval is too large for a \c double to hold.
+KWIVER_ALGO_KLV_EXPORT
+std::vector< double >
+klv_read_imap_n(
+  vital::interval< double > const& interval,
+  klv_read_iter_t& data, size_t length, size_t count );
+
 // ----------------------------------------------------------------------------
 /// Write a floating-point value into the IMAP format.
 ///
@@ -446,6 +492,36 @@ KWIVER_ALGO_KLV_EXPORT
 size_t
 klv_string_length( std::string const& value );
 
+// ----------------------------------------------------------------------------
+/// Offers a shared buffer as backing storage to reads on the calling thread.
+///
+/// While an instance exists, deferred values (see
+/// \c klv_set_format::set_deferred) read from within \p buffer keep a
+/// reference to it instead of copying their bytes. The contents of \p buffer
+/// must not change afterwards. Instances may be nested.
+class KWIVER_ALGO_KLV_EXPORT klv_read_buffer_scope
+{
+public:
+  explicit
+  klv_read_buffer_scope( std::shared_ptr< klv_bytes_t const > const& buffer );
+
+  klv_read_buffer_scope( klv_read_buffer_scope const& ) = delete;
+
+  ~klv_read_buffer_scope();
+
+  klv_read_buffer_scope&
+  operator=( klv_read_buffer_scope const& ) = delete;
+
+  /// Return the innermost active buffer containing \p length bytes starting
+  /// at \p data, or \c nullptr if there is none.
+  static std::shared_ptr< klv_bytes_t const >
+  find( klv_read_iter_t data, size_t length );
+
+private:
+  std::shared_ptr< klv_bytes_t const > m_buffer;
+  klv_read_buffer_scope* m_outer;
+};
+
 } // namespace klv
 
 } // namespace arrows
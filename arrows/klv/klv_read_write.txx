@@ -382,6 +382,44 @@ klv_read_flint(
   }
 }
 
+// ----------------------------------------------------------------------------
+template < class T >
+std::vector< double >
+klv_read_flint_n(
+  vital::interval< double > const& interval, klv_read_iter_t& data,
+  size_t length, size_t count )
+{
+  KLV_ASSERT_INT( T );
+
+  _check_range_length( interval, length );
+
+  if( std::is_signed< T >::value && interval.lower() != -interval.upper() )
+  {
+    throw std::logic_error( "range must be symmetrical around zero" );
+  }
+
+  auto const invalid = _int_min< T >( length );
+  auto const scale = std::is_signed< T >::value
+                     ? interval.upper() / _int_max< T >( length )
+                     : interval.span() / _int_max< T >( length );
+  auto const offset = std::is_signed< T >::value ? 0.0 : interval.lower();
+
+  // Only move the caller's iterator once every value has been read
+  auto it = data;
+  std::vector< double > result;
+  result.reserve( count );
+  for( size_t i = 0; i < count; ++i )
+  {
+    auto const int_value = klv_read_int< T >( it, length );
+    result.push_back(
+      ( std::is_signed< T >::value && int_value == invalid )
+      ? std::numeric_limits< double >::quiet_NaN()
+      : static_cast< double >( int_value ) * scale + offset );
+  }
+  data = it;
+  return result;
+}
+
 // ----------------------------------------------------------------------------
 template < class T >
 void
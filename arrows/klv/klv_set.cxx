@@ -9,6 +9,7 @@
 
 #include <arrows/klv/klv_1010.h>
 #include <arrows/klv/klv_key_traits.h>
+#include <arrows/klv/klv_read_write.h>
 #include <arrows/klv/klv_util.h>
 
 namespace kv = kwiver::vital;
@@ -364,7 +365,8 @@ ::value_compare( const_iterator lhs, const_iterator rhs )
 template < class Key >
 klv_set_format< Key >
 ::klv_set_format( klv_tag_traits_lookup const& traits )
-  : klv_data_format_< klv_set< Key > >{ 0 }, m_traits( traits )
+  : klv_data_format_< klv_set< Key > >{ 0 }, m_traits( traits ),
+    m_deferred{ false }
 {}
 
 // ----------------------------------------------------------------------------
@@ -373,6 +375,24 @@ klv_set_format< Key >
 ::~klv_set_format()
 {}
 
+// ----------------------------------------------------------------------------
+template < class Key >
+bool
+klv_set_format< Key >
+::deferred() const
+{
+  return m_deferred;
+}
+
+// ----------------------------------------------------------------------------
+template < class Key >
+void
+klv_set_format< Key >
+::set_deferred( bool deferred )
+{
+  m_deferred = deferred;
+}
+
 // ----------------------------------------------------------------------------
 template < class Key >
 klv_set< Key >
@@ -383,6 +403,23 @@ ::read_typed( klv_read_iter_t& data, size_t length ) const
 
   auto const tracker = track_it( data, length );
 
+  // Values parsed on demand refer to the caller's buffer if one was offered,
+  // otherwise to a single copy of the set's bytes
+  std::shared_ptr< klv_bytes_t const > buffer;
+  size_t buffer_offset = 0;
+  if( m_deferred )
+  {
+    buffer = klv_read_buffer_scope::find( data, length );
+    if( buffer )
+    {
+      buffer_offset = static_cast< size_t >( data - buffer->data() );
+    }
+    else
+    {
+      buffer = std::make_shared< klv_bytes_t const >( data, data + length );
+    }
+  }
+
   klv_set< Key > result;
   std::vector< klv_lds_key > history;
   while( tracker.remaining() )
@@ -407,6 +444,13 @@ ::read_typed( klv_read_iter_t& data, size_t length ) const
       format.set_preceding( history );
       value = format.read( data, tracker.verify( length_of_value ) );
     }
+    else if( buffer && length_of_value )
+    {
+      auto const offset = buffer_offset + tracker.traversed();
+      data += tracker.verify( length_of_value );
+      value = klv_value::deferred(
+        traits.format(), buffer, offset, length_of_value );
+    }
     else
     {
       value = traits.format().read( data, tracker.verify( length_of_value ) );
@@ -164,6 +164,20 @@ class KWIVER_ALGO_KLV_EXPORT klv_set_format
   virtual
   ~klv_set_format();
 
+  /// Return whether entries are parsed only when first accessed.
+  bool
+  deferred() const;
+
+  /// Set whether entries are parsed only when first accessed.
+  ///
+  /// When enabled, reading a set only walks its keys and lengths, keeping a
+  /// copy of the set's bytes from which each value is parsed on demand. The
+  /// copy is avoided if the bytes lie within a buffer offered by a
+  /// \c klv_read_buffer_scope. Values are otherwise unchanged, so this only
+  /// affects performance.
+  void
+  set_deferred( bool deferred );
+
 protected:
   klv_set< Key >
   read_typed( klv_read_iter_t& data, size_t length ) const override;
@@ -186,6 +200,7 @@ class KWIVER_ALGO_KLV_EXPORT klv_set_format
   check_set( klv_set< Key > const& klv ) const;
 
   klv_tag_traits_lookup const& m_traits;
+  bool m_deferred;
 };
 
 // ----------------------------------------------------------------------------
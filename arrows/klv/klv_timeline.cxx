@@ -261,6 +261,87 @@ ::clear()
   m_map.clear();
 }
 
+// ----------------------------------------------------------------------------
+size_t
+klv_timeline
+::entry_count() const
+{
+  size_t result = 0;
+  for( auto const& entry : m_map )
+  {
+    result += entry.second.size();
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+klv_timeline
+::erase_before( uint64_t time, klv_timeline* evicted )
+{
+  size_t result = 0;
+  for( auto it = m_map.begin(); it != m_map.end(); )
+  {
+    // Entries are sorted and disjoint, so those ending by the given time form
+    // a prefix
+    auto& entries = it->second;
+    auto end_it = entries.begin();
+    for(; end_it != entries.end() && end_it->key_interval.upper() <= time;
+        ++end_it )
+    {
+      if( evicted )
+      {
+        evicted->insert_or_find( it->first.standard, it->first.tag,
+                                 it->first.index )
+          ->second.set( end_it->key_interval, end_it->value );
+      }
+      ++result;
+    }
+    entries.erase( entries.begin(), end_it );
+
+    it = entries.empty() ? m_map.erase( it ) : std::next( it );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+klv_timeline
+::erase_excess( size_t max_entries, klv_timeline* evicted )
+{
+  size_t result = 0;
+  for( auto it = m_map.begin(); it != m_map.end(); )
+  {
+    auto& entries = it->second;
+    if( entries.size() > max_entries )
+    {
+      auto end_it = entries.begin();
+      for( auto i = entries.size() - max_entries; i; --i, ++end_it )
+      {
+        if( evicted )
+        {
+          evicted->insert_or_find( it->first.standard, it->first.tag,
+                                   it->first.index )
+            ->second.set( end_it->key_interval, end_it->value );
+        }
+        ++result;
+      }
+      entries.erase( entries.begin(), end_it );
+    }
+
+    it = entries.empty() ? m_map.erase( it ) : std::next( it );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+bool
+klv_timeline_retention
+::is_limited() const
+{
+  return max_duration || max_entries;
+}
+
 // ----------------------------------------------------------------------------
 bool
 operator==( klv_timeline const& lhs, klv_timeline const& rhs )
@@ -336,6 +417,149 @@ operator<<( std::ostream& os, klv_timeline const& rhs )
   return os;
 }
 
+// ----------------------------------------------------------------------------
+klv_timeline_cursor
+::klv_timeline_cursor( klv_timeline const& timeline )
+  : m_timeline( timeline ), m_positions{}, m_all_positions{}
+{}
+
+// ----------------------------------------------------------------------------
+klv_value const&
+klv_timeline_cursor
+::at( klv_top_level_tag standard, klv_lds_key tag, uint64_t time )
+{
+  static klv_value const empty;
+
+  klv_value const* result = nullptr;
+  for( auto& position : positions( standard, tag ) )
+  {
+    auto const value = find( position, time );
+    if( value )
+    {
+      if( result )
+      {
+        throw std::logic_error(
+                "klv_timeline_cursor.at(): more than one entry found" );
+      }
+      result = value;
+    }
+  }
+
+  return result ? *result : empty;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< klv_value const* >
+klv_timeline_cursor
+::all_at( klv_top_level_tag standard, klv_lds_key tag, uint64_t time )
+{
+  std::vector< klv_value const* > results;
+  for( auto& position : positions( standard, tag ) )
+  {
+    auto const value = find( position, time );
+    if( value )
+    {
+      results.emplace_back( value );
+    }
+  }
+  return results;
+}
+
+// ----------------------------------------------------------------------------
+klv_timeline_cursor::snapshot_t
+klv_timeline_cursor
+::snapshot( uint64_t time )
+{
+  if( m_all_positions.empty() )
+  {
+    for( auto it = m_timeline.begin(); it != m_timeline.end(); ++it )
+    {
+      m_all_positions.push_back( { it, it->second.end() } );
+    }
+  }
+
+  snapshot_t result;
+  for( auto& position : m_all_positions )
+  {
+    auto const value = find( position, time );
+    if( value )
+    {
+      result.emplace_back( &position.timeline_it->first, value );
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+void
+klv_timeline_cursor
+::reset()
+{
+  m_positions.clear();
+  m_all_positions.clear();
+}
+
+// ----------------------------------------------------------------------------
+klv_timeline_cursor::positions_t&
+klv_timeline_cursor
+::positions( klv_top_level_tag standard, klv_lds_key tag )
+{
+  auto const key = ( static_cast< uint32_t >( standard ) << 16 ) | tag;
+  auto const it = m_positions.find( key );
+  if( it != m_positions.end() )
+  {
+    return it->second;
+  }
+
+  auto& result = m_positions[ key ];
+  auto const range = m_timeline.find_all( standard, tag );
+  for( auto timeline_it = range.begin(); timeline_it != range.end();
+       ++timeline_it )
+  {
+    result.push_back( { timeline_it, timeline_it->second.end() } );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+klv_value const*
+klv_timeline_cursor
+::find( position_t& position, uint64_t time ) const
+{
+  auto const& entries = position.timeline_it->second;
+  auto& it = position.entry_it;
+  if( it != entries.end() && it->key_interval.lower() <= time )
+  {
+    // Same entry as last time
+    if( time < it->key_interval.upper() )
+    {
+      return &it->value;
+    }
+
+    // Next entry, or the gap before it
+    auto next = it;
+    ++next;
+    if( next == entries.end() || time < next->key_interval.lower() )
+    {
+      return nullptr;
+    }
+    if( time < next->key_interval.upper() )
+    {
+      it = next;
+      return &it->value;
+    }
+  }
+
+  // Search; keep the previous position if there is no entry at this time
+  auto const found = entries.find( time );
+  if( found == entries.end() )
+  {
+    return nullptr;
+  }
+  it = found;
+  return &it->value;
+}
+
 } // namespace klv
 
 } // namespace arrows
@@ -14,6 +14,9 @@
 
 #include <vital/util/interval_map.h>
 
+#include <unordered_map>
+#include <vector>
+
 namespace kwiver {
 
 namespace arrows {
@@ -117,10 +120,109 @@ class KWIVER_ALGO_KLV_EXPORT klv_timeline
   /// Remove all data from this object.
   void clear();
 
+  /// Return the total number of entries in all timelines.
+  size_t entry_count() const;
+
+  /// Remove every entry which ends at or before \p time.
+  ///
+  /// Entries spanning \p time are kept whole. Timelines left with no entries
+  /// are erased.
+  ///
+  /// \param time Entries ending at or before this time are removed.
+  /// \param evicted If not null, removed entries are added to this timeline.
+  ///
+  /// \returns Number of entries removed.
+  size_t erase_before( uint64_t time, klv_timeline* evicted = nullptr );
+
+  /// Remove the oldest entries of each timeline until no more than \p
+  /// max_entries remain in any of them.
+  ///
+  /// \param max_entries Number of entries to keep per timeline.
+  /// \param evicted If not null, removed entries are added to this timeline.
+  ///
+  /// \returns Number of entries removed.
+  size_t erase_excess( size_t max_entries, klv_timeline* evicted = nullptr );
+
 private:
   container_t m_map;
 };
 
+// ----------------------------------------------------------------------------
+/// Limits on the history kept in a \c klv_timeline.
+///
+/// A limit of zero is no limit.
+struct KWIVER_ALGO_KLV_EXPORT klv_timeline_retention
+{
+  /// Entries which ended longer than this many microseconds before the most
+  /// recent frame are evicted.
+  uint64_t max_duration;
+
+  /// No more than this many of the most recent entries are kept for each key.
+  size_t max_entries;
+
+  /// Return \c true if either limit is set.
+  bool is_limited() const;
+};
+
+// ----------------------------------------------------------------------------
+/// Reads values from a \c klv_timeline at a sequence of times.
+///
+/// The cursor remembers the entry last found for each queried tag. When
+/// successive queries are at the same or increasing times, as when streaming
+/// through a video, each query usually finds its value in the remembered entry
+/// or the one after it, in constant time. Queries at other times are still
+/// answered correctly by an ordinary search.
+///
+/// \warning The cursor refers into the timeline, so \c reset() must be
+/// called after the timeline is modified.
+class KWIVER_ALGO_KLV_EXPORT klv_timeline_cursor
+{
+public:
+  using snapshot_t =
+    std::vector< std::pair< klv_timeline::key_t const*, klv_value const* > >;
+
+  explicit
+  klv_timeline_cursor( klv_timeline const& timeline );
+
+  /// Return the value at the given location, or an empty \c klv_value if no
+  /// value exists.
+  ///
+  /// \throws logic_error If more than one value is present.
+  klv_value const&
+  at( klv_top_level_tag standard, klv_lds_key tag, uint64_t time );
+
+  /// Return all values at the given location.
+  std::vector< klv_value const* >
+  all_at( klv_top_level_tag standard, klv_lds_key tag, uint64_t time );
+
+  /// Return every key with a value at \p time, with that value, in key order.
+  snapshot_t
+  snapshot( uint64_t time );
+
+  /// Forget all remembered entries.
+  void
+  reset();
+
+private:
+  struct position_t
+  {
+    klv_timeline::const_iterator timeline_it;
+    klv_timeline::interval_map_t::const_iterator entry_it;
+  };
+
+  using positions_t = std::vector< position_t >;
+
+  positions_t&
+  positions( klv_top_level_tag standard, klv_lds_key tag );
+
+  klv_value const*
+  find( position_t& position, uint64_t time ) const;
+
+  klv_timeline const& m_timeline;
+  std::unordered_map< uint32_t, positions_t > m_positions;
+  positions_t m_all_positions;
+};
+
 // ----------------------------------------------------------------------------
 DECLARE_CMP( klv_timeline::key_t );
 
@@ -0,0 +1,193 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Implementation of the on-disk KLV timeline archive.
+
+#include "klv_timeline_archive.h"
+
+#include <arrows/klv/klv_demuxer.h>
+#include <arrows/klv/klv_muxer.h>
+#include <arrows/klv/klv_read_write.h>
+
+#include <vital/exceptions/io.h>
+
+#include <map>
+#include <set>
+
+namespace kv = kwiver::vital;
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace klv {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Each record is a frame timestamp and the byte length of the frame's packets,
+// followed by the packets themselves.
+constexpr size_t record_timestamp_length = 8;
+constexpr size_t record_size_length = 4;
+constexpr size_t record_header_length =
+  record_timestamp_length + record_size_length;
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+klv_timeline_archive
+::klv_timeline_archive( std::string const& path )
+  : m_path{ path },
+    m_file{ path, std::ios::in | std::ios::out |
+                  std::ios::trunc | std::ios::binary }
+{
+  if( !m_file )
+  {
+    VITAL_THROW( kv::file_write_exception, path, "Could not open file" );
+  }
+}
+
+// ----------------------------------------------------------------------------
+std::string const&
+klv_timeline_archive
+::path() const
+{
+  return m_path;
+}
+
+// ----------------------------------------------------------------------------
+void
+klv_timeline_archive
+::write( klv_timeline const& timeline )
+{
+  // Encode a frame at every change of value
+  std::set< uint64_t > times;
+  for( auto const& entry : timeline )
+  {
+    for( auto const& subentry : entry.second )
+    {
+      times.emplace( subentry.key_interval.lower() );
+      times.emplace( subentry.key_interval.upper() );
+    }
+  }
+
+  klv_muxer muxer( timeline );
+  for( auto const time : times )
+  {
+    muxer.send_frame( time );
+  }
+
+  m_file.clear();
+  m_file.seekp( 0, std::ios::end );
+
+  klv_bytes_t buffer;
+  for( auto i = times.size(); i; --i )
+  {
+    auto const timestamp = muxer.next_frame_time();
+    auto const packets = muxer.receive_frame();
+    if( packets.empty() )
+    {
+      continue;
+    }
+
+    size_t length = 0;
+    for( auto const& packet : packets )
+    {
+      length += klv_packet_length( packet );
+    }
+    if( length > UINT32_MAX )
+    {
+      VITAL_THROW( kv::file_write_exception, m_path,
+                   "KLV frame too large to archive" );
+    }
+
+    buffer.resize( record_header_length + length );
+    auto const buffer_end = &*buffer.begin() + buffer.size();
+    auto it = &*buffer.begin();
+    klv_write_int( timestamp, it, record_timestamp_length );
+    klv_write_int( static_cast< uint32_t >( length ), it, record_size_length );
+    for( auto const& packet : packets )
+    {
+      klv_write_packet( packet, it, buffer_end - it );
+    }
+
+    m_file.write( reinterpret_cast< char const* >( buffer.data() ),
+                  buffer.size() );
+  }
+
+  m_file.flush();
+  if( !m_file )
+  {
+    VITAL_THROW( kv::file_write_exception, m_path, "Could not write file" );
+  }
+}
+
+// ----------------------------------------------------------------------------
+klv_timeline
+klv_timeline_archive
+::read( interval_t const& time_interval )
+{
+  // Find the records which may contribute to the requested time. Records of
+  // separate writes may overlap in time, so they are sorted before demuxing
+  std::multimap< uint64_t, std::pair< std::streamoff, size_t > > records;
+  uint8_t header[ record_header_length ];
+  m_file.clear();
+  m_file.seekg( 0 );
+  while( m_file.read( reinterpret_cast< char* >( header ),
+                      record_header_length ) )
+  {
+    klv_read_iter_t it = header;
+    auto const timestamp =
+      klv_read_int< uint64_t >( it, record_timestamp_length );
+    auto const length =
+      klv_read_int< uint32_t >( it, record_size_length );
+    if( timestamp < time_interval.upper() )
+    {
+      records.emplace(
+        timestamp, std::make_pair( std::streamoff{ m_file.tellg() },
+                                   size_t{ length } ) );
+    }
+    m_file.seekg( length, std::ios::cur );
+  }
+  if( m_file.bad() )
+  {
+    VITAL_THROW( kv::file_not_read_exception, m_path, "Could not read file" );
+  }
+  m_file.clear();
+
+  klv_timeline result;
+  klv_demuxer demuxer( result );
+  klv_bytes_t buffer;
+  for( auto const& record : records )
+  {
+    buffer.resize( record.second.second );
+    m_file.seekg( record.second.first );
+    if( !m_file.read( reinterpret_cast< char* >( buffer.data() ),
+                      buffer.size() ) )
+    {
+      m_file.clear();
+      VITAL_THROW( kv::file_not_read_exception, m_path, "Truncated record" );
+    }
+
+    std::vector< klv_packet > packets;
+    auto it = static_cast< klv_read_iter_t >( buffer.data() );
+    auto const end = it + buffer.size();
+    while( it < end )
+    {
+      packets.emplace_back( klv_read_packet( it, end - it ) );
+    }
+    demuxer.send_frame( packets, record.first );
+  }
+
+  // Drop history which ends before the requested time
+  result.erase_before( time_interval.lower() );
+  return result;
+}
+
+} // namespace klv
+
+} // namespace arrows
+
+} // namespace kwiver
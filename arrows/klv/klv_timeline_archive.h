@@ -0,0 +1,69 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Declaration of the on-disk KLV timeline archive.
+
+#ifndef KWIVER_ARROWS_KLV_KLV_TIMELINE_ARCHIVE_H_
+#define KWIVER_ARROWS_KLV_KLV_TIMELINE_ARCHIVE_H_
+
+#include <arrows/klv/klv_timeline.h>
+#include <arrows/klv/kwiver_algo_klv_export.h>
+
+#include <fstream>
+#include <string>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace klv {
+
+// ----------------------------------------------------------------------------
+/// Keeps history evicted from a \c klv_timeline in a file instead of memory.
+///
+/// History is re-encoded as KLV packets, grouped by frame, and appended to the
+/// file. Reading it back demuxes those packets into a new timeline, which
+/// holds valid, though not necessarily identical, data for the requested
+/// time. Only the file path is held in memory; reads scan the whole file.
+class KWIVER_ALGO_KLV_EXPORT klv_timeline_archive
+{
+public:
+  using interval_t = typename klv_timeline::interval_t;
+
+  /// Create an empty archive at \p path, replacing any existing file.
+  ///
+  /// \throws file_write_exception If the file could not be opened.
+  explicit klv_timeline_archive( std::string const& path );
+
+  klv_timeline_archive( klv_timeline_archive const& ) = delete;
+
+  klv_timeline_archive&
+  operator=( klv_timeline_archive const& ) = delete;
+
+  /// Return the path of the archive file.
+  std::string const& path() const;
+
+  /// Append the contents of \p timeline to the archive.
+  ///
+  /// \throws file_write_exception If the file could not be written.
+  void write( klv_timeline const& timeline );
+
+  /// Return the archived history present at any point in \p time_interval.
+  ///
+  /// \throws file_not_read_exception If the file could not be read.
+  klv_timeline read( interval_t const& time_interval );
+
+private:
+  std::string m_path;
+  std::fstream m_file;
+};
+
+} // namespace klv
+
+} // namespace arrows
+
+} // namespace kwiver
+
+#endif
@@ -9,12 +9,16 @@
 
 #include "klv_all.h"
 #include "klv_blob.h"
+#include "klv_data_format.h"
 #include "klv_packet.h"
 #include "klv_series.hpp"
 #include "klv_set.h"
 
 #include <vital/util/demangle.h>
 
+#include <atomic>
+#include <mutex>
+
 namespace kwiver {
 
 namespace arrows {
@@ -78,6 +82,10 @@ class klv_value::internal_base
   virtual std::ostream& print( std::ostream& os ) const = 0;
   virtual internal_base* clone() const = 0;
   virtual kwiver::vital::any to_any() const = 0;
+
+  // Return the object holding the parsed value.
+  virtual internal_base const& resolved() const { return *this; }
+  virtual bool is_deferred() const noexcept { return false; }
 };
 
 // ----------------------------------------------------------------------------
@@ -154,6 +162,94 @@ class klv_value::internal_ : public internal_base
   T m_item;
 };
 
+// ----------------------------------------------------------------------------
+class klv_value::internal_deferred : public internal_base
+{
+public:
+  internal_deferred( klv_data_format const& format,
+                     std::shared_ptr< klv_bytes_t const > const& buffer,
+                     size_t offset, size_t length )
+    : m_format( format ), m_buffer{ buffer }, m_offset{ offset },
+      m_length{ length }, m_parsed{ false }
+  {}
+
+  std::type_info const&
+  type() const noexcept override final
+  {
+    return resolved().type();
+  }
+
+  bool
+  less_than( internal_base const& rhs ) const override final
+  {
+    return resolved().less_than( rhs.resolved() );
+  }
+
+  bool
+  equal_to( internal_base const& rhs ) const override final
+  {
+    return resolved().equal_to( rhs.resolved() );
+  }
+
+  std::ostream&
+  print( std::ostream& os ) const override final
+  {
+    return resolved().print( os );
+  }
+
+  internal_base*
+  clone() const override final
+  {
+    // m_value is complete once m_parsed is set. Otherwise the copy parses the
+    // bytes itself; m_buffer never changes, so reading it here cannot race
+    // with a parse on another thread
+    if( m_parsed.load( std::memory_order_acquire ) )
+    {
+      return m_value->clone();
+    }
+    return new internal_deferred{ m_format, m_buffer, m_offset, m_length };
+  }
+
+  kwiver::vital::any
+  to_any() const override final
+  {
+    return resolved().to_any();
+  }
+
+  internal_base const&
+  resolved() const override final
+  {
+    std::call_once( m_once, [ this ](){ parse(); } );
+    return *m_value;
+  }
+
+  bool
+  is_deferred() const noexcept override final
+  {
+    return !m_parsed.load( std::memory_order_acquire );
+  }
+
+  // Parse if necessary, then hand over ownership of the parsed value.
+  std::unique_ptr< internal_base >
+  release()
+  {
+    resolved();
+    return std::move( m_value );
+  }
+
+private:
+  void
+  parse() const;
+
+  klv_data_format const& m_format;
+  std::shared_ptr< klv_bytes_t const > const m_buffer;
+  size_t m_offset;
+  size_t m_length;
+  mutable std::once_flag m_once;
+  mutable std::unique_ptr< internal_base > m_value;
+  mutable std::atomic< bool > m_parsed;
+};
+
 // ----------------------------------------------------------------------------
 klv_value
 ::klv_value()
@@ -212,6 +308,19 @@ ::operator=( T&& rhs )
   return *this;
 }
 
+// ----------------------------------------------------------------------------
+klv_value
+klv_value
+::deferred( klv_data_format const& format,
+            std::shared_ptr< klv_bytes_t const > const& buffer,
+            size_t offset, size_t length )
+{
+  klv_value result;
+  result.m_item.reset(
+    new internal_deferred{ format, buffer, offset, length } );
+  return result;
+}
+
 // ----------------------------------------------------------------------------
 kwiver::vital::any
 klv_value
@@ -237,6 +346,14 @@ ::empty() const noexcept
   return !m_item;
 }
 
+// ----------------------------------------------------------------------------
+bool
+klv_value
+::is_deferred() const noexcept
+{
+  return m_item && m_item->is_deferred();
+}
+
 // ----------------------------------------------------------------------------
 bool
 klv_value
@@ -318,6 +435,13 @@ ::get_ptr() noexcept
     return nullptr;
   }
 
+  // The caller may modify the value, so it no longer needs its raw bytes
+  auto const deferred = dynamic_cast< internal_deferred* >( m_item.get() );
+  if( deferred )
+  {
+    m_item = deferred->release();
+  }
+
   auto const ptr = dynamic_cast< internal_< T >* >( m_item.get() );
   return ptr ? &ptr->m_item : nullptr;
 }
@@ -333,7 +457,8 @@ ::get_ptr() const noexcept
     return nullptr;
   }
 
-  auto const ptr = dynamic_cast< internal_< T > const* >( m_item.get() );
+  auto const ptr =
+    dynamic_cast< internal_< T > const* >( &m_item->resolved() );
   return ptr ? &ptr->m_item : nullptr;
 }
 
@@ -345,7 +470,9 @@ operator<( klv_value const& lhs, klv_value const& rhs )
   {
     return false;
   }
-  return lhs.empty() ? true : lhs.m_item->less_than( *rhs.m_item );
+  return lhs.empty()
+         ? true
+         : lhs.m_item->resolved().less_than( rhs.m_item->resolved() );
 }
 
 // ----------------------------------------------------------------------------
@@ -358,7 +485,7 @@ operator==( klv_value const& lhs, klv_value const& rhs )
   }
   return ( lhs.empty() && rhs.empty() )
          ? true
-         : lhs.m_item->equal_to( *rhs.m_item );
+         : lhs.m_item->resolved().equal_to( rhs.m_item->resolved() );
 }
 
 // ----------------------------------------------------------------------------
@@ -474,6 +601,28 @@ KLV_INSTANTIATE( std::vector< uint16_t > );
 KLV_INSTANTIATE( std::vector< uint64_t > );
 KLV_INSTANTIATE( uint64_t );
 
+// ----------------------------------------------------------------------------
+// Defined after the explicit instantiations, which must precede the implicit
+// instantiation of internal_< klv_blob > here
+void
+klv_value::internal_deferred
+::parse() const
+{
+  auto const begin = m_buffer->data() + m_offset;
+  auto it = begin;
+  auto value = m_format.read( it, m_length );
+  if( value.m_item )
+  {
+    m_value = std::move( value.m_item );
+  }
+  else
+  {
+    m_value.reset( new internal_< klv_blob >{
+                     klv_blob( klv_bytes_t( begin, begin + m_length ) ) } );
+  }
+  m_parsed.store( true, std::memory_order_release );
+}
+
 } // namespace klv
 
 } // namespace arrows
@@ -10,6 +10,7 @@
 
 #include <vital/any.h>
 
+#include <memory>
 #include <sstream>
 
 #ifndef KWIVER_ARROWS_KLV_KLV_VALUE_H_
@@ -21,6 +22,8 @@ namespace arrows {
 
 namespace klv {
 
+class klv_data_format;
+
 // ----------------------------------------------------------------------------
 /// Exception indicating a \c klv_value container did not contain the requested
 /// type.
@@ -76,6 +79,18 @@ class KWIVER_ALGO_KLV_EXPORT klv_value
   klv_value&
   operator=( T&& rhs );
 
+  /// Create an object holding \p length bytes of \p buffer, starting at
+  /// \p offset, which are parsed by \p format the first time the value is
+  /// accessed.
+  ///
+  /// Copies made before then share \p buffer and parse it independently. The
+  /// object and its copies keep \p buffer for as long as they exist.
+  /// \p format must outlive the returned object and all copies of it.
+  static klv_value
+  deferred( klv_data_format const& format,
+            std::shared_ptr< klv_bytes_t const > const& buffer,
+            size_t offset, size_t length );
+
   /// Swap the contents of this \c klv_value with another.
   klv_value&
   swap( klv_value& rhs ) noexcept;
@@ -88,6 +103,10 @@ class KWIVER_ALGO_KLV_EXPORT klv_value
   bool
   empty() const noexcept;
 
+  /// Check if the object holds raw bytes which have not been parsed yet.
+  bool
+  is_deferred() const noexcept;
+
   /// Check if the object contains a value which is not of type \c klv_blob.
   bool
   valid() const noexcept;
@@ -150,6 +169,9 @@ class KWIVER_ALGO_KLV_EXPORT klv_value
   // Type-specific implementation of the internal_base interface.
   template < class T > class internal_;
 
+  // Raw bytes which are parsed into an internal_ on first access.
+  class internal_deferred;
+
   std::unique_ptr< internal_base > m_item;
 };
 
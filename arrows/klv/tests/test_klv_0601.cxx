@@ -9,6 +9,10 @@
 
 #include <arrows/klv/klv_0601.h>
 #include <arrows/klv/klv_1204.h>
+#include <arrows/klv/klv_read_write.h>
+
+#include <thread>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 int
@@ -560,3 +564,109 @@ TEST ( klv, read_write_0601_packet )
   CALL_TEST( test_read_write_packet,
              expected_result, input_bytes, packet_footer, klv_0601_key() );
 }
+
+// ----------------------------------------------------------------------------
+TEST ( klv, read_0601_deferred )
+{
+  klv_0601_local_set_format format;
+  ASSERT_TRUE( format.deferred() );
+
+  auto it = &*input_bytes.cbegin();
+  auto const value = format.read( it, input_bytes.size() );
+  ASSERT_EQ( &*input_bytes.cend(), it );
+
+  // No entry is parsed until it is accessed, except for null entries and
+  // the SDCC-FLP, which depends on the entries preceding it
+  auto const& set = value.get< klv_local_set >();
+  for( auto const& entry : set )
+  {
+    EXPECT_EQ( !entry.second.empty() && entry.first != KLV_0601_SDCC_FLP,
+               entry.second.is_deferred() ) << entry.first;
+  }
+
+  auto const& mission_id = set.at( KLV_0601_MISSION_ID );
+  EXPECT_EQ( "MISSION01", mission_id.get< std::string >() );
+  EXPECT_FALSE( mission_id.is_deferred() );
+  EXPECT_TRUE( set.at( KLV_0601_PLATFORM_TAIL_NUMBER ).is_deferred() );
+
+  // Copies of unparsed entries parse independently
+  auto const copy = value;
+  auto const& copy_set = copy.get< klv_local_set >();
+  EXPECT_FALSE( copy_set.at( KLV_0601_MISSION_ID ).is_deferred() );
+  EXPECT_TRUE( copy_set.at( KLV_0601_PLATFORM_TAIL_NUMBER ).is_deferred() );
+  EXPECT_EQ( expected_result, copy );
+  EXPECT_EQ( expected_result, value );
+
+  // Parsing eagerly produces the same values
+  format.set_deferred( false );
+  it = &*input_bytes.cbegin();
+  auto const eager = format.read( it, input_bytes.size() );
+  for( auto const& entry : eager.get< klv_local_set >() )
+  {
+    EXPECT_FALSE( entry.second.is_deferred() );
+  }
+  EXPECT_EQ( value, eager );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, read_0601_deferred_concurrent )
+{
+  klv_0601_local_set_format const format;
+
+  for( size_t round = 0; round < 20; ++round )
+  {
+    auto it = &*input_bytes.cbegin();
+    auto const value = format.read( it, input_bytes.size() );
+
+    // Copying the set while other threads parse its entries must neither
+    // race nor leave the copies unable to parse
+    std::vector< klv_value > copies( 4 );
+    std::vector< std::thread > threads;
+    for( size_t i = 0; i < copies.size(); ++i )
+    {
+      threads.emplace_back( [ &value ](){
+        for( auto const& entry : value.get< klv_local_set >() )
+        {
+          entry.second.valid();
+        }
+      } );
+      threads.emplace_back( [ &value, &copies, i ](){
+        copies[ i ] = value;
+      } );
+    }
+    for( auto& thread : threads )
+    {
+      thread.join();
+    }
+
+    EXPECT_EQ( expected_result, value );
+    for( auto const& copy : copies )
+    {
+      EXPECT_EQ( expected_result, copy );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, read_0601_deferred_shared_buffer )
+{
+  klv_0601_local_set_format const format;
+  auto const buffer = std::make_shared< klv_bytes_t const >( input_bytes );
+
+  klv_value value;
+  {
+    klv_read_buffer_scope const scope{ buffer };
+    auto it = buffer->data();
+    value = format.read( it, buffer->size() );
+  }
+
+  // Unparsed entries refer to the offered buffer instead of a copy
+  EXPECT_LT( 1, buffer.use_count() );
+  EXPECT_EQ( expected_result, value );
+
+  // Without a scope, the set's bytes are copied
+  auto const unshared = std::make_shared< klv_bytes_t const >( input_bytes );
+  auto it = unshared->data();
+  EXPECT_EQ( expected_result, format.read( it, unshared->size() ) );
+  EXPECT_EQ( 1, unshared.use_count() );
+}
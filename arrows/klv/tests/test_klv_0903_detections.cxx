@@ -0,0 +1,314 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Test direct conversion between KLV 0903 and detections.
+
+#include "data_format.h"
+
+#include <arrows/klv/klv_0903.h>
+#include <arrows/klv/klv_0903_detections.h>
+#include <arrows/klv/klv_0903_vmask_set.h>
+#include <arrows/klv/klv_0903_vobject_set.h>
+#include <arrows/klv/klv_0903_vtarget_pack.h>
+
+#include <cmath>
+
+using kld = klv_lengthy< double >;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+uint64_t
+pixel( uint64_t row, uint64_t column )
+{
+  return row * 1920 + column + 1;
+}
+
+// ----------------------------------------------------------------------------
+auto const vmti = klv_local_set{
+  { KLV_0903_PRECISION_TIMESTAMP, uint64_t{ 987654321000000 } },
+  { KLV_0903_VMTI_SYSTEM_NAME, std::string{ "DSTO_ADSS_VMTI" } },
+  { KLV_0903_VERSION, uint64_t{ 5 } },
+  { KLV_0903_FRAME_WIDTH, uint64_t{ 1920 } },
+  { KLV_0903_FRAME_HEIGHT, uint64_t{ 1080 } },
+  { KLV_0903_VTARGET_SERIES,
+    std::vector< klv_0903_vtarget_pack >{
+      { 1, klv_local_set{
+          { KLV_0903_VTARGET_CENTROID, pixel( 213, 639 ) } } },
+      { 2, klv_local_set{
+          { KLV_0903_VTARGET_CENTROID, pixel( 10, 30 ) },
+          { KLV_0903_VTARGET_BOUNDARY_TOP_LEFT, pixel( 1, 10 ) },
+          { KLV_0903_VTARGET_BOUNDARY_BOTTOM_RIGHT, pixel( 20, 50 ) },
+          { KLV_0903_VTARGET_PRIORITY, uint64_t{ 27 } },
+          { KLV_0903_VTARGET_CONFIDENCE_LEVEL, uint64_t{ 80 } },
+          { KLV_0903_VTARGET_VOBJECT,
+            klv_local_set{
+              { KLV_0903_VOBJECT_ONTOLOGY, std::string{ "URI" } },
+              { KLV_0903_VOBJECT_ONTOLOGY_CLASS, std::string{ "car" } },
+              { KLV_0903_VOBJECT_CONFIDENCE, kld{ 90.0, 2 } } } } } },
+      { 3, klv_local_set{
+          { KLV_0903_VTARGET_VMASK,
+            klv_local_set{
+              { KLV_0903_VMASK_POLYGON,
+                std::vector< uint64_t >{
+                  pixel( 100, 200 ), pixel( 150, 300 ),
+                  pixel( 120, 180 ) } },
+              { KLV_0903_VMASK_BITMASK_SERIES,
+                std::vector< klv_0903_pixel_run >{ { 74, 2 } } } } },
+          { KLV_0903_VTARGET_VOBJECT_SERIES,
+            std::vector< klv_local_set >{
+              { { KLV_0903_VOBJECT_ONTOLOGY_CLASS, std::string{ "person" } },
+                { KLV_0903_VOBJECT_CONFIDENCE, kld{ 40.0, 2 } } },
+              { { KLV_0903_VOBJECT_ONTOLOGY_CLASS, std::string{ "bike" } },
+                { KLV_0903_VOBJECT_CONFIDENCE, kld{ 70.0, 2 } } } } } } },
+      { 4, klv_local_set{
+          { KLV_0903_VTARGET_CENTROID_ROW, uint64_t{ 5 } },
+          { KLV_0903_VTARGET_CENTROID_COLUMN, uint64_t{ 7 } } } },
+      { 5, klv_local_set{
+          { KLV_0903_VTARGET_PRIORITY, uint64_t{ 3 } } } } } } };
+
+// ----------------------------------------------------------------------------
+klv_bytes_t
+write_vmti( klv_local_set const& set )
+{
+  klv_0903_local_set_format const format;
+  klv_bytes_t bytes( format.length_of( set ) );
+  auto it = &*bytes.begin();
+  format.write( set, it, bytes.size() );
+  return bytes;
+}
+
+// ----------------------------------------------------------------------------
+void
+expect_equal_or_nan( double expected, double actual, double tolerance )
+{
+  if( std::isnan( expected ) )
+  {
+    EXPECT_TRUE( std::isnan( actual ) );
+  }
+  else
+  {
+    EXPECT_NEAR( expected, actual, tolerance );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+expect_equal( klv_0903_detections const& expected,
+              klv_0903_detections const& actual )
+{
+  EXPECT_EQ( expected.timestamp, actual.timestamp );
+  EXPECT_EQ( expected.frame_width, actual.frame_width );
+  EXPECT_EQ( expected.frame_height, actual.frame_height );
+  ASSERT_EQ( expected.size(), actual.size() );
+  EXPECT_EQ( expected.id, actual.id );
+  EXPECT_EQ( expected.min_x, actual.min_x );
+  EXPECT_EQ( expected.min_y, actual.min_y );
+  EXPECT_EQ( expected.max_x, actual.max_x );
+  EXPECT_EQ( expected.max_y, actual.max_y );
+  for( size_t i = 0; i < expected.size(); ++i )
+  {
+    SCOPED_TRACE( i );
+    expect_equal_or_nan( expected.confidence[ i ], actual.confidence[ i ],
+                         0.005 );
+    expect_equal_or_nan( expected.class_score[ i ], actual.class_score[ i ],
+                         0.001 );
+
+    auto const expected_class = expected.class_index[ i ];
+    auto const actual_class = actual.class_index[ i ];
+    if( expected_class == klv_0903_detections::no_class )
+    {
+      EXPECT_EQ( klv_0903_detections::no_class, actual_class );
+    }
+    else
+    {
+      ASSERT_LT( actual_class, actual.class_names.size() );
+      EXPECT_EQ( expected.class_names[ expected_class ],
+                 actual.class_names[ actual_class ] );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+klv_0903_detections
+expected_detections()
+{
+  auto const nan = std::numeric_limits< double >::quiet_NaN();
+  auto const none = klv_0903_detections::no_class;
+
+  klv_0903_detections result;
+  result.timestamp = 987654321000000;
+  result.frame_width = 1920;
+  result.frame_height = 1080;
+  result.id = { 1, 2, 3, 4 };
+  result.min_x = { 639.0, 10.0, 180.0, 6.0 };
+  result.min_y = { 213.0, 1.0, 100.0, 4.0 };
+  result.max_x = { 640.0, 51.0, 301.0, 7.0 };
+  result.max_y = { 214.0, 21.0, 151.0, 5.0 };
+  result.confidence = { nan, 0.8, nan, nan };
+  result.class_index = { none, 0, 1, none };
+  result.class_score = { nan, 0.9, 0.7, nan };
+  result.class_names = { "car", "bike" };
+  return result;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST ( klv, read_0903_detections_bytes )
+{
+  auto const bytes = write_vmti( vmti );
+  klv_0903_detections result;
+  auto it = &*bytes.cbegin();
+  klv_0903_read_detections( it, bytes.size(), result );
+  EXPECT_EQ( &*bytes.cend(), it );
+  expect_equal( expected_detections(), result );
+  EXPECT_EQ( ( std::vector< std::string >{ "car", "bike" } ),
+             result.class_names );
+
+  // Class indices are kept across frames
+  it = &*bytes.cbegin();
+  klv_0903_read_detections( it, bytes.size(), result );
+  EXPECT_EQ( 2, result.class_names.size() );
+  EXPECT_EQ( 1, result.class_index[ 2 ] );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, read_0903_detections_set )
+{
+  // Read through the deferred parse of the set's bytes
+  auto const bytes = write_vmti( vmti );
+  auto it = &*bytes.cbegin();
+  auto const set =
+    klv_0903_local_set_format().read( it, bytes.size() ).get< klv_local_set >();
+
+  klv_0903_detections result;
+  klv_0903_read_detections( set, result );
+  expect_equal( expected_detections(), result );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, read_0903_detections_no_width )
+{
+  auto set = vmti;
+  set.erase( set.find( KLV_0903_FRAME_WIDTH ) );
+  auto const bytes = write_vmti( set );
+
+  // Only the target located by centroid row and column can be placed
+  klv_0903_detections result;
+  auto it = &*bytes.cbegin();
+  klv_0903_read_detections( it, bytes.size(), result );
+  EXPECT_EQ( 0, result.frame_width );
+  ASSERT_EQ( 1, result.size() );
+  EXPECT_EQ( 4, result.id[ 0 ] );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, write_0903_detections )
+{
+  auto const expected = expected_detections();
+  klv_bytes_t bytes( klv_0903_detections_length( expected ) );
+  auto write_it = &*bytes.begin();
+  klv_0903_write_detections( expected, write_it, bytes.size() );
+  EXPECT_EQ( &*bytes.end(), write_it );
+
+  // The bytes are a valid ST0903 set
+  auto read_it = &*bytes.cbegin();
+  auto const set =
+    klv_0903_local_set_format().read( read_it, bytes.size() );
+  ASSERT_TRUE( set.valid() );
+  auto const& targets =
+    set.get< klv_local_set >().at( KLV_0903_VTARGET_SERIES )
+    .get< std::vector< klv_0903_vtarget_pack > >();
+  ASSERT_EQ( 4, targets.size() );
+  EXPECT_EQ( pixel( 1, 10 ),
+             targets[ 1 ].set.at( KLV_0903_VTARGET_BOUNDARY_TOP_LEFT )
+             .get< uint64_t >() );
+  EXPECT_EQ( pixel( 20, 50 ),
+             targets[ 1 ].set.at( KLV_0903_VTARGET_BOUNDARY_BOTTOM_RIGHT )
+             .get< uint64_t >() );
+
+  klv_0903_detections result;
+  read_it = &*bytes.cbegin();
+  klv_0903_read_detections( read_it, bytes.size(), result );
+  expect_equal( expected, result );
+
+  // A target cannot be numbered without the frame width
+  auto no_width = expected;
+  no_width.frame_width = 0;
+  write_it = &*bytes.begin();
+  EXPECT_THROW(
+    klv_0903_write_detections( no_width, write_it, bytes.size() ),
+    kv::metadata_exception );
+
+  write_it = &*bytes.begin();
+  EXPECT_THROW(
+    klv_0903_write_detections( expected, write_it, bytes.size() - 1 ),
+    kv::metadata_buffer_overflow );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, write_0903_detections_packet )
+{
+  auto const expected = expected_detections();
+  auto const packet = klv_0903_detections_packet( expected );
+  EXPECT_EQ( klv_0903_key(), packet.key );
+
+  klv_bytes_t bytes( klv_packet_length( packet ) );
+  auto write_it = &*bytes.begin();
+  klv_write_packet( packet, write_it, bytes.size() );
+
+  auto read_it = &*bytes.cbegin();
+  auto const result_packet = klv_read_packet( read_it, bytes.size() );
+  ASSERT_TRUE( result_packet.value.valid() );
+
+  klv_0903_detections result;
+  klv_0903_read_detections( result_packet.value.get< klv_local_set >(),
+                            result );
+  expect_equal( expected, result );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, convert_0903_detections_vital )
+{
+  auto const expected = expected_detections();
+  auto const set = klv_0903_to_detected_object_set( expected );
+  ASSERT_EQ( 4, set->size() );
+
+  auto const object = set->at( 1 );
+  EXPECT_EQ( 2, object->index() );
+  EXPECT_EQ( kv::bounding_box_d( 10.0, 1.0, 51.0, 21.0 ),
+             object->bounding_box() );
+  EXPECT_DOUBLE_EQ( 0.8, object->confidence() );
+  ASSERT_NE( nullptr, object->type() );
+  EXPECT_DOUBLE_EQ( 0.9, object->type()->score( "car" ) );
+  EXPECT_DOUBLE_EQ( 1.0, set->at( 0 )->confidence() );
+  EXPECT_EQ( nullptr, set->at( 0 )->type() );
+
+  klv_0903_detections result;
+  result.timestamp = expected.timestamp;
+  result.frame_width = expected.frame_width;
+  result.frame_height = expected.frame_height;
+  klv_0903_from_detected_object_set( *set, result );
+
+  // Missing confidences have become one
+  auto with_confidence = expected;
+  for( auto& confidence : with_confidence.confidence )
+  {
+    if( std::isnan( confidence ) )
+    {
+      confidence = 1.0;
+    }
+  }
+  expect_equal( with_confidence, result );
+}
@@ -0,0 +1,414 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Benchmark KLV packet parsing and serialization.
+///
+/// Each test builds a corpus of valid packets of one standard with randomized
+/// field values, then reads and writes it, reporting packets per second and
+/// bytes allocated per packet. Allocation is deterministic for a given build,
+/// so it is checked against a fixed budget. Rates depend on the machine, so
+/// they are checked only against a floor passed as \c --min-rate=<packets/s>.
+
+#include <arrows/klv/klv_0601.h>
+#include <arrows/klv/klv_0903.h>
+#include <arrows/klv/klv_0903_vtarget_pack.h>
+#include <arrows/klv/klv_1002.h>
+#include <arrows/klv/klv_1108.h>
+#include <arrows/klv/klv_1108_metric_set.h>
+#include <arrows/klv/klv_1202.h>
+#include <arrows/klv/klv_packet.h>
+
+#include <tests/test_gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <random>
+
+using namespace kwiver::arrows::klv;
+namespace kv = kwiver::vital;
+
+using kld = klv_lengthy< double >;
+
+namespace {
+
+std::atomic< size_t > g_allocated_bytes{ 0 };
+double g_min_rate = 0.0;
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+// Count the bytes requested from the global allocator
+void*
+operator new( size_t size )
+{
+  g_allocated_bytes.fetch_add( size, std::memory_order_relaxed );
+  if( auto const ptr = std::malloc( size ? size : 1 ) )
+  {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+// ----------------------------------------------------------------------------
+void
+operator delete( void* ptr ) noexcept
+{
+  std::free( ptr );
+}
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+
+  std::string const min_rate_flag = "--min-rate=";
+  for( int i = 1; i < argc; ++i )
+  {
+    std::string const arg = argv[ i ];
+    if( !arg.compare( 0, min_rate_flag.size(), min_rate_flag ) )
+    {
+      g_min_rate = std::stod( arg.substr( min_rate_flag.size() ) );
+    }
+  }
+
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using clock_t = std::chrono::steady_clock;
+
+constexpr size_t corpus_size = 500;
+constexpr size_t passes = 4;
+
+// ----------------------------------------------------------------------------
+double
+uniform( std::mt19937& rng, double lower, double upper )
+{
+  return std::uniform_real_distribution< double >{ lower, upper }( rng );
+}
+
+// ----------------------------------------------------------------------------
+uint64_t
+uniform_int( std::mt19937& rng, uint64_t lower, uint64_t upper )
+{
+  return std::uniform_int_distribution< uint64_t >{ lower, upper }( rng );
+}
+
+// ----------------------------------------------------------------------------
+// Parse every value of a set, including any left deferred by the reader
+void
+resolve( klv_packet const& packet )
+{
+  for( auto const& entry : packet.value.get< klv_local_set >() )
+  {
+    entry.second.valid();
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+report( char const* name, char const* operation,
+        clock_t::duration elapsed, size_t allocated )
+{
+  auto const count = static_cast< double >( corpus_size * passes );
+  auto const rate =
+    count / std::chrono::duration< double >( elapsed ).count();
+  std::cout << std::left << std::setw( 6 ) << name
+            << std::setw( 6 ) << operation
+            << std::right << std::setw( 12 ) << std::fixed
+            << std::setprecision( 0 ) << rate << " packets/s"
+            << std::setw( 10 ) << allocated / count << " bytes/packet\n";
+  if( g_min_rate > 0.0 )
+  {
+    EXPECT_LE( g_min_rate, rate ) << name << " " << operation;
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Time reading then writing the corpus, checking that allocation per packet
+// stays within the given budgets and that the bytes round-trip exactly
+void
+run_benchmark( char const* name, std::vector< klv_packet > const& corpus,
+               size_t read_budget, size_t write_budget )
+{
+  ASSERT_EQ( corpus_size, corpus.size() );
+
+  std::vector< klv_bytes_t > encoded;
+  for( auto const& packet : corpus )
+  {
+    klv_bytes_t bytes( klv_packet_length( packet ) );
+    auto it = &*bytes.begin();
+    klv_write_packet( packet, it, bytes.size() );
+    encoded.emplace_back( std::move( bytes ) );
+  }
+
+  // Reading
+  std::vector< klv_packet > decoded( corpus_size );
+  auto allocated = g_allocated_bytes.load();
+  auto start = clock_t::now();
+  for( size_t pass = 0; pass < passes; ++pass )
+  {
+    for( size_t i = 0; i < corpus_size; ++i )
+    {
+      klv_read_iter_t it = encoded[ i ].data();
+      decoded[ i ] = klv_read_packet( it, encoded[ i ].size() );
+      resolve( decoded[ i ] );
+    }
+  }
+  auto elapsed = clock_t::now() - start;
+  auto const read_allocated = g_allocated_bytes.load() - allocated;
+  report( name, "read", elapsed, read_allocated );
+
+  // Writing
+  std::vector< klv_bytes_t > reencoded( corpus_size );
+  for( size_t i = 0; i < corpus_size; ++i )
+  {
+    reencoded[ i ].resize( encoded[ i ].size() );
+  }
+  allocated = g_allocated_bytes.load();
+  start = clock_t::now();
+  for( size_t pass = 0; pass < passes; ++pass )
+  {
+    for( size_t i = 0; i < corpus_size; ++i )
+    {
+      auto& bytes = reencoded[ i ];
+      auto it = &*bytes.begin();
+      klv_write_packet( decoded[ i ], it, bytes.size() );
+    }
+  }
+  elapsed = clock_t::now() - start;
+  auto const write_allocated = g_allocated_bytes.load() - allocated;
+  report( name, "write", elapsed, write_allocated );
+
+  for( size_t i = 0; i < corpus_size; ++i )
+  {
+    ASSERT_EQ( encoded[ i ], reencoded[ i ] ) << name << " packet " << i;
+  }
+
+  EXPECT_GE( read_budget * corpus_size * passes, read_allocated )
+    << name << " read allocation regressed";
+  EXPECT_GE( write_budget * corpus_size * passes, write_allocated )
+    << name << " write allocation regressed";
+}
+
+// ----------------------------------------------------------------------------
+std::vector< klv_packet >
+make_0601_corpus()
+{
+  std::mt19937 rng{ 601 };
+  std::vector< klv_packet > result;
+  for( size_t i = 0; i < corpus_size; ++i )
+  {
+    klv_local_set set{
+      { KLV_0601_PRECISION_TIMESTAMP,
+        uint64_t{ 1630000000000000 + i * 33367 } },
+      { KLV_0601_MISSION_ID, std::string{ "MISSION01" } },
+      { KLV_0601_PLATFORM_TAIL_NUMBER, std::string{ "AF-101" } },
+      { KLV_0601_PLATFORM_HEADING_ANGLE, kld{ uniform( rng, 0.0, 360.0 ) } },
+      { KLV_0601_PLATFORM_PITCH_ANGLE, kld{ uniform( rng, -20.0, 20.0 ) } },
+      { KLV_0601_PLATFORM_ROLL_ANGLE, kld{ uniform( rng, -50.0, 50.0 ) } },
+      { KLV_0601_PLATFORM_DESIGNATION, std::string{ "MQ1-B" } },
+      { KLV_0601_IMAGE_SOURCE_SENSOR, std::string{ "EO" } },
+      { KLV_0601_IMAGE_COORDINATE_SYSTEM, std::string{ "Geodetic WGS84" } },
+      { KLV_0601_SENSOR_LATITUDE, kld{ uniform( rng, -90.0, 90.0 ) } },
+      { KLV_0601_SENSOR_LONGITUDE, kld{ uniform( rng, -180.0, 180.0 ) } },
+      { KLV_0601_SENSOR_TRUE_ALTITUDE,
+        kld{ uniform( rng, -900.0, 19000.0 ) } },
+      { KLV_0601_SENSOR_HORIZONTAL_FOV, kld{ uniform( rng, 0.0, 180.0 ) } },
+      { KLV_0601_SENSOR_VERTICAL_FOV, kld{ uniform( rng, 0.0, 180.0 ) } },
+      { KLV_0601_SENSOR_RELATIVE_AZIMUTH_ANGLE,
+        kld{ uniform( rng, 0.0, 360.0 ) } },
+      { KLV_0601_SENSOR_RELATIVE_ELEVATION_ANGLE,
+        kld{ uniform( rng, -180.0, 180.0 ) } },
+      { KLV_0601_SENSOR_RELATIVE_ROLL_ANGLE,
+        kld{ uniform( rng, 0.0, 360.0 ) } },
+      { KLV_0601_SLANT_RANGE, kld{ uniform( rng, 0.0, 5000000.0 ) } },
+      { KLV_0601_TARGET_WIDTH, kld{ uniform( rng, 0.0, 10000.0 ) } },
+      { KLV_0601_FRAME_CENTER_LATITUDE, kld{ uniform( rng, -90.0, 90.0 ) } },
+      { KLV_0601_FRAME_CENTER_LONGITUDE,
+        kld{ uniform( rng, -180.0, 180.0 ) } },
+      { KLV_0601_FRAME_CENTER_ELEVATION,
+        kld{ uniform( rng, -900.0, 19000.0 ) } },
+      { KLV_0601_OFFSET_CORNER_LATITUDE_POINT_1,
+        kld{ uniform( rng, -0.075, 0.075 ) } },
+      { KLV_0601_OFFSET_CORNER_LONGITUDE_POINT_1,
+        kld{ uniform( rng, -0.075, 0.075 ) } },
+      { KLV_0601_OFFSET_CORNER_LATITUDE_POINT_2,
+        kld{ uniform( rng, -0.075, 0.075 ) } },
+      { KLV_0601_OFFSET_CORNER_LONGITUDE_POINT_2,
+        kld{ uniform( rng, -0.075, 0.075 ) } },
+      { KLV_0601_OFFSET_CORNER_LATITUDE_POINT_3,
+        kld{ uniform( rng, -0.075, 0.075 ) } },
+      { KLV_0601_OFFSET_CORNER_LONGITUDE_POINT_3,
+        kld{ uniform( rng, -0.075, 0.075 ) } },
+      { KLV_0601_OFFSET_CORNER_LATITUDE_POINT_4,
+        kld{ uniform( rng, -0.075, 0.075 ) } },
+      { KLV_0601_OFFSET_CORNER_LONGITUDE_POINT_4,
+        kld{ uniform( rng, -0.075, 0.075 ) } },
+      { KLV_0601_PLATFORM_GROUND_SPEED,
+        kld{ static_cast< double >( uniform_int( rng, 0, 255 ) ) } },
+      { KLV_0601_VERSION_NUMBER, uint64_t{ 17 } } };
+    result.push_back( { klv_0601_key(), std::move( set ) } );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< klv_packet >
+make_0903_corpus()
+{
+  std::mt19937 rng{ 903 };
+  std::vector< klv_packet > result;
+  for( size_t i = 0; i < corpus_size; ++i )
+  {
+    std::vector< klv_0903_vtarget_pack > targets;
+    for( auto j = uniform_int( rng, 1, 20 ); j; --j )
+    {
+      targets.push_back( {
+        j, klv_local_set{
+          { KLV_0903_VTARGET_CENTROID, uniform_int( rng, 0, 1920 * 1080 ) },
+          { KLV_0903_VTARGET_BOUNDARY_TOP_LEFT,
+            uniform_int( rng, 0, 1920 * 1080 ) },
+          { KLV_0903_VTARGET_BOUNDARY_BOTTOM_RIGHT,
+            uniform_int( rng, 0, 1920 * 1080 ) },
+          { KLV_0903_VTARGET_PRIORITY, uniform_int( rng, 1, 255 ) },
+          { KLV_0903_VTARGET_CONFIDENCE_LEVEL, uniform_int( rng, 0, 100 ) },
+          { KLV_0903_VTARGET_HISTORY, uniform_int( rng, 0, 10000 ) },
+          { KLV_0903_VTARGET_LOCATION_OFFSET_LATITUDE,
+            kld{ uniform( rng, -19.2, 19.2 ), 3 } },
+          { KLV_0903_VTARGET_LOCATION_OFFSET_LONGITUDE,
+            kld{ uniform( rng, -19.2, 19.2 ), 3 } },
+          { KLV_0903_VTARGET_CENTROID_ROW, uniform_int( rng, 0, 1080 ) },
+          { KLV_0903_VTARGET_CENTROID_COLUMN, uniform_int( rng, 0, 1920 ) },
+          { KLV_0903_VTARGET_ALGORITHM_ID, uint64_t{ 3 } } } } );
+    }
+
+    klv_local_set set{
+      { KLV_0903_PRECISION_TIMESTAMP,
+        uint64_t{ 1630000000000000 + i * 33367 } },
+      { KLV_0903_VMTI_SYSTEM_NAME, std::string{ "KWIVER_VMTI" } },
+      { KLV_0903_VERSION, uint64_t{ 5 } },
+      { KLV_0903_NUM_TARGETS_DETECTED, uint64_t{ targets.size() } },
+      { KLV_0903_NUM_TARGETS_REPORTED, uint64_t{ targets.size() } },
+      { KLV_0903_FRAME_NUMBER, uint64_t{ i } },
+      { KLV_0903_FRAME_WIDTH, uint64_t{ 1920 } },
+      { KLV_0903_FRAME_HEIGHT, uint64_t{ 1080 } },
+      { KLV_0903_SOURCE_SENSOR, std::string{ "EO Nose" } },
+      { KLV_0903_HORIZONTAL_FOV, kld{ uniform( rng, 0.0, 180.0 ), 2 } },
+      { KLV_0903_VERTICAL_FOV, kld{ uniform( rng, 0.0, 180.0 ), 2 } },
+      { KLV_0903_VTARGET_SERIES, std::move( targets ) } };
+    result.push_back( { klv_0903_key(), std::move( set ) } );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< klv_packet >
+make_1108_corpus()
+{
+  std::mt19937 rng{ 1108 };
+  std::vector< klv_packet > result;
+  for( size_t i = 0; i < corpus_size; ++i )
+  {
+    auto const timestamp = uint64_t{ 1630000000000000 + i * 1000000 };
+    klv_local_set const metric_set{
+      { KLV_1108_METRIC_SET_NAME, std::string{ "VNIIRS" } },
+      { KLV_1108_METRIC_SET_VERSION, std::string{ "3.0" } },
+      { KLV_1108_METRIC_SET_IMPLEMENTER,
+        klv_1108_metric_implementer{ "KW", "CV" } },
+      { KLV_1108_METRIC_SET_PARAMETERS, std::string{ "A0+A1" } },
+      { KLV_1108_METRIC_SET_TIME, timestamp },
+      { KLV_1108_METRIC_SET_VALUE, kld{ uniform( rng, 0.0, 9.0 ), 8 } } };
+
+    klv_local_set set{
+      { KLV_1108_ASSESSMENT_POINT, KLV_1108_ASSESSMENT_POINT_ARCHIVE },
+      { KLV_1108_METRIC_PERIOD_PACK,
+        klv_1108_metric_period_pack{ timestamp, 1000000 } },
+      { KLV_1108_WINDOW_CORNERS_PACK,
+        klv_1108_window_corners_pack{ { 0, 0, 1280, 720 } } },
+      { KLV_1108_METRIC_LOCAL_SET, metric_set },
+      { KLV_1108_COMPRESSION_TYPE, KLV_1108_COMPRESSION_TYPE_H264 },
+      { KLV_1108_COMPRESSION_PROFILE, KLV_1108_COMPRESSION_PROFILE_HIGH },
+      { KLV_1108_COMPRESSION_LEVEL, std::string{ "5.2" } },
+      { KLV_1108_COMPRESSION_RATIO,
+        kld{ uniform( rng, 1.0, 100.0 ), 4 } },
+      { KLV_1108_STREAM_BITRATE, uniform_int( rng, 256, 20000 ) },
+      { KLV_1108_DOCUMENT_VERSION, uint64_t{ 3 } } };
+    result.push_back( { klv_1108_key(), std::move( set ) } );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< klv_packet >
+make_1002_corpus()
+{
+  std::mt19937 rng{ 1002 };
+  std::vector< klv_packet > result;
+  for( size_t i = 0; i < corpus_size; ++i )
+  {
+    klv_local_set set{
+      { KLV_1002_PRECISION_TIMESTAMP,
+        uint64_t{ 1630000000000000 + i * 33367 } },
+      { KLV_1002_DOCUMENT_VERSION, uint64_t{ 2 } },
+      { KLV_1002_RANGE_IMAGE_ENUMERATIONS,
+        klv_1002_enumerations{
+          KLV_1002_COMPRESSION_METHOD_NONE,
+          KLV_1002_DATA_TYPE_DEPTH_RANGE_IMAGE,
+          KLV_1002_SOURCE_RANGE_SENSOR } },
+      { KLV_1002_SPRM, kld{ uniform( rng, 0.0, 1000.0 ), 4 } },
+      { KLV_1002_SPRM_UNCERTAINTY, kld{ uniform( rng, 0.0, 10.0 ), 4 } },
+      { KLV_1002_SPRM_ROW, kld{ 320.0, 4 } },
+      { KLV_1002_SPRM_COLUMN, kld{ 240.0, 4 } },
+      { KLV_1002_NUMBER_SECTIONS_X, uint64_t{ 4 } },
+      { KLV_1002_NUMBER_SECTIONS_Y, uint64_t{ 1 } },
+      { KLV_1002_GENERALIZED_TRANSFORMATION_LOCAL_SET,
+        klv_local_set{ { KLV_1202_VERSION, uint64_t{ 1 } } } },
+      { KLV_1002_SECTION_DATA_PACK,
+        klv_1002_section_data_pack{
+          2, 0,
+          { { 2, 2 },
+            { uniform( rng, 0.0, 200.0 ), uniform( rng, 0.0, 200.0 ),
+              uniform( rng, 0.0, 200.0 ), uniform( rng, 0.0, 200.0 ) },
+            4, KLV_1303_APA_NATURAL, 0, kv::nullopt },
+          kv::nullopt,
+          kld{ 1.0, 4 },
+          kld{ 2.0, 4 },
+          kv::nullopt } } };
+    result.push_back( { klv_1002_key(), std::move( set ) } );
+  }
+  return result;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST ( klv, benchmark_0601 )
+{
+  CALL_TEST( run_benchmark, "0601", make_0601_corpus(), 23000, 1000 );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, benchmark_0903 )
+{
+  CALL_TEST( run_benchmark, "0903", make_0903_corpus(), 120000, 192000 );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, benchmark_1108 )
+{
+  CALL_TEST( run_benchmark, "1108", make_1108_corpus(), 8200, 700 );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, benchmark_1002 )
+{
+  CALL_TEST( run_benchmark, "1002", make_1002_corpus(), 6800, 650 );
+}
@@ -9,6 +9,9 @@
 
 #include <tests/test_gtest.h>
 
+#include <chrono>
+#include <iostream>
+#include <random>
 #include <vector>
 
 // ----------------------------------------------------------------------------
@@ -80,3 +83,134 @@ TEST ( klv, klv_crc_32_mpeg )
   CALL_TEST( test_crc_32_mpeg, 0x0376E6E7,
              { '1', '2', '3', '4', '5', '6', '7', '8', '9' } );
 }
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Bit-at-a-time reference implementations
+uint16_t
+reference_running_sum_16( vec_t const& data, uint16_t sum, bool parity )
+{
+  for( auto const byte : data )
+  {
+    sum += parity ? byte : static_cast< uint16_t >( byte << 8 );
+    parity = !parity;
+  }
+  return sum;
+}
+
+// ----------------------------------------------------------------------------
+uint16_t
+reference_crc_16_ccitt( vec_t data, uint16_t crc )
+{
+  data.push_back( 0x00 );
+  data.push_back( 0x00 );
+  for( auto const byte : data )
+  {
+    for( size_t i = 0; i < 8; ++i )
+    {
+      bool const high_bit = crc & 0x8000;
+      crc = static_cast< uint16_t >( ( crc << 1 ) |
+                                     ( ( byte >> ( 7 - i ) ) & 1 ) );
+      if( high_bit )
+      {
+        crc ^= 0x1021;
+      }
+    }
+  }
+  return crc;
+}
+
+// ----------------------------------------------------------------------------
+uint32_t
+reference_crc_32_mpeg( vec_t const& data, uint32_t crc )
+{
+  for( auto const byte : data )
+  {
+    crc ^= static_cast< uint32_t >( byte ) << 24;
+    for( size_t i = 0; i < 8; ++i )
+    {
+      crc = ( crc & 0x80000000 ) ? ( ( crc << 1 ) ^ 0x04C11DB7 ) : crc << 1;
+    }
+  }
+  return crc;
+}
+
+// ----------------------------------------------------------------------------
+vec_t
+random_bytes( size_t length, uint32_t seed )
+{
+  std::mt19937 rng{ seed };
+  std::uniform_int_distribution< int > distribution{ 0, 255 };
+  vec_t result( length );
+  for( auto& byte : result )
+  {
+    byte = static_cast< uint8_t >( distribution( rng ) );
+  }
+  return result;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST ( klv, checksum_matches_reference )
+{
+  // Lengths around the eight-byte stride of the sliced loops
+  for( size_t length = 0; length < 40; ++length )
+  {
+    auto const data = random_bytes( length, static_cast< uint32_t >( length ) );
+    auto const begin = data.data();
+    auto const end = data.data() + data.size();
+    for( uint16_t const initial : { 0x0000, 0xFFFF, 0x1234 } )
+    {
+      for( bool const parity : { false, true } )
+      {
+        EXPECT_EQ( reference_running_sum_16( data, initial, parity ),
+                   klv_running_sum_16( begin, end, initial, parity ) )
+          << "Length: " << length;
+      }
+      EXPECT_EQ( reference_crc_16_ccitt( data, initial ),
+                 klv_crc_16_ccitt( begin, end, initial ) )
+        << "Length: " << length;
+    }
+    for( uint32_t const initial : { 0x00000000u, 0xFFFFFFFFu, 0x87654321u } )
+    {
+      EXPECT_EQ( reference_crc_32_mpeg( data, initial ),
+                 klv_crc_32_mpeg( begin, end, initial ) )
+        << "Length: " << length;
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, checksum_benchmark )
+{
+  // Reports throughput only; timing is too noisy to assert on here
+  auto const data = random_bytes( 1 << 22, 0 );
+  auto const begin = data.data();
+  auto const end = data.data() + data.size();
+
+  auto const report =
+    [ &data ]( char const* name,
+               std::chrono::steady_clock::time_point start ){
+      std::chrono::duration< double > const elapsed =
+        std::chrono::steady_clock::now() - start;
+      std::cout << name << ": "
+                << data.size() / elapsed.count() / ( 1 << 20 ) << " MiB/s\n";
+    };
+
+  auto start = std::chrono::steady_clock::now();
+  auto const sum = klv_running_sum_16( begin, end );
+  report( "running_sum_16", start );
+  EXPECT_EQ( reference_running_sum_16( data, 0x0000, false ), sum );
+
+  start = std::chrono::steady_clock::now();
+  auto const crc_16 = klv_crc_16_ccitt( begin, end );
+  report( "crc_16_ccitt", start );
+  EXPECT_EQ( reference_crc_16_ccitt( data, 0xFFFF ), crc_16 );
+
+  start = std::chrono::steady_clock::now();
+  auto const crc_32 = klv_crc_32_mpeg( begin, end );
+  report( "crc_32_mpeg", start );
+  EXPECT_EQ( reference_crc_32_mpeg( data, 0xFFFFFFFF ), crc_32 );
+}
@@ -0,0 +1,100 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Test KLV to vital metadata conversion.
+
+#include <arrows/klv/klv_0601.h>
+#include <arrows/klv/klv_convert_vital.h>
+#include <arrows/klv/klv_packet.h>
+
+#include <tests/test_gtest.h>
+
+using namespace kwiver::arrows::klv;
+namespace kv = kwiver::vital;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+using kld = klv_lengthy< double >;
+
+// ----------------------------------------------------------------------------
+void
+set_0601( klv_timeline& timeline, klv_lds_key tag,
+          uint64_t begin, uint64_t end, klv_value const& value )
+{
+  timeline.insert_or_find( KLV_PACKET_MISB_0601_LOCAL_SET, tag, {} )
+    ->second.set( { begin, end }, value );
+}
+
+// ----------------------------------------------------------------------------
+klv_timeline
+make_timeline()
+{
+  klv_timeline timeline;
+  set_0601( timeline, KLV_0601_MISSION_ID, 0, 300,
+            std::string{ "MISSION01" } );
+  set_0601( timeline, KLV_0601_PLATFORM_HEADING_ANGLE, 0, 100, kld{ 10.0 } );
+  set_0601( timeline, KLV_0601_PLATFORM_HEADING_ANGLE, 100, 200, kld{ 20.0 } );
+  set_0601( timeline, KLV_0601_TARGET_WIDTH, 0, 300, kld{ 5.0 } );
+  set_0601( timeline, KLV_0601_TARGET_WIDTH_EXTENDED, 150, 300, kld{ 6.0 } );
+  set_0601( timeline, KLV_0601_SENSOR_LATITUDE, 50, 250, kld{ 40.0 } );
+  set_0601( timeline, KLV_0601_SENSOR_LONGITUDE, 50, 250, kld{ -70.0 } );
+  set_0601( timeline, KLV_0601_SENSOR_TRUE_ALTITUDE, 50, 250, kld{ 900.0 } );
+  return timeline;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST ( klv, convert_vital_single )
+{
+  auto const timeline = make_timeline();
+
+  auto const early = klv_to_vital_metadata( timeline, 25 );
+  ASSERT_TRUE( early );
+  EXPECT_EQ( "MISSION01",
+             early->find( kv::VITAL_META_MISSION_ID ).as_string() );
+  EXPECT_EQ( 10.0,
+             early->find( kv::VITAL_META_PLATFORM_HEADING_ANGLE ).as_double() );
+  EXPECT_EQ( 5.0, early->find( kv::VITAL_META_TARGET_WIDTH ).as_double() );
+  EXPECT_FALSE( early->has( kv::VITAL_META_SENSOR_LOCATION ) );
+
+  // The extended target width takes precedence where present
+  auto const late = klv_to_vital_metadata( timeline, 175 );
+  ASSERT_TRUE( late );
+  EXPECT_EQ( 20.0,
+             late->find( kv::VITAL_META_PLATFORM_HEADING_ANGLE ).as_double() );
+  EXPECT_EQ( 6.0, late->find( kv::VITAL_META_TARGET_WIDTH ).as_double() );
+  EXPECT_TRUE( late->has( kv::VITAL_META_SENSOR_LOCATION ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, convert_vital_batch )
+{
+  auto const timeline = make_timeline();
+  std::vector< uint64_t > const timestamps = { 0, 25, 75, 100, 175, 250, 400 };
+
+  auto const batch = klv_to_vital_metadata( timeline, timestamps );
+  ASSERT_EQ( timestamps.size(), batch.size() );
+  for( size_t i = 0; i < timestamps.size(); ++i )
+  {
+    auto const single = klv_to_vital_metadata( timeline, timestamps[ i ] );
+    ASSERT_TRUE( batch[ i ] );
+    EXPECT_TRUE( kv::test_equal_content( *single, *batch[ i ] ) )
+      << "Timestamp: " << timestamps[ i ];
+    EXPECT_EQ( timestamps[ i ],
+               batch[ i ]->find( kv::VITAL_META_UNIX_TIMESTAMP ).as_uint64() );
+  }
+
+  EXPECT_TRUE(
+    klv_to_vital_metadata( timeline, std::vector< uint64_t >{} ).empty() );
+}
@@ -0,0 +1,92 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Test the asynchronous KLV frame encoder.
+
+#include <arrows/klv/klv_0601.h>
+#include <arrows/klv/klv_frame_encoder.h>
+
+#include <tests/test_gtest.h>
+
+using namespace kwiver::arrows::klv;
+using kld = klv_lengthy< double >;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+klv_packet
+make_packet( uint64_t timestamp, double heading )
+{
+  return { klv_0601_key(),
+           klv_local_set{
+             { KLV_0601_PRECISION_TIMESTAMP, timestamp },
+             { KLV_0601_PLATFORM_HEADING_ANGLE, kld{ heading } } } };
+}
+
+// ----------------------------------------------------------------------------
+klv_bytes_t
+write_packet( klv_packet const& packet )
+{
+  klv_bytes_t result( klv_packet_length( packet ) );
+  auto it = &*result.begin();
+  klv_write_packet( packet, it, result.size() );
+  return result;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST ( klv, frame_encoder )
+{
+  klv_frame_encoder encoder;
+  EXPECT_EQ( 0, encoder.pending_frames() );
+  EXPECT_FALSE( encoder.frame_ready() );
+  EXPECT_THROW( encoder.receive_frame(), std::logic_error );
+
+  // Many frames in flight at once still come back in order
+  std::vector< std::vector< klv_packet > > frames;
+  for( uint64_t i = 0; i < 50; ++i )
+  {
+    frames.push_back( { make_packet( 1000 + i, i ),
+                        make_packet( 1000 + i, 180.0 + i ) } );
+    if( i % 7 == 0 )
+    {
+      // Frames with no packets are allowed
+      frames.back().clear();
+    }
+    encoder.send_frame( 1000 + i, frames.back() );
+  }
+  EXPECT_EQ( frames.size(), encoder.pending_frames() );
+
+  for( uint64_t i = 0; i < frames.size(); ++i )
+  {
+    auto const frame = encoder.receive_frame();
+    EXPECT_EQ( 1000 + i, frame.timestamp );
+    ASSERT_EQ( frames[ i ].size(), frame.packets.size() );
+    for( size_t j = 0; j < frame.packets.size(); ++j )
+    {
+      EXPECT_EQ( write_packet( frames[ i ][ j ] ), frame.packets[ j ] );
+    }
+  }
+  EXPECT_EQ( 0, encoder.pending_frames() );
+
+  // Timestamps may repeat, but not go backwards
+  encoder.send_frame( 2000, {} );
+  encoder.send_frame( 2000, {} );
+  EXPECT_THROW( encoder.send_frame( 1999, {} ), std::logic_error );
+  EXPECT_EQ( 2, encoder.pending_frames() );
+
+  encoder.reset();
+  EXPECT_EQ( 0, encoder.pending_frames() );
+  EXPECT_NO_THROW( encoder.send_frame( 1999, {} ) );
+}
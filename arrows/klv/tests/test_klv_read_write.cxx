@@ -751,6 +751,55 @@ TEST ( klv, read_flint )
   CALL_TEST( test_sint_invalid_value, 0, 1, -0.9, 1.0 );
 }
 
+// ----------------------------------------------------------------------------
+template < class T >
+void
+test_read_flint_n( vec_t const& data, size_t length,
+                   double minimum, double maximum )
+{
+  auto const count = data.size() / length;
+  auto it = data.data();
+  auto const result =
+    klv_read_flint_n< T >( { minimum, maximum }, it, length, count );
+  EXPECT_EQ( data.data() + count * length, it );
+  ASSERT_EQ( count, result.size() );
+
+  auto cit = data.data();
+  for( auto const value : result )
+  {
+    auto const expected =
+      klv_read_flint< T >( { minimum, maximum }, cit, length );
+    if( std::isnan( expected ) )
+    {
+      EXPECT_TRUE( std::isnan( value ) );
+    }
+    else
+    {
+      EXPECT_EQ( expected, value );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, read_flint_n )
+{
+  vec_t const data = { 0x00, 0x00, 0x80, 0x00, 0x7F, 0xFF,
+                       0xFF, 0xFF, 0x12, 0x34, 0xA1, 0x96 };
+  CALL_TEST( test_read_flint_n< uint16_t >, data, 2, -900.0, 19000.0 );
+  CALL_TEST( test_read_flint_n< int16_t >,  data, 2, -180.0, 180.0 );
+  CALL_TEST( test_read_flint_n< uint32_t >, data, 4, 0.0, 1.0 );
+  CALL_TEST( test_read_flint_n< int32_t >,  data, 3, -90.0, 90.0 );
+  CALL_TEST( test_read_flint_n< uint8_t >,  vec_t{}, 1, 0.0, 1.0 );
+
+  // Errors leave the iterator in place
+  auto it = data.data();
+  EXPECT_THROW( klv_read_flint_n< int16_t >( { 0.0, 1.0 }, it, 2, 6 ),
+                std::logic_error );
+  EXPECT_THROW( klv_read_flint_n< uint16_t >( { 0.0, 1.0 }, it, 3, 4 ),
+                kv::metadata_type_overflow );
+  EXPECT_EQ( data.data(), it );
+}
+
 // ----------------------------------------------------------------------------
 template < class T >
 void
@@ -1139,6 +1188,52 @@ TEST ( klv, read_imap )
   CALL_TEST( test_read_imap_logic_error, 0, 1,         0.0, double_qnan );
 }
 
+// ----------------------------------------------------------------------------
+void
+test_read_imap_n( vec_t const& data, size_t length,
+                  double minimum, double maximum )
+{
+  auto const count = data.size() / length;
+  auto it = data.data();
+  auto const result =
+    klv_read_imap_n( { minimum, maximum }, it, length, count );
+  EXPECT_EQ( data.data() + count * length, it );
+  ASSERT_EQ( count, result.size() );
+
+  auto cit = data.data();
+  for( auto const value : result )
+  {
+    auto const expected = klv_read_imap( { minimum, maximum }, cit, length );
+    if( std::isnan( expected ) )
+    {
+      EXPECT_TRUE( std::isnan( value ) );
+      EXPECT_EQ( std::signbit( expected ), std::signbit( value ) );
+    }
+    else
+    {
+      EXPECT_EQ( expected, value );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, read_imap_n )
+{
+  vec_t const data = { 0x00, 0x00, 0x33, 0x33, 0x66, 0x66, 0xE8, 0x00,
+                       0xC8, 0x00, 0xD0, 0x00, 0xF8, 0x00, 0x40, 0x00 };
+  CALL_TEST( test_read_imap_n, data, 2,  0.1, 0.9 );
+  CALL_TEST( test_read_imap_n, data, 2, -1.0, 1.0 );
+  CALL_TEST( test_read_imap_n, data, 4, -900.0, 19000.0 );
+  CALL_TEST( test_read_imap_n, vec_t{}, 2, 0.0, 1.0 );
+
+  // Errors leave the iterator in place
+  auto it = data.data();
+  EXPECT_THROW( klv_read_imap_n( { 0.0, double_inf }, it, 2, 8 ),
+                std::logic_error );
+  EXPECT_THROW( klv_read_imap_n( { 0.0, 1.0 }, it, 0, 8 ), std::logic_error );
+  EXPECT_EQ( data.data(), it );
+}
+
 // ----------------------------------------------------------------------------
 void
 test_write_imap(
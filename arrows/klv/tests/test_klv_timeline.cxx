@@ -0,0 +1,198 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Test the KLV timeline and its cursor.
+
+#include <arrows/klv/klv_0601.h>
+#include <arrows/klv/klv_1108.h>
+#include <arrows/klv/klv_demuxer.h>
+#include <arrows/klv/klv_timeline.h>
+#include <arrows/klv/klv_timeline_archive.h>
+
+#include <tests/test_gtest.h>
+#include <tests/test_tmpfn.h>
+
+#include <cstdio>
+
+using namespace kwiver::arrows::klv;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+constexpr auto st0601 = KLV_PACKET_MISB_0601_LOCAL_SET;
+constexpr auto st1108 = KLV_PACKET_MISB_1108_LOCAL_SET;
+
+using kld = klv_lengthy< double >;
+
+// ----------------------------------------------------------------------------
+klv_timeline
+make_timeline()
+{
+  klv_timeline timeline;
+  auto& heading =
+    timeline.insert_or_find( st0601, KLV_0601_PLATFORM_HEADING_ANGLE, {} )
+    ->second;
+  heading.set( { 0, 10 }, uint64_t{ 1 } );
+  heading.set( { 10, 20 }, uint64_t{ 2 } );
+  heading.set( { 30, 40 }, uint64_t{ 3 } );
+
+  timeline.insert_or_find( st0601, KLV_0601_MISSION_ID, {} )
+  ->second.set( { 5, 35 }, std::string{ "MISSION" } );
+
+  // Two indexed timelines for the same tag
+  timeline.insert_or_find( st1108, KLV_1108_METRIC_LOCAL_SET, uint64_t{ 1 } )
+  ->second.set( { 0, 40 }, uint64_t{ 10 } );
+  timeline.insert_or_find( st1108, KLV_1108_METRIC_LOCAL_SET, uint64_t{ 2 } )
+  ->second.set( { 20, 40 }, uint64_t{ 20 } );
+  return timeline;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST ( klv, timeline_cursor_matches_timeline )
+{
+  auto const timeline = make_timeline();
+  klv_timeline_cursor cursor{ timeline };
+
+  // Forward, repeated, and backward queries all agree with the timeline
+  for( uint64_t const time : { 0, 3, 3, 9, 10, 15, 22, 25, 31, 39, 40, 50,
+                               12, 0, 33 } )
+  {
+    for( auto const tag : { KLV_0601_PLATFORM_HEADING_ANGLE,
+                            KLV_0601_MISSION_ID, KLV_0601_PLATFORM_TAIL_NUMBER } )
+    {
+      EXPECT_EQ( timeline.at( st0601, tag, time ),
+                 cursor.at( st0601, tag, time ) )
+        << "Tag: " << tag << ", time: " << time;
+    }
+
+    auto const expected =
+      timeline.all_at( st1108, KLV_1108_METRIC_LOCAL_SET, time );
+    auto const actual =
+      cursor.all_at( st1108, KLV_1108_METRIC_LOCAL_SET, time );
+    ASSERT_EQ( expected.size(), actual.size() ) << "Time: " << time;
+    for( size_t i = 0; i < expected.size(); ++i )
+    {
+      EXPECT_EQ( expected[ i ], *actual[ i ] ) << "Time: " << time;
+    }
+  }
+
+  EXPECT_THROW( cursor.at( st1108, KLV_1108_METRIC_LOCAL_SET, 25 ),
+                std::logic_error );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, timeline_cursor_snapshot )
+{
+  auto timeline = make_timeline();
+  klv_timeline_cursor cursor{ timeline };
+
+  auto const snapshot = cursor.snapshot( 25 );
+  ASSERT_EQ( 3, snapshot.size() );
+  EXPECT_EQ( KLV_0601_MISSION_ID, snapshot[ 0 ].first->tag );
+  EXPECT_EQ( std::string{ "MISSION" },
+             snapshot[ 0 ].second->get< std::string >() );
+  EXPECT_EQ( KLV_1108_METRIC_LOCAL_SET, snapshot[ 1 ].first->tag );
+  EXPECT_EQ( 10, snapshot[ 1 ].second->get< uint64_t >() );
+  EXPECT_EQ( 20, snapshot[ 2 ].second->get< uint64_t >() );
+
+  EXPECT_EQ( 3, cursor.snapshot( 35 ).size() );
+  EXPECT_TRUE( cursor.snapshot( 45 ).empty() );
+
+  // Modifications are seen after a reset
+  timeline.insert_or_find( st0601, KLV_0601_PLATFORM_TAIL_NUMBER, {} )
+  ->second.set( { 40, 50 }, std::string{ "1" } );
+  cursor.reset();
+  EXPECT_EQ( 1, cursor.snapshot( 45 ).size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, timeline_erase_before )
+{
+  auto timeline = make_timeline();
+  ASSERT_EQ( 6, timeline.entry_count() );
+
+  // Only entries ending by the given time are removed
+  klv_timeline evicted;
+  EXPECT_EQ( 2, timeline.erase_before( 20, &evicted ) );
+  EXPECT_EQ( 4, timeline.entry_count() );
+  EXPECT_EQ( 2, evicted.entry_count() );
+  EXPECT_EQ( uint64_t{ 1 },
+             evicted.at( st0601, KLV_0601_PLATFORM_HEADING_ANGLE, 5 ) );
+  EXPECT_TRUE( timeline.at( st0601, KLV_0601_PLATFORM_HEADING_ANGLE, 5 )
+               .empty() );
+  EXPECT_EQ( std::string{ "MISSION" },
+             timeline.at( st0601, KLV_0601_MISSION_ID, 5 ) );
+
+  // Emptied timelines are erased
+  EXPECT_EQ( 4, timeline.erase_before( 40 ) );
+  EXPECT_EQ( 0, timeline.size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, timeline_erase_excess )
+{
+  auto timeline = make_timeline();
+
+  klv_timeline evicted;
+  EXPECT_EQ( 2, timeline.erase_excess( 1, &evicted ) );
+  EXPECT_EQ( 4, timeline.entry_count() );
+  EXPECT_EQ( uint64_t{ 3 },
+             timeline.at( st0601, KLV_0601_PLATFORM_HEADING_ANGLE, 35 ) );
+  EXPECT_EQ( uint64_t{ 2 },
+             evicted.at( st0601, KLV_0601_PLATFORM_HEADING_ANGLE, 15 ) );
+
+  EXPECT_EQ( 0, timeline.erase_excess( 1 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( klv, timeline_retention_archive )
+{
+  auto const filename =
+    kwiver::testing::temp_file_name( "test-klv-archive-", ".klv" );
+  {
+    klv_timeline_archive archive{ filename };
+    klv_timeline timeline;
+    klv_demuxer demuxer{ timeline };
+    klv_timeline_retention retention;
+    retention.max_duration = 1000000;
+    retention.max_entries = 0;
+    demuxer.set_retention( retention );
+    demuxer.set_archive( &archive );
+
+    // Ten frames per second, each with a new heading
+    for( uint64_t i = 0; i < 100; ++i )
+    {
+      klv_local_set set{
+        { KLV_0601_PRECISION_TIMESTAMP, i * 100000 },
+        { KLV_0601_PLATFORM_HEADING_ANGLE, kld{ static_cast< double >( i ) } } };
+      demuxer.send_frame( { { klv_0601_key(), std::move( set ) } } );
+      EXPECT_GE( 11, timeline.entry_count() );
+    }
+    EXPECT_EQ( 11, timeline.entry_count() );
+
+    // Evicted history can still be queried
+    for( uint64_t const i : { 0, 5, 50, 88 } )
+    {
+      auto const history =
+        archive.read( { i * 100000, i * 100000 + 1 } );
+      auto const value =
+        history.at( st0601, KLV_0601_PLATFORM_HEADING_ANGLE, i * 100000 );
+      ASSERT_TRUE( value.valid() ) << "Frame: " << i;
+      EXPECT_NEAR( static_cast< double >( i ), value.get< kld >().value, 0.01 )
+        << "Frame: " << i;
+    }
+    EXPECT_EQ( 0, archive.read( { 9500000, 9600000 } ).size() );
+  }
+  EXPECT_EQ( 0, std::remove( filename.c_str() ) );
+}
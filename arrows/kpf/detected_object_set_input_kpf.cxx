@@ -14,17 +14,122 @@
 #include "vital_kpf_adapters.h"
 
 #include <vital/util/data_stream_reader.h>
+#include <vital/util/mapped_file.h>
+#include <vital/util/text_lines.h>
+#include <vital/util/thread_pool.h>
 #include <vital/vital_config.h>
 #include <vital/exceptions.h>
 
-#include <map>
+#include <algorithm>
+#include <exception>
+#include <iostream>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 #include <cstdlib>
 
 namespace kwiver {
 namespace arrows {
 namespace kpf {
 
+namespace {
+
+// A detection read from a record, with the frame it belongs to
+struct detection_record
+{
+  int frame;
+  kwiver::vital::detected_object_sptr detection;
+};
+
+// ----------------------------------------------------------------------------
+// True if every line of the text is a single record, a comment or blank,
+// so that the text may be split at any line into valid KPF
+bool
+is_one_record_per_line( char const* begin, char const* end )
+{
+  for ( auto pos = begin; pos != end; )
+  {
+    auto const eol = std::find( pos, end, '\n' );
+    if ( ( eol - pos < 2 ) || ( pos[0] != '-' ) || ( pos[1] != ' ' ) )
+    {
+      auto const c = std::find_if( pos, eol, []( char ch ){ return ch != ' '; } );
+      if ( ( c != eol ) && ( *c != '#' ) && ( *c != '\r' ) )
+      {
+        return false;
+      }
+    }
+    pos = ( eol == end ? end : eol + 1 );
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+// Read the detections of a KPF stream, in order, and the text of the
+// metadata records
+void
+read_records( std::istream& in, unsigned max_threads,
+              std::vector< detection_record >& records,
+              std::vector< std::string >& meta )
+{
+  KPF::kpf_yaml_parser_t parser( in, max_threads );
+  KPF::kpf_reader_t reader( parser );
+
+  size_t      detection_id;
+  double      frame_number;
+  vital_box_adapter_t box_adapter;
+  kwiver::vital::detected_object_type_sptr types(new kwiver::vital::detected_object_type());
+
+  // This will only work for files for which each non-Meta record contains at least
+  // these elements (the minimum necessary to build a detection).  Should heterogenous
+  // KPF files become common in the wild, this would have to be revisited.
+  while ( reader >> KPF::reader< KPFC::id_t >(detection_id, KPFC::id_t::DETECTION_ID)
+                >> KPF::reader< KPFC::timestamp_t>(frame_number, KPFC::timestamp_t::FRAME_NUMBER)
+                >> KPF::reader< KPFC::bbox_t >(box_adapter, KPFC::bbox_t::IMAGE_COORDS) )
+  {
+    std::string detector_name = "kpf_reader";
+    double      confidence = 1.0;
+    uint64_t    index = 0;
+
+    // We've gotten a record that has the least possible info for a detections.  What
+    // else can we find that might be useful?  In particular pick up the elements
+    // our sister writer writes
+    auto det_name_packet = reader.transfer_kv_packet_from_buffer("detector_name");
+    if ( det_name_packet.first )
+    {
+      detector_name = det_name_packet.second.kv.val;
+    }
+
+    auto confidence_packet = reader.transfer_packet_from_buffer( KPF::packet_header_t( KPF::packet_style::CONF, DETECTOR_DOMAIN ) );
+    if ( confidence_packet.first )
+    {
+      confidence = confidence_packet.second.conf.d;
+    }
+
+    auto index_packet = reader.transfer_packet_from_buffer( KPF::packet_header_t( KPF::packet_style::ID, KPFC::id_t::TRACK_ID ) );
+    if ( index_packet.first )
+    {
+      index = index_packet.second.id.d;
+    }
+
+    kwiver::vital::bounding_box_d bbox(0, 0, 0, 0);
+    box_adapter.get(bbox);
+    kwiver::vital::detected_object_sptr det(new kwiver::vital::detected_object(bbox, confidence, types));
+    det->set_detector_name(detector_name);
+    det->set_index(index);
+
+    records.push_back( { static_cast< int >( frame_number ), det } );
+
+    // did we receive any metadata?
+    for (auto const& m : reader.get_meta_packets())
+    {
+      meta.push_back( m );
+    }
+    reader.flush();
+  }
+}
+
+} // namespace
+
 // ----------------------------------------------------------------------------
 class detected_object_set_input_kpf::priv
 {
@@ -32,21 +137,30 @@ class detected_object_set_input_kpf::priv
   priv( detected_object_set_input_kpf* parent)
     : m_parent( parent )
     , m_first( true )
+    , m_current_idx( 0 )
+    , m_first_frame( 0 )
+    , m_last_frame( 0 )
   { }
 
   ~priv() { }
 
   void read_all();
+  bool read_all_mapped( std::vector< detection_record >& records,
+                        std::vector< std::string >& meta );
 
   detected_object_set_input_kpf* m_parent;
   bool m_first;
 
+  // File to map in place of reading the stream, if opened by name
+  std::string m_filename;
+
   int m_current_idx;
-  int m_last_idx;
 
   // Map of detected objects indexed by frame number. Each set
   // contains all detections for a single frame.
-  std::map< int, kwiver::vital::detected_object_set_sptr > m_detected_sets;
+  std::unordered_map< int, kwiver::vital::detected_object_set_sptr > m_detected_sets;
+  int m_first_frame;
+  int m_last_frame;
 };
 
 // ----------------------------------------------------------------------------
@@ -76,6 +190,15 @@ check_configuration( VITAL_UNUSED vital::config_block_sptr config) const
   return true;
 }
 
+// ----------------------------------------------------------------------------
+void
+detected_object_set_input_kpf::
+open( std::string const& filename )
+{
+  vital::algo::detected_object_set_input::open( filename );
+  d->m_filename = filename;
+}
+
 // ----------------------------------------------------------------------------
 bool
 detected_object_set_input_kpf::
@@ -89,34 +212,59 @@ read_set( kwiver::vital::detected_object_set_sptr & set, std::string& image_name
 
     // set up iterators for returning sets.
     d->m_current_idx = 1;
-    d->m_last_idx = d->m_detected_sets.rbegin()->first;
   } // end first
 
   // we do not return image name
   image_name.clear();
 
-  // return detection set at current index if there is one
-  if ( 0 == d->m_detected_sets.count( d->m_current_idx ) )
+  // Frames past the last detections are the end of the input
+  if ( d->m_detected_sets.empty() || d->m_current_idx > d->m_last_frame )
   {
-    // return empty set
-    set = std::make_shared< kwiver::vital::detected_object_set>();
+    return false;
   }
-  else
+
+  // Return detections for this frame, or an empty set if there are none
+  if ( ! read_frame_set( d->m_current_idx, set ) )
   {
-    // Return detections for this frame.
-    set = d->m_detected_sets[d->m_current_idx];
+    set = std::make_shared< kwiver::vital::detected_object_set>();
   }
 
   ++d->m_current_idx;
   return true;
 }
 
+// ----------------------------------------------------------------------------
+bool
+detected_object_set_input_kpf::
+read_frame_set( int frame, kwiver::vital::detected_object_set_sptr& set )
+{
+  if ( d->m_first )
+  {
+    d->read_all();
+    d->m_first = false;
+    d->m_current_idx = 1;
+  }
+
+  if ( d->m_detected_sets.empty() ||
+       frame < d->m_first_frame || frame > d->m_last_frame )
+  {
+    return false;
+  }
+
+  auto const i = d->m_detected_sets.find( frame );
+  set = ( i == d->m_detected_sets.end()
+          ? std::make_shared< kwiver::vital::detected_object_set >()
+          : i->second );
+  return true;
+}
+
 // ----------------------------------------------------------------------------
 void
 detected_object_set_input_kpf::
 new_stream()
 {
   d->m_first = true;
+  d->m_filename.clear();
 }
 
 // ----------------------------------------------------------------------------
@@ -125,73 +273,120 @@ detected_object_set_input_kpf::priv::
 read_all()
 {
   m_detected_sets.clear();
+  m_first_frame = 0;
+  m_last_frame = 0;
 
-  KPF::kpf_yaml_parser_t parser(m_parent->stream());
-  KPF::kpf_reader_t reader(parser);
-
-  size_t      detection_id;
-  double      frame_number;
-  vital_box_adapter_t box_adapter;
-  kwiver::vital::detected_object_type_sptr types(new kwiver::vital::detected_object_type());
-  kwiver::vital::detected_object_set_sptr frame_detections;
+  std::vector< detection_record > records;
+  std::vector< std::string > meta;
+  if ( ! read_all_mapped( records, meta ) )
+  {
+    read_records( m_parent->stream(), 0, records, meta );
+  }
 
-  // This will only work for files for which each non-Meta record contains at least
-  // these elements (the minimum necessary to build a detection).  Should heterogenous
-  // KPF files become common in the wild, this would have to be revisited.
-  while ( reader >> KPF::reader< KPFC::id_t >(detection_id, KPFC::id_t::DETECTION_ID)
-                >> KPF::reader< KPFC::timestamp_t>(frame_number, KPFC::timestamp_t::FRAME_NUMBER)
-                >> KPF::reader< KPFC::bbox_t >(box_adapter, KPFC::bbox_t::IMAGE_COORDS) )
+  for ( auto const& m : meta )
   {
-    std::string detector_name = "kpf_reader";
-    double      confidence = 1.0;
-    uint64_t    index = 0;
+    std::cout << "Metadata: '" << m << "'\n";
+  }
+  LOG_TRACE( m_parent->logger(), "DONE" );
 
-    // We've gotten a record that has the least possible info for a detections.  What
-    // else can we find that might be useful?  In particular pick up the elements
-    // our sister writer writes
-    auto det_name_packet = reader.transfer_kv_packet_from_buffer("detector_name");
-    if ( det_name_packet.first )
+  // Group the detections by frame in file order
+  kwiver::vital::detected_object_set_sptr set;
+  int set_frame = 0;
+  for ( auto const& r : records )
+  {
+    if ( ! set || r.frame != set_frame )
     {
-      detector_name = det_name_packet.second.kv.val;
+      auto& entry = m_detected_sets[ r.frame ];
+      if ( ! entry )
+      {
+        entry = std::make_shared< kwiver::vital::detected_object_set >();
+      }
+      set = entry;
+      set_frame = r.frame;
     }
+    set->add( r.detection );
+  }
 
-    auto confidence_packet = reader.transfer_packet_from_buffer( KPF::packet_header_t( KPF::packet_style::CONF, DETECTOR_DOMAIN ) );
-    if ( confidence_packet.first )
-    {
-      confidence = confidence_packet.second.conf.d;
-    }
+  if ( ! records.empty() )
+  {
+    auto const range = std::minmax_element(
+      records.begin(), records.end(),
+      []( detection_record const& a, detection_record const& b )
+      { return a.frame < b.frame; } );
+    m_first_frame = range.first->frame;
+    m_last_frame = range.second->frame;
+  }
+} // read_all
 
-    auto index_packet = reader.transfer_packet_from_buffer( KPF::packet_header_t( KPF::packet_style::ID, KPFC::id_t::TRACK_ID ) );
-    if ( index_packet.first )
-    {
-      index = index_packet.second.conf.d;
-    }
+// ----------------------------------------------------------------------------
+bool
+detected_object_set_input_kpf::priv::
+read_all_mapped( std::vector< detection_record >& records,
+                 std::vector< std::string >& meta )
+{
+  kwiver::vital::mapped_file file;
+  if ( m_filename.empty() || ! file.open( m_filename ) )
+  {
+    return false;
+  }
 
-    kwiver::vital::bounding_box_d bbox(0, 0, 0, 0);
-    box_adapter.get(bbox);
-    kwiver::vital::detected_object_sptr det(new kwiver::vital::detected_object(bbox, confidence, types));
-    det->set_detector_name(detector_name);
-    det->set_index(index);
+  // Files which are not one record per line can only be parsed whole
+  char const* const begin = file.data();
+  char const* const end = begin + file.size();
+  if ( ! is_one_record_per_line( begin, end ) )
+  {
+    return false;
+  }
 
-    frame_detections = m_detected_sets[frame_number];
-    if (frame_detections.get() == nullptr)
+  // Chunks of about a megabyte are enough to keep every thread busy; a
+  // single chunk is instead scanned by the threads of the parser
+  auto& pool = kwiver::vital::thread_pool::instance();
+  auto const size = static_cast< size_t >( end - begin );
+  auto const count =
+    std::max< size_t >( 1, std::min( pool.num_threads() * 4, size >> 20 ) );
+  auto const chunks = kwiver::vital::split_line_chunks( begin, end, count );
+  auto const n_chunks = chunks.size() - 1;
+
+  std::vector< std::vector< detection_record > > chunk_records( n_chunks );
+  std::vector< std::vector< std::string > > chunk_meta( n_chunks );
+  std::vector< std::exception_ptr > errors( n_chunks );
+  pool.parallel_for(
+    n_chunks, 1,
+    [ & ]( size_t first, size_t last )
     {
-      // create a new detection set entry
-      frame_detections = std::make_shared<kwiver::vital::detected_object_set>();
-      m_detected_sets[frame_number] = frame_detections;
-    }
-    frame_detections->add(det);
-
-    // did we receive any metadata?
-    for (auto m : reader.get_meta_packets())
+      for ( auto i = first; i < last; ++i )
+      {
+        try
+        {
+          std::istringstream in(
+            std::string( chunks[ i ], chunks[ i + 1 ] ) );
+          read_records( in, ( n_chunks > 1 ? 1 : 0 ),
+                        chunk_records[ i ], chunk_meta[ i ] );
+        }
+        catch ( ... )
+        {
+          errors[ i ] = std::current_exception();
+        }
+      }
+    } );
+
+  for ( auto const& error : errors )
+  {
+    if ( error )
     {
-      std::cout << "Metadata: '" << m << "'\n";
+      std::rethrow_exception( error );
     }
-    LOG_TRACE( m_parent->logger(), "FLUSHING" );
-    reader.flush();
   }
-  LOG_TRACE( m_parent->logger(), "DONE" );
 
-} // read_all
+  for ( size_t i = 0; i < n_chunks; ++i )
+  {
+    records.insert( records.end(), chunk_records[ i ].begin(), chunk_records[ i ].end() );
+    meta.insert( meta.end(), chunk_meta[ i ].begin(), chunk_meta[ i ].end() );
+  }
+
+  // The whole file has been read, as if from the stream
+  m_parent->stream().setstate( std::ios::eofbit );
+  return true;
+} // read_all_mapped
 
 } } } // end namespace
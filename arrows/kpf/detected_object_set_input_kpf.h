@@ -26,8 +26,25 @@ class KWIVER_ALGO_KPF_EXPORT detected_object_set_input_kpf
   virtual void set_configuration(vital::config_block_sptr config);
   virtual bool check_configuration(vital::config_block_sptr config) const;
 
+  /// Open a file of detections
+  ///
+  /// Files opened by name are memory mapped and parsed in parallel.
+  virtual void open( std::string const& filename );
+
   virtual bool read_set( kwiver::vital::detected_object_set_sptr & set, std::string& image_name );
 
+  /// Read the detections of one frame
+  ///
+  /// The whole input is read and indexed by frame on first use, after which
+  /// the set of any frame is found in constant time. This does not change
+  /// the frame returned next by read_set().
+  ///
+  /// \param frame Frame number of the detections
+  /// \param[out] set Detections of the frame, empty if it has none
+  ///
+  /// \return \b false if the frame is outside the frames of the input.
+  bool read_frame_set( int frame, kwiver::vital::detected_object_set_sptr& set );
+
 private:
   virtual void new_stream();
 
@@ -6,9 +6,9 @@
 
 #include <vital/vital_config.h>
 #include <arrows/kpf/yaml/kpf_canonical_io_adapter.h>
-#include <arrows/kpf/yaml/kpf_yaml_writer.h>
 #include <arrows/kpf/vital_kpf_adapters.h>
 
+#include <cstdio>
 #include <memory>
 #include <vector>
 #include <fstream>
@@ -28,6 +28,31 @@ namespace kwiver {
 namespace arrows {
 namespace kpf {
 
+namespace {
+
+// ----------------------------------------------------------------------------
+// Append a number as an output stream with default flags and the given
+// precision would write it
+void
+append_number( std::string& buffer, double value, int precision )
+{
+  char text[ 32 ];
+  int const n = std::snprintf( text, sizeof( text ), "%.*g", precision, value );
+  if ( n > 0 && static_cast< size_t >( n ) < sizeof( text ) )
+  {
+    buffer.append( text, static_cast< size_t >( n ) );
+  }
+  else
+  {
+    std::ostringstream oss;
+    oss.precision( precision );
+    oss << value;
+    buffer += oss.str();
+  }
+}
+
+} // namespace
+
 // ----------------------------------------------------------------------------
 class detected_object_set_output_kpf::priv
 {
@@ -39,10 +64,11 @@ class detected_object_set_output_kpf::priv
 
   ~priv() {}
 
-  void read_all();
-
   detected_object_set_output_kpf* m_parent;
   int m_frame_number;
+
+  // Text of the records of a set, kept to reuse its memory
+  std::string m_buffer;
 };
 
 // ----------------------------------------------------------------------------
@@ -93,67 +119,51 @@ detected_object_set_output_kpf::
 write_set( const kwiver::vital::detected_object_set_sptr set,
            VITAL_UNUSED std::string const& image_name )
 {
-  KPF::record_yaml_writer w(stream());
+  // The records of the set are formatted into one buffer, as
+  // KPF::record_yaml_writer would write them, and written together
+  auto& buffer = d->m_buffer;
+  buffer.clear();
+
   size_t line_count = 0;
-  vital_box_adapter_t box_adapter;
-  // Is this needed? vital_poly_adapter_t poly_adapter;
+  int const precision = static_cast< int >( stream().precision() );
+  double const frame = d->m_frame_number - 1;
 
   // process all detections
   auto ie =  set->cend();
   for ( auto det = set->cbegin(); det != ie; ++det )
   {
-    const kwiver::vital::bounding_box_d bbox( (*det)->bounding_box() );
-    // N/A? double ilx = ( bbox.min_x() + bbox.max_x() ) / 2.0;
-    // N/A? double ily = ( bbox.min_y() + bbox.max_y() ) / 2.0;
-
     static std::atomic<unsigned> id_counter( 0 );
     const unsigned id = id_counter++;
 
-    auto det_index = (*det)->index();
+    const kwiver::vital::bounding_box_d bbox( (*det)->bounding_box() );
 
-    std::ostringstream oss;
-    oss << "Record " << line_count++;
-    w
-      << KPF::writer< KPFC::meta_t >(oss.str())
-      << KPF::record_yaml_writer::endl;
-    w.set_schema( KPF::schema_style::GEOM )
-      << KPF::writer< KPFC::kv_t >("detector_name", (*det)->detector_name())
-      << KPF::writer< KPFC::id_t >(id, KPFC::id_t::DETECTION_ID)
-      << KPF::writer< KPFC::id_t >(det_index, KPFC::id_t::TRACK_ID)
-      << KPF::writer< KPFC::timestamp_t >(d->m_frame_number - 1, KPFC::timestamp_t::FRAME_NUMBER)
-      << KPF::writer< KPFC::conf_t>((*det)->confidence(), DETECTOR_DOMAIN)
-      << KPF::writer< KPFC::bbox_t >(box_adapter((*det)->bounding_box()), KPFC::bbox_t::IMAGE_COORDS);
-    //for (auto t : *(*det)->type())
-    //  w << KPF::writer< KPFC::kv_t >(*t.first, std::to_string(t.second));
-    w << KPF::record_yaml_writer::endl;
-
-    // I do not think the vital detection has poly data....
-    //<< KPF::writer< KPFC::poly_t>(poly_adapter(det), KPFC::poly_t::IMAGE_COORDS)
-    /*
-    This is how kw18 writes out data, Delete when we are happy with the above code
-    stream() << id                  // 1: track id
-             << " 1 "               // 2: track length
-             << d->m_frame_number-1 // 3: frame number / set number
-             << " 0 "               // 4: tracking plane x
-             << " 0 "               // 5: tracking plane y
-             << "0 "                // 6: velocity x
-             << "0 "                // 7: velocity y
-             << ilx << " "          // 8: image location x
-             << ily << " "          // 9: image location y
-             << bbox.min_x() << " " // 10: TL-x
-             << bbox.min_y() << " " // 11: TL-y
-             << bbox.max_x() << " " // 12: BR-x
-             << bbox.max_y() << " " // 13: BR-y
-             << bbox.area() << " "  // 14: area
-             << "0 "                // 15: world-loc x
-             << "0 "                // 16: world-loc y
-             << "0 "                // 17: world-loc z
-             << "-1 "                // 18: timestamp
-             << (*det)->confidence()   // 19: confidence
-             << std::endl;
-    */
+    buffer += "- { meta: Record ";
+    buffer += std::to_string( line_count++ );
+    buffer += " }\n";
+
+    buffer += "- { geom: { detector_name: ";
+    buffer += (*det)->detector_name();
+    buffer += ", id" + std::to_string( KPFC::id_t::DETECTION_ID ) + ": ";
+    buffer += std::to_string( id );
+    buffer += ", id" + std::to_string( KPFC::id_t::TRACK_ID ) + ": ";
+    buffer += std::to_string( (*det)->index() );
+    buffer += ", ts" + std::to_string( KPFC::timestamp_t::FRAME_NUMBER ) + ": ";
+    append_number( buffer, frame, precision );
+    buffer += ", conf" + std::to_string( DETECTOR_DOMAIN ) + ": ";
+    append_number( buffer, (*det)->confidence(), precision );
+    buffer += ", g" + std::to_string( KPFC::bbox_t::IMAGE_COORDS ) + ": ";
+    append_number( buffer, bbox.min_x(), precision );
+    buffer += ' ';
+    append_number( buffer, bbox.min_y(), precision );
+    buffer += ' ';
+    append_number( buffer, bbox.max_x(), precision );
+    buffer += ' ';
+    append_number( buffer, bbox.max_y(), precision );
+    buffer += ",  } }\n";
   } // end foreach
 
+  stream().write( buffer.data(), static_cast< std::streamsize >( buffer.size() ) );
+
   // Put each set on a new frame
   ++d->m_frame_number;
 }
@@ -0,0 +1,170 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test KPF detected object io
+
+#include <test_tmpfn.h>
+
+#include <arrows/kpf/detected_object_set_input_kpf.h>
+#include <arrows/kpf/detected_object_set_output_kpf.h>
+
+#include <arrows/kpf/yaml/kpf_canonical_io_adapter.h>
+#include <arrows/kpf/yaml/kpf_yaml_writer.h>
+#include <arrows/kpf/vital_kpf_adapters.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace kak = kwiver::arrows::kpf;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Detections for a frame; every fourth frame has none
+kwiver::vital::detected_object_set_sptr
+make_set( int frame )
+{
+  auto set = std::make_shared< kwiver::vital::detected_object_set >();
+  for ( int i = 0; i < frame % 4; ++i )
+  {
+    auto det = std::make_shared< kwiver::vital::detected_object >(
+      kwiver::vital::bounding_box_d{ 10.0 * i, 0.5 * frame,
+                                     10.0 * i + 7.5, 0.5 * frame + 3.5 },
+      1.0 / ( i + frame + 2 ) );
+    det->set_detector_name( "detector_" + std::to_string( i ) );
+    det->set_index( static_cast< uint64_t >( frame * 10 + i ) );
+    set->add( det );
+  }
+  return set;
+}
+
+// ----------------------------------------------------------------------------
+void
+expect_same_set( kwiver::vital::detected_object_set_sptr const& expected,
+                 kwiver::vital::detected_object_set_sptr const& actual )
+{
+  ASSERT_TRUE( actual );
+  ASSERT_EQ( expected->size(), actual->size() );
+  for ( size_t i = 0; i < expected->size(); ++i )
+  {
+    auto const e = expected->at( i );
+    auto const a = actual->at( i );
+    EXPECT_EQ( e->bounding_box(), a->bounding_box() );
+    EXPECT_NEAR( e->confidence(), a->confidence(), 1e-6 );
+    EXPECT_EQ( e->detector_name(), a->detector_name() );
+    EXPECT_EQ( e->index(), a->index() );
+  }
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_io, kpf_file_io)
+{
+  auto const file_name = kwiver::testing::temp_file_name( "test-", ".kpf" );
+  int const frames = 12000;
+
+  {
+    kak::detected_object_set_output_kpf writer;
+    writer.open( file_name );
+    for ( int f = 0; f < frames; ++f )
+    {
+      writer.write_set( make_set( f ), "" );
+    }
+    writer.close();
+  }
+
+  // The mapped file and the stream give the same detections
+  std::ifstream file_stream( file_name );
+  kak::detected_object_set_input_kpf file_reader;
+  kak::detected_object_set_input_kpf stream_reader;
+  file_reader.open( file_name );
+  stream_reader.use_stream( &file_stream );
+
+  for ( auto* reader : { &file_reader, &stream_reader } )
+  {
+    // Sequential reading starts at frame one
+    kwiver::vital::detected_object_set_sptr set;
+    std::string name;
+    for ( int f = 1; f < frames; ++f )
+    {
+      SCOPED_TRACE( f );
+      ASSERT_TRUE( reader->read_set( set, name ) );
+      expect_same_set( make_set( f ), set );
+      EXPECT_TRUE( name.empty() );
+    }
+    EXPECT_FALSE( reader->read_set( set, name ) );
+
+    // Any frame from the first to the last with detections can be read
+    // directly
+    for ( int f : { 1, 4, 11999, 1234 } )
+    {
+      SCOPED_TRACE( f );
+      ASSERT_TRUE( reader->read_frame_set( f, set ) );
+      expect_same_set( make_set( f ), set );
+    }
+    EXPECT_FALSE( reader->read_frame_set( 0, set ) );
+    EXPECT_FALSE( reader->read_frame_set( frames, set ) );
+  }
+
+  std::remove( file_name.c_str() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_io, kpf_output_format)
+{
+  std::stringstream str;
+  kak::detected_object_set_output_kpf writer;
+  writer.use_stream( &str );
+  std::vector< int > const frames = { 0, 1234567 };
+  for ( int frame : frames )
+  {
+    writer.write_set( make_set( frame ), "" );
+  }
+
+  // The records are those the KPF YAML writer would write
+  std::stringstream expected;
+  KPF::record_yaml_writer w( expected );
+  vital_box_adapter_t box_adapter;
+  std::string line;
+  for ( size_t k = 0; k < frames.size(); ++k )
+  {
+    size_t n = 0;
+    auto const set = make_set( frames[ k ] );
+    for ( auto const& det : *set )
+    {
+      // Detection IDs are counted across all writers
+      std::getline( str, line );
+      std::getline( str, line );
+      auto const id_pos = line.find( "id0: " ) + 5;
+      unsigned const id = static_cast< unsigned >(
+        std::stoul( line.substr( id_pos, line.find( ',', id_pos ) - id_pos ) ) );
+
+      w << KPF::writer< KPFC::meta_t >( "Record " + std::to_string( n++ ) )
+        << KPF::record_yaml_writer::endl;
+      w.set_schema( KPF::schema_style::GEOM )
+        << KPF::writer< KPFC::kv_t >( "detector_name", det->detector_name() )
+        << KPF::writer< KPFC::id_t >( id, KPFC::id_t::DETECTION_ID )
+        << KPF::writer< KPFC::id_t >( det->index(), KPFC::id_t::TRACK_ID )
+        << KPF::writer< KPFC::timestamp_t >( k, KPFC::timestamp_t::FRAME_NUMBER )
+        << KPF::writer< KPFC::conf_t >( det->confidence(), DETECTOR_DOMAIN )
+        << KPF::writer< KPFC::bbox_t >( box_adapter( det->bounding_box() ), KPFC::bbox_t::IMAGE_COORDS )
+        << KPF::record_yaml_writer::endl;
+    }
+  }
+  EXPECT_EQ( expected.str(), str.str() );
+}
@@ -10,6 +10,11 @@
  * resulting in a flat list of tokens that the event parsers have to
  * reconstruct. Again, probably not optimal.
  *
+ * Files written one record per line skip most of that: each line in the
+ * record writer's flat shape is read straight into packets by the
+ * record_scanner below, and only the rest go through yaml-cpp, one line at
+ * a time. Lines are scanned a chunk at a time across threads.
+ *
  */
 
 #include "kpf_yaml_parser.h"
@@ -20,6 +25,11 @@
 #include <vector>
 #include <sstream>
 #include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <thread>
 
 #include <vital/util/tokenize.h>
 
@@ -34,6 +44,7 @@ using std::isdigit;
 using std::ostringstream;
 using std::make_pair;
 using std::stod;
+using std::strchr;
 
 namespace { // anon
 
@@ -47,7 +58,7 @@ kpf_v3_check( const YAML::Node& n )
   if ( n.size() != 1)   return KPF::schema_style::INVALID;
 
   auto it = n.begin();
-  const auto& sub_n = it->second;
+  const YAML::Node sub_n = it->second;
   if ( ! sub_n.IsMap()) return KPF::schema_style::INVALID;
 
   return KPF::validation_data::str_to_schema_style( it->first.as<string>() );
@@ -474,6 +485,433 @@ parse_as_kpf_v3( const YAML::Node& n,
   return parse_general( n, local_packet_buffer );
 }
 
+/**
+ * \brief Parse one record node into the packet buffer.
+ *
+ * Starting with KPFv3, each yaml line is either:
+ *
+ * meta: xxxxxx
+ *
+ * or a set of
+ *
+ * schema: {xxx}
+ *
+ * where "schema" is a tag meant to assist in validation and parsing.
+ *
+ * The result is still to populate the local packet buffer; the schema
+ * does not propagate beyond the parser.
+ *
+ * There is still only one schema instance per line; we don't support
+ * (for example)
+ *
+ * - { geom: { geom-stuff }, geom: {geom-stuff} }
+ *
+ */
+
+bool
+parse_record_node( const YAML::Node& n,
+                   KPF::schema_style& schema,
+                   KPF::packet_buffer_t& local_packet_buffer )
+{
+  //
+  // The line must be a map.
+  //
+
+  if (! n.IsMap())
+  {
+    LOG_ERROR( main_logger, "YAML: root node is " << n.Type() << "; expected map" );
+    LOG_ERROR( main_logger, "node as string: '" << n.as<string>() << "'" );
+    return false;
+  }
+
+  //
+  // Each element of the map is itself a map, k:v. If k is a kpfv3 schema,
+  // parse v as a map of elements which must conform to the constraints of
+  // the schema k. Otherwise, treat all of the toplevel map as a kpfv2 file,
+  // and guess at its schema.
+  //
+
+  //
+  // Is it a kpfv3 schema tag?
+  //
+
+  bool okay = false;
+  auto check = kpf_v3_check( n );
+  auto n_sub = n.begin();
+
+  schema = check;
+
+  // special case for meta
+  if ( KPF::str2style( n_sub->first.as<string>()) == KPF::packet_style::META )
+  {
+    okay = parse_as_kpf_v3( n, KPF::schema_style::UNSPECIFIED, local_packet_buffer );
+  }
+  else
+  {
+    if ( check != KPF::schema_style::INVALID )
+    {
+      okay = parse_as_kpf_v3( n_sub->second, check, local_packet_buffer );
+    }
+  }
+
+  return okay;
+}
+
+//
+// A single-pass scanner for records in the shape the record_yaml_writer
+// emits,
+//
+//   - { geom: { g0: 1 2 3 4, id0: 100, ts0: 4, poly0: [[ 1, 2 ],], label: car, } }
+//
+// i.e. one schema tag over a flat map whose values are plain scalars, a
+// poly's list of points, or a cset's map of numbers. It builds the packets
+// directly, with the same conversions as the node-tree parsers above.
+//
+// scan() returns false on anything outside that shape -- quoting, comments,
+// anchors, null or non-decimal scalars, repeated keys, activities, meta
+// records -- and the caller gives the line to yaml-cpp instead.
+//
+
+class record_scanner
+{
+public:
+  record_scanner( const char* b, const char* e ): p( b ), end( e ) {}
+
+  bool scan( KPF::schema_style& schema, KPF::packet_buffer_t& local_packet_buffer );
+
+private:
+  const char* p;
+  const char* end;
+
+  void skip_spaces()
+  {
+    while ((this->p != this->end) && (*this->p == ' ')) ++this->p;
+  }
+  bool accept( char c )
+  {
+    this->skip_spaces();
+    if ((this->p == this->end) || (*this->p != c)) return false;
+    ++this->p;
+    return true;
+  }
+
+  bool scan_key( string& k );
+  bool scan_plain( const char* stops, string& s );
+  bool scan_double( const char* stops, double& d );
+  bool scan_uint64( uint64_t& d );
+  bool scan_geom( KPFC::bbox_t& box );
+  bool scan_poly( KPFC::poly_t& poly );
+  bool scan_cset( KPFC::cset_t& cset );
+};
+
+// decimal floating point only; leaves inf, nan, hex etc. to yaml-cpp
+bool
+to_double( const string& s, double& d )
+{
+  if ( s.empty() || ( s.find_first_not_of( "0123456789+-.eE" ) != string::npos ))
+  {
+    return false;
+  }
+  char* e;
+  errno = 0;
+  d = std::strtod( s.c_str(), &e );
+  return ( *e == '\0' ) && ( errno == 0 );
+}
+
+bool
+record_scanner
+::scan_key( string& k )
+{
+  this->skip_spaces();
+  const char* b = this->p;
+  while ((this->p != this->end) &&
+         ( std::isalnum( static_cast< unsigned char >( *this->p )) ||
+           ( *this->p == '_' ) || ( *this->p == '-' ) || ( *this->p == '.' )))
+  {
+    ++this->p;
+  }
+  // a plain key must start with a letter, digit or underscore, and be
+  // followed by ": "
+  if (( this->p == b ) || ( *b == '-' ) || ( *b == '.' ) ||
+      ( this->end - this->p < 2 ) || ( this->p[0] != ':' ) || ( this->p[1] != ' ' ))
+  {
+    return false;
+  }
+  k.assign( b, this->p );
+  ++this->p;
+  return true;
+}
+
+bool
+record_scanner
+::scan_plain( const char* stops, string& s )
+{
+  this->skip_spaces();
+  const char* b = this->p;
+  for ( ; this->p != this->end; ++this->p )
+  {
+    char c = *this->p;
+    if ( static_cast< unsigned char >( c ) < 0x20 ) return false;
+    if ( strchr( stops, c )) break;
+    if ( strchr( "[]{}#&*!|>'\"%@`:", c )) return false;
+  }
+  const char* e = this->p;
+  while (( e != b ) && ( *(e-1) == ' ' )) --e;
+  if ( e == b ) return false;
+
+  // "- x" and "? x" are indicators, not scalars
+  if ((( *b == '-' ) || ( *b == '?' )) && (( e == b+1 ) || ( b[1] == ' ' ))) return false;
+
+  s.assign( b, e );
+  // leave nulls to yaml-cpp
+  return ! (( s == "~" ) || ( s == "null" ) || ( s == "Null" ) || ( s == "NULL" ));
+}
+
+bool
+record_scanner
+::scan_double( const char* stops, double& d )
+{
+  string s;
+  return this->scan_plain( stops, s ) && to_double( s, d );
+}
+
+bool
+record_scanner
+::scan_uint64( uint64_t& d )
+{
+  string s;
+  if (( ! this->scan_plain( ",}", s )) ||
+      ( s.find_first_not_of( "0123456789" ) != string::npos ) ||
+      // yaml-cpp reads a leading zero as octal
+      (( s.size() > 1 ) && ( s[0] == '0' )))
+  {
+    return false;
+  }
+  char* e;
+  errno = 0;
+  unsigned long long v = std::strtoull( s.c_str(), &e, 10 );
+  if (( *e != '\0' ) || ( errno != 0 )) return false;
+  d = v;
+  return true;
+}
+
+bool
+record_scanner
+::scan_geom( KPFC::bbox_t& box )
+{
+  string s;
+  if ( ! this->scan_plain( ",}", s )) return false;
+
+  double xy[4];
+  size_t n = 0;
+  for (size_t i = s.find_first_not_of( ' ' ); i != string::npos; i = s.find_first_not_of( ' ', i ))
+  {
+    size_t j = s.find( ' ', i );
+    if (( n == 4 ) || ( ! to_double( s.substr( i, j-i ), xy[n++] ))) return false;
+    i = j;
+  }
+  if ( n != 4 ) return false;
+
+  box = KPFC::bbox_t( xy[0], xy[1], xy[2], xy[3] );
+  return true;
+}
+
+bool
+record_scanner
+::scan_poly( KPFC::poly_t& poly )
+{
+  if ( ! this->accept( '[' )) return false;
+
+  vector< pair< double, double > > xy;
+  while ( ! this->accept( ']' ))
+  {
+    double x, y;
+    if (( ! this->accept( '[' )) ||
+        ( ! this->scan_double( ",]", x )) ||
+        ( ! this->accept( ',' )) ||
+        ( ! this->scan_double( ",]", y )) ||
+        ( ! this->accept( ']' )))
+    {
+      return false;
+    }
+    xy.push_back( make_pair( x, y ));
+    if ( this->accept( ',' )) continue;
+    if ( this->accept( ']' )) break;
+    return false;
+  }
+
+  poly.xy.swap( xy );
+  return true;
+}
+
+bool
+record_scanner
+::scan_cset( KPFC::cset_t& cset )
+{
+  if ( ! this->accept( '{' )) return false;
+
+  while ( ! this->accept( '}' ))
+  {
+    string k;
+    double d;
+    if (( ! this->scan_key( k )) ||
+        ( ! this->scan_double( ",}", d )) ||
+        ( ! cset.d.insert( make_pair( k, d )).second ))
+    {
+      return false;
+    }
+    if ( this->accept( ',' )) continue;
+    if ( this->accept( '}' )) break;
+    return false;
+  }
+  return true;
+}
+
+bool
+record_scanner
+::scan( KPF::schema_style& schema, KPF::packet_buffer_t& local_packet_buffer )
+{
+  string tag;
+  if (( this->end - this->p < 2 ) || ( this->p[0] != '-' ) || ( this->p[1] != ' ' )) return false;
+  this->p += 2;
+  if (( ! this->accept( '{' )) || ( ! this->scan_key( tag ))) return false;
+
+  schema = KPF::validation_data::str_to_schema_style( tag );
+  if (( schema == KPF::schema_style::INVALID ) ||
+      ( schema == KPF::schema_style::META ) ||
+      ( schema == KPF::schema_style::ACT ))
+  {
+    return false;
+  }
+  if ( ! this->accept( '{' )) return false;
+
+  vector< string > keys;
+  while ( ! this->accept( '}' ))
+  {
+    string k;
+    if ( ! this->scan_key( k )) return false;
+
+    // all-digit keys and overlong domains are errors the node-tree parser reports
+    size_t domain_start = k.find_last_not_of( "0123456789" ) + 1;
+    if (( std::isdigit( static_cast< unsigned char >( k[0] ))) || ( k.size() - domain_start > 9 ) ||
+        ( std::find( keys.begin(), keys.end(), k ) != keys.end() ))
+    {
+      return false;
+    }
+    keys.push_back( k );
+
+    KPF::packet_t packet( KPF::packet_header_parser( k ));
+    bool okay = false;
+    switch (packet.header.style)
+    {
+    case KPF::packet_style::TS:
+      okay = this->scan_double( ",}", packet.timestamp.d );
+      break;
+
+    case KPF::packet_style::CONF:
+      okay = this->scan_double( ",}", packet.conf.d );
+      break;
+
+    case KPF::packet_style::EVAL:
+      okay = this->scan_double( ",}", packet.eval.d );
+      break;
+
+    case KPF::packet_style::ID:
+      okay = this->scan_uint64( packet.id.d );
+      break;
+
+    case KPF::packet_style::KV:
+      {
+        string v;
+        okay = this->scan_plain( ",}", v );
+        if (okay)
+        {
+          packet.kv = KPFC::kv_t( k, v );
+        }
+      }
+      break;
+
+    case KPF::packet_style::GEOM:
+      okay = this->scan_geom( packet.bbox );
+      break;
+
+    case KPF::packet_style::POLY:
+      okay = this->scan_poly( packet.poly );
+      break;
+
+    case KPF::packet_style::CSET:
+      okay = this->scan_cset( *packet.cset );
+      break;
+
+    default:
+      break;
+    }
+    if (! okay) return false;
+
+    local_packet_buffer.insert( make_pair( packet.header, std::move( packet )));
+
+    if ( this->accept( ',' )) continue;
+    if ( this->accept( '}' )) break;
+    return false;
+  }
+
+  if ( ! this->accept( '}' )) return false;
+  this->skip_spaces();
+  return ( this->p == this->end );
+}
+
+//
+// Lines of a file in line mode: either a record ("- " in the first
+// column), blank or a comment, or something else, which means the file
+// has to be parsed as a whole.
+//
+
+enum class line_kind { RECORD, SKIP, OTHER };
+
+line_kind
+next_line( const string& text, size_t& pos, const char*& b, const char*& e )
+{
+  size_t eol = text.find( '\n', pos );
+  if ( eol == string::npos ) eol = text.size();
+  b = text.data() + pos;
+  e = text.data() + eol;
+  pos = ( eol == text.size() ) ? eol : eol+1;
+  if (( e != b ) && ( *(e-1) == '\r' )) --e;
+
+  if (( e - b >= 2 ) && ( b[0] == '-' ) && ( b[1] == ' ' )) return line_kind::RECORD;
+  const char* c = b;
+  while (( c != e ) && ( *c == ' ' )) ++c;
+  return (( c == e ) || ( *c == '#' )) ? line_kind::SKIP : line_kind::OTHER;
+}
+
+// the yaml-cpp parse of a line the record_scanner didn't take
+bool
+parse_record_line( const char* b, const char* e,
+                   KPF::schema_style& schema,
+                   KPF::packet_buffer_t& local_packet_buffer )
+{
+  const string line( b, e );
+  YAML::Node doc;
+  try
+  {
+    doc = YAML::Load( line );
+  }
+  catch (const YAML::ParserException& ex )
+  {
+    LOG_ERROR( main_logger, "Exception parsing KPF YAML '" << line << "': " << ex.what() );
+    return false;
+  }
+  if ( ( ! doc.IsSequence() ) || ( doc.size() != 1 ))
+  {
+    LOG_ERROR( main_logger, "YAML: '" << line << "' is not a single record" );
+    return false;
+  }
+  return parse_record_node( doc[0], schema, local_packet_buffer );
+}
+
+// records scanned per thread per chunk
+const size_t chunk_records_per_thread = 2048;
+
 } // ...anon
 
 namespace kwiver {
@@ -481,27 +919,57 @@ namespace vital {
 namespace kpf {
 
 /**
- * \brief Load the YAML document in the constructor.
+ * \brief Read the input in the constructor.
  *
- * The entire document is loaded here; each "line" can be
- * accessed by iterating over the root.
+ * If every line is either a record or blank / a comment, the records are
+ * parsed a chunk at a time in parse_next_record(). Otherwise, the entire
+ * document is loaded here and each "line" is accessed by iterating over
+ * the root.
  *
  */
 
 kpf_yaml_parser_t
-::kpf_yaml_parser_t( istream& is )
-  : current_record_schema( schema_style::INVALID )
+::kpf_yaml_parser_t( istream& is, unsigned max_threads_in )
+  : current_record_schema( schema_style::INVALID ),
+    line_mode( true ),
+    max_threads( max_threads_in ? max_threads_in : std::max( std::thread::hardware_concurrency(), 1u ) ),
+    text_pos( 0 ),
+    n_records( 0 ),
+    n_records_read( 0 ),
+    chunk_pos( 0 )
 {
-  try
   {
-    this->root = YAML::Load( is );
+    ostringstream oss;
+    oss << is.rdbuf();
+    this->text = oss.str();
   }
-  // This seems not to work on OSX as of 30oct2017
-  // see https://stackoverflow.com/questions/21737201/problems-throwing-and-catching-exceptions-on-os-x-with-fno-rtti
-  catch (const YAML::ParserException& e )
+
+  const char* b;
+  const char* e;
+  for (size_t pos = 0; this->line_mode && (pos < this->text.size()); )
   {
-    LOG_ERROR( main_logger, "Exception parsing KPF YAML: " << e.what() );
-    this->root = YAML::Node();
+    switch (next_line( this->text, pos, b, e ))
+    {
+    case line_kind::RECORD: ++this->n_records; break;
+    case line_kind::SKIP:   break;
+    case line_kind::OTHER:  this->line_mode = false; break;
+    }
+  }
+
+  if ( ! this->line_mode )
+  {
+    try
+    {
+      this->root = YAML::Load( this->text );
+    }
+    // This seems not to work on OSX as of 30oct2017
+    // see https://stackoverflow.com/questions/21737201/problems-throwing-and-catching-exceptions-on-os-x-with-fno-rtti
+    catch (const YAML::ParserException& ex )
+    {
+      LOG_ERROR( main_logger, "Exception parsing KPF YAML: " << ex.what() );
+      this->root = YAML::Node();
+    }
+    string().swap( this->text );
   }
   this->current_record = this->root.begin();
 }
@@ -510,14 +978,17 @@ bool
 kpf_yaml_parser_t
 ::get_status() const
 {
-  return this->current_record != this->root.end();
+  return ! this->eof();
 }
 
 bool
 kpf_yaml_parser_t
 ::eof() const
 {
-  return this->current_record == this->root.end();
+  return
+    this->line_mode
+    ? ( this->n_records_read == this->n_records )
+    : ( this->current_record == this->root.end() );
 }
 
 schema_style
@@ -528,86 +999,123 @@ ::get_current_record_schema() const
 }
 
 /**
- * \brief Read the next child of root into the packet buffer.
- *
- * Starting with KPFv3, each yaml line is either:
- *
- * meta: xxxxxx
- *
- * or a set of
- *
- * schema: {xxx}
- *
- * where "schema" is a tag meant to assist in validation and parsing.
- *
- * The result is still to populate the local packet buffer; the schema
- * does not propagate beyond the parser.
- *
- * There is still only one schema instance per line; we don't support
- * (for example)
+ * \brief Scan the next chunk of record lines.
  *
- * - { geom: { geom-stuff }, geom: {geom-stuff} }
+ * The lines are divided among up to max_threads threads
+ * (fewer for short chunks), which run only the record_scanner; the lines
+ * it doesn't take are parsed by yaml-cpp in parse_next_record(), on the
+ * client's thread, since the parsers log. Returns false if there are no
+ * more records.
  *
  */
 
 bool
 kpf_yaml_parser_t
-::parse_next_record( packet_buffer_t& local_packet_buffer )
+::parse_next_chunk()
 {
-
-  //
-  // This routine gets called once per line.
-  //
-
-  if (this->current_record == this->root.end())
+  const size_t n_threads = this->max_threads;
+
+  this->chunk.clear();
+  this->chunk_pos = 0;
+  const char* b;
+  const char* e;
+  while (( this->chunk.size() < n_threads * chunk_records_per_thread ) &&
+         ( this->text_pos < this->text.size() ))
+  {
+    if ( next_line( this->text, this->text_pos, b, e ) == line_kind::RECORD )
+    {
+      this->chunk.push_back( parsed_record_t() );
+      this->chunk.back().line_begin = b;
+      this->chunk.back().line_end = e;
+    }
+  }
+  if ( this->chunk.empty() )
   {
     return false;
   }
 
-  const YAML::Node& n = *(this->current_record++);
-
-  //
-  // The line must be a map.
-  //
+  auto worker = [this]( size_t first, size_t last ) {
+    for (size_t i = first; i < last; ++i)
+    {
+      parsed_record_t& r = this->chunk[ i ];
+      try
+      {
+        record_scanner scanner( r.line_begin, r.line_end );
+        r.scanned = scanner.scan( r.schema, r.packets );
+        if ( ! r.scanned )
+        {
+          r.packets.clear();
+        }
+      }
+      catch (...)
+      {
+        r.error = std::current_exception();
+      }
+    }
+  };
 
-  if (! n.IsMap())
+  const size_t n = this->chunk.size();
+  const size_t n_workers = std::min( n_threads, ( n + chunk_records_per_thread - 1 ) / chunk_records_per_thread );
+  const size_t per_worker = ( n + n_workers - 1 ) / n_workers;
+  vector< std::thread > threads;
+  for (size_t i = 1; i < n_workers; ++i)
   {
-    LOG_ERROR( main_logger, "YAML: root node is " << n.Type() << "; expected map" );
-    LOG_ERROR( main_logger, "node as string: '" << n.as<string>() << "'" );
-    return false;
+    threads.push_back( std::thread( worker, std::min( n, i * per_worker ), std::min( n, (i+1) * per_worker )));
+  }
+  worker( 0, std::min( n, per_worker ));
+  for (auto& t: threads)
+  {
+    t.join();
   }
+  return true;
+}
 
-  //
-  // Each element of the map is itself a map, k:v. If k is a kpfv3 schema,
-  // parse v as a map of elements which must conform to the constraints of
-  // the schema k. Otherwise, treat all of the toplevel map as a kpfv2 file,
-  // and guess at its schema.
-  //
+/**
+ * \brief Read the next record into the packet buffer.
+ *
+ * See parse_record_node() for the record format.
+ *
+ */
+
+bool
+kpf_yaml_parser_t
+::parse_next_record( packet_buffer_t& local_packet_buffer )
+{
 
   //
-  // Is it a kpfv3 schema tag?
+  // This routine gets called once per line.
   //
 
-  bool okay = false;
-  auto check = kpf_v3_check( n );
-  auto n_sub = n.begin();
-
-  this->current_record_schema = check;
-
-  // special case for meta
-  if ( str2style( n_sub->first.as<string>()) == packet_style::META )
-  {
-    okay = parse_as_kpf_v3( n, schema_style::UNSPECIFIED, local_packet_buffer );
-  }
-  else
+  if ( this->line_mode )
   {
-    if ( check != schema_style::INVALID )
+    if (( this->chunk_pos == this->chunk.size() ) && ( ! this->parse_next_chunk() ))
     {
-      okay = parse_as_kpf_v3( n_sub->second, check, local_packet_buffer );
+      return false;
+    }
+    parsed_record_t& r = this->chunk[ this->chunk_pos++ ];
+    ++this->n_records_read;
+    if ( r.error )
+    {
+      std::rethrow_exception( r.error );
     }
+    if ( ! r.scanned )
+    {
+      this->current_record_schema = schema_style::INVALID;
+      return parse_record_line( r.line_begin, r.line_end, this->current_record_schema, local_packet_buffer );
+    }
+    this->current_record_schema = r.schema;
+    local_packet_buffer.insert( r.packets.begin(), r.packets.end() );
+    r.packets.clear();
+    return true;
   }
 
-  return okay;
+  if (this->current_record == this->root.end())
+  {
+    return false;
+  }
+
+  const YAML::Node& n = *(this->current_record++);
+  return parse_record_node( n, this->current_record_schema, local_packet_buffer );
 }
 
 } // ...kpf
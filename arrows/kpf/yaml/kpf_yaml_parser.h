@@ -6,9 +6,15 @@
  * @file
  * @brief KPF YAML parser class.
  *
- * Header for the KPF YAML parser; holds the YAML root document and provides
- * the interface for reading each KPF line (which shows up as a YAML map)
- * into the KPF generic parser's packet buffer.
+ * Header for the KPF YAML parser; provides the interface for reading each
+ * KPF line (which shows up as a YAML map) into the KPF generic parser's
+ * packet buffer.
+ *
+ * When the input is one record per line (as written by the
+ * record_yaml_writer), records are scanned a chunk at a time, in parallel;
+ * lines in the writer's flat shape are read by a dedicated scanner and the
+ * others are handed to yaml-cpp one line at a time. Any other input is
+ * loaded as a single YAML document.
  */
 
 #ifndef KWIVER_VITAL_KPF_YAML_PARSER_H_
@@ -19,6 +25,11 @@
 
 #include <yaml-cpp/yaml.h>
 
+#include <cstddef>
+#include <exception>
+#include <string>
+#include <vector>
+
 namespace kwiver {
 namespace vital {
 namespace kpf {
@@ -26,7 +37,9 @@ namespace kpf {
 class KPF_YAML_EXPORT kpf_yaml_parser_t: public kpf_parser_base_t
 {
 public:
-  explicit kpf_yaml_parser_t( std::istream& is );
+  // Record lines are scanned by up to max_threads threads; zero uses one
+  // per hardware thread
+  explicit kpf_yaml_parser_t( std::istream& is, unsigned max_threads = 0 );
   ~kpf_yaml_parser_t() {}
 
   virtual bool get_status() const;
@@ -35,9 +48,35 @@ class KPF_YAML_EXPORT kpf_yaml_parser_t: public kpf_parser_base_t
   virtual bool eof() const;
 
 private:
+  // a record line of the current chunk, scanned ahead of the client
+  struct parsed_record_t
+  {
+    const char* line_begin;
+    const char* line_end;
+    bool scanned;
+    schema_style schema;
+    packet_buffer_t packets;
+    std::exception_ptr error;
+    parsed_record_t()
+      : line_begin( 0 ), line_end( 0 ), scanned( false ), schema( schema_style::INVALID )
+    {}
+  };
+
+  bool parse_next_chunk();
+
+  // document mode
   YAML::Node root;
   YAML::const_iterator current_record;
   schema_style current_record_schema;
+
+  // line mode
+  bool line_mode;
+  unsigned max_threads;
+  std::string text;
+  size_t text_pos;
+  size_t n_records, n_records_read;
+  std::vector< parsed_record_t > chunk;
+  size_t chunk_pos;
 };
 
 } // ...kpf
@@ -254,6 +254,43 @@ static const string improper_kpf =
          "- { geom: { src: linear-interpolation, g0: 1606 228 1820 728, occlusion: , id0: 28, id1: 1, ts0: 2432, ts1: 0 } }\n"
          "- { geom: { src: linear-interpolation, g0: 1604 228 1820 733, occlusion: , id0: 29, id1: 1, ts0: 2433, ts1: 0 } }\n";
 
+//
+// Records covering the scanner's shapes and the ones it leaves to yaml-cpp.
+//
+
+static const string mixed_kpf =
+         "- { meta: Record 0 }\n"
+         "- { geom: { g0: 33.3 33.3 43.3 53.3, id0: 100, ts0: 4, poly0: [[ 10, 10 ],[ 20, 20 ],[ 10, 30 ],], label: vehicle, conf17: 0.3,  } }\n"
+         "# a comment\n"
+         "\n"
+         "- { geom: { id1: 7, cset3: {person: 0.25, vehicle: 0.75, }, eval2: -1.5e2, src: truth } }\r\n"
+         "- { geom: { id0: 012, ts0: 0x10, ts1: .inf, label: 'quoted, string', note: ~, } }\n"
+         "- { geom: { id0: 5, label: car, label: truck } }   # trailing comment\n"
+         "- { geom: { g0: 1 2 3, id0: 6 } }\n"
+         "- { act: { act2: {walking: 1, }, id2: 3, timespan: [{ tsr0: [1 , 10],  }], actors: [{id1: 5, timespan: [{tsr0: [1, 10]}]} , ] } }\n"
+         "- { types: { id1: 3, cset3: { person: 1.0 } } }\n";
+
+vector< string >
+parse_records( const string& s )
+{
+  istringstream iss( s );
+  KPF::kpf_yaml_parser_t parser( iss );
+  vector< string > records;
+  while ( ! parser.eof() )
+  {
+    KPF::packet_buffer_t packets;
+    ostringstream oss;
+    oss << parser.parse_next_record( packets ) << " "
+        << KPF::validation_data::schema_style_to_str( parser.get_current_record_schema() );
+    for (const auto& p: packets)
+    {
+      oss << " | " << p.second;
+    }
+    records.push_back( oss.str() );
+  }
+  return records;
+}
+
 } // ... anon
 
 int
@@ -341,3 +378,30 @@ IMPLEMENT_TEST( kpf_packet_extraction )
   TEST_EQUAL( "Read more lines after first line", c > 0, true );
 
 }
+
+IMPLEMENT_TEST( kpf_line_and_document_parse_agree )
+{
+  // the "---" forces the whole-document parse of the same records
+  for (const string& src: { mixed_kpf, improper_kpf })
+  {
+    vector< string > by_line = parse_records( src );
+    vector< string > by_document = parse_records( "---\n" + src );
+    TEST_EQUAL( "Line and document parse: same number of records", by_line.size(), by_document.size() );
+    for (size_t i=0; (i<by_line.size()) && (i<by_document.size()); ++i)
+    {
+      TEST_EQUAL( "Line and document parse: record " + by_document[i], by_line[i], by_document[i] );
+    }
+  }
+
+  // enough records to take several chunks
+  stringstream ss;
+  vector< user_complex_detection_t > dets;
+  for (size_t i=0; i<10000; ++i)
+  {
+    dets.push_back( user_complex_detection_t( i, i/10, {i * 0.5, 1.25}, 10, 20, "vehicle", 0.1, {1,2,3}, {4,5,6} ));
+  }
+  write_detections_to_stream( ss, dets );
+  vector< user_complex_detection_t > new_dets = read_detections_from_stream( ss );
+  TEST_EQUAL( "Read back many detections", new_dets.size(), dets.size() );
+  TEST_EQUAL( "Many detections: source eq output", new_dets == dets, true );
+}
@@ -0,0 +1,218 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of MVG estimate_fundamental_matrix algorithm
+
+#include "estimate_fundamental_matrix.h"
+
+#include <arrows/mvg/robust_estimation.h>
+
+#include <Eigen/SVD>
+
+using namespace kwiver::vital;
+
+namespace kwiver {
+namespace arrows {
+namespace mvg {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Fit fundamental matrices to point correspondences for robust_estimate()
+class fundamental_matrix_solver
+{
+public:
+  using model_t = matrix_3x3d;
+  static constexpr size_t sample_size = 8;
+
+  fundamental_matrix_solver( std::vector< vector_2d > const& pts1,
+                             std::vector< vector_2d > const& pts2 )
+    : x1( pts1.size() ), y1( pts1.size() ),
+      x2( pts2.size() ), y2( pts2.size() )
+  {
+    for( size_t i = 0; i < pts1.size(); ++i )
+    {
+      x1[ i ] = pts1[ i ].x();
+      y1[ i ] = pts1[ i ].y();
+      x2[ i ] = pts2[ i ].x();
+      y2[ i ] = pts2[ i ].y();
+    }
+
+    // fit in normalized coordinates for numerical stability
+    T1 = normalizing_transform( x1, y1 );
+    T2 = normalizing_transform( x2, y2 );
+    nx1 = T1( 0, 0 ) * x1 + T1( 0, 2 );
+    ny1 = T1( 1, 1 ) * y1 + T1( 1, 2 );
+    nx2 = T2( 0, 0 ) * x2 + T2( 0, 2 );
+    ny2 = T2( 1, 1 ) * y2 + T2( 1, 2 );
+  }
+
+  size_t size() const { return static_cast< size_t >( x1.size() ); }
+
+  bool
+  fit_sample( size_t const* indices, model_t& F ) const
+  {
+    return fit( indices, sample_size, F );
+  }
+
+  bool
+  fit_inliers( std::vector< size_t > const& indices, model_t& F ) const
+  {
+    return fit( indices.data(), indices.size(), F );
+  }
+
+  // Squared Sampson distance of each correspondence
+  void
+  residuals( model_t const& F, Eigen::ArrayXd& r ) const
+  {
+    // epipolar lines of the points in the other image
+    Eigen::ArrayXd const a = F( 0, 0 ) * x1 + F( 0, 1 ) * y1 + F( 0, 2 );
+    Eigen::ArrayXd const b = F( 1, 0 ) * x1 + F( 1, 1 ) * y1 + F( 1, 2 );
+    Eigen::ArrayXd const c = F( 2, 0 ) * x1 + F( 2, 1 ) * y1 + F( 2, 2 );
+    Eigen::ArrayXd const d = F( 0, 0 ) * x2 + F( 1, 0 ) * y2 + F( 2, 0 );
+    Eigen::ArrayXd const e = F( 0, 1 ) * x2 + F( 1, 1 ) * y2 + F( 2, 1 );
+
+    Eigen::ArrayXd const err = x2 * a + y2 * b + c;
+    Eigen::ArrayXd const norm = a.square() + b.square() +
+                                d.square() + e.square();
+    r = ( norm > 0.0 )
+        .select( err.square() / norm,
+                 std::numeric_limits< double >::infinity() );
+  }
+
+private:
+  // Fit with the normalized eight point algorithm
+  bool
+  fit( size_t const* indices, size_t count, model_t& F ) const
+  {
+    Eigen::Matrix< double, Eigen::Dynamic, 9 > A( count, 9 );
+    for( size_t n = 0; n < count; ++n )
+    {
+      auto const i = indices[ n ];
+      double const x = nx1[ i ], y = ny1[ i ];
+      double const u = nx2[ i ], v = ny2[ i ];
+      A.row( n ) << u * x, u * y, u, v * x, v * y, v, x, y, 1.0;
+    }
+
+    Eigen::JacobiSVD< Eigen::Matrix< double, Eigen::Dynamic, 9 > >
+      svd( A, Eigen::ComputeFullV );
+    Eigen::Matrix< double, 9, 1 > const f = svd.matrixV().col( 8 );
+    matrix_3x3d Fn;
+    Fn << f[ 0 ], f[ 1 ], f[ 2 ],
+          f[ 3 ], f[ 4 ], f[ 5 ],
+          f[ 6 ], f[ 7 ], f[ 8 ];
+
+    // enforce rank two
+    Eigen::JacobiSVD< matrix_3x3d >
+      svd_f( Fn, Eigen::ComputeFullU | Eigen::ComputeFullV );
+    vector_3d s = svd_f.singularValues();
+    s[ 2 ] = 0.0;
+    Fn = svd_f.matrixU() * s.asDiagonal() * svd_f.matrixV().transpose();
+
+    F = T2.transpose() * Fn * T1;
+    auto const norm = F.norm();
+    if( !( norm > 0.0 ) || !F.allFinite() )
+    {
+      return false;
+    }
+    F /= norm;
+    return true;
+  }
+
+  Eigen::ArrayXd x1, y1, x2, y2;
+  Eigen::ArrayXd nx1, ny1, nx2, ny2;
+  matrix_3x3d T1, T2;
+};
+
+} // end anonymous namespace
+
+// ----------------------------------------------------------------------------
+// Private implementation class
+class estimate_fundamental_matrix::priv
+  : public robust_estimation_options
+{
+};
+
+// ----------------------------------------------------------------------------
+estimate_fundamental_matrix
+::estimate_fundamental_matrix()
+  : d_(new priv)
+{
+  attach_logger( "arrows.mvg.estimate_fundamental_matrix" );
+}
+
+// ----------------------------------------------------------------------------
+estimate_fundamental_matrix
+::~estimate_fundamental_matrix()
+{
+}
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+estimate_fundamental_matrix
+::get_configuration() const
+{
+  // get base config from base class
+  vital::config_block_sptr config =
+    vital::algo::estimate_fundamental_matrix::get_configuration();
+
+  d_->get_configuration( config );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+estimate_fundamental_matrix
+::set_configuration(vital::config_block_sptr in_config)
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config(in_config);
+
+  d_->set_configuration( config );
+}
+
+// ----------------------------------------------------------------------------
+bool
+estimate_fundamental_matrix
+::check_configuration(vital::config_block_sptr config) const
+{
+  return d_->check_configuration( config );
+}
+
+// ----------------------------------------------------------------------------
+fundamental_matrix_sptr
+estimate_fundamental_matrix
+::estimate(const std::vector<vector_2d>& pts1,
+           const std::vector<vector_2d>& pts2,
+           std::vector<bool>& inliers,
+           double inlier_scale) const
+{
+  if (pts1.size() < 8 || pts2.size() < 8)
+  {
+    LOG_ERROR(logger(), "Not enough points to estimate a fundamental matrix");
+    return fundamental_matrix_sptr();
+  }
+  if (pts1.size() != pts2.size())
+  {
+    LOG_ERROR(logger(), "Number of corresponding points must match");
+    return fundamental_matrix_sptr();
+  }
+
+  fundamental_matrix_solver const solver( pts1, pts2 );
+  auto const result = robust_estimate( solver, inlier_scale, *d_ );
+  if (!result.success)
+  {
+    LOG_ERROR(logger(), "Unable to find a fundamental matrix from any sample");
+    return fundamental_matrix_sptr();
+  }
+
+  inliers = result.inliers;
+  return std::make_shared< fundamental_matrix_<double> >( result.model );
+}
+
+} // end namespace mvg
+} // end namespace arrows
+} // end namespace kwiver
@@ -0,0 +1,73 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header for MVG estimate_fundamental_matrix algorithm
+
+#ifndef KWIVER_ARROWS_MVG_ESTIMATE_FUNDAMENTAL_MATRIX_H_
+#define KWIVER_ARROWS_MVG_ESTIMATE_FUNDAMENTAL_MATRIX_H_
+
+#include <arrows/mvg/kwiver_algo_mvg_export.h>
+
+#include <vital/algo/estimate_fundamental_matrix.h>
+
+namespace kwiver {
+namespace arrows {
+namespace mvg {
+
+/// A class that robustly estimates a fundamental matrix from matching 2D points
+///
+/// Hypotheses are fit to eight point samples with the normalized eight point
+/// algorithm and scored by Sampson distance, in parallel batches on the vital
+/// thread pool. See robust_estimate() for details.
+class KWIVER_ALGO_MVG_EXPORT estimate_fundamental_matrix
+  : public vital::algo::estimate_fundamental_matrix
+{
+public:
+  PLUGIN_INFO( "mvg",
+               "Use LO-RANSAC to robustly estimate a fundamental matrix "
+               "from matched features, evaluating hypotheses in parallel." )
+
+  /// Constructor
+  estimate_fundamental_matrix();
+
+  /// Destructor
+  virtual ~estimate_fundamental_matrix();
+
+  /// Get this algorithm's \link vital::config_block configuration block \endlink
+  virtual vital::config_block_sptr get_configuration() const;
+
+  /// Set this algorithm's properties via a config block
+  virtual void set_configuration(vital::config_block_sptr config);
+
+  /// Check that the algorithm's configuration config_block is valid
+  virtual bool check_configuration(vital::config_block_sptr config) const;
+
+  /// Estimate a fundamental matrix from corresponding points
+  ///
+  /// If estimation fails, a NULL-containing sptr is returned
+  ///
+  /// \param [in]  pts1 the vector or corresponding points from the source image
+  /// \param [in]  pts2 the vector of corresponding points from the destination image
+  /// \param [out] inliers for each point pair, the value is true if
+  ///                      this pair is an inlier to the fundamental matrix estimate
+  /// \param [in]  inlier_scale error distance tolerated for matches to be inliers
+  virtual vital::fundamental_matrix_sptr
+  estimate(const std::vector<vital::vector_2d>& pts1,
+           const std::vector<vital::vector_2d>& pts2,
+           std::vector<bool>& inliers,
+           double inlier_scale = 1.0) const;
+  using vital::algo::estimate_fundamental_matrix::estimate;
+
+private:
+  /// private implementation class
+  class priv;
+  const std::unique_ptr<priv> d_;
+};
+
+} // end namespace mvg
+} // end namespace arrows
+} // end namespace kwiver
+
+#endif
@@ -0,0 +1,225 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of MVG estimate_homography algorithm
+
+#include "estimate_homography.h"
+
+#include <arrows/mvg/robust_estimation.h>
+
+#include <Eigen/LU>
+#include <Eigen/SVD>
+
+using namespace kwiver::vital;
+
+namespace kwiver {
+namespace arrows {
+namespace mvg {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Fit homographies to point correspondences for robust_estimate()
+class homography_solver
+{
+public:
+  using model_t = matrix_3x3d;
+  static constexpr size_t sample_size = 4;
+
+  homography_solver( std::vector< vector_2d > const& pts1,
+                     std::vector< vector_2d > const& pts2 )
+    : x1( pts1.size() ), y1( pts1.size() ),
+      x2( pts2.size() ), y2( pts2.size() )
+  {
+    for( size_t i = 0; i < pts1.size(); ++i )
+    {
+      x1[ i ] = pts1[ i ].x();
+      y1[ i ] = pts1[ i ].y();
+      x2[ i ] = pts2[ i ].x();
+      y2[ i ] = pts2[ i ].y();
+    }
+
+    // fit in normalized coordinates for numerical stability
+    T1 = normalizing_transform( x1, y1 );
+    matrix_3x3d const T2 = normalizing_transform( x2, y2 );
+    T2_inv = T2.inverse();
+    nx1 = T1( 0, 0 ) * x1 + T1( 0, 2 );
+    ny1 = T1( 1, 1 ) * y1 + T1( 1, 2 );
+    nx2 = T2( 0, 0 ) * x2 + T2( 0, 2 );
+    ny2 = T2( 1, 1 ) * y2 + T2( 1, 2 );
+  }
+
+  size_t size() const { return static_cast< size_t >( x1.size() ); }
+
+  bool
+  fit_sample( size_t const* indices, model_t& H ) const
+  {
+    // reject samples with three collinear points in either image
+    for( size_t a = 0; a < 4; ++a )
+    {
+      auto const i = indices[ ( a + 1 ) % 4 ];
+      auto const j = indices[ ( a + 2 ) % 4 ];
+      auto const k = indices[ ( a + 3 ) % 4 ];
+      if( collinear( nx1, ny1, i, j, k ) || collinear( nx2, ny2, i, j, k ) )
+      {
+        return false;
+      }
+    }
+    return fit( indices, sample_size, H );
+  }
+
+  bool
+  fit_inliers( std::vector< size_t > const& indices, model_t& H ) const
+  {
+    return fit( indices.data(), indices.size(), H );
+  }
+
+  // Squared transfer error of each point in the destination image
+  void
+  residuals( model_t const& H, Eigen::ArrayXd& r ) const
+  {
+    Eigen::ArrayXd const w = H( 2, 0 ) * x1 + H( 2, 1 ) * y1 + H( 2, 2 );
+    Eigen::ArrayXd const ex =
+      ( H( 0, 0 ) * x1 + H( 0, 1 ) * y1 + H( 0, 2 ) ) / w - x2;
+    Eigen::ArrayXd const ey =
+      ( H( 1, 0 ) * x1 + H( 1, 1 ) * y1 + H( 1, 2 ) ) / w - y2;
+
+    // points mapped to infinity are never inliers
+    r = ( w.abs() > std::numeric_limits< double >::epsilon() )
+        .select( ex.square() + ey.square(),
+                 std::numeric_limits< double >::infinity() );
+  }
+
+private:
+  static bool
+  collinear( Eigen::ArrayXd const& x, Eigen::ArrayXd const& y,
+             size_t i, size_t j, size_t k )
+  {
+    auto const area = ( x[ j ] - x[ i ] ) * ( y[ k ] - y[ i ] ) -
+                      ( y[ j ] - y[ i ] ) * ( x[ k ] - x[ i ] );
+    return std::abs( area ) < 1e-9;
+  }
+
+  // Fit with the direct linear transform
+  bool
+  fit( size_t const* indices, size_t count, model_t& H ) const
+  {
+    Eigen::Matrix< double, Eigen::Dynamic, 9 > A( 2 * count, 9 );
+    for( size_t n = 0; n < count; ++n )
+    {
+      auto const i = indices[ n ];
+      double const x = nx1[ i ], y = ny1[ i ];
+      double const u = nx2[ i ], v = ny2[ i ];
+      A.row( 2 * n ) << -x, -y, -1.0, 0.0, 0.0, 0.0, u * x, u * y, u;
+      A.row( 2 * n + 1 ) << 0.0, 0.0, 0.0, -x, -y, -1.0, v * x, v * y, v;
+    }
+
+    Eigen::JacobiSVD< Eigen::Matrix< double, Eigen::Dynamic, 9 > >
+      svd( A, Eigen::ComputeFullV );
+    Eigen::Matrix< double, 9, 1 > const h = svd.matrixV().col( 8 );
+    matrix_3x3d Hn;
+    Hn << h[ 0 ], h[ 1 ], h[ 2 ],
+          h[ 3 ], h[ 4 ], h[ 5 ],
+          h[ 6 ], h[ 7 ], h[ 8 ];
+
+    H = T2_inv * Hn * T1;
+    return H.allFinite() && std::abs( H.determinant() ) > 0.0;
+  }
+
+  Eigen::ArrayXd x1, y1, x2, y2;
+  Eigen::ArrayXd nx1, ny1, nx2, ny2;
+  matrix_3x3d T1, T2_inv;
+};
+
+} // end anonymous namespace
+
+// ----------------------------------------------------------------------------
+// Private implementation class
+class estimate_homography::priv
+  : public robust_estimation_options
+{
+};
+
+// ----------------------------------------------------------------------------
+estimate_homography
+::estimate_homography()
+  : d_(new priv)
+{
+  attach_logger( "arrows.mvg.estimate_homography" );
+}
+
+// ----------------------------------------------------------------------------
+estimate_homography
+::~estimate_homography()
+{
+}
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+estimate_homography
+::get_configuration() const
+{
+  // get base config from base class
+  vital::config_block_sptr config =
+    vital::algo::estimate_homography::get_configuration();
+
+  d_->get_configuration( config );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+estimate_homography
+::set_configuration(vital::config_block_sptr in_config)
+{
+  vital::config_block_sptr config = this->get_configuration();
+  config->merge_config(in_config);
+
+  d_->set_configuration( config );
+}
+
+// ----------------------------------------------------------------------------
+bool
+estimate_homography
+::check_configuration(vital::config_block_sptr config) const
+{
+  return d_->check_configuration( config );
+}
+
+// ----------------------------------------------------------------------------
+homography_sptr
+estimate_homography
+::estimate(const std::vector<vector_2d>& pts1,
+           const std::vector<vector_2d>& pts2,
+           std::vector<bool>& inliers,
+           double inlier_scale) const
+{
+  if (pts1.size() < 4 || pts2.size() < 4)
+  {
+    LOG_ERROR(logger(), "Not enough points to estimate a homography");
+    return homography_sptr();
+  }
+  if (pts1.size() != pts2.size())
+  {
+    LOG_ERROR(logger(), "Number of corresponding points must match");
+    return homography_sptr();
+  }
+
+  homography_solver const solver( pts1, pts2 );
+  auto const result = robust_estimate( solver, inlier_scale, *d_ );
+  if (!result.success)
+  {
+    LOG_ERROR(logger(), "Unable to find a homography from any sample");
+    return homography_sptr();
+  }
+
+  inliers = result.inliers;
+  return std::make_shared< homography_<double> >( result.model );
+}
+
+} // end namespace mvg
+} // end namespace arrows
+} // end namespace kwiver
@@ -18,11 +18,13 @@
 #include <math.h>
 
 #include <vital/util/cpu_timer.h>
+#include <vital/util/thread_pool.h>
 
 #include <vital/algo/optimize_cameras.h>
 #include <vital/algo/triangulate_landmarks.h>
 #include <arrows/mvg/metrics.h>
 #include <arrows/mvg/interpolate_camera.h>
+#include <arrows/mvg/transform.h>
 
 #include <vital/types/camera_perspective.h>
 #include <vital/exceptions.h>
@@ -78,6 +80,71 @@ int_interp(frame_id_t a, frame_id_t b, double p)
   return static_cast<frame_id_t>(a*(1.0-p) + b*p + 0.5);
 }
 
+// ----------------------------------------------------------------------------
+// Estimate the similarity which takes the poses of the cameras in \p from to
+// the poses of the cameras of the same frames in \p to
+/**
+ * The rotation is the average over all cameras, so unlike an alignment of
+ * camera centers alone it is well defined for cameras along a line.
+ */
+similarity_d
+align_cameras(camera_map::map_camera_t const& from,
+              camera_map::map_camera_t const& to)
+{
+  std::vector<vector_3d> centers_from, centers_to;
+  Eigen::Vector4d q_sum = Eigen::Vector4d::Zero();
+  for (camera_map::map_camera_t::value_type const& p : from)
+  {
+    auto const it = to.find(p.first);
+    if (it == to.end())
+    {
+      continue;
+    }
+    auto const cam_from = std::dynamic_pointer_cast<camera_perspective>(p.second);
+    auto const cam_to = std::dynamic_pointer_cast<camera_perspective>(it->second);
+    if (!cam_from || !cam_to)
+    {
+      continue;
+    }
+
+    // a similarity with rotation R takes camera rotation Rc to Rc * R^-1
+    rotation_d const R = cam_to->rotation().inverse() * cam_from->rotation();
+    Eigen::Vector4d q = R.quaternion().coeffs();
+    if (q.dot(q_sum) < 0.0)
+    {
+      q = -q;
+    }
+    q_sum += q;
+    centers_from.push_back(cam_from->center());
+    centers_to.push_back(cam_to->center());
+  }
+  if (centers_from.empty())
+  {
+    return similarity_d();
+  }
+
+  rotation_d const R(vector_4d(q_sum.normalized()));
+  vector_3d mean_from = vector_3d::Zero(), mean_to = vector_3d::Zero();
+  for (size_t i = 0; i < centers_from.size(); ++i)
+  {
+    mean_from += centers_from[i];
+    mean_to += centers_to[i];
+  }
+  mean_from /= static_cast<double>(centers_from.size());
+  mean_to /= static_cast<double>(centers_to.size());
+
+  double spread_from = 0.0, spread_to = 0.0;
+  for (size_t i = 0; i < centers_from.size(); ++i)
+  {
+    spread_from += (centers_from[i] - mean_from).norm();
+    spread_to += (centers_to[i] - mean_to).norm();
+  }
+  double const scale = (spread_from > 0.0 && spread_to > 0.0)
+                       ? spread_to / spread_from : 1.0;
+
+  return similarity_d(scale, R, mean_to - scale * (R * mean_from));
+}
+
 } // end anonymous namespace
 
 // ============================================================================
@@ -89,20 +156,180 @@ class hierarchical_bundle_adjust::priv
     : initial_sub_sample(1)
     , interpolation_rate(0)
     , rmse_reporting_enabled(false)
+    , partition_size(0)
+    , partition_overlap(5)
   {
   }
 
   ~priv() { }
 
+  /// Bundle adjust the cameras in overlapping partitions solved in parallel
+  void optimize_partitioned(camera_map_sptr & cameras,
+                            landmark_map_sptr & landmarks,
+                            feature_track_set_sptr tracks,
+                            sfm_constraints_sptr constraints,
+                            vital::logger_handle_t logger) const;
+
   unsigned int initial_sub_sample;
   unsigned int interpolation_rate;
   bool rmse_reporting_enabled;
+  unsigned int partition_size;
+  unsigned int partition_overlap;
 
   vital::algo::bundle_adjust_sptr sba;
   vital::algo::optimize_cameras_sptr camera_optimizer;
   vital::algo::triangulate_landmarks_sptr lm_triangulator;
 };
 
+// ----------------------------------------------------------------------------
+/**
+ * Cameras are split, in frame order, into partitions of partition_size
+ * cameras, each extended by partition_overlap cameras of its neighbors on
+ * either side.  Each partition is solved on the thread pool by its own
+ * instance of the nested bundle adjuster, with copies of the cameras and the
+ * landmarks they see.  Each solution is then mapped back to the coordinate
+ * frame of the input cameras by the similarity which best aligns its camera
+ * poses with their input poses, so that no error accumulates from one
+ * partition to the next.  Each camera is taken from the partition it is not
+ * an overlap camera of, and landmarks seen in several partitions are
+ * averaged.
+ */
+void
+hierarchical_bundle_adjust::priv
+::optimize_partitioned(camera_map_sptr & cameras,
+                       landmark_map_sptr & landmarks,
+                       feature_track_set_sptr tracks,
+                       sfm_constraints_sptr constraints,
+                       vital::logger_handle_t logger) const
+{
+  camera_map::map_camera_t const input_cams = cameras->cameras();
+  landmark_map::map_landmark_t const input_lms = landmarks->landmarks();
+  std::vector<frame_id_t> frames;
+  for (camera_map::map_camera_t::value_type const& p : input_cams)
+  {
+    frames.push_back(p.first);
+  }
+
+  size_t const num_parts =
+    (frames.size() + this->partition_size - 1) / this->partition_size;
+  if (num_parts < 2)
+  {
+    this->sba->optimize(cameras, landmarks, tracks, constraints);
+    return;
+  }
+
+  struct partition
+  {
+    size_t core_begin, core_end;
+    vital::algo::bundle_adjust_sptr sba;
+    camera_map::map_camera_t input_cams;
+    camera_map_sptr cameras;
+    landmark_map_sptr landmarks;
+  };
+
+  std::vector<partition> parts(num_parts);
+  for (size_t k = 0; k < num_parts; ++k)
+  {
+    auto& part = parts[k];
+    part.core_begin = k * this->partition_size;
+    part.core_end = std::min(frames.size(), part.core_begin + this->partition_size);
+    size_t const begin = part.core_begin > this->partition_overlap
+                         ? part.core_begin - this->partition_overlap : 0;
+    size_t const end = std::min(frames.size(),
+                                part.core_end + this->partition_overlap);
+
+    // the nested bundle adjuster is not assumed to be reentrant
+    if (k == 0)
+    {
+      part.sba = this->sba;
+    }
+    else
+    {
+      part.sba = vital::algo::bundle_adjust::create(this->sba->impl_name());
+      part.sba->set_configuration(this->sba->get_configuration());
+    }
+
+    // partitions are solved on copies, as landmarks are shared between them
+    camera_map::map_camera_t cams;
+    landmark_map::map_landmark_t lms;
+    for (size_t i = begin; i < end; ++i)
+    {
+      auto const fid = frames[i];
+      auto const& cam = input_cams.at(fid);
+      part.input_cams[fid] = cam;
+      cams[fid] = cam->clone();
+      for (auto const& t : tracks->active_tracks(fid))
+      {
+        auto const it = input_lms.find(t->id());
+        if (it != input_lms.end() && lms.count(it->first) == 0)
+        {
+          lms[it->first] = it->second->clone();
+        }
+      }
+    }
+    part.cameras = std::make_shared<simple_camera_map>(cams);
+    part.landmarks = std::make_shared<simple_landmark_map>(lms);
+  }
+
+  LOG_INFO(logger, "Optimizing " << frames.size() << " cameras in "
+                   << num_parts << " partitions");
+  { // scope block
+    kwiver::vital::scoped_cpu_timer t( "partitioned SBA" );
+    vital::thread_pool::instance().parallel_for(num_parts, 1,
+      [&](size_t begin, size_t end)
+      {
+        for (size_t k = begin; k < end; ++k)
+        {
+          parts[k].sba->optimize(parts[k].cameras, parts[k].landmarks,
+                                 tracks, constraints);
+        }
+      });
+  }
+
+  // map each partition back to the frame of the input cameras and merge them
+  camera_map::map_camera_t merged_cams = input_cams;
+  std::map<landmark_id_t, std::pair<vector_3d, unsigned>> lm_sums;
+  for (auto const& part : parts)
+  {
+    auto const part_cams = part.cameras->cameras();
+    similarity_d const xform = align_cameras(part_cams, part.input_cams);
+    LOG_DEBUG(logger, "Partition of frames " << frames[part.core_begin]
+                      << " to " << frames[part.core_end - 1]
+                      << " aligned with " << xform);
+
+    for (size_t i = part.core_begin; i < part.core_end; ++i)
+    {
+      auto const it = part_cams.find(frames[i]);
+      auto const cam =
+        it == part_cams.end()
+        ? nullptr : std::dynamic_pointer_cast<camera_perspective>(it->second);
+      if (cam)
+      {
+        merged_cams[frames[i]] = transform(cam, xform);
+      }
+    }
+    for (landmark_map::map_landmark_t::value_type const& p :
+         part.landmarks->landmarks())
+    {
+      auto& sum = lm_sums.emplace(
+        p.first, std::make_pair(vector_3d::Zero().eval(), 0u)).first->second;
+      sum.first += xform * p.second->loc();
+      ++sum.second;
+    }
+  }
+
+  landmark_map::map_landmark_t merged_lms = input_lms;
+  for (auto const& p : lm_sums)
+  {
+    auto lm = std::make_shared<landmark_d>(*input_lms.at(p.first));
+    lm->set_loc(p.second.first / p.second.second);
+    merged_lms[p.first] = lm;
+  }
+
+  cameras = std::make_shared<simple_camera_map>(merged_cams);
+  landmarks = std::make_shared<simple_landmark_map>(merged_lms);
+}
+
 // ----------------------------------------------------------------------------
 // Constructor
 hierarchical_bundle_adjust
@@ -140,6 +367,20 @@ ::get_configuration() const
                     "stages of this algorithm. Constant calculating of RMSE "
                     "may effect run time of the algorithm.");
 
+  config->set_value("partition_size", d_->partition_size,
+                    "If greater than zero, split the active cameras of each "
+                    "level into partitions of this many consecutive cameras, "
+                    "extended by partition_overlap cameras on either side, "
+                    "and bundle adjust the partitions in parallel.  The "
+                    "partitions are aligned with the input cameras and "
+                    "merged.  This bounds the size of each solve.  When "
+                    "zero, each level is a single solve.");
+
+  config->set_value("partition_overlap", d_->partition_overlap,
+                    "Number of cameras of each neighboring partition which "
+                    "are also optimized in a partition, which ties the "
+                    "landmarks of neighboring partitions together.");
+
   vital::algo::bundle_adjust::get_nested_algo_configuration(
       "sba_impl", config, d_->sba
       );
@@ -162,6 +403,8 @@ ::set_configuration(vital::config_block_sptr config)
   d_->initial_sub_sample = config->get_value<unsigned int>("initial_sub_sample", d_->initial_sub_sample);
   d_->interpolation_rate = config->get_value<unsigned int>("interpolation_rate", d_->interpolation_rate);
   d_->rmse_reporting_enabled = config->get_value<bool>("enable_rmse_reporting", d_->rmse_reporting_enabled);
+  d_->partition_size = config->get_value<unsigned int>("partition_size", d_->partition_size);
+  d_->partition_overlap = config->get_value<unsigned int>("partition_overlap", d_->partition_overlap);
 
   vital::algo::bundle_adjust::set_nested_algo_configuration(
       "sba_impl", config, d_->sba
@@ -291,7 +534,15 @@ ::optimize(camera_map_sptr & cameras,
     // updated active_cam_map and landmarks
     { // scope block
       kwiver::vital::scoped_cpu_timer t( "inner-SBA iteration" );
-      d_->sba->optimize(active_cam_map, landmarks, tracks, constraints);
+      if (d_->partition_size > 0)
+      {
+        d_->optimize_partitioned(active_cam_map, landmarks, tracks,
+                                 constraints, logger());
+      }
+      else
+      {
+        d_->sba->optimize(active_cam_map, landmarks, tracks, constraints);
+      }
     }
 
     double rmse = reprojection_rmse(active_cam_map->cameras(),
@@ -323,7 +574,7 @@ ::optimize(camera_map_sptr & cameras,
       double f;
       frame_id_t i2;
       frame_id_t cur_frm, next_frm;
-      camera_perspective_sptr cur_cam, next_cam;
+      std::vector<frame_id_t> interp_frames;
 
       // Iterate through frames and cameras, interpolating across gaps when found
       // ASSUMING even interpolation for now
@@ -333,14 +584,12 @@ ::optimize(camera_map_sptr & cameras,
         while (it != ac_map.end())
         {
           cur_frm = it->first;
-          cur_cam = std::dynamic_pointer_cast<camera_perspective>(it->second);
           ++it;
 
           // If we're not at the end of the active camera sequence
           if (it != ac_map.end())
           {
             next_frm = it->first;
-            next_cam = std::dynamic_pointer_cast<camera_perspective>(it->second);
 
             // this specific gap's interpolation rate -- gap may be smaller than ir
             ir_l = std::min(ir, next_frm - cur_frm - 1);
@@ -357,14 +606,14 @@ ::optimize(camera_map_sptr & cameras,
               // aproximate interpolation snapped to nearest integer
               i2 = int_interp(cur_frm, next_frm, f);
 
-              // fraction position of interpoated integer
-              f = static_cast<double>(i2 - cur_frm) / (next_frm - cur_frm);
-
-              interped_cams[i2] = interpolate_camera(cur_cam, next_cam, f);
+              interp_frames.push_back(i2);
             }
 
           }
         }
+
+        // interpolate all the new cameras in one batch
+        interped_cams = interpolate_cameras(ac_map, interp_frames);
       }
       if(interped_cams.empty())
       {
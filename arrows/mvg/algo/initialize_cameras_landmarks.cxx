@@ -9,10 +9,12 @@
 
 #include "initialize_cameras_landmarks.h"
 
+#include <algorithm>
 #include <random>
 #include <unordered_map>
 #include <deque>
 #include <iterator>
+#include <mutex>
 #include <Eigen/StdVector>
 #include <fstream>
 #include <ctime>
@@ -20,6 +22,8 @@
 #include <vital/exceptions.h>
 #include <vital/io/eigen_io.h>
 #include <vital/math_constants.h>
+#include <vital/types/dense_camera_perspective_map.h>
+#include <vital/util/thread_pool.h>
 #include <vital/vital_config.h>
 
 #include <vital/algo/bundle_adjust.h>
@@ -343,6 +347,13 @@ class initialize_cameras_landmarks::priv
     const std::set<frame_id_t> &already_bundled_cams,
     const std::set<frame_id_t> &frames_since_last_local_ba);
 
+  void sliding_window_bundle(
+    simple_camera_perspective_map_sptr cams,
+    map_landmark_t& lmks,
+    feature_track_set_sptr tracks,
+    sfm_constraints_sptr constraints,
+    std::deque<frame_id_t> &window);
+
   feature_track_set_changes_sptr
     get_feature_track_changes(
       feature_track_set_sptr tracks,
@@ -377,6 +388,10 @@ class initialize_cameras_landmarks::priv
   double m_thresh_triang_cos_ang = std::cos(deg_to_rad * 2.0);
   vital::algo::estimate_pnp_sptr m_pnp;
   std::set<rel_pose> m_rel_poses;
+
+  // serializes use of the global bundle adjuster by the relative poses
+  // computed in parallel; mutable since calc_rel_pose is const
+  mutable std::mutex m_bundle_adjuster_mutex;
   std::set<frame_id_t> m_keyframes;
   Eigen::SparseMatrix<unsigned int> m_kf_match_matrix;
   std::set<frame_id_t> m_frames_removed_from_sfm_solution;
@@ -395,6 +410,7 @@ class initialize_cameras_landmarks::priv
   bool m_config_defines_base_intrinsics = false;
   bool m_do_final_sfm_cleaning = false;
   bool m_force_common_intrinsics = true;
+  unsigned m_streaming_window_size = 0;
   std::set<landmark_id_t> m_already_merged_landmarks;
 };
 
@@ -927,8 +943,9 @@ ::calc_rel_pose(frame_id_t frame_0, frame_id_t frame_1,
   while (inlier_lm_ids.size() > inlier_count_prev)
   {
     inlier_count_prev = inlier_lm_ids.size();
-#pragma omp critical
     {
+      // the bundle adjuster is shared by the pairs computed in parallel
+      std::lock_guard<std::mutex> lock(m_bundle_adjuster_mutex);
       std::set<frame_id_t> empty_fixed_cams;
       std::set<landmark_id_t> empty_fixed_lms;
       global_bundle_adjuster->optimize(*cam_map, lms, trk_set,
@@ -1059,30 +1076,36 @@ ::calc_rel_poses(
       }
     }
 
-#pragma omp parallel for schedule(dynamic, 10)
-    for (int64_t i = 0; i < static_cast<int64_t>(pairs_to_process.size()); ++i)
-    {
-      const auto &tp = pairs_to_process[i];
-      auto fid_0 = tp.first;
-      auto fid_1 = tp.second;
-      auto tks0 = tracks->active_tracks(fid_0);
-      auto tks1 = tracks->active_tracks(fid_1);
-      std::sort(tks0.begin(), tks0.end());
-      std::sort(tks1.begin(), tks1.end());
-      std::vector<kwiver::vital::track_sptr> tks_01;
-      std::set_intersection(tks0.begin(), tks0.end(),
-                            tks1.begin(), tks1.end(),
-                            std::back_inserter(tks_01));
-
-      // ok now we have the common tracks between the two frames.
-      // make the essential matrix, decompose it and store it in a relative pose
-      rel_pose rp = calc_rel_pose(fid_0, fid_1, tks_01);
-#pragma omp critical
+    // each pair writes only its own slot; the poses are kept afterwards
+    std::vector<rel_pose> pair_poses(pairs_to_process.size());
+    vital::thread_pool::instance().parallel_for(pairs_to_process.size(), 1,
+      [&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; ++i)
       {
-        if (rp.well_conditioned_landmark_count > m_min_frame_to_frame_matches)
-        {
-          m_rel_poses.insert(rp);
-        }
+        const auto &tp = pairs_to_process[i];
+        auto fid_0 = tp.first;
+        auto fid_1 = tp.second;
+        auto tks0 = tracks->active_tracks(fid_0);
+        auto tks1 = tracks->active_tracks(fid_1);
+        std::sort(tks0.begin(), tks0.end());
+        std::sort(tks1.begin(), tks1.end());
+        std::vector<kwiver::vital::track_sptr> tks_01;
+        std::set_intersection(tks0.begin(), tks0.end(),
+                              tks1.begin(), tks1.end(),
+                              std::back_inserter(tks_01));
+
+        // ok now we have the common tracks between the two frames.
+        // make the essential matrix, decompose it and store it in a relative pose
+        pair_poses[i] = calc_rel_pose(fid_0, fid_1, tks_01);
+      }
+    });
+
+    for (auto const& rp : pair_poses)
+    {
+      if (rp.well_conditioned_landmark_count > m_min_frame_to_frame_matches)
+      {
+        m_rel_poses.insert(rp);
       }
     }
 
@@ -3020,6 +3043,9 @@ ::initialize_next_camera(
 
     while (bundled_inlier_count > prev_bundled_inlier_count)
     {
+      // keep the cameras from before this step, to undo it if it loses inliers
+      dense_camera_perspective_map const before_step(*cams);
+
       // DOES THIS LOOP HELP?
       bundle_adjuster->optimize(*cams, cur_landmarks_rand_sub, tracks,
                                 already_registred_cams, cur_frame_landmarks,
@@ -3030,6 +3056,14 @@ ::initialize_next_camera(
       bundled_inlier_count = set_inlier_flags(fid_to_register, bundled_cam,
                                               cur_landmarks, tracks, 50);
       ++loop_count;
+
+      if (bundled_inlier_count < prev_bundled_inlier_count)
+      {
+        cams->set_from_base_camera_map(before_step.cameras());
+        bundled_cam = cams->find(fid_to_register);
+        bundled_inlier_count = set_inlier_flags(fid_to_register, bundled_cam,
+                                                cur_landmarks, tracks, 50);
+      }
     }
     if (loop_count > 2)
     {
@@ -3053,6 +3087,7 @@ ::initialize_next_camera(
         int loop_count = 0;
         while (resection_inlier_count > prev_resection_inlier_count)
         {
+          dense_camera_perspective_map const before_step(*cams);
           bundle_adjuster->optimize(*cams, cur_landmarks, tracks,
                                     already_registred_cams,
                                     cur_frame_landmarks,
@@ -3063,6 +3098,15 @@ ::initialize_next_camera(
             set_inlier_flags(fid_to_register, resectioned_cam,
                              cur_landmarks, tracks, 50);
           ++loop_count;
+
+          if (resection_inlier_count < prev_resection_inlier_count)
+          {
+            cams->set_from_base_camera_map(before_step.cameras());
+            resectioned_cam = cams->find(fid_to_register);
+            resection_inlier_count =
+              set_inlier_flags(fid_to_register, resectioned_cam,
+                               cur_landmarks, tracks, 50);
+          }
         }
         if (loop_count > 2)
         {
@@ -3168,6 +3212,101 @@ ::windowed_clean_and_bundle(
   landmarks = store_landmarks(lmks, variable_landmarks);
 }
 
+void
+initialize_cameras_landmarks::priv
+::sliding_window_bundle(
+  simple_camera_perspective_map_sptr cams,
+  map_landmark_t& lmks,
+  feature_track_set_sptr tracks,
+  sfm_constraints_sptr constraints,
+  std::deque<frame_id_t> &window)
+{
+  // cameras leaving the window are no longer optimized
+  while (window.size() > m_streaming_window_size)
+  {
+    window.pop_front();
+  }
+  std::set<frame_id_t> window_frames(window.begin(), window.end());
+
+  auto variable_landmark_ids =
+    find_visible_landmarks_in_frames(lmks, tracks, window_frames);
+  auto variable_landmarks = get_sub_landmark_map(lmks, variable_landmark_ids);
+
+  // Older cameras which see the window's landmarks anchor it with fixed
+  // poses.  Only the most recent of them are kept so the size of the problem
+  // does not grow with the length of the sequence.
+  std::set<frame_id_t> anchor_candidates;
+  for (auto const& lm : variable_landmarks)
+  {
+    auto t = tracks->get_track(lm.first);
+    if (!t)
+    {
+      continue;
+    }
+    for (auto ts : *t)
+    {
+      if (window_frames.find(ts->frame()) == window_frames.end() &&
+          cams->find(ts->frame()))
+      {
+        anchor_candidates.insert(ts->frame());
+      }
+    }
+  }
+  std::set<frame_id_t> anchor_frames;
+  for (auto it = anchor_candidates.rbegin();
+       it != anchor_candidates.rend() &&
+       anchor_frames.size() < m_streaming_window_size; ++it)
+  {
+    anchor_frames.insert(*it);
+  }
+
+  simple_camera_perspective_map window_cams;
+  for (auto fid : window_frames)
+  {
+    if (auto cam = cams->find(fid))
+    {
+      window_cams.insert(fid, cam);
+    }
+  }
+  for (auto fid : anchor_frames)
+  {
+    window_cams.insert(fid, cams->find(fid));
+  }
+
+  std::set<landmark_id_t> empty_landmark_id_set;
+  LOG_DEBUG(m_logger, "Bundle adjusting a window of " << window_frames.size()
+                      << " cameras (" << anchor_frames.size()
+                      << " fixed anchors) and "
+                      << variable_landmarks.size() << " landmarks");
+  bundle_adjuster->optimize(window_cams, variable_landmarks, tracks,
+                            anchor_frames, empty_landmark_id_set,
+                            constraints);
+  for (auto const& lm : variable_landmarks)
+  {
+    lmks[lm.first] = lm.second;
+  }
+
+  std::vector<frame_id_t> removed_cams;
+  clean_cameras_and_landmarks(window_cams, lmks, tracks,
+                              m_thresh_triang_cos_ang, removed_cams,
+                              window_frames,
+                              variable_landmark_ids,
+                              image_coverage_threshold,
+                              interim_reproj_thresh);
+
+  for (auto rem_fid : removed_cams)
+  {
+    cams->erase(rem_fid);
+    window.erase(std::remove(window.begin(), window.end(), rem_fid),
+                 window.end());
+    m_frames_removed_from_sfm_solution.insert(rem_fid);
+  }
+  for (auto const& cam : window_cams.T_cameras())
+  {
+    cams->insert(cam.first, cam.second);
+  }
+}
+
 std::set<uint32_t> hash_point(vector_3d const& X_min,
                               vector_3d const& X,
                               double volume_unit_size)
@@ -3497,7 +3636,8 @@ ::initialize_remaining_cameras(
                        all_frames_to_register,
                        keyframes_to_register;
 
-  bool done_registering_keyframes = false;
+  // with no keyframes, as when resuming a stream, go straight to all frames
+  bool done_registering_keyframes = m_keyframes.empty();
   size_t num_frames_to_register = std::numeric_limits<size_t>::max();
 
   std::set<frame_id_t> frames_since_last_local_ba;
@@ -3508,11 +3648,26 @@ ::initialize_remaining_cameras(
     frames_since_last_local_ba.insert(fid);
   }
 
+  // In streaming mode only a window of the most recently registered cameras
+  // is bundle adjusted after each new camera, starting with the newest of
+  // the existing cameras.
+  bool const streaming = m_streaming_window_size > 0;
+  std::deque<frame_id_t> streaming_window;
+  if (streaming)
+  {
+    for (auto it = existing_fids.rbegin();
+         it != existing_fids.rend() &&
+         streaming_window.size() < m_streaming_window_size; ++it)
+    {
+      streaming_window.push_front(*it);
+    }
+  }
+
   m_frames_removed_from_sfm_solution.clear();
 
   int max_constraints_used = 0;
 
-  bool disable_windowing = true;
+  bool disable_windowing = !done_registering_keyframes;
 
   int frames_since_last_ba = 0;
 
@@ -3625,56 +3780,65 @@ ::initialize_remaining_cameras(
 
     frames_since_last_local_ba.insert(fid_to_register);
 
-    auto reporj_by_cam = reprojection_rmse_by_cam(cams->cameras(),
-                                                  lmks, tracks->tracks());
-
-    double rebundle_thresh = final_reproj_thresh * 4.0;
-    bool bundle_because_of_reproj = false;
-    int num_cams_over_thresh = 0;
-    for (auto& cd : reporj_by_cam)
+    if (streaming)
+    {
+      streaming_window.push_back(fid_to_register);
+      sliding_window_bundle(cams, lmks, tracks, constraints_to_ba,
+                            streaming_window);
+    }
+    else
     {
-      if (cd.second > rebundle_thresh)
+      auto reporj_by_cam = reprojection_rmse_by_cam(cams->cameras(),
+                                                    lmks, tracks->tracks());
+
+      double rebundle_thresh = final_reproj_thresh * 4.0;
+      bool bundle_because_of_reproj = false;
+      int num_cams_over_thresh = 0;
+      for (auto& cd : reporj_by_cam)
       {
-        auto last_it = last_reproj_by_cam.find(cd.first);
-        if (last_it != last_reproj_by_cam.end())
+        if (cd.second > rebundle_thresh)
         {
-          if (last_it->second > rebundle_thresh)
+          auto last_it = last_reproj_by_cam.find(cd.first);
+          if (last_it != last_reproj_by_cam.end())
           {
-            // ignore this one, it didn't get better with bundling.
-            continue;
+            if (last_it->second > rebundle_thresh)
+            {
+              // ignore this one, it didn't get better with bundling.
+              continue;
+            }
+          }
+          ++num_cams_over_thresh;
+          if (num_cams_over_thresh >= 10)
+          {
+            bundle_because_of_reproj = true;
+            break;
           }
-        }
-        ++num_cams_over_thresh;
-        if (num_cams_over_thresh >= 10)
-        {
-          bundle_because_of_reproj = true;
-          break;
         }
       }
-    }
-
-    ++frames_since_last_ba;
-    if (bundle_because_of_reproj ||
-        frames_to_register.empty() ||
-        frames_since_last_ba > 50)
-    {
-      frames_since_last_ba = 0;
-      windowed_clean_and_bundle(cams, landmarks, lmks, tracks,
-                                constraints_to_ba,
-                                windowed_bundled_cams,
-                                frames_since_last_local_ba);
 
-      if (!disable_windowing)
+      ++frames_since_last_ba;
+      if (bundle_because_of_reproj ||
+          frames_to_register.empty() ||
+          frames_since_last_ba > 50)
       {
-        for (auto ll_fid : frames_since_last_local_ba)
+        frames_since_last_ba = 0;
+        windowed_clean_and_bundle(cams, landmarks, lmks, tracks,
+                                  constraints_to_ba,
+                                  windowed_bundled_cams,
+                                  frames_since_last_local_ba);
+
+        if (!disable_windowing)
         {
-          windowed_bundled_cams.insert(ll_fid);
+          for (auto ll_fid : frames_since_last_local_ba)
+          {
+            windowed_bundled_cams.insert(ll_fid);
+          }
+          frames_since_last_local_ba.clear();
         }
-        frames_since_last_local_ba.clear();
-      }
 
-      last_reproj_by_cam = reprojection_rmse_by_cam(cams->cameras(),
-                                                    lmks, tracks->tracks());
+        last_reproj_by_cam = reprojection_rmse_by_cam(cams->cameras(),
+                                                      lmks, tracks->tracks());
+      }
     }
 
     already_registred_cams.insert(fid_to_register);
@@ -3859,6 +4023,17 @@ ::get_configuration() const
                     m_priv->m_do_final_sfm_cleaning,
                     "run a final sfm solution cleanup when solution is complete");
 
+  config->set_value("streaming_window_size",
+                    m_priv->m_streaming_window_size,
+                    "If greater than zero, register cameras incrementally for "
+                    "streaming video.  After each new camera only this many "
+                    "of the most recently registered cameras are bundle "
+                    "adjusted, anchored by as many older cameras held fixed, "
+                    "so the cost per frame does not grow with the length of "
+                    "the sequence.  A call given existing cameras and "
+                    "landmarks extends that solution instead of starting "
+                    "over.  Zero processes the whole track set in batch.");
+
   double r1 = 0;
   double r2 = 0;
   double r3 = 0;
@@ -3987,6 +4162,10 @@ ::set_configuration(vital::config_block_sptr config)
     config->get_value<bool>("do_final_sfm_cleaning",
                             m_priv->m_do_final_sfm_cleaning);
 
+  m_priv->m_streaming_window_size =
+    config->get_value<unsigned>("streaming_window_size",
+                                m_priv->m_streaming_window_size);
+
   vital::config_block_sptr bc = config->subblock("base_camera");
 
   m_priv->m_config_defines_base_intrinsics =
@@ -4077,17 +4256,29 @@ ::initialize(camera_map_sptr& cameras,
     tracks->remove(tk);
   }
 
+  // In streaming mode an existing solution is extended with the new frames
+  bool const resume_stream = m_priv->m_streaming_window_size > 0 &&
+                             cameras && cameras->size() > 0 &&
+                             landmarks && landmarks->size() > 0;
+
   // Compute keyframes to use for SFM
-  auto all_frames = tracks->all_frame_ids();
   auto const max_keyframes = m_priv->m_max_cams_in_keyframe_init;
-  if (max_keyframes < 0 ||
-      all_frames.size() <= static_cast<size_t>(max_keyframes))
+  if (resume_stream)
   {
-    m_priv->m_keyframes = std::move(all_frames);
+    m_priv->m_keyframes.clear();
   }
   else
   {
-    m_priv->m_keyframes = keyframes_for_sfm(tracks);
+    auto all_frames = tracks->all_frame_ids();
+    if (max_keyframes < 0 ||
+        all_frames.size() <= static_cast<size_t>(max_keyframes))
+    {
+      m_priv->m_keyframes = std::move(all_frames);
+    }
+    else
+    {
+      m_priv->m_keyframes = keyframes_for_sfm(tracks);
+    }
   }
 
   m_priv->m_already_merged_landmarks.clear();
@@ -4099,15 +4290,18 @@ ::initialize(camera_map_sptr& cameras,
     cams->set_from_base_cams(cameras);
   }
 
-  if (m_priv->m_init_intrinsics_from_metadata)
+  if (!resume_stream)
   {
-    m_priv->init_base_camera_from_metadata(constraints);
-  }
+    if (m_priv->m_init_intrinsics_from_metadata)
+    {
+      m_priv->init_base_camera_from_metadata(constraints);
+    }
 
-  if (!m_priv->initialize_keyframes(cams, landmarks, tracks,
-                                    constraints, this->m_callback))
-  {
-    return;
+    if (!m_priv->initialize_keyframes(cams, landmarks, tracks,
+                                      constraints, this->m_callback))
+    {
+      return;
+    }
   }
 
   if (cams->size() == 0 ||
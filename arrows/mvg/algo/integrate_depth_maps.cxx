@@ -9,7 +9,9 @@
 
 #include <arrows/mvg/algo/integrate_depth_maps.h>
 #include <arrows/core/depth_utils.h>
+#include <arrows/core/sparse_volume.h>
 
+#include <vital/util/thread_pool.h>
 #include <vital/util/transform_image.h>
 
 #include <sstream>
@@ -33,12 +35,27 @@ class integrate_depth_maps::priv
       ray_potential_delta(10.0),
       grid_spacing {1.0, 1.0, 1.0},
       voxel_spacing_factor(1.0),
+      brick_size(8),
       m_logger(vital::get_logger("arrows.mvg.integrate_depth_maps"))
   {
   }
 
+  // compute the voxel spacing and grid dimensions and the constants of the
+  // ray potential for a bounding region
+  void setup(vector_3d const& minpt_bound,
+             vector_3d const& maxpt_bound,
+             std::vector<camera_perspective_sptr> const& cameras,
+             vector_3d& spacing);
+
+  // get the weight map to use with depth map i, or an empty image
+  image_of<double> weight_map(
+    std::vector<image_container_sptr> const& depth_maps,
+    std::vector<image_container_sptr> const& weight_maps,
+    size_t i) const;
+
   // integrate a depth image into the integration volume
-  void integrate_depth_map(image_of<double>& volume,
+  template <typename Volume>
+  void integrate_depth_map(Volume& volume,
                            camera_perspective const& camera,
                            image_of<double> const& depth,
                            image_of<double> const& weight,
@@ -84,6 +101,9 @@ class integrate_depth_maps::priv
   // multiplier on all dimensions of grid spacing
   double voxel_spacing_factor;
 
+  // number of voxels along each side of a brick of a sparse volume
+  unsigned brick_size;
+
   double const_thickness;
   double const_delta;
   double const_slope;
@@ -107,7 +127,7 @@ accumulate_projections(image_of<double>& volume,
 {
   auto const ni = volume.width();
   auto const nj = volume.height();
-  auto const nk = static_cast<int64_t>(volume.depth());
+  auto const nk = volume.depth();
 
   // origin offset by half a step to center voxels
   vector_3d offset = origin + 0.5 * spacing;
@@ -117,19 +137,73 @@ accumulate_projections(image_of<double>& volume,
   vector_3d const y_step = spacing[1] * camera.col(1);
   vector_3d const z_step = spacing[2] * camera.col(2);
 
-#pragma omp parallel for
-  for (int64_t k = 0; k < nk; ++k)
+  vital::thread_pool::instance().parallel_for(nk, 1,
+    [&](size_t begin, size_t end)
   {
-    vector_3d homog_pt_y = k * z_step + homog_pt_base;
-    for (size_t j = 0; j < nj; ++j, homog_pt_y += y_step)
+    for (size_t k = begin; k < end; ++k)
     {
-      vector_3d homog_pt = homog_pt_y;
-      for (size_t i = 0; i < ni; ++i, homog_pt += x_step)
+      vector_3d homog_pt_y = static_cast<double>(k) * z_step + homog_pt_base;
+      for (size_t j = 0; j < nj; ++j, homog_pt_y += y_step)
       {
-        volume(i, j, k) += accum_func(homog_pt);
+        vector_3d homog_pt = homog_pt_y;
+        for (size_t i = 0; i < ni; ++i, homog_pt += x_step)
+        {
+          volume(i, j, k) += accum_func(homog_pt);
+        }
       }
     }
-  }
+  });
+}
+
+// ----------------------------------------------------------------------------
+
+// integrate a depth image into the allocated bricks of a sparse volume
+template <typename OP>
+void
+accumulate_projections(core::sparse_volume& volume,
+                       vector_3d const& origin,
+                       vector_3d const& spacing,
+                       matrix_3x4d const& camera,
+                       OP&& accum_func)
+{
+  auto const nb = volume.num_bricks();
+  size_t const bs = volume.brick_size();
+
+  // origin offset by half a step to center voxels
+  vector_3d offset = origin + 0.5 * spacing;
+  vector_3d homog_pt_base = camera.leftCols<3>() * offset + camera.col(3);
+
+  vector_3d const x_step = spacing[0] * camera.col(0);
+  vector_3d const y_step = spacing[1] * camera.col(1);
+  vector_3d const z_step = spacing[2] * camera.col(2);
+
+  vital::thread_pool::instance().parallel_for(nb, 1,
+    [&](size_t begin, size_t end)
+  {
+    for (size_t b = begin; b < end; ++b)
+    {
+      auto const& o = volume.brick_origin(b);
+      auto const ni = std::min(bs, volume.width() - o[0]);
+      auto const nj = std::min(bs, volume.height() - o[1]);
+      auto const nk = std::min(bs, volume.depth() - o[2]);
+      double* voxel = volume.brick_data(b);
+      vector_3d const homog_pt_brick = homog_pt_base + static_cast<double>(o[0]) * x_step +
+                                       static_cast<double>(o[1]) * y_step;
+      for (size_t k = 0; k < nk; ++k)
+      {
+        vector_3d homog_pt_y = static_cast<double>(o[2] + k) * z_step + homog_pt_brick;
+        for (size_t j = 0; j < nj; ++j, homog_pt_y += y_step)
+        {
+          double* row = voxel + (k * bs + j) * bs;
+          vector_3d homog_pt = homog_pt_y;
+          for (size_t i = 0; i < ni; ++i, homog_pt += x_step)
+          {
+            row[i] += accum_func(homog_pt);
+          }
+        }
+      }
+    }
+  });
 }
 
 // ----------------------------------------------------------------------------
@@ -185,9 +259,10 @@ ::ray_potiential_at_point(vector_2d const& image_pt,
 // ----------------------------------------------------------------------------
 
 // integrate a depth image into the integration volume
+template <typename Volume>
 void
 integrate_depth_maps::priv
-::integrate_depth_map(image_of<double>& volume,
+::integrate_depth_map(Volume& volume,
                       camera_perspective const& camera,
                       image_of<double> const& depth,
                       image_of<double> const& weight,
@@ -310,6 +385,9 @@ integrate_depth_maps::get_configuration() const
   config->set_value("voxel_spacing_factor", d_->voxel_spacing_factor,
                     "Multiplier on voxel spacing.  Set to 1.0 for voxel "
                     "sizes that project to 1 pixel on average.");
+  config->set_value("brick_size", d_->brick_size,
+                    "Number of voxels along each side of the bricks in which "
+                    "a sparse volume is allocated.");
 
   std::ostringstream stream;
   stream << d_->grid_spacing[0] << " "
@@ -346,6 +424,8 @@ integrate_depth_maps::set_configuration(vital::config_block_sptr in_config)
     config->get_value<double>("ray_potential_delta", d_->ray_potential_delta);
   d_->voxel_spacing_factor =
     config->get_value<double>("voxel_spacing_factor", d_->voxel_spacing_factor);
+  d_->brick_size =
+    config->get_value<unsigned>("brick_size", d_->brick_size);
 
   std::ostringstream ostream;
   ostream << d_->grid_spacing[0] << " "
@@ -369,14 +449,11 @@ integrate_depth_maps::check_configuration(vital::config_block_sptr) const
 // ----------------------------------------------------------------------------
 
 void
-integrate_depth_maps::integrate(
-  vector_3d const& minpt_bound,
-  vector_3d const& maxpt_bound,
-  std::vector<image_container_sptr> const& depth_maps,
-  std::vector<image_container_sptr> const& weight_maps,
-  std::vector<camera_perspective_sptr> const& cameras,
-  image_container_sptr& volume,
-  vector_3d &spacing) const
+integrate_depth_maps::priv
+::setup(vector_3d const& minpt_bound,
+        vector_3d const& maxpt_bound,
+        std::vector<camera_perspective_sptr> const& cameras,
+        vector_3d& spacing)
 {
   double pixel_to_world_scale;
   pixel_to_world_scale =
@@ -384,30 +461,65 @@ integrate_depth_maps::integrate(
       compute_pixel_to_world_scale(minpt_bound, maxpt_bound, cameras);
 
   vector_3d diff = maxpt_bound - minpt_bound;
-  vector_3d orig = minpt_bound;
 
-  spacing = vector_3d(d_->grid_spacing);
-  spacing *= pixel_to_world_scale * d_->voxel_spacing_factor;
+  spacing = vector_3d(grid_spacing);
+  spacing *= pixel_to_world_scale * voxel_spacing_factor;
   double max_spacing = spacing.maxCoeff();
 
   // precompute constants to make ray potential computation more efficient
-  d_->const_delta = d_->ray_potential_delta * max_spacing;
-  d_->const_thickness = d_->ray_potential_thickness * max_spacing;
-  d_->const_slope = d_->ray_potential_rho / d_->const_thickness;
-  d_->const_freespace_val = -d_->ray_potential_eta * d_->ray_potential_rho;
-  d_->const_occluded_val = d_->ray_potential_epsilon * d_->ray_potential_rho;
+  const_delta = ray_potential_delta * max_spacing;
+  const_thickness = ray_potential_thickness * max_spacing;
+  const_slope = ray_potential_rho / const_thickness;
+  const_freespace_val = -ray_potential_eta * ray_potential_rho;
+  const_occluded_val = ray_potential_epsilon * ray_potential_rho;
 
   for (int i = 0; i < 3; i++)
   {
-    d_->grid_dims[i] = static_cast<int>((diff[i] / spacing[i]));
+    grid_dims[i] = static_cast<int>((diff[i] / spacing[i]));
   }
 
-  LOG_DEBUG( logger(), "voxel size: " << spacing[0]
+  LOG_DEBUG( m_logger, "voxel size: " << spacing[0]
                        << " "         << spacing[1]
                        << " "         << spacing[2] );
-  LOG_DEBUG( logger(), "grid: " << d_->grid_dims[0]
-                       << " "   << d_->grid_dims[1]
-                       << " "   << d_->grid_dims[2] );
+  LOG_DEBUG( m_logger, "grid: " << grid_dims[0]
+                       << " "   << grid_dims[1]
+                       << " "   << grid_dims[2] );
+}
+
+// ----------------------------------------------------------------------------
+
+image_of<double>
+integrate_depth_maps::priv
+::weight_map(std::vector<image_container_sptr> const& depth_maps,
+             std::vector<image_container_sptr> const& weight_maps,
+             size_t i) const
+{
+  if (i < weight_maps.size())
+  {
+    auto const& w = weight_maps[i];
+    if (w->width() == depth_maps[i]->width() &&
+        w->height() == depth_maps[i]->height())
+    {
+      return image_of<double>{ w->get_image() };
+    }
+  }
+  return {};
+}
+
+// ----------------------------------------------------------------------------
+
+void
+integrate_depth_maps::integrate(
+  vector_3d const& minpt_bound,
+  vector_3d const& maxpt_bound,
+  std::vector<image_container_sptr> const& depth_maps,
+  std::vector<image_container_sptr> const& weight_maps,
+  std::vector<camera_perspective_sptr> const& cameras,
+  image_container_sptr& volume,
+  vector_3d &spacing) const
+{
+  d_->setup(minpt_bound, maxpt_bound, cameras, spacing);
+  vector_3d orig = minpt_bound;
 
   LOG_INFO( logger(), "initialize volume" );
   image_of<double> voxel_grid;
@@ -425,16 +537,7 @@ integrate_depth_maps::integrate(
   for (size_t i = 0; i < depth_maps.size(); ++i)
   {
     image_of<double> depth{ depth_maps[i]->get_image() };
-    image_of<double> weight;
-    if (i < weight_maps.size())
-    {
-      auto const& w = weight_maps[i];
-      if (w->width() == depth.width() &&
-          w->height() == depth.height())
-      {
-        weight = weight_maps[i]->get_image();
-      }
-    }
+    image_of<double> weight = d_->weight_map(depth_maps, weight_maps, i);
     if (i >= cameras.size() || !cameras[i])
     {
       continue;
@@ -449,6 +552,54 @@ integrate_depth_maps::integrate(
   volume = std::make_shared<simple_image_container>(voxel_grid);
 }
 
+// ----------------------------------------------------------------------------
+
+void
+integrate_depth_maps::integrate_sparse(
+  vector_3d const& minpt_bound,
+  vector_3d const& maxpt_bound,
+  std::vector<image_container_sptr> const& depth_maps,
+  std::vector<image_container_sptr> const& weight_maps,
+  std::vector<camera_perspective_sptr> const& cameras,
+  core::sparse_volume& volume,
+  vector_3d &spacing) const
+{
+  d_->setup(minpt_bound, maxpt_bound, cameras, spacing);
+  vector_3d orig = minpt_bound;
+  volume.reset(d_->grid_dims[0], d_->grid_dims[1], d_->grid_dims[2],
+               d_->brick_size);
+
+  // allocate the bricks near every surface before integrating any depth map
+  // so that each brick receives the contributions of all of them
+  auto const num_maps = std::min(depth_maps.size(), cameras.size());
+  for (size_t i = 0; i < num_maps; ++i)
+  {
+    if (cameras[i])
+    {
+      image_of<double> depth{ depth_maps[i]->get_image() };
+      image_of<double> weight = d_->weight_map(depth_maps, weight_maps, i);
+      core::allocate_surface_bricks(volume, *cameras[i], depth, weight,
+                                    orig, spacing, d_->const_delta);
+    }
+  }
+  LOG_INFO( logger(), "allocated " << volume.num_bricks() << " bricks of "
+                      << volume.brick_voxels() << " voxels" );
+
+  for (size_t i = 0; i < num_maps; ++i)
+  {
+    if (!cameras[i])
+    {
+      continue;
+    }
+
+    image_of<double> depth{ depth_maps[i]->get_image() };
+    image_of<double> weight = d_->weight_map(depth_maps, weight_maps, i);
+    LOG_INFO( logger(), "depth map " << i );
+    d_->integrate_depth_map(volume, *cameras[i], depth, weight,
+                            orig, spacing);
+  }
+}
+
 } // end namespace mvg
 } // end namespace arrows
 } // end namespace kwiver
@@ -18,6 +18,11 @@
 
 namespace kwiver {
 namespace arrows {
+
+namespace core {
+class sparse_volume;
+}
+
 namespace mvg {
 
 class KWIVER_ALGO_MVG_EXPORT integrate_depth_maps
@@ -65,6 +70,30 @@ class KWIVER_ALGO_MVG_EXPORT integrate_depth_maps
               kwiver::vital::image_container_sptr& volume,
               kwiver::vital::vector_3d &spacing) const;
 
+  /// Integrate multiple depth maps with per-pixel weights into a sparse volume
+  ///
+  /// The volume is the same as integrate() computes, except that only the
+  /// bricks of voxels within ray_potential_delta of a depth in some depth map
+  /// are allocated.  Each allocated voxel has the value integrate() would give
+  /// it, but memory scales with the area of the observed surface rather than
+  /// with the volume of the bounding region.
+  ///
+  /// \param [in]     minpt_bound the min point of the bounding region
+  /// \param [in]     maxpt_bound the max point of the bounding region
+  /// \param [in]     depth_maps  the set of floating point depth map images
+  /// \param [in]     weight_maps the set of floating point [0,1] weight maps
+  /// \param [in]     cameras     the set of cameras, one for each depth map
+  /// \param [out]    volume      the fused volumetric data
+  /// \param [out]    spacing     the spacing between voxels in each dimension
+  void
+    integrate_sparse(kwiver::vital::vector_3d const& minpt_bound,
+                     kwiver::vital::vector_3d const& maxpt_bound,
+                     std::vector<kwiver::vital::image_container_sptr> const& depth_maps,
+                     std::vector<kwiver::vital::image_container_sptr> const& weight_maps,
+                     std::vector<kwiver::vital::camera_perspective_sptr> const& cameras,
+                     core::sparse_volume& volume,
+                     kwiver::vital::vector_3d &spacing) const;
+
 private:
   /// private implementation class
   class priv;
@@ -9,14 +9,14 @@
 
 #include "triangulate_landmarks.h"
 
-#include <set>
+#include <map>
 #include <random>
-#include <ctime>
 
 #include <arrows/mvg/metrics.h>
 #include <arrows/mvg/triangulate.h>
 
 #include <vital/math_constants.h>
+#include <vital/util/thread_pool.h>
 #include <vital/vital_config.h>
 
 namespace kwiver {
@@ -48,15 +48,46 @@ class triangulate_landmarks::priv
       m_inlier_threshold_pixels_sq(other.m_inlier_threshold_pixels_sq),
       m_frac_track_inliers_to_keep_triangulated_point(
         other.m_frac_track_inliers_to_keep_triangulated_point),
-      m_max_ransac_samples(other.m_max_ransac_samples)
+      m_max_ransac_samples(other.m_max_ransac_samples),
+      m_conf_thresh(other.m_conf_thresh)
   {
   }
 
+  // Outcome of triangulating one landmark
+  enum status
+  {
+    triangulated,
+    skipped,        // fewer than two views
+    failed,
+    failed_outlier, // too few inliers
+    failed_angle    // views too close to parallel
+  };
+
+  // Views of one landmark, reused from one landmark to the next
+  struct scratch
+  {
+    std::vector<vital::simple_camera_perspective> cams;
+    std::vector<vital::simple_camera_rpc> cams_rpc;
+    std::vector<vital::vector_2d> image_pts;
+    std::vector<vital::vector_2d> image_pts_rpc;
+    std::vector<vital::feature_track_state*> features;
+    std::mt19937_64 gen;
+  };
+
   vital::vector_3d
   ransac_triangulation(const std::vector<vital::simple_camera_perspective> &lm_cams,
                        const std::vector<vital::vector_2d> &lm_image_pts,
                        int &best_inlier_count,
-                       vital::vector_3d const* guess) const;
+                       vital::vector_3d const* guess,
+                       std::mt19937_64 &gen) const;
+
+  status
+  triangulate_landmark(vital::landmark_id_t id,
+                       vital::landmark_sptr const& current,
+                       unsigned num_observations,
+                       double thresh_triang_cos_ang,
+                       scratch& s,
+                       vital::landmark_sptr& result) const;
 
   bool
   triangulate(const std::vector<vital::simple_camera_perspective> &lm_cams,
@@ -207,7 +238,8 @@ triangulate_landmarks::priv
 ::ransac_triangulation(const std::vector<vital::simple_camera_perspective> &lm_cams,
                        const std::vector<vital::vector_2d> &lm_image_pts,
                        int &best_inlier_count,
-                       vital::vector_3d const* guess) const
+                       vital::vector_3d const* guess,
+                       std::mt19937_64 &gen) const
 {
   double conf = 0;
   std::vector<vital::simple_camera_perspective> cam_sample(2);
@@ -216,12 +248,6 @@ ::ransac_triangulation(const std::vector<vital::simple_camera_perspective> &lm_c
   best_inlier_count = 0;
   double best_inlier_ratio = 0;
 
-  std::random_device rd;
-  std::mt19937_64 gen(rd());
-  std::time_t time_res = std::time(nullptr);
-  gen.seed(time_res);
-  std::uniform_int_distribution<> dis(0, int(lm_cams.size() - 1));
-
   best_pt3d.setZero();
 
   if (lm_cams.size() < 2)
@@ -230,9 +256,10 @@ ::ransac_triangulation(const std::vector<vital::simple_camera_perspective> &lm_c
     return best_pt3d;
   }
 
+  // the second view is drawn from the others, so a pair never repeats a view
+  std::uniform_int_distribution<> dis(0, int(lm_cams.size() - 1));
+  std::uniform_int_distribution<> dis_other(0, int(lm_cams.size() - 2));
   int s_idx[2];
-  vital::landmark_d lm;
-  vital::feature_d f;
 
   for (int num_samples = 1;
        num_samples <= m_max_ransac_samples && conf < m_conf_thresh;
@@ -241,10 +268,10 @@ ::ransac_triangulation(const std::vector<vital::simple_camera_perspective> &lm_c
     //pick two random points
     int inlier_count = 0;
     s_idx[0] = dis(gen);
-    s_idx[1] = s_idx[0];
-    while (s_idx[0] == s_idx[1])
+    s_idx[1] = dis_other(gen);
+    if (s_idx[1] >= s_idx[0])
     {
-      s_idx[1] = dis(gen);
+      ++s_idx[1];
     }
 
     cam_sample[0] = lm_cams[s_idx[0]];
@@ -265,17 +292,16 @@ ::ransac_triangulation(const std::vector<vital::simple_camera_perspective> &lm_c
       }
     }
 
-    lm.set_loc(pt3d);
     //count inliers
     for (unsigned int idx = 0; idx < lm_cams.size(); ++idx)
     {
-      auto depth = lm_cams[idx].depth(lm.loc());
+      auto depth = lm_cams[idx].depth(pt3d);
       if (depth <= 0)
       {
         continue;
       }
-      f.set_loc(lm_image_pts[idx]);
-      double reproj_err_sq = reprojection_error_sqr(lm_cams[idx], lm, f);
+      double reproj_err_sq =
+        (lm_cams[idx].project(pt3d) - lm_image_pts[idx]).squaredNorm();
       if (reproj_err_sq < m_inlier_threshold_pixels_sq)
       {
         ++inlier_count;
@@ -289,7 +315,8 @@ ::ransac_triangulation(const std::vector<vital::simple_camera_perspective> &lm_c
       best_inlier_ratio = (double)best_inlier_count / (double)lm_cams.size();
     }
 
-    conf = 1.0 - pow(1.0 - pow(best_inlier_ratio, 2.0), double(num_samples));
+    conf = 1.0 - pow(1.0 - best_inlier_ratio * best_inlier_ratio,
+                     double(num_samples));
     if (lm_cams.size() == 2)
     {
       break;  //2 choose 2 only happens one way
@@ -299,6 +326,127 @@ ::ransac_triangulation(const std::vector<vital::simple_camera_perspective> &lm_c
   return best_pt3d;
 }
 
+/// Triangulate one landmark from the views gathered for it
+triangulate_landmarks::priv::status
+triangulate_landmarks::priv
+::triangulate_landmark(vital::landmark_id_t id,
+                       vital::landmark_sptr const& current,
+                       unsigned num_observations,
+                       double thresh_triang_cos_ang,
+                       scratch& s,
+                       vital::landmark_sptr& result) const
+{
+  // if we found at least two views of this landmark, triangulate
+  if (s.cams.size() > 1)
+  {
+    int inlier_count = 0;
+    vital::vector_3d pt3d;
+    if (m_ransac)
+    {
+      vital::vector_3d lm_cur_pt3d =
+        current ? current->loc() : vital::vector_3d::Zero();
+      auto triang_guess = &lm_cur_pt3d;
+      if (lm_cur_pt3d.x() == 0 && lm_cur_pt3d.y() == 0 && lm_cur_pt3d.z() == 0)
+      {
+        triang_guess = NULL;
+      }
+
+      // seed from the landmark, so results do not depend on scheduling
+      s.gen.seed(static_cast<std::mt19937_64::result_type>(id));
+      pt3d = ransac_triangulation(s.cams, s.image_pts, inlier_count,
+                                  triang_guess, s.gen);
+      if (inlier_count < s.image_pts.size() * m_frac_track_inliers_to_keep_triangulated_point)
+      {
+        return failed_outlier;
+      }
+    }
+    else
+    {
+      if (!triangulate(s.cams, s.image_pts, pt3d))
+      {
+        return failed;
+      }
+      //test if the point is behind any of the cameras
+      bool behind = false;
+      for (auto const& lm_cam : s.cams)
+      {
+        auto depth = lm_cam.depth(pt3d);
+        if (depth <= 0)
+        {
+          behind = true;
+          break;
+        }
+      }
+      if (behind)
+      {
+        for (auto lm_feat : s.features)
+        {
+          lm_feat->inlier = false;
+        }
+        return failed;
+      }
+    }
+
+    //set inlier/outlier states for the measurements
+    for (unsigned int idx = 0; idx < s.cams.size(); ++idx)
+    {
+      double reproj_err_sq =
+        (s.cams[idx].project(pt3d) - s.image_pts[idx]).squaredNorm();
+      s.features[idx]->inlier = reproj_err_sq < m_inlier_threshold_pixels_sq;
+    }
+    if (!pt3d.allFinite())
+    {
+      for (auto lm_feat : s.features)
+      {
+        lm_feat->inlier = false;
+      }
+      return failed;
+    }
+
+    double triang_cos_ang = bundle_angle_max(s.cams, pt3d);
+    bool bad_triangulation = triang_cos_ang > thresh_triang_cos_ang;
+    if (bad_triangulation)
+    {
+      for (auto lm_feat : s.features)
+      {
+        lm_feat->inlier = false;
+      }
+      return failed_angle;
+    }
+
+    std::shared_ptr<vital::landmark_d> lm;
+    // if the landmark already exists, copy it
+    if (current)
+    {
+      lm = std::make_shared<vital::landmark_d>(*current);  //automatically copies the tracks_ data
+      lm->set_loc(pt3d);
+    }
+    // otherwise make a new landmark
+    else
+    {
+      lm = std::make_shared<vital::landmark_d>(pt3d);
+    }
+    lm->set_cos_observation_angle(triang_cos_ang);
+    lm->set_observations(num_observations);
+    result = lm;
+    return triangulated;
+  }
+  else if ( s.cams_rpc.size() > 1 )
+  {
+    vital::vector_3d pt3d =
+      triangulate_rpc(s.cams_rpc, s.image_pts_rpc);
+
+    // TODO: is there a way to check for bad triangulations for RPC cameras?
+    auto lm = current ? std::make_shared<vital::landmark_d>(*current)
+                      : std::make_shared<vital::landmark_d>();
+    lm->set_loc(pt3d);
+    lm->set_observations(num_observations);
+    result = lm;
+    return triangulated;
+  }
+  return skipped;
+}
+
 void
 triangulate_landmarks
 ::triangulate(vital::camera_map_sptr cameras,
@@ -335,195 +483,152 @@ ::triangulate(vital::camera_map_sptr cameras,
   map_camera_t cams = cameras->cameras();
   map_landmark_t lms = landmarks->landmarks();
 
-  // the set of landmark ids which failed to triangulate
-  std::set<vital::landmark_id_t> failed_landmarks;
-  std::set<vital::landmark_id_t> failed_outlier, failed_angle;
-
   //minimum triangulation angle
   double thresh_triang_cos_ang = cos(vital::deg_to_rad * d_->m_min_angle_deg);
 
-  std::vector<vital::simple_camera_perspective> lm_cams;
-  std::vector<vital::simple_camera_rpc> lm_cams_rpc;
-  std::vector<vital::vector_2d> lm_image_pts;
-  std::vector<vital::feature_track_state_sptr> lm_features;
+  // convert each camera once; a camera is referred to by its index in
+  // persp_cams, or by -1 minus its index in rpc_cams
+  std::vector<vital::simple_camera_perspective> persp_cams;
+  std::vector<vital::simple_camera_rpc> rpc_cams;
+  std::map<vital::frame_id_t, int> cam_index;
+  for (auto const& c : cams)
+  {
+    if (auto cam_ptr =
+          std::dynamic_pointer_cast<vital::camera_perspective>(c.second))
+    {
+      cam_index[c.first] = static_cast<int>(persp_cams.size());
+      persp_cams.push_back(vital::simple_camera_perspective(*cam_ptr));
+    }
+    else if (auto rpc_ptr =
+               std::dynamic_pointer_cast<vital::camera_rpc>(c.second))
+    {
+      cam_index[c.first] = -1 - static_cast<int>(rpc_cams.size());
+      rpc_cams.push_back(vital::simple_camera_rpc(*rpc_ptr));
+    }
+  }
 
-  map_landmark_t triangulated_lms;
-  for(const map_landmark_t::value_type& p : lms)
+  // gather the observations of every landmark into flat arrays; those of
+  // landmark i are obs_begin[i] to obs_begin[i+1]
+  std::vector<map_landmark_t::const_iterator> lm_itrs;
+  std::vector<size_t> obs_begin;
+  std::vector<int> obs_cam;
+  std::vector<vital::feature_track_state_sptr> obs_feature;
+  std::vector<priv::status> status;
+  lm_itrs.reserve(lms.size());
+  obs_begin.reserve(lms.size() + 1);
+  status.reserve(lms.size());
+  for (auto p = lms.cbegin(); p != lms.cend(); ++p)
   {
-    lm_cams.clear();
-    lm_cams_rpc.clear();
-    lm_image_pts.clear();
-    lm_features.clear();
-    // extract the cameras and image points for this landmarks
-    auto lm_observations = unsigned{ 0 };
+    lm_itrs.push_back(p);
+    obs_begin.push_back(obs_cam.size());
 
     // get the corresponding track
-    vital::track_map_t::const_iterator t_itr = track_map.find(p.first);
+    vital::track_map_t::const_iterator t_itr = track_map.find(p->first);
     if (t_itr == track_map.end())
     {
       // there is no track for the provided landmark
-      failed_landmarks.insert(p.first);
+      status.push_back(priv::failed);
       continue;
     }
+    status.push_back(priv::skipped);
     const vital::track& t = *t_itr->second;
 
     for (vital::track::history_const_itr tsi = t.begin(); tsi != t.end(); ++tsi)
     {
       auto fts = std::static_pointer_cast<vital::feature_track_state>(*tsi);
-      if (!fts && !fts->feature)
+      if (!fts || !fts->feature)
       {
         // there is no valid feature for this track state
         continue;
       }
-      map_camera_t::const_iterator c_itr = cams.find((*tsi)->frame());
-      if (c_itr == cams.end())
+      auto c_itr = cam_index.find((*tsi)->frame());
+      if (c_itr == cam_index.end())
       {
         // there is no camera for this track state.
         continue;
       }
-      auto cam_ptr =
-        std::dynamic_pointer_cast<vital::camera_perspective>(c_itr->second);
-      if (cam_ptr)
-      {
-        lm_cams.push_back(vital::simple_camera_perspective(*cam_ptr));
-      }
-      auto rpc_ptr =
-        std::dynamic_pointer_cast<vital::camera_rpc>(c_itr->second);
-      if (rpc_ptr)
-      {
-        lm_cams_rpc.push_back( vital::simple_camera_rpc( *rpc_ptr ) );
-      }
-      if (cam_ptr || rpc_ptr)
-      {
-        lm_image_pts.push_back(fts->feature->loc());
-        lm_features.push_back(fts);
-        ++lm_observations;
-      }
+      obs_cam.push_back(c_itr->second);
+      obs_feature.push_back(fts);
     }
-
-    // if we found at least two views of this landmark, triangulate
-    if (lm_cams.size() > 1)
+  }
+  obs_begin.push_back(obs_cam.size());
+
+  // each landmark updates only the states of its own track, so landmarks
+  // are triangulated in parallel with no locking
+  std::vector<vital::landmark_sptr> results(lm_itrs.size());
+  vital::thread_pool::instance().parallel_for(
+    lm_itrs.size(), 64,
+    [&](size_t begin, size_t end)
     {
-      int inlier_count = 0;
-      vital::vector_3d pt3d;
-      if (d_->m_ransac)
-      {
-        vital::vector_3d lm_cur_pt3d = p.second->loc();
-        auto triang_guess = &lm_cur_pt3d;
-        if (lm_cur_pt3d.x() == 0 && lm_cur_pt3d.y() == 0 && lm_cur_pt3d.z() == 0)
-        {
-          triang_guess = NULL;
-        }
-
-        pt3d = d_->ransac_triangulation(lm_cams, lm_image_pts, inlier_count, triang_guess);
-        if (inlier_count < lm_image_pts.size() * d_->m_frac_track_inliers_to_keep_triangulated_point)
-        {
-          failed_landmarks.insert(p.first);
-          failed_outlier.insert(p.first);
-          continue;
-        }
-      }
-      else
+      // reused for every landmark of the chunk
+      priv::scratch s;
+      for (size_t i = begin; i < end; ++i)
       {
-        if (!d_->triangulate(lm_cams, lm_image_pts, pt3d))
+        if (status[i] != priv::skipped)
         {
-          failed_landmarks.insert(p.first);
           continue;
         }
-        //test if the point is behind any of the cameras
-        bool behind = false;
-        for (auto const& lm_cam : lm_cams)
+
+        s.cams.clear();
+        s.cams_rpc.clear();
+        s.image_pts.clear();
+        s.image_pts_rpc.clear();
+        s.features.clear();
+        for (size_t o = obs_begin[i]; o < obs_begin[i + 1]; ++o)
         {
-          auto depth = lm_cam.depth(pt3d);
-          if (depth <= 0)
+          int const c = obs_cam[o];
+          if (c >= 0)
           {
-            behind = true;
-            break;
+            s.cams.push_back(persp_cams[c]);
+            s.image_pts.push_back(obs_feature[o]->feature->loc());
+            s.features.push_back(obs_feature[o].get());
           }
-        }
-        if (behind)
-        {
-          for (auto lm_feat : lm_features)
+          else
           {
-            lm_feat->inlier = false;
+            s.cams_rpc.push_back(rpc_cams[-1 - c]);
+            s.image_pts_rpc.push_back(obs_feature[o]->feature->loc());
           }
-          failed_landmarks.insert(p.first);
-          continue;
         }
-      }
 
-      //set inlier/outlier states for the measurements
-      for (unsigned int idx = 0; idx < lm_cams.size(); ++idx)
-      {
-        vital::landmark_d lm;
-        lm.set_loc(pt3d);
-        double reproj_err_sq = reprojection_error_sqr(lm_cams[idx], lm, *lm_features[idx]->feature);
-        if (reproj_err_sq < d_->m_inlier_threshold_pixels_sq)
-        {
-          lm_features[idx]->inlier = true;
-        }
-        else
-        {
-          lm_features[idx]->inlier = false;
-        }
-      }
-      if (!pt3d.allFinite())
-      {
-        for (auto lm_feat : lm_features)
-        {
-          lm_feat->inlier = false;
-        }
-        failed_landmarks.insert(p.first);
-        continue;
-      }
-
-      double triang_cos_ang = bundle_angle_max(lm_cams, pt3d);
-      bool bad_triangulation = triang_cos_ang > thresh_triang_cos_ang;
-      if (bad_triangulation)
-      {
-        failed_landmarks.insert(p.first);
-        failed_angle.insert(p.first);
-        for (auto lm_feat : lm_features)
-        {
-          lm_feat->inlier = false;
-        }
-        continue;
+        status[i] = d_->triangulate_landmark(
+          lm_itrs[i]->first, lm_itrs[i]->second,
+          static_cast<unsigned>(obs_begin[i + 1] - obs_begin[i]),
+          thresh_triang_cos_ang, s, results[i]);
       }
+    });
 
-      std::shared_ptr<vital::landmark_d> lm;
-      // if the landmark already exists, copy it
-      if (p.second)
-      {
-        lm = std::make_shared<vital::landmark_d>(*p.second);  //automatically copies the tracks_ data
-        lm->set_loc(pt3d);
-      }
-      // otherwise make a new landmark
-      else
-      {
-        lm = std::make_shared<vital::landmark_d>(pt3d);
-      }
-      lm->set_cos_observation_angle(triang_cos_ang);
-      lm->set_observations(lm_observations);
-      triangulated_lms[p.first] = lm;
-    }
-    else if ( lm_cams_rpc.size() > 1 )
+  // the set of landmark ids which failed to triangulate
+  size_t num_failed = 0, num_outlier = 0, num_angle = 0;
+  map_landmark_t triangulated_lms;
+  for (size_t i = 0; i < lm_itrs.size(); ++i)
+  {
+    switch (status[i])
     {
-      vital::vector_3d pt3d =
-        triangulate_rpc(lm_cams_rpc, lm_image_pts);
-
-      // TODO: is there a way to check for bad triangulations for RPC cameras?
-      auto lm = std::make_shared<vital::landmark_d>(*p.second);
-      lm->set_loc(pt3d);
-      lm->set_observations(lm_observations);
-      triangulated_lms[p.first] = lm;
+      case priv::triangulated:
+        triangulated_lms.emplace_hint(triangulated_lms.end(),
+                                      lm_itrs[i]->first, results[i]);
+        break;
+      case priv::failed_outlier:
+        ++num_outlier;
+        ++num_failed;
+        break;
+      case priv::failed_angle:
+        ++num_angle;
+        ++num_failed;
+        break;
+      case priv::failed:
+        ++num_failed;
+        break;
+      case priv::skipped:
+        break;
     }
   }
-  if( !failed_landmarks.empty() )
+  if( num_failed > 0 )
   {
     LOG_WARN( logger(),
-              "failed to triangulate " << failed_landmarks.size()
-              << " with " << failed_angle.size() << " for angle, "
-              << failed_outlier.size() << " outliers");
+              "failed to triangulate " << num_failed
+              << " with " << num_angle << " for angle, "
+              << num_outlier << " outliers");
   }
   landmarks = vital::landmark_map_sptr(new vital::simple_landmark_map(triangulated_lms));
 }
@@ -23,6 +23,7 @@
 #include <arrows/core/colorize.h>
 
 #include <cstdlib>
+#include <deque>
 #include <iostream>
 #include <fstream>
 #include <vector>
@@ -179,6 +180,16 @@ select_frames(std::vector<kv::frame_id_t> const& valid_frames,
   return selected_frames;
 }
 
+// ----------------------------------------------------------------------------
+// A frame read ahead of tracking
+struct pending_frame
+{
+  kv::frame_id_t frame;
+  kv::image_container_sptr image;
+  kv::image_container_sptr mask;
+  bool prefetched;
+};
+
 } // end namespace
 
 class track_features::priv
@@ -448,10 +459,17 @@ class track_features::priv
       }
     }
 
-    // Track features on each frame sequentially
-    kv::feature_track_set_sptr tracks;
-    for (auto target_frame : selected_frames)
+    // Read the next target frame and its mask into a pending frame
+    enum read_result { READ_OK, READ_END, READ_FAIL };
+    auto next_target = selected_frames.begin();
+    auto read_frame = [&](pending_frame& pf) -> read_result
     {
+      if (next_target == selected_frames.end())
+      {
+        return READ_END;
+      }
+      auto const target_frame = *next_target++;
+
       bool valid = true;
       kv::frame_id_t frame = 0;
 
@@ -468,7 +486,8 @@ class track_features::priv
       } while (valid && frame < target_frame);
       if (!valid)
       {
-        break;
+        next_target = selected_frames.end();
+        return READ_END;
       }
 
       auto const image = video_reader->frame_image();
@@ -481,7 +500,7 @@ class track_features::priv
         if (!expect_multichannel_masks && mask->depth() > 1)
         {
           LOG_ERROR(main_logger, "Encounted multi-channel mask image!");
-          return false;
+          return READ_FAIL;
         }
         else if (expect_multichannel_masks && mask->depth() == 1)
         {
@@ -507,7 +526,58 @@ class track_features::priv
         image->set_metadata(mdv[0]);
       }
 
-      tracks = feature_tracker->track(tracks, frame, image, mask);
+      pf.frame = frame;
+      pf.image = image;
+      pf.mask = mask;
+      pf.prefetched = false;
+      return READ_OK;
+    };
+
+    // Track features on each frame in order. Frames are read ahead and
+    // offered to the tracker for as long as it accepts them, so that it may
+    // work on them in the background.
+    kv::feature_track_set_sptr tracks;
+    std::deque<pending_frame> pending;
+    bool more_frames = true;
+    while (true)
+    {
+      // retry frames the tracker had no capacity for
+      for (auto& pf : pending)
+      {
+        if (!pf.prefetched &&
+            !(pf.prefetched =
+                feature_tracker->prefetch(pf.frame, pf.image, pf.mask)))
+        {
+          break;
+        }
+      }
+      while (more_frames && (pending.empty() || pending.back().prefetched))
+      {
+        pending_frame pf;
+        switch (read_frame(pf))
+        {
+        case READ_FAIL:
+          return false;
+        case READ_END:
+          more_frames = false;
+          continue;
+        case READ_OK:
+          break;
+        }
+        pf.prefetched = feature_tracker->prefetch(pf.frame, pf.image, pf.mask);
+        pending.push_back(pf);
+      }
+      if (pending.empty())
+      {
+        break;
+      }
+
+      auto const pf = pending.front();
+      pending.pop_front();
+      auto const frame = pf.frame;
+      auto const& image = pf.image;
+
+      tracks = feature_tracker->track(tracks, frame, image, pf.mask);
       if (tracks)
       {
         tracks = kwiver::arrows::core::extract_feature_colors(tracks, *image, frame);
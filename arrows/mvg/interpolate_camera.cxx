@@ -7,23 +7,27 @@
 
 #include "interpolate_camera.h"
 
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+
 namespace kwiver {
 namespace arrows {
 namespace mvg {
 
-/// Generate an interpolated camera between \c A and \c B by a given fraction \c f
+namespace {
+
+/// Interpolate the center and intrinsics of a camera with a known rotation
 vital::simple_camera_perspective
 interpolate_camera(vital::simple_camera_perspective const& A,
-                   vital::simple_camera_perspective const& B, double f)
+                   vital::simple_camera_perspective const& B, double f,
+                   vital::rotation_d const& R)
 {
   const double f1 = 1.0 - f;
 
   // interpolate center
   vital::vector_3d c = f1*A.get_center() + f*B.get_center();
 
-  // interpolate rotation
-  vital::rotation_d R = interpolate_rotation(A.get_rotation(), B.get_rotation(), f);
-
   // interpolate intrinsics
   vital::camera_intrinsics_sptr k1 = A.get_intrinsics(),
                                 k2 = B.get_intrinsics();
@@ -41,6 +45,19 @@ interpolate_camera(vital::simple_camera_perspective const& A,
   return vital::simple_camera_perspective(c, R, k);
 }
 
+} // end anonymous namespace
+
+/// Generate an interpolated camera between \c A and \c B by a given fraction \c f
+vital::simple_camera_perspective
+interpolate_camera(vital::simple_camera_perspective const& A,
+                   vital::simple_camera_perspective const& B, double f)
+{
+  // interpolate rotation
+  vital::rotation_d R = interpolate_rotation(A.get_rotation(), B.get_rotation(), f);
+
+  return interpolate_camera(A, B, f, R);
+}
+
 /// Generate N evenly interpolated cameras in between \c A and \c B
 void
 interpolated_cameras(vital::simple_camera_perspective const& A,
@@ -70,6 +87,90 @@ interpolate_camera(vital::camera_perspective_sptr A,
     vital::simple_camera_perspective(*B), f).clone());
 }
 
+/// Generate interpolated cameras for many frames at once
+vital::camera_map::map_camera_t
+interpolate_cameras(vital::camera_map::map_camera_t const& cameras,
+                    std::vector<vital::frame_id_t> const& frames)
+{
+  // the perspective cameras to interpolate between, in frame order
+  std::vector<vital::frame_id_t> key_frames;
+  std::vector<vital::camera_perspective_sptr> key_cams;
+  std::vector<vital::simple_camera_perspective> key_simple;
+  for (auto const& c : cameras)
+  {
+    if (auto pc = std::dynamic_pointer_cast<vital::camera_perspective>(c.second))
+    {
+      key_frames.push_back(c.first);
+      key_cams.push_back(pc);
+      key_simple.emplace_back(*pc);
+    }
+  }
+
+  vital::camera_map::map_camera_t interp_cams;
+  if (key_frames.empty())
+  {
+    return interp_cams;
+  }
+
+  // the rotation across each gap, as an angle about an axis, which
+  // interpolate_rotation would otherwise recompute for every frame
+  std::vector<double> gap_angle(key_frames.size() - 1);
+  std::vector<vital::vector_3d> gap_axis(key_frames.size() - 1);
+  for (size_t g = 0; g + 1 < key_frames.size(); ++g)
+  {
+    vital::rotation_d const C = key_simple[g].get_rotation().inverse() *
+                                key_simple[g + 1].get_rotation();
+    gap_angle[g] = C.angle();
+    gap_axis[g] = C.axis();
+  }
+
+  std::vector<vital::camera_perspective_sptr> results(frames.size());
+  vital::thread_pool::instance().parallel_for(
+    frames.size(), 256,
+    [&](size_t begin, size_t end)
+    {
+      for (size_t i = begin; i < end; ++i)
+      {
+        auto const fid = frames[i];
+        auto const next =
+          std::upper_bound(key_frames.begin(), key_frames.end(), fid);
+        if (next == key_frames.begin())
+        {
+          // before the first camera
+          continue;
+        }
+        size_t const g = static_cast<size_t>(next - key_frames.begin()) - 1;
+        if (key_frames[g] == fid)
+        {
+          results[i] = key_cams[g];
+          continue;
+        }
+        if (next == key_frames.end())
+        {
+          // after the last camera
+          continue;
+        }
+
+        double const f = static_cast<double>(fid - key_frames[g]) /
+                         static_cast<double>(key_frames[g + 1] - key_frames[g]);
+        vital::rotation_d const R = key_simple[g].get_rotation() *
+                                    vital::rotation_d(gap_angle[g] * f,
+                                                      gap_axis[g]);
+        results[i] = std::make_shared<vital::simple_camera_perspective>(
+          interpolate_camera(key_simple[g], key_simple[g + 1], f, R));
+      }
+    });
+
+  for (size_t i = 0; i < frames.size(); ++i)
+  {
+    if (results[i])
+    {
+      interp_cams[frames[i]] = results[i];
+    }
+  }
+  return interp_cams;
+}
+
 } // end namespace mvg
 } // end namespace arrows
 } // end namespace kwiver
@@ -12,6 +12,7 @@
 #include <arrows/mvg/kwiver_algo_mvg_export.h>
 
 #include <vector>
+#include <vital/types/camera_map.h>
 #include <vital/types/camera_perspective.h>
 
 namespace kwiver {
@@ -49,6 +50,23 @@ void interpolated_cameras(vital::simple_camera_perspective const& A,
                           size_t n,
                           std::vector< vital::simple_camera_perspective > & interp_cams);
 
+/// Generate interpolated cameras for many frames at once
+///
+/// Each frame of \c frames between two perspective cameras of \c cameras
+/// gets a camera interpolated between the nearest of them, as by
+/// interpolate_camera(). Frames which already have a camera get that
+/// camera, and frames before the first or after the last camera are left
+/// out. The rotation between each pair of cameras is computed once, and
+/// the frames are interpolated in parallel on the vital thread pool.
+///
+/// \param cameras Cameras to interpolate between.
+/// \param frames  Frames to return cameras for.
+/// \returns A map from each frame that could be interpolated to its camera.
+KWIVER_ALGO_MVG_EXPORT
+vital::camera_map::map_camera_t
+interpolate_cameras(vital::camera_map::map_camera_t const& cameras,
+                    std::vector<vital::frame_id_t> const& frames);
+
 } // end namespace mvg
 } // end namespace arrows
 } // end namespace kwiver
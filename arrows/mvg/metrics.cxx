@@ -7,6 +7,7 @@
 
 #include "metrics.h"
 #include <vital/types/feature_track_set.h>
+#include <vital/util/thread_pool.h>
 #include <limits>
 
 namespace kwiver {
@@ -15,6 +16,124 @@ namespace mvg {
 
 using namespace kwiver::vital;
 
+namespace {
+
+/// The observations seen by one camera
+struct camera_batch
+{
+  frame_id_t frame;
+  const camera* cam;
+  /// Position of each observation in the list of all observations
+  std::vector<size_t> index;
+  std::vector<vector_3d> points;
+  std::vector<vector_2d> features;
+};
+
+/// Compute the squared reprojection error of every observation
+///
+/// Observations are the inlier feature track states with both a camera and
+/// a landmark. Their errors are returned in track order, and the frame of
+/// each is returned in \p frames if not null. The observations of each
+/// camera are projected together, with one batch projection for perspective
+/// cameras, and the cameras are spread over the vital thread pool.
+std::vector<double>
+reprojection_errors_sqr(const std::map<frame_id_t, camera_sptr>& cameras,
+                        const std::map<landmark_id_t, landmark_sptr>& landmarks,
+                        const std::vector<track_sptr>& tracks,
+                        std::vector<frame_id_t>* frames = nullptr)
+{
+  std::vector<camera_batch> batches;
+  std::map<frame_id_t, size_t> batch_of_frame;
+  size_t num_obs = 0;
+
+  for (const track_sptr& t : tracks)
+  {
+    auto lmi = landmarks.find(t->id());
+    if (lmi == landmarks.end() || !lmi->second)
+    {
+      // no landmark corresponding to this track
+      continue;
+    }
+    const landmark& lm = *lmi->second;
+    for (track::history_const_itr tsi = t->begin(); tsi != t->end(); ++tsi)
+    {
+      auto fts = std::dynamic_pointer_cast<feature_track_state>(*tsi);
+      if (!fts || !fts->feature || !fts->inlier)
+      {
+        // no inlier feature for this track state
+        continue;
+      }
+      auto ci = cameras.find((*tsi)->frame());
+      if (ci == cameras.end() || !ci->second)
+      {
+        // no camera corresponding to this track state
+        continue;
+      }
+
+      auto const b = batch_of_frame.emplace(ci->first, batches.size());
+      if (b.second)
+      {
+        batches.push_back(camera_batch{ ci->first, ci->second.get(), {}, {}, {} });
+      }
+      camera_batch& batch = batches[b.first->second];
+      batch.index.push_back(num_obs++);
+      batch.points.push_back(lm.loc());
+      batch.features.push_back(fts->feature->loc());
+    }
+  }
+
+  std::vector<double> errors(num_obs);
+  if (frames)
+  {
+    frames->resize(num_obs);
+  }
+
+  thread_pool::instance().parallel_for(
+    batches.size(), 1,
+    [&](size_t begin, size_t end)
+    {
+      for (size_t b = begin; b < end; ++b)
+      {
+        const camera_batch& batch = batches[b];
+        const size_t n = batch.index.size();
+        auto const pcam = dynamic_cast<const camera_perspective*>(batch.cam);
+
+        if (pcam)
+        {
+          const matrix_Xx3d pts =
+            Eigen::Map<const Eigen::Matrix<double, 3, Eigen::Dynamic>>(
+              batch.points[0].data(), 3, n).transpose();
+          const matrix_Xx2d proj = pcam->project_points(pts);
+          for (size_t i = 0; i < n; ++i)
+          {
+            errors[batch.index[i]] =
+              (proj.row(i).transpose() - batch.features[i]).squaredNorm();
+          }
+        }
+        else
+        {
+          for (size_t i = 0; i < n; ++i)
+          {
+            errors[batch.index[i]] =
+              (batch.cam->project(batch.points[i]) - batch.features[i]).squaredNorm();
+          }
+        }
+
+        if (frames)
+        {
+          for (size_t i = 0; i < n; ++i)
+          {
+            (*frames)[batch.index[i]] = batch.frame;
+          }
+        }
+      }
+    });
+
+  return errors;
+}
+
+} // end anonymous namespace
+
 /// Compute the reprojection error vector of lm projected by cam compared to f
 vector_2d
 reprojection_error_vec(const camera& cam,
@@ -88,40 +207,11 @@ reprojection_errors(const std::map<frame_id_t, camera_sptr>& cameras,
                     const std::map<landmark_id_t, landmark_sptr>& landmarks,
                     const std::vector<track_sptr>& tracks)
 {
-  typedef std::map<landmark_id_t, landmark_sptr>::const_iterator lm_map_itr_t;
-  typedef std::map<frame_id_t, camera_sptr>::const_iterator cam_map_itr_t;
-  std::vector<double> errors;
-  for(const track_sptr& t : tracks)
+  std::vector<double> errors =
+    reprojection_errors_sqr(cameras, landmarks, tracks);
+  for (double& e : errors)
   {
-    lm_map_itr_t lmi = landmarks.find(t->id());
-    if (lmi == landmarks.end() || !lmi->second)
-    {
-      // no landmark corresponding to this track
-      continue;
-    }
-    const landmark& lm = *lmi->second;
-    for( track::history_const_itr tsi = t->begin(); tsi != t->end(); ++tsi)
-    {
-      auto fts = std::dynamic_pointer_cast<feature_track_state>(*tsi);
-      if (!fts || !fts->feature)
-      {
-        // no feature for this track state.
-        continue;
-      }
-      if (!fts->inlier)
-      {
-        continue; //feature is not marked as an inlier so skip it
-      }
-      const feature& feat = *fts->feature;
-      cam_map_itr_t ci = cameras.find((*tsi)->frame());
-      if (ci == cameras.end() || !ci->second)
-      {
-        // no camera corresponding to this track state
-        continue;
-      }
-      const camera& cam = *ci->second;
-      errors.push_back(reprojection_error(cam, lm, feat));
-    }
+    e = std::sqrt(e);
   }
   return errors;
 }
@@ -132,66 +222,23 @@ reprojection_rmse_by_cam(const vital::camera_map::map_camera_t& cameras,
                          const vital::landmark_map::map_landmark_t& landmarks,
                          const std::vector<track_sptr>& tracks)
 {
-  typedef std::map<landmark_id_t, landmark_sptr>::const_iterator lm_map_itr_t;
-  typedef std::map<frame_id_t, camera_sptr>::const_iterator cam_map_itr_t;
+  std::vector<frame_id_t> frames;
+  const std::vector<double> errors =
+    reprojection_errors_sqr(cameras, landmarks, tracks, &frames);
 
   struct err_vals {
     unsigned int num_obs;
     double sum_error_sq;
     err_vals() :
       num_obs(0), sum_error_sq(0) {}
-
-    err_vals(unsigned int num_obs_, double sum_error_sq_) :
-      num_obs(num_obs_), sum_error_sq(sum_error_sq_) {}
   };
 
   std::map<frame_id_t, err_vals> cam_errors;
-
-  for (const track_sptr& t : tracks)
+  for (size_t i = 0; i < errors.size(); ++i)
   {
-    lm_map_itr_t lmi = landmarks.find(t->id());
-    if (lmi == landmarks.end() || !lmi->second)
-    {
-      // no landmark corresponding to this track
-      continue;
-    }
-    const landmark& lm = *lmi->second;
-    for (track::history_const_itr tsi = t->begin(); tsi != t->end(); ++tsi)
-    {
-      auto frame_num = (*tsi)->frame();
-
-      auto fts = std::dynamic_pointer_cast<feature_track_state>(*tsi);
-      if (!fts || !fts->feature)
-      {
-        // no feature for this track state.
-        continue;
-      }
-      if (!fts->inlier)
-      {
-        continue; //feature is not marked as an inlier so skip it
-      }
-
-      const feature& feat = *fts->feature;
-      cam_map_itr_t ci = cameras.find(frame_num);
-      if (ci == cameras.end() || !ci->second)
-      {
-        // no camera corresponding to this track state
-        continue;
-      }
-      const camera& cam = *ci->second;
-
-      auto rpe = reprojection_error_sqr(cam, lm, feat);
-      auto ce_it = cam_errors.find(ci->first);
-      if (ce_it == cam_errors.end())
-      {
-        cam_errors[ci->first] = err_vals(1.0, rpe);
-      }
-      else
-      {
-        ce_it->second.num_obs += 1;
-        ce_it->second.sum_error_sq += rpe;
-      }
-    }
+    err_vals& ev = cam_errors[frames[i]];
+    ev.num_obs += 1;
+    ev.sum_error_sq += errors[i];
   }
 
   std::map<frame_id_t, double> ret_errs;
@@ -211,44 +258,24 @@ reprojection_rmse(const std::map<frame_id_t, camera_sptr>& cameras,
                   const std::map<landmark_id_t, landmark_sptr>& landmarks,
                   const std::vector<track_sptr>& tracks)
 {
-  typedef std::map<landmark_id_t, landmark_sptr>::const_iterator lm_map_itr_t;
-  typedef std::map<frame_id_t, camera_sptr>::const_iterator cam_map_itr_t;
-  double error_sum = 0.0;
-  unsigned num_obs = 0;
-  for(const track_sptr& t : tracks)
-  {
-    lm_map_itr_t lmi = landmarks.find(t->id());
-    if (lmi == landmarks.end() || !lmi->second)
-    {
-      // no landmark corresponding to this track
-      continue;
-    }
-    const landmark& lm = *lmi->second;
-    for( track::history_const_itr tsi = t->begin(); tsi != t->end(); ++tsi)
+  const std::vector<double> errors =
+    reprojection_errors_sqr(cameras, landmarks, tracks);
+
+  // Summed in fixed chunks so the result does not depend on the threads
+  const double error_sum = thread_pool::instance().parallel_reduce(
+    errors.size(), 4096, 0.0,
+    [&](size_t begin, size_t end)
     {
-      auto fts = std::dynamic_pointer_cast<feature_track_state>(*tsi);
-      if (!fts || !fts->feature)
-      {
-        // no feature for this track state.
-        continue;
-      }
-      if (!fts->inlier)
-      {
-        continue; //feature is not marked as an inlier so skip it
-      }
-      const feature& feat = *fts->feature;
-      cam_map_itr_t ci = cameras.find((*tsi)->frame());
-      if (ci == cameras.end() || !ci->second)
+      double sum = 0.0;
+      for (size_t i = begin; i < end; ++i)
       {
-        // no camera corresponding to this track state
-        continue;
+        sum += errors[i];
       }
-      const camera& cam = *ci->second;
-      error_sum += reprojection_error_sqr(cam, lm, feat);
-      ++num_obs;
-    }
-  }
-  return std::sqrt(error_sum / num_obs);
+      return sum;
+    },
+    [](double a, double b) { return a + b; });
+
+  return std::sqrt(error_sum / errors.size());
 }
 
 /// Compute the median of the reprojection errors
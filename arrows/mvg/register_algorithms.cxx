@@ -9,6 +9,8 @@
 
 #include <vital/algo/algorithm_factory.h>
 
+#include <arrows/mvg/algo/estimate_fundamental_matrix.h>
+#include <arrows/mvg/algo/estimate_homography.h>
 #include <arrows/mvg/algo/hierarchical_bundle_adjust.h>
 #include <arrows/mvg/algo/integrate_depth_maps.h>
 #include <arrows/mvg/algo/initialize_cameras_landmarks.h>
@@ -50,6 +52,8 @@ register_factories( kwiver::vital::plugin_loader& vpm )
     return;
   }
 
+  reg.register_algorithm< estimate_fundamental_matrix >();
+  reg.register_algorithm< estimate_homography >();
   reg.register_algorithm< hierarchical_bundle_adjust >();
   reg.register_algorithm< integrate_depth_maps >();
   reg.register_algorithm< initialize_cameras_landmarks >();
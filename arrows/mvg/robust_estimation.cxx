@@ -0,0 +1,107 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of MVG robust model estimation
+
+#include "robust_estimation.h"
+
+#include <vital/logger/logger.h>
+
+namespace kwiver {
+namespace arrows {
+namespace mvg {
+
+// ----------------------------------------------------------------------------
+vital::matrix_3x3d
+normalizing_transform( Eigen::ArrayXd const& x, Eigen::ArrayXd const& y )
+{
+  double const cx = x.mean();
+  double const cy = y.mean();
+  double const mean_dist =
+    ( ( x - cx ).square() + ( y - cy ).square() ).sqrt().mean();
+  double const s = mean_dist > 0.0 ? std::sqrt( 2.0 ) / mean_dist : 1.0;
+
+  vital::matrix_3x3d T;
+  T << s, 0.0, -s * cx,
+       0.0, s, -s * cy,
+       0.0, 0.0, 1.0;
+  return T;
+}
+
+// ----------------------------------------------------------------------------
+void
+robust_estimation_options
+::get_configuration( vital::config_block_sptr config ) const
+{
+  config->set_value( "confidence", this->confidence,
+                     "Sampling stops once the probability of having drawn a "
+                     "sample of only inliers reaches this confidence." );
+  config->set_value( "max_iterations", this->max_iterations,
+                     "Maximum number of hypotheses to evaluate." );
+  config->set_value( "batch_size", this->batch_size,
+                     "Number of hypotheses fit and scored concurrently on the "
+                     "thread pool. Results do not depend on the number of "
+                     "threads." );
+  config->set_value( "local_optimization_iterations",
+                     this->local_optimization_iterations,
+                     "Maximum number of least squares refits to the inliers "
+                     "of each new best hypothesis. Zero disables local "
+                     "optimization." );
+  config->set_value( "progressive_sampling", this->progressive_sampling,
+                     "Sample from the first correspondences first (PROSAC). "
+                     "Enable this only when correspondences are given in "
+                     "order of decreasing quality." );
+  config->set_value( "random_seed", this->random_seed,
+                     "Seed of the random number generator used for "
+                     "sampling." );
+}
+
+// ----------------------------------------------------------------------------
+void
+robust_estimation_options
+::set_configuration( vital::config_block_sptr config )
+{
+  this->confidence =
+    config->get_value< double >( "confidence", this->confidence );
+  this->max_iterations =
+    config->get_value< unsigned >( "max_iterations", this->max_iterations );
+  this->batch_size =
+    config->get_value< unsigned >( "batch_size", this->batch_size );
+  this->local_optimization_iterations =
+    config->get_value< unsigned >( "local_optimization_iterations",
+                                   this->local_optimization_iterations );
+  this->progressive_sampling =
+    config->get_value< bool >( "progressive_sampling",
+                               this->progressive_sampling );
+  this->random_seed =
+    config->get_value< unsigned >( "random_seed", this->random_seed );
+}
+
+// ----------------------------------------------------------------------------
+bool
+robust_estimation_options
+::check_configuration( vital::config_block_sptr config ) const
+{
+  auto logger = vital::get_logger( "arrows.mvg.robust_estimation" );
+  bool valid = true;
+
+  auto const conf =
+    config->get_value< double >( "confidence", this->confidence );
+  if( !( conf > 0.0 && conf < 1.0 ) )
+  {
+    LOG_ERROR( logger, "confidence must be between 0 and 1 exclusive" );
+    valid = false;
+  }
+  if( config->get_value< unsigned >( "batch_size", this->batch_size ) < 1 )
+  {
+    LOG_ERROR( logger, "batch_size must be at least 1" );
+    valid = false;
+  }
+  return valid;
+}
+
+} // namespace mvg
+} // namespace arrows
+} // namespace kwiver
@@ -0,0 +1,314 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header for MVG robust model estimation
+
+#ifndef KWIVER_ARROWS_MVG_ROBUST_ESTIMATION_H_
+#define KWIVER_ARROWS_MVG_ROBUST_ESTIMATION_H_
+
+#include <arrows/mvg/kwiver_algo_mvg_export.h>
+
+#include <vital/config/config_block.h>
+#include <vital/types/matrix.h>
+#include <vital/types/vector.h>
+#include <vital/util/thread_pool.h>
+
+#include <Eigen/Core>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace kwiver {
+namespace arrows {
+namespace mvg {
+
+/// Robust estimation options
+///
+/// The intended use of this class is for a PIMPL for an algorithm to
+/// inherit from this class to share these options with that algorithm.
+struct KWIVER_ALGO_MVG_EXPORT robust_estimation_options
+{
+  virtual ~robust_estimation_options() = default;
+
+  /// Populate the config block with options.
+  virtual void get_configuration( vital::config_block_sptr config ) const;
+
+  /// Set the member variables from the config block.
+  virtual void set_configuration( vital::config_block_sptr config );
+
+  /// Check the options in the config block.
+  virtual bool check_configuration( vital::config_block_sptr config ) const;
+
+  /// Probability of drawing at least one sample of only inliers
+  double confidence = 0.99;
+
+  /// Maximum number of hypotheses to evaluate
+  unsigned max_iterations = 2000;
+
+  /// Number of hypotheses fit and scored concurrently
+  unsigned batch_size = 32;
+
+  /// Maximum least squares refits on the inliers of each new best hypothesis
+  unsigned local_optimization_iterations = 4;
+
+  /// Draw samples from the first data first (PROSAC)
+  bool progressive_sampling = false;
+
+  /// Seed of the sampling random number generator
+  unsigned random_seed = 42;
+};
+
+/// Result of robust_estimate()
+template < typename Model >
+struct robust_estimation_result
+{
+  /// True if a model was found
+  bool success = false;
+
+  /// The model with the lowest score
+  Model model;
+
+  /// Inlier flags of the data under the model
+  std::vector< bool > inliers;
+
+  /// Number of inliers of the model
+  size_t num_inliers = 0;
+
+  /// Number of hypotheses evaluated
+  unsigned iterations = 0;
+};
+
+/// Compute a transform which moves points to their centroid and scales them
+/// to a mean distance of sqrt(2) from it
+KWIVER_ALGO_MVG_EXPORT
+vital::matrix_3x3d
+normalizing_transform( Eigen::ArrayXd const& x, Eigen::ArrayXd const& y );
+
+/// Estimate a model robustly using LO-RANSAC with MSAC scoring
+///
+/// Hypotheses are fit to random minimal samples in batches of
+/// \c options.batch_size, which are fit and scored concurrently on the vital
+/// thread pool. Samples are drawn serially from a generator seeded with
+/// \c options.random_seed, so the result does not depend on the number of
+/// threads. Each hypothesis with a lower score than any before it is refit
+/// to its inliers for as long as that lowers its score. Sampling stops once
+/// \c options.confidence is reached for the best inlier ratio found.
+///
+/// The \p solver must provide:
+/// - \c model_t, the type of the model
+/// - \c sample_size, the size of a minimal sample
+/// - <tt>size_t size() const</tt>, the number of data
+/// - <tt>bool fit_sample( size_t const* indices, model_t& model ) const</tt>,
+///   which fits a model to a minimal sample
+/// - <tt>bool fit_inliers( std::vector< size_t > const& indices,
+///   model_t& model ) const</tt>, which fits a model to more data
+/// - <tt>void residuals( model_t const& model, Eigen::ArrayXd& r ) const</tt>,
+///   which computes the squared residuals of all data
+///
+/// \param solver the model solver
+/// \param inlier_threshold the largest residual of an inlier
+/// \param options the sampling options
+template < typename Solver >
+robust_estimation_result< typename Solver::model_t >
+robust_estimate( Solver const& solver, double inlier_threshold,
+                 robust_estimation_options const& options )
+{
+  using model_t = typename Solver::model_t;
+  constexpr size_t sample_size = Solver::sample_size;
+  using sample_t = std::array< size_t, sample_size >;
+
+  struct hypothesis
+  {
+    bool valid = false;
+    model_t model;
+    double score = std::numeric_limits< double >::infinity();
+    size_t num_inliers = 0;
+  };
+
+  robust_estimation_result< model_t > result;
+  size_t const num_data = solver.size();
+  if( num_data < sample_size )
+  {
+    return result;
+  }
+
+  double const threshold_sq = inlier_threshold * inlier_threshold;
+  auto const score =
+    [&]( model_t const& model, Eigen::ArrayXd& r, hypothesis& h )
+    {
+      solver.residuals( model, r );
+      h.score = r.min( threshold_sq ).sum();
+      h.num_inliers = static_cast< size_t >( ( r <= threshold_sq ).count() );
+    };
+
+  // PROSAC grows the sampled subset of the data on a fixed schedule;
+  // uniform sampling starts with the subset already at its full size
+  std::mt19937 rng( options.random_seed );
+  size_t subset_size = options.progressive_sampling ? sample_size : num_data;
+  double subset_samples = options.max_iterations;
+  for( size_t i = 0; i < sample_size; ++i )
+  {
+    subset_samples *= static_cast< double >( sample_size - i ) /
+                      static_cast< double >( num_data - i );
+  }
+  double subset_last_sample = 1.0;
+
+  auto const draw_sample =
+    [&]( unsigned t, sample_t& sample )
+    {
+      while( subset_size < num_data && t >= subset_last_sample )
+      {
+        auto const next_samples =
+          subset_samples * static_cast< double >( subset_size + 1 ) /
+          static_cast< double >( subset_size + 1 - sample_size );
+        subset_last_sample += std::ceil( next_samples - subset_samples );
+        subset_samples = next_samples;
+        ++subset_size;
+      }
+
+      // a progressive sample always contains the newest datum of the subset
+      size_t first = 0;
+      size_t pool = subset_size;
+      if( subset_size < num_data )
+      {
+        sample[ first++ ] = subset_size - 1;
+        --pool;
+      }
+      std::uniform_int_distribution< size_t > dist( 0, pool - 1 );
+      for( auto i = first; i < sample_size; ++i )
+      {
+        size_t index;
+        do
+        {
+          index = dist( rng );
+        } while( std::find( sample.begin(), sample.begin() + i, index ) !=
+                 sample.begin() + i );
+        sample[ i ] = index;
+      }
+    };
+
+  hypothesis best;
+  Eigen::ArrayXd residuals( num_data );
+  unsigned max_iterations = options.max_iterations;
+  unsigned const batch_size = std::max( options.batch_size, 1u );
+  std::vector< sample_t > samples;
+  std::vector< hypothesis > batch;
+
+  while( result.iterations < max_iterations )
+  {
+    auto const count = std::min( batch_size,
+                                 max_iterations - result.iterations );
+    samples.resize( count );
+    for( unsigned i = 0; i < count; ++i )
+    {
+      draw_sample( result.iterations + i + 1, samples[ i ] );
+    }
+    result.iterations += count;
+
+    batch.assign( count, hypothesis{} );
+    vital::thread_pool::instance().parallel_for( count, 1,
+      [&]( size_t begin, size_t end )
+      {
+        Eigen::ArrayXd r( num_data );
+        for( auto i = begin; i < end; ++i )
+        {
+          auto& h = batch[ i ];
+          h.valid = solver.fit_sample( samples[ i ].data(), h.model );
+          if( h.valid )
+          {
+            score( h.model, r, h );
+          }
+        }
+      } );
+
+    // take the first of equally good hypotheses, as a serial search would
+    auto const batch_best = std::min_element(
+      batch.begin(), batch.end(),
+      []( hypothesis const& a, hypothesis const& b )
+      {
+        return a.valid && ( !b.valid || a.score < b.score );
+      } );
+    if( !batch_best->valid || ( best.valid &&
+                                batch_best->score >= best.score ) )
+    {
+      continue;
+    }
+    best = std::move( *batch_best );
+
+    // local optimization: refit to the inliers while the score improves
+    std::vector< size_t > inlier_indices;
+    for( unsigned lo = 0; lo < options.local_optimization_iterations; ++lo )
+    {
+      solver.residuals( best.model, residuals );
+      inlier_indices.clear();
+      for( size_t i = 0; i < num_data; ++i )
+      {
+        if( residuals[ i ] <= threshold_sq )
+        {
+          inlier_indices.push_back( i );
+        }
+      }
+
+      hypothesis refit;
+      if( inlier_indices.size() <= sample_size ||
+          !solver.fit_inliers( inlier_indices, refit.model ) )
+      {
+        break;
+      }
+      score( refit.model, residuals, refit );
+      if( refit.score >= best.score )
+      {
+        break;
+      }
+      refit.valid = true;
+      best = std::move( refit );
+    }
+
+    // stop once an all-inlier sample has probably been drawn
+    auto const inlier_ratio =
+      static_cast< double >( best.num_inliers ) / num_data;
+    auto const p_good = std::pow( inlier_ratio, sample_size );
+    if( p_good >= 1.0 )
+    {
+      break;
+    }
+    if( p_good > 0.0 )
+    {
+      auto const needed = std::ceil( std::log( 1.0 - options.confidence ) /
+                                     std::log( 1.0 - p_good ) );
+      if( needed < max_iterations )
+      {
+        max_iterations = std::max( static_cast< unsigned >( needed ),
+                                   result.iterations );
+      }
+    }
+  }
+
+  if( !best.valid )
+  {
+    return result;
+  }
+
+  solver.residuals( best.model, residuals );
+  result.inliers.resize( num_data );
+  for( size_t i = 0; i < num_data; ++i )
+  {
+    result.inliers[ i ] = residuals[ i ] <= threshold_sq;
+  }
+  result.success = true;
+  result.model = best.model;
+  result.num_inliers = best.num_inliers;
+  return result;
+}
+
+} // namespace mvg
+} // namespace arrows
+} // namespace kwiver
+
+#endif
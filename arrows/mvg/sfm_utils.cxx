@@ -10,9 +10,14 @@
 #include <vital/vital_types.h>
 #include <vital/types/bounding_box.h>
 #include <vital/types/feature_track_set.h>
+#include <vital/util/thread_pool.h>
 #include <arrows/mvg/metrics.h>
 #include <arrows/core/match_matrix.h>
 
+#include <algorithm>
+#include <bitset>
+#include <numeric>
+
 using namespace kwiver::vital;
 
 namespace kwiver {
@@ -235,98 +240,7 @@ image_coverages(
   vital::landmark_map::map_landmark_t const& lms,
   vital::simple_camera_perspective_map::frame_to_T_sptr_map const& cams )
 {
-  const int mask_w(16);
-  const int mask_h(16);
-  typedef Eigen::Matrix<int, mask_h, mask_w> vis_mask;
-  typedef std::map<frame_id_t, vis_mask> frame_map_t;
-  frame_map_t frame_masks;
-  //calculate feature distribution masks for each candidate image.
-
-  struct im_dims {
-    int w;
-    int h;
-  };
-
-  //Get the dimension of each image.  Each image may be a different size.
-  std::map<frame_id_t,im_dims> frame_dims;
-
-  for (auto cam : cams)
-  {
-    if (cam.second)
-    {
-      auto simp_cam = std::static_pointer_cast<simple_camera_perspective>(cam.second);
-      im_dims dims;
-      //this assumes the principal point is at the center of the image.
-      dims.w = int(simp_cam->intrinsics()->principal_point().x() * 2.0);
-      dims.h = int(simp_cam->intrinsics()->principal_point().y() * 2.0);
-      frame_dims[cam.first] = dims;
-    }
-  }
-
-  for (const track_sptr& t : trks)
-  {
-    if (lms.find(t->id()) != lms.end())
-    {
-      for (auto ts : *t)
-      {
-        auto fid = ts->frame();
-        auto fd_it = frame_dims.find(fid);
-        if (fd_it == frame_dims.end())
-        {
-          continue;
-        }
-
-        feature_track_state_sptr fts =
-          std::dynamic_pointer_cast<feature_track_state>(ts);
-        if (!fts || !fts->feature)
-        {
-          continue;
-        }
-
-        if (!fts->inlier)
-        {
-          continue;
-        }
-
-        //calculate the mask image location
-        vector_2d x = fts->feature->loc();
-        int mask_row = int(std::max<float>(0.0f,
-          std::min<float>(mask_h*float(x.y()) / fd_it->second.h, mask_h - 1)));
-        int mask_col = int(std::max<float>(0.0f,
-          std::min<float>(mask_w*float(x.x()) / fd_it->second.w, mask_w - 1)));
-
-        auto fm_it = frame_masks.find(fid);
-        if (fm_it == frame_masks.end())
-        {
-          vis_mask msk;
-          msk.setZero();
-          msk(mask_row, mask_col) = 1;
-          frame_masks.insert(std::pair<frame_id_t, vis_mask>(fid, msk));
-        }
-        else
-        {
-          fm_it->second(mask_row, mask_col) = 1;
-        }
-      }
-    }
-  }
-
-  //ok, now we have calculated all the masks.
-  frame_coverage_vec ret;
-  for (auto fid : frame_dims)
-  {
-    auto fm_it = frame_masks.find(fid.first);
-    if (fm_it == frame_masks.end())
-    {
-      ret.push_back(coverage_pair(fid.first, 0.0f));
-    }
-    else
-    {
-      float coverage = float(fm_it->second.sum()) / float(mask_w*mask_h);
-      ret.push_back(coverage_pair(fid.first, coverage));
-    }
-  }
-  return ret;
+  return camera_landmark_graph(cams, lms, trks).image_coverages();
 }
 
 /// Remove landmarks with IDs in the set
@@ -351,127 +265,304 @@ connected_camera_components(
   landmark_map::map_landmark_t const& lms,
   feature_track_set_sptr tracks)
 {
-  auto trks = tracks->tracks();
+  return camera_landmark_graph(cams, lms, tracks->tracks())
+    .connected_components();
+}
 
-  camera_components comps;
+/// Detect critical tracks that connect disjoint components
+std::vector<track_sptr>
+detect_critical_tracks(camera_components const& cc,
+                       feature_track_set_sptr tracks)
+{
+  std::vector<track_sptr> critical_tracks;
+  // build a mapping from frame number to connected component index
+  std::map<frame_id_t, unsigned int> cc_map;
+  for (unsigned int i=0; i<cc.size(); ++i)
+  {
+    for (auto const& f : cc[i])
+    {
+      cc_map[f] = i;
+    }
+  }
 
-  for (const track_sptr& t : trks)
+  // find tracks which span more than one connected component
+  for (auto const& t : tracks->tracks())
   {
-    auto lmi = lms.find(t->id());
-    if (lmi == lms.end() || !lmi->second)
+    unsigned int first_idx = cc_map[t->first_frame()];
+    for (auto const& ts : *t)
+    {
+      auto idx = cc_map[ts->frame()];
+      if (idx != first_idx)
+      {
+        critical_tracks.push_back(t);
+        break;
+      }
+    }
+  }
+  return critical_tracks;
+}
+
+constexpr size_t camera_landmark_graph::npos;
+
+// ----------------------------------------------------------------------------
+camera_landmark_graph
+::camera_landmark_graph(
+  vital::simple_camera_perspective_map::frame_to_T_sptr_map const& cams,
+  landmark_map::map_landmark_t const& lms,
+  std::vector<track_sptr> const& trks)
+{
+  for (auto const& cam : cams)
+  {
+    if (cam.second)
+    {
+      // this assumes the principal point is at the center of the image
+      auto const pp = cam.second->intrinsics()->principal_point();
+      m_camera_ids.push_back(cam.first);
+      m_image_sizes.push_back({ int(pp.x() * 2.0), int(pp.y() * 2.0) });
+    }
+  }
+
+  // Find the track of each landmark, in order of landmark id
+  std::vector<std::pair<landmark_id_t, track const*>> lm_tracks;
+  lm_tracks.reserve(std::min(trks.size(), lms.size()));
+  for (auto const& t : trks)
+  {
+    if (!t)
     {
-      // no landmark corresponding to this track
       continue;
     }
+    auto const lmi = lms.find(t->id());
+    if (lmi != lms.end() && lmi->second)
+    {
+      lm_tracks.emplace_back(t->id(), t.get());
+    }
+  }
+  std::stable_sort(lm_tracks.begin(), lm_tracks.end(),
+    [](std::pair<landmark_id_t, track const*> const& a,
+       std::pair<landmark_id_t, track const*> const& b)
+  {
+    return a.first < b.first;
+  });
 
-    std::unordered_set<frame_id_t> cam_clique;
-    for (auto ts : *t)
+  // Collect the edges of each landmark; tracks with the same id are merged
+  std::vector<size_t> camera_counts(m_camera_ids.size() + 1, 0);
+  m_landmark_offsets.push_back(0);
+  for (auto const& lt : lm_tracks)
+  {
+    if (m_landmark_ids.empty() || m_landmark_ids.back() != lt.first)
     {
-      auto fts = std::static_pointer_cast<feature_track_state>(ts);
-      if (!fts || !fts->feature)
+      if (!m_landmark_ids.empty())
       {
-        // no feature for this track state.
-        continue;
+        m_landmark_offsets.push_back(m_landmark_edges.size());
       }
-      if (!fts->inlier)
+      m_landmark_ids.push_back(lt.first);
+    }
+    for (auto const& ts : *lt.second)
+    {
+      auto const c = camera_index(ts->frame());
+      if (c == npos)
       {
-        //outliers don't connect cameras
         continue;
       }
-      auto ci = cams.find(ts->frame());
-      if (ci == cams.end() || !ci->second)
+      auto const fts = dynamic_cast<feature_track_state*>(ts.get());
+      if (!fts || !fts->feature)
       {
-        // no camera corresponding to this track state
         continue;
       }
-      cam_clique.insert(ci->first);
+      m_landmark_edges.push_back({ static_cast<unsigned>(c), fts });
+      ++camera_counts[c + 1];
     }
-    if (cam_clique.empty())
+  }
+  if (!m_landmark_ids.empty())
+  {
+    m_landmark_offsets.push_back(m_landmark_edges.size());
+  }
+
+  // Transpose into the edges of each camera
+  std::partial_sum(camera_counts.begin(), camera_counts.end(),
+                   camera_counts.begin());
+  m_camera_offsets = camera_counts;
+  m_camera_edges.resize(m_landmark_edges.size());
+  for (size_t l = 0; l < m_landmark_ids.size(); ++l)
+  {
+    for (auto const& e : landmark_observations(l))
     {
-      continue; // nothing to do if no cameras found viewing this track.
+      m_camera_edges[camera_counts[e.index]++] =
+        { static_cast<unsigned>(l), e.state };
     }
+  }
+
+  m_camera_active.assign(m_camera_ids.size(), 1);
+  m_landmark_active.assign(m_landmark_ids.size(), 1);
+}
+
+// ----------------------------------------------------------------------------
+size_t
+camera_landmark_graph
+::camera_index(frame_id_t frame) const
+{
+  auto const it =
+    std::lower_bound(m_camera_ids.begin(), m_camera_ids.end(), frame);
+  if (it == m_camera_ids.end() || *it != frame)
+  {
+    return npos;
+  }
+  return static_cast<size_t>(it - m_camera_ids.begin());
+}
+
+// ----------------------------------------------------------------------------
+size_t
+camera_landmark_graph
+::landmark_index(landmark_id_t id) const
+{
+  auto const it =
+    std::lower_bound(m_landmark_ids.begin(), m_landmark_ids.end(), id);
+  if (it == m_landmark_ids.end() || *it != id)
+  {
+    return npos;
+  }
+  return static_cast<size_t>(it - m_landmark_ids.begin());
+}
+
+// ----------------------------------------------------------------------------
+camera_landmark_graph::observation_range
+camera_landmark_graph
+::camera_observations(size_t c) const
+{
+  auto const first = m_camera_edges.data();
+  return { first + m_camera_offsets[c], first + m_camera_offsets[c + 1] };
+}
 
-    //which of the existing cliques does cam_clique overlap with?
-    std::vector<int> overlapping_comps;
-    for (unsigned int comp_id = 0; comp_id < comps.size(); ++comp_id)
+// ----------------------------------------------------------------------------
+camera_landmark_graph::observation_range
+camera_landmark_graph
+::landmark_observations(size_t l) const
+{
+  auto const first = m_landmark_edges.data();
+  return { first + m_landmark_offsets[l], first + m_landmark_offsets[l + 1] };
+}
+
+// ----------------------------------------------------------------------------
+frame_coverage_vec
+camera_landmark_graph
+::image_coverages() const
+{
+  const int mask_w(16);
+  const int mask_h(16);
+
+  // Each camera only writes its own coverage
+  std::vector<float> coverages(m_camera_ids.size(), 0.0f);
+  vital::thread_pool::instance().parallel_for(
+    m_camera_ids.size(), 16,
+    [&](size_t begin, size_t end)
     {
-      auto &cur_comp = comps[comp_id];
-      for (auto cn : cam_clique)
+      for (size_t c = begin; c < end; ++c)
       {
-        if (cur_comp.find(cn) != cur_comp.end())
+        if (!m_camera_active[c])
         {
-          overlapping_comps.push_back(comp_id);
-          break; //go onto the next component
+          continue;
         }
+
+        // mark the mask cells holding inlier observations
+        auto const& size = m_image_sizes[c];
+        std::bitset<mask_w * mask_h> mask;
+        for (auto const& e : camera_observations(c))
+        {
+          if (!m_landmark_active[e.index] || !e.state->inlier)
+          {
+            continue;
+          }
+
+          vector_2d x = e.state->feature->loc();
+          int mask_row = int(std::max<float>(0.0f,
+            std::min<float>(mask_h*float(x.y()) / size.h, mask_h - 1)));
+          int mask_col = int(std::max<float>(0.0f,
+            std::min<float>(mask_w*float(x.x()) / size.w, mask_w - 1)));
+          mask.set(mask_row * mask_w + mask_col);
+        }
+        coverages[c] = float(mask.count()) / float(mask_w*mask_h);
       }
+    });
+
+  frame_coverage_vec ret;
+  for (size_t c = 0; c < m_camera_ids.size(); ++c)
+  {
+    if (m_camera_active[c])
+    {
+      ret.push_back(coverage_pair(m_camera_ids[c], coverages[c]));
     }
-    if (overlapping_comps.empty())
+  }
+  return ret;
+}
+
+// ----------------------------------------------------------------------------
+camera_components
+camera_landmark_graph
+::connected_components() const
+{
+  // Union-find over camera indices, joining each camera to the root of the
+  // first camera seen for the same landmark
+  std::vector<size_t> parent(m_camera_ids.size());
+  std::iota(parent.begin(), parent.end(), size_t{ 0 });
+  auto find_root = [&parent](size_t c)
+  {
+    while (parent[c] != c)
     {
-      //make a new component
-      comps.push_back(cam_clique);
+      parent[c] = parent[parent[c]];
+      c = parent[c];
     }
-    else
+    return c;
+  };
+
+  std::vector<char> connected(m_camera_ids.size(), 0);
+  for (size_t l = 0; l < m_landmark_ids.size(); ++l)
+  {
+    if (!m_landmark_active[l])
     {
-      auto &final_comp = comps[overlapping_comps[0]];
-      //add all cameras in cam_clique to final comp
-      for (auto cn : cam_clique)
+      continue;
+    }
+    size_t root = npos;
+    for (auto const& e : landmark_observations(l))
+    {
+      if (!m_camera_active[e.index] || !e.state->inlier)
       {
-        final_comp.insert(cn);
+        // outliers don't connect cameras
+        continue;
       }
-      //merge all other overlapping components into final_comp
-      for (unsigned int oc = 1; oc < overlapping_comps.size(); ++oc)
+      connected[e.index] = 1;
+      auto const r = find_root(e.index);
+      if (root == npos)
       {
-       auto &merged_comp = comps[overlapping_comps[oc]];
-        final_comp.insert(merged_comp.begin(), merged_comp.end());
+        root = r;
       }
-      //remove all merged comps except for final_comp
-      for (auto oc_it = overlapping_comps.rbegin();
-        oc_it != overlapping_comps.rend(); ++oc_it)
+      else if (r != root)
       {
-        int comp_idx = *oc_it;
-        if (comp_idx == overlapping_comps[0])
-        {
-          continue;  // we don't erase the final comp which is the first
-                     // overlapping comp
-        }
-        comps.erase(comps.begin() + comp_idx);
+        // keep the lower index as the root
+        parent[std::max(r, root)] = std::min(r, root);
+        root = std::min(r, root);
       }
     }
   }
-  return comps;
-}
 
-/// Detect critical tracks that connect disjoint components
-std::vector<track_sptr>
-detect_critical_tracks(camera_components const& cc,
-                       feature_track_set_sptr tracks)
-{
-  std::vector<track_sptr> critical_tracks;
-  // build a mapping from frame number to connected component index
-  std::map<frame_id_t, unsigned int> cc_map;
-  for (unsigned int i=0; i<cc.size(); ++i)
+  // Roots are the lowest camera of their component, so components are
+  // created in order of their lowest frame
+  camera_components comps;
+  std::vector<size_t> comp_index(m_camera_ids.size(), npos);
+  for (size_t c = 0; c < m_camera_ids.size(); ++c)
   {
-    for (auto const& f : cc[i])
+    if (!connected[c])
     {
-      cc_map[f] = i;
+      continue;
     }
-  }
-
-  // find tracks which span more than one connected component
-  for (auto const& t : tracks->tracks())
-  {
-    unsigned int first_idx = cc_map[t->first_frame()];
-    for (auto const& ts : *t)
+    auto const r = find_root(c);
+    if (comp_index[r] == npos)
     {
-      auto idx = cc_map[ts->frame()];
-      if (idx != first_idx)
-      {
-        critical_tracks.push_back(t);
-        break;
-      }
+      comp_index[r] = comps.size();
+      comps.emplace_back();
     }
+    comps[comp_index[r]].insert(m_camera_ids[c]);
   }
-  return critical_tracks;
+  return comps;
 }
 
 /// Detect underconstrained landmarks.
@@ -741,6 +832,11 @@ clean_cameras_and_landmarks(
   kwiver::vital::logger_handle_t logger(kwiver::vital::get_logger("arrows.mvg.sfm_utils"));
 
   removed_cams.clear();
+
+  // Built once; landmarks and cameras are removed from it as they are
+  // cleaned out of the solution
+  camera_landmark_graph graph(det_cams, det_lms, tracks->tracks());
+
   //loop until no changes are done to further clean up the solution
   bool keep_cleaning = true;
   while (keep_cleaning)
@@ -760,10 +856,23 @@ clean_cameras_and_landmarks(
     }
     remove_landmarks(lm_to_remove, lms);
     remove_landmarks(lm_to_remove, det_lms);
+    for (auto lm_id : lm_to_remove)
+    {
+      auto const l = graph.landmark_index(lm_id);
+      if (l != camera_landmark_graph::npos)
+      {
+        graph.remove_landmark(l);
+      }
+    }
 
-    std::set<frame_id_t> cams_to_remove =
-      detect_bad_cameras(det_cams, det_lms, tracks,
-                         static_cast<float>(image_coverage_threshold));
+    std::set<frame_id_t> cams_to_remove;
+    for (auto const& cov : graph.image_coverages())
+    {
+      if (cov.second < static_cast<float>(image_coverage_threshold))
+      {
+        cams_to_remove.insert(cov.first);
+      }
+    }
 
     for (auto frame_id : cams_to_remove)
     {
@@ -780,6 +889,7 @@ clean_cameras_and_landmarks(
 
       cams_persp.erase(frame_id);
       det_cams[frame_id] = nullptr;
+      graph.remove_camera(graph.camera_index(frame_id));
       removed_cams.push_back(frame_id);
       LOG_DEBUG(logger, "removing camera " << frame_id);
     }
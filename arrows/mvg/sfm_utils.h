@@ -16,6 +16,7 @@
 #include <vital/types/bounding_box.h>
 #include <arrows/mvg/kwiver_algo_mvg_export.h>
 
+#include <vital/range/iterator_range.h>
 #include <vital/types/feature_track_set.h>
 #include <vital/types/landmark_map.h>
 #include <vital/types/camera_map.h>
@@ -125,6 +126,110 @@ std::vector<vital::track_sptr>
 detect_critical_tracks(camera_components const& cc,
                        vital::feature_track_set_sptr tracks);
 
+/// Bipartite graph of cameras and the landmarks they observe
+///
+/// The graph stores, in compressed sparse row form, the feature track states
+/// linking each camera to the landmarks it observes and each landmark to the
+/// cameras observing it.  It is built once for a set of cameras, landmarks
+/// and tracks, after which cameras and landmarks can be removed from it
+/// without rebuilding.  Inlier flags are read from the track states when
+/// the graph is queried, so it follows outliers marked after it was built.
+/// The track states must outlive the graph.
+///
+/// Cameras and landmarks which are null are left out.  Cameras are indexed
+/// in order of frame number and landmarks in order of landmark id.
+class KWIVER_ALGO_MVG_EXPORT camera_landmark_graph
+{
+public:
+  /// An edge of the graph
+  struct observation
+  {
+    /// Index of the landmark or camera at the other end of the edge
+    unsigned index;
+    /// Observation of the landmark in the camera
+    vital::feature_track_state* state;
+  };
+
+  typedef vital::range::iterator_range<observation const*> observation_range;
+
+  /// Index returned for cameras and landmarks not in the graph
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  /// Build the graph
+  ///
+  /// \param [in] cams the cameras of the graph
+  /// \param [in] lms the landmarks of the graph
+  /// \param [in] trks the tracks of the landmarks, with the same ids
+  camera_landmark_graph(
+    vital::simple_camera_perspective_map::frame_to_T_sptr_map const& cams,
+    vital::landmark_map::map_landmark_t const& lms,
+    std::vector<vital::track_sptr> const& trks);
+
+  size_t num_cameras() const { return m_camera_ids.size(); }
+  size_t num_landmarks() const { return m_landmark_ids.size(); }
+
+  vital::frame_id_t camera_id(size_t c) const { return m_camera_ids[c]; }
+  vital::landmark_id_t landmark_id(size_t l) const { return m_landmark_ids[l]; }
+
+  /// Index of the camera of a frame, or npos
+  size_t camera_index(vital::frame_id_t frame) const;
+  /// Index of a landmark, or npos
+  size_t landmark_index(vital::landmark_id_t id) const;
+
+  bool is_camera_active(size_t c) const { return m_camera_active[c] != 0; }
+  bool is_landmark_active(size_t l) const { return m_landmark_active[l] != 0; }
+
+  /// Remove a camera, with its observations, from later queries
+  void remove_camera(size_t c) { m_camera_active[c] = 0; }
+  /// Remove a landmark, with its observations, from later queries
+  void remove_landmark(size_t l) { m_landmark_active[l] = 0; }
+
+  /// Observations in a camera, in order of landmark index
+  ///
+  /// All observations are included, whether or not the landmarks are active
+  /// or the observations are inliers.
+  observation_range camera_observations(size_t c) const;
+
+  /// Observations of a landmark, in order of camera index
+  ///
+  /// All observations are included, whether or not the cameras are active
+  /// or the observations are inliers.
+  observation_range landmark_observations(size_t l) const;
+
+  /// Fraction of each active camera image covered by inlier observations
+  ///
+  /// Computed as in image_coverages, in parallel over the cameras.
+  frame_coverage_vec image_coverages() const;
+
+  /// Connected components of active cameras
+  ///
+  /// Cameras are connected when they have inlier observations of the same
+  /// active landmark.  Cameras without such observations are in no
+  /// component.  Components are in order of their lowest frame number.
+  camera_components connected_components() const;
+
+private:
+  struct image_size
+  {
+    int w;
+    int h;
+  };
+
+  std::vector<vital::frame_id_t> m_camera_ids;
+  std::vector<image_size> m_image_sizes;
+  std::vector<vital::landmark_id_t> m_landmark_ids;
+
+  // Edges of camera c are m_camera_edges[m_camera_offsets[c]] up to
+  // m_camera_edges[m_camera_offsets[c + 1]], and likewise for landmarks
+  std::vector<size_t> m_camera_offsets;
+  std::vector<observation> m_camera_edges;
+  std::vector<size_t> m_landmark_offsets;
+  std::vector<observation> m_landmark_edges;
+
+  std::vector<char> m_camera_active;
+  std::vector<char> m_landmark_active;
+};
+
 /// Detect bad landmarks
 ///
 /// Checks landmark reprojection errors, triangulation angles and whether or not
@@ -0,0 +1,133 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test MVG homography estimation algorithm
+
+#include <test_eigen.h>
+#include <test_random_point.h>
+
+#include <arrows/mvg/algo/estimate_homography.h>
+
+#include <vital/plugin_loader/plugin_manager.h>
+
+using namespace kwiver::vital;
+using namespace kwiver::arrows;
+using namespace kwiver::testing;
+
+using mvg::estimate_homography;
+
+static constexpr double ideal_matrix_tolerance = 1e-9;
+static constexpr double ideal_norm_tolerance = 1e-8;
+
+static constexpr double noisy_matrix_tolerance = 0.05;
+static constexpr double noisy_norm_tolerance = 0.2;
+
+static constexpr double outlier_matrix_tolerance = 1e-9;
+static constexpr double outlier_norm_tolerance = 1e-8;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST(estimate_homography, create)
+{
+  plugin_manager::instance().load_all_plugins();
+
+  EXPECT_NE( nullptr, algo::estimate_homography::create("mvg") );
+}
+
+// ----------------------------------------------------------------------------
+#include <arrows/tests/test_estimate_homography.h>
+
+// ----------------------------------------------------------------------------
+// Make points with every third destination point replaced by an outlier,
+// optionally with the inliers first
+static void
+make_outlier_points( std::vector<vector_2d>& pts1,
+                     std::vector<vector_2d>& pts2,
+                     bool inliers_first )
+{
+  matrix_3x3d const true_H = sample_homography();
+  std::vector<vector_2d> outliers1, outliers2;
+  kwiver::testing::rng_t rng( 2 );
+  for( unsigned i = 0; i < 300; ++i )
+  {
+    vector_2d v2 = random_point2d( 1000.0, rng ) + vector_2d( 500.0, 500.0 );
+    vector_3d v3 = true_H * vector_3d( v2.x(), v2.y(), 1.0 );
+    if( i % 3 == 0 )
+    {
+      outliers1.push_back( v2 );
+      outliers2.push_back(
+        random_point2d( 1000.0, rng ) + vector_2d( 500.0, 500.0 ) );
+    }
+    else
+    {
+      pts1.push_back( v2 );
+      pts2.push_back( vector_2d( v3.x() / v3.z(), v3.y() / v3.z() ) );
+    }
+  }
+  auto const pos1 = inliers_first ? pts1.end() : pts1.begin();
+  pts1.insert( pos1, outliers1.begin(), outliers1.end() );
+  auto const pos2 = inliers_first ? pts2.end() : pts2.begin();
+  pts2.insert( pos2, outliers2.begin(), outliers2.end() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(estimate_homography, sampling_options)
+{
+  struct options
+  {
+    unsigned batch_size;
+    unsigned local_optimization_iterations;
+    bool progressive_sampling;
+  };
+
+  for( auto const o : { options{ 1, 4, false }, options{ 7, 0, false },
+                        options{ 64, 4, false }, options{ 16, 4, true } } )
+  {
+    SCOPED_TRACE( "Batch size " + std::to_string( o.batch_size ) +
+                  ", local optimization iterations " +
+                  std::to_string( o.local_optimization_iterations ) +
+                  ( o.progressive_sampling ? ", progressive" : "" ) );
+
+    estimate_homography estimator;
+    auto const config = estimator.get_configuration();
+    config->set_value( "batch_size", o.batch_size );
+    config->set_value( "local_optimization_iterations",
+                       o.local_optimization_iterations );
+    config->set_value( "progressive_sampling", o.progressive_sampling );
+    ASSERT_TRUE( estimator.check_configuration( config ) );
+    estimator.set_configuration( config );
+
+    std::vector<vector_2d> pts1, pts2;
+    make_outlier_points( pts1, pts2, o.progressive_sampling );
+
+    std::vector<bool> inliers;
+    auto const H = estimator.estimate( pts1, pts2, inliers );
+    ASSERT_NE( nullptr, H );
+    EXPECT_MATRIX_NEAR( sample_homography(), H->normalize()->matrix(),
+                        o.local_optimization_iterations ? 1e-9 : 1e-4 );
+    EXPECT_EQ( 200, std::count( inliers.begin(), inliers.end(), true ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(estimate_homography, check_configuration)
+{
+  estimate_homography estimator;
+  auto const config = estimator.get_configuration();
+  EXPECT_TRUE( estimator.check_configuration( config ) );
+
+  config->set_value( "confidence", 1.0 );
+  EXPECT_FALSE( estimator.check_configuration( config ) );
+
+  config->set_value( "confidence", 0.99 );
+  config->set_value( "batch_size", 0 );
+  EXPECT_FALSE( estimator.check_configuration( config ) );
+}
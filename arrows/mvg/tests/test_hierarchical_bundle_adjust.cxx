@@ -0,0 +1,178 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test hierarchical bundle adjustment
+
+#include <test_gtest.h>
+#include <test_scene.h>
+
+#include <arrows/mvg/algo/hierarchical_bundle_adjust.h>
+#include <arrows/mvg/projected_track_set.h>
+#include <arrows/mvg/transform.h>
+
+#include <vital/algo/algorithm_factory.h>
+#include <vital/plugin_loader/plugin_manager.h>
+
+#include <algorithm>
+#include <mutex>
+
+namespace kv = kwiver::vital;
+namespace algo = kwiver::vital::algo;
+
+using kwiver::arrows::mvg::hierarchical_bundle_adjust;
+
+namespace {
+
+std::mutex calls_mutex;
+std::vector< std::set< kv::frame_id_t > > calls;
+
+// ----------------------------------------------------------------------------
+// Move the solution to a different gauge for each subset of cameras, as a
+// bundle adjuster that fixes none of them may
+class test_gauge_ba : public algo::bundle_adjust
+{
+public:
+  PLUGIN_INFO( "test_gauge_ba", "Changes the gauge of the solution." )
+
+  void set_configuration( kv::config_block_sptr ) override {}
+  bool check_configuration( kv::config_block_sptr ) const override
+  {
+    return true;
+  }
+
+  void
+  optimize( kv::camera_map_sptr& cameras,
+            kv::landmark_map_sptr& landmarks,
+            kv::feature_track_set_sptr,
+            kv::sfm_constraints_sptr ) const override
+  {
+    std::set< kv::frame_id_t > frames;
+    for( auto const& p : cameras->cameras() )
+    {
+      frames.insert( p.first );
+    }
+    {
+      std::lock_guard< std::mutex > lock( calls_mutex );
+      calls.push_back( frames );
+    }
+
+    auto const first = static_cast< double >( *frames.begin() );
+    kv::similarity_d const xform{
+      1.0 + 0.1 * first,
+      kv::rotation_d{ 0.05 * first, kv::vector_3d{ 0.0, 0.0, 1.0 } },
+      kv::vector_3d{ first, 1.0, 0.0 } };
+    cameras = kwiver::arrows::mvg::transform( cameras, xform );
+    landmarks = kwiver::arrows::mvg::transform( landmarks, xform );
+  }
+};
+
+// ----------------------------------------------------------------------------
+void
+configure( hierarchical_bundle_adjust& hba, unsigned partition_size )
+{
+  auto const config = hba.get_configuration();
+  config->set_value( "sba_impl:type", "test_gauge_ba" );
+  config->set_value( "partition_size", partition_size );
+  config->set_value( "partition_overlap", 2 );
+  hba.set_configuration( config );
+  EXPECT_TRUE( hba.check_configuration( config ) );
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+
+  kv::plugin_manager::instance().add_factory(
+    new kv::algorithm_factory_0< test_gauge_ba >(
+      test_gauge_ba::static_type_name(), test_gauge_ba::_plugin_name ) );
+
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST ( hierarchical_bundle_adjust, partitions_aligned )
+{
+  auto const true_landmarks = kwiver::testing::cube_corners( 2.0 );
+  auto const true_cameras = kwiver::testing::camera_seq( 20 );
+  auto const tracks =
+    kwiver::arrows::mvg::projected_tracks( true_landmarks, true_cameras );
+
+  hierarchical_bundle_adjust hba;
+  configure( hba, 6 );
+
+  calls.clear();
+  auto cameras = true_cameras;
+  auto landmarks = true_landmarks;
+  hba.optimize( cameras, landmarks, tracks );
+
+  // Each partition of 6 cameras is solved with 2 cameras of its neighbors
+  std::sort( calls.begin(), calls.end() );
+  ASSERT_EQ( 4, calls.size() );
+  EXPECT_EQ( ( std::set< kv::frame_id_t >{ 0, 1, 2, 3, 4, 5, 6, 7 } ),
+             calls[ 0 ] );
+  EXPECT_EQ( 10, calls[ 1 ].size() );
+  EXPECT_EQ( 10, calls[ 2 ].size() );
+  EXPECT_EQ( ( std::set< kv::frame_id_t >{ 16, 17, 18, 19 } ), calls[ 3 ] );
+
+  // Each partition is moved back to the gauge of the input
+  ASSERT_EQ( true_cameras->size(), cameras->size() );
+  for( auto const& p : true_cameras->cameras() )
+  {
+    auto const expected =
+      std::dynamic_pointer_cast< kv::camera_perspective >( p.second );
+    auto const actual = std::dynamic_pointer_cast< kv::camera_perspective >(
+      cameras->cameras().at( p.first ) );
+    ASSERT_TRUE( actual );
+    EXPECT_NEAR( 0.0, ( expected->center() - actual->center() ).norm(),
+                 1e-9 ) << "Frame " << p.first;
+    EXPECT_NEAR( 0.0, ( expected->rotation().inverse()
+                        * actual->rotation() ).angle(),
+                 1e-9 ) << "Frame " << p.first;
+  }
+
+  ASSERT_EQ( true_landmarks->size(), landmarks->size() );
+  for( auto const& p : true_landmarks->landmarks() )
+  {
+    EXPECT_NEAR( 0.0, ( p.second->loc() -
+                        landmarks->landmarks().at( p.first )->loc() ).norm(),
+                 1e-9 ) << "Landmark " << p.first;
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( hierarchical_bundle_adjust, single_partition )
+{
+  auto const true_landmarks = kwiver::testing::cube_corners( 2.0 );
+  auto const true_cameras = kwiver::testing::camera_seq( 20 );
+  auto const tracks =
+    kwiver::arrows::mvg::projected_tracks( true_landmarks, true_cameras );
+
+  for( auto const partition_size : { 0u, 20u } )
+  {
+    SCOPED_TRACE( "Partition size: " + std::to_string( partition_size ) );
+
+    hierarchical_bundle_adjust hba;
+    configure( hba, partition_size );
+
+    calls.clear();
+    auto cameras = true_cameras;
+    auto landmarks = true_landmarks;
+    hba.optimize( cameras, landmarks, tracks );
+
+    // All cameras are solved together and left in the nested solver's gauge
+    ASSERT_EQ( 1, calls.size() );
+    EXPECT_EQ( 20, calls[ 0 ].size() );
+    auto const cam = std::dynamic_pointer_cast< kv::camera_perspective >(
+      cameras->cameras().at( 0 ) );
+    EXPECT_GT( ( cam->center() - std::dynamic_pointer_cast<
+                   kv::camera_perspective >( true_cameras->cameras().at( 0 ) )
+                     ->center() ).norm(), 0.1 );
+  }
+}
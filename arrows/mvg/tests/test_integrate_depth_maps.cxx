@@ -7,6 +7,7 @@
 #include <arrows/mvg/algo/integrate_depth_maps.h>
 #include <arrows/core/render_mesh_depth_map.h>
 #include <arrows/core/mesh_operations.h>
+#include <arrows/core/sparse_volume.h>
 
 #include <vital/plugin_loader/plugin_manager.h>
 #include <vital/types/camera_perspective_map.h>
@@ -205,3 +206,91 @@ TEST(integrate_depth_maps, integrate_distorted)
 
   evaluate_volume(volume, min_pt, max_pt, spacing);
 }
+
+// ----------------------------------------------------------------------------
+// Test depth map integration into a sparse volume
+TEST(integrate_depth_maps, integrate_sparse)
+{
+  namespace mvg = kwiver::arrows::mvg;
+  namespace core = kwiver::arrows::core;
+
+  std::vector< image_container_sptr > depth_maps;
+  std::vector< camera_perspective_sptr > cams;
+  vector_3d min_pt, max_pt;
+  auto K = simple_camera_intrinsics(
+    200, { 80, 60 }, 1.0, 0.0, {}, 160, 120);
+  make_test_data(depth_maps, cams, min_pt, max_pt, K);
+
+  mvg::integrate_depth_maps algorithm;
+  config_block_sptr config = algorithm.get_configuration();
+  config->set_value("voxel_spacing_factor", 1.0);
+  config->set_value("brick_size", 4);
+  algorithm.set_configuration(config);
+  image_container_sptr volume = nullptr;
+  vector_3d spacing{ 1.0, 1.0, 1.0 };
+  algorithm.integrate(min_pt, max_pt,
+                      depth_maps, {}, cams, volume, spacing);
+
+  core::sparse_volume sparse;
+  vector_3d sparse_spacing{ 1.0, 1.0, 1.0 };
+  cpu_timer timer;
+  timer.start();
+  algorithm.integrate_sparse(min_pt, max_pt,
+                             depth_maps, {}, cams, sparse, sparse_spacing);
+  timer.stop();
+  std::cout << "sparse integration time: " << timer.elapsed() << std::endl;
+
+  EXPECT_EQ(spacing, sparse_spacing);
+  ASSERT_EQ(volume->width(), sparse.width());
+  ASSERT_EQ(volume->height(), sparse.height());
+  ASSERT_EQ(volume->depth(), sparse.depth());
+  EXPECT_EQ(4, sparse.brick_size());
+
+  // only the bricks near the surface should be allocated
+  auto const bricks_along = [](size_t n) { return (n + 3) / 4; };
+  size_t const dense_bricks = bricks_along(sparse.width()) *
+                              bricks_along(sparse.height()) *
+                              bricks_along(sparse.depth());
+  std::cout << "allocated " << sparse.num_bricks() << " of "
+            << dense_bricks << " bricks" << std::endl;
+  EXPECT_GT(sparse.num_bricks(), 0);
+  EXPECT_LT(sparse.num_bricks(), dense_bricks);
+
+  // allocated voxels should match the dense volume
+  image_of<double> dense(volume->get_image());
+  size_t allocated = 0;
+  for (size_t k = 0; k < dense.depth(); ++k)
+  {
+    for (size_t j = 0; j < dense.height(); ++j)
+    {
+      for (size_t i = 0; i < dense.width(); ++i)
+      {
+        if (sparse.is_allocated(i, j, k))
+        {
+          ++allocated;
+          EXPECT_NEAR(dense(i, j, k), sparse.value(i, j, k), 1e-9);
+        }
+      }
+    }
+  }
+  EXPECT_GT(allocated, 0);
+
+  // the voxels near the surface should all be allocated
+  for (auto const& p : { vector_3d{ 0.5, 0.0, 0.0 },
+                         vector_3d{ 0.0, 0.5, 0.0 },
+                         vector_3d{ 0.49, 0.49, 0.0 },
+                         vector_3d{ 0.0, 0.0, 1.0 } })
+  {
+    Eigen::Vector3i index =
+      ((p - min_pt).array() / spacing.array()).cast<int>();
+    EXPECT_TRUE(sparse.is_allocated(index[0], index[1], index[2]))
+      << "at " << p.transpose();
+  }
+
+  // the dense conversion should give the same volume where allocated
+  auto const nan = std::numeric_limits<double>::quiet_NaN();
+  auto const converted = sparse.to_image(nan);
+  ASSERT_EQ(dense.size(), converted.size());
+  EXPECT_TRUE(std::isnan(converted(0, 0, 0)) ||
+              sparse.is_allocated(0, 0, 0));
+}
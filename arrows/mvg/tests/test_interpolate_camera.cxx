@@ -119,3 +119,51 @@ TEST(interpolate_camera, multiple_interpolations)
 // detailed to do this for camera rings along each major axis plane, as well
 // as for a stare-point that is not at along the axis of rotation for the
 // camera ring.
+
+// ----------------------------------------------------------------------------
+TEST(interpolate_camera, batch_interpolation)
+{
+  using namespace kwiver;
+  using vital::vector_3d;
+  using vital::rotation_d;
+  using vital::simple_camera_perspective;
+
+  auto a = std::make_shared<simple_camera_perspective>(
+             vector_3d(-1, -1, -1), rotation_d());
+  auto b = std::make_shared<simple_camera_perspective>(
+             vector_3d(3, 3, 3), rotation_d(-pi / 2, vector_3d(0, 0, 1)));
+  auto c = std::make_shared<simple_camera_perspective>(
+             vector_3d(3, 7, 3), rotation_d(pi / 3, vector_3d(1, 0, 0)));
+
+  vital::camera_map::map_camera_t cams;
+  cams[10] = a;
+  cams[14] = b;
+  cams[20] = c;
+
+  std::vector<vital::frame_id_t> frames{ 5, 10, 11, 13, 14, 17, 25 };
+  auto const interp = arrows::mvg::interpolate_cameras(cams, frames);
+
+  // frames outside the cameras are left out, known frames are unchanged
+  EXPECT_EQ(5, interp.size());
+  EXPECT_EQ(0, interp.count(5));
+  EXPECT_EQ(0, interp.count(25));
+  EXPECT_EQ(a, interp.at(10));
+  EXPECT_EQ(b, interp.at(14));
+
+  // others match interpolating one camera at a time
+  auto const check = [&](vital::frame_id_t f,
+                         simple_camera_perspective const& A,
+                         simple_camera_perspective const& B, double t)
+  {
+    auto const expected = arrows::mvg::interpolate_camera(A, B, t);
+    auto const cam =
+      std::dynamic_pointer_cast<vital::camera_perspective>(interp.at(f));
+    ASSERT_TRUE(cam);
+    EXPECT_NEAR(0.0, (expected.center() - cam->center()).norm(), 1e-12);
+    EXPECT_NEAR(0.0, (expected.rotation().inverse() *
+                      cam->rotation()).angle(), 1e-12);
+  };
+  check(11, *a, *b, 0.25);
+  check(13, *a, *b, 0.75);
+  check(17, *b, *c, 0.5);
+}
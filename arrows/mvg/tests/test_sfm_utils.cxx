@@ -0,0 +1,173 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include <arrows/mvg/sfm_utils.h>
+
+#include <gtest/gtest.h>
+
+using namespace kwiver::vital;
+using kwiver::arrows::mvg::camera_landmark_graph;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Two groups of three cameras, each seeing five landmarks of its own
+struct sfm_scene
+{
+  sfm_scene()
+  {
+    simple_camera_intrinsics const K(1000, { 640, 480 });
+    for (frame_id_t f = 0; f < 6; ++f)
+    {
+      cams[f] = std::make_shared<simple_camera_perspective>(
+        vector_3d(f, 0, -10), rotation_d(), K);
+    }
+
+    for (landmark_id_t l = 0; l < 12; ++l)
+    {
+      auto t = track::create();
+      t->set_id(l);
+      trks.push_back(t);
+      if (l < 10)
+      {
+        lms[l] = std::make_shared<landmark_d>(vector_3d(0, 0, 0));
+      }
+    }
+    // landmark 11 has been removed but is still in the map
+    lms[11] = nullptr;
+
+    // Each landmark is seen in a different 16x16 mask cell
+    for (landmark_id_t l = 0; l < 10; ++l)
+    {
+      frame_id_t const first = (l < 5 ? 0 : 3);
+      for (frame_id_t f = first; f < first + 3; ++f)
+      {
+        observe(l, f, true);
+      }
+    }
+
+    // Landmark 10 has no landmark, so it does not connect the groups
+    observe(10, 2, true);
+    observe(10, 3, true);
+    observe(11, 2, true);
+    observe(11, 3, true);
+
+    // Neither does an outlier observation
+    bridge = observe(9, 2, false);
+  }
+
+  feature_track_state_sptr
+  observe(landmark_id_t l, frame_id_t f, bool inlier)
+  {
+    auto fts = std::make_shared<feature_track_state>(f);
+    fts->feature = std::make_shared<feature_d>(
+      vector_2d(80.0 * l + 40.0, 60.0 * l + 30.0));
+    fts->inlier = inlier;
+    trks[l]->insert(fts);
+    return fts;
+  }
+
+  simple_camera_perspective_map::frame_to_T_sptr_map cams;
+  landmark_map::map_landmark_t lms;
+  std::vector<track_sptr> trks;
+  feature_track_state_sptr bridge;
+};
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+TEST(sfm_utils, camera_landmark_graph)
+{
+  sfm_scene scene;
+  camera_landmark_graph graph(scene.cams, scene.lms, scene.trks);
+
+  ASSERT_EQ(6, graph.num_cameras());
+  ASSERT_EQ(10, graph.num_landmarks());
+  EXPECT_EQ(4, graph.camera_id(4));
+  EXPECT_EQ(7, graph.landmark_id(7));
+  EXPECT_EQ(camera_landmark_graph::npos, graph.camera_index(6));
+  EXPECT_EQ(camera_landmark_graph::npos, graph.landmark_index(10));
+  EXPECT_EQ(camera_landmark_graph::npos, graph.landmark_index(11));
+
+  EXPECT_EQ(5, graph.camera_observations(0).size());
+  EXPECT_EQ(6, graph.camera_observations(2).size());
+  EXPECT_EQ(4, graph.landmark_observations(9).size());
+
+  unsigned last = 0;
+  for (auto const& e : graph.camera_observations(2))
+  {
+    EXPECT_LE(last, e.index);
+    EXPECT_EQ(2, e.state->frame());
+    last = e.index;
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(sfm_utils, connected_components)
+{
+  sfm_scene scene;
+  camera_landmark_graph graph(scene.cams, scene.lms, scene.trks);
+
+  auto cc = graph.connected_components();
+  ASSERT_EQ(2, cc.size());
+  EXPECT_EQ((std::unordered_set<frame_id_t>{ 0, 1, 2 }), cc[0]);
+  EXPECT_EQ((std::unordered_set<frame_id_t>{ 3, 4, 5 }), cc[1]);
+
+  // Inlier flags are read when the graph is queried
+  scene.bridge->inlier = true;
+  cc = graph.connected_components();
+  ASSERT_EQ(1, cc.size());
+  EXPECT_EQ(6, cc[0].size());
+
+  graph.remove_landmark(graph.landmark_index(9));
+  graph.remove_camera(graph.camera_index(4));
+  cc = graph.connected_components();
+  ASSERT_EQ(2, cc.size());
+  EXPECT_EQ((std::unordered_set<frame_id_t>{ 0, 1, 2 }), cc[0]);
+  EXPECT_EQ((std::unordered_set<frame_id_t>{ 3, 5 }), cc[1]);
+
+  auto const tracks = std::make_shared<feature_track_set>(scene.trks);
+  auto const free_cc =
+    kwiver::arrows::mvg::connected_camera_components(scene.cams, scene.lms,
+                                                     tracks);
+  EXPECT_EQ(1, free_cc.size());
+}
+
+// ----------------------------------------------------------------------------
+TEST(sfm_utils, image_coverages)
+{
+  sfm_scene scene;
+  camera_landmark_graph graph(scene.cams, scene.lms, scene.trks);
+
+  auto cov = graph.image_coverages();
+  ASSERT_EQ(6, cov.size());
+  for (frame_id_t f = 0; f < 6; ++f)
+  {
+    EXPECT_EQ(f, cov[f].first);
+    EXPECT_FLOAT_EQ(5.0f / 256.0f, cov[f].second);
+  }
+
+  graph.remove_landmark(graph.landmark_index(0));
+  graph.remove_camera(graph.camera_index(1));
+  cov = graph.image_coverages();
+  ASSERT_EQ(5, cov.size());
+  EXPECT_EQ(0, cov[0].first);
+  EXPECT_FLOAT_EQ(4.0f / 256.0f, cov[0].second);
+  EXPECT_EQ(2, cov[1].first);
+  EXPECT_FLOAT_EQ(4.0f / 256.0f, cov[1].second);
+  EXPECT_EQ(3, cov[2].first);
+  EXPECT_FLOAT_EQ(5.0f / 256.0f, cov[2].second);
+
+  auto const free_cov =
+    kwiver::arrows::mvg::image_coverages(scene.trks, scene.lms, scene.cams);
+  ASSERT_EQ(6, free_cov.size());
+  EXPECT_FLOAT_EQ(5.0f / 256.0f, free_cov[0].second);
+}
@@ -360,3 +360,38 @@ TEST(triangulate_landmarks, noisy_tracks_homog_ransac)
   tri_lm.set_configuration(cfg);
   kwiver::testing::test_noisy_tracks(tri_lm);
 }
+
+// ----------------------------------------------------------------------------
+// RANSAC triangulation gives the same landmarks on every run
+TEST(triangulate_landmarks, ransac_repeatable)
+{
+  using namespace kwiver::vital;
+
+  kwiver::arrows::mvg::triangulate_landmarks tri_lm;
+  config_block_sptr cfg = tri_lm.get_configuration();
+  cfg->set_value("ransac", "true");
+  tri_lm.set_configuration(cfg);
+
+  landmark_map_sptr landmarks = kwiver::testing::cube_corners(2.0);
+  camera_map_sptr cameras = kwiver::testing::camera_seq();
+  feature_track_set_sptr tracks = kwiver::testing::noisy_tracks(
+    kwiver::arrows::mvg::projected_tracks(landmarks, cameras), 1.0);
+  landmark_id_t num_landmarks =
+    static_cast<landmark_id_t>(landmarks->size());
+
+  landmark_map_sptr landmarks1 =
+    kwiver::testing::init_landmarks(num_landmarks);
+  landmark_map_sptr landmarks2 =
+    kwiver::testing::init_landmarks(num_landmarks);
+  tri_lm.triangulate(cameras, tracks, landmarks1);
+  tri_lm.triangulate(cameras, tracks, landmarks2);
+
+  auto const lms1 = landmarks1->landmarks();
+  auto const lms2 = landmarks2->landmarks();
+  ASSERT_EQ(lms1.size(), lms2.size());
+  for (auto const& p : lms1)
+  {
+    ASSERT_EQ(1, lms2.count(p.first));
+    EXPECT_EQ(p.second->loc(), lms2.at(p.first)->loc());
+  }
+}
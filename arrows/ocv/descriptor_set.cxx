@@ -8,6 +8,7 @@
 #include "descriptor_set.h"
 
 #include <vital/exceptions.h>
+#include <vital/types/packed_descriptor_set.h>
 
 /// This macro applies another macro to all of the types listed below.
 #define APPLY_TO_TYPES(MACRO) \
@@ -22,28 +23,16 @@ namespace ocv {
 namespace
 {
 
-/// Templated helper function to convert matrix row into a descriptor
+/// Templated helper function to wrap a matrix row as a descriptor
+///
+/// The descriptor refers to the matrix data instead of copying it, and holds
+/// \p m to keep that data alive.
 template <typename T>
 vital::descriptor_sptr
-ocv_to_vital_descriptor(const cv::Mat& v)
+ocv_to_vital_descriptor(const std::shared_ptr<cv::Mat>& m, int index)
 {
-  vital::descriptor_array_of<T>* d = NULL;
-  switch(v.cols)
-  {
-  case 64:
-    d = new vital::descriptor_fixed<T,64>();
-    break;
-  case 128:
-    d = new vital::descriptor_fixed<T,128>();
-    break;
-  case 256:
-    d = new vital::descriptor_fixed<T,256>();
-    break;
-  default:
-    d = new vital::descriptor_dynamic<T>(v.cols);
-  }
-  std::copy(v.begin<T>(), v.end<T>(), d->raw_data());
-  return vital::descriptor_sptr(d);
+  return std::make_shared<vital::descriptor_view<T> >(
+    std::shared_ptr<T>(m, m->ptr<T>(index)), m->cols);
 }
 
 /// Templated helper function to convert descriptors into a cv::Mat
@@ -119,13 +108,15 @@ descriptor_set
 ::descriptors() const
 {
   std::vector<vital::descriptor_sptr> desc;
-  const unsigned num_desc = data_.rows;
+  const int num_desc = data_.rows;
+  desc.reserve(num_desc);
+  auto const owner = std::make_shared<cv::Mat>(data_);
   /// \cond DoxygenSuppress
 #define CONVERT_CASE(T) \
   case cv::DataType<T>::type: \
-  for( unsigned i=0; i<num_desc; ++i ) \
+  for( int i=0; i<num_desc; ++i ) \
   { \
-    desc.push_back(ocv_to_vital_descriptor<T>(data_.row(i))); \
+    desc.push_back(ocv_to_vital_descriptor<T>(owner, i)); \
   } \
   break
 
@@ -152,6 +143,24 @@ descriptors_to_ocv_matrix(const vital::descriptor_set& desc_set)
   {
     return d->ocv_desc_matrix();
   }
+  // if the descriptor set is packed then wrap its buffer without copying
+  /// \cond DoxygenSuppress
+#define CONVERT_CASE(T) \
+  if( const vital::packed_descriptor_set<T>* p = \
+          dynamic_cast<const vital::packed_descriptor_set<T>*>(&desc_set) ) \
+  { \
+    if( p->empty() ) \
+    { \
+      return cv::Mat(); \
+    } \
+    return cv::Mat(static_cast<int>(p->size()), \
+                   static_cast<int>(p->dimension()), \
+                   cv::DataType<T>::type, const_cast<T*>(p->raw_data()), \
+                   p->stride() * sizeof(T)); \
+  }
+  APPLY_TO_TYPES(CONVERT_CASE);
+#undef CONVERT_CASE
+  /// \endcond
   std::vector<vital::descriptor_sptr> desc = desc_set.descriptors();
   if( desc.empty() || !desc[0] )
   {
@@ -178,7 +187,8 @@ ::at( size_t index )
   /// \cond DoxygenSuppress
 #define CONVERT_CASE(T) \
   case cv::DataType<T>::type:                   \
-  return ocv_to_vital_descriptor<T>( data_.row(index) );
+  return ocv_to_vital_descriptor<T>( std::make_shared<cv::Mat>(data_), \
+                                     static_cast<int>(index) );
 
   switch(data_.type())
   {
@@ -199,7 +209,8 @@ ::at( size_t index ) const
   /// \cond DoxygenSuppress
 #define CONVERT_CASE(T)                         \
   case cv::DataType<T>::type:                   \
-    return ocv_to_vital_descriptor<T>( data_.row(index) );
+    return ocv_to_vital_descriptor<T>( std::make_shared<cv::Mat>(data_), \
+                                     static_cast<int>(index) );
 
   switch(data_.type())
   {
@@ -220,7 +231,9 @@ ::get_iter_next_func()
   // Variable for copy into the lambda instance to hold the current row
   // descriptor reference.
   vital::descriptor_sptr d_sptr;
-  return [row_counter,d_sptr,this] () mutable ->iterator::reference {
+  // Shared header of the matrix which the returned descriptors refer to.
+  auto owner = std::make_shared<cv::Mat>(data_);
+  return [row_counter,d_sptr,owner,this] () mutable ->iterator::reference {
     if( row_counter >= size() )
     {
       VITAL_THROW( vital::stop_iteration_exception, "descriptor_set" );
@@ -229,7 +242,8 @@ ::get_iter_next_func()
   /// \cond DoxygenSuppress
 #define CONVERT_CASE(T) \
     case cv::DataType<T>::type:                                         \
-      d_sptr = ocv_to_vital_descriptor<T>( data_.row(row_counter++) ); \
+      d_sptr = ocv_to_vital_descriptor<T>( owner, \
+                                        static_cast<int>(row_counter++) ); \
       break;
 
   switch(data_.type())
@@ -253,7 +267,9 @@ ::get_const_iter_next_func() const
   // Variable for copy into the lambda instance to hold the current row
   // descriptor reference.
   vital::descriptor_sptr d_sptr;
-  return [row_counter,d_sptr,this] () mutable ->const_iterator::reference {
+  // Shared header of the matrix which the returned descriptors refer to.
+  auto owner = std::make_shared<cv::Mat>(data_);
+  return [row_counter,d_sptr,owner,this] () mutable ->const_iterator::reference {
     if( row_counter >= size() )
     {
       VITAL_THROW( vital::stop_iteration_exception, "descriptor_set" );
@@ -262,7 +278,8 @@ ::get_const_iter_next_func() const
   /// \cond DoxygenSuppress
 #define CONVERT_CASE(T)                         \
   case cv::DataType<T>::type:                   \
-    d_sptr = ocv_to_vital_descriptor<T>( data_.row(row_counter++) ); \
+    d_sptr = ocv_to_vital_descriptor<T>( owner, \
+                                        static_cast<int>(row_counter++) ); \
     break;
 
   switch(data_.type())
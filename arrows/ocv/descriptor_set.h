@@ -36,6 +36,8 @@ class KWIVER_ALGO_OCV_EXPORT descriptor_set
   virtual bool empty() const override { return size() == 0; }
 
   /// Return a vector of descriptor shared pointers
+  ///
+  /// The descriptors refer to the rows of the matrix rather than copying them.
   virtual std::vector<vital::descriptor_sptr> descriptors() const;
 
   /// Return the native OpenCV descriptors as a matrix
@@ -54,6 +56,10 @@ class KWIVER_ALGO_OCV_EXPORT descriptor_set
 
 /// Convert any descriptor set to an OpenCV cv::Mat
 ///
+/// OpenCV and packed descriptor sets are returned without copying. A matrix
+/// made from a packed set refers to its buffer, so it is only valid while
+/// \p desc_set or another owner of that buffer exists.
+///
 /// \param desc_set descriptors to convert to cv::mat
 KWIVER_ALGO_OCV_EXPORT cv::Mat
 descriptors_to_ocv_matrix(const vital::descriptor_set& desc_set);
@@ -7,11 +7,19 @@
 
 #include "detect_features.h"
 
+#include <algorithm>
 #include <vector>
 
 #include <opencv2/imgproc/imgproc.hpp>
 
+#ifdef KWIVER_OCV_HAS_CUDA_FEATURES
+#include <opencv2/core/cuda.hpp>
+#endif
+
 #include <vital/exceptions/image.h>
+#include <vital/types/image_tiling.h>
+#include <vital/util/thread_pool.h>
+#include <vital/util/trace.h>
 #include <arrows/ocv/feature_set.h>
 #include <arrows/ocv/image_container.h>
 
@@ -21,11 +29,169 @@ namespace kwiver {
 namespace arrows {
 namespace ocv {
 
+namespace {
+
+// ----------------------------------------------------------------------------
+/// Keep at most \p count of the strongest keypoints
+void
+retain_best( std::vector<cv::KeyPoint>& keypoints, size_t count )
+{
+  if( keypoints.size() <= count )
+  {
+    return;
+  }
+
+  std::nth_element( keypoints.begin(), keypoints.begin() + count,
+                    keypoints.end(),
+                    []( cv::KeyPoint const& a, cv::KeyPoint const& b ){
+                      return a.response > b.response;
+                    } );
+  keypoints.resize( count );
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+detect_features
+::get_configuration() const
+{
+  auto config = vital::algo::detect_features::get_configuration();
+
+  config->set_value( "tile_size", tile_size,
+                     "If positive, images larger than this many pixels on "
+                     "a side are divided into square tiles of this size, "
+                     "which are detected in parallel. Features are kept "
+                     "only from the part of each tile closest to its "
+                     "center." );
+  config->set_value( "tile_overlap", tile_overlap,
+                     "Number of pixels shared by neighboring tiles. Half of "
+                     "this should be at least the border the detector needs "
+                     "around a feature." );
+  config->set_value( "features_per_tile", features_per_tile,
+                     "If positive and tile_size is set, only this many of "
+                     "the strongest features of each tile are kept, which "
+                     "spreads the features evenly over the image." );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+detect_features
+::set_detect_configuration( vital::config_block_sptr const& config )
+{
+  tile_size = config->get_value<unsigned>( "tile_size", tile_size );
+  tile_overlap = config->get_value<unsigned>( "tile_overlap", tile_overlap );
+  features_per_tile =
+    config->get_value<unsigned>( "features_per_tile", features_per_tile );
+
+  if( tile_size && tile_overlap >= tile_size )
+  {
+    LOG_WARN( logger(), "tile_overlap must be less than tile_size; "
+                        "using no overlap" );
+    tile_overlap = 0;
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+detect_features
+::detect_tiles( cv::Mat const& image, cv::Mat const& mask,
+                std::vector<cv::KeyPoint>& keypoints ) const
+{
+  vital::image_tiling const tiling{
+    static_cast<size_t>( image.cols ), static_cast<size_t>( image.rows ),
+    tile_size, tile_size, tile_overlap };
+
+  std::vector< std::vector<cv::KeyPoint> > tile_keypoints( tiling.size() );
+  vital::thread_pool::instance().parallel_for(
+    tiling.size(), 1,
+    [&]( size_t begin, size_t end ){
+      for( size_t i = begin; i < end; ++i )
+      {
+        auto const tile = tiling.tile( i );
+        auto const core = tiling.core( i );
+        cv::Rect const roi{ tile.min_x(), tile.min_y(),
+                            tile.width(), tile.height() };
+
+        auto& kps = tile_keypoints[ i ];
+        detector->detect( image( roi ), kps,
+                          mask.empty() ? cv::Mat{} : mask( roi ) );
+
+        // move the keypoints into the image and keep those of the core
+        auto const is_outside = [&]( cv::KeyPoint& kp ){
+          kp.pt.x += static_cast<float>( roi.x );
+          kp.pt.y += static_cast<float>( roi.y );
+          return kp.pt.x < core.min_x() || kp.pt.x >= core.max_x() ||
+                 kp.pt.y < core.min_y() || kp.pt.y >= core.max_y();
+        };
+        kps.erase( std::remove_if( kps.begin(), kps.end(), is_outside ),
+                   kps.end() );
+
+        if( features_per_tile )
+        {
+          retain_best( kps, features_per_tile );
+        }
+      }
+    } );
+
+  keypoints.clear();
+  for( auto const& kps : tile_keypoints )
+  {
+    keypoints.insert( keypoints.end(), kps.begin(), kps.end() );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+detect_features
+::retain_best_per_tile( std::vector<cv::KeyPoint>& keypoints,
+                        size_t width, size_t height ) const
+{
+  vital::image_tiling const tiling{
+    width, height, tile_size, tile_size, tile_overlap };
+
+  // the cores of a row or column of tiles share their bounds
+  std::vector<float> column_ends, row_ends;
+  for( size_t c = 0; c < tiling.columns(); ++c )
+  {
+    column_ends.push_back( static_cast<float>( tiling.core( c ).max_x() ) );
+  }
+  for( size_t r = 0; r < tiling.rows(); ++r )
+  {
+    row_ends.push_back(
+      static_cast<float>( tiling.core( r * tiling.columns() ).max_y() ) );
+  }
+
+  std::vector< std::vector<cv::KeyPoint> > tile_keypoints( tiling.size() );
+  for( auto const& kp : keypoints )
+  {
+    auto const c = std::min<size_t>(
+      std::upper_bound( column_ends.begin(), column_ends.end(), kp.pt.x ) -
+      column_ends.begin(), tiling.columns() - 1 );
+    auto const r = std::min<size_t>(
+      std::upper_bound( row_ends.begin(), row_ends.end(), kp.pt.y ) -
+      row_ends.begin(), tiling.rows() - 1 );
+    tile_keypoints[ r * tiling.columns() + c ].push_back( kp );
+  }
+
+  keypoints.clear();
+  for( auto& kps : tile_keypoints )
+  {
+    retain_best( kps, features_per_tile );
+    keypoints.insert( keypoints.end(), kps.begin(), kps.end() );
+  }
+}
+
+// ----------------------------------------------------------------------------
 /// Extract a set of image features from the provided image
 vital::feature_set_sptr
 detect_features
 ::detect(vital::image_container_sptr image_data, vital::image_container_sptr mask) const
 {
+  KWIVER_TRACE_SCOPE( "ocv::detect_features" );
+
   cv::Mat cv_img = image_container::vital_to_ocv(image_data->get_image(), ocv::image_container::BGR_COLOR );
   cv::Mat cv_mask;
   std::vector<cv::KeyPoint> keypoints;
@@ -57,7 +223,50 @@ ::detect(vital::image_container_sptr image_data, vital::image_container_sptr mas
     cv::threshold(cv_mask, cv_mask, 128, 255, cv::THRESH_BINARY);
   }
 
-  detector->detect(cv_img, keypoints, cv_mask);
+  auto const width = static_cast<size_t>( cv_img.cols );
+  auto const height = static_cast<size_t>( cv_img.rows );
+  auto const tiled = tile_size && ( width > tile_size || height > tile_size );
+  {
+    KWIVER_TRACE_SCOPE( "ocv::detect_features::detect" );
+    if( detector_on_gpu )
+    {
+#ifdef KWIVER_OCV_HAS_CUDA_FEATURES
+      // the CUDA detectors take the whole frame at once, as one gray image
+      cv::Mat gray;
+      if( cv_img.channels() == 1 )
+      {
+        gray = cv_img;
+      }
+      else
+      {
+        cv::cvtColor( cv_img, gray, cv::COLOR_BGR2GRAY );
+      }
+      cv::cuda::GpuMat const gpu_img{ gray };
+      cv::cuda::GpuMat gpu_mask;
+      if( !cv_mask.empty() )
+      {
+        gpu_mask.upload( cv_mask );
+      }
+      detector->detect( gpu_img, keypoints, gpu_mask );
+#endif
+      if( tile_size && features_per_tile )
+      {
+        retain_best_per_tile( keypoints, width, height );
+      }
+    }
+    else if( tiled )
+    {
+      detect_tiles( cv_img, cv_mask, keypoints );
+    }
+    else
+    {
+      detector->detect(cv_img, keypoints, cv_mask);
+      if( tile_size && features_per_tile )
+      {
+        retain_best( keypoints, features_per_tile );
+      }
+    }
+  }
   return feature_set_sptr(new feature_set(keypoints));
 }
 
@@ -12,7 +12,14 @@
 
 #include <arrows/ocv/kwiver_algo_ocv_export.h>
 
+#include <vector>
+
 #include <opencv2/features2d/features2d.hpp>
+#include <opencv2/opencv_modules.hpp>
+
+#if defined(HAVE_OPENCV_CUDAFEATURES2D) && KWIVER_OPENCV_VERSION_MAJOR >= 3
+#define KWIVER_OCV_HAS_CUDA_FEATURES
+#endif
 
 namespace kwiver {
 namespace arrows {
@@ -22,10 +29,19 @@ namespace ocv {
 ///
 /// This extended algorithm_def provides a common implementation for the detect
 /// method.
+///
+/// Large images may be divided into overlapping tiles, which are detected in
+/// parallel on the vital thread pool. Features are kept only from the core of
+/// each tile, so none are found twice, and optionally only the strongest
+/// features of each tile are kept, which spreads the features evenly over
+/// the image without a global non-maximum suppression.
 class KWIVER_ALGO_OCV_EXPORT detect_features
   : public kwiver::vital::algo::detect_features
 {
 public:
+  /// Get the configuration shared by OCV feature detectors
+  virtual vital::config_block_sptr get_configuration() const;
+
   /// Extract a set of image features from the provided image
   ///
   /// A given mask image should be one-channel (mask->depth() == 1). If the
@@ -42,8 +58,29 @@ class KWIVER_ALGO_OCV_EXPORT detect_features
          vital::image_container_sptr mask = vital::image_container_sptr()) const;
 
 protected:
+  /// Set the configuration shared by OCV feature detectors
+  ///
+  /// Derived classes call this from set_configuration.
+  void set_detect_configuration( vital::config_block_sptr const& config );
+
   /// the feature detector algorithm
   cv::Ptr<cv::FeatureDetector> detector;
+
+  /// set if \c detector is an OpenCV CUDA detector of grayscale GpuMat images
+  bool detector_on_gpu = false;
+
+private:
+  /// Detect features in each tile of a tiling of the image in parallel
+  void detect_tiles( cv::Mat const& image, cv::Mat const& mask,
+                     std::vector<cv::KeyPoint>& keypoints ) const;
+
+  /// Keep only the features_per_tile strongest features of each tile core
+  void retain_best_per_tile( std::vector<cv::KeyPoint>& keypoints,
+                             size_t width, size_t height ) const;
+
+  unsigned tile_size = 0;
+  unsigned tile_overlap = 64;
+  unsigned features_per_tile = 0;
 };
 
 } // end namespace ocv
@@ -152,6 +152,7 @@ ::set_configuration(vital::config_block_sptr config)
   config_block_sptr c = get_configuration();
   c->merge_config( config );
   p_->set_config( c );
+  set_detect_configuration( c );
   p_->update( detector.dynamicCast<cv::AgastFeatureDetector>() );
 }
 
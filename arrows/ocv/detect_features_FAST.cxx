@@ -7,6 +7,10 @@
 
 #include "detect_features_FAST.h"
 
+#ifdef KWIVER_OCV_HAS_CUDA_FEATURES
+#include <opencv2/cudafeatures2d.hpp>
+#endif
+
 using namespace kwiver::vital;
 
 namespace kwiver {
@@ -20,7 +24,9 @@ class detect_features_FAST::priv
   priv()
     : threshold(10),
       nonmaxSuppression(true),
-      targetNumDetections(2500)
+      targetNumDetections(2500),
+      use_cuda(false),
+      cuda_max_features(50000)
   {
 #if KWIVER_OPENCV_VERSION_MAJOR >= 3
     neighborhood_type = cv::FastFeatureDetector::TYPE_9_16;
@@ -42,9 +48,28 @@ class detect_features_FAST::priv
 #endif
   }
 
+#ifdef KWIVER_OCV_HAS_CUDA_FEATURES
+  /// Create a new CUDA FAST detector instance with the current parameter values
+  cv::Ptr<cv::cuda::FastFeatureDetector> create_cuda() const
+  {
+    return cv::cuda::FastFeatureDetector::create(threshold, nonmaxSuppression,
+                                                 neighborhood_type,
+                                                 cuda_max_features);
+  }
+#endif
+
   /// Update the parameters of the given detector with the currently set values
   void update(cv::Ptr<cv::FeatureDetector> detector) const
   {
+#ifdef KWIVER_OCV_HAS_CUDA_FEATURES
+    auto cuda_det = detector.dynamicCast<cv::cuda::FastFeatureDetector>();
+    if( !cuda_det.empty() )
+    {
+      // the other parameters are fixed when the CUDA detector is created
+      cuda_det->setThreshold(threshold);
+      return;
+    }
+#endif
 #if KWIVER_OPENCV_VERSION_MAJOR < 3
     detector->set("threshold", threshold);
     detector->set("nonmaxSuppression", nonmaxSuppression);
@@ -81,6 +106,13 @@ class detect_features_FAST::priv
                       "algorithm tries to output approximately this many features. "
                       "Disable by setting to negative value.");
 
+    config->set_value("use_cuda", use_cuda,
+                      "Detect on the GPU with the OpenCV CUDA FAST detector, "
+                      "if OpenCV was built with it. The CUDA detector only "
+                      "supports the 9_16 neighborhood type.");
+    config->set_value("cuda_max_features", cuda_max_features,
+                      "Maximum number of features the CUDA detector finds in "
+                      "a frame.");
   }
 
   /// Set parameter values based on given config block
@@ -95,6 +127,8 @@ class detect_features_FAST::priv
         config->get_value<int>( "neighborhood_type" ) );
 #endif
     targetNumDetections = config->get_value<int>("target_num_features_detected");
+    use_cuda = config->get_value<bool>("use_cuda");
+    cuda_max_features = config->get_value<int>("cuda_max_features");
   }
 
   /// Check config parameter values
@@ -131,6 +165,8 @@ class detect_features_FAST::priv
 #endif
 #endif
   int targetNumDetections;
+  bool use_cuda;
+  int cuda_max_features;
 };
 
 /// Constructor
@@ -164,6 +200,28 @@ ::set_configuration(vital::config_block_sptr in_config)
   vital::config_block_sptr config = get_configuration();
   config->merge_config( in_config );
   p_->set_config( config );
+  set_detect_configuration( config );
+
+#ifdef KWIVER_OCV_HAS_CUDA_FEATURES
+  // The CUDA detector can only change its threshold, so recreate it
+  if( p_->use_cuda )
+  {
+    detector = p_->create_cuda();
+    detector_on_gpu = true;
+    return;
+  }
+#else
+  if( p_->use_cuda )
+  {
+    LOG_WARN( logger(), "OpenCV was built without CUDA feature detectors; "
+                        "detecting on the CPU" );
+  }
+#endif
+  if( detector_on_gpu )
+  {
+    detector = p_->create();
+    detector_on_gpu = false;
+  }
 
   // Update the wrapped algo inst with new parameters
   p_->update(detector);
@@ -10,6 +10,7 @@
 #include <vital/exceptions.h>
 #include <vital/types/detected_object.h>
 #include <vital/types/detected_object_type.h>
+#include <vital/util/thread_pool.h>
 #include <vital/util/wall_timer.h>
 #include <vital/config/config_difference.h>
 
@@ -19,6 +20,9 @@
 #include <opencv2/imgproc/imgproc.hpp>
 #include <opencv2/core/eigen.hpp>
 
+#include <algorithm>
+#include <numeric>
+
 namespace kwiver {
 namespace arrows {
 namespace ocv {
@@ -85,8 +89,8 @@ linspace(T a, T b, int n)
   ///  start checking for a viable bounding box (default -1 uses image width).
   ///
   /// @return Tuple of integers (first row, last row, first col, last col)
-  ///  indicating the bounding rows/columns where at least one above-threshold
-  ///  element exists. last_row is one greater than the index for the last above-
+  ///  indicating the bounding rows/columns of the given window where at least
+  ///  one above-threshold element of the window exists. last_row is one greater than the index for the last above-
   ///  threshold row, and last_col is one greater than the index for the last
   ///  above-threshold column. If image is entirely below threshold, then
   ///  first_row = last_row = image.rows and first_colum = last_column =
@@ -116,10 +120,16 @@ mask_bounding_box( const cv::Mat image, double threshold = 0, int first_row = 0,
   --last_col;
   --last_row;
 
+  // Only the part of each row and column inside the window is scanned
+  int const col_begin = first_col;
+  int const col_end = last_col + 1;
+  int const row_begin = first_row;
+  int const row_end = last_row + 1;
+
   bool done = false;
   while( first_row < image.rows )
   {
-    for( int j=0; j < image.cols; j++ )
+    for( int j=col_begin; j < col_end; j++ )
     {
       if( image.at<T>( first_row, j ) >= threshold )
       {
@@ -137,7 +147,7 @@ mask_bounding_box( const cv::Mat image, double threshold = 0, int first_row = 0,
   done = false;
   while( last_row > first_row )
   {
-    for( int j=0; j < image.cols; j++ )
+    for( int j=col_begin; j < col_end; j++ )
     {
       if( image.at<T>( last_row, j ) >= threshold )
       {
@@ -155,7 +165,7 @@ mask_bounding_box( const cv::Mat image, double threshold = 0, int first_row = 0,
   done = false;
   while( first_col < image.cols )
   {
-    for( int i=0; i<image.rows; i++ )
+    for( int i=row_begin; i<row_end; i++ )
     {
       if( image.at<T>( i, first_col ) >= threshold )
       {
@@ -173,7 +183,7 @@ mask_bounding_box( const cv::Mat image, double threshold = 0, int first_row = 0,
   done = false;
   while( last_col > first_col )
   {
-    for( int i=0; i < image.rows; i++ )
+    for( int i=row_begin; i < row_end; i++ )
     {
       if( image.at<T>( i, last_col ) >= threshold )
       {
@@ -191,6 +201,100 @@ mask_bounding_box( const cv::Mat image, double threshold = 0, int first_row = 0,
   return std::make_tuple( first_row, last_row+1, first_col, last_col+1 );
 }
 
+// ----------------------------------------------------------------------------
+/// Mean of the heat map over the window anchored at each pixel.
+///
+/// The means are those cv::boxFilter gives with normalization and a zero
+/// border, but are computed from a summed-area table, so that after part of
+/// the heat map changes only the windows overlapping that part are computed
+/// again. Rows are computed in parallel on the thread pool.
+class window_means
+{
+public:
+  window_means( cv::Mat const& heat_map, cv::Size ksize, cv::Point anchor )
+    : m_means( heat_map.size(), CV_32F ),
+      m_ksize( ksize ),
+      m_anchor( anchor )
+  {
+    compute( heat_map, cv::Rect( 0, 0, heat_map.cols, heat_map.rows ) );
+  }
+
+  /// Compute again the windows which overlap \p changed
+  void update( cv::Mat const& heat_map, cv::Rect const& changed )
+  {
+    int const x1 = changed.x - m_ksize.width + 1 + m_anchor.x;
+    int const y1 = changed.y - m_ksize.height + 1 + m_anchor.y;
+    int const x2 = changed.x + changed.width + m_anchor.x;
+    int const y2 = changed.y + changed.height + m_anchor.y;
+
+    cv::Rect const anchors = cv::Rect( x1, y1, x2 - x1, y2 - y1 ) &
+                             cv::Rect( 0, 0, heat_map.cols, heat_map.rows );
+    if( anchors.area() > 0 )
+    {
+      compute( heat_map, anchors );
+    }
+  }
+
+  cv::Mat const& means() const { return m_means; }
+
+private:
+  void compute( cv::Mat const& heat_map, cv::Rect const& anchors )
+  {
+    // The part of the heat map covered by the windows of these anchors
+    cv::Rect const image( 0, 0, heat_map.cols, heat_map.rows );
+    cv::Rect const covered =
+      cv::Rect( anchors.x - m_anchor.x, anchors.y - m_anchor.y,
+                anchors.width + m_ksize.width - 1,
+                anchors.height + m_ksize.height - 1 ) & image;
+
+    cv::Mat sat;
+    cv::integral( heat_map( covered ), sat, CV_64F );
+
+    double const area = static_cast<double>( m_ksize.area() );
+
+    // Sums of floating point values taken as differences of the table may
+    // be left with rounding error where the heat map is zero
+    double const tolerance =
+      ( heat_map.depth() == CV_32F || heat_map.depth() == CV_64F )
+      ? 1e-12 * std::abs( sat.at<double>( sat.rows - 1, sat.cols - 1 ) )
+      : 0.0;
+
+    vital::thread_pool::instance().parallel_for(
+      anchors.height, 16,
+      [&]( size_t begin, size_t end ){
+        for( size_t r = begin; r < end; ++r )
+        {
+          int const y = anchors.y + static_cast<int>( r );
+          int const wy1 =
+            std::max( y - m_anchor.y, covered.y ) - covered.y;
+          int const wy2 =
+            std::min( y - m_anchor.y + m_ksize.height,
+                      covered.y + covered.height ) - covered.y;
+          double const* const top = sat.ptr<double>( wy1 );
+          double const* const bottom = sat.ptr<double>( wy2 );
+          float* const out = m_means.ptr<float>( y );
+
+          for( int x = anchors.x; x < anchors.x + anchors.width; ++x )
+          {
+            int const wx1 =
+              std::max( x - m_anchor.x, covered.x ) - covered.x;
+            int const wx2 =
+              std::min( x - m_anchor.x + m_ksize.width,
+                        covered.x + covered.width ) - covered.x;
+            double const sum =
+              bottom[ wx2 ] - bottom[ wx1 ] - top[ wx2 ] + top[ wx1 ];
+            out[ x ] =
+              ( sum > tolerance ? static_cast<float>( sum / area ) : 0.0f );
+          }
+        }
+      } );
+  }
+
+  cv::Mat m_means;
+  cv::Size m_ksize;
+  cv::Point m_anchor;
+};
+
 // ----------------------------------------------------------------------------
 // ----------------------------- Sprokit --------------------------------------
 
@@ -383,6 +487,152 @@ class detect_heat_map::priv
     return detected_objects;
   }
 
+  // --------------------------------------------------------------------------
+  /// Place one box on each blob of a heat map whose blobs are far apart.
+  ///
+  /// When every connected blob of nonzero pixels fits in the kernel and no
+  /// box can touch two blobs, the search in get_bbox_fixed_size places one
+  /// box centered on each blob, in order of decreasing sum. This finds the
+  /// same boxes from the connected components. Returns null when the blobs
+  /// are not separated well enough, or the heat map is not 8-bit.
+  detected_object_set_sptr
+  get_bbox_separated_blobs( cv::Mat const &heat_map, int bbox_width,
+                            int bbox_height, cv::Size ksize,
+                            double out_width_rescale,
+                            double out_height_rescale )
+  {
+    if( heat_map.type() != CV_8UC1 )
+    {
+      return nullptr;
+    }
+
+    cv::Mat labels, stats, centroids;
+    int const num_labels =
+      cv::connectedComponentsWithStats( heat_map > 0, labels, stats,
+                                        centroids, 8, CV_32S );
+
+    struct blob
+    {
+      cv::Rect extent;
+      double sum;
+    };
+
+    // Label 0 is the background
+    std::vector< blob > blobs( num_labels > 0 ? num_labels - 1 : 0 );
+    for( size_t i = 0; i < blobs.size(); ++i )
+    {
+      int const label = static_cast<int>( i ) + 1;
+      blobs[i].extent = cv::Rect( stats.at<int>( label, cv::CC_STAT_LEFT ),
+                                  stats.at<int>( label, cv::CC_STAT_TOP ),
+                                  stats.at<int>( label, cv::CC_STAT_WIDTH ),
+                                  stats.at<int>( label, cv::CC_STAT_HEIGHT ) );
+      blobs[i].sum = 0;
+
+      if( blobs[i].extent.width > ksize.width ||
+          blobs[i].extent.height > ksize.height )
+      {
+        return nullptr;
+      }
+    }
+
+    // A box touches two blobs if they are closer than its size on both axes
+    std::vector< size_t > order( blobs.size() );
+    std::iota( order.begin(), order.end(), 0 );
+    std::sort( order.begin(), order.end(),
+               [&blobs]( size_t a, size_t b ){
+                 return blobs[a].extent.x < blobs[b].extent.x; } );
+
+    for( size_t i = 0; i < order.size(); ++i )
+    {
+      cv::Rect const& a = blobs[ order[i] ].extent;
+      for( size_t j = i + 1; j < order.size(); ++j )
+      {
+        cv::Rect const& b = blobs[ order[j] ].extent;
+        if( b.x - ( a.x + a.width ) >= bbox_width - 1 )
+        {
+          break;
+        }
+
+        int const gap_x = std::max( a.x, b.x ) -
+                          std::min( a.x + a.width, b.x + b.width );
+        int const gap_y = std::max( a.y, b.y ) -
+                          std::min( a.y + a.height, b.y + b.height );
+        if( gap_x < bbox_width - 1 && gap_y < bbox_height - 1 )
+        {
+          return nullptr;
+        }
+      }
+    }
+
+    for( int y = 0; y < heat_map.rows; ++y )
+    {
+      int const* const label = labels.ptr<int>( y );
+      uchar const* const value = heat_map.ptr<uchar>( y );
+      for( int x = 0; x < heat_map.cols; ++x )
+      {
+        if( label[x] > 0 )
+        {
+          blobs[ label[x] - 1 ].sum += value[x];
+        }
+      }
+    }
+
+    // Boxes are placed in order of decreasing score, and then in raster
+    // order of the blobs
+    std::sort( blobs.begin(), blobs.end(),
+               []( blob const& a, blob const& b ){
+                 if( a.sum != b.sum )
+                 {
+                   return a.sum > b.sum;
+                 }
+                 return std::make_pair( a.extent.y, a.extent.x ) <
+                        std::make_pair( b.extent.y, b.extent.x );
+               } );
+
+    int const hr1f = bbox_width/2;
+    int const vr1f = bbox_height/2;
+    int const hr2f = bbox_width-1-hr1f;
+    int const vr2f = bbox_height-1-vr1f;
+    double const area = static_cast<double>( ksize.area() );
+
+    auto detected_objects = std::make_shared< detected_object_set >();
+    for( auto const& b : blobs )
+    {
+      if( m_max_boxes > 0 &&
+          static_cast<int>( detected_objects->size() ) == m_max_boxes )
+      {
+        break;
+      }
+
+      int const cx = ( 2*b.extent.x + b.extent.width )/2;
+      int const cy = ( 2*b.extent.y + b.extent.height )/2;
+
+      // vital::bounding_box lower-right point is not inclusive, so must add 1.
+      int x1 = cx-hr1f;
+      int y1 = cy-vr1f;
+      int x2 = cx+hr2f+1;
+      int y2 = cy+vr2f+1;
+      int const dx = -std::min( 0, x1 ) - std::max( 0, x2 - heat_map.cols );
+      int const dy = -std::min( 0, y1 ) - std::max( 0, y2 - heat_map.rows );
+      x1 += dx;  x2 += dx;  y1 += dy;  y2 += dy;
+
+      kwiver::vital::bounding_box_d bbox( x1*out_width_rescale,
+                                          y1*out_height_rescale,
+                                          x2*out_width_rescale,
+                                          y2*out_height_rescale );
+
+      double const score = static_cast<float>( b.sum / area );
+      auto dot = std::make_shared< detected_object_type >();
+      dot->set_score( m_class_name, score );
+      detected_objects->add(
+        std::make_shared< kwiver::vital::detected_object >( bbox, score, dot ) );
+    }
+
+    LOG_TRACE( m_logger, "Placed " << detected_objects->size()
+               << " boxes on separated blobs" );
+    return detected_objects;
+  }
+
   // --------------------------------------------------------------------------
   /// Find optimal tiling of bounding boxes with fixed size
   detected_object_set_sptr
@@ -430,7 +680,8 @@ class detect_heat_map::priv
     }
     else
     {
-      heat_map = heat_map0;
+      // Boxes are removed from the heat map as they are placed
+      heat_map = heat_map0.clone();
     }
 
     //heat_map0.copyTo( heat_map0, heat_map );
@@ -466,7 +717,25 @@ class detect_heat_map::priv
     // round the center up to the nearest integer.
     cv::Point anchor( hr1, vr1 );
 
-    cv::Mat conv_map;
+    // Well separated blobs each get the box centered on them, which can
+    // be found without searching
+    auto const blobs = get_bbox_separated_blobs( heat_map, bbox_width,
+                                                 bbox_height, ksize,
+                                                 bbox_out_width_rescale,
+                                                 bbox_out_height_rescale );
+    if( blobs )
+    {
+      return blobs;
+    }
+
+    // We are searching locations to place the bounding boxes that maximize the
+    // enclosed sum value from heat_map. The kernel size is equal to the
+    // bounding box size minus the bounding box buffer. This way, we only
+    // consider the inner useful region of the bounding box when looking for
+    // optimal placement. The window mean at a pixel is proportional to the
+    // sum of the heat map value within a bounding box centered at that pixel.
+    window_means conv_map( heat_map, ksize, anchor );
+
     double min_val, max_val;
     cv::Point max_loc;
     auto detected_objects = std::make_shared< detected_object_set >();
@@ -474,29 +743,7 @@ class detect_heat_map::priv
     int cntr = 0;
     while( true )
     {
-      // We are searching locations to place the bounding boxes that maximize the
-      // enclosed sum value from heat_map. Therefore, we can use a box blur filter
-      // to efficiently calculate this. The kernel size is equal to the bounding
-      // box size minus the bounding box buffer. This way, we only consider the
-      // inner useful region of the bounding box when looking for optimal
-      // placement. The value of the filtered image is equal to the sum of the
-      // heat map value within a bounding box centered at that pixel.
-      cv::boxFilter( heat_map, conv_map, CV_32F, ksize, anchor, true,
-                     cv::BORDER_CONSTANT );
-
-      if( false )
-      {
-        if( cntr == 0 )
-        {
-          cv::Mat output;
-          cv::normalize( conv_map, output, 0, 255, cv::NORM_MINMAX, CV_8UC1);
-          cv::imwrite( "/home/mattb/debug_output/output.tif", output );
-          cv::normalize( heat_map, output, 0, 255, cv::NORM_MINMAX, CV_8UC1);
-          cv::imwrite( "/home/mattb/debug_output/latest_heat_map.tif", output );
-        }
-      }
-
-      cv::minMaxLoc(conv_map, &min_val, &max_val, NULL, &max_loc);
+      cv::minMaxLoc(conv_map.means(), &min_val, &max_val, NULL, &max_loc);
       if( max_val == 0 )
       {
         // No above-threshold regions left.
@@ -561,6 +808,7 @@ class detect_heat_map::priv
       // during next iteration.
       cv::Rect cv_bbox( x1, y1, x2 - x1, y2 - y1 );
       heat_map(cv_bbox) = 0;
+      conv_map.update( heat_map, cv_bbox );
 
       ++cntr;
       if( cntr == m_max_boxes )
@@ -6,6 +6,7 @@
 /// \brief Implementation of ocv::detect_moiion_3frame_differencing
 
 #include <deque>
+#include <vector>
 
 #include "detect_motion_3frame_differencing.h"
 
@@ -20,6 +21,14 @@
 #include <opencv2/imgproc/imgproc.hpp>
 #include <opencv2/core/eigen.hpp>
 
+#if defined(HAVE_OPENCV_CUDAARITHM) && defined(HAVE_OPENCV_CUDAFILTERS) && \
+    defined(HAVE_OPENCV_CUDAIMGPROC)
+#define KWIVER_OCV_DIFFERENCING_CUDA
+#include <opencv2/cudaarithm.hpp>
+#include <opencv2/cudafilters.hpp>
+#include <opencv2/cudaimgproc.hpp>
+#endif
+
 namespace kwiver {
 namespace arrows {
 namespace ocv {
@@ -57,6 +66,31 @@ rms_over_channels( const cv::Mat &src, cv::Mat &dst)
   delete [] src_split;
 }
 
+#ifdef KWIVER_OCV_DIFFERENCING_CUDA
+// ----------------------------------------------------------------------------
+/// GPU version of rms_over_channels
+static
+void
+rms_over_channels( const cv::cuda::GpuMat &src, cv::cuda::GpuMat &dst)
+{
+  std::vector<cv::cuda::GpuMat> src_split;
+  cv::cuda::split(src, src_split);
+  cv::cuda::GpuMat accum(src.rows, src.cols, CV_32F, cv::Scalar(0));
+  cv::cuda::GpuMat temp;
+  for( auto const& channel : src_split )
+  {
+    channel.convertTo(temp, CV_32F);
+
+    // Divide the result by 3^2 so that the difference has the same scale as
+    // a mono image
+    cv::cuda::multiply( temp, temp, temp, 1/3.0 );
+    cv::cuda::add( accum, temp, accum );
+  }
+  cv::cuda::sqrt(accum, accum);
+  accum.convertTo(dst, CV_8UC1);
+}
+#endif
+
 // ----------------------------------------------------------------------------
 /// Private implementation class
 class detect_motion_3frame_differencing::priv
@@ -65,6 +99,14 @@ class detect_motion_3frame_differencing::priv
   std::deque<cv::Mat> m_frames;
   int m_debug_counter = 0;
 
+#ifdef KWIVER_OCV_DIFFERENCING_CUDA
+  /// Frames kept in GPU memory between calls
+  std::deque<cv::cuda::GpuMat> m_gpu_frames;
+  cv::Ptr<cv::cuda::Filter> m_gpu_dilate;
+  cv::Ptr<cv::cuda::Filter> m_gpu_erode;
+  int m_gpu_filter_type = -1;
+#endif
+
 public:
   /// Parameters
   std::string m_debug_dir;
@@ -73,6 +115,7 @@ class detect_motion_3frame_differencing::priv
   int m_jitter_radius;
   double m_max_foreground_fract;
   double m_max_foreground_fract_thresh;
+  bool m_use_cuda = false;
   kwiver::vital::logger_handle_t m_logger;
 
   /// Constructor
@@ -89,6 +132,9 @@ class detect_motion_3frame_differencing::priv
   void reset()
   {
     m_frames.clear();
+#ifdef KWIVER_OCV_DIFFERENCING_CUDA
+    m_gpu_frames.clear();
+#endif
   }
 
   ///
@@ -110,14 +156,9 @@ class detect_motion_3frame_differencing::priv
     }
     else
     {
-      if( m_jitter_struct_el.empty() )
-      {
-        cv::Size el_size(2*m_jitter_radius+1,2*m_jitter_radius+1);
-        m_jitter_struct_el = cv::getStructuringElement( cv::MORPH_RECT, el_size);
-      }
       cv::Mat local_max, local_min;
-      cv::dilate( img2, local_max, m_jitter_struct_el );
-      cv::erode( img2, local_min, m_jitter_struct_el );
+      cv::dilate( img2, local_max, jitter_struct_el() );
+      cv::erode( img2, local_min, jitter_struct_el() );
 
       // Following the reference "Detecting and Tracking All Moving Objects in
       // Wide-Area Aerial Video" equation 2
@@ -133,9 +174,70 @@ class detect_motion_3frame_differencing::priv
     }
   }
 
+  /// Get the structuring element for the jitter neighborhood
+  const cv::Mat& jitter_struct_el()
+  {
+    if( m_jitter_struct_el.empty() )
+    {
+      cv::Size el_size(2*m_jitter_radius+1,2*m_jitter_radius+1);
+      m_jitter_struct_el = cv::getStructuringElement( cv::MORPH_RECT, el_size);
+    }
+    return m_jitter_struct_el;
+  }
+
+#ifdef KWIVER_OCV_DIFFERENCING_CUDA
+  /// GPU version of image_difference
+  void
+  image_difference( const cv::cuda::GpuMat &img1, const cv::cuda::GpuMat &img2,
+                    cv::cuda::GpuMat &img_diff )
+  {
+    if( m_jitter_radius == 0 )
+    {
+      cv::cuda::absdiff( img1, img2, img_diff );
+    }
+    else
+    {
+      if( !m_gpu_dilate || m_gpu_filter_type != img2.type() )
+      {
+        m_gpu_filter_type = img2.type();
+        m_gpu_dilate = cv::cuda::createMorphologyFilter(
+          cv::MORPH_DILATE, m_gpu_filter_type, jitter_struct_el() );
+        m_gpu_erode = cv::cuda::createMorphologyFilter(
+          cv::MORPH_ERODE, m_gpu_filter_type, jitter_struct_el() );
+      }
+      cv::cuda::GpuMat local_max, local_min;
+      m_gpu_dilate->apply( img2, local_max );
+      m_gpu_erode->apply( img2, local_min );
+
+      cv::cuda::GpuMat img2_min_minus_img1, img1_minus_img2_max;
+      cv::cuda::subtract( local_min, img1, img2_min_minus_img1, cv::noArray(), CV_32F );
+      cv::cuda::subtract( img1, local_max, img1_minus_img2_max, cv::noArray(), CV_32F );
+
+      // Set negative values to zero, treating the channels as extra columns
+      // since the CUDA threshold takes a single channel
+      auto const channels = img1.channels();
+      cv::cuda::GpuMat low = img2_min_minus_img1.reshape(1);
+      cv::cuda::GpuMat high = img1_minus_img2_max.reshape(1);
+      cv::cuda::threshold( low, low, 0, 1, cv::THRESH_TOZERO );
+      cv::cuda::threshold( high, high, 0, 1, cv::THRESH_TOZERO );
+
+      cv::cuda::GpuMat diff;
+      cv::cuda::max( low, high, diff );
+      img_diff = diff.reshape(channels);
+    }
+  }
+#endif
+
   void
   process_image(cv::Mat &cv_src, cv::Mat &fgmask)
   {
+#ifdef KWIVER_OCV_DIFFERENCING_CUDA
+    if( m_use_cuda )
+    {
+      process_image_cuda(cv_src, fgmask);
+      return;
+    }
+#endif
     // Images are in temporal order A (oldest), B, C (newest).
     cv::Mat imgA, imgB, imgC;
     cv_src.copyTo(imgC);
@@ -171,30 +273,7 @@ class detect_motion_3frame_differencing::priv
 
     if( m_output_to_debug_dir )
     {
-      std::string fname;
-      cv::Mat img;
-      imgA.convertTo(img, CV_8UC1);
-      fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "imgA" + ".tif";
-      cv::imwrite( fname, img );
-      imgB.convertTo(img, CV_8UC1);
-      fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "imgB" + ".tif";
-      cv::imwrite( fname, img );
-      imgC.convertTo(img, CV_8UC1);
-      fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "imgC" + ".tif";
-      cv::imwrite( fname, img );
-      AminusC.convertTo(img, CV_8UC1);
-      fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "AminusC" + ".tif";
-      cv::imwrite( fname, img );
-      CminusB.convertTo(img, CV_8UC1);
-      fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "CminusB" + ".tif";
-      cv::imwrite( fname, img );
-      AminusB.convertTo(img, CV_8UC1);
-      fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "AminusB" + ".tif";
-      cv::imwrite( fname, img );
-      fgmask.convertTo(img, CV_8UC1);
-      fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "fgmask" + ".tif";
-      cv::imwrite( fname, img );
-      ++m_debug_counter;
+      write_debug_images( imgA, imgB, imgC, AminusC, CminusB, AminusB, fgmask );
     }
 
     if( fgmask.channels() > 1 )
@@ -204,6 +283,124 @@ class detect_motion_3frame_differencing::priv
       rms_over_channels( fgmask, fgmask);
     }
 
+    check_foreground( fgmask );
+  }
+
+#ifdef KWIVER_OCV_DIFFERENCING_CUDA
+  /// GPU version of process_image
+  ///
+  /// The queued frames stay in GPU memory, so each call uploads only the new
+  /// frame and downloads only the foreground mask.
+  void
+  process_image_cuda(cv::Mat &cv_src, cv::Mat &fgmask)
+  {
+    // Images are in temporal order A (oldest), B, C (newest).
+    cv::cuda::GpuMat imgA, imgB, imgC;
+    imgC.upload(cv_src);
+
+    // The CUDA morphology filters take one or four channels
+    if( m_jitter_radius > 0 && imgC.channels() == 3 )
+    {
+      cv::cuda::GpuMat bgra;
+      cv::cuda::cvtColor( imgC, bgra, cv::COLOR_BGR2BGRA );
+      imgC = bgra;
+    }
+    m_gpu_frames.push_front(imgC);
+
+    if( m_gpu_frames.size() < 2*m_frame_separation )
+    {
+      LOG_TRACE( m_logger, "Haven't collected enough frames yet, so setting "
+                           "foreground mask to all zeros.");
+      fgmask = cv::Mat(cv_src.rows, cv_src.cols, CV_8UC1, cv::Scalar(0));
+      return;
+    }
+
+    imgA = m_gpu_frames.back();
+    imgB = m_gpu_frames[m_frame_separation];
+
+    if( m_gpu_frames.size() > 2*m_frame_separation )
+    {
+      m_gpu_frames.pop_back();
+    }
+
+    // unsigned_sum (default)
+    ///  = | | A - C | + | C - B | - | A - B | |
+    cv::cuda::GpuMat AminusC, CminusB, AminusB, gpu_fgmask;
+    image_difference( imgA, imgC, AminusC );
+    image_difference( imgC, imgB, CminusB );
+    image_difference( imgA, imgB, AminusB );
+
+    cv::cuda::add( AminusC, CminusB, gpu_fgmask );
+    cv::cuda::subtract( gpu_fgmask, AminusB, gpu_fgmask );
+    if( gpu_fgmask.depth() == CV_32F )
+    {
+      cv::cuda::GpuMat values = gpu_fgmask.reshape(1);
+      cv::cuda::abs( values, values );
+    }
+
+    if( m_output_to_debug_dir )
+    {
+      cv::Mat A, B, C, AC, CB, AB, fg;
+      imgA.download(A);
+      imgB.download(B);
+      imgC.download(C);
+      AminusC.download(AC);
+      CminusB.download(CB);
+      AminusB.download(AB);
+      gpu_fgmask.download(fg);
+      write_debug_images( A, B, C, AC, CB, AB, fg );
+    }
+
+    if( gpu_fgmask.channels() > 1 )
+    {
+      LOG_TRACE( m_logger, "Converting multichannel foreground mask to single "
+                 "channel");
+      rms_over_channels( gpu_fgmask, gpu_fgmask );
+    }
+
+    gpu_fgmask.download(fgmask);
+    check_foreground( fgmask );
+  }
+#endif
+
+  /// Write the images of one difference computation to the debug directory
+  void
+  write_debug_images( const cv::Mat &imgA, const cv::Mat &imgB,
+                      const cv::Mat &imgC, const cv::Mat &AminusC,
+                      const cv::Mat &CminusB, const cv::Mat &AminusB,
+                      const cv::Mat &fgmask )
+  {
+    std::string fname;
+    cv::Mat img;
+    imgA.convertTo(img, CV_8UC1);
+    fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "imgA" + ".tif";
+    cv::imwrite( fname, img );
+    imgB.convertTo(img, CV_8UC1);
+    fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "imgB" + ".tif";
+    cv::imwrite( fname, img );
+    imgC.convertTo(img, CV_8UC1);
+    fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "imgC" + ".tif";
+    cv::imwrite( fname, img );
+    AminusC.convertTo(img, CV_8UC1);
+    fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "AminusC" + ".tif";
+    cv::imwrite( fname, img );
+    CminusB.convertTo(img, CV_8UC1);
+    fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "CminusB" + ".tif";
+    cv::imwrite( fname, img );
+    AminusB.convertTo(img, CV_8UC1);
+    fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "AminusB" + ".tif";
+    cv::imwrite( fname, img );
+    fgmask.convertTo(img, CV_8UC1);
+    fname = m_debug_dir + "/" + std::to_string(m_debug_counter) + "fgmask" + ".tif";
+    cv::imwrite( fname, img );
+    ++m_debug_counter;
+  }
+
+  /// Log statistics of the foreground mask, and reset the model if too much
+  /// of the frame is foreground
+  void
+  check_foreground( cv::Mat &fgmask )
+  {
     if ( IS_TRACE_ENABLED( m_logger ) )
     {
       double min_val, max_val;
@@ -297,6 +494,11 @@ ::get_configuration() const
                      "been exceeded." );
   config->set_value( "debug_dir", d_->m_debug_dir,
                      "Output debug images to this directory.");
+  config->set_value( "use_cuda", d_->m_use_cuda,
+                     "Use the CUDA modules of OpenCV, which keep the queued "
+                     "frames in GPU memory between calls. This requires "
+                     "OpenCV built with CUDA and a CUDA device; otherwise "
+                     "the CPU implementation is used." );
 
   return config;
 }
@@ -316,6 +518,23 @@ ::set_configuration(vital::config_block_sptr in_config)
   d_->m_max_foreground_fract   = config->get_value<double>( "max_foreground_fract" );
   d_->m_max_foreground_fract_thresh   = config->get_value<double>( "max_foreground_fract_thresh" );
   d_->m_debug_dir         = config->get_value<std::string>( "debug_dir" );
+  d_->m_use_cuda          = config->get_value<bool>( "use_cuda" );
+
+  if( d_->m_use_cuda )
+  {
+#ifdef KWIVER_OCV_DIFFERENCING_CUDA
+    if( cv::cuda::getCudaEnabledDeviceCount() < 1 )
+    {
+      LOG_WARN( logger(), "No CUDA device found; using the CPU instead" );
+      d_->m_use_cuda = false;
+    }
+#else
+    LOG_WARN( logger(), "OpenCV was built without the CUDA arithmetic, "
+                        "filtering and image processing modules; using the "
+                        "CPU instead" );
+    d_->m_use_cuda = false;
+#endif
+  }
 
   if( d_->m_frame_separation < 0 )
   {
@@ -355,6 +574,10 @@ ::set_configuration(vital::config_block_sptr in_config)
   LOG_DEBUG( logger(), "max_foreground_fract: " << std::to_string(d_->m_max_foreground_fract) );
   LOG_DEBUG( logger(), "max_foreground_fract_thresh: " << std::to_string(d_->m_max_foreground_fract_thresh) );
   LOG_DEBUG( logger(), "debug_dir: " << d_->m_debug_dir );
+  LOG_DEBUG( logger(), "use_cuda: " << d_->m_use_cuda );
+
+  // Start over with frames queued on the chosen device
+  d_->reset();
 }
 
 bool
@@ -17,6 +17,14 @@
 #include <opencv2/imgproc/imgproc.hpp>
 #include <opencv2/core/eigen.hpp>
 
+#if defined(HAVE_OPENCV_CUDABGSEGM) && defined(HAVE_OPENCV_CUDAFILTERS) && \
+    defined(HAVE_OPENCV_CUDAIMGPROC)
+#define KWIVER_OCV_MOG2_CUDA
+#include <opencv2/cudabgsegm.hpp>
+#include <opencv2/cudafilters.hpp>
+#include <opencv2/cudaimgproc.hpp>
+#endif
+
 namespace kwiver {
 namespace arrows {
 namespace ocv {
@@ -38,10 +46,22 @@ class detect_motion_mog2::priv
   int m_min_frames;
   int m_nmixtures;
   double m_max_foreground_fract;
+  bool m_use_cuda;
   cv::Ptr<cv::BackgroundSubtractorMOG2> bg_model;
   image_container_sptr motion_heat_map;
   kwiver::vital::logger_handle_t m_logger;
 
+#ifdef KWIVER_OCV_MOG2_CUDA
+  /// Model and buffers kept in GPU memory between frames
+  cv::Ptr<cv::cuda::BackgroundSubtractorMOG2> gpu_bg_model;
+  cv::Ptr<cv::cuda::Filter> gpu_blur;
+  int gpu_blur_type = -1;
+  cv::cuda::GpuMat gpu_src;
+  cv::cuda::GpuMat gpu_bgra;
+  cv::cuda::GpuMat gpu_blurred;
+  cv::cuda::GpuMat gpu_fgmask;
+#endif
+
   /// Constructor
   priv()
      :
@@ -52,7 +72,8 @@ class detect_motion_mog2::priv
        m_blur_kernel_size(3),
        m_min_frames(1),
        m_nmixtures(3),
-       m_max_foreground_fract(1)
+       m_max_foreground_fract(1),
+       m_use_cuda(false)
   {
   }
 
@@ -60,6 +81,16 @@ class detect_motion_mog2::priv
   void reset()
   {
     m_frame_count = 0;
+#ifdef KWIVER_OCV_MOG2_CUDA
+    if( m_use_cuda )
+    {
+      gpu_bg_model = cv::cuda::createBackgroundSubtractorMOG2(
+        m_history, m_var_threshold, false );
+      gpu_bg_model->setNMixtures( m_nmixtures );
+      gpu_blur.release();
+      return;
+    }
+#endif
 #if KWIVER_OPENCV_VERSION_MAJOR >= 3
     bg_model = cv::createBackgroundSubtractorMOG2( m_history, m_var_threshold, false );
     bg_model->setNMixtures( m_nmixtures );
@@ -68,6 +99,65 @@ class detect_motion_mog2::priv
     bg_model->set("nmixtures", m_nmixtures);
 #endif
   }
+
+  /// Blur a frame and update the background model with it
+  void apply( const cv::Mat& src, cv::Mat& fgmask )
+  {
+#ifdef KWIVER_OCV_MOG2_CUDA
+    if( m_use_cuda )
+    {
+      apply_cuda( src, fgmask );
+      return;
+    }
+#endif
+    cv::Mat cv_src;
+    src.copyTo(cv_src);
+
+    if( m_blur_kernel_size > 0)
+    {
+      cv::blur(cv_src, cv_src, cv::Size(m_blur_kernel_size, m_blur_kernel_size) );
+    }
+
+#if KWIVER_OPENCV_VERSION_MAJOR >= 3
+    bg_model->apply( cv_src, fgmask, m_learning_rate );
+#else
+    bg_model->operator()(cv_src, fgmask, m_learning_rate);
+#endif
+  }
+
+#ifdef KWIVER_OCV_MOG2_CUDA
+  /// Blur a frame and update the background model with it on the GPU
+  ///
+  /// The buffers are reused from frame to frame, so only the frame is
+  /// uploaded and only the foreground mask is downloaded.
+  void apply_cuda( const cv::Mat& src, cv::Mat& fgmask )
+  {
+    gpu_src.upload( src );
+
+    cv::cuda::GpuMat* frame = &gpu_src;
+    if( m_blur_kernel_size > 0 )
+    {
+      // The CUDA box filter takes one or four channels of bytes
+      if( frame->channels() == 3 )
+      {
+        cv::cuda::cvtColor( *frame, gpu_bgra, cv::COLOR_BGR2BGRA );
+        frame = &gpu_bgra;
+      }
+      if( !gpu_blur || gpu_blur_type != frame->type() )
+      {
+        gpu_blur_type = frame->type();
+        gpu_blur = cv::cuda::createBoxFilter(
+          gpu_blur_type, gpu_blur_type,
+          cv::Size( m_blur_kernel_size, m_blur_kernel_size ) );
+      }
+      gpu_blur->apply( *frame, gpu_blurred );
+      frame = &gpu_blurred;
+    }
+
+    gpu_bg_model->apply( *frame, gpu_fgmask, m_learning_rate );
+    gpu_fgmask.download( fgmask );
+  }
+#endif
 };
 
 /// Constructor
@@ -118,6 +208,11 @@ ::get_configuration() const
                      "invalid (e.g., due to excessive camera motion) and is "
                      "reset. The default value of 1 indicates that no checking "
                      "is done." );
+  config->set_value( "use_cuda", d_->m_use_cuda,
+                     "Use the CUDA modules of OpenCV, which keep the "
+                     "background model in GPU memory between frames. This "
+                     "requires OpenCV built with CUDA and a CUDA device; "
+                     "otherwise the CPU implementation is used." );
 
   return config;
 }
@@ -138,6 +233,21 @@ ::set_configuration(vital::config_block_sptr in_config)
   d_->m_blur_kernel_size       = config->get_value<int>( "blur_kernel_size" );
   d_->m_min_frames             = config->get_value<int>( "min_frames" );
   d_->m_max_foreground_fract   = config->get_value<double>( "max_foreground_fract" );
+  d_->m_use_cuda               = config->get_value<bool>( "use_cuda" );
+  if( d_->m_use_cuda )
+  {
+#ifdef KWIVER_OCV_MOG2_CUDA
+    if( cv::cuda::getCudaEnabledDeviceCount() < 1 )
+    {
+      LOG_WARN( logger(), "No CUDA device found; using the CPU instead" );
+      d_->m_use_cuda = false;
+    }
+#else
+    LOG_WARN( logger(), "OpenCV was built without the CUDA background "
+                        "subtraction modules; using the CPU instead" );
+    d_->m_use_cuda = false;
+#endif
+  }
   if( d_->m_max_foreground_fract < 0 || d_->m_max_foreground_fract > 1 )
   {
     VITAL_THROW( algorithm_configuration_exception, type_name(), impl_name(),
@@ -156,6 +266,10 @@ ::set_configuration(vital::config_block_sptr in_config)
   LOG_DEBUG( logger(), "learning_rate: " << std::to_string(d_->m_learning_rate));
   LOG_DEBUG( logger(), "blur_kernel_size: " << std::to_string(d_->m_blur_kernel_size));
   LOG_DEBUG( logger(), "max_foreground_fract: " << std::to_string(d_->m_max_foreground_fract));
+  LOG_DEBUG( logger(), "use_cuda: " << d_->m_use_cuda);
+
+  // Create the model for the chosen device
+  d_->reset();
 }
 
 bool
@@ -183,20 +297,10 @@ ::process_image( VITAL_UNUSED const timestamp& ts,
     d_->reset();
   }
 
-  cv::Mat cv_src;
-  ocv::image_container::vital_to_ocv(image->get_image(),image_container::BGR_COLOR).copyTo(cv_src);
-
-  if( d_->m_blur_kernel_size > 0)
-  {
-    cv::blur(cv_src, cv_src, cv::Size(d_->m_blur_kernel_size, d_->m_blur_kernel_size) );
-  }
-
   cv::Mat fgmask;
-#if KWIVER_OPENCV_VERSION_MAJOR >= 3
-  d_->bg_model->apply( cv_src, fgmask, d_->m_learning_rate );
-#else
-  d_->bg_model->operator()(cv_src, fgmask, d_->m_learning_rate);
-#endif
+  d_->apply( ocv::image_container::vital_to_ocv(image->get_image(),
+                                               image_container::BGR_COLOR),
+             fgmask );
   LOG_TRACE( logger(), "Finished MOG2 motion detector for this iteration");
 
   ++ d_->m_frame_count;
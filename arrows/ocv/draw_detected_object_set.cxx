@@ -19,6 +19,7 @@
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 
+#include <cmath>
 #include <sstream>
 
 namespace kwiver {
@@ -112,9 +113,6 @@ class draw_detected_object_set::priv
                  bool                         just_text = false,
                  int                          offset_index = 0 ) const
   {
-    cv::Mat overlay;
-
-    image.copyTo( overlay );
     vital::bounding_box_d bbox = dos->bounding_box();
     if ( m_clip_box_to_image )
     {
@@ -144,29 +142,62 @@ class draw_detected_object_set::priv
       bbp = &( iter->second );
     }
 
+    // Find the part of the image the box and label are drawn on, since only
+    // that part needs to be blended
+    cv::Rect region;
+    if ( ! just_text )
+    {
+      int const margin = static_cast< int >( std::ceil( bbp->thickness ) ) + 1;
+      region = cv::Rect( r.x - margin, r.y - margin,
+                         r.width + 2 * margin, r.height + 2 * margin );
+    }
+
+    int fontface = cv::FONT_HERSHEY_SIMPLEX;
+    double scale = m_text_scale;
+    int thickness = m_text_thickness;
+    int baseline = 0;
+    cv::Point pt( r.tl() + cv::Point( 0, MULTI_LABEL_OFFSET * offset_index ) );
+    cv::Size text;
+    if ( m_draw_text )
+    {
+      text = cv::getTextSize( txt, fontface, scale, thickness, &baseline );
+      int const margin = 2 * thickness + 2;
+      cv::Rect const text_region( pt.x - margin, pt.y - text.height - margin,
+                                  text.width + 2 * margin,
+                                  text.height + baseline + 2 * margin );
+      region = region.area() ? ( region | text_region ) : text_region;
+    }
+
+    region &= cv::Rect( 0, 0, image.cols, image.rows );
+    if ( region.area() == 0 )
+    {
+      return;
+    }
+
+    // Draw straight onto the image when there is nothing to blend
+    cv::Mat target = image( region );
+    cv::Mat overlay = ( alpha_wight == 1.0 ) ? target : target.clone();
+    cv::Point const shift = -region.tl();
+
     // Add text to an existing box
     if ( ! just_text )
     {
       cv::Scalar color( bbp->color[0], bbp->color[1], bbp->color[2] );
-      cv::rectangle( overlay, r, color, bbp->thickness );
+      cv::rectangle( overlay, r + shift, color, bbp->thickness );
     }
 
     if ( m_draw_text )
     {
-      int fontface = cv::FONT_HERSHEY_SIMPLEX;
-      double scale = m_text_scale;
-      int thickness = m_text_thickness;
-      int baseline = 0;
-      cv::Point pt( r.tl() + cv::Point( 0, MULTI_LABEL_OFFSET * offset_index ) );
-
-      cv::Size text = cv::getTextSize( txt, fontface, scale, thickness, &baseline );
-      cv::rectangle( overlay, pt + cv::Point( 0, baseline ), pt +
+      cv::rectangle( overlay, pt + shift + cv::Point( 0, baseline ), pt + shift +
                      cv::Point( text.width, -text.height ), cv::Scalar( 0, 0, 0 ), cv::FILLED );
 
-      cv::putText( overlay, txt, pt, fontface, scale, cv::Scalar( 255, 255, 255 ), thickness, 8 );
+      cv::putText( overlay, txt, pt + shift, fontface, scale, cv::Scalar( 255, 255, 255 ), thickness, 8 );
     }
 
-    cv::addWeighted( overlay, alpha_wight, image, 1 - alpha_wight, 0, image );
+    if ( overlay.data != target.data )
+    {
+      cv::addWeighted( overlay, alpha_wight, target, 1 - alpha_wight, 0, target );
+    }
   } // draw_box
 
   // --------------------------------------------------------------------------
@@ -327,18 +327,22 @@ ::draw( track_set_sptr input_display_set,
     // Should the current frame be written to disk?
     bool write_image_to_disk = d->write_images_to_disk;
 
-    // Clone a copy of the current image (so we don't modify the original input).
-    cv::Mat img = ocv::image_container::vital_to_ocv( ctr_sptr->get_image(), ocv::image_container::BGR_COLOR ).clone();
-
-    // Convert to 3 channel image if not one already
-    if( img.channels() == 1 )
+    // Copy the current image (so we don't modify the original input),
+    // converting it to 3 channels if it is not already as part of the copy
+    cv::Mat img;
+    cv::Mat const input_img = ocv::image_container::vital_to_ocv( ctr_sptr->get_image(), ocv::image_container::BGR_COLOR );
+    if( input_img.channels() == 1 )
     {
 #if KWIVER_OPENCV_VERSION_MAJOR >= 3
-      cv::cvtColor( img, img, cv::COLOR_GRAY2BGR );
+      cv::cvtColor( input_img, img, cv::COLOR_GRAY2BGR );
 #else
-      cv::cvtColor( img, img, CV_GRAY2BGR );
+      cv::cvtColor( input_img, img, CV_GRAY2BGR );
 #endif
     }
+    else
+    {
+      img = input_img.clone();
+    }
 
     // List of match lines to draw on final image
     line_vec_t lines;
@@ -349,13 +353,14 @@ ::draw( track_set_sptr input_display_set,
     // Has at least one comparison track been found for this frame?
     bool comparison_track_found = false;
 
-    // Draw points on input image
-    for( track_sptr trk : display_set->active_tracks( fid ) )
+    // Draw points on input image, visiting the states on this frame directly
+    // rather than searching each active track for them
+    for( track_state_sptr ts : display_set->frame_states( fid ) )
     {
-      auto ts = *( trk->find( fid ) );
       auto fts = std::dynamic_pointer_cast<feature_track_state>(ts);
+      track_sptr trk = ts->track();
 
-      if( !fts || !fts->feature )
+      if( !fts || !fts->feature || !trk )
       {
         continue;
       }
@@ -364,9 +369,6 @@ ::draw( track_set_sptr input_display_set,
       cv::Scalar color = default_color;
       cv::Point loc = state_to_cv_point( ts );
       cv::Point txt_offset( 2, -2 );
-      std::stringstream str;
-      str << trk->id();
-      std::string tid_str = str.str();
 
       if( trk->size() == 1 )
       {
@@ -431,7 +433,7 @@ ::draw( track_set_sptr input_display_set,
 
       if( d->draw_track_ids && trk->size() > 1 )
       {
-        cv::putText( img, tid_str, loc + txt_offset, cv::FONT_HERSHEY_COMPLEX_SMALL, 0.5, color );
+        cv::putText( img, std::to_string( trk->id() ), loc + txt_offset, cv::FONT_HERSHEY_COMPLEX_SMALL, 0.5, color );
       }
 
       if( d->draw_untracked_features || trk->size() > 1 )
@@ -464,21 +466,29 @@ ::draw( track_set_sptr input_display_set,
       write_image_to_disk = false;
     }
 
-    output_image = cv::Mat( img.rows, display_frames*img.cols, img.type(), cv::Scalar(0) );
-
-    for( unsigned i = 0; i < past_frames; i++ )
+    if( past_frames == 0 )
+    {
+      // Nothing else is drawn on the output, so it can share the image
+      output_image = img;
+    }
+    else
     {
-      cv::Mat region( output_image, cv::Rect( i*img.cols, 0, img.cols, img.rows ) );
+      output_image = cv::Mat( img.rows, display_frames*img.cols, img.type(), cv::Scalar(0) );
 
-      if( ((signed) d->buffer.size() >= d->past_frames_to_show[i]) &&
-          (d->past_frames_to_show[i] != 0) )
+      for( unsigned i = 0; i < past_frames; i++ )
       {
-        d->buffer[ d->buffer.size()-d->past_frames_to_show[i] ].copyTo( region );
+        cv::Mat region( output_image, cv::Rect( i*img.cols, 0, img.cols, img.rows ) );
+
+        if( ((signed) d->buffer.size() >= d->past_frames_to_show[i]) &&
+            (d->past_frames_to_show[i] != 0) )
+        {
+          d->buffer[ d->buffer.size()-d->past_frames_to_show[i] ].copyTo( region );
+        }
       }
-    }
 
-    cv::Mat region( output_image, cv::Rect( past_frames*img.cols, 0, img.cols, img.rows ) );
-    img.copyTo( region );
+      cv::Mat region( output_image, cv::Rect( past_frames*img.cols, 0, img.cols, img.rows ) );
+      img.copyTo( region );
+    }
 
     for( unsigned i = 0; i < lines.size(); i++ )
     {
@@ -112,6 +112,7 @@ ::set_configuration(vital::config_block_sptr config)
   config_block_sptr c = get_configuration();
   c->merge_config(config);
   p_->set_configuration(c);
+  set_detect_configuration( c );
   detector = p_->create();
 }
 
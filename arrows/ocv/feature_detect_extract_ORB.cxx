@@ -7,6 +7,10 @@
 
 #include "feature_detect_extract_ORB.h"
 
+#ifdef KWIVER_OCV_HAS_CUDA_FEATURES
+#include <opencv2/cudafeatures2d.hpp>
+#endif
+
 using namespace kwiver::vital;
 
 namespace kwiver {
@@ -197,6 +201,18 @@ class priv
 class detect_features_ORB::priv
   : public ocv::priv
 {
+public:
+#ifdef KWIVER_OCV_HAS_CUDA_FEATURES
+  /// Create a new CUDA ORB instance based on current parameters
+  cv::Ptr<cv::cuda::ORB> create_cuda() const
+  {
+    return cv::cuda::ORB::create( n_features, scale_factor, n_levels,
+                                  edge_threshold, first_level, wta_k,
+                                  score_type, patch_size, fast_threshold );
+  }
+#endif
+
+  bool use_cuda = false;
 };
 
 class extract_descriptors_ORB::priv
@@ -223,6 +239,9 @@ ::get_configuration() const
 {
   config_block_sptr config = detect_features::get_configuration();
   p_->update_configuration(config);
+  config->set_value( "use_cuda", p_->use_cuda,
+                     "Detect on the GPU with the OpenCV CUDA ORB detector, "
+                     "if OpenCV was built with it." );
   return config;
 }
 
@@ -233,6 +252,29 @@ ::set_configuration(vital::config_block_sptr config)
   config_block_sptr c = get_configuration();
   c->merge_config(config);
   p_->set_configuration(c);
+  p_->use_cuda = c->get_value<bool>( "use_cuda" );
+  set_detect_configuration( c );
+
+#ifdef KWIVER_OCV_HAS_CUDA_FEATURES
+  if( p_->use_cuda )
+  {
+    detector = p_->create_cuda();
+    detector_on_gpu = true;
+    return;
+  }
+#else
+  if( p_->use_cuda )
+  {
+    LOG_WARN( logger(), "OpenCV was built without CUDA feature detectors; "
+                        "detecting on the CPU" );
+  }
+#endif
+  if( detector_on_gpu )
+  {
+    detector = p_->create();
+    detector_on_gpu = false;
+  }
+
 #if KWIVER_OPENCV_VERSION_MAJOR < 3
   p_->update_algo( detector );
 #else
@@ -166,6 +166,7 @@ ::set_configuration(vital::config_block_sptr config)
   config_block_sptr c = get_configuration();
   c->merge_config( config );
   p_->set_config( c );
+  set_detect_configuration( c );
 
 #if KWIVER_OPENCV_VERSION_MAJOR < 3
   p_->update( detector );
@@ -81,9 +81,16 @@ ::size() const
 /// Convert an OpenCV cv::Mat to a VITAL image
 image
 image_container
-::ocv_to_vital(const cv::Mat& img,
-               VITAL_UNUSED ColorMode cm)
+::ocv_to_vital(const cv::Mat& img, ColorMode cm)
 {
+  // a BGRA image can not be viewed as RGBA, so convert a copy
+  if( cm == BGR_COLOR && img.channels() == 4 )
+  {
+    cv::Mat rgba;
+    cv::cvtColor(img, rgba, cv::COLOR_BGRA2RGBA);
+    return ocv_to_vital(rgba, RGB_COLOR);
+  }
+
   // if the cv::Mat has reference counted memory then wrap it to keep a
   // counted reference too it.  If it doesn't own its memory, then the
   // vital image won't take ownership either
@@ -97,10 +104,17 @@ ::ocv_to_vital(const cv::Mat& img,
     memory = std::make_shared<mat_image_memory>(img);
   }
 
-  return image(memory, img.data,
-               img.cols, img.rows, img.channels(),
-               img.channels(), img.step1(), 1,
-               ocv_to_vital(img.type()));
+  image const out(memory, img.data,
+                  img.cols, img.rows, img.channels(),
+                  img.channels(), img.step1(), 1,
+                  ocv_to_vital(img.type()));
+
+  // view a BGR image as RGB by stepping through the channels backwards
+  if( cm == BGR_COLOR && img.channels() == 3 )
+  {
+    return out.reverse_channels();
+  }
+  return out;
 }
 
 // ----------------------------------------------------------------------------
@@ -142,6 +156,14 @@ ::vital_to_ocv(const vital::image& img, image_container::ColorMode cm)
   // compatible type
   const int cv_type = vital_to_ocv(img.pixel_traits());
 
+  // A BGR request for an RGB view of interleaved BGR memory, such as one made
+  // by ocv_to_vital, wraps the BGR memory directly
+  if( cm == BGR_COLOR && img.depth() == 3 && img.d_step() == -1 &&
+      img.w_step() == 3 )
+  {
+    return vital_to_ocv(img.reverse_channels(), RGB_COLOR);
+  }
+
   // cv::Mat is limited in the image data layouts and types that it supports.
   // Color channels must be interleaved (d_step==1) and the
   // step between columns must equal the number of channels (w_step==depth).
@@ -310,7 +332,21 @@ image_container_to_ocv_matrix(const vital::image_container& img, image_container
   }
   else
   {
-    return ocv::image_container::vital_to_ocv(img.get_image(), cm);
+    // reuse a copy made by an earlier conversion of this container
+    std::string const key =
+      "ocv:" + std::to_string(static_cast<int>(cm));
+    if( auto cached = img.get_conversion(key) )
+    {
+      return *std::static_pointer_cast<cv::Mat>(cached);
+    }
+
+    vital::image const vital_image = img.get_image();
+    result = ocv::image_container::vital_to_ocv(vital_image, cm);
+    if( result.data != vital_image.first_pixel() )
+    {
+      img.set_conversion(key, std::make_shared<cv::Mat>(result));
+    }
+    return result;
   }
   if(cm == image_container::BGR_COLOR && (result.channels() == 3 || result.channels() == 4) )
   {
@@ -66,7 +66,8 @@ class KWIVER_ALGO_OCV_EXPORT image_container
   /// Convert an OpenCV cv::Mat to a VITAL image
   ///
   /// This function constructs a vital::image from a cv::Mat and wraps the same
-  /// memory.  If the memory is owned by the cv::Mat this function will use a
+  /// memory.  A 3 channel BGR matrix is viewed as RGB by stepping through its
+  /// channels backwards, while a 4 channel BGRA matrix is converted to RGBA.  If the memory is owned by the cv::Mat this function will use a
   /// mat_image_memory class to retain the original memory and reference
   /// counting.  If the cv::Mat does not own the memory, the vital::image will
   /// point to the same memory but also not take ownership.  That is
@@ -91,6 +92,8 @@ class KWIVER_ALGO_OCV_EXPORT image_container
   /// deep copied.  The same is true if the user requests a color mode other
   /// than the default BGR used by OpenCV.  The data will be copied into new
   /// memory and the color is converted.
+  /// An exception is a BGR request for a 3 channel RGB view of BGR memory,
+  /// such as one made by ocv_to_vital, which wraps the BGR memory directly.
   static cv::Mat vital_to_ocv(const vital::image& img, ColorMode cm);
 
   /// Convert a vital::image_pixel_traits to an OpenCV cv::Mat type integer
@@ -106,6 +109,9 @@ class KWIVER_ALGO_OCV_EXPORT image_container
 /// If \a img is actually an arrows::ocv::image_container then
 /// return the underlying cv::Mat.  Otherwise, convert the image data
 /// to cv:Mat by shallow copy (if possible) or deep copy as a last resort.
+/// A deep copy is stored in the conversion cache of \a img and returned by
+/// later calls with the same color mode, so the result may share memory and
+/// should not be modified in place.
 ///
 /// \param img Image container to convert to cv::mat
 KWIVER_ALGO_OCV_EXPORT cv::Mat image_container_to_ocv_matrix(const vital::image_container& img,
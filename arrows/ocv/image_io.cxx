@@ -15,10 +15,63 @@
 #include <opencv2/imgcodecs.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 
+#include <vector>
+
 namespace kwiver {
 namespace arrows {
 namespace ocv {
 
+/// Constructor
+image_io
+::image_io()
+  : png_compression_(-1),
+    jpeg_quality_(-1)
+{
+}
+
+/// Get this algorithm's \link vital::config_block configuration block \endlink
+vital::config_block_sptr
+image_io
+::get_configuration() const
+{
+  vital::config_block_sptr config = vital::algo::image_io::get_configuration();
+
+  config->set_value("png_compression", png_compression_,
+                    "Compression level (0 to 9) of PNG images written. "
+                    "Higher levels give smaller files but take longer to "
+                    "write. Set to -1 to use the OpenCV default.");
+  config->set_value("jpeg_quality", jpeg_quality_,
+                    "Quality (0 to 100) of JPEG images written. Set to -1 "
+                    "to use the OpenCV default.");
+
+  return config;
+}
+
+/// Set this algorithm's properties via a config block
+void
+image_io
+::set_configuration(vital::config_block_sptr in_config)
+{
+  vital::config_block_sptr config = get_configuration();
+  config->merge_config(in_config);
+
+  png_compression_ = config->get_value<int>("png_compression");
+  jpeg_quality_ = config->get_value<int>("jpeg_quality");
+}
+
+/// Check that the algorithm's currently configuration is valid
+bool
+image_io
+::check_configuration(vital::config_block_sptr config) const
+{
+  auto const png_compression =
+    config->get_value<int>("png_compression", png_compression_);
+  auto const jpeg_quality =
+    config->get_value<int>("jpeg_quality", jpeg_quality_);
+  return png_compression >= -1 && png_compression <= 9 &&
+         jpeg_quality >= -1 && jpeg_quality <= 100;
+}
+
 /// Load image image from the file
 ///
 /// \param filename the path to the file to load
@@ -46,7 +99,19 @@ ::save_(const std::string& filename,
        vital::image_container_sptr data) const
 {
   cv::Mat img = ocv::image_container::vital_to_ocv(data->get_image(), ocv::image_container::BGR_COLOR);
-  cv::imwrite(filename.c_str(), img);
+
+  std::vector<int> params;
+  if (png_compression_ >= 0)
+  {
+    params.push_back(cv::IMWRITE_PNG_COMPRESSION);
+    params.push_back(png_compression_);
+  }
+  if (jpeg_quality_ >= 0)
+  {
+    params.push_back(cv::IMWRITE_JPEG_QUALITY);
+    params.push_back(jpeg_quality_);
+  }
+  cv::imwrite(filename.c_str(), img, params);
 }
 
 /// Load image metadata from the file
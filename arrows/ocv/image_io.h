@@ -24,11 +24,15 @@ class KWIVER_ALGO_OCV_EXPORT image_io
   PLUGIN_INFO( "ocv",
                "Read and write image using OpenCV." )
 
-  // No configuration for this class yet
-  /// \cond DoxygenSuppress
-  virtual void set_configuration(vital::config_block_sptr /*config*/) { }
-  virtual bool check_configuration(vital::config_block_sptr /*config*/) const { return true; }
-  /// \endcond
+  /// Constructor
+  image_io();
+
+  /// Get this algorithm's \link vital::config_block configuration block \endlink
+  virtual vital::config_block_sptr get_configuration() const;
+  /// Set this algorithm's properties via a config block
+  virtual void set_configuration(vital::config_block_sptr config);
+  /// Check that the algorithm's currently configuration is valid
+  virtual bool check_configuration(vital::config_block_sptr config) const;
 
 private:
   /// Implementation specific load functionality.
@@ -49,6 +53,12 @@ class KWIVER_ALGO_OCV_EXPORT image_io
   /// \param filename the path to the file to read
   /// \returns pointer to the loaded metadata
   virtual kwiver::vital::metadata_sptr load_metadata_(std::string const& filename) const;
+
+  /// PNG compression level, or -1 for the OpenCV default
+  int png_compression_;
+
+  /// JPEG quality, or -1 for the OpenCV default
+  int jpeg_quality_;
 };
 
 } // end namespace ocv
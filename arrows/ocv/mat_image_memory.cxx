@@ -40,6 +40,7 @@ ::mat_image_memory(const cv::Mat& m)
   }
 #endif
   this->size_ = static_cast<size_t>( m.rows * m.step );
+  this->update_accounting();
 }
 
 /// Destructor
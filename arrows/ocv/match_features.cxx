@@ -9,6 +9,7 @@
 
 #include <vector>
 
+#include <vital/util/trace.h>
 #include <vital/vital_config.h>
 
 #include <arrows/ocv/descriptor_set.h>
@@ -28,6 +29,8 @@ ::match( VITAL_UNUSED vital::feature_set_sptr feat1,
          VITAL_UNUSED vital::feature_set_sptr feat2,
          vital::descriptor_set_sptr desc2) const
 {
+  KWIVER_TRACE_SCOPE( "ocv::match_features" );
+
   // Return empty match set pointer if either of the input sets were empty
   // pointers
   if( !desc1 || !desc2 )
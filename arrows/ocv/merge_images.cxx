@@ -12,6 +12,8 @@
 #include <opencv2/core/core.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
 
+#include <vector>
+
 using namespace kwiver::vital;
 
 namespace kwiver {
@@ -28,26 +30,53 @@ ::merge_images()
 kwiver::vital::image_container_sptr
 merge_images::merge(kwiver::vital::image_container_sptr image1,
                     kwiver::vital::image_container_sptr image2) const
+{
+  return merge(image1, image2, kwiver::vital::image_memory_pool::instance());
+}
+
+/// Merge images into memory taken from a pool
+kwiver::vital::image_container_sptr
+merge_images::merge(kwiver::vital::image_container_sptr image1,
+                    kwiver::vital::image_container_sptr image2,
+                    kwiver::vital::image_memory_pool& pool) const
 {
   cv::Mat cv_image1 = ocv::image_container::vital_to_ocv(image1->get_image(),
     ocv::image_container::RGB_COLOR);
   cv::Mat cv_image2 = ocv::image_container::vital_to_ocv(image2->get_image(),
     ocv::image_container::RGB_COLOR);
-  cv::Mat fin_image;
 
-  std::vector<cv::Mat> channels1, channels2, all_channels;
-  cv::split(cv_image1, channels1);
-  cv::split(cv_image2, channels2);
-  all_channels.insert(all_channels.begin(), channels1.begin(), channels1.end());
-  all_channels.insert(all_channels.end(), channels2.begin(), channels2.end());
+  // Copy the channels of both images straight into the output, which is
+  // not shared with anything, so no intermediate single-channel images or
+  // copies of the output are needed
+  int const channels1 = cv_image1.channels();
+  int const channels2 = cv_image2.channels();
+  size_t const depth = static_cast<size_t>(channels1 + channels2);
+  size_t const width = static_cast<size_t>(cv_image1.cols);
+  size_t const height = static_cast<size_t>(cv_image1.rows);
+
+  // The output is interleaved, so the matrix wraps its pooled memory
+  kwiver::vital::image_pixel_traits const traits =
+    image1->get_image().pixel_traits();
+  kwiver::vital::image_memory_sptr memory =
+    pool.acquire(width * height * depth * traits.num_bytes);
+  kwiver::vital::image fin_image(memory, memory->data(), width, height, depth,
+                  static_cast<ptrdiff_t>(depth),
+                  static_cast<ptrdiff_t>(width * depth), 1, traits);
+  cv::Mat fin_mat = ocv::image_container::vital_to_ocv(fin_image,
+    ocv::image_container::RGB_COLOR);
 
-  cv::merge(all_channels, fin_image);
+  std::vector<int> from_to;
+  for( int c = 0; c < channels1 + channels2; ++c )
+  {
+    from_to.push_back( c );
+    from_to.push_back( c );
+  }
 
-  kwiver::vital::image_container_sptr concatenated_image_container =
-      image_container_sptr(new ocv::image_container(fin_image.clone(),
-                           ocv::image_container::RGB_COLOR));
+  cv::Mat const sources[] = { cv_image1, cv_image2 };
+  cv::mixChannels( sources, 2, &fin_mat, 1, from_to.data(),
+                   channels1 + channels2 );
 
-  return concatenated_image_container;
+  return std::make_shared<kwiver::vital::simple_image_container>(fin_image);
 }
 
 } // end namespace ocv
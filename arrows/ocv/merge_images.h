@@ -42,6 +42,12 @@ class KWIVER_ALGO_OCV_EXPORT merge_images
   kwiver::vital::image_container_sptr
     merge(kwiver::vital::image_container_sptr image1,
           kwiver::vital::image_container_sptr image2) const override;
+
+  /// Merge images into memory taken from a pool
+  kwiver::vital::image_container_sptr
+    merge(kwiver::vital::image_container_sptr image1,
+          kwiver::vital::image_container_sptr image2,
+          kwiver::vital::image_memory_pool& pool) const override;
 };
 
 } // end namespace ocv
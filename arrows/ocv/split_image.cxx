@@ -31,6 +31,27 @@ split_image
 }
 
 /// Split image
+kwiver::vital::config_block_sptr
+split_image
+::get_configuration() const
+{
+  kwiver::vital::config_block_sptr config = algorithm::get_configuration();
+
+  config->set_value( "copy", m_copy,
+                     "Copy the pixels of each part of the image. Otherwise "
+                     "the parts are views sharing the memory of the input "
+                     "image." );
+
+  return config;
+}
+
+void
+split_image
+::set_configuration( kwiver::vital::config_block_sptr config )
+{
+  m_copy = config->get_value< bool >( "copy", m_copy );
+}
+
 std::vector< kwiver::vital::image_container_sptr >
 split_image
 ::split(kwiver::vital::image_container_sptr image) const
@@ -39,8 +60,13 @@ ::split(kwiver::vital::image_container_sptr image) const
   cv::Mat cv_image = ocv::image_container::vital_to_ocv( image->get_image(), ocv::image_container::RGB_COLOR );
   cv::Mat left_image = cv_image( cv::Rect( 0, 0, cv_image.cols/2, cv_image.rows ) );
   cv::Mat right_image = cv_image( cv::Rect( cv_image.cols/2, 0, cv_image.cols/2, cv_image.rows ) );
-  output.push_back( image_container_sptr( new ocv::image_container( left_image.clone(), ocv::image_container::RGB_COLOR ) ) );
-  output.push_back( image_container_sptr( new ocv::image_container( right_image.clone(), ocv::image_container::RGB_COLOR ) ) );
+  if( m_copy )
+  {
+    left_image = left_image.clone();
+    right_image = right_image.clone();
+  }
+  output.push_back( image_container_sptr( new ocv::image_container( left_image, ocv::image_container::RGB_COLOR ) ) );
+  output.push_back( image_container_sptr( new ocv::image_container( right_image, ocv::image_container::RGB_COLOR ) ) );
   return output;
 }
 
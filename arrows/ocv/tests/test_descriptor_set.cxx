@@ -7,6 +7,8 @@
 
 #include <arrows/ocv/descriptor_set.h>
 
+#include <vital/types/packed_descriptor_set.h>
+
 #include <gtest/gtest.h>
 
 using namespace kwiver::vital;
@@ -175,3 +177,24 @@ TYPED_TEST(descriptor_set_conversion, conversion)
   test_conversions( rand_mat<TypeParam>( 125, 20 ) );
   test_conversions( rand_mat<TypeParam>( 256, 10 ) );
 }
+
+// ----------------------------------------------------------------------------
+TEST(descriptor_set, zero_copy)
+{
+  // Descriptors of an OpenCV set refer to the matrix rows
+  cv::Mat data = rand_mat<float>( 10, 32 );
+  ocv::descriptor_set ds( data );
+  auto const d =
+    std::dynamic_pointer_cast< descriptor_array_of<float> >( ds.at( 3 ) );
+  ASSERT_TRUE( d );
+  EXPECT_EQ( data.ptr<float>( 3 ), d->raw_data() );
+
+  // Packed sets convert to OpenCV matrices over the same buffer
+  packed_descriptor_set<float> packed(
+    std::vector<float>( data.ptr<float>(), data.ptr<float>() + 320 ), 32 );
+  cv::Mat mat = ocv::descriptors_to_ocv_matrix( packed );
+  EXPECT_EQ( packed.raw_data(), mat.ptr<float>() );
+  EXPECT_EQ( CV_32F, mat.type() );
+  EXPECT_EQ( data.size(), mat.size() );
+  EXPECT_EQ( 0, cv::countNonZero( mat != data ) );
+}
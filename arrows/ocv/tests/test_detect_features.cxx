@@ -0,0 +1,107 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test tiled OCV feature detection
+
+#include <arrows/ocv/detect_features_FAST.h>
+#include <arrows/ocv/image_container.h>
+
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <utility>
+
+namespace kv = kwiver::vital;
+using namespace kwiver::arrows;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+kv::image_container_sptr
+make_test_image()
+{
+  // random rectangles give plenty of corners all over the image
+  cv::Mat img( 700, 900, CV_8UC1, cv::Scalar( 0 ) );
+  cv::RNG rng( 12345 );
+  for( int i = 0; i < 400; ++i )
+  {
+    cv::Point const p{ rng.uniform( 0, img.cols ), rng.uniform( 0, img.rows ) };
+    cv::Size const s{ rng.uniform( 5, 60 ), rng.uniform( 5, 60 ) };
+    cv::rectangle( img, cv::Rect{ p, s }, cv::Scalar( rng.uniform( 0, 256 ) ),
+                   -1 );
+  }
+  return std::make_shared< ocv::image_container >(
+    img, ocv::image_container::BGR_COLOR );
+}
+
+// ----------------------------------------------------------------------------
+std::set< std::pair< double, double > >
+locations( kv::feature_set_sptr const& features )
+{
+  std::set< std::pair< double, double > > result;
+  for( auto const& f : features->features() )
+  {
+    result.emplace( f->loc().x(), f->loc().y() );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+kv::feature_set_sptr
+detect_FAST( kv::image_container_sptr const& image,
+             unsigned tile_size, unsigned features_per_tile )
+{
+  ocv::detect_features_FAST detector;
+  auto config = detector.get_configuration();
+  config->set_value( "target_num_features_detected", -1 );
+  config->set_value( "tile_size", tile_size );
+  config->set_value( "features_per_tile", features_per_tile );
+  detector.set_configuration( config );
+  return detector.detect( image );
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+TEST ( detect_features, tiled_matches_whole_image )
+{
+  auto const image = make_test_image();
+  auto const whole = detect_FAST( image, 0, 0 );
+  auto const tiled = detect_FAST( image, 256, 0 );
+
+  ASSERT_GT( whole->size(), 100 );
+  EXPECT_EQ( whole->size(), tiled->size() );
+  EXPECT_EQ( locations( whole ), locations( tiled ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( detect_features, features_per_tile )
+{
+  auto const image = make_test_image();
+  auto const whole = detect_FAST( image, 256, 0 );
+  auto const limited = detect_FAST( image, 256, 5 );
+
+  // 900 x 700 in 256 pixel tiles overlapping by 64 makes 5 x 4 tiles
+  EXPECT_LE( limited->size(), 20 * 5 );
+  EXPECT_GE( limited->size(), 10 * 5 );
+
+  auto const all = locations( whole );
+  for( auto const& loc : locations( limited ) )
+  {
+    EXPECT_EQ( 1, all.count( loc ) );
+  }
+}
@@ -371,6 +371,60 @@ TYPED_TEST(image_bgr_conversion, bgra_to_rgba)
   }
 }
 
+// ----------------------------------------------------------------------------
+TYPED_TEST(image_bgr_conversion, bgr_view_round_trip)
+{
+  cv::Mat_<cv::Vec<TypeParam, 3>> bgr{ cv::Size{ 100, 200 } };
+  populate_ocv_image<TypeParam>( bgr );
+
+  // a BGR matrix is viewed as RGB without a copy
+  image rgb = ocv::image_container::ocv_to_vital(
+    bgr, ocv::image_container::BGR_COLOR );
+  EXPECT_EQ( -1, rgb.d_step() );
+  for( int j = 0; j < bgr.rows; ++j )
+  {
+    for( int i = 0; i < bgr.cols; ++i )
+    {
+      for( int c = 0; c < 3; ++c )
+      {
+        ASSERT_EQ( bgr( j, i )[ 2 - c ], rgb.at<TypeParam>( i, j, c ) )
+          << "Pixels differ at " << i << ", " << j << ", " << c;
+      }
+    }
+  }
+
+  // and converted back to BGR without a copy
+  cv::Mat back = ocv::image_container::vital_to_ocv(
+    rgb, ocv::image_container::BGR_COLOR );
+  EXPECT_EQ( bgr.data, back.data );
+}
+
+// ----------------------------------------------------------------------------
+TEST(image, conversion_cache)
+{
+  // a planar image must be copied to make a cv::Mat
+  image_of<uint8_t> img{ 200, 300, 3 };
+  populate_vital_image<uint8_t>( img );
+  simple_image_container container{ img };
+
+  cv::Mat first = ocv::image_container_to_ocv_matrix(
+    container, ocv::image_container::BGR_COLOR );
+  EXPECT_NE( img.first_pixel(), first.data );
+
+  // the copy is reused for the same color mode
+  cv::Mat second = ocv::image_container_to_ocv_matrix(
+    container, ocv::image_container::BGR_COLOR );
+  EXPECT_EQ( first.data, second.data );
+  cv::Mat rgb = ocv::image_container_to_ocv_matrix(
+    container, ocv::image_container::RGB_COLOR );
+  EXPECT_NE( first.data, rgb.data );
+
+  container.clear_conversions();
+  cv::Mat third = ocv::image_container_to_ocv_matrix(
+    container, ocv::image_container::BGR_COLOR );
+  EXPECT_NE( first.data, third.data );
+}
+
 // ----------------------------------------------------------------------------
 template <typename T>
 class get_image : public ::testing::Test
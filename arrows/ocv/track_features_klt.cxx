@@ -23,9 +23,17 @@
 
 #include <vital/exceptions/algorithm.h>
 #include <vital/exceptions/image.h>
+#include <vital/util/thread_pool.h>
 
+#include <opencv2/imgproc/imgproc.hpp>
+#include <opencv2/opencv_modules.hpp>
 #include <opencv2/video/tracking.hpp>
 
+#if defined(HAVE_OPENCV_CUDAOPTFLOW) && KWIVER_OPENCV_VERSION_MAJOR >= 3
+#define KWIVER_OCV_KLT_CUDA
+#include <opencv2/cudaoptflow.hpp>
+#endif
+
 #include <arrows/core/track_set_impl.h>
 
 using namespace kwiver::vital;
@@ -35,7 +43,18 @@ namespace arrows {
 namespace ocv {
 
 typedef std::vector<cv::Mat> image_pyramid;
-typedef std::map<frame_id_t, image_pyramid> image_pyramid_map;
+
+/// The data of a frame needed to track features from or to it
+struct klt_frame
+{
+  /// The image pyramid, when tracking on the CPU
+  image_pyramid pyramid;
+#ifdef KWIVER_OCV_KLT_CUDA
+  /// The gray image in device memory, when tracking on the GPU
+  cv::cuda::GpuMat gpu_image;
+#endif
+};
+typedef std::map<frame_id_t, klt_frame> klt_frame_map;
 
 /// Private implementation class
 class track_features_klt::priv
@@ -53,8 +72,85 @@ class track_features_klt::priv
     erp2(1),
     max_pyramid_level(3),
     target_number_of_features(2048),
-    l1_err_thresh(10)
+    l1_err_thresh(10),
+    use_cuda(false),
+    prev_frame_shared(false)
+  {
+  }
+
+  /// Make the frame data of an image, reusing the buffers of spare_frame
+  klt_frame make_frame(cv::Mat const& image)
+  {
+    klt_frame frame;
+    std::swap(frame, spare_frame);
+#ifdef KWIVER_OCV_KLT_CUDA
+    if (use_cuda)
+    {
+      cv::Mat gray;
+      if (image.channels() == 1)
+      {
+        gray = image;
+      }
+      else
+      {
+        cv::cvtColor(image, gray, cv::COLOR_RGB2GRAY);
+      }
+      frame.gpu_image.upload(gray);
+      return frame;
+    }
+#endif
+    // buildOpticalFlowPyramid reuses levels that already have the right size
+    cv::buildOpticalFlowPyramid(image, frame.pyramid,
+                                cv::Size(win_size, win_size),
+                                max_pyramid_level);
+    return frame;
+  }
+
+  /// Track points from one frame to another
+  ///
+  /// If \p use_initial_flow is set, \p to_points holds the initial
+  /// estimates of the tracked points.
+  void track_points(klt_frame const& from, klt_frame const& to,
+                    std::vector<cv::Point2f> const& from_points,
+                    std::vector<cv::Point2f>& to_points,
+                    std::vector<uchar>& status, std::vector<float>& err,
+                    bool use_initial_flow) const
   {
+    cv::TermCriteria const criteria(
+      cv::TermCriteria::COUNT + cv::TermCriteria::EPS, 30, 0.01);
+#ifdef KWIVER_OCV_KLT_CUDA
+    if (use_cuda)
+    {
+      auto const n = static_cast<int>(from_points.size());
+      cv::cuda::GpuMat gpu_from(cv::Mat(1, n, CV_32FC2,
+        const_cast<cv::Point2f*>(from_points.data())));
+      cv::cuda::GpuMat gpu_to, gpu_status, gpu_err;
+      if (use_initial_flow)
+      {
+        gpu_to.upload(cv::Mat(1, n, CV_32FC2, to_points.data()));
+      }
+      cuda_lk->setUseInitialFlow(use_initial_flow);
+      cuda_lk->calc(from.gpu_image, to.gpu_image, gpu_from, gpu_to,
+                    gpu_status, gpu_err);
+
+      to_points.resize(from_points.size());
+      status.resize(from_points.size());
+      err.resize(from_points.size());
+      cv::Mat to_mat(1, n, CV_32FC2, to_points.data());
+      cv::Mat status_mat(1, n, CV_8UC1, status.data());
+      cv::Mat err_mat(1, n, CV_32FC1, err.data());
+      gpu_to.download(to_mat);
+      gpu_status.download(status_mat);
+      gpu_err.download(err_mat);
+      return;
+    }
+#endif
+    cv::calcOpticalFlowPyrLK(from.pyramid, to.pyramid, from_points,
+                             to_points, status, err,
+                             cv::Size(win_size, win_size),
+                             max_pyramid_level, criteria,
+                             use_initial_flow ? cv::OPTFLOW_USE_INITIAL_FLOW
+                                              : 0);
   }
 
   // sets up a mask based on the points.  We query this mask to find out if a
@@ -160,6 +256,13 @@ class track_features_klt::priv
     config->set_value("klt_path_l1_difference_thresh", l1_err_thresh,
                       "patches with average l1 difference greater than this threshold "
                       "will be discarded.");
+
+    config->set_value("use_cuda", use_cuda,
+                      "track with the OpenCV CUDA sparse optical flow, keeping "
+                      "the gray frames tracked from in device memory, if "
+                      "OpenCV was built with it.  The CUDA tracker measures "
+                      "its error differently, so klt_path_l1_difference_thresh "
+                      "may need a different value.");
   }
 
   /// Set our parameters based on the given config block
@@ -192,6 +295,31 @@ class track_features_klt::priv
     target_number_of_features = config->get_value<int>("target_number_of_features",target_number_of_features);
 
     l1_err_thresh = config->get_value<float>("klt_path_l1_difference_thresh", l1_err_thresh);
+
+    auto const was_cuda = use_cuda;
+    use_cuda = config->get_value<bool>("use_cuda", use_cuda);
+#ifdef KWIVER_OCV_KLT_CUDA
+    if (use_cuda)
+    {
+      cuda_lk = cv::cuda::SparsePyrLKOpticalFlow::create(
+        cv::Size(win_size, win_size), max_pyramid_level, 30);
+    }
+#else
+    if (use_cuda)
+    {
+      LOG_WARN(m_logger, "OpenCV was built without CUDA optical flow; "
+                         "tracking on the CPU");
+      use_cuda = false;
+    }
+#endif
+
+    // frames prepared for one tracker cannot be used by the other
+    if (use_cuda != was_cuda)
+    {
+      prev_frame = klt_frame();
+      spare_frame = klt_frame();
+      det_frames.clear();
+    }
   }
 
   bool check_configuration(vital::config_block_sptr config) const
@@ -378,8 +506,10 @@ class track_features_klt::priv
 
   /// The feature detector algorithm to use
   vital::algo::detect_features_sptr detector;
-  image_pyramid prev_pyramid;
-  image_pyramid_map det_pyramids;
+  klt_frame prev_frame;
+  klt_frame_map det_frames;
+  /// A frame whose buffers are no longer used, to reuse for the next frame
+  klt_frame spare_frame;
   detection_data_map det_data_map;
   frame_id_t prev_frame_num;
   size_t last_detect_num_features;
@@ -397,6 +527,12 @@ class track_features_klt::priv
   int max_pyramid_level;
   int target_number_of_features;
   float l1_err_thresh;
+  bool use_cuda;
+  /// Set if prev_frame is also held by det_frames
+  bool prev_frame_shared;
+#ifdef KWIVER_OCV_KLT_CUDA
+  cv::Ptr<cv::cuda::SparsePyrLKOpticalFlow> cuda_lk;
+#endif
 };
 
 /// Default Constructor
@@ -485,7 +621,6 @@ ::track(feature_track_set_sptr prev_tracks,
         "not all sub-algorithms have been initialized");
   }
 
-  image_pyramid cur_pyramid;
   cv::Mat cv_img = ocv::image_container::vital_to_ocv(image_data->get_image(), ocv::image_container::RGB_COLOR);
   cv::Mat cv_mask;
 
@@ -518,8 +653,7 @@ ::track(feature_track_set_sptr prev_tracks,
   //setup stuff complete
 
   // build pyramid for the current image
-  auto win_size = cv::Size(d_->win_size, d_->win_size);
-  cv::buildOpticalFlowPyramid(cv_img, cur_pyramid, win_size, d_->max_pyramid_level);
+  klt_frame cur_frame = d_->make_frame(cv_img);
 
   feature_track_set_sptr cur_tracks = prev_tracks;  //no clone here.  It is done in the process.
 
@@ -574,8 +708,8 @@ ::track(feature_track_set_sptr prev_tracks,
       d_->det_data_map.erase(rem_det_id);
     }
 
-    cv::calcOpticalFlowPyrLK(d_->prev_pyramid, cur_pyramid, prev_points,
-      tracked_points, status, err, win_size,d_->max_pyramid_level);
+    d_->track_points(d_->prev_frame, cur_frame, prev_points,
+                     tracked_points, status, err, false);
 
     //ok, now we do the tracking for each active track back to the frame where it was detected
     //copy last frame's features
@@ -597,23 +731,27 @@ ::track(feature_track_set_sptr prev_tracks,
       }
     }
 
-    std::set<frame_id_t> det_pyr_to_remove;
-    for (auto &det_pyr_it : d_->det_pyramids)
+    // Refine the tracks of each detection frame by tracking directly from
+    // where they were detected.  Each track started on one detection frame,
+    // so the frames update separate elements of status and tracked_points
+    // and are tracked in parallel on the CPU.
+    std::vector<klt_frame_map::value_type const*> det_frames;
+    for (auto const& det_frame_it : d_->det_frames)
     {
+      det_frames.push_back(&det_frame_it);
+    }
+    std::vector<uchar> det_frame_unused(det_frames.size(), 0);
 
+    auto const track_from_detection = [&](size_t det_i)
+    {
       std::vector<unsigned int> kf_feat_i_in_det_tracking;
       std::vector<cv::Point2f> det_points, det_tracked_points;
 
-      frame_id_t det_frame = det_pyr_it.first;
-      auto &det_pyr = det_pyr_it.second;
+      frame_id_t det_frame = det_frames[det_i]->first;
+      auto const& det_frame_data = det_frames[det_i]->second;
       for (unsigned int kf_feat_i = 0; kf_feat_i < prev_klt_tracks.size(); ++kf_feat_i)
       {
-        if (!status[kf_feat_i])
-        {
-          continue;
-        }
-
-        track_sptr t = prev_klt_tracks[kf_feat_i];
+        track_sptr const& t = prev_klt_tracks[kf_feat_i];
         if (t->empty())
         {
           continue;
@@ -624,11 +762,17 @@ ::track(feature_track_set_sptr prev_tracks,
           continue;
         }
 
+        // checked before the status, which other detection frames update
         if (det_it->second.fid != det_frame)
         {
           continue;
         }
 
+        if (!status[kf_feat_i])
+        {
+          continue;
+        }
+
         auto &det_loc = det_it->second.loc;
 
         kf_feat_i_in_det_tracking.push_back(kf_feat_i);
@@ -639,15 +783,14 @@ ::track(feature_track_set_sptr prev_tracks,
       }
       if (det_tracked_points.empty())
       {
-        det_pyr_to_remove.insert(det_frame);
-        continue;
+        det_frame_unused[det_i] = 1;
+        return;
       }
       std::vector<uchar> det_status;
       std::vector<float> det_err;
 
-      cv::TermCriteria criteria = cv::TermCriteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS,30,0.01);
-      int flags = cv::OPTFLOW_USE_INITIAL_FLOW;
-      cv::calcOpticalFlowPyrLK(det_pyr, cur_pyramid, det_points, det_tracked_points, det_status, det_err, win_size, d_->max_pyramid_level,criteria,flags);
+      d_->track_points(det_frame_data, cur_frame, det_points,
+                       det_tracked_points, det_status, det_err, true);
 
       for (unsigned int det_kf_feat_i = 0; det_kf_feat_i != det_points.size(); ++det_kf_feat_i)
       {
@@ -666,12 +809,36 @@ ::track(feature_track_set_sptr prev_tracks,
 
         tracked_points[kf_feat_i] = det_tracked_points[det_kf_feat_i];
       }
+    };
+
+    if (d_->use_cuda)
+    {
+      // the CUDA tracker has state, so it tracks one frame at a time
+      for (size_t det_i = 0; det_i < det_frames.size(); ++det_i)
+      {
+        track_from_detection(det_i);
+      }
+    }
+    else
+    {
+      vital::thread_pool::instance().parallel_for(
+        det_frames.size(), 1,
+        [&](size_t begin, size_t end)
+        {
+          for (size_t det_i = begin; det_i < end; ++det_i)
+          {
+            track_from_detection(det_i);
+          }
+        });
     }
 
     // limit the stored detection pyramids to ones in which the active tracks started
-    for (auto rem_fid : det_pyr_to_remove)
+    for (size_t det_i = 0; det_i < det_frames.size(); ++det_i)
     {
-      d_->det_pyramids.erase(rem_fid);
+      if (det_frame_unused[det_i])
+      {
+        d_->det_frames.erase(det_frames[det_i]->first);
+      }
     }
 
     //copy last frame's features
@@ -726,7 +893,7 @@ ::track(feature_track_set_sptr prev_tracks,
 
   if( detect_new_features)
   {
-    d_->det_pyramids[frame_number] = cur_pyramid;
+    d_->det_frames[frame_number] = cur_frame;
 
     // detect new features
     // see if there are already existing tracks on this frame
@@ -824,8 +991,16 @@ ::track(feature_track_set_sptr prev_tracks,
     d_->last_detect_distImage.set_from_feature_vector(next_points, image_data);
   }
 
-  //set up previous data structures for next call
-  d_->prev_pyramid = cur_pyramid;
+  //set up previous data structures for next call.  The buffers of the last
+  //previous frame are reused for the next frame, unless a detection frame
+  //still shares them.
+  d_->spare_frame = klt_frame();
+  if (!d_->prev_frame_shared)
+  {
+    std::swap(d_->spare_frame, d_->prev_frame);
+  }
+  d_->prev_frame = std::move(cur_frame);
+  d_->prev_frame_shared = detect_new_features;
   d_->prev_frame_num = frame_number;
 
   return cur_tracks;
@@ -13,13 +13,22 @@
 
 #include <kwiversys/SystemTools.hxx>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <map>
+
 #include <pdal/Dimension.hpp>
+#include <pdal/Filter.hpp>
 #include <pdal/Options.hpp>
+#include <pdal/PointRef.hpp>
 #include <pdal/PointTable.hpp>
 #include <pdal/PointView.hpp>
+#include <pdal/Reader.hpp>
 #include <pdal/StageFactory.hpp>
+#include <pdal/Streamable.hpp>
 
-#include <io/BufferReader.hpp>
 #include <io/BpfReader.hpp>
 #include <io/LasReader.hpp>
 #include <io/PlyReader.hpp>
@@ -27,6 +36,303 @@
 namespace kwiver {
 namespace arrows {
 namespace pdal {
+
+namespace {
+
+// Points held by PDAL at a time when streaming
+constexpr ::pdal::point_count_t stream_capacity = 10000;
+
+// Points per chunk when saving, and per tile buffer when tiling
+constexpr size_t write_chunk_size = 65536;
+
+// Points buffered over all tiles before they are spooled to disk
+constexpr size_t tile_buffer_budget = 1 << 22;
+
+// ----------------------------------------------------------------------------
+// PDAL reader for the extension of a file
+std::string
+reader_driver( vital::path_t const& filename )
+{
+  auto const ext = kwiversys::SystemTools::GetFilenameExtension( filename );
+  if( ext == ".las" )
+  {
+    return "readers.las";
+  }
+  if( ext == ".bpf" )
+  {
+    return "readers.bpf";
+  }
+  if( ext == ".ply" )
+  {
+    return "readers.ply";
+  }
+  throw vital::invalid_file( filename,
+                             "file is not a bpf, las, or ply file." );
+}
+
+// ----------------------------------------------------------------------------
+// Run a pipeline ending in a stage, a few points at a time if every stage
+// supports streaming and all at once otherwise
+void
+execute( ::pdal::Stage& stage )
+{
+  if( stage.pipelineStreamable() )
+  {
+    ::pdal::FixedPointTable table( stream_capacity );
+    stage.prepare( table );
+    stage.execute( table );
+  }
+  else
+  {
+    ::pdal::PointTable table;
+    stage.prepare( table );
+    stage.execute( table );
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Filter passing the points through it to a function in chunks
+class chunk_sink : public ::pdal::Filter, public ::pdal::Streamable
+{
+public:
+  chunk_sink( size_t chunk_size,
+              vital::algo::pointcloud_io::chunk_sink_t const& sink )
+    : m_chunk_size( chunk_size ),
+      m_sink( sink )
+  {
+    m_points.reserve( chunk_size );
+  }
+
+  std::string getName() const override { return "filters.kwiver_chunk_sink"; }
+
+  // Pass on the points of a partial chunk
+  void
+  flush()
+  {
+    if( !m_points.empty() )
+    {
+      m_sink( m_points, m_colors );
+      m_points.clear();
+      m_colors.clear();
+    }
+  }
+
+private:
+  void
+  prepared( ::pdal::PointTableRef table ) override
+  {
+    auto const layout = table.layout();
+    m_has_color = layout->hasDim( ::pdal::Dimension::Id::Red ) &&
+                  layout->hasDim( ::pdal::Dimension::Id::Green ) &&
+                  layout->hasDim( ::pdal::Dimension::Id::Blue );
+  }
+
+  bool
+  processOne( ::pdal::PointRef& point ) override
+  {
+    m_points.emplace_back(
+      point.getFieldAs< double >( ::pdal::Dimension::Id::X ),
+      point.getFieldAs< double >( ::pdal::Dimension::Id::Y ),
+      point.getFieldAs< double >( ::pdal::Dimension::Id::Z ) );
+    if( m_has_color )
+    {
+      m_colors.emplace_back(
+        point.getFieldAs< uint8_t >( ::pdal::Dimension::Id::Red ),
+        point.getFieldAs< uint8_t >( ::pdal::Dimension::Id::Green ),
+        point.getFieldAs< uint8_t >( ::pdal::Dimension::Id::Blue ) );
+    }
+    if( m_points.size() >= m_chunk_size )
+    {
+      flush();
+    }
+    return true;
+  }
+
+  void
+  filter( ::pdal::PointView& view ) override
+  {
+    for( ::pdal::PointId idx = 0; idx < view.size(); ++idx )
+    {
+      ::pdal::PointRef point( view, idx );
+      processOne( point );
+    }
+  }
+
+  size_t m_chunk_size;
+  vital::algo::pointcloud_io::chunk_sink_t const& m_sink;
+  bool m_has_color = false;
+  std::vector< vital::vector_3d > m_points;
+  std::vector< vital::rgb_color > m_colors;
+};
+
+// ----------------------------------------------------------------------------
+// Reader taking its points from a function in chunks
+//
+// The first chunk is read on construction, to find whether the points have
+// colors and where they are.
+class chunk_reader : public ::pdal::Reader, public ::pdal::Streamable
+{
+public:
+  chunk_reader( vital::algo::pointcloud_io::chunk_source_t const& source,
+                vital::vector_3d const& offset )
+    : m_source( source ),
+      m_offset( offset )
+  {
+    next_chunk();
+    m_has_color = !m_colors.empty();
+  }
+
+  std::string getName() const override { return "readers.kwiver_chunks"; }
+
+  /// Check if there are no points at all
+  bool empty() const { return m_points.empty(); }
+
+  /// The first point, with the offset applied
+  vital::vector_3d
+  first_point() const
+  {
+    return m_points.empty() ? m_offset : m_points.front() + m_offset;
+  }
+
+private:
+  bool
+  next_chunk()
+  {
+    m_next = 0;
+    m_points.clear();
+    m_colors.clear();
+    while( !m_done && m_points.empty() )
+    {
+      m_done = !m_source( m_points, m_colors );
+    }
+    if( m_has_color && m_colors.size() != m_points.size() )
+    {
+      throw vital::invalid_value( "pdal::pointcloud_io: number of colors "
+                                  "provided does not match the number of "
+                                  "points" );
+    }
+    return !m_points.empty();
+  }
+
+  void
+  addDimensions( ::pdal::PointLayoutPtr layout ) override
+  {
+    layout->registerDim( ::pdal::Dimension::Id::X );
+    layout->registerDim( ::pdal::Dimension::Id::Y );
+    layout->registerDim( ::pdal::Dimension::Id::Z );
+    if( m_has_color )
+    {
+      layout->registerDim( ::pdal::Dimension::Id::Red );
+      layout->registerDim( ::pdal::Dimension::Id::Green );
+      layout->registerDim( ::pdal::Dimension::Id::Blue );
+    }
+  }
+
+  bool
+  processOne( ::pdal::PointRef& point ) override
+  {
+    if( m_next >= m_points.size() && !next_chunk() )
+    {
+      return false;
+    }
+
+    vital::vector_3d const pt = m_points[ m_next ] + m_offset;
+    point.setField( ::pdal::Dimension::Id::X, pt.x() );
+    point.setField( ::pdal::Dimension::Id::Y, pt.y() );
+    point.setField( ::pdal::Dimension::Id::Z, pt.z() );
+    if( m_has_color )
+    {
+      vital::rgb_color const& rgb = m_colors[ m_next ];
+      point.setField( ::pdal::Dimension::Id::Red, rgb.r );
+      point.setField( ::pdal::Dimension::Id::Green, rgb.g );
+      point.setField( ::pdal::Dimension::Id::Blue, rgb.b );
+    }
+    ++m_next;
+    return true;
+  }
+
+  ::pdal::point_count_t
+  read( ::pdal::PointViewPtr view, ::pdal::point_count_t count ) override
+  {
+    ::pdal::PointId const first = view->size();
+    ::pdal::PointId idx = first;
+    for( ; idx - first < count; ++idx )
+    {
+      ::pdal::PointRef point( *view, idx );
+      if( !processOne( point ) )
+      {
+        break;
+      }
+    }
+    return idx - first;
+  }
+
+  vital::algo::pointcloud_io::chunk_source_t const& m_source;
+  vital::vector_3d m_offset;
+  bool m_has_color = false;
+  bool m_done = false;
+  size_t m_next = 0;
+  std::vector< vital::vector_3d > m_points;
+  std::vector< vital::rgb_color > m_colors;
+};
+
+// ----------------------------------------------------------------------------
+// Points of one tile, buffered in memory and then appended to a spool file
+struct tile_spool
+{
+  std::string path;
+  std::vector< vital::vector_3d > points;
+  std::vector< vital::rgb_color > colors;
+  bool spooled = false;
+};
+
+// Record of a spooled point: position then color
+constexpr size_t spool_record_size = 3 * sizeof( double ) + 3;
+
+// ----------------------------------------------------------------------------
+void
+write_spool( tile_spool& tile )
+{
+  if( tile.points.empty() )
+  {
+    return;
+  }
+
+  std::FILE* f = std::fopen( tile.path.c_str(), tile.spooled ? "ab" : "wb" );
+  if( !f )
+  {
+    VITAL_THROW( vital::file_write_exception, tile.path,
+                 "Could not open tile spool file" );
+  }
+
+  std::vector< unsigned char > buffer( tile.points.size() * spool_record_size );
+  unsigned char* out = buffer.data();
+  for( size_t i = 0; i < tile.points.size(); ++i )
+  {
+    std::memcpy( out, tile.points[ i ].data(), 3 * sizeof( double ) );
+    out += 3 * sizeof( double );
+    vital::rgb_color const rgb =
+      tile.colors.empty() ? vital::rgb_color() : tile.colors[ i ];
+    *out++ = rgb.r;
+    *out++ = rgb.g;
+    *out++ = rgb.b;
+  }
+
+  bool const ok =
+    std::fwrite( buffer.data(), 1, buffer.size(), f ) == buffer.size();
+  if( std::fclose( f ) != 0 || !ok )
+  {
+    VITAL_THROW( vital::file_write_exception, tile.path,
+                 "Could not write tile spool file" );
+  }
+
+  tile.spooled = true;
+  tile.points.clear();
+  tile.colors.clear();
+}
+
+} // end namespace
+
 /// Load point cloud from file with PDAL
 
 kwiver::vital::pointcloud_d
@@ -120,41 +426,208 @@ pointcloud_io
            std::vector< vital::vector_3d > const& points,
            std::vector< vital::rgb_color > const& colors ) const
 {
-  namespace kv = kwiver::vital;
-  kv::logger_handle_t logger( kv::get_logger( "arrows.pdal.pointcloud_io" ) );
-
   if( !colors.empty() && colors.size() != points.size() )
   {
     throw vital::invalid_value( "pdal::pointcloud_io::save_: number of colors "
                                 "provided does not match the number of points" );
   }
 
+  size_t next = 0;
+  save_chunks_( filename,
+    [ & ]( std::vector< vital::vector_3d >& chunk_points,
+           std::vector< vital::rgb_color >& chunk_colors )
+    {
+      if( next >= points.size() )
+      {
+        return false;
+      }
+      auto const end = std::min( points.size(), next + write_chunk_size );
+      chunk_points.assign( points.begin() + next, points.begin() + end );
+      if( !colors.empty() )
+      {
+        chunk_colors.assign( colors.begin() + next, colors.begin() + end );
+      }
+      next = end;
+      return true;
+    } );
+}
+
+/// Read point cloud from a file in chunks with PDAL
+
+void
+pointcloud_io
+  ::load_chunks_( vital::path_t const& filename, size_t chunk_size,
+                  chunk_sink_t const& sink ) const
+{
   ::pdal::Options options;
   options.add( "filename", filename );
-  options.add( "system_id", "KWIVER" );
-  options.add( "offset_x", "auto" );
-  options.add( "offset_y", "auto" );
-  options.add( "offset_z", "auto" );
 
-  ::pdal::PointTable table;
-  table.layout()->registerDim( ::pdal::Dimension::Id::X );
-  table.layout()->registerDim( ::pdal::Dimension::Id::Y );
-  table.layout()->registerDim( ::pdal::Dimension::Id::Z );
-  if( !colors.empty() )
+  ::pdal::StageFactory factory;
+  ::pdal::Stage* reader = factory.createStage( reader_driver( filename ) );
+  reader->setOptions( options );
+
+  chunk_sink filter( chunk_size, sink );
+  filter.setInput( *reader );
+  execute( filter );
+  filter.flush();
+}
+
+/// Write point cloud to a file in chunks with PDAL
+
+void
+pointcloud_io
+  ::save_chunks_( vital::path_t const& filename,
+                  chunk_source_t const& source ) const
+{
+  if( m_tile_size <= 0.0 )
+  {
+    write_las( filename, source );
+    return;
+  }
+
+  // Bin the points into tiles, spooling tiles to disk as their buffers fill
+  // so that memory does not grow with the cloud, then write each tile
+  namespace st = kwiversys::SystemTools;
+  std::string const dir = st::GetFilenamePath( filename );
+  std::string const base = ( dir.empty() ? "" : dir + "/" ) +
+                           st::GetFilenameWithoutLastExtension( filename );
+  std::string const ext = st::GetFilenameLastExtension( filename );
+
+  using tile_key = std::pair< int64_t, int64_t >;
+  std::map< tile_key, tile_spool > tiles;
+  size_t buffered = 0;
+  bool has_color = false;
+
+  std::vector< vital::vector_3d > points;
+  std::vector< vital::rgb_color > colors;
+  bool first = true;
+  while( source( points, colors ) )
+  {
+    if( first && !points.empty() )
+    {
+      has_color = !colors.empty();
+      first = false;
+    }
+    if( has_color && colors.size() != points.size() )
+    {
+      throw vital::invalid_value( "pdal::pointcloud_io: number of colors "
+                                  "provided does not match the number of "
+                                  "points" );
+    }
+
+    for( size_t i = 0; i < points.size(); ++i )
+    {
+      tile_key const key(
+        static_cast< int64_t >( std::floor( points[ i ].x() / m_tile_size ) ),
+        static_cast< int64_t >( std::floor( points[ i ].y() / m_tile_size ) ) );
+      auto& tile = tiles[ key ];
+      if( tile.path.empty() )
+      {
+        tile.path = base + "_" + std::to_string( key.first ) + "_" +
+                    std::to_string( key.second ) + ext + ".spool";
+      }
+      tile.points.push_back( points[ i ] );
+      if( has_color )
+      {
+        tile.colors.push_back( colors[ i ] );
+      }
+
+      ++buffered;
+      if( tile.points.size() >= write_chunk_size )
+      {
+        buffered -= tile.points.size();
+        write_spool( tile );
+      }
+      else if( buffered >= tile_buffer_budget )
+      {
+        for( auto& t : tiles )
+        {
+          write_spool( t.second );
+        }
+        buffered = 0;
+      }
+    }
+  }
+
+  for( auto& t : tiles )
   {
-    table.layout()->registerDim( ::pdal::Dimension::Id::Red );
-    table.layout()->registerDim( ::pdal::Dimension::Id::Green );
-    table.layout()->registerDim( ::pdal::Dimension::Id::Blue );
+    auto& tile = t.second;
+    std::string const tile_path =
+      tile.path.substr( 0, tile.path.size() - std::string( ".spool" ).size() );
+
+    if( !tile.spooled )
+    {
+      // the whole tile is still in memory
+      bool done = false;
+      write_las( tile_path,
+        [ & ]( std::vector< vital::vector_3d >& chunk_points,
+               std::vector< vital::rgb_color >& chunk_colors )
+        {
+          if( done )
+          {
+            return false;
+          }
+          chunk_points.swap( tile.points );
+          chunk_colors.swap( tile.colors );
+          done = true;
+          return true;
+        } );
+      continue;
+    }
+
+    write_spool( tile );
+
+    std::FILE* f = std::fopen( tile.path.c_str(), "rb" );
+    if( !f )
+    {
+      throw vital::invalid_file( tile.path, "Could not open tile spool file" );
+    }
+
+    std::vector< unsigned char > buffer( write_chunk_size * spool_record_size );
+    write_las( tile_path,
+      [ & ]( std::vector< vital::vector_3d >& chunk_points,
+             std::vector< vital::rgb_color >& chunk_colors )
+      {
+        size_t const n =
+          std::fread( buffer.data(), spool_record_size, write_chunk_size, f );
+        chunk_points.resize( n );
+        chunk_colors.resize( has_color ? n : 0 );
+        unsigned char const* in = buffer.data();
+        for( size_t i = 0; i < n; ++i )
+        {
+          std::memcpy( chunk_points[ i ].data(), in, 3 * sizeof( double ) );
+          in += 3 * sizeof( double );
+          if( has_color )
+          {
+            chunk_colors[ i ] = vital::rgb_color( in[ 0 ], in[ 1 ], in[ 2 ] );
+          }
+          in += 3;
+        }
+        return n > 0;
+      } );
+
+    std::fclose( f );
+    std::remove( tile.path.c_str() );
   }
+}
+
+/// Write the points from a source to one LAS file
+
+void
+pointcloud_io
+  ::write_las( vital::path_t const& filename,
+               chunk_source_t const& source ) const
+{
+  ::pdal::Options options;
+  options.add( "filename", filename );
+  options.add( "system_id", "KWIVER" );
 
   int crs = m_lgcs.origin().crs();
-  kv::vector_3d offset( 0.0, 0.0, 0.0 );
+  vital::vector_3d offset( 0.0, 0.0, 0.0 );
 
-  ::pdal::PointViewPtr view;
   // handle special cases of non-geographic coordinates
   if( crs < 0 )
   {
-    view = std::make_shared< ::pdal::PointView >( table );
     options.add( "scale_x", 1e-4 );
     options.add( "scale_y", 1e-4 );
     options.add( "scale_z", 1e-4 );
@@ -162,39 +635,59 @@ pointcloud_io
   else
   {
     offset = m_lgcs.origin().location( vital::SRID::lat_lon_WGS84 );
-    std::string srs_name = "EPSG:" + std::to_string( crs );
-
-    ::pdal::SpatialReference srs;
-    srs = ::pdal::SpatialReference( srs_name );
-    view = std::make_shared< ::pdal::PointView >( table, srs );
+    options.add( "a_srs", "EPSG:" + std::to_string( crs ) );
   }
 
-  for( unsigned int id = 0; id < points.size(); ++id )
-  {
-    kv::vector_3d pt = points[ id ] + offset;
-    view->setField( ::pdal::Dimension::Id::X, id, pt.x() );
-    view->setField( ::pdal::Dimension::Id::Y, id, pt.y() );
-    view->setField( ::pdal::Dimension::Id::Z, id, pt.z() );
-    if( !colors.empty() )
-    {
-      kv::rgb_color const& rgb = colors[ id ];
-      view->setField( ::pdal::Dimension::Id::Red, id, rgb.r );
-      view->setField( ::pdal::Dimension::Id::Green, id, rgb.g );
-      view->setField( ::pdal::Dimension::Id::Blue, id, rgb.b );
-    }
-  }
+  chunk_reader reader( source, offset );
 
-  ::pdal::BufferReader reader;
-  reader.addView( view );
+  // The points are not all known up front when streaming, so offset them
+  // from the first point rather than the center of their bounds
+  vital::vector_3d const origin = reader.first_point();
+  options.add( "offset_x", std::floor( origin.x() ) );
+  options.add( "offset_y", std::floor( origin.y() ) );
+  options.add( "offset_z", std::floor( origin.z() ) );
 
   ::pdal::StageFactory factory;
   ::pdal::Stage* writer = factory.createStage( "writers.las" );
 
   writer->setInput( reader );
   writer->setOptions( options );
-  writer->prepare( table );
-  writer->execute( table );
+  execute( *writer );
 }
+
+/// Get this algorithm's configuration block
+
+vital::config_block_sptr
+pointcloud_io
+  ::get_configuration() const
+{
+  auto config = vital::algo::pointcloud_io::get_configuration();
+  config->set_value( "tile_size", m_tile_size,
+                     "Size of the square tiles, in the units of the points, "
+                     "that saved point clouds are split into. Each tile is "
+                     "written to its own file, named by adding the tile "
+                     "column and row to the file name. 0 writes one file." );
+  return config;
+}
+
+/// Set this algorithm's properties via a config block
+
+void
+pointcloud_io
+  ::set_configuration( vital::config_block_sptr config )
+{
+  m_tile_size = config->get_value< double >( "tile_size", m_tile_size );
+}
+
+/// Check that the algorithm's configuration config_block is valid
+
+bool
+pointcloud_io
+  ::check_configuration( vital::config_block_sptr config ) const
+{
+  return config->get_value< double >( "tile_size", m_tile_size ) >= 0.0;
+}
+
 } // end namespace pdal
 } // end namespace arrows
 } // end namespace kwiver
@@ -24,14 +24,14 @@ class KWIVER_ALGO_PDAL_EXPORT pointcloud_io
   PLUGIN_INFO( "pdal",
                "Use PDAL to write and read point clouds." );
 
-  /// \cond DoxygenSuppress
-  virtual void
-  set_configuration( vital::config_block_sptr /*config*/ ) {}
+  /// Get this algorithm's \link vital::config_block configuration block \endlink
+  vital::config_block_sptr get_configuration() const override;
 
-  virtual bool
-  check_configuration( vital::config_block_sptr /*config*/ )
-  const { return true; }
-  /// \endcond
+  /// Set this algorithm's properties via a config block
+  void set_configuration( vital::config_block_sptr config ) override;
+
+  /// Check that the algorithm's configuration config_block is valid
+  bool check_configuration( vital::config_block_sptr config ) const override;
 
   void
   set_local_geo_cs( vital::local_geo_cs const& lgcs ) { m_lgcs = lgcs; }
@@ -39,11 +39,24 @@ class KWIVER_ALGO_PDAL_EXPORT pointcloud_io
 private:
   vital::local_geo_cs m_lgcs;
 
+  /// Size of the square tiles, in the units of the points, that saved
+  /// clouds are split into; 0 writes a single file
+  double m_tile_size = 0.0;
+
   kwiver::vital::pointcloud_d load_( vital::path_t const& filename ) const;
 
   void save_( vital::path_t const& filename,
               std::vector< vital::vector_3d > const& points,
               std::vector< vital::rgb_color > const& colors ) const;
+
+  void load_chunks_( vital::path_t const& filename, size_t chunk_size,
+                     chunk_sink_t const& sink ) const override;
+
+  void save_chunks_( vital::path_t const& filename,
+                     chunk_source_t const& source ) const override;
+
+  void write_las( vital::path_t const& filename,
+                  chunk_source_t const& source ) const;
 };
 } // end namespace pdal
 } // end namespace arrows
@@ -170,3 +170,132 @@ TEST_F ( pointcloud_io, save_landmarks )
   pc_io.set_local_geo_cs( lgcs );
   pc_io.save( tmp_path, landmark_map );
 }
+
+TEST_F ( pointcloud_io, load_chunks )
+{
+  auto pc_io = kwiver::arrows::pdal::pointcloud_io();
+
+  for( std::string ext : { ".bpf", ".las", ".ply" } )
+  {
+    auto const octahedron_path = data_dir + "/" + octahedron_base + ext;
+    auto const expected = pc_io.load( octahedron_path );
+
+    std::vector< size_t > sizes;
+    std::vector< kv::vector_3d > points;
+    std::vector< kv::rgb_color > colors;
+    pc_io.load_chunks( octahedron_path, 4,
+      [ & ]( std::vector< kv::vector_3d > const& chunk_points,
+             std::vector< kv::rgb_color > const& chunk_colors )
+      {
+        sizes.push_back( chunk_points.size() );
+        EXPECT_EQ( chunk_points.size(), chunk_colors.size() );
+        points.insert( points.end(),
+                       chunk_points.begin(), chunk_points.end() );
+        colors.insert( colors.end(),
+                       chunk_colors.begin(), chunk_colors.end() );
+      } );
+
+    EXPECT_EQ( ( std::vector< size_t >{ 4, 2 } ), sizes );
+    ASSERT_EQ( expected.positions().size(), points.size() );
+    for( unsigned int i = 0; i < points.size(); ++i )
+    {
+      EXPECT_TRUE( points[ i ].isApprox( expected.positions()[ i ],
+                                         0.0000001 ) );
+      EXPECT_EQ( expected.colors()[ i ], colors[ i ] );
+    }
+  }
+}
+
+TEST_F ( pointcloud_io, save_chunks )
+{
+  auto const octahedron_path = data_dir + "/" + octahedron_base + ".las";
+  auto const tmp_path = data_dir + "/" + tmp_file;
+
+  struct _tmp_file_deleter
+  {
+    ~_tmp_file_deleter()
+    {
+      std::remove( tmp_path.c_str() );
+    }
+
+    std::string tmp_path;
+  } tmp_file_deleter{ tmp_path };
+
+  auto pc_io = kwiver::arrows::pdal::pointcloud_io();
+  auto const expected = pc_io.load( octahedron_path );
+
+  // Write the cloud back a point at a time
+  size_t next = 0;
+  pc_io.save_chunks( tmp_path,
+    [ & ]( std::vector< kv::vector_3d >& points,
+           std::vector< kv::rgb_color >& colors )
+    {
+      if( next >= expected.positions().size() )
+      {
+        return false;
+      }
+      points.assign( 1, expected.positions()[ next ] );
+      colors.assign( 1, expected.colors()[ next ] );
+      ++next;
+      return true;
+    } );
+
+  auto const actual = pc_io.load( tmp_path );
+  ASSERT_EQ( expected.positions().size(), actual.positions().size() );
+  for( unsigned int i = 0; i < actual.positions().size(); ++i )
+  {
+    EXPECT_TRUE( actual.positions()[ i ].isApprox( expected.positions()[ i ],
+                                                   0.0001 ) );
+    EXPECT_EQ( expected.colors()[ i ], actual.colors()[ i ] );
+  }
+}
+
+TEST_F ( pointcloud_io, save_tiles )
+{
+  auto const tmp_path = data_dir + "/" + tmp_file;
+  auto const tile_path = [ & ]( std::string const& tile ){
+    return data_dir + "/pointcloud_data/pointcloud_" + tile + ".las";
+  };
+  std::vector< std::string > const tiles = { "-1_-1", "-1_0", "0_-1", "0_0" };
+
+  struct _tmp_files_deleter
+  {
+    ~_tmp_files_deleter()
+    {
+      for( auto const& path : paths )
+      {
+        std::remove( path.c_str() );
+      }
+    }
+
+    std::vector< std::string > paths;
+  } tmp_files_deleter;
+  for( auto const& tile : tiles )
+  {
+    tmp_files_deleter.paths.push_back( tile_path( tile ) );
+  }
+
+  auto pc_io = kwiver::arrows::pdal::pointcloud_io();
+  auto config = pc_io.get_configuration();
+  config->set_value( "tile_size", 1.0 );
+  ASSERT_TRUE( pc_io.check_configuration( config ) );
+  pc_io.set_configuration( config );
+
+  // One point in each of four tiles around the origin
+  std::vector< kv::vector_3d > const points = {
+    kv::vector_3d( -0.5, -0.5, 0.0 ),
+    kv::vector_3d( -0.5, 0.5, 0.0 ),
+    kv::vector_3d( 0.5, -0.5, 0.0 ),
+    kv::vector_3d( 0.5, 0.5, 0.0 ) };
+  pc_io.save( tmp_path, points, {} );
+
+  for( unsigned int i = 0; i < tiles.size(); ++i )
+  {
+    auto const tile = pc_io.load( tile_path( tiles[ i ] ) );
+    ASSERT_EQ( 1, tile.positions().size() );
+    EXPECT_TRUE( tile.positions()[ 0 ].isApprox( points[ i ], 0.0001 ) );
+  }
+
+  config->set_value( "tile_size", -1.0 );
+  EXPECT_FALSE( pc_io.check_configuration( config ) );
+}
@@ -186,6 +186,57 @@ extract_props( props_t& props, PJ* proj )
   }
 }
 
+// ----------------------------------------------------------------------------
+template < typename Point >
+void
+convert_points( Point* points, size_t count, int from, int to )
+{
+  if( !count )
+  {
+    return;
+  }
+
+  auto const proj = projection( from, to );
+
+  if( proj_angular_input( proj, PJ_FWD ) )
+  {
+    for( size_t i = 0; i < count; ++i )
+    {
+      points[ i ][ 0 ] = proj_torad( points[ i ][ 0 ] );
+      points[ i ][ 1 ] = proj_torad( points[ i ][ 1 ] );
+    }
+  }
+
+  // The coordinates are transformed where they are, stepping over whole
+  // points; 2D points have no Z to transform
+  constexpr auto has_z = ( Point::RowsAtCompileTime > 2 );
+  auto const stride = sizeof( Point );
+
+  proj_errno_reset( proj );
+  proj_trans_generic( proj, PJ_FWD,
+                      points[ 0 ].data() + 0, stride, count,
+                      points[ 0 ].data() + 1, stride, count,
+                      ( has_z ? points[ 0 ].data() + 2 : nullptr ),
+                      ( has_z ? stride : 0 ), ( has_z ? count : 0 ),
+                      nullptr, 0, 0 );
+  if( auto const err = proj_errno( proj ) )
+  {
+    auto const msg =
+      "PROJ conversion failed: error " + std::to_string( err ) +
+      ": " + proj_errno_string( err );
+    throw std::runtime_error( msg );
+  }
+
+  if( proj_angular_output( proj, PJ_FWD ) )
+  {
+    for( size_t i = 0; i < count; ++i )
+    {
+      points[ i ][ 0 ] = proj_todeg( points[ i ][ 0 ] );
+      points[ i ][ 1 ] = proj_todeg( points[ i ][ 1 ] );
+    }
+  }
+}
+
 } // namespace <anonymous>
 
 // ----------------------------------------------------------------------------
@@ -307,6 +358,22 @@ ::operator()( vital::vector_3d const& point, int from, int to )
   return { c.v[ 0 ], c.v[ 1 ], c.v[ 2 ] };
 }
 
+// ----------------------------------------------------------------------------
+void
+geo_conversion
+::operator()( vital::vector_2d* points, size_t count, int from, int to )
+{
+  convert_points( points, count, from, to );
+}
+
+// ----------------------------------------------------------------------------
+void
+geo_conversion
+::operator()( vital::vector_3d* points, size_t count, int from, int to )
+{
+  convert_points( points, count, from, to );
+}
+
 } // namespace proj
 
 } // namespace arrows
@@ -38,6 +38,14 @@ class KWIVER_ALGO_PROJ_EXPORT geo_conversion
   /// Conversion operator
   vital::vector_3d operator()(
     vital::vector_3d const& point, int from, int to ) override;
+
+  /// Batch conversion operator
+  void operator()(
+    vital::vector_2d* points, size_t count, int from, int to ) override;
+
+  /// Batch conversion operator
+  void operator()(
+    vital::vector_3d* points, size_t count, int from, int to ) override;
 };
 
 } // namespace proj
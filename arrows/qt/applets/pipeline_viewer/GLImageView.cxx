@@ -0,0 +1,399 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "GLImageView.h"
+
+#include <arrows/qt/image_container.h>
+
+#include <QImage>
+#include <QOpenGLContext>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLVertexArrayObject>
+#include <QVector4D>
+
+#include <algorithm>
+#include <cstring>
+
+using qt_image_container = kwiver::arrows::qt::image_container;
+
+namespace kwiver {
+
+namespace tools {
+
+namespace {
+
+// Quad covering the image rectangle, made from the vertex index
+char const* const vertexShader =
+  "out vec2 texCoord;\n"
+  "uniform vec4 rect;\n"
+  "void main()\n"
+  "{\n"
+  "  vec2 c = vec2( float( gl_VertexID & 1 ), float( gl_VertexID >> 1 ) );\n"
+  "  texCoord = c;\n"
+  "  gl_Position = vec4( mix( rect.xy, rect.zw, c ), 0.0, 1.0 );\n"
+  "}\n";
+
+char const* const fragmentShader =
+  "in vec2 texCoord;\n"
+  "out vec4 color;\n"
+  "uniform sampler2D image;\n"
+  "void main()\n"
+  "{\n"
+  "  color = texture( image, texCoord );\n"
+  "}\n";
+
+// ----------------------------------------------------------------------------
+QByteArray
+shaderSource( QOpenGLContext const* context, char const* body )
+{
+  auto source = QByteArray{
+    context->isOpenGLES()
+    ? "#version 300 es\nprecision mediump float;\n"
+    : "#version 330 core\n" };
+  return source + body;
+}
+
+} // namespace (anonymous)
+
+// ----------------------------------------------------------------------------
+class GLImageViewPrivate
+{
+public:
+  // Pixels of a frame as they are uploaded
+  struct Pixels
+  {
+    void const* data;
+    int width;
+    int height;
+    int depth;
+    int rowLength; // in pixels
+  };
+
+  void upload( GLImageView* q, vital::image_container_sptr const& image );
+  void uploadPixels( GLImageView* q, Pixels const& pixels );
+
+  bool updatesSuspended = false;
+  ImageView::ScaleMode scaleMode = ImageView::OriginalSize;
+
+  vital::image_container_sptr lastImage;
+
+  // Newest image given since the last repaint, not yet uploaded
+  vital::image_container_sptr pendingImage;
+
+  QOpenGLShaderProgram program;
+  QOpenGLVertexArrayObject vao;
+
+  GLuint texture = 0;
+  int textureWidth = 0;
+  int textureHeight = 0;
+  int textureDepth = 0;
+
+  // Frames alternate between two pixel buffers, so that filling one
+  // does not wait for the transfer from the other
+  GLuint buffers[ 2 ] = { 0, 0 };
+  size_t bufferSizes[ 2 ] = { 0, 0 };
+  int nextBuffer = 0;
+};
+
+KQ_IMPLEMENT_D_FUNC( GLImageView )
+
+// ----------------------------------------------------------------------------
+void
+GLImageViewPrivate
+::upload( GLImageView* q, vital::image_container_sptr const& image )
+{
+  auto const& img = image->get_image();
+  if( !img.first_pixel() || !img.width() || !img.height() )
+  {
+    return;
+  }
+
+  // Interleaved 8-bit gray, RGB and RGBA pixels are used in place
+  auto const depth = static_cast< ptrdiff_t >( img.depth() );
+  if( img.pixel_traits() == vital::image_pixel_traits_of< uint8_t >() &&
+      ( depth == 1 || depth == 3 || depth == 4 ) &&
+      img.d_step() == 1 && img.w_step() == depth &&
+      img.h_step() >= static_cast< ptrdiff_t >( img.width() ) * depth &&
+      img.h_step() % depth == 0 )
+  {
+    this->uploadPixels(
+      q, { img.first_pixel(),
+           static_cast< int >( img.width() ),
+           static_cast< int >( img.height() ),
+           static_cast< int >( depth ),
+           static_cast< int >( img.h_step() / depth ) } );
+    return;
+  }
+
+  // Anything else is converted to RGBA first
+  auto const& converted =
+    qt_image_container::vital_to_qt( img ).convertToFormat(
+      QImage::Format_RGBA8888 );
+  this->uploadPixels(
+    q, { converted.constBits(), converted.width(), converted.height(), 4,
+         converted.bytesPerLine() / 4 } );
+}
+
+// ----------------------------------------------------------------------------
+void
+GLImageViewPrivate
+::uploadPixels( GLImageView* q, Pixels const& pixels )
+{
+  static GLenum const formats[] = { GL_RED, GL_RG, GL_RGB, GL_RGBA };
+  static GLint const internalFormats[] = { GL_R8, GL_RG8, GL_RGB8, GL_RGBA8 };
+  auto const format = formats[ pixels.depth - 1 ];
+
+  q->glBindTexture( GL_TEXTURE_2D, this->texture );
+
+  if( pixels.width != this->textureWidth ||
+      pixels.height != this->textureHeight ||
+      pixels.depth != this->textureDepth )
+  {
+    q->glTexImage2D( GL_TEXTURE_2D, 0, internalFormats[ pixels.depth - 1 ],
+                     pixels.width, pixels.height, 0, format,
+                     GL_UNSIGNED_BYTE, nullptr );
+
+    // Gray is shown on all channels; alpha is ignored
+    auto const gray = ( pixels.depth == 1 );
+    q->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G,
+                        gray ? GL_RED : GL_GREEN );
+    q->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B,
+                        gray ? GL_RED : GL_BLUE );
+    q->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_ONE );
+
+    this->textureWidth = pixels.width;
+    this->textureHeight = pixels.height;
+    this->textureDepth = pixels.depth;
+  }
+
+  auto const rowBytes = static_cast< size_t >( pixels.rowLength ) *
+                        static_cast< size_t >( pixels.depth );
+  auto const bytes =
+    rowBytes * static_cast< size_t >( pixels.height - 1 ) +
+    static_cast< size_t >( pixels.width ) *
+    static_cast< size_t >( pixels.depth );
+
+  q->glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+  q->glPixelStorei( GL_UNPACK_ROW_LENGTH, pixels.rowLength );
+
+  // Copy the pixels into a buffer whose transfer to the texture the driver
+  // can do asynchronously; fresh storage is requested each time so that
+  // the copy does not wait for a transfer still reading the old contents
+  auto const buffer = this->nextBuffer;
+  this->nextBuffer = 1 - buffer;
+
+  q->glBindBuffer( GL_PIXEL_UNPACK_BUFFER, this->buffers[ buffer ] );
+  this->bufferSizes[ buffer ] = std::max( this->bufferSizes[ buffer ], bytes );
+  q->glBufferData( GL_PIXEL_UNPACK_BUFFER,
+                   static_cast< GLsizeiptr >( this->bufferSizes[ buffer ] ),
+                   nullptr, GL_STREAM_DRAW );
+
+  auto* const mapped = q->glMapBufferRange(
+    GL_PIXEL_UNPACK_BUFFER, 0, static_cast< GLsizeiptr >( bytes ),
+    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT );
+  if( mapped )
+  {
+    std::memcpy( mapped, pixels.data, bytes );
+    q->glUnmapBuffer( GL_PIXEL_UNPACK_BUFFER );
+    q->glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, pixels.width, pixels.height,
+                        format, GL_UNSIGNED_BYTE, nullptr );
+    q->glBindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+  }
+  else
+  {
+    // Upload from the image memory directly if the buffer is unavailable
+    q->glBindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+    q->glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, pixels.width, pixels.height,
+                        format, GL_UNSIGNED_BYTE, pixels.data );
+  }
+
+  q->glPixelStorei( GL_UNPACK_ROW_LENGTH, 0 );
+}
+
+// ----------------------------------------------------------------------------
+GLImageView
+::GLImageView( QWidget* parent )
+  : QOpenGLWidget{ parent }, d_ptr{ new GLImageViewPrivate }
+{
+}
+
+// ----------------------------------------------------------------------------
+GLImageView
+::~GLImageView()
+{
+  KQ_D();
+
+  if( this->context() )
+  {
+    this->makeCurrent();
+    this->glDeleteBuffers( 2, d->buffers );
+    this->glDeleteTextures( 1, &d->texture );
+    d->vao.destroy();
+    d->program.removeAllShaders();
+    this->doneCurrent();
+  }
+}
+
+// ----------------------------------------------------------------------------
+bool
+GLImageView
+::isSupported()
+{
+  QOpenGLContext context;
+  if( !context.create() )
+  {
+    return false;
+  }
+
+  auto const version = context.format().version();
+  return version >= ( context.isOpenGLES() ? qMakePair( 3, 0 )
+                                           : qMakePair( 3, 3 ) );
+}
+
+// ----------------------------------------------------------------------------
+bool
+GLImageView
+::updatesSuspended() const
+{
+  KQ_D();
+  return d->updatesSuspended;
+}
+
+// ----------------------------------------------------------------------------
+void
+GLImageView
+::setUpdatesSuspended( bool suspend )
+{
+  KQ_D();
+
+  d->updatesSuspended = suspend;
+
+  if( !suspend )
+  {
+    displayImage( d->lastImage );
+  }
+}
+
+// ----------------------------------------------------------------------------
+ImageView::ScaleMode
+GLImageView
+::scaleMode() const
+{
+  KQ_D();
+  return d->scaleMode;
+}
+
+// ----------------------------------------------------------------------------
+void
+GLImageView
+::setScaleMode( ImageView::ScaleMode mode )
+{
+  KQ_D();
+
+  d->scaleMode = mode;
+  this->update();
+}
+
+// ----------------------------------------------------------------------------
+void
+GLImageView
+::displayImage( vital::image_container_sptr const& image )
+{
+  KQ_D();
+
+  auto const first = !d->lastImage;
+  d->lastImage = image;
+
+  if( image && ( first || !d->updatesSuspended ) )
+  {
+    // Images replaced before the next repaint are never uploaded
+    d->pendingImage = image;
+    this->update();
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+GLImageView
+::initializeGL()
+{
+  KQ_D();
+
+  this->initializeOpenGLFunctions();
+
+  auto* const context = this->context();
+  d->program.addShaderFromSourceCode(
+    QOpenGLShader::Vertex, shaderSource( context, vertexShader ) );
+  d->program.addShaderFromSourceCode(
+    QOpenGLShader::Fragment, shaderSource( context, fragmentShader ) );
+  d->program.link();
+
+  // Core profiles draw nothing without a vertex array, even an empty one
+  d->vao.create();
+
+  this->glGenTextures( 1, &d->texture );
+  this->glBindTexture( GL_TEXTURE_2D, d->texture );
+  this->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+  this->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+  this->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+  this->glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+
+  this->glGenBuffers( 2, d->buffers );
+
+  // A new context (e.g. after reparenting) needs the image again
+  d->textureWidth = d->textureHeight = d->textureDepth = 0;
+  d->bufferSizes[ 0 ] = d->bufferSizes[ 1 ] = 0;
+  d->pendingImage = d->lastImage;
+}
+
+// ----------------------------------------------------------------------------
+void
+GLImageView
+::paintGL()
+{
+  KQ_D();
+
+  this->glClearColor( 0.0f, 0.0f, 0.0f, 1.0f );
+  this->glClear( GL_COLOR_BUFFER_BIT );
+
+  if( d->pendingImage )
+  {
+    d->upload( this, d->pendingImage );
+    d->pendingImage.reset();
+  }
+
+  if( !d->textureWidth || !d->textureHeight )
+  {
+    return;
+  }
+
+  // Place the image in the center of the view, in device pixels
+  auto const ratio = this->devicePixelRatioF();
+  auto const vw = this->width() * ratio;
+  auto const vh = this->height() * ratio;
+  auto scale = 1.0;
+  if( d->scaleMode == ImageView::FitToWindow )
+  {
+    scale = std::min( vw / d->textureWidth, vh / d->textureHeight );
+  }
+  auto const sx = static_cast< float >( scale * d->textureWidth / vw );
+  auto const sy = static_cast< float >( scale * d->textureHeight / vh );
+
+  // Image rows run from the top of the view down
+  d->program.bind();
+  d->program.setUniformValue( "rect", QVector4D{ -sx, sy, sx, -sy } );
+  d->program.setUniformValue( "image", 0 );
+
+  this->glActiveTexture( GL_TEXTURE0 );
+  this->glBindTexture( GL_TEXTURE_2D, d->texture );
+
+  d->vao.bind();
+  this->glDrawArrays( GL_TRIANGLE_STRIP, 0, 4 );
+  d->vao.release();
+  d->program.release();
+}
+
+} // namespace tools
+
+} // namespace kwiver
@@ -0,0 +1,66 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_TOOLS_PIPELINE_VIEWER_GLIMAGEVIEW_H_
+#define KWIVER_TOOLS_PIPELINE_VIEWER_GLIMAGEVIEW_H_
+
+#include "ImageView.h"
+
+#include <arrows/qt/kq_global.h>
+
+#include <vital/types/image_container.h>
+
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLWidget>
+
+namespace kwiver {
+
+namespace tools {
+
+class GLImageViewPrivate;
+
+// ----------------------------------------------------------------------------
+/// Image view drawing frames as OpenGL textures.
+///
+/// Frames are uploaded from the memory of the vital image through pixel
+/// buffer objects, without conversion when the pixels are interleaved 8-bit
+/// gray, RGB or RGBA. Only the newest frame given before each repaint is
+/// uploaded; repaints are synchronized with the display, so frames arriving
+/// faster than the display refresh rate are dropped without being touched.
+class GLImageView : public QOpenGLWidget, protected QOpenGLExtraFunctions
+{
+  Q_OBJECT
+
+public:
+  explicit GLImageView( QWidget* parent = nullptr );
+
+  ~GLImageView();
+
+  /// Test if OpenGL 3.3, or OpenGL ES 3.0, is available for this view.
+  static bool isSupported();
+
+  bool updatesSuspended() const;
+  void setUpdatesSuspended( bool suspend );
+
+  ImageView::ScaleMode scaleMode() const;
+  void setScaleMode( ImageView::ScaleMode mode );
+
+public slots:
+  void displayImage( kwiver::vital::image_container_sptr const& image );
+
+protected:
+  KQ_DECLARE_PRIVATE_RPTR( GLImageView );
+
+  void initializeGL() override;
+  void paintGL() override;
+
+private:
+  KQ_DECLARE_PRIVATE( GLImageView );
+};
+
+} // namespace tools
+
+} // namespace kwiver
+
+#endif
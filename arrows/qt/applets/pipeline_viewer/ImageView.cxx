@@ -4,6 +4,8 @@
 
 #include "ImageView.h"
 
+#include <arrows/qt/image_container.h>
+
 #include <QGraphicsPixmapItem>
 #include <QGraphicsScene>
 #include <QPaintEvent>
@@ -128,6 +130,28 @@ ::displayImage( QImage const& image )
   }
 }
 
+// ----------------------------------------------------------------------------
+void
+ImageView
+::displayImage( vital::image_container_sptr const& image )
+{
+  using qt_image_container = kwiver::arrows::qt::image_container;
+
+  if( !image )
+  {
+    return;
+  }
+
+  if( auto qi = std::dynamic_pointer_cast< qt_image_container >( image ) )
+  {
+    this->displayImage( static_cast< QImage >( *qi ) );
+  }
+  else
+  {
+    this->displayImage( qt_image_container::vital_to_qt( image->get_image() ) );
+  }
+}
+
 } // namespace tools
 
 } // namespace kwiver
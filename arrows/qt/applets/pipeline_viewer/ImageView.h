@@ -7,6 +7,8 @@
 
 #include <arrows/qt/kq_global.h>
 
+#include <vital/types/image_container.h>
+
 #include <QGraphicsView>
 
 namespace kwiver {
@@ -39,6 +41,7 @@ class ImageView : public QGraphicsView
 
 public slots:
   void displayImage( QImage const& image );
+  void displayImage( kwiver::vital::image_container_sptr const& image );
 
 protected:
   KQ_DECLARE_PRIVATE_RPTR( ImageView );
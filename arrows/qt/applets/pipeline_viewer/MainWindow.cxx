@@ -5,6 +5,7 @@
 #include "MainWindow.h"
 #include "ui_MainWindow.h"
 
+#include "GLImageView.h"
 #include "ImageView.h"
 #include "PipelineWorker.h"
 
@@ -19,6 +20,9 @@ class MainWindowPrivate
 {
 public:
   Ui::MainWindow ui;
+
+  // Replaces ui.imageView when OpenGL is available
+  GLImageView* glImageView = nullptr;
 };
 
 KQ_IMPLEMENT_D_FUNC( MainWindow )
@@ -32,6 +36,13 @@ ::MainWindow( QWidget* parent )
 
   d->ui.setupUi( this );
 
+  if( GLImageView::isSupported() )
+  {
+    d->glImageView = new GLImageView{ this };
+    this->setCentralWidget( d->glImageView );
+    d->ui.imageView = nullptr;
+  }
+
   connect( d->ui.actionExecutePipeline, &QAction::triggered,
            this, QOverload<>::of( &MainWindow::executePipeline ) );
   connect( d->ui.actionSuspendUpdates, &QAction::toggled,
@@ -75,8 +86,18 @@ ::executePipeline( QString const& path )
     d->ui.actionExecutePipeline->setEnabled( false );
     d->ui.actionSuspendUpdates->setEnabled( true );
 
-    connect( &worker, &PipelineWorker::imageAvailable,
-             d->ui.imageView, &ImageView::displayImage );
+    connect( &worker, &PipelineWorker::imageAvailable, this,
+             [ d, &worker ]{
+               auto const& image = worker.takeImage();
+               if( d->glImageView )
+               {
+                 d->glImageView->displayImage( image );
+               }
+               else
+               {
+                 d->ui.imageView->displayImage( image );
+               }
+             } );
 
     worker.execute();
 
@@ -99,7 +120,15 @@ MainWindow
 ::setUpdatesSuspended( bool suspend )
 {
   KQ_D();
-  d->ui.imageView->setUpdatesSuspended( suspend );
+
+  if( d->glImageView )
+  {
+    d->glImageView->setUpdatesSuspended( suspend );
+  }
+  else
+  {
+    d->ui.imageView->setUpdatesSuspended( suspend );
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -118,8 +147,15 @@ ::setFitToWindow( bool fit )
 {
   KQ_D();
 
-  d->ui.imageView->setScaleMode(
-    fit ? ImageView::FitToWindow : ImageView::OriginalSize );
+  auto const mode = ( fit ? ImageView::FitToWindow : ImageView::OriginalSize );
+  if( d->glImageView )
+  {
+    d->glImageView->setScaleMode( mode );
+  }
+  else
+  {
+    d->ui.imageView->setScaleMode( mode );
+  }
 }
 
 } // namespace tools
@@ -4,24 +4,31 @@
 
 #include "PipelineWorker.h"
 
-#include <arrows/qt/image_container.h>
-
 #include <sprokit/processes/adapters/adapter_data_set.h>
 
 #include <QMessageBox>
+#include <QMutex>
+#include <QMutexLocker>
 
 using super = kwiver::arrows::qt::EmbeddedPipelineWorker;
-using qt_image_container = kwiver::arrows::qt::image_container;
-
 namespace kwiver {
 
 namespace tools {
 
-class PipelineWorkerPrivate {};
+// ----------------------------------------------------------------------------
+class PipelineWorkerPrivate
+{
+public:
+  QMutex mutex;
+  vital::image_container_sptr image;
+};
+
+KQ_IMPLEMENT_D_FUNC( PipelineWorker )
 
 // ----------------------------------------------------------------------------
 PipelineWorker
-::PipelineWorker( QWidget* parent ) : super{ RequiresOutput, parent }
+::PipelineWorker( QWidget* parent )
+  : super{ RequiresOutput, parent }, d_ptr{ new PipelineWorkerPrivate }
 {
 }
 
@@ -44,19 +51,38 @@ ::processOutput( adapter::adapter_data_set_t const& output )
       iter->second->get_datum< vital::image_container_sptr >();
     if( image )
     {
-      if( auto qi = std::dynamic_pointer_cast< qt_image_container >( image ) )
+      KQ_D();
+
+      // Only signal when no image was waiting; otherwise the waiting image
+      // is replaced and the signal already sent picks up this one
+      auto notify = false;
       {
-        emit this->imageAvailable( *qi );
+        QMutexLocker lock{ &d->mutex };
+        notify = !d->image;
+        d->image = image;
       }
-      else
+
+      if( notify )
       {
-        emit this->imageAvailable(
-          qt_image_container::vital_to_qt( image->get_image() ) );
+        emit this->imageAvailable();
       }
     }
   }
 }
 
+// ----------------------------------------------------------------------------
+kwiver::vital::image_container_sptr
+PipelineWorker
+::takeImage()
+{
+  KQ_D();
+
+  QMutexLocker lock{ &d->mutex };
+  auto image = d->image;
+  d->image.reset();
+  return image;
+}
+
 // ----------------------------------------------------------------------------
 void
 PipelineWorker
@@ -7,7 +7,7 @@
 
 #include <arrows/qt/EmbeddedPipelineWorker.h>
 
-#include <QImage>
+#include <vital/types/image_container.h>
 
 namespace kwiver {
 
@@ -25,8 +25,16 @@ class PipelineWorker : public arrows::qt::EmbeddedPipelineWorker
 
   virtual ~PipelineWorker();
 
+  /// Take the newest image received from the pipeline.
+  ///
+  /// Images received while an earlier one was waiting replace it, so images
+  /// arriving faster than they are taken are dropped without being
+  /// converted for display.
+  vital::image_container_sptr takeImage();
+
 signals:
-  void imageAvailable( QImage const& );
+  /// Emitted when an image is waiting to be taken.
+  void imageAvailable();
 
 protected:
   KQ_DECLARE_PRIVATE_RPTR( PipelineWorker );
@@ -9,6 +9,8 @@
 #include <vital/range/iota.h>
 
 #include <QApplication>
+#include <QOpenGLContext>
+#include <QSurfaceFormat>
 
 // ----------------------------------------------------------------------------
 int
@@ -34,6 +36,18 @@ ::run()
     margs.push_back( std::move( marg ) );
   }
 
+  // Ask for a core profile for the OpenGL image view, synchronized with the
+  // display so that frames are shown at most at its refresh rate; this must
+  // be done before the application is created
+  auto format = QSurfaceFormat::defaultFormat();
+  if( QOpenGLContext::openGLModuleType() == QOpenGLContext::LibGL )
+  {
+    format.setVersion( 3, 3 );
+    format.setProfile( QSurfaceFormat::CoreProfile );
+  }
+  format.setSwapInterval( 1 );
+  QSurfaceFormat::setDefaultFormat( format );
+
   // Create QApplication
   QApplication app{ argc, argv.get() };
 
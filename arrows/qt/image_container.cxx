@@ -19,7 +19,10 @@ class qt_image_memory : public kwiver::vital::image_memory
 {
 public:
   qt_image_memory( QImage const& img ) : image_{ img }
-  { size_ = static_cast< size_t >( image_.sizeInBytes() ); }
+  {
+    size_ = static_cast< size_t >( image_.sizeInBytes() );
+    update_accounting();
+  }
 
   virtual void* data() override { return image_.bits(); }
 
@@ -170,9 +173,15 @@ ::image_container( vital::image_container const& container )
   {
     this->data_ = qic->data_;
   }
+  else if( auto cached = container.get_conversion( "qt" ) )
+  {
+    // reuse the copy made by an earlier conversion of this container
+    this->data_ = *std::static_pointer_cast< QImage >( cached );
+  }
   else
   {
     this->data_ = vital_to_qt( container.get_image() );
+    container.set_conversion( "qt", std::make_shared< QImage >( data_ ) );
   }
 }
 
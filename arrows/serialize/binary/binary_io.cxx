@@ -0,0 +1,405 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of flat binary image messages
+
+#include "binary_io.h"
+
+#include <zlib.h>
+
+#include <cstdlib>
+#include <limits>
+#include <utility>
+
+namespace kwiver {
+namespace arrows {
+namespace serialize {
+namespace binary {
+
+namespace {
+
+// Image header layout:
+//    4 bytes magic "KWBI"
+//    1 byte  version
+//    1 byte  compression
+//    1 byte  pixel type
+//    1 byte  bytes per pixel
+//    4 bytes flags
+//    4 bytes reserved
+//   24 bytes width, height, depth
+//   24 bytes steps between columns, rows and channels of the payload
+//    8 bytes size of the payload
+char const image_magic[ 4 ] = { 'K', 'W', 'B', 'I' };
+uint8_t const image_version = 1;
+size_t const image_header_size = 72;
+
+uint32_t const flag_null_image = 1;
+uint32_t const flag_big_endian_pixels = 2;
+
+// ----------------------------------------------------------------------------
+struct image_layout
+{
+  vital::image_pixel_traits traits;
+  size_t width = 0;
+  size_t height = 0;
+  size_t depth = 0;
+  ptrdiff_t w_step = 0;
+  ptrdiff_t h_step = 0;
+  ptrdiff_t d_step = 0;
+
+  size_t pixel_count() const { return width * height * depth; }
+  size_t byte_count() const { return pixel_count() * traits.num_bytes; }
+};
+
+// ----------------------------------------------------------------------------
+// Layout of the pixels of image in a message
+//
+// Contiguous images keep their layout. Others are packed interleaved or
+// planar, whichever is closer to their own layout.
+image_layout
+message_layout( vital::image const& image )
+{
+  image_layout layout;
+  layout.traits = image.pixel_traits();
+  layout.width = image.width();
+  layout.height = image.height();
+  layout.depth = image.depth();
+
+  if( image.is_contiguous() )
+  {
+    layout.w_step = image.w_step();
+    layout.h_step = image.h_step();
+    layout.d_step = image.d_step();
+  }
+  else if( layout.depth > 1 &&
+           std::abs( image.d_step() ) < std::abs( image.w_step() ) )
+  {
+    layout.d_step = 1;
+    layout.w_step = static_cast< ptrdiff_t >( layout.depth );
+    layout.h_step = static_cast< ptrdiff_t >( layout.width * layout.depth );
+  }
+  else
+  {
+    layout.w_step = 1;
+    layout.h_step = static_cast< ptrdiff_t >( layout.width );
+    layout.d_step = static_cast< ptrdiff_t >( layout.width * layout.height );
+  }
+  return layout;
+}
+
+// ----------------------------------------------------------------------------
+char*
+write_image_header( char* out, image_layout const& layout, uint32_t flags,
+                    compression method, uint64_t payload_size )
+{
+  buffer_sink sink{ out };
+  sink.put( image_magic, sizeof( image_magic ) );
+  put_little_endian< uint8_t >( sink, image_version );
+  put_little_endian< uint8_t >( sink, static_cast< uint8_t >( method ) );
+  put_little_endian< uint8_t >( sink, layout.traits.type );
+  put_little_endian< uint8_t >( sink, layout.traits.num_bytes );
+  if( !host_is_little_endian() && !( flags & flag_null_image ) )
+  {
+    flags |= flag_big_endian_pixels;
+  }
+  put_little_endian< uint32_t >( sink, flags );
+  put_little_endian< uint32_t >( sink, 0 );
+  put_little_endian< uint64_t >( sink, layout.width );
+  put_little_endian< uint64_t >( sink, layout.height );
+  put_little_endian< uint64_t >( sink, layout.depth );
+  put_little_endian< int64_t >( sink, layout.w_step );
+  put_little_endian< int64_t >( sink, layout.h_step );
+  put_little_endian< int64_t >( sink, layout.d_step );
+  put_little_endian< uint64_t >( sink, payload_size );
+  return sink.pos;
+}
+
+// ----------------------------------------------------------------------------
+// Copy the pixels of image into out with the given layout
+void
+write_pixels( char* out, vital::image const& image,
+              image_layout const& layout )
+{
+  if( !layout.pixel_count() )
+  {
+    return;
+  }
+
+  if( image.is_contiguous() )
+  {
+    // Contiguous images start at their lowest address
+    auto first = static_cast< char const* >( image.first_pixel() );
+    std::memcpy( out, first, layout.byte_count() );
+    return;
+  }
+
+  // Lowest address of the packed layout, which has only positive steps
+  vital::image view{ out, layout.width, layout.height, layout.depth,
+                     layout.w_step, layout.h_step, layout.d_step,
+                     layout.traits };
+  view.copy_from( image );
+}
+
+// ----------------------------------------------------------------------------
+[[noreturn]] void
+throw_invalid( std::string const& reason )
+{
+  VITAL_THROW( vital::serialization_exception,
+               "Invalid binary image message: " + reason );
+}
+
+// ----------------------------------------------------------------------------
+// Check that the layout of a message only addresses its own pixels
+void
+check_layout( image_layout const& layout, uint64_t raw_size )
+{
+  auto const max = std::numeric_limits< size_t >::max();
+  auto const bytes = layout.traits.num_bytes;
+  if( bytes == 0 ||
+      ( layout.width && layout.height > max / layout.width ) ||
+      ( layout.width * layout.height != 0 &&
+        layout.depth > max / ( layout.width * layout.height ) ) ||
+      layout.pixel_count() > max / bytes )
+  {
+    throw_invalid( "image is too large" );
+  }
+  if( raw_size != layout.byte_count() )
+  {
+    throw_invalid( "pixel data size does not match image size" );
+  }
+  if( !layout.pixel_count() )
+  {
+    return;
+  }
+
+  // With positive steps, no pixel lies past the last one
+  if( layout.w_step <= 0 || layout.h_step <= 0 || layout.d_step <= 0 )
+  {
+    throw_invalid( "image steps must be positive" );
+  }
+  auto const last =
+    static_cast< double >( layout.width - 1 ) * layout.w_step +
+    static_cast< double >( layout.height - 1 ) * layout.h_step +
+    static_cast< double >( layout.depth - 1 ) * layout.d_step;
+  if( last >= static_cast< double >( layout.pixel_count() ) )
+  {
+    throw_invalid( "image steps exceed pixel data" );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+swap_pixel_bytes( char* data, size_t count, size_t bytes )
+{
+  for( size_t i = 0; i < count; ++i, data += bytes )
+  {
+    std::reverse( data, data + bytes );
+  }
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+size_t
+image_size( vital::image_container_scptr const& image )
+{
+  if( !image )
+  {
+    return image_header_size;
+  }
+
+  auto const& img = image->get_image();
+  return image_header_size +
+         img.width() * img.height() * img.depth() *
+         img.pixel_traits().num_bytes;
+}
+
+// ----------------------------------------------------------------------------
+char*
+write_image( char* out, vital::image_container_scptr const& image )
+{
+  if( !image )
+  {
+    return write_image_header( out, image_layout{}, flag_null_image,
+                               compression::none, 0 );
+  }
+
+  auto const img = image->get_image();
+  auto const layout = message_layout( img );
+  out = write_image_header( out, layout, 0, compression::none,
+                            layout.byte_count() );
+  write_pixels( out, img, layout );
+  return out + layout.byte_count();
+}
+
+// ----------------------------------------------------------------------------
+vital::algo::message_part
+write_image_parts( std::string& header,
+                   vital::image_container_scptr const& image )
+{
+  if( !image || !image->get_image().is_contiguous() )
+  {
+    header.resize( image_size( image ) );
+    write_image( &header[ 0 ], image );
+    return { nullptr, 0, nullptr };
+  }
+
+  auto const img = image->get_image();
+  auto const layout = message_layout( img );
+  header.resize( image_header_size );
+  write_image_header( &header[ 0 ], layout, 0, compression::none,
+                      layout.byte_count() );
+
+  // Containers may convert their image on each call, so the image viewed
+  // is held along with its container to keep its pixels alive
+  auto const owner =
+    std::make_shared< std::pair< vital::image_container_scptr,
+                                 vital::image > >( image, img );
+  return { static_cast< char const* >( owner->second.first_pixel() ),
+           layout.byte_count(), owner };
+}
+
+// ----------------------------------------------------------------------------
+void
+write_image_zlib( std::string& buffer,
+                  vital::image_container_scptr const& image, int level )
+{
+  auto const start = buffer.size();
+  if( !image )
+  {
+    buffer.resize( start + image_header_size );
+    write_image_header( &buffer[ start ], image_layout{}, flag_null_image,
+                        compression::zlib, 0 );
+    return;
+  }
+
+  auto const img = image->get_image();
+  auto const layout = message_layout( img );
+  auto const raw_size = layout.byte_count();
+
+  // Contiguous pixels are compressed in place; others are packed first
+  std::string packed;
+  auto raw = static_cast< char const* >( img.first_pixel() );
+  if( !img.is_contiguous() )
+  {
+    packed.resize( raw_size );
+    write_pixels( &packed[ 0 ], img, layout );
+    raw = packed.data();
+  }
+
+  // The uncompressed size is stored ahead of the deflated
+  // pixels, so the pixels can be inflated straight into a new image
+  auto bound = compressBound( static_cast< uLong >( raw_size ) );
+  buffer.resize( start + image_header_size + 8 + bound );
+  auto const payload = &buffer[ start + image_header_size ];
+  buffer_sink raw_size_sink{ payload };
+  put_little_endian< uint64_t >( raw_size_sink, raw_size );
+
+  auto const status =
+    compress2( reinterpret_cast< Bytef* >( payload + 8 ), &bound,
+               reinterpret_cast< Bytef const* >( raw ),
+               static_cast< uLong >( raw_size ), level );
+  if( status != Z_OK )
+  {
+    buffer.resize( start );
+    VITAL_THROW( vital::serialization_exception,
+                 "Failed to compress image with zlib" );
+  }
+  buffer.resize( start + image_header_size + 8 + bound );
+  write_image_header( &buffer[ start ], layout, 0, compression::zlib,
+                      8 + bound );
+}
+
+// ----------------------------------------------------------------------------
+vital::image_container_sptr
+read_image( byte_reader& reader )
+{
+  auto const magic = reader.take( sizeof( image_magic ) );
+  if( std::memcmp( magic, image_magic, sizeof( image_magic ) ) )
+  {
+    throw_invalid( "bad magic number" );
+  }
+  if( reader.get< uint8_t >() != image_version )
+  {
+    throw_invalid( "unsupported version" );
+  }
+
+  auto const method = static_cast< compression >( reader.get< uint8_t >() );
+  image_layout layout;
+  layout.traits.type =
+    static_cast< vital::image_pixel_traits::pixel_type >(
+      reader.get< uint8_t >() );
+  layout.traits.num_bytes = reader.get< uint8_t >();
+  auto const flags = reader.get< uint32_t >();
+  reader.get< uint32_t >();
+  layout.width = reader.get< uint64_t >();
+  layout.height = reader.get< uint64_t >();
+  layout.depth = reader.get< uint64_t >();
+  layout.w_step = reader.get< int64_t >();
+  layout.h_step = reader.get< int64_t >();
+  layout.d_step = reader.get< int64_t >();
+  auto const payload_size = reader.get< uint64_t >();
+  auto const payload = reader.take( payload_size );
+
+  if( flags & flag_null_image )
+  {
+    return nullptr;
+  }
+
+  uint64_t raw_size = payload_size;
+  if( method == compression::zlib )
+  {
+    if( payload_size < 8 )
+    {
+      throw_invalid( "missing uncompressed size" );
+    }
+    byte_reader payload_reader{ payload, 8 };
+    raw_size = payload_reader.get< uint64_t >();
+  }
+  else if( method != compression::none )
+  {
+    throw_invalid( "unsupported compression" );
+  }
+  check_layout( layout, raw_size );
+
+  if( !layout.pixel_count() )
+  {
+    return std::make_shared< vital::simple_image_container >(
+      vital::image{ layout.width, layout.height, layout.depth, false,
+                    layout.traits } );
+  }
+
+  auto const memory = std::make_shared< vital::image_memory >( raw_size );
+  auto const data = static_cast< char* >( memory->data() );
+  if( method == compression::zlib )
+  {
+    auto size = static_cast< uLongf >( raw_size );
+    auto const status =
+      uncompress( reinterpret_cast< Bytef* >( data ), &size,
+                  reinterpret_cast< Bytef const* >( payload + 8 ),
+                  static_cast< uLong >( payload_size - 8 ) );
+    if( status != Z_OK || size != raw_size )
+    {
+      throw_invalid( "corrupt compressed pixels" );
+    }
+  }
+  else
+  {
+    std::memcpy( data, payload, raw_size );
+  }
+
+  bool const big_endian = ( flags & flag_big_endian_pixels ) != 0;
+  if( big_endian == host_is_little_endian() && layout.traits.num_bytes > 1 )
+  {
+    swap_pixel_bytes( data, layout.pixel_count(), layout.traits.num_bytes );
+  }
+
+  return std::make_shared< vital::simple_image_container >(
+    vital::image{ memory, data, layout.width, layout.height, layout.depth,
+                  layout.w_step, layout.h_step, layout.d_step,
+                  layout.traits } );
+}
+
+} } } }       // end namespace kwiver
@@ -0,0 +1,198 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Helpers to read and write flat little-endian binary messages
+
+#ifndef ARROWS_SERIALIZATION_BINARY_BINARY_IO
+#define ARROWS_SERIALIZATION_BINARY_BINARY_IO
+
+#include <vital/algo/data_serializer.h>
+#include <vital/exceptions/serialize.h>
+#include <vital/types/image_container.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace kwiver {
+namespace arrows {
+namespace serialize {
+namespace binary {
+
+// ----------------------------------------------------------------------------
+inline bool
+host_is_little_endian()
+{
+  uint16_t const value = 1;
+  unsigned char first;
+  std::memcpy( &first, &value, 1 );
+  return first == 1;
+}
+
+// ----------------------------------------------------------------------------
+/// Sink which only counts the bytes written to it
+///
+/// Messages are written once to this sink to find their size, so that they
+/// can be written again straight into a buffer of that size.
+struct size_sink
+{
+  void put( void const*, size_t n ) { size += n; }
+
+  size_t size = 0;
+};
+
+// ----------------------------------------------------------------------------
+/// Sink which writes into a buffer of known size
+struct buffer_sink
+{
+  void put( void const* data, size_t n )
+  {
+    std::memcpy( pos, data, n );
+    pos += n;
+  }
+
+  char* pos;
+};
+
+// ----------------------------------------------------------------------------
+template < typename T, typename Sink >
+void
+put_little_endian( Sink& sink, T value )
+{
+  char bytes[ sizeof( T ) ];
+  std::memcpy( bytes, &value, sizeof( T ) );
+  if( !host_is_little_endian() )
+  {
+    std::reverse( bytes, bytes + sizeof( T ) );
+  }
+  sink.put( bytes, sizeof( T ) );
+}
+
+// ----------------------------------------------------------------------------
+template < typename Sink >
+void
+put_string( Sink& sink, std::string const& s )
+{
+  put_little_endian< uint32_t >( sink, static_cast< uint32_t >( s.size() ) );
+  sink.put( s.data(), s.size() );
+}
+
+// ----------------------------------------------------------------------------
+/// Reader of a binary message which throws if the message is too short
+class byte_reader
+{
+public:
+  byte_reader( char const* data, size_t size )
+    : m_pos( data ), m_end( data + size )
+  {}
+
+  explicit byte_reader( std::string const& message )
+    : byte_reader( message.data(), message.size() )
+  {}
+
+  /// Take the next \p n bytes of the message
+  char const* take( size_t n )
+  {
+    if( n > remaining() )
+    {
+      VITAL_THROW( vital::serialization_exception,
+                   "Binary message is truncated" );
+    }
+    auto const result = m_pos;
+    m_pos += n;
+    return result;
+  }
+
+  template < typename T >
+  T get()
+  {
+    char bytes[ sizeof( T ) ];
+    std::memcpy( bytes, take( sizeof( T ) ), sizeof( T ) );
+    if( !host_is_little_endian() )
+    {
+      std::reverse( bytes, bytes + sizeof( T ) );
+    }
+    T value;
+    std::memcpy( &value, bytes, sizeof( T ) );
+    return value;
+  }
+
+  std::string get_string()
+  {
+    auto const size = get< uint32_t >();
+    return std::string( take( size ), size );
+  }
+
+  size_t remaining() const { return static_cast< size_t >( m_end - m_pos ); }
+
+private:
+  char const* m_pos;
+  char const* m_end;
+};
+
+// ----------------------------------------------------------------------------
+/// Compression of image pixels
+enum class compression : uint8_t
+{
+  none = 0,
+  zlib = 1,
+};
+
+/// Number of bytes written by write_image for \p image
+size_t image_size( vital::image_container_scptr const& image );
+
+/// Write an image, uncompressed, at \p out
+///
+/// The image is written as a fixed size header followed by its pixels.
+/// Contiguous images keep their memory layout and are copied with a single
+/// memcpy; others are packed straight into \p out. A null image is written
+/// as a header alone.
+///
+/// \param out Start of at least image_size( \p image ) bytes
+///
+/// \returns the end of the bytes written.
+char* write_image( char* out, vital::image_container_scptr const& image );
+
+/// Write an uncompressed image as a header and the pixels of \p image
+///
+/// When \p image is contiguous, only the header is written to \p header and
+/// the pixels are returned as a part referring to the memory of \p image.
+/// Otherwise, the whole message is written to \p header.
+///
+/// \returns the part to send after \p header, which may be empty.
+vital::algo::message_part
+write_image_parts( std::string& header,
+                   vital::image_container_scptr const& image );
+
+/// Append an image, with pixels compressed by zlib at \p level, to \p buffer
+void write_image_zlib( std::string& buffer,
+                       vital::image_container_scptr const& image, int level );
+
+/// Read an image written by write_image or write_image_zlib
+///
+/// Pixels are copied or decompressed straight into the memory of the new
+/// image.
+///
+/// \throws vital::serialization_exception if the data is not a valid image.
+vital::image_container_sptr read_image( byte_reader& reader );
+
+// ----------------------------------------------------------------------------
+inline void
+put_image( size_sink& sink, vital::image_container_scptr const& image )
+{
+  sink.size += image_size( image );
+}
+
+// ----------------------------------------------------------------------------
+inline void
+put_image( buffer_sink& sink, vital::image_container_scptr const& image )
+{
+  sink.pos = write_image( sink.pos, image );
+}
+
+} } } }       // end namespace kwiver
+
+#endif // ARROWS_SERIALIZATION_BINARY_BINARY_IO
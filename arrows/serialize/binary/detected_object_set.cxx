@@ -0,0 +1,215 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "detected_object_set.h"
+#include "binary_io.h"
+
+#include <vital/types/detected_object_set.h>
+
+namespace kwiver {
+namespace arrows {
+namespace serialize {
+namespace binary {
+
+namespace {
+
+char const set_magic[ 4 ] = { 'K', 'W', 'B', 'D' };
+uint8_t const set_version = 1;
+
+uint8_t const flag_has_type = 1;
+uint8_t const flag_has_geo_point = 2;
+uint8_t const flag_has_mask = 4;
+
+// ----------------------------------------------------------------------------
+template < typename Sink >
+void
+write_detection( Sink& sink, vital::detected_object const& det )
+{
+  auto const& bbox = det.bounding_box();
+  auto const type = det.type();
+  auto const geo_point = det.geo_point();
+  auto const mask = det.mask();
+
+  uint8_t flags = 0;
+  flags |= ( type ? flag_has_type : 0 );
+  flags |= ( geo_point.is_empty() ? 0 : flag_has_geo_point );
+  flags |= ( mask ? flag_has_mask : 0 );
+  put_little_endian< uint8_t >( sink, flags );
+
+  put_little_endian< double >( sink, bbox.min_x() );
+  put_little_endian< double >( sink, bbox.min_y() );
+  put_little_endian< double >( sink, bbox.max_x() );
+  put_little_endian< double >( sink, bbox.max_y() );
+  put_little_endian< double >( sink, det.confidence() );
+  put_little_endian< uint64_t >( sink, det.index() );
+  put_string( sink, det.detector_name() );
+
+  if( type )
+  {
+    put_little_endian< uint32_t >( sink,
+                                   static_cast< uint32_t >( type->size() ) );
+    for( auto const& entry : *type )
+    {
+      put_string( sink, *entry.first );
+      put_little_endian< double >( sink, entry.second );
+    }
+  }
+
+  auto const notes = det.notes();
+  put_little_endian< uint32_t >( sink, static_cast< uint32_t >( notes.size() ) );
+  for( auto const& note : notes )
+  {
+    put_string( sink, note );
+  }
+
+  auto const keypoints = det.keypoints();
+  put_little_endian< uint32_t >( sink,
+                                 static_cast< uint32_t >( keypoints.size() ) );
+  for( auto const& keypoint : keypoints )
+  {
+    put_string( sink, keypoint.first );
+    put_little_endian< double >( sink, keypoint.second.value()[ 0 ] );
+    put_little_endian< double >( sink, keypoint.second.value()[ 1 ] );
+  }
+
+  if( !geo_point.is_empty() )
+  {
+    auto const location = geo_point.location();
+    put_little_endian< int32_t >( sink, geo_point.crs() );
+    put_little_endian< double >( sink, location[ 0 ] );
+    put_little_endian< double >( sink, location[ 1 ] );
+    put_little_endian< double >( sink, location[ 2 ] );
+  }
+
+  if( mask )
+  {
+    put_image( sink, mask );
+  }
+}
+
+// ----------------------------------------------------------------------------
+template < typename Sink >
+void
+write_set( Sink& sink, vital::detected_object_set const& set )
+{
+  sink.put( set_magic, sizeof( set_magic ) );
+  put_little_endian< uint8_t >( sink, set_version );
+  put_little_endian< uint64_t >( sink, set.size() );
+  for( auto it = set.cbegin(); it != set.cend(); ++it )
+  {
+    write_detection( sink, **it );
+  }
+}
+
+// ----------------------------------------------------------------------------
+vital::detected_object_sptr
+read_detection( byte_reader& reader )
+{
+  auto const flags = reader.get< uint8_t >();
+
+  auto const min_x = reader.get< double >();
+  auto const min_y = reader.get< double >();
+  auto const max_x = reader.get< double >();
+  auto const max_y = reader.get< double >();
+  auto const det = std::make_shared< vital::detected_object >(
+    vital::bounding_box_d{ min_x, min_y, max_x, max_y } );
+  det->set_confidence( reader.get< double >() );
+  det->set_index( reader.get< uint64_t >() );
+  det->set_detector_name( reader.get_string() );
+
+  if( flags & flag_has_type )
+  {
+    auto const type = std::make_shared< vital::detected_object_type >();
+    for( auto n = reader.get< uint32_t >(); n; --n )
+    {
+      auto const name = reader.get_string();
+      type->set_score( name, reader.get< double >() );
+    }
+    det->set_type( type );
+  }
+
+  for( auto n = reader.get< uint32_t >(); n; --n )
+  {
+    det->add_note( reader.get_string() );
+  }
+
+  for( auto n = reader.get< uint32_t >(); n; --n )
+  {
+    auto const name = reader.get_string();
+    auto const x = reader.get< double >();
+    auto const y = reader.get< double >();
+    det->add_keypoint( name, vital::point_2d{ x, y } );
+  }
+
+  if( flags & flag_has_geo_point )
+  {
+    auto const crs = reader.get< int32_t >();
+    vital::geo_point::geo_3d_point_t location;
+    location[ 0 ] = reader.get< double >();
+    location[ 1 ] = reader.get< double >();
+    location[ 2 ] = reader.get< double >();
+    det->set_geo_point( vital::geo_point{ location, crs } );
+  }
+
+  if( flags & flag_has_mask )
+  {
+    det->set_mask( read_image( reader ) );
+  }
+
+  return det;
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+detected_object_set::
+detected_object_set()
+{ }
+
+detected_object_set::
+~detected_object_set()
+{ }
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< std::string >
+detected_object_set::
+serialize( const vital::any& element )
+{
+  auto const obj =
+    vital::any_cast< vital::detected_object_set_sptr >( element );
+  vital::detected_object_set const empty;
+  auto const& set = ( obj ? *obj : empty );
+
+  size_sink size;
+  write_set( size, set );
+
+  auto message = std::make_shared< std::string >( size.size, '\0' );
+  buffer_sink out{ &( *message )[ 0 ] };
+  write_set( out, set );
+  return message;
+}
+
+// ----------------------------------------------------------------------------
+vital::any
+detected_object_set::
+deserialize( const std::string& message )
+{
+  byte_reader reader{ message };
+  auto const magic = reader.take( sizeof( set_magic ) );
+  if( std::memcmp( magic, set_magic, sizeof( set_magic ) ) ||
+      reader.get< uint8_t >() != set_version )
+  {
+    VITAL_THROW( vital::serialization_exception,
+                 "Invalid binary detected_object_set message" );
+  }
+
+  auto const set = std::make_shared< vital::detected_object_set >();
+  for( auto n = reader.get< uint64_t >(); n; --n )
+  {
+    set->add( read_detection( reader ) );
+  }
+  return vital::any( set );
+}
+
+} } } }       // end namespace kwiver
@@ -0,0 +1,37 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef ARROWS_SERIALIZATION_BINARY_DETECTED_OBJECT_SET
+#define ARROWS_SERIALIZATION_BINARY_DETECTED_OBJECT_SET
+
+#include <arrows/serialize/binary/kwiver_serialize_binary_export.h>
+#include <vital/algo/data_serializer.h>
+
+namespace kwiver {
+namespace arrows {
+namespace serialize {
+namespace binary {
+
+/// Serializer of detection sets as flat binary records
+///
+/// The message is measured first and then written into a buffer of its
+/// exact size. Masks are written as uncompressed binary images.
+/// Descriptors and set attributes are not serialized.
+class KWIVER_SERIALIZE_BINARY_EXPORT detected_object_set
+  : public vital::algo::data_serializer
+{
+public:
+  PLUGIN_INFO( "kwiver:detected_object_set",
+               "Serializes a detected_object_set as flat binary records." );
+
+  detected_object_set();
+  virtual ~detected_object_set();
+
+  std::shared_ptr< std::string > serialize( const vital::any& element ) override;
+  vital::any deserialize( const std::string& message ) override;
+};
+
+} } } }       // end namespace kwiver
+
+#endif // ARROWS_SERIALIZATION_BINARY_DETECTED_OBJECT_SET
@@ -0,0 +1,139 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "image.h"
+#include "binary_io.h"
+
+#include <vital/types/image_container.h>
+
+namespace kwiver {
+namespace arrows {
+namespace serialize {
+namespace binary {
+
+// ----------------------------------------------------------------------------
+class image::priv
+{
+public:
+  std::string compression = "none";
+  int compression_level = 1;
+};
+
+// ----------------------------------------------------------------------------
+image::
+image()
+  : d{ new priv }
+{ }
+
+image::
+~image()
+{ }
+
+// ----------------------------------------------------------------------------
+vital::config_block_sptr
+image::
+get_configuration() const
+{
+  auto config = data_serializer::get_configuration();
+
+  config->set_value( "compression", d->compression,
+                     "Compression of the image pixels: \"none\" to copy the "
+                     "raw pixels, or \"zlib\" to deflate them." );
+  config->set_value( "compression_level", d->compression_level,
+                     "Level of zlib compression, from 1 (fastest) to 9 "
+                     "(smallest)." );
+
+  return config;
+}
+
+// ----------------------------------------------------------------------------
+void
+image::
+set_configuration( vital::config_block_sptr in_config )
+{
+  auto config = get_configuration();
+  config->merge_config( in_config );
+
+  d->compression = config->get_value< std::string >( "compression" );
+  d->compression_level = config->get_value< int >( "compression_level" );
+}
+
+// ----------------------------------------------------------------------------
+bool
+image::
+check_configuration( vital::config_block_sptr config ) const
+{
+  auto const method =
+    config->get_value< std::string >( "compression", d->compression );
+  auto const level =
+    config->get_value< int >( "compression_level", d->compression_level );
+  if( method != "none" && method != "zlib" )
+  {
+    LOG_ERROR( logger(), "Unknown compression \"" << method << "\"" );
+    return false;
+  }
+  if( level < 1 || level > 9 )
+  {
+    LOG_ERROR( logger(), "Compression level must be between 1 and 9" );
+    return false;
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< std::string >
+image::
+serialize( const vital::any& element )
+{
+  auto const obj =
+    vital::any_cast< vital::image_container_sptr >( element );
+
+  auto message = std::make_shared< std::string >();
+  if( d->compression == "zlib" )
+  {
+    write_image_zlib( *message, obj, d->compression_level );
+  }
+  else
+  {
+    message->resize( image_size( obj ) );
+    write_image( &( *message )[ 0 ], obj );
+  }
+  return message;
+}
+
+// ----------------------------------------------------------------------------
+vital::algo::message_parts
+image::
+serialize_parts( const vital::any& element )
+{
+  if( d->compression == "zlib" )
+  {
+    return data_serializer::serialize_parts( element );
+  }
+
+  auto const obj =
+    vital::any_cast< vital::image_container_sptr >( element );
+
+  auto header = std::make_shared< std::string >();
+  auto const pixels = write_image_parts( *header, obj );
+
+  vital::algo::message_parts parts;
+  vital::algo::add_message_part( parts, header );
+  if( pixels.size )
+  {
+    parts.push_back( pixels );
+  }
+  return parts;
+}
+
+// ----------------------------------------------------------------------------
+vital::any
+image::
+deserialize( const std::string& message )
+{
+  byte_reader reader{ message };
+  return vital::any( read_image( reader ) );
+}
+
+} } } }       // end namespace kwiver
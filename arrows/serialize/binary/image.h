@@ -0,0 +1,51 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef ARROWS_SERIALIZATION_BINARY_IMAGE
+#define ARROWS_SERIALIZATION_BINARY_IMAGE
+
+#include <arrows/serialize/binary/kwiver_serialize_binary_export.h>
+#include <vital/algo/data_serializer.h>
+
+namespace kwiver {
+namespace arrows {
+namespace serialize {
+namespace binary {
+
+/// Serializer of images as a flat header followed by the raw pixels
+///
+/// The pixels of contiguous images are copied once, into a message sized
+/// up front, or not at all when serialized as parts, and copied once more
+/// into the memory of the deserialized image. Pixels may optionally be
+/// compressed with zlib.
+class KWIVER_SERIALIZE_BINARY_EXPORT image
+  : public vital::algo::data_serializer
+{
+public:
+  PLUGIN_INFO( "kwiver:image",
+               "Serializes an image as a flat binary header and raw pixels." );
+
+  image();
+  virtual ~image();
+
+  vital::config_block_sptr get_configuration() const override;
+  void set_configuration( vital::config_block_sptr config ) override;
+  bool check_configuration( vital::config_block_sptr config ) const override;
+
+  std::shared_ptr< std::string > serialize( const vital::any& element ) override;
+  vital::any deserialize( const std::string& message ) override;
+
+  /// Serialize an image as its header and, when the image is contiguous
+  /// and not compressed, its own pixel memory
+  vital::algo::message_parts
+  serialize_parts( const vital::any& element ) override;
+
+private:
+  class priv;
+  std::unique_ptr< priv > d;
+};
+
+} } } }       // end namespace kwiver
+
+#endif // ARROWS_SERIALIZATION_BINARY_IMAGE
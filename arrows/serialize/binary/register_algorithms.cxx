@@ -0,0 +1,52 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Default plugin algorithm registration interface implementation.
+
+#include <arrows/serialize/binary/kwiver_serialize_binary_plugin_export.h>
+
+#include <vital/algo/algorithm_factory.h>
+
+#include "detected_object_set.h"
+#include "image.h"
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace serialize {
+
+namespace binary {
+
+// ----------------------------------------------------------------------------
+extern "C"
+KWIVER_SERIALIZE_BINARY_PLUGIN_EXPORT
+void
+register_factories( kwiver::vital::plugin_loader& vpm )
+{
+  auto const module_name = std::string{ "arrows.serialize.binary" };
+  kwiver::vital::serializer_registrar sreg( vpm, module_name, "binary" );
+
+  if( sreg.is_module_loaded() )
+  {
+    return;
+  }
+
+  using namespace kwiver::arrows::serialize::binary;
+
+  sreg.register_algorithm< detected_object_set >();
+  sreg.register_algorithm< image >();
+  sreg.register_algorithm< image >( "kwiver:mask" );
+
+  sreg.mark_module_as_loaded();
+}
+
+} // end namespace binary
+
+} // end namespace serialize
+
+} // end namespace arrows
+
+} // end namespace kwiver
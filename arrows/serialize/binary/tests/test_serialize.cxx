@@ -0,0 +1,332 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test binary serializers
+
+#include <gtest/gtest.h>
+
+#include <vital/exceptions/serialize.h>
+#include <vital/types/detected_object_set.h>
+#include <vital/types/image_container.h>
+
+#include <arrows/serialize/binary/detected_object_set.h>
+#include <arrows/serialize/binary/image.h>
+
+#include <cstdint>
+
+namespace kasb = kwiver::arrows::serialize::binary;
+
+using namespace kwiver::vital;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+image_container_sptr
+round_trip( kasb::image& ser, image const& img )
+{
+  image_container_sptr const in =
+    std::make_shared< simple_image_container >( img );
+  auto const message = ser.serialize( any( in ) );
+  return any_cast< image_container_sptr >( ser.deserialize( *message ) );
+}
+
+// ----------------------------------------------------------------------------
+template < typename T >
+image_of< T >
+make_image( size_t width, size_t height, size_t depth, bool interleave )
+{
+  image_of< T > img{ width, height, depth, interleave };
+  for( size_t k = 0; k < depth; ++k )
+  {
+    for( size_t j = 0; j < height; ++j )
+    {
+      for( size_t i = 0; i < width; ++i )
+      {
+        img( i, j, k ) = static_cast< T >( i * 7 + j * 13 + k * 31 );
+      }
+    }
+  }
+  return img;
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST( serialize, image )
+{
+  kasb::image ser;
+  for( bool const interleave : { false, true } )
+  {
+    auto const img = make_image< uint8_t >( 200, 300, 3, interleave );
+    auto const out = round_trip( ser, img );
+    ASSERT_TRUE( out );
+    EXPECT_TRUE( equal_content( img, out->get_image() ) );
+
+    // Contiguous images keep their layout
+    EXPECT_EQ( img.w_step(), out->get_image().w_step() );
+    EXPECT_EQ( img.h_step(), out->get_image().h_step() );
+    EXPECT_EQ( img.d_step(), out->get_image().d_step() );
+  }
+
+  // The message is the header and the pixels
+  auto const img = make_image< uint8_t >( 20, 10, 3, true );
+  image_container_sptr const in =
+    std::make_shared< simple_image_container >( img );
+  EXPECT_EQ( 72 + img.size(), ser.serialize( any( in ) )->size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST( serialize, image_views )
+{
+  kasb::image ser;
+  auto const img = make_image< uint16_t >( 64, 48, 3, true );
+
+  // Crop, flip and channel selection all give non-contiguous views
+  image const views[] = {
+    image{ img.memory(), img.first_pixel() + img.h_step() * 5 + 3,
+           32, 20, 3, img.w_step(), img.h_step(), img.d_step(),
+           img.pixel_traits() },
+    image{ img.memory(),
+           img.first_pixel() + img.h_step() * 47,
+           64, 48, 3, img.w_step(), -img.h_step(), img.d_step(),
+           img.pixel_traits() },
+    image{ img.memory(), img.first_pixel() + 1,
+           64, 48, 1, img.w_step(), img.h_step(), img.d_step(),
+           img.pixel_traits() },
+    make_image< uint16_t >( 64, 48, 3, false ) };
+
+  for( auto const& view : views )
+  {
+    auto const out = round_trip( ser, view );
+    ASSERT_TRUE( out );
+    EXPECT_TRUE( equal_content( view, out->get_image() ) );
+    EXPECT_TRUE( out->get_image().is_contiguous() );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST( serialize, image_types )
+{
+  kasb::image ser;
+  auto const check = [ & ]( image const& img )
+  {
+    auto const out = round_trip( ser, img );
+    ASSERT_TRUE( out );
+    EXPECT_EQ( img.pixel_traits(), out->get_image().pixel_traits() );
+    EXPECT_TRUE( equal_content( img, out->get_image() ) );
+  };
+
+  check( make_image< int32_t >( 17, 11, 2, false ) );
+  check( make_image< float >( 17, 11, 1, false ) );
+  check( make_image< double >( 5, 3, 4, true ) );
+  check( make_image< bool >( 9, 9, 1, false ) );
+
+  // Empty images keep their traits and size
+  auto const out = round_trip( ser, image_of< uint16_t >{ 0, 4, 1 } );
+  ASSERT_TRUE( out );
+  EXPECT_EQ( 0, out->width() );
+  EXPECT_EQ( 4, out->height() );
+  EXPECT_EQ( image_pixel_traits_of< uint16_t >(),
+             out->get_image().pixel_traits() );
+
+  // Null images round trip
+  auto const message = ser.serialize( any( image_container_sptr{} ) );
+  EXPECT_FALSE( any_cast< image_container_sptr >(
+                  ser.deserialize( *message ) ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST( serialize, image_zlib )
+{
+  kasb::image ser;
+  auto config = ser.get_configuration();
+  config->set_value( "compression", "zlib" );
+  config->set_value( "compression_level", 6 );
+  ASSERT_TRUE( ser.check_configuration( config ) );
+  ser.set_configuration( config );
+
+  auto const img = make_image< uint8_t >( 200, 300, 3, true );
+  image_container_sptr const in =
+    std::make_shared< simple_image_container >( img );
+  auto const message = ser.serialize( any( in ) );
+  EXPECT_LT( message->size(), img.size() );
+
+  auto const out =
+    any_cast< image_container_sptr >( ser.deserialize( *message ) );
+  ASSERT_TRUE( out );
+  EXPECT_TRUE( equal_content( img, out->get_image() ) );
+
+  // Uncompressed messages are read whatever the configuration
+  kasb::image plain;
+  auto const plain_message = plain.serialize( any( in ) );
+  EXPECT_TRUE( equal_content(
+    img, any_cast< image_container_sptr >(
+      ser.deserialize( *plain_message ) )->get_image() ) );
+
+  // Non-contiguous images are packed before compression
+  image const flipped{ img.memory(),
+                       img.first_pixel() + img.h_step() * 299,
+                       200, 300, 3, img.w_step(), -img.h_step(),
+                       img.d_step(), img.pixel_traits() };
+  auto const out_flipped = round_trip( ser, flipped );
+  ASSERT_TRUE( out_flipped );
+  EXPECT_TRUE( equal_content( flipped, out_flipped->get_image() ) );
+
+  config->set_value( "compression", "lz77" );
+  EXPECT_FALSE( ser.check_configuration( config ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST( serialize, image_invalid )
+{
+  kasb::image ser;
+  auto const img = make_image< uint16_t >( 8, 8, 1, false );
+  image_container_sptr const in =
+    std::make_shared< simple_image_container >( img );
+  auto const message = *ser.serialize( any( in ) );
+
+  EXPECT_THROW( ser.deserialize( "" ), serialization_exception );
+  EXPECT_THROW( ser.deserialize( message.substr( 0, message.size() - 1 ) ),
+                serialization_exception );
+  EXPECT_THROW( ser.deserialize( "XXXX" + message.substr( 4 ) ),
+                serialization_exception );
+
+  // Steps which address pixels outside of the message are rejected
+  auto bad_steps = message;
+  bad_steps[ 48 ] = 100;
+  EXPECT_THROW( ser.deserialize( bad_steps ), serialization_exception );
+}
+
+// ----------------------------------------------------------------------------
+TEST( serialize, detected_object_set )
+{
+  kasb::detected_object_set ser;
+
+  auto const set = std::make_shared< detected_object_set >();
+  for( int i = 0; i < 10; ++i )
+  {
+    auto const type = std::make_shared< detected_object_type >();
+    type->set_score( "first", 1.0 / ( i + 1 ) );
+    type->set_score( "second", 0.5 );
+
+    auto const det = std::make_shared< detected_object >(
+      bounding_box_d{ 1.0 + i, 2.5, 30.25 + i, 40.125 }, 0.1 * i, type );
+    det->set_index( 100 + i );
+    det->set_detector_name( "detector" );
+    det->add_note( "note" );
+    det->add_keypoint( "head", point_2d{ 3.5, i * 2.0 } );
+    if( i % 2 )
+    {
+      det->set_geo_point( geo_point{ geo_point::geo_3d_point_t{ 1, 2, 3 },
+                                     4326 } );
+      det->set_mask( std::make_shared< simple_image_container >(
+                       make_image< bool >( 29, 38, 1, false ) ) );
+    }
+    set->add( det );
+  }
+  set->add( std::make_shared< detected_object >( bounding_box_d{ 0, 0, 1, 1 },
+                                                 1.0, nullptr ) );
+
+  auto const message = ser.serialize( any( set ) );
+  auto const out =
+    any_cast< detected_object_set_sptr >( ser.deserialize( *message ) );
+
+  ASSERT_EQ( set->size(), out->size() );
+  for( size_t i = 0; i < set->size(); ++i )
+  {
+    SCOPED_TRACE( i );
+    auto const& a = *set->at( i );
+    auto const& b = *out->at( i );
+    EXPECT_EQ( a.bounding_box(), b.bounding_box() );
+    EXPECT_EQ( a.confidence(), b.confidence() );
+    EXPECT_EQ( a.index(), b.index() );
+    EXPECT_EQ( a.detector_name(), b.detector_name() );
+    EXPECT_EQ( a.notes(), b.notes() );
+    EXPECT_EQ( a.keypoints().size(), b.keypoints().size() );
+    EXPECT_EQ( a.geo_point(), b.geo_point() );
+
+    ASSERT_EQ( !!a.type(), !!b.type() );
+    if( a.type() )
+    {
+      EXPECT_EQ( a.type()->class_names(), b.type()->class_names() );
+      for( auto const& name : a.type()->class_names() )
+      {
+        EXPECT_EQ( a.type()->score( name ), b.type()->score( name ) );
+      }
+    }
+
+    ASSERT_EQ( !!a.mask(), !!b.mask() );
+    if( a.mask() )
+    {
+      EXPECT_TRUE( equal_content( a.mask()->get_image(),
+                                  b.mask()->get_image() ) );
+    }
+  }
+
+  // Null and empty sets give empty sets
+  auto const empty = ser.serialize( any( detected_object_set_sptr{} ) );
+  EXPECT_EQ( 0, any_cast< detected_object_set_sptr >(
+                  ser.deserialize( *empty ) )->size() );
+
+  EXPECT_THROW( ser.deserialize( message->substr( 0, message->size() / 2 ) ),
+                serialization_exception );
+}
+
+// ----------------------------------------------------------------------------
+TEST( serialize, image_parts )
+{
+  kasb::image ser;
+  auto const img = make_image< uint16_t >( 40, 30, 3, true );
+  image_container_sptr const in =
+    std::make_shared< simple_image_container >( img );
+
+  // The pixels of contiguous images are sent from their own memory
+  auto const parts = ser.serialize_parts( any( in ) );
+  ASSERT_EQ( 2, parts.size() );
+  EXPECT_EQ( img.first_pixel(), static_cast< void const* >( parts[ 1 ].data ) );
+  EXPECT_EQ( img.size(), parts[ 1 ].size );
+
+  auto const message = ser.serialize( any( in ) );
+  EXPECT_EQ( *message, kwiver::vital::algo::join_message_parts( parts ) );
+
+  // Views and compressed images are sent as a single part
+  image const flipped{ img.memory(),
+                       img.first_pixel() + img.h_step() * 29,
+                       40, 30, 3, img.w_step(), -img.h_step(),
+                       img.d_step(), img.pixel_traits() };
+  image_container_sptr const in_flipped =
+    std::make_shared< simple_image_container >( flipped );
+  auto const flipped_parts = ser.serialize_parts( any( in_flipped ) );
+  ASSERT_EQ( 1, flipped_parts.size() );
+  auto const out = any_cast< image_container_sptr >( ser.deserialize(
+    kwiver::vital::algo::join_message_parts( flipped_parts ) ) );
+  EXPECT_TRUE( equal_content( flipped, out->get_image() ) );
+
+  auto config = ser.get_configuration();
+  config->set_value( "compression", "zlib" );
+  ser.set_configuration( config );
+  EXPECT_EQ( 1, ser.serialize_parts( any( in ) ).size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST( serialize, detected_object_set_parts )
+{
+  // Serializers without parts give their message as a single part
+  kasb::detected_object_set ser;
+  auto const set = std::make_shared< detected_object_set >();
+  set->add( std::make_shared< detected_object >( bounding_box_d{ 0, 0, 1, 1 } ) );
+
+  auto const parts = ser.serialize_parts( any( set ) );
+  ASSERT_EQ( 1, parts.size() );
+  EXPECT_EQ( *ser.serialize( any( set ) ),
+             kwiver::vital::algo::join_message_parts( parts ) );
+}
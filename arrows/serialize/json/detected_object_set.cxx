@@ -5,6 +5,7 @@
 #include "detected_object_set.h"
 
 #include "detected_object.h"
+#include "json_writer.h"
 #include "load_save.h"
 
 #include <vital/types/detected_object_set.h>
@@ -38,13 +39,7 @@ serialize( const vital::any& element )
   kwiver::vital::detected_object_set_sptr obj =
     kwiver::vital::any_cast< kwiver::vital::detected_object_set_sptr > ( element );
 
-  std::stringstream msg;
-  msg << "detected_object_set ";
-  {
-    cereal::JSONOutputArchive ar( msg );
-    save( ar, *obj );
-  }
-  return std::make_shared< std::string > ( msg.str() );
+  return write_detected_object_set( "detected_object_set", *obj );
 }
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,483 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "json_writer.h"
+
+#include <vital/types/detected_object.h>
+#include <vital/types/geo_point.h>
+
+// The archive header sets up the rapidjson namespace and default flags the
+// writer below must share with cereal
+#include <vital/internal/cereal/archives/json.hpp>
+#include <vital/internal/cereal/external/rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace kwiver {
+namespace arrows {
+namespace serialize {
+namespace json {
+
+namespace {
+
+namespace rj = CEREAL_RAPIDJSON_NAMESPACE;
+
+using writer_t = rj::PrettyWriter< rj::StringBuffer >;
+
+// Markers cereal uses in polymorphic and pointer ids
+uint32_t const new_id_bit = 0x80000000;
+uint32_t const same_type_id = 0x40000000;
+
+// Names under which the types are registered with cereal
+char const* const track_set_name = "kwiver::vital::track_set";
+char const* const object_track_set_name = "kwiver::vital::object_track_set";
+char const* const object_track_state_name = "kwiver::vital::object_track_state";
+
+// ----------------------------------------------------------------------------
+// Buffer and writer kept by each thread across messages
+struct thread_writer
+{
+  thread_writer()
+    : writer( buffer )
+  {
+    writer.SetMaxDecimalPlaces( writer_t::kDefaultMaxDecimalPlaces );
+    writer.SetIndent( ' ', 4 );
+  }
+
+  writer_t& start( char const* tag )
+  {
+    buffer.Clear();
+    writer.Reset( buffer );
+    for ( ; *tag; ++tag )
+    {
+      buffer.Put( *tag );
+    }
+    buffer.Put( ' ' );
+    return writer;
+  }
+
+  std::shared_ptr< std::string > message() const
+  {
+    return std::make_shared< std::string >( buffer.GetString(),
+                                            buffer.GetSize() );
+  }
+
+  rj::StringBuffer buffer;
+  writer_t writer;
+};
+
+// ----------------------------------------------------------------------------
+thread_writer&
+get_thread_writer()
+{
+  static thread_local thread_writer tw;
+  return tw;
+}
+
+// ----------------------------------------------------------------------------
+// Writes values into the object or array opened last, following the rules of
+// cereal::JSONOutputArchive for naming and for shared pointers
+class object_writer
+{
+public:
+  explicit object_writer( writer_t& w )
+    : m_w( w )
+  { }
+
+  void key( char const* name ) { m_w.Key( name ); }
+
+  void value( double v ) { m_w.Double( v ); }
+  void value( int v ) { m_w.Int( v ); }
+  void value( uint32_t v ) { m_w.Uint( v ); }
+  void value( int64_t v ) { m_w.Int64( v ); }
+  void value( uint64_t v ) { m_w.Uint64( v ); }
+  void value( std::string const& v )
+  {
+    m_w.String( v.c_str(), static_cast< rj::SizeType >( v.size() ) );
+  }
+
+  template < typename T >
+  void field( char const* name, T const& v )
+  {
+    key( name );
+    value( v );
+  }
+
+  template < typename P >
+  void point( P const& pt );
+  void geo_point( vital::geo_point const& pt );
+  void detected_object( vital::detected_object const& obj );
+  void detected_object_set( vital::detected_object_set const& set );
+
+  bool track_state( vital::track_state_sptr const& state );
+  bool track_set_data( vital::track_set const& set, char const* items_name );
+
+  // Write polymorphic_id and, when \p name is first seen, polymorphic_name
+  void polymorphic_id( char const* name );
+
+  // Write the id of \p ptr in ptr_wrapper, returning true if its data
+  // follows
+  bool pointer_id( void const* ptr );
+
+private:
+  writer_t& m_w;
+
+  std::map< char const*, uint32_t > m_type_ids;
+  std::map< void const*, uint32_t > m_pointer_ids;
+};
+
+// ----------------------------------------------------------------------------
+template < typename P >
+void
+object_writer
+::point( P const& pt )
+{
+  m_w.StartObject();
+
+  auto const& v = pt.value();
+  key( "values" );
+  m_w.StartArray();
+  for ( int i = 0; i < v.size(); ++i )
+  {
+    value( static_cast< double >( v[ i ] ) );
+  }
+  m_w.EndArray();
+
+  auto const cov = pt.covariance();
+  auto const data = cov.data();
+  key( "cov_values" );
+  m_w.StartArray();
+  for ( unsigned i = 0; i < decltype( cov )::data_size; ++i )
+  {
+    value( static_cast< double >( data[ i ] ) );
+  }
+  m_w.EndArray();
+
+  m_w.EndObject();
+}
+
+// ----------------------------------------------------------------------------
+void
+object_writer
+::geo_point( vital::geo_point const& pt )
+{
+  m_w.StartObject();
+  if ( pt.is_empty() )
+  {
+    field( "crs", -1 );
+  }
+  else
+  {
+    auto const loc = pt.location( pt.crs() );
+    field( "crs", pt.crs() );
+    field( "x", static_cast< double >( loc[ 0 ] ) );
+    field( "y", static_cast< double >( loc[ 1 ] ) );
+    field( "z", static_cast< double >( loc[ 2 ] ) );
+  }
+  m_w.EndObject();
+}
+
+// ----------------------------------------------------------------------------
+void
+object_writer
+::detected_object( vital::detected_object const& obj )
+{
+  auto const& bbox = obj.bounding_box();
+  field( "min_x", bbox.min_x() );
+  field( "min_y", bbox.min_y() );
+  field( "max_x", bbox.max_x() );
+  field( "max_y", bbox.max_y() );
+  field( "confidence", obj.confidence() );
+  field( "index", static_cast< uint64_t >( obj.index() ) );
+  field( "detector_name", obj.detector_name() );
+
+  key( "notes" );
+  m_w.StartArray();
+  for ( auto const& note : obj.notes() )
+  {
+    value( note );
+  }
+  m_w.EndArray();
+
+  key( "keypoints" );
+  m_w.StartArray();
+  for ( auto const& kp : obj.keypoints() )
+  {
+    m_w.StartObject();
+    field( "key", kp.first );
+    key( "value" );
+    point( kp.second );
+    m_w.EndObject();
+  }
+  m_w.EndArray();
+
+  key( "geo_point" );
+  geo_point( obj.geo_point() );
+
+  // Class names are written in sorted order, as from a std::map
+  std::vector< std::pair< std::string const*, double > > scores;
+  auto const type = const_cast< vital::detected_object& >( obj ).type();
+  if ( type )
+  {
+    for ( auto const& entry : *type )
+    {
+      scores.emplace_back( entry.first, entry.second );
+    }
+    std::sort( scores.begin(), scores.end(),
+               []( std::pair< std::string const*, double > const& a,
+                   std::pair< std::string const*, double > const& b ){
+                 return *a.first < *b.first;
+               } );
+  }
+
+  key( "detected_object_type_content" );
+  m_w.StartArray();
+  for ( auto const& score : scores )
+  {
+    m_w.StartObject();
+    field( "key", *score.first );
+    field( "value", score.second );
+    m_w.EndObject();
+  }
+  m_w.EndArray();
+}
+
+// ----------------------------------------------------------------------------
+void
+object_writer
+::detected_object_set( vital::detected_object_set const& set )
+{
+  field( "size", static_cast< uint64_t >( set.size() ) );
+  for ( auto it = set.cbegin(); it != set.cend(); ++it )
+  {
+    detected_object( **it );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+object_writer
+::polymorphic_id( char const* name )
+{
+  auto const it = m_type_ids.find( name );
+  if ( it != m_type_ids.end() )
+  {
+    field( "polymorphic_id", it->second );
+    return;
+  }
+
+  auto const id = static_cast< uint32_t >( m_type_ids.size() + 1 );
+  m_type_ids.emplace( name, id );
+  field( "polymorphic_id", id | new_id_bit );
+  field( "polymorphic_name", std::string{ name } );
+}
+
+// ----------------------------------------------------------------------------
+bool
+object_writer
+::pointer_id( void const* ptr )
+{
+  auto const it = m_pointer_ids.find( ptr );
+  if ( it != m_pointer_ids.end() )
+  {
+    field( "id", it->second );
+    return false;
+  }
+
+  auto const id = static_cast< uint32_t >( m_pointer_ids.size() + 1 );
+  m_pointer_ids.emplace( ptr, id );
+  field( "id", id | new_id_bit );
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+bool
+object_writer
+::track_state( vital::track_state_sptr const& state )
+{
+  if ( !state )
+  {
+    field( "polymorphic_id", uint32_t{ 0 } );
+    return true;
+  }
+
+  auto const& type = typeid( *state );
+  vital::object_track_state const* ots = nullptr;
+  if ( type == typeid( vital::track_state ) )
+  {
+    field( "polymorphic_id", same_type_id );
+  }
+  else if ( type == typeid( vital::object_track_state ) )
+  {
+    ots = static_cast< vital::object_track_state const* >( state.get() );
+    if ( !ots->detection() )
+    {
+      return false;
+    }
+    polymorphic_id( object_track_state_name );
+  }
+  else
+  {
+    return false;
+  }
+
+  key( "ptr_wrapper" );
+  m_w.StartObject();
+  if ( pointer_id( state.get() ) )
+  {
+    key( "data" );
+    m_w.StartObject();
+    if ( ots )
+    {
+      key( "value0" );
+      m_w.StartObject();
+      field( "track_frame", static_cast< int64_t >( ots->frame() ) );
+      m_w.EndObject();
+      field( "track_time", static_cast< int64_t >( ots->time() ) );
+      key( "image_point" );
+      point( ots->image_point() );
+      key( "track_point" );
+      point( ots->track_point() );
+      detected_object( *ots->detection() );
+    }
+    else
+    {
+      field( "track_frame", static_cast< int64_t >( state->frame() ) );
+    }
+    m_w.EndObject();
+  }
+  m_w.EndObject();
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+bool
+object_writer
+::track_set_data( vital::track_set const& set, char const* items_name )
+{
+  key( items_name );
+  m_w.StartArray();
+  for ( auto const& trk : set.tracks() )
+  {
+    m_w.StartObject();
+    field( "track_id", static_cast< int64_t >( trk->id() ) );
+    field( "track_size", static_cast< uint64_t >( trk->size() ) );
+    key( "trk" );
+    m_w.StartArray();
+    for ( auto const& state : *trk )
+    {
+      m_w.StartObject();
+      if ( !track_state( state ) )
+      {
+        return false;
+      }
+      m_w.EndObject();
+    }
+    m_w.EndArray();
+    m_w.EndObject();
+  }
+  m_w.EndArray();
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+// Write a track set held by a shared pointer to \p static_name
+std::shared_ptr< std::string >
+write_track_set_pointer( char const* tag, vital::track_set const* set,
+                         char const* static_name )
+{
+  auto& tw = get_thread_writer();
+  auto& w = tw.start( tag );
+  object_writer ow{ w };
+
+  w.StartObject();
+  if ( !set )
+  {
+    ow.field( "polymorphic_id", uint32_t{ 0 } );
+    w.EndObject();
+    return tw.message();
+  }
+
+  auto const& type = typeid( *set );
+  char const* dynamic_name = nullptr;
+  if ( type == typeid( vital::track_set ) )
+  {
+    dynamic_name = track_set_name;
+  }
+  else if ( type == typeid( vital::object_track_set ) )
+  {
+    dynamic_name = object_track_set_name;
+  }
+  else
+  {
+    return nullptr;
+  }
+
+  if ( dynamic_name == static_name )
+  {
+    ow.field( "polymorphic_id", same_type_id );
+  }
+  else if ( static_name == track_set_name )
+  {
+    ow.polymorphic_id( dynamic_name );
+  }
+  else
+  {
+    // A track_set is not an object_track_set
+    return nullptr;
+  }
+
+  ow.key( "ptr_wrapper" );
+  w.StartObject();
+  ow.pointer_id( set );
+  ow.key( "data" );
+  w.StartObject();
+  if ( !ow.track_set_data( *set, dynamic_name == track_set_name
+                                 ? "trk_items" : "object_trk_items" ) )
+  {
+    return nullptr;
+  }
+  w.EndObject();
+  w.EndObject();
+  w.EndObject();
+  return tw.message();
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< std::string >
+write_detected_object_set( char const* tag,
+                           vital::detected_object_set const& set )
+{
+  auto& tw = get_thread_writer();
+  auto& w = tw.start( tag );
+
+  w.StartObject();
+  object_writer{ w }.detected_object_set( set );
+  w.EndObject();
+  return tw.message();
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< std::string >
+write_track_set( char const* tag, vital::track_set_sptr const& set )
+{
+  return write_track_set_pointer( tag, set.get(), track_set_name );
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< std::string >
+write_object_track_set( char const* tag,
+                        vital::object_track_set_sptr const& set )
+{
+  return write_track_set_pointer( tag, set.get(), object_track_set_name );
+}
+
+} } } }       // end namespace kwiver
@@ -0,0 +1,46 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Direct JSON writers for detections and track sets
+
+#ifndef ARROWS_SERIALIZATION_JSON_JSON_WRITER_H
+#define ARROWS_SERIALIZATION_JSON_JSON_WRITER_H
+
+#include <vital/types/detected_object_set.h>
+#include <vital/types/object_track_set.h>
+#include <vital/types/track_set.h>
+
+#include <memory>
+#include <string>
+
+namespace kwiver {
+namespace arrows {
+namespace serialize {
+namespace json {
+
+// ----------------------------------------------------------------------------
+// These write the message "<tag> <json>" with the same bytes as saving the
+// object through a cereal::JSONOutputArchive, without building the archive's
+// node stack or going through a std::ostream. The text is formatted in a
+// buffer owned by the calling thread, which is reused from one message to
+// the next.
+//
+// The track set writers return nullptr when the set holds a track state of a
+// type they do not know; the caller should then use the archive.
+
+std::shared_ptr< std::string >
+write_detected_object_set( char const* tag,
+                           vital::detected_object_set const& set );
+
+std::shared_ptr< std::string >
+write_track_set( char const* tag, vital::track_set_sptr const& set );
+
+std::shared_ptr< std::string >
+write_object_track_set( char const* tag,
+                        vital::object_track_set_sptr const& set );
+
+} } } }       // end namespace kwiver
+
+#endif // ARROWS_SERIALIZATION_JSON_JSON_WRITER_H
@@ -5,15 +5,21 @@
 /// \file
 /// \brief Implementation of metadata load/save functionality.
 
-#include <arrows/serialize/json/metadata.h>
+#include <arrows/serialize/json/load_save.h>
 #include <arrows/serialize/json/metadata_map_io.h>
 
 #include <vital/types/metadata_map.h>
 
 #include <vital/exceptions/io.h>
+#include <vital/util/thread_pool.h>
 
-#include <fstream>
+#include <vital/internal/cereal/cereal.hpp>
+#include <vital/internal/cereal/archives/json.hpp>
+
+#include <exception>
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 namespace kwiver {
 
@@ -23,16 +29,238 @@ namespace serialize {
 
 namespace json {
 
+namespace {
+
+// A document is an array with an element {"key": frame, "value": packets} per
+// frame. Elements are read, parsed and written this many at a time, in
+// parallel, so only one batch of the text is ever held in memory.
+size_t const frames_per_batch = 256;
+size_t const frames_per_task = 8;
+
 // ----------------------------------------------------------------------------
-class metadata_map_io::priv
+// Splits the top level array of a JSON document, as read from a stream, into
+// the text of its elements without parsing them
+class element_reader
 {
 public:
-  metadata serializer;
+  element_reader( std::istream& in, std::string const& filename )
+    : m_in( in ), m_filename( filename ), m_buffer( 1 << 16 )
+  {}
+
+  // Read the next element into \p text, returning false after the last one
+  bool next( std::string& text );
+
+private:
+  bool get( char& c );
+  bool get_non_space( char& c );
+  [[noreturn]] void fail( char const* reason ) const;
+
+  std::istream& m_in;
+  std::string const& m_filename;
+  std::vector< char > m_buffer;
+  size_t m_pos = 0;
+  size_t m_end = 0;
+  bool m_started = false;
+  bool m_done = false;
+};
+
+// ----------------------------------------------------------------------------
+bool
+element_reader
+::get( char& c )
+{
+  if( m_pos == m_end )
+  {
+    m_in.read( m_buffer.data(), m_buffer.size() );
+    m_pos = 0;
+    m_end = static_cast< size_t >( m_in.gcount() );
+    if( !m_end )
+    {
+      return false;
+    }
+  }
+  c = m_buffer[ m_pos++ ];
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+bool
+element_reader
+::get_non_space( char& c )
+{
+  while( get( c ) )
+  {
+    if( c != ' ' && c != '\n' && c != '\r' && c != '\t' )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// ----------------------------------------------------------------------------
+void
+element_reader
+::fail( char const* reason ) const
+{
+  VITAL_THROW( vital::file_not_read_exception, m_filename, reason );
+}
+
+// ----------------------------------------------------------------------------
+bool
+element_reader
+::next( std::string& text )
+{
+  char c;
+  if( !m_started )
+  {
+    m_started = true;
+
+    // An empty map is saved as an empty document
+    if( !get_non_space( c ) )
+    {
+      m_done = true;
+    }
+    else if( c != '[' )
+    {
+      fail( "Metadata document is not a JSON array" );
+    }
+    else if( !get_non_space( c ) )
+    {
+      fail( "Metadata document ends unexpectedly" );
+    }
+    else if( c == ']' )
+    {
+      m_done = true;
+    }
+    else
+    {
+      --m_pos;
+    }
+  }
+  if( m_done )
+  {
+    return false;
+  }
+
+  text.clear();
+  if( !get_non_space( c ) )
+  {
+    fail( "Metadata document ends unexpectedly" );
+  }
+
+  size_t depth = 0;
+  bool in_string = false;
+  bool escaped = false;
+  size_t end = 0;
+  do
+  {
+    if( in_string )
+    {
+      in_string = escaped || c != '"';
+      escaped = !escaped && c == '\\';
+    }
+    else if( depth == 0 && ( c == ',' || c == ']' ) )
+    {
+      m_done = ( c == ']' );
+      text.resize( end );
+      return true;
+    }
+    else if( c == '"' )
+    {
+      in_string = true;
+    }
+    else if( c == '{' || c == '[' )
+    {
+      ++depth;
+    }
+    else if( c == '}' || c == ']' )
+    {
+      --depth;
+    }
+
+    text.push_back( c );
+    if( in_string || ( c != ' ' && c != '\n' && c != '\r' && c != '\t' ) )
+    {
+      end = text.size();
+    }
+  } while( get( c ) );
+
+  fail( "Metadata document ends unexpectedly" );
+}
+
+// ----------------------------------------------------------------------------
+// Call \p f on each index of a batch in parallel, then rethrow the first
+// error in the batch, if any
+template < class F >
+void
+for_each_in_batch( size_t count, F const& f )
+{
+  std::vector< std::exception_ptr > errors( count );
+  vital::thread_pool::instance().parallel_for(
+    count, frames_per_task,
+    [ & ]( size_t begin, size_t end ){
+      for( auto i = begin; i < end; ++i )
+      {
+        try
+        {
+          f( i );
+        }
+        catch( ... )
+        {
+          errors[ i ] = std::current_exception();
+        }
+      }
+    } );
+
+  for( auto const& error : errors )
+  {
+    if( error )
+    {
+      std::rethrow_exception( error );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Format one frame as an element of the document, indented to sit within the
+// top level array just as a single archive of the whole map would put it
+std::string
+format_element( vital::frame_id_t frame,
+                vital::metadata_vector const& packets )
+{
+  std::ostringstream out;
+  {
+    cereal::JSONOutputArchive ar( out );
+    ar( cereal::make_nvp( "key", frame ), cereal::make_nvp( "value", packets ) );
+  }
+
+  auto const& text = out.str();
+  std::string element;
+  element.reserve( text.size() + text.size() / 8 );
+  element += "    ";
+  for( auto const c : text )
+  {
+    element.push_back( c );
+    if( c == '\n' )
+    {
+      element += "    ";
+    }
+  }
+  return element;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+class metadata_map_io::priv
+{
 };
 
 // ----------------------------------------------------------------------------
 metadata_map_io
 ::metadata_map_io()
+  : d_{ new priv }
 {
 }
 
@@ -51,12 +279,36 @@ ::load_( std::istream& fin, std::string const& filename ) const
 
   if( fin )
   {
-    std::stringstream buffer;
-    buffer << fin.rdbuf();
+    element_reader reader{ fin, filename };
+    std::vector< std::string > texts( frames_per_batch );
+    std::vector< std::pair< vital::frame_id_t, vital::metadata_vector > >
+      frames( frames_per_batch );
 
-    auto const& input_string = buffer.str();
+    size_t count;
+    do
+    {
+      for( count = 0; count < frames_per_batch; ++count )
+      {
+        if( !reader.next( texts[ count ] ) )
+        {
+          break;
+        }
+      }
 
-    metadata_map = d_->serializer.deserialize_map( input_string );
+      for_each_in_batch( count, [ & ]( size_t i ){
+        std::istringstream element{ texts[ i ] };
+        cereal::JSONInputArchive ar( element );
+        frames[ i ].second.clear();
+        ar( cereal::make_nvp( "key", frames[ i ].first ),
+            cereal::make_nvp( "value", frames[ i ].second ) );
+      } );
+
+      for( size_t i = 0; i < count; ++i )
+      {
+        metadata_map.emplace_hint( metadata_map.end(), frames[ i ].first,
+                                   std::move( frames[ i ].second ) );
+      }
+    } while( count == frames_per_batch );
   }
   else
   {
@@ -75,10 +327,37 @@ ::save_( std::ostream& fout,
 {
   if( fout )
   {
-    auto metadata = data->metadata();
-    std::shared_ptr< std::string > serialized =
-      d_->serializer.serialize_map( metadata );
-    fout << *serialized << std::endl;
+    auto const metadata = data->metadata();
+    std::vector< decltype( metadata.begin() ) > frames;
+    std::vector< std::string > elements;
+    frames.reserve( frames_per_batch );
+    elements.resize( frames_per_batch );
+
+    char const* separator = "[\n";
+    for( auto it = metadata.begin(); it != metadata.end(); )
+    {
+      frames.clear();
+      for( ; it != metadata.end() && frames.size() < frames_per_batch; ++it )
+      {
+        frames.push_back( it );
+      }
+
+      for_each_in_batch( frames.size(), [ & ]( size_t i ){
+        elements[ i ] = format_element( frames[ i ]->first,
+                                        frames[ i ]->second );
+      } );
+
+      for( size_t i = 0; i < frames.size(); ++i )
+      {
+        fout << separator << elements[ i ];
+        separator = ",\n";
+      }
+    }
+    if( !metadata.empty() )
+    {
+      fout << "\n]";
+    }
+    fout << std::endl;
   }
   else
   {
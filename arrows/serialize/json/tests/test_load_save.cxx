@@ -6,7 +6,11 @@
 #include <arrows/serialize/json/load_save_point.h>
 #include <arrows/serialize/json/load_save_track_state.h>
 #include <arrows/serialize/json/load_save_track_set.h>
+#include <arrows/serialize/json/detected_object_set.h>
+#include <arrows/serialize/json/metadata_map_io.h>
+#include <arrows/serialize/json/object_track_set.h>
 #include <arrows/serialize/json/track.h>
+#include <arrows/serialize/json/track_set.h>
 
 #include <vital/internal/cereal/cereal.hpp>
 #include <vital/internal/cereal/archives/json.hpp>
@@ -16,6 +20,7 @@
 #include <vital/types/covariance.h>
 #include <vital/types/detected_object.h>
 #include <vital/types/detected_object_set.h>
+#include <vital/types/feature_track_set.h>
 #include <vital/types/geo_polygon.h>
 #include <vital/types/geodesy.h>
 #include <vital/types/image_container.h>
@@ -31,6 +36,7 @@
 #include <vital/types/track.h>
 #include <vital/types/track_set.h>
 
+#include <vital/exceptions/io.h>
 #include <vital/vital_types.h>
 
 #include <vital/range/iota.h>
@@ -804,6 +810,72 @@ TEST( load_save, object_track_set )
   }
 }
 
+// ----------------------------------------------------------------------------
+TEST( load_save, metadata_map_io )
+{
+  // The algorithm streams the document a few frames at a time; it must write
+  // what one archive of the whole map would
+  kwiver::arrows::serialize::json::metadata_map_io io;
+  kwiver::vital::metadata_map::map_metadata_t meta_map;
+
+  auto const check_round_trip =
+    [ & ](){
+      std::stringstream expected;
+      {
+        cereal::JSONOutputArchive ar( expected );
+        cereal::save( ar, meta_map );
+      }
+      expected << std::endl;
+
+      std::stringstream saved;
+      io.save_( saved,
+                std::make_shared< kwiver::vital::simple_metadata_map >(
+                  meta_map ), "test.json" );
+      EXPECT_EQ( expected.str(), saved.str() );
+
+      auto const loaded = io.load_( saved, "test.json" )->metadata();
+      ASSERT_EQ( meta_map.size(), loaded.size() );
+      for( auto const& item : meta_map )
+      {
+        auto const& dser_vect = loaded.at( item.first );
+        ASSERT_EQ( item.second.size(), dser_vect.size() );
+        for( auto const i : kvr::iota( item.second.size() ) )
+        {
+          compare_meta_collection( *item.second[ i ], *dser_vect[ i ] );
+        }
+      }
+    };
+
+  check_round_trip();
+
+  auto const meta =
+    std::make_shared< kwiver::vital::metadata >( create_meta_collection() );
+  auto const other = std::make_shared< kwiver::vital::metadata >();
+  other->add< kwiver::vital::VITAL_META_PLATFORM_DESIGNATION >(
+    "quoted \"name\", with [brackets] and {braces}\\" );
+  other->add< kwiver::vital::VITAL_META_VIDEO_KEY_FRAME >( true );
+
+  meta_map[ 3 ] = { meta };
+  check_round_trip();
+
+  // More frames than are handled in one batch, one without packets
+  for( kwiver::vital::frame_id_t frame = 10; frame < 1000; ++frame )
+  {
+    meta_map[ frame ] = { meta, other };
+  }
+  meta_map[ 5 ] = {};
+  check_round_trip();
+
+  // Truncated documents are not silently accepted
+  std::stringstream saved;
+  io.save_( saved,
+            std::make_shared< kwiver::vital::simple_metadata_map >( meta_map ),
+            "test.json" );
+  std::stringstream truncated{ saved.str().substr( 0, 5000 ) };
+  EXPECT_THROW( io.load_( truncated, "test.json" ),
+                kwiver::vital::file_not_read_exception );
+}
+
 // ----------------------------------------------------------------------------
 TEST( load_save, covariance )
 {
@@ -882,3 +954,144 @@ do {                                                                    \
 #undef TEST_POINT
 
 }
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Message a serializer would produce from saving obj through an archive
+template < typename T >
+std::string
+archive_message( std::string const& tag, T const& obj )
+{
+  std::stringstream msg;
+  msg << tag << " ";
+  {
+    cereal::JSONOutputArchive ar( msg );
+    cereal::save( ar, obj );
+  }
+  return msg.str();
+}
+
+// ----------------------------------------------------------------------------
+kwiver::vital::detected_object_sptr
+make_detection( double confidence )
+{
+  auto dot = std::make_shared< kwiver::vital::detected_object_type >();
+  dot->set_score( "zebra", 0.1 );
+  dot->set_score( "aardvark", 1.0 / 3.0 );
+  dot->set_score( "other", 1e-7 );
+
+  auto det = std::make_shared< kwiver::vital::detected_object >(
+    kwiver::vital::bounding_box_d{ 1, 2.5, 3.25, 1e20 }, confidence, dot );
+  det->set_detector_name( "detector \"quoted\"\n" );
+  det->set_index( 1234 );
+  det->add_note( "first note" );
+  det->add_note( "second note" );
+  det->add_keypoint( "head", kwiver::vital::point_2d{ 1.5, -2 } );
+  det->add_keypoint( "tail", kwiver::vital::point_2d{ 0.1, 100 } );
+  det->set_geo_point(
+    kwiver::vital::geo_point{ kwiver::vital::geo_point::geo_2d_point_t{
+                                42.5, 73.54 },
+                              kwiver::vital::SRID::lat_lon_WGS84 } );
+  return det;
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+TEST( load_save, fast_detected_object_set )
+{
+  // The serializer writes JSON directly; it must match the archive
+  kwiver::arrows::serialize::json::detected_object_set ser;
+
+  auto dos = std::make_shared< kwiver::vital::detected_object_set >();
+  EXPECT_EQ( archive_message( "detected_object_set", *dos ),
+             *ser.serialize( kwiver::vital::any{ dos } ) );
+
+  dos->add( make_detection( 0.3 ) );
+  dos->add( std::make_shared< kwiver::vital::detected_object >(
+              kwiver::vital::bounding_box_d{ 0, 0, 1e-7, 5 }, -0.0 ) );
+  dos->add( make_detection( 123456789.125 ) );
+  EXPECT_EQ( archive_message( "detected_object_set", *dos ),
+             *ser.serialize( kwiver::vital::any{ dos } ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST( load_save, fast_track_set )
+{
+  kwiver::arrows::serialize::json::track_set ser;
+
+  auto ts = std::make_shared< kwiver::vital::track_set >();
+  EXPECT_EQ( archive_message( "track_set", ts ),
+             *ser.serialize( kwiver::vital::any{ ts } ) );
+
+  for ( kwiver::vital::track_id_t trk_id = 1; trk_id < 4; ++trk_id )
+  {
+    auto trk = kwiver::vital::track::create();
+    trk->set_id( trk_id * 1000000000000 );
+    for ( int i = 0; i < 3; ++i )
+    {
+      trk->insert( std::make_shared< kwiver::vital::track_state >(
+                     trk_id * 10 + i ) );
+    }
+    ts->insert( trk );
+  }
+  ts->insert( kwiver::vital::track::create() );
+  EXPECT_EQ( archive_message( "track_set", ts ),
+             *ser.serialize( kwiver::vital::any{ ts } ) );
+
+  kwiver::vital::track_set_sptr null_set;
+  EXPECT_EQ( archive_message( "track_set", null_set ),
+             *ser.serialize( kwiver::vital::any{ null_set } ) );
+
+  // Object tracks held as plain tracks
+  auto det = make_detection( 0.5 );
+  auto trk = kwiver::vital::track::create();
+  trk->set_id( 7 );
+  trk->insert( std::make_shared< kwiver::vital::object_track_state >(
+                 1, 10, det ) );
+  trk->insert( std::make_shared< kwiver::vital::track_state >( 2 ) );
+  trk->insert( std::make_shared< kwiver::vital::object_track_state >(
+                 3, 30, det ) );
+  kwiver::vital::track_set_sptr ots =
+    std::make_shared< kwiver::vital::object_track_set >(
+      std::vector< kwiver::vital::track_sptr >{ trk } );
+  EXPECT_EQ( archive_message( "track_set", ots ),
+             *ser.serialize( kwiver::vital::any{ ots } ) );
+
+  // States the direct writer does not know go through the archive
+  auto feature_trk = kwiver::vital::track::create();
+  feature_trk->insert(
+    std::make_shared< kwiver::vital::feature_track_state >( 1 ) );
+  auto fts = std::make_shared< kwiver::vital::track_set >(
+    std::vector< kwiver::vital::track_sptr >{ feature_trk } );
+  EXPECT_THROW( ser.serialize( kwiver::vital::any{ fts } ),
+                cereal::Exception );
+}
+
+// ----------------------------------------------------------------------------
+TEST( load_save, fast_object_track_set )
+{
+  kwiver::arrows::serialize::json::object_track_set ser;
+
+  auto ots = std::make_shared< kwiver::vital::object_track_set >();
+  EXPECT_EQ( archive_message( "object_track_set", ots ),
+             *ser.serialize( kwiver::vital::any{ ots } ) );
+
+  for ( kwiver::vital::track_id_t trk_id = 1; trk_id < 3; ++trk_id )
+  {
+    auto trk = kwiver::vital::track::create();
+    trk->set_id( trk_id );
+    for ( int i = trk_id * 2; i < ( trk_id + 1 ) * 2; ++i )
+    {
+      auto state = std::make_shared< kwiver::vital::object_track_state >(
+        i, i * 33333, make_detection( 1.0 / i ) );
+      state->set_image_point( kwiver::vital::point_2d{ i * 0.1, 2 } );
+      state->set_track_point( kwiver::vital::point_3d{ 1, i * 1e-3, 3 } );
+      trk->insert( state );
+    }
+    ots->insert( trk );
+  }
+  EXPECT_EQ( archive_message( "object_track_set", ots ),
+             *ser.serialize( kwiver::vital::any{ ots } ) );
+}
@@ -4,6 +4,7 @@
 
 #include "track_set.h"
 
+#include "json_writer.h"
 #include "load_save.h"
 #include "load_save_track_state.h"
 #include "load_save_track_set.h"
@@ -36,6 +37,13 @@ serialize( const vital::any& element )
   kwiver::vital::track_set_sptr trk_set_sptr =
     kwiver::vital::any_cast< kwiver::vital::track_set_sptr > ( element );
 
+  auto const fast_msg = write_track_set( "track_set", trk_set_sptr );
+  if ( fast_msg )
+  {
+    return fast_msg;
+  }
+
+  // The set holds track states the direct writer does not know about
   std::stringstream msg;
   msg << "track_set "; // add type tag
   {
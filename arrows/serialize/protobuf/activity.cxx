@@ -4,6 +4,7 @@
 
 #include "activity.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/activity.h>
 #include <vital/types/protobuf/activity.pb.h>
@@ -35,19 +36,18 @@ serialize( const vital::any& element )
   kwiver::vital::activity act =
     kwiver::vital::any_cast< kwiver::vital::activity > ( element );
 
-  std::ostringstream msg;
-  msg << "activity "; // add type tag
-
-  kwiver::protobuf::activity proto_act;
+  auto& proto_act = thread_message< kwiver::protobuf::activity >();
   convert_protobuf( act, proto_act );
 
-  if ( ! proto_act.SerializeToOstream( &msg ) )
+  if ( ! proto_act.IsInitialized() )
   {
     VITAL_THROW( kwiver::vital::serialization_exception,
                  "Error serializing activity from protobuf" );
   }
 
-  return std::make_shared< std::string > ( msg.str() );
+  auto msg = serialize_message( "activity", proto_act );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -55,28 +55,24 @@ vital::any activity::
 deserialize( const std::string& message )
 {
   kwiver::vital::activity act;
-  std::istringstream msg( message );
-
-  std::string tag;
-  msg >> tag;
-  msg.get();  // Eat delimiter
 
-  if ( tag != "activity" )
+  if ( ! has_message_tag( "activity", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"activity\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::activity proto_act;
-    if ( ! proto_act.ParseFromIstream( &msg ) )
+    auto& proto_act = thread_message< kwiver::protobuf::activity >();
+    if ( ! parse_message( "activity", message, proto_act ) )
     {
       VITAL_THROW( kwiver::vital::serialization_exception,
                    "Error deserializing detected_type from protobuf" );
     }
 
     convert_protobuf( proto_act, act );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any(act);
@@ -4,6 +4,7 @@
 
 #include "activity_type.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/activity_type.h>
 #include <vital/types/protobuf/activity_type.pb.h>
@@ -35,18 +36,18 @@ serialize( const vital::any& element )
   kwiver::vital::activity_type at =
     kwiver::vital::any_cast< kwiver::vital::activity_type > ( element );
 
-  std::ostringstream msg;
-  msg << "activity_type "; // add type tag
-
-  kwiver::protobuf::activity_type proto_at;
+  auto& proto_at = thread_message< kwiver::protobuf::activity_type >();
   convert_protobuf( at, proto_at );
 
-  if ( ! proto_at.SerializeToOstream( &msg ) )
+  if ( ! proto_at.IsInitialized() )
   {
     VITAL_THROW( kwiver::vital::serialization_exception,
                  "Error serializing detected_type from protobuf" );
   }
-  return std::make_shared< std::string > ( msg.str() );
+
+  auto msg = serialize_message( "activity_type", proto_at );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -54,28 +55,24 @@ vital::any activity_type::
 deserialize( const std::string& message )
 {
   kwiver::vital::activity_type at;
-  std::istringstream msg( message );
-
-  std::string tag;
-  msg >> tag;
-  msg.get();  // Eat delimiter
 
-  if (tag != "activity_type" )
+  if ( ! has_message_tag( "activity_type", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"activity_type\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::activity_type proto_at;
-    if ( ! proto_at.ParseFromIstream( &msg ) )
+    auto& proto_at = thread_message< kwiver::protobuf::activity_type >();
+    if ( ! parse_message( "activity_type", message, proto_at ) )
     {
       VITAL_THROW( kwiver::vital::serialization_exception,
                    "Error deserializing detected_type from protobuf" );
     }
 
     convert_protobuf( proto_at, at );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any(at);
@@ -4,6 +4,7 @@
 
 #include "bounding_box.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/bounding_box.h>
 #include <vital/types/protobuf/bounding_box.pb.h>
@@ -34,18 +35,17 @@ serialize( const vital::any& element )
   kwiver::vital::bounding_box_d bbox =
     kwiver::vital::any_cast< kwiver::vital::bounding_box_d > ( element );
 
-  std::ostringstream msg;
-  msg << "bounding_box "; // add type tag
-
-  kwiver::protobuf::bounding_box proto_bbox;
+  auto& proto_bbox = thread_message< kwiver::protobuf::bounding_box >();
   convert_protobuf( bbox, proto_bbox );
 
-  if ( ! proto_bbox.SerializeToOstream( &msg ) )
+  if ( ! proto_bbox.IsInitialized() )
   {
     LOG_ERROR( logger(), "proto_bbox.SerializeToOStream failed" );
   }
 
-  return std::make_shared< std::string > ( msg.str() );
+  auto msg = serialize_message( "bounding_box", proto_bbox );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -54,26 +54,23 @@ deserialize( const std::string& message )
 {
   kwiver::vital::bounding_box_d bbox{ 0, 0, 0, 0 };
 
-  std::istringstream msg( message );
-  std::string tag;
-  msg >> tag;
-  msg.get();  // Eat the delimiter
 
-  if (tag != "bounding_box" )
+  if ( ! has_message_tag( "bounding_box", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"bounding_box\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::bounding_box proto_bbox;
-    if ( ! proto_bbox.ParseFromIstream( &msg ) )
+    auto& proto_bbox = thread_message< kwiver::protobuf::bounding_box >();
+    if ( ! parse_message( "bounding_box", message, proto_bbox ) )
     {
       LOG_ERROR( logger(), "Incoming protobuf stream did not parse correctly. ParseFromIstream failed." );
     }
 
     convert_protobuf( proto_bbox, bbox );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any(bbox);
@@ -95,33 +95,22 @@ KWIVER_SERIALIZE_PROTOBUF_EXPORT
 void convert_protobuf( const ::kwiver::vital::activity& act,
                        ::kwiver::protobuf::activity&    proto_act )
 {
-  // Again retrieve required params and convert to protobuf
-  ::kwiver::protobuf::timestamp proto_start_frame;
-  convert_protobuf( act.start(), proto_start_frame );
-
-  ::kwiver::protobuf::timestamp proto_end_frame;
-  convert_protobuf( act.end(), proto_end_frame );
-
   // Set required fields
   proto_act.set_id( act.id() );
   proto_act.set_label( act.label() );
   proto_act.set_confidence( act.confidence() );
-  *proto_act.mutable_start_frame() = proto_start_frame;
-  *proto_act.mutable_end_frame() = proto_end_frame;
+  convert_protobuf( act.start(), *proto_act.mutable_start_frame() );
+  convert_protobuf( act.end(), *proto_act.mutable_end_frame() );
 
   // Now check if optional fields can be set
   if ( auto at_sptr = act.type() )
   {
-    ::kwiver::protobuf::activity_type proto_at;
-    convert_protobuf( *at_sptr, proto_at );
-    *proto_act.mutable_classifications() = proto_at;
+    convert_protobuf( *at_sptr, *proto_act.mutable_classifications() );
   }
 
   if ( auto obj_trk_set_sptr = act.participants() )
   {
-    ::kwiver::protobuf::object_track_set proto_obj_trk_set;
-    convert_protobuf( obj_trk_set_sptr, proto_obj_trk_set );
-    *proto_act.mutable_participants() = proto_obj_trk_set;
+    convert_protobuf( obj_trk_set_sptr, *proto_act.mutable_participants() );
   }
 }
 
@@ -152,15 +141,13 @@ void convert_protobuf( const ::kwiver::protobuf::detected_object&  proto_det_obj
   det_object.set_confidence( proto_det_object.confidence() );
 
   ::kwiver::vital::bounding_box_d bbox{ 0, 0, 0, 0 };
-  ::kwiver::protobuf::bounding_box proto_bbox = proto_det_object.bbox();
-  convert_protobuf( proto_bbox, bbox );
+  convert_protobuf( proto_det_object.bbox(), bbox );
   det_object.set_bounding_box( bbox );
 
   if ( proto_det_object.has_classifications() )
   {
     auto new_dot = std::make_shared< ::kwiver::vital::detected_object_type >();
-    ::kwiver::protobuf::detected_object_type proto_dot = proto_det_object.classifications();
-    convert_protobuf( proto_dot, *new_dot );
+    convert_protobuf( proto_det_object.classifications(), *new_dot );
     det_object.set_type( new_dot );
   }
 
@@ -183,8 +170,7 @@ void convert_protobuf( const ::kwiver::protobuf::detected_object&  proto_det_obj
 
   // keypoints
   det_object.clear_keypoints();
-  auto keypoint_map = proto_det_object.keypoints();
-  for ( const auto & entry : keypoint_map )
+  for ( const auto & entry : proto_det_object.keypoints() )
   {
     ::kwiver::vital::point_2d pt;
     convert_protobuf( entry.second, pt );
@@ -222,14 +208,12 @@ void convert_protobuf( const ::kwiver::vital::detected_object& det_object,
   proto_det_object.set_detector_name( det_object.detector_name() );
 
   // Notes
-  auto l_notes = det_object.notes();
-  if ( ! l_notes.empty() )
+  auto const l_notes = det_object.notes();
+  proto_det_object.mutable_notes()->Reserve( static_cast< int >( l_notes.size() ) );
+  for ( auto const& n : l_notes )
   {
-    for ( auto& n : l_notes )
-    {
-      proto_det_object.add_notes( n );
-    } // end for
-  }
+    proto_det_object.add_notes( n );
+  } // end for
 
   // keypoints
   auto l_keyp = det_object.keypoints();
@@ -237,13 +221,9 @@ void convert_protobuf( const ::kwiver::vital::detected_object& det_object,
   {
     auto* mkp = proto_det_object.mutable_keypoints();
 
-    for ( auto it : l_keyp )
+    for ( auto const& it : l_keyp )
     {
-      ::kwiver::protobuf::point_d proto_pt;
-      convert_protobuf( it.second, proto_pt );
-
-      (*mkp)[it.first] = proto_pt;
-
+      convert_protobuf( it.second, (*mkp)[it.first] );
     } // end for
   }
 
@@ -262,9 +242,7 @@ void convert_protobuf( const ::kwiver::protobuf::detected_object_set&  proto_dos
   {
     auto det_object_sptr = std::make_shared< ::kwiver::vital::detected_object >(
       ::kwiver::vital::bounding_box_d { 0, 0, 0, 0 } );
-    auto proto_det_object = proto_dos.detected_objects( i );
-
-    convert_protobuf(proto_det_object,*det_object_sptr);
+    convert_protobuf( proto_dos.detected_objects( i ), *det_object_sptr );
 
     dos.add( det_object_sptr );
   }
@@ -278,7 +256,8 @@ void convert_protobuf( const ::kwiver::vital::detected_object_set& dos,
   // in having the source object parameter be const, but type() isn't because
   // its a pointer into the det_object.  Using const_cast here is a middle ground
   // though somewhat ugly
-  for ( const auto it: const_cast< ::kwiver::vital::detected_object_set& >( dos ) )
+  proto_dos.mutable_detected_objects()->Reserve( static_cast< int >( dos.size() ) );
+  for ( const auto& it: const_cast< ::kwiver::vital::detected_object_set& >( dos ) )
   {
     ::kwiver::protobuf::detected_object *proto_det_object_ptr = proto_dos.add_detected_objects();
 
@@ -422,11 +401,13 @@ void convert_protobuf( const ::kwiver::vital::image_container_sptr img,
     local_image = vital_image;
   }
 
-  // Compress raw pixel data
+  // Compress raw pixel data directly into the message, which keeps the
+  // capacity of the buffer when the message is reused
   const uLongf size = compressBound( local_image.size() );
   uLongf out_size(size);
-  std::vector<uint8_t> image_data( size );
-  Bytef *out_buf = new Bytef[size];
+  std::string* out_data = proto_img.mutable_data();
+  out_data->resize( size );
+  Bytef *out_buf = reinterpret_cast< Bytef* >( &( *out_data )[0] );
   Bytef const* in_buf = reinterpret_cast< Bytef * >(local_image.memory()->data());
 
   // Since the image is contiguous, we can calculate the size
@@ -454,6 +435,7 @@ void convert_protobuf( const ::kwiver::vital::image_container_sptr img,
                  "Error compressing image data." );
       break;
     } // end switch
+    proto_img.clear_data();
   }
   else
   {
@@ -472,7 +454,7 @@ void convert_protobuf( const ::kwiver::vital::image_container_sptr img,
     proto_img.set_trait_num_bytes( pixel_trait.num_bytes );
 
     proto_img.set_size( local_image.size() ); // uncompressed size
-    proto_img.set_data( out_buf, size );
+    out_data->resize( out_size ); // compressed size
 
     // serialize the metadata if there is any.
     if ( img->get_metadata() )
@@ -481,7 +463,6 @@ void convert_protobuf( const ::kwiver::vital::image_container_sptr img,
       convert_protobuf( *img->get_metadata(), *proto_meta );
     }
   }
-  delete []out_buf;
 }
 
 // ----------------------------------------------------------------------------
@@ -715,6 +696,7 @@ void convert_protobuf( const ::kwiver::vital::polygon& poly,
                        ::kwiver::protobuf::polygon&  proto_poly )
 {
   const auto vertices = poly.get_vertices();
+  proto_poly.mutable_point_list()->Reserve( static_cast< int >( vertices.size() ) );
   for ( auto const& vert : vertices )
   {
     auto* proto_item = proto_poly.add_point_list();
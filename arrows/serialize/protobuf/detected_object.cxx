@@ -6,6 +6,7 @@
 #include "detected_object.h"
 #include "bounding_box.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/detected_object.h>
 #include <vital/types/protobuf/detected_object.pb.h>
@@ -37,49 +38,44 @@ serialize( const vital::any& element )
   kwiver::vital::detected_object det_object =
     kwiver::vital::any_cast< kwiver::vital::detected_object > ( element );
 
-  std::ostringstream msg;
-  msg << "detected_object "; // add type tag
-
-  kwiver::protobuf::detected_object proto_det_object;
+  auto& proto_det_object = thread_message< kwiver::protobuf::detected_object >();
   convert_protobuf( det_object, proto_det_object );
 
-  if ( ! proto_det_object.SerializeToOstream( &msg ) )
+  if ( ! proto_det_object.IsInitialized() )
   {
     VITAL_THROW( kwiver::vital::serialization_exception,
                  "Error serializing detected_object from protobuf" );
   }
 
-  return std::make_shared< std::string > ( msg.str() );
+  auto msg = serialize_message( "detected_object", proto_det_object );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
 vital::any detected_object::
 deserialize( const std::string& message )
 {
-  std::istringstream msg( message );
   auto det_object_ptr = std::make_shared< kwiver::vital::detected_object >(
     kwiver::vital::bounding_box_d { 0, 0, 0, 0 } );
 
-  std::string tag;
-  msg >> tag;
-  msg.get();  // Eat delimiter
-
-  if (tag != "detected_object" )
+  if ( ! has_message_tag( "detected_object", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"detected_object\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::detected_object proto_det_object;
-    if ( ! proto_det_object.ParseFromIstream( &msg ) )
+    auto& proto_det_object = thread_message< kwiver::protobuf::detected_object >();
+    if ( ! parse_message( "detected_object", message, proto_det_object ) )
     {
       VITAL_THROW( kwiver::vital::serialization_exception,
                    "Error deserializing detected_object from protobuf" );
     }
 
     convert_protobuf( proto_det_object, *det_object_ptr );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any( det_object_ptr );
@@ -5,6 +5,7 @@
 #include "detected_object_set.h"
 #include "detected_object.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/detected_object_set.h>
 #include <vital/types/protobuf/detected_object_set.pb.h>
@@ -36,19 +37,18 @@ serialize( const vital::any& element )
   kwiver::vital::detected_object_set_sptr dos_sptr =
     kwiver::vital::any_cast< kwiver::vital::detected_object_set_sptr > ( element );
 
-  std::ostringstream msg;
-  msg << "detected_object_set "; // add type tag
-
-  kwiver::protobuf::detected_object_set proto_dos;
+  auto& proto_dos = thread_message< kwiver::protobuf::detected_object_set >();
   convert_protobuf( *dos_sptr, proto_dos );
 
-  if ( ! proto_dos.SerializeToOstream( &msg ) )
+  if ( ! proto_dos.IsInitialized() )
   {
     VITAL_THROW( kwiver::vital::serialization_exception,
                  "Error serializing detected_object_set from protobuf" );
   }
 
-  return std::make_shared< std::string > ( msg.str() );
+  auto msg = serialize_message( "detected_object_set", proto_dos );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -56,28 +56,24 @@ vital::any detected_object_set::
 deserialize( const std::string& message )
 {
   auto dos_sptr = std::make_shared< kwiver::vital::detected_object_set >();
-  std::istringstream msg( message );
-
-  std::string tag;
-  msg >> tag;
-  msg.get();  // Eat delimiter
 
-  if (tag != "detected_object_set" )
+  if ( ! has_message_tag( "detected_object_set", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"detected_object_set\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::detected_object_set proto_dos;
-    if ( ! proto_dos.ParseFromIstream( &msg ) )
+    auto& proto_dos = thread_message< kwiver::protobuf::detected_object_set >();
+    if ( ! parse_message( "detected_object_set", message, proto_dos ) )
     {
       VITAL_THROW( kwiver::vital::serialization_exception,
                    "Error deserializing detected_object_set from protobuf" );
     }
 
     convert_protobuf( proto_dos, *dos_sptr );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any(dos_sptr);
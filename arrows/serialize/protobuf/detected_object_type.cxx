@@ -4,6 +4,7 @@
 
 #include "detected_object_type.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/detected_object_type.h>
 #include <vital/types/protobuf/detected_object_type.pb.h>
@@ -35,18 +36,18 @@ serialize( const vital::any& element )
   kwiver::vital::detected_object_type dot =
     kwiver::vital::any_cast< kwiver::vital::detected_object_type > ( element );
 
-  std::ostringstream msg;
-  msg << "detected_object_type "; // add type tag
-
-  kwiver::protobuf::detected_object_type proto_dot;
+  auto& proto_dot = thread_message< kwiver::protobuf::detected_object_type >();
   convert_protobuf( dot, proto_dot );
 
-  if ( ! proto_dot.SerializeToOstream( &msg ) )
+  if ( ! proto_dot.IsInitialized() )
   {
     VITAL_THROW( kwiver::vital::serialization_exception,
                  "Error serializing detected_object_type from protobuf" );
   }
-  return std::make_shared< std::string > ( msg.str() );
+
+  auto msg = serialize_message( "detected_object_type", proto_dot );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -54,28 +55,24 @@ vital::any detected_object_type::
 deserialize( const std::string& message )
 {
   kwiver::vital::detected_object_type dot;
-  std::istringstream msg( message );
-
-  std::string tag;
-  msg >> tag;
-  msg.get();  // Eat delimiter
 
-  if (tag != "detected_object_type" )
+  if ( ! has_message_tag( "detected_object_type", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"detected_object_type\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::detected_object_type proto_dot;
-    if ( ! proto_dot.ParseFromIstream( &msg ) )
+    auto& proto_dot = thread_message< kwiver::protobuf::detected_object_type >();
+    if ( ! parse_message( "detected_object_type", message, proto_dot ) )
     {
       VITAL_THROW( kwiver::vital::serialization_exception,
                    "Error deserializing detected_type from protobuf" );
     }
 
     convert_protobuf( proto_dot, dot );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any(dot);
@@ -4,6 +4,7 @@
 
 #include "geo_polygon.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/geo_polygon.h>
 #include <vital/types/protobuf/geo_polygon.pb.h>
@@ -34,18 +35,17 @@ serialize( const vital::any& element )
   kwiver::vital::geo_polygon_d bbox =
     kwiver::vital::any_cast< kwiver::vital::geo_polygon_d > ( element );
 
-  std::ostringstream msg;
-  msg << "geo_polygon "; // add type tag
-
-  kwiver::protobuf::geo_polygon proto_bbox;
+  auto& proto_bbox = thread_message< kwiver::protobuf::geo_polygon >();
   convert_protobuf( bbox, proto_bbox );
 
-  if ( ! proto_bbox.SerializeToOstream( &msg ) )
+  if ( ! proto_bbox.IsInitialized() )
   {
     LOG_ERROR( logger(), "proto_bbox.SerializeToOStream failed" );
   }
 
-  return std::make_shared< std::string > ( msg.str() );
+  auto msg = serialize_message( "geo_polygon", proto_bbox );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -54,26 +54,23 @@ deserialize( const std::string& message )
 {
   kwiver::vital::geo_polygon_d bbox{ 0, 0, 0, 0 };
 
-  std::istringstream msg( message );
-  std::string tag;
-  msg >> tag;
-  msg.get();  // Eat the delimiter
 
-  if (tag != "geo_polygon" )
+  if ( ! has_message_tag( "geo_polygon", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"geo_polygon\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::geo_polygon proto_bbox;
-    if ( ! proto_bbox.ParseFromIstream( &msg ) )
+    auto& proto_bbox = thread_message< kwiver::protobuf::geo_polygon >();
+    if ( ! parse_message( "geo_polygon", message, proto_bbox ) )
     {
       LOG_ERROR( logger(), "Incoming protobuf stream did not parse correctly. ParseFromIstream failed." );
     }
 
     convert_protobuf( proto_bbox, bbox );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any(bbox);
@@ -4,6 +4,7 @@
 
 #include "image.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/image_container.h>
 #include <vital/types/protobuf/image.pb.h>
@@ -33,18 +34,18 @@ serialize( const vital::any& element )
   kwiver::vital::image_container_sptr img_sptr =
     kwiver::vital::any_cast< kwiver::vital::image_container_sptr > ( element );
 
-  std::ostringstream msg;
-  msg << "image ";   // add type tag
-  kwiver::protobuf::image proto_img;
+  auto& proto_img = thread_message< kwiver::protobuf::image >();
   convert_protobuf( img_sptr, proto_img );
 
-  if ( ! proto_img.SerializeToOstream( &msg ) )
+  if ( ! proto_img.IsInitialized() )
   {
     VITAL_THROW( kwiver::vital::serialization_exception,
                  "Error serializing detected_object_set from protobuf" );
   }
 
-  return std::make_shared< std::string > ( msg.str() );
+  auto msg = serialize_message( "image", proto_img );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -53,29 +54,25 @@ image::
 deserialize( const std::string& message )
 {
   kwiver::vital::image_container_sptr img_container_sptr;
-  std::istringstream msg( message );
 
-  std::string tag;
-  msg >> tag;
-  msg.get();    // Eat delimiter
-
-  if ( tag != "image" )
+  if ( ! has_message_tag( "image", message ) )
   {
     LOG_ERROR(
       logger(), "Invalid data type tag received. Expected \"image\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::image proto_img;
-    if ( ! proto_img.ParseFromIstream(&msg) )
+    auto& proto_img = thread_message< kwiver::protobuf::image >();
+    if ( ! parse_message( "image", message, proto_img ) )
     {
       VITAL_THROW(kwiver::vital::serialization_exception,
                   "Error deserializing image_container from protobuf");
     }
 
     convert_protobuf(proto_img, img_container_sptr);
+    trim_thread_arena();
   }
 
   return kwiver::vital::any( img_container_sptr );
@@ -4,6 +4,7 @@
 
 #include "metadata.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/metadata.h>
 #include <vital/types/protobuf/metadata.pb.h>
@@ -36,18 +37,17 @@ serialize( const vital::any& element )
   kwiver::vital::metadata_vector mvec =
     kwiver::vital::any_cast< kwiver::vital::metadata_vector > ( element );
 
-  std::ostringstream msg;
-  msg << "metadata "; // add type tag
-
-  kwiver::protobuf::metadata_vector proto_mvec;
+  auto& proto_mvec = thread_message< kwiver::protobuf::metadata_vector >();
   convert_protobuf( mvec, proto_mvec );
 
-  if ( ! proto_mvec.SerializeToOstream( &msg ) )
+  if ( ! proto_mvec.IsInitialized() )
   {
     LOG_ERROR( logger(), "proto_mvec.SerializeToOStream failed" );
   }
 
-  return std::make_shared< std::string > ( msg.str() );
+  auto msg = serialize_message( "metadata", proto_mvec );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -55,26 +55,23 @@ vital::any metadata::
 deserialize( const std::string& message )
 {
   kwiver::vital::metadata_vector mvec;
-  std::istringstream msg( message );
-  std::string tag;
-  msg >> tag;
-  msg.get();  // Eat the delimiter
 
-  if (tag != "metadata" )
+  if ( ! has_message_tag( "metadata", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"metadata\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::metadata_vector proto_mvec;
-    if ( ! proto_mvec.ParseFromIstream( &msg ) )
+    auto& proto_mvec = thread_message< kwiver::protobuf::metadata_vector >();
+    if ( ! parse_message( "metadata", message, proto_mvec ) )
     {
       LOG_ERROR( logger(), "Incoming protobuf stream did not parse correctly. ParseFromIstream failed." );
     }
 
     convert_protobuf( proto_mvec, mvec );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any(mvec);
@@ -4,6 +4,7 @@
 
 #include "object_track_set.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/object_track_set.h>
 #include <vital/types/protobuf/object_track_set.pb.h>
@@ -33,19 +34,18 @@ serialize( const vital::any& element )
   kwiver::vital::object_track_set_sptr obj_trk_set_sptr =
     kwiver::vital::any_cast< kwiver::vital::object_track_set_sptr > ( element );
 
-  std::ostringstream msg;
-  msg << "object_track_set "; // add type tag
-
-  kwiver::protobuf::object_track_set proto_obj_trk_set;
+  auto& proto_obj_trk_set = thread_message< kwiver::protobuf::object_track_set >();
   convert_protobuf( obj_trk_set_sptr, proto_obj_trk_set );
 
-  if ( ! proto_obj_trk_set.SerializeToOstream( &msg ) )
+  if ( ! proto_obj_trk_set.IsInitialized() )
   {
     VITAL_THROW( kwiver::vital::serialization_exception,
                  "Error serializing track from protobuf" );
   }
 
-  return std::make_shared< std::string > ( msg.str() );
+  auto msg = serialize_message( "object_track_set", proto_obj_trk_set );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -53,28 +53,24 @@ vital::any object_track_set::
 deserialize( const std::string& message )
 {
   auto obj_trk_set_sptr = std::make_shared< kwiver::vital::object_track_set >();
-  std::istringstream msg( message );
-
-  std::string tag;
-  msg >> tag;
-  msg.get();  // Eat delimiter
 
-  if (tag != "object_track_set" )
+  if ( ! has_message_tag( "object_track_set", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"object track set\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::object_track_set proto_obj_trk_set;
-    if ( ! proto_obj_trk_set.ParseFromIstream( &msg ) )
+    auto& proto_obj_trk_set = thread_message< kwiver::protobuf::object_track_set >();
+    if ( ! parse_message( "object_track_set", message, proto_obj_trk_set ) )
     {
       VITAL_THROW( kwiver::vital::serialization_exception,
                    "Error deserializing track from protobuf" );
     }
 
     convert_protobuf( proto_obj_trk_set, obj_trk_set_sptr );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any( obj_trk_set_sptr );
@@ -4,6 +4,7 @@
 
 #include "object_track_state.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include "vital/types/object_track_set.h"
 #include <vital/types/protobuf/object_track_state.pb.h>
@@ -34,47 +35,43 @@ namespace protobuf {
     kwiver::vital::object_track_state obj_trk_state =
       kwiver::vital::any_cast< kwiver::vital::object_track_state >( element );
 
-    std::ostringstream msg;
-    msg << "object_track_state "; // add type tag
-
-    kwiver::protobuf::object_track_state proto_obj_trk_state;
+    auto& proto_obj_trk_state = thread_message< kwiver::protobuf::object_track_state >();
     convert_protobuf( obj_trk_state, proto_obj_trk_state );
 
-    if ( ! proto_obj_trk_state.SerializeToOstream( &msg ) )
+    if ( ! proto_obj_trk_state.IsInitialized() )
     {
       VITAL_THROW( kwiver::vital::serialization_exception,
                    "Error serializing track state from protobuf" );
     }
 
-    return std::make_shared< std::string >( msg.str() );
+    auto msg = serialize_message( "object_track_state", proto_obj_trk_state );
+    trim_thread_arena();
+    return msg;
   }
 
   // --------------------------------------------------------------------------
   vital::any object_track_state::
   deserialize( const std::string& message )
   {
-    std::istringstream msg( message );
     kwiver::vital::object_track_state obj_trk_state;
-    std::string tag;
-    msg >> tag;
-    msg.get();  // Eat delimiter
 
-    if (tag != "object_track_state" )
+    if ( ! has_message_tag( "object_track_state", message ) )
     {
       LOG_ERROR( logger(), "Invalid data type tag received. Expected \"object_track_state\", received \""
-                 << tag << "\". Message dropped." );
+                 << message_tag( message ) << "\". Message dropped." );
     }
     else
     {
       // define our protobuf
-      kwiver::protobuf::object_track_state proto_obj_trk_state;
-      if ( ! proto_obj_trk_state.ParseFromIstream( &msg ) )
+      auto& proto_obj_trk_state = thread_message< kwiver::protobuf::object_track_state >();
+      if ( ! parse_message( "object_track_state", message, proto_obj_trk_state ) )
       {
         VITAL_THROW( kwiver::vital::serialization_exception,
                      "Error deserializing Object Track State from protobuf" );
       }
 
       convert_protobuf( proto_obj_trk_state,  obj_trk_state);
+      trim_thread_arena();
     }
 
     return kwiver::vital::any( obj_trk_state );
@@ -0,0 +1,168 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "serialize_message.h"
+
+#include <vital/exceptions.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+namespace kwiver {
+namespace arrows {
+namespace serialize {
+namespace protobuf {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+struct arena_state
+{
+  google::protobuf::Arena arena;
+  uint64_t generation = 1;
+};
+
+// ----------------------------------------------------------------------------
+arena_state&
+thread_arena_state()
+{
+  thread_local arena_state state;
+  return state;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+checked_byte_size( google::protobuf::MessageLite const& message )
+{
+  auto const size = message.ByteSizeLong();
+  if ( size > static_cast< size_t >( std::numeric_limits< int >::max() ) )
+  {
+    std::stringstream str;
+    str << "Error serializing " << message.GetTypeName()
+        << " to protobuf: message of " << size << " bytes is too large";
+    VITAL_THROW( kwiver::vital::serialization_exception, str.str() );
+  }
+  return size;
+}
+
+} // end namespace
+
+namespace detail {
+
+// ----------------------------------------------------------------------------
+google::protobuf::Arena&
+thread_arena( uint64_t& generation )
+{
+  auto& state = thread_arena_state();
+  generation = state.generation;
+  return state.arena;
+}
+
+} // end namespace detail
+
+// ----------------------------------------------------------------------------
+void
+trim_thread_arena( size_t max_bytes )
+{
+  auto& state = thread_arena_state();
+  if ( state.arena.SpaceAllocated() > max_bytes )
+  {
+    state.arena.Reset();
+    ++state.generation;
+  }
+}
+
+// ----------------------------------------------------------------------------
+size_t
+serialized_size( std::string const& tag,
+                 google::protobuf::MessageLite const& message )
+{
+  return tag.size() + 1 + checked_byte_size( message );
+}
+
+// ----------------------------------------------------------------------------
+size_t
+serialize_message( std::string const& tag,
+                   google::protobuf::MessageLite const& message,
+                   void* buffer, size_t size )
+{
+  // Computing the size caches the sizes of the sub-messages, which the write
+  // below relies on
+  auto const message_size = checked_byte_size( message );
+  auto const total_size = tag.size() + 1 + message_size;
+  if ( total_size > size )
+  {
+    std::stringstream str;
+    str << "Error serializing " << message.GetTypeName()
+        << " to protobuf: " << total_size
+        << " bytes do not fit in a buffer of " << size << " bytes";
+    VITAL_THROW( kwiver::vital::serialization_exception, str.str() );
+  }
+
+  auto* out = static_cast< uint8_t* >( buffer );
+  std::memcpy( out, tag.data(), tag.size() );
+  out[ tag.size() ] = ' ';
+  message.SerializeWithCachedSizesToArray( out + tag.size() + 1 );
+  return total_size;
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< std::string >
+serialize_message( std::string const& tag,
+                   google::protobuf::MessageLite const& message )
+{
+  auto const message_size = checked_byte_size( message );
+
+  auto result = std::make_shared< std::string >();
+  result->resize( tag.size() + 1 + message_size );
+
+  auto* out = reinterpret_cast< uint8_t* >( &( *result )[ 0 ] );
+  std::memcpy( out, tag.data(), tag.size() );
+  out[ tag.size() ] = ' ';
+  message.SerializeWithCachedSizesToArray( out + tag.size() + 1 );
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+bool
+has_message_tag( std::string const& tag, std::string const& data )
+{
+  return data.compare( 0, tag.size(), tag ) == 0 &&
+         ( data.size() == tag.size() ||
+           std::isspace( static_cast< unsigned char >( data[ tag.size() ] ) ) );
+}
+
+// ----------------------------------------------------------------------------
+std::string
+message_tag( std::string const& data )
+{
+  auto const begin = data.find_first_not_of( " \t\n\v\f\r" );
+  if ( begin == std::string::npos )
+  {
+    return {};
+  }
+  return data.substr( begin,
+                      data.find_first_of( " \t\n\v\f\r", begin ) - begin );
+}
+
+// ----------------------------------------------------------------------------
+bool
+parse_message( std::string const& tag, std::string const& data,
+               google::protobuf::MessageLite& message )
+{
+  // Skip the tag and its delimiter
+  auto const offset = std::min( tag.size() + 1, data.size() );
+  auto const size = data.size() - offset;
+  if ( size > static_cast< size_t >( std::numeric_limits< int >::max() ) )
+  {
+    return false;
+  }
+  return message.ParseFromArray( data.data() + offset,
+                                 static_cast< int >( size ) );
+}
+
+} } } }       // end namespace kwiver
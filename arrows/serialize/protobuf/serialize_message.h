@@ -0,0 +1,116 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Reusable protobuf messages and tagged message framing
+
+#ifndef ARROWS_SERIALIZATION_PROTOBUF_SERIALIZE_MESSAGE_H
+#define ARROWS_SERIALIZATION_PROTOBUF_SERIALIZE_MESSAGE_H
+
+#include <arrows/serialize/protobuf/kwiver_serialize_protobuf_export.h>
+
+#include <google/protobuf/arena.h>
+#include <google/protobuf/message_lite.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace kwiver {
+namespace arrows {
+namespace serialize {
+namespace protobuf {
+
+namespace detail {
+
+/// Arena owned by the calling thread and the number of times it was reset
+KWIVER_SERIALIZE_PROTOBUF_EXPORT
+google::protobuf::Arena& thread_arena( uint64_t& generation );
+
+} // end namespace detail
+
+// ----------------------------------------------------------------------------
+/// Get the message of type \p Message owned by the calling thread.
+///
+/// The message is allocated once per thread on the thread's arena and is
+/// cleared, not freed, from one call to the next, so that its sub-messages,
+/// repeated fields and strings keep their memory. The reference is valid
+/// until the next call for the same type or to \c trim_thread_arena() on the
+/// same thread.
+template < typename Message >
+Message&
+thread_message()
+{
+  thread_local Message* message = nullptr;
+  thread_local uint64_t message_generation = 0;
+
+  uint64_t generation;
+  auto& arena = detail::thread_arena( generation );
+  if ( message == nullptr || message_generation != generation )
+  {
+    message = google::protobuf::Arena::CreateMessage< Message >( &arena );
+    message_generation = generation;
+  }
+  else
+  {
+    message->Clear();
+  }
+  return *message;
+}
+
+/// Release the memory of the calling thread's arena if it has grown too large.
+///
+/// Fields such as maps do not reuse the memory of cleared entries, so the
+/// arena is reset, and every message obtained from \c thread_message() on
+/// this thread is discarded, once it holds more than \p max_bytes.
+KWIVER_SERIALIZE_PROTOBUF_EXPORT
+void trim_thread_arena( size_t max_bytes = 16 * 1024 * 1024 );
+
+// ----------------------------------------------------------------------------
+/// Number of bytes of \p message serialized after the type tag \p tag.
+KWIVER_SERIALIZE_PROTOBUF_EXPORT
+size_t serialized_size( std::string const& tag,
+                        google::protobuf::MessageLite const& message );
+
+/// Serialize \p message after the type tag \p tag into a caller's buffer.
+///
+/// The bytes written are "<tag> " followed by the message, which is the
+/// layout the serializers of this arrow read back.
+///
+/// \returns The number of bytes written.
+///
+/// \throws kwiver::vital::serialization_exception if the message does not
+///   fit in \p size bytes.
+KWIVER_SERIALIZE_PROTOBUF_EXPORT
+size_t serialize_message( std::string const& tag,
+                          google::protobuf::MessageLite const& message,
+                          void* buffer, size_t size );
+
+/// Serialize \p message after the type tag \p tag into a new string.
+///
+/// The string is allocated at its final size and written in place.
+KWIVER_SERIALIZE_PROTOBUF_EXPORT
+std::shared_ptr< std::string >
+serialize_message( std::string const& tag,
+                   google::protobuf::MessageLite const& message );
+
+/// Test whether \p data starts with the type tag \p tag.
+KWIVER_SERIALIZE_PROTOBUF_EXPORT
+bool has_message_tag( std::string const& tag, std::string const& data );
+
+/// Get the type tag at the start of \p data.
+KWIVER_SERIALIZE_PROTOBUF_EXPORT
+std::string message_tag( std::string const& data );
+
+/// Parse the bytes of \p data after the type tag \p tag into \p message.
+///
+/// \returns false if the bytes are not a valid message.
+KWIVER_SERIALIZE_PROTOBUF_EXPORT
+bool parse_message( std::string const& tag, std::string const& data,
+                    google::protobuf::MessageLite& message );
+
+} } } }       // end namespace kwiver
+
+#endif // ARROWS_SERIALIZATION_PROTOBUF_SERIALIZE_MESSAGE_H
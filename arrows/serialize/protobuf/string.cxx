@@ -5,6 +5,7 @@
 #include "string.h"
 
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/protobuf/string.pb.h>
 
@@ -28,41 +29,38 @@ std::shared_ptr< std::string > string::
 serialize( const vital::any& element )
 {
   const std::string data = kwiver::vital::any_cast< std::string >( element );
-  std::ostringstream msg;
-  msg << "string ";
-
-  kwiver::protobuf::string proto_string;
+  auto& proto_string = thread_message< kwiver::protobuf::string >();
   convert_protobuf( data, proto_string );
 
-  if ( ! proto_string.SerializeToOstream( &msg ) )
+  if ( ! proto_string.IsInitialized() )
   {
     LOG_ERROR( logger(), "proto_string.SerializeToOStream failed" );
   }
-  return std::make_shared< std::string > ( msg.str() );
+
+  auto msg = serialize_message( "string", proto_string );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
 vital::any string::deserialize( const std::string& message )
 {
   std::string data;
-  std::istringstream msg( message );
-  std::string tag;
-  msg >> tag;
-  msg.get();
 
-  if (tag != "string")
+  if ( ! has_message_tag( "string", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"string\", received \""
-            << tag << "\". Message dropped.");
+            << message_tag( message ) << "\". Message dropped.");
   }
   else
   {
-    kwiver::protobuf::string proto_str;
-    if ( !proto_str.ParseFromIstream( &msg ) )
+    auto& proto_str = thread_message< kwiver::protobuf::string >();
+    if ( ! parse_message( "string", message, proto_str ) )
     {
       LOG_ERROR( logger(), "Incoming protobuf stream did not parse correctly");
     }
     convert_protobuf( proto_str, data);
+    trim_thread_arena();
   }
   return kwiver::vital::any(data);
 }
@@ -22,6 +22,7 @@
 #include <arrows/serialize/protobuf/object_track_state.h>
 #include <arrows/serialize/protobuf/object_track_set.h>
 #include <arrows/serialize/protobuf/convert_protobuf.h>
+#include <arrows/serialize/protobuf/serialize_message.h>
 
 #include <vital/types/activity.h>
 #include <vital/types/activity_type.h>
@@ -33,6 +34,8 @@
 #include <vital/types/track.h>
 #include <vital/types/track_set.h>
 #include <vital/types/object_track_set.h>
+#include <vital/types/protobuf/detected_object_set.pb.h>
+#include <vital/exceptions.h>
 #include <vital/util/hex_dump.h>
 #include <vital/util/string.h>
 
@@ -817,3 +820,90 @@ TEST( serialize, object_track_set )
     }
   }
 }
+
+// ----------------------------------------------------------------------------
+TEST( serialize, reused_messages )
+{
+  kasp::detected_object_set obj_ser;
+
+  auto make_set = []( int count ){
+    auto dos_sptr = std::make_shared< kwiver::vital::detected_object_set >();
+    for ( int i = 0; i < count; ++i )
+    {
+      auto det_object_sptr = std::make_shared< kwiver::vital::detected_object >(
+        kwiver::vital::bounding_box_d{ 1.0 + i, 2.0 + i, 3.0 + i, 4.0 + i } );
+      det_object_sptr->add_note( "note " + std::to_string( i ) );
+      det_object_sptr->add_keypoint( "head", { 1.5 + i, 2.5 } );
+      dos_sptr->add( det_object_sptr );
+    }
+    return dos_sptr;
+  };
+
+  // Messages reused by the serializer must not keep the fields of the
+  // previous message
+  for ( int count : { 10, 3, 0, 5 } )
+  {
+    auto const ser_dos_sptr = make_set( count );
+    auto const mes = obj_ser.serialize( kwiver::vital::any( ser_dos_sptr ) );
+    auto const deser_dos_sptr =
+      kwiver::vital::any_cast< kwiver::vital::detected_object_set_sptr >(
+        obj_ser.deserialize( *mes ) );
+
+    ASSERT_EQ( count, deser_dos_sptr->size() );
+    for ( int i = 0; i < count; ++i )
+    {
+      auto const deser_do_sptr = deser_dos_sptr->at( i );
+      EXPECT_EQ( ser_dos_sptr->at( i )->bounding_box(),
+                 deser_do_sptr->bounding_box() );
+      ASSERT_EQ( 1, deser_do_sptr->notes().size() );
+      EXPECT_EQ( "note " + std::to_string( i ), deser_do_sptr->notes()[ 0 ] );
+      ASSERT_EQ( 1, deser_do_sptr->keypoints().size() );
+      EXPECT_EQ( 1.5 + i, deser_do_sptr->keypoints().at( "head" ).value()[ 0 ] );
+    }
+
+    // Resetting the arena discards the reused messages
+    kasp::trim_thread_arena( 0 );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST( serialize, message_buffer )
+{
+  kasp::detected_object_set obj_ser;
+
+  auto dos_sptr = std::make_shared< kwiver::vital::detected_object_set >();
+  dos_sptr->add( std::make_shared< kwiver::vital::detected_object >(
+    kwiver::vital::bounding_box_d{ 1, 2, 3, 4 }, 0.5 ) );
+
+  kwiver::protobuf::detected_object_set proto_dos;
+  kasp::convert_protobuf( *dos_sptr, proto_dos );
+
+  auto const mes = kasp::serialize_message( "detected_object_set", proto_dos );
+  auto const size = kasp::serialized_size( "detected_object_set", proto_dos );
+  ASSERT_EQ( size, mes->size() );
+  EXPECT_EQ( *obj_ser.serialize( kwiver::vital::any( dos_sptr ) ), *mes );
+
+  // The same bytes are written into a caller's buffer
+  std::vector< char > buffer( size + 8, 'x' );
+  EXPECT_EQ( size, kasp::serialize_message( "detected_object_set", proto_dos,
+                                            buffer.data(), buffer.size() ) );
+  EXPECT_EQ( *mes, std::string( buffer.data(), size ) );
+  EXPECT_EQ( 'x', buffer[ size ] );
+
+  EXPECT_THROW( kasp::serialize_message( "detected_object_set", proto_dos,
+                                         buffer.data(), size - 1 ),
+                kwiver::vital::serialization_exception );
+
+  // Messages written through a stream are still read back
+  std::string streamed = "detected_object_set ";
+  proto_dos.AppendToString( &streamed );
+  auto const deser_dos_sptr =
+    kwiver::vital::any_cast< kwiver::vital::detected_object_set_sptr >(
+      obj_ser.deserialize( streamed ) );
+  ASSERT_EQ( 1, deser_dos_sptr->size() );
+  EXPECT_EQ( dos_sptr->at( 0 )->bounding_box(),
+             deser_dos_sptr->at( 0 )->bounding_box() );
+
+  EXPECT_FALSE( kasp::has_message_tag( "detected_object", *mes ) );
+  EXPECT_EQ( "detected_object_set", kasp::message_tag( *mes ) );
+}
@@ -4,6 +4,7 @@
 
 #include "timestamp.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/timestamp.h>
 #include <vital/types/protobuf/timestamp.pb.h>
@@ -31,18 +32,18 @@ timestamp::
 serialize( const vital::any& element )
 {
   kwiver::vital::timestamp tstamp = kwiver::vital::any_cast< kwiver::vital::timestamp > ( element );
-  std::ostringstream msg;
-  msg << "timestamp ";
-  kwiver::protobuf::timestamp proto_tstamp;
+  auto& proto_tstamp = thread_message< kwiver::protobuf::timestamp >();
 
   convert_protobuf( tstamp, proto_tstamp );
 
-  if ( ! proto_tstamp.SerializeToOstream( &msg ) )
+  if ( ! proto_tstamp.IsInitialized() )
   {
     LOG_ERROR( logger(), "proto_timestamp.SerializeToOStream failed" );
   }
 
-  return std::make_shared< std::string > ( msg.str() );
+  auto msg = serialize_message( "timestamp", proto_tstamp );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -50,25 +51,22 @@ vital::any
 timestamp::deserialize( const std::string& message )
 {
   kwiver::vital::timestamp tstamp;
-  std::istringstream msg( message );
-  std::string tag;
-  msg >> tag;
-  msg.get();
-  if ( tag != "timestamp" )
+  if ( ! has_message_tag( "timestamp", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag receiver. Expected timestamp"
-               << "received " << tag << ". Message dropped." );
+               << "received " << message_tag( message ) << ". Message dropped." );
   }
   else
   {
-    kwiver::protobuf::timestamp proto_tstamp;
-    if ( ! proto_tstamp.ParseFromIstream( &msg ) )
+    auto& proto_tstamp = thread_message< kwiver::protobuf::timestamp >();
+    if ( ! parse_message( "timestamp", message, proto_tstamp ) )
     {
       LOG_ERROR( logger(), "Incoming protobuf stream did not parse correctly."
                  << "ParseFromIstream failed." );
     }
 
     convert_protobuf( proto_tstamp, tstamp );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any( tstamp );
@@ -4,6 +4,7 @@
 
 #include "track.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/track.h>
 #include <vital/types/protobuf/track.pb.h>
@@ -33,19 +34,18 @@ serialize( const vital::any& element )
   kwiver::vital::track_sptr trk_sptr =
     kwiver::vital::any_cast< kwiver::vital::track_sptr > ( element );
 
-  std::ostringstream msg;
-  msg << "track "; // add type tag
-
-  kwiver::protobuf::track proto_trk;
+  auto& proto_trk = thread_message< kwiver::protobuf::track >();
   convert_protobuf( trk_sptr, proto_trk );
 
-  if ( ! proto_trk.SerializeToOstream( &msg ) )
+  if ( ! proto_trk.IsInitialized() )
   {
     VITAL_THROW( kwiver::vital::serialization_exception,
                  "Error serializing track from protobuf" );
   }
 
-  return std::make_shared< std::string > ( msg.str() );
+  auto msg = serialize_message( "track", proto_trk );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -53,28 +53,24 @@ vital::any track::
 deserialize( const std::string& message )
 {
   auto trk_sptr = kwiver::vital::track::create();
-  std::istringstream msg( message );
-
-  std::string tag;
-  msg >> tag;
-  msg.get();  // Eat delimiter
 
-  if (tag != "track" )
+  if ( ! has_message_tag( "track", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"track\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::track proto_trk;
-    if ( ! proto_trk.ParseFromIstream( &msg ) )
+    auto& proto_trk = thread_message< kwiver::protobuf::track >();
+    if ( ! parse_message( "track", message, proto_trk ) )
     {
       VITAL_THROW( kwiver::vital::serialization_exception,
                    "Error deserializing track from protobuf" );
     }
 
     convert_protobuf( proto_trk, trk_sptr );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any( trk_sptr );
@@ -4,6 +4,7 @@
 
 #include "track_set.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include <vital/types/track_set.h>
 #include <vital/types/protobuf/track_set.pb.h>
@@ -33,19 +34,18 @@ serialize( const vital::any& element )
   kwiver::vital::track_set_sptr trk_set_sptr =
     kwiver::vital::any_cast< kwiver::vital::track_set_sptr > ( element );
 
-  std::ostringstream msg;
-  msg << "track_set "; // add type tag
-
-  kwiver::protobuf::track_set proto_trk_set;
+  auto& proto_trk_set = thread_message< kwiver::protobuf::track_set >();
   convert_protobuf( trk_set_sptr, proto_trk_set );
 
-  if ( ! proto_trk_set.SerializeToOstream( &msg ) )
+  if ( ! proto_trk_set.IsInitialized() )
   {
     VITAL_THROW( kwiver::vital::serialization_exception,
                  "Error serializing track from protobuf" );
   }
 
-  return std::make_shared< std::string > ( msg.str() );
+  auto msg = serialize_message( "track_set", proto_trk_set );
+  trim_thread_arena();
+  return msg;
 }
 
 // ----------------------------------------------------------------------------
@@ -53,28 +53,24 @@ vital::any track_set::
 deserialize( const std::string& message )
 {
   auto trk_set_sptr = std::make_shared< kwiver::vital::track_set >();
-  std::istringstream msg( message );
-
-  std::string tag;
-  msg >> tag;
-  msg.get();  // Eat delimiter
 
-  if (tag != "track_set" )
+  if ( ! has_message_tag( "track_set", message ) )
   {
     LOG_ERROR( logger(), "Invalid data type tag received. Expected \"track\", received \""
-               << tag << "\". Message dropped." );
+               << message_tag( message ) << "\". Message dropped." );
   }
   else
   {
     // define our protobuf
-    kwiver::protobuf::track_set proto_trk_set;
-    if ( ! proto_trk_set.ParseFromIstream( &msg ) )
+    auto& proto_trk_set = thread_message< kwiver::protobuf::track_set >();
+    if ( ! parse_message( "track_set", message, proto_trk_set ) )
     {
       VITAL_THROW( kwiver::vital::serialization_exception,
                    "Error deserializing track from protobuf" );
     }
 
     convert_protobuf( proto_trk_set, trk_set_sptr );
+    trim_thread_arena();
   }
 
   return kwiver::vital::any( trk_set_sptr );
@@ -4,6 +4,7 @@
 
 #include "track_state.h"
 #include "convert_protobuf.h"
+#include "serialize_message.h"
 
 #include "vital/types/track.h"
 #include <vital/types/protobuf/track_state.pb.h>
@@ -34,47 +35,43 @@ namespace protobuf {
     kwiver::vital::track_state trk_state =
       kwiver::vital::any_cast< kwiver::vital::track_state > ( element );
 
-    std::ostringstream msg;
-    msg << "track_state "; // add type tag
-
-    kwiver::protobuf::track_state proto_trk_state;
+    auto& proto_trk_state = thread_message< kwiver::protobuf::track_state >();
     convert_protobuf( trk_state, proto_trk_state );
 
-    if ( ! proto_trk_state.SerializeToOstream( &msg ) )
+    if ( ! proto_trk_state.IsInitialized() )
     {
       VITAL_THROW( kwiver::vital::serialization_exception,
                    "Error serializing track state from protobuf" );
     }
 
-    return std::make_shared< std::string > ( msg.str() );
+    auto msg = serialize_message( "track_state", proto_trk_state );
+    trim_thread_arena();
+    return msg;
   }
 
   // --------------------------------------------------------------------------
   vital::any track_state::
   deserialize( const std::string& message )
   {
-    std::istringstream msg( message );
     kwiver::vital::track_state trk_state( 0 );
-    std::string tag;
-    msg >> tag;
-    msg.get();  // Eat delimiter
 
-    if (tag != "track_state" )
+    if ( ! has_message_tag( "track_state", message ) )
     {
       LOG_ERROR( logger(), "Invalid data type tag received. Expected \"track_state\", received \""
-                 << tag << "\". Message dropped." );
+                 << message_tag( message ) << "\". Message dropped." );
     }
     else
     {
       // define our protobuf
-      kwiver::protobuf::track_state proto_trk_state;
-      if ( ! proto_trk_state.ParseFromIstream( &msg ) )
+      auto& proto_trk_state = thread_message< kwiver::protobuf::track_state >();
+      if ( ! parse_message( "track_state", message, proto_trk_state ) )
       {
         VITAL_THROW( kwiver::vital::serialization_exception,
                      "Error deserializing Track State from protobuf" );
       }
 
       convert_protobuf( proto_trk_state,  trk_state );
+      trim_thread_arena();
     }
 
     return kwiver::vital::any( trk_state );
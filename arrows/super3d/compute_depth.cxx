@@ -16,6 +16,7 @@
 #include <vil/vil_math.h>
 #include <vil/vil_plane.h>
 #include <vital/types/bounding_box.h>
+#include <vital/util/thread_pool.h>
 #include <vital/vital_config.h>
 
 #include <sstream>
@@ -207,25 +208,28 @@ compute_uncertainty(vil_image_view<double> const& height_map,
   // This scale is 1/(2*sigma) converted from [0,255] to [0,1]
   const double cost_scale = 255.0 / (2.0 * 5.0);
 
-#pragma omp parallel for
-  for (int64_t j = 0; j < cost_volume.nj(); j++)
+  vital::thread_pool::instance().parallel_for(cost_volume.nj(), 1,
+    [&](size_t begin, size_t end)
   {
-    for (unsigned int i = 0; i < cost_volume.ni(); i++)
+    for (int64_t j = begin; j < static_cast<int64_t>(end); j++)
     {
-      double const& dij = height_map(i, j);
-      double sum_w = 0.0;
-      double var = 0.0;
-      for (unsigned int k = 0; k < cost_volume.nplanes(); k++)
+      for (unsigned int i = 0; i < cost_volume.ni(); i++)
       {
-        const double d_k = (static_cast<double>(k) + 0.5) / S;
-        const double diff = d_k - dij;
-        const double w = std::exp(-cost_volume(i, j, k) * cost_scale);
-        sum_w += w;
-        var += w * diff * diff;
+        double const& dij = height_map(i, j);
+        double sum_w = 0.0;
+        double var = 0.0;
+        for (unsigned int k = 0; k < cost_volume.nplanes(); k++)
+        {
+          const double d_k = (static_cast<double>(k) + 0.5) / S;
+          const double diff = d_k - dij;
+          const double w = std::exp(-cost_volume(i, j, k) * cost_scale);
+          sum_w += w;
+          var += w * diff * diff;
+        }
+        uncertainty(i, j) = std::sqrt(var / sum_w);
       }
-      uncertainty(i, j) = std::sqrt(var / sum_w);
     }
-  }
+  });
   return uncertainty;
 }
 
@@ -245,14 +249,17 @@ ::compute(std::vector<kwiver::vital::image_container_sptr> const& frames_in,
 
   //convert frames
   std::vector<vil_image_view<double> > frames(frames_in.size());
-#pragma omp parallel for schedule(static, 1)
-  for (int i = 0; i < static_cast< int >(frames.size()); i++)
+  vital::thread_pool::instance().parallel_for(frames.size(), 1,
+    [&](size_t begin, size_t end)
   {
-    vil_image_view<vxl_byte> img =
-      vxl::image_container::vital_to_vxl(frames_in[i]->get_image());
-    vil_convert_planes_to_grey(img, frames[i]);
-    vil_math_scale_values(frames[i], 1.0 / 255.0);
-  }
+    for (size_t i = begin; i < end; i++)
+    {
+      vil_image_view<vxl_byte> img =
+        vxl::image_container::vital_to_vxl(frames_in[i]->get_image());
+      vil_convert_planes_to_grey(img, frames[i]);
+      vil_math_scale_values(frames[i], 1.0 / 255.0);
+    }
+  });
 
   d_->depth_min = depth_min;
   d_->depth_max = depth_max;
@@ -263,35 +270,38 @@ ::compute(std::vector<kwiver::vital::image_container_sptr> const& frames_in,
   if (!masks_in.empty())
   {
     masks.resize(masks_in.size());
-#pragma omp parallel for schedule(static, 1)
-    for (int i = 0; i < static_cast< int >(masks.size()); i++)
+    vital::thread_pool::instance().parallel_for(masks.size(), 1,
+      [&](size_t begin, size_t end)
     {
-      if (!masks_in[i])
-      {
-        continue;
-      }
-      auto vxl_mask = vxl::image_container::vital_to_vxl(masks_in[i]->get_image());
-      if (!vxl_mask)
-      {
-        continue;
-      }
-      if (vxl_mask->pixel_format() == VIL_PIXEL_FORMAT_BOOL)
-      {
-        masks[i] = vxl_mask;
-      }
-      else if (vxl_mask->pixel_format() == VIL_PIXEL_FORMAT_BYTE)
+      for (size_t i = begin; i < end; i++)
       {
-        vil_threshold_above<vxl_byte>(vxl_mask, masks[i], 128);
+        if (!masks_in[i])
+        {
+          continue;
+        }
+        auto vxl_mask = vxl::image_container::vital_to_vxl(masks_in[i]->get_image());
+        if (!vxl_mask)
+        {
+          continue;
+        }
+        if (vxl_mask->pixel_format() == VIL_PIXEL_FORMAT_BOOL)
+        {
+          masks[i] = vxl_mask;
+        }
+        else if (vxl_mask->pixel_format() == VIL_PIXEL_FORMAT_BYTE)
+        {
+          vil_threshold_above<vxl_byte>(vxl_mask, masks[i], 128);
+        }
+        else
+        {
+          // unsupported pixel format
+          continue;
+        }
+        // ensure that this is a single channel image
+        // take only the first channel
+        masks[i] = vil_plane(masks[i], 0);
       }
-      else
-      {
-        // unsupported pixel format
-        continue;
-      }
-      // ensure that this is a single channel image
-      // take only the first channel
-      masks[i] = vil_plane(masks[i], 0);
-    }
+    });
     ref_mask = &masks[ref_frame];
   }
 
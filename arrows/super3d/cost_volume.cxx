@@ -22,6 +22,7 @@
 #include <limits>
 
 #include <vital/logger/logger.h>
+#include <vital/util/thread_pool.h>
 #include <vital/vital_config.h>
 
 namespace kwiver {
@@ -98,36 +99,42 @@ compute_world_cost_volume(const std::vector<vil_image_view<double> > &frames,
         ws->warp_image_to_depth(masks[f], warp_mask, warp_cams[f], s, f, false);
       }
 
-#pragma omp parallel for
-      for (int64_t j = 0; j < warp_ref.nj(); j++)
+      vital::thread_pool::instance().parallel_for(warp_ref.nj(), 1,
+        [&](size_t begin, size_t end)
       {
-        for (unsigned int i = 0; i < warp_ref.ni(); i++)
+        for (int64_t j = begin; j < static_cast<int64_t>(end); j++)
         {
-          if (warp(i,j) == -1 ||
-              (!masks.empty() && (warp_ref_mask(i,j) || warp_mask(i,j))))
-            continue;
-
-          cost_volume(i, j, k) += fabs(warp_ref(i, j) - warp(i, j));
-          counts(i,j) += 1;
+          for (unsigned int i = 0; i < warp_ref.ni(); i++)
+          {
+            if (warp(i,j) == -1 ||
+                (!masks.empty() && (warp_ref_mask(i,j) || warp_mask(i,j))))
+              continue;
+
+            cost_volume(i, j, k) += fabs(warp_ref(i, j) - warp(i, j));
+            counts(i,j) += 1;
+          }
         }
-      }
+      });
     }
 
   //Normalize by counts
-    #pragma omp parallel for
-    for (int64_t j = 0; j < warp_ref.nj(); j++)
+    vital::thread_pool::instance().parallel_for(warp_ref.nj(), 1,
+      [&](size_t begin, size_t end)
     {
-      for (unsigned int i = 0; i < warp_ref.ni(); i++)
+      for (int64_t j = begin; j < static_cast<int64_t>(end); j++)
       {
-        if (!masks.empty() && warp_ref_mask(i, j))
-          continue;
+        for (unsigned int i = 0; i < warp_ref.ni(); i++)
+        {
+          if (!masks.empty() && warp_ref_mask(i, j))
+            continue;
 
-        if (counts(i, j) == 0)
-          cost_volume(i, j, k) = std::numeric_limits<double>::infinity();
-        else
-          cost_volume(i, j, k) /= (double)counts(i,j);
+          if (counts(i, j) == 0)
+            cost_volume(i, j, k) = std::numeric_limits<double>::infinity();
+          else
+            cost_volume(i, j, k) /= (double)counts(i,j);
+        }
       }
-    }
+    });
   }
   return true;
 }
@@ -0,0 +1,156 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include <test_gtest.h>
+
+#include <arrows/super3d/warp_image.h>
+
+#include <vil/vil_image_view.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace kas = kwiver::arrows::super3d;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char** argv )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+vil_image_view< float >
+random_image( unsigned ni, unsigned nj, unsigned np )
+{
+  std::mt19937 rng( 42 );
+  std::uniform_real_distribution< float > dist( 0.0f, 1.0f );
+  vil_image_view< float > img( ni, nj, np );
+  for( unsigned p = 0; p < np; ++p )
+  {
+    for( unsigned j = 0; j < nj; ++j )
+    {
+      for( unsigned i = 0; i < ni; ++i )
+      {
+        img( i, j, p ) = dist( rng );
+      }
+    }
+  }
+  return img;
+}
+
+// ----------------------------------------------------------------------------
+// A perspective homography like those induced by the planes of a sweep
+vgl_h_matrix_2d< double >
+test_homography()
+{
+  vnl_matrix_fixed< double, 3, 3 > M;
+  M( 0, 0 ) = 0.93;   M( 0, 1 ) = 0.08;   M( 0, 2 ) = 12.5;
+  M( 1, 0 ) = -0.05;  M( 1, 1 ) = 1.04;   M( 1, 2 ) = -7.25;
+  M( 2, 0 ) = 1.2e-4; M( 2, 1 ) = -6e-5;  M( 2, 2 ) = 1.0;
+  return vgl_h_matrix_2d< double >( M );
+}
+
+} // end anonymous namespace
+
+// ----------------------------------------------------------------------------
+TEST ( warp_image, vectorized_matches_scalar )
+{
+  auto const src = random_image( 203, 151, 3 );
+  auto const H = test_homography();
+
+  for( int offset : { 0, 9 } )
+  {
+    auto params = kas::warp_image_parameters().set_offset( offset, -offset );
+
+    // use a width which is not a multiple of the block size
+    vil_image_view< float > expected( 197, 143, 3 ), actual( 197, 143, 3 );
+    vil_image_view< bool > expected_mask( 197, 143 ), actual_mask( 197, 143 );
+    ASSERT_TRUE( kas::warp_image( src, expected, H,
+                                  params.set_vectorized( false ),
+                                  &expected_mask ) );
+    ASSERT_TRUE( kas::warp_image( src, actual, H,
+                                  params.set_vectorized( true ),
+                                  &actual_mask ) );
+
+    // pixels exactly on the source boundary may round either way in float
+    unsigned mask_mismatches = 0;
+    unsigned mapped = 0;
+    for( unsigned j = 0; j < expected.nj(); ++j )
+    {
+      for( unsigned i = 0; i < expected.ni(); ++i )
+      {
+        if( expected_mask( i, j ) != actual_mask( i, j ) )
+        {
+          ++mask_mismatches;
+          continue;
+        }
+        if( expected_mask( i, j ) )
+        {
+          for( unsigned p = 0; p < 3; ++p )
+          {
+            EXPECT_EQ( 0.0f, actual( i, j, p ) );
+          }
+          continue;
+        }
+        ++mapped;
+        for( unsigned p = 0; p < 3; ++p )
+        {
+          EXPECT_NEAR( expected( i, j, p ), actual( i, j, p ), 1e-4 )
+            << "at pixel " << i << ", " << j << ", " << p;
+        }
+      }
+    }
+    EXPECT_GT( mapped, expected.ni() * expected.nj() / 2 );
+    EXPECT_LE( mask_mismatches, expected.ni() + expected.nj() );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST ( warp_image, tiny_source )
+{
+  // sources too small to interpolate use the generic path
+  vil_image_view< float > src( 1, 1 ), dest( 4, 4 );
+  src( 0, 0 ) = 0.5f;
+  vnl_matrix_fixed< double, 3, 3 > M;
+  M.set_identity();
+  M( 0, 2 ) = 0.5;
+  EXPECT_FALSE( kas::warp_image_bilinear_float( src, dest, M, 0, 0,
+                                                0, 4, 0, 4, nullptr ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( warp_image, benchmark )
+{
+  constexpr unsigned repetitions = 10;
+  auto const src = random_image( 1280, 720, 1 );
+  auto const H = test_homography();
+  vil_image_view< float > dest( 1280, 720 );
+  vil_image_view< bool > mask( 1280, 720 );
+
+  auto time_warps = [ & ]( bool vectorized ){
+    auto const params =
+      kas::warp_image_parameters().set_vectorized( vectorized );
+    auto const start = std::chrono::steady_clock::now();
+    for( unsigned r = 0; r < repetitions; ++r )
+    {
+      kas::warp_image( src, dest, H, params, &mask );
+    }
+    std::chrono::duration< double > const elapsed =
+      std::chrono::steady_clock::now() - start;
+    return src.size() * repetitions / elapsed.count();
+  };
+
+  auto const scalar_rate = time_warps( false );
+  auto const vectorized_rate = time_warps( true );
+  std::cout << "scalar:     " << scalar_rate * 1e-6 << " Mpixel/s\n"
+            << "vectorized: " << vectorized_rate * 1e-6 << " Mpixel/s\n";
+  EXPECT_GT( vectorized_rate, 0.0 );
+}
@@ -21,6 +21,7 @@
 #include <vnl/vnl_double_2.h>
 
 #include <vital/logger/logger.h>
+#include <vital/util/thread_pool.h>
 
 namespace kwiver {
 namespace arrows {
@@ -118,45 +119,51 @@ void huber(vil_image_view<double> &q,
 {
   unsigned int ni = d.ni() - 1, nj = d.nj() - 1;
   double stepsilon1 = 1.0 + step*epsilon;
-#pragma omp parallel for
-  for (int64_t j = 0; j < nj; j++)
+  vital::thread_pool::instance().parallel_for(nj, 1,
+    [&](size_t begin, size_t end)
   {
-    for (unsigned int i = 0; i < ni; i++)
+    for (int64_t j = begin; j < static_cast<int64_t>(end); j++)
     {
-      double &x = q(i,j,0), &y = q(i,j,1);
-      double dij = d(i,j);
-      x = (x + step * g(i,j) * (d(i+1,j) - dij))/stepsilon1;
-      y = (y + step * g(i,j) * (d(i,j+1) - dij))/stepsilon1;
-
-      //truncate vectors
-      double mag = x*x + y*y;
-      if (mag > 1.0f)
+      for (unsigned int i = 0; i < ni; i++)
       {
-        mag = sqrt(mag);
-        x /= mag;
-        y /= mag;
+        double &x = q(i,j,0), &y = q(i,j,1);
+        double dij = d(i,j);
+        x = (x + step * g(i,j) * (d(i+1,j) - dij))/stepsilon1;
+        y = (y + step * g(i,j) * (d(i,j+1) - dij))/stepsilon1;
+
+        //truncate vectors
+        double mag = x*x + y*y;
+        if (mag > 1.0f)
+        {
+          mag = sqrt(mag);
+          x /= mag;
+          y /= mag;
+        }
       }
     }
-  }
+  });
 
   q(ni,nj,0) = q(ni-1,nj,0);
   q(ni,nj,1) = q(ni,nj-1,1);
 
   double theta_inv = 1.0 / theta, denom = (1.0 + (step / theta));
-#pragma omp parallel for
-  for (int64_t j = 0; j < d.nj(); j++)
+  vital::thread_pool::instance().parallel_for(d.nj(), 1,
+    [&](size_t begin, size_t end)
   {
-    for (unsigned int i = 0; i < d.ni(); i++)
+    for (int64_t j = begin; j < static_cast<int64_t>(end); j++)
     {
-      //add scaled divergence
-      double divx = q(i,j,0), divy = q(i,j,1);
-      if (i > 0)  divx -=  q(i-1,j,0);
-      if (j > 0)  divy -=  q(i,j-1,1);
+      for (unsigned int i = 0; i < d.ni(); i++)
+      {
+        //add scaled divergence
+        double divx = q(i,j,0), divy = q(i,j,1);
+        if (i > 0)  divx -=  q(i-1,j,0);
+        if (j > 0)  divy -=  q(i,j-1,1);
 
-      double &dij = d(i,j);
-      dij = (dij + step * (g(i,j) * (divx + divy) + theta_inv * a(i,j)))/denom;
+        double &dij = d(i,j);
+        dij = (dij + step * (g(i,j) * (divx + divy) + theta_inv * a(i,j)))/denom;
+      }
     }
-  }
+  });
 }
 
 //*****************************************************************************
@@ -198,69 +205,72 @@ min_search_bound(vil_image_view<double> &a,
   const std::ptrdiff_t jstep_c = cost_volume.jstep();
   const std::ptrdiff_t pstep_c = cost_volume.planestep();
 
-#pragma omp parallel for
-  for (int64_t j = 0; j < d.nj(); j++)
+  vital::thread_pool::instance().parallel_for(d.nj(), 1,
+    [&](size_t begin, size_t end)
   {
-    const double* row_c = cost_volume.top_left_ptr();
-    row_c += (j * jstep_c);
-
-    const double* col_c = row_c;
-    for (unsigned int i = 0; i < d.ni(); i++, col_c += istep_c)
+    for (int64_t j = begin; j < static_cast<int64_t>(end); j++)
     {
-      const double sqrt_range = sqrt_cost_range(i, j);
-      if (!std::isfinite(sqrt_range))
-      {
-        a(i, j) = d(i, j);
-        continue;
-      }
-      const int r = std::min(last_plane,
-                             std::max(0, static_cast<int>(S * range_coeff
-                                                            * sqrt_range)));
-      const double dij = d(i, j) * S - 0.5;
-      const int init_k = std::min(last_plane, std::max(0, static_cast<int>(dij)));
-
-      // compute the search range and clip between 0 and S-1
-      // note that when dij is outside the volume range [0,1] this
-      // range needs to be shifted to the closest edge of the volume
-      // for example if dij < 0 then search in [0, r] and
-      // if dij > 1 search in [S-1-r, 1]
-      const int min_k = std::max(0, init_k - r);
-      const int max_k = std::min(last_plane, init_k + r);
-
-      int bestk = init_k;
-      const double diff = dij - bestk;
-      double best_e = coeff*diff*diff + *(col_c + bestk);
-      const double* cost = col_c + min_k;
-      for (int k = min_k; k <= max_k; ++k, cost += pstep_c)
+      const double* row_c = cost_volume.top_left_ptr();
+      row_c += (j * jstep_c);
+
+      const double* col_c = row_c;
+      for (unsigned int i = 0; i < d.ni(); i++, col_c += istep_c)
       {
-        if (k == init_k || *cost < 0.0 || *cost > best_e)
+        const double sqrt_range = sqrt_cost_range(i, j);
+        if (!std::isfinite(sqrt_range))
         {
+          a(i, j) = d(i, j);
           continue;
         }
-        const double dd = dij - k;
-        const double e = coeff * dd * dd + (*cost);
-        if (e < best_e)
+        const int r = std::min(last_plane,
+                               std::max(0, static_cast<int>(S * range_coeff
+                                                              * sqrt_range)));
+        const double dij = d(i, j) * S - 0.5;
+        const int init_k = std::min(last_plane, std::max(0, static_cast<int>(dij)));
+
+        // compute the search range and clip between 0 and S-1
+        // note that when dij is outside the volume range [0,1] this
+        // range needs to be shifted to the closest edge of the volume
+        // for example if dij < 0 then search in [0, r] and
+        // if dij > 1 search in [S-1-r, 1]
+        const int min_k = std::max(0, init_k - r);
+        const int max_k = std::min(last_plane, init_k + r);
+
+        int bestk = init_k;
+        const double diff = dij - bestk;
+        double best_e = coeff*diff*diff + *(col_c + bestk);
+        const double* cost = col_c + min_k;
+        for (int k = min_k; k <= max_k; ++k, cost += pstep_c)
         {
-          best_e = e;
-          bestk = k;
+          if (k == init_k || *cost < 0.0 || *cost > best_e)
+          {
+            continue;
+          }
+          const double dd = dij - k;
+          const double e = coeff * dd * dd + (*cost);
+          if (e < best_e)
+          {
+            best_e = e;
+            bestk = k;
+          }
+        }
+        // fit a parabola to estimate the subsample offset for the best k
+        if (bestk > 0 && bestk < S - 1)
+        {
+          cost = col_c + bestk;
+          const double diff2 = 2 * coeff * (dij - static_cast<double>(bestk));
+          const double ym1 = *(cost - pstep_c) + diff2 + coeff;
+          const double yp1 = *(cost + pstep_c) - diff2 + coeff;
+          const double offset = interp_offset(ym1, *cost, yp1);
+          a(i, j) = (static_cast<double>(bestk) + offset + 0.5) * a_step;
+        }
+        else
+        {
+          a(i, j) = (static_cast<double>(bestk) + 0.5) * a_step;
         }
-      }
-      // fit a parabola to estimate the subsample offset for the best k
-      if (bestk > 0 && bestk < S - 1)
-      {
-        cost = col_c + bestk;
-        const double diff2 = 2 * coeff * (dij - static_cast<double>(bestk));
-        const double ym1 = *(cost - pstep_c) + diff2 + coeff;
-        const double yp1 = *(cost + pstep_c) - diff2 + coeff;
-        const double offset = interp_offset(ym1, *cost, yp1);
-        a(i, j) = (static_cast<double>(bestk) + offset + 0.5) * a_step;
-      }
-      else
-      {
-        a(i, j) = (static_cast<double>(bestk) + 0.5) * a_step;
       }
     }
-  }
+  });
 }
 
 //*****************************************************************************
@@ -8,6 +8,8 @@
 #define KWIVER_ARROWS_SUPER3D_WARP_IMAGE_H_
 
 /// \file
+#include <arrows/super3d/kwiver_algo_super3d_export.h>
+
 #include <vgl/algo/vgl_h_matrix_2d.h>
 
 template<class T>
@@ -31,7 +33,8 @@ struct warp_image_parameters
       fill_unmapped_( true ),
       unmapped_value_( 0.0 ),
       interpolator_( LINEAR ),
-      shallow_copy_okay_( false )
+      shallow_copy_okay_( false ),
+      vectorized_( true )
   {
   }
 
@@ -88,18 +91,32 @@ struct warp_image_parameters
     return *this;
   }
 
+  /// Use a vectorized kernel when one exists for the pixel type?
+  ///
+  /// If this parameter is true (default), bilinear warps of float images
+  /// use warp_image_bilinear_float(), which evaluates the homography in
+  /// single precision for blocks of pixels along each scanline.  Otherwise
+  /// every pixel is mapped in double precision.
+  warp_image_parameters& set_vectorized( bool v )
+  {
+    vectorized_ = v;
+    return *this;
+  }
+
   int off_i_;
   int off_j_;
   bool fill_unmapped_;
   double unmapped_value_;
   interp_type interpolator_;
   bool shallow_copy_okay_;
+  bool vectorized_;
 };
 
 /// Warp an image using a homography.
 ///
 /// The destination image \a dest should already be allocated.
 template<class T>
+KWIVER_ALGO_SUPER3D_EXPORT
 bool
 warp_image( vil_image_view<T> const& src,
             vil_image_view<T>& dest,
@@ -110,6 +127,7 @@ warp_image( vil_image_view<T> const& src,
 ///
 /// See warp_image_parameters::set_offset() for the meaning of off_i and off_j.
 template<class T>
+KWIVER_ALGO_SUPER3D_EXPORT
 bool
 warp_image( vil_image_view<T> const& src,
             vil_image_view<T>& dest,
@@ -121,6 +139,7 @@ warp_image( vil_image_view<T> const& src,
 ///
 /// \sa warp_image_parameters
 template<class T>
+KWIVER_ALGO_SUPER3D_EXPORT
 bool
 warp_image( vil_image_view<T> const& src,
             vil_image_view<T>& dest,
@@ -128,6 +147,28 @@ warp_image( vil_image_view<T> const& src,
             warp_image_parameters const& param,
             vil_image_view< bool > * const unmapped_mask = NULL );
 
+/// Bilinearly warp a region of a float image using a homography.
+///
+/// This is the vectorized kernel used by warp_image() for float images.  It
+/// fills the destination pixels (i,j) with \a start_i <= i < \a end_i and
+/// \a start_j <= j < \a end_j whose offset coordinates map inside the
+/// source, and clears the corresponding entries of \a unmapped_mask.
+/// Pixels are processed in blocks of eight along each scanline.  The
+/// homography is evaluated in double precision at the start of each block
+/// and incrementally in single precision within it.
+///
+/// \returns false, touching nothing, if the source is smaller than 2x2 or
+///          too large to index with int
+KWIVER_ALGO_SUPER3D_EXPORT
+bool
+warp_image_bilinear_float( vil_image_view<float> const& src,
+                           vil_image_view<float>& dest,
+                           vnl_matrix_fixed<double,3,3> const& dest_to_src,
+                           int off_i, int off_j,
+                           int start_i, int end_i,
+                           int start_j, int end_j,
+                           vil_image_view< bool > * const unmapped_mask );
+
 } // end namespace depth
 } // end namespace arrows
 } // end namespace kwiver
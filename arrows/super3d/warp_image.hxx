@@ -106,6 +106,33 @@ bicubic_interp_wrapper(double x,
   return safe_cast<T>(vil_bicub_interp_raw(x, y, data, xstep, ystep));
 }
 
+//Pixel types without a vectorized kernel always use the generic loop
+template <class T>
+bool
+warp_region_vectorized(vil_image_view<T> const&,
+                       vil_image_view<T>&,
+                       vnl_matrix_fixed<double,3,3> const&,
+                       int, int, int, int, int, int,
+                       vil_image_view<bool> * const)
+{
+  return false;
+}
+
+inline
+bool
+warp_region_vectorized(vil_image_view<float> const& src,
+                       vil_image_view<float>& dest,
+                       vnl_matrix_fixed<double,3,3> const& dest_to_src,
+                       int off_i, int off_j,
+                       int start_i, int end_i,
+                       int start_j, int end_j,
+                       vil_image_view<bool> * const unmapped_mask_ptr)
+{
+  return warp_image_bilinear_float(src, dest, dest_to_src, off_i, off_j,
+                                   start_i, end_i, start_j, end_j,
+                                   unmapped_mask_ptr);
+}
+
 template<class T>
 bool
 warp_image( vil_image_view<T> const& src,
@@ -275,6 +302,16 @@ warp_image( vil_image_view<T> const& src,
   const int end_j_adj = end_j + param.off_j_;
   const int end_i_adj = end_i + param.off_i_;
 
+  if( param.interpolator_ == warp_image_parameters::LINEAR &&
+      param.vectorized_ &&
+      warp_region_vectorized( src, dest, dest_to_src_homography.get_matrix(),
+                              param.off_i_, param.off_j_,
+                              start_i, end_i, start_j, end_j,
+                              unmapped_mask_ptr ) )
+  {
+    return true;
+  }
+
   // Get pointers to image data and retrieve required step values
   T* row_start = dest.top_left_ptr();
   const T* src_start = src.top_left_ptr();
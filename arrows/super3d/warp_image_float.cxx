@@ -0,0 +1,161 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+ /// \file
+ /// \brief Source file for the vectorized float kernel of warp_image
+
+#include "warp_image.h"
+
+#include <vil/vil_image_view.h>
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+
+namespace kwiver {
+namespace arrows {
+namespace super3d {
+
+namespace {
+
+// Number of pixels warped together along a scanline.  The per block loops
+// have a fixed trip count and no branches so the compiler can vectorize them.
+constexpr int block_size = 8;
+
+}
+
+bool
+warp_image_bilinear_float( vil_image_view<float> const& src,
+                           vil_image_view<float>& dest,
+                           vnl_matrix_fixed<double,3,3> const& H,
+                           int off_i, int off_j,
+                           int start_i, int end_i,
+                           int start_j, int end_j,
+                           vil_image_view< bool > * const unmapped_mask_ptr )
+{
+  int const sni = static_cast<int>(src.ni());
+  int const snj = static_cast<int>(src.nj());
+  if( sni < 2 || snj < 2 )
+  {
+    return false;
+  }
+
+  // Block offsets into a source plane are computed in int, which is
+  // narrow enough to vectorize along with the float coordinates
+  const std::ptrdiff_t src_i_step = src.istep();
+  const std::ptrdiff_t src_j_step = src.jstep();
+  if( (sni - 1) * std::abs(src_i_step) + (snj - 1) * std::abs(src_j_step) >
+      std::numeric_limits<int>::max() )
+  {
+    return false;
+  }
+  int const offset_i_step = static_cast<int>(src_i_step);
+  int const offset_j_step = static_cast<int>(src_j_step);
+
+  unsigned const np = src.nplanes();
+  float const max_x = static_cast<float>(sni - 1);
+  float const max_y = static_cast<float>(snj - 1);
+
+  const float* src_start = src.top_left_ptr();
+  const std::ptrdiff_t src_p_step = src.planestep();
+  const std::ptrdiff_t dest_i_step = dest.istep();
+  const std::ptrdiff_t dest_j_step = dest.jstep();
+  const std::ptrdiff_t dest_p_step = dest.planestep();
+
+  // Homography increments from the first pixel of a block to each lane
+  float lane_x[block_size], lane_y[block_size], lane_w[block_size];
+  for( int l = 0; l < block_size; ++l )
+  {
+    lane_x[l] = static_cast<float>(l * H(0,0));
+    lane_y[l] = static_cast<float>(l * H(1,0));
+    lane_w[l] = static_cast<float>(l * H(2,0));
+  }
+
+  vital::thread_pool::instance().parallel_for(
+    static_cast<size_t>(std::max(0, end_j - start_j)), 1,
+    [&](size_t begin, size_t end)
+  {
+    for( int j = start_j + static_cast<int>(begin); j < start_j + static_cast<int>(end); ++j )
+    {
+      float* dest_row = dest.top_left_ptr() + j * dest_j_step;
+      double const dj = static_cast<double>(j + off_j);
+      double const row_x = H(0,1) * dj + H(0,2);
+      double const row_y = H(1,1) * dj + H(1,2);
+      double const row_w = H(2,1) * dj + H(2,2);
+
+      for( int i0 = start_i; i0 < end_i; i0 += block_size )
+      {
+        int const n = std::min(block_size, end_i - i0);
+
+        // Evaluate the homography at the first pixel of the block in double
+        // precision so that rounding error does not accumulate along the row
+        double const di = static_cast<double>(i0 + off_i);
+        float const base_x = static_cast<float>(H(0,0) * di + row_x);
+        float const base_y = static_cast<float>(H(1,0) * di + row_y);
+        float const base_w = static_cast<float>(H(2,0) * di + row_w);
+
+        int inside[block_size];
+        int offset[block_size];
+        float frac_x[block_size], frac_y[block_size];
+        for( int l = 0; l < block_size; ++l )
+        {
+          float const w = base_w + lane_w[l];
+          float const x = (base_x + lane_x[l]) / w;
+          float const y = (base_y + lane_y[l]) / w;
+          inside[l] = (x >= 0.0f) & (y >= 0.0f) & (x <= max_x) & (y <= max_y);
+
+          // Clamp so that unmapped lanes still address valid source pixels;
+          // the argument order also maps NaN to zero
+          float const cx = std::min(max_x, std::max(0.0f, x));
+          float const cy = std::min(max_y, std::max(0.0f, y));
+          int const ix = std::min(static_cast<int>(cx), sni - 2);
+          int const iy = std::min(static_cast<int>(cy), snj - 2);
+          frac_x[l] = cx - static_cast<float>(ix);
+          frac_y[l] = cy - static_cast<float>(iy);
+          offset[l] = ix * offset_i_step + iy * offset_j_step;
+        }
+
+        // For each channel interpolate from src, reusing the weights
+        const float* src_plane = src_start;
+        float* dest_block = dest_row + i0 * dest_i_step;
+        for( unsigned p = 0; p < np;
+             ++p, src_plane += src_p_step, dest_block += dest_p_step )
+        {
+          for( int l = 0; l < n; ++l )
+          {
+            if( inside[l] )
+            {
+              const float* s = src_plane + offset[l];
+              float const top = s[0] + frac_x[l] * (s[src_i_step] - s[0]);
+              float const bottom =
+                s[src_j_step] +
+                frac_x[l] * (s[src_j_step + src_i_step] - s[src_j_step]);
+              dest_block[l * dest_i_step] = top + frac_y[l] * (bottom - top);
+            }
+          }
+        }
+
+        // If using an optional mask, mark corresp. values
+        if( unmapped_mask_ptr )
+        {
+          for( int l = 0; l < n; ++l )
+          {
+            if( inside[l] )
+            {
+              (*unmapped_mask_ptr)(i0 + l, j) = false;
+            }
+          }
+        }
+      }
+    }
+  });
+
+  return true;
+}
+
+} // end namespace super3d
+} // end namespace arrows
+} // end namespace kwiver
@@ -93,6 +93,11 @@ template void world_space::warp_image_to_depth(const vil_image_view<double> &in,
                                                const vpgl_perspective_camera<double> &cam,
                                                double depth_slice, int f, double fill);
 
+template void world_space::warp_image_to_depth(const vil_image_view<float> &in,
+                                               vil_image_view<float> &out,
+                                               const vpgl_perspective_camera<double> &cam,
+                                               double depth_slice, int f, float fill);
+
 template void world_space::warp_image_to_depth(const vil_image_view<vxl_byte> &in,
                                                vil_image_view<vxl_byte> &out,
                                                const vpgl_perspective_camera<double> &cam,
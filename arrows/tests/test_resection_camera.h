@@ -217,3 +217,49 @@ TEST ( resection_camera, noisy_points_with_config )
         );
     }, camera_map );
 }
+
+// ----------------------------------------------------------------------------
+// Test camera resection of many frames at once with ideal points
+TEST ( resection_camera, many_frames )
+{
+  // Landmarks at random locations
+  auto landmarks = kwiver::testing::init_landmarks( 128 );
+  landmarks = kwiver::testing::noisy_landmarks( landmarks, 1.0 );
+
+  // Camera sequence (elliptical path)
+  auto camera_map = kwiver::testing::camera_seq();
+
+  // Tracks from projections
+  auto tracks = projected_tracks( landmarks, camera_map );
+
+  auto frame_ids = std::vector< frame_id_t >{};
+  for( auto const& camera_iter : camera_map->cameras() )
+  {
+    frame_ids.push_back( camera_iter.first );
+  }
+
+  resection_camera algo;
+  auto const intrinsics =
+    dynamic_pointer_cast< camera_perspective >(
+      camera_map->cameras().begin()->second )->intrinsics();
+  auto inliers = std::map< frame_id_t, std::unordered_set< landmark_id_t > >{};
+  auto const estimated_cameras =
+    algo.resection( frame_ids, landmarks, tracks, intrinsics, &inliers );
+
+  ASSERT_EQ( frame_ids.size(), estimated_cameras.size() );
+  test_resection_cameras(
+    [ & ]( frame_id_t test_frame, camera_perspective_sptr const& camera ) {
+      auto const estimated_camera =
+        dynamic_pointer_cast< camera_perspective >(
+          estimated_cameras.at( test_frame ) );
+      ASSERT_NE( nullptr, estimated_camera );
+
+      auto rotation_error =
+        camera->rotation().inverse() * estimated_camera->rotation();
+      EXPECT_LT( rotation_error.angle(), ideal_rotation_tolerance );
+      EXPECT_MATRIX_SIMILAR( camera->center(), estimated_camera->center(),
+                             ideal_center_tolerance );
+      EXPECT_EQ( landmarks->size(), inliers[ test_frame ].size() ) <<
+        "all points should be inliers";
+    }, camera_map );
+}
@@ -0,0 +1,222 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+// Common benchmark of decoding, seeking and metadata extraction for
+// implementations of the video_input interface
+
+#ifndef ARROWS_TESTS_TEST_VIDEO_INPUT_BENCHMARK_H
+#define ARROWS_TESTS_TEST_VIDEO_INPUT_BENCHMARK_H
+
+#include <vital/algo/video_input.h>
+#include <vital/types/image_container.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Number of seeks timed in each of the sequential and random seek passes
+constexpr size_t benchmark_num_seeks = 20;
+
+// ----------------------------------------------------------------------------
+// Parse the "--min-fps=<frames/s>" argument, returning 0 if absent. Rates
+// depend on the machine, so benchmarks only fail below a floor given by the
+// build configuration.
+double
+benchmark_min_fps( int argc, char* argv[] )
+{
+  std::string const flag = "--min-fps=";
+  for( int i = 1; i < argc; ++i )
+  {
+    std::string const arg = argv[ i ];
+    if( !arg.compare( 0, flag.size(), flag ) )
+    {
+      return std::stod( arg.substr( flag.size() ) );
+    }
+  }
+  return 0.0;
+}
+
+// ----------------------------------------------------------------------------
+// Peak resident set size of this process in kilobytes, or zero if unknown
+double
+benchmark_peak_memory_kb()
+{
+#ifndef _WIN32
+  rusage usage;
+  if( getrusage( RUSAGE_SELF, &usage ) == 0 )
+  {
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024.0;
+#else
+    return static_cast< double >( usage.ru_maxrss );
+#endif
+  }
+#endif
+  return 0.0;
+}
+
+// ----------------------------------------------------------------------------
+// Measurements of one video_input configuration on one video
+struct video_benchmark_result
+{
+  size_t frames = 0;
+  size_t metadata = 0;
+  double decode_fps = 0.0;
+  double metadata_rate = 0.0;
+  double image_kb_per_frame = 0.0;
+  double memory_growth_kb_per_frame = 0.0;
+  double sequential_seek_ms = 0.0;
+  double random_seek_ms = 0.0;
+  double random_seek_max_ms = 0.0;
+};
+
+// ----------------------------------------------------------------------------
+// Time a seek to each of the given frames, returning the mean and maximum in
+// milliseconds
+std::pair< double, double >
+benchmark_seeks( kwiver::vital::algo::video_input& input,
+                 std::vector< kwiver::vital::frame_id_t > const& frames )
+{
+  using clock_t = std::chrono::steady_clock;
+
+  double total = 0.0;
+  double max = 0.0;
+  for( auto const frame : frames )
+  {
+    kwiver::vital::timestamp ts;
+    auto const start = clock_t::now();
+    EXPECT_TRUE( input.seek_frame( ts, frame ) ) << "Seek to frame " << frame;
+    input.frame_image();
+    auto const ms =
+      std::chrono::duration< double, std::milli >( clock_t::now() - start )
+      .count();
+    EXPECT_EQ( frame, ts.get_frame() );
+    total += ms;
+    max = std::max( max, ms );
+  }
+  return { frames.empty() ? 0.0 : total / frames.size(), max };
+}
+
+// ----------------------------------------------------------------------------
+// Read every frame of a video, with its image and metadata, then time
+// sequential and random seeks if the input is seekable
+video_benchmark_result
+benchmark_video_input( kwiver::vital::algo::video_input& input,
+                       std::string const& filename )
+{
+  using clock_t = std::chrono::steady_clock;
+
+  video_benchmark_result result;
+
+  input.open( filename );
+  auto const start_memory = benchmark_peak_memory_kb();
+  auto const start = clock_t::now();
+
+  size_t image_bytes = 0;
+  kwiver::vital::timestamp ts;
+  while( input.next_frame( ts ) )
+  {
+    ++result.frames;
+    if( auto const image = input.frame_image() )
+    {
+      image_bytes += image->size();
+    }
+    result.metadata += input.frame_metadata().size();
+  }
+
+  auto const seconds =
+    std::chrono::duration< double >( clock_t::now() - start ).count();
+  auto const frames = static_cast< double >( std::max( result.frames,
+                                                       size_t{ 1 } ) );
+  result.decode_fps = result.frames / seconds;
+  result.metadata_rate = result.metadata / seconds;
+  result.image_kb_per_frame = image_bytes / 1024.0 / frames;
+  result.memory_growth_kb_per_frame =
+    ( benchmark_peak_memory_kb() - start_memory ) / frames;
+
+  if( input.seekable() && result.frames > 1 )
+  {
+    auto const last = static_cast< kwiver::vital::frame_id_t >(
+      result.frames );
+
+    std::vector< kwiver::vital::frame_id_t > sequential;
+    auto const step = std::max< kwiver::vital::frame_id_t >(
+      1, last / static_cast< kwiver::vital::frame_id_t >(
+        benchmark_num_seeks ) );
+    for( kwiver::vital::frame_id_t frame = 1; frame <= last; frame += step )
+    {
+      sequential.push_back( frame );
+    }
+
+    std::mt19937 rng{ 5489u };
+    std::uniform_int_distribution< kwiver::vital::frame_id_t > any( 1, last );
+    std::vector< kwiver::vital::frame_id_t > random;
+    for( size_t i = 0; i < benchmark_num_seeks; ++i )
+    {
+      random.push_back( any( rng ) );
+    }
+
+    result.sequential_seek_ms = benchmark_seeks( input, sequential ).first;
+    auto const random_seeks = benchmark_seeks( input, random );
+    result.random_seek_ms = random_seeks.first;
+    result.random_seek_max_ms = random_seeks.second;
+  }
+
+  input.close();
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+// Print a result and record it as properties of the current test, so that
+// --gtest_output=json or xml gives a machine-readable report. Fails if the
+// decode rate is below \p min_fps, when it is positive.
+void
+report_video_benchmark( video_benchmark_result const& result,
+                        double min_fps )
+{
+  auto const record =
+    []( char const* key, double value ){
+      std::ostringstream s;
+      s << std::fixed << std::setprecision( 3 ) << value;
+      ::testing::Test::RecordProperty( key, s.str() );
+    };
+  record( "frames", static_cast< double >( result.frames ) );
+  record( "decode_fps", result.decode_fps );
+  record( "metadata_per_second", result.metadata_rate );
+  record( "image_kb_per_frame", result.image_kb_per_frame );
+  record( "memory_growth_kb_per_frame", result.memory_growth_kb_per_frame );
+  record( "sequential_seek_ms", result.sequential_seek_ms );
+  record( "random_seek_ms", result.random_seek_ms );
+  record( "random_seek_max_ms", result.random_seek_max_ms );
+
+  auto const info =
+    ::testing::UnitTest::GetInstance()->current_test_info();
+  std::cout << std::fixed << std::setprecision( 1 )
+            << info->test_case_name() << "." << info->name() << ": "
+            << result.frames << " frames at " << result.decode_fps
+            << " fps, " << result.metadata_rate << " metadata/s, "
+            << result.image_kb_per_frame << " kB image/frame, "
+            << result.memory_growth_kb_per_frame << " kB growth/frame; seek "
+            << result.sequential_seek_ms << " ms sequential, "
+            << result.random_seek_ms << " ms random (max "
+            << result.random_seek_max_ms << ")\n";
+
+  EXPECT_LT( 0u, result.frames );
+  if( min_fps > 0.0 )
+  {
+    EXPECT_LE( min_fps, result.decode_fps );
+  }
+}
+
+#endif
@@ -4,6 +4,8 @@
 
 #include "descriptor_set.h"
 
+#include <vital/types/packed_descriptor_set.h>
+
 #include <viscl/core/manager.h>
 
 namespace kwiver {
@@ -15,25 +17,18 @@ std::vector<vital::descriptor_sptr>
 descriptor_set
 ::descriptors() const
 {
-  using namespace arrows;
-  std::vector<vital::descriptor_sptr> desc;
-
-  cl_int4 *buf = new cl_int4[data_.len()];
-
-  viscl::cl_queue_t queue = viscl::manager::inst()->create_queue();
-  queue->enqueueReadBuffer(*data_().get(), CL_TRUE, 0, data_.mem_size(), buf);
-  queue->finish();
-
-  for (unsigned int i = 0; i < data_.len(); i++)
+  // Read the descriptors into one packed buffer which they all refer to
+  std::vector<int> buf(data_.len() * 4);
+  if( buf.empty() )
   {
-    vital::descriptor_fixed<int,4> *d = new vital::descriptor_fixed<int,4>;
-    memcpy(d->raw_data(), &buf[i].s, sizeof(int)*4);
-    desc.push_back(vital::descriptor_sptr(d));
+    return std::vector<vital::descriptor_sptr>();
   }
 
-  delete [] buf;
+  viscl::cl_queue_t queue = viscl::manager::inst()->create_queue();
+  queue->enqueueReadBuffer(*data_().get(), CL_TRUE, 0, data_.mem_size(), buf.data());
+  queue->finish();
 
-  return desc;
+  return vital::packed_descriptor_set<int>(std::move(buf), 4).descriptors();
 }
 
 /// Convert a descriptor set to a VisCL descriptor set must be <int,4>
@@ -46,6 +41,26 @@ descriptors_to_viscl(const vital::descriptor_set& desc_set)
     return m_viscl->viscl_descriptors();
   }
 
+  //packed <int,4> descriptors are uploaded straight from their buffer
+  if( const vital::packed_descriptor_set<int>* packed =
+          dynamic_cast<const vital::packed_descriptor_set<int>*>(&desc_set) )
+  {
+    if( packed->empty() )
+    {
+      return viscl::buffer();
+    }
+    if( packed->dimension() != 4 || packed->stride() != 4 )
+    {
+      //TODO: throw exception
+      return viscl::buffer();
+    }
+    viscl::buffer buf = viscl::manager::inst()->create_buffer<cl_int4>(CL_MEM_READ_WRITE, packed->size());
+    viscl::cl_queue_t queue = viscl::manager::inst()->create_queue();
+    queue->enqueueWriteBuffer(*buf().get(), CL_TRUE, 0, buf.mem_size(), packed->raw_data());
+    queue->finish();
+    return buf;
+  }
+
   //viscl cannot take an arbitrary descriptor so this function
   //only checks for <int,4> descriptors
   std::vector<cl_int4> viscl_descr;
@@ -53,11 +68,12 @@ descriptors_to_viscl(const vital::descriptor_set& desc_set)
   for (unsigned int i = 0; i < descriptors.size(); i++)
   {
     //check if type is <int,4> if not we are done
-    if ( const vital::descriptor_fixed<int,4> * dfixed =
-          dynamic_cast<const vital::descriptor_fixed<int,4> *>(descriptors[i].get()) )
+    const vital::descriptor_array_of<int> * darray =
+      dynamic_cast<const vital::descriptor_array_of<int> *>(descriptors[i].get());
+    if ( darray && darray->size() == 4 )
     {
       cl_int4 d;
-      memcpy(&d.s, dfixed->raw_data(), sizeof(int)*4);
+      memcpy(&d.s, darray->raw_data(), sizeof(int)*4);
       viscl_descr.push_back(d);
     }
     else
@@ -82,7 +82,7 @@ ::detect(vital::image_container_sptr image_data, vital::image_container_sptr mas
 {
   // TODO: Do something with the given mask
 
-  viscl::image img = vcl::image_container_to_viscl(*image_data);
+  viscl::image img = vcl::image_container_to_viscl(image_data);
   vcl::feature_set::type feature_data;
 
   d_->detector.smooth_and_detect(img, feature_data.kptmap_, feature_data.features_, feature_data.numfeat_,
@@ -51,7 +51,7 @@ ::extract(vital::image_container_sptr image_data,
     return vital::descriptor_set_sptr();
   }
 
-  viscl::image img = vcl::image_container_to_viscl(*image_data);
+  viscl::image img = vcl::image_container_to_viscl(image_data);
   vcl::feature_set::type fs = vcl::features_to_viscl(*features);
   viscl::buffer descriptors;
   d_->brief.compute_descriptors(img, fs.features_, features->size(), descriptors);
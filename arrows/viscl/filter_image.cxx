@@ -0,0 +1,103 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "filter_image.h"
+
+#include <arrows/viscl/image_container.h>
+#include <arrows/viscl/image_filters.h>
+
+#include <cmath>
+
+namespace kwiver {
+namespace arrows {
+namespace vcl {
+
+/// Private implementation class
+class filter_image::priv
+{
+public:
+  /// Constructor
+  priv() : sigma(0.0f), scale(1.0)
+  {
+  }
+
+  float sigma;
+  double scale;
+};
+
+/// Constructor
+filter_image
+::filter_image()
+: d_(new priv)
+{
+}
+
+/// Destructor
+filter_image
+::~filter_image()
+{
+}
+
+/// Get this algorithm's \link vital::config_block configuration block \endlink
+vital::config_block_sptr
+filter_image
+::get_configuration() const
+{
+  vital::config_block_sptr config = algorithm::get_configuration();
+  config->set_value("sigma", d_->sigma,
+                    "Standard deviation in pixels of the Gaussian smoothing, "
+                    "applied after resizing. 0 disables smoothing.");
+  config->set_value("scale", d_->scale,
+                    "Factor by which to resize the image. 1 keeps the "
+                    "input size.");
+  return config;
+}
+
+/// Set this algorithm's properties via a config block
+void
+filter_image
+::set_configuration(vital::config_block_sptr config)
+{
+  d_->sigma = config->get_value<float>("sigma", d_->sigma);
+  d_->scale = config->get_value<double>("scale", d_->scale);
+}
+
+/// Check that the algorithm's configuration vital::config_block is valid
+bool
+filter_image
+::check_configuration(vital::config_block_sptr config) const
+{
+  return config->get_value<float>("sigma", d_->sigma) >= 0.0f &&
+         config->get_value<double>("scale", d_->scale) > 0.0;
+}
+
+/// Filter an image, leaving the result on the GPU
+vital::image_container_sptr
+filter_image
+::filter(vital::image_container_sptr image_data)
+{
+  if( !image_data )
+  {
+    return vital::image_container_sptr();
+  }
+
+  viscl::image img = vcl::image_container_to_viscl(image_data);
+
+  if( d_->scale != 1.0 )
+  {
+    size_t const width =
+      static_cast<size_t>(std::lround(img.width() * d_->scale));
+    size_t const height =
+      static_cast<size_t>(std::lround(img.height() * d_->scale));
+    img = vcl::resize_image(img, width, height);
+  }
+
+  img = vcl::smooth_image(img, d_->sigma);
+
+  return std::make_shared<vcl::image_container>(img);
+}
+
+} // end namespace vcl
+} // end namespace arrows
+} // end namespace kwiver
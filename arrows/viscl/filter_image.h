@@ -0,0 +1,57 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_ARROWS_VISCL_FILTER_IMAGE_H_
+#define KWIVER_ARROWS_VISCL_FILTER_IMAGE_H_
+
+#include <arrows/viscl/kwiver_algo_viscl_export.h>
+
+#include <vital/algo/image_filter.h>
+
+namespace kwiver {
+namespace arrows {
+namespace vcl {
+
+/// Grey conversion, resizing and Gaussian smoothing on the GPU
+///
+///  The image is uploaded, converted to grey if it has three channels,
+///  resized and then smoothed, and is returned as a vcl::image_container so
+///  that following VisCL algorithms use it without another upload.
+class KWIVER_ALGO_VISCL_EXPORT filter_image
+  : public vital::algo::image_filter
+{
+public:
+  /// Constructor
+  filter_image();
+
+  /// Destructor
+  virtual ~filter_image();
+
+  /// Get this algorithm's \link kwiver::vital::config_block configuration block \endlink
+  virtual vital::config_block_sptr get_configuration() const;
+
+  /// Set this algorithm's properties via a config block
+  virtual void set_configuration(vital::config_block_sptr config);
+
+  /// Check that the algorithm's configuration vital::config_block is valid
+  virtual bool check_configuration(vital::config_block_sptr config) const;
+
+  /// Filter an image, leaving the result on the GPU
+  ///
+  ///  \param image_data the image to filter
+  ///  \returns a vcl::image_container holding the filtered grey image
+  virtual vital::image_container_sptr
+  filter(vital::image_container_sptr image_data);
+
+private:
+  /// private implementation class
+  class priv;
+  const std::unique_ptr<priv> d_;
+};
+
+} // end namespace vcl
+} // end namespace arrows
+} // end namespace kwiver
+
+#endif
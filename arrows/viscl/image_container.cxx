@@ -4,6 +4,8 @@
 
 #include "image_container.h"
 
+#include <arrows/viscl/image_filters.h>
+
 #include <vil/vil_image_view.h>
 #include <vil/vil_save.h>
 
@@ -14,6 +16,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include <memory>
+#include <mutex>
 
 namespace kwiver {
 namespace arrows {
@@ -82,29 +85,8 @@ ::vital_to_viscl(const vital::image& img)
 
   if (img.depth() == 3)
   {
-    //Convert color image to a grey scale image and upload it.
-    unsigned char *grey = new unsigned char [img.width() * img.height()];
-    for (unsigned int j = 0; j < img.height(); j++)
-    {
-      for (unsigned int i = 0; i < img.width(); i++)
-      {
-        double value = 0.2125 * img(i,j,0) + 0.7154 * img(i,j,1) + 0.0721 * img(i,j,2);
-        grey[j * img.width() + i] = static_cast<unsigned char>(value);
-      }
-    }
-
-    viscl::image image = viscl::image(boost::make_shared<cl::Image2D>(
-                                        viscl::manager::inst()->get_context(),
-                                        CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-                                        img_fmt,
-                                        img.width(),
-                                        img.height(),
-                                        0,
-                                        grey));
-
-    delete [] grey;
-
-    return image;
+    // Upload the color image and convert it to grey scale on the GPU
+    return rgb_to_grey(img);
   }
 
   //TODO: Throw exception
@@ -123,6 +105,37 @@ image_container_to_viscl(const vital::image_container& img)
   return image_container::vital_to_viscl(img.get_image());
 }
 
+/// Extract a VisCL image from any image container, reusing the last upload
+viscl::image
+image_container_to_viscl(const vital::image_container_sptr& img)
+{
+  if( !img || dynamic_cast<const image_container*>(img.get()) )
+  {
+    return img ? image_container_to_viscl(*img) : viscl::image();
+  }
+
+  // The source is held weakly, so an expired entry can never match a new
+  // container allocated at the same address
+  static std::mutex mutex;
+  static std::weak_ptr<vital::image_container> last_source;
+  static viscl::image last_upload;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if( last_source.lock() == img )
+    {
+      return last_upload;
+    }
+  }
+
+  viscl::image upload = image_container::vital_to_viscl(img->get_image());
+
+  std::lock_guard<std::mutex> lock(mutex);
+  last_source = img;
+  last_upload = upload;
+  return upload;
+}
+
 } // end namespace vcl
 } // end namespace arrows
 } // end namespace kwiver
@@ -79,6 +79,15 @@ class KWIVER_ALGO_VISCL_EXPORT image_container
 /// and upload to the GPU.
 KWIVER_ALGO_VISCL_EXPORT viscl::image image_container_to_viscl(const vital::image_container& img);
 
+/// Extract a VisCL image from any image container, reusing the last upload
+///
+/// As above, but the most recently uploaded image is kept on the GPU and
+/// returned again while \a img is the same container, so that consecutive
+/// VisCL algorithms given the same image, such as feature detection and
+/// descriptor extraction, upload it once.  Image containers must not be
+/// modified once shared, as everywhere else in vital.
+KWIVER_ALGO_VISCL_EXPORT viscl::image image_container_to_viscl(const vital::image_container_sptr& img);
+
 } // end namespace vcl
 } // end namespace arrows
 } // end namespace kwiver
@@ -0,0 +1,274 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "image_filters.h"
+
+#include <vital/exceptions/algorithm.h>
+#include <vital/exceptions/image.h>
+
+#include <viscl/core/manager.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace kwiver {
+namespace arrows {
+namespace vcl {
+
+namespace {
+
+// Images are single channel, as everywhere else in VisCL.  Samplers use
+// pixel coordinates; linear samples are taken at pixel centers.
+char const* const filter_source = R"(
+__constant sampler_t nearest = CLK_NORMALIZED_COORDS_FALSE |
+                               CLK_ADDRESS_CLAMP_TO_EDGE |
+                               CLK_FILTER_NEAREST;
+__constant sampler_t linear = CLK_NORMALIZED_COORDS_FALSE |
+                              CLK_ADDRESS_CLAMP_TO_EDGE |
+                              CLK_FILTER_LINEAR;
+
+__kernel void convolve(__read_only image2d_t src,
+                       __write_only image2d_t dst,
+                       __global const float* weights,
+                       int radius, int2 dir)
+{
+  int2 p = (int2)(get_global_id(0), get_global_id(1));
+  float sum = 0.0f;
+  for (int k = -radius; k <= radius; ++k)
+  {
+    sum += weights[k + radius] * read_imagef(src, nearest, p + k * dir).x;
+  }
+  write_imagef(dst, p, (float4)(sum));
+}
+
+__kernel void resize(__read_only image2d_t src,
+                     __write_only image2d_t dst,
+                     float2 scale)
+{
+  int2 p = (int2)(get_global_id(0), get_global_id(1));
+  float2 s = ((float2)(p.x, p.y) + 0.5f) * scale;
+  write_imagef(dst, p, (float4)(read_imagef(src, linear, s).x));
+}
+
+__kernel void rgb_to_grey(__global const uchar* rgb,
+                          int w_step, int h_step, int d_step,
+                          __write_only image2d_t dst)
+{
+  int2 p = (int2)(get_global_id(0), get_global_id(1));
+  int i = p.x * w_step + p.y * h_step;
+  float v = 0.2125f * rgb[i] + 0.7154f * rgb[i + d_step] +
+            0.0721f * rgb[i + 2 * d_step];
+  write_imagef(dst, p, (float4)(v / 255.0f));
+}
+)";
+
+// ----------------------------------------------------------------------------
+// The filter program, built once per process for the VisCL context
+class filter_program
+{
+public:
+  static filter_program& instance()
+  {
+    static filter_program program;
+    return program;
+  }
+
+  // Kernel objects hold their arguments, so each call gets its own
+  cl::Kernel kernel(char const* name)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cl::Kernel(program_, name);
+  }
+
+private:
+  filter_program()
+  {
+    cl::Context context = viscl::manager::inst()->get_context();
+    std::vector<cl::Device> devices = context.getInfo<CL_CONTEXT_DEVICES>();
+
+    cl::Program::Sources sources(
+      1, std::make_pair(filter_source, std::strlen(filter_source)));
+    program_ = cl::Program(context, sources);
+    if (program_.build(devices) != CL_SUCCESS)
+    {
+      std::string log;
+      if (!devices.empty())
+      {
+        log = program_.getBuildInfo<CL_PROGRAM_BUILD_LOG>(devices[0]);
+      }
+      VITAL_THROW( vital::algorithm_exception, "image_filter", "viscl",
+                   "Could not build the VisCL image filters: " + log );
+    }
+  }
+
+  std::mutex mutex_;
+  cl::Program program_;
+};
+
+// ----------------------------------------------------------------------------
+viscl::image
+make_image(cl::ImageFormat const& format, size_t width, size_t height)
+{
+  return viscl::image(boost::make_shared<cl::Image2D>(
+                        viscl::manager::inst()->get_context(),
+                        CL_MEM_READ_WRITE, format, width, height));
+}
+
+// ----------------------------------------------------------------------------
+void
+run(cl::Kernel& kernel, size_t width, size_t height)
+{
+  viscl::cl_queue_t q = viscl::manager::inst()->create_queue();
+  q->enqueueNDRangeKernel(kernel, cl::NullRange,
+                          cl::NDRange(width, height), cl::NullRange);
+  q->finish();
+}
+
+// Format of the byte images uploaded by vcl::image_container
+cl::ImageFormat const byte_format(CL_INTENSITY, CL_UNORM_INT8);
+
+// Intermediate results are kept in floating point
+cl::ImageFormat const float_format(CL_INTENSITY, CL_FLOAT);
+
+} // end namespace
+
+/// Smooth a VisCL image with a Gaussian kernel on the GPU
+viscl::image
+smooth_image(const viscl::image& img, float sigma)
+{
+  size_t const width = img.width();
+  size_t const height = img.height();
+  if (sigma <= 0.0f || !width || !height)
+  {
+    return img;
+  }
+
+  int const radius = static_cast<int>(std::ceil(3.0f * sigma));
+  std::vector<float> weights(2 * radius + 1);
+  float sum = 0.0f;
+  for (int k = -radius; k <= radius; ++k)
+  {
+    weights[k + radius] = std::exp(-0.5f * k * k / (sigma * sigma));
+    sum += weights[k + radius];
+  }
+  for (float& w : weights)
+  {
+    w /= sum;
+  }
+
+  cl::Buffer weight_buffer(viscl::manager::inst()->get_context(),
+                           CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                           sizeof(float) * weights.size(), weights.data());
+
+  viscl::image horizontal = make_image(float_format, width, height);
+  viscl::image result = make_image(byte_format, width, height);
+
+  cl_int2 along_x, along_y;
+  along_x.s[0] = 1;
+  along_x.s[1] = 0;
+  along_y.s[0] = 0;
+  along_y.s[1] = 1;
+
+  filter_program& program = filter_program::instance();
+
+  cl::Kernel kx = program.kernel("convolve");
+  kx.setArg(0, *img().get());
+  kx.setArg(1, *horizontal().get());
+  kx.setArg(2, weight_buffer);
+  kx.setArg(3, radius);
+  kx.setArg(4, along_x);
+  run(kx, width, height);
+
+  cl::Kernel ky = program.kernel("convolve");
+  ky.setArg(0, *horizontal().get());
+  ky.setArg(1, *result().get());
+  ky.setArg(2, weight_buffer);
+  ky.setArg(3, radius);
+  ky.setArg(4, along_y);
+  run(ky, width, height);
+
+  return result;
+}
+
+/// Resample a VisCL image to a new size on the GPU
+viscl::image
+resize_image(const viscl::image& img, size_t width, size_t height)
+{
+  if (width == img.width() && height == img.height())
+  {
+    return img;
+  }
+
+  viscl::image result = make_image(byte_format, width, height);
+  if (!width || !height)
+  {
+    return result;
+  }
+
+  cl_float2 scale;
+  scale.s[0] = static_cast<float>(img.width()) / width;
+  scale.s[1] = static_cast<float>(img.height()) / height;
+
+  cl::Kernel k = filter_program::instance().kernel("resize");
+  k.setArg(0, *img().get());
+  k.setArg(1, *result().get());
+  k.setArg(2, scale);
+  run(k, width, height);
+
+  return result;
+}
+
+/// Upload a three channel byte image and convert it to grey on the GPU
+viscl::image
+rgb_to_grey(const vital::image& img)
+{
+  if (img.depth() != 3 ||
+      img.pixel_traits() != vital::image_pixel_traits_of<uint8_t>())
+  {
+    VITAL_THROW( vital::image_type_mismatch_exception,
+                 "VisCL grey conversion requires a three channel byte image" );
+  }
+
+  size_t const width = img.width();
+  size_t const height = img.height();
+  viscl::image result = make_image(byte_format, width, height);
+  if (!width || !height)
+  {
+    return result;
+  }
+
+  // Upload only the pixels, in the memory order of the image if it has no
+  // gaps or flipped axes, so that the kernel can index them directly
+  vital::image packed = img;
+  if (!img.is_contiguous())
+  {
+    packed = vital::image(width, height, 3, true, img.pixel_traits());
+    packed.copy_from(img);
+  }
+
+  cl::Buffer pixels(viscl::manager::inst()->get_context(),
+                    CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                    width * height * 3,
+                    const_cast<void*>(packed.first_pixel()));
+
+  cl::Kernel k = filter_program::instance().kernel("rgb_to_grey");
+  k.setArg(0, pixels);
+  k.setArg(1, static_cast<cl_int>(packed.w_step()));
+  k.setArg(2, static_cast<cl_int>(packed.h_step()));
+  k.setArg(3, static_cast<cl_int>(packed.d_step()));
+  k.setArg(4, *result().get());
+  run(k, width, height);
+
+  return result;
+}
+
+} // end namespace vcl
+} // end namespace arrows
+} // end namespace kwiver
@@ -0,0 +1,45 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_ARROWS_VISCL_IMAGE_FILTERS_H_
+#define KWIVER_ARROWS_VISCL_IMAGE_FILTERS_H_
+
+#include <vital/vital_config.h>
+#include <arrows/viscl/kwiver_algo_viscl_export.h>
+
+#include <vital/types/image.h>
+
+#include <viscl/core/image.h>
+
+namespace kwiver {
+namespace arrows {
+namespace vcl {
+
+/// Smooth a VisCL image with a Gaussian kernel on the GPU
+///
+///  The kernel is applied separably and extends 3 sigma either side of
+///  each pixel.  Pixels beyond the border are clamped to the edge.
+KWIVER_ALGO_VISCL_EXPORT viscl::image
+smooth_image(const viscl::image& img, float sigma);
+
+/// Resample a VisCL image to a new size on the GPU
+///
+///  Pixels are sampled bilinearly at the centers of the output pixels.
+KWIVER_ALGO_VISCL_EXPORT viscl::image
+resize_image(const viscl::image& img, size_t width, size_t height);
+
+/// Upload a three channel byte image and convert it to grey on the GPU
+///
+///  Uses the same weights as the CPU conversion of
+///  vcl::image_container::vital_to_viscl.
+///  \throws vital::image_type_mismatch_exception if the image is not a
+///          three channel byte image
+KWIVER_ALGO_VISCL_EXPORT viscl::image
+rgb_to_grey(const vital::image& img);
+
+} // end namespace vcl
+} // end namespace arrows
+} // end namespace kwiver
+
+#endif
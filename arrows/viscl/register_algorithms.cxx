@@ -11,6 +11,7 @@
 #include <arrows/viscl/convert_image.h>
 #include <arrows/viscl/detect_features.h>
 #include <arrows/viscl/extract_descriptors.h>
+#include <arrows/viscl/filter_image.h>
 #include <arrows/viscl/match_features.h>
 
 namespace kwiver {
@@ -53,6 +54,15 @@ register_factories( kwiver::vital::plugin_loader& vpm )
     .add_attribute( kwiver::vital::plugin_factory::PLUGIN_ORGANIZATION, "Kitware Inc." )
     ;
 
+  fact = vpm.ADD_ALGORITHM( "viscl", kwiver::arrows::vcl::filter_image );
+  fact->add_attribute( kwiver::vital::plugin_factory::PLUGIN_DESCRIPTION,
+                       "Convert to grey, resize and smooth an image on the GPU, "
+                       "leaving the result on the GPU for other VisCL algorithms." )
+    .add_attribute( kwiver::vital::plugin_factory::PLUGIN_MODULE_NAME, module_name )
+    .add_attribute( kwiver::vital::plugin_factory::PLUGIN_VERSION, "1.0" )
+    .add_attribute( kwiver::vital::plugin_factory::PLUGIN_ORGANIZATION, "Kitware Inc." )
+    ;
+
   fact = vpm.ADD_ALGORITHM( "viscl", kwiver::arrows::vcl::match_features );
   fact->add_attribute( kwiver::vital::plugin_factory::PLUGIN_DESCRIPTION,
                        "" )
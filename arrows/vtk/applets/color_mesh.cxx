@@ -239,6 +239,7 @@ class color_mesh::priv : public kwiver::arrows::vtk::mesh_coloration
     color_occluded_ = config_->get_value("color_occluded", color_occluded_);
     color_masked_ = config_->get_value("color_masked", color_masked_);
     remove_color_count_less_equal_ = config_->get_value("remove_color_count_less_equal", remove_color_count_less_equal_);
+    frame_batch_size_ = config_->get_value("frame_batch_size", frame_batch_size_);
 
     return SUCCESS;
   }
@@ -312,6 +313,11 @@ class color_mesh::priv : public kwiver::arrows::vtk::mesh_coloration
     config->set_value(
       "color_masked", false,
       "Color masked points if parameter is true.");
+    config->set_value(
+      "frame_batch_size", 0,
+      "Number of frames read from the video and colored together. "
+      "Only the images of one batch are kept in memory. "
+      "Values less than one use twice the number of threads.");
 
     kva::video_input::get_nested_algo_configuration("video_reader", config,
       kva::video_input_sptr());
@@ -25,17 +25,23 @@
 #include <vital/plugin_loader/plugin_manager.h>
 #include <vital/types/camera_perspective.h>
 #include <vital/types/bounding_box.h>
+#include <vital/types/image_container.h>
 #include <vital/util/get_paths.h>
 
+#include <vtkAppendPolyData.h>
 #include <vtkBox.h>
+#include <vtkCleanPolyData.h>
 #include <vtkFlyingEdges3D.h>
 #include <vtkPLYWriter.h>
 #include <vtkOBJWriter.h>
 #include <vtkXMLImageDataWriter.h>
 #include <vtkXMLPolyDataWriter.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
 
 namespace kwiver {
 namespace arrows {
@@ -52,6 +58,7 @@ using kv::camera_perspective;
 using kv::camera_sptr;
 using kv::landmark_map_sptr;
 
+using kwiver::arrows::core::compute_pixel_to_world_scale;
 using kwiver::arrows::core::compute_robust_ROI;
 using kwiver::arrows::mvg::crop_camera;
 
@@ -134,6 +141,16 @@ bool check_config(kv::config_block_sptr config)
     validate_optional_output_file("output_mesh_file", *config,
                                  main_logger, false) && config_valid;
 
+  if (config->get_value<unsigned>("num_chunks", 1) == 0)
+  {
+    KWIVER_CONFIG_FAIL("num_chunks must be at least 1");
+  }
+  if (config->get_value<int>("chunk_index", -1) >=
+      static_cast<int>(config->get_value<unsigned>("num_chunks", 1)))
+  {
+    KWIVER_CONFIG_FAIL("chunk_index must be less than num_chunks");
+  }
+
   if (!integrate_depth_maps::check_nested_algo_configuration("integrate_depth_maps",
                                                              config))
   {
@@ -158,6 +175,10 @@ class fuse_depth::priv
   vtkSmartPointer<vtkImageData> fused_volume;
   vtkSmartPointer<vtkPolyData> isosurface_mesh;
   double isosurface_threshold = 0.0;
+  unsigned batch_size = 0;
+  unsigned num_chunks = 1;
+  int chunk_index = -1;
+  bool volume_written = false;
 
   kv::path_t  input_cameras_directory = "results/krtd";
   kv::path_t  input_depths_directory = "results/depths";
@@ -231,8 +252,23 @@ class fuse_depth::priv
       isosurface_threshold = cmd_args["isosurface-threshold"].as<double>();
       config->set_value("isosurface_threshold", isosurface_threshold);
     }
+    if ( cmd_args.count("batch-size") > 0 )
+    {
+      config->set_value("batch_size", cmd_args["batch-size"].as<unsigned>());
+    }
+    if ( cmd_args.count("num-chunks") > 0 )
+    {
+      config->set_value("num_chunks", cmd_args["num-chunks"].as<unsigned>());
+    }
+    if ( cmd_args.count("chunk-index") > 0 )
+    {
+      config->set_value("chunk_index", cmd_args["chunk-index"].as<int>());
+    }
 
     bool valid_config = check_config(config);
+    batch_size = config->get_value<unsigned>("batch_size", batch_size);
+    num_chunks = config->get_value<unsigned>("num_chunks", num_chunks);
+    chunk_index = config->get_value<int>("chunk_index", chunk_index);
 
     if( ! opt_out_config.empty() )
     {
@@ -297,6 +333,25 @@ class fuse_depth::priv
       "Path to a file to write the extracted isosurface mesh. Will be "
       "overwritten if present." );
 
+    config->set_value("batch_size", batch_size,
+      "Number of depth maps to load and integrate at a time. The volumes of "
+      "the batches are summed, so memory for depth maps is bounded by the "
+      "batch size. Set to zero to load all depth maps at once." );
+
+    config->set_value("num_chunks", num_chunks,
+      "Number of chunks into which to split the volume along its longest "
+      "axis. Each chunk is integrated and contoured on its own and the "
+      "meshes are merged, so only one chunk is in memory at a time. "
+      "Adjacent chunks share a plane of voxels so that their meshes meet. "
+      "With more than one chunk, each chunk volume is written to the "
+      "output_volume_file name with a _chunk<index> suffix." );
+
+    config->set_value("chunk_index", chunk_index,
+      "Index of the only chunk to process, or -1 to process all chunks. "
+      "This allows chunks to be processed by separate processes, for "
+      "example on separate GPUs. The chunk volume and mesh are written to "
+      "output_volume_file and output_mesh_file." );
+
     return config;
   }
 
@@ -363,6 +418,11 @@ class fuse_depth::priv
 
   bool write_depth_volume()
   {
+    if( volume_written )
+    {
+      return true;
+    }
+
     if( fused_volume == nullptr)
     {
       LOG_WARN(main_logger, "Fused volume was not set for writing");
@@ -375,12 +435,32 @@ class fuse_depth::priv
       return true;
     }
 
+    write_volume(fused_volume, output_volume_file);
+    return true;
+  }
+
+  static void write_volume(vtkImageData* volume, std::string const& filename)
+  {
     auto volume_writer = vtkSmartPointer<vtkXMLImageDataWriter>::New();
 
-    volume_writer->SetFileName(output_volume_file.c_str());
-    volume_writer->SetInputData(fused_volume);
+    volume_writer->SetFileName(filename.c_str());
+    volume_writer->SetInputData(volume);
     volume_writer->Write();
-    return true;
+  }
+
+  // Insert a chunk suffix before the extension of a file name
+  static std::string chunk_filename(std::string const& filename,
+                                    unsigned index)
+  {
+    std::string const path = ST::GetFilenamePath(filename);
+    std::ostringstream ss;
+    if (!path.empty())
+    {
+      ss << path << "/";
+    }
+    ss << ST::GetFilenameWithoutLastExtension(filename)
+       << "_chunk" << index << ST::GetFilenameLastExtension(filename);
+    return ss.str();
   }
 
   bool write_isosurface()
@@ -467,34 +547,73 @@ class fuse_depth::priv
     maxpt = {bounds[1], bounds[3], bounds[5]};
   }
 
+  // Load a depth map, its weights, and its camera cropped to match
+  void load_frame(std::string const& basename,
+                  std::vector<kv::camera_perspective_sptr>& cameras_out,
+                  std::vector<kv::image_container_sptr>& depths_out,
+                  std::vector<kv::image_container_sptr>& weights_out)
+  {
+    std::string camera_filename = input_cameras_directory + "/" +
+                                  basename + CAMERA_EXTENSION;
+    std::string depth_filename = input_depths_directory + "/" +
+                                  basename + DEPTH_EXTENSION;
+    auto cam = read_krtd_file(camera_filename);
+
+    kv::bounding_box<int> crop;
+    kv::image_container_sptr depth, weight, uncertainty, color;
+    load_depth_map(depth_filename, crop, depth, weight, uncertainty, color);
+    depths_out.push_back(depth);
+    weights_out.push_back(weight);
+    cameras_out.push_back(crop_camera(cam, crop));
+  }
+
+  vtkSmartPointer<vtkPolyData> extract_isosurface(vtkImageData* volume)
+  {
+    vtkNew<vtkFlyingEdges3D> contour_filter;
+    contour_filter->SetInputData(volume);
+    contour_filter->SetNumberOfContours(1);
+    contour_filter->SetValue(0, isosurface_threshold);
+    //Declare which table will be use for the contour
+    contour_filter->SetInputArrayToProcess(0, 0, 0,
+      vtkDataObject::FIELD_ASSOCIATION_POINTS,
+      "reconstruction_scalar");
+    contour_filter->Update();
+
+    return contour_filter->GetOutput();
+  }
+
   void run_algorithm()
+  {
+    std::vector<std::string> shared_basenames
+      = common_camera_and_depth_basenames();
+
+    kv::vector_3d minpt, maxpt;
+    // Compute the extents from the loaded landmarks
+    compute_ROI(minpt, maxpt);
+
+    if (batch_size == 0 && num_chunks == 1)
+    {
+      run_in_memory(shared_basenames, minpt, maxpt);
+    }
+    else
+    {
+      run_streaming(shared_basenames, minpt, maxpt);
+    }
+  }
+
+  // Integrate all depth maps at once into a single volume
+  void run_in_memory(std::vector<std::string> const& shared_basenames,
+                     kv::vector_3d const& minpt, kv::vector_3d const& maxpt)
   {
     std::vector<kv::camera_perspective_sptr> cameras_out;
     std::vector<kv::image_container_sptr> depths_out;
     std::vector<kv::image_container_sptr> weights_out;
 
-    std::vector<std::string> shared_basenames
-      = common_camera_and_depth_basenames();
     for (auto const& shared : shared_basenames )
     {
-      std::string camera_filename = input_cameras_directory + "/" +
-                                    shared + CAMERA_EXTENSION;
-      std::string depth_filename = input_depths_directory + "/" +
-                                    shared + DEPTH_EXTENSION;
-      auto cam = read_krtd_file(camera_filename);
-
-      kv::bounding_box<int> crop;
-      kv::image_container_sptr depth, weight, uncertainty, color;
-      load_depth_map(depth_filename, crop, depth, weight, uncertainty, color);
-      depths_out.push_back(depth);
-      weights_out.push_back(weight);
-      cameras_out.push_back(crop_camera(cam, crop));
+      load_frame(shared, cameras_out, depths_out, weights_out);
     }
 
-    kv::vector_3d minpt, maxpt;
-    // Compute the extents from the loaded landmarks
-    compute_ROI(minpt, maxpt);
-
     kv::image_container_sptr volume;
     kv::vector_3d spacing;
     integrate_algo->integrate(minpt, maxpt,
@@ -504,17 +623,169 @@ class fuse_depth::priv
     fused_volume = volume_to_vtk(volume, minpt, spacing);
     if (output_mesh_file != "")
     {
-      vtkNew<vtkFlyingEdges3D> contour_filter;
-      contour_filter->SetInputData(fused_volume);
-      contour_filter->SetNumberOfContours(1);
-      contour_filter->SetValue(0, isosurface_threshold);
-      //Declare which table will be use for the contour
-      contour_filter->SetInputArrayToProcess(0, 0, 0,
-        vtkDataObject::FIELD_ASSOCIATION_POINTS,
-        "reconstruction_scalar");
-      contour_filter->Update();
+      isosurface_mesh = extract_isosurface(fused_volume);
+    }
+  }
+
+  // Integrate depth maps in batches into each chunk of the volume in turn
+  //
+  // The integration algorithm chooses its voxel spacing from the cameras and
+  // bounds it is given, so the spacing factor of each call is scaled to give
+  // every batch and chunk the spacing of the whole volume with all cameras.
+  // Chunk bounds are placed half a voxel past whole voxel counts so that
+  // rounding cannot change the number of voxels.
+  void run_streaming(std::vector<std::string> const& shared_basenames,
+                     kv::vector_3d const& minpt, kv::vector_3d const& maxpt)
+  {
+    // Cameras are small, so read all of them to find the common spacing;
+    // cropping does not change the scale of a camera
+    std::vector<kv::camera_perspective_sptr> all_cameras;
+    for (auto const& shared : shared_basenames)
+    {
+      all_cameras.push_back(
+        read_krtd_file(input_cameras_directory + "/" + shared +
+                       CAMERA_EXTENSION));
+    }
+
+    auto algo_config = integrate_algo->get_configuration();
+    double const spacing_factor =
+      algo_config->get_value<double>("voxel_spacing_factor", 1.0);
+    kv::vector_3d grid_spacing{ 1.0, 1.0, 1.0 };
+    std::istringstream(
+      algo_config->get_value<std::string>("grid_spacing", "1 1 1"))
+      >> grid_spacing[0] >> grid_spacing[1] >> grid_spacing[2];
+
+    double const global_scale =
+      compute_pixel_to_world_scale(minpt, maxpt, all_cameras);
+    kv::vector_3d const spacing =
+      grid_spacing * spacing_factor * global_scale;
+    Eigen::Vector3i dims =
+      ((maxpt - minpt).array() / spacing.array()).cast<int>();
+    LOG_INFO(main_logger, "volume: " << dims.transpose() << " voxels of size "
+                          << spacing.transpose());
+
+    // Split along the longest axis
+    int axis;
+    dims.maxCoeff(&axis);
+    unsigned const n = static_cast<unsigned>(dims[axis]);
+    unsigned const chunks = std::max(1u, std::min(num_chunks, n));
+    unsigned const batch = batch_size > 0
+      ? batch_size : static_cast<unsigned>(shared_basenames.size());
+
+    vtkNew<vtkAppendPolyData> append_meshes;
+    for (unsigned c = 0; c < chunks; ++c)
+    {
+      if (chunk_index >= 0 && c != static_cast<unsigned>(chunk_index))
+      {
+        continue;
+      }
+
+      // Each chunk overlaps the next by one plane of voxels
+      unsigned const begin = c * n / chunks;
+      unsigned const end = std::min(n, (c + 1) * n / chunks + 1);
+      kv::vector_3d chunk_min = minpt;
+      chunk_min[axis] += begin * spacing[axis];
+      Eigen::Vector3d counts = dims.cast<double>();
+      counts[axis] = end - begin;
+      kv::vector_3d const chunk_max =
+        chunk_min + ((counts.array() + 0.5) * spacing.array()).matrix();
+
+      LOG_INFO(main_logger, "chunk " << c << " of " << chunks
+                            << ": voxels " << begin << " to " << end
+                            << " along axis " << axis);
+
+      kv::image_of<double> chunk_volume;
+      for (size_t first = 0; first < shared_basenames.size(); first += batch)
+      {
+        std::vector<kv::camera_perspective_sptr> cameras_out;
+        std::vector<kv::image_container_sptr> depths_out;
+        std::vector<kv::image_container_sptr> weights_out;
+        auto const last = std::min(shared_basenames.size(),
+                                   first + batch);
+        for (auto i = first; i < last; ++i)
+        {
+          load_frame(shared_basenames[i], cameras_out, depths_out,
+                     weights_out);
+        }
+
+        double const batch_scale =
+          compute_pixel_to_world_scale(chunk_min, chunk_max, cameras_out);
+        algo_config->set_value("voxel_spacing_factor",
+                               spacing_factor * global_scale / batch_scale);
+        integrate_algo->set_configuration(algo_config);
 
-      isosurface_mesh = contour_filter->GetOutput();
+        kv::image_container_sptr volume;
+        kv::vector_3d batch_spacing;
+        integrate_algo->integrate(chunk_min, chunk_max,
+                                  depths_out, weights_out, cameras_out,
+                                  volume, batch_spacing);
+
+        if (chunk_volume.size() == 0)
+        {
+          chunk_volume = kv::image_of<double>(volume->get_image());
+          continue;
+        }
+        if (volume->width() != chunk_volume.width() ||
+            volume->height() != chunk_volume.height() ||
+            volume->depth() != chunk_volume.depth())
+        {
+          throw std::runtime_error("Volume of a batch of depth maps does "
+                                   "not match the volume of the chunk");
+        }
+        kv::image_of<double> batch_volume(volume->get_image());
+        for (size_t k = 0; k < chunk_volume.depth(); ++k)
+        {
+          for (size_t j = 0; j < chunk_volume.height(); ++j)
+          {
+            for (size_t i = 0; i < chunk_volume.width(); ++i)
+            {
+              chunk_volume(i, j, k) += batch_volume(i, j, k);
+            }
+          }
+        }
+      }
+
+      // Restore the configured spacing factor
+      algo_config->set_value("voxel_spacing_factor", spacing_factor);
+      integrate_algo->set_configuration(algo_config);
+
+      if (chunk_volume.size() == 0)
+      {
+        continue;
+      }
+
+      auto const vtk_volume = volume_to_vtk(
+        std::make_shared<kv::simple_image_container>(chunk_volume),
+        chunk_min, spacing);
+      if (chunks == 1)
+      {
+        fused_volume = vtk_volume;
+      }
+      else
+      {
+        if (output_volume_file != "")
+        {
+          write_volume(vtk_volume,
+                       chunk_index >= 0 ? output_volume_file
+                                        : chunk_filename(output_volume_file, c));
+        }
+        volume_written = true;
+      }
+
+      if (output_mesh_file != "")
+      {
+        append_meshes->AddInputData(extract_isosurface(vtk_volume));
+      }
+    }
+
+    if (output_mesh_file != "" &&
+        append_meshes->GetNumberOfInputConnections(0) > 0)
+    {
+      // Merge the points that adjacent chunks share on their common plane
+      vtkNew<vtkCleanPolyData> clean;
+      clean->SetInputConnection(append_meshes->GetOutputPort());
+      clean->Update();
+      isosurface_mesh = clean->GetOutput();
     }
   }
 };
@@ -617,6 +888,15 @@ add_command_options()
       cxxopts::value<std::string>())
     ( "t,isosurface-threshold", "isosurface extraction threshold (default: " +
       std::to_string(d->isosurface_threshold) + ")." , cxxopts::value<double>() )
+    ( "b,batch-size", "Number of depth maps to integrate at a time, or 0 "
+      "for all at once (default: " + std::to_string(d->batch_size) + ").",
+      cxxopts::value<unsigned>() )
+    ( "n,num-chunks", "Number of chunks into which to split the volume "
+      "(default: " + std::to_string(d->num_chunks) + ").",
+      cxxopts::value<unsigned>() )
+    ( "chunk-index", "Index of the only chunk to process, or -1 for all "
+      "chunks (default: " + std::to_string(d->chunk_index) + ").",
+      cxxopts::value<int>() )
 
     // positional parameters
     ( "input-cameras-dir", "Camera location data", cxxopts::value<std::string>() )
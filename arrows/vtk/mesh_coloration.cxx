@@ -4,36 +4,27 @@
 
 #include "mesh_coloration.h"
 
-#include "vtkKwiverCamera.h"
+#include <arrows/core/render_mesh_depth_map.h>
 
 #include <kwiversys/SystemTools.hxx>
 
 #include <vital/range/iota.h>
+#include <vital/types/camera_intrinsics.h>
+#include <vital/types/mesh.h>
+#include <vital/util/thread_pool.h>
 
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCleanPolyData.h"
-#include "vtkDoubleArray.h"
-#include "vtkFloatArray.h"
 #include "vtkIdTypeArray.h"
-#include "vtkImageData.h"
 #include "vtkIntArray.h"
 #include "vtkNew.h"
 #include "vtkPointData.h"
-#include "vtkPointDataToCellData.h"
 #include "vtkPolyData.h"
-#include "vtkPolyDataMapper.h"
 #include "vtkPolyDataNormals.h"
-#include "vtkRenderer.h"
-#include "vtkRendererCollection.h"
-#include "vtkRenderWindow.h"
-#include "vtkSequencePass.h"
 #include "vtkSmartPointer.h"
 #include "vtkRemovePolyData.h"
 #include "vtkUnsignedCharArray.h"
-#include "vtkVector.h"
-#include "vtkWindowToImageFilter.h"
-#include "vtkXMLImageDataWriter.h"
-#include "vtkXMLPolyDataWriter.h"
 
 #include <algorithm>
 #include <iomanip>
@@ -69,6 +60,71 @@ ComputeMedian( std::vector< T > vector, double& median )
   }
 }
 
+// Number of mesh points sampled together by a thread
+constexpr size_t points_per_chunk = 4096;
+
+// ----------------------------------------------------------------------------
+/// Convert the polygons and strips of a mesh to a triangle mesh
+kwiver::vital::mesh_sptr
+triangulate( vtkPolyData* poly,
+             std::vector< kwiver::vital::vector_3d > const& positions )
+{
+  using kwiver::vital::mesh_tri;
+
+  std::unique_ptr< kwiver::vital::mesh_regular_face_array< 3 > > tris(
+    new kwiver::vital::mesh_regular_face_array< 3 > );
+  tris->reserve( static_cast< unsigned int >( poly->GetNumberOfPolys() ) );
+
+  vtkIdType npts;
+  vtkIdType const* pts;
+  auto* const polys = poly->GetPolys();
+  for( polys->InitTraversal(); polys->GetNextCell( npts, pts ); )
+  {
+    for( vtkIdType i = 2; i < npts; ++i )
+    {
+      tris->push_back( mesh_tri( static_cast< unsigned int >( pts[ 0 ] ),
+                                 static_cast< unsigned int >( pts[ i - 1 ] ),
+                                 static_cast< unsigned int >( pts[ i ] ) ) );
+    }
+  }
+  // orientation does not matter for depth maps
+  auto* const strips = poly->GetStrips();
+  for( strips->InitTraversal(); strips->GetNextCell( npts, pts ); )
+  {
+    for( vtkIdType i = 2; i < npts; ++i )
+    {
+      tris->push_back( mesh_tri( static_cast< unsigned int >( pts[ i - 2 ] ),
+                                 static_cast< unsigned int >( pts[ i - 1 ] ),
+                                 static_cast< unsigned int >( pts[ i ] ) ) );
+    }
+  }
+
+  std::unique_ptr< kwiver::vital::mesh_vertex_array< 3 > > verts(
+    new kwiver::vital::mesh_vertex_array< 3 >( positions ) );
+  return std::make_shared< kwiver::vital::mesh >( std::move( verts ),
+                                                  std::move( tris ) );
+}
+
+// ----------------------------------------------------------------------------
+/// Make a camera for rendering a depth map the size of an image
+kwiver::vital::camera_perspective_sptr
+camera_for_image( kwiver::vital::camera_perspective_sptr const& camera,
+                  size_t width, size_t height )
+{
+  auto const& K = camera->intrinsics();
+  if( K->image_width() == width && K->image_height() == height )
+  {
+    return camera;
+  }
+
+  auto sized_K =
+    std::make_shared< kwiver::vital::simple_camera_intrinsics >( *K );
+  sized_K->set_image_width( static_cast< unsigned int >( width ) );
+  sized_K->set_image_height( static_cast< unsigned int >( height ) );
+  return std::make_shared< kwiver::vital::simple_camera_perspective >(
+    camera->center(), camera->rotation(), sized_K );
+}
+
 } // namespace <anonymous>
 
 namespace kwiver {
@@ -90,6 +146,7 @@ ::mesh_coloration()
   color_occluded_ = false;
   color_masked_ = false;
   remove_color_count_less_equal_ = -1;
+  frame_batch_size_ = 0;
   video_reader_ = nullptr;
   mask_reader_ = nullptr;
   cameras_ = nullptr;
@@ -194,21 +251,18 @@ bool
 mesh_coloration
 ::colorize()
 {
-  LOG_INFO( logger_, "Initialize camera and image list: frame " << frame_ );
-  initialize_data_list( frame_ );
-
-  auto const numFrames = data_list_.size();
+  if( input_ == 0 )
+  {
+    LOG_ERROR( logger_, "Error when input has been set" );
+    LOG_INFO( logger_, "Done: frame " << frame_ );
+    return false;
+  }
 
-  if( input_ == 0 || numFrames == 0 )
+  LOG_INFO( logger_, "Initialize camera list: frame " << frame_ );
+  auto const cameras = select_cameras( frame_ );
+  if( cameras.empty() )
   {
-    if( input_ == 0 )
-    {
-      LOG_ERROR( logger_, "Error when input has been set" );
-    }
-    else
-    {
-      LOG_INFO( logger_, "No camera for this frame" );
-    }
+    LOG_INFO( logger_, "No camera for this frame" );
     LOG_INFO( logger_, "Done: frame " << frame_ );
     return false;
   }
@@ -237,264 +291,286 @@ ::colorize()
   }
   vtkIdType nbMeshPoint = meshPointList->GetNumberOfPoints();
 
-  // per frame colors
-  std::vector< vtkSmartPointer< vtkUnsignedCharArray > > perFrameColor;
-  // average colors
-  vtkNew< vtkUnsignedCharArray > meanValues;
-  vtkNew< vtkUnsignedCharArray > medianValues;
-  vtkNew< vtkIntArray > countValues;
-  // Store each rgb value for each depth map
-  std::vector< double > list0;
-  std::vector< double > list1;
-  std::vector< double > list2;
-  struct DepthBuffer
+  // Copy the points and normals once so that the threads only read them
+  std::vector< kwiver::vital::vector_3d > positions( nbMeshPoint );
+  std::vector< kwiver::vital::vector_3d > pointNormals( nbMeshPoint );
+  for( auto const pointId : kvr::iota( nbMeshPoint ) )
   {
-    DepthBuffer()
-    {
-      Range[ 0 ] = Range[ 1 ] = 0;
-    }
-
-    vtkSmartPointer< vtkFloatArray > Buffer;
-    double Range[ 2 ];
-  };
-
-  std::vector< DepthBuffer > depthBuffer( numFrames );
+    meshPointList->GetPoint( pointId, positions[ pointId ].data() );
+    normals->GetTuple( pointId, pointNormals[ pointId ].data() );
+  }
 
+  kwiver::vital::mesh_sptr depthMesh;
   if( !color_occluded_ )
   {
-    report_progress_changed( "Creating depth buffers", 0 );
+    depthMesh = triangulate( output_, positions );
+  }
+
+  // Colors seen by each point, accumulated over all batches
+  std::vector< std::vector< kwiver::vital::rgb_color > > pointColors;
+  if( !all_frames_ )
+  {
+    pointColors.resize( nbMeshPoint );
+  }
+  std::vector< int > colorCount( nbMeshPoint, 0 );
 
-    auto ren_win = create_depth_buffer_pipeline();
+  // per frame colors
+  std::vector< vtkSmartPointer< vtkUnsignedCharArray > > perFrameColor;
+  std::vector< int > cameraFrames;
 
-    if( !ren_win )
+  auto& pool = kwiver::vital::thread_pool::instance();
+  size_t const batchSize =
+    frame_batch_size_ > 0
+    ? static_cast< size_t >( frame_batch_size_ )
+    : std::max< size_t >( 1, 2 * pool.num_threads() );
+
+  auto const has_mask = open_readers();
+  kwiver::vital::timestamp ts;
+  size_t numFramesColored = 0;
+  for( size_t batchBegin = 0; batchBegin < cameras.size();
+       batchBegin += batchSize )
+  {
+    report_progress_changed(
+      "Coloring Mesh Points",
+      static_cast< int >( ( 100 * batchBegin ) / cameras.size() ) );
+
+    // Only the images of this batch are held in memory
+    auto const batchEnd = std::min( cameras.size(), batchBegin + batchSize );
+    data_list_.clear();
+    for( auto i = batchBegin; i < batchEnd; ++i )
+    {
+      push_data( cameras[ i ], ts, has_mask );
+    }
+    auto const numFrames = data_list_.size();
+    if( numFrames == 0 )
+    {
+      continue;
+    }
+
+    // Render the depth maps of the batch together on the thread pool
+    std::vector< kwiver::vital::image_of< double > > depthMaps;
+    if( depthMesh )
     {
-      LOG_ERROR( logger_, "Fail to create the render window" );
-      return false;
+      std::vector< kwiver::vital::camera_perspective_sptr > depthCameras;
+      for( auto const& data : data_list_ )
+      {
+        depthCameras.push_back(
+          camera_for_image( data.camera_, data.image_.width(),
+                            data.image_.height() ) );
+      }
+      for( auto const& depth :
+           kwiver::arrows::core::render_mesh_depth_maps( depthMesh,
+                                                         depthCameras ) )
+      {
+        depthMaps.emplace_back( depth->get_image() );
+      }
     }
 
-    size_t i = 0;
-    for( auto it = depthBuffer.begin(); it != depthBuffer.end(); ++it )
+    std::vector< unsigned char* > frameColors( numFrames, nullptr );
+    if( all_frames_ )
     {
-      kwiver::vital::camera_perspective_sptr camera = data_list_[ i ].camera_;
-      auto const& colorImage = data_list_[ i ].image_;
-      auto const width = static_cast< int >( colorImage.width() );
-      auto const height = static_cast< int >( colorImage.height() );
-      DepthBuffer db;
-      db.Buffer =
-        render_depth_buffer( ren_win, camera, width, height, db.Range );
-      *it = db;
-      ++i;
+      for( auto const frameId : kvr::iota( numFrames ) )
+      {
+        // RGBA, we use A=0 for invalid pixels and A=255 otherwise
+        auto colors = vtkSmartPointer< vtkUnsignedCharArray >::New();
+        colors->SetNumberOfComponents( 4 );
+        colors->SetNumberOfTuples( nbMeshPoint );
+
+        unsigned char* p = colors->GetPointer( 0 );
+        std::fill( p, p + nbMeshPoint * 4, 0 );
+        frameColors[ frameId ] = p;
+
+        std::ostringstream ostr;
+        kwiver::vital::frame_id_t frame = data_list_[ frameId ].frame_;
+        cameraFrames.push_back( static_cast< int >( frame ) );
+        ostr << "frame_" << std::setfill( '0' ) << std::setw( 4 ) << frame;
+        colors->SetName( ostr.str().c_str() );
+        perFrameColor.push_back( colors );
+      }
     }
+
+    // Sample the frames of the batch for each point in parallel; each point
+    // is only written by the thread which samples it
+    pool.parallel_for(
+      static_cast< size_t >( nbMeshPoint ), points_per_chunk,
+      [ & ]( size_t begin, size_t end ){
+        for( auto pointId = begin; pointId < end; ++pointId )
+        {
+          auto const& position = positions[ pointId ];
+          auto const& pointNormal = pointNormals[ pointId ];
+          for( auto const frameId : kvr::iota( numFrames ) )
+          {
+            auto const& data = data_list_[ frameId ];
+            auto const& camera = data.camera_;
+            // Check if the 3D point is in front of the camera
+            double depth = camera->depth( position );
+
+            if( depth <= 0.0 )
+            {
+              continue;
+            }
+
+            // test that we are viewing the front side of the mesh
+            kwiver::vital::vector_3d cameraPointVec =
+              position - camera->center();
+
+            if( cameraPointVec.dot( pointNormal ) > 0.0 )
+            {
+              continue;
+            }
+
+            // project 3D point to pixel coordinates
+            auto pixelPosition = camera->project( position );
+            auto const& colorImage = data.image_;
+            auto const width = colorImage.width();
+            auto const height = colorImage.height();
+
+            if( pixelPosition[ 0 ] < 0.0 ||
+                pixelPosition[ 1 ] < 0.0 ||
+                pixelPosition[ 0 ] >= static_cast< double >( width ) ||
+                pixelPosition[ 1 ] >= static_cast< double >( height ) )
+            {
+              continue;
+            }
+
+            auto const x = static_cast< size_t >( pixelPosition[ 0 ] );
+            auto const y = static_cast< size_t >( pixelPosition[ 1 ] );
+
+            // masks which do not cover the pixel do not hide it
+            auto const& maskImage = data.mask_image_;
+            bool const showPoint =
+              x >= maskImage.width() || y >= maskImage.height() ||
+              maskImage.at( x, y ).r > 0;
+            if( !color_masked_ && !showPoint )
+            {
+              continue;
+            }
+
+            if( !color_occluded_ &&
+                !( depthMaps[ frameId ]( x, y ) + occlusion_threshold_ >
+                   depth ) )
+            {
+              continue;
+            }
+
+            kwiver::vital::rgb_color const rgb = colorImage.at( x, y );
+            if( !all_frames_ )
+            {
+              pointColors[ pointId ].push_back( rgb );
+            }
+            else
+            {
+              unsigned char* const rgba = frameColors[ frameId ] + 4 * pointId;
+              rgba[ 0 ] = rgb.r;
+              rgba[ 1 ] = rgb.g;
+              rgba[ 2 ] = rgb.b;
+              rgba[ 3 ] = 255;
+            }
+            ++colorCount[ pointId ];
+          }
+        }
+      } );
+    numFramesColored += numFrames;
+  }
+  data_list_.clear();
+  close_readers( has_mask );
+
+  if( numFramesColored == 0 )
+  {
+    LOG_INFO( logger_, "No image for this frame" );
+    LOG_INFO( logger_, "Done: frame " << frame_ );
+    return false;
   }
+
   if( !all_frames_ )
   {
     // Contains rgb values
+    vtkNew< vtkUnsignedCharArray > meanValues;
     meanValues->SetNumberOfComponents( 3 );
     meanValues->SetNumberOfTuples( nbMeshPoint );
-    meanValues->FillComponent( 0, 0 );
-    meanValues->FillComponent( 1, 0 );
-    meanValues->FillComponent( 2, 0 );
     meanValues->SetName( "mean" );
 
+    vtkNew< vtkUnsignedCharArray > medianValues;
     medianValues->SetNumberOfComponents( 3 );
     medianValues->SetNumberOfTuples( nbMeshPoint );
-    medianValues->FillComponent( 0, 0 );
-    medianValues->FillComponent( 1, 0 );
-    medianValues->FillComponent( 2, 0 );
     medianValues->SetName( "median" );
 
+    vtkNew< vtkIntArray > countValues;
     countValues->SetNumberOfComponents( 1 );
     countValues->SetNumberOfTuples( nbMeshPoint );
-    countValues->FillComponent( 0, 0 );
     countValues->SetName( "count" );
+
+    unsigned char* const means = meanValues->GetPointer( 0 );
+    unsigned char* const medians = medianValues->GetPointer( 0 );
+    int* const counts = countValues->GetPointer( 0 );
+    pool.parallel_for(
+      static_cast< size_t >( nbMeshPoint ), points_per_chunk,
+      [ & ]( size_t begin, size_t end ){
+        std::vector< double > channel;
+        for( auto pointId = begin; pointId < end; ++pointId )
+        {
+          auto const& colors = pointColors[ pointId ];
+          counts[ pointId ] = static_cast< int >( colors.size() );
+          for( int c = 0; c < 3; ++c )
+          {
+            means[ 3 * pointId + c ] = 0;
+            medians[ 3 * pointId + c ] = 0;
+            if( colors.empty() )
+            {
+              continue;
+            }
+
+            channel.clear();
+            for( auto const& rgb : colors )
+            {
+              channel.push_back( c == 0 ? rgb.r : c == 1 ? rgb.g : rgb.b );
+            }
+            double const sum =
+              std::accumulate( channel.begin(), channel.end(), 0.0 );
+            double median;
+            ComputeMedian< double >( channel, median );
+            // truncate like vtkDataArray::SetTuple3
+            means[ 3 * pointId + c ] = static_cast< unsigned char >(
+              sum / static_cast< double >( channel.size() ) );
+            medians[ 3 * pointId + c ] = static_cast< unsigned char >( median );
+          }
+        }
+      } );
+
+    output_->GetPointData()->AddArray( meanValues );
+    output_->GetPointData()->AddArray( medianValues );
+    output_->GetPointData()->AddArray( countValues );
   }
   else
   {
-    perFrameColor.resize( numFrames );
-
     vtkNew< vtkIntArray > cameraIndex;
     cameraIndex->SetNumberOfComponents( 1 );
-    cameraIndex->SetNumberOfTuples( static_cast< int >( numFrames ) );
+    cameraIndex->SetNumberOfTuples(
+      static_cast< vtkIdType >( cameraFrames.size() ) );
     cameraIndex->SetName( "camera_index" );
+    for( auto const i : kvr::iota( cameraFrames.size() ) )
+    {
+      cameraIndex->SetValue( static_cast< vtkIdType >( i ), cameraFrames[ i ] );
+    }
     output_->GetFieldData()->AddArray( cameraIndex );
 
-    size_t i = 0;
-    for( auto it = perFrameColor.begin(); it != perFrameColor.end(); ++it )
+    for( auto const& colors : perFrameColor )
     {
-      ( *it ) = vtkSmartPointer< vtkUnsignedCharArray >::New();
-      ( *it )->SetNumberOfComponents( 4 ); // RGBA, we use A=0 for invalid
-                                           // pixels and A=255 otherwise
-      ( *it )->SetNumberOfTuples( nbMeshPoint );
-
-      unsigned char* p = ( *it )->GetPointer( 0 );
-      std::fill( p, p + nbMeshPoint * 4, 0 );
-
-      std::ostringstream ostr;
-      kwiver::vital::frame_id_t frame = data_list_[ i ].frame_;
-      cameraIndex->SetValue( static_cast< vtkIdType >( i ),
-                             static_cast< int >( frame ) );
-      ostr << "frame_" << std::setfill( '0' ) << std::setw( 4 ) << frame;
-      ( *it )->SetName( ostr.str().c_str() );
-      output_->GetPointData()->AddArray( *it );
-      ++i;
+      output_->GetPointData()->AddArray( colors );
     }
   }
-  auto const progress_step = nbMeshPoint / 100;
+
   vtkNew<vtkIdTypeArray> removedPoints;
   removedPoints->SetNumberOfTuples(nbMeshPoint);
   vtkIdType removedPointsIndex = 0;
-
   for( auto const pointId : kvr::iota( nbMeshPoint ) )
   {
-    if( pointId % progress_step == 0 )
-    {
-      report_progress_changed(
-        "Coloring Mesh Points",
-        static_cast< int >( ( 100 * pointId ) / nbMeshPoint ) );
-    }
-    if( !all_frames_ )
-    {
-      list0.reserve( numFrames );
-      list1.reserve( numFrames );
-      list2.reserve( numFrames );
-    }
-
-    // Get mesh position from id
-    kwiver::vital::vector_3d position;
-    meshPointList->GetPoint( pointId, position.data() );
-
-    kwiver::vital::vector_3d pointNormal;
-    normals->GetTuple( pointId, pointNormal.data() );
-    int colorCount = 0;
-    for( auto const frameId : kvr::iota( numFrames ) )
-    {
-      kwiver::vital::camera_perspective_sptr camera =
-        data_list_[ frameId ].camera_;
-      // Check if the 3D point is in front of the camera
-      double depth = camera->depth( position );
-
-      if( depth <= 0.0 )
-      {
-        continue;
-      }
-
-      // test that we are viewing the front side of the mesh
-      kwiver::vital::vector_3d cameraPointVec = position - camera->center();
-
-      if( cameraPointVec.dot( pointNormal ) > 0.0 )
-      {
-        continue;
-      }
-
-      // project 3D point to pixel coordinates
-      auto pixelPosition = camera->project( position );
-      auto const& colorImage = data_list_[ frameId ].image_;
-      auto const width = colorImage.width();
-      auto const height = colorImage.height();
-
-      if( pixelPosition[ 0 ] < 0.0 ||
-          pixelPosition[ 1 ] < 0.0 ||
-          pixelPosition[ 0 ] >= static_cast< double >( width ) ||
-          pixelPosition[ 1 ] >= static_cast< double >( height ) )
-      {
-        continue;
-      }
-
-      bool has_mask = true;
-      auto const& maskImage = data_list_[ frameId ].mask_image_;
-      auto const maskWidth = static_cast< double >( maskImage.width() );
-      auto const maskHeight = static_cast< double >( maskImage.height() );
-
-      if( pixelPosition[ 0 ] < 0.0 ||
-          pixelPosition[ 1 ] < 0.0 ||
-          pixelPosition[ 0 ] >= maskWidth ||
-          pixelPosition[ 1 ] >= maskHeight )
-      {
-        has_mask = false;
-      }
-
-      try
-      {
-        auto const x = static_cast< size_t >( pixelPosition[ 0 ] );
-        auto const y = static_cast< size_t >( pixelPosition[ 1 ] );
-        kwiver::vital::rgb_color rgb = colorImage.at( x, y );
-        bool showPoint = true;
-
-        if( has_mask )
-        {
-          showPoint = ( maskImage.at( x, y ).r > 0 );
-        }
-
-        double depthBufferValue = 0;
-        if( !color_occluded_ )
-        {
-          double* range = depthBuffer[ frameId ].Range;
-          float depthBufferValueNorm =
-            depthBuffer[ frameId ].Buffer->GetValue(
-              static_cast< vtkIdType >( x + width * ( height - y - 1 ) ) );
-          depthBufferValue =
-            2 * range[1] * range[0] / (range[1] + range[0] - (2 * depthBufferValueNorm - 1) * (range[1] - range[0]));
-        }
-        if( ( color_occluded_ ||
-              depthBufferValue + occlusion_threshold_ > depth ) &&
-            ( color_masked_ || showPoint ) )
-        {
-          if( !all_frames_ )
-          {
-            list0.push_back( rgb.r );
-            list1.push_back( rgb.g );
-            list2.push_back( rgb.b );
-          }
-          else
-          {
-            unsigned char rgba[] = { rgb.r, rgb.g, rgb.b, 255 };
-            perFrameColor[ frameId ]->SetTypedTuple( pointId, rgba );
-          }
-          ++colorCount;
-        }
-      }
-      catch ( std::out_of_range const& )
-      {
-        continue;
-      }
-    }
-    if (colorCount <= remove_color_count_less_equal_)
+    if (colorCount[ pointId ] <= remove_color_count_less_equal_)
     {
       removedPoints->SetValue(removedPointsIndex++, pointId);
     }
-
-    if( !all_frames_ )
-    {
-      // If we get elements
-      if( list0.size() != 0 )
-      {
-        double const sum0 = std::accumulate( list0.begin(), list0.end(), 0 );
-        double const sum1 = std::accumulate( list1.begin(), list1.end(), 0 );
-        double const sum2 = std::accumulate( list2.begin(), list2.end(), 0 );
-        double const nb_val = static_cast< double >( list0.size() );
-        meanValues->SetTuple3(
-          pointId, sum0 / nb_val, sum1 / nb_val, sum2 / nb_val );
-
-        double median0, median1, median2;
-        ComputeMedian< double >( list0, median0 );
-        ComputeMedian< double >( list1, median1 );
-        ComputeMedian< double >( list2, median2 );
-        medianValues->SetTuple3( pointId, median0, median1, median2 );
-        countValues->SetTuple1( pointId, nb_val );
-      }
-
-      list0.clear();
-      list1.clear();
-      list2.clear();
-    }
   }
   removedPoints->Resize(removedPointsIndex);
-  if( !all_frames_ )
-  {
-    output_->GetPointData()->AddArray( meanValues );
-    output_->GetPointData()->AddArray( medianValues );
-    output_->GetPointData()->AddArray( countValues );
-  }
 
   if (remove_color_count_less_equal_ >= 0 && removedPoints->GetNumberOfTuples() > 1)
   {
@@ -517,33 +593,23 @@ ::colorize()
 // ----------------------------------------------------------------------------
 void
 mesh_coloration
-::push_data(
-  kwiver::vital::camera_map::map_camera_t::value_type cam_itr,
-  kwiver::vital::timestamp& ts, bool has_mask )
+::push_data( frame_camera const& cam, kwiver::vital::timestamp& ts,
+             bool has_mask )
 {
-  auto cam_ptr =
-    std::dynamic_pointer_cast< kwiver::vital::camera_perspective >(
-      cam_itr.second );
-  if( cam_ptr && video_reader_->seek_frame( ts, cam_itr.first ) &&
-      ( !has_mask || mask_reader_->seek_frame( ts, cam_itr.first ) ) )
+  if( video_reader_->seek_frame( ts, cam.first ) &&
+      ( !has_mask || mask_reader_->seek_frame( ts, cam.first ) ) )
   {
     try
     {
       kwiver::vital::image_container_sptr image{
         video_reader_->frame_image() };
+      kwiver::vital::image_container_sptr maskImage;
       if( has_mask )
       {
-        kwiver::vital::image_container_sptr maskImage{
-          mask_reader_->frame_image() };
-        data_list_.push_back(
-          coloration_data( image, maskImage, cam_ptr, cam_itr.first ) );
-      }
-      else
-      {
-        kwiver::vital::image_container_sptr maskImage;
-        data_list_.push_back(
-          coloration_data( image, maskImage, cam_ptr, cam_itr.first ) );
+        maskImage = mask_reader_->frame_image();
       }
+      data_list_.push_back(
+        coloration_data( image, maskImage, cam.second, cam.first ) );
     }
     catch ( kwiver::vital::image_type_mismatch_exception const& )
     {
@@ -552,31 +618,23 @@ ::push_data(
 }
 
 // ----------------------------------------------------------------------------
-void
+std::vector< mesh_coloration::frame_camera >
 mesh_coloration
-::initialize_data_list( int frame_id )
+::select_cameras( int frame_id ) const
 {
-  video_reader_->open( video_path_ );
-
-  kwiver::vital::timestamp ts;
-  auto cam_map = cameras_->cameras();
-  bool has_mask = true;
-  if( mask_path_.empty() )
-  {
-    has_mask = false;
-  }
-  else
-  {
-    try
+  std::vector< frame_camera > selected;
+  auto const cam_map = cameras_->cameras();
+  auto const select = [ &selected ](
+    kwiver::vital::camera_map::map_camera_t::value_type const& cam_itr ){
+    auto cam_ptr =
+      std::dynamic_pointer_cast< kwiver::vital::camera_perspective >(
+        cam_itr.second );
+    if( cam_ptr )
     {
-      mask_reader_->open( mask_path_ );
+      selected.emplace_back( cam_itr.first, cam_ptr );
     }
-    catch ( std::exception const& )
-    {
-      has_mask = false;
-      LOG_ERROR( logger_, "Cannot open mask file: " << mask_path_ );
-    }
-  }
+  };
+
   // Take a subset of images
   if( frame_id < 0 )
   {
@@ -588,9 +646,9 @@ ::initialize_data_list( int frame_id )
       {
         continue;
       }
-      push_data( cam_itr, ts, has_mask );
+      select( cam_itr );
     }
-    LOG_DEBUG( logger_, "Camera and image list size: " << data_list_.size() );
+    LOG_DEBUG( logger_, "Camera list size: " << selected.size() );
   }
   // Take the current image
   else
@@ -598,108 +656,46 @@ ::initialize_data_list( int frame_id )
     auto cam_itr = cam_map.find( frame_id );
     if( cam_itr != cam_map.end() )
     {
-      push_data( *cam_itr, ts, has_mask );
+      select( *cam_itr );
     }
   }
-  video_reader_->close();
-
-  if( has_mask )
-  {
-    mask_reader_->close();
-  }
+  return selected;
 }
 
 // ----------------------------------------------------------------------------
-vtkSmartPointer< vtkRenderWindow >
+bool
 mesh_coloration
-::create_depth_buffer_pipeline()
+::open_readers()
 {
-  vtkNew< vtkRenderer > ren;
-  auto ren_win = vtkSmartPointer< vtkRenderWindow >::New();
-  if( ren_win )
-  {
-    ren_win->OffScreenRenderingOn();
-    ren_win->SetMultiSamples( 0 );
-    ren_win->AddRenderer( ren );
-
-    vtkNew< vtkPolyDataMapper > mapper;
-    mapper->SetInputDataObject( output_ );
+  video_reader_->open( video_path_ );
 
-    vtkNew< vtkActor > actor;
-    actor->SetMapper( mapper );
-    ren->AddActor( actor );
+  if( mask_path_.empty() )
+  {
+    return false;
   }
-  return ren_win;
+  try
+  {
+    mask_reader_->open( mask_path_ );
+  }
+  catch ( std::exception const& )
+  {
+    LOG_ERROR( logger_, "Cannot open mask file: " << mask_path_ );
+    return false;
+  }
+  return true;
 }
 
 // ----------------------------------------------------------------------------
-vtkSmartPointer< vtkFloatArray >
+void
 mesh_coloration
-::render_depth_buffer(
-  vtkSmartPointer< vtkRenderWindow > ren_win,
-  kwiver::vital::camera_perspective_sptr camera_persp,
-  int width, int height, double depthRange[ 2 ] )
+::close_readers( bool has_mask )
 {
-  ren_win->SetSize( width, height );
-
-  double* bounds = output_->GetBounds();
-  double const bb[ 8 ][ 3 ] = {
-    { bounds[ 0 ], bounds[ 2 ], bounds[ 4 ] },
-    { bounds[ 1 ], bounds[ 2 ], bounds[ 4 ] },
-    { bounds[ 0 ], bounds[ 3 ], bounds[ 4 ] },
-    { bounds[ 1 ], bounds[ 3 ], bounds[ 4 ] },
-
-    { bounds[ 0 ], bounds[ 2 ], bounds[ 5 ] },
-    { bounds[ 1 ], bounds[ 2 ], bounds[ 5 ] },
-    { bounds[ 0 ], bounds[ 3 ], bounds[ 5 ] },
-    { bounds[ 1 ], bounds[ 3 ], bounds[ 5 ] },
-  };
-  depthRange[ 0 ] = std::numeric_limits< double >::max();
-  depthRange[ 1 ] = std::numeric_limits< double >::lowest();
+  video_reader_->close();
 
-  for( int i : kvr::iota( 8 ) )
-  {
-    double depth =
-      camera_persp->depth( kwiver::vital::vector_3d( bb[ i ][ 0 ],
-                                                     bb[ i ][ 1 ],
-                                                     bb[ i ][ 2 ] ) );
-    if( depth < depthRange[ 0 ] )
-    {
-      depthRange[ 0 ] = depth;
-    }
-    if( depth > depthRange[ 1 ] )
-    {
-      depthRange[ 1 ] = depth;
-    }
-  }
-  // we only render points in front of the camera
-  double minDepth = depthRange[ 1 ] * 0.001;
-  if( depthRange[ 0 ] <  minDepth)
+  if( has_mask )
   {
-    depthRange[ 0 ] = minDepth;
+    mask_reader_->close();
   }
-  vtkNew< vtkKwiverCamera > cam;
-  int imageDimensions[ 2 ] = { width, height };
-  cam->SetCamera( camera_persp );
-  cam->SetImageDimensions( imageDimensions );
-  cam->Update();
-  cam->SetClippingRange( depthRange[ 0 ], depthRange[ 1 ] );
-
-  vtkRenderer* ren = ren_win->GetRenderers()->GetFirstRenderer();
-  vtkCamera* camera = ren->GetActiveCamera();
-  camera->ShallowCopy( cam );
-  ren_win->Render();
-
-  vtkNew< vtkWindowToImageFilter > filter;
-  filter->SetInput( ren_win );
-  filter->SetScale( 1 );
-  filter->SetInputBufferTypeToZBuffer();
-  filter->Update();
-
-  vtkSmartPointer< vtkFloatArray > zBuffer =
-    vtkFloatArray::SafeDownCast(
-      filter->GetOutput()->GetPointData()->GetArray( 0 ) );
-  return zBuffer;
 }
 
 } // namespace vtk
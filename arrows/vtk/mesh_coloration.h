@@ -19,9 +19,7 @@
 #include <string>
 #include <vector>
 
-class vtkFloatArray;
 class vtkPolyData;
-class vtkRenderWindow;
 
 namespace kwiver {
 
@@ -111,6 +109,18 @@ class KWIVER_ALGO_VTK_EXPORT mesh_coloration :
     color_masked_ = color_masked;
   }
 
+  /// Set the number of frames read and colored together.
+  ///
+  /// Only the images of one batch are held in memory.  The depth maps of a
+  /// batch are rendered concurrently and its frames are sampled together for
+  /// each mesh point.  Values less than one use twice the number of threads
+  /// of the vital thread pool.
+  void
+  set_frame_batch_size( int batch_size )
+  {
+    frame_batch_size_ = batch_size;
+  }
+
   /// Set whether to remove points colored with fewer or equal the number of
   /// frames passed as a parameter. Default is -1, so we doing remove any cells.
   void
@@ -124,6 +134,10 @@ class KWIVER_ALGO_VTK_EXPORT mesh_coloration :
   /// Adds mean and median colors to \c output_ if \c all_frames is \c false,
   /// or adds an array of colors for each camera (frame) otherwise.
   ///
+  /// Frames are streamed from the video in batches.  Unless occluded points
+  /// are colored, the occlusion of each point is tested against depth maps of
+  /// the mesh rendered on the CPU, so no graphics context is needed.
+  ///
   /// \return \c true if successful, \c false if an error occurred.
   bool colorize();
 
@@ -132,14 +146,15 @@ class KWIVER_ALGO_VTK_EXPORT mesh_coloration :
                                         int percentage ) = 0;
 
 protected:
-  void initialize_data_list( int frame_id );
-  void push_data( kwiver::vital::camera_map::map_camera_t::value_type cam_itr,
-                  kwiver::vital::timestamp& ts, bool has_mask );
-  vtkSmartPointer< vtkRenderWindow > create_depth_buffer_pipeline();
-  vtkSmartPointer< vtkFloatArray > render_depth_buffer(
-    vtkSmartPointer< vtkRenderWindow > ren_win,
-    kwiver::vital::camera_perspective_sptr camera, int width,
-    int height, double range[ 2 ] );
+  /// A frame chosen for coloring and its camera
+  using frame_camera = std::pair< kwiver::vital::frame_id_t,
+                                  kwiver::vital::camera_perspective_sptr >;
+
+  std::vector< frame_camera > select_cameras( int frame_id ) const;
+  bool open_readers();
+  void close_readers( bool has_mask );
+  void push_data( frame_camera const& cam, kwiver::vital::timestamp& ts,
+                  bool has_mask );
 
 protected:
   vtkSmartPointer< vtkPolyData > input_;
@@ -151,6 +166,7 @@ class KWIVER_ALGO_VTK_EXPORT mesh_coloration :
   bool color_occluded_;
   bool color_masked_;
   int remove_color_count_less_equal_;
+  int frame_batch_size_;
 
   kwiver::vital::logger_handle_t logger_;
 
@@ -172,6 +188,7 @@ class KWIVER_ALGO_VTK_EXPORT mesh_coloration :
     kwiver::vital::frame_id_t frame_;
   };
 
+  /// The images and cameras of the batch of frames being colored
   std::vector< coloration_data > data_list_;
 
   std::string video_path_;
@@ -4,15 +4,19 @@
 
 #include "aligned_edge_detection.h"
 
+#include "parallel_rows.h"
+
 #include <arrows/vxl/image_container.h>
 
 #include <vil/algo/vil_gauss_filter.h>
 #include <vil/algo/vil_sobel_3x3.h>
 #include <vil/vil_convert.h>
+#include <vil/vil_copy.h>
 #include <vil/vil_image_view.h>
-#include <vil/vil_math.h>
 #include <vil/vil_plane.h>
+#include <vil/vil_transform.h>
 
+#include <algorithm>
 #include <limits>
 #include <type_traits>
 
@@ -139,50 +143,62 @@ ::filter( vil_image_view< pix_t > const& input_image )
 {
   auto const source_ni = input_image.ni();
   auto const source_nj = input_image.nj();
+  auto const nplanes = ( produce_joint_output ? 3u : 2u );
 
-  vil_image_view< pix_t > aligned_edges;
-  if( produce_joint_output )
-  {
-    aligned_edges.set_size( source_ni, source_nj, 3 );
-  }
-  else
+  vil_image_view< pix_t > aligned_edges{ source_ni, source_nj, nplanes };
+
+  auto half_step = ( produce_joint_output ? smoothing_half_step : 0u );
+  auto const min_dim = std::min( source_ni, source_nj );
+
+  if( 2 * half_step + 1 >= min_dim )
   {
-    aligned_edges.set_size( source_ni, source_nj, 2 );
+    half_step = ( min_dim - 1 ) / 2;
   }
-  aligned_edges.fill( 0 );
 
-  auto i_response = vil_plane( aligned_edges, 0 );
-  auto j_response = vil_plane( aligned_edges, 1 );
+  // Process bands of rows in parallel, doing all steps on each band while it
+  // is still in cache; non-maximum suppression reads gradients one row away,
+  // which the Sobel filter computes from one row further, and the smoothing
+  // of the combined response reads half_step rows beyond that
+  filter_row_bands(
+    input_image, aligned_edges, 2 + half_step,
+    [ & ]( vil_image_view< pix_t > const& in_band,
+           vil_image_view< pix_t >& out_band, unsigned ){
+      auto const band_nj = in_band.nj();
 
-  calculate_aligned_edges< pix_t >( input_image, i_response, j_response );
+      out_band.set_size( source_ni, band_nj, nplanes );
+      out_band.fill( 0 );
 
-  // Perform extra op if enabled
-  if( produce_joint_output )
-  {
-    auto combined_response = vil_plane( aligned_edges, 2 );
+      auto i_response = vil_plane( out_band, 0 );
+      auto j_response = vil_plane( out_band, 1 );
 
-    // Add vertical and horizontal edge planes together and smooth
-    vil_math_image_sum( i_response,
-                        j_response,
-                        combined_response );
+      calculate_aligned_edges< pix_t >( in_band, i_response, j_response );
 
-    auto half_step = smoothing_half_step;
-    auto const min_dim = std::min( source_ni, source_nj );
+      // Perform extra op if enabled
+      if( produce_joint_output )
+      {
+        auto combined_response = vil_plane( out_band, 2 );
 
-    if( 2 * half_step + 1 >= min_dim )
-    {
-      half_step = ( min_dim - 1 ) / 2;
-    }
+        // Add vertical and horizontal edge planes together and smooth
+        for( unsigned j = 0; j < band_nj; ++j )
+        {
+          for( unsigned i = 0; i < source_ni; ++i )
+          {
+            combined_response( i, j ) = static_cast< pix_t >(
+              i_response( i, j ) + j_response( i, j ) );
+          }
+        }
+
+        if( half_step != 0 )
+        {
+          vil_image_view< pix_t > smoothed_response;
+          // Smooth the combined response
+          vil_gauss_filter_2d(
+            combined_response, smoothed_response, smoothing_sigma, half_step );
+          vil_copy_reformat( smoothed_response, combined_response );
+        }
+      }
+    } );
 
-    if( half_step != 0 )
-    {
-      vil_image_view< pix_t > smoothed_response;
-      // Smooth the combined response
-      vil_gauss_filter_2d(
-        combined_response, smoothed_response, smoothing_sigma, half_step );
-      combined_response.deep_copy( smoothed_response );
-    }
-  }
   return aligned_edges;
 }
 
@@ -15,8 +15,12 @@
 
 #include <deque>
 #include <exception>
+#include <limits>
 #include <map>
 #include <memory>
+#include <type_traits>
+
+#include <cstdint>
 
 namespace kwiver {
 
@@ -73,9 +77,30 @@ class online_frame_averager : public online_frame_averager_base
     vil_image_view< double >& variance );
 
 protected:
+  // Integer pixels are summed exactly in 64 bits, so that long running sums
+  // neither overflow nor drift; other pixels are summed in double precision
+  using sum_type =
+    typename std::conditional<
+      std::is_integral< PixType >::value && sizeof( PixType ) <= 4,
+      std::int64_t, double >::type;
+
   // Is the resolution of the input image different from prior inputs?
   bool has_resolution_changed( vil_image_view< PixType > const& input );
 
+  // Start the running sum with a single frame
+  void start_sum( vil_image_view< PixType > const& input );
+
+  // Add a frame to the running sum, and optionally remove an older one
+  void update_sum( vil_image_view< PixType > const& added,
+                   vil_image_view< PixType > const* removed = nullptr );
+
+  // Set the last average, and the output, to the running sum of count frames
+  // divided by count
+  void compute_average( size_t count, vil_image_view< PixType >& average );
+
+  // Running sum of the frames
+  vil_image_view< sum_type > sum_;
+
 private:
   // Temporary buffers used for variance calculations if they're enabled
   vil_image_view< double > dev1_tmp_space_;
@@ -198,6 +223,93 @@ ::has_resolution_changed( vil_image_view< PixType > const& input )
            input.nplanes() != this->last_average_.nplanes() );
 }
 
+// ----------------------------------------------------------------------------
+template < typename PixType >
+void
+online_frame_averager< PixType >
+::start_sum( vil_image_view< PixType > const& input )
+{
+  sum_.set_size( input.ni(), input.nj(), input.nplanes() );
+  sum_.fill( 0 );
+  this->update_sum( input );
+}
+
+// ----------------------------------------------------------------------------
+template < typename PixType >
+void
+online_frame_averager< PixType >
+::update_sum( vil_image_view< PixType > const& added,
+              vil_image_view< PixType > const* removed )
+{
+  auto const ni = sum_.ni();
+  auto const nj = sum_.nj();
+  auto const np = sum_.nplanes();
+
+  // The sum is allocated by set_size, so its pixels are contiguous with unit
+  // i step; only the frames may have other layouts
+  auto const istep_a = added.istep();
+  sum_type* pixel_s = sum_.top_left_ptr();
+  for( unsigned p = 0; p < np; ++p )
+  {
+    for( unsigned j = 0; j < nj; ++j, pixel_s += ni )
+    {
+      PixType const* pixel_a = &added( 0, j, p );
+      if( removed )
+      {
+        auto const istep_r = removed->istep();
+        PixType const* pixel_r = &( *removed )( 0, j, p );
+        for( unsigned i = 0; i < ni; ++i )
+        {
+          pixel_s[ i ] += static_cast< sum_type >( pixel_a[ i * istep_a ] ) -
+                          static_cast< sum_type >( pixel_r[ i * istep_r ] );
+        }
+      }
+      else
+      {
+        for( unsigned i = 0; i < ni; ++i )
+        {
+          pixel_s[ i ] += static_cast< sum_type >( pixel_a[ i * istep_a ] );
+        }
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+template < typename PixType >
+void
+online_frame_averager< PixType >
+::compute_average( size_t count, vil_image_view< PixType >& average )
+{
+  auto const ni = sum_.ni();
+  auto const nj = sum_.nj();
+  auto const np = sum_.nplanes();
+
+  this->last_average_.set_size( ni, nj, np );
+
+  // Allocate a completely new output image in case we are running in async
+  // mode
+  average = vil_image_view< PixType >{ ni, nj, np };
+
+  // All three images are allocated by set_size and so share one contiguous
+  // layout; compute the average and the output in one pass over them
+  auto const n = static_cast< size_t >( ni ) * nj * np;
+  auto const scale = 1.0 / static_cast< double >( count );
+  auto const round =
+    this->should_round_ && std::numeric_limits< PixType >::is_integer &&
+    !std::is_same< PixType, bool >::value;
+  sum_type const* pixel_s = sum_.top_left_ptr();
+  double* pixel_l = this->last_average_.top_left_ptr();
+  PixType* pixel_o = average.top_left_ptr();
+  for( size_t k = 0; k < n; ++k )
+  {
+    auto const value = static_cast< double >( pixel_s[ k ] ) * scale;
+    pixel_l[ k ] = value;
+    pixel_o[ k ] = static_cast< PixType >(
+      round ? ( value < 0 ? value - 0.5 : value + 0.5 ) : value );
+  }
+}
+
 // ----------------------------------------------------------------------------
 // Helper function to allocate a completely new image, and cast the input image
 // to whatever specified type the output image is, scaling by some factor if
@@ -257,27 +369,19 @@ ::process_frame( vil_image_view< PixType > const& input,
   // If this is the first frame observed or there was an indicated reset
   if( this->frame_count_ == 0 )
   {
-    vil_convert_cast( input, this->last_average_ );
+    this->start_sum( input );
   }
   // Standard update case
   else
   {
-    // Calculate new average - TODO: Non-exponential cumulative average can be
-    // modified to be more efficient and prevent precision losses by not using
-    // math_add_fraction function. Can also be optimized in the byte case to
-    // use integer instead of double operations, but it's good enough for now.
-    auto const scale_factor =
-      1.0 / static_cast< double >( this->frame_count_ + 1 );
-
-    vil_math_add_image_fraction( this->last_average_, 1.0 - scale_factor,
-                                 input, scale_factor );
+    this->update_sum( input );
   }
 
-  // Copy a completely new image
-  copy_cast( this->last_average_, average, this->should_round_ );
-
   // Increase observed frame count
   ++this->frame_count_;
+
+  // Compute a completely new image
+  this->compute_average( this->frame_count_, average );
 }
 
 // ----------------------------------------------------------------------------
@@ -366,86 +470,25 @@ ::process_frame( vil_image_view< PixType > const& input,
     this->reset();
   }
 
-  // Early exit cases: the buffer is currently filling
-  auto const window_buffer_size = window_buffer_.size();
-  if( window_buffer_size == 0 )
+  // Add the new frame to the running sum; once the buffer is full, the oldest
+  // frame leaves the window at the same time
+  if( window_buffer_.empty() )
   {
-    vil_convert_cast( input, this->last_average_ );
+    this->start_sum( input );
   }
-  else if( window_buffer_size < window_buffer_capacity_ )
+  else if( window_buffer_.size() < window_buffer_capacity_ )
   {
-    double src_weight =
-      1.0 / ( static_cast< double >( window_buffer_size ) + 1.0 );
-    vil_math_add_image_fraction( this->last_average_, 1.0 - src_weight, input,
-                                 src_weight );
+    this->update_sum( input );
   }
-  // Standard case, buffer is full
   else
   {
-    // Scan image subtracting the last frame, and adding the new one from
-    // the previous average
-    auto const ni = input.ni();
-    auto const nj = input.nj();
-    auto const np = input.nplanes();
-
-    // Image A = Removed Entry, B = Added Entry, C = The Average Calculation
-    auto const scale = 1.0 / static_cast< double >( window_buffer_size );
-
-    input_type const& tmpA = window_buffer_[ window_buffer_size - 1 ];
-    input_type const* imA = &tmpA;
-    input_type const* imB = &input;
-    vil_image_view< double >* imC = &( this->last_average_ );
-
-    auto istepA = imA->istep();
-    auto jstepA = imA->jstep();
-    auto pstepA = imA->planestep();
-    auto istepB = imB->istep();
-    auto jstepB = imB->jstep();
-    auto pstepB = imB->planestep();
-    auto istepC = imC->istep();
-    auto jstepC = imC->jstep();
-    auto pstepC = imC->planestep();
-
-    PixType const* planeA = imA->top_left_ptr();
-    PixType const* planeB = imB->top_left_ptr();
-    double*        planeC = imC->top_left_ptr();
-
-    for( unsigned p = 0; p < np;
-
-         ++p, planeA += pstepA, planeB += pstepB, planeC += pstepC )
-    {
-      PixType const* rowA = planeA;
-      PixType const* rowB = planeB;
-      double*        rowC = planeC;
-
-      for( unsigned j = 0; j < nj;
-
-           ++j, rowA += jstepA, rowB += jstepB, rowC += jstepC )
-      {
-        PixType const* pixelA = rowA;
-        PixType const* pixelB = rowB;
-        double*        pixelC = rowC;
-
-        for( unsigned i = 0; i < ni;
-             ++i, pixelA += istepA, pixelB += istepB, pixelC += istepC )
-        {
-          *pixelC += scale *
-                     ( static_cast< double >( *pixelB ) -
-                       static_cast< double >( *pixelA ) );
-        }
-      }
-    }
+    this->update_sum( input, &window_buffer_.front() );
+    window_buffer_.pop_front();
   }
+  window_buffer_.push_back( input );
 
-  // Add to buffer
-  this->window_buffer_.push_back( input );
-  if( this->window_buffer_.size() > this->window_buffer_capacity_ )
-  {
-    this->window_buffer_.pop_front();
-  }
-
-  // Copy into output
-  copy_cast( this->last_average_, average, this->should_round_ );
+  // Compute the output
+  this->compute_average( window_buffer_.size(), average );
 }
 
 // ----------------------------------------------------------------------------
@@ -502,7 +545,8 @@ class average_frames::priv
       {
         case AVERAGER_window:
         {
-          averager.reset( new windowed_frame_averager< PixType >{} );
+          averager.reset(
+            new windowed_frame_averager< PixType >{ round, window_size } );
           break;
         }
         case AVERAGER_cumulative:
@@ -10,12 +10,16 @@
 #include <vil/vil_convert.h>
 #include <vil/vil_image_view.h>
 #include <vil/vil_math.h>
+#include <vil/vil_pixel_format.h>
 #include <vil/vil_plane.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <limits>
 #include <random>
 #include <type_traits>
+#include <utility>
 
 namespace kwiver {
 
@@ -77,33 +81,21 @@ combine_channels( vil_image_view< Type > const& src,
 }
 
 // ----------------------------------------------------------------------------
+// Stretch an image so that the bounds map to the limits of the output type
 template < typename InputType, typename OutputType >
 void
 percentile_scale_image(
   vil_image_view< InputType > const& src, vil_image_view< OutputType >& dst,
-  double lower, double upper, unsigned sampling_points,
-  bool ignore_extremes = true )
+  InputType lower_bound, InputType upper_bound )
 {
-  std::vector< double > percentiles( 2, 0.0 );
-  percentiles[ 0 ] = lower;
-  percentiles[ 1 ] = upper;
-
-  std::vector< InputType > percentile_values =
-    get_image_percentiles( src, percentiles, sampling_points,
-                           ignore_extremes );
-
   OutputType max_val = std::numeric_limits< OutputType >::max();
 
-  InputType lower_bound = percentile_values[ 0 ];
-  InputType upper_bound = percentile_values[ 1 ];
-
   double scale;
 
-  if( percentile_values[ 1 ] - percentile_values[ 0 ] > 0 )
+  if( upper_bound - lower_bound > 0 )
   {
     scale = ( static_cast< double >( max_val ) + 0.5 ) /
-            static_cast< double >( percentile_values[ 1 ] -
-                                   percentile_values[ 0 ] );
+            static_cast< double >( upper_bound - lower_bound );
   }
   else
   {
@@ -150,6 +142,10 @@ class convert_image::priv
       , scale_factor{ 0.0 }
       , random_grayscale{ 0.0 }
       , percentile_norm{ -1.0 }
+      , percentile_sampling_points{ 100000000 }
+      , percentile_reuse_frames{ 0 }
+      , percentile_max_drift{ 0.0 }
+      , percentile_drift_sampling_points{ 10000 }
   {
   }
 
@@ -164,6 +160,11 @@ class convert_image::priv
   vil_image_view< ipix_t >
   apply_transforms( vil_image_view_base_sptr& view );
 
+  // Find the percentile normalization bounds, reusing recent ones
+  template < typename ipix_t >
+  std::pair< ipix_t, ipix_t >
+  percentile_bounds( vil_image_view< ipix_t > const& input );
+
   // Scale and convert the image
   template < typename opix_t, typename ipix_t >
   vil_image_view< opix_t >
@@ -174,6 +175,16 @@ class convert_image::priv
   double scale_factor;
   double random_grayscale;
   double percentile_norm;
+  unsigned percentile_sampling_points;
+  unsigned percentile_reuse_frames;
+  double percentile_max_drift;
+  unsigned percentile_drift_sampling_points;
+
+  // Percentile normalization bounds of a recent frame
+  vil_pixel_format bounds_format = VIL_PIXEL_FORMAT_UNKNOWN;
+  double bounds_lower = 0.0;
+  double bounds_upper = 0.0;
+  unsigned bounds_reused = 0;
 
   std::random_device random_device;
   std::mt19937 random_engine{ random_device() };
@@ -232,6 +243,52 @@ ::apply_transforms( vil_image_view_base_sptr& view )
   }
 }
 
+// ----------------------------------------------------------------------------
+template < typename ipix_t >
+std::pair< ipix_t, ipix_t >
+convert_image::priv
+::percentile_bounds( vil_image_view< ipix_t > const& input )
+{
+  std::vector< double > const percentiles{
+    percentile_norm, 1.0 - percentile_norm };
+  auto const format = vil_pixel_format_of( ipix_t{} );
+
+  if( bounds_format == format && bounds_reused < percentile_reuse_frames )
+  {
+    // Reuse the bounds unless a sparse estimate has drifted too far from them
+    auto drifted = false;
+    if( percentile_max_drift > 0.0 )
+    {
+      auto const estimate =
+        get_image_percentiles( input, percentiles,
+                               percentile_drift_sampling_points, true );
+      auto const limit = percentile_max_drift *
+                         std::max( bounds_upper - bounds_lower, 1.0 );
+      drifted =
+        std::abs( static_cast< double >( estimate[ 0 ] ) - bounds_lower ) >
+        limit ||
+        std::abs( static_cast< double >( estimate[ 1 ] ) - bounds_upper ) >
+        limit;
+    }
+
+    if( !drifted )
+    {
+      ++bounds_reused;
+      return { static_cast< ipix_t >( bounds_lower ),
+               static_cast< ipix_t >( bounds_upper ) };
+    }
+  }
+
+  auto const values =
+    get_image_percentiles( input, percentiles, percentile_sampling_points,
+                           true );
+  bounds_format = format;
+  bounds_lower = static_cast< double >( values[ 0 ] );
+  bounds_upper = static_cast< double >( values[ 1 ] );
+  bounds_reused = 0;
+  return { values[ 0 ], values[ 1 ] };
+}
+
 // ----------------------------------------------------------------------------
 template < typename opix_t, typename ipix_t >
 vil_image_view< opix_t >
@@ -241,8 +298,8 @@ ::scale_and_convert( vil_image_view< ipix_t > const& input )
   vil_image_view< opix_t > output;
   if( percentile_norm >= 0.0 )
   {
-    percentile_scale_image(
-      input, output, percentile_norm, 1.0 - percentile_norm, 1e8 );
+    auto const bounds = percentile_bounds( input );
+    percentile_scale_image( input, output, bounds.first, bounds.second );
   }
   else if( scale_factor == 0.0 || scale_factor == 1.0 )
   {
@@ -299,6 +356,26 @@ ::get_configuration() const
     "normalization such that the output image's min and max "
     "values correspond to the percentiles in the orignal "
     "image at this value and one minus this value, respectively." );
+  config->set_value(
+    "percentile_sampling_points", d->percentile_sampling_points,
+    "Number of pixels of each channel sampled to estimate the percentiles "
+    "for percentile normalization. All pixels are used if the image has "
+    "fewer." );
+  config->set_value(
+    "percentile_reuse_frames", d->percentile_reuse_frames,
+    "Number of frames after one whose percentiles are estimated that "
+    "reuse its normalization bounds instead of estimating their own. "
+    "This saves time on video, whose intensity changes slowly." );
+  config->set_value(
+    "percentile_max_drift", d->percentile_max_drift,
+    "If positive, frames reusing normalization bounds also estimate their "
+    "percentiles from percentile_drift_sampling_points pixels, and the "
+    "bounds are estimated again if that estimate has moved from them by "
+    "more than this fraction of the range between them." );
+  config->set_value(
+    "percentile_drift_sampling_points", d->percentile_drift_sampling_points,
+    "Number of pixels of each channel sampled to check the drift of reused "
+    "normalization bounds." );
 
   return config;
 }
@@ -320,6 +397,15 @@ ::set_configuration( vital::config_block_sptr in_config )
   d->scale_factor = config->get_value< double >( "scale_factor" );
   d->random_grayscale = config->get_value< double >( "random_grayscale" );
   d->percentile_norm = config->get_value< double >( "percentile_norm" );
+  d->percentile_sampling_points =
+    config->get_value< unsigned >( "percentile_sampling_points" );
+  d->percentile_reuse_frames =
+    config->get_value< unsigned >( "percentile_reuse_frames" );
+  d->percentile_max_drift =
+    config->get_value< double >( "percentile_max_drift" );
+  d->percentile_drift_sampling_points =
+    config->get_value< unsigned >( "percentile_drift_sampling_points" );
+  d->bounds_format = VIL_PIXEL_FORMAT_UNKNOWN;
 
   // Adjustment in case user specified 1% instead of 0.01
   if( d->percentile_norm >= 0.5 )
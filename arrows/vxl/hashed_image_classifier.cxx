@@ -4,6 +4,8 @@
 
 #include "hashed_image_classifier.h"
 
+#include "parallel_rows.h"
+
 #include <vital/range/iota.h>
 
 #include <vil/vil_plane.h>
@@ -66,36 +68,39 @@ ::classify_images( feature_vector_t const& input_features,
 
   output_image.set_size(
       input_features[ 0 ].ni(), input_features[ 0 ].nj() );
-  output_image.fill( offset );
-
-  std::vector< std::ptrdiff_t > sisteps( num_features );
-  std::vector< input_t const* > spixels( num_features );
-
-  for( auto const f : kvr::iota( num_features ) )
-  {
-    sisteps[ f ] = input_features[ f ].istep();
-  }
 
+  auto const ni = output_image.ni();
   auto const distep = output_image.istep();
-
-  for( auto const j : kvr::iota( output_image.nj() ) )
-  {
-    weight_t* dpixel = &output_image( 0, j );
-
-    for( auto const f : kvr::iota( num_features ) )
-    {
-      spixels[ f ] = &input_features[ f ]( 0, j );
-    }
-
-    for( unsigned i = 0; i < output_image.ni(); ++i, dpixel += distep )
-    {
-      for( auto const f : kvr::iota( num_features ) )
+  weight_t const* const* const feature_weights{
+    &model_->feature_weights[ 0 ] };
+
+  // Bands of rows are classified in parallel. Within each row, the weights
+  // of one feature at a time are added to the whole row, which stays in
+  // cache, so that the inner loop reads a single weight table and has no
+  // dependency between pixels.
+  for_each_row_band(
+    output_image.nj(),
+    [ & ]( unsigned j0, unsigned j1 ){
+      for( auto j = j0; j < j1; ++j )
       {
-        *dpixel += model_->feature_weights[ f ][ *spixels[ f ] ];
-        spixels[ f ] += sisteps[ f ];
+        weight_t* const drow = &output_image( 0, j );
+        for( unsigned i = 0; i < ni; ++i )
+        {
+          drow[ i * distep ] = offset;
+        }
+
+        for( auto const f : kvr::iota( num_features ) )
+        {
+          input_t const* const srow = &input_features[ f ]( 0, j );
+          auto const sistep = input_features[ f ].istep();
+          weight_t const* const weights = feature_weights[ f ];
+          for( unsigned i = 0; i < ni; ++i )
+          {
+            drow[ i * distep ] += weights[ srow[ i * sistep ] ];
+          }
+        }
       }
-    }
-  }
+    } );
 }
 
 // ----------------------------------------------------------------------------
@@ -122,26 +127,31 @@ ::classify_images( feature_vector_t const& input_features,
 
   output_image.set_size( input_features[ 0 ].ni(), input_features[ 0 ].nj() );
 
-  weight_t** const feature_weights{ &model_->feature_weights[ 0 ] };
+  weight_t const* const* const feature_weights{
+    &model_->feature_weights[ 0 ] };
 
-  for( unsigned j = 0; j < output_image.nj(); ++j )
-  {
-    for( unsigned i = 0; i < output_image.ni(); ++i )
-
-    {
-      if( mask( i, j ) )
+  // Bands of rows are classified in parallel
+  for_each_row_band(
+    output_image.nj(),
+    [ & ]( unsigned j0, unsigned j1 ){
+      for( auto j = j0; j < j1; ++j )
       {
-        weight_t& output{ output_image( i, j ) };
+        for( unsigned i = 0; i < output_image.ni(); ++i )
+        {
+          if( mask( i, j ) )
+          {
+            weight_t& output{ output_image( i, j ) };
 
-        output = offset;
+            output = offset;
 
-        for( unsigned f = 0; f < features; ++f )
-        {
-          output += feature_weights[ f ][ input_features[ f ]( i, j ) ];
+            for( unsigned f = 0; f < features; ++f )
+            {
+              output += feature_weights[ f ][ input_features[ f ]( i, j ) ];
+            }
+          }
         }
       }
-    }
-  }
+    } );
 }
 
 // ----------------------------------------------------------------------------
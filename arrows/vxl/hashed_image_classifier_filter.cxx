@@ -8,6 +8,7 @@
 #include <arrows/vxl/image_container.h>
 
 #include <vital/config/config_block_io.h>
+#include <vital/util/resource_cache.h>
 
 #include <vital/vital_config.h>
 
@@ -43,11 +44,13 @@ class hashed_image_classifier_filter::priv
   // Scale and convert the image
   bool load_model();
 
+  using classifier_t = hashed_image_classifier< vxl_byte, double >;
+
   hashed_image_classifier_filter* const p;
 
-  hashed_image_classifier< vxl_byte, double > hashed_classifier;
+  // Shared with every other filter using the same model file
+  std::shared_ptr< classifier_t const > hashed_classifier;
   double offset{ 0 };
-  bool model_loaded{ false };
 
   std::string model_file;
 };
@@ -57,7 +60,7 @@ bool
 hashed_image_classifier_filter::priv
 ::load_model()
 {
-  if( !model_loaded )
+  if( !hashed_classifier )
   {
     auto const& model_paths = vital::find_config_file( model_file );
     if( model_paths.empty() )
@@ -67,13 +70,24 @@ ::load_model()
       return false;
     }
 
-    if( !hashed_classifier.load_from_file( model_paths.front() ) )
+    auto const& path = model_paths.front();
+    hashed_classifier =
+      vital::resource_cache::instance().get< classifier_t >(
+        vital::resource_cache::file_key( path ),
+        [ & ]{
+          auto classifier = std::make_shared< classifier_t >();
+          if( !classifier->load_from_file( path ) )
+          {
+            classifier.reset();
+          }
+          return classifier;
+        } );
+    if( !hashed_classifier )
     {
       LOG_ERROR( p->logger(),
-                 "Could not load \"" << model_paths.front() << "\" model" );
+                 "Could not load \"" << path << "\" model" );
       return false;
     }
-    model_loaded = true;
   }
   return true;
 }
@@ -119,8 +133,12 @@ ::set_configuration( vital::config_block_sptr in_config )
   vital::config_block_sptr config = this->get_configuration();
   config->merge_config( in_config );
 
-  d->model_file =
-    config->get_value< std::string >( "model_file" );
+  auto const model_file = config->get_value< std::string >( "model_file" );
+  if( model_file != d->model_file )
+  {
+    d->model_file = model_file;
+    d->hashed_classifier.reset();
+  }
   d->offset =
     config->get_value< double >( "offset" );
 }
@@ -168,7 +186,7 @@ ::filter( kwiver::vital::image_container_sptr image_data )
 
   vil_image_view< double > weight_image;
 
-  d->hashed_classifier.classify_images( view, weight_image, d->offset );
+  d->hashed_classifier->classify_images( view, weight_image, d->offset );
 
   return std::make_shared< vxl::image_container >( weight_image );
 }
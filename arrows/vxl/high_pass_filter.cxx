@@ -4,12 +4,13 @@
 
 #include "high_pass_filter.h"
 
+#include "parallel_rows.h"
+
 #include <arrows/vxl/image_container.h>
 #include <vital/util/enum_converter.h>
 
 #include <vil/vil_convert.h>
 #include <vil/vil_image_view.h>
-#include <vil/vil_math.h>
 #include <vil/vil_plane.h>
 #include <vil/vil_transpose.h>
 
@@ -69,6 +70,81 @@ template <>
 struct accumulator< double >
 { using type = double; };
 
+// ----------------------------------------------------------------------------
+template < typename PixType >
+inline PixType
+abs_difference( PixType a, PixType b )
+{
+  return ( a > b ? a - b : b - a );
+}
+
+// ----------------------------------------------------------------------------
+// Force a kernel width to be smaller than the image width and odd
+inline unsigned
+limit_kernel_width( unsigned kernel_width, unsigned ni )
+{
+  if( kernel_width >= ni )
+  {
+    return ( ni == 1 ? 1 : ( ni - 2 ) | 0x01 );
+  }
+  return kernel_width;
+}
+
+// ----------------------------------------------------------------------------
+// Fast 1D box filter smoothing of one row of ni pixels
+template < typename PixType >
+void
+box_average_row( PixType const* rowS, std::ptrdiff_t istepS,
+                 PixType* rowD, std::ptrdiff_t istepD,
+                 unsigned ni, unsigned kernel_width )
+{
+  auto const half_width = kernel_width / 2;
+
+  PixType const* pixelS1 = rowS;
+  PixType const* pixelS2 = rowS;
+  PixType*       pixelD = rowD;
+
+  // fast box filter smoothing by adding one pixel to the sum and
+  // subtracting another pixel at each step
+  using accumulator_t = typename accumulator< PixType >::type;
+
+  auto const kw = static_cast< accumulator_t >( kernel_width );
+  accumulator_t sum = 0;
+  unsigned i = 0;
+
+  // initialize the sum for half the kernel width
+  for(; i <= half_width; ++i, pixelS2 += istepS )
+  {
+    sum += *pixelS2;
+  }
+
+  // starting boundary case: the kernel width is expanding
+  for(; i < kernel_width; ++i, pixelS2 += istepS, pixelD += istepD )
+  {
+    *pixelD =
+      static_cast< PixType >( sum / static_cast< accumulator_t >( i ) );
+    sum += *pixelS2;
+  }
+
+  // general case: add the leading edge and remove the trailing edge.
+  for(; i < ni;
+      ++i, pixelS1 += istepS, pixelS2 += istepS, pixelD += istepD )
+  {
+    *pixelD = static_cast< PixType >( sum / kw );
+    sum -= *pixelS1;
+    sum += *pixelS2;
+  }
+
+  // ending boundary case: the kernel is shrinking
+  for( i = kernel_width; i > half_width;
+       --i, pixelS1 += istepS, pixelD += istepD )
+  {
+    *pixelD =
+      static_cast< PixType >( sum / static_cast< accumulator_t >( i ) );
+    sum -= *pixelS1;
+  }
+}
+
 } // namespace <anonymous>
 
 // ----------------------------------------------------------------------------
@@ -148,18 +224,33 @@ ::box_high_pass_filter( vil_image_view< PixType > const& grey_img )
   vil_image_view< PixType > filter_y = vil_plane( output, 1 );
   vil_image_view< PixType > filter_xy = vil_plane( output, 2 );
 
-  box_average_horizontal( grey_img, filter_x, kernel_width );
   box_average_vertical( grey_img, filter_y, kernel_height );
 
-  // Apply horizontal smoothing to the vertically smoothed image to get a 2D
-  // box filter
-  box_average_horizontal( filter_y, filter_xy, kernel_width );
-
-  // Report the difference between the pixel value and all of the smoothed
-  // responses
-  vil_math_image_abs_difference( grey_img, filter_x, filter_x );
-  vil_math_image_abs_difference( grey_img, filter_y, filter_y );
-  vil_math_image_abs_difference( grey_img, filter_xy, filter_xy );
+  auto const ni = grey_img.ni();
+  auto const kw = limit_kernel_width( kernel_width, ni );
+
+  // Apply horizontal smoothing to the image and to the vertically smoothed
+  // image to get a 2D box filter, and report the difference between the
+  // pixel value and all of the smoothed responses, one row at a time while
+  // the row is in cache
+  for_each_row_band(
+    grey_img.nj(),
+    [ & ]( unsigned j0, unsigned j1 ){
+      for( unsigned j = j0; j < j1; ++j )
+      {
+        box_average_row( &grey_img( 0, j ), grey_img.istep(),
+                         &filter_x( 0, j ), filter_x.istep(), ni, kw );
+        box_average_row( &filter_y( 0, j ), filter_y.istep(),
+                         &filter_xy( 0, j ), filter_xy.istep(), ni, kw );
+        for( unsigned i = 0; i < ni; ++i )
+        {
+          auto const val = grey_img( i, j );
+          filter_x( i, j ) = abs_difference( val, filter_x( i, j ) );
+          filter_y( i, j ) = abs_difference( val, filter_y( i, j ) );
+          filter_xy( i, j ) = abs_difference( val, filter_xy( i, j ) );
+        }
+      }
+    } );
 
   return output;
 }
@@ -185,23 +276,22 @@ ::horizontal_box_bidirectional_pass( vil_image_view< PixType > const& grey,
 
   output.fill( 0 );
 
-  PixType diff1 = 0;
-  PixType diff2 = 0;
-
-  for( unsigned j = 0; j < nj; ++j )
-  {
-    for( unsigned i = offset; i < ni - offset; ++i )
-    {
-      PixType const& val = grey( i, j );
-      PixType const& avg1 = smoothed( i - offset, j );
-      PixType const& avg2 = smoothed( i + offset, j );
-
-      diff1 = ( val > avg1 ? val - avg1 : avg1 - val );
-      diff2 = ( val > avg2 ? val - avg2 : avg2 - val );
-
-      output( i, j ) = std::min( diff1, diff2 );
-    }
-  }
+  for_each_row_band(
+    nj,
+    [ & ]( unsigned j0, unsigned j1 ){
+      for( unsigned j = j0; j < j1; ++j )
+      {
+        for( unsigned i = offset; i < ni - offset; ++i )
+        {
+          PixType const& val = grey( i, j );
+          PixType const& avg1 = smoothed( i - offset, j );
+          PixType const& avg2 = smoothed( i + offset, j );
+
+          output( i, j ) = std::min( abs_difference( val, avg1 ),
+                                     abs_difference( val, avg2 ) );
+        }
+      }
+    } );
 }
 
 // ----------------------------------------------------------------------------
@@ -243,7 +333,18 @@ ::bidirection_box_filter( vil_image_view< PixType > const& grey_img )
   box_average_horizontal( grey_img, filter_xy, kernel_width );
   vertical_box_bidirectional_pass( grey_img, filter_xy, filter_y,
                                    kernel_height );
-  vil_math_image_max( filter_x, filter_y, filter_xy );
+
+  for_each_row_band(
+    grey_img.nj(),
+    [ & ]( unsigned j0, unsigned j1 ){
+      for( unsigned j = j0; j < j1; ++j )
+      {
+        for( unsigned i = 0; i < grey_img.ni(); ++i )
+        {
+          filter_xy( i, j ) = std::max( filter_x( i, j ), filter_y( i, j ) );
+        }
+      }
+    } );
 
   return output;
 }
@@ -289,11 +390,7 @@ ::box_average_horizontal( vil_image_view< PixType > const& src,
     LOG_ERROR( p->logger(), "Kernel width must be odd" );
   }
 
-  if( kernel_width >= src.ni() )
-  {
-    // Force width to be smaller than image width and odd
-    kernel_width = ( src.ni() == 1 ? 1 : ( src.ni() - 2 ) | 0x01 );
-  }
+  kernel_width = limit_kernel_width( kernel_width, src.ni() );
 
   auto const ni = src.ni();
   auto const nj = src.nj();
@@ -301,69 +398,17 @@ ::box_average_horizontal( vil_image_view< PixType > const& src,
 
   dst.set_size( ni, nj, np );
 
-  auto const half_width = kernel_width / 2;
-
-  auto const istepS = src.istep();
-  auto const jstepS = src.jstep();
-  auto const pstepS = src.planestep();
-  auto const istepD = dst.istep();
-  auto const jstepD = dst.jstep();
-  auto const pstepD = dst.planestep();
-
-  PixType const* planeS = src.top_left_ptr();
-  PixType* planeD = dst.top_left_ptr();
-
-  for( unsigned p = 0; p < np; ++p, planeS += pstepS, planeD += pstepD )
+  for( unsigned p = 0; p < np; ++p )
   {
-    PixType const* rowS = planeS;
-    PixType*       rowD = planeD;
-
-    for( unsigned j = 0; j < nj; ++j, rowS += jstepS, rowD += jstepD )
-    {
-      PixType const* pixelS1 = rowS;
-      PixType const* pixelS2 = rowS;
-      PixType*       pixelD = rowD;
-
-      // fast box filter smoothing by adding one pixel to the sum and
-      // subtracting another pixel at each step
-      using accumulator_t = typename accumulator< PixType >::type;
-
-      auto const kw = static_cast< accumulator_t >( kernel_width );
-      accumulator_t sum = 0;
-      unsigned i = 0;
-
-      // initialize the sum for half the kernel width
-      for(; i <= half_width; ++i, pixelS2 += istepS )
-      {
-        sum += *pixelS2;
-      }
-
-      // starting boundary case: the kernel width is expanding
-      for(; i < kernel_width; ++i, pixelS2 += istepS, pixelD += istepD )
-      {
-        *pixelD =
-          static_cast< PixType >( sum / static_cast< accumulator_t >( i ) );
-        sum += *pixelS2;
-      }
-
-      // general case: add the leading edge and remove the trailing edge.
-      for(; i < ni;
-          ++i, pixelS1 += istepS, pixelS2 += istepS, pixelD += istepD )
-      {
-        *pixelD = static_cast< PixType >( sum / kw );
-        sum -= *pixelS1;
-        sum += *pixelS2;
-      }
-
-      // ending boundary case: the kernel is shrinking
-      for( i = kernel_width; i > half_width;
-           --i, pixelS1 += istepS, pixelD += istepD )
-      {
-        *pixelD =
-          static_cast< PixType >( sum / static_cast< accumulator_t >( i ) );
-        sum -= *pixelS1;
-      }
-    }
+    for_each_row_band(
+      nj,
+      [ & ]( unsigned j0, unsigned j1 ){
+        for( unsigned j = j0; j < j1; ++j )
+        {
+          box_average_row( &src( 0, j, p ), src.istep(),
+                           &dst( 0, j, p ), dst.istep(), ni, kernel_width );
+        }
+      } );
   }
 }
 
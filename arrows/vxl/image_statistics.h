@@ -4,6 +4,7 @@
 #include <vil/vil_image_view.h>
 
 #include <vital/range/iota.h>
+#include <vital/util/thread_pool.h>
 
 #include <vil/algo/vil_threshold.h>
 #include <vil/vil_image_view.h>
@@ -11,100 +12,236 @@
 
 #include <algorithm>
 #include <limits>
+#include <numeric>
+#include <type_traits>
 #include <vector>
 
 // ----------------------------------------------------------------------------
-// Calculate the values of our image percentiles from x sampling points
+// The points sampled from an image to estimate its percentiles
+//
+// Up to sampling_points pixels are sampled from each plane, at a fixed step
+// through the image.
 template < typename PixType >
-std::vector< PixType >
-sample_and_sort_image( vil_image_view< PixType > const& src,
-                       unsigned int sampling_points,
-                       bool remove_extremes )
+class image_sampler
 {
-  if( src.ni() * src.nj() < sampling_points )
+public:
+  image_sampler( vil_image_view< PixType > const& src,
+                 unsigned sampling_points )
+    : src_( src ),
+      sampling_points_(
+        std::min< size_t >( sampling_points,
+                            static_cast< size_t >( src.ni() ) * src.nj() ) ),
+      pixel_step_( sampling_points_ ? src.size() / sampling_points_ : 0 )
   {
-    sampling_points = src.ni() * src.nj();
   }
 
-  std::vector< PixType > dst;
+  // Return the number of samples over all planes
+  size_t size() const { return sampling_points_ * src_.nplanes(); }
 
-  if( sampling_points == 0 )
+  // Return sample n
+  PixType operator[]( size_t n ) const
   {
-    return dst;
+    auto const position = n * pixel_step_;
+    return src_( static_cast< unsigned >( position % src_.ni() ),
+                 static_cast< unsigned >( ( position / src_.ni() ) %
+                                          src_.nj() ),
+                 static_cast< unsigned >( n / sampling_points_ ) );
   }
 
-  auto const scanning_area = src.size();
-  auto const ni = src.ni();
-  auto const nj = src.nj();
-  auto const np = src.nplanes();
-  auto const pixel_step =
-    static_cast< unsigned >( scanning_area / sampling_points );
-
-  dst.reserve( sampling_points * np );
-
-  unsigned position = 0;
-
-  for( unsigned p = 0; p < np; ++p )
+  // Return a chunk size that splits the samples among the thread pool
+  size_t chunk_size( size_t min_size ) const
   {
-    for( unsigned s = 0; s < sampling_points; ++s, position += pixel_step )
-    {
-      unsigned i = position % ni;
-      unsigned j = ( position / ni ) % nj;
-      dst.push_back( src( i, j, p ) );
-    }
+    auto const threads = kwiver::vital::thread_pool::instance().num_threads();
+    return std::max( min_size, size() / ( threads + 1 ) + 1 );
   }
 
-  std::sort( dst.begin(), dst.end() );
+private:
+  vil_image_view< PixType > const& src_;
+  size_t sampling_points_;
+  size_t pixel_step_;
+};
+
+// ----------------------------------------------------------------------------
+// Calculate the values of our image percentiles from x sampling points
+template < typename PixType >
+std::vector< PixType >
+sample_and_sort_image( vil_image_view< PixType > const& src,
+                       unsigned int sampling_points,
+                       bool remove_extremes )
+{
+  image_sampler< PixType > const sampler{ src, sampling_points };
+  std::vector< PixType > dst( sampler.size() );
+
+  auto& pool = kwiver::vital::thread_pool::instance();
+  pool.parallel_for(
+    dst.size(), sampler.chunk_size( 1 << 16 ),
+    [ & ]( size_t begin, size_t end ){
+      for( auto n = begin; n < end; ++n )
+      {
+        dst[ n ] = sampler[ n ];
+      }
+    } );
+  pool.parallel_sort( dst.begin(), dst.end() );
 
   if( remove_extremes )
   {
     constexpr auto low = PixType{ 0 };
+    constexpr auto high = std::numeric_limits< PixType >::max();
 
-    while( !dst.empty() && dst.front() == low )
+    auto first = dst.begin();
+    while( first != dst.end() && *first == low )
     {
-      dst.erase( dst.begin() );
+      ++first;
     }
 
-    constexpr auto high = std::numeric_limits< PixType >::max();
-
-    while( !dst.empty() && dst.back() == high )
+    auto last = dst.end();
+    while( last != first && *( last - 1 ) == high )
     {
-      dst.pop_back();
+      --last;
     }
+
+    dst.erase( last, dst.end() );
+    dst.erase( dst.begin(), first );
   }
   return dst;
 }
 
 // ----------------------------------------------------------------------------
-// Estimate the pixel values at given percentiles using a subset of points
+// Find the index into the sorted samples of a percentile
+inline size_t
+percentile_index( size_t samples, double percentile )
+{
+  // Find the index by multiplying the number of points by the percentile
+  // The number is adjusted by -1 to account for the fact that percentiles
+  // are the number which fall below a value. The +0.5 is to account for
+  // truncation by static cast.
+  return static_cast< size_t >(
+    static_cast< double >( samples - 1 ) * percentile + 0.5 );
+}
+
+// ----------------------------------------------------------------------------
+// Estimate percentiles by sorting the samples, for any pixel type
 template < typename PixType >
 std::vector< PixType >
 get_image_percentiles(
   vil_image_view< PixType > const& src,
   std::vector< double > const& percentiles,
-  unsigned sampling_points, bool remove_extremes = false )
+  unsigned sampling_points, bool remove_extremes, std::false_type )
 {
   std::vector< PixType > sorted_samples =
     sample_and_sort_image( src, sampling_points, remove_extremes );
 
   std::vector< PixType > dst( percentiles.size() );
-  double sampling_points_minus1 =
-    static_cast< double >( sorted_samples.size() - 1 );
+  if( sorted_samples.empty() )
+  {
+    return dst;
+  }
 
   for( auto const i : kwiver::vital::range::iota( percentiles.size() ) )
   {
-    // Find the index by multiplying the number of points by the percentile
-    // The number is adjusted by -1 to account for the fact that percentiles
-    // are the number which fall below a value. The +0.5 is to account for
-    // truncation by static cast.
-    auto ind =
-      static_cast< size_t >(
-        sampling_points_minus1 * percentiles[ i ] + 0.5 );
-    dst[ i ] = sorted_samples[ ind ];
+    dst[ i ] =
+      sorted_samples[ percentile_index( sorted_samples.size(),
+                                        percentiles[ i ] ) ];
   }
   return dst;
 }
 
+// ----------------------------------------------------------------------------
+// Estimate percentiles from a histogram of the samples, for pixel types of
+// at most 16 bits
+//
+// This gives the same values as sorting the samples, in linear time.
+template < typename PixType >
+std::vector< PixType >
+get_image_percentiles(
+  vil_image_view< PixType > const& src,
+  std::vector< double > const& percentiles,
+  unsigned sampling_points, bool remove_extremes, std::true_type )
+{
+  using histogram_t = std::vector< size_t >;
+  constexpr long low = std::numeric_limits< PixType >::min();
+  constexpr long high = std::numeric_limits< PixType >::max();
+  auto const bins = static_cast< size_t >( high - low + 1 );
+
+  image_sampler< PixType > const sampler{ src, sampling_points };
+  auto histogram = kwiver::vital::thread_pool::instance().parallel_reduce(
+    sampler.size(), sampler.chunk_size( 1 << 16 ), histogram_t{},
+    [ & ]( size_t begin, size_t end ){
+      histogram_t h( bins, 0 );
+      for( auto n = begin; n < end; ++n )
+      {
+        ++h[ static_cast< size_t >( static_cast< long >( sampler[ n ] ) -
+                                    low ) ];
+      }
+      return h;
+    },
+    []( histogram_t a, histogram_t b ){
+      if( a.size() < b.size() )
+      {
+        std::swap( a, b );
+      }
+      for( auto const i : kwiver::vital::range::iota( b.size() ) )
+      {
+        a[ i ] += b[ i ];
+      }
+      return a;
+    } );
+
+  std::vector< PixType > dst( percentiles.size() );
+  if( histogram.empty() )
+  {
+    return dst;
+  }
+
+  if( remove_extremes )
+  {
+    // as when sorting, zero is removed only if it is the lowest value
+    auto const zero = static_cast< size_t >( -low );
+    if( std::all_of( histogram.begin(), histogram.begin() + zero,
+                     []( size_t count ){ return count == 0; } ) )
+    {
+      histogram[ zero ] = 0;
+    }
+    histogram.back() = 0;
+  }
+
+  std::partial_sum( histogram.begin(), histogram.end(), histogram.begin() );
+  auto const samples = histogram.back();
+  if( samples == 0 )
+  {
+    return dst;
+  }
+
+  for( auto const i : kwiver::vital::range::iota( percentiles.size() ) )
+  {
+    auto const bin = std::upper_bound(
+      histogram.begin(), histogram.end(),
+      percentile_index( samples, percentiles[ i ] ) );
+    dst[ i ] = static_cast< PixType >( low + ( bin - histogram.begin() ) );
+  }
+  return dst;
+}
+
+// ----------------------------------------------------------------------------
+// Estimate the pixel values at given percentiles using a subset of points
+//
+// The samples are taken in parallel. Percentiles of pixel types of at most
+// 16 bits are found from a histogram of the samples, and those of other
+// types by sorting them. If every sample is removed as an extreme, the
+// percentiles are all zero.
+template < typename PixType >
+std::vector< PixType >
+get_image_percentiles(
+  vil_image_view< PixType > const& src,
+  std::vector< double > const& percentiles,
+  unsigned sampling_points, bool remove_extremes = false )
+{
+  using use_histogram = std::integral_constant< bool,
+    std::is_integral< PixType >::value && sizeof( PixType ) <= 2 >;
+  return get_image_percentiles( src, percentiles, sampling_points,
+                                remove_extremes, use_histogram{} );
+}
+
 // ----------------------------------------------------------------------------
 // Resultant image is true where pixel is greater than a percentile threshold
 template < typename PixType >
@@ -4,6 +4,8 @@
 
 #include "morphology.h"
 
+#include "parallel_rows.h"
+
 #include <arrows/vxl/image_container.h>
 
 #include <vital/util/enum_converter.h>
@@ -16,7 +18,10 @@
 #include <vil/algo/vil_binary_opening.h>
 #include <vil/algo/vil_structuring_element.h>
 #include <vil/vil_plane.h>
-#include <vil/vil_transform.h>
+
+#include <algorithm>
+
+#include <cstdlib>
 
 namespace kwiver {
 
@@ -95,6 +100,9 @@ class morphology::priv
                          vil_image_view< bool >& output,
                          morphology_func_t func );
 
+  // Number of rows away from a pixel the operation reads
+  unsigned halo() const;
+
   // Perform a morphological operation and optionally combine across channels
   vil_image_view< bool >
   perform_morphological_operations( vil_image_view< bool > const& input );
@@ -193,6 +201,20 @@ ::apply_morphology( vil_image_view< bool > const& input,
   }
 }
 
+// ----------------------------------------------------------------------------
+unsigned
+morphology::priv
+::halo() const
+{
+  auto const reach = static_cast< unsigned >(
+    std::max( std::abs( morphological_element.min_j() ),
+              std::abs( morphological_element.max_j() ) ) );
+
+  // Opening and closing apply the element twice
+  return ( morphology_type == MORPHOLOGY_open ||
+           morphology_type == MORPHOLOGY_close ) ? 2 * reach : reach;
+}
+
 // ----------------------------------------------------------------------------
 vil_image_view< bool >
 morphology::priv
@@ -200,29 +222,47 @@ ::perform_morphological_operations( vil_image_view< bool > const& input )
 {
   setup_internals();
 
-  vil_image_view< bool > output{ input.ni(), input.nj(), input.nplanes() };
-
-  apply_morphology( input, output );
-
-  if( combine_type == COMBINE_none )
-  {
-    // Don't combine across channels
-    return output;
-  }
+  auto const combine = ( combine_type != COMBINE_none );
+  vil_image_view< bool > output{ input.ni(), input.nj(),
+                                 combine ? 1 : input.nplanes() };
 
   // Select whether to do pixel-wise union or intersection
-  auto functor =
+  auto const functor =
     ( combine_type == COMBINE_union
       ? union_functor : intersection_functor );
 
-  auto accumulator = vil_plane( output, 0 );
-  for( unsigned i = 1; i < output.nplanes(); ++i )
-  {
-    auto current_plane = vil_plane( output, i );
-    // Union or intersect the current plane with the accumulator
-    vil_transform( accumulator, current_plane, accumulator, functor );
-  }
-  return accumulator;
+  // Filter bands of rows in parallel, combining across channels while each
+  // band is still in cache
+  filter_row_bands(
+    input, output, halo(),
+    [ & ]( vil_image_view< bool > const& in_band,
+           vil_image_view< bool >& out_band, unsigned ){
+      vil_image_view< bool > filtered{ in_band.ni(), in_band.nj(),
+                                       in_band.nplanes() };
+      apply_morphology( in_band, filtered );
+
+      if( !combine )
+      {
+        // Don't combine across channels
+        out_band = filtered;
+        return;
+      }
+
+      out_band.deep_copy( vil_plane( filtered, 0 ) );
+      for( unsigned p = 1; p < filtered.nplanes(); ++p )
+      {
+        for( unsigned j = 0; j < filtered.nj(); ++j )
+        {
+          for( unsigned i = 0; i < filtered.ni(); ++i )
+          {
+            // Union or intersect the current plane with the accumulator
+            out_band( i, j ) = functor( out_band( i, j ), filtered( i, j, p ) );
+          }
+        }
+      }
+    } );
+
+  return output;
 }
 
 // ----------------------------------------------------------------------------
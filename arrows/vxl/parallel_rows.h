@@ -0,0 +1,114 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_ARROWS_VXL_PARALLEL_ROWS_H_
+#define KWIVER_ARROWS_VXL_PARALLEL_ROWS_H_
+
+#include <vital/util/thread_pool.h>
+
+#include <vil/vil_copy.h>
+#include <vil/vil_image_view.h>
+
+#include <algorithm>
+
+namespace kwiver {
+
+namespace arrows {
+
+namespace vxl {
+
+// ----------------------------------------------------------------------------
+// View rows [j0, j0 + rows) of an image without sharing its memory chunk.
+//
+// The reference count of a vil memory chunk is not safe to change from
+// several threads, so views handed to worker threads point at the pixels
+// directly. The image must outlive the view.
+template < typename PixType >
+vil_image_view< PixType >
+row_band( vil_image_view< PixType > const& image, unsigned j0, unsigned rows )
+{
+  return vil_image_view< PixType >{
+    image.top_left_ptr() + static_cast< std::ptrdiff_t >( j0 ) * image.jstep(),
+    image.ni(), rows, image.nplanes(),
+    image.istep(), image.jstep(), image.planestep() };
+}
+
+// ----------------------------------------------------------------------------
+// Call f( j0, j1 ) over bands of rows [j0, j1) of an image of nj rows.
+//
+// The bands are processed in parallel on the vital thread pool and are all
+// at least min_rows tall, unless the image itself is shorter.
+template < typename F >
+void
+for_each_row_band( unsigned nj, F const& f, unsigned min_rows = 16 )
+{
+  if( nj == 0 )
+  {
+    return;
+  }
+
+  auto& pool = vital::thread_pool::instance();
+  unsigned const max_bands =
+    static_cast< unsigned >( 4 * ( pool.num_threads() + 1 ) );
+  unsigned const bands =
+    std::max( 1u, std::min( max_bands, nj / std::max( 1u, min_rows ) ) );
+  if( bands == 1 )
+  {
+    f( 0u, nj );
+    return;
+  }
+
+  // split the rows evenly so that no band is much shorter than the others
+  pool.parallel_for(
+    bands, 1,
+    [ & ]( size_t begin, size_t end ){
+      for( auto b = begin; b < end; ++b )
+      {
+        f( static_cast< unsigned >( b * nj / bands ),
+           static_cast< unsigned >( ( b + 1 ) * nj / bands ) );
+      }
+    } );
+}
+
+// ----------------------------------------------------------------------------
+// Apply a filter to bands of rows of an image in parallel.
+//
+// The filter is called as f( input_band, output_band, first_row ), where
+// input_band holds the rows of a band of the input, extended by up to halo
+// rows on each side, first_row is the row of the input it starts at, and
+// output_band is an empty image to fill with a result of the same size.
+// The rows of the result for the band itself are copied to output, which
+// must already have its final size. So for a filter which reads at most
+// halo rows away, such as a convolution or a morphological operation, the
+// result matches filtering the whole image.
+template < typename InType, typename OutType, typename F >
+void
+filter_row_bands( vil_image_view< InType > const& input,
+                  vil_image_view< OutType >& output,
+                  unsigned halo, F const& f )
+{
+  auto const nj = input.nj();
+  for_each_row_band(
+    nj,
+    [ & ]( unsigned j0, unsigned j1 ){
+      auto const start = ( j0 > halo ? j0 - halo : 0u );
+      auto const stop = std::min( nj, j1 + halo );
+
+      vil_image_view< OutType > result;
+      f( row_band( input, start, stop - start ), result, start );
+
+      auto const kept = row_band( result, j0 - start, j1 - j0 );
+      auto dest = row_band( output, j0, j1 - j0 );
+      vil_copy_reformat( kept, dest );
+    },
+    std::max( 16u, 4 * halo ) );
+}
+
+} // namespace vxl
+
+} // namespace arrows
+
+} // namespace kwiver
+
+#endif
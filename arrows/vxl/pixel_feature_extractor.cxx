@@ -13,7 +13,9 @@
 #include <arrows/vxl/image_container.h>
 
 #include <vital/config/config_block_io.h>
+#include <vital/types/image_container.h>
 #include <vital/range/iota.h>
+#include <vital/util/thread_pool.h>
 
 #include <vil/vil_clamp.h>
 #include <vil/vil_convert.h>
@@ -21,10 +23,14 @@
 #include <vil/vil_math.h>
 #include <vil/vil_plane.h>
 
-#include <cstdlib>
+#include <exception>
+#include <functional>
 #include <limits>
+#include <mutex>
 #include <type_traits>
 
+#include <cstdlib>
+
 namespace kwiver {
 
 namespace arrows {
@@ -236,6 +242,48 @@ convert_to_typed_vil_image_view(
   return vil_convert_cast( pix_t(), vxl_image_ptr );
 }
 
+// ----------------------------------------------------------------------------
+// Image memory borrowed from another image
+//
+// Views converted to vil from an image backed by a vil memory chunk share the
+// reference count of that chunk, which is not safe to change from several
+// threads at once. Wrapping the memory in this class makes each conversion
+// create a new chunk instead.
+class borrowed_image_memory : public vital::image_memory
+{
+public:
+  borrowed_image_memory( vital::image_memory_sptr memory )
+    : memory_{ memory }
+  {
+    size_ = memory_->size();
+  }
+
+  // Return a pointer to the borrowed memory
+  void* data() override { return memory_->data(); }
+
+private:
+  vital::image_memory_sptr memory_;
+};
+
+// ----------------------------------------------------------------------------
+// Create a view of an image which may be converted to vil in another thread
+vital::image_container_sptr
+isolated_view( vital::image_container_sptr const& input_image )
+{
+  auto const image = input_image->get_image();
+  if( !image.memory() )
+  {
+    return std::make_shared< vital::simple_image_container >( image );
+  }
+
+  return std::make_shared< vital::simple_image_container >(
+    vital::image{
+      std::make_shared< borrowed_image_memory >( image.memory() ),
+      image.first_pixel(), image.width(), image.height(), image.depth(),
+      image.w_step(), image.h_step(), image.d_step(),
+      image.pixel_traits() } );
+}
+
 // ----------------------------------------------------------------------------
 template < typename pix_t >
 vil_image_view< pix_t >
@@ -244,81 +292,151 @@ ::filter( kwiver::vital::image_container_sptr input_image )
 {
   ++frame_number;
 
-  std::vector< vil_image_view< pix_t > > filtered_images;
-
+  // The features computed by separate filters are independent of each other,
+  // so they are computed in parallel; each filter is a separate instance
+  // which is only used by one job
+  vil_image_view< pix_t > color, gray, color_commonality, high_pass_box,
+                          high_pass_bidir, aligned_edge;
   vil_image_view< double > double_variance;
+  using job_t = std::function< void ( vital::image_container_sptr const& ) >;
+  std::vector< job_t > jobs;
 
   if( enable_color )
   {
-    // 3 channels
-    filtered_images.push_back(
-      convert_to_typed_vil_image_view< pix_t >( input_image ) );
+    jobs.push_back( [ & ]( vital::image_container_sptr const& image ){
+      color = convert_to_typed_vil_image_view< pix_t >( image );
+    } );
   }
 
   // These three features require processing the vil_image directly
   if( enable_gray || enable_average || enable_normalized_variance )
   {
-    auto input_image_sptr =
-      vxl::image_container::vital_to_vxl( input_image->get_image() );
+    jobs.push_back( [ & ]( vital::image_container_sptr const& image ){
+      auto input_image_sptr =
+        vxl::image_container::vital_to_vxl( image->get_image() );
+
+      if( input_image_sptr->nplanes() == 3 )
+      {
+        input_image_sptr = vil_convert_to_grey_using_rgb_weighting(
+          input_image_sptr );
+      }
+      else
+      {
+        input_image_sptr =
+          vil_convert_to_grey_using_average( input_image_sptr );
+      }
+
+      auto const double_gray = static_cast< vil_image_view< double > >(
+        vil_convert_cast( double{}, input_image_sptr ) );
+
+      if( enable_average || enable_normalized_variance )
+      {
+        auto gray_container =
+          std::make_shared< vxl::image_container >( double_gray );
+        double_variance = convert_to_typed_vil_image_view< double >(
+          average_frames_filter->filter( gray_container ) );
+      }
+
+      if( enable_gray )
+      {
+        gray = clamping_cast< pix_t >( double_gray );
+      }
+    } );
+  }
 
-    if( input_image_sptr->nplanes() == 3 )
-    {
-      input_image_sptr = vil_convert_to_grey_using_rgb_weighting(
-        input_image_sptr );
-    }
-    else
-    {
-      input_image_sptr = vil_convert_to_grey_using_average( input_image_sptr );
-    }
+  if( enable_color_commonality )
+  {
+    jobs.push_back( [ & ]( vital::image_container_sptr const& image ){
+      color_commonality = convert_to_typed_vil_image_view< pix_t >(
+        color_commonality_filter->filter( image ) );
+    } );
+  }
+  if( enable_high_pass_box )
+  {
+    jobs.push_back( [ & ]( vital::image_container_sptr const& image ){
+      high_pass_box = convert_to_typed_vil_image_view< pix_t >(
+        high_pass_box_filter->filter( image ) );
+
+      // Legacy BurnOut models expect these channels to be incorrectly ordered
+      // TODO Remove this code when we no longer need to train models using
+      // legacy code
+      auto first_plane = vil_plane( high_pass_box, 0 );
+      auto second_plane = vil_plane( high_pass_box, 1 );
+      auto temp = vil_copy_deep( first_plane );
+      first_plane.deep_copy( second_plane );
+      second_plane.deep_copy( temp );
+    } );
+  }
+  if( enable_high_pass_bidir )
+  {
+    jobs.push_back( [ & ]( vital::image_container_sptr const& image ){
+      high_pass_bidir = convert_to_typed_vil_image_view< pix_t >(
+        high_pass_bidir_filter->filter( image ) );
+    } );
+  }
+  if( enable_aligned_edge )
+  {
+    jobs.push_back( [ & ]( vital::image_container_sptr const& image ){
+      aligned_edge = convert_to_typed_vil_image_view< pix_t >(
+        aligned_edge_detection_filter->filter( image ) );
+    } );
+  }
 
-    auto const double_gray = static_cast< vil_image_view< double > >(
-      vil_convert_cast( double{}, input_image_sptr ) );
+  // Give each job its own view of the input, made here before any job starts
+  std::vector< vital::image_container_sptr > job_inputs;
+  for( size_t k = 0; k < jobs.size(); ++k )
+  {
+    job_inputs.push_back( isolated_view( input_image ) );
+  }
 
-    if( enable_average || enable_normalized_variance )
-    {
-      auto gray_container =
-        std::make_shared< vxl::image_container >( double_gray );
-      double_variance = convert_to_typed_vil_image_view< double >(
-        average_frames_filter->filter( gray_container ) );
-    }
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  vital::thread_pool::instance().parallel_for(
+    jobs.size(), 1,
+    [ & ]( size_t begin, size_t end ){
+      for( auto k = begin; k < end; ++k )
+      {
+        try
+        {
+          jobs[ k ]( job_inputs[ k ] );
+        }
+        catch( ... )
+        {
+          std::lock_guard< std::mutex > lock( error_mutex );
+          error = std::current_exception();
+        }
+      }
+    } );
+  if( error )
+  {
+    std::rethrow_exception( error );
+  }
+
+  // Gather the features in the order models expect them
+  std::vector< vil_image_view< pix_t > > filtered_images;
 
+  if( enable_color )
+  {
+    // 3 channels
+    filtered_images.push_back( color );
+  }
+  if( enable_gray )
+  {
     // 1 channel
-    if( enable_gray )
-    {
-      auto pix_t_gray = clamping_cast< pix_t >( double_gray );
-      filtered_images.push_back( pix_t_gray );
-    }
+    filtered_images.push_back( gray );
   }
-
   if( enable_color_commonality )
   {
     // 1 channel
-    auto color_commonality = convert_to_typed_vil_image_view< pix_t >(
-      color_commonality_filter->filter( input_image ) );
-
     filtered_images.push_back( color_commonality );
   }
   if( enable_high_pass_box )
   {
-    auto high_pass_box = convert_to_typed_vil_image_view< pix_t >(
-      high_pass_box_filter->filter( input_image ) );
-
-    // Legacy BurnOut models expect these channels to be incorrectly ordered
-    // TODO Remove this code when we no longer need to train models using
-    // legacy code
-    auto first_plane = vil_plane( high_pass_box, 0 );
-    auto second_plane = vil_plane( high_pass_box, 1 );
-    auto temp = vil_copy_deep( first_plane );
-    first_plane.deep_copy( second_plane );
-    second_plane.deep_copy( temp );
-
     // 3 channels
     filtered_images.push_back( high_pass_box );
   }
   if( enable_high_pass_bidir )
   {
-    auto high_pass_bidir = convert_to_typed_vil_image_view< pix_t >(
-      high_pass_bidir_filter->filter( input_image ) );
     // 3 channels
     filtered_images.push_back( high_pass_bidir );
   }
@@ -333,9 +451,6 @@ ::filter( kwiver::vital::image_container_sptr input_image )
   }
   if( enable_aligned_edge )
   {
-    auto aligned_edge = convert_to_typed_vil_image_view< pix_t >(
-      aligned_edge_detection_filter->filter( input_image ) );
-
     auto joint_response =
       vil_plane( aligned_edge, aligned_edge.nplanes() - 1 );
     // 1 channel
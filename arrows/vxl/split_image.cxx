@@ -28,6 +28,29 @@ split_image
 {
 }
 
+/// Get this algorithm's configuration block
+kwiver::vital::config_block_sptr
+split_image
+::get_configuration() const
+{
+  kwiver::vital::config_block_sptr config = algorithm::get_configuration();
+
+  config->set_value( "copy", m_copy,
+                     "Copy the pixels of each part of the image. Otherwise "
+                     "the parts are views sharing the memory of the input "
+                     "image." );
+
+  return config;
+}
+
+/// Set this algorithm's properties via a config block
+void
+split_image
+::set_configuration( kwiver::vital::config_block_sptr config )
+{
+  m_copy = config->get_value< bool >( "copy", m_copy );
+}
+
 /// Split image
 std::vector< kwiver::vital::image_container_sptr >
 split_image
@@ -36,16 +59,22 @@ ::split(kwiver::vital::image_container_sptr image) const
   std::vector< kwiver::vital::image_container_sptr > output;
   vil_image_view< vxl_byte > vxl_image = vxl::image_container::vital_to_vxl( image->get_image() );
 
-  vil_image_view< vxl_byte > left_image_copy, left_image
+  vil_image_view< vxl_byte > left_image
     = vil_crop( vxl_image, 0, vxl_image.ni()/2, 0, vxl_image.nj() );
-  vil_image_view< vxl_byte > right_image_copy, right_image
+  vil_image_view< vxl_byte > right_image
     = vil_crop( vxl_image, vxl_image.ni()/2, vxl_image.ni()/2, 0, vxl_image.nj() );
 
-  vil_copy_deep( left_image, left_image_copy );
-  vil_copy_deep( right_image, right_image_copy );
+  if( m_copy )
+  {
+    vil_image_view< vxl_byte > left_image_copy, right_image_copy;
+    vil_copy_deep( left_image, left_image_copy );
+    vil_copy_deep( right_image, right_image_copy );
+    left_image = left_image_copy;
+    right_image = right_image_copy;
+  }
 
-  output.push_back( vital::image_container_sptr( new vxl::image_container( left_image_copy ) ) );
-  output.push_back( vital::image_container_sptr( new vxl::image_container( right_image_copy ) ) );
+  output.push_back( vital::image_container_sptr( new vxl::image_container( left_image ) ) );
+  output.push_back( vital::image_container_sptr( new vxl::image_container( right_image ) ) );
 
   return output;
 }
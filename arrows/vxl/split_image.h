@@ -32,12 +32,18 @@ class KWIVER_ALGO_VXL_EXPORT split_image
   /// Destructor
   virtual ~split_image();
 
-  virtual void set_configuration( VITAL_UNUSED kwiver::vital::config_block_sptr ) { }
+  /// Get this algorithm's \link vital::config_block configuration block \endlink
+  virtual kwiver::vital::config_block_sptr get_configuration() const;
+  virtual void set_configuration( kwiver::vital::config_block_sptr config );
   virtual bool check_configuration( VITAL_UNUSED kwiver::vital::config_block_sptr config) const { return true; }
 
   /// Split image
   virtual std::vector< kwiver::vital::image_container_sptr >
   split(kwiver::vital::image_container_sptr img) const;
+
+private:
+  /// Copy the pixels of each part instead of viewing the input memory
+  bool m_copy = false;
 };
 
 } // end namespace vxl
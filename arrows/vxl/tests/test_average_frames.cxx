@@ -132,3 +132,42 @@ TEST_F ( average_frames, exponential )
                          exponential_second_expected_name,
                          exponential_third_expected_name } );
 }
+
+// ----------------------------------------------------------------------------
+TEST_F ( average_frames, window_slides )
+{
+  ka::vxl::average_frames filter;
+
+  auto config = kv::config_block::empty_config();
+  config->set_value( "type", "window" );
+  config->set_value( "window_size", 2 );
+  filter.set_configuration( config );
+
+  // Once the window is full, the oldest frame leaves it
+  std::vector< int > const values = { 10, 20, 40, 100, 100 };
+  std::vector< int > const expected = { 10, 15, 30, 70, 100 };
+  for( size_t k = 0; k < values.size(); ++k )
+  {
+    vil_image_view< vxl_byte > frame{ 5, 4, 3 };
+    frame.fill( static_cast< vxl_byte >( values[ k ] ) );
+
+    auto const filtered = filter.filter(
+      std::make_shared< ka::vxl::image_container >( frame ) );
+    ASSERT_NE( nullptr, filtered );
+
+    kv::image_of< uint8_t > const average{ filtered->get_image() };
+    ASSERT_EQ( 5, average.width() );
+    ASSERT_EQ( 4, average.height() );
+    ASSERT_EQ( 3, average.depth() );
+    for( size_t c = 0; c < 3; ++c )
+    {
+      for( size_t j = 0; j < 4; ++j )
+      {
+        for( size_t i = 0; i < 5; ++i )
+        {
+          EXPECT_EQ( expected[ k ], average( i, j, c ) ) << "At frame " << k;
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,143 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include <test_gtest.h>
+#include <test_scene.h>
+
+#include <arrows/mvg/algo/initialize_cameras_landmarks.h>
+#include <arrows/mvg/metrics.h>
+#include <arrows/mvg/projected_track_set.h>
+
+#include <vital/plugin_loader/plugin_manager.h>
+
+#include <vital/types/camera_map.h>
+
+using namespace kwiver::vital;
+using namespace kwiver::arrows::mvg;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  TEST_LOAD_PLUGINS();
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Configure the algorithm with VXL sub-algorithms and OpenCV PnP
+void
+configure_algo(initialize_cameras_landmarks& algo,
+               camera_intrinsics_sptr const K,
+               unsigned window_size)
+{
+  config_block_sptr cfg = algo.get_configuration();
+  cfg->set_value("base_camera:focal_length", K->focal_length());
+  cfg->set_value("base_camera:principal_point", K->principal_point());
+  cfg->set_value("base_camera:aspect_ratio", K->aspect_ratio());
+  cfg->set_value("base_camera:skew", K->skew());
+  cfg->set_value("essential_mat_estimator:type", "vxl");
+  cfg->set_value("essential_mat_estimator:vxl:num_ransac_samples", 10);
+  cfg->set_value("estimate_pnp:type", "ocv");
+  cfg->set_value("lm_triangulator:type", "mvg");
+  cfg->set_value("bundle_adjuster:type", "vxl");
+  cfg->set_value("similarity_estimator:type", "vxl");
+  cfg->set_value("canonical_estimator:type", "core_pca");
+  cfg->set_value("streaming_window_size", window_size);
+  algo.set_configuration(cfg);
+
+  ASSERT_TRUE(algo.check_configuration(cfg));
+}
+
+// ----------------------------------------------------------------------------
+// The cameras of the frames before \p end
+camera_map_sptr
+first_cameras(camera_map_sptr const& cameras, frame_id_t end)
+{
+  camera_map::map_camera_t first;
+  for (auto const& p : cameras->cameras())
+  {
+    if (p.first < end)
+    {
+      first.insert(p);
+    }
+  }
+  return std::make_shared<simple_camera_map>(first);
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+// Register the first half of a sequence, then resume with the rest, bundle
+// adjusting a small sliding window, and compare against the batch solution
+TEST(initialize_cameras_landmarks, streaming_resume)
+{
+  frame_id_t const num_frames = 20;
+
+  // create landmarks at the random locations
+  landmark_map_sptr landmarks = kwiver::testing::init_landmarks(100);
+  landmarks = kwiver::testing::noisy_landmarks(landmarks, 1.0);
+
+  // create a camera sequence (elliptical path)
+  camera_map_sptr cameras = kwiver::testing::camera_seq(num_frames);
+
+  auto const first_cam =
+    std::dynamic_pointer_cast<camera_perspective>(cameras->cameras()[0]);
+  camera_intrinsics_sptr const K = first_cam->intrinsics();
+
+  // Tracks are recreated for each run since initialization removes
+  // stationary tracks from them
+  auto const all_tracks = [&]()
+  {
+    auto tracks = projected_tracks(landmarks, cameras);
+    kwiver::testing::reset_inlier_flag(tracks);
+    return tracks;
+  };
+
+  // Batch
+  initialize_cameras_landmarks batch;
+  configure_algo(batch, K, 0);
+
+  camera_map_sptr batch_cameras;
+  landmark_map_sptr batch_landmarks;
+  auto tracks = all_tracks();
+  batch.initialize(batch_cameras, batch_landmarks, tracks);
+
+  ASSERT_NE(nullptr, batch_cameras);
+  ASSERT_NE(nullptr, batch_landmarks);
+  double const batch_rmse =
+    reprojection_rmse(batch_cameras->cameras(), batch_landmarks->landmarks(),
+                      tracks->tracks());
+
+  // Streaming, first half
+  initialize_cameras_landmarks streaming;
+  configure_algo(streaming, K, 3);
+
+  camera_map_sptr stream_cameras;
+  landmark_map_sptr stream_landmarks;
+  auto first_tracks =
+    projected_tracks(landmarks, first_cameras(cameras, num_frames / 2));
+  kwiver::testing::reset_inlier_flag(first_tracks);
+  streaming.initialize(stream_cameras, stream_landmarks, first_tracks);
+
+  ASSERT_NE(nullptr, stream_cameras);
+  ASSERT_NE(nullptr, stream_landmarks);
+  EXPECT_EQ(static_cast<size_t>(num_frames / 2), stream_cameras->size());
+
+  // Streaming, resumed with the rest of the frames
+  tracks = all_tracks();
+  streaming.initialize(stream_cameras, stream_landmarks, tracks);
+
+  double const stream_rmse =
+    reprojection_rmse(stream_cameras->cameras(),
+                      stream_landmarks->landmarks(), tracks->tracks());
+
+  std::cout << "batch RMSE " << batch_rmse
+            << ", streaming RMSE " << stream_rmse << std::endl;
+
+  EXPECT_EQ(batch_cameras->size(), stream_cameras->size());
+  EXPECT_EQ(cameras->size(), stream_cameras->size());
+  EXPECT_NEAR(batch_rmse, stream_rmse, 0.5);
+}
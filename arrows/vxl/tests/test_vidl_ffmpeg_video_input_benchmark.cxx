@@ -0,0 +1,59 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// Benchmark decoding and seeking with vidl_ffmpeg_video_input.
+///
+/// Reads the same H.264 MPEG-TS video with KLV as the ffmpeg arrow's
+/// benchmark, so that the two readers can be compared. Results are recorded as
+/// test properties, for \c --gtest_output=json:<file>, and rates are checked
+/// only against a floor passed as \c --min-fps=<frames/s>.
+
+#include <test_gtest.h>
+
+#include <arrows/tests/test_video_input_benchmark.h>
+#include <arrows/vxl/vidl_ffmpeg_video_input.h>
+
+#include <string>
+
+kwiver::vital::path_t g_data_dir;
+
+namespace {
+
+double g_min_fps = 0.0;
+
+std::string const klv_video_name = "videos/aphill_klv_10s.ts";
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+
+  GET_ARG( 1, g_data_dir );
+  g_min_fps = benchmark_min_fps( argc, argv );
+
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+class vidl_ffmpeg_video_input_benchmark : public ::testing::Test
+{
+  TEST_ARG( data_dir );
+};
+
+// ----------------------------------------------------------------------------
+TEST_F ( vidl_ffmpeg_video_input_benchmark, decode )
+{
+  kwiver::arrows::vxl::vidl_ffmpeg_video_input input;
+  auto const config = input.get_configuration();
+  EXPECT_TRUE( input.check_configuration( config ) );
+  input.set_configuration( config );
+
+  report_video_benchmark(
+    benchmark_video_input( input, data_dir + "/" + klv_video_name ),
+    g_min_fps );
+}
@@ -5,6 +5,7 @@
 #include "threshold.h"
 
 #include "image_statistics.h"
+#include "parallel_rows.h"
 
 #include <arrows/vxl/image_container.h>
 
@@ -14,7 +15,6 @@
 
 #include <vil/vil_convert.h>
 #include <vil/vil_image_view.h>
-#include <vil/vil_math.h>
 #include <vil/vil_plane.h>
 
 #include <limits>
@@ -57,23 +57,44 @@ vil_image_view< bool >
 threshold::priv
 ::filter( vil_image_view< pix_t > image )
 {
+  pix_t value;
   switch( type )
   {
     case MODE_absolute:
-    {
-      vil_image_view< bool > output;
-      vil_threshold_above( image, output, static_cast< pix_t >( threshold ) );
-      return output;
-    }
+      value = static_cast< pix_t >( threshold );
+      break;
     case MODE_percentile:
     {
-      vil_image_view< bool > output;
-      percentile_threshold_above( image, threshold, output );
-      return output;
+      if( !image.size() )
+      {
+        return {};
+      }
+      value = get_image_percentiles( image, { threshold }, 1000 ).front();
+      break;
     }
     default:
       return {};
   }
+
+  // Compare every pixel to the threshold in bands of rows in parallel
+  auto const ni = image.ni();
+  auto const np = image.nplanes();
+  vil_image_view< bool > output{ ni, image.nj(), np };
+  for_each_row_band(
+    image.nj(),
+    [ & ]( unsigned j0, unsigned j1 ){
+      for( unsigned p = 0; p < np; ++p )
+      {
+        for( unsigned j = j0; j < j1; ++j )
+        {
+          for( unsigned i = 0; i < ni; ++i )
+          {
+            output( i, j, p ) = image( i, j, p ) > value;
+          }
+        }
+      }
+    } );
+  return output;
 }
 
 // ----------------------------------------------------------------------------
@@ -7,8 +7,7 @@
 
 #include "triangulate_landmarks.h"
 
-#include <set>
-
+#include <vital/util/thread_pool.h>
 #include <vital/vital_config.h>
 
 #include <arrows/vxl/camera_map.h>
@@ -105,14 +104,18 @@ ::triangulate(vital::camera_map_sptr cameras,
     track_map[t->id()] = t;
   }
 
-  // the set of landmark ids which failed to triangulation
-  std::set<landmark_id_t> failed_landmarks;
-
-  map_landmark_t triangulated_lms;
-  for(const map_landmark_t::value_type& p : lms)
+  // gather the views of every landmark into flat arrays; those of
+  // landmark i are obs_begin[i] to obs_begin[i+1]
+  std::vector<map_landmark_t::const_iterator> lm_itrs;
+  std::vector<size_t> obs_begin;
+  std::vector<const vpgl_perspective_camera<double>*> obs_cam;
+  std::vector<feature_track_state*> obs_feature;
+  lm_itrs.reserve(lms.size());
+  obs_begin.reserve(lms.size() + 1);
+  for(auto p = lms.cbegin(); p != lms.cend(); ++p)
   {
     // get the corresponding track
-    track_map_t::const_iterator t_itr = track_map.find(p.first);
+    track_map_t::const_iterator t_itr = track_map.find(p->first);
     if (t_itr == track_map.end())
     {
       // there is no track for the provided landmark
@@ -120,11 +123,8 @@ ::triangulate(vital::camera_map_sptr cameras,
     }
     const track& t = *t_itr->second;
 
-    // extract the cameras and image points for this landmarks
-    std::vector<vpgl_perspective_camera<double> > lm_cams;
-    std::vector<vgl_point_2d<double> > lm_image_pts;
-    std::vector<feature_track_state_sptr> feats;
-
+    lm_itrs.push_back(p);
+    obs_begin.push_back(obs_cam.size());
     for (track::history_const_itr tsi = t.begin(); tsi != t.end(); ++tsi)
     {
       auto fts = std::dynamic_pointer_cast<feature_track_state>(*tsi);
@@ -139,47 +139,88 @@ ::triangulate(vital::camera_map_sptr cameras,
         // there is no camera for this track state.
         continue;
       }
-      lm_cams.push_back(c_itr->second);
-      vital::vector_2d pt = fts->feature->loc();
-      lm_image_pts.push_back(vgl_point_2d<double>(pt.x(), pt.y()));
-      feats.push_back(fts);
+      obs_cam.push_back(&c_itr->second);
+      obs_feature.push_back(fts.get());
     }
-
-    // if we found at least two views of this landmark, triangulate
-    if (lm_cams.size() > 1)
+  }
+  obs_begin.push_back(obs_cam.size());
+
+  // each landmark updates only the states of its own track, so landmarks
+  // are triangulated in parallel; a null result is a failure
+  std::vector<landmark_sptr> results(lm_itrs.size());
+  std::vector<char> failed(lm_itrs.size(), 0);
+  vital::thread_pool::instance().parallel_for(
+    lm_itrs.size(), 64,
+    [&](size_t begin, size_t end)
     {
-      vital::vector_3d lm_loc = p.second->loc();
-      vgl_point_3d<double> pt3d(lm_loc.x(), lm_loc.y(), lm_loc.z());
-      double error = vpgl_triangulate_points::triangulate(lm_image_pts,
-                                                          lm_cams, pt3d);
-      bool bad_triangulation = false;
-      vgl_homg_point_3d<double> hpt3d(pt3d);
-      for(vpgl_perspective_camera<double> const& cam : lm_cams)
+      // reused for every landmark of the chunk
+      std::vector<vpgl_perspective_camera<double> > lm_cams;
+      std::vector<vgl_point_2d<double> > lm_image_pts;
+      for (size_t i = begin; i < end; ++i)
       {
-        if(cam.is_behind_camera(hpt3d))
+        size_t const first = obs_begin[i];
+        size_t const last = obs_begin[i + 1];
+
+        // if we found at least two views of this landmark, triangulate
+        if (last - first < 2)
         {
-          bad_triangulation = true;
-          failed_landmarks.insert(p.first);
-          break;
+          continue;
         }
-      }
-      if( !bad_triangulation )
-      {
-        auto lm = std::make_shared<vital::landmark_d>();
-        lm->set_loc(vital::vector_3d(pt3d.x(), pt3d.y(), pt3d.z()));
-        lm->set_covar(covariance_3d(error));
-        lm->set_observations(static_cast<unsigned int>(lm_cams.size()));
-        triangulated_lms[p.first] = lm;
-        for (auto fts : feats)
+
+        lm_cams.clear();
+        lm_image_pts.clear();
+        for (size_t o = first; o < last; ++o)
         {
-          fts->inlier = true;
+          lm_cams.push_back(*obs_cam[o]);
+          vital::vector_2d pt = obs_feature[o]->feature->loc();
+          lm_image_pts.push_back(vgl_point_2d<double>(pt.x(), pt.y()));
+        }
+
+        vital::vector_3d lm_loc = lm_itrs[i]->second->loc();
+        vgl_point_3d<double> pt3d(lm_loc.x(), lm_loc.y(), lm_loc.z());
+        double error = vpgl_triangulate_points::triangulate(lm_image_pts,
+                                                            lm_cams, pt3d);
+        bool bad_triangulation = false;
+        vgl_homg_point_3d<double> hpt3d(pt3d);
+        for(vpgl_perspective_camera<double> const& cam : lm_cams)
+        {
+          if(cam.is_behind_camera(hpt3d))
+          {
+            bad_triangulation = true;
+            failed[i] = 1;
+            break;
+          }
+        }
+        if( !bad_triangulation )
+        {
+          auto lm = std::make_shared<vital::landmark_d>();
+          lm->set_loc(vital::vector_3d(pt3d.x(), pt3d.y(), pt3d.z()));
+          lm->set_covar(covariance_3d(error));
+          lm->set_observations(static_cast<unsigned int>(lm_cams.size()));
+          results[i] = lm;
+          for (size_t o = first; o < last; ++o)
+          {
+            obs_feature[o]->inlier = true;
+          }
         }
       }
+    });
+
+  // the number of landmarks which failed to triangulate
+  size_t num_failed = 0;
+  map_landmark_t triangulated_lms;
+  for (size_t i = 0; i < lm_itrs.size(); ++i)
+  {
+    if (results[i])
+    {
+      triangulated_lms.emplace_hint(triangulated_lms.end(),
+                                    lm_itrs[i]->first, results[i]);
     }
+    num_failed += failed[i];
   }
-  if( !failed_landmarks.empty() )
+  if( num_failed > 0 )
   {
-    LOG_ERROR(logger(), "failed to triangulate " << failed_landmarks.size()
+    LOG_ERROR(logger(), "failed to triangulate " << num_failed
                             << " of " << lms.size() << " landmarks");
   }
   landmarks = landmark_map_sptr(new simple_landmark_map(triangulated_lms));
@@ -13,6 +13,7 @@
 #include <arrows/klv/klv_demuxer.h>
 #include <arrows/klv/misp_time.h>
 
+#include <vital/types/image_memory_pool.h>
 #include <vital/types/timestamp.h>
 #include <vital/exceptions/io.h>
 #include <vital/exceptions/metadata.h>
@@ -887,9 +888,17 @@ ::frame_image( )
     return kwiver::vital::image_container_sptr();
   }
 
-  // We succeed in the step if we can convert the frame to RGB.
-  vil_image_view<vxl_byte> img;
   vidl_frame_sptr vidl_frame = d->d_video_stream.current_frame();
+  size_t const ni = vidl_frame->ni();
+  size_t const nj = vidl_frame->nj();
+
+  // Convert into recycled memory to avoid an allocation for every frame
+  auto memory =
+    kwiver::vital::image_memory_pool::instance().acquire( ni * nj * 3 );
+  auto const buffer = static_cast< vxl_byte* >( memory->data() );
+  vil_image_view<vxl_byte> img( buffer, ni, nj, 3, 3, 3 * ni, 1 );
+
+  // We succeed in the step if we can convert the frame to RGB.
   bool result = vidl_convert_to_view( *vidl_frame,
                                       img,
                                       VIDL_PIXEL_COLOR_RGB );
@@ -900,7 +909,18 @@ ::frame_image( )
   }
 
   // make an image container and add the first metadata object, if there is one
-  auto img_cont = std::make_shared<vxl::image_container>(img);
+  kwiver::vital::image_container_sptr img_cont;
+  if ( img.top_left_ptr() == buffer )
+  {
+    img_cont = std::make_shared<kwiver::vital::simple_image_container>(
+      kwiver::vital::image_of<vxl_byte>( memory, buffer, ni, nj, 3,
+                                         3, 3 * ni, 1 ) );
+  }
+  else
+  {
+    // The conversion allocated its own view
+    img_cont = std::make_shared<vxl::image_container>(img);
+  }
   auto mdv = this->frame_metadata();
   if (!mdv.empty())
   {
@@ -28,6 +28,7 @@ class KWIVER_ALGO_VXL_EXPORT vil_image_memory
   : vil_data_(chunk)
   {
     size_ = chunk->size();
+    update_accounting();
   }
 
   /// Return a pointer to the allocated memory
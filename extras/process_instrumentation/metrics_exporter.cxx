@@ -0,0 +1,639 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "metrics_exporter.h"
+
+#include <vital/logger/logger.h>
+#include <vital/util/memory_accounting.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <thread>
+
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace sprokit {
+
+namespace {
+
+kwiver::vital::logger_handle_t
+logger()
+{
+  static auto const log =
+    kwiver::vital::get_logger( "sprokit.metrics_process_instrumentation" );
+  return log;
+}
+
+// ----------------------------------------------------------------------------
+// Escape a Prometheus label value
+std::string
+label_value( std::string const& s )
+{
+  std::string result;
+  for ( char const c : s )
+  {
+    switch ( c )
+    {
+      case '\\': result += "\\\\"; break;
+      case '"':  result += "\\\""; break;
+      case '\n': result += "\\n"; break;
+      default:   result += c; break;
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+// Make a string usable as part of a StatsD metric name
+std::string
+metric_name( std::string const& s )
+{
+  std::string result = s;
+  for ( char& c : result )
+  {
+    if ( !std::isalnum( static_cast< unsigned char >( c ) ) &&
+         c != '_' && c != '-' )
+    {
+      c = '_';
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+// Categories of vital data whose memory is exported
+std::vector< kwiver::vital::memory_category > const&
+memory_categories()
+{
+  static std::vector< kwiver::vital::memory_category > const categories = {
+    kwiver::vital::memory_category::image,
+    kwiver::vital::memory_category::descriptor,
+    kwiver::vital::memory_category::track_state,
+    kwiver::vital::memory_category::metadata,
+  };
+  return categories;
+}
+
+#ifndef _WIN32
+
+// ----------------------------------------------------------------------------
+class prometheus_exporter : public metrics_exporter
+{
+public:
+  prometheus_exporter( std::string const& address, unsigned port )
+    : m_fd( -1 ),
+      m_stop( false )
+  {
+    sockaddr_in addr;
+    std::memset( &addr, 0, sizeof( addr ) );
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons( static_cast< uint16_t >( port ) );
+    if ( inet_pton( AF_INET, address.c_str(), &addr.sin_addr ) != 1 )
+    {
+      LOG_ERROR( logger(), "Invalid Prometheus listen address \""
+                 << address << "\"; metrics will not be served" );
+      return;
+    }
+
+    m_fd = socket( AF_INET, SOCK_STREAM, 0 );
+    int const yes = 1;
+    if ( m_fd < 0 ||
+         setsockopt( m_fd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof( yes ) ) ||
+         bind( m_fd, reinterpret_cast< sockaddr* >( &addr ), sizeof( addr ) ) ||
+         listen( m_fd, 16 ) )
+    {
+      LOG_ERROR( logger(), "Unable to listen on " << address << ":" << port
+                 << " (" << std::strerror( errno )
+                 << "); metrics will not be served" );
+      if ( m_fd >= 0 )
+      {
+        close( m_fd );
+        m_fd = -1;
+      }
+      return;
+    }
+
+    LOG_INFO( logger(), "Serving Prometheus metrics on http://"
+              << address << ":" << port << "/metrics" );
+    m_thread = std::thread( &prometheus_exporter::serve, this );
+  }
+
+  ~prometheus_exporter()
+  {
+    m_stop = true;
+    if ( m_thread.joinable() )
+    {
+      m_thread.join();
+    }
+    if ( m_fd >= 0 )
+    {
+      close( m_fd );
+    }
+  }
+
+private:
+  void serve()
+  {
+    while ( !m_stop )
+    {
+      // Wake up now and then to see if we should stop
+      pollfd p = { m_fd, POLLIN, 0 };
+      if ( poll( &p, 1, 200 ) <= 0 )
+      {
+        continue;
+      }
+
+      int const client = accept( m_fd, nullptr, nullptr );
+      if ( client >= 0 )
+      {
+        respond( client );
+        close( client );
+      }
+    }
+  }
+
+  void respond( int client )
+  {
+    timeval timeout = { 1, 0 };
+    setsockopt( client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof( timeout ) );
+    setsockopt( client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof( timeout ) );
+
+    // Only the request line matters; read until the end of the headers
+    std::string request;
+    char buf[ 1024 ];
+    while ( request.find( "\r\n\r\n" ) == std::string::npos &&
+            request.size() < 8192 )
+    {
+      ssize_t const n = recv( client, buf, sizeof( buf ), 0 );
+      if ( n <= 0 )
+      {
+        break;
+      }
+      request.append( buf, static_cast< size_t >( n ) );
+    }
+
+    std::string status = "200 OK";
+    std::string body;
+    if ( request.compare( 0, 13, "GET /metrics " ) == 0 ||
+         request.compare( 0, 6, "GET / " ) == 0 )
+    {
+      body = prometheus_text();
+    }
+    else
+    {
+      status = "404 Not Found";
+      body = "Metrics are served at /metrics\n";
+    }
+
+    std::ostringstream response;
+    response << "HTTP/1.1 " << status << "\r\n"
+             << "Content-Type: text/plain; version=0.0.4\r\n"
+             << "Content-Length: " << body.size() << "\r\n"
+             << "Connection: close\r\n\r\n"
+             << body;
+
+    std::string const text = response.str();
+    size_t sent = 0;
+    while ( sent < text.size() )
+    {
+      ssize_t const n = send( client, text.data() + sent, text.size() - sent,
+                              MSG_NOSIGNAL );
+      if ( n <= 0 )
+      {
+        break;
+      }
+      sent += static_cast< size_t >( n );
+    }
+  }
+
+  int m_fd;
+  std::atomic< bool > m_stop;
+  std::thread m_thread;
+};
+
+// ----------------------------------------------------------------------------
+class statsd_exporter : public metrics_exporter
+{
+public:
+  statsd_exporter( std::string const& host, unsigned port,
+                   double interval, std::string const& prefix )
+    : m_fd( -1 ),
+      m_interval( interval ),
+      m_prefix( prefix.empty() ? prefix : metric_name( prefix ) + "." ),
+      m_stop( false )
+  {
+    addrinfo hints;
+    std::memset( &hints, 0, sizeof( hints ) );
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    addrinfo* info = nullptr;
+    if ( getaddrinfo( host.c_str(), std::to_string( port ).c_str(),
+                      &hints, &info ) != 0 || !info )
+    {
+      LOG_ERROR( logger(), "Unable to resolve StatsD host \"" << host
+                 << "\"; metrics will not be sent" );
+      return;
+    }
+
+    m_fd = socket( info->ai_family, info->ai_socktype, info->ai_protocol );
+    if ( m_fd < 0 || connect( m_fd, info->ai_addr, info->ai_addrlen ) )
+    {
+      LOG_ERROR( logger(), "Unable to open socket to StatsD server "
+                 << host << ":" << port << " (" << std::strerror( errno )
+                 << "); metrics will not be sent" );
+      if ( m_fd >= 0 )
+      {
+        close( m_fd );
+        m_fd = -1;
+      }
+    }
+    freeaddrinfo( info );
+
+    if ( m_fd >= 0 )
+    {
+      m_thread = std::thread( &statsd_exporter::run, this );
+    }
+  }
+
+  ~statsd_exporter()
+  {
+    {
+      std::lock_guard< std::mutex > lock( m_stop_mutex );
+      m_stop = true;
+    }
+    m_stop_cond.notify_one();
+    if ( m_thread.joinable() )
+    {
+      m_thread.join();
+    }
+    if ( m_fd >= 0 )
+    {
+      close( m_fd );
+    }
+  }
+
+private:
+  void run()
+  {
+    auto const interval = std::chrono::duration< double >( m_interval );
+    std::unique_lock< std::mutex > lock( m_stop_mutex );
+    while ( !m_stop_cond.wait_for( lock, interval, [this] { return m_stop; } ) )
+    {
+      send_all();
+    }
+    send_all();
+  }
+
+  // Steps are sent as a count and the mean step time over the interval,
+  // since StatsD computes its own percentiles from individual samples
+  void send_all()
+  {
+    std::map< process_metrics const*, std::pair< uint64_t, uint64_t > > current;
+    std::string packet;
+
+    for ( auto const& p : processes() )
+    {
+      uint64_t const count = p->count.load( std::memory_order_relaxed );
+      uint64_t const sum_ns = p->sum_ns.load( std::memory_order_relaxed );
+      auto const& last = m_last[ p.get() ];
+      current[ p.get() ] = std::make_pair( count, sum_ns );
+
+      std::string const name = m_prefix + metric_name( p->name );
+      uint64_t const steps = count - last.first;
+
+      std::ostringstream lines;
+      lines << name << ".steps:" << steps << "|c\n";
+      if ( steps )
+      {
+        lines << name << ".step_time:" << std::fixed << std::setprecision( 3 )
+              << ( sum_ns - last.second ) / 1e6 / steps << "|ms\n";
+      }
+      for ( auto const& e : p->edges() )
+      {
+        std::string const edge = name + "." + metric_name( e.port );
+        lines << edge << ".depth:" << e.depth << "|g\n"
+              << edge << ".max_depth:" << e.max_depth << "|g\n";
+      }
+
+      // Keep datagrams small enough not to be fragmented
+      std::string const text = lines.str();
+      if ( !packet.empty() && packet.size() + text.size() > 1400 )
+      {
+        send( m_fd, packet.data(), packet.size(), MSG_NOSIGNAL );
+        packet.clear();
+      }
+      packet += text;
+    }
+
+    if ( kwiver::vital::memory_accounting::enabled() )
+    {
+      std::ostringstream lines;
+      for ( auto const category : memory_categories() )
+      {
+        auto const usage = kwiver::vital::memory_accounting::usage( category );
+        std::string const name = m_prefix + "memory." +
+          kwiver::vital::memory_accounting::name( category );
+        lines << name << ".live_bytes:" << usage.live_bytes << "|g\n"
+              << name << ".live_objects:" << usage.live_count << "|g\n"
+              << name << ".peak_bytes:" << usage.peak_bytes << "|g\n";
+      }
+
+      std::string const text = lines.str();
+      if ( !packet.empty() && packet.size() + text.size() > 1400 )
+      {
+        send( m_fd, packet.data(), packet.size(), MSG_NOSIGNAL );
+        packet.clear();
+      }
+      packet += text;
+    }
+
+    if ( !packet.empty() )
+    {
+      send( m_fd, packet.data(), packet.size(), MSG_NOSIGNAL );
+    }
+
+    // Forget processes that have gone
+    m_last.swap( current );
+  }
+
+  int m_fd;
+  double const m_interval;
+  std::string const m_prefix;
+
+  std::map< process_metrics const*, std::pair< uint64_t, uint64_t > > m_last;
+
+  std::mutex m_stop_mutex;
+  std::condition_variable m_stop_cond;
+  bool m_stop;
+  std::thread m_thread;
+};
+
+#endif
+
+// ----------------------------------------------------------------------------
+// Exporters by endpoint; an exporter lives as long as a process uses it.
+// Never destroyed, so instrumentation may go away during static
+// destruction.
+std::shared_ptr< metrics_exporter >
+shared_exporter( std::string const& key,
+                 std::function< metrics_exporter*() > const& create )
+{
+  static std::mutex* const mutex = new std::mutex;
+  static auto* const exporters =
+    new std::map< std::string, std::weak_ptr< metrics_exporter > >;
+
+  std::lock_guard< std::mutex > lock( *mutex );
+  auto exporter = ( *exporters )[ key ].lock();
+  if ( !exporter )
+  {
+    exporter.reset( create() );
+    ( *exporters )[ key ] = exporter;
+  }
+  return exporter;
+}
+
+} // end namespace
+
+// ============================================================================
+process_metrics
+::process_metrics( std::string const& name_ )
+  : name( name_ ),
+    buckets( new std::atomic< uint64_t >[ bucket_bounds().size() + 1 ] ),
+    count( 0 ),
+    sum_ns( 0 )
+{
+  for ( size_t i = 0; i <= bucket_bounds().size(); ++i )
+  {
+    buckets[ i ] = 0;
+  }
+}
+
+// ----------------------------------------------------------------------------
+std::vector< double > const&
+process_metrics
+::bucket_bounds()
+{
+  static std::vector< double > const bounds = {
+    0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+    0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0 };
+  return bounds;
+}
+
+// ----------------------------------------------------------------------------
+void
+process_metrics
+::add_step( double seconds )
+{
+  auto const& bounds = bucket_bounds();
+  size_t const bucket =
+    std::lower_bound( bounds.begin(), bounds.end(), seconds ) - bounds.begin();
+
+  buckets[ bucket ].fetch_add( 1, std::memory_order_relaxed );
+  sum_ns.fetch_add( static_cast< uint64_t >( seconds * 1e9 ),
+                    std::memory_order_relaxed );
+  count.fetch_add( 1, std::memory_order_relaxed );
+}
+
+// ----------------------------------------------------------------------------
+void
+process_metrics
+::set_edges( std::vector< edge_sample > edges )
+{
+  std::lock_guard< std::mutex > lock( m_edges_mutex );
+  m_edges.swap( edges );
+}
+
+// ----------------------------------------------------------------------------
+std::vector< process_metrics::edge_sample >
+process_metrics
+::edges() const
+{
+  std::lock_guard< std::mutex > lock( m_edges_mutex );
+  return m_edges;
+}
+
+// ============================================================================
+std::shared_ptr< metrics_exporter >
+metrics_exporter
+::prometheus( std::string const& address, unsigned port )
+{
+  return shared_exporter(
+    "prometheus:" + address + ":" + std::to_string( port ),
+    [&]() -> metrics_exporter* {
+#ifndef _WIN32
+      return new prometheus_exporter( address, port );
+#else
+      LOG_ERROR( logger(), "The Prometheus exporter is not supported on "
+                 "this platform" );
+      return new metrics_exporter;
+#endif
+    } );
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< metrics_exporter >
+metrics_exporter
+::statsd( std::string const& host, unsigned port,
+          double interval, std::string const& prefix )
+{
+  return shared_exporter(
+    "statsd:" + host + ":" + std::to_string( port ) + ":" + prefix,
+    [&]() -> metrics_exporter* {
+#ifndef _WIN32
+      return new statsd_exporter( host, port, interval, prefix );
+#else
+      LOG_ERROR( logger(), "The StatsD exporter is not supported on "
+                 "this platform" );
+      return new metrics_exporter;
+#endif
+    } );
+}
+
+// ----------------------------------------------------------------------------
+void
+metrics_exporter
+::add( std::shared_ptr< process_metrics > const& metrics )
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+  m_processes.push_back( metrics );
+}
+
+// ----------------------------------------------------------------------------
+void
+metrics_exporter
+::remove( std::shared_ptr< process_metrics > const& metrics )
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+  m_processes.erase(
+    std::remove( m_processes.begin(), m_processes.end(), metrics ),
+    m_processes.end() );
+}
+
+// ----------------------------------------------------------------------------
+std::vector< std::shared_ptr< process_metrics > >
+metrics_exporter
+::processes() const
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+  return m_processes;
+}
+
+// ----------------------------------------------------------------------------
+std::string
+metrics_exporter
+::prometheus_text() const
+{
+  auto const procs = processes();
+  auto const& bounds = process_metrics::bucket_bounds();
+
+  std::ostringstream out;
+
+  out << "# HELP kwiver_process_step_seconds Time spent in process step.\n"
+      << "# TYPE kwiver_process_step_seconds histogram\n";
+  for ( auto const& p : procs )
+  {
+    std::string const label = "process=\"" + label_value( p->name ) + "\"";
+
+    // Read the total first, so the buckets never add up to more
+    uint64_t const count = p->count.load( std::memory_order_relaxed );
+    uint64_t const sum_ns = p->sum_ns.load( std::memory_order_relaxed );
+
+    uint64_t cumulative = 0;
+    for ( size_t i = 0; i < bounds.size(); ++i )
+    {
+      cumulative += p->buckets[ i ].load( std::memory_order_relaxed );
+      out << "kwiver_process_step_seconds_bucket{" << label
+          << ",le=\"" << bounds[ i ] << "\"} "
+          << std::min( cumulative, count ) << "\n";
+    }
+    out << "kwiver_process_step_seconds_bucket{" << label
+        << ",le=\"+Inf\"} " << count << "\n"
+        << "kwiver_process_step_seconds_sum{" << label << "} "
+        << std::setprecision( 9 ) << sum_ns / 1e9 << std::setprecision( 6 )
+        << "\n"
+        << "kwiver_process_step_seconds_count{" << label << "} "
+        << count << "\n";
+  }
+
+  std::ostringstream depth, max_depth, pushed;
+  for ( auto const& p : procs )
+  {
+    for ( auto const& e : p->edges() )
+    {
+      std::string const label = "{process=\"" + label_value( p->name ) +
+                                "\",port=\"" + label_value( e.port ) + "\"} ";
+      depth << "kwiver_edge_depth" << label << e.depth << "\n";
+      max_depth << "kwiver_edge_max_depth" << label << e.max_depth << "\n";
+      pushed << "kwiver_edge_pushed_total" << label << e.pushed << "\n";
+    }
+  }
+
+  out << "# HELP kwiver_edge_depth Data waiting on the edge into an input port.\n"
+      << "# TYPE kwiver_edge_depth gauge\n"
+      << depth.str()
+      << "# HELP kwiver_edge_max_depth Most data the edge has held at once.\n"
+      << "# TYPE kwiver_edge_max_depth gauge\n"
+      << max_depth.str()
+      << "# HELP kwiver_edge_pushed_total Data pushed into the edge.\n"
+      << "# TYPE kwiver_edge_pushed_total counter\n"
+      << pushed.str();
+
+  if ( kwiver::vital::memory_accounting::enabled() )
+  {
+    std::ostringstream live_bytes, live_objects, peak_bytes, allocated;
+    for ( auto const category : memory_categories() )
+    {
+      auto const usage = kwiver::vital::memory_accounting::usage( category );
+      std::string const label = std::string{ "{type=\"" } +
+        kwiver::vital::memory_accounting::name( category ) + "\"} ";
+      live_bytes << "kwiver_memory_live_bytes" << label
+                 << usage.live_bytes << "\n";
+      live_objects << "kwiver_memory_live_objects" << label
+                   << usage.live_count << "\n";
+      peak_bytes << "kwiver_memory_peak_bytes" << label
+                 << usage.peak_bytes << "\n";
+      allocated << "kwiver_memory_objects_total" << label
+                << usage.total_count << "\n";
+    }
+
+    out << "# HELP kwiver_memory_live_bytes Bytes held by vital data of a type.\n"
+        << "# TYPE kwiver_memory_live_bytes gauge\n"
+        << live_bytes.str()
+        << "# HELP kwiver_memory_live_objects Live vital objects of a type.\n"
+        << "# TYPE kwiver_memory_live_objects gauge\n"
+        << live_objects.str()
+        << "# HELP kwiver_memory_peak_bytes Most bytes held by vital data of a type.\n"
+        << "# TYPE kwiver_memory_peak_bytes gauge\n"
+        << peak_bytes.str()
+        << "# HELP kwiver_memory_objects_total Vital objects of a type created.\n"
+        << "# TYPE kwiver_memory_objects_total counter\n"
+        << allocated.str();
+  }
+
+  return out.str();
+}
+
+} // end namespace
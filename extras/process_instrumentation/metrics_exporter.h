@@ -0,0 +1,117 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/**
+ * \file
+ * \brief Interface for exporting process metrics to monitoring systems.
+ */
+
+#ifndef SPROKIT_METRICS_EXPORTER_H
+#define SPROKIT_METRICS_EXPORTER_H
+
+#include "instrumentation_plugin_export.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace sprokit {
+
+// -----------------------------------------------------------------
+/**
+ * \brief Metrics collected for one process.
+ *
+ * The process thread updates these; an exporter thread reads them.
+ */
+class INSTRUMENTATION_PLUGIN_NO_EXPORT process_metrics
+{
+public:
+  explicit process_metrics( std::string const& name );
+
+  /// Upper bounds, in seconds, of the step latency histogram buckets.
+  static std::vector< double > const& bucket_bounds();
+
+  /// Count one step taking \p seconds.
+  void add_step( double seconds );
+
+  /// Depth of the edge feeding one input port, as last sampled.
+  struct edge_sample
+  {
+    std::string port;
+    size_t depth;
+    size_t max_depth;
+    size_t pushed;
+  };
+
+  /// Replace the edge samples.
+  void set_edges( std::vector< edge_sample > edges );
+
+  /// Get a copy of the edge samples.
+  std::vector< edge_sample > edges() const;
+
+  std::string const name;
+
+  /// Steps per bucket; the last bucket counts steps above all bounds.
+  std::unique_ptr< std::atomic< uint64_t >[] > buckets;
+  std::atomic< uint64_t > count;
+  std::atomic< uint64_t > sum_ns;
+
+private:
+  mutable std::mutex m_edges_mutex;
+  std::vector< edge_sample > m_edges;
+};
+
+// -----------------------------------------------------------------
+/**
+ * \brief Publishes the metrics of registered processes.
+ *
+ * Exporters are shared by all processes configured with the same
+ * endpoint, and do their formatting and I/O on their own thread.
+ */
+class INSTRUMENTATION_PLUGIN_NO_EXPORT metrics_exporter
+{
+public:
+  virtual ~metrics_exporter() = default;
+
+  /**
+   * \brief Get the exporter serving a Prometheus HTTP endpoint.
+   *
+   * \param address Address to listen on.
+   * \param port TCP port to listen on.
+   */
+  static std::shared_ptr< metrics_exporter >
+  prometheus( std::string const& address, unsigned port );
+
+  /**
+   * \brief Get the exporter sending to a StatsD server.
+   *
+   * \param host Address of the server.
+   * \param port UDP port of the server.
+   * \param interval Seconds between sends.
+   * \param prefix Prefix for all metric names.
+   */
+  static std::shared_ptr< metrics_exporter >
+  statsd( std::string const& host, unsigned port,
+          double interval, std::string const& prefix );
+
+  void add( std::shared_ptr< process_metrics > const& metrics );
+  void remove( std::shared_ptr< process_metrics > const& metrics );
+
+  /// Format the metrics in the Prometheus text exposition format.
+  std::string prometheus_text() const;
+
+protected:
+  std::vector< std::shared_ptr< process_metrics > > processes() const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::vector< std::shared_ptr< process_metrics > > m_processes;
+};
+
+} // end namespace
+
+#endif // SPROKIT_METRICS_EXPORTER_H
@@ -0,0 +1,242 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "metrics_process_instrumentation.h"
+
+#include <vital/vital_config.h>
+#include <vital/util/enum_converter.h>
+
+#include <sprokit/pipeline/process.h>
+
+namespace sprokit {
+
+namespace {
+
+enum exporter_type
+{
+  exporter_prometheus,
+  exporter_statsd
+};
+
+  ENUM_CONVERTER( exporter_converter, exporter_type,
+                  { "prometheus", exporter_prometheus },
+                  { "statsd", exporter_statsd }
+    )
+
+// How often the process samples the depths of its input edges
+std::chrono::seconds const sample_period( 1 );
+
+}
+
+// ------------------------------------------------------------------
+metrics_process_instrumentation::
+metrics_process_instrumentation()
+{ }
+
+metrics_process_instrumentation::
+~metrics_process_instrumentation()
+{
+  if ( m_exporter )
+  {
+    m_exporter->remove( m_metrics );
+  }
+}
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+start_init_processing( VITAL_UNUSED std::string const& data )
+{ }
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+stop_init_processing()
+{ }
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+start_finalize_processing( VITAL_UNUSED std::string const& data )
+{ }
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+stop_finalize_processing()
+{ }
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+start_reset_processing( VITAL_UNUSED std::string const& data )
+{ }
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+stop_reset_processing()
+{ }
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+start_flush_processing( VITAL_UNUSED std::string const& data )
+{ }
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+stop_flush_processing()
+{ }
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+start_step_processing( VITAL_UNUSED std::string const& data )
+{
+  m_step_start = clock::now();
+}
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+stop_step_processing()
+{
+  if ( !m_metrics )
+  {
+    return;
+  }
+
+  auto const now = clock::now();
+  m_metrics->add_step(
+    std::chrono::duration< double >( now - m_step_start ).count() );
+
+  if ( now >= m_next_sample )
+  {
+    m_next_sample = now + sample_period;
+    sample_edges();
+  }
+}
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+start_configure_processing( VITAL_UNUSED std::string const& data )
+{ }
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+stop_configure_processing()
+{ }
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+start_reconfigure_processing( VITAL_UNUSED std::string const& data )
+{ }
+
+// ------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+stop_reconfigure_processing()
+{ }
+
+// ----------------------------------------------------------------------------
+void metrics_process_instrumentation::
+configure( kwiver::vital::config_block_sptr const conf )
+{
+  auto local_config = get_configuration();
+  local_config->merge_config( conf );
+
+  switch ( local_config->get_enum_value< exporter_converter >( "exporter" ) )
+  {
+  case exporter_prometheus:
+    m_exporter = metrics_exporter::prometheus(
+      local_config->get_value< std::string >( "prometheus_address" ),
+      local_config->get_value< unsigned >( "prometheus_port" ) );
+    break;
+
+  case exporter_statsd:
+    m_exporter = metrics_exporter::statsd(
+      local_config->get_value< std::string >( "statsd_host" ),
+      local_config->get_value< unsigned >( "statsd_port" ),
+      local_config->get_value< double >( "statsd_interval" ),
+      local_config->get_value< std::string >( "statsd_prefix" ) );
+    break;
+
+  default:
+    break;
+  } // end switch
+
+  if ( m_exporter )
+  {
+    if ( m_metrics )
+    {
+      m_exporter->remove( m_metrics );
+    }
+    m_metrics = std::make_shared< process_metrics >( process()->name() );
+    m_exporter->add( m_metrics );
+  }
+}
+
+// ----------------------------------------------------------------------------
+kwiver::vital::config_block_sptr
+metrics_process_instrumentation::
+get_configuration() const
+{
+  auto conf = kwiver::vital::config_block::empty_config();
+
+  conf->set_value( "exporter", "prometheus",
+                   "Where to export metrics. Allowable values are 'prometheus' "
+                   "and 'statsd'. Prometheus metrics are served over HTTP at "
+                   "/metrics for a Prometheus server to scrape; StatsD metrics "
+                   "are sent periodically over UDP." );
+  conf->set_value( "prometheus_address", "127.0.0.1",
+                   "Address the Prometheus endpoint listens on. Use 0.0.0.0 "
+                   "to accept connections from other hosts." );
+  conf->set_value( "prometheus_port", "9464",
+                   "TCP port the Prometheus endpoint listens on. Processes "
+                   "configured with the same address and port share one "
+                   "endpoint." );
+  conf->set_value( "statsd_host", "127.0.0.1",
+                   "Host name or address of the StatsD server." );
+  conf->set_value( "statsd_port", "8125",
+                   "UDP port of the StatsD server." );
+  conf->set_value( "statsd_interval", "10",
+                   "Seconds between sends to the StatsD server." );
+  conf->set_value( "statsd_prefix", "kwiver",
+                   "Prefix of the StatsD metric names, which are "
+                   "<prefix>.<process>.<metric>." );
+
+  return conf;
+}
+
+// ----------------------------------------------------------------------------
+void
+metrics_process_instrumentation::
+sample_edges()
+{
+  std::vector< process_metrics::edge_sample > edges;
+
+  for ( auto const& port : process()->input_ports() )
+  {
+    auto const stats = process()->input_port_edge_statistics( port );
+    if ( stats )
+    {
+      process_metrics::edge_sample const sample = {
+        port,
+        // The counters are read one at a time, so may briefly disagree
+        stats->pushed > stats->popped ? stats->pushed - stats->popped : 0,
+        stats->max_depth,
+        stats->pushed };
+      edges.push_back( sample );
+    }
+  }
+
+  m_metrics->set_edges( std::move( edges ) );
+}
+
+} // end namespace
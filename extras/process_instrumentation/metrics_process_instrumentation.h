@@ -0,0 +1,97 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/**
+ * \file
+ * \brief Interface for process instrumentation exporting metrics.
+ */
+
+#ifndef SPROKIT_METRICS_PROCESS_INSTRUMENTATION_H
+#define SPROKIT_METRICS_PROCESS_INSTRUMENTATION_H
+
+#include "instrumentation_plugin_export.h"
+
+#include "metrics_exporter.h"
+
+#include <sprokit/pipeline/process_instrumentation.h>
+
+#include <chrono>
+#include <memory>
+
+namespace sprokit {
+
+// -----------------------------------------------------------------
+/**
+ * \brief Process instrumentation exporting live metrics.
+ *
+ * This class provides an implementation of process instrumentation
+ * that publishes a step latency histogram, a step counter, and the
+ * depth of the edges feeding each input port, to either a Prometheus
+ * HTTP endpoint or a StatsD server. When memory accounting is on (see
+ * kwiver::vital::memory_accounting), the memory held by each type of
+ * vital data is exported as well.
+ *
+ * The process thread only counts steps, and samples its input edges
+ * about once a second; all formatting and network I/O happens on a
+ * thread owned by the exporter, which is shared by every process
+ * configured with the same endpoint.
+ *
+\code
+process motion :: detect_motion
+    block _instrumentation
+       type = metrics
+       block metrics
+          exporter = prometheus
+          prometheus_port = 9464
+       endblock
+    endblock
+\endcode
+ */
+class INSTRUMENTATION_PLUGIN_NO_EXPORT metrics_process_instrumentation
+  : public process_instrumentation
+{
+public:
+  metrics_process_instrumentation();
+  virtual ~metrics_process_instrumentation();
+
+  void start_init_processing( std::string const& data ) override;
+  void stop_init_processing() override;
+
+  void start_finalize_processing( std::string const& data ) override;
+  void stop_finalize_processing() override;
+
+  void start_reset_processing( std::string const& data ) override;
+  void stop_reset_processing() override;
+
+  void start_flush_processing( std::string const& data ) override;
+  void stop_flush_processing() override;
+
+  void start_step_processing( std::string const& data ) override;
+  void stop_step_processing() override;
+
+  void start_configure_processing( std::string const& data ) override;
+  void stop_configure_processing() override;
+
+  void start_reconfigure_processing( std::string const& data ) override;
+  void stop_reconfigure_processing() override;
+
+  void configure( kwiver::vital::config_block_sptr const conf ) override;
+  kwiver::vital::config_block_sptr get_configuration() const override;
+
+private:
+  typedef std::chrono::steady_clock clock;
+
+  void sample_edges();
+
+  std::shared_ptr< metrics_exporter > m_exporter;
+  std::shared_ptr< process_metrics > m_metrics;
+
+  clock::time_point m_step_start;
+  clock::time_point m_next_sample;
+
+}; // end class metrics_process_instrumentation
+
+} // end namespace
+
+#endif // SPROKIT_METRICS_PROCESS_INSTRUMENTATION_H
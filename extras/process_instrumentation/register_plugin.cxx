@@ -7,6 +7,7 @@
 #include <instrumentation_plugin_export.h>
 
 #include "logger_process_instrumentation.h"
+#include "metrics_process_instrumentation.h"
 #include "timing_process_instrumentation.h"
 
 extern "C"
@@ -42,6 +43,17 @@ register_factories( kwiver::vital::plugin_loader& vpm )
     .add_attribute( kwiver::vital::plugin_factory::PLUGIN_CATEGORY, "process-instrumentation" )
     ;
 
+  fact = vpm.ADD_FACTORY( sprokit::process_instrumentation, sprokit::metrics_process_instrumentation );
+  fact->add_attribute( kwiver::vital::plugin_factory::PLUGIN_NAME, "metrics")
+    .add_attribute( kwiver::vital::plugin_factory::PLUGIN_MODULE_NAME, module_name )
+    .add_attribute( kwiver::vital::plugin_factory::PLUGIN_DESCRIPTION,
+                       "Sprokit process instrumentation exporting step latency and edge depth "
+                       "metrics to Prometheus or StatsD.")
+    .add_attribute( kwiver::vital::plugin_factory::PLUGIN_VERSION, "1.0" )
+    .add_attribute( kwiver::vital::plugin_factory::PLUGIN_ORGANIZATION, "Kitware Inc." )
+    .add_attribute( kwiver::vital::plugin_factory::PLUGIN_CATEGORY, "process-instrumentation" )
+    ;
+
   // - - - - - - - - - - - - - - - - - - - - - - -
   vpm.mark_module_as_loaded( module_name );
 }
@@ -12,7 +12,9 @@ PYBIND11_MAKE_OPAQUE(string_set)
 #include <pybind11/stl_bind.h>
 #include <pybind11/operators.h>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "python_wrappers.cxx"
 
@@ -132,9 +134,14 @@ ::sprokit::datum peek_at_datum_on_port(::sprokit::process &self,
                                      ::sprokit::process::port_t const& port,
                                      std::size_t idx);
 object grab_value_from_port(::sprokit::process &self, ::sprokit::process::port_t const& port);
+std::vector< std::vector< ::sprokit::datum > >
+grab_datums_from_ports(::sprokit::process &self, ::sprokit::process::ports_t const& ports,
+                       std::size_t max_count);
 
 void push_value_to_port(::sprokit::process &self, ::sprokit::process::port_t const& port, object const& obj);
 void push_datum_to_port(::sprokit::process &self, ::sprokit::process::port_t const& port, ::sprokit::datum const& dat);
+void push_datums_to_port(::sprokit::process &self, ::sprokit::process::port_t const& port,
+                         std::vector< ::sprokit::datum > const& dats);
 
 std::string config_value(::sprokit::process &self, kwiver::vital::config_block_key_t const& key);
 
@@ -501,6 +508,12 @@ PYBIND11_MODULE(process, m)
     .def("grab_datum_from_port", &grab_datum_from_port, call_guard<kwiver::vital::python::gil_scoped_release>()
       , arg("port")
       , "Grab a datum from a port.")
+    .def("grab_datums_from_ports", &grab_datums_from_ports, call_guard<kwiver::vital::python::gil_scoped_release>()
+      , arg("ports"), arg("max_count")
+      , "Grab a batch of up to max_count data from each of several ports. Waits "
+        "for the first datum on each port, then takes as many more as are "
+        "already queued on every port, stopping before any control datum. "
+        "Returns one list of data per port, all of the same length.")
     .def("push_to_port", static_cast<void (sprokit::process::*)(sprokit::process::port_t const&, sprokit::edge_datum_t const&) const>(&wrap_process::push_to_port), call_guard<kwiver::vital::python::gil_scoped_release>()
       , arg("port"), arg("datum")
       , "Push a datum packet to a port.")
@@ -510,6 +523,9 @@ PYBIND11_MODULE(process, m)
     .def("push_datum_to_port", &push_datum_to_port, call_guard<kwiver::vital::python::gil_scoped_release>()
       , arg("port"), arg("datum")
       , "Push a datum to a port.")
+    .def("push_datums_to_port", &push_datums_to_port, call_guard<kwiver::vital::python::gil_scoped_release>()
+      , arg("port"), arg("data")
+      , "Push a list of data to a port.")
     .def("get_config", static_cast<kwiver::vital::config_block_sptr (sprokit::process::*)() const>(&wrap_process::get_config), call_guard<kwiver::vital::python::gil_scoped_release>()
       , "Gets the configuration for a process.")
     .def("config_value", &config_value, call_guard<kwiver::vital::python::gil_scoped_release>()
@@ -839,6 +855,65 @@ grab_datum_from_port(::sprokit::process &self, ::sprokit::process::port_t const&
   return dat;
 }
 
+// Grabbing a batch in one call, with the GIL released throughout, lets a
+// Python process handle many data per step without giving up and
+// reacquiring the GIL for every datum.
+std::vector< std::vector< ::sprokit::datum > >
+grab_datums_from_ports(::sprokit::process &self, ::sprokit::process::ports_t const& ports,
+                       std::size_t max_count)
+{
+  ::sprokit::process* self_ptr = &self;
+  wrap_process* const proc = (wrap_process*) self_ptr;
+
+  // The first datum is always taken, waiting for it if needed; more are
+  // only taken when already queued on every port.
+  std::size_t count = std::max< std::size_t >( max_count, 1 );
+  for ( auto const& port : ports )
+  {
+    auto const stats = self.input_port_edge_statistics( port );
+    std::size_t const queued =
+      ( stats && stats->pushed > stats->popped ) ? stats->pushed - stats->popped : 0;
+    count = std::min( count, std::max< std::size_t >( queued, 1 ) );
+  }
+
+  // Leave control data, such as the end of the stream, for the next step
+  // so the base process handles them.
+  for ( std::size_t i = 1; i < count; ++i )
+  {
+    for ( auto const& port : ports )
+    {
+      if ( proc->peek_at_datum_on_port( port, i )->type() != ::sprokit::datum::data )
+      {
+        count = i;
+        break;
+      }
+    }
+  }
+
+  std::vector< std::vector< ::sprokit::datum > > batches( ports.size() );
+  for ( std::size_t p = 0; p < ports.size(); ++p )
+  {
+    batches[ p ].reserve( count );
+    for ( std::size_t i = 0; i < count; ++i )
+    {
+      batches[ p ].push_back( *proc->grab_datum_from_port( ports[ p ] ) );
+    }
+  }
+
+  return batches;
+}
+
+void
+push_datums_to_port(::sprokit::process &self, ::sprokit::process::port_t const& port,
+                    std::vector< ::sprokit::datum > const& dats)
+{
+  ::sprokit::process* self_ptr = &self;
+  for ( auto const& dat : dats )
+  {
+    ((wrap_process*) self_ptr)->push_datum_to_port(port, std::make_shared<::sprokit::datum>(dat));
+  }
+}
+
 ::sprokit::datum
 peek_at_datum_on_port(::sprokit::process &self, ::sprokit::process::port_t const& port,
                       std::size_t idx)
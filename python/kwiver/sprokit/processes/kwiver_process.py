@@ -352,6 +352,68 @@ def grab_value_using_trait(self, ptn):
 
         return self.grab_value_from_port(pt.name)
 
+    def grab_batch_using_traits(self, ptns, max_count):
+        """
+        Get a batch of values from several ports using traits.
+
+        Waits for one datum on each port, then also takes up to
+        max_count - 1 more that are already queued on every port, in a
+        single call which releases the GIL only once. The batch stops
+        before any control datum, such as the end of the stream, which
+        is handled by the next step. Each datum is passed through the
+        converter of its type trait, as in grab_input_using_trait().
+
+        Taking several inputs per step amortizes the cost of entering
+        Python and of handing the GIL between threads, and lets a model
+        run on a batch of inputs at once. Since every port yields the
+        same number of values, the outputs stay in step if the process
+        pushes one value per input to each output port.
+
+        :param ptns: port trait names
+        :param max_count: largest number of values to take from each port
+
+        :returns: list of lists of values, one per port trait name
+        """
+        names = []
+        for ptn in ptns:
+            pt = self._port_trait_set.get(ptn, None)
+            if pt is None:
+                raise ValueError('port trait name \"%s\" not registered' % ptn)
+            names.append(pt.name)
+
+        batches = self.grab_datums_from_ports(names, max_count)
+
+        values = []
+        for ptn, batch in zip(ptns, batches):
+            tt = self._port_trait_set[ptn].type_trait
+            if tt.converter_in is not None:
+                batch = [tt.converter_in(dat) for dat in batch]
+            values.append(batch)
+
+        return values
+
+    def push_batch_to_port_using_trait(self, ptn, vals):
+        """
+        Push a list of values to port using trait.
+
+        The values are converted as in push_to_port_using_trait(), and
+        pushed in a single call when the trait has a converter.
+
+        :param ptn: port trait name
+        :param vals: values to put on port, in order
+        """
+        pt = self._port_trait_set.get(ptn, None)
+        if pt is None:
+            raise ValueError('port trait name \"%s\" not registered' % ptn)
+
+        tt = pt.type_trait
+        if tt.converter_out is not None:
+            self.push_datums_to_port(pt.name,
+                                     [tt.converter_out(val) for val in vals])
+        else:
+            for val in vals:
+                self.push_datum_to_port(pt.name, val)
+
     def declare_config_using_trait(self, name):
         """
         Declare a process config entry from the named trait.
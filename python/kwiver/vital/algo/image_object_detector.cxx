@@ -3,6 +3,7 @@
 // https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
 
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 #include <python/kwiver/vital/algo/trampoline/image_object_detector_trampoline.txx>
 #include <python/kwiver/vital/algo/image_object_detector.h>
 
@@ -18,7 +19,8 @@ void image_object_detector(py::module &m)
               image_object_detector_trampoline<> >(m, "ImageObjectDetector")
     .def(py::init())
     .def_static("static_type_name", &kwiver::vital::algo::image_object_detector::static_type_name)
-    .def("detect", &kwiver::vital::algo::image_object_detector::detect);
+    .def("detect", &kwiver::vital::algo::image_object_detector::detect)
+    .def("batch_detect", &kwiver::vital::algo::image_object_detector::batch_detect);
 }
 }
 }
@@ -24,6 +24,8 @@ void interpolate_track(py::module &m)
         &kwiver::vital::algo::interpolate_track::static_type_name)
     .def("interpolate",
         &kwiver::vital::algo::interpolate_track::interpolate)
+    .def("batch_interpolate",
+        &kwiver::vital::algo::interpolate_track::batch_interpolate)
     .def("set_video_input",
         &kwiver::vital::algo::interpolate_track::set_video_input)
     .def("set_progress_callback",
@@ -54,6 +54,17 @@ class image_object_detector_trampoline :
         image_data
       );
     }
+
+    std::vector<kwiver::vital::detected_object_set_sptr>
+    batch_detect(std::vector<kwiver::vital::image_container_sptr> const& images) const override
+    {
+      VITAL_PYBIND11_OVERLOAD(
+        std::vector<kwiver::vital::detected_object_set_sptr>,
+        kwiver::vital::algo::image_object_detector,
+        batch_detect,
+        images
+      );
+    }
 };
 }
 }
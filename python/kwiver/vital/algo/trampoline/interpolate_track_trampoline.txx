@@ -58,6 +58,17 @@ class interpolate_track_trampoline :
         init_states
       );
     }
+
+    std::vector<kwiver::vital::track_sptr>
+    batch_interpolate( std::vector<kwiver::vital::track_sptr> const& tracks ) override
+    {
+      VITAL_PYBIND11_OVERLOAD(
+        std::vector<kwiver::vital::track_sptr>,
+        kwiver::vital::algo::interpolate_track,
+        batch_interpolate,
+        tracks
+      );
+    }
 };
 
 }
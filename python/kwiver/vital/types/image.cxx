@@ -8,9 +8,46 @@
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 
+#include <cstdint>
+#include <memory>
+
 namespace kwiver {
 namespace vital  {
 namespace python {
+// ----------------------------------------------------------------------------
+numpy_image_memory
+::numpy_image_memory(py::array const& array)
+  : m_array(array)
+  , m_data(const_cast<void*>(array.data()))
+{
+  this->size_ = static_cast<size_t>(array.nbytes());
+}
+
+// ----------------------------------------------------------------------------
+// The last image using the array may go away in a thread not holding the
+// GIL, such as a pipeline thread.
+numpy_image_memory
+::~numpy_image_memory()
+{
+  if (Py_IsInitialized())
+  {
+    py::gil_scoped_acquire const gil;
+    m_array = py::object();
+  }
+  else
+  {
+    m_array.release();
+  }
+}
+
+// ----------------------------------------------------------------------------
+void*
+numpy_image_memory
+::data()
+{
+  return m_data;
+}
+
 pixel_traits::pixel_type
 kwiver::vital::python::image::pixel_type(std::shared_ptr<image_t> &self)
 {
@@ -189,13 +226,13 @@ const char* kwiver::vital::python::image::get_trait_format_descriptor(
             switch (traits.num_bytes)
             {
                 case 1:
-                    return "b";
+                    return "B";
                 case 2:
-                    return "h";
+                    return "H";
                 case 4:
-                    return "i";
+                    return "I";
                 case 8:
-                    return "q";
+                    return "Q";
                 default:
                     throw std::runtime_error(
                         "Unsigned must have itemsize 1, 2, 4, or 8, not " + std::to_string(itemsize));
@@ -204,13 +241,13 @@ const char* kwiver::vital::python::image::get_trait_format_descriptor(
             switch (traits.num_bytes)
             {
                 case 1:
-                    return "B";
+                    return "b";
                 case 2:
-                    return "H";
+                    return "h";
                 case 4:
-                    return "I";
+                    return "i";
                 case 8:
-                    return "Q";
+                    return "q";
                 default:
                     throw std::runtime_error(
                         "Signed must have itemsize 1, 2, 4, or 8, not " + std::to_string(itemsize));
@@ -260,12 +297,250 @@ py::buffer_info kwiver::vital::python::image::get_buffer_info(image_t &img)
             //{ img.h_step(),
             //  img.w_step(),
             //  img.d_step() }
-            { itemsize * img.h_step(),
-              itemsize * img.w_step(),
-              itemsize * img.d_step() }
+            { static_cast<py::ssize_t>(itemsize) * img.h_step(),
+              static_cast<py::ssize_t>(itemsize) * img.w_step(),
+              static_cast<py::ssize_t>(itemsize) * img.d_step() }
     );
 }
 
+// ----------------------------------------------------------------------------
+// The views below keep a copy of the image, which shares its memory, alive
+// for as long as the view exists.
+py::array kwiver::vital::python::image::as_numpy_view(image_t const& img)
+{
+  const pixel_traits traits = img.pixel_traits();
+  const py::ssize_t itemsize = static_cast<py::ssize_t>(traits.num_bytes);
+
+  image_t* const owner = new image_t(img);
+  py::capsule base(owner, [](void* p) { delete static_cast<image_t*>(p); });
+
+  return py::array(
+    py::dtype(get_trait_format_descriptor(traits)),
+    { static_cast<py::ssize_t>(img.height()),
+      static_cast<py::ssize_t>(img.width()),
+      static_cast<py::ssize_t>(img.depth()) },
+    { itemsize * img.h_step(),
+      itemsize * img.w_step(),
+      itemsize * img.d_step() },
+    owner->first_pixel(),
+    base);
+}
+
+// ----------------------------------------------------------------------------
+// numpy keeps the object providing __array_interface__ as the base of the
+// array, which keeps the image alive.
+py::dict kwiver::vital::python::image::array_interface(image_t const& img)
+{
+  const pixel_traits traits = img.pixel_traits();
+  const py::ssize_t itemsize = static_cast<py::ssize_t>(traits.num_bytes);
+
+  py::dict iface;
+  iface["version"] = 3;
+  iface["shape"] = py::make_tuple(img.height(), img.width(), img.depth());
+  iface["typestr"] = py::dtype(get_trait_format_descriptor(traits)).attr("str");
+  iface["data"] = py::make_tuple(
+    reinterpret_cast<std::uintptr_t>(img.first_pixel()), false);
+  iface["strides"] = py::make_tuple(itemsize * img.h_step(),
+                                    itemsize * img.w_step(),
+                                    itemsize * img.d_step());
+  return iface;
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// The DLPack ABI, from dlpack.h (https://github.com/dmlc/dlpack)
+struct DLDevice
+{
+  int32_t device_type;
+  int32_t device_id;
+};
+
+struct DLDataType
+{
+  uint8_t code;
+  uint8_t bits;
+  uint16_t lanes;
+};
+
+struct DLTensor
+{
+  void* data;
+  DLDevice device;
+  int32_t ndim;
+  DLDataType dtype;
+  int64_t* shape;
+  int64_t* strides;
+  uint64_t byte_offset;
+};
+
+struct DLManagedTensor
+{
+  DLTensor dl_tensor;
+  void* manager_ctx;
+  void (*deleter)(DLManagedTensor* self);
+};
+
+enum { kDLCPU = 1 };
+enum { kDLInt = 0, kDLUInt = 1, kDLFloat = 2, kDLBool = 6 };
+
+// The tensor handed to the consumer, with the image whose memory it uses
+struct dlpack_image
+{
+  explicit dlpack_image(image_t const& img)
+    : image(img)
+  {
+  }
+
+  image_t image;
+  int64_t shape[3];
+  int64_t strides[3];
+  DLManagedTensor tensor;
+};
+
+void
+dlpack_image_deleter(DLManagedTensor* self)
+{
+  delete static_cast<dlpack_image*>(self->manager_ctx);
+}
+
+// Called when the capsule is destroyed; a consumer renames the capsule
+// when it takes ownership of the tensor.
+void
+dlpack_capsule_destructor(PyObject* capsule)
+{
+  if (PyCapsule_IsValid(capsule, "dltensor"))
+  {
+    auto tensor = static_cast<DLManagedTensor*>(
+      PyCapsule_GetPointer(capsule, "dltensor"));
+    tensor->deleter(tensor);
+  }
+}
+
+}
+
+// ----------------------------------------------------------------------------
+py::capsule kwiver::vital::python::image::to_dlpack(image_t const& img)
+{
+  const pixel_traits traits = img.pixel_traits();
+
+  DLDataType dtype;
+  dtype.bits = static_cast<uint8_t>(traits.num_bytes * 8);
+  dtype.lanes = 1;
+  switch (traits.type)
+  {
+    case pixel_traits::pixel_type::BOOL:
+      dtype.code = kDLBool;
+      break;
+    case pixel_traits::pixel_type::UNSIGNED:
+      dtype.code = kDLUInt;
+      break;
+    case pixel_traits::pixel_type::SIGNED:
+      dtype.code = kDLInt;
+      break;
+    case pixel_traits::pixel_type::FLOAT:
+      dtype.code = kDLFloat;
+      break;
+    default:
+      throw std::runtime_error(
+        "Cannot handle traits with unknown pixel type ");
+  }
+
+  auto ctx = new dlpack_image(img);
+  ctx->shape[0] = static_cast<int64_t>(img.height());
+  ctx->shape[1] = static_cast<int64_t>(img.width());
+  ctx->shape[2] = static_cast<int64_t>(img.depth());
+  // DLPack strides are in elements, as are the image steps
+  ctx->strides[0] = img.h_step();
+  ctx->strides[1] = img.w_step();
+  ctx->strides[2] = img.d_step();
+
+  DLTensor& t = ctx->tensor.dl_tensor;
+  t.data = const_cast<void*>(ctx->image.first_pixel());
+  t.device.device_type = kDLCPU;
+  t.device.device_id = 0;
+  t.ndim = 3;
+  t.dtype = dtype;
+  t.shape = ctx->shape;
+  t.strides = ctx->strides;
+  t.byte_offset = 0;
+  ctx->tensor.manager_ctx = ctx;
+  ctx->tensor.deleter = &dlpack_image_deleter;
+
+  PyObject* const capsule =
+    PyCapsule_New(&ctx->tensor, "dltensor", &dlpack_capsule_destructor);
+  if (!capsule)
+  {
+    delete ctx;
+    throw py::error_already_set();
+  }
+
+  return py::reinterpret_steal<py::capsule>(capsule);
+}
+
+// ----------------------------------------------------------------------------
+py::tuple kwiver::vital::python::image::dlpack_device(image_t const&)
+{
+  // Vital images are always in host memory
+  return py::make_tuple(static_cast<int>(kDLCPU), 0);
+}
+
+// ----------------------------------------------------------------------------
+image_t kwiver::vital::python::image::new_image_sharing_numpy(py::array array)
+{
+  if (!array.writeable())
+  {
+    throw std::runtime_error("Cannot share the memory of a read-only array");
+  }
+
+  py::buffer_info const info = array.request();
+
+  if (info.ndim != 2 && info.ndim != 3)
+  {
+    throw std::runtime_error("Incompatible buffer dimension!");
+  }
+
+  pixel_traits::pixel_type type;
+  switch (array.dtype().kind())
+  {
+    case 'b':
+      type = pixel_traits::pixel_type::BOOL;
+      break;
+    case 'u':
+      type = pixel_traits::pixel_type::UNSIGNED;
+      break;
+    case 'i':
+      type = pixel_traits::pixel_type::SIGNED;
+      break;
+    case 'f':
+      type = pixel_traits::pixel_type::FLOAT;
+      break;
+    default:
+      throw std::runtime_error("Unsupported array type for an image");
+  }
+
+  pixel_traits const traits(type, static_cast<size_t>(info.itemsize));
+  for (auto const stride : info.strides)
+  {
+    if (stride % info.itemsize)
+    {
+      throw std::runtime_error("Array strides must be whole pixels");
+    }
+  }
+
+  // numpy images are in height x width format by default (row major)
+  size_t const height = info.shape[0];
+  size_t const width = info.shape[1];
+  size_t const depth = (info.ndim == 3 ? info.shape[2] : 1);
+  ptrdiff_t const h_step = info.strides[0] / info.itemsize;
+  ptrdiff_t const w_step = info.strides[1] / info.itemsize;
+  ptrdiff_t const d_step = (info.ndim == 3 ? info.strides[2] / info.itemsize : 1);
+
+  auto const mem = std::make_shared<numpy_image_memory>(array);
+  return image_t(mem, info.ptr, width, height, depth,
+                 w_step, h_step, d_step, traits);
+}
+
 py::object kwiver::vital::python::image::asarray(image_t img)
 {
   const pixel_traits traits = img.pixel_traits();
@@ -530,9 +805,14 @@ void kwiver::vital::python::image::image(py::module& m)
           >>> print(vital_img.asarray())
           >>> assert vital_img.pixel_type_name() == 'uint8'
           >>> assert np.all(np_img == vital_img.asarray())
-          >>> # Currently we never share memory
+          >>> # The constructor and asarray() copy
           >>> np_img += 1
           >>> assert np.all(np_img != vital_img.asarray())
+          >>> # from_numpy() and asarray(copy=False) share memory
+          >>> shared_img = Image.from_numpy(np_img)
+          >>> view = shared_img.asarray(copy=False)
+          >>> np_img += 1
+          >>> assert np.all(np_img == view)
       )";
 
   py::enum_<pixel_traits::pixel_type>(img, "Types") .value("PIXEL_UNKNOWN",
@@ -582,13 +862,27 @@ void kwiver::vital::python::image::image(py::module& m)
   .def("pixel_num_bytes", &kwiver::vital::python::image::pixel_num_bytes)
   .def("__getitem__", &kwiver::vital::python::image::get_pixel)
   .def_buffer(&kwiver::vital::python::image::get_buffer_info)
-  .def("asarray", [](image_t &img){
-        // It may be possible to write this method to share memory between
-        // vital and numpy using the py::capsule class. For references see:
-        // https://stackoverflow.com/questions/44659924/ret-nparrays-pybind11
+  .def("asarray", [](image_t &img, bool copy) -> py::object {
+        if (!copy)
+        {
+          return kwiver::vital::python::image::as_numpy_view(img);
+        }
         py::object np_arr = kwiver::vital::python::image::asarray(img);
         return np_arr;
-      }, py::doc("Copy the image into a numpy array'"));
+      }, py::arg("copy")=true,
+      py::doc("Copy the image into a numpy array, or if copy is False, return "
+              "a strided numpy view of the image memory which keeps it alive"))
+  .def_property_readonly("__array_interface__",
+    &kwiver::vital::python::image::array_interface)
+  .def("__dlpack__", [](image_t &img, py::object) {
+        return kwiver::vital::python::image::to_dlpack(img);
+      }, py::arg("stream")=py::none(),
+      py::doc("Export the image memory as a DLPack capsule without copying"))
+  .def("__dlpack_device__", &kwiver::vital::python::image::dlpack_device)
+  .def_static("from_numpy", &kwiver::vital::python::image::new_image_sharing_numpy,
+    py::arg("array"),
+    py::doc("Create a vital image which shares the memory of a 2D or 3D numpy "
+            "array, keeping the array alive while the image memory is in use"));
 }
 }
 }
@@ -21,6 +21,21 @@ namespace vital {
 
 namespace python {
 
+/// Image memory borrowed from a numpy array, which it keeps alive.
+class numpy_image_memory
+  : public image_memory
+{
+public:
+  explicit numpy_image_memory( py::array const& array );
+  virtual ~numpy_image_memory();
+
+  void* data() override;
+
+private:
+  py::object m_array;
+  void* m_data;
+};
+
 namespace image {
 
 void image( py::module& m );
@@ -92,6 +107,11 @@ new_image_from_numpy( py::array_t< T > array )
 const char* get_trait_format_descriptor( const pixel_traits& traits );
 py::buffer_info get_buffer_info( image_t& img );
 py::object asarray( image_t img );
+py::array as_numpy_view( image_t const& img );
+py::dict array_interface( image_t const& img );
+py::capsule to_dlpack( image_t const& img );
+py::tuple dlpack_device( image_t const& img );
+image_t new_image_sharing_numpy( py::array array );
 
 } // namespace image
 
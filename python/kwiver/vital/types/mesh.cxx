@@ -64,16 +64,7 @@ PYBIND11_MODULE(mesh, m)
         for (unsigned int i = 0; i < faces.size(); ++i)
         {
             py::list verts;
-            if (face_dim == 0)
-            {
-                auto curr_face =
-                    static_cast<const kv::mesh_face_array&>(faces)[i];
-                for ( unsigned int j = 0; j < curr_face.size(); ++j )
-                {
-                    verts.append(curr_face[j]);
-                }
-            }
-            else if (face_dim == 3)
+            if (face_dim == 3)
             {
                 auto curr_face =
                     static_cast<const kv::mesh_regular_face_array<3>&>(faces)[i];
@@ -91,6 +82,13 @@ PYBIND11_MODULE(mesh, m)
                     verts.append(curr_face[j]);
                 }
             }
+            else
+            {
+                for ( unsigned int j = 0; j < faces.num_verts(i); ++j )
+                {
+                    verts.append(faces(i, j));
+                }
+            }
             retVal.append(verts);
         }
 
@@ -17,6 +17,7 @@
 #include <vital/vital_config.h>
 
 #include <sprokit/pipeline_util/pipeline_builder.h>
+#include <sprokit/pipeline_util/pipeline_snapshot.h>
 #include <sprokit/pipeline/pipeline.h>
 #include <sprokit/pipeline/datum.h>
 #include <sprokit/pipeline/scheduler.h>
@@ -28,8 +29,14 @@
 
 #include <kwiversys/SystemTools.hxx>
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 namespace {
 
@@ -38,6 +45,10 @@ using plugin_factory =  kwiver::vital::implementation_factory_by_name< kwiver::e
 static kwiver::vital::config_block_key_t const scheduler_block = kwiver::vital::config_block_key_t("_scheduler");
 static kwiver::vital::config_block_key_t const epx_block_key = kwiver::vital::config_block_key_t("_pipeline:embedded_pipeline_extension");
 
+// How often the background send and receive threads check whether they
+// should stop while waiting on the adapter queues.
+std::chrono::milliseconds const poll_interval{ 50 };
+
 } // end
 
 namespace kwiver {
@@ -71,9 +82,23 @@ class embedded_pipeline::priv
   bool connect_input_adapter();
   bool connect_output_adapter();
 
+  bool handle_output( kwiver::adapter::adapter_data_set_t const& ads );
+  void start_sender();
+  void start_receiver();
+  void stop_workers();
+  void sender();
+  void receiver();
+
+  struct pending_send
+  {
+    std::vector< kwiver::adapter::adapter_data_set_t > sets;
+    std::promise< void > done;
+  };
+
   vital::logger_handle_t m_logger;
-  bool m_at_end {false};
+  std::atomic< bool > m_at_end {false};
   bool m_stop_flag {false};
+  bool m_started {false};
   bool m_input_adapter_connected {false};
   bool m_output_adapter_connected {false};
 
@@ -91,6 +116,23 @@ class embedded_pipeline::priv
   std::string m_app_name;
   std::string m_app_version;
   std::string m_app_prefix;
+
+  // Background send and receive. The queues and threads are guarded by
+  // m_async_mutex.
+  std::mutex m_async_mutex;
+  std::condition_variable m_async_cv;
+  std::deque< pending_send > m_pending_sends;
+  std::deque< std::promise< kwiver::adapter::adapter_data_set_t > > m_pending_receives;
+  std::function< void( kwiver::adapter::adapter_data_set_t ) > m_output_callback;
+  std::thread m_sender;
+  std::thread m_receiver;
+  std::atomic< bool > m_workers_stop {false};
+
+  std::string m_checkpoint_file;
+  double m_checkpoint_interval {0};
+
+  // Declared last so it stops before anything it uses is destroyed
+  std::unique_ptr< sprokit::pipeline_checkpointer > m_checkpointer;
 }; // end class embedded_pipeline::priv
 
 // ============================================================================
@@ -138,6 +180,7 @@ ::embedded_pipeline()
 embedded_pipeline
 ::~embedded_pipeline()
 {
+  m_priv->stop_workers();
 }
 
 // ----------------------------------------------------------------------------
@@ -282,6 +325,75 @@ ::send( kwiver::adapter::adapter_data_set_t ads )
   m_priv->m_input_adapter.send( ads );
 }
 
+// ------------------------------------------------------------------
+void
+embedded_pipeline
+::send( std::vector< kwiver::adapter::adapter_data_set_t > const& sets )
+{
+  if ( ! input_adapter_connected() )
+  {
+    throw std::runtime_error( "Input adapter not connected." );
+  }
+
+  m_priv->m_input_adapter.send( sets );
+}
+
+// ------------------------------------------------------------------
+bool
+embedded_pipeline
+::try_send( kwiver::adapter::adapter_data_set_t ads )
+{
+  if ( ! input_adapter_connected() )
+  {
+    throw std::runtime_error( "Input adapter not connected." );
+  }
+
+  return m_priv->m_input_adapter.try_send( ads );
+}
+
+// ------------------------------------------------------------------
+std::future< void >
+embedded_pipeline
+::send_async( std::vector< kwiver::adapter::adapter_data_set_t > sets )
+{
+  if ( ! input_adapter_connected() )
+  {
+    throw std::runtime_error( "Input adapter not connected." );
+  }
+
+  priv::pending_send item;
+  item.sets = std::move( sets );
+  auto result = item.done.get_future();
+  {
+    std::lock_guard< std::mutex > lock( m_priv->m_async_mutex );
+    m_priv->m_pending_sends.push_back( std::move( item ) );
+  }
+
+  m_priv->start_sender();
+  m_priv->m_async_cv.notify_all();
+  return result;
+}
+
+// ------------------------------------------------------------------
+void
+embedded_pipeline
+::set_backpressure_callback( std::function< void( bool ) > notify,
+                             size_t high, size_t low )
+{
+  if ( ! input_adapter_connected() )
+  {
+    throw std::runtime_error( "Input adapter not connected." );
+  }
+
+  if ( high == 0 )
+  {
+    high = m_priv->m_input_adapter.capacity();
+  }
+
+  m_priv->m_input_adapter.set_backpressure_callback( std::move( notify ),
+                                                     high, low );
+}
+
 // ------------------------------------------------------------------
 void
 embedded_pipeline
@@ -293,7 +405,23 @@ ::send_end_of_input()
   }
 
   auto ds = kwiver::adapter::adapter_data_set::create( kwiver::adapter::adapter_data_set::end_of_input );
-  this->send( ds );
+
+  // Keep the end of input behind any data sets still being sent in
+  // the background.
+  bool sending_async;
+  {
+    std::lock_guard< std::mutex > lock( m_priv->m_async_mutex );
+    sending_async = m_priv->m_sender.joinable();
+  }
+
+  if ( sending_async )
+  {
+    this->send_async( { ds } ).get();
+  }
+  else
+  {
+    this->send( ds );
+  }
 }
 
 // ------------------------------------------------------------------
@@ -312,23 +440,85 @@ ::receive()
                << "Probable deadlock." );
   }
 
+  if ( m_priv->m_output_callback )
+  {
+    throw std::runtime_error( "receive() can not be used with an output callback." );
+  }
+
   auto ads =  m_priv->m_output_adapter.receive();
-  m_priv->m_at_end = ads->is_end_of_data();
+  m_priv->handle_output( ads );
+  return ads;
+}
 
-  // This will not catch the case where the pipeline has a sink and
-  // produces no output
-  if ( m_priv->m_at_end )
+// ------------------------------------------------------------------
+kwiver::adapter::adapter_data_set_t
+embedded_pipeline
+::try_receive()
+{
+  if ( ! output_adapter_connected() )
   {
-    // call end_of_data() hook
-    if ( m_priv->m_hooks)
-    {
-      m_priv->m_hooks->end_of_output( *m_priv->m_context );
-    }
+    throw std::runtime_error( "Output adapter not connected." );
+  }
+
+  if ( m_priv->m_output_callback )
+  {
+    throw std::runtime_error( "try_receive() can not be used with an output callback." );
   }
 
+  auto ads = m_priv->m_output_adapter.try_receive();
+  if ( ads )
+  {
+    m_priv->handle_output( ads );
+  }
   return ads;
 }
 
+// ------------------------------------------------------------------
+std::future< kwiver::adapter::adapter_data_set_t >
+embedded_pipeline
+::receive_async()
+{
+  if ( ! output_adapter_connected() )
+  {
+    throw std::runtime_error( "Output adapter not connected." );
+  }
+
+  if ( m_priv->m_output_callback )
+  {
+    throw std::runtime_error( "receive_async() can not be used with an output callback." );
+  }
+
+  std::promise< kwiver::adapter::adapter_data_set_t > request;
+  auto result = request.get_future();
+  {
+    std::lock_guard< std::mutex > lock( m_priv->m_async_mutex );
+    m_priv->m_pending_receives.push_back( std::move( request ) );
+  }
+
+  m_priv->start_receiver();
+  m_priv->m_async_cv.notify_all();
+  return result;
+}
+
+// ------------------------------------------------------------------
+void
+embedded_pipeline
+::set_output_callback(
+  std::function< void( kwiver::adapter::adapter_data_set_t ) > cb )
+{
+  if ( ! output_adapter_connected() )
+  {
+    throw std::runtime_error( "Output adapter not connected." );
+  }
+
+  if ( m_priv->m_started )
+  {
+    throw std::runtime_error( "set_output_callback() must be called before start()." );
+  }
+
+  m_priv->m_output_callback = std::move( cb );
+}
+
 // ------------------------------------------------------------------
 bool
 embedded_pipeline
@@ -369,6 +559,19 @@ embedded_pipeline
 ::start()
 {
   m_priv->m_scheduler->start();
+  m_priv->m_started = true;
+
+  if ( ! m_priv->m_checkpoint_file.empty() )
+  {
+    m_priv->m_checkpointer.reset( new sprokit::pipeline_checkpointer(
+      m_priv->m_pipeline, m_priv->m_checkpoint_file,
+      m_priv->m_checkpoint_interval ) );
+  }
+
+  if ( m_priv->m_output_callback )
+  {
+    m_priv->start_receiver();
+  }
 }
 
 // ------------------------------------------------------------------
@@ -377,6 +580,15 @@ embedded_pipeline
 ::wait()
 {
   m_priv->m_scheduler->wait();
+
+  if ( m_priv->m_checkpointer )
+  {
+    m_priv->m_checkpointer->stop( true );
+  }
+
+  // The pipeline has terminated, so the receiver only has to deliver
+  // what is left in the output queue.
+  m_priv->stop_workers();
 }
 
 // ------------------------------------------------------------------
@@ -389,6 +601,47 @@ ::stop()
   // Note: Can throws stop_before_start_exception Thrown when the
   // scheduler has not been started
   m_priv->m_scheduler->stop();
+  m_priv->stop_workers();
+
+  if ( m_priv->m_checkpointer )
+  {
+    m_priv->m_checkpointer->stop();
+  }
+}
+
+// ------------------------------------------------------------------
+void
+embedded_pipeline
+::save_state( std::string const& file )
+{
+  sprokit::write_pipeline_snapshot( file, m_priv->m_pipeline->save_state() );
+}
+
+// ------------------------------------------------------------------
+void
+embedded_pipeline
+::restore_state( std::string const& file )
+{
+  if ( m_priv->m_started )
+  {
+    throw std::runtime_error( "Pipeline state must be restored before the pipeline is started." );
+  }
+
+  m_priv->m_pipeline->restore_state( sprokit::read_pipeline_snapshot( file ) );
+}
+
+// ------------------------------------------------------------------
+void
+embedded_pipeline
+::set_checkpoint( std::string const& file, double interval )
+{
+  if ( m_priv->m_started )
+  {
+    throw std::runtime_error( "Checkpointing must be set before the pipeline is started." );
+  }
+
+  m_priv->m_checkpoint_file = file;
+  m_priv->m_checkpoint_interval = interval;
 }
 
 // ------------------------------------------------------------------
@@ -494,4 +747,189 @@ connect_output_adapter()
   return false;
 }
 
+// ------------------------------------------------------------------
+bool
+embedded_pipeline::priv::
+handle_output( kwiver::adapter::adapter_data_set_t const& ads )
+{
+  m_at_end = ads->is_end_of_data();
+
+  // This will not catch the case where the pipeline has a sink and
+  // produces no output
+  if ( m_at_end )
+  {
+    // call end_of_data() hook
+    if ( m_hooks)
+    {
+      m_hooks->end_of_output( *m_context );
+    }
+  }
+
+  return m_at_end;
+}
+
+// ------------------------------------------------------------------
+void
+embedded_pipeline::priv::
+start_sender()
+{
+  std::lock_guard< std::mutex > lock( m_async_mutex );
+  if ( ! m_sender.joinable() )
+  {
+    m_sender = std::thread( &priv::sender, this );
+  }
+}
+
+// ------------------------------------------------------------------
+void
+embedded_pipeline::priv::
+start_receiver()
+{
+  std::lock_guard< std::mutex > lock( m_async_mutex );
+  if ( ! m_receiver.joinable() )
+  {
+    m_receiver = std::thread( &priv::receiver, this );
+  }
+}
+
+// ------------------------------------------------------------------
+void
+embedded_pipeline::priv::
+stop_workers()
+{
+  {
+    std::lock_guard< std::mutex > lock( m_async_mutex );
+    m_workers_stop = true;
+  }
+  m_async_cv.notify_all();
+
+  if ( m_sender.joinable() )
+  {
+    m_sender.join();
+  }
+  if ( m_receiver.joinable() )
+  {
+    m_receiver.join();
+  }
+}
+
+// ------------------------------------------------------------------
+void
+embedded_pipeline::priv::
+sender()
+{
+  std::unique_lock< std::mutex > lock( m_async_mutex );
+  while ( true )
+  {
+    m_async_cv.wait( lock, [this]{
+        return m_workers_stop || ! m_pending_sends.empty(); } );
+    if ( m_pending_sends.empty() )
+    {
+      return;
+    }
+
+    auto item = std::move( m_pending_sends.front() );
+    m_pending_sends.pop_front();
+    lock.unlock();
+
+    bool sent = true;
+    for ( auto const& ds : item.sets )
+    {
+      while ( sent && ! m_input_adapter.send( ds, poll_interval ) )
+      {
+        sent = ! m_workers_stop;
+      }
+    }
+
+    if ( sent && ! m_workers_stop )
+    {
+      item.done.set_value();
+    }
+    else
+    {
+      item.done.set_exception( std::make_exception_ptr( std::runtime_error(
+        "Pipeline stopped before all data sets were sent." ) ) );
+    }
+
+    lock.lock();
+  }
+}
+
+// ------------------------------------------------------------------
+void
+embedded_pipeline::priv::
+receiver()
+{
+  while ( true )
+  {
+    std::promise< kwiver::adapter::adapter_data_set_t > request;
+    {
+      std::unique_lock< std::mutex > lock( m_async_mutex );
+      m_async_cv.wait( lock, [this]{
+          return m_workers_stop || m_output_callback ||
+                 ! m_pending_receives.empty(); } );
+      if ( ! m_output_callback )
+      {
+        if ( m_pending_receives.empty() )
+        {
+          return;
+        }
+        request = std::move( m_pending_receives.front() );
+        m_pending_receives.pop_front();
+      }
+    }
+
+    kwiver::adapter::adapter_data_set_t ads;
+    while ( ! m_output_adapter.receive( ads, poll_interval ) )
+    {
+      if ( m_workers_stop )
+      {
+        break;
+      }
+    }
+
+    if ( ! ads )
+    {
+      // Stopped with no more output; fail whatever is still requested.
+      std::lock_guard< std::mutex > lock( m_async_mutex );
+      if ( ! m_output_callback )
+      {
+        m_pending_receives.push_front( std::move( request ) );
+      }
+      for ( auto& r : m_pending_receives )
+      {
+        r.set_exception( std::make_exception_ptr( std::runtime_error(
+          "Pipeline stopped before producing a data set." ) ) );
+      }
+      m_pending_receives.clear();
+      return;
+    }
+
+    bool const at_end = handle_output( ads );
+    if ( ! m_output_callback )
+    {
+      request.set_value( ads );
+      continue;
+    }
+
+    try
+    {
+      m_output_callback( ads );
+    }
+    catch ( std::exception const& e )
+    {
+      LOG_ERROR( m_logger, "Output callback failed: " << e.what() );
+    }
+    catch ( ... )
+    {
+      LOG_ERROR( m_logger, "Output callback failed" );
+    }
+
+    if ( at_end )
+    {
+      return;
+    }
+  }
+}
+
 } // end namespace kwiver
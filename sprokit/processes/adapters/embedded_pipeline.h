@@ -16,8 +16,11 @@
 
 #include <vital/logger/logger.h>
 
+#include <functional>
+#include <future>
 #include <istream>
 #include <string>
+#include <vector>
 
 namespace kwiver {
 
@@ -111,6 +114,12 @@ namespace kwiver {
     // This is unexpected.
   }
 \endcode
+ *
+ * Applications that can not block, such as those with an event loop,
+ * can use try_send(), send_async() and try_receive(), or have each
+ * output data set passed to a callback (see set_output_callback()) and
+ * be told when the pipeline can not keep up with the input (see
+ * set_backpressure_callback()) instead.
  */
 class KWIVER_ADAPTER_EXPORT embedded_pipeline
 {
@@ -177,6 +186,68 @@ class KWIVER_ADAPTER_EXPORT embedded_pipeline
    */
   void send( kwiver::adapter::adapter_data_set_t ads );
 
+  /**
+   * @brief Send data sets to input adapter.
+   *
+   * This method sends the data sets to the input adapter in order,
+   * blocking only while the pipeline can not accept more input.
+   *
+   * @param sets Data sets to send
+   */
+  void send( std::vector< kwiver::adapter::adapter_data_set_t > const& sets );
+
+  /**
+   * @brief Send data set to input adapter without blocking.
+   *
+   * @param ads Data set to send
+   *
+   * @return \b true if the data set was sent, \b false if the pipeline
+   * can not accept more input at this time.
+   */
+  bool try_send( kwiver::adapter::adapter_data_set_t ads );
+
+  /**
+   * @brief Send data sets to input adapter in the background.
+   *
+   * This method returns at once. The data sets are sent in order,
+   * after those of earlier calls, from a thread owned by the embedded
+   * pipeline, and the returned future becomes ready once the last of
+   * them has been accepted by the pipeline.
+   *
+   * If the pipeline is stopped or terminates before all data sets have
+   * been sent, the future holds a std::runtime_error.
+   *
+   * @param sets Data sets to send
+   *
+   * @return Future which is ready when all data sets have been sent.
+   */
+  std::future< void >
+  send_async( std::vector< kwiver::adapter::adapter_data_set_t > sets );
+
+  /**
+   * @brief Set callback for input backpressure notifications.
+   *
+   * The callback is called with \b true when the input queue of the
+   * pipeline holds \p high data sets, after which sending more input
+   * may block, and with \b false when the pipeline has drained it
+   * down to \p low data sets. The size of the queue is set by the
+   * queue_size configuration of the input adapter process.
+   *
+   * The callback is called from the thread that sent the data set or
+   * from a pipeline thread, so it should only record or post the
+   * notification.
+   *
+   * @param notify Callback, or an empty function to remove it.
+   * @param high High watermark, from 1 to the queue size, or 0 for the
+   * queue size.
+   * @param low Low watermark, less than \p high.
+   *
+   * @throws std::runtime_error if the input adapter is not connected.
+   * @throws std::invalid_argument if the watermarks are out of range.
+   */
+  void set_backpressure_callback( std::function< void( bool ) > notify,
+                                  size_t high = 0, size_t low = 0 );
+
   /**
    * @brief Send end of input into pipeline.
    *
@@ -212,6 +283,44 @@ class KWIVER_ADAPTER_EXPORT embedded_pipeline
    */
   kwiver::adapter::adapter_data_set_t receive();
 
+  /**
+   * @brief Get pipeline output data without blocking.
+   *
+   * @return Data set from the pipeline, or nullptr if none is ready.
+   */
+  kwiver::adapter::adapter_data_set_t try_receive();
+
+  /**
+   * @brief Get pipeline output data in the background.
+   *
+   * This method returns at once with a future for the next output data
+   * set which has not been requested by an earlier call. The data set
+   * is received by a thread owned by the embedded pipeline.
+   *
+   * If the pipeline is stopped before producing the data set, the
+   * future holds a std::runtime_error.
+   *
+   * @return Future data set from the pipeline.
+   */
+  std::future< kwiver::adapter::adapter_data_set_t > receive_async();
+
+  /**
+   * @brief Pass each pipeline output to a callback.
+   *
+   * When set, every data set produced by the pipeline, up to and
+   * including the end of data marker, is received by a thread owned
+   * by the embedded pipeline and passed to \p cb. The callback is
+   * called from that thread, one data set at a time. Exceptions thrown
+   * by the callback are logged and otherwise ignored.
+   *
+   * This method must be called before start(). The receive() methods
+   * can not be used while a callback is set.
+   *
+   * @param cb Callback for output data sets.
+   */
+  void set_output_callback(
+    std::function< void( kwiver::adapter::adapter_data_set_t ) > cb );
+
   /**
    * @brief Can pipeline accept more input?
    *
@@ -277,6 +386,46 @@ class KWIVER_ADAPTER_EXPORT embedded_pipeline
    */
   void stop();
 
+  /**
+   * @brief Save the state of the pipeline processes to a file.
+   *
+   * The state is what processes such as trackers learn from the data
+   * they have seen. Restoring it with restore_state() lets a restarted
+   * pipeline continue without a cold start. This may be called while
+   * the pipeline is running.
+   *
+   * @param file Name of the snapshot file.
+   *
+   * @throws kwiver::vital::file_write_exception if the file cannot be written.
+   */
+  void save_state( std::string const& file );
+
+  /**
+   * @brief Restore the state of the pipeline processes from a file.
+   *
+   * This must be called after build_pipeline() and before start().
+   *
+   * @param file Name of a snapshot file written by save_state() or
+   * by checkpointing.
+   *
+   * @throws kwiver::vital::file_not_found_exception if the file does not exist.
+   * @throws kwiver::vital::invalid_file if the file is not a snapshot.
+   */
+  void restore_state( std::string const& file );
+
+  /**
+   * @brief Periodically save the state of the pipeline processes.
+   *
+   * Once the pipeline is started, its state is saved to \c file every
+   * \c interval seconds, and once more when wait() returns. Checkpoints
+   * that fail are logged and skipped. This must be called before
+   * start().
+   *
+   * @param file Name of the snapshot file.
+   * @param interval Seconds between snapshots.
+   */
+  void set_checkpoint( std::string const& file, double interval );
+
   /**
    * @brief Get list of input ports.
    *
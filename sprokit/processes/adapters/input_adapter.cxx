@@ -60,6 +60,59 @@ ::send( kwiver::adapter::adapter_data_set_t dat )
   m_interface_queue->Send( dat );
 }
 
+// ------------------------------------------------------------------
+void
+input_adapter
+::send( std::vector< kwiver::adapter::adapter_data_set_t > const& dat )
+{
+  for ( auto const& ds : dat )
+  {
+    m_interface_queue->Send( ds );
+  }
+}
+
+// ------------------------------------------------------------------
+bool
+input_adapter
+::send( kwiver::adapter::adapter_data_set_t dat,
+        std::chrono::milliseconds timeout )
+{
+  return m_interface_queue->Send( dat, timeout );
+}
+
+// ------------------------------------------------------------------
+bool
+input_adapter
+::try_send( kwiver::adapter::adapter_data_set_t dat )
+{
+  return m_interface_queue->TrySend( dat );
+}
+
+// ------------------------------------------------------------------
+void
+input_adapter
+::set_backpressure_callback( std::function< void( bool ) > notify,
+                             size_t high, size_t low )
+{
+  m_interface_queue->SetWatermarks( std::move( notify ), high, low );
+}
+
+// ------------------------------------------------------------------
+size_t
+input_adapter
+::capacity() const
+{
+  return m_interface_queue->Capacity();
+}
+
+// ------------------------------------------------------------------
+size_t
+input_adapter
+::size() const
+{
+  return m_interface_queue->Size();
+}
+
 // ------------------------------------------------------------------
 bool
 input_adapter
@@ -15,6 +15,10 @@
 #include "adapter_types.h"
 #include "adapter_data_set.h"
 
+#include <chrono>
+#include <functional>
+#include <vector>
+
 namespace kwiver {
 
 class input_adapter_process;
@@ -78,6 +82,65 @@ class KWIVER_ADAPTER_EXPORT input_adapter
    */
   void send( kwiver::adapter::adapter_data_set_t dat );
 
+  /**
+   * @brief Send data sets to input adapter process.
+   *
+   * The data sets are sent in order, waiting for space in the
+   * interface queue only when it is full.
+   *
+   * @param dat Data sets to send.
+   */
+  void send( std::vector< kwiver::adapter::adapter_data_set_t > const& dat );
+
+  /**
+   * @brief Send data set to input adapter process, waiting at most \p timeout.
+   *
+   * @param dat Data set to send.
+   * @param timeout Longest time to wait for space in the interface queue.
+   *
+   * @return \b true if the data set was sent.
+   */
+  bool send( kwiver::adapter::adapter_data_set_t dat,
+             std::chrono::milliseconds timeout );
+
+  /**
+   * @brief Send data set to input adapter process without waiting.
+   *
+   * @param dat Data set to send.
+   *
+   * @return \b true if the data set was sent, \b false if the
+   * interface queue was full.
+   */
+  bool try_send( kwiver::adapter::adapter_data_set_t dat );
+
+  /**
+   * @brief Set callback for backpressure notifications.
+   *
+   * The callback is called with \b true when the interface queue
+   * fills up to \p high data sets, and with \b false when the
+   * pipeline has taken enough of them to bring it back down to \p low
+   * data sets. It is called from the thread which sent or took the
+   * data set that crossed the watermark, so it should return quickly.
+   *
+   * @param notify Callback, or an empty function to remove it.
+   * @param high High watermark, from 1 to capacity().
+   * @param low Low watermark, less than \p high.
+   *
+   * @throws std::invalid_argument if the watermarks are out of range.
+   */
+  void set_backpressure_callback( std::function< void( bool ) > notify,
+                                  size_t high, size_t low );
+
+  /**
+   * @brief Number of data sets the interface queue can hold.
+   */
+  size_t capacity() const;
+
+  /**
+   * @brief Number of data sets waiting in the interface queue.
+   */
+  size_t size() const;
+
   /**
    * @brief Is interface queue full?
    *
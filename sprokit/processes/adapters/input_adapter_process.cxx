@@ -4,6 +4,11 @@
 
 #include "input_adapter_process.h"
 
+#include <kwiver_type_traits.h>
+
+#include <sprokit/pipeline/process_exception.h>
+
+#include <chrono>
 #include <stdexcept>
 #include <sstream>
 
@@ -31,17 +36,61 @@ namespace kwiver {
  * pipeline connections.
  */
 
+create_config_trait( queue_size, unsigned, "2",
+                     "Number of data sets the queue from the application can hold "
+                     "before the application has to wait to send more." );
+
+create_config_trait( wait_timeout, unsigned, "0",
+                     "Longest time in milliseconds a step waits for a data set from the "
+                     "application before returning without output, so that the thread "
+                     "stepping this process can run other processes in the meantime. "
+                     "Zero waits until a data set arrives." );
+
+//----------------------------------------------------------------
+// Private implementation class
+class input_adapter_process::priv
+{
+public:
+  std::chrono::milliseconds m_wait_timeout{ 0 };
+}; // end priv class
+
 // ------------------------------------------------------------------
 input_adapter_process
 ::input_adapter_process( kwiver::vital::config_block_sptr const& config )
   : process( config )
+  , d( new input_adapter_process::priv )
 {
+  declare_config_using_trait( queue_size );
+  declare_config_using_trait( wait_timeout );
 }
 
 input_adapter_process
 ::~input_adapter_process()
 { }
 
+// ------------------------------------------------------------------
+void
+input_adapter_process
+::_configure()
+{
+  auto const size = config_value_using_trait( queue_size );
+  if ( size < 1 )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception,
+                 name(), "queue_size must be greater than zero" );
+  }
+
+  // The application side adapter gets the queue when it connects,
+  // which is after the pipeline has been configured.
+  if ( size != m_interface_queue->Capacity() )
+  {
+    m_interface_queue.reset(
+      new kwiver::vital::bounded_buffer< kwiver::adapter::adapter_data_set_t >( size ) );
+  }
+
+  d->m_wait_timeout = std::chrono::milliseconds( config_value_using_trait( wait_timeout ) );
+}
+
 // ------------------------------------------------------------------
 kwiver::adapter::ports_info_t
 input_adapter_process
@@ -92,8 +141,18 @@ void
 input_adapter_process
 ::_step()
 {
+  kwiver::adapter::adapter_data_set_t data_set;
+  if ( d->m_wait_timeout.count() == 0 )
+  {
+    data_set = this->get_interface_queue()->Receive(); // blocking call
+  }
+  else if ( ! this->get_interface_queue()->Receive( data_set, d->m_wait_timeout ) )
+  {
+    // Nothing to do yet; let the scheduler step us again.
+    return;
+  }
+
   LOG_TRACE( logger(), "Processing data set" );
-  auto data_set = this->get_interface_queue()->Receive(); // blocking call
   std::set< sprokit::process::port_t > unused_ports = m_active_ports; // copy set of active ports
 
   // Handle end of input as last data supplied.
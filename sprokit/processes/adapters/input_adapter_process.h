@@ -47,10 +47,14 @@ class KWIVER_ADAPTER_EXPORT input_adapter_process
   adapter::ports_info_t get_ports();
 
 private:
+  void _configure() override;
 
   // This is used to intercept connections and make ports JIT
   void output_port_undefined( sprokit::process::port_t const& port) override;
 
+  class priv;
+  const std::unique_ptr<priv> d;
+
 }; // end class input_adapter_process
 
 } // end namespace
@@ -60,6 +60,25 @@ ::receive()
   return m_interface_queue->Receive();
 }
 
+// ------------------------------------------------------------------
+bool
+output_adapter
+::receive( kwiver::adapter::adapter_data_set_t& dat,
+           std::chrono::milliseconds timeout )
+{
+  return m_interface_queue->Receive( dat, timeout );
+}
+
+// ------------------------------------------------------------------
+kwiver::adapter::adapter_data_set_t
+output_adapter
+::try_receive()
+{
+  kwiver::adapter::adapter_data_set_t dat;
+  m_interface_queue->TryReceive( dat );
+  return dat;
+}
+
 // ------------------------------------------------------------------
 bool
 output_adapter
@@ -15,6 +15,8 @@
 #include "adapter_types.h"
 #include "adapter_data_set.h"
 
+#include <chrono>
+
 namespace kwiver {
 
 class output_adapter_process;
@@ -78,6 +80,24 @@ class KWIVER_ADAPTER_EXPORT output_adapter
    */
   kwiver::adapter::adapter_data_set_t receive();
 
+  /**
+   * @brief Get data set from output adapter process, waiting at most \p timeout.
+   *
+   * @param[out] dat Data set from the pipeline.
+   * @param timeout Longest time to wait for a data set.
+   *
+   * @return \b true if a data set was received.
+   */
+  bool receive( kwiver::adapter::adapter_data_set_t& dat,
+                std::chrono::milliseconds timeout );
+
+  /**
+   * @brief Get data set from output adapter process without waiting.
+   *
+   * @return Data set, or nullptr if the interface queue is empty.
+   */
+  kwiver::adapter::adapter_data_set_t try_receive();
+
   /**
    * @brief Is interface queue empty?
    *
@@ -21,7 +21,13 @@
 
 #include <sprokit/processes/adapters/embedded_pipeline.h>
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 static kwiver::vital::config_block_key_t const scheduler_block = kwiver::vital::config_block_key_t("_scheduler");
 
@@ -404,3 +410,210 @@ IMPLEMENT_TEST( epx_test )
 
   ep.wait();
 }
+
+// ----------------------------------------------------------------------------
+IMPLEMENT_TEST( embedded_pipeline_async )
+{
+  std::stringstream pipeline_desc;
+  pipeline_desc << SPROKIT_PROCESS( "input_adapter",  "ia" )
+                << SPROKIT_CONFIG( "queue_size", "4" )
+                << SPROKIT_PROCESS( "output_adapter", "oa" )
+
+                << SPROKIT_CONNECT( "ia", "value",    "oa", "value" )
+    ;
+
+  kwiver::embedded_pipeline ep;
+  ep.build_pipeline( pipeline_desc );
+
+  std::atomic< int > pressure_on( 0 );
+  std::atomic< int > pressure_off( 0 );
+  ep.set_backpressure_callback( [&]( bool on ){ ++( on ? pressure_on : pressure_off ); } );
+
+  std::mutex output_mutex;
+  std::vector< int > output;
+  bool end_seen = false;
+  ep.set_output_callback(
+    [&]( kwiver::adapter::adapter_data_set_t ods )
+    {
+      std::lock_guard< std::mutex > lock( output_mutex );
+      if ( ods->is_end_of_data() )
+      {
+        end_seen = true;
+        return;
+      }
+      output.push_back( ods->get_port_data< int >( "value" ) );
+    } );
+
+  EXPECT_EXCEPTION( std::runtime_error, ep.receive(),
+                    "receiving with an output callback" );
+
+  ep.start();
+
+  std::vector< std::future< void > > sent;
+  for ( int batch = 0; batch < 10; ++batch )
+  {
+    std::vector< kwiver::adapter::adapter_data_set_t > sets;
+    for ( int i = 0; i < 10; ++i )
+    {
+      auto ds = kwiver::adapter::adapter_data_set::create();
+      ds->add_value( "value", batch * 10 + i );
+      sets.push_back( ds );
+    }
+    sent.push_back( ep.send_async( std::move( sets ) ) );
+  }
+
+  ep.send_end_of_input();
+  ep.wait();
+
+  for ( auto& f : sent )
+  {
+    f.get();
+  }
+
+  TEST_EQUAL( "at_end() set correctly", ep.at_end(), true );
+  TEST_EQUAL( "End of data passed to callback", end_seen, true );
+  TEST_EQUAL( "Number of outputs", output.size(), 100 );
+  for ( size_t i = 0; i < output.size(); ++i )
+  {
+    TEST_EQUAL( "Output in order", output[ i ], static_cast< int >( i ) );
+  }
+
+  auto const on = pressure_on.load();
+  auto const off = pressure_off.load();
+  TEST_EQUAL( "Backpressure notifications paired", ( on == off || on == off + 1 ), true );
+}
+
+// ----------------------------------------------------------------------------
+IMPLEMENT_TEST( embedded_pipeline_non_blocking )
+{
+  std::stringstream pipeline_desc;
+  pipeline_desc << SPROKIT_PROCESS( "input_adapter",  "ia" )
+                << SPROKIT_PROCESS( "output_adapter", "oa" )
+
+                << SPROKIT_CONNECT( "ia", "value",    "oa", "value" )
+    ;
+
+  kwiver::embedded_pipeline ep;
+  ep.build_pipeline( pipeline_desc );
+  ep.start();
+
+  std::vector< std::future< kwiver::adapter::adapter_data_set_t > > received;
+  for ( int i = 0; i < 10; ++i )
+  {
+    received.push_back( ep.receive_async() );
+  }
+
+  for ( int i = 0; i < 10; ++i )
+  {
+    auto ds = kwiver::adapter::adapter_data_set::create();
+    ds->add_value( "value", i );
+    while ( ! ep.try_send( ds ) )
+    {
+      std::this_thread::yield();
+    }
+  }
+  ep.send_end_of_input();
+
+  for ( int i = 0; i < 10; ++i )
+  {
+    auto ods = received[ i ].get();
+    TEST_EQUAL( "Output in order", ods->get_port_data< int >( "value" ), i );
+  }
+
+  kwiver::adapter::adapter_data_set_t ods;
+  while ( ! ( ods = ep.try_receive() ) )
+  {
+    std::this_thread::yield();
+  }
+
+  TEST_EQUAL( "End of data received", ods->is_end_of_data(), true );
+  TEST_EQUAL( "at_end() set correctly", ep.at_end(), true );
+
+  ep.wait();
+}
+
+// ----------------------------------------------------------------------------
+IMPLEMENT_TEST( embedded_pipelines_shared_pool )
+{
+  // More pipelines than workers; the input adapters give their worker
+  // back while waiting for input.
+  size_t const num_pipelines = 4;
+
+  std::vector< std::unique_ptr< kwiver::embedded_pipeline > > pipelines;
+  for ( size_t i = 0; i < num_pipelines; ++i )
+  {
+    std::stringstream pipeline_desc;
+    pipeline_desc << SPROKIT_PROCESS( "input_adapter",  "ia" )
+                  << SPROKIT_CONFIG( "wait_timeout", "5" )
+                  << SPROKIT_PROCESS( "output_adapter", "oa" )
+
+                  << SPROKIT_CONNECT( "ia", "value",    "oa", "value" )
+
+                  << SPROKIT_CONFIG_BLOCK( "_scheduler" )
+                  << SPROKIT_CONFIG( "type", "thread_pool" )
+                  << SPROKIT_CONFIG( "thread_pool:num_threads", "2" )
+                  << SPROKIT_CONFIG( "thread_pool:pool", "test_shared_pool" )
+      ;
+
+    pipelines.emplace_back( new kwiver::embedded_pipeline );
+    pipelines.back()->build_pipeline( pipeline_desc );
+    pipelines.back()->start();
+  }
+
+  std::vector< std::thread > feeders;
+  for ( size_t i = 0; i < num_pipelines; ++i )
+  {
+    feeders.emplace_back(
+      [ &pipelines, i ]
+      {
+        auto& ep = *pipelines[ i ];
+        for ( int v = 0; v < 20; ++v )
+        {
+          auto ds = kwiver::adapter::adapter_data_set::create();
+          ds->add_value( "value", static_cast< int >( i ) * 100 + v );
+          ep.send( ds );
+        }
+        ep.send_end_of_input();
+      } );
+  }
+
+  // Each pipeline's output is taken as it is produced; an output
+  // adapter waiting for room in its queue holds a worker of the pool.
+  std::vector< int > received( num_pipelines, 0 );
+  for ( size_t i = 0; i < num_pipelines; ++i )
+  {
+    feeders.emplace_back(
+      [ &pipelines, &received, i ]
+      {
+        auto& ep = *pipelines[ i ];
+        int expected = static_cast< int >( i ) * 100;
+
+        while ( true )
+        {
+          auto ods = ep.receive();
+          if ( ods->is_end_of_data() )
+          {
+            break;
+          }
+          if ( ods->get_port_data< int >( "value" ) != expected )
+          {
+            TEST_ERROR( "Output out of order" );
+          }
+          ++expected;
+        }
+
+        received[ i ] = expected - static_cast< int >( i ) * 100;
+      } );
+  }
+
+  for ( auto& t : feeders )
+  {
+    t.join();
+  }
+
+  for ( size_t i = 0; i < num_pipelines; ++i )
+  {
+    TEST_EQUAL( "All outputs received", received[ i ], 20 );
+    pipelines[ i ]->wait();
+  }
+}
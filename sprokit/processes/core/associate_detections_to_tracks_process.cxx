@@ -17,6 +17,8 @@
 
 #include <sprokit/pipeline/process_exception.h>
 
+#include <algorithm>
+
 namespace kwiver
 {
 
@@ -32,6 +34,19 @@ create_port_trait( all_detections,
   detected_object_set,
   "Set of all detected objects for the given frame." );
 
+create_port_trait( terminated_tracks,
+  object_track_set,
+  "Tracks terminated on this frame by terminate_after." );
+
+create_config_trait( terminate_after, vital::frame_id_t, "0",
+  "Terminate tracks with no state in this many frames, moving them from "
+  "the output tracks to the terminated_tracks port. Zero keeps all tracks." );
+create_config_trait( max_track_states, size_t, "0",
+  "Keep at most this many of the latest states of each active track, "
+  "releasing older states and their detections. Zero keeps all states. "
+  "Writers of the output tracks then only see the states retained; "
+  "connect a writer to new_track_states to record full histories." );
+
 //------------------------------------------------------------------------------
 // Private implementation class
 class associate_detections_to_tracks_process::priv
@@ -41,6 +56,9 @@ class associate_detections_to_tracks_process::priv
   ~priv();
 
   algo::associate_detections_to_tracks_sptr m_track_associator;
+
+  vital::frame_id_t m_terminate_after = 0;
+  size_t m_max_track_states = 0;
 }; // end priv class
 
 // =============================================================================
@@ -67,6 +85,9 @@ ::_configure()
 
   vital::config_block_sptr algo_config = get_config();
 
+  d->m_terminate_after = config_value_using_trait( terminate_after );
+  d->m_max_track_states = config_value_using_trait( max_track_states );
+
   algo::associate_detections_to_tracks::set_nested_algo_configuration_using_trait(
     track_associator,
     algo_config,
@@ -131,8 +152,36 @@ ::_step()
            tracks, detections, ass_matrix, output, unused );
   }
 
+  if( count_output_port_edges_using_trait( new_track_states ) > 0 )
+  {
+    push_to_port_using_trait( new_track_states,
+                              vital::new_track_states( *tracks, *output ) );
+  }
+
+  // Apply the retention policy
+  std::vector< vital::track_sptr > terminated;
+  if( d->m_terminate_after > 0 || d->m_max_track_states > 0 )
+  {
+    // Without a timestamp, the latest frame of any track is the current one
+    auto frame = frame_id.get_frame();
+    if( !frame_id.has_valid_frame() )
+    {
+      frame = 0;
+      for( auto const& t : output->tracks() )
+      {
+        frame = std::max( frame, t->last_frame() );
+      }
+    }
+
+    output = vital::retain_tracks( *output, frame, d->m_terminate_after,
+                                   d->m_max_track_states, terminated );
+  }
+
   // Return by value
   push_to_port_using_trait( object_track_set, output );
+  push_to_port_using_trait(
+    terminated_tracks,
+    std::make_shared< vital::object_track_set >( terminated ) );
   push_to_port_using_trait( all_detections, detections );
   push_to_port_using_trait( unused_detections, unused );
 }
@@ -155,6 +204,8 @@ ::make_ports()
 
   // -- output --
   declare_output_port_using_trait( object_track_set, optional );
+  declare_output_port_using_trait( new_track_states, optional );
+  declare_output_port_using_trait( terminated_tracks, optional );
   declare_output_port_using_trait( all_detections, optional );
   declare_output_port_using_trait( unused_detections, optional );
 }
@@ -164,6 +215,8 @@ void associate_detections_to_tracks_process
 ::make_config()
 {
   declare_config_using_trait( track_associator);
+  declare_config_using_trait( terminate_after );
+  declare_config_using_trait( max_track_states );
 }
 
 // =============================================================================
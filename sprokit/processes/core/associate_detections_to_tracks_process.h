@@ -29,6 +29,8 @@ namespace kwiver
  *
  * \oports
  * \oport{tracks}
+ * \oport{new_track_states}
+ * \oport{terminated_tracks}
  * \oport{unused_detections}
  * \oport{all_detections}
  */
@@ -120,6 +120,18 @@ ::_step()
   push_to_port_using_trait( detected_object_set, result );
 }
 
+// ----------------------------------------------------------------
+sprokit::process::properties_t
+detected_object_filter_process
+::_properties() const
+{
+  properties_t consts = sprokit::process::_properties();
+
+  consts.insert( property_fusable );
+
+  return consts;
+}
+
 // ----------------------------------------------------------------
 void
 detected_object_filter_process
@@ -34,6 +34,7 @@ class KWIVER_PROCESSES_NO_EXPORT detected_object_filter_process
 protected:
   virtual void _configure();
   virtual void _step();
+  virtual properties_t _properties() const;
 
 private:
   void make_ports();
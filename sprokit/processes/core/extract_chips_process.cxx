@@ -0,0 +1,180 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "extract_chips_process.h"
+
+#include <vital/types/image_chips.h>
+#include <vital/types/image_container.h>
+#include <vital/types/image_container_set_simple.h>
+#include <vital/util/tokenize.h>
+
+#include <kwiver_type_traits.h>
+
+#include <sprokit/pipeline/process_exception.h>
+
+#include <sstream>
+
+namespace kwiver {
+
+create_config_trait( chip_width, size_t, "224", "Width in pixels of each chip" );
+create_config_trait( chip_height, size_t, "224", "Height in pixels of each chip" );
+create_config_trait( context, double, "0",
+  "Fraction of the detection width and height added on each side of the "
+  "box as context" );
+create_config_trait( scale, double, "1",
+  "Factor applied to pixel values before normalization, "
+  "e.g. 0.00392157 to map 8-bit values to [0, 1]" );
+create_config_trait( mean, std::string, "",
+  "Value subtracted from each channel after scaling, as either one value "
+  "or one value for each image channel, separated by spaces or commas" );
+create_config_trait( std_dev, std::string, "",
+  "Value each channel is divided by after subtracting the mean, as either "
+  "one value or one value for each image channel, separated by spaces or "
+  "commas" );
+
+create_port_trait( chip_batch, image,
+  "All chips in one planar float image, with the channels of each chip "
+  "in turn." );
+
+//----------------------------------------------------------------
+// Private implementation class
+class extract_chips_process::priv
+{
+public:
+  std::vector< double > parse_values( std::string const& value,
+                                      std::string const& name ) const;
+
+  extract_chips_process* parent;
+  vital::chip_extraction_options options;
+};
+
+// ================================================================
+
+extract_chips_process
+::extract_chips_process( kwiver::vital::config_block_sptr const& config )
+  : process( config ),
+    d( new extract_chips_process::priv )
+{
+  d->parent = this;
+  make_ports();
+  make_config();
+}
+
+extract_chips_process
+::~extract_chips_process()
+{
+}
+
+// ----------------------------------------------------------------
+void extract_chips_process
+::_configure()
+{
+  d->options.width = config_value_using_trait( chip_width );
+  d->options.height = config_value_using_trait( chip_height );
+  d->options.context = config_value_using_trait( context );
+  d->options.scale = config_value_using_trait( scale );
+  d->options.mean =
+    d->parse_values( config_value_using_trait( mean ), "mean" );
+  d->options.std_dev =
+    d->parse_values( config_value_using_trait( std_dev ), "std_dev" );
+
+  if( !d->options.width || !d->options.height )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+      "The chip width and height must be positive." );
+  }
+}
+
+// ----------------------------------------------------------------
+void
+extract_chips_process
+::_step()
+{
+  auto const img = grab_from_port_using_trait( image );
+  auto const detections = grab_from_port_using_trait( detected_object_set );
+
+  std::vector< vital::bounding_box_d > boxes;
+  if( detections )
+  {
+    boxes.reserve( detections->size() );
+    for( auto const& det : *detections )
+    {
+      boxes.push_back( det->bounding_box() );
+    }
+  }
+
+  vital::image_chip_batch batch;
+  if( img )
+  {
+    batch = vital::extract_image_chips( img->get_image(), boxes, d->options );
+  }
+
+  std::vector< vital::image_container_sptr > chips;
+  chips.reserve( batch.count );
+  for( size_t i = 0; i < batch.count && batch.data.size(); ++i )
+  {
+    chips.push_back(
+      std::make_shared< vital::simple_image_container >( batch.chip( i ) ) );
+  }
+
+  push_to_port_using_trait( image_set,
+    std::make_shared< vital::simple_image_container_set >( chips ) );
+  push_to_port_using_trait( chip_batch,
+    std::make_shared< vital::simple_image_container >( batch.data ) );
+}
+
+// ----------------------------------------------------------------
+void extract_chips_process
+::make_ports()
+{
+  // Set up for required ports
+  sprokit::process::port_flags_t optional;
+  sprokit::process::port_flags_t required;
+  required.insert( flag_required );
+
+  // -- input --
+  declare_input_port_using_trait( image, required );
+  declare_input_port_using_trait( detected_object_set, required );
+
+  // -- output --
+  declare_output_port_using_trait( image_set, optional );
+  declare_output_port_using_trait( chip_batch, optional );
+}
+
+// ----------------------------------------------------------------
+void extract_chips_process
+::make_config()
+{
+  declare_config_using_trait( chip_width );
+  declare_config_using_trait( chip_height );
+  declare_config_using_trait( context );
+  declare_config_using_trait( scale );
+  declare_config_using_trait( mean );
+  declare_config_using_trait( std_dev );
+}
+
+// ================================================================
+std::vector< double >
+extract_chips_process::priv
+::parse_values( std::string const& value, std::string const& name ) const
+{
+  std::vector< std::string > tokens;
+  vital::tokenize( value, tokens, " ,", vital::TokenizeTrimEmpty );
+
+  std::vector< double > values;
+  for( auto const& token : tokens )
+  {
+    std::istringstream stream( token );
+    double v;
+    if( !( stream >> v ) || !stream.eof() )
+    {
+      VITAL_THROW( sprokit::invalid_configuration_exception, parent->name(),
+        "Invalid " + name + " value \"" + token + "\"." );
+    }
+    values.push_back( v );
+  }
+  return values;
+}
+
+} // end namespace
@@ -0,0 +1,59 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_EXTRACT_CHIPS_PROCESS_H_
+#define KWIVER_EXTRACT_CHIPS_PROCESS_H_
+
+#include <sprokit/pipeline/process.h>
+
+#include "kwiver_processes_export.h"
+
+#include <memory>
+
+namespace kwiver
+{
+
+// ----------------------------------------------------------------
+/**
+ * \class extract_chips_process
+ *
+ * \brief Extracts a normalized chip of each detection in an image.
+ *
+ * All chips of a frame are extracted in one parallel pass into one
+ * contiguous batch, laid out by chip, channel, row and column.
+ *
+ * \iports
+ * \iport{image}
+ * \iport{detected_object_set}
+ *
+ * \oports
+ * \oport{image_set} one image for each chip, sharing the batch memory
+ * \oport{chip_batch} the batch as one planar float image
+ *
+ */
+class KWIVER_PROCESSES_NO_EXPORT extract_chips_process
+  : public sprokit::process
+{
+public:
+  PLUGIN_INFO( "extract_chips",
+               "Extract a batch of normalized image chips of detections." )
+
+  extract_chips_process( kwiver::vital::config_block_sptr const& config );
+  virtual ~extract_chips_process();
+
+protected:
+  virtual void _configure();
+  virtual void _step();
+
+private:
+  void make_ports();
+  void make_config();
+
+  class priv;
+  const std::unique_ptr<priv> d;
+}; // end class extract_chips_process
+
+} // end namespace
+
+#endif
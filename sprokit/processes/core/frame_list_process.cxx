@@ -5,6 +5,7 @@
 #include "frame_list_process.h"
 
 #include <vital/vital_types.h>
+#include <vital/types/frame_stamp.h>
 #include <vital/types/timestamp.h>
 #include <vital/types/image_container.h>
 #include <vital/types/image.h>
@@ -53,6 +54,11 @@ create_config_trait( frame_time, double, "0.03333333", "Inter frame time in seco
                      "timestamps for sequential frames. This can be used to simulate a frame rate in a "
                      "video stream application.");
 
+create_config_trait( stream_id, unsigned, "0",
+                     "Stream number placed in the frame_stamp output, which "
+                     "tells frames of this list from those of other sources "
+                     "in the same pipeline. Must be less than 65536." );
+
 create_algorithm_name_config_trait( image_reader );
 
 //----------------------------------------------------------------
@@ -67,6 +73,7 @@ class frame_list_process::priv
   std::string m_config_image_list_filename;
   kwiver::vital::time_usec_t m_config_frame_time;
   std::vector< std::string > m_config_path;
+  kwiver::vital::frame_stamp::stream_t m_stream_id;
 
   // process local data
   std::vector < kwiver::vital::path_t > m_files;
@@ -109,6 +116,15 @@ ::_configure()
   kwiver::vital::tokenize( path, d->m_config_path, ":", kwiver::vital::TokenizeTrimEmpty );
   d->m_config_path.push_back( "." ); // add current directory
 
+  unsigned const stream_id = config_value_using_trait( stream_id );
+  if ( stream_id > kwiver::vital::frame_stamp::max_stream )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "stream_id must be less than 65536." );
+  }
+  d->m_stream_id =
+    static_cast< kwiver::vital::frame_stamp::stream_t >( stream_id );
+
   kwiver::vital::config_block_sptr algo_config = get_config(); // config for process
 
   algo::image_io::set_nested_algo_configuration_using_trait( image_reader, algo_config, d->m_image_reader);
@@ -196,12 +212,15 @@ ::_step()
     // -- end debug
 
     kwiver::vital::timestamp frame_ts( d->m_frame_time, d->m_frame_number );
+    kwiver::vital::frame_stamp const stamp(
+      d->m_frame_time, d->m_frame_number, d->m_stream_id );
 
     // update timestamp
     ++d->m_frame_number;
     d->m_frame_time += d->m_config_frame_time;
 
     push_to_port_using_trait( timestamp, frame_ts );
+    push_to_port_using_trait( frame_stamp, stamp );
     push_to_port_using_trait( image, img_c );
     push_to_port_using_trait( image_file_name, a_file );
 
@@ -216,6 +235,7 @@ ::_step()
     const sprokit::datum_t dat= sprokit::datum::complete_datum();
 
     push_datum_to_port_using_trait( timestamp, dat );
+    push_datum_to_port_using_trait( frame_stamp, dat );
     push_datum_to_port_using_trait( image, dat );
     push_datum_to_port_using_trait( image_file_name, dat );
   }
@@ -231,6 +251,7 @@ ::make_ports()
   shared.insert( flag_output_shared );
 
   declare_output_port_using_trait( timestamp, optional );
+  declare_output_port_using_trait( frame_stamp, optional );
   declare_output_port_using_trait( image, shared );
   declare_output_port_using_trait( image_file_name, optional );
 }
@@ -241,6 +262,7 @@ ::make_config()
 {
   declare_config_using_trait( image_list_file );
   declare_config_using_trait( frame_time );
+  declare_config_using_trait( stream_id );
   declare_config_using_trait( image_reader );
   declare_config_using_trait( path );
 }
@@ -248,7 +270,8 @@ ::make_config()
 // ================================================================
 frame_list_process::priv
 ::priv()
-  : m_frame_number( 1 )
+  : m_stream_id( 0 )
+  , m_frame_number( 1 )
   , m_frame_time( 0 )
 {
 }
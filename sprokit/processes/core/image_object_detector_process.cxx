@@ -5,14 +5,314 @@
 #include "image_object_detector_process.h"
 
 #include <vital/algo/image_object_detector.h>
+#include <vital/types/homography_f2f.h>
 
 #include <sprokit/processes/kwiver_type_traits.h>
+#include <sprokit/pipeline/datum.h>
 #include <sprokit/pipeline/process_exception.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 namespace kwiver {
 
 create_algorithm_name_config_trait( detector );
 
+create_config_trait( batch_size, unsigned, "1",
+  "Number of frames passed to the detector together. Outputs for a frame "
+  "are delayed until its batch is full, the batch times out, or the input "
+  "ends." );
+
+create_config_trait( batch_timeout, double, "0",
+  "Maximum time in seconds the first frame of a batch waits for the batch "
+  "to fill. The wait is checked as each new frame arrives. Zero waits for "
+  "a full batch." );
+
+create_config_trait( shared_detector, bool, "false",
+  "Share one detector among all the processes of the program which have "
+  "the same detector configuration, such as those of several embedded "
+  "pipelines, instead of loading a detector for each of them. Frames "
+  "given to the shared detector at the same time by different processes "
+  "are detected together in one batch." );
+
+create_config_trait( detection_interval, unsigned, "1",
+  "Run the detector on every Nth frame only. The detections of the most "
+  "recent detected frame are reused for the frames in between, moved by "
+  "the homography of each frame when the homography port is connected. "
+  "Larger values trade accuracy for throughput. One runs the detector on "
+  "every frame." );
+
+create_config_trait( motion_threshold, double, "0",
+  "Fraction of the pixels of the motion heat map which, when exceeded, "
+  "runs the detector on a frame which would otherwise reuse earlier "
+  "detections. Only used when the motion_heat_map port is connected. Zero "
+  "ignores the heat map." );
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Fraction of the pixels of an image which are not zero
+double
+nonzero_fraction( vital::image const& img )
+{
+  size_t const count = img.width() * img.height();
+  if( count == 0 )
+  {
+    return 0.0;
+  }
+
+  size_t const bytes = img.pixel_traits().num_bytes;
+  auto const* const first =
+    static_cast< unsigned char const* >( img.first_pixel() );
+
+  size_t nonzero = 0;
+  for( size_t j = 0; j < img.height(); ++j )
+  {
+    for( size_t i = 0; i < img.width(); ++i )
+    {
+      for( size_t k = 0; k < img.depth(); ++k )
+      {
+        auto const* const pixel = first +
+          static_cast< ptrdiff_t >( bytes ) *
+          ( i * img.w_step() + j * img.h_step() + k * img.d_step() );
+        if( std::any_of( pixel, pixel + bytes,
+                         []( unsigned char b ){ return b != 0; } ) )
+        {
+          ++nonzero;
+          break;
+        }
+      }
+    }
+  }
+  return static_cast< double >( nonzero ) / static_cast< double >( count );
+}
+
+// ----------------------------------------------------------------------------
+// Move detections found in one frame to another frame, given the
+// homographies of both frames to the same reference frame. The bounding
+// box of each detection becomes the bounds of its warped corners.
+vital::detected_object_set_sptr
+propagate_detections( vital::detected_object_set_sptr const& detections,
+                      vital::f2f_homography const* from,
+                      vital::f2f_homography const* to )
+{
+  if( ! detections )
+  {
+    return std::make_shared< vital::detected_object_set >();
+  }
+
+  // Detections downstream may be changed, so each frame gets its own copy
+  auto result = detections->clone();
+  if( ! from || ! to )
+  {
+    return result;
+  }
+
+  Eigen::Matrix< double, 3, 3 > const H =
+    to->homography()->matrix().inverse() * from->homography()->matrix();
+
+  for( auto det : *result )
+  {
+    auto const box = det->bounding_box();
+    vital::vector_2d const corners[] = {
+      box.upper_left(), box.lower_right(),
+      { box.min_x(), box.max_y() }, { box.max_x(), box.min_y() } };
+
+    double const inf = std::numeric_limits< double >::infinity();
+    vital::vector_2d lo{ inf, inf };
+    vital::vector_2d hi{ -inf, -inf };
+    for( auto const& c : corners )
+    {
+      Eigen::Vector3d const p = H * Eigen::Vector3d{ c.x(), c.y(), 1.0 };
+      vital::vector_2d const q = p.head< 2 >() / p.z();
+      lo = lo.cwiseMin( q );
+      hi = hi.cwiseMax( q );
+    }
+    det->set_bounding_box( vital::bounding_box_d{ lo, hi } );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+// A detector used by several processes. Batches arriving while the
+// detector is busy are gathered and detected together by the next
+// process to find it idle.
+class shared_detector
+{
+public:
+  using images_t = std::vector< vital::image_container_sptr >;
+  using results_t = std::vector< vital::detected_object_set_sptr >;
+
+  explicit shared_detector( vital::algo::image_object_detector_sptr detector )
+    : m_detector( std::move( detector ) )
+  { }
+
+  static std::shared_ptr< shared_detector >
+  get( std::string const& key,
+       std::function< vital::algo::image_object_detector_sptr() > create );
+
+  results_t detect( images_t const& images );
+
+private:
+  struct request
+  {
+    images_t const* images;
+    results_t results;
+    std::exception_ptr error;
+    bool done = false;
+  };
+
+  void run( std::vector< request* > const& batch );
+
+  vital::algo::image_object_detector_sptr const m_detector;
+
+  std::mutex m_mutex;
+  std::condition_variable m_done;
+  std::vector< request* > m_pending;
+  bool m_busy = false;
+};
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< shared_detector >
+shared_detector
+::get( std::string const& key,
+       std::function< vital::algo::image_object_detector_sptr() > create )
+{
+  static std::mutex detectors_mutex;
+  static std::map< std::string, std::weak_ptr< shared_detector > > detectors;
+
+  std::lock_guard< std::mutex > const lock( detectors_mutex );
+
+  // The detector goes away with the last process using it
+  auto detector = detectors[ key ].lock();
+  if( ! detector )
+  {
+    auto algo = create();
+    if( algo )
+    {
+      detector = std::make_shared< shared_detector >( algo );
+      detectors[ key ] = detector;
+    }
+  }
+  return detector;
+}
+
+// ----------------------------------------------------------------------------
+shared_detector::results_t
+shared_detector
+::detect( images_t const& images )
+{
+  request r;
+  r.images = &images;
+
+  std::unique_lock< std::mutex > lock( m_mutex );
+  m_pending.push_back( &r );
+
+  while( ! r.done )
+  {
+    if( m_busy )
+    {
+      m_done.wait( lock );
+      continue;
+    }
+
+    // Detect everything that has queued up, including our own request
+    m_busy = true;
+    std::vector< request* > batch;
+    batch.swap( m_pending );
+    lock.unlock();
+
+    run( batch );
+
+    lock.lock();
+    m_busy = false;
+    for( auto const req : batch )
+    {
+      req->done = true;
+    }
+    m_done.notify_all();
+  }
+
+  if( r.error )
+  {
+    std::rethrow_exception( r.error );
+  }
+  return std::move( r.results );
+}
+
+// ----------------------------------------------------------------------------
+void
+shared_detector
+::run( std::vector< request* > const& batch )
+{
+  images_t images;
+  for( auto const req : batch )
+  {
+    images.insert( images.end(), req->images->begin(), req->images->end() );
+  }
+
+  try
+  {
+    results_t results;
+    if( images.size() == 1 )
+    {
+      results.push_back( m_detector->detect( images.front() ) );
+    }
+    else
+    {
+      results = m_detector->batch_detect( images );
+    }
+
+    if( results.size() != images.size() )
+    {
+      throw std::runtime_error( "Detector returned the wrong number of detection sets" );
+    }
+
+    auto next = results.begin();
+    for( auto const req : batch )
+    {
+      auto const end = next + req->images->size();
+      req->results.assign( next, end );
+      next = end;
+    }
+  }
+  catch( ... )
+  {
+    for( auto const req : batch )
+    {
+      req->error = std::current_exception();
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Text identifying a nested algorithm configuration
+std::string
+configuration_key( vital::config_block_sptr const& config )
+{
+  auto keys = config->available_values();
+  std::sort( keys.begin(), keys.end() );
+
+  std::stringstream str;
+  for( auto const& key : keys )
+  {
+    str << key << '=' << config->get_value< std::string >( key ) << '\n';
+  }
+  return str.str();
+}
+
+} // namespace
+
 //----------------------------------------------------------------
 // Private implementation class
 class image_object_detector_process::priv
@@ -21,7 +321,39 @@ class image_object_detector_process::priv
   priv();
   ~priv();
 
-   vital::algo::image_object_detector_sptr m_detector;
+  vital::algo::image_object_detector_sptr m_detector;
+  std::shared_ptr< shared_detector > m_shared_detector;
+
+  struct frame
+  {
+    // Empty for frames which reuse earlier detections
+    vital::image_container_sptr image;
+    vital::timestamp ts;
+    std::shared_ptr< vital::f2f_homography > homography;
+  };
+
+  bool needs_detection( frame const& f,
+                        vital::image_container_sptr const& motion ) const;
+
+  unsigned m_batch_size;
+  double m_batch_timeout;
+  unsigned m_detection_interval;
+  double m_motion_threshold;
+
+  // Frames waiting for the current batch to be processed, and the number
+  // of them given to the detector
+  std::vector< frame > m_frames;
+  size_t m_detect_count;
+  std::chrono::steady_clock::time_point m_batch_start;
+
+  // Last frame chosen for detection and the frames received since
+  bool m_have_key;
+  std::shared_ptr< vital::f2f_homography > m_key_homography;
+  unsigned m_since_key;
+
+  // Detections of the last detected frame, reused for following frames
+  vital::detected_object_set_sptr m_last_detections;
+  std::shared_ptr< vital::f2f_homography > m_last_homography;
 
 }; // end priv class
 
@@ -31,6 +363,9 @@ image_object_detector_process( kwiver::vital::config_block_sptr const& config )
   : process( config ),
     d( new image_object_detector_process::priv )
 {
+  // Control datums are handled in _step so that pending frames of a batch
+  // are output before them
+  set_data_checking_level( check_none );
   make_ports();
   make_config();
 }
@@ -55,11 +390,34 @@ _configure()
     VITAL_THROW( sprokit::invalid_configuration_exception, name(), "Configuration check failed." );
   }
 
-  vital::algo::image_object_detector::set_nested_algo_configuration_using_trait( detector, algo_config, d->m_detector );
-  if ( ! d->m_detector )
+  if ( config_value_using_trait( shared_detector ) )
+  {
+    d->m_detector.reset();
+    d->m_shared_detector = shared_detector::get(
+      configuration_key( algo_config->subblock_view( "detector" ) ),
+      [ & ]{
+        vital::algo::image_object_detector_sptr algo;
+        vital::algo::image_object_detector::set_nested_algo_configuration_using_trait(
+          detector, algo_config, algo );
+        return algo;
+      } );
+  }
+  else
+  {
+    d->m_shared_detector.reset();
+    vital::algo::image_object_detector::set_nested_algo_configuration_using_trait( detector, algo_config, d->m_detector );
+  }
+
+  if ( ! d->m_detector && ! d->m_shared_detector )
   {
     VITAL_THROW( sprokit::invalid_configuration_exception, name(), "Unable to create detector" );
   }
+
+  d->m_batch_size = std::max( 1u, config_value_using_trait( batch_size ) );
+  d->m_batch_timeout = config_value_using_trait( batch_timeout );
+  d->m_detection_interval =
+    std::max( 1u, config_value_using_trait( detection_interval ) );
+  d->m_motion_threshold = config_value_using_trait( motion_threshold );
 }
 
 // ------------------------------------------------------------------
@@ -67,17 +425,166 @@ void
 image_object_detector_process::
 _step()
 {
-  vital::image_container_sptr input = grab_from_port_using_trait( image );
+  const bool has_timestamp = has_input_port_edge_using_trait( timestamp );
+  const bool has_homography =
+    has_input_port_edge_using_trait( homography_src_to_ref );
+  const bool has_motion = has_input_port_edge_using_trait( motion_heat_map );
+
+  auto const p_info = peek_at_port_using_trait( image );
+  if( p_info.datum->type() != sprokit::datum::data )
+  {
+    // Output the frames received before this datum, then pass it on
+    grab_edge_datum_using_trait( image );
+    if( has_timestamp )
+    {
+      grab_edge_datum_using_trait( timestamp );
+    }
+    if( has_homography )
+    {
+      grab_edge_datum_using_trait( homography_src_to_ref );
+    }
+    if( has_motion )
+    {
+      grab_edge_datum_using_trait( motion_heat_map );
+    }
+    process_batch();
+
+    // Frames after a flush or the end of input are not related to those
+    // before it, so do not reuse detections across it
+    d->m_have_key = false;
+    d->m_last_detections.reset();
+
+    if( p_info.datum->type() == sprokit::datum::complete )
+    {
+      mark_process_as_complete();
+    }
+    push_datum_to_port_using_trait( detected_object_set, p_info.datum );
+    push_datum_to_port_using_trait( timestamp, p_info.datum );
+    return;
+  }
+
+  priv::frame f;
+  f.image = grab_from_port_using_trait( image );
+  if( has_timestamp )
+  {
+    f.ts = grab_from_port_using_trait( timestamp );
+  }
+  if( has_homography )
+  {
+    f.homography = std::make_shared< vital::f2f_homography >(
+      grab_from_port_using_trait( homography_src_to_ref ) );
+  }
+  vital::image_container_sptr motion;
+  if( has_motion )
+  {
+    motion = grab_from_port_using_trait( motion_heat_map );
+  }
 
-  vital::detected_object_set_sptr result;
+  auto const now = std::chrono::steady_clock::now();
+  if( d->needs_detection( f, motion ) )
+  {
+    if( d->m_detect_count == 0 )
+    {
+      d->m_batch_start = now;
+    }
+    ++d->m_detect_count;
+    d->m_have_key = true;
+    d->m_key_homography = f.homography;
+    d->m_since_key = 0;
+  }
+  else
+  {
+    f.image.reset();
+    ++d->m_since_key;
+  }
+  d->m_frames.push_back( f );
+
+  // Frames reusing detections wait only for the detected frames before them
+  const std::chrono::duration< double > waited = now - d->m_batch_start;
+  if( d->m_detect_count == 0 ||
+      d->m_detect_count >= d->m_batch_size ||
+      ( d->m_batch_timeout > 0.0 && waited.count() >= d->m_batch_timeout ) )
+  {
+    process_batch();
+  }
+}
+
+// ------------------------------------------------------------------
+void
+image_object_detector_process::
+process_batch()
+{
+  if( d->m_frames.empty() )
+  {
+    return;
+  }
+
+  std::vector< vital::image_container_sptr > images;
+  images.reserve( d->m_detect_count );
+  for( auto const& f : d->m_frames )
+  {
+    if( f.image )
+    {
+      images.push_back( f.image );
+    }
+  }
+
+  std::vector< vital::detected_object_set_sptr > results;
   {
     scoped_step_instrumentation();
 
-    // Get detections from detector on image
-    result = d->m_detector->detect( input );
+    // Get detections from detector on the images
+    if( images.empty() )
+    {
+      // Every frame reuses earlier detections
+    }
+    else if( d->m_shared_detector )
+    {
+      results = d->m_shared_detector->detect( images );
+    }
+    else if( images.size() == 1 )
+    {
+      results.push_back( d->m_detector->detect( images.front() ) );
+    }
+    else
+    {
+      results = d->m_detector->batch_detect( images );
+    }
   }
 
-  push_to_port_using_trait( detected_object_set, result );
+  if( results.size() != images.size() )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "Detector returned the wrong number of detection sets" );
+  }
+
+  auto next = results.begin();
+  for( auto const& f : d->m_frames )
+  {
+    vital::detected_object_set_sptr output;
+    if( f.image )
+    {
+      output = *next++;
+
+      // Keep a copy, as the output may be changed downstream before it is
+      // reused
+      d->m_last_detections =
+        ( output && d->m_detection_interval > 1 ? output->clone() : output );
+      d->m_last_homography = f.homography;
+    }
+    else
+    {
+      output = propagate_detections( d->m_last_detections,
+                                     d->m_last_homography.get(),
+                                     f.homography.get() );
+    }
+
+    push_to_port_using_trait( detected_object_set, output );
+    push_to_port_using_trait( timestamp, f.ts );
+  }
+
+  d->m_frames.clear();
+  d->m_detect_count = 0;
 }
 
 // ------------------------------------------------------------------
@@ -93,9 +600,13 @@ make_ports()
 
   // -- input --
   declare_input_port_using_trait( image, required );
+  declare_input_port_using_trait( timestamp, optional );
+  declare_input_port_using_trait( homography_src_to_ref, optional );
+  declare_input_port_using_trait( motion_heat_map, optional );
 
   // -- output --
   declare_output_port_using_trait( detected_object_set, optional );
+  declare_output_port_using_trait( timestamp, optional );
 }
 
 // ------------------------------------------------------------------
@@ -104,11 +615,23 @@ image_object_detector_process::
 make_config()
 {
   declare_config_using_trait( detector );
+  declare_config_using_trait( batch_size );
+  declare_config_using_trait( batch_timeout );
+  declare_config_using_trait( shared_detector );
+  declare_config_using_trait( detection_interval );
+  declare_config_using_trait( motion_threshold );
 }
 
 // ================================================================
 image_object_detector_process::priv
 ::priv()
+  : m_batch_size( 1 )
+  , m_batch_timeout( 0.0 )
+  , m_detection_interval( 1 )
+  , m_motion_threshold( 0.0 )
+  , m_detect_count( 0 )
+  , m_have_key( false )
+  , m_since_key( 0 )
 {
 }
 
@@ -117,4 +640,30 @@ image_object_detector_process::priv
 {
 }
 
+// ------------------------------------------------------------------
+// Decide whether the detector runs on a frame or it reuses the detections
+// of the last frame which did
+bool
+image_object_detector_process::priv
+::needs_detection( frame const& f,
+                   vital::image_container_sptr const& motion ) const
+{
+  if( ! m_have_key || m_since_key + 1 >= m_detection_interval )
+  {
+    return true;
+  }
+
+  // Detections can only be moved between frames with homographies to the
+  // same reference frame
+  if( static_cast< bool >( f.homography ) !=
+        static_cast< bool >( m_key_homography ) ||
+      ( f.homography && f.homography->to_id() != m_key_homography->to_id() ) )
+  {
+    return true;
+  }
+
+  return motion && m_motion_threshold > 0.0 &&
+         nonzero_fraction( motion->get_image() ) > m_motion_threshold;
+}
+
 } // end namespace kwiver
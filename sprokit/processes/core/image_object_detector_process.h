@@ -17,12 +17,30 @@ namespace kwiver {
 /**
  * @brief Image object detector process.
  *
+ * Frames may be grouped into batches of \c batch_size and passed to the
+ * detector together.  Outputs keep the order of the inputs, and the
+ * optional timestamp of each frame is output with its detections.
+ *
+ * With \c detection_interval greater than one, the detector runs only on
+ * every Nth frame, and the frames in between reuse the detections of the
+ * last detected frame. When the \c homography_src_to_ref port is
+ * connected, for instance to a stabilizer, the reused bounding boxes are
+ * moved by the homographies of the two frames, and a change of reference
+ * frame runs the detector. When the \c motion_heat_map port is connected,
+ * a frame with more motion than \c motion_threshold also runs the
+ * detector.
+ *
  * \iports
  * \iport{image}
+ * \iport{timestamp}
+ * \iport{homography_src_to_ref} Optional homography of each image to a
+ *                                reference frame.
+ * \iport{motion_heat_map} Optional motion heat map of each image.
  *
  * \oports
  *
  * \oport{detected_object_set}
+ * \oport{timestamp}
  */
 class KWIVER_PROCESSES_NO_EXPORT image_object_detector_process
   : public sprokit::process
@@ -41,6 +59,7 @@ class KWIVER_PROCESSES_NO_EXPORT image_object_detector_process
 private:
   void make_ports();
   void make_config();
+  void process_batch();
 
   class priv;
   const std::unique_ptr<priv> d;
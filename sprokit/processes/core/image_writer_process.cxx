@@ -10,6 +10,7 @@
 #include <vital/types/timestamp.h>
 #include <vital/algo/image_io.h>
 #include <vital/exceptions.h>
+#include <vital/util/bounded_buffer.h>
 #include <vital/util/string.h>
 
 #include <kwiver_type_traits.h>
@@ -19,6 +20,10 @@
 
 #include <kwiversys/SystemTools.hxx>
 
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include <vector>
 #include <stdint.h>
 #include <fstream>
@@ -40,6 +45,16 @@ create_config_trait( file_name_template, std::string, "image%04d.png",
                      "format specifier to convert an integer increasing image number. "
                      "The image file type is determined by the file extension and the concrete writer selected." );
 
+create_config_trait( write_threads, unsigned, "0",
+                     "Number of background threads which encode and write images. With 0, each image is "
+                     "written in the pipeline thread before the next step. Otherwise the writer selected "
+                     "must be safe to call from several threads, as the built-in writers are." );
+create_config_trait( write_queue_size, unsigned, "16",
+                     "Maximum number of images waiting to be written when writing in the background." );
+create_config_trait( drop_when_full, bool, "false",
+                     "When writing in the background and the queue is full, drop the image instead of "
+                     "waiting for space in the queue. Dropped images are counted and reported." );
+
 create_algorithm_name_config_trait( image_writer );
 
 //----------------------------------------------------------------
@@ -50,8 +65,33 @@ class image_writer_process::priv
   priv();
   ~priv();
 
+  // An image waiting to be written. An empty file name stops a writer
+  // thread.
+  struct write_request
+  {
+    std::string file_name;
+    vital::image_container_sptr image;
+  };
+
+  void start_writers();
+  void stop_writers();
+  void write_loop();
+  void check_write_error();
+
   // Configuration values
   std::string m_file_template;
+  unsigned m_write_threads;
+  unsigned m_write_queue_size;
+  bool m_drop_when_full;
+
+  // Background writing; only present when write_threads is set
+  std::unique_ptr< vital::bounded_buffer< write_request > > m_queue;
+  std::vector< std::thread > m_writers;
+  std::atomic< bool > m_write_failed;
+  std::exception_ptr m_write_error;
+  std::mutex m_write_error_mutex;
+  size_t m_dropped;
+  kwiver::vital::logger_handle_t m_logger;
 
   // Number for current image.
   kwiver::vital::frame_id_t m_frame_number;
@@ -75,6 +115,17 @@ ::image_writer_process( kwiver::vital::config_block_sptr const& config )
 image_writer_process
 ::~image_writer_process()
 {
+  // Errors are reported by _finalize(), unless the pipeline was stopped
+  // before it completed
+  d->stop_writers();
+  try
+  {
+    d->check_write_error();
+  }
+  catch ( std::exception const& e )
+  {
+    LOG_ERROR( logger(), "Failed to write image: " << e.what() );
+  }
 }
 
 // ----------------------------------------------------------------
@@ -85,6 +136,10 @@ ::_configure()
 
   // Get process config entries
   d->m_file_template = config_value_using_trait( file_name_template );
+  d->m_write_threads = config_value_using_trait( write_threads );
+  d->m_write_queue_size = config_value_using_trait( write_queue_size );
+  d->m_drop_when_full = config_value_using_trait( drop_when_full );
+  d->m_logger = logger();
 
   // Get algo config entries
   kwiver::vital::config_block_sptr algo_config = get_config(); // config for process
@@ -106,6 +161,18 @@ ::_configure()
   {
     VITAL_THROW( sprokit::invalid_configuration_exception, name(), "Configuration check failed." );
   }
+
+  if ( d->m_write_threads > 0 && d->m_write_queue_size == 0 )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "write_queue_size must be greater than zero." );
+  }
+
+  d->stop_writers();
+  if ( d->m_write_threads > 0 )
+  {
+    d->start_writers();
+  }
 }
 
 // ----------------------------------------------------------------
@@ -153,7 +220,37 @@ ::_step()
     LOG_DEBUG( logger(), "Writing image to file \"" << a_file << "\"" );
   }
 
-  d->m_image_writer->save( a_file, input );
+  if ( ! d->m_queue )
+  {
+    d->m_image_writer->save( a_file, input );
+    return;
+  }
+
+  // Errors from the writer threads stop the pipeline here
+  d->check_write_error();
+
+  if ( d->m_drop_when_full )
+  {
+    if ( ! d->m_queue->TrySend( { a_file, input } ) )
+    {
+      ++d->m_dropped;
+      LOG_WARN( logger(), "Write queue is full; dropped image \"" << a_file
+                << "\" (" << d->m_dropped << " dropped so far)" );
+    }
+  }
+  else
+  {
+    d->m_queue->Send( { a_file, input } );
+  }
+}
+
+// ----------------------------------------------------------------
+void image_writer_process
+::_finalize()
+{
+  // Finish writing queued images before the pipeline ends
+  d->stop_writers();
+  d->check_write_error();
 }
 
 // ----------------------------------------------------------------
@@ -176,13 +273,21 @@ void image_writer_process
 ::make_config()
 {
   declare_config_using_trait( file_name_template );
+  declare_config_using_trait( write_threads );
+  declare_config_using_trait( write_queue_size );
+  declare_config_using_trait( drop_when_full );
   declare_config_using_trait( image_writer );
 }
 
 // ================================================================
 image_writer_process::priv
 ::priv()
-  : m_frame_number(0)
+  : m_write_threads( 0 ),
+    m_write_queue_size( 16 ),
+    m_drop_when_full( false ),
+    m_write_failed( false ),
+    m_dropped( 0 ),
+    m_frame_number(0)
 {
 }
 
@@ -191,4 +296,93 @@ image_writer_process::priv
 {
 }
 
+// ----------------------------------------------------------------
+void image_writer_process::priv
+::start_writers()
+{
+  m_queue.reset(
+    new vital::bounded_buffer< write_request >( m_write_queue_size ) );
+  for ( unsigned i = 0; i < m_write_threads; ++i )
+  {
+    m_writers.emplace_back( &priv::write_loop, this );
+  }
+}
+
+// ----------------------------------------------------------------
+void image_writer_process::priv
+::stop_writers()
+{
+  if ( ! m_queue )
+  {
+    return;
+  }
+
+  // Each thread stops at the first end marker it receives, after the
+  // images queued before it
+  for ( size_t i = 0; i < m_writers.size(); ++i )
+  {
+    m_queue->Send( write_request{} );
+  }
+  for ( auto& t : m_writers )
+  {
+    t.join();
+  }
+  m_writers.clear();
+  m_queue.reset();
+
+  if ( m_dropped )
+  {
+    LOG_WARN( m_logger, m_dropped << " images were dropped because the write "
+              "queue was full" );
+  }
+}
+
+// ----------------------------------------------------------------
+void image_writer_process::priv
+::write_loop()
+{
+  for ( auto request = m_queue->Receive(); ! request.file_name.empty();
+        request = m_queue->Receive() )
+  {
+    // Until a failure is reported, the remaining images are skipped
+    if ( m_write_failed )
+    {
+      continue;
+    }
+
+    try
+    {
+      m_image_writer->save( request.file_name, request.image );
+    }
+    catch ( ... )
+    {
+      std::lock_guard< std::mutex > lock( m_write_error_mutex );
+      if ( ! m_write_failed )
+      {
+        m_write_error = std::current_exception();
+        m_write_failed = true;
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------
+void image_writer_process::priv
+::check_write_error()
+{
+  if ( ! m_write_failed )
+  {
+    return;
+  }
+
+  // Each error is reported once
+  std::exception_ptr error;
+  {
+    std::lock_guard< std::mutex > lock( m_write_error_mutex );
+    std::swap( error, m_write_error );
+    m_write_failed = false;
+  }
+  std::rethrow_exception( error );
+}
+
 } // end namespace
@@ -37,6 +37,7 @@ class KWIVER_PROCESSES_NO_EXPORT image_writer_process
 protected:
   virtual void _configure();
   virtual void _step();
+  virtual void _finalize();
 
 private:
   void make_ports();
@@ -121,6 +121,9 @@ ::_step()
     new_tracks = d->m_track_initializer->initialize( frame_id, image, detections );
   }
 
+  // New tracks are all new states; they are shared with the joined set
+  push_to_port_using_trait( new_track_states, new_tracks );
+
   // Union optional input tracks if available
   if( old_tracks )
   {
@@ -156,6 +159,7 @@ ::make_ports()
 
   // -- output --
   declare_output_port_using_trait( object_track_set, optional );
+  declare_output_port_using_trait( new_track_states, optional );
 }
 
 // -----------------------------------------------------------------------------
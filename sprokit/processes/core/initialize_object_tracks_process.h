@@ -31,6 +31,7 @@ namespace kwiver
  *
  * \oports
  * \oport{tracks}
+ * \oport{new_track_states}
  */
 class KWIVER_PROCESSES_NO_EXPORT initialize_object_tracks_process
   : public sprokit::process
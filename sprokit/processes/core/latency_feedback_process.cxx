@@ -0,0 +1,75 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "latency_feedback_process.h"
+
+#include <kwiver_type_traits.h>
+
+#include <vital/types/timestamp.h>
+
+#include <sprokit/pipeline/latency_feedback.h>
+
+namespace kwiver
+{
+
+create_config_trait( latency_channel, std::string, "realtime",
+                     "Name of the latency channel shared with the source "
+                     "process." );
+
+class latency_feedback_process::priv
+{
+public:
+  sprokit::latency_channel_t channel;
+};
+
+// ----------------------------------------------------------------
+latency_feedback_process
+::latency_feedback_process( vital::config_block_sptr const& config )
+  : process( config ),
+    d( new latency_feedback_process::priv )
+{
+  make_ports();
+  make_config();
+}
+
+latency_feedback_process
+::~latency_feedback_process()
+{
+}
+
+// ----------------------------------------------------------------
+void latency_feedback_process
+::_configure()
+{
+  d->channel = sprokit::latency_channel::get(
+    config_value_using_trait( latency_channel ) );
+}
+
+// ----------------------------------------------------------------
+void latency_feedback_process
+::_step()
+{
+  kwiver::vital::timestamp const ts = grab_from_port_using_trait( timestamp );
+
+  d->channel->complete( ts.get_frame() );
+}
+
+// ----------------------------------------------------------------
+void latency_feedback_process
+::make_ports()
+{
+  sprokit::process::port_flags_t required;
+  required.insert( flag_required );
+
+  declare_input_port_using_trait( timestamp, required );
+}
+
+// ----------------------------------------------------------------
+void latency_feedback_process
+::make_config()
+{
+  declare_config_using_trait( latency_channel );
+}
+
+}
@@ -0,0 +1,55 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef _KWIVER_LATENCY_FEEDBACK_PROCESS_H_
+#define _KWIVER_LATENCY_FEEDBACK_PROCESS_H_
+
+#include "kwiver_processes_export.h"
+
+#include <sprokit/pipeline/process.h>
+
+#include <memory>
+
+namespace kwiver
+{
+
+// ----------------------------------------------------------------
+/**
+ * \class latency_feedback_process
+ *
+ * \brief Reports frames reaching the end of a real-time pipeline.
+ *
+ * Connect the timestamp of the last stage of the pipeline to this
+ * process and give it the same latency channel as the source (for
+ * example video_input). The source then drops frames as needed to keep
+ * the time from reading a frame to it arriving here within the budget.
+ *
+ * \iports
+ * \iport{timestamp}
+ */
+class KWIVER_PROCESSES_NO_EXPORT latency_feedback_process
+  : public sprokit::process
+{
+public:
+  PLUGIN_INFO( "latency_feedback",
+               "Reports finished frames to the source of a real-time pipeline." )
+
+  latency_feedback_process( vital::config_block_sptr const& config );
+  virtual ~latency_feedback_process();
+
+protected:
+  virtual void _configure();
+  virtual void _step();
+
+private:
+  void make_ports();
+  void make_config();
+
+  class priv;
+  const std::unique_ptr<priv> d;
+};
+
+}
+
+#endif // _KWIVER_LATENCY_FEEDBACK_PROCESS_H_
@@ -27,6 +27,10 @@ class merge_images_process::priv
 
   algo::merge_images_sptr m_images_merger;
   std::set< std::string > p_port_list;
+
+  // Merged images of a stream are all the same size, so the memory of each
+  // output is reused once downstream processes release it
+  kwiver::vital::image_memory_pool m_pool;
 };
 
 // ================================================================
@@ -93,7 +97,7 @@ ::_step()
   kwiver::vital::image_container_sptr output;
 
   // Get feature tracks
-  output = d->m_images_merger->merge( image_list[0], image_list[1]);
+  output = d->m_images_merger->merge( image_list[0], image_list[1], d->m_pool );
 
   // Return by value
   push_to_port_using_trait( image, output);
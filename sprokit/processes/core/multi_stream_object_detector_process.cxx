@@ -0,0 +1,431 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "multi_stream_object_detector_process.h"
+
+#include <vital/algo/image_object_detector.h>
+#include <vital/util/string.h>
+
+#include <sprokit/processes/kwiver_type_traits.h>
+#include <sprokit/pipeline/datum.h>
+#include <sprokit/pipeline/process_exception.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace kwiver {
+
+create_algorithm_name_config_trait( detector );
+
+create_config_trait( batch_size, unsigned, "0",
+  "Number of frames passed to the detector together, taken from all of the "
+  "streams. Zero uses the number of streams which have not yet completed." );
+
+create_config_trait( batch_timeout, double, "0",
+  "Maximum time in seconds the first frame of a batch waits for the batch "
+  "to fill. Zero waits for a full batch, which only completes while enough "
+  "streams keep sending frames." );
+
+namespace {
+
+std::string const image_prefix = "image/";
+std::string const timestamp_prefix = "timestamp/";
+std::string const detections_prefix = "detected_object_set/";
+
+} // namespace
+
+//----------------------------------------------------------------
+// Private implementation class
+class multi_stream_object_detector_process::priv
+{
+public:
+  priv();
+  ~priv();
+
+  struct stream_info
+  {
+    std::string name;
+    bool active;
+  };
+
+  struct frame
+  {
+    size_t stream;
+    vital::image_container_sptr image;
+    vital::timestamp ts;
+  };
+
+  size_t count_active() const;
+
+  vital::algo::image_object_detector_sptr m_detector;
+
+  unsigned m_batch_size;
+  double m_batch_timeout;
+
+  std::vector< stream_info > m_streams;
+  std::map< std::string, size_t > m_stream_index;
+
+  // Stream to look at first for the next frames
+  size_t m_next_stream;
+
+  // Frames waiting for the current batch to be processed
+  std::vector< frame > m_batch;
+  std::chrono::steady_clock::time_point m_batch_start;
+
+  static sprokit::edge::duration_t const poll_interval;
+}; // end priv class
+
+sprokit::edge::duration_t const
+multi_stream_object_detector_process::priv::poll_interval =
+  boost::chrono::duration_cast< sprokit::edge::duration_t >(
+    boost::chrono::milliseconds( 5 ) );
+
+// ==================================================================
+multi_stream_object_detector_process::
+multi_stream_object_detector_process( kwiver::vital::config_block_sptr const& config )
+  : process( config ),
+    d( new multi_stream_object_detector_process::priv )
+{
+  // This process manages its own inputs, which are not synchronized
+  set_data_checking_level( check_none );
+  make_config();
+}
+
+multi_stream_object_detector_process::
+~multi_stream_object_detector_process()
+{
+}
+
+// ------------------------------------------------------------------
+void
+multi_stream_object_detector_process::
+_configure()
+{
+  scoped_configure_instrumentation();
+
+  vital::config_block_sptr algo_config = get_config();
+
+  // Check config so it will give run-time diagnostic of config problems
+  if ( ! vital::algo::image_object_detector::check_nested_algo_configuration_using_trait( detector, algo_config ) )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(), "Configuration check failed." );
+  }
+
+  vital::algo::image_object_detector::set_nested_algo_configuration_using_trait( detector, algo_config, d->m_detector );
+
+  if ( ! d->m_detector )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(), "Unable to create detector" );
+  }
+
+  d->m_batch_size = config_value_using_trait( batch_size );
+  d->m_batch_timeout = config_value_using_trait( batch_timeout );
+}
+
+// ------------------------------------------------------------------
+void
+multi_stream_object_detector_process::
+_init()
+{
+  if ( d->m_streams.empty() )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "No image streams are connected" );
+  }
+
+  process::_init();
+}
+
+// ------------------------------------------------------------------
+void
+multi_stream_object_detector_process::
+_step()
+{
+  size_t const count = d->m_streams.size();
+
+  while ( true )
+  {
+    size_t const active = d->count_active();
+    if ( active == 0 )
+    {
+      process_batch();
+      mark_process_as_complete();
+      return;
+    }
+
+    size_t const target = ( d->m_batch_size ? d->m_batch_size : active );
+    if ( d->m_batch.size() >= target )
+    {
+      break;
+    }
+
+    if ( ! d->m_batch.empty() && d->m_batch_timeout > 0.0 )
+    {
+      std::chrono::duration< double > const waited =
+        std::chrono::steady_clock::now() - d->m_batch_start;
+      if ( waited.count() >= d->m_batch_timeout )
+      {
+        break;
+      }
+    }
+
+    // Take at most one frame from each stream in turn, so that every
+    // stream gets its share of the batch
+    bool took = false;
+    for ( size_t i = 0; i < count && d->m_batch.size() < target; ++i )
+    {
+      size_t const s = ( d->m_next_stream + i ) % count;
+      if ( d->m_streams[s].active &&
+           take_frame( s, sprokit::edge::duration_t::zero() ) )
+      {
+        took = true;
+      }
+    }
+    d->m_next_stream = ( d->m_next_stream + 1 ) % count;
+
+    if ( ! took )
+    {
+      // Nothing is waiting; wait a little on the next active stream
+      for ( size_t i = 0; i < count; ++i )
+      {
+        size_t const s = ( d->m_next_stream + i ) % count;
+        if ( d->m_streams[s].active )
+        {
+          take_frame( s, priv::poll_interval );
+          break;
+        }
+      }
+    }
+  }
+
+  process_batch();
+}
+
+// ------------------------------------------------------------------
+// Take the next datum of a stream if one arrives within the wait. Frames
+// are added to the batch; control datums are passed on after the batch.
+bool
+multi_stream_object_detector_process::
+take_frame( size_t stream, sprokit::edge::duration_t const& wait )
+{
+  priv::stream_info& info = d->m_streams[stream];
+  port_t const timestamp_port = timestamp_prefix + info.name;
+
+  auto const dat = try_grab_from_port( image_prefix + info.name, wait );
+  if ( ! dat )
+  {
+    return false;
+  }
+
+  bool const has_timestamp = has_input_port_edge( timestamp_port );
+
+  if ( dat->datum->type() != sprokit::datum::data )
+  {
+    // Output the frames received before this datum, then pass it on
+    if ( has_timestamp )
+    {
+      grab_from_port( timestamp_port );
+    }
+    process_batch();
+
+    if ( dat->datum->type() == sprokit::datum::complete )
+    {
+      info.active = false;
+    }
+    push_datum_to_port( detections_prefix + info.name, dat->datum );
+    push_datum_to_port( timestamp_prefix + info.name, dat->datum );
+    return true;
+  }
+
+  priv::frame f;
+  f.stream = stream;
+  f.image = dat->datum->get_datum< vital::image_container_sptr >();
+  if ( has_timestamp )
+  {
+    f.ts = grab_from_port_as< vital::timestamp >( timestamp_port );
+  }
+
+  if ( d->m_batch.empty() )
+  {
+    d->m_batch_start = std::chrono::steady_clock::now();
+  }
+  d->m_batch.push_back( f );
+
+  return true;
+}
+
+// ------------------------------------------------------------------
+void
+multi_stream_object_detector_process::
+process_batch()
+{
+  if ( d->m_batch.empty() )
+  {
+    return;
+  }
+
+  std::vector< vital::image_container_sptr > images;
+  images.reserve( d->m_batch.size() );
+  for ( auto const& f : d->m_batch )
+  {
+    images.push_back( f.image );
+  }
+
+  std::vector< vital::detected_object_set_sptr > results;
+  {
+    scoped_step_instrumentation();
+
+    // Get detections from detector on the images
+    if ( images.size() == 1 )
+    {
+      results.push_back( d->m_detector->detect( images.front() ) );
+    }
+    else
+    {
+      results = d->m_detector->batch_detect( images );
+    }
+  }
+
+  if ( results.size() != images.size() )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "Detector returned the wrong number of detection sets" );
+  }
+
+  // Send each result back to the stream of its frame
+  for ( size_t i = 0; i < results.size(); ++i )
+  {
+    auto const& f = d->m_batch[i];
+    auto const& stream = d->m_streams[f.stream].name;
+
+    push_to_port_as< vital::detected_object_set_sptr >(
+      detections_prefix + stream, results[i] );
+    push_to_port_as< vital::timestamp >( timestamp_prefix + stream, f.ts );
+  }
+
+  d->m_batch.clear();
+}
+
+// ------------------------------------------------------------------
+sprokit::process::properties_t
+multi_stream_object_detector_process::
+_properties() const
+{
+  properties_t consts = process::_properties();
+
+  consts.insert( property_unsync_input );
+  consts.insert( property_unsync_output );
+
+  return consts;
+}
+
+// ------------------------------------------------------------------
+// Intercept input port connection so we can create the ports of a stream
+void
+multi_stream_object_detector_process::
+input_port_undefined( port_t const& port )
+{
+  if ( kwiver::vital::starts_with( port, image_prefix ) )
+  {
+    make_stream( port.substr( image_prefix.size() ) );
+  }
+  else if ( kwiver::vital::starts_with( port, timestamp_prefix ) )
+  {
+    make_stream( port.substr( timestamp_prefix.size() ) );
+  }
+}
+
+// ------------------------------------------------------------------
+// Intercept output port connection so we can create the ports of a stream
+void
+multi_stream_object_detector_process::
+output_port_undefined( port_t const& port )
+{
+  if ( kwiver::vital::starts_with( port, detections_prefix ) )
+  {
+    make_stream( port.substr( detections_prefix.size() ) );
+  }
+  else if ( kwiver::vital::starts_with( port, timestamp_prefix ) )
+  {
+    make_stream( port.substr( timestamp_prefix.size() ) );
+  }
+}
+
+// ------------------------------------------------------------------
+void
+multi_stream_object_detector_process::
+make_stream( std::string const& stream )
+{
+  if ( stream.empty() || d->m_stream_index.count( stream ) )
+  {
+    return;
+  }
+
+  d->m_stream_index[ stream ] = d->m_streams.size();
+  d->m_streams.push_back( { stream, true } );
+
+  sprokit::process::port_flags_t required;
+  sprokit::process::port_flags_t optional;
+
+  required.insert( flag_required );
+
+  // -- input --
+  declare_input_port( image_prefix + stream,
+                      image_port_trait::type_name,
+                      required,
+                      "Images of stream " + stream + "." );
+  declare_input_port( timestamp_prefix + stream,
+                      timestamp_port_trait::type_name,
+                      optional,
+                      "Timestamps of the images of stream " + stream + "." );
+
+  // -- output --
+  declare_output_port( detections_prefix + stream,
+                       detected_object_set_port_trait::type_name,
+                       optional,
+                       "Detections in the images of stream " + stream + "." );
+  declare_output_port( timestamp_prefix + stream,
+                       timestamp_port_trait::type_name,
+                       optional,
+                       "Timestamps of the images of stream " + stream + "." );
+}
+
+// ------------------------------------------------------------------
+void
+multi_stream_object_detector_process::
+make_config()
+{
+  declare_config_using_trait( detector );
+  declare_config_using_trait( batch_size );
+  declare_config_using_trait( batch_timeout );
+}
+
+// ================================================================
+multi_stream_object_detector_process::priv
+::priv()
+  : m_batch_size( 0 )
+  , m_batch_timeout( 0.0 )
+  , m_next_stream( 0 )
+{
+}
+
+multi_stream_object_detector_process::priv
+::~priv()
+{
+}
+
+// ------------------------------------------------------------------
+size_t
+multi_stream_object_detector_process::priv
+::count_active() const
+{
+  return static_cast< size_t >(
+    std::count_if( m_streams.begin(), m_streams.end(),
+                   []( stream_info const& s ){ return s.active; } ) );
+}
+
+} // end namespace kwiver
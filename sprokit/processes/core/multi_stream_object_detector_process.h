@@ -0,0 +1,97 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef ARROWS_PROCESSES_MULTI_STREAM_OBJECT_DETECTOR_PROCESS_H
+#define ARROWS_PROCESSES_MULTI_STREAM_OBJECT_DETECTOR_PROCESS_H
+
+#include <sprokit/pipeline/process.h>
+
+#include "kwiver_processes_export.h"
+
+#include <vital/config/config_block.h>
+
+namespace kwiver {
+
+// ----------------------------------------------------------------
+/**
+ * @brief Object detector process shared by several video streams.
+ *
+ * Frames from any number of independent streams are gathered into
+ * batches for a single detector, and the detections of each frame are
+ * sent out on the ports of the stream it came from, with its timestamp.
+ * This keeps a batching detector busy with full batches when each
+ * stream alone is too slow to fill them.
+ *
+ * Each stream is named by the ports connected to it. Frames are taken
+ * from the streams in turn as they arrive, so a stalled stream does not
+ * hold up the others, and the outputs of each stream keep the order of
+ * its inputs. Control datums such as flush and complete are passed on to
+ * the stream they arrived on after its pending frames.
+ *
+ * In an embedded pipeline, the streams may be fed from the input adapter
+ * through ports named \c image/\portvar{stream}. Streams run by separate
+ * pipeline instances can instead batch together through the
+ * \c shared_detector option of the \c image_object_detector process.
+ *
+ * \iports
+ * \iport{image/\portvar{stream}} The images of a stream.
+ * \iport{timestamp/\portvar{stream}} The timestamps of a stream.
+ *
+ * \oports
+ *
+ * \oport{detected_object_set/\portvar{stream}} The detections of each image
+ *                                               of a stream.
+ * \oport{timestamp/\portvar{stream}} The timestamp of each image of a
+ *                                    stream.
+ *
+ * \code
+ process detector :: multi_stream_object_detector
+   batch_size = 32
+   batch_timeout = 0.05
+   detector:type = darknet
+
+ connect from camera_1.image      to detector.image/camera_1
+ connect from camera_1.timestamp  to detector.timestamp/camera_1
+ connect from camera_2.image      to detector.image/camera_2
+ connect from camera_2.timestamp  to detector.timestamp/camera_2
+
+ connect from detector.detected_object_set/camera_1  to tracker_1.detected_object_set
+ connect from detector.timestamp/camera_1            to tracker_1.timestamp
+ connect from detector.detected_object_set/camera_2  to tracker_2.detected_object_set
+ connect from detector.timestamp/camera_2            to tracker_2.timestamp
+ * \endcode
+ */
+class KWIVER_PROCESSES_NO_EXPORT multi_stream_object_detector_process
+  : public sprokit::process
+{
+public:
+  PLUGIN_INFO( "multi_stream_object_detector",
+               "Apply one image object detector to the images of several "
+               "streams, batching frames across the streams." )
+
+  multi_stream_object_detector_process( kwiver::vital::config_block_sptr const& config );
+  virtual ~multi_stream_object_detector_process();
+
+protected:
+  void _configure() override;
+  void _init() override;
+  void _step() override;
+  properties_t _properties() const override;
+
+  void input_port_undefined( port_t const& port ) override;
+  void output_port_undefined( port_t const& port ) override;
+
+private:
+  void make_config();
+  void make_stream( std::string const& stream );
+  bool take_frame( size_t stream, sprokit::edge::duration_t const& wait );
+  void process_batch();
+
+  class priv;
+  const std::unique_ptr<priv> d;
+}; // end class multi_stream_object_detector_process
+
+} // end namespace
+
+#endif /* ARROWS_PROCESSES_MULTI_STREAM_OBJECT_DETECTOR_PROCESS_H */
@@ -8,11 +8,17 @@
 
 #include <sprokit/pipeline/process_exception.h>
 
+#include <vital/algo/descriptor_index.h>
 #include <vital/algo/read_object_track_set.h>
 #include <vital/algo/read_track_descriptor_set.h>
 
+#include <kwiversys/SystemTools.hxx>
+
 #include <boost/filesystem.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
 #include <tuple>
 
 namespace kwiver {
@@ -35,6 +41,7 @@ create_port_trait( result_descriptor_scores, double_vector,
 // -- config traits --
 create_algorithm_name_config_trait( descriptor_reader );
 create_algorithm_name_config_trait( track_reader );
+create_algorithm_name_config_trait( descriptor_index );
 
 create_config_trait( external_handler, bool,
   "true", "Whether or not an external query handler is used" );
@@ -48,6 +55,11 @@ create_config_trait( descriptor_postfix, std::string,
   "_descriptors.csv", "Postfix to add to basename for desc files" );
 create_config_trait( index_postfix, std::string,
   ".index", "Postfix to add to basename for reading index files" );
+create_config_trait( index_file, std::string,
+  "", "File holding the descriptor index searched when no external "
+  "handler is used. The index is loaded from it if it matches the "
+  "database, and otherwise built and written to it. If empty, the index "
+  "is built in memory each run." );
 
 //------------------------------------------------------------------------------
 // Private implementation class
@@ -65,6 +77,7 @@ class perform_query_process::priv
   std::string track_postfix;
   std::string descriptor_postfix;
   std::string index_postfix;
+  std::string index_file;
 
   unsigned max_result_count;
 
@@ -80,6 +93,10 @@ class perform_query_process::priv
 
   algo::read_track_descriptor_set_sptr descriptor_reader;
   algo::read_object_track_set_sptr track_reader;
+  algo::descriptor_index_sptr descriptor_index;
+
+  // UID of each descriptor in the index, by index
+  std::vector< std::string > index_uids;
 
   // Video name <=> descriptor sptr <=> track sptr tuple
   typedef std::tuple< std::string,
@@ -89,6 +106,11 @@ class perform_query_process::priv
   std::map< std::string, desc_tuple_t > uid_to_desc;
 
   void populate_database();
+  void populate_index();
+  void search_index( std::vector< vital::descriptor_sptr > const& queries,
+                     std::vector< vital::descriptor_sptr > const& negatives,
+                     vital::string_vector& uids,
+                     vital::double_vector& scores );
 
   void reset_query( const vital::database_query_sptr& query );
   unsigned get_instance_id( const std::string& uid );
@@ -125,51 +147,77 @@ ::_configure()
   d->track_postfix = config_value_using_trait( track_postfix );
   d->descriptor_postfix = config_value_using_trait( descriptor_postfix );
   d->index_postfix = config_value_using_trait( index_postfix );
+  d->index_file = config_value_using_trait( index_file );
 
-  if( d->external_handler )
-  {
-    algo::read_track_descriptor_set::set_nested_algo_configuration_using_trait(
-      descriptor_reader,
-      algo_config,
-      d->descriptor_reader );
+  // The database is read in both modes
+  algo::read_track_descriptor_set::set_nested_algo_configuration_using_trait(
+    descriptor_reader,
+    algo_config,
+    d->descriptor_reader );
 
-    if( !d->descriptor_reader )
-    {
-      VITAL_THROW( sprokit::invalid_configuration_exception,
-        name(), "Unable to create descriptor reader" );
-    }
+  if( !d->descriptor_reader )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception,
+      name(), "Unable to create descriptor reader" );
+  }
 
-    algo::read_track_descriptor_set::get_nested_algo_configuration_using_trait(
-      descriptor_reader,
-      algo_config,
-      d->descriptor_reader );
+  algo::read_track_descriptor_set::get_nested_algo_configuration_using_trait(
+    descriptor_reader,
+    algo_config,
+    d->descriptor_reader );
 
-    if( !algo::read_track_descriptor_set::check_nested_algo_configuration_using_trait(
-          descriptor_reader,
-          algo_config ) )
-    {
-      VITAL_THROW( sprokit::invalid_configuration_exception,
-                   name(), "Configuration check failed." );
-    }
+  if( !algo::read_track_descriptor_set::check_nested_algo_configuration_using_trait(
+        descriptor_reader,
+        algo_config ) )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception,
+                 name(), "Configuration check failed." );
+  }
 
   algo::read_object_track_set::set_nested_algo_configuration_using_trait(
     track_reader,
     algo_config,
     d->track_reader );
 
-    if( !d->track_reader )
+  if( !d->track_reader )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception,
+                 name(), "Unable to create track reader" );
+  }
+
+  algo::read_object_track_set::get_nested_algo_configuration_using_trait(
+    track_reader,
+    algo_config,
+    d->track_reader );
+
+  if( !algo::read_object_track_set::check_nested_algo_configuration_using_trait(
+        track_reader,
+        algo_config ) )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception,
+                 name(), "Configuration check failed." );
+  }
+
+  if( !d->external_handler )
+  {
+    algo::descriptor_index::set_nested_algo_configuration_using_trait(
+      descriptor_index,
+      algo_config,
+      d->descriptor_index );
+
+    if( !d->descriptor_index )
     {
       VITAL_THROW( sprokit::invalid_configuration_exception,
-                   name(), "Unable to create track reader" );
+                   name(), "Unable to create descriptor index" );
     }
 
-    algo::read_object_track_set::get_nested_algo_configuration_using_trait(
-      track_reader,
+    algo::descriptor_index::get_nested_algo_configuration_using_trait(
+      descriptor_index,
       algo_config,
-      d->track_reader );
+      d->descriptor_index );
 
-    if( !algo::read_object_track_set::check_nested_algo_configuration_using_trait(
-          track_reader,
+    if( !algo::descriptor_index::check_nested_algo_configuration_using_trait(
+          descriptor_index,
           algo_config ) )
     {
       VITAL_THROW( sprokit::invalid_configuration_exception,
@@ -233,73 +281,76 @@ ::_step()
     d->is_first = false;
   }
 
-  // Call external feedback loop if enabled
-  if( d->external_handler )
-  {
-    d->populate_database();
+  d->populate_database();
 
-    vital::string_vector_sptr positive_uids( new vital::string_vector() );
-    vital::string_vector_sptr negative_uids( new vital::string_vector() );
+  vital::string_vector_sptr positive_uids( new vital::string_vector() );
+  vital::string_vector_sptr negative_uids( new vital::string_vector() );
+  std::vector< vital::descriptor_sptr > positive_raw_descs;
+  std::vector< vital::descriptor_sptr > negative_raw_descs;
 
-    if( feedback &&
-      ( !feedback->positive_ids().empty() ) )
+  if( feedback &&
+    ( !feedback->positive_ids().empty() ) )
+  {
+    for( auto id : feedback->positive_ids() )
     {
-      for( auto id : feedback->positive_ids() )
+      for( auto desc_sptr : *d->previous_results[id]->descriptors() )
       {
-        for( auto desc_sptr : *d->previous_results[id]->descriptors() )
-        {
-          positive_uids->push_back( desc_sptr->get_uid().value() );
-        }
+        positive_uids->push_back( desc_sptr->get_uid().value() );
+        positive_raw_descs.push_back( desc_sptr->get_descriptor() );
+      }
 
-        d->forced_positives[ id ] = d->previous_results[ id ];
+      d->forced_positives[ id ] = d->previous_results[ id ];
 
-        auto negative_itr = d->forced_negatives.find( id );
+      auto negative_itr = d->forced_negatives.find( id );
 
-        if( negative_itr != d->forced_negatives.end() )
-        {
-          d->forced_negatives.erase( negative_itr );
-        }
+      if( negative_itr != d->forced_negatives.end() )
+      {
+        d->forced_negatives.erase( negative_itr );
       }
     }
+  }
 
-    if( feedback &&
-      ( !feedback->negative_ids().empty() ) )
+  if( feedback &&
+    ( !feedback->negative_ids().empty() ) )
+  {
+    for( auto id : feedback->negative_ids() )
     {
-      for( auto id : feedback->negative_ids() )
+      for( auto desc_sptr : *d->previous_results[id]->descriptors() )
       {
-        for( auto desc_sptr : *d->previous_results[id]->descriptors() )
-        {
-          negative_uids->push_back( desc_sptr->get_uid().value() );
-        }
+        negative_uids->push_back( desc_sptr->get_uid().value() );
+        negative_raw_descs.push_back( desc_sptr->get_descriptor() );
+      }
 
-        d->forced_negatives[ id ] = d->previous_results[ id ];
+      d->forced_negatives[ id ] = d->previous_results[ id ];
 
-        auto positive_itr = d->forced_positives.find( id );
+      auto positive_itr = d->forced_positives.find( id );
 
-        if( positive_itr != d->forced_positives.end() )
-        {
-          d->forced_positives.erase( positive_itr );
-        }
+      if( positive_itr != d->forced_positives.end() )
+      {
+        d->forced_positives.erase( positive_itr );
       }
     }
+  }
 
-    // Format data to simplified format for external
-    std::vector< vital::descriptor_sptr > exemplar_raw_descs;
+  // Format data to simplified format for external
+  std::vector< vital::descriptor_sptr > exemplar_raw_descs;
 
-    vital::string_vector_sptr exemplar_uids( new vital::string_vector() );
+  vital::string_vector_sptr exemplar_uids( new vital::string_vector() );
 
-    for( auto track_desc : *query->descriptors() )
-    {
-      exemplar_uids->push_back( track_desc->get_uid().value() );
-      exemplar_raw_descs.push_back( track_desc->get_descriptor() );
-    }
+  for( auto track_desc : *query->descriptors() )
+  {
+    exemplar_uids->push_back( track_desc->get_uid().value() );
+    exemplar_raw_descs.push_back( track_desc->get_descriptor() );
+  }
+
+  vital::string_vector_sptr result_uids;
+  vital::double_vector_sptr result_scores;
 
+  if( d->external_handler )
+  {
     vital::descriptor_set_sptr exemplar_descs(
       new vital::simple_descriptor_set( exemplar_raw_descs ) );
 
-    vital::string_vector_sptr result_uids;
-    vital::double_vector_sptr result_scores;
-
     // Send data to external process
     push_to_port_using_trait( external_descriptor_set, exemplar_descs );
     push_to_port_using_trait( external_exemplar_uids, exemplar_uids );
@@ -309,107 +360,115 @@ ::_step()
     // Receive data from external process (halts until finished)
     result_uids = grab_from_port_using_trait( result_descriptor_uids );
     result_scores = grab_from_port_using_trait( result_descriptor_scores );
+  }
+  else
+  {
+    // Search near the exemplars and the positive IQR examples together
+    result_uids = std::make_shared< vital::string_vector >();
+    result_scores = std::make_shared< vital::double_vector >();
+
+    exemplar_raw_descs.insert( exemplar_raw_descs.end(),
+                               positive_raw_descs.begin(),
+                               positive_raw_descs.end() );
+    d->search_index( exemplar_raw_descs, negative_raw_descs,
+                     *result_uids, *result_scores );
+  }
 
-    // Handle forced positive examples, set score to 1, make sure at front
-    for( auto itr = d->forced_positives.begin();
-         itr != d->forced_positives.end(); itr++ )
-    {
-      itr->second->set_relevancy_score( 1.0 );
-      output->push_back( itr->second );
-    }
+  // Handle forced positive examples, set score to 1, make sure at front
+  for( auto itr = d->forced_positives.begin();
+       itr != d->forced_positives.end(); itr++ )
+  {
+    itr->second->set_relevancy_score( 1.0 );
+    output->push_back( itr->second );
+  }
 
-    // Handle all new or unadjudacted results
-    for( unsigned i = 0; i < result_uids->size(); ++i )
+  // Handle all new or unadjudacted results
+  for( unsigned i = 0; i < result_uids->size(); ++i )
+  {
+    if( i > d->max_result_count )
     {
-      if( i > d->max_result_count )
-      {
-        break;
-      }
+      break;
+    }
 
-      auto result_uid = (*result_uids)[i];
-      auto result_score = (*result_scores)[i];
+    auto result_uid = (*result_uids)[i];
+    auto result_score = (*result_scores)[i];
 
-      auto db_res = d->uid_to_desc.find( result_uid );
+    auto db_res = d->uid_to_desc.find( result_uid );
 
-      if( db_res == d->uid_to_desc.end() )
-      {
-        continue;
-      }
+    if( db_res == d->uid_to_desc.end() )
+    {
+      continue;
+    }
 
-      // Create result set and set relevant IDs
-      auto iid = d->get_instance_id( result_uid );
+    // Create result set and set relevant IDs
+    auto iid = d->get_instance_id( result_uid );
 
-      // Check if result is forced positive or negative (e.g. annotated by user)
-      if( d->forced_positives.find( iid ) != d->forced_positives.end() ||
-          d->forced_negatives.find( iid ) != d->forced_negatives.end() )
-      {
-        continue;
-      }
+    // Check if result is forced positive or negative (e.g. annotated by user)
+    if( d->forced_positives.find( iid ) != d->forced_positives.end() ||
+        d->forced_negatives.find( iid ) != d->forced_negatives.end() )
+    {
+      continue;
+    }
 
-      vital::query_result_sptr entry( new vital::query_result() );
+    vital::query_result_sptr entry( new vital::query_result() );
 
-      entry->set_query_id( d->active_uid );
-      entry->set_stream_id( std::get<0>( db_res->second ) );
-      entry->set_instance_id( iid );
-      entry->set_relevancy_score( result_score );
+    entry->set_query_id( d->active_uid );
+    entry->set_stream_id( std::get<0>( db_res->second ) );
+    entry->set_instance_id( iid );
+    entry->set_relevancy_score( result_score );
 
-      // Assign track descriptor set to result
-      vital::track_descriptor_set_sptr desc_set(
-        new vital::track_descriptor_set() );
+    // Assign track descriptor set to result
+    vital::track_descriptor_set_sptr desc_set(
+      new vital::track_descriptor_set() );
 
-      desc_set->push_back( std::get<1>( db_res->second ) );
-      entry->set_descriptors( desc_set );
+    desc_set->push_back( std::get<1>( db_res->second ) );
+    entry->set_descriptors( desc_set );
 
-      // Assign temporal bounds to this query result
-      vital::timestamp ts1, ts2;
-      bool is_first = true;
+    // Assign temporal bounds to this query result
+    vital::timestamp ts1, ts2;
+    bool is_first = true;
 
-      for( auto desc : *desc_set )
+    for( auto desc : *desc_set )
+    {
+      for( auto hist : desc->get_history() )
       {
-        for( auto hist : desc->get_history() )
+        if( is_first )
+        {
+          ts1 = hist.get_timestamp();
+          ts2 = hist.get_timestamp();
+
+          is_first = false;
+        }
+        else if( hist.get_timestamp().get_frame() < ts1.get_frame() )
         {
-          if( is_first )
-          {
-            ts1 = hist.get_timestamp();
-            ts2 = hist.get_timestamp();
-
-            is_first = false;
-          }
-          else if( hist.get_timestamp().get_frame() < ts1.get_frame() )
-          {
-            ts1 = hist.get_timestamp();
-          }
-          else if( hist.get_timestamp().get_frame() > ts2.get_frame() )
-          {
-            ts2 = hist.get_timestamp();
-          }
+          ts1 = hist.get_timestamp();
+        }
+        else if( hist.get_timestamp().get_frame() > ts2.get_frame() )
+        {
+          ts2 = hist.get_timestamp();
         }
       }
-      entry->set_temporal_bounds( ts1, ts2 );
-
-      // Assign track set to result
-      vital::object_track_set_sptr trk_set(
-        new vital::object_track_set( std::get<2>( db_res->second ) ) );
+    }
+    entry->set_temporal_bounds( ts1, ts2 );
 
-      entry->set_tracks( trk_set );
+    // Assign track set to result
+    vital::object_track_set_sptr trk_set(
+      new vital::object_track_set( std::get<2>( db_res->second ) ) );
 
-      // Remember this descriptor result for future iterations
-      d->previous_results[ entry->instance_id() ] = entry;
+    entry->set_tracks( trk_set );
 
-      output->push_back( entry );
-    }
+    // Remember this descriptor result for future iterations
+    d->previous_results[ entry->instance_id() ] = entry;
 
-    // Handle forced negative examples, set score to 0, make sure at end of result set
-    for( auto itr = d->forced_negatives.begin();
-         itr != d->forced_negatives.end(); itr++ )
-    {
-      itr->second->set_relevancy_score( 0.0 );
-      output->push_back( itr->second );
-    }
+    output->push_back( entry );
   }
-  else
+
+  // Handle forced negative examples, set score to 0, make sure at end of result set
+  for( auto itr = d->forced_negatives.begin();
+       itr != d->forced_negatives.end(); itr++ )
   {
-    throw std::runtime_error( "Only external handler mode yet supported" );
+    itr->second->set_relevancy_score( 0.0 );
+    output->push_back( itr->second );
   }
 
   // Push outputs downstream
@@ -451,12 +510,14 @@ ::make_config()
 {
   declare_config_using_trait( descriptor_reader );
   declare_config_using_trait( track_reader );
+  declare_config_using_trait( descriptor_index );
   declare_config_using_trait( external_handler );
   declare_config_using_trait( database_folder );
   declare_config_using_trait( max_result_count );
   declare_config_using_trait( descriptor_postfix );
   declare_config_using_trait( track_postfix );
   declare_config_using_trait( index_postfix );
+  declare_config_using_trait( index_file );
 }
 
 // =============================================================================
@@ -547,9 +608,160 @@ ::populate_database()
     }
   }
 
+  if( !external_handler )
+  {
+    populate_index();
+  }
+
   database_populated = true;
 }
 
+void perform_query_process::priv
+::populate_index()
+{
+  // Descriptors are indexed in UID order, so that an index written by an
+  // earlier run over the same database can be reused
+  std::vector< vital::descriptor_sptr > descs;
+
+  index_uids.clear();
+  for( auto const& entry : uid_to_desc )
+  {
+    auto const desc = std::get<1>( entry.second )->get_descriptor();
+
+    if( desc )
+    {
+      index_uids.push_back( entry.first );
+      descs.push_back( desc );
+    }
+  }
+
+  std::string const uids_file = index_file + ".uids";
+
+  if( !index_file.empty() &&
+      kwiversys::SystemTools::FileExists( index_file ) &&
+      kwiversys::SystemTools::FileExists( uids_file ) )
+  {
+    std::vector< std::string > file_uids;
+    std::ifstream uids_in( uids_file );
+
+    for( std::string line; std::getline( uids_in, line ); )
+    {
+      file_uids.push_back( line );
+    }
+
+    if( file_uids == index_uids )
+    {
+      descriptor_index->load( index_file );
+
+      if( descriptor_index->size() == index_uids.size() )
+      {
+        return;
+      }
+    }
+
+    LOG_INFO( parent->logger(), "Descriptor index " << index_file
+              << " does not match the database; rebuilding it" );
+  }
+
+  descriptor_index->clear();
+  descriptor_index->add( descs );
+
+  if( !index_file.empty() )
+  {
+    descriptor_index->save( index_file );
+
+    std::ofstream uids_out( uids_file );
+
+    for( auto const& uid : index_uids )
+    {
+      uids_out << uid << "\n";
+    }
+
+    if( !uids_out )
+    {
+      LOG_ERROR( parent->logger(), "Unable to write " << uids_file );
+    }
+  }
+}
+
+void perform_query_process::priv
+::search_index( std::vector< vital::descriptor_sptr > const& queries,
+                std::vector< vital::descriptor_sptr > const& negatives,
+                vital::string_vector& uids,
+                vital::double_vector& scores )
+{
+  std::vector< std::vector< size_t > > indices;
+  std::vector< std::vector< double > > distances;
+
+  // Ask for enough neighbors to fill the results after the adjudicated ones
+  // are skipped
+  size_t const k = max_result_count + 1 +
+                   forced_positives.size() + forced_negatives.size();
+
+  std::vector< vital::descriptor_sptr > valid_queries;
+
+  std::copy_if( queries.begin(), queries.end(),
+                std::back_inserter( valid_queries ),
+                []( vital::descriptor_sptr const& d ){ return !!d; } );
+
+  descriptor_index->find_nearest( valid_queries, k, indices, distances );
+
+  // Distance of each result to the nearest query
+  std::map< size_t, double > nearest;
+
+  for( size_t q = 0; q < indices.size(); ++q )
+  {
+    for( size_t j = 0; j < indices[ q ].size(); ++j )
+    {
+      auto const it = nearest.emplace( indices[ q ][ j ], distances[ q ][ j ] );
+
+      if( !it.second )
+      {
+        it.first->second = std::min( it.first->second, distances[ q ][ j ] );
+      }
+    }
+  }
+
+  // Drop results nearer to a negative example than to any query
+  if( !negatives.empty() )
+  {
+    std::vector< vital::descriptor_sptr > valid_negatives;
+
+    std::copy_if( negatives.begin(), negatives.end(),
+                  std::back_inserter( valid_negatives ),
+                  []( vital::descriptor_sptr const& d ){ return !!d; } );
+
+    descriptor_index->find_nearest( valid_negatives, k, indices, distances );
+
+    for( size_t q = 0; q < indices.size(); ++q )
+    {
+      for( size_t j = 0; j < indices[ q ].size(); ++j )
+      {
+        auto const it = nearest.find( indices[ q ][ j ] );
+
+        if( it != nearest.end() && distances[ q ][ j ] < it->second )
+        {
+          nearest.erase( it );
+        }
+      }
+    }
+  }
+
+  std::vector< std::pair< double, size_t > > order;
+
+  for( auto const& n : nearest )
+  {
+    order.emplace_back( n.second, n.first );
+  }
+  std::sort( order.begin(), order.end() );
+
+  for( auto const& o : order )
+  {
+    uids.push_back( index_uids[ o.second ] );
+    scores.push_back( 1.0 / ( 1.0 + o.first ) );
+  }
+}
+
 void perform_query_process::priv
 ::reset_query( const vital::database_query_sptr& query )
 {
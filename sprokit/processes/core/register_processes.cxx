@@ -22,6 +22,7 @@
 #include "downsample_process.h"
 #include "draw_detected_object_set_process.h"
 #include "draw_tracks_process.h"
+#include "extract_chips_process.h"
 #include "extract_descriptors_process.h"
 #include "frame_list_process.h"
 #include "handle_descriptor_request_process.h"
@@ -31,10 +32,12 @@
 #include "image_writer_process.h"
 #include "initialize_object_tracks_process.h"
 #include "keyframe_selection_process.h"
+#include "latency_feedback_process.h"
 #include "matcher_process.h"
 #include "merge_detection_sets_process.h"
 #include "perform_query_process.h"
 #include "merge_images_process.h"
+#include "multi_stream_object_detector_process.h"
 #include "print_config_process.h"
 #include "detect_motion_process.h"
 #include "read_descriptor_process.h"
@@ -82,6 +85,7 @@ register_factories( kwiver::vital::plugin_loader& vpm )
   reg.register_process< read_descriptor_process >();
   reg.register_process< refine_detections_process >();
   reg.register_process< image_object_detector_process >();
+  reg.register_process< multi_stream_object_detector_process >( process_registrar::no_test );
   reg.register_process< image_filter_process >();
   reg.register_process< image_writer_process >();
   reg.register_process< image_file_reader_process >();
@@ -92,6 +96,7 @@ register_factories( kwiver::vital::plugin_loader& vpm )
   reg.register_process< video_input_process >();
   reg.register_process< draw_detected_object_set_process >();
   reg.register_process< split_image_process >();
+  reg.register_process< extract_chips_process >();
   reg.register_process< merge_images_process >( process_registrar::no_test );
   reg.register_process< read_track_descriptor_process >();
   reg.register_process< write_track_descriptor_process >();
@@ -113,6 +118,7 @@ register_factories( kwiver::vital::plugin_loader& vpm )
   reg.register_process< perform_query_process >();
   reg.register_process< detect_motion_process >();
   reg.register_process< shift_detected_object_set_frames_process >();
+  reg.register_process< latency_feedback_process >();
 
   reg.mark_module_as_loaded();
 } // register_process
@@ -40,7 +40,8 @@ namespace kwiver {
  * \oports
  *
  * \oport{algo} Output ports are dynamically created as needed and
- * must correspond to the algo name from an input port.
+ * must correspond to the algo name from an input port. With
+ * \c output_parts set, they carry each message as a sequence of parts.
  *
  * \code
  process ser :: serializer
@@ -66,6 +67,12 @@ create_config_trait( serialization_type, std::string, "",
 
 create_config_trait( dump_message, bool, "false",
                      "Dump printable version of serialized messages of set to true." );
+create_config_trait( output_parts, bool, "false",
+                     "Output each message as a sequence of parts, on ports of type "
+                     "\"kwiver:serialized_message_parts\", instead of a single byte "
+                     "string. Transports can send the parts without joining them, so "
+                     "serializers which refer to the memory of large data elements "
+                     "avoid copying them." );
 
 class serializer_process::priv
 {
@@ -74,6 +81,7 @@ class serializer_process::priv
   ~priv();
 
   bool opt_dump_message;
+  bool opt_output_parts;
 };
 
 // ============================================================================
@@ -103,6 +111,7 @@ ::_configure()
   // Examine the configuration
   m_serialization_type = config_value_using_trait( serialization_type );
   d->opt_dump_message =  config_value_using_trait( dump_message );
+  d->opt_output_parts = config_value_using_trait( output_parts );
 
   if (m_serialization_type.empty())
   {
@@ -146,30 +155,32 @@ ::_step()
     // element ::= <element-name> <port-type> <length> <serialized-bytes>
     //         |
 
-    std::ostringstream message_str;
     const auto & msg_spec = m_message_spec_list[msg_spec_it.first];
 
-    // Add message type string
-    message_str << msg_spec_it.first << " ";
-
-    std::ostringstream ser_elements;
+    // The message is assembled as a list of parts: the text fields
+    // surrounding each element are small strings, and the serialized
+    // elements are kept as their serializers returned them.
+    auto parts = std::make_shared< kwiver::vital::algo::message_parts >();
+    parts->push_back( {} ); // placeholder for the message header
 
     // loop over all elements that are part of this group.
     // This assembles the output byte string from one or more concrete data types.
     for ( auto msg_elem_it : msg_spec.m_elements )
     {
       const auto& element = msg_elem_it.second;
+
       LOG_TRACE( logger(), "Processing port: \"" << element.m_port_name
                  << "\" of type \"" << element.m_port_type << "\"" );
 
       // Convert input datum to a serialized message
       auto datum = grab_datum_from_port( element.m_port_name );
       auto local_datum = datum->get_datum<kwiver::vital::any>();
-      std::shared_ptr< std::string > message;
+
+      kwiver::vital::algo::message_parts element_parts;
       try
       {
         // Serialize the collected set of inputs
-        message = element.m_serializer->serialize( local_datum );
+        element_parts = element.m_serializer->serialize_parts( local_datum );
       }
       catch ( const kwiver::vital::vital_exception& e )
       {
@@ -179,11 +190,12 @@ ::_step()
         break;
       }
 
+      auto const element_size = kwiver::vital::algo::message_size( element_parts );
       LOG_TRACE( logger(), "Adding element: \"" << element.m_element_name
                  << "\"  Port type: \"" << element.m_port_type << "\"  Size: "
-                 << message->size() );
+                 << element_size );
 
-      if ( message->empty() )
+      if ( element_size == 0 )
       {
         LOG_WARN( logger(), "Serializer for message element \"" << element.m_element_name
                    << "\" for port name \"" << element.m_port_name
@@ -191,22 +203,45 @@ ::_step()
       }
 
       // Add element name and port type to output followed by serialized data
-      ser_elements << element.m_element_name << " "
-                   << element.m_port_type << " "
-                   << message->size() << " "
-                   << *message;
+      std::ostringstream element_str;
+      element_str << element.m_element_name << " "
+                  << element.m_port_type << " "
+                  << element_size << " ";
+      kwiver::vital::algo::add_message_part(
+        *parts, std::make_shared< std::string >( element_str.str() ) );
+      parts->insert( parts->end(), element_parts.begin(), element_parts.end() );
     } // end for
 
-    // Add payload length to output buffer before the serialized elements.
-    message_str << ser_elements.str().size()+1 << " " << ser_elements.str();
+    // Add message type and payload length before the serialized elements.
+    std::ostringstream message_str;
+    message_str << msg_spec_it.first << " "
+                << kwiver::vital::algo::message_size( *parts ) + 1 << " ";
+    auto const header = std::make_shared< std::string >( message_str.str() );
+    parts->front() = { header->data(), header->size(), header };
+
+    if ( d->opt_output_parts )
+    {
+      if ( d->opt_dump_message )
+      {
+        decode_message( kwiver::vital::algo::join_message_parts( *parts ) );
+      }
+
+      // Push the parts of the message, to be sent without joining them
+      push_to_port_as < serialized_message_parts_port_trait::type >(
+        msg_spec.m_serialized_port_name, parts );
+      continue;
+    }
+
+    // Join the whole serialized message into a buffer of its final size
+    auto msg_buffer = std::make_shared< std::string >(
+      kwiver::vital::algo::join_message_parts( *parts ) );
 
     if (d->opt_dump_message)
     {
-      decode_message( message_str.str() );
+      decode_message( *msg_buffer );
     }
 
     // Push whole serialized message to port
-    auto msg_buffer = std::make_shared< std::string >( message_str.str() );
     push_to_port_as < serialized_message_port_trait::type >( msg_spec.m_serialized_port_name, msg_buffer );
 
   } // end for
@@ -258,10 +293,15 @@ output_port_undefined(port_t const& port_name)
 
       LOG_TRACE( logger(), "Creating output port: \"" << port_name << "\"" );
 
+      // Ports may be created before the process is configured
+      auto const port_type = config_value_using_trait( output_parts )
+        ? serialized_message_parts_port_trait::type_name
+        : serialized_message_port_trait::type_name;
+
       // Create output port
       declare_output_port(
         port_name,                                // port name
-        serialized_message_port_trait::type_name, // port type
+        port_type,                                // port type
         required,                                 // port flags
         "serialized output" );
     }
@@ -295,12 +335,14 @@ ::make_config()
 {
   declare_config_using_trait( serialization_type );
   declare_config_using_trait( dump_message );
+  declare_config_using_trait( output_parts );
 }
 
 // ------------------------------------------------------------------
 serializer_process::priv
 ::priv()
   : opt_dump_message( false )
+  , opt_output_parts( false )
 {
 }
 
@@ -8,6 +8,8 @@
 #include <sprokit/processes/kwiver_type_traits.h>
 #include <sprokit/pipeline/process_exception.h>
 
+#include <string>
+
 /**
  * \file shift_detected_object_set_frames_process.cxx
  *
@@ -107,6 +109,28 @@ ::_step()
   }
 }
 
+std::string
+shift_detected_object_set_frames_process
+::_save_state()
+{
+  return std::to_string(d->remaining_offset);
+}
+
+void
+shift_detected_object_set_frames_process
+::_restore_state(std::string const& state)
+{
+  try
+  {
+    d->remaining_offset = std::stoi(state);
+  }
+  catch (std::exception const&)
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "Saved state \"" + state + "\" is not an offset" );
+  }
+}
+
 shift_detected_object_set_frames_process::priv
 ::priv(int offset)
   : remaining_offset(offset)
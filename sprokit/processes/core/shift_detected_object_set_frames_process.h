@@ -70,6 +70,16 @@ class KWIVER_PROCESSES_NO_EXPORT shift_detected_object_set_frames_process
      * \brief Step the process.
      */
     void _step();
+
+    /**
+     * \brief Save the part of the offset not yet applied.
+     */
+    std::string _save_state();
+
+    /**
+     * \brief Restore the part of the offset not yet applied.
+     */
+    void _restore_state(std::string const& state);
   private:
     void make_ports();
     void make_config();
@@ -5,6 +5,7 @@
 #include "video_input_process.h"
 
 #include <vital/vital_types.h>
+#include <vital/types/frame_stamp.h>
 #include <vital/types/timestamp.h>
 #include <vital/types/image_container.h>
 #include <vital/types/image.h>
@@ -16,6 +17,9 @@
 
 #include <sprokit/pipeline/process_exception.h>
 #include <sprokit/pipeline/datum.h>
+#include <sprokit/pipeline/latency_feedback.h>
+
+#include <vector>
 
 // -- DEBUG
 #if defined DEBUG
@@ -37,6 +41,29 @@ create_config_trait( frame_time, double, "0.03333333",
                      "If the input video stream does not supply frame times, "
                      "this value is used to create a default timestamp. "
                      "If the video stream has frame times, then those are used." );
+create_config_trait( stream_id, unsigned, "0",
+                     "Stream number placed in the frame_stamp output, which "
+                     "tells frames of this video from those of other videos "
+                     "in the same pipeline. Must be less than 65536." );
+create_config_trait( latency_channel, std::string, "",
+                     "Name of a latency channel for real-time operation. "
+                     "When set, frames are dropped as needed to keep the time "
+                     "from reading a frame to it reaching a latency_feedback "
+                     "process on the same channel within latency_budget. "
+                     "When empty, every frame is sent." );
+create_config_trait( latency_budget, double, "0.5",
+                     "Largest end-to-end latency, in seconds, to aim for when "
+                     "latency_channel is set." );
+create_config_trait( replay_frames, size_t, "0",
+                     "When greater than zero, read this many frames when the "
+                     "process is initialized and send them from memory "
+                     "instead of reading the video while the pipeline runs, "
+                     "so that the run excludes reading and decoding. Used to "
+                     "benchmark pipelines." );
+create_config_trait( replay_loops, size_t, "1",
+                     "Number of times to send the frames read for "
+                     "replay_frames. Frame numbers and times keep increasing "
+                     "from one loop to the next." );
 
 //----------------------------------------------------------------
 // Private implementation class
@@ -46,10 +73,28 @@ class video_input_process::priv
   priv();
   ~priv();
 
+  // Fill in the frame number and time the reader does not supply
+  void update_timestamp( kwiver::vital::timestamp& ts );
+
+  // Make the frame stamp for a timestamp
+  kwiver::vital::frame_stamp make_stamp( kwiver::vital::timestamp const& ts ) const;
+
+  // Get the metadata of the current frame, or the last metadata seen
+  kwiver::vital::metadata_vector frame_metadata();
+
+  // A frame read ahead for replay
+  struct cached_frame
+  {
+    kwiver::vital::timestamp ts;
+    kwiver::vital::image_container_sptr image;
+    kwiver::vital::metadata_vector metadata;
+  };
+
   // Configuration values
   std::string                           m_config_video_filename;
   kwiver::vital::time_usec_t              m_config_frame_time;
   bool                                  m_has_config_frame_time;
+  kwiver::vital::frame_stamp::stream_t  m_stream_id;
 
   kwiver::vital::algo::video_input_sptr m_video_reader;
   kwiver::vital::algorithm_capabilities m_video_traits;
@@ -57,8 +102,23 @@ class video_input_process::priv
   kwiver::vital::frame_id_t             m_frame_number;
   kwiver::vital::time_usec_t              m_frame_time;
 
+  // Frame interval derived from the reader frame rate, recomputed only
+  // when the rate changes
+  double                                m_frame_rate;
+  kwiver::vital::time_usec_t            m_frame_interval;
+
   kwiver::vital::metadata_vector        m_last_metadata;
 
+  sprokit::latency_channel_t            m_latency_channel;
+
+  // Replay of frames read ahead
+  size_t                                m_replay_frames;
+  size_t                                m_replay_loops;
+  std::vector< cached_frame >           m_replay;
+  size_t                                m_replay_next;
+  kwiver::vital::frame_id_t             m_replay_frame_span;
+  kwiver::vital::time_usec_t            m_replay_time_span;
+
 }; // end priv class
 
 // ================================================================
@@ -88,12 +148,31 @@ ::_configure()
   d->m_config_frame_time = static_cast<vital::time_usec_t>(
                                config_value_using_trait( frame_time ) * 1e6); // in usec
 
+  unsigned const stream_id = config_value_using_trait( stream_id );
+  if ( stream_id > kwiver::vital::frame_stamp::max_stream )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "stream_id must be less than 65536." );
+  }
+  d->m_stream_id =
+    static_cast< kwiver::vital::frame_stamp::stream_t >( stream_id );
+
   kwiver::vital::config_block_sptr algo_config = get_config(); // config for process
   if( algo_config->has_value( "frame_time" ) )
   {
     d->m_has_config_frame_time = true;
   }
 
+  std::string const channel = config_value_using_trait( latency_channel );
+  if ( ! channel.empty() )
+  {
+    d->m_latency_channel = sprokit::latency_channel::get( channel );
+    d->m_latency_channel->set_budget( config_value_using_trait( latency_budget ) );
+  }
+
+  d->m_replay_frames = config_value_using_trait( replay_frames );
+  d->m_replay_loops = config_value_using_trait( replay_loops );
+
   if ( ! algo::video_input::check_nested_algo_configuration_using_trait(
          video_reader, algo_config ) )
   {
@@ -120,12 +199,74 @@ ::_init()
   d->m_video_reader->open( d->m_config_video_filename ); // throws
 
   d->m_video_traits = d->m_video_reader->get_implementation_capabilities();
+
+  if ( d->m_latency_channel )
+  {
+    d->m_latency_channel->reset();
+  }
+
+  if ( d->m_replay_frames > 0 )
+  {
+    if ( ! d->m_video_traits.capability( kwiver::vital::algo::video_input::HAS_FRAME_DATA ) )
+    {
+      VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                   "Video reader selected does not supply image data." );
+    }
+
+    // Read the frames now, copying the pixels so that any deferred
+    // decoding or conversion happens here as well
+    d->m_replay.clear();
+    d->m_replay_next = 0;
+
+    kwiver::vital::timestamp ts;
+    while ( d->m_replay.size() < d->m_replay_frames &&
+            d->m_video_reader->next_frame( ts ) )
+    {
+      d->update_timestamp( ts );
+
+      priv::cached_frame cached;
+      cached.ts = ts;
+      cached.metadata = d->frame_metadata();
+
+      auto const frame = d->m_video_reader->frame_image();
+      if ( frame )
+      {
+        kwiver::vital::image image;
+        image.copy_from( frame->get_image() );
+        cached.image =
+          std::make_shared< kwiver::vital::simple_image_container >( image );
+      }
+      d->m_replay.push_back( cached );
+    }
+
+    // Later loops continue the frame numbers and times of the first
+    if ( ! d->m_replay.empty() )
+    {
+      auto const& first = d->m_replay.front().ts;
+      auto const& last = d->m_replay.back().ts;
+      auto const n = static_cast< kwiver::vital::frame_id_t >( d->m_replay.size() );
+
+      d->m_replay_frame_span = last.get_frame() - first.get_frame() + 1;
+      d->m_replay_time_span = last.get_time_usec() - first.get_time_usec();
+      d->m_replay_time_span +=
+        ( n > 1 ? d->m_replay_time_span / ( n - 1 ) : d->m_config_frame_time );
+    }
+
+    LOG_INFO( logger(), "Replaying " << d->m_replay.size() << " frames "
+              << d->m_replay_loops << " times" );
+  }
 }
 
 // ----------------------------------------------------------------
 void video_input_process
 ::_step()
 {
+  if ( d->m_replay_frames > 0 )
+  {
+    replay_step();
+    return;
+  }
+
   kwiver::vital::timestamp ts;
 
   if ( d->m_video_reader->next_frame( ts ) )
@@ -135,18 +276,6 @@ ::_step()
     {
       scoped_step_instrumentation();
 
-      frame = d->m_video_reader->frame_image();
-
-      // --- debug
-#if defined DEBUG
-      cv::Mat image = algorithms::ocv::image_container::vital_to_ocv( frame->get_image() );
-      namedWindow( "Display window", cv::WINDOW_NORMAL ); // Create a window for display.
-      imshow( "Display window", image ); // Show our image inside it.
-
-      waitKey(0);                 // Wait for a keystroke in the window
-#endif
-      // -- end debug
-
       // update timestamp
       //
       // Sometimes the video source can not determine either the frame
@@ -157,57 +286,39 @@ ::_step()
                      "Video reader selected does not supply image data." );
       }
 
-      if ( d->m_video_traits.capability( kwiver::vital::algo::video_input::HAS_FRAME_NUMBERS ) )
-      {
-        d->m_frame_number = ts.get_frame();
-      }
-      else
-      {
-        ++d->m_frame_number;
-        ts.set_frame( d->m_frame_number );
-      }
+      d->update_timestamp( ts );
 
-      if ( ! d->m_video_traits.capability( kwiver::vital::algo::video_input::HAS_FRAME_TIME ) )
+      // In real-time mode, skip the frame if the pipeline is too far
+      // behind; the frame number still advances so the gap is visible
+      // downstream
+      if ( d->m_latency_channel &&
+           ! d->m_latency_channel->admit( ts.get_frame() ) )
       {
-        // create an internal time standard
-        double frame_rate = d->m_video_reader->frame_rate();
-        if( ! d->m_video_traits.capability( kwiver::vital::algo::video_input::HAS_FRAME_RATE ) ||
-            frame_rate <= 0.0 || d->m_has_config_frame_time )
-        {
-          d->m_frame_time = d->m_frame_number * d->m_config_frame_time;
-        }
-        else
-        {
-          time_t frame_time_usec = ( 1.0 / frame_rate ) * 1e6;
-          d->m_frame_time = d->m_frame_number * frame_time_usec;
-        }
-        ts.set_time_usec( d->m_frame_time );
-      }
+        LOG_TRACE( logger(), "Dropping frame " << ts.get_frame()
+                   << " to stay within the latency budget" );
 
-      // If this reader/video does not have any metadata, we will just
-      // return an empty vector.  That is all handled by the algorithm
-      // implementation.
-      metadata = d->m_video_reader->frame_metadata();
-
-      // Since we want to try to always return valid metadata for this
-      // frame - if the returned metadata is empty, then use the last
-      // one we received.  The requirement is to always provide the best
-      // metadata for a frame. Since metadata appears less frequently
-      // than the frames, the metadata returned can be a little old, but
-      // it is still the best we have.
-      if ( metadata.empty() )
-      {
-        // The saved one could be empty, but it is the bewt we have.
-        metadata = d->m_last_metadata;
-      }
-      else
-      {
-        // Now that we have new metadata save it in case we need it later.
-        d->m_last_metadata = metadata;
+        // Keep the metadata, which later frames may need
+        d->frame_metadata();
+        return;
       }
+
+      frame = d->m_video_reader->frame_image();
+
+      // --- debug
+#if defined DEBUG
+      cv::Mat image = algorithms::ocv::image_container::vital_to_ocv( frame->get_image() );
+      namedWindow( "Display window", cv::WINDOW_NORMAL ); // Create a window for display.
+      imshow( "Display window", image ); // Show our image inside it.
+
+      waitKey(0);                 // Wait for a keystroke in the window
+#endif
+      // -- end debug
+
+      metadata = d->frame_metadata();
     }
 
     push_to_port_using_trait( timestamp, ts );
+    push_to_port_using_trait( frame_stamp, d->make_stamp( ts ) );
     push_to_port_using_trait( image, frame );
     push_to_port_using_trait( metadata, metadata );
     push_to_port_using_trait( frame_rate, d->m_video_reader->frame_rate() );
@@ -215,16 +326,71 @@ ::_step()
   else
   {
     LOG_DEBUG( logger(), "End of input reached, process terminating" );
+    finish();
+  }
+}
+
+// ----------------------------------------------------------------
+// Send the next frame read ahead by _init()
+void video_input_process
+::replay_step()
+{
+  size_t const count = d->m_replay.size();
+  if ( d->m_replay_next >= count * d->m_replay_loops )
+  {
+    LOG_DEBUG( logger(), "End of replay reached, process terminating" );
+    finish();
+    return;
+  }
+
+  auto const loop =
+    static_cast< kwiver::vital::frame_id_t >( d->m_replay_next / count );
+  priv::cached_frame const& cached = d->m_replay[ d->m_replay_next % count ];
+  ++d->m_replay_next;
+
+  kwiver::vital::timestamp ts = cached.ts;
+  ts.set_frame( ts.get_frame() + loop * d->m_replay_frame_span );
+  if ( ts.has_valid_time() )
+  {
+    ts.set_time_usec( ts.get_time_usec() + loop * d->m_replay_time_span );
+  }
+
+  if ( d->m_latency_channel &&
+       ! d->m_latency_channel->admit( ts.get_frame() ) )
+  {
+    return;
+  }
 
-    // indicate done
-    mark_process_as_complete();
-    const sprokit::datum_t dat= sprokit::datum::complete_datum();
+  push_to_port_using_trait( timestamp, ts );
+  push_to_port_using_trait( frame_stamp, d->make_stamp( ts ) );
+  push_to_port_using_trait( image, cached.image );
+  push_to_port_using_trait( metadata, cached.metadata );
+  push_to_port_using_trait( frame_rate, d->m_video_reader->frame_rate() );
+}
 
-    push_datum_to_port_using_trait( timestamp, dat );
-    push_datum_to_port_using_trait( image, dat );
-    push_datum_to_port_using_trait( metadata, dat );
-    push_datum_to_port_using_trait( frame_rate, dat );
+// ----------------------------------------------------------------
+// Mark the process complete and send the end of data downstream
+void video_input_process
+::finish()
+{
+  if ( d->m_latency_channel )
+  {
+    sprokit::latency_statistics_t const stats =
+      d->m_latency_channel->statistics();
+    LOG_INFO( logger(), "Real-time mode sent " << stats.admitted
+              << " frames and dropped " << stats.dropped
+              << "; recent p99 latency " << stats.latency_p99 << " s" );
   }
+
+  // indicate done
+  mark_process_as_complete();
+  const sprokit::datum_t dat= sprokit::datum::complete_datum();
+
+  push_datum_to_port_using_trait( timestamp, dat );
+  push_datum_to_port_using_trait( frame_stamp, dat );
+  push_datum_to_port_using_trait( image, dat );
+  push_datum_to_port_using_trait( metadata, dat );
+  push_datum_to_port_using_trait( frame_rate, dat );
 }
 
 // ----------------------------------------------------------------
@@ -240,6 +406,7 @@ ::make_ports()
   shared.insert( flag_output_shared );
 
   declare_output_port_using_trait( timestamp, optional );
+  declare_output_port_using_trait( frame_stamp, optional );
   declare_output_port_using_trait( image, shared );
   declare_output_port_using_trait( metadata, shared );
   declare_output_port_using_trait( frame_rate, optional );
@@ -252,14 +419,27 @@ ::make_config()
   declare_config_using_trait( video_reader );
   declare_config_using_trait( video_filename );
   declare_config_using_trait( frame_time );
+  declare_config_using_trait( stream_id );
+  declare_config_using_trait( latency_channel );
+  declare_config_using_trait( latency_budget );
+  declare_config_using_trait( replay_frames );
+  declare_config_using_trait( replay_loops );
 }
 
 // ================================================================
 video_input_process::priv
 ::priv()
   : m_has_config_frame_time( false ),
+    m_stream_id( 0 ),
     m_frame_number( 1 ),
-    m_frame_time( 0 )
+    m_frame_time( 0 ),
+    m_frame_rate( 0.0 ),
+    m_frame_interval( 0 ),
+    m_replay_frames( 0 ),
+    m_replay_loops( 1 ),
+    m_replay_next( 0 ),
+    m_replay_frame_span( 0 ),
+    m_replay_time_span( 0 )
 {
 }
 
@@ -268,4 +448,80 @@ video_input_process::priv
 {
 }
 
+// ----------------------------------------------------------------
+void video_input_process::priv
+::update_timestamp( kwiver::vital::timestamp& ts )
+{
+  // Sometimes the video source can not determine either the frame
+  // number or frame time or both.
+  if ( m_video_traits.capability( kwiver::vital::algo::video_input::HAS_FRAME_NUMBERS ) )
+  {
+    m_frame_number = ts.get_frame();
+  }
+  else
+  {
+    ++m_frame_number;
+    ts.set_frame( m_frame_number );
+  }
+
+  if ( ! m_video_traits.capability( kwiver::vital::algo::video_input::HAS_FRAME_TIME ) )
+  {
+    // create an internal time standard
+    double frame_rate = m_video_reader->frame_rate();
+    if( ! m_video_traits.capability( kwiver::vital::algo::video_input::HAS_FRAME_RATE ) ||
+        frame_rate <= 0.0 || m_has_config_frame_time )
+    {
+      m_frame_time = m_frame_number * m_config_frame_time;
+    }
+    else
+    {
+      if ( frame_rate != m_frame_rate )
+      {
+        m_frame_rate = frame_rate;
+        m_frame_interval =
+          static_cast< kwiver::vital::time_usec_t >( ( 1.0 / frame_rate ) * 1e6 );
+      }
+      m_frame_time = m_frame_number * m_frame_interval;
+    }
+    ts.set_time_usec( m_frame_time );
+  }
+}
+
+// ----------------------------------------------------------------
+kwiver::vital::frame_stamp video_input_process::priv
+::make_stamp( kwiver::vital::timestamp const& ts ) const
+{
+  kwiver::vital::frame_stamp stamp( ts );
+  stamp.set_stream( m_stream_id );
+  return stamp;
+}
+
+// ----------------------------------------------------------------
+kwiver::vital::metadata_vector video_input_process::priv
+::frame_metadata()
+{
+  // If this reader/video does not have any metadata, we will just
+  // return an empty vector.  That is all handled by the algorithm
+  // implementation.
+  kwiver::vital::metadata_vector metadata = m_video_reader->frame_metadata();
+
+  // Since we want to try to always return valid metadata for this
+  // frame - if the returned metadata is empty, then use the last
+  // one we received.  The requirement is to always provide the best
+  // metadata for a frame. Since metadata appears less frequently
+  // than the frames, the metadata returned can be a little old, but
+  // it is still the best we have.
+  if ( metadata.empty() )
+  {
+    // The saved one could be empty, but it is the bewt we have.
+    metadata = m_last_metadata;
+  }
+  else
+  {
+    // Now that we have new metadata save it in case we need it later.
+    m_last_metadata = metadata;
+  }
+  return metadata;
+}
+
 } // end namespace
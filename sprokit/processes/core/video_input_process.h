@@ -17,6 +17,10 @@ namespace kwiver
  *
  * \brief Reads a video file and passes the images as output.
  *
+ * With replay_frames set, the first frames are read when the process
+ * is initialized and sent from memory, replay_loops times, so that a
+ * pipeline can be benchmarked without reading or decoding video.
+ *
  * \oports
  * \oport{image}
  *
@@ -42,6 +46,8 @@ class KWIVER_PROCESSES_NO_EXPORT video_input_process
 private:
   void make_ports();
   void make_config();
+  void replay_step();
+  void finish();
 
   class priv;
   const std::unique_ptr<priv> d;
@@ -15,10 +15,14 @@
 #include <sprokit/pipeline/process_exception.h>
 #include <sprokit/pipeline/stamp.h>
 
+#include <vital/logger/logger.h>
 #include <vital/util/string.h>
 
+#include <algorithm>
+#include <deque>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace sprokit
 {
@@ -65,6 +69,23 @@ namespace sprokit
  * each \b tag the same based on the type of the port that is first
  * connected.
  *
+ * When the status datum holds the index of an input port, as sent by a
+ * \ref distribute_process with the \c least_loaded policy, the result is
+ * taken from that port instead of the next one in turn. The results leave
+ * in the order of the status stream either way.
+ *
+ * \configs
+ *
+ * \config{timeout} The number of milliseconds to wait for the port holding
+ *                  the next result before giving up on it and sending an
+ *                  empty datum in its place. The late result is dropped
+ *                  when it arrives. Zero, the default, waits forever.
+ * \config{reorder_buffer} The number of results to take from each of the
+ *                         other ports of a tag while waiting for a slow
+ *                         one, so that the workers feeding them are not
+ *                         blocked by their full output edges. Zero, the
+ *                         default, takes results only when they are due.
+ *
  * \note
  * It is not immediately apparent how the input ports become sorted in
  * ASCII-betical order on "item" order.
@@ -118,13 +139,29 @@ class collate_process::priv
 
     ports_t ports; // list of port names
     ports_t::const_iterator cur_port;
+
+    // Results taken early from each port, in arrival order
+    std::vector< std::deque< edge_datum_t > > buffers;
+
+    // Number of results given up on for each port which have not arrived
+    std::vector< size_t > skipped;
   };
   typedef std::map<tag_t, tag_info> tag_data_t;
 
   tag_data_t tag_data; // tag table
 
+  edge::duration_t timeout;
+  size_t reorder_buffer;
+
   tag_t tag_for_coll_port(port_t const& port) const;
 
+  // Take the next datum from a port of a tag, buffering the data which
+  // arrive on its other ports meanwhile. Returns nothing on timeout.
+  kwiver::vital::optional<edge_datum_t>
+  take_from_port(collate_process const& proc, tag_info& info, size_t idx) const;
+
+  static edge::duration_t const poll_interval;
+
   static port_t const res_sep;
   static port_t const port_res_prefix;
   static port_t const port_status_prefix;
@@ -135,6 +172,8 @@ process::port_t const collate_process::priv::res_sep = port_t("/");
 process::port_t const collate_process::priv::port_res_prefix = port_t("res") + res_sep;
 process::port_t const collate_process::priv::port_status_prefix = port_t("status") + res_sep;
 process::port_t const collate_process::priv::port_coll_prefix = port_t("coll") + res_sep;
+edge::duration_t const collate_process::priv::poll_interval =
+  boost::chrono::duration_cast<edge::duration_t>(boost::chrono::milliseconds(5));
 
 /**
  * \internal
@@ -183,6 +222,21 @@ ::collate_process(kwiver::vital::config_block_sptr const& config)
 {
   // This process manages its own inputs.
   this->set_data_checking_level(check_none);
+
+  declare_configuration_key(
+    "timeout",
+    "0",
+    "The number of milliseconds to wait for the input port holding the next "
+    "result before skipping it. An empty datum is sent in place of the "
+    "skipped result, which is dropped when it arrives. "
+    "Zero waits forever.");
+
+  declare_configuration_key(
+    "reorder_buffer",
+    "0",
+    "The number of results to take ahead of time from each of the other "
+    "input ports of a tag while waiting for a slow one, so that one slow "
+    "worker does not block the others. Zero takes results only when due.");
 }
 
 collate_process
@@ -190,6 +244,25 @@ collate_process
 {
 }
 
+// ------------------------------------------------------------------
+void
+collate_process
+::_configure()
+{
+  int const timeout = config_value<int>("timeout");
+  int const reorder_buffer = config_value<int>("reorder_buffer");
+
+  if (timeout < 0 || reorder_buffer < 0)
+  {
+    std::string const reason = "The timeout and reorder_buffer must not be negative";
+    VITAL_THROW( invalid_configuration_exception, name(), reason);
+  }
+
+  d->timeout = boost::chrono::duration_cast<edge::duration_t>(
+    boost::chrono::milliseconds(timeout));
+  d->reorder_buffer = static_cast<size_t>(reorder_buffer);
+}
+
 // ------------------------------------------------------------------
 // Post connection processing
 void
@@ -222,6 +295,8 @@ ::_init()
 
     // Set iterator to start of list.
     info.cur_port = ports.begin();
+    info.buffers.assign(ports.size(), std::deque<edge_datum_t>());
+    info.skipped.assign(ports.size(), 0);
   }
 
   process::_init();
@@ -283,10 +358,24 @@ ::_step()
       // echo the input to the output port
       push_to_port(output_port, status_edat);
 
-      // Flush this set of inputs
-      for (port_t const& port : info.ports)
+      // Flush this set of inputs, dropping any late results still on
+      // their way.
+      for (size_t i = 0; i < info.ports.size(); ++i)
       {
-        (void)grab_from_port(port);
+        while (true)
+        {
+          kwiver::vital::optional<edge_datum_t> const dat =
+            d->take_from_port(*this, info, i);
+
+          if (!dat || !info.skipped[i] || dat->datum->type() >= datum::flush)
+          {
+            break;
+          }
+
+          --info.skipped[i];
+        }
+
+        info.skipped[i] = 0;
       }
 
       // If the upstream process is done, then mark this tag as done.
@@ -299,11 +388,48 @@ ::_step()
     }
     else
     {
-      // There is real data on the input ports. Grab data from the
-      // current input port and push to the output.
-      edge_datum_t const coll_dat = grab_from_port(*info.cur_port);
+      // There is real data on the input ports. Grab data from the input
+      // port named by the status, or else the current one, and push it to
+      // the output.
+      if (status_type == datum::data)
+      {
+        kwiver::vital::any const index = status_dat->get_datum<kwiver::vital::any>();
+
+        if (index.type() == typeid(size_t) &&
+            kwiver::vital::any_cast<size_t>(index) < info.ports.size())
+        {
+          info.cur_port = info.ports.begin() + kwiver::vital::any_cast<size_t>(index);
+        }
+      }
+
+      size_t const idx = info.cur_port - info.ports.begin();
 
-      push_to_port(output_port, coll_dat);
+      while (true)
+      {
+        kwiver::vital::optional<edge_datum_t> const coll_dat =
+          d->take_from_port(*this, info, idx);
+
+        if (!coll_dat)
+        {
+          LOG_WARN(logger(), "Timed out waiting for \"" << *info.cur_port
+                   << "\"; skipping its result");
+
+          ++info.skipped[idx];
+          push_to_port(output_port,
+                       edge_datum_t(datum::empty_datum(), status_edat.stamp));
+          break;
+        }
+
+        // Drop the late results of earlier skips.
+        if (info.skipped[idx] && coll_dat->datum->type() < datum::flush)
+        {
+          --info.skipped[idx];
+          continue;
+        }
+
+        push_to_port(output_port, *coll_dat);
+        break;
+      }
     }
 
     // Advance to next port in the group, and wrap at the end.
@@ -409,6 +535,8 @@ ::input_port_undefined(port_t const& port)
 collate_process::priv
 ::priv()
   : tag_data()
+  , timeout(edge::duration_t::zero())
+  , reorder_buffer(0)
 {
 }
 
@@ -457,11 +585,76 @@ ::tag_for_coll_port(port_t const& port) const
   return tag_t();
 }
 
+// ------------------------------------------------------------------
+kwiver::vital::optional<edge_datum_t>
+collate_process::priv
+::take_from_port(collate_process const& proc, tag_info& info, size_t idx) const
+{
+  std::deque<edge_datum_t>& buffer = info.buffers[idx];
+  port_t const& port = info.ports[idx];
+
+  if (!buffer.empty())
+  {
+    edge_datum_t const dat = buffer.front();
+    buffer.pop_front();
+    return dat;
+  }
+
+  bool const wait_forever = (timeout == edge::duration_t::zero());
+
+  if (wait_forever && !reorder_buffer)
+  {
+    return proc.grab_from_port(port);
+  }
+
+  edge::clock_t::time_point const deadline = edge::clock_t::now() + timeout;
+
+  while (true)
+  {
+    edge::duration_t wait = poll_interval;
+
+    if (!wait_forever)
+    {
+      edge::duration_t const remaining = deadline - edge::clock_t::now();
+      if (remaining <= edge::duration_t::zero())
+      {
+        return kwiver::vital::nullopt;
+      }
+
+      wait = std::min(wait, remaining);
+    }
+
+    kwiver::vital::optional<edge_datum_t> dat = proc.try_grab_from_port(port, wait);
+    if (dat)
+    {
+      return dat;
+    }
+
+    // Keep the other workers going while this one is slow.
+    for (size_t i = 0; i < info.ports.size(); ++i)
+    {
+      while (i != idx && info.buffers[i].size() < reorder_buffer)
+      {
+        kwiver::vital::optional<edge_datum_t> const other =
+          proc.try_grab_from_port(info.ports[i], edge::duration_t::zero());
+        if (!other)
+        {
+          break;
+        }
+
+        info.buffers[i].push_back(*other);
+      }
+    }
+  }
+}
+
 // ------------------------------------------------------------------
 collate_process::priv::tag_info
 ::tag_info()
   : ports()
   , cur_port()
+  , buffers()
+  , skipped()
 {
 }
 
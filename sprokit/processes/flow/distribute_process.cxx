@@ -51,6 +51,16 @@ namespace sprokit {
  * \req Each output port \port{status/\portvar{res}} must be connected.
  * \req Each \portvar{res} must have at least two outputs to distribute to.
  *
+ * \configs
+ *
+ * \config{policy} How a datum is assigned to an output port. With
+ *                 \c round_robin (the default), the ports are used in
+ *                 turn. With \c least_loaded, each datum goes to the port
+ *                 whose downstream edge holds the fewest data, so that a
+ *                 slow worker does not hold up the others; the status
+ *                 datum then holds the index of the chosen port, which
+ *                 the \ref collate_process uses to restore the order.
+ *
  * \code
 process distrib :: distribute
 
@@ -64,6 +74,10 @@ connect distrib.status/set1  to     bar.status
 connect distrib.dist/set1/A   to    bar.data
 connect distrib.dist/set1/B   to    bar_1.data
 
+# send work to whichever worker has the least queued
+config distrib
+  :policy least_loaded
+
  * \endcode
  *
  * \todo Add configuration to allow forcing a number of outputs for a source.
@@ -94,6 +108,11 @@ class distribute_process::priv
 
     tag_data_t tag_data;
 
+    bool least_loaded;
+
+    // Select the output port for the next datum of a tag.
+    ports_t::const_iterator next_port(distribute_process const& proc, tag_info const& info) const;
+
     // Port name break down.
     tag_t tag_for_dist_port(port_t const& port) const;
 
@@ -155,6 +174,16 @@ ::distribute_process(kwiver::vital::config_block_sptr const& config)
 {
   // This process manages its own inputs.
   set_data_checking_level(check_none);
+
+  declare_configuration_key(
+    "policy",
+    "round_robin",
+    "How data is assigned to the output ports of a tag. "
+    "Valid values are \"round_robin\" and \"least_loaded\". "
+    "With \"round_robin\", the output ports are used in turn. "
+    "With \"least_loaded\", each datum is sent to the output port whose "
+    "edge holds the fewest data, and the status datum holds the index of "
+    "that port so that a collate process can restore the original order.");
 }
 
 distribute_process
@@ -162,6 +191,28 @@ distribute_process
 {
 }
 
+// ------------------------------------------------------------------
+void
+distribute_process
+::_configure()
+{
+  std::string const policy = config_value<std::string>("policy");
+
+  if (policy == "round_robin")
+  {
+    d->least_loaded = false;
+  }
+  else if (policy == "least_loaded")
+  {
+    d->least_loaded = true;
+  }
+  else
+  {
+    std::string const reason = "Invalid option specified for policy: " + policy;
+    VITAL_THROW( invalid_configuration_exception, name(), reason);
+  }
+}
+
 // ------------------------------------------------------------------
 // Post connection processing
 void
@@ -273,10 +324,16 @@ ::_step()
     else
     {
       // There is real data on the input port. Send it to the next output port.
-      edge_datum_t const status_edat = edge_datum_t(datum::empty_datum(), src_stamp);
+      ports_t::const_iterator const port = d->next_port(*this, info);
 
-      push_to_port(status_port, status_edat);
-      push_to_port(*info.cur_port, src_edat);
+      datum_t const status_dat = (d->least_loaded
+        ? datum::new_datum<size_t>(port - info.ports.begin())
+        : datum::empty_datum());
+
+      push_to_port(status_port, edge_datum_t(status_dat, src_stamp));
+      push_to_port(*port, src_edat);
+
+      info.cur_port = port;
     }
 
     // Go to next output port in the set.
@@ -381,6 +438,7 @@ ::output_port_undefined(port_t const& port)
 distribute_process::priv
 ::priv()
   : tag_data()
+  , least_loaded(false)
 {
 }
 
@@ -389,6 +447,40 @@ distribute_process::priv
 {
 }
 
+// ------------------------------------------------------------------
+process::ports_t::const_iterator
+distribute_process::priv
+::next_port(distribute_process const& proc, tag_info const& info) const
+{
+  if (!least_loaded)
+  {
+    return info.cur_port;
+  }
+
+  // Look at the ports starting from the current one so that ties are
+  // still broken in turn.
+  ports_t::const_iterator best = info.cur_port;
+  size_t best_count = proc.count_output_port_data(*best);
+
+  ports_t::const_iterator i = best;
+  for (size_t n = 1; n < info.ports.size() && best_count; ++n)
+  {
+    if (++i == info.ports.end())
+    {
+      i = info.ports.begin();
+    }
+
+    size_t const count = proc.count_output_port_data(*i);
+    if (count < best_count)
+    {
+      best = i;
+      best_count = count;
+    }
+  }
+
+  return best;
+}
+
 // ------------------------------------------------------------------
 distribute_process::priv::tag_t
 distribute_process::priv
@@ -36,6 +36,11 @@ class PROCESSES_FLOW_NO_EXPORT distribute_process
   ~distribute_process();
 
 protected:
+  /**
+   * \brief Configure the process.
+   */
+  void _configure() override;
+
   /**
    * \brief Initialize the process.
    */
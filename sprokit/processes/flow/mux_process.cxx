@@ -297,10 +297,14 @@ ::_step()
       switch ( d->m_config_term_policy )
       {
         case priv::term_policy_t::policy_any:
-          // Flush this set of inputs
+          // Flush the other inputs of this set; the complete was the last
+          // datum on the current one, so grabbing it again would block.
           for ( port_t const& port : info.ports )
           {
-            (void) grab_from_port( port );
+            if ( port != *info.cur_port )
+            {
+              (void) grab_from_port( port );
+            }
           }
 
           // echo the input control message to the output port
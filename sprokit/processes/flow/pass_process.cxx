@@ -80,6 +80,17 @@ ::_step()
   process::_step();
 }
 
+process::properties_t
+pass_process
+::_properties() const
+{
+  properties_t consts = process::_properties();
+
+  consts.insert(property_fusable);
+
+  return consts;
+}
+
 pass_process::priv
 ::priv()
 {
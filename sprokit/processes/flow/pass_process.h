@@ -63,6 +63,11 @@ class PROCESSES_FLOW_NO_EXPORT pass_process
    */
   void _step();
 
+  /**
+   * \brief The properties on the process.
+   */
+  properties_t _properties() const override;
+
 private:
   class priv;
   std::unique_ptr< priv > d;
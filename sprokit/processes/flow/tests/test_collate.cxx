@@ -0,0 +1,129 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include <test_common.h>
+
+#include <sprokit/processes/adapters/embedded_pipeline.h>
+#include <sprokit/pipeline_util/literal_pipeline.h>
+
+#include <sstream>
+
+#define TEST_ARGS ()
+
+DECLARE_TEST_MAP();
+
+int
+main(int argc, char* argv[])
+{
+  CHECK_ARGS(1);
+
+  testname_t const testname = argv[1];
+
+  RUN_TEST(testname);
+}
+
+// ==================================================================
+// This class removes the requirement for a input adapter in the
+// pipeline.
+class src_ep
+  : public kwiver::embedded_pipeline
+{
+public:
+  src_ep() = default;
+  virtual ~src_ep() = default;
+
+protected:
+  virtual bool connect_input_adapter() { return true; }
+};
+
+// ------------------------------------------------------------------
+static void
+run_farm( std::string const& policy, std::string const& reorder_buffer )
+{
+  // Use SPROKIT macros to create pipeline description
+  std::stringstream pipeline_desc;
+  pipeline_desc
+    << SPROKIT_PROCESS( "numbers", "num" )
+    << SPROKIT_CONFIG( "start", "0" )
+    << SPROKIT_CONFIG( "end",   "100" )
+
+    << SPROKIT_PROCESS( "distribute", "dist" )
+    << SPROKIT_CONFIG( "policy", policy )
+
+    << SPROKIT_PROCESS( "pass", "worker_a" )
+    << SPROKIT_PROCESS( "pass", "worker_b" )
+    << SPROKIT_PROCESS( "pass", "worker_c" )
+
+    << SPROKIT_PROCESS( "collate", "coll" )
+    << SPROKIT_CONFIG( "reorder_buffer", reorder_buffer )
+
+    << SPROKIT_CONNECT( "dist", "status/num",  "coll", "status/num" )
+    << SPROKIT_CONNECT( "num", "number",       "dist", "src/num" )
+
+    << SPROKIT_CONNECT( "dist", "dist/num/A",  "worker_a", "pass" )
+    << SPROKIT_CONNECT( "dist", "dist/num/B",  "worker_b", "pass" )
+    << SPROKIT_CONNECT( "dist", "dist/num/C",  "worker_c", "pass" )
+
+    << SPROKIT_CONNECT( "worker_a", "pass",    "coll", "coll/num/A" )
+    << SPROKIT_CONNECT( "worker_b", "pass",    "coll", "coll/num/B" )
+    << SPROKIT_CONNECT( "worker_c", "pass",    "coll", "coll/num/C" )
+
+    << SPROKIT_PROCESS( "output_adapter", "oa" )
+
+    << SPROKIT_CONNECT( "coll", "res/num",  "oa", "num" )
+    ;
+
+  // --------------------------
+  // create embedded pipeline
+  src_ep ep;
+  ep.build_pipeline( pipeline_desc );
+
+  // Start pipeline
+  ep.start();
+
+  int expected( 0 );
+
+  while( true )
+  {
+    // Get output
+    auto ods = ep.receive(); // blocks
+
+    // check for end of data marker
+    if ( ods->is_end_of_data() )
+    {
+      TEST_EQUAL( "at_end() set correctly", ep.at_end(), true );
+      break;
+    }
+
+    // Results leave in the order the numbers were generated, whichever
+    // worker handled them
+    int val = ods->get_port_data<int>( "num" );
+
+    if ( val != expected )
+    {
+      std::stringstream str;
+      str << "Unexpected value from port num. Expected " << expected
+          << " got " << val;
+      TEST_ERROR( str.str() );
+    }
+
+    ++expected;
+  } // end while
+
+  TEST_EQUAL( "all values collated", expected, 100 );
+
+  ep.wait(); // wait for pipeline to terminate
+}
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( round_robin )
+{
+  run_farm( "round_robin", "0" );
+}
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( least_loaded )
+{
+  run_farm( "least_loaded", "4" );
+}
@@ -133,3 +133,69 @@ IMPLEMENT_TEST( test_mux )
 
   ep.wait(); // wait for pipeline to terminate
 }
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( test_mux_any )
+{
+  // Every input completes after the same number of data, so the group
+  // completes when the first one does.
+  std::stringstream pipeline_desc;
+  pipeline_desc
+    << SPROKIT_PROCESS( "numbers", "num_1" )
+    << SPROKIT_CONFIG( "start", "0" )
+    << SPROKIT_CONFIG( "end",   "20" )
+
+    << SPROKIT_PROCESS( "numbers", "num_2" )
+    << SPROKIT_CONFIG( "start", "100" )
+    << SPROKIT_CONFIG( "end",   "120" )
+
+    << SPROKIT_PROCESS( "numbers", "num_3" )
+    << SPROKIT_CONFIG( "start", "200" )
+    << SPROKIT_CONFIG( "end",   "220" )
+
+    << SPROKIT_PROCESS( "multiplexer",  "mux" )
+    << SPROKIT_CONFIG( "termination_policy",   "any" )
+
+    << SPROKIT_CONNECT( "num_1", "number",     "mux", "num/1" )
+    << SPROKIT_CONNECT( "num_2", "number",     "mux", "num/2" )
+    << SPROKIT_CONNECT( "num_3", "number",     "mux", "num/3" )
+
+    << SPROKIT_PROCESS( "output_adapter", "oa" )
+
+    << SPROKIT_CONNECT( "mux", "num",  "oa", "num" )
+    ;
+
+  src_ep ep;
+  ep.build_pipeline( pipeline_desc );
+  ep.start();
+
+  int idx(0);
+
+  while( true )
+  {
+    auto ods = ep.receive(); // blocks
+
+    if ( ods->is_end_of_data() )
+    {
+      TEST_EQUAL( "at_end() set correctly", ep.at_end(), true );
+      break;
+    }
+
+    int const expected = 100 * ( idx % 3 ) + idx / 3;
+    int const val = ods->value<int>( "num" );
+
+    if ( val != expected )
+    {
+      std::stringstream str;
+      str << "Unexpected value from port num. Expected " << expected
+          << " got " << val;
+      TEST_ERROR( str.str() );
+    }
+
+    ++idx;
+  } // end while
+
+  TEST_EQUAL( "all data received", idx, 60 );
+
+  ep.wait(); // wait for pipeline to terminate
+}
@@ -11,6 +11,7 @@
 #define KWIVER_VITAL_TYPE_TRAITS_H
 
 #include <vital/vital_types.h>
+#include <vital/algo/data_serializer.h>
 
 #include <vital/types/database_query.h>
 #include <vital/types/descriptor_set.h>
@@ -18,6 +19,7 @@
 #include <vital/types/detected_object_set.h>
 #include <vital/types/feature_set.h>
 #include <vital/types/feature_track_set.h>
+#include <vital/types/frame_stamp.h>
 #include <vital/types/homography_f2f.h>
 #include <vital/types/geo_polygon.h>
 #include <vital/types/image_container.h>
@@ -45,6 +47,7 @@ namespace vital {
   typedef std::vector< std::string > string_vector;
   typedef std::shared_ptr< string_vector > string_vector_sptr;
   using string_sptr =  std::shared_ptr< std::string >;
+  using message_parts_sptr = std::shared_ptr< algo::message_parts const >;
 
 } }
 
@@ -56,6 +59,7 @@ namespace vital {
 //
 create_type_trait( bounding_box, "kwiver:bounding_box", kwiver::vital::bounding_box_d );
 create_type_trait( timestamp, "kwiver:timestamp", kwiver::vital::timestamp );
+create_type_trait( frame_stamp, "kwiver:frame_stamp", kwiver::vital::frame_stamp );
 create_type_trait( gsd, "kwiver:gsd", double );
 create_type_trait( corner_points, "kwiver:corner_points", kwiver::vital::geo_polygon );
 create_type_trait( image, "kwiver:image", kwiver::vital::image_container_sptr );
@@ -87,6 +91,7 @@ create_type_trait( frame_rate, "kwiver:frame_rate", double );
 create_type_trait( kwiver_logical, "kwiver:logical", bool );
 
 create_type_trait( serialized_message, "kwiver:serialized_message", kwiver::vital::string_sptr );
+create_type_trait( serialized_message_parts, "kwiver:serialized_message_parts", kwiver::vital::message_parts_sptr );
 
 // ==================================================================================
 //
@@ -95,6 +100,7 @@ create_type_trait( serialized_message, "kwiver:serialized_message", kwiver::vita
 //
 create_port_trait( bounding_box, bounding_box, "Bounding box" );
 create_port_trait( timestamp, timestamp, "Timestamp for input image." );
+create_port_trait( frame_stamp, frame_stamp, "Frame number, time and stream of input image." );
 create_port_trait( corner_points, corner_points, "Four corner points for image in lat/lon units, ordering ul ur lr ll." );
 create_port_trait( gsd, gsd, "GSD for image in meters per pixel." );
 create_port_trait( image, image, "Single frame image." );
@@ -112,6 +118,7 @@ create_port_trait( string_vector, string_vector, "Vector of strings." );
 create_port_trait( track_set, track_set, "Set of arbitrary tracks." );
 create_port_trait( feature_track_set, feature_track_set, "Set of feature tracks." );
 create_port_trait( object_track_set, object_track_set, "Set of object tracks." );
+create_port_trait( new_track_states, object_track_set, "Object tracks holding only the states added on this frame." );
 create_port_trait( detected_object_set, detected_object_set, "Set of detected objects." );
 create_port_trait( track_descriptor_set, track_descriptor_set, "Set of track descriptors." );
 create_port_trait( matrix_d, matrix_d, "2-dimensional double matrix." );
@@ -125,6 +132,7 @@ create_port_trait( video_uid, video_uid, "Video UID value." );
 create_port_trait( frame_rate, frame_rate, "Video frame rate." );
 
 create_port_trait( serialized_message, serialized_message, "serialized data type" );
+create_port_trait( serialized_message_parts, serialized_message_parts, "serialized data as a sequence of parts" );
 
 create_port_trait( coordinate_system_updated, kwiver_logical, "Set to true if new reference frame is established." );
 create_port_trait( motion_heat_map, image, "Motion heat map." );
@@ -438,6 +438,22 @@ grab_from_port_as< PN ## _port_trait::type > ( PN ## _port_trait::port_name )
   try_grab_from_port_as< PN ## _port_trait::type >( \
     PN ## _port_trait::port_name )
 
+/**
+ * \brief Get input from port using port trait name, moving it if possible.
+ *
+ * This behaves like #grab_from_port_using_trait, except that the value
+ * is moved out of the datum instead of copied when no other process
+ * shares it.
+ *
+ * \sa grab_from_port_using_trait, sprokit::process::grab_datum_moved_as()
+ *
+ * \param PN Port trait name.
+ *
+ * \return Data value from port.
+ */
+#define grab_moved_from_port_using_trait(PN)                            \
+grab_datum_moved_as< PN ## _port_trait::type > ( PN ## _port_trait::port_name )
+
 /**
  * \brief Get input from port using port trait name.
  *
@@ -0,0 +1,161 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/**
+ * \file
+ * \brief Records of serialized messages written to a file
+ *
+ * A record file starts with, in little-endian order:
+ *
+ *   4 bytes   magic "\0KWR"
+ *   4 bytes   version and reserved bytes
+ *   8 bytes   reserved
+ *
+ * followed by records made of a header:
+ *
+ *   8 bytes   message size
+ *   8 bytes   frame number
+ *   8 bytes   time in microseconds
+ *   4 bytes   flags: 1 if the frame is valid, 2 if the time is valid
+ *   4 bytes   reserved
+ *
+ * and of the bytes of the message.
+ */
+
+#ifndef KWIVER_TRANSPORT_FILE_TRANSPORT_FORMAT_H
+#define KWIVER_TRANSPORT_FILE_TRANSPORT_FORMAT_H
+
+#include <vital/types/timestamp.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace kwiver {
+
+/// Location and timestamp of a message within a record file
+struct file_transport_record
+{
+  uint64_t offset = 0;
+  uint64_t size = 0;
+  kwiver::vital::timestamp ts;
+};
+
+namespace file_transport_format {
+
+char const magic[ 4 ] = { '\0', 'K', 'W', 'R' };
+uint8_t const version = 1;
+size_t const header_size = 16;
+size_t const record_header_size = 32;
+
+uint32_t const flag_frame = 1;
+uint32_t const flag_time = 2;
+
+// ----------------------------------------------------------------------------
+inline void
+put( std::string& out, uint64_t value, size_t bytes )
+{
+  for ( size_t i = 0; i < bytes; ++i )
+  {
+    out.push_back( static_cast< char >( ( value >> ( 8 * i ) ) & 0xff ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+inline uint64_t
+get( char const* data, size_t bytes )
+{
+  uint64_t value = 0;
+  for ( size_t i = 0; i < bytes; ++i )
+  {
+    value |= static_cast< uint64_t >(
+      static_cast< unsigned char >( data[ i ] ) ) << ( 8 * i );
+  }
+  return value;
+}
+
+} // end namespace file_transport_format
+
+// ----------------------------------------------------------------------------
+/// Write the header of a record file
+inline std::string
+write_file_transport_header()
+{
+  namespace ff = file_transport_format;
+
+  std::string out( ff::magic, sizeof( ff::magic ) );
+  ff::put( out, ff::version, 4 );
+  ff::put( out, 0, 8 );
+  return out;
+}
+
+// ----------------------------------------------------------------------------
+/// Write the header of a record holding \p size bytes
+inline std::string
+write_file_transport_record( uint64_t size, kwiver::vital::timestamp const& ts )
+{
+  namespace ff = file_transport_format;
+
+  uint32_t flags = 0;
+  flags |= ( ts.has_valid_frame() ? ff::flag_frame : 0 );
+  flags |= ( ts.has_valid_time() ? ff::flag_time : 0 );
+
+  std::string out;
+  out.reserve( ff::record_header_size );
+  ff::put( out, size, 8 );
+  ff::put( out, static_cast< uint64_t >(
+             ts.has_valid_frame() ? ts.get_frame() : 0 ), 8 );
+  ff::put( out, static_cast< uint64_t >(
+             ts.has_valid_time() ? ts.get_time_usec() : 0 ), 8 );
+  ff::put( out, flags, 4 );
+  ff::put( out, 0, 4 );
+  return out;
+}
+
+// ----------------------------------------------------------------------------
+/// Test whether a file starts with the header of a record file
+inline bool
+is_file_transport_file( char const* data, size_t size )
+{
+  namespace ff = file_transport_format;
+  return size >= ff::header_size &&
+         std::memcmp( data, ff::magic, sizeof( ff::magic ) ) == 0 &&
+         static_cast< uint8_t >( data[ 4 ] ) == ff::version;
+}
+
+// ----------------------------------------------------------------------------
+/// Read the record at \p offset of a record file
+///
+/// \returns false if the file ends before the end of the record.
+inline bool
+read_file_transport_record( char const* data, size_t size, uint64_t offset,
+                            file_transport_record& record )
+{
+  namespace ff = file_transport_format;
+
+  if ( offset > size || size - offset < ff::record_header_size )
+  {
+    return false;
+  }
+
+  auto const p = data + offset;
+  auto const flags = ff::get( p + 24, 4 );
+
+  record.offset = offset + ff::record_header_size;
+  record.size = ff::get( p, 8 );
+  record.ts = kwiver::vital::timestamp();
+  if ( flags & ff::flag_frame )
+  {
+    record.ts.set_frame( static_cast< int64_t >( ff::get( p + 8, 8 ) ) );
+  }
+  if ( flags & ff::flag_time )
+  {
+    record.ts.set_time_usec( static_cast< int64_t >( ff::get( p + 16, 8 ) ) );
+  }
+  return record.size <= size - record.offset;
+}
+
+} // end namespace kwiver
+
+#endif // KWIVER_TRANSPORT_FILE_TRANSPORT_FORMAT_H
@@ -0,0 +1,277 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "file_transport_receive_process.h"
+#include "file_transport_format.h"
+
+#include <sprokit/pipeline/datum.h>
+#include <sprokit/pipeline/process_exception.h>
+
+#include <vital/util/mapped_file.h>
+
+#include <kwiver_type_traits.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace kwiver {
+
+// (config-key, value-type, default-value, description )
+create_config_trait( file_name, std::string, "serialized_data.dat",
+                     "Name of the file of records written by "
+                     "file_transport_send." );
+create_config_trait( rate, double, "0",
+                     "Speed of the replay relative to the times of the "
+                     "recorded timestamps; 1 replays in real time. Messages "
+                     "are replayed as fast as possible if zero." );
+create_config_trait( start_frame, vital::frame_id_t, "-1",
+                     "Replay from the first message of at least this frame "
+                     "if not negative." );
+create_config_trait( end_frame, vital::frame_id_t, "-1",
+                     "Stop replaying before the first message after this "
+                     "frame if not negative." );
+
+//----------------------------------------------------------------
+// Private implementation class
+class file_transport_receive_process::priv
+{
+public:
+  priv();
+  ~priv();
+
+  // Index the records of the mapped file
+  void index( kwiver::vital::logger_handle_t const& logger );
+
+  // Find the first record to replay
+  size_t seek() const;
+
+  // Wait until a record is due
+  void pace( kwiver::vital::timestamp const& ts );
+
+  // Configuration values
+  std::string m_file_name;
+  double m_rate;
+  vital::frame_id_t m_start_frame;
+  vital::frame_id_t m_end_frame;
+
+  kwiver::vital::mapped_file m_file;
+  std::vector< file_transport_record > m_records;
+
+  // Frames of the records are all valid and ascending
+  bool m_sorted;
+
+  size_t m_next;
+
+  // Pacing of the replay
+  bool m_paced;
+  vital::time_usec_t m_first_time;
+  std::chrono::steady_clock::time_point m_start;
+
+}; // end priv class
+
+// ================================================================
+
+file_transport_receive_process
+::file_transport_receive_process( kwiver::vital::config_block_sptr const& config )
+  : process( config ),
+    d( new file_transport_receive_process::priv )
+{
+  make_ports();
+  make_config();
+}
+
+file_transport_receive_process
+::~file_transport_receive_process()
+{
+}
+
+// ----------------------------------------------------------------
+void file_transport_receive_process
+::_configure()
+{
+  scoped_configure_instrumentation();
+
+  // Get process config entries
+  d->m_file_name = config_value_using_trait( file_name );
+  d->m_rate = config_value_using_trait( rate );
+  d->m_start_frame = config_value_using_trait( start_frame );
+  d->m_end_frame = config_value_using_trait( end_frame );
+
+  if ( d->m_rate < 0 )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "Replay rate must not be negative." );
+  }
+
+  if ( ! d->m_file.open( d->m_file_name ) )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "Unable to open input file." );
+  }
+  if ( ! is_file_transport_file( d->m_file.data(), d->m_file.size() ) )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "Input file was not written as records by "
+                 "file_transport_send." );
+  }
+
+  d->index( logger() );
+  d->m_next = d->seek();
+}
+
+// ----------------------------------------------------------------
+void file_transport_receive_process
+::_step()
+{
+  auto const done = d->m_next >= d->m_records.size() ||
+    ( d->m_end_frame >= 0 &&
+      d->m_records[ d->m_next ].ts.has_valid_frame() &&
+      d->m_records[ d->m_next ].ts.get_frame() > d->m_end_frame );
+  if ( done )
+  {
+    mark_process_as_complete();
+    auto const dat = sprokit::datum::complete_datum();
+
+    push_datum_to_port_using_trait( serialized_message, dat );
+    push_datum_to_port_using_trait( timestamp, dat );
+    return;
+  }
+
+  auto const& record = d->m_records[ d->m_next++ ];
+  d->pace( record.ts );
+
+  scoped_step_instrumentation();
+
+  auto const message = std::make_shared< std::string >(
+    d->m_file.data() + record.offset, record.size );
+
+  push_to_port_using_trait( serialized_message, message );
+  push_to_port_using_trait( timestamp, record.ts );
+}
+
+// ----------------------------------------------------------------
+void file_transport_receive_process
+::make_ports()
+{
+  // Set up for required ports
+  sprokit::process::port_flags_t optional;
+
+  declare_output_port_using_trait( serialized_message, optional );
+  declare_output_port_using_trait( timestamp, optional );
+}
+
+// ----------------------------------------------------------------
+void file_transport_receive_process
+::make_config()
+{
+  declare_config_using_trait( file_name );
+  declare_config_using_trait( rate );
+  declare_config_using_trait( start_frame );
+  declare_config_using_trait( end_frame );
+}
+
+// ================================================================
+file_transport_receive_process::priv
+::priv()
+  : m_file_name( "serialized_data.dat" )
+  , m_rate( 0 )
+  , m_start_frame( -1 )
+  , m_end_frame( -1 )
+  , m_sorted( true )
+  , m_next( 0 )
+  , m_paced( false )
+  , m_first_time( 0 )
+{
+}
+
+file_transport_receive_process::priv
+::~priv()
+{
+}
+
+// ----------------------------------------------------------------
+void
+file_transport_receive_process::priv
+::index( kwiver::vital::logger_handle_t const& logger )
+{
+  auto const data = m_file.data();
+  auto const size = m_file.size();
+
+  m_records.clear();
+  m_sorted = true;
+
+  uint64_t offset = file_transport_format::header_size;
+  file_transport_record record;
+  while ( offset < size )
+  {
+    if ( ! read_file_transport_record( data, size, offset, record ) )
+    {
+      LOG_WARN( logger, "Ignoring the truncated record at offset "
+                << offset << " of \"" << m_file_name << "\"." );
+      break;
+    }
+
+    m_sorted = m_sorted && record.ts.has_valid_frame() &&
+      ( m_records.empty() ||
+        m_records.back().ts.get_frame() <= record.ts.get_frame() );
+    m_records.push_back( record );
+    offset = record.offset + record.size;
+  }
+}
+
+// ----------------------------------------------------------------
+size_t
+file_transport_receive_process::priv
+::seek() const
+{
+  if ( m_start_frame < 0 )
+  {
+    return 0;
+  }
+
+  auto const before_start = [ this ]( file_transport_record const& r )
+  {
+    return ! r.ts.has_valid_frame() || r.ts.get_frame() < m_start_frame;
+  };
+
+  // Recordings are usually in frame order, which allows a binary search
+  if ( m_sorted )
+  {
+    return static_cast< size_t >(
+      std::partition_point( m_records.begin(), m_records.end(),
+                            before_start ) - m_records.begin() );
+  }
+  return static_cast< size_t >(
+    std::find_if_not( m_records.begin(), m_records.end(),
+                      before_start ) - m_records.begin() );
+}
+
+// ----------------------------------------------------------------
+void
+file_transport_receive_process::priv
+::pace( kwiver::vital::timestamp const& ts )
+{
+  if ( m_rate <= 0 || ! ts.has_valid_time() )
+  {
+    return;
+  }
+
+  // Times are measured from the first paced message
+  if ( ! m_paced )
+  {
+    m_paced = true;
+    m_first_time = ts.get_time_usec();
+    m_start = std::chrono::steady_clock::now();
+    return;
+  }
+
+  auto const elapsed = static_cast< double >( ts.get_time_usec() - m_first_time );
+  auto const due = m_start + std::chrono::microseconds(
+    static_cast< int64_t >( elapsed / m_rate ) );
+  std::this_thread::sleep_until( due );
+}
+
+} // end namespace
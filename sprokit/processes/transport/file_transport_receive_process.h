@@ -0,0 +1,69 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_TRANSPORT_FILE_TRANSPORT_RECEIVE_PROCESS_H
+#define KWIVER_TRANSPORT_FILE_TRANSPORT_RECEIVE_PROCESS_H
+
+#include <sprokit/pipeline/process.h>
+
+#include "kwiver_processes_transport_export.h"
+
+namespace kwiver {
+
+// ----------------------------------------------------------------
+/**
+ * \class file_transport_receive_process
+ *
+ * \brief Replays serialized data recorded by file_transport_send.
+ *
+ * The file must have been written with the records option of
+ * file_transport_send. It is mapped into memory and indexed when the
+ * process is configured, so that replay reads nothing but the messages
+ * themselves. Messages are output as fast as possible, or paced by the
+ * times of their timestamps, and replay can start and end at given
+ * frames.
+ *
+ * \oports
+ *
+ * \oport{serialized_message} the recorded byte string.
+ *
+ * \oport{timestamp} the timestamp recorded with it, or an invalid
+ * timestamp.
+ *
+ * \configs
+ *
+ * \config{file_name} name of the file to replay.
+ *
+ * \config{rate} speed of the replay relative to the recorded times, or
+ * zero to replay as fast as possible.
+ *
+ * \config{start_frame} first frame to replay, if not negative.
+ *
+ * \config{end_frame} last frame to replay, if not negative.
+ */
+class KWIVER_PROCESSES_TRANSPORT_NO_EXPORT file_transport_receive_process
+  : public sprokit::process
+{
+public:
+  PLUGIN_INFO( "file_transport_receive",
+               "Replays serialized buffers recorded by file_transport_send." )
+
+  file_transport_receive_process( kwiver::vital::config_block_sptr const& config );
+  virtual ~file_transport_receive_process();
+
+protected:
+  virtual void _configure();
+  virtual void _step();
+
+private:
+  void make_ports();
+  void make_config();
+
+  class priv;
+  const std::unique_ptr<priv> d;
+}; // end class file_transport_receive_process
+
+}  // end namespace
+
+#endif // KWIVER_TRANSPORT_FILE_TRANSPORT_RECEIVE_PROCESS_H
@@ -3,7 +3,9 @@
 // https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
 
 #include "file_transport_send_process.h"
+#include "file_transport_format.h"
 
+#include <sprokit/pipeline/datum.h>
 #include <sprokit/pipeline/process_exception.h>
 
 #include <kwiver_type_traits.h>
@@ -15,6 +17,10 @@ namespace kwiver {
 // (config-key, value-type, default-value, description )
 create_config_trait( file_name, std::string, "serialized_data.dat",
                      "Name of file where serialized messages are written. ");
+create_config_trait( records, bool, "false",
+                     "Write each message as a record holding its size and "
+                     "timestamp, which file_transport_receive can replay. "
+                     "Otherwise messages are written back to back." );
 
 //----------------------------------------------------------------
 // Private implementation class
@@ -27,8 +33,16 @@ class file_transport_send_process::priv
   // Configuration values
   std::string m_file_name;
 
+  bool m_records;
+
   std::ofstream m_output_file;
 
+  // Messages arrive as parts instead of byte strings
+  bool m_parts;
+
+  // Timestamps of the messages are connected
+  bool m_timestamp;
+
 }; // end priv class
 
 // ================================================================
@@ -55,23 +69,90 @@ ::_configure()
 
   // Get process config entries
   d->m_file_name = config_value_using_trait( file_name );
+  d->m_records = config_value_using_trait( records );
 
-  d->m_output_file.open( d->m_file_name );
+  d->m_output_file.open( d->m_file_name, std::ios::binary );
   if ( ! d->m_output_file )
   {
     VITAL_THROW( sprokit::invalid_configuration_exception, name(),
                      "Unable to open output file." );
   }
+
+  if ( d->m_records )
+  {
+    d->m_output_file << write_file_transport_header();
+  }
+}
+
+// ----------------------------------------------------------------
+void file_transport_send_process
+::_init()
+{
+  d->m_parts = has_input_port_edge_using_trait( serialized_message_parts );
+  if ( d->m_parts == has_input_port_edge_using_trait( serialized_message ) )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "Exactly one of the serialized_message and "
+                 "serialized_message_parts ports must be connected." );
+  }
+  d->m_timestamp = has_input_port_edge_using_trait( timestamp );
 }
 
 // ----------------------------------------------------------------
 void file_transport_send_process
 ::_step()
 {
+  // The input ports are optional, so the end of their data is handled here
+  auto const& port = d->m_parts
+    ? serialized_message_parts_port_trait::port_name
+    : serialized_message_port_trait::port_name;
+  if ( peek_at_port( port ).datum->type() == sprokit::datum::complete )
+  {
+    grab_from_port( port );
+    if ( d->m_timestamp )
+    {
+      grab_from_port( timestamp_port_trait::port_name );
+    }
+    d->m_output_file.close();
+    mark_process_as_complete();
+    return;
+  }
+
+  kwiver::vital::timestamp ts;
+  if ( d->m_timestamp )
+  {
+    ts = grab_from_port_using_trait( timestamp );
+  }
+
+  if ( d->m_parts )
+  {
+    auto parts = grab_from_port_using_trait( serialized_message_parts );
+
+    scoped_step_instrumentation();
+
+    if ( d->m_records )
+    {
+      d->m_output_file << write_file_transport_record(
+        kwiver::vital::algo::message_size( *parts ), ts );
+    }
+
+    // Write the parts in turn, without joining them first
+    for ( auto const& part : *parts )
+    {
+      d->m_output_file.write( part.data, part.size );
+    }
+    return;
+  }
+
   auto mess = grab_from_port_using_trait( serialized_message );
 
   scoped_step_instrumentation();
 
+  if ( d->m_records )
+  {
+    d->m_output_file << write_file_transport_record( mess->size(), ts );
+  }
+
   // We know that the message is a pointer to a std::string
   d->m_output_file << *mess;
 }
@@ -80,11 +161,12 @@ ::_step()
 void file_transport_send_process
 ::make_ports()
 {
-  // Set up for required ports
-  sprokit::process::port_flags_t required;
-  required.insert( flag_required );
+  // Messages are read from whichever port is connected
+  sprokit::process::port_flags_t optional;
 
-  declare_input_port_using_trait( serialized_message, required );
+  declare_input_port_using_trait( serialized_message, optional );
+  declare_input_port_using_trait( serialized_message_parts, optional );
+  declare_input_port_using_trait( timestamp, optional );
 }
 
 // ----------------------------------------------------------------
@@ -92,12 +174,16 @@ void file_transport_send_process
 ::make_config()
 {
   declare_config_using_trait( file_name );
+  declare_config_using_trait( records );
 }
 
 // ================================================================
 file_transport_send_process::priv
 ::priv()
   : m_file_name( "transport_file.dat" )
+  , m_records( false )
+  , m_parts( false )
+  , m_timestamp( false )
 {
 }
 
@@ -17,8 +17,21 @@ namespace kwiver {
  *
  * \brief Writes serialized data to a file.
  *
+ * \iports
  *
- * \oport{message}
+ * \iport{serialized_message} the byte string to write.
+ *
+ * \iport{serialized_message_parts} the parts of a message to write, in
+ * order, instead of a single byte string.
+ *
+ * \iport{timestamp} the timestamp of the message, kept in records.
+ *
+ * \configs
+ *
+ * \config{file_name} name of the file to write.
+ *
+ * \config{records} write messages as records which
+ * file_transport_receive can replay.
  */
 class KWIVER_PROCESSES_TRANSPORT_NO_EXPORT file_transport_send_process
   : public sprokit::process
@@ -32,6 +45,7 @@ class KWIVER_PROCESSES_TRANSPORT_NO_EXPORT file_transport_send_process
 
 protected:
   virtual void _configure();
+  virtual void _init();
   virtual void _step();
 
 private:
@@ -8,6 +8,7 @@
 #include <vital/plugin_loader/plugin_loader.h>
 
 // -- list processes to register --
+#include "file_transport_receive_process.h"
 #include "file_transport_send_process.h"
 
 #if WITH_ZMQ
@@ -15,6 +16,11 @@
 #include "zmq_transport_receive_process.h"
 #endif
 
+#if WITH_SHM
+#include "shm_transport_send_process.h"
+#include "shm_transport_receive_process.h"
+#endif
+
 // ---------------------------------------------------------------------------------------
 /** \brief Regsiter processes
  *
@@ -35,12 +41,20 @@ register_factories( kwiver::vital::plugin_loader& vpm )
   }
 
   reg.register_process< kwiver::file_transport_send_process >();
+  reg.register_process< kwiver::file_transport_receive_process >();
 
 #if WITH_ZMQ
 
   reg.register_process< kwiver::zmq_transport_send_process >();
   reg.register_process< kwiver::zmq_transport_receive_process >();
 
+#endif
+
+#if WITH_SHM
+
+  reg.register_process< kwiver::shm_transport_send_process >();
+  reg.register_process< kwiver::shm_transport_receive_process >();
+
 #endif
 
  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -0,0 +1,200 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "shm_transport_receive_process.h"
+#include "shm_transport_ring.h"
+
+#include <sprokit/pipeline/datum.h>
+#include <sprokit/pipeline/process_exception.h>
+
+#include <vital/types/image_container.h>
+
+#include <kwiver_type_traits.h>
+
+#include <stdexcept>
+
+namespace kwiver {
+
+// (config-key, value-type, default-value, description )
+create_config_trait( shm_name, std::string, "kwiver_frames",
+                     "Name of the shared memory segment, which must be the "
+                     "same for the sender and the receiver." );
+create_config_trait( open_timeout, double, "0",
+                     "Seconds to wait for the sender to create the shared "
+                     "memory segment. Wait for as long as it takes if zero." );
+
+namespace {
+
+// ----------------------------------------------------------------
+// Image memory of a slot, which goes back to the sender when released
+class slot_image_memory : public vital::image_memory
+{
+public:
+  slot_image_memory( std::shared_ptr< shm_transport_ring > const& ring,
+                     size_t index )
+    : m_ring( ring ), m_index( index )
+  {
+    size_ = ring->slot( index ).image_size;
+  }
+
+  virtual ~slot_image_memory()
+  {
+    m_ring->release( m_index );
+  }
+
+  virtual void* data() { return m_ring->slot_data( m_index ); }
+
+private:
+  std::shared_ptr< shm_transport_ring > m_ring;
+  size_t m_index;
+};
+
+} // end namespace
+
+//----------------------------------------------------------------
+// Private implementation class
+class shm_transport_receive_process::priv
+{
+public:
+  priv();
+  ~priv();
+
+  // Configuration values
+  std::string m_shm_name;
+  double m_open_timeout;
+
+  std::shared_ptr< shm_transport_ring > m_ring;
+
+}; // end priv class
+
+// ================================================================
+
+shm_transport_receive_process
+::shm_transport_receive_process( kwiver::vital::config_block_sptr const& config )
+  : process( config ),
+    d( new shm_transport_receive_process::priv )
+{
+  make_ports();
+  make_config();
+}
+
+shm_transport_receive_process
+::~shm_transport_receive_process()
+{
+}
+
+// ----------------------------------------------------------------
+void shm_transport_receive_process
+::_configure()
+{
+  scoped_configure_instrumentation();
+
+  // Get process config entries
+  d->m_shm_name = config_value_using_trait( shm_name );
+  d->m_open_timeout = config_value_using_trait( open_timeout );
+
+  try
+  {
+    d->m_ring = shm_transport_ring::open( d->m_shm_name, d->m_open_timeout );
+  }
+  catch ( std::exception const& e )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(), e.what() );
+  }
+}
+
+// ----------------------------------------------------------------
+void shm_transport_receive_process
+::_step()
+{
+  auto const index = d->m_ring->next();
+  auto const& slot = d->m_ring->slot( index );
+
+  if ( slot.flags & shm_transport_slot::end_of_data )
+  {
+    d->m_ring->release( index );
+
+    mark_process_as_complete();
+    auto const dat = sprokit::datum::complete_datum();
+
+    push_datum_to_port_using_trait( image, dat );
+    push_datum_to_port_using_trait( timestamp, dat );
+    push_datum_to_port_using_trait( serialized_message, dat );
+    return;
+  }
+
+  scoped_step_instrumentation();
+
+  vital::timestamp ts;
+  if ( slot.flags & shm_transport_slot::has_frame )
+  {
+    ts.set_frame( slot.frame );
+  }
+  if ( slot.flags & shm_transport_slot::has_time )
+  {
+    ts.set_time_usec( slot.time );
+  }
+
+  auto const data = static_cast< char const* >( d->m_ring->slot_data( index ) );
+  auto const message = std::make_shared< std::string >(
+    data + slot.message_offset, slot.message_size );
+
+  // The image is a view of the slot, which is released with it; without an
+  // image, the slot is done with now
+  vital::image_container_sptr image;
+  if ( slot.flags & shm_transport_slot::has_image )
+  {
+    auto const memory =
+      std::make_shared< slot_image_memory >( d->m_ring, index );
+    vital::image_pixel_traits const traits(
+      static_cast< vital::image_pixel_traits::pixel_type >( slot.pixel_type ),
+      slot.pixel_bytes );
+    image = std::make_shared< vital::simple_image_container >(
+      vital::image( memory, memory->data(),
+                    slot.width, slot.height, slot.depth,
+                    slot.w_step, slot.h_step, slot.d_step, traits ) );
+  }
+  else
+  {
+    d->m_ring->release( index );
+  }
+
+  push_to_port_using_trait( image, image );
+  push_to_port_using_trait( timestamp, ts );
+  push_to_port_using_trait( serialized_message, message );
+}
+
+// ----------------------------------------------------------------
+void shm_transport_receive_process
+::make_ports()
+{
+  // Set up for required ports
+  sprokit::process::port_flags_t optional;
+
+  declare_output_port_using_trait( image, optional );
+  declare_output_port_using_trait( timestamp, optional );
+  declare_output_port_using_trait( serialized_message, optional );
+}
+
+// ----------------------------------------------------------------
+void shm_transport_receive_process
+::make_config()
+{
+  declare_config_using_trait( shm_name );
+  declare_config_using_trait( open_timeout );
+}
+
+// ================================================================
+shm_transport_receive_process::priv
+::priv()
+  : m_open_timeout( 0 )
+{
+}
+
+shm_transport_receive_process::priv
+::~priv()
+{
+}
+
+} // end namespace
@@ -0,0 +1,65 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_TRANSPORT_SHM_TRANSPORT_RECEIVE_PROCESS_H
+#define KWIVER_TRANSPORT_SHM_TRANSPORT_RECEIVE_PROCESS_H
+
+#include <sprokit/pipeline/process.h>
+
+#include "kwiver_processes_transport_export.h"
+
+namespace kwiver {
+
+// ----------------------------------------------------------------
+/**
+ * \class shm_transport_receive_process
+ *
+ * \brief Receives frames from shm_transport_send in another process on the
+ * same host.
+ *
+ * The process opens the shared memory segment of the sender, waiting for
+ * it to be created. Images are output as views of their slot, without
+ * copying them; the slot goes back to the sender once the last copy of
+ * the image is released. The process completes when the sender does.
+ *
+ * \oports
+ *
+ * \oport{image} the image sent, or null if the sender had no image.
+ *
+ * \oport{timestamp} the timestamp sent, or an invalid timestamp.
+ *
+ * \oport{serialized_message} the byte string sent, or an empty string.
+ *
+ * \configs
+ *
+ * \config{shm_name} name of the shared memory segment.
+ *
+ * \config{open_timeout} seconds to wait for the sender.
+ */
+class KWIVER_PROCESSES_TRANSPORT_NO_EXPORT shm_transport_receive_process
+  : public sprokit::process
+{
+public:
+  PLUGIN_INFO( "shm_transport_receive",
+               "Receives images and serialized messages from another "
+               "process on the same host through shared memory." )
+
+  shm_transport_receive_process( kwiver::vital::config_block_sptr const& config );
+  virtual ~shm_transport_receive_process();
+
+protected:
+  virtual void _configure();
+  virtual void _step();
+
+private:
+  void make_ports();
+  void make_config();
+
+  class priv;
+  const std::unique_ptr<priv> d;
+}; // end class shm_transport_receive_process
+
+}  // end namespace
+
+#endif // KWIVER_TRANSPORT_SHM_TRANSPORT_RECEIVE_PROCESS_H
@@ -0,0 +1,473 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "shm_transport_ring.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace kwiver {
+
+namespace {
+
+// Written last by the sender once the segment is ready for use
+uint32_t const ring_magic = 0x4b575352; // "KWSR"
+uint32_t const ring_version = 1;
+
+enum slot_state : uint32_t
+{
+  slot_free = 0,
+  slot_writing,
+  slot_published,
+  slot_reading,
+};
+
+// ----------------------------------------------------------------
+// Control block at the start of the segment. It is followed by the queue of
+// published slots, the slot descriptions and, from data_offset, the slots.
+struct ring_control
+{
+  std::atomic< uint32_t > magic;
+  uint32_t version;
+
+  uint64_t slot_count;
+  uint64_t slot_size;
+  uint64_t slot_stride;
+  uint64_t data_offset;
+  uint64_t total_size;
+
+  int64_t sender_pid;
+  int64_t receiver_pid;
+
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+
+  // Positions of the sender and the receiver in the queue
+  uint64_t head;
+  uint64_t tail;
+};
+
+// ----------------------------------------------------------------
+size_t
+round_up( size_t n, size_t alignment )
+{
+  return ( n + alignment - 1 ) / alignment * alignment;
+}
+
+// ----------------------------------------------------------------
+std::string
+segment_name( std::string const& name )
+{
+  return ( !name.empty() && name[ 0 ] == '/' ) ? name : "/" + name;
+}
+
+// ----------------------------------------------------------------
+bool
+process_alive( int64_t pid )
+{
+  return kill( static_cast< pid_t >( pid ), 0 ) == 0 || errno == EPERM;
+}
+
+// ----------------------------------------------------------------
+[[noreturn]] void
+throw_system_error( std::string const& what )
+{
+  throw std::runtime_error( what + ": " + std::strerror( errno ) );
+}
+
+// ----------------------------------------------------------------
+class ring_lock
+{
+public:
+  explicit ring_lock( pthread_mutex_t& mutex ) : m_mutex( mutex )
+  {
+    pthread_mutex_lock( &m_mutex );
+  }
+
+  ~ring_lock() { pthread_mutex_unlock( &m_mutex ); }
+
+private:
+  pthread_mutex_t& m_mutex;
+};
+
+} // end namespace
+
+// ================================================================
+class shm_transport_ring::priv
+{
+public:
+  priv()
+    : m_base( nullptr ), m_size( 0 ), m_sender( false ),
+      m_control( nullptr ), m_queue( nullptr ), m_slots( nullptr )
+  {
+  }
+
+  ~priv()
+  {
+    if ( m_base )
+    {
+      munmap( m_base, m_size );
+    }
+    if ( m_sender )
+    {
+      shm_unlink( m_name.c_str() );
+    }
+  }
+
+  // Map the whole segment
+  void map( int fd, size_t size )
+  {
+    m_base = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    if ( m_base == MAP_FAILED )
+    {
+      m_base = nullptr;
+      throw_system_error( "Unable to map shared memory " + m_name );
+    }
+    m_size = size;
+  }
+
+  // Find the parts of the segment from the layout in its control block
+  void locate()
+  {
+    auto const base = static_cast< char* >( m_base );
+    m_control = reinterpret_cast< ring_control* >( base );
+    m_queue = reinterpret_cast< uint64_t* >(
+      base + round_up( sizeof( ring_control ), alignof( uint64_t ) ) );
+    m_slots = reinterpret_cast< shm_transport_slot* >(
+      m_queue + m_control->slot_count );
+  }
+
+  // Wait on the ring, with the mutex held, until ready() holds
+  template < typename Predicate >
+  void wait( Predicate ready, int64_t const& peer, char const* what )
+  {
+    while ( !ready() )
+    {
+      if ( peer != 0 && !process_alive( peer ) )
+      {
+        throw std::runtime_error(
+          std::string( "Process at the other end of shared memory " ) +
+          m_name + " ended while waiting " + what );
+      }
+
+      // Wake up now and then to notice the end of the other process
+      timespec deadline;
+      clock_gettime( CLOCK_REALTIME, &deadline );
+      deadline.tv_sec += 1;
+      pthread_cond_timedwait( &m_control->cond, &m_control->mutex, &deadline );
+    }
+  }
+
+  std::string m_name;
+  void* m_base;
+  size_t m_size;
+  bool m_sender;
+
+  ring_control* m_control;
+  uint64_t* m_queue;
+  shm_transport_slot* m_slots;
+};
+
+// ================================================================
+shm_transport_ring
+::shm_transport_ring()
+  : d( new priv )
+{
+}
+
+shm_transport_ring
+::~shm_transport_ring()
+{
+}
+
+// ----------------------------------------------------------------
+std::shared_ptr< shm_transport_ring >
+shm_transport_ring
+::create( std::string const& name, size_t slot_count, size_t slot_size )
+{
+  if ( slot_count == 0 || slot_size == 0 )
+  {
+    throw std::invalid_argument(
+      "Shared memory ring needs at least one slot of non-zero size" );
+  }
+
+  std::shared_ptr< shm_transport_ring > ring( new shm_transport_ring );
+  auto& d = *ring->d;
+  d.m_name = segment_name( name );
+
+  auto const page = static_cast< size_t >( sysconf( _SC_PAGESIZE ) );
+  auto const header_size =
+    round_up( sizeof( ring_control ), alignof( uint64_t ) ) +
+    slot_count * ( sizeof( uint64_t ) + sizeof( shm_transport_slot ) );
+  auto const data_offset = round_up( header_size, page );
+  auto const slot_stride = round_up( slot_size, page );
+  auto const total_size = data_offset + slot_count * slot_stride;
+
+  // A segment left by a sender that did not exit cleanly is replaced
+  shm_unlink( d.m_name.c_str() );
+  int const fd =
+    shm_open( d.m_name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR );
+  if ( fd < 0 )
+  {
+    throw_system_error( "Unable to create shared memory " + d.m_name );
+  }
+  d.m_sender = true;
+
+  if ( ftruncate( fd, static_cast< off_t >( total_size ) ) != 0 )
+  {
+    close( fd );
+    throw_system_error( "Unable to size shared memory " + d.m_name );
+  }
+
+  d.map( fd, total_size );
+  close( fd );
+
+  auto const control = new ( d.m_base ) ring_control;
+  control->magic.store( 0 );
+  control->version = ring_version;
+  control->slot_count = slot_count;
+  control->slot_size = slot_size;
+  control->slot_stride = slot_stride;
+  control->data_offset = data_offset;
+  control->total_size = total_size;
+  control->sender_pid = getpid();
+  control->receiver_pid = 0;
+  control->head = 0;
+  control->tail = 0;
+  d.locate();
+
+  pthread_mutexattr_t mutex_attr;
+  pthread_mutexattr_init( &mutex_attr );
+  pthread_mutexattr_setpshared( &mutex_attr, PTHREAD_PROCESS_SHARED );
+  pthread_mutex_init( &d.m_control->mutex, &mutex_attr );
+  pthread_mutexattr_destroy( &mutex_attr );
+
+  pthread_condattr_t cond_attr;
+  pthread_condattr_init( &cond_attr );
+  pthread_condattr_setpshared( &cond_attr, PTHREAD_PROCESS_SHARED );
+  pthread_cond_init( &d.m_control->cond, &cond_attr );
+  pthread_condattr_destroy( &cond_attr );
+
+  for ( size_t i = 0; i < slot_count; ++i )
+  {
+    std::memset( &d.m_slots[ i ], 0, sizeof( shm_transport_slot ) );
+    d.m_slots[ i ].state = slot_free;
+  }
+
+  d.m_control->magic.store( ring_magic, std::memory_order_release );
+  return ring;
+}
+
+// ----------------------------------------------------------------
+std::shared_ptr< shm_transport_ring >
+shm_transport_ring
+::open( std::string const& name, double timeout )
+{
+  std::shared_ptr< shm_transport_ring > ring( new shm_transport_ring );
+  auto& d = *ring->d;
+  d.m_name = segment_name( name );
+
+  auto const start = std::chrono::steady_clock::now();
+  for ( ;; )
+  {
+    int const fd = shm_open( d.m_name.c_str(), O_RDWR, 0 );
+    if ( fd < 0 && errno != ENOENT )
+    {
+      throw_system_error( "Unable to open shared memory " + d.m_name );
+    }
+
+    // The segment is used once the sender has finished setting it up, and
+    // only if that sender is still running
+    struct stat st;
+    if ( fd >= 0 && fstat( fd, &st ) == 0 &&
+         static_cast< size_t >( st.st_size ) >= sizeof( ring_control ) )
+    {
+      auto const control = static_cast< ring_control* >(
+        mmap( nullptr, sizeof( ring_control ), PROT_READ, MAP_SHARED, fd, 0 ) );
+      if ( control != MAP_FAILED )
+      {
+        bool const ready =
+          control->magic.load( std::memory_order_acquire ) == ring_magic &&
+          control->version == ring_version &&
+          control->total_size == static_cast< uint64_t >( st.st_size ) &&
+          process_alive( control->sender_pid );
+        auto const size = control->total_size;
+        munmap( control, sizeof( ring_control ) );
+
+        if ( ready )
+        {
+          d.map( fd, size );
+          close( fd );
+          d.locate();
+          break;
+        }
+      }
+    }
+    if ( fd >= 0 )
+    {
+      close( fd );
+    }
+
+    if ( timeout > 0 &&
+         std::chrono::duration< double >(
+           std::chrono::steady_clock::now() - start ).count() > timeout )
+    {
+      throw std::runtime_error( "Timed out waiting for a sender to create "
+                                "shared memory " + d.m_name );
+    }
+    std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+  }
+
+  ring_lock lock( d.m_control->mutex );
+  if ( d.m_control->receiver_pid != 0 &&
+       process_alive( d.m_control->receiver_pid ) )
+  {
+    throw std::runtime_error( "Shared memory " + d.m_name +
+                              " already has a receiver" );
+  }
+  d.m_control->receiver_pid = getpid();
+  pthread_cond_broadcast( &d.m_control->cond );
+  return ring;
+}
+
+// ----------------------------------------------------------------
+size_t
+shm_transport_ring
+::slot_count() const
+{
+  return d->m_control->slot_count;
+}
+
+// ----------------------------------------------------------------
+size_t
+shm_transport_ring
+::slot_size() const
+{
+  return d->m_control->slot_size;
+}
+
+// ----------------------------------------------------------------
+shm_transport_slot&
+shm_transport_ring
+::slot( size_t index )
+{
+  return d->m_slots[ index ];
+}
+
+// ----------------------------------------------------------------
+void*
+shm_transport_ring
+::slot_data( size_t index )
+{
+  return static_cast< char* >( d->m_base ) + d->m_control->data_offset +
+         index * d->m_control->slot_stride;
+}
+
+// ----------------------------------------------------------------
+size_t
+shm_transport_ring
+::acquire()
+{
+  auto const c = d->m_control;
+  ring_lock lock( c->mutex );
+
+  size_t index = 0;
+  d->wait( [ & ]
+    {
+      for ( index = 0; index < c->slot_count; ++index )
+      {
+        if ( d->m_slots[ index ].state == slot_free )
+        {
+          return true;
+        }
+      }
+      return false;
+    }, c->receiver_pid, "for a free slot" );
+
+  d->m_slots[ index ].state = slot_writing;
+  return index;
+}
+
+// ----------------------------------------------------------------
+void
+shm_transport_ring
+::publish( size_t index )
+{
+  auto const c = d->m_control;
+  ring_lock lock( c->mutex );
+
+  d->m_slots[ index ].state = slot_published;
+  d->m_queue[ c->head % c->slot_count ] = index;
+  ++c->head;
+  pthread_cond_broadcast( &c->cond );
+}
+
+// ----------------------------------------------------------------
+void
+shm_transport_ring
+::wait_until_drained()
+{
+  auto const c = d->m_control;
+  ring_lock lock( c->mutex );
+
+  d->wait( [ c ] { return c->tail == c->head; },
+           c->receiver_pid, "for the receiver to take the last slots" );
+}
+
+// ----------------------------------------------------------------
+void
+shm_transport_ring
+::unlink()
+{
+  if ( d->m_sender )
+  {
+    shm_unlink( d->m_name.c_str() );
+    d->m_sender = false;
+  }
+}
+
+// ----------------------------------------------------------------
+size_t
+shm_transport_ring
+::next()
+{
+  auto const c = d->m_control;
+  ring_lock lock( c->mutex );
+
+  d->wait( [ c ] { return c->tail != c->head; },
+           c->sender_pid, "for data" );
+
+  auto const index = d->m_queue[ c->tail % c->slot_count ];
+  ++c->tail;
+  d->m_slots[ index ].state = slot_reading;
+  pthread_cond_broadcast( &c->cond );
+  return index;
+}
+
+// ----------------------------------------------------------------
+void
+shm_transport_ring
+::release( size_t index )
+{
+  auto const c = d->m_control;
+  ring_lock lock( c->mutex );
+
+  d->m_slots[ index ].state = slot_free;
+  pthread_cond_broadcast( &c->cond );
+}
+
+} // end namespace
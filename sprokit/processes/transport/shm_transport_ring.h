@@ -0,0 +1,112 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Ring of frame slots in POSIX shared memory
+
+#ifndef KWIVER_TRANSPORT_SHM_TRANSPORT_RING_H
+#define KWIVER_TRANSPORT_SHM_TRANSPORT_RING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace kwiver {
+
+// ----------------------------------------------------------------
+/// Description of the contents of a slot, written by the sender
+struct shm_transport_slot
+{
+  enum
+  {
+    has_image = 1,
+    has_frame = 2,
+    has_time = 4,
+    has_message = 8,
+    end_of_data = 16,
+  };
+
+  uint32_t state;
+  uint32_t flags;
+
+  int64_t frame;
+  int64_t time;
+
+  // Layout of the image at the start of the slot data, in pixels
+  uint64_t width;
+  uint64_t height;
+  uint64_t depth;
+  int64_t w_step;
+  int64_t h_step;
+  int64_t d_step;
+  uint32_t pixel_type;
+  uint32_t pixel_bytes;
+  uint64_t image_size;
+
+  // The message follows the image at message_offset of the slot data
+  uint64_t message_offset;
+  uint64_t message_size;
+};
+
+// ----------------------------------------------------------------
+/// Ring of frame slots shared by a sending and a receiving process
+///
+/// The sender creates a named POSIX shared memory segment holding a control
+/// block and \c slot_count slots of \c slot_size bytes. It acquires a free
+/// slot, writes into it directly and publishes it. The receiver takes the
+/// slots in the order they were published and releases each one when it is
+/// done with it, in any order, so that data in a slot can be used in place
+/// for as long as needed. Waits fail if the process at the other end of the
+/// ring has died.
+class shm_transport_ring
+{
+public:
+  ~shm_transport_ring();
+
+  /// Create the segment \p name, replacing any left by an earlier sender
+  static std::shared_ptr< shm_transport_ring >
+  create( std::string const& name, size_t slot_count, size_t slot_size );
+
+  /// Open the segment \p name as its receiver
+  ///
+  /// \param timeout Seconds to wait for the sender to create the segment,
+  ///                or zero to wait for as long as it takes.
+  static std::shared_ptr< shm_transport_ring >
+  open( std::string const& name, double timeout );
+
+  size_t slot_count() const;
+  size_t slot_size() const;
+
+  shm_transport_slot& slot( size_t index );
+  void* slot_data( size_t index );
+
+  /// Wait for a free slot and reserve it for writing
+  size_t acquire();
+
+  /// Hand a slot written by the sender to the receiver
+  void publish( size_t index );
+
+  /// Wait until the receiver has taken every published slot
+  void wait_until_drained();
+
+  /// Remove the name of the segment, which stays mapped while in use
+  void unlink();
+
+  /// Wait for the next published slot
+  size_t next();
+
+  /// Return a slot taken by the receiver to the sender
+  void release( size_t index );
+
+private:
+  shm_transport_ring();
+
+  class priv;
+  std::unique_ptr< priv > d;
+};
+
+} // end namespace
+
+#endif // KWIVER_TRANSPORT_SHM_TRANSPORT_RING_H
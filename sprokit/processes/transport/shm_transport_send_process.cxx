@@ -0,0 +1,285 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "shm_transport_send_process.h"
+#include "shm_transport_ring.h"
+
+#include <sprokit/pipeline/datum.h>
+#include <sprokit/pipeline/process_exception.h>
+
+#include <kwiver_type_traits.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace kwiver {
+
+// (config-key, value-type, default-value, description )
+create_config_trait( shm_name, std::string, "kwiver_frames",
+                     "Name of the shared memory segment, which must be the "
+                     "same for the sender and the receiver." );
+create_config_trait( slot_count, size_t, "4",
+                     "Number of frames held in shared memory. The sender "
+                     "waits when the receiver holds all of them." );
+create_config_trait( slot_size, size_t, "8388608",
+                     "Bytes of image and message data held by each slot.  "
+                     "Every frame must fit into a slot." );
+
+//----------------------------------------------------------------
+// Private implementation class
+class shm_transport_send_process::priv
+{
+public:
+  priv();
+  ~priv();
+
+  // Write an image into a slot in a packed layout
+  void write_image( size_t index, vital::image const& image );
+
+  // Configuration values
+  std::string m_shm_name;
+  size_t m_slot_count;
+  size_t m_slot_size;
+
+  std::shared_ptr< shm_transport_ring > m_ring;
+
+  // Connected input ports
+  bool m_image;
+  bool m_timestamp;
+  bool m_message;
+
+}; // end priv class
+
+// ================================================================
+
+shm_transport_send_process
+::shm_transport_send_process( kwiver::vital::config_block_sptr const& config )
+  : process( config ),
+    d( new shm_transport_send_process::priv )
+{
+  make_ports();
+  make_config();
+}
+
+shm_transport_send_process
+::~shm_transport_send_process()
+{
+}
+
+// ----------------------------------------------------------------
+void shm_transport_send_process
+::_configure()
+{
+  scoped_configure_instrumentation();
+
+  // Get process config entries
+  d->m_shm_name = config_value_using_trait( shm_name );
+  d->m_slot_count = config_value_using_trait( slot_count );
+  d->m_slot_size = config_value_using_trait( slot_size );
+
+  try
+  {
+    d->m_ring = shm_transport_ring::create(
+      d->m_shm_name, d->m_slot_count, d->m_slot_size );
+  }
+  catch ( std::exception const& e )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(), e.what() );
+  }
+}
+
+// ----------------------------------------------------------------
+void shm_transport_send_process
+::_init()
+{
+  d->m_image = has_input_port_edge_using_trait( image );
+  d->m_timestamp = has_input_port_edge_using_trait( timestamp );
+  d->m_message = has_input_port_edge_using_trait( serialized_message );
+  if ( !d->m_image && !d->m_timestamp && !d->m_message )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "At least one of the image, timestamp and "
+                 "serialized_message ports must be connected." );
+  }
+}
+
+// ----------------------------------------------------------------
+void shm_transport_send_process
+::_step()
+{
+  // The input ports are optional, so the end of their data is handled here
+  auto const& port =
+    d->m_image ? image_port_trait::port_name
+    : d->m_timestamp ? timestamp_port_trait::port_name
+    : serialized_message_port_trait::port_name;
+  if ( peek_at_port( port ).datum->type() == sprokit::datum::complete )
+  {
+    if ( d->m_image )
+    {
+      grab_from_port( image_port_trait::port_name );
+    }
+    if ( d->m_timestamp )
+    {
+      grab_from_port( timestamp_port_trait::port_name );
+    }
+    if ( d->m_message )
+    {
+      grab_from_port( serialized_message_port_trait::port_name );
+    }
+
+    // Let the receiver finish too, and wait for it to take every frame
+    // before the segment goes away
+    auto const index = d->m_ring->acquire();
+    d->m_ring->slot( index ).flags = shm_transport_slot::end_of_data;
+    d->m_ring->publish( index );
+    d->m_ring->wait_until_drained();
+    d->m_ring->unlink();
+
+    mark_process_as_complete();
+    return;
+  }
+
+  vital::image_container_sptr image;
+  vital::timestamp ts;
+  serialized_message_port_trait::type message;
+  if ( d->m_image )
+  {
+    image = grab_from_port_using_trait( image );
+  }
+  if ( d->m_timestamp )
+  {
+    ts = grab_from_port_using_trait( timestamp );
+  }
+  if ( d->m_message )
+  {
+    message = grab_from_port_using_trait( serialized_message );
+  }
+
+  scoped_step_instrumentation();
+
+  auto const index = d->m_ring->acquire();
+  auto& slot = d->m_ring->slot( index );
+  auto const data = static_cast< char* >( d->m_ring->slot_data( index ) );
+
+  slot.flags = 0;
+  slot.image_size = 0;
+  if ( image )
+  {
+    d->write_image( index, image->get_image() );
+  }
+
+  if ( ts.has_valid_frame() )
+  {
+    slot.flags |= shm_transport_slot::has_frame;
+    slot.frame = ts.get_frame();
+  }
+  if ( ts.has_valid_time() )
+  {
+    slot.flags |= shm_transport_slot::has_time;
+    slot.time = ts.get_time_usec();
+  }
+
+  // Messages follow the image, aligned for whoever reads them in place
+  slot.message_offset = ( slot.image_size + 63 ) / 64 * 64;
+  slot.message_size = 0;
+  if ( message )
+  {
+    if ( slot.message_offset + message->size() > d->m_slot_size )
+    {
+      d->m_ring->release( index );
+      throw std::runtime_error(
+        "shm_transport_send: frame of " +
+        std::to_string( slot.message_offset + message->size() ) +
+        " bytes does not fit into a slot of " +
+        std::to_string( d->m_slot_size ) + " bytes" );
+    }
+    slot.flags |= shm_transport_slot::has_message;
+    slot.message_size = message->size();
+    std::memcpy( data + slot.message_offset, message->data(), message->size() );
+  }
+
+  d->m_ring->publish( index );
+}
+
+// ----------------------------------------------------------------
+void shm_transport_send_process
+::make_ports()
+{
+  // Data is read from whichever ports are connected
+  sprokit::process::port_flags_t optional;
+
+  declare_input_port_using_trait( image, optional );
+  declare_input_port_using_trait( timestamp, optional );
+  declare_input_port_using_trait( serialized_message, optional );
+}
+
+// ----------------------------------------------------------------
+void shm_transport_send_process
+::make_config()
+{
+  declare_config_using_trait( shm_name );
+  declare_config_using_trait( slot_count );
+  declare_config_using_trait( slot_size );
+}
+
+// ================================================================
+shm_transport_send_process::priv
+::priv()
+  : m_slot_count( 4 )
+  , m_slot_size( 8388608 )
+  , m_image( false )
+  , m_timestamp( false )
+  , m_message( false )
+{
+}
+
+shm_transport_send_process::priv
+::~priv()
+{
+}
+
+// ----------------------------------------------------------------
+void
+shm_transport_send_process::priv
+::write_image( size_t index, vital::image const& image )
+{
+  auto& slot = m_ring->slot( index );
+  auto const width = image.width();
+  auto const height = image.height();
+  auto const depth = image.depth();
+  auto const& traits = image.pixel_traits();
+
+  slot.image_size = width * height * depth * traits.num_bytes;
+  if ( slot.image_size > m_slot_size )
+  {
+    m_ring->release( index );
+    throw std::runtime_error(
+      "shm_transport_send: image of " + std::to_string( slot.image_size ) +
+      " bytes does not fit into a slot of " + std::to_string( m_slot_size ) +
+      " bytes" );
+  }
+
+  // Interleaved images stay interleaved, so that they are copied in one go
+  bool const interleaved = depth > 1 && std::abs( image.d_step() ) == 1;
+  ptrdiff_t const w_step = interleaved ? depth : 1;
+  ptrdiff_t const h_step = w_step * width;
+  ptrdiff_t const d_step = interleaved ? 1 : width * height;
+
+  vital::image view( m_ring->slot_data( index ), width, height, depth,
+                     w_step, h_step, d_step, traits );
+  view.copy_from( image );
+
+  slot.flags |= shm_transport_slot::has_image;
+  slot.width = width;
+  slot.height = height;
+  slot.depth = depth;
+  slot.w_step = w_step;
+  slot.h_step = h_step;
+  slot.d_step = d_step;
+  slot.pixel_type = traits.type;
+  slot.pixel_bytes = static_cast< uint32_t >( traits.num_bytes );
+}
+
+} // end namespace
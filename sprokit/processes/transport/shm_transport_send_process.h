@@ -0,0 +1,72 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_TRANSPORT_SHM_TRANSPORT_SEND_PROCESS_H
+#define KWIVER_TRANSPORT_SHM_TRANSPORT_SEND_PROCESS_H
+
+#include <sprokit/pipeline/process.h>
+
+#include "kwiver_processes_transport_export.h"
+
+namespace kwiver {
+
+// ----------------------------------------------------------------
+/**
+ * \class shm_transport_send_process
+ *
+ * \brief Sends frames to a pipeline in another process on the same host
+ * through shared memory.
+ *
+ * The process creates a POSIX shared memory segment holding a ring of
+ * frame slots, which shm_transport_receive opens. Images are copied
+ * straight into a free slot, along with their timestamp and a serialized
+ * message, with no serialization or socket in between. When every slot
+ * is in use, the process waits for the receiver to release one.
+ *
+ * \iports
+ *
+ * \iport{image} the image to send.
+ *
+ * \iport{timestamp} the timestamp to send with it.
+ *
+ * \iport{serialized_message} a byte string to send with it, for instance
+ * the serialized detections of the frame.
+ *
+ * Any of the ports can be left unconnected, but not all of them.
+ *
+ * \configs
+ *
+ * \config{shm_name} name of the shared memory segment.
+ *
+ * \config{slot_count} number of frames held in shared memory.
+ *
+ * \config{slot_size} bytes of image and message held by each slot.
+ */
+class KWIVER_PROCESSES_TRANSPORT_NO_EXPORT shm_transport_send_process
+  : public sprokit::process
+{
+public:
+  PLUGIN_INFO( "shm_transport_send",
+               "Sends images and serialized messages to another process "
+               "on the same host through shared memory." )
+
+  shm_transport_send_process( kwiver::vital::config_block_sptr const& config );
+  virtual ~shm_transport_send_process();
+
+protected:
+  virtual void _configure();
+  virtual void _init();
+  virtual void _step();
+
+private:
+  void make_ports();
+  void make_config();
+
+  class priv;
+  const std::unique_ptr<priv> d;
+}; // end class shm_transport_send_process
+
+}  // end namespace
+
+#endif // KWIVER_TRANSPORT_SHM_TRANSPORT_SEND_PROCESS_H
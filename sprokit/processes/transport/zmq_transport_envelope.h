@@ -0,0 +1,169 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/**
+ * \file
+ * \brief Envelopes holding batches of messages sent over ZeroMQ
+ *
+ * An envelope is a multipart ZeroMQ message. Its first frame describes
+ * the messages of the envelope, and the remaining frames hold the bytes
+ * of these messages one after another. Frames need not match messages.
+ *
+ * The first frame holds, in little-endian order:
+ *
+ *   4 bytes   magic "\0KWE"
+ *   4 bytes   version and reserved bytes
+ *   8 bytes   message count
+ *
+ * followed, for each message, by:
+ *
+ *   8 bytes   message size
+ *   8 bytes   frame number
+ *   8 bytes   time in microseconds
+ *   4 bytes   flags: 1 if the frame is valid, 2 if the time is valid
+ *   4 bytes   reserved
+ *
+ * Serialized messages start with the name of their message type, so they
+ * are never mistaken for an envelope.
+ */
+
+#ifndef KWIVER_TRANSPORT_ZMQ_TRANSPORT_ENVELOPE_H
+#define KWIVER_TRANSPORT_ZMQ_TRANSPORT_ENVELOPE_H
+
+#include <vital/types/timestamp.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace kwiver {
+
+/// Description of a message within an envelope
+struct transport_envelope_entry
+{
+  uint64_t size = 0;
+  kwiver::vital::timestamp ts;
+};
+
+namespace transport_envelope {
+
+char const magic[ 4 ] = { '\0', 'K', 'W', 'E' };
+uint8_t const version = 1;
+size_t const header_size = 16;
+size_t const entry_size = 32;
+
+uint32_t const flag_frame = 1;
+uint32_t const flag_time = 2;
+
+// ----------------------------------------------------------------------------
+inline void
+put( std::string& out, uint64_t value, size_t bytes )
+{
+  for ( size_t i = 0; i < bytes; ++i )
+  {
+    out.push_back( static_cast< char >( ( value >> ( 8 * i ) ) & 0xff ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+inline uint64_t
+get( char const* data, size_t bytes )
+{
+  uint64_t value = 0;
+  for ( size_t i = 0; i < bytes; ++i )
+  {
+    value |= static_cast< uint64_t >(
+      static_cast< unsigned char >( data[ i ] ) ) << ( 8 * i );
+  }
+  return value;
+}
+
+} // end namespace transport_envelope
+
+// ----------------------------------------------------------------------------
+/// Write the first frame of an envelope holding \p entries
+inline std::string
+write_transport_envelope( std::vector< transport_envelope_entry > const& entries )
+{
+  namespace te = transport_envelope;
+
+  std::string out;
+  out.reserve( te::header_size + te::entry_size * entries.size() );
+  out.append( te::magic, sizeof( te::magic ) );
+  te::put( out, te::version, 4 );
+  te::put( out, entries.size(), 8 );
+  for ( auto const& entry : entries )
+  {
+    uint32_t flags = 0;
+    flags |= ( entry.ts.has_valid_frame() ? te::flag_frame : 0 );
+    flags |= ( entry.ts.has_valid_time() ? te::flag_time : 0 );
+
+    te::put( out, entry.size, 8 );
+    te::put( out, static_cast< uint64_t >(
+               entry.ts.has_valid_frame() ? entry.ts.get_frame() : 0 ), 8 );
+    te::put( out, static_cast< uint64_t >(
+               entry.ts.has_valid_time() ? entry.ts.get_time_usec() : 0 ), 8 );
+    te::put( out, flags, 4 );
+    te::put( out, 0, 4 );
+  }
+  return out;
+}
+
+// ----------------------------------------------------------------------------
+/// Test whether a frame is the first frame of an envelope
+inline bool
+is_transport_envelope( char const* data, size_t size )
+{
+  namespace te = transport_envelope;
+  return size >= te::header_size &&
+         std::memcmp( data, te::magic, sizeof( te::magic ) ) == 0;
+}
+
+// ----------------------------------------------------------------------------
+/// Read the first frame of an envelope
+///
+/// \returns false if the frame is not a valid envelope.
+inline bool
+read_transport_envelope( char const* data, size_t size,
+                         std::vector< transport_envelope_entry >& entries )
+{
+  namespace te = transport_envelope;
+
+  entries.clear();
+  if ( ! is_transport_envelope( data, size ) ||
+       static_cast< uint8_t >( data[ 4 ] ) != te::version )
+  {
+    return false;
+  }
+
+  auto const count = te::get( data + 8, 8 );
+  if ( count > ( size - te::header_size ) / te::entry_size )
+  {
+    return false;
+  }
+
+  entries.resize( count );
+  for ( size_t i = 0; i < count; ++i )
+  {
+    auto const p = data + te::header_size + i * te::entry_size;
+    auto const flags = te::get( p + 24, 4 );
+
+    auto& entry = entries[ i ];
+    entry.size = te::get( p, 8 );
+    if ( flags & te::flag_frame )
+    {
+      entry.ts.set_frame( static_cast< int64_t >( te::get( p + 8, 8 ) ) );
+    }
+    if ( flags & te::flag_time )
+    {
+      entry.ts.set_time_usec( static_cast< int64_t >( te::get( p + 16, 8 ) ) );
+    }
+  }
+  return true;
+}
+
+} // end namespace kwiver
+
+#endif // KWIVER_TRANSPORT_ZMQ_TRANSPORT_ENVELOPE_H
@@ -6,8 +6,12 @@
 
 #include <sprokit/pipeline/process_exception.h>
 
+#include "zmq_transport_envelope.h"
+
 #include <kwiver_type_traits.h>
 
+#include <map>
+
 namespace kwiver {
 
 // (config-key, value-type, default-value, description )
@@ -20,6 +24,33 @@ create_config_trait( connect_host, std::string, "localhost",
 create_config_trait( num_publishers, int, "1",
                      "Number of publishers to subscribe to. ");
 
+create_config_trait( mode, std::string, "sub",
+                     "Transport mode. \"sub\" subscribes to publishers. \"pull\" "
+                     "takes a share of the messages of push senders." );
+
+create_config_trait( bind, bool, "false",
+                     "In pull mode, bind to the port instead of connecting to "
+                     "senders, so that several push senders, such as workers, "
+                     "can connect to this receiver." );
+
+create_config_trait( high_water_mark, int, "0",
+                     "Number of messages queued from each peer. Zero keeps the "
+                     "ZeroMQ default." );
+
+create_config_trait( reorder_window, int, "0",
+                     "Number of messages held to restore the order of their "
+                     "timestamps, for instance when collecting the results of "
+                     "several workers. Messages are output in order of frame "
+                     "number, or of time if they have no frame number, as soon "
+                     "as they follow the previous message or when the window is "
+                     "full. Zero outputs messages as they arrive." );
+
+create_config_trait( end_of_stream, bool, "false",
+                     "Complete once an end of stream marker has arrived from "
+                     "each of num_publishers senders, instead of running until "
+                     "the pipeline is stopped. The senders must be configured "
+                     "to send the marker." );
+
 /**
  * \class zmq_transport_receive_process
  *
@@ -43,11 +74,26 @@ create_config_trait( num_publishers, int, "1",
  * synchronization.  A subsequent publisher will be connected
  * at port+2 and so on.
  *
- * \iports
+ * In pull mode, the process receives on a PULL socket instead, taking
+ * its share of the messages of PUSH senders. It connects to senders at
+ * the same ports as publishers, without handshaking, or binds the port
+ * for senders to connect to. A pipeline which pulls frames from a source
+ * and pushes its results to a collector can be run as many times as
+ * needed to share the work.
  *
- * \iport{serialized_message} the incoming byte is sent to a
+ * Envelopes sent by zmq_transport_send are split into their messages,
+ * which are output with their timestamps. The messages can be put back
+ * in timestamp order, which lets a collector undo the interleaving of
+ * several workers.
+ *
+ * \oports
+ *
+ * \oport{serialized_message} the incoming byte is sent to a
  * serializer process here.
  *
+ * \oport{timestamp} the timestamp sent with each message, or an invalid
+ * timestamp.
+ *
  * \configs
  *
  * \config{port} the port number to subscribe on.
@@ -57,6 +103,17 @@ create_config_trait( num_publishers, int, "1",
  *
  * \config{connect_host} The name of the host to connect
  * to.  May be a DNS name or an IP address.
+ *
+ * \config{mode} sub or pull.
+ *
+ * \config{bind} bind the port in pull mode.
+ *
+ * \config{high_water_mark} messages queued per peer.
+ *
+ * \config{reorder_window} messages held to restore timestamp order.
+ *
+ * \config{end_of_stream} complete after an end of stream marker from
+ * each sender.
  */
 
 //----------------------------------------------------------------
@@ -69,14 +126,47 @@ class zmq_transport_receive_process::priv
 
   void connect();
 
+  // Receive one ZeroMQ message and queue the messages it holds
+  void receive();
+
+  // Queue a received message, in timestamp order if reordering
+  void add( std::shared_ptr< std::string > const& message,
+            kwiver::vital::timestamp const& ts );
+
+  // Move held messages which are ready to the output queue
+  void release_ordered();
+
+  struct entry
+  {
+    std::shared_ptr< std::string > message;
+    kwiver::vital::timestamp ts;
+  };
+
   // Configuration values
   int m_port;
   int m_num_publishers;
   std::string m_connect_host;
+  std::string m_mode;
+  bool m_bind;
+  int m_high_water_mark;
+  size_t m_reorder_window;
+  bool m_end_of_stream;
 
   // any other connection related data goes here
   zmq::context_t m_context;
-  zmq::socket_t m_sub_socket;
+  std::unique_ptr< zmq::socket_t > m_sub_socket;
+
+  // Messages ready to output
+  std::vector< entry > m_ready;
+
+  // End of stream markers received, and whether all have been
+  int m_ends;
+  bool m_ended;
+
+  // Messages held for reordering, by frame number or time
+  std::multimap< int64_t, entry > m_held;
+  bool m_has_last_key;
+  int64_t m_last_key;
   std::vector< std::shared_ptr<zmq::socket_t> > m_sync_sockets;
 
   vital::logger_handle_t m_logger; // for logging in priv methods
@@ -110,6 +200,33 @@ ::_configure()
   d->m_port = config_value_using_trait( port );
   d->m_num_publishers = config_value_using_trait( num_publishers );
   d->m_connect_host = config_value_using_trait( connect_host );
+  d->m_mode = config_value_using_trait( mode );
+  d->m_bind = config_value_using_trait( bind );
+  d->m_high_water_mark = config_value_using_trait( high_water_mark );
+
+  auto const reorder_window = config_value_using_trait( reorder_window );
+  if ( reorder_window < 0 )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "reorder_window must not be negative." );
+  }
+  d->m_reorder_window = static_cast< size_t >( reorder_window );
+  d->m_end_of_stream = config_value_using_trait( end_of_stream );
+
+  if ( d->m_mode == "sub" )
+  {
+    d->m_sub_socket.reset( new zmq::socket_t( d->m_context, ZMQ_SUB ) );
+  }
+  else if ( d->m_mode == "pull" )
+  {
+    d->m_sub_socket.reset( new zmq::socket_t( d->m_context, ZMQ_PULL ) );
+  }
+  else
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "Unknown mode \"" + d->m_mode + "\"; "
+                 "expected \"sub\" or \"pull\"." );
+  }
 
   int major, minor, patch;
   zmq_version(&major, &minor, &patch);
@@ -127,16 +244,27 @@ ::_init()
 void zmq_transport_receive_process
 ::_step()
 {
-  LOG_TRACE( logger(), "Waiting for datagram..." );
+  // Wait until at least one message is ready; a batch may yield several
+  while ( d->m_ready.empty() && ! d->m_ended )
+  {
+    LOG_TRACE( logger(), "Waiting for datagram..." );
+    d->receive();
+  }
 
-  zmq::message_t datagram;
-  d->m_sub_socket.recv(&datagram);
+  for ( auto const& e : d->m_ready )
+  {
+    LOG_TRACE( logger(), "Received datagram of size " << e.message->size() );
 
-  auto msg = std::make_shared< std::string >(static_cast<char *>(datagram.data()), datagram.size());
-  LOG_TRACE( logger(), "Received datagram of size " << msg->size() );
+    // We know that the message is a pointer to a std::string
+    push_to_port_using_trait( serialized_message, e.message );
+    push_to_port_using_trait( timestamp, e.ts );
+  }
+  d->m_ready.clear();
 
-  // We know that the message is a pointer to a std::string
-  push_to_port_using_trait( serialized_message, msg );
+  if ( d->m_ended )
+  {
+    mark_process_as_complete();
+  }
 }
 
 // ----------------------------------------------------------------
@@ -148,6 +276,9 @@ ::make_ports()
   required.insert( flag_required );
 
   declare_output_port_using_trait( serialized_message, required );
+
+  sprokit::process::port_flags_t optional;
+  declare_output_port_using_trait( timestamp, optional );
 }
 
 // ----------------------------------------------------------------
@@ -157,13 +288,27 @@ ::make_config()
   declare_config_using_trait( port );
   declare_config_using_trait( num_publishers );
   declare_config_using_trait( connect_host );
+  declare_config_using_trait( mode );
+  declare_config_using_trait( bind );
+  declare_config_using_trait( high_water_mark );
+  declare_config_using_trait( reorder_window );
+  declare_config_using_trait( end_of_stream );
 }
 
 // ================================================================
 zmq_transport_receive_process::priv
 ::priv()
-  : m_context( 1 )
-  , m_sub_socket( m_context, ZMQ_SUB )
+  : m_port( 5550 )
+  , m_num_publishers( 1 )
+  , m_bind( false )
+  , m_high_water_mark( 0 )
+  , m_reorder_window( 0 )
+  , m_end_of_stream( false )
+  , m_context( 1 )
+  , m_ends( 0 )
+  , m_ended( false )
+  , m_has_last_key( false )
+  , m_last_key( 0 )
 {
 }
 
@@ -177,8 +322,36 @@ void
 zmq_transport_receive_process::priv
 ::connect()
 {
+  if ( m_high_water_mark > 0 )
+  {
+    m_sub_socket->setsockopt( ZMQ_RCVHWM, &m_high_water_mark,
+                              sizeof( m_high_water_mark ) );
+  }
+
+  if ( m_mode == "pull" )
+  {
+    std::ostringstream pull_connect_string;
+    if ( m_bind )
+    {
+      pull_connect_string << "tcp://*:" << m_port;
+      LOG_TRACE( m_logger, "PULL Bind for " << pull_connect_string.str() );
+      m_sub_socket->bind( pull_connect_string.str() );
+      return;
+    }
+
+    // Senders are at the same ports as publishers would be
+    for ( int i = 0; i < m_num_publishers * 2; i += 2 )
+    {
+      std::ostringstream connect_string;
+      connect_string << "tcp://" << m_connect_host << ":" << m_port + i;
+      LOG_TRACE( m_logger, "PULL Connect for " << connect_string.str() );
+      m_sub_socket->connect( connect_string.str() );
+    }
+    return;
+  }
+
   LOG_DEBUG( m_logger, "Number of publishers " << m_num_publishers );
-  m_sub_socket.setsockopt(ZMQ_SUBSCRIBE,"",0);
+  m_sub_socket->setsockopt(ZMQ_SUBSCRIBE,"",0);
 
   // We start with our base port.  Even ports are the pub/sub socket
   // Odd ports (pub/sub + 1) are the sync sockets
@@ -190,7 +363,7 @@ ::connect()
     std::ostringstream sub_connect_string;
     sub_connect_string << "tcp://" << m_connect_host << ":" << m_port + i;
     LOG_TRACE( m_logger, "SUB Connect for " << sub_connect_string.str() );
-    m_sub_socket.connect( sub_connect_string.str() );
+    m_sub_socket->connect( sub_connect_string.str() );
 
     std::ostringstream sync_connect_string;
     sync_connect_string << "tcp://" << m_connect_host << ":" << ( m_port + i + 1);
@@ -207,4 +380,143 @@ ::connect()
   }
 }
 
+// ----------------------------------------------------------------------------
+void
+zmq_transport_receive_process::priv
+::receive()
+{
+  // Gather the frames of one multipart message
+  std::vector< zmq::message_t > frames( 1 );
+  m_sub_socket->recv( &frames.back() );
+
+  int more = 0;
+  size_t more_size = sizeof( more );
+  m_sub_socket->getsockopt( ZMQ_RCVMORE, &more, &more_size );
+  while ( more )
+  {
+    frames.emplace_back();
+    m_sub_socket->recv( &frames.back() );
+    m_sub_socket->getsockopt( ZMQ_RCVMORE, &more, &more_size );
+  }
+
+  auto const& first = frames.front();
+  std::vector< transport_envelope_entry > entries;
+  if ( ! is_transport_envelope( static_cast< char const* >( first.data() ),
+                                first.size() ) )
+  {
+    // A plain message, possibly sent in parts
+    auto msg = std::make_shared< std::string >();
+    for ( auto& frame : frames )
+    {
+      msg->append( static_cast< char* >( frame.data() ), frame.size() );
+    }
+    add( msg, kwiver::vital::timestamp{} );
+    return;
+  }
+
+  if ( ! read_transport_envelope( static_cast< char const* >( first.data() ),
+                                  first.size(), entries ) )
+  {
+    LOG_ERROR( m_logger, "Invalid message envelope received. Messages dropped." );
+    return;
+  }
+
+  if ( entries.empty() )
+  {
+    if ( m_end_of_stream && ++m_ends >= m_num_publishers )
+    {
+      // Nothing more is coming to fill the gaps in the held messages
+      for ( auto const& held : m_held )
+      {
+        m_ready.push_back( held.second );
+      }
+      m_held.clear();
+      m_ended = true;
+    }
+    return;
+  }
+
+  // Split the bytes of the remaining frames into the messages
+  uint64_t total = 0;
+  for ( auto const& e : entries )
+  {
+    total += e.size;
+  }
+
+  std::string payload;
+  payload.reserve( total );
+  for ( size_t i = 1; i < frames.size(); ++i )
+  {
+    payload.append( static_cast< char* >( frames[ i ].data() ), frames[ i ].size() );
+  }
+  if ( payload.size() != total )
+  {
+    LOG_ERROR( m_logger, "Message envelope holds " << payload.size()
+               << " bytes instead of " << total << ". Messages dropped." );
+    return;
+  }
+
+  size_t offset = 0;
+  for ( auto const& e : entries )
+  {
+    add( std::make_shared< std::string >( payload, offset, e.size ), e.ts );
+    offset += e.size;
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+zmq_transport_receive_process::priv
+::add( std::shared_ptr< std::string > const& message,
+       kwiver::vital::timestamp const& ts )
+{
+  if ( ! m_reorder_window ||
+       ! ( ts.has_valid_frame() || ts.has_valid_time() ) )
+  {
+    m_ready.push_back( { message, ts } );
+    return;
+  }
+
+  auto const key = ts.has_valid_frame() ? ts.get_frame() : ts.get_time_usec();
+  if ( m_has_last_key && key <= m_last_key )
+  {
+    if ( key < m_last_key )
+    {
+      LOG_WARN( m_logger, "Message for " << ts << " arrived after later "
+                "messages were output; consider a larger reorder_window." );
+    }
+    m_ready.push_back( { message, ts } );
+    return;
+  }
+
+  m_held.emplace( key, entry{ message, ts } );
+  release_ordered();
+}
+
+// ----------------------------------------------------------------------------
+void
+zmq_transport_receive_process::priv
+::release_ordered()
+{
+  // Output the earliest message while it follows the last one output, or
+  // while the window is over full. Frame numbers are consecutive when no
+  // frames are missing; times cannot tell, so they rely on the window.
+  while ( ! m_held.empty() )
+  {
+    auto const it = m_held.begin();
+    bool const next = m_has_last_key &&
+                      it->second.ts.has_valid_frame() &&
+                      it->first == m_last_key + 1;
+    if ( ! next && m_held.size() <= m_reorder_window )
+    {
+      break;
+    }
+
+    m_has_last_key = true;
+    m_last_key = it->first;
+    m_ready.push_back( it->second );
+    m_held.erase( it );
+  }
+}
+
 } // end namespace
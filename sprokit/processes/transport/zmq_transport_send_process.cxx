@@ -4,8 +4,11 @@
 
 #include "zmq_transport_send_process.h"
 
+#include <sprokit/pipeline/datum.h>
 #include <sprokit/pipeline/process_exception.h>
 
+#include "zmq_transport_envelope.h"
+
 #include <kwiver_type_traits.h>
 #include <memory.h>
 
@@ -18,10 +21,49 @@ create_config_trait( port, int, "5550",
 create_config_trait( expected_subscribers, int, "1",
                      "Number of subscribers to wait for before starting to publish");
 
+create_config_trait( mode, std::string, "pub",
+                     "Transport mode. \"pub\" publishes every message to all "
+                     "subscribers, dropping messages for subscribers which fall "
+                     "behind by more than the high water mark. \"push\" "
+                     "distributes messages among the connected receivers in turn, "
+                     "blocking while all of them are full." );
+
+create_config_trait( connect_host, std::string, "",
+                     "Host to connect to in push mode, such as a collector "
+                     "receiving the results of several workers. If empty, the "
+                     "socket is bound to the port instead." );
+
+create_config_trait( high_water_mark, int, "0",
+                     "Number of messages queued for each peer before the socket "
+                     "drops (pub) or blocks (push). Zero keeps the ZeroMQ default." );
+
+create_config_trait( batch_size, int, "1",
+                     "Number of messages sent together as a single multipart "
+                     "ZeroMQ message. Batches are sent when full and when the "
+                     "input ends." );
+
+create_config_trait( end_of_stream, bool, "false",
+                     "Send an end of stream marker when the input ends, so that "
+                     "receivers configured to expect it complete too. In push "
+                     "mode the marker reaches only one receiver." );
+
+namespace {
+
+// ----------------------------------------------------------------
+// Release the owner of the bytes of a zero-copy ZeroMQ message
+void
+release_message_part( void*, void* hint )
+{
+  delete static_cast< std::shared_ptr< void const >* >( hint );
+}
+
+} // end namespace
+
 /**
  * \class zmq_transport_send_process
  *
- * \brief End cap that publishes incoming data on a ZeroMQ PUB Socket
+ * \brief End cap that publishes incoming data on a ZeroMQ PUB or PUSH
+ * Socket
  *
  * \process This process can be used to connect separate Sprokit pipelines
  * to one another in a publishi/subscribe framework.  This process
@@ -41,16 +83,49 @@ create_config_trait( expected_subscribers, int, "1",
  * the configuration. One above that port is used to handle
  * subscription handshaking.
  *
+ * In push mode, the process sends on a PUSH socket instead, which hands
+ * each message to one of the connected PULL receivers in turn. This
+ * spreads the frames of a stream over a farm of worker pipelines. The
+ * socket can also connect to a single host, such as a collector which
+ * gathers the results of the workers. There is no handshaking; sending
+ * blocks until a receiver is connected and has room for the message.
+ *
+ * Messages are sent as they are, unless they are batched or a timestamp
+ * is connected. They are then sent in an envelope, a multipart message
+ * whose first frame lists the size and timestamp of each message it
+ * holds. Receivers use the timestamps to put the messages of several
+ * workers back in order.
+ *
  * \iports
  *
  * \iport{serialized_message} the incoming byte string to publish.
  *
+ * \iport{serialized_message_parts} the parts of an incoming message, to
+ * publish as a ZeroMQ multipart message instead of a single byte string.
+ * Subscribers receive the parts in order and join them into the same
+ * byte string.
+ *
+ * \iport{timestamp} optional timestamp of each message, sent with the
+ * message so that receivers can reorder messages.
+ *
  * \configs
  *
  * \config{port} the port number to publish on.
  *
  * \config{expected_subscribers} the number of subscribers that must
- * connect before publication commences.
+ * connect before publication commences, in pub mode.
+ *
+ * \config{mode} pub or push.
+ *
+ * \config{connect_host} host to connect to in push mode, instead of
+ * binding the port.
+ *
+ * \config{high_water_mark} messages queued per peer.
+ *
+ * \config{batch_size} number of messages sent together.
+ *
+ * \config{end_of_stream} send an end of stream marker, an envelope
+ * holding no messages, when the input ends.
  */
 
 //----------------------------------------------------------------
@@ -63,15 +138,37 @@ class zmq_transport_send_process::priv
 
   void connect();
 
+  // Send the parts of a message, or of a batch, as one multipart message
+  void send( kwiver::vital::algo::message_parts const& parts );
+
+  // Send the pending messages in an envelope
+  void send_batch();
+
   // Configuration values
   int m_port;
   int m_expected_subscribers;
+  std::string m_mode;
+  std::string m_connect_host;
+  int m_high_water_mark;
+  size_t m_batch_size;
+  bool m_end_of_stream;
 
   //+ any other connection related data goes here
   zmq::context_t m_context;
-  zmq::socket_t m_pub_socket;
+  std::unique_ptr< zmq::socket_t > m_pub_socket;
   zmq::socket_t m_sync_socket;
 
+  // Messages arrive as parts instead of byte strings
+  bool m_parts;
+
+  // Messages are sent in envelopes
+  bool m_envelope;
+  bool m_has_timestamp;
+
+  // Messages waiting to be sent in the next envelope
+  std::vector< kwiver::vital::algo::message_parts > m_pending;
+  std::vector< transport_envelope_entry > m_pending_entries;
+
   vital::logger_handle_t m_logger; // for logging in priv methods
 
 }; // end priv class
@@ -103,6 +200,33 @@ ::_configure()
   // Get process config entries
   d->m_port = config_value_using_trait( port );
   d->m_expected_subscribers = config_value_using_trait( expected_subscribers );
+  d->m_mode = config_value_using_trait( mode );
+  d->m_connect_host = config_value_using_trait( connect_host );
+  d->m_high_water_mark = config_value_using_trait( high_water_mark );
+
+  auto const batch_size = config_value_using_trait( batch_size );
+  if ( batch_size < 1 )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "batch_size must be at least 1." );
+  }
+  d->m_batch_size = static_cast< size_t >( batch_size );
+  d->m_end_of_stream = config_value_using_trait( end_of_stream );
+
+  if ( d->m_mode == "pub" )
+  {
+    d->m_pub_socket.reset( new zmq::socket_t( d->m_context, ZMQ_PUB ) );
+  }
+  else if ( d->m_mode == "push" )
+  {
+    d->m_pub_socket.reset( new zmq::socket_t( d->m_context, ZMQ_PUSH ) );
+  }
+  else
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "Unknown mode \"" + d->m_mode + "\"; "
+                 "expected \"pub\" or \"push\"." );
+  }
 
   int major, minor, patch;
   zmq_version(&major, &minor, &patch);
@@ -113,6 +237,17 @@ ::_configure()
 void zmq_transport_send_process
 ::_init()
 {
+  d->m_parts = has_input_port_edge_using_trait( serialized_message_parts );
+  if ( d->m_parts == has_input_port_edge_using_trait( serialized_message ) )
+  {
+    VITAL_THROW( sprokit::invalid_configuration_exception, name(),
+                 "Exactly one of the serialized_message and "
+                 "serialized_message_parts ports must be connected." );
+  }
+
+  d->m_has_timestamp = has_input_port_edge_using_trait( timestamp );
+  d->m_envelope = d->m_has_timestamp || d->m_batch_size > 1;
+
   d->connect();
 }
 
@@ -120,27 +255,86 @@ ::_init()
 void zmq_transport_send_process
 ::_step()
 {
-  auto mess = grab_from_port_using_trait( serialized_message );
+  // The input ports are optional, so the end of their data is handled here
+  auto const& port = d->m_parts
+    ? serialized_message_parts_port_trait::port_name
+    : serialized_message_port_trait::port_name;
+  if ( peek_at_port( port ).datum->type() == sprokit::datum::complete )
+  {
+    grab_from_port( port );
+    if ( d->m_has_timestamp )
+    {
+      grab_from_port( timestamp_port_trait::port_name );
+    }
+
+    // Send the last, partial batch
+    if ( ! d->m_pending.empty() )
+    {
+      d->send_batch();
+    }
+
+    // An empty envelope, which receivers not expecting it ignore
+    if ( d->m_end_of_stream )
+    {
+      d->send_batch();
+    }
+    mark_process_as_complete();
+    return;
+  }
+
+  kwiver::vital::algo::message_parts parts;
+  if ( d->m_parts )
+  {
+    auto mess = grab_from_port_using_trait( serialized_message_parts );
+    for ( auto const& part : *mess )
+    {
+      if ( part.size )
+      {
+        parts.push_back( part );
+      }
+    }
+  }
+  else
+  {
+    auto mess = grab_from_port_using_trait( serialized_message );
+    parts.push_back( { mess->data(), mess->size(), mess } );
+  }
+
+  kwiver::vital::timestamp ts;
+  if ( d->m_has_timestamp )
+  {
+    ts = grab_from_port_using_trait( timestamp );
+  }
 
   scoped_step_instrumentation();
 
-  // We know that the message is a pointer to a std::string
-  // send mess to the transport
-  LOG_TRACE( logger(), "Sending datagram of size " << mess->size() );
-  zmq::message_t datagram(mess->size());
-  memcpy((void *) datagram.data(), (mess->c_str()), mess->size());
-  d->m_pub_socket.send(datagram);
+  if ( ! d->m_envelope )
+  {
+    d->send( parts );
+    return;
+  }
+
+  transport_envelope_entry entry;
+  entry.size = kwiver::vital::algo::message_size( parts );
+  entry.ts = ts;
+  d->m_pending.push_back( std::move( parts ) );
+  d->m_pending_entries.push_back( entry );
+  if ( d->m_pending.size() >= d->m_batch_size )
+  {
+    d->send_batch();
+  }
 }
 
 // ----------------------------------------------------------------
 void zmq_transport_send_process
 ::make_ports()
 {
-  // Set up for required ports
-  sprokit::process::port_flags_t required;
-  required.insert( flag_required );
+  // Messages are read from whichever port is connected
+  sprokit::process::port_flags_t optional;
 
-  declare_input_port_using_trait( serialized_message, required );
+  declare_input_port_using_trait( serialized_message, optional );
+  declare_input_port_using_trait( serialized_message_parts, optional );
+  declare_input_port_using_trait( timestamp, optional );
 }
 
 // ----------------------------------------------------------------
@@ -149,14 +343,26 @@ ::make_config()
 {
   declare_config_using_trait( port );
   declare_config_using_trait( expected_subscribers );
+  declare_config_using_trait( mode );
+  declare_config_using_trait( connect_host );
+  declare_config_using_trait( high_water_mark );
+  declare_config_using_trait( batch_size );
+  declare_config_using_trait( end_of_stream );
 }
 
 // ================================================================
 zmq_transport_send_process::priv
 ::priv()
-  : m_context( 1 )
-  , m_pub_socket( m_context, ZMQ_PUB )
+  : m_port( 5550 )
+  , m_expected_subscribers( 1 )
+  , m_high_water_mark( 0 )
+  , m_batch_size( 1 )
+  , m_end_of_stream( false )
+  , m_context( 1 )
   , m_sync_socket( m_context, ZMQ_REP )
+  , m_parts( false )
+  , m_envelope( false )
+  , m_has_timestamp( false )
 {
 }
 
@@ -170,11 +376,37 @@ void
 zmq_transport_send_process::priv
 ::connect()
 {
+  if ( m_high_water_mark > 0 )
+  {
+    m_pub_socket->setsockopt( ZMQ_SNDHWM, &m_high_water_mark,
+                              sizeof( m_high_water_mark ) );
+  }
+
+  if ( m_mode == "push" )
+  {
+    // Receivers pull from this socket, or it pushes to a single collector.
+    // A PUSH socket waits for its peers, so no handshake is needed.
+    std::ostringstream push_connect_string;
+    if ( m_connect_host.empty() )
+    {
+      push_connect_string << "tcp://*:" << m_port;
+      LOG_TRACE( m_logger, "PUSH Bind for " << push_connect_string.str() );
+      m_pub_socket->bind( push_connect_string.str() );
+    }
+    else
+    {
+      push_connect_string << "tcp://" << m_connect_host << ":" << m_port;
+      LOG_TRACE( m_logger, "PUSH Connect for " << push_connect_string.str() );
+      m_pub_socket->connect( push_connect_string.str() );
+    }
+    return;
+  }
+
   // Bind to the publisher socket
   std::ostringstream pub_connect_string;
   pub_connect_string << "tcp://*:" << m_port;
   LOG_TRACE( m_logger, "PUB Connect for " << pub_connect_string.str() );
-  m_pub_socket.bind( pub_connect_string.str() );
+  m_pub_socket->bind( pub_connect_string.str() );
 
   // Wait for replies from expected number of subscribers before sending antying
   std::ostringstream sync_connect_string;
@@ -199,4 +431,50 @@ ::connect()
   LOG_TRACE( m_logger, "SYNC Loop done, all " << subscribers << " received" );
 }
 
+// ----------------------------------------------------------------------------
+void
+zmq_transport_send_process::priv
+::send( kwiver::vital::algo::message_parts const& parts )
+{
+  // Send each part as a frame of a multipart message. The frames refer to
+  // the bytes of the parts, which are held until ZeroMQ releases them.
+  for ( size_t i = 0; i < parts.size(); ++i )
+  {
+    auto const& part = parts[ i ];
+    LOG_TRACE( m_logger, "Sending datagram part of size " << part.size );
+    zmq::message_t datagram( const_cast< char* >( part.data ), part.size,
+                             release_message_part,
+                             new std::shared_ptr< void const >( part.owner ) );
+    m_pub_socket->send( datagram, i + 1 < parts.size() ? ZMQ_SNDMORE : 0 );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+zmq_transport_send_process::priv
+::send_batch()
+{
+  auto const header = std::make_shared< std::string >(
+    write_transport_envelope( m_pending_entries ) );
+
+  kwiver::vital::algo::message_parts frames;
+  frames.push_back( { header->data(), header->size(), header } );
+  for ( auto const& parts : m_pending )
+  {
+    for ( auto const& part : parts )
+    {
+      if ( part.size )
+      {
+        frames.push_back( part );
+      }
+    }
+  }
+
+  LOG_TRACE( m_logger, "Sending batch of " << m_pending.size() << " messages" );
+  send( frames );
+
+  m_pending.clear();
+  m_pending_entries.clear();
+}
+
 } // end namespace
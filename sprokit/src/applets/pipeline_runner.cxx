@@ -9,15 +9,41 @@
 #include <vital/config/config_block_io.h>
 #include <vital/plugin_loader/plugin_manager.h>
 #include <vital/util/get_paths.h>
+#include <vital/util/trace.h>
 
+#include <kwiversys/Process.h>
+#include <kwiversys/SystemTools.hxx>
+
+#include <sprokit/pipeline/latency_feedback.h>
+#include <sprokit/pipeline/object_pool.h>
 #include <sprokit/pipeline/pipeline.h>
 #include <sprokit/pipeline/scheduler.h>
 #include <sprokit/pipeline/scheduler_factory.h>
+#include <sprokit/pipeline_util/compiled_pipeline.h>
+#include <sprokit/pipeline_util/pipe_bakery.h>
+#include <sprokit/pipeline_util/pipe_declaration_types.h>
 #include <sprokit/pipeline_util/pipe_display.h>
 #include <sprokit/pipeline_util/pipeline_builder.h>
+#include <sprokit/pipeline_util/pipeline_partition.h>
+#include <sprokit/pipeline_util/pipeline_snapshot.h>
+
+#include <boost/chrono/duration.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
 #include <cstdlib>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace sprokit {
 
@@ -26,6 +52,578 @@ namespace tools {
 static const auto scheduler_block =
   kwiver::vital::config_block_key_t( "_scheduler" );
 
+// ----------------------------------------------------------------------------
+static double
+to_seconds( sprokit::edge_statistics_t::duration_t const& d )
+{
+  return boost::chrono::duration_cast< boost::chrono::duration< double > >( d ).count();
+}
+
+// ----------------------------------------------------------------------------
+/*
+ * Print one line per connection with its queue depth and the time the
+ * processes on either end spent blocked. Edges with producers blocked
+ * on them are downstream of a bottleneck; edges with consumers blocked
+ * on them are upstream of one.
+ */
+static void
+print_edge_statistics( std::ostream& str, sprokit::pipeline_t const& pipe )
+{
+  sprokit::connections_statistics_t const stats = pipe->connection_statistics();
+
+  str << "Edge statistics ("
+      << "pushed, dropped, mean/max depth, "
+      << "push blocked s, pop blocked s):\n";
+
+  for ( auto const& conn_stats : stats )
+  {
+    sprokit::process::connection_t const& conn = conn_stats.first;
+    sprokit::edge_statistics_t const& es = conn_stats.second;
+
+    str << "  " << conn.first.first << "." << conn.first.second
+        << " -> " << conn.second.first << "." << conn.second.second
+        << " : " << es.pushed
+        << ", " << es.dropped
+        << ", " << std::fixed << std::setprecision( 2 ) << es.mean_depth()
+        << "/" << es.max_depth
+        << ", " << std::setprecision( 3 ) << to_seconds( es.push_blocked_time )
+        << ", " << to_seconds( es.pop_blocked_time )
+        << "\n";
+  }
+
+  sprokit::object_pool_statistics_t const ps = sprokit::object_pool_statistics();
+
+  str << "Datum/stamp pool (allocated, reused, returned, released, cached): "
+      << ps.allocated
+      << ", " << ps.reused
+      << ", " << ps.returned
+      << ", " << ps.released
+      << ", " << ps.cached
+      << "\n";
+
+  for ( auto const& channel : sprokit::latency_channel::all_statistics() )
+  {
+    sprokit::latency_statistics_t const& ls = channel.second;
+
+    str << "Latency channel " << channel.first
+        << " (sent, dropped, finished, in flight/limit, p50/p99/max s): "
+        << ls.admitted
+        << ", " << ls.dropped
+        << ", " << ls.completed
+        << ", " << ls.in_flight << "/" << ls.limit
+        << ", " << std::setprecision( 3 ) << ls.latency_p50
+        << "/" << ls.latency_p99
+        << "/" << ls.latency_max
+        << "\n";
+  }
+
+  str.flush();
+}
+
+// ----------------------------------------------------------------------------
+/*
+ * Time accounting for one process over a run. Busy time is the time
+ * spent in steps less the time those steps were blocked on edges.
+ */
+struct process_profile
+{
+  process_profile()
+    : steps( 0 ), step_time( 0 ), input_wait( 0 ), output_wait( 0 ),
+      setup_time( 0 )
+  {
+  }
+
+  double busy() const
+  {
+    return std::max( 0.0, step_time - input_wait - output_wait );
+  }
+
+  double per_step() const
+  {
+    return ( steps ? busy() / steps : 0.0 );
+  }
+
+  size_t steps;
+  double step_time;
+  double input_wait;
+  double output_wait;
+  double setup_time;
+  std::vector< sprokit::process::name_t > downstream;
+};
+
+typedef std::map< sprokit::process::name_t, process_profile > profiles_t;
+
+// ----------------------------------------------------------------------------
+/*
+ * Find the most expensive path ending at a process, by time per datum.
+ */
+static double
+longest_path( profiles_t const& profiles,
+              sprokit::process::name_t const& name,
+              std::map< sprokit::process::name_t, double >& cost,
+              std::map< sprokit::process::name_t, sprokit::process::name_t >& prev )
+{
+  auto const known = cost.find( name );
+  if ( known != cost.end() )
+  {
+    return known->second;
+  }
+
+  // The pipeline is a DAG, so the recursion ends at the sources.
+  double best = 0;
+  for ( auto const& entry : profiles )
+  {
+    auto const& down = entry.second.downstream;
+    if ( std::find( down.begin(), down.end(), name ) != down.end() )
+    {
+      double const c = longest_path( profiles, entry.first, cost, prev );
+      if ( c > best || !prev.count( name ) )
+      {
+        best = c;
+        prev[ name ] = entry.first;
+      }
+    }
+  }
+
+  double const total = best + profiles.at( name ).per_step();
+  cost[ name ] = total;
+  return total;
+}
+
+// ----------------------------------------------------------------------------
+/*
+ * Collect the time accounting of every process in the pipeline.
+ */
+static profiles_t
+collect_profiles( sprokit::pipeline_t const& pipe )
+{
+  profiles_t profiles;
+
+  for ( auto const& name : pipe->process_names() )
+  {
+    sprokit::process_statistics_t const ps =
+      pipe->process_by_name( name )->statistics();
+
+    process_profile& prof = profiles[ name ];
+    prof.steps = ps.steps;
+    prof.step_time = to_seconds( ps.step_time );
+    prof.setup_time = to_seconds( ps.configure_time ) + to_seconds( ps.init_time );
+  }
+
+  for ( auto const& conn_stats : pipe->connection_statistics() )
+  {
+    sprokit::process::connection_t const& conn = conn_stats.first;
+    sprokit::edge_statistics_t const& es = conn_stats.second;
+
+    process_profile& up = profiles[ conn.first.first ];
+    process_profile& down = profiles[ conn.second.first ];
+
+    up.output_wait += to_seconds( es.push_blocked_time );
+    down.input_wait += to_seconds( es.pop_blocked_time );
+
+    if ( std::find( up.downstream.begin(), up.downstream.end(),
+                    conn.second.first ) == up.downstream.end() )
+    {
+      up.downstream.push_back( conn.second.first );
+    }
+  }
+
+  return profiles;
+}
+
+// ----------------------------------------------------------------------------
+/*
+ * Find the chain of processes with the largest total time per datum,
+ * from its source to its end. Returns the time per datum of the chain.
+ */
+static double
+critical_path( profiles_t const& profiles,
+               std::vector< sprokit::process::name_t >& path )
+{
+  // Find the end of the most expensive path, then walk it back.
+  std::map< sprokit::process::name_t, double > cost;
+  std::map< sprokit::process::name_t, sprokit::process::name_t > prev;
+  sprokit::process::name_t last;
+  double critical = 0;
+
+  for ( auto const& entry : profiles )
+  {
+    double const c = longest_path( profiles, entry.first, cost, prev );
+    if ( last.empty() || c > critical )
+    {
+      critical = c;
+      last = entry.first;
+    }
+  }
+
+  path.clear();
+  if ( !last.empty() )
+  {
+    path.push_back( last );
+    while ( prev.count( path.back() ) )
+    {
+      path.push_back( prev[ path.back() ] );
+    }
+    std::reverse( path.begin(), path.end() );
+  }
+
+  return critical;
+}
+
+// ----------------------------------------------------------------------------
+/*
+ * Print where each process spent the run and which process bounds the
+ * throughput of the pipeline.
+ *
+ * A process needs its busy time to handle its share of the data no
+ * matter how the pipeline is scheduled, so the run can take no less
+ * than the largest busy time of any process. Replicating a process
+ * divides its busy time among the replicas; the predicted gain is the
+ * ratio of that bound before and after doing so. The critical path is
+ * the chain of processes with the largest total time per datum, which
+ * bounds the latency of a single datum.
+ */
+static void
+print_profile( std::ostream& str, sprokit::pipeline_t const& pipe,
+               double elapsed )
+{
+  profiles_t const profiles = collect_profiles( pipe );
+
+  // The two largest busy times bound the run before and after
+  // replicating the busiest process.
+  sprokit::process::name_t bottleneck;
+  double max_busy = 0;
+  double second_busy = 0;
+
+  for ( auto const& entry : profiles )
+  {
+    double const busy = entry.second.busy();
+    if ( busy > max_busy )
+    {
+      second_busy = max_busy;
+      max_busy = busy;
+      bottleneck = entry.first;
+    }
+    else if ( busy > second_busy )
+    {
+      second_busy = busy;
+    }
+  }
+
+  double const span = ( elapsed > 0 ? elapsed : 1 );
+
+  str << "Process profile over " << std::fixed << std::setprecision( 3 )
+      << elapsed << " s "
+      << "(setup s, steps, busy ms/step, busy %, waiting on input %, "
+      << "waiting on output %, speedup from 2 replicas):\n";
+
+  for ( auto const& entry : profiles )
+  {
+    process_profile const& prof = entry.second;
+    double const busy = prof.busy();
+    double const others = ( entry.first == bottleneck ? second_busy : max_busy );
+    double const gain =
+      ( busy > 0 ? max_busy / std::max( busy / 2, others ) : 1.0 );
+
+    str << "  " << entry.first
+        << " : " << std::setprecision( 3 ) << prof.setup_time
+        << ", " << prof.steps
+        << ", " << std::setprecision( 3 ) << 1000 * prof.per_step()
+        << ", " << std::setprecision( 1 ) << 100 * busy / span
+        << ", " << 100 * prof.input_wait / span
+        << ", " << 100 * prof.output_wait / span
+        << ", " << std::setprecision( 2 ) << gain << "x"
+        << "\n";
+  }
+
+  if ( !bottleneck.empty() )
+  {
+    str << "Bottleneck: " << bottleneck << " (busy "
+        << std::setprecision( 3 ) << max_busy << " s, "
+        << std::setprecision( 1 ) << 100 * max_busy / span << "% of the run)\n";
+  }
+
+  std::vector< sprokit::process::name_t > path;
+  double const critical = critical_path( profiles, path );
+
+  if ( !path.empty() )
+  {
+    str << "Critical path (" << std::setprecision( 3 ) << 1000 * critical
+        << " ms per datum):";
+    for ( auto i = path.begin(); i != path.end(); ++i )
+    {
+      str << ( i == path.begin() ? " " : " -> " ) << *i;
+    }
+    str << "\n";
+  }
+
+  str.flush();
+}
+
+// ----------------------------------------------------------------------------
+static void
+write_json_string( std::ostream& str, std::string const& s )
+{
+  str << '"';
+  for ( char const c : s )
+  {
+    unsigned char const u = static_cast< unsigned char >( c );
+    if ( c == '"' || c == '\\' )
+    {
+      str << '\\' << c;
+    }
+    else if ( u < 0x20 )
+    {
+      static char const hex[] = "0123456789abcdef";
+      str << "\\u00" << hex[ u >> 4 ] << hex[ u & 0xf ];
+    }
+    else
+    {
+      str << c;
+    }
+  }
+  str << '"';
+}
+
+// ----------------------------------------------------------------------------
+/*
+ * Write the results of a benchmark run as JSON: the frame rate of the
+ * replayed sources, the time accounting of each process, the edge
+ * statistics, and the latency percentiles of any latency channels.
+ */
+static void
+write_benchmark_report( std::ostream& str, sprokit::pipeline_t const& pipe,
+                        std::vector< sprokit::process::name_t > const& sources,
+                        std::string const& scheduler_type,
+                        double elapsed, double cpu )
+{
+  profiles_t const profiles = collect_profiles( pipe );
+  double const span = ( elapsed > 0 ? elapsed : 1 );
+
+  // The last step of a source only marks it complete
+  size_t frames = 0;
+  for ( auto const& name : sources )
+  {
+    auto const prof = profiles.find( name );
+    if ( prof != profiles.end() && prof->second.steps > 0 )
+    {
+      frames += prof->second.steps - 1;
+    }
+  }
+
+  std::vector< sprokit::process::name_t > path;
+  double const critical = critical_path( profiles, path );
+
+  str << std::setprecision( 6 );
+  str << "{\n  \"scheduler\": ";
+  write_json_string( str, scheduler_type );
+  str << ",\n  \"sources\": [";
+  for ( size_t i = 0; i < sources.size(); ++i )
+  {
+    str << ( i ? ", " : "" );
+    write_json_string( str, sources[ i ] );
+  }
+  str << "],\n  \"frames\": " << frames
+      << ",\n  \"elapsed_s\": " << elapsed
+      << ",\n  \"fps\": " << frames / span
+      << ",\n  \"cpu_s\": " << cpu
+      << ",\n  \"critical_path_ms\": " << 1000 * critical
+      << ",\n  \"critical_path\": [";
+  for ( size_t i = 0; i < path.size(); ++i )
+  {
+    str << ( i ? ", " : "" );
+    write_json_string( str, path[ i ] );
+  }
+  str << "],\n  \"processes\": {";
+
+  bool first = true;
+  for ( auto const& entry : profiles )
+  {
+    process_profile const& prof = entry.second;
+
+    str << ( first ? "\n    " : ",\n    " );
+    write_json_string( str, entry.first );
+    str << ": { \"steps\": " << prof.steps
+        << ", \"setup_s\": " << prof.setup_time
+        << ", \"busy_s\": " << prof.busy()
+        << ", \"busy_ms_per_step\": " << 1000 * prof.per_step()
+        << ", \"busy_percent\": " << 100 * prof.busy() / span
+        << ", \"input_wait_s\": " << prof.input_wait
+        << ", \"output_wait_s\": " << prof.output_wait
+        << " }";
+    first = false;
+  }
+  str << "\n  },\n  \"edges\": [";
+
+  first = true;
+  for ( auto const& conn_stats : pipe->connection_statistics() )
+  {
+    sprokit::process::connection_t const& conn = conn_stats.first;
+    sprokit::edge_statistics_t const& es = conn_stats.second;
+
+    str << ( first ? "\n    " : ",\n    " ) << "{ \"from\": ";
+    write_json_string( str, conn.first.first + "." + conn.first.second );
+    str << ", \"to\": ";
+    write_json_string( str, conn.second.first + "." + conn.second.second );
+    str << ", \"pushed\": " << es.pushed
+        << ", \"dropped\": " << es.dropped
+        << ", \"mean_depth\": " << es.mean_depth()
+        << ", \"max_depth\": " << es.max_depth
+        << ", \"push_blocked_s\": " << to_seconds( es.push_blocked_time )
+        << ", \"pop_blocked_s\": " << to_seconds( es.pop_blocked_time )
+        << " }";
+    first = false;
+  }
+  str << "\n  ],\n  \"latency\": {";
+
+  first = true;
+  for ( auto const& channel : sprokit::latency_channel::all_statistics() )
+  {
+    sprokit::latency_statistics_t const& ls = channel.second;
+
+    str << ( first ? "\n    " : ",\n    " );
+    write_json_string( str, channel.first );
+    str << ": { \"sent\": " << ls.admitted
+        << ", \"dropped\": " << ls.dropped
+        << ", \"finished\": " << ls.completed
+        << ", \"p50_s\": " << ls.latency_p50
+        << ", \"p99_s\": " << ls.latency_p99
+        << ", \"max_s\": " << ls.latency_max
+        << " }";
+    first = false;
+  }
+  str << ( first ? "}\n}\n" : "\n  }\n}\n" );
+
+  str.flush();
+}
+
+// ----------------------------------------------------------------------------
+/*
+ * Run the part of the pipeline on each node in a process of its own,
+ * by running this applet again with --node. The node's launch command,
+ * such as "ssh host", is put in front of the command, so the same
+ * install and file paths must be valid on every node. If any part
+ * fails the others are killed, since they would wait for it forever.
+ */
+static int
+launch_nodes( sprokit::pipeline_nodes_t const& nodes,
+              std::string const& applet,
+              std::vector< std::string > const& args )
+{
+  std::string const program =
+    kwiver::vital::get_executable_path() + "/kwiver";
+
+  std::vector< kwiversysProcess* > children;
+
+  for ( auto const& node : nodes )
+  {
+    std::vector< std::string > command;
+
+    std::istringstream launch( node.launch );
+    std::string word;
+    while ( launch >> word )
+    {
+      command.push_back( word );
+    }
+
+    command.push_back( program );
+    command.push_back( applet );
+
+    // Skip the program name and the launch flag itself
+    for ( size_t i = 1; i < args.size(); ++i )
+    {
+      if ( args[ i ] != "--launch" )
+      {
+        command.push_back( args[ i ] );
+      }
+    }
+
+    command.push_back( "--node" );
+    command.push_back( node.name );
+
+    std::vector< char const* > argv;
+    for ( auto const& arg : command )
+    {
+      argv.push_back( arg.c_str() );
+    }
+    argv.push_back( nullptr );
+
+    kwiversysProcess* const cp = kwiversysProcess_New();
+    kwiversysProcess_SetCommand( cp, argv.data() );
+    kwiversysProcess_SetPipeShared( cp, kwiversysProcess_Pipe_STDOUT, 1 );
+    kwiversysProcess_SetPipeShared( cp, kwiversysProcess_Pipe_STDERR, 1 );
+    kwiversysProcess_Execute( cp );
+
+    std::cerr << "Started node " << node.name << std::endl;
+    children.push_back( cp );
+  }
+
+  int result = EXIT_SUCCESS;
+  size_t running = children.size();
+  std::vector< bool > done( children.size(), false );
+
+  while ( running > 0 )
+  {
+    for ( size_t i = 0; i < children.size(); ++i )
+    {
+      if ( done[ i ] )
+      {
+        continue;
+      }
+
+      double timeout = 0.1;
+      if ( !kwiversysProcess_WaitForExit( children[ i ], &timeout ) )
+      {
+        continue;
+      }
+
+      done[ i ] = true;
+      --running;
+
+      int const state = kwiversysProcess_GetState( children[ i ] );
+      bool const ok = ( state == kwiversysProcess_State_Exited &&
+                        kwiversysProcess_GetExitValue( children[ i ] ) == 0 );
+
+      if ( ok || result != EXIT_SUCCESS )
+      {
+        continue;
+      }
+
+      std::cerr << "Error: Node " << nodes[ i ].name << " failed";
+      if ( state == kwiversysProcess_State_Exited )
+      {
+        std::cerr << " with exit code "
+                  << kwiversysProcess_GetExitValue( children[ i ] );
+      }
+      else if ( state == kwiversysProcess_State_Exception )
+      {
+        std::cerr << ": " << kwiversysProcess_GetExceptionString( children[ i ] );
+      }
+      else if ( state == kwiversysProcess_State_Error )
+      {
+        std::cerr << ": " << kwiversysProcess_GetErrorString( children[ i ] );
+      }
+      std::cerr << "; stopping the other nodes" << std::endl;
+
+      result = EXIT_FAILURE;
+      for ( size_t j = 0; j < children.size(); ++j )
+      {
+        if ( !done[ j ] )
+        {
+          kwiversysProcess_Kill( children[ j ] );
+        }
+      }
+    }
+  }
+
+  for ( auto const cp : children )
+  {
+    kwiversysProcess_Delete( cp );
+  }
+
+  return result;
+}
+
 // ----------------------------------------------------------------------------
 pipeline_runner
 ::pipeline_runner()
@@ -57,6 +655,62 @@ ::add_command_options()
     ( "S,scheduler", "Scheduler type to use.", cxxopts::value<std::string>() )
     ( "D,dump-pipe", "Dump final pipeline configuration. This is useful for "
       "debugging config related problems." )
+    ( "compiled", "Load the pipe file and supplemental configuration files "
+      "from the given compiled pipeline file when none of the files has "
+      "changed since it was written, and otherwise parse them and write "
+      "the file, so that later runs skip parsing. Settings are applied "
+      "after loading.", cxxopts::value<std::string>() )
+    ;
+
+  m_cmd_options->add_options("stats")
+    ( "edge-stats", "Print edge occupancy and blocking statistics, and "
+      "datum pool and latency channel counters, when the pipeline completes." )
+    ( "edge-stats-interval", "Also print edge statistics every N seconds "
+      "while the pipeline is running.", cxxopts::value<double>() )
+    ( "trace", "Record algorithm trace scopes and write them to the given "
+      "file as Chrome trace JSON (viewable in chrome://tracing or "
+      "ui.perfetto.dev).", cxxopts::value<std::string>() )
+    ( "profile", "Print per-process setup time, utilization, time waiting "
+      "on input and output, the bottleneck and critical path, and the "
+      "predicted speedup from replicating each process, when the pipeline "
+      "completes." )
+    ;
+
+  m_cmd_options->add_options("benchmark")
+    ( "benchmark", "Run the pipeline as a benchmark and write a JSON report "
+      "of the frame rate, per-process busy time, edge statistics and "
+      "latency channel percentiles to the given file, or to standard "
+      "output for \"-\". The benchmark sources read their first frames "
+      "before the run starts and replay them from memory, so reading and "
+      "decoding are not timed.", cxxopts::value<std::string>() )
+    ( "benchmark-source", "Name of a video_input process to replay. Can "
+      "occur multiple times. By default every video_input process is "
+      "replayed.", cxxopts::value<std::vector<std::string>>() )
+    ( "benchmark-frames", "Number of frames each source reads ahead.",
+      cxxopts::value<size_t>()->default_value( "100" ) )
+    ( "benchmark-loops", "Number of times each source sends its frames.",
+      cxxopts::value<size_t>()->default_value( "10" ) )
+    ;
+
+  m_cmd_options->add_options("state")
+    ( "checkpoint", "Periodically save the state of the processes, such as "
+      "active tracks, to the given file, and once more when the pipeline "
+      "completes.", cxxopts::value<std::string>() )
+    ( "checkpoint-interval", "Seconds between checkpoints.",
+      cxxopts::value<double>()->default_value( "60" ) )
+    ( "resume", "Restore the state of the processes from the given file, "
+      "written by --checkpoint, before running. A missing file is not an "
+      "error, so the same file may be passed to both options.",
+      cxxopts::value<std::string>() )
+    ;
+
+  m_cmd_options->add_options("distributed")
+    ( "node", "Run only the part of the pipeline on the given node, as "
+      "assigned with _node. Data crossing to and from other nodes is "
+      "sent over the network.", cxxopts::value<std::string>() )
+    ( "launch", "Run the part of the pipeline on every node, each with "
+      "the node's launch command, and wait for all of them. All other "
+      "options are passed on to each part." )
     ;
 
     // positional parameters
@@ -111,19 +765,75 @@ ::run()
   // Load the pipeline file.
   kwiver::vital::path_t const pipe_file(
     cmd_args[ "pipe-file" ].as< std::string >() );
-  builder.load_pipeline( pipe_file );
 
-  // Must be applied after pipe file is loaded.
-  // To overwrite any existing settings
+  std::vector< std::string > config_file_names;
   if( cmd_args.count( "config" ) > 0 )
   {
-    std::vector< std::string > config_file_names =
-      cmd_args[ "config" ].as< std::vector< std::string > >();
+    config_file_names = cmd_args[ "config" ].as< std::vector< std::string > >();
+  }
+
+  // The compiled pipeline is only used for the same files and includes
+  std::string compiled_file;
+  std::string compiled_key;
+  bool compiled_loaded = false;
 
+  if( cmd_args.count( "compiled" ) > 0 )
+  {
+    compiled_file = cmd_args[ "compiled" ].as< std::string >();
+    compiled_key = "pipe " + kwiversys::SystemTools::CollapseFullPath( pipe_file );
+    for( const auto& config : config_file_names )
+    {
+      compiled_key += "\nconfig " + kwiversys::SystemTools::CollapseFullPath( config );
+    }
+    if( cmd_args.count( "include" ) > 0 )
+    {
+      for( const auto& dir : cmd_args[ "include" ].as< std::vector< std::string > >() )
+      {
+        compiled_key += "\ninclude " + dir;
+      }
+    }
+
+    try
+    {
+      sprokit::pipe_blocks compiled_blocks;
+      compiled_loaded = sprokit::read_compiled_pipeline(
+        compiled_file, compiled_key, compiled_blocks );
+      if( compiled_loaded )
+      {
+        builder.load_blocks( compiled_blocks );
+      }
+    }
+    catch( std::exception const& e )
+    {
+      std::cerr << "Warning: Ignoring compiled pipeline: " << e.what()
+                << std::endl;
+    }
+  }
+
+  if( !compiled_loaded )
+  {
+    builder.load_pipeline( pipe_file );
+
+    // Must be applied after pipe file is loaded.
+    // To overwrite any existing settings
     for( const auto& config : config_file_names )
     {
       builder.load_supplement( config );
     }
+
+    if( !compiled_file.empty() )
+    {
+      try
+      {
+        sprokit::write_compiled_pipeline(
+          compiled_file, builder.pipeline_blocks(), compiled_key );
+      }
+      catch( std::exception const& e )
+      {
+        std::cerr << "Warning: Unable to write compiled pipeline: "
+                  << e.what() << std::endl;
+      }
+    }
   }
 
   // Add accumulated settings to the pipeline
@@ -137,11 +847,109 @@ ::run()
     }
   }
 
+  sprokit::pipe_blocks blocks = builder.pipeline_blocks();
+
+  // Replace the benchmark sources with a replay from memory
+  std::vector< sprokit::process::name_t > benchmark_sources;
+  std::string benchmark_file;
+
+  if( cmd_args.count( "benchmark" ) > 0 )
+  {
+    benchmark_file = cmd_args[ "benchmark" ].as< std::string >();
+
+    std::vector< std::string > requested;
+    if( cmd_args.count( "benchmark-source" ) > 0 )
+    {
+      requested =
+        cmd_args[ "benchmark-source" ].as< std::vector< std::string > >();
+    }
+
+    for( auto const& block : blocks )
+    {
+      auto const* const proc =
+        kwiver::vital::get_if< sprokit::process_pipe_block >( &block );
+      if( !proc )
+      {
+        continue;
+      }
+
+      auto const pos =
+        std::find( requested.begin(), requested.end(), proc->name );
+      if( pos == requested.end() && !( requested.empty() &&
+                                       proc->type == "video_input" ) )
+      {
+        continue;
+      }
+
+      if( proc->type != "video_input" )
+      {
+        std::cerr << "Error: Benchmark source \"" << proc->name
+                  << "\" is a " << proc->type
+                  << " process; only video_input can be replayed"
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      if( pos != requested.end() )
+      {
+        requested.erase( pos );
+      }
+      benchmark_sources.push_back( proc->name );
+    }
+
+    if( !requested.empty() )
+    {
+      std::cerr << "Error: Benchmark source \"" << requested.front()
+                << "\" is not in the pipeline" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    if( benchmark_sources.empty() )
+    {
+      std::cerr << "Error: The pipeline has no video_input process to "
+                << "replay" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    std::string const frames =
+      std::to_string( cmd_args[ "benchmark-frames" ].as< size_t >() );
+    std::string const loops =
+      std::to_string( cmd_args[ "benchmark-loops" ].as< size_t >() );
+
+    for( auto const& name : benchmark_sources )
+    {
+      builder.add_setting( name + ":replay_frames=" + frames );
+      builder.add_setting( name + ":replay_loops=" + loops );
+    }
+
+    blocks = builder.pipeline_blocks();
+  }
+
+  if( cmd_args[ "launch" ].as< bool >() )
+  {
+    if( cmd_args.count( "node" ) > 0 )
+    {
+      std::cerr << "Error: --launch and --node may not be used together"
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    return launch_nodes( sprokit::pipeline_nodes( blocks ), opt_app_name,
+                         applet_args() );
+  }
+
+  if( cmd_args.count( "node" ) > 0 )
+  {
+    blocks = sprokit::partition_pipe_blocks(
+      blocks, cmd_args[ "node" ].as< std::string >() );
+  }
+
   // Get handle to pipeline
-  sprokit::pipeline_t const pipe = builder.pipeline();
+  sprokit::pipeline_t const pipe = sprokit::bake_pipe_blocks( blocks );
 
   // get handle to config block
-  kwiver::vital::config_block_sptr const conf = builder.config();
+  kwiver::vital::config_block_sptr const conf =
+    sprokit::extract_configuration( blocks );
 
   // nice to dump config at this point
   if( cmd_args[ "dump-pipe" ].as< bool >() )
@@ -150,7 +958,7 @@ ::run()
 
     sprokit::pipe_display pd( std::cout );
     pd.print_loc();
-    pd.display_pipe_blocks( builder.pipeline_blocks() );
+    pd.display_pipe_blocks( blocks );
 
     return EXIT_SUCCESS;
   }
@@ -164,6 +972,21 @@ ::run()
   // Get pipeline ready to run
   pipe->setup_pipeline();
 
+  if( cmd_args.count( "resume" ) > 0 )
+  {
+    std::string const snapshot = cmd_args[ "resume" ].as< std::string >();
+
+    if( std::ifstream( snapshot ) )
+    {
+      pipe->restore_state( sprokit::read_pipeline_snapshot( snapshot ) );
+    }
+    else
+    {
+      std::cerr << "No snapshot \"" << snapshot
+                << "\" to resume from; starting fresh" << std::endl;
+    }
+  }
+
   //
   // Check for scheduler specification in config block
   //
@@ -198,9 +1021,127 @@ ::run()
     return EXIT_FAILURE;
   }
 
+  bool const edge_stats = cmd_args[ "edge-stats" ].as< bool >();
+  double stats_interval = 0;
+
+  if( cmd_args.count( "edge-stats-interval" ) > 0 )
+  {
+    stats_interval = cmd_args[ "edge-stats-interval" ].as< double >();
+  }
+
+  std::string trace_file;
+
+  if( cmd_args.count( "trace" ) > 0 )
+  {
+    trace_file = cmd_args[ "trace" ].as< std::string >();
+    kwiver::vital::set_trace_enabled( true );
+  }
+
+  bool const profile = cmd_args[ "profile" ].as< bool >();
+  auto const start_time = std::chrono::steady_clock::now();
+  std::clock_t const start_cpu = std::clock();
+
   scheduler->start();
+
+  std::unique_ptr< sprokit::pipeline_checkpointer > checkpointer;
+
+  if( cmd_args.count( "checkpoint" ) > 0 )
+  {
+    checkpointer.reset( new sprokit::pipeline_checkpointer(
+      pipe, cmd_args[ "checkpoint" ].as< std::string >(),
+      cmd_args[ "checkpoint-interval" ].as< double >() ) );
+  }
+
+  // Periodically report edge statistics until the pipeline is done.
+  std::mutex stats_mutex;
+  std::condition_variable stats_cond;
+  bool running = true;
+  std::thread stats_thread;
+
+  if( stats_interval > 0 )
+  {
+    auto const interval = std::chrono::duration< double >( stats_interval );
+
+    stats_thread = std::thread( [&]() {
+      std::unique_lock< std::mutex > lock( stats_mutex );
+
+      while( !stats_cond.wait_for( lock, interval, [&running]() { return !running; } ) )
+      {
+        print_edge_statistics( std::cerr, pipe );
+      }
+    } );
+  }
+
   scheduler->wait();
 
+  double const elapsed = std::chrono::duration< double >(
+    std::chrono::steady_clock::now() - start_time ).count();
+  double const cpu =
+    static_cast< double >( std::clock() - start_cpu ) / CLOCKS_PER_SEC;
+
+  if( checkpointer )
+  {
+    checkpointer->stop( true );
+  }
+
+  if( stats_thread.joinable() )
+  {
+    {
+      std::lock_guard< std::mutex > const lock( stats_mutex );
+      running = false;
+    }
+
+    stats_cond.notify_one();
+    stats_thread.join();
+  }
+
+  if( edge_stats )
+  {
+    print_edge_statistics( std::cout, pipe );
+  }
+
+  if( profile )
+  {
+    print_profile( std::cout, pipe, elapsed );
+  }
+
+  if( !benchmark_file.empty() )
+  {
+    if( benchmark_file == "-" )
+    {
+      write_benchmark_report( std::cout, pipe, benchmark_sources,
+                              scheduler_type, elapsed, cpu );
+    }
+    else
+    {
+      std::ofstream report( benchmark_file );
+      if( !report )
+      {
+        std::cerr << "Error: Unable to open benchmark report \""
+                  << benchmark_file << "\"" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      write_benchmark_report( report, pipe, benchmark_sources,
+                              scheduler_type, elapsed, cpu );
+    }
+  }
+
+  if( !trace_file.empty() )
+  {
+    kwiver::vital::set_trace_enabled( false );
+
+    std::ofstream trace_stream( trace_file );
+    if( !trace_stream )
+    {
+      std::cerr << "Error: Unable to open trace file \""
+                << trace_file << "\"" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    kwiver::vital::write_trace( trace_stream );
+  }
+
   return EXIT_SUCCESS;
 }
 
@@ -182,6 +182,13 @@ ::run(pipeline_t const& pipe)
   for (process::name_t const& name : names)
   {
     process_t const proc = pipe->process_by_name(name);
+
+    // Fused processes are stepped by the process they are fused onto.
+    if (proc->is_fused())
+    {
+      continue;
+    }
+
     edge_t const monitor_edge = std::make_shared<edge>(edge_conf);
 
     proc->connect_output_port(process::port_heartbeat, monitor_edge);
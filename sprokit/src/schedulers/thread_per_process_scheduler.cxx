@@ -16,6 +16,9 @@
 #include <boost/thread/shared_mutex.hpp>
 #include <boost/thread/thread.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <map>
 #include <memory>
 #include <sstream>
 
@@ -34,16 +37,40 @@ class thread_per_process_scheduler::priv
     priv();
     ~priv();
 
+    // Where and how the thread of a process runs
+    struct thread_settings_t
+    {
+      thread_settings_t();
+
+      cpu_list_t cpus;
+      bool set_priority;
+      int priority;
+    };
+
     void run_process(process_t const& process);
+    void apply_thread_settings(process_t const& process) const;
+
+    static thread_settings_t read_thread_settings(process_t const& process);
 
     std::unique_ptr<boost::thread_group> process_threads;
+    std::map<process::name_t, thread_settings_t> thread_settings;
+
+    kwiver::vital::logger_handle_t m_logger;
 
     typedef boost::shared_mutex mutex_t;
     typedef boost::shared_lock<mutex_t> shared_lock_t;
 
     mutable mutex_t m_pause_mutex;
+
+    static kwiver::vital::config_block_key_t const config_affinity;
+    static kwiver::vital::config_block_key_t const config_numa_node;
+    static kwiver::vital::config_block_key_t const config_priority;
 };
 
+kwiver::vital::config_block_key_t const thread_per_process_scheduler::priv::config_affinity = kwiver::vital::config_block_key_t("_affinity");
+kwiver::vital::config_block_key_t const thread_per_process_scheduler::priv::config_numa_node = kwiver::vital::config_block_key_t("_numa_node");
+kwiver::vital::config_block_key_t const thread_per_process_scheduler::priv::config_priority = kwiver::vital::config_block_key_t("_priority");
+
 // ------------------------------------------------------------------
 thread_per_process_scheduler
 ::thread_per_process_scheduler(pipeline_t const& pipe,
@@ -52,6 +79,7 @@ ::thread_per_process_scheduler(pipeline_t const& pipe,
   , d(new priv)
 {
   m_logger = kwiver::vital::get_logger( "scheduler.thread_per_process" );
+  d->m_logger = m_logger;
 
   pipeline_t const p = pipeline();
 
@@ -77,6 +105,12 @@ ::thread_per_process_scheduler(pipeline_t const& pipe,
     auto proc = p->process_by_name(name);
     process::properties_t const consts = proc->properties();
 
+    // A fused process runs in the thread of the process it is fused onto.
+    if (proc->is_fused())
+    {
+      continue;
+    }
+
     if (consts.count(process::property_no_threads))
     {
       std::string const reason =
@@ -84,6 +118,8 @@ ::thread_per_process_scheduler(pipeline_t const& pipe,
 
       VITAL_THROW( incompatible_pipeline_exception, reason);
     }
+
+    d->thread_settings[name] = priv::read_thread_settings(proc);
   }
 }
 
@@ -108,6 +144,12 @@ ::_start()
   {
     process_t const process = pipeline()->process_by_name(name);
 
+    // Fused processes are stepped by the process they are fused onto.
+    if (process->is_fused())
+    {
+      continue;
+    }
+
     d->process_threads->create_thread(std::bind(&priv::run_process, d.get(), process));
   }
 }
@@ -148,6 +190,7 @@ ::_stop()
 thread_per_process_scheduler::priv
 ::priv()
   : process_threads()
+  , thread_settings()
   , m_pause_mutex()
 {
 }
@@ -158,6 +201,122 @@ thread_per_process_scheduler::priv
 {
 }
 
+// ------------------------------------------------------------------
+thread_per_process_scheduler::priv::thread_settings_t
+::thread_settings_t()
+  : cpus()
+  , set_priority(false)
+  , priority(0)
+{
+}
+
+// ------------------------------------------------------------------
+/*
+ * Read the CPUs and priority requested for the thread of a process. A
+ * NUMA node and a CPU list together restrict the thread to the CPUs of
+ * the node that are in the list.
+ */
+thread_per_process_scheduler::priv::thread_settings_t
+thread_per_process_scheduler::priv
+::read_thread_settings(process_t const& process)
+{
+  kwiver::vital::config_block_sptr const conf = process->special_config();
+  thread_settings_t settings;
+
+  if (conf->has_value(config_affinity))
+  {
+    std::string const spec = conf->get_value<std::string>(config_affinity);
+
+    if (!parse_cpu_list(spec, settings.cpus))
+    {
+      std::string const reason =
+        "The process \'" + process->name() + "\' has an invalid CPU list "
+        "for " + config_affinity + ": \'" + spec + "\'.";
+
+      VITAL_THROW( incompatible_pipeline_exception, reason);
+    }
+  }
+
+  if (conf->has_value(config_numa_node))
+  {
+    unsigned const node = conf->get_value<unsigned>(config_numa_node);
+    cpu_list_t const node_cpus = numa_node_cpus(node);
+
+    if (node_cpus.empty())
+    {
+      std::ostringstream reason;
+      reason << "The process \'" << process->name() << "\' requests NUMA node "
+             << node << ", which does not exist on this system.";
+
+      VITAL_THROW( incompatible_pipeline_exception, reason.str());
+    }
+
+    if (settings.cpus.empty())
+    {
+      settings.cpus = node_cpus;
+    }
+    else
+    {
+      cpu_list_t cpus;
+      std::set_intersection(settings.cpus.begin(), settings.cpus.end(),
+                            node_cpus.begin(), node_cpus.end(),
+                            std::back_inserter(cpus));
+
+      if (cpus.empty())
+      {
+        std::ostringstream reason;
+        reason << "None of the CPUs in " << config_affinity << " of the process \'"
+               << process->name() << "\' are on NUMA node " << node << ".";
+
+        VITAL_THROW( incompatible_pipeline_exception, reason.str());
+      }
+
+      settings.cpus = cpus;
+    }
+  }
+
+  if (conf->has_value(config_priority))
+  {
+    settings.set_priority = true;
+    settings.priority = conf->get_value<int>(config_priority);
+  }
+
+  return settings;
+}
+
+// ------------------------------------------------------------------
+/*
+ * Apply the settings of a process to the calling thread. Failures are
+ * only warned about, since the pipeline still runs correctly without
+ * them.
+ */
+void
+thread_per_process_scheduler::priv
+::apply_thread_settings(process_t const& process) const
+{
+  std::map<process::name_t, thread_settings_t>::const_iterator const i =
+    thread_settings.find(process->name());
+
+  if (i == thread_settings.end())
+  {
+    return;
+  }
+
+  thread_settings_t const& settings = i->second;
+
+  if (!settings.cpus.empty() && !pin_thread(settings.cpus))
+  {
+    LOG_WARN( m_logger, "Unable to set the CPU affinity of the thread for process \""
+              << process->name() << "\"" );
+  }
+
+  if (settings.set_priority && !set_thread_priority(settings.priority))
+  {
+    LOG_WARN( m_logger, "Unable to set the priority of the thread for process \""
+              << process->name() << "\" to " << settings.priority );
+  }
+}
+
 static kwiver::vital::config_block_sptr monitor_edge_config();
 
 // ------------------------------------------------------------------
@@ -173,6 +332,8 @@ ::run_process(process_t const& process)
   kwiver::vital::config_block_sptr const edge_conf = monitor_edge_config();
 
   name_thread(process->name());
+  apply_thread_settings(process);
+
   edge_t monitor_edge = std::make_shared<edge>(edge_conf);
 
   process->connect_output_port(process::port_heartbeat, monitor_edge);
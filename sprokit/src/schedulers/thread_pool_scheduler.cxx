@@ -0,0 +1,1215 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "thread_pool_scheduler.h"
+
+#include <vital/config/config_block.h>
+#include <vital/config/config_block_exception.h>
+
+#include <sprokit/pipeline/datum.h>
+#include <sprokit/pipeline/edge.h>
+#include <sprokit/pipeline/pipeline.h>
+#include <sprokit/pipeline/scheduler_exception.h>
+#include <sprokit/pipeline/utils.h>
+
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * \file thread_pool_scheduler.cxx
+ *
+ * \brief Implementation of the thread pool scheduler.
+ */
+
+namespace sprokit
+{
+
+static thread_name_t const thread_name = thread_name_t("thread_pool_worker");
+
+// How long an idle worker parks before rescanning for ready processes.
+static boost::chrono::milliseconds const idle_wait = boost::chrono::milliseconds(5);
+
+namespace
+{
+
+// ----------------------------------------------------------------------------
+// A pipeline whose processes are stepped by the workers of a pool.
+class pool_job
+{
+  public:
+    pool_job();
+    virtual ~pool_job() = default;
+
+    // Do one piece of work for the pipeline on the given worker.
+    // Returns false if there was nothing to do.
+    virtual bool run_one(size_t worker) = 0;
+
+    void acquire();
+    void release();
+    void wait_released();
+
+  private:
+    std::atomic<size_t> active;
+    boost::mutex release_mutex;
+    boost::condition_variable release_cond;
+};
+
+// ----------------------------------------------------------------------------
+// A set of worker threads which step the processes of one or more
+// pipelines. Workers go round the pipelines, taking one step from each
+// which has a ready process, and park when none has.
+class worker_pool
+{
+  public:
+    worker_pool(size_t num_threads_);
+    ~worker_pool();
+
+    void add(pool_job* job);
+    // Waits until no worker is using the job.
+    void remove(pool_job* job);
+
+    void notify_one();
+    void notify_all();
+    void interrupt_all();
+
+    // Get the pool shared under the given name, creating it if needed.
+    static std::shared_ptr<worker_pool> shared(std::string const& name, size_t num_threads);
+
+    size_t const num_threads;
+
+  private:
+    void run_worker(size_t worker);
+
+    boost::mutex jobs_mutex;
+    std::vector<pool_job*> jobs;
+    bool started;
+
+    boost::mutex park_mutex;
+    boost::condition_variable park_cond;
+
+    std::atomic<bool> stopping;
+    boost::thread_group threads;
+};
+
+}
+
+class thread_pool_scheduler::priv
+  : public pool_job
+{
+  public:
+    priv(std::shared_ptr<worker_pool> const& pool_, bool shared_pool_);
+    ~priv();
+
+    enum task_state_t
+    {
+      task_idle,
+      task_queued,
+      task_running,
+      task_complete
+    };
+
+    // An input edge and the number of data it must hold for one step.
+    typedef std::pair<edge_t, size_t> input_requirement_t;
+
+    class task_t
+    {
+      public:
+        task_t(process_t const& proc);
+
+        process_t const process;
+        edge_t monitor_edge;
+
+        std::vector<input_requirement_t> inputs;
+        edges_t outputs;
+
+        // Processes which may become ready when this one steps.
+        std::vector<size_t> neighbors;
+
+        // Require all inputs, or only one, to hold data.
+        bool any_input;
+        // Must always run on the first worker.
+        bool pinned;
+        // Higher priority tasks are run first.
+        int priority;
+
+        std::atomic<int> state;
+    };
+
+    class worker_queue_t
+    {
+      public:
+        boost::mutex mutex;
+        std::deque<size_t> tasks;
+        // Tasks which may not be stolen by another worker.
+        std::deque<size_t> pinned;
+    };
+
+    void read_priorities(pipeline_t const& pipe);
+    int branch_priority(pipeline_t const& pipe,
+                        process::name_t const& name,
+                        std::map<process::name_t, int> const& explicit_priorities,
+                        std::set<process::name_t>& visiting);
+    void build_tasks(pipeline_t const& pipe);
+
+    bool run_one(size_t worker) override;
+    void run_task(size_t worker, size_t task);
+    void finish();
+
+    bool next_task(size_t worker, size_t& task);
+    bool next_prioritized_task(size_t worker, size_t& task);
+    bool enqueue_if_ready(size_t worker, size_t task);
+    bool enqueue_ready(size_t worker);
+    bool is_ready(task_t const& task) const;
+
+    std::shared_ptr<worker_pool> pool;
+    bool const shared_pool;
+    size_t const num_threads;
+    bool registered;
+
+    std::vector<std::unique_ptr<task_t>> tasks;
+    std::vector<std::unique_ptr<worker_queue_t>> queues;
+
+    // The priority of each process, including those it inherits from
+    // the branches it feeds. Empty unless some process sets one.
+    std::map<process::name_t, int> priorities;
+    bool prioritized;
+
+    // With priorities, ready tasks which may run on any worker are kept
+    // in one queue ordered by priority instead of per-worker deques.
+    boost::mutex ready_mutex;
+    std::multimap<int, size_t, std::greater<int>> ready;
+
+    std::atomic<size_t> remaining;
+    std::atomic<bool> done;
+    std::atomic<bool> paused;
+
+    boost::mutex done_mutex;
+    boost::condition_variable done_cond;
+
+    typedef boost::shared_mutex mutex_t;
+    typedef boost::shared_lock<mutex_t> shared_lock_t;
+
+    mutable mutex_t m_pause_mutex;
+
+    static kwiver::vital::config_block_key_t const config_num_threads;
+    static kwiver::vital::config_block_key_t const config_pool;
+    static kwiver::vital::config_block_key_t const config_priority;
+};
+
+kwiver::vital::config_block_key_t const thread_pool_scheduler::priv::config_num_threads = kwiver::vital::config_block_key_t("num_threads");
+kwiver::vital::config_block_key_t const thread_pool_scheduler::priv::config_pool = kwiver::vital::config_block_key_t("pool");
+kwiver::vital::config_block_key_t const thread_pool_scheduler::priv::config_priority = kwiver::vital::config_block_key_t("_schedule_priority");
+
+static kwiver::vital::config_block_sptr monitor_edge_config();
+
+// ------------------------------------------------------------------
+thread_pool_scheduler
+::thread_pool_scheduler(pipeline_t const& pipe, kwiver::vital::config_block_sptr const& config)
+  : scheduler(pipe, config)
+  , d()
+{
+  m_logger = kwiver::vital::get_logger( "scheduler.thread_pool" );
+
+  pipeline_t const p = pipeline();
+
+  processes_t procs = p->get_python_processes();
+  if( ! procs.empty() )
+  {
+    std::stringstream str;
+    str << "This pipeline contains the following python processes which are not supported by this scheduler.\n";
+    for ( auto proc : procs )
+    {
+      str << "      \"" << proc->name() << "\" of type \"" << proc->type() << "\"\n";
+    }
+
+    VITAL_THROW( incompatible_pipeline_exception, str.str());
+  }
+
+  size_t num_threads = config->get_value<size_t>(priv::config_num_threads, 0);
+  std::string const pool_name = config->get_value<std::string>(priv::config_pool, "");
+
+  if (!num_threads)
+  {
+    num_threads = boost::thread::hardware_concurrency();
+  }
+
+  // A process with unsynchronized inputs is ready when any of its inputs
+  // has data, but its step may grab from another one and block its worker
+  // until that input is filled. Leave a worker for the rest of the
+  // pipeline even when every such process is blocked.
+  process::names_t const names = p->process_names();
+  size_t min_threads = 1;
+
+  for (process::name_t const& name : names)
+  {
+    if (p->process_by_name(name)->properties().count(process::property_unsync_input))
+    {
+      ++min_threads;
+    }
+  }
+
+  std::shared_ptr<worker_pool> pool;
+
+  if (pool_name.empty())
+  {
+    // There is no point in having more workers than processes.
+    num_threads = std::max(min_threads, std::min(num_threads, names.size()));
+    pool = std::make_shared<worker_pool>(num_threads);
+
+    LOG_DEBUG( m_logger, "Using " << num_threads << " worker threads" );
+  }
+  else
+  {
+    pool = worker_pool::shared(pool_name, std::max(min_threads, num_threads));
+
+    LOG_DEBUG( m_logger, "Using shared pool \"" << pool_name << "\" of "
+               << pool->num_threads << " worker threads" );
+
+    if (pool->num_threads < min_threads)
+    {
+      LOG_WARN( m_logger, "Shared pool \"" << pool_name << "\" has "
+                << pool->num_threads << " worker threads, but this pipeline "
+                "may block " << (min_threads - 1) << " of them in processes "
+                "with unsynchronized inputs" );
+    }
+  }
+
+  d.reset(new priv(pool, !pool_name.empty()));
+  d->read_priorities(p);
+
+  for (auto const& entry : d->priorities)
+  {
+    LOG_DEBUG( m_logger, "Process \"" << entry.first << "\" has priority "
+               << entry.second );
+  }
+}
+
+// ------------------------------------------------------------------
+thread_pool_scheduler
+::~thread_pool_scheduler()
+{
+  shutdown();
+}
+
+// ------------------------------------------------------------------
+void
+thread_pool_scheduler
+::_start()
+{
+  d->build_tasks(pipeline());
+
+  d->registered = true;
+  d->pool->add(d.get());
+}
+
+// ------------------------------------------------------------------
+void
+thread_pool_scheduler
+::_wait()
+{
+  {
+    boost::unique_lock<boost::mutex> lock(d->done_mutex);
+
+    while (!d->done)
+    {
+      d->done_cond.wait(lock);
+    }
+  }
+
+  // Steps still running on other workers finish before the pipeline
+  // leaves the pool.
+  d->pool->remove(d.get());
+  d->registered = false;
+}
+
+// ------------------------------------------------------------------
+void
+thread_pool_scheduler
+::_pause()
+{
+  d->paused = true;
+  d->m_pause_mutex.lock();
+}
+
+// ------------------------------------------------------------------
+void
+thread_pool_scheduler
+::_resume()
+{
+  d->m_pause_mutex.unlock();
+  d->paused = false;
+  d->pool->notify_all();
+}
+
+// ------------------------------------------------------------------
+void
+thread_pool_scheduler
+::_stop()
+{
+  d->finish();
+
+  // Only interrupt the workers if they are ours; the workers of a
+  // shared pool are stepping other pipelines too.
+  if (!d->shared_pool)
+  {
+    d->pool->interrupt_all();
+  }
+
+  d->pool->notify_all();
+}
+
+// ============================================================================
+pool_job
+::pool_job()
+  : active(0)
+  , release_mutex()
+  , release_cond()
+{
+}
+
+// ------------------------------------------------------------------
+void
+pool_job
+::acquire()
+{
+  ++active;
+}
+
+// ------------------------------------------------------------------
+void
+pool_job
+::release()
+{
+  if (0 == --active)
+  {
+    boost::lock_guard<boost::mutex> const lock(release_mutex);
+
+    (void)lock;
+
+    release_cond.notify_all();
+  }
+}
+
+// ------------------------------------------------------------------
+void
+pool_job
+::wait_released()
+{
+  boost::unique_lock<boost::mutex> lock(release_mutex);
+
+  while (active)
+  {
+    release_cond.wait(lock);
+  }
+}
+
+// ============================================================================
+worker_pool
+::worker_pool(size_t num_threads_)
+  : num_threads(num_threads_)
+  , jobs_mutex()
+  , jobs()
+  , started(false)
+  , park_mutex()
+  , park_cond()
+  , stopping(false)
+  , threads()
+{
+}
+
+// ------------------------------------------------------------------
+worker_pool
+::~worker_pool()
+{
+  stopping = true;
+  threads.interrupt_all();
+  notify_all();
+  threads.join_all();
+}
+
+// ------------------------------------------------------------------
+void
+worker_pool
+::add(pool_job* job)
+{
+  {
+    boost::lock_guard<boost::mutex> const lock(jobs_mutex);
+
+    (void)lock;
+
+    jobs.push_back(job);
+
+    // Workers start with the first pipeline so that an idle pool
+    // parks no threads.
+    if (!started)
+    {
+      started = true;
+
+      for (size_t i = 0; i < num_threads; ++i)
+      {
+        threads.create_thread(std::bind(&worker_pool::run_worker, this, i));
+      }
+    }
+  }
+
+  notify_all();
+}
+
+// ------------------------------------------------------------------
+void
+worker_pool
+::remove(pool_job* job)
+{
+  {
+    boost::lock_guard<boost::mutex> const lock(jobs_mutex);
+
+    (void)lock;
+
+    jobs.erase(std::remove(jobs.begin(), jobs.end(), job), jobs.end());
+  }
+
+  job->wait_released();
+}
+
+// ------------------------------------------------------------------
+void
+worker_pool
+::notify_one()
+{
+  park_cond.notify_one();
+}
+
+// ------------------------------------------------------------------
+void
+worker_pool
+::notify_all()
+{
+  boost::lock_guard<boost::mutex> const lock(park_mutex);
+
+  (void)lock;
+
+  park_cond.notify_all();
+}
+
+// ------------------------------------------------------------------
+void
+worker_pool
+::interrupt_all()
+{
+  threads.interrupt_all();
+}
+
+// ------------------------------------------------------------------
+std::shared_ptr<worker_pool>
+worker_pool
+::shared(std::string const& name, size_t num_threads)
+{
+  static std::mutex pools_mutex;
+  static std::map<std::string, std::weak_ptr<worker_pool>> pools;
+
+  std::lock_guard<std::mutex> const lock(pools_mutex);
+
+  // The pool goes away with the last scheduler using it; the first
+  // scheduler to use a name sets its size.
+  auto pool = pools[name].lock();
+
+  if (!pool)
+  {
+    pool = std::make_shared<worker_pool>(num_threads);
+    pools[name] = pool;
+  }
+
+  return pool;
+}
+
+// ------------------------------------------------------------------
+/*
+ * This is the loop run by each worker thread. It runs until the pool
+ * is destroyed, or the worker is interrupted when a pipeline with a
+ * pool of its own is stopped.
+ */
+void
+worker_pool
+::run_worker(size_t worker)
+{
+  name_thread(thread_name);
+
+  std::vector<pool_job*> current;
+  size_t first = worker;
+
+  while (!stopping)
+  {
+    {
+      boost::lock_guard<boost::mutex> const lock(jobs_mutex);
+
+      (void)lock;
+
+      current = jobs;
+
+      for (pool_job* const job : current)
+      {
+        job->acquire();
+      }
+    }
+
+    // Release the jobs even if a step is interrupted.
+    struct release_t
+    {
+      std::vector<pool_job*> const& jobs;
+
+      ~release_t()
+      {
+        for (pool_job* const job : jobs)
+        {
+          job->release();
+        }
+      }
+    } const release = { current };
+
+    (void)release;
+
+    bool worked = false;
+
+    // Start with a different pipeline on each pass so that a busy one
+    // does not keep the others waiting.
+    for (size_t i = 0; i < current.size(); ++i)
+    {
+      worked = current[(first + i) % current.size()]->run_one(worker) || worked;
+    }
+
+    ++first;
+
+    if (!worked)
+    {
+      boost::unique_lock<boost::mutex> lock(park_mutex);
+
+      if (!stopping)
+      {
+        park_cond.wait_for(lock, idle_wait);
+      }
+    }
+
+    boost::this_thread::interruption_point();
+  }
+}
+
+// ============================================================================
+thread_pool_scheduler::priv
+::priv(std::shared_ptr<worker_pool> const& pool_, bool shared_pool_)
+  : pool(pool_)
+  , shared_pool(shared_pool_)
+  , num_threads(pool_->num_threads)
+  , registered(false)
+  , tasks()
+  , queues()
+  , priorities()
+  , prioritized(false)
+  , ready_mutex()
+  , ready()
+  , remaining(0)
+  , done(false)
+  , paused(false)
+  , done_mutex()
+  , done_cond()
+  , m_pause_mutex()
+{
+  for (size_t i = 0; i < num_threads; ++i)
+  {
+    queues.push_back(std::unique_ptr<worker_queue_t>(new worker_queue_t));
+  }
+}
+
+// ------------------------------------------------------------------
+thread_pool_scheduler::priv
+::~priv()
+{
+  if (registered)
+  {
+    done = true;
+    pool->remove(this);
+  }
+}
+
+// ------------------------------------------------------------------
+thread_pool_scheduler::priv::task_t
+::task_t(process_t const& proc)
+  : process(proc)
+  , monitor_edge()
+  , inputs()
+  , outputs()
+  , neighbors()
+  , any_input(false)
+  , pinned(false)
+  , priority(0)
+  , state(task_idle)
+{
+}
+
+// ------------------------------------------------------------------
+void
+thread_pool_scheduler::priv
+::read_priorities(pipeline_t const& pipe)
+{
+  process::names_t const names = pipe->process_names();
+  std::map<process::name_t, int> explicit_priorities;
+
+  for (process::name_t const& name : names)
+  {
+    kwiver::vital::config_block_sptr const conf =
+      pipe->process_by_name(name)->special_config();
+
+    if (!conf->has_value(config_priority))
+    {
+      continue;
+    }
+
+    try
+    {
+      explicit_priorities[name] = conf->get_value<int>(config_priority);
+    }
+    catch (kwiver::vital::bad_config_block_cast_exception const&)
+    {
+      std::string const reason =
+        "The process \'" + name + "\' has an invalid " + config_priority + ": \'" +
+        conf->get_value<std::string>(config_priority) + "\'.";
+
+      VITAL_THROW( incompatible_pipeline_exception, reason);
+    }
+  }
+
+  if (explicit_priorities.empty())
+  {
+    return;
+  }
+
+  prioritized = true;
+
+  std::set<process::name_t> visiting;
+
+  for (process::name_t const& name : names)
+  {
+    branch_priority(pipe, name, explicit_priorities, visiting);
+  }
+}
+
+// ------------------------------------------------------------------
+/*
+ * A process without a priority of its own takes the highest priority
+ * of the processes it sends to, so that marking the end of a branch
+ * marks the whole branch, and a process feeding several branches runs
+ * as soon as the most urgent one needs it.
+ */
+int
+thread_pool_scheduler::priv
+::branch_priority(pipeline_t const& pipe,
+                  process::name_t const& name,
+                  std::map<process::name_t, int> const& explicit_priorities,
+                  std::set<process::name_t>& visiting)
+{
+  auto const known = priorities.find(name);
+
+  if (known != priorities.end())
+  {
+    return known->second;
+  }
+
+  auto const own = explicit_priorities.find(name);
+
+  if (own != explicit_priorities.end())
+  {
+    priorities[name] = own->second;
+    return own->second;
+  }
+
+  bool found = false;
+  int priority = 0;
+
+  visiting.insert(name);
+
+  for (process_t const& down : pipe->downstream_for_process(name))
+  {
+    // Do not follow a feedback loop back to where it started.
+    if (visiting.count(down->name()))
+    {
+      continue;
+    }
+
+    int const down_priority = branch_priority(pipe, down->name(), explicit_priorities, visiting);
+
+    priority = (found ? std::max(priority, down_priority) : down_priority);
+    found = true;
+  }
+
+  visiting.erase(name);
+
+  priorities[name] = priority;
+  return priority;
+}
+
+// ------------------------------------------------------------------
+void
+thread_pool_scheduler::priv
+::build_tasks(pipeline_t const& pipe)
+{
+  process::names_t const names = pipe->process_names();
+  std::map<process::name_t, size_t> index;
+
+  kwiver::vital::config_block_sptr const edge_conf = monitor_edge_config();
+
+  // Fused processes are stepped within the task of the process they are
+  // fused onto; that task sends to where the last of them sends.
+  std::map<process::name_t, process::names_t> members;
+
+  for (process::name_t const& name : names)
+  {
+    process_t const proc = pipe->process_by_name(name);
+
+    if (proc->is_fused())
+    {
+      continue;
+    }
+
+    std::unique_ptr<task_t> task(new task_t(proc));
+
+    process::properties_t const props = proc->properties();
+
+    task->pinned = (0 != props.count(process::property_no_threads));
+    task->any_input = (0 != props.count(process::property_unsync_input));
+
+    process::names_t& task_members = members[name];
+    task_members.push_back(name);
+
+    for (process_t const& fused : proc->fused_processes())
+    {
+      task->pinned = task->pinned ||
+        (0 != fused->properties().count(process::property_no_threads));
+      task_members.push_back(fused->name());
+    }
+
+    if (prioritized)
+    {
+      task->priority = priorities[name];
+
+      for (process::name_t const& member : task_members)
+      {
+        task->priority = std::max(task->priority, priorities[member]);
+      }
+    }
+
+    for (process::port_t const& port : proc->input_ports())
+    {
+      edge_t const iedge = pipe->input_edge_for_port(name, port);
+
+      if (!iedge)
+      {
+        continue;
+      }
+
+      // Match the number of data the process grabs in a step; ports
+      // without an integral frequency need at least one.
+      process::port_frequency_t const freq = proc->input_port_info(port)->frequency;
+      size_t count = 1;
+
+      if (freq && (freq.denominator() == 1))
+      {
+        count = freq.numerator();
+      }
+
+      task->inputs.push_back(input_requirement_t(iedge, count));
+    }
+
+    task->outputs = pipe->output_edges_for_process(task_members.back());
+
+    task->monitor_edge = std::make_shared<edge>(edge_conf);
+    proc->connect_output_port(process::port_heartbeat, task->monitor_edge);
+
+    for (process::name_t const& member : task_members)
+    {
+      index[member] = tasks.size();
+    }
+    tasks.push_back(std::move(task));
+  }
+
+  for (std::map<process::name_t, process::names_t>::value_type const& task_members : members)
+  {
+    size_t const self = index[task_members.first];
+    task_t& task = *tasks[self];
+
+    for (process::name_t const& name : task_members.second)
+    {
+      for (process_t const& up : pipe->upstream_for_process(name))
+      {
+        task.neighbors.push_back(index[up->name()]);
+      }
+
+      for (process_t const& down : pipe->downstream_for_process(name))
+      {
+        task.neighbors.push_back(index[down->name()]);
+      }
+    }
+
+    task.neighbors.erase(std::remove(task.neighbors.begin(), task.neighbors.end(), self),
+                         task.neighbors.end());
+
+    std::sort(task.neighbors.begin(), task.neighbors.end());
+    task.neighbors.erase(std::unique(task.neighbors.begin(), task.neighbors.end()),
+                         task.neighbors.end());
+  }
+
+  remaining = tasks.size();
+
+  if (tasks.empty())
+  {
+    finish();
+  }
+}
+
+// ------------------------------------------------------------------
+/*
+ * This is called by the workers of the pool until every process is
+ * complete or the scheduler is stopped.
+ */
+bool
+thread_pool_scheduler::priv
+::run_one(size_t worker)
+{
+  if (done || paused)
+  {
+    return false;
+  }
+
+  size_t task;
+
+  if (next_task(worker, task))
+  {
+    run_task(worker, task);
+    return true;
+  }
+
+  // Nothing is queued; look for processes which became ready
+  // without a neighbor noticing.
+  return enqueue_ready(worker);
+}
+
+// ------------------------------------------------------------------
+void
+thread_pool_scheduler::priv
+::finish()
+{
+  boost::lock_guard<boost::mutex> const lock(done_mutex);
+
+  (void)lock;
+
+  done = true;
+  done_cond.notify_all();
+}
+
+// ------------------------------------------------------------------
+void
+thread_pool_scheduler::priv
+::run_task(size_t worker, size_t index)
+{
+  task_t& task = *tasks[index];
+
+  task.state = task_running;
+
+  {
+    // This locking will cause this thread to pause if the scheduler
+    // pause() method is called.
+    shared_lock_t const lock(m_pause_mutex);
+
+    (void)lock;
+
+    // This call allows an exception to be thrown (boost::thread_interrupted)
+    // Since this exception is not caught, it causes the thread to terminate.
+    boost::this_thread::interruption_point();
+
+    task.process->step();
+  }
+
+  bool complete = false;
+
+  // Check the monitor edge to see if the process is still running
+  // or has completed.
+  while (task.monitor_edge->has_data())
+  {
+    edge_datum_t const edat = task.monitor_edge->get_datum();
+
+    if (edat.datum->type() == datum::complete)
+    {
+      complete = true;
+    }
+  }
+
+  if (complete)
+  {
+    task.state = task_complete;
+
+    if (0 == --remaining)
+    {
+      finish();
+    }
+  }
+  else
+  {
+    task.state = task_idle;
+    enqueue_if_ready(worker, index);
+  }
+
+  // Stepping consumed input and produced output, which may have made
+  // the processes on either side ready.
+  for (size_t const neighbor : task.neighbors)
+  {
+    enqueue_if_ready(worker, neighbor);
+  }
+}
+
+// ------------------------------------------------------------------
+bool
+thread_pool_scheduler::priv
+::next_task(size_t worker, size_t& task)
+{
+  if (prioritized)
+  {
+    return next_prioritized_task(worker, task);
+  }
+
+  {
+    worker_queue_t& own = *queues[worker];
+    boost::lock_guard<boost::mutex> const lock(own.mutex);
+
+    (void)lock;
+
+    if (!own.pinned.empty())
+    {
+      task = own.pinned.front();
+      own.pinned.pop_front();
+
+      return true;
+    }
+
+    // Take the most recently readied process; its data is likely
+    // still in this core's cache.
+    if (!own.tasks.empty())
+    {
+      task = own.tasks.back();
+      own.tasks.pop_back();
+
+      return true;
+    }
+  }
+
+  // Steal the oldest work from another worker.
+  for (size_t i = 1; i < num_threads; ++i)
+  {
+    worker_queue_t& victim = *queues[(worker + i) % num_threads];
+    boost::lock_guard<boost::mutex> const lock(victim.mutex);
+
+    (void)lock;
+
+    if (!victim.tasks.empty())
+    {
+      task = victim.tasks.front();
+      victim.tasks.pop_front();
+
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// ------------------------------------------------------------------
+bool
+thread_pool_scheduler::priv
+::next_prioritized_task(size_t worker, size_t& task)
+{
+  boost::lock_guard<boost::mutex> const ready_lock(ready_mutex);
+
+  (void)ready_lock;
+
+  worker_queue_t& own = *queues[worker];
+  boost::lock_guard<boost::mutex> const own_lock(own.mutex);
+
+  (void)own_lock;
+
+  // Tasks pinned to this worker only wait for more urgent ones.
+  if (!own.pinned.empty() &&
+      (ready.empty() || (tasks[own.pinned.front()]->priority >= ready.begin()->first)))
+  {
+    task = own.pinned.front();
+    own.pinned.pop_front();
+
+    return true;
+  }
+
+  // Tasks of equal priority run in the order they became ready.
+  if (!ready.empty())
+  {
+    task = ready.begin()->second;
+    ready.erase(ready.begin());
+
+    return true;
+  }
+
+  return false;
+}
+
+// ------------------------------------------------------------------
+bool
+thread_pool_scheduler::priv
+::enqueue_if_ready(size_t worker, size_t index)
+{
+  task_t& task = *tasks[index];
+
+  while (true)
+  {
+    if ((task.state != task_idle) || !is_ready(task))
+    {
+      return false;
+    }
+
+    int expected = task_idle;
+
+    // Claiming the task here keeps it from being queued twice, which
+    // also guarantees that no process is stepped reentrantly.
+    if (!task.state.compare_exchange_strong(expected, task_queued))
+    {
+      return false;
+    }
+
+    // Another worker may have run the task between the check above and
+    // the claim, consuming the input it saw. Once claimed, only the task
+    // itself drains its inputs and fills its outputs, so readiness can
+    // no longer go stale; otherwise release it and look again.
+    if (is_ready(task))
+    {
+      break;
+    }
+
+    task.state = task_idle;
+  }
+
+  if (prioritized && !task.pinned)
+  {
+    boost::lock_guard<boost::mutex> const lock(ready_mutex);
+
+    (void)lock;
+
+    ready.insert(std::make_pair(task.priority, index));
+  }
+  else
+  {
+    worker_queue_t& queue = *queues[task.pinned ? 0 : worker];
+    boost::lock_guard<boost::mutex> const lock(queue.mutex);
+
+    (void)lock;
+
+    if (task.pinned)
+    {
+      queue.pinned.push_back(index);
+    }
+    else
+    {
+      queue.tasks.push_back(index);
+    }
+  }
+
+  if (task.pinned)
+  {
+    // Only the first worker may run this task.
+    pool->notify_all();
+  }
+  else
+  {
+    pool->notify_one();
+  }
+
+  return true;
+}
+
+// ------------------------------------------------------------------
+bool
+thread_pool_scheduler::priv
+::enqueue_ready(size_t worker)
+{
+  bool found = false;
+
+  for (size_t i = 0; i < tasks.size(); ++i)
+  {
+    found = enqueue_if_ready(worker, i) || found;
+  }
+
+  return found;
+}
+
+// ------------------------------------------------------------------
+bool
+thread_pool_scheduler::priv
+::is_ready(task_t const& task) const
+{
+  for (edge_t const& oedge : task.outputs)
+  {
+    if (oedge->full_of_data())
+    {
+      return false;
+    }
+  }
+
+  if (task.inputs.empty())
+  {
+    return true;
+  }
+
+  for (input_requirement_t const& input : task.inputs)
+  {
+    bool const have = (input.second <= input.first->datum_count());
+
+    if (task.any_input && have)
+    {
+      return true;
+    }
+
+    if (!task.any_input && !have)
+    {
+      return false;
+    }
+  }
+
+  return !task.any_input;
+}
+
+// ------------------------------------------------------------------
+/**
+ * This function returns the config block for the "monitor_edge". The
+ * monitor_edge being the one where the process generates a heart beat datum.
+ *
+ * Currently there is no config for these edges.
+ */
+kwiver::vital::config_block_sptr
+monitor_edge_config()
+{
+  kwiver::vital::config_block_sptr conf = kwiver::vital::config_block::empty_config();
+
+  // Empty config will create a default edge.
+
+  return conf;
+}
+
+}
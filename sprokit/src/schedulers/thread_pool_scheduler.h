@@ -0,0 +1,125 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef SPROKIT_SCHEDULERS_SCHEDULERS_THREAD_POOL_SCHEDULER_H
+#define SPROKIT_SCHEDULERS_SCHEDULERS_THREAD_POOL_SCHEDULER_H
+
+#include <schedulers/schedulers_export.h>
+
+#include <sprokit/pipeline/scheduler.h>
+
+/**
+ * \file thread_pool_scheduler.h
+ *
+ * \brief Declaration of the thread pool scheduler.
+ */
+
+namespace sprokit
+{
+
+/**
+ * \class thread_pool_scheduler
+ *
+ * \brief A scheduler which shares process execution among a group of threads.
+ *
+ * A process is stepped only when it is ready: every connected input
+ * edge holds enough data for one step and no output edge is full.
+ * Ready processes are queued on the local deque of the worker which
+ * made them ready; idle workers steal from the other workers.
+ *
+ * A process is never stepped by two workers at once. Processes with
+ * \ref process::property_no_threads are always stepped on the same
+ * worker thread.
+ *
+ * A worker is held for the whole of a step, so a process which blocks
+ * in a step keeps its worker until it can go on. A process with
+ * \ref process::property_unsync_input is ready when any of its inputs
+ * has data, yet it may grab from another input and wait for it, as the
+ * mux process does when its next input is empty. The scheduler
+ * therefore runs at least one worker per such process, plus one for the
+ * rest of the pipeline, whatever \c num_threads says. Other processes
+ * should not block on inputs or outputs beyond what they request in a
+ * single step.
+ *
+ * \scheduler Manages execution using a set number of threads.
+ *
+ * \configs
+ *
+ * Schedulers configured with the same \c pool name share one set of
+ * workers, which take turns stepping the ready processes of each of
+ * their pipelines. This lets many pipelines in one program, such as
+ * embedded pipelines serving separate streams, run on a fixed number of
+ * threads. A process which blocks in a step, such as an input adapter
+ * waiting for data, holds a worker of the shared pool while it waits.
+ *
+ * \config{num_threads} The number of threads to run. A setting of \c 0 means "auto".
+ * It is raised to the minimum described above. For a shared pool, this
+ * is only used by the first scheduler to name it, and later pipelines
+ * which need more workers than the pool has log a warning.
+ *
+ * \config{pool} The name of a worker pool shared with the other
+ * schedulers of the program which use the same name. By default, the
+ * scheduler has workers of its own.
+ *
+ * Processes may set \c _schedule_priority to an integer. A process
+ * without one takes the highest priority of the processes it sends
+ * to, so setting it on the last process of a branch sets it for the
+ * branch. When any process has a priority, ready processes are run
+ * highest priority first instead of being stolen between workers, and
+ * lower priority branches fall behind while higher ones have work.
+ * How far they may fall behind is set by the capacity of their input
+ * edges. Priorities only order the processes of one pipeline; the
+ * pipelines of a shared pool still take turns.
+ */
+class SCHEDULERS_NO_EXPORT thread_pool_scheduler
+  : public scheduler
+{
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param pipe The pipeline to scheduler.
+     * \param config Contains config for the scheduler.
+     */
+    thread_pool_scheduler(pipeline_t const& pipe, kwiver::vital::config_block_sptr const& config);
+
+    /**
+     * \brief Destructor.
+     */
+    ~thread_pool_scheduler();
+
+  protected:
+    /**
+     * \brief Starts execution.
+     */
+    void _start();
+
+    /**
+     * \brief Waits until execution is finished.
+     */
+    void _wait();
+
+    /**
+     * \brief Pauses execution.
+     */
+    void _pause();
+
+    /**
+     * \brief Resumes execution.
+     */
+    void _resume();
+
+    /**
+     * \brief Stop execution of the pipeline.
+     */
+    void _stop();
+
+  private:
+    class priv;
+    std::unique_ptr<priv> d;
+};
+
+}
+
+#endif // SPROKIT_SCHEDULERS_SCHEDULERS_THREAD_POOL_SCHEDULER_H
@@ -3,6 +3,7 @@
 // https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
 
 #include "datum.h"
+#include "object_pool.h"
 
 #include <sstream>
 
@@ -18,7 +19,10 @@ namespace sprokit {
 datum_t
 datum::new_datum(kwiver::vital::any const& dat)
 {
-  return datum_t(new datum(dat));
+  return make_pooled_shared<datum>([&](void* mem)
+  {
+    return new (mem) datum(dat);
+  });
 }
 
 // ------------------------------------------------------------------
@@ -26,7 +30,10 @@ datum_t
 datum
 ::empty_datum()
 {
-  return datum_t(new datum(empty));
+  return make_pooled_shared<datum>([&](void* mem)
+  {
+    return new (mem) datum(empty);
+  });
 }
 
 // ------------------------------------------------------------------
@@ -34,7 +41,10 @@ datum_t
 datum
 ::flush_datum()
 {
-  return datum_t(new datum(flush));
+  return make_pooled_shared<datum>([&](void* mem)
+  {
+    return new (mem) datum(flush);
+  });
 }
 
 // ------------------------------------------------------------------
@@ -42,7 +52,10 @@ datum_t
 datum
 ::complete_datum()
 {
-  return datum_t(new datum(complete));
+  return make_pooled_shared<datum>([&](void* mem)
+  {
+    return new (mem) datum(complete);
+  });
 }
 
 // ------------------------------------------------------------------
@@ -50,7 +63,10 @@ datum_t
 datum
 ::error_datum(error_t const& error)
 {
-  return datum_t(new datum(error));
+  return make_pooled_shared<datum>([&](void* mem)
+  {
+    return new (mem) datum(error);
+  });
 }
 
 // ------------------------------------------------------------------
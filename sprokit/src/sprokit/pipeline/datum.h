@@ -13,6 +13,7 @@
 #include <boost/operators.hpp>
 
 #include <string>
+#include <utility>
 
 /**
  * \file datum.h
@@ -136,6 +137,37 @@ class SPROKIT_PIPELINE_EXPORT datum
     template <typename T>
     T get_datum() const;
 
+    /**
+     * \brief Access a result within a datum without copying it.
+     *
+     * The reference is valid for as long as the datum is alive. This is
+     * the cheapest way to read data from edges which fan out to several
+     * processes since the data is shared between all of them.
+     *
+     * \throws bad_datum_cast_exception Thrown when the data cannot be cast as requested.
+     *
+     * \returns A reference to the result contained within the datum.
+     */
+    template <typename T>
+    T const& get_datum_ref() const;
+
+    /**
+     * \brief Extract a result from a datum, moving it out if possible.
+     *
+     * If \p dat is the only reference to the datum, the result is moved
+     * out of the datum rather than copied and the datum is left holding
+     * a moved-from value. Otherwise, the result is copied as with
+     * get_datum().
+     *
+     * \throws bad_datum_cast_exception Thrown when the data cannot be cast as requested.
+     *
+     * \param dat The datum to extract the result from.
+     *
+     * \returns The result contained within the datum.
+     */
+    template <typename T>
+    static T take_datum(datum_t dat);
+
     /**
      * \brief Compare two data for equality.
      *
@@ -154,9 +186,13 @@ class SPROKIT_PIPELINE_EXPORT datum
     SPROKIT_PIPELINE_NO_EXPORT datum(error_t const& err);
     SPROKIT_PIPELINE_NO_EXPORT datum(kwiver::vital::any const& dat);
 
+    template <typename T>
+    [[noreturn]] void throw_bad_cast(char const* reason) const;
+
     type_t const m_type;
     error_t const m_error;
-    kwiver::vital::any const m_datum;
+    // Not const so that take_datum() can move the result out.
+    kwiver::vital::any m_datum;
 };
 
 // ----------------------------------------------------------------------------
@@ -239,12 +275,58 @@ datum::get_datum() const
   }
   catch (kwiver::vital::bad_any_cast const& e)
   {
-    std::string const req_type_name = typeid(T).name();
-    std::string const type_name = m_datum.type().name();
+    throw_bad_cast<T>(e.what());
+  }
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+T const&
+datum::get_datum_ref() const
+{
+  T const* const ptr = kwiver::vital::any_cast<T>(&m_datum);
+
+  if (!ptr)
+  {
+    kwiver::vital::bad_any_cast const e(m_datum.empty() ? "" : m_datum.type().name(),
+                                        typeid(T).name());
 
-    VITAL_THROW( bad_datum_cast_exception,
-                 req_type_name, type_name, m_type, m_error, e.what());
+    throw_bad_cast<T>(e.what());
   }
+
+  return *ptr;
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+T
+datum::take_datum(datum_t dat)
+{
+  if (dat.use_count() == 1)
+  {
+    // Nobody else can observe the datum, so it is safe to steal from it.
+    datum& owned = const_cast<datum&>(*dat);
+    T* const ptr = kwiver::vital::any_cast<T>(&owned.m_datum);
+
+    if (ptr)
+    {
+      return T(std::move(*ptr));
+    }
+  }
+
+  return dat->get_datum<T>();
+}
+
+// ----------------------------------------------------------------------------
+template <typename T>
+void
+datum::throw_bad_cast(char const* reason) const
+{
+  std::string const req_type_name = typeid(T).name();
+  std::string const type_name = m_datum.type().name();
+
+  VITAL_THROW( bad_datum_cast_exception,
+               req_type_name, type_name, m_type, m_error, reason);
 }
 
 // ----------------------------------------------------------------------------
@@ -12,11 +12,16 @@
 
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/locks.hpp>
+#include <boost/thread/mutex.hpp>
 #include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/thread.hpp>
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <deque>
+#include <utility>
 
 /**
  * \file edge.cxx
@@ -48,12 +53,50 @@ ::edge_datum_t(datum_t const& datum_, stamp_t const& stamp_)
 {
 }
 
+// ------------------------------------------------------------------
+edge_datum_t
+::edge_datum_t(edge_datum_t const& other)
+  : datum(other.datum)
+  , stamp(other.stamp)
+{
+}
+
+// ------------------------------------------------------------------
+edge_datum_t
+::edge_datum_t(edge_datum_t&& other) noexcept
+  : datum(std::move(other.datum))
+  , stamp(std::move(other.stamp))
+{
+}
+
 // ------------------------------------------------------------------
 edge_datum_t
 ::~edge_datum_t()
 {
 }
 
+// ------------------------------------------------------------------
+edge_datum_t&
+edge_datum_t
+::operator = (edge_datum_t const& other)
+{
+  datum = other.datum;
+  stamp = other.stamp;
+
+  return *this;
+}
+
+// ------------------------------------------------------------------
+edge_datum_t&
+edge_datum_t
+::operator = (edge_datum_t&& other) noexcept
+{
+  datum = std::move(other.datum);
+  stamp = std::move(other.stamp);
+
+  return *this;
+}
+
 template <typename T>
 static bool pointers_equal(T const& a, T const& b);
 
@@ -72,12 +115,105 @@ ::operator == (edge_datum_t const& rhs) const
 kwiver::vital::config_block_key_t const edge::config_dependency = kwiver::vital::config_block_key_t("_dependency");
 kwiver::vital::config_block_key_t const edge::config_capacity   = kwiver::vital::config_block_key_t("capacity");
 kwiver::vital::config_block_key_t const edge::config_blocking   = kwiver::vital::config_block_key_t("blocking");
+kwiver::vital::config_block_key_t const edge::config_impl       = kwiver::vital::config_block_key_t("impl");
+
+static std::string const impl_deque     = std::string("deque");
+static std::string const impl_spsc_ring = std::string("spsc_ring");
+
+// Number of times a waiter on a ring edge polls before parking.
+static size_t const ring_spin_count = 64;
+
+// Largest number of individual queue depths tracked by the depth
+// histogram; deeper queues share the last bin.
+static size_t const max_depth_bins = 256;
+
+typedef std::atomic<edge::duration_t::rep> blocked_time_t;
+
+// ------------------------------------------------------------------
+// Adds the time spent in a wait to a statistic, but only when the wait
+// actually had to block.
+class blocked_timer
+{
+  public:
+    blocked_timer(blocked_time_t& total_, bool blocked)
+      : total(total_)
+      , active(blocked)
+      , start(blocked ? edge::clock_t::now() : edge::clock_t::time_point())
+    {
+    }
+
+    ~blocked_timer()
+    {
+      if (active)
+      {
+        total.fetch_add((edge::clock_t::now() - start).count(),
+                        std::memory_order_relaxed);
+      }
+    }
+
+  private:
+    blocked_time_t& total;
+    bool const active;
+    edge::clock_t::time_point const start;
+};
+
+// ------------------------------------------------------------------
+// Increment a counter which only one thread ever writes.
+static inline void
+bump(std::atomic<size_t>& counter)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+}
+
+// ==================================================================
+/**
+ * \brief Fixed capacity single-producer/single-consumer ring of edge data.
+ *
+ * The upstream process is the only writer of \c tail and the
+ * downstream process is the only writer of \c head, so neither side
+ * needs a lock. Indices increase monotonically and are reduced modulo
+ * the capacity when addressing a slot.
+ */
+class edge_ring
+{
+  public:
+    explicit edge_ring(size_t capacity_);
+
+    size_t size() const;
+    bool empty() const;
+    bool full() const;
+
+    // Producer side. The ring must not be full.
+    void push(edge_datum_t const& datum);
+
+    // Consumer side. The ring must hold more than \p idx elements.
+    edge_datum_t const& at(size_t idx) const;
+    // Consumer side. The ring must not be empty.
+    edge_datum_t pop();
+    // Consumer side.
+    void clear();
+
+  private:
+    // Keep the indices on separate cache lines so the producer and
+    // consumer do not contend on the same line.
+    static size_t const cache_line = 64;
+
+    std::vector<edge_datum_t> slots;
+    size_t const capacity;
+
+    char pad0[cache_line];
+    std::atomic<size_t> head;
+    char pad1[cache_line - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> tail;
+    char pad2[cache_line - sizeof(std::atomic<size_t>)];
+};
 
 // ==================================================================
 class edge::priv
 {
   public:
-    priv(bool depends_, size_t capacity_, bool blocking_);
+    priv(bool depends_, size_t capacity_, bool blocking_, bool use_ring);
     ~priv();
 
     typedef std::weak_ptr<process> process_ref_t;
@@ -88,6 +224,22 @@ class edge::priv
     bool push(edge_datum_t const& datum, kwiver::vital::optional<duration_t> const& duration = kwiver::vital::nullopt);
     kwiver::vital::optional<edge_datum_t> pop(kwiver::vital::optional<duration_t> const& duration = kwiver::vital::nullopt);
 
+    bool ring_push(edge_datum_t const& datum, kwiver::vital::optional<duration_t> const& duration);
+    kwiver::vital::optional<edge_datum_t> ring_pop(kwiver::vital::optional<duration_t> const& duration);
+
+    // Spin for a short while, then park until the predicate holds.
+    template <typename Predicate>
+    bool ring_wait(boost::condition_variable& cond,
+                   Predicate const& predicate,
+                   kwiver::vital::optional<duration_t> const& duration,
+                   blocked_time_t& blocked);
+    // Wake the other side if it is parked on the condition.
+    void ring_notify(boost::condition_variable& cond);
+
+    // Record a push into a queue which held \p depth data. Only the
+    // upstream process pushes, so this needs no lock.
+    void record_push(size_t depth);
+
     /// This flag indicates that this edge connection should or should
     /// not imply a dependency. Generally set to false if a backwards
     /// edge.
@@ -99,7 +251,7 @@ class edge::priv
     /// Set to indicate if this edge will block if its buffer is full.
     bool const blocking;
 
-    bool downstream_complete;
+    std::atomic<bool> downstream_complete;
 
     process_ref_t upstream;
     process_ref_t downstream;
@@ -120,6 +272,25 @@ class edge::priv
     mutable mutex_t mutex;
     mutable mutex_t complete_mutex;
 
+    /// Lock-free storage used instead of \c q when the ring is selected.
+    std::unique_ptr<edge_ring> ring;
+
+    /// Parking state for ring waiters.
+    boost::mutex park_mutex;
+    boost::condition_variable ring_have_data;
+    boost::condition_variable ring_have_space;
+    std::atomic<size_t> parked;
+
+    /// Occupancy and blocking statistics.
+    std::atomic<size_t> stat_pushed;
+    std::atomic<size_t> stat_popped;
+    std::atomic<size_t> stat_dropped;
+    std::atomic<size_t> stat_max_depth;
+    size_t const stat_bins;
+    std::unique_ptr<std::atomic<size_t>[]> stat_depths;
+    blocked_time_t stat_push_blocked;
+    blocked_time_t stat_pop_blocked;
+
     kwiver::vital::logger_handle_t m_logger;
 };
 
@@ -136,13 +307,29 @@ ::edge(kwiver::vital::config_block_sptr const& config)
   bool const depends    = config->get_value<bool>(config_dependency, true);
   size_t const capacity = config->get_value<size_t>(config_capacity, SPROKIT_DEFAULT_EDGE_CAPACITY );
   bool const blocking   = config->get_value<bool>(config_blocking, true);
+  std::string const impl = config->get_value<std::string>(config_impl, impl_deque);
+
+  if ( ( impl != impl_deque ) && ( impl != impl_spsc_ring ) )
+  {
+    VITAL_THROW( invalid_edge_impl_exception, impl );
+  }
 
-  d.reset(new priv(depends, capacity, blocking));
+  bool const use_ring = ( impl == impl_spsc_ring ) && ( 0 != capacity );
+
+  d.reset(new priv(depends, capacity, blocking, use_ring));
+
+  if ( ( impl == impl_spsc_ring ) && ! use_ring )
+  {
+    LOG_WARN( d->m_logger, "Edge implementation \"" << impl_spsc_ring
+              << "\" requires a non-zero capacity; using \""
+              << impl_deque << "\" instead" );
+  }
 
-  if ( 0 != capacity || ! blocking )
+  if ( 0 != capacity || ! blocking || use_ring )
   {
     LOG_DEBUG( d->m_logger, "Edge capacity set to: " << capacity
-               << "   " << (blocking ? "" : "non-" ) << "blocking: ");
+               << "   " << (blocking ? "" : "non-" ) << "blocking: "
+               << "   impl: " << ( use_ring ? impl_spsc_ring : impl_deque ) );
   }
 }
 
@@ -165,6 +352,11 @@ bool
 edge
 ::has_data() const
 {
+  if (d->ring)
+  {
+    return !d->ring->empty();
+  }
+
   priv::shared_lock_t const lock(d->mutex);
 
   (void)lock;
@@ -177,6 +369,11 @@ bool
 edge
 ::full_of_data() const
 {
+  if (d->ring)
+  {
+    return d->ring->full();
+  }
+
   priv::shared_lock_t const lock(d->mutex);
 
   (void)lock;
@@ -189,6 +386,11 @@ size_t
 edge
 ::datum_count() const
 {
+  if (d->ring)
+  {
+    return d->ring->size();
+  }
+
   priv::shared_lock_t const lock(d->mutex);
 
   (void)lock;
@@ -206,7 +408,10 @@ ::push_datum(edge_datum_t const& datum)
   // We can lose data but not control messages.
   if ( ! d->blocking && ( datum.datum->type() == datum::data ) )
   {
-    d->push( datum, duration_t( 0 ) );
+    if ( ! d->push( datum, duration_t( 0 ) ) )
+    {
+      bump( d->stat_dropped );
+    }
   }
   else
   {
@@ -219,7 +424,7 @@ edge_datum_t
 edge
 ::get_datum()
 {
-  return *d->pop();
+  return std::move(*d->pop());
 }
 
 // ------------------------------------------------------------------
@@ -229,10 +434,26 @@ ::peek_datum(size_t idx) const
 {
   d->complete_check();
 
+  if (d->ring)
+  {
+    edge_ring const& ring = *d->ring;
+
+    d->ring_wait(d->ring_have_data,
+                 [&ring, idx] () { return idx < ring.size(); },
+                 kwiver::vital::nullopt,
+                 d->stat_pop_blocked);
+
+    return ring.at(idx);
+  }
+
   priv::shared_lock_t lock(d->mutex);
 
-  d->cond_have_data.wait(lock,
-      boost::bind(&priv::edge_queue_t::size, &d->q) > idx);
+  {
+    blocked_timer const timer(d->stat_pop_blocked, d->q.size() <= idx);
+
+    d->cond_have_data.wait(lock,
+        boost::bind(&priv::edge_queue_t::size, &d->q) > idx);
+  }
 
   return d->q.at(idx);
 }
@@ -242,13 +463,23 @@ void
 edge
 ::pop_datum()
 {
+  if (d->ring)
+  {
+    d->ring_pop(kwiver::vital::nullopt);
+    return;
+  }
+
   d->complete_check();
 
   {
     priv::upgrade_lock_t lock(d->mutex);
 
-    d->cond_have_data.wait(lock,
-        !boost::bind(&priv::edge_queue_t::empty, &d->q));
+    {
+      blocked_timer const timer(d->stat_pop_blocked, d->q.empty());
+
+      d->cond_have_data.wait(lock,
+          !boost::bind(&priv::edge_queue_t::empty, &d->q));
+    }
 
     {
       priv::upgrade_to_unique_lock_t const write_lock(lock);
@@ -257,6 +488,8 @@ ::pop_datum()
 
       d->q.pop_front();
     }
+
+    bump(d->stat_popped);
   }
 
   d->cond_have_space.notify_one();
@@ -278,11 +511,49 @@ ::try_get_datum(duration_t const& duration)
   return d->pop(duration);
 }
 
+// ------------------------------------------------------------------
+edge_statistics_t
+edge
+::statistics() const
+{
+  edge_statistics_t stats;
+
+  stats.pushed = d->stat_pushed.load(std::memory_order_relaxed);
+  stats.popped = d->stat_popped.load(std::memory_order_relaxed);
+  stats.dropped = d->stat_dropped.load(std::memory_order_relaxed);
+  stats.max_depth = d->stat_max_depth.load(std::memory_order_relaxed);
+
+  stats.depth_histogram.resize(d->stat_bins);
+
+  for (size_t i = 0; i < d->stat_bins; ++i)
+  {
+    stats.depth_histogram[i] = d->stat_depths[i].load(std::memory_order_relaxed);
+  }
+
+  stats.push_blocked_time =
+    duration_t(d->stat_push_blocked.load(std::memory_order_relaxed));
+  stats.pop_blocked_time =
+    duration_t(d->stat_pop_blocked.load(std::memory_order_relaxed));
+
+  return stats;
+}
+
 // ------------------------------------------------------------------
 void
 edge
 ::mark_downstream_as_complete()
 {
+  if (d->ring)
+  {
+    // Only the downstream process marks its edges complete, so it is
+    // safe to drain the ring from here.
+    d->downstream_complete = true;
+    d->ring->clear();
+    d->ring_notify(d->ring_have_space);
+
+    return;
+  }
+
   priv::unique_lock_t const complete_lock(d->complete_mutex);
   priv::unique_lock_t const lock(d->mutex);
 
@@ -304,6 +575,11 @@ bool
 edge
 ::is_downstream_complete() const
 {
+  if (d->ring)
+  {
+    return d->downstream_complete;
+  }
+
   priv::shared_lock_t const lock(d->complete_mutex);
 
   (void)lock;
@@ -355,7 +631,7 @@ ::set_downstream_process(process_t process)
 
 // ==================================================================
 edge::priv
-::priv(bool depends_, size_t capacity_, bool blocking_)
+::priv(bool depends_, size_t capacity_, bool blocking_, bool use_ring)
   : depends(depends_)
   , capacity(capacity_)
   , blocking(blocking_)
@@ -367,8 +643,25 @@ ::priv(bool depends_, size_t capacity_, bool blocking_)
   , cond_have_space()
   , mutex()
   , complete_mutex()
+  , ring( use_ring ? new edge_ring(capacity_) : nullptr )
+  , park_mutex()
+  , ring_have_data()
+  , ring_have_space()
+  , parked(0)
+  , stat_pushed(0)
+  , stat_popped(0)
+  , stat_dropped(0)
+  , stat_max_depth(0)
+  , stat_bins( ( capacity_ ? std::min(capacity_, max_depth_bins) : max_depth_bins ) + 1 )
+  , stat_depths( new std::atomic<size_t>[stat_bins] )
+  , stat_push_blocked(0)
+  , stat_pop_blocked(0)
   , m_logger( kwiver::vital::get_logger( "sprokit.edge" ))
 {
+  for (size_t i = 0; i < stat_bins; ++i)
+  {
+    stat_depths[i].store(0, std::memory_order_relaxed);
+  }
 }
 
 // ------------------------------------------------------------------
@@ -395,6 +688,16 @@ void
 edge::priv
 ::complete_check() const
 {
+  if (ring)
+  {
+    if (downstream_complete)
+    {
+      VITAL_THROW( datum_requested_after_complete );
+    }
+
+    return;
+  }
+
   shared_lock_t const lock(complete_mutex);
 
   (void)lock;
@@ -410,6 +713,11 @@ bool
 edge::priv
 ::push(edge_datum_t const& datum, kwiver::vital::optional<duration_t> const& duration)
 {
+  if (ring)
+  {
+    return ring_push(datum, duration);
+  }
+
   {
     shared_lock_t const lock(complete_mutex);
 
@@ -426,17 +734,21 @@ ::push(edge_datum_t const& datum, kwiver::vital::optional<duration_t> const& dur
     upgrade_lock_t lock(mutex);
     boost::function<bool ()> const predicate = !boost::bind(&sprokit::edge::priv::full_of_data, this);
 
-    if (duration)
     {
-      // Wait for specified duration before giving up
-      if (!cond_have_space.wait_for(lock, *duration, predicate))
+      blocked_timer const timer(stat_push_blocked, !predicate());
+
+      if (duration)
       {
-        return false;
+        // Wait for specified duration before giving up
+        if (!cond_have_space.wait_for(lock, *duration, predicate))
+        {
+          return false;
+        }
+      }
+      else
+      {
+        cond_have_space.wait(lock, predicate);
       }
-    }
-    else
-    {
-      cond_have_space.wait(lock, predicate);
     }
 
     {
@@ -444,6 +756,7 @@ ::push(edge_datum_t const& datum, kwiver::vital::optional<duration_t> const& dur
 
       (void)write_lock;
 
+      record_push(q.size());
       q.push_back(datum);
     }
   }
@@ -458,6 +771,11 @@ kwiver::vital::optional<edge_datum_t>
 edge::priv
 ::pop(kwiver::vital::optional<duration_t> const& duration)
 {
+  if (ring)
+  {
+    return ring_pop(duration);
+  }
+
   complete_check();
 
   edge_datum_t dat;
@@ -466,19 +784,23 @@ ::pop(kwiver::vital::optional<duration_t> const& duration)
     upgrade_lock_t lock(mutex);
     boost::function<bool ()> const predicate = !boost::bind(&edge_queue_t::empty, &q);
 
-    if (duration)
     {
-      if (!cond_have_data.wait_for(lock, *duration, predicate))
+      blocked_timer const timer(stat_pop_blocked, q.empty());
+
+      if (duration)
       {
-        return kwiver::vital::nullopt;
+        if (!cond_have_data.wait_for(lock, *duration, predicate))
+        {
+          return kwiver::vital::nullopt;
+        }
+      }
+      else
+      {
+        cond_have_data.wait(lock, predicate);
       }
-    }
-    else
-    {
-      cond_have_data.wait(lock, predicate);
     }
 
-    dat = q.front();
+    dat = std::move(q.front());
 
     {
       upgrade_to_unique_lock_t const write_lock(lock);
@@ -487,13 +809,243 @@ ::pop(kwiver::vital::optional<duration_t> const& duration)
 
       q.pop_front();
     }
+
+    bump(stat_popped);
   }
 
   cond_have_space.notify_one();
 
+  return std::move(dat);
+}
+
+// ------------------------------------------------------------------
+bool
+edge::priv
+::ring_push(edge_datum_t const& datum, kwiver::vital::optional<duration_t> const& duration)
+{
+  // If downstream process has marked itself as complete, do nothing
+  if (downstream_complete)
+  {
+    return true;
+  }
+
+  edge_ring const& r = *ring;
+
+  if (!ring_wait(ring_have_space, [&r] () { return !r.full(); }, duration,
+                 stat_push_blocked))
+  {
+    return false;
+  }
+
+  record_push(ring->size());
+  ring->push(datum);
+  ring_notify(ring_have_data);
+
+  return true;
+}
+
+// ------------------------------------------------------------------
+kwiver::vital::optional<edge_datum_t>
+edge::priv
+::ring_pop(kwiver::vital::optional<duration_t> const& duration)
+{
+  complete_check();
+
+  edge_ring const& r = *ring;
+
+  if (!ring_wait(ring_have_data, [&r] () { return !r.empty(); }, duration,
+                 stat_pop_blocked))
+  {
+    return kwiver::vital::nullopt;
+  }
+
+  edge_datum_t dat = ring->pop();
+  bump(stat_popped);
+  ring_notify(ring_have_space);
+
+  return std::move(dat);
+}
+
+// ------------------------------------------------------------------
+template <typename Predicate>
+bool
+edge::priv
+::ring_wait(boost::condition_variable& cond,
+            Predicate const& predicate,
+            kwiver::vital::optional<duration_t> const& duration,
+            blocked_time_t& blocked)
+{
+  if (predicate())
+  {
+    return true;
+  }
+
+  // A zero timeout is a poll; do not spin or park.
+  if (duration && (*duration <= duration_t::zero()))
+  {
+    return false;
+  }
+
+  blocked_timer const timer(blocked, true);
+
+  for (size_t i = 0; i < ring_spin_count; ++i)
+  {
+    boost::this_thread::yield();
+
+    if (predicate())
+    {
+      return true;
+    }
+  }
+
+  boost::unique_lock<boost::mutex> lock(park_mutex);
+
+  // Announce the parked waiter before re-checking the predicate. This
+  // pairs with the fence in ring_notify so that either the waiter sees
+  // the update or the notifier sees the waiter.
+  ++parked;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  bool ready = true;
+
+  if (duration)
+  {
+    ready = cond.wait_for(lock, *duration, predicate);
+  }
+  else
+  {
+    cond.wait(lock, predicate);
+  }
+
+  --parked;
+
+  return ready;
+}
+
+// ------------------------------------------------------------------
+void
+edge::priv
+::ring_notify(boost::condition_variable& cond)
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (parked.load(std::memory_order_relaxed))
+  {
+    // Taking the lock orders this notification after a waiter which
+    // has checked its predicate but not yet blocked.
+    boost::lock_guard<boost::mutex> const lock(park_mutex);
+
+    (void)lock;
+
+    cond.notify_all();
+  }
+}
+
+// ------------------------------------------------------------------
+void
+edge::priv
+::record_push(size_t depth)
+{
+  bump(stat_pushed);
+  bump(stat_depths[std::min(depth, stat_bins - 1)]);
+
+  if (stat_max_depth.load(std::memory_order_relaxed) <= depth)
+  {
+    stat_max_depth.store(depth + 1, std::memory_order_relaxed);
+  }
+}
+
+// ==================================================================
+edge_ring
+::edge_ring(size_t capacity_)
+  : slots(capacity_)
+  , capacity(capacity_)
+  , head(0)
+  , tail(0)
+{
+}
+
+// ------------------------------------------------------------------
+size_t
+edge_ring
+::size() const
+{
+  // Read head first; tail never falls behind it.
+  size_t const h = head.load(std::memory_order_acquire);
+  size_t const t = tail.load(std::memory_order_acquire);
+
+  return t - h;
+}
+
+// ------------------------------------------------------------------
+bool
+edge_ring
+::empty() const
+{
+  return (0 == size());
+}
+
+// ------------------------------------------------------------------
+bool
+edge_ring
+::full() const
+{
+  return (capacity <= size());
+}
+
+// ------------------------------------------------------------------
+void
+edge_ring
+::push(edge_datum_t const& datum)
+{
+  size_t const t = tail.load(std::memory_order_relaxed);
+
+  slots[t % capacity] = datum;
+
+  tail.store(t + 1, std::memory_order_release);
+}
+
+// ------------------------------------------------------------------
+edge_datum_t const&
+edge_ring
+::at(size_t idx) const
+{
+  size_t const h = head.load(std::memory_order_relaxed);
+
+  return slots[(h + idx) % capacity];
+}
+
+// ------------------------------------------------------------------
+edge_datum_t
+edge_ring
+::pop()
+{
+  size_t const h = head.load(std::memory_order_relaxed);
+  edge_datum_t& slot = slots[h % capacity];
+
+  edge_datum_t dat;
+
+  // Release the slot's references so the datum does not outlive its
+  // trip through the edge.
+  dat.datum.swap(slot.datum);
+  dat.stamp.swap(slot.stamp);
+
+  head.store(h + 1, std::memory_order_release);
+
   return dat;
 }
 
+// ------------------------------------------------------------------
+void
+edge_ring
+::clear()
+{
+  while (!empty())
+  {
+    pop();
+  }
+}
+
 // ------------------------------------------------------------------
 template <typename T>
 bool
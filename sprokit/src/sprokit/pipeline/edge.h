@@ -56,11 +56,30 @@ class SPROKIT_PIPELINE_EXPORT edge_datum_t
    */
   edge_datum_t( datum_t const& datum_, stamp_t const& stamp_ );
 
+  /**
+   * \brief Copy constructor.
+   */
+  edge_datum_t( edge_datum_t const& other );
+
+  /**
+   * \brief Move constructor.
+   *
+   * Moving a packet transfers its references without touching the
+   * reference counts, which keeps a lone datum uniquely owned on its way
+   * through an \ref edge.
+   */
+  edge_datum_t( edge_datum_t&& other ) noexcept;
+
   /**
    * \brief Destructor.
    */
   ~edge_datum_t();
 
+  /// Copy assignment.
+  edge_datum_t& operator=( edge_datum_t const& other );
+  /// Move assignment.
+  edge_datum_t& operator=( edge_datum_t&& other ) noexcept;
+
   /**
    * \brief Compare two \ref edge_datum_t packets.
    *
@@ -76,6 +95,59 @@ class SPROKIT_PIPELINE_EXPORT edge_datum_t
   stamp_t stamp;
 };
 
+/**
+ * \class edge_statistics_t <sprokit/pipeline/edge.h>
+ *
+ * \brief Occupancy and blocking statistics collected by an \ref edge.
+ */
+class edge_statistics_t
+{
+public:
+  typedef boost::chrono::high_resolution_clock::duration duration_t;
+
+  edge_statistics_t()
+    : pushed( 0 )
+    , popped( 0 )
+    , dropped( 0 )
+    , max_depth( 0 )
+    , depth_histogram()
+    , push_blocked_time( duration_t::zero() )
+    , pop_blocked_time( duration_t::zero() )
+  {
+  }
+
+  /// The mean queue depth seen by pushes into the edge.
+  double mean_depth() const
+  {
+    size_t count = 0;
+    double total = 0;
+
+    for ( size_t i = 0; i < depth_histogram.size(); ++i )
+    {
+      count += depth_histogram[ i ];
+      total += static_cast< double >( i ) * depth_histogram[ i ];
+    }
+
+    return ( count ? total / count : 0.0 );
+  }
+
+  /// The number of data pushed into the edge.
+  size_t pushed;
+  /// The number of data removed from the edge by the downstream process.
+  size_t popped;
+  /// The number of data dropped because a non-blocking edge was full.
+  size_t dropped;
+  /// The largest number of data the edge has held at once.
+  size_t max_depth;
+  /// Count of pushes by the queue depth found before the push. The
+  /// last bin also counts all deeper queues.
+  std::vector< size_t > depth_histogram;
+  /// Total time the upstream process spent blocked on a full edge.
+  duration_t push_blocked_time;
+  /// Total time the downstream process spent blocked on an empty edge.
+  duration_t pop_blocked_time;
+};
+
 /// A typedef for a multiple packets which go through an \ref edge.
 typedef std::vector< edge_datum_t > edge_data_t;
 /// A group of \link edge edges\endlink.
@@ -251,6 +323,16 @@ class SPROKIT_PIPELINE_EXPORT edge
    */
   kwiver::vital::optional< edge_datum_t > try_get_datum( duration_t const& duration );
 
+  /**
+   * \brief Get the occupancy and blocking statistics for the edge.
+   *
+   * Statistics are collected continuously and may be queried from any
+   * thread while the pipeline is running.
+   *
+   * \returns A snapshot of the statistics collected so far.
+   */
+  edge_statistics_t statistics() const;
+
   /**
    * \brief Trigger the edge to flush all data and not accept any more data.
    *
@@ -313,6 +395,16 @@ class SPROKIT_PIPELINE_EXPORT edge
   /// Configuration for edge blocking behaviour
   static kwiver::vital::config_block_key_t const config_blocking;
 
+  /**
+   * \brief Configuration for the queue implementation backing the edge.
+   *
+   * Valid values are \c deque (the default), a mutex protected queue,
+   * and \c spsc_ring, a fixed capacity lock-free single-producer /
+   * single-consumer ring buffer. The ring requires a non-zero
+   * capacity; unbounded edges always use \c deque.
+   */
+  static kwiver::vital::config_block_key_t const config_impl;
+
 private:
   class SPROKIT_PIPELINE_NO_EXPORT priv;
   std::unique_ptr< priv > d;
@@ -43,6 +43,26 @@ null_edge_config_exception
 {
 }
 
+// ----------------------------------------------------------------------------
+invalid_edge_impl_exception
+::invalid_edge_impl_exception(std::string const& impl) noexcept
+  : edge_exception()
+  , m_impl(impl)
+{
+  std::ostringstream sstr;
+
+  sstr << "The edge implementation \""
+       << m_impl << "\" is not known; "
+          "use \"deque\" or \"spsc_ring\"";
+
+  m_what = sstr.str();
+}
+
+invalid_edge_impl_exception
+::~invalid_edge_impl_exception() noexcept
+{
+}
+
 // ----------------------------------------------------------------------------
 datum_requested_after_complete
 ::datum_requested_after_complete() noexcept
@@ -63,6 +63,32 @@ class SPROKIT_PIPELINE_EXPORT null_edge_config_exception
     ~null_edge_config_exception() noexcept;
 };
 
+/**
+ * \class invalid_edge_impl_exception edge_exception.h <sprokit/pipeline/edge_exception.h>
+ *
+ * \brief Thrown when an unknown queue implementation is requested for an edge.
+ *
+ * \ingroup exceptions
+ */
+class SPROKIT_PIPELINE_EXPORT invalid_edge_impl_exception
+  : public edge_exception
+{
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param impl The requested implementation.
+     */
+    invalid_edge_impl_exception(std::string const& impl) noexcept;
+    /**
+     * \brief Destructor.
+     */
+    ~invalid_edge_impl_exception() noexcept;
+
+    /// The requested implementation.
+    std::string const m_impl;
+};
+
 /**
  * \class datum_requested_after_complete pipeline_exception.h <sprokit/pipeline/pipeline_exception.h>
  *
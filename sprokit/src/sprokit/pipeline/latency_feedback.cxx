@@ -0,0 +1,237 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "latency_feedback.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file latency_feedback.cxx
+ *
+ * \brief Implementation of the latency feedback channel.
+ */
+
+namespace sprokit {
+
+namespace {
+
+// The limit starts generous enough not to starve a deep pipeline, and
+// never goes below one frame
+double const initial_limit = 32;
+double const min_limit = 1;
+double const max_limit = 1024;
+
+// Cut applied when a frame is over budget
+double const decrease_factor = 0.7;
+
+// Frames finishing within this share of the budget let the limit grow
+double const increase_threshold = 0.8;
+
+// Number of recent latencies kept for the percentiles
+size_t const recent_count = 256;
+
+// ----------------------------------------------------------------------------
+// Never destroyed, so channels may be used during static destruction
+struct registry
+{
+  std::mutex mutex;
+  std::map< std::string, latency_channel_t > channels;
+
+  static registry& instance()
+  {
+    static registry* const reg = new registry;
+    return *reg;
+  }
+};
+
+// ----------------------------------------------------------------------------
+double
+percentile( std::vector< double >& values, double p )
+{
+  if ( values.empty() )
+  {
+    return 0.0;
+  }
+
+  size_t const n = static_cast< size_t >( p * ( values.size() - 1 ) + 0.5 );
+  std::nth_element( values.begin(), values.begin() + n, values.end() );
+  return values[ n ];
+}
+
+}
+
+// ----------------------------------------------------------------------------
+latency_channel_t
+latency_channel
+::get( std::string const& name )
+{
+  registry& reg = registry::instance();
+  std::lock_guard< std::mutex > lock( reg.mutex );
+
+  latency_channel_t& channel = reg.channels[ name ];
+  if ( !channel )
+  {
+    channel = std::make_shared< latency_channel >();
+  }
+  return channel;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< std::pair< std::string, latency_statistics_t > >
+latency_channel
+::all_statistics()
+{
+  std::vector< std::pair< std::string, latency_channel_t > > channels;
+  {
+    registry& reg = registry::instance();
+    std::lock_guard< std::mutex > lock( reg.mutex );
+    channels.assign( reg.channels.begin(), reg.channels.end() );
+  }
+
+  std::vector< std::pair< std::string, latency_statistics_t > > stats;
+  for ( auto const& channel : channels )
+  {
+    stats.emplace_back( channel.first, channel.second->statistics() );
+  }
+  return stats;
+}
+
+// ----------------------------------------------------------------------------
+latency_channel
+::latency_channel()
+  : m_budget( 0.5 )
+  , m_limit( initial_limit )
+  , m_cut_barrier( std::numeric_limits< key_t >::min() )
+  , m_last_admitted( std::numeric_limits< key_t >::min() )
+  , m_admitted( 0 )
+  , m_dropped( 0 )
+  , m_completed( 0 )
+{
+}
+
+// ----------------------------------------------------------------------------
+void
+latency_channel
+::set_budget( double seconds )
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+  m_budget = seconds;
+}
+
+// ----------------------------------------------------------------------------
+double
+latency_channel
+::budget() const
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+  return m_budget;
+}
+
+// ----------------------------------------------------------------------------
+void
+latency_channel
+::reset()
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+
+  m_limit = initial_limit;
+  m_in_flight.clear();
+  m_cut_barrier = std::numeric_limits< key_t >::min();
+  m_last_admitted = std::numeric_limits< key_t >::min();
+  m_recent.clear();
+  m_admitted = 0;
+  m_dropped = 0;
+  m_completed = 0;
+}
+
+// ----------------------------------------------------------------------------
+bool
+latency_channel
+::admit( key_t key )
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+
+  if ( m_in_flight.size() >= static_cast< size_t >( m_limit ) )
+  {
+    ++m_dropped;
+    return false;
+  }
+
+  m_in_flight[ key ] = clock::now();
+  m_last_admitted = std::max( m_last_admitted, key );
+  ++m_admitted;
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+latency_channel
+::complete( key_t key )
+{
+  auto const now = clock::now();
+
+  std::lock_guard< std::mutex > lock( m_mutex );
+
+  auto const i = m_in_flight.find( key );
+  if ( i == m_in_flight.end() )
+  {
+    return;
+  }
+
+  double const latency =
+    std::chrono::duration< double >( now - i->second ).count();
+
+  // Earlier frames still in flight were dropped downstream
+  m_in_flight.erase( m_in_flight.begin(), std::next( i ) );
+  ++m_completed;
+
+  m_recent.push_back( latency );
+  if ( m_recent.size() > recent_count )
+  {
+    m_recent.pop_front();
+  }
+
+  // Cut the limit at most once per trip through the pipeline, since the
+  // frames behind the slow one were sent under the old limit
+  if ( latency > m_budget )
+  {
+    if ( key > m_cut_barrier )
+    {
+      m_limit = std::max( min_limit, m_limit * decrease_factor );
+      m_cut_barrier = m_last_admitted;
+    }
+  }
+  else if ( latency < m_budget * increase_threshold && key > m_cut_barrier )
+  {
+    // About one more frame per trip
+    m_limit = std::min( max_limit, m_limit + 1.0 / m_limit );
+  }
+}
+
+// ----------------------------------------------------------------------------
+latency_statistics_t
+latency_channel
+::statistics() const
+{
+  std::vector< double > recent;
+  latency_statistics_t stats;
+  {
+    std::lock_guard< std::mutex > lock( m_mutex );
+
+    stats.admitted = m_admitted;
+    stats.dropped = m_dropped;
+    stats.completed = m_completed;
+    stats.in_flight = m_in_flight.size();
+    stats.limit = static_cast< size_t >( m_limit );
+    recent.assign( m_recent.begin(), m_recent.end() );
+  }
+
+  stats.latency_max = percentile( recent, 1.0 );
+  stats.latency_p99 = percentile( recent, 0.99 );
+  stats.latency_p50 = percentile( recent, 0.5 );
+  return stats;
+}
+
+}
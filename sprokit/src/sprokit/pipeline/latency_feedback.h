@@ -0,0 +1,172 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef SPROKIT_PIPELINE_LATENCY_FEEDBACK_H
+#define SPROKIT_PIPELINE_LATENCY_FEEDBACK_H
+
+#include <sprokit/pipeline/sprokit_pipeline_export.h>
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \file latency_feedback.h
+ *
+ * \brief Feedback from the end of a pipeline to its source, for running
+ * live feeds within a latency budget.
+ *
+ * A source process asks the channel to admit each frame before sending
+ * it on, and a process at the end of the pipeline reports each frame it
+ * finishes. The channel measures the end-to-end latency of every frame
+ * and limits how many frames may be in the pipeline at once: the limit
+ * is cut whenever a frame takes longer than the budget and grows slowly
+ * while frames finish well within it. Frames arriving while the limit
+ * is reached are dropped by the source, so a pipeline that cannot keep
+ * up skips frames instead of falling further and further behind.
+ */
+
+namespace sprokit {
+
+/**
+ * \class latency_statistics_t <sprokit/pipeline/latency_feedback.h>
+ *
+ * \brief Counters and recent latencies of a \ref latency_channel.
+ */
+class latency_statistics_t
+{
+public:
+  latency_statistics_t()
+    : admitted( 0 )
+    , dropped( 0 )
+    , completed( 0 )
+    , in_flight( 0 )
+    , limit( 0 )
+    , latency_p50( 0 )
+    , latency_p99( 0 )
+    , latency_max( 0 )
+  {
+  }
+
+  /// The number of frames the source was allowed to send.
+  size_t admitted;
+  /// The number of frames the source dropped.
+  size_t dropped;
+  /// The number of frames reported finished.
+  size_t completed;
+  /// The number of frames sent but not yet finished.
+  size_t in_flight;
+  /// The current limit on frames in flight.
+  size_t limit;
+  /// Median latency, in seconds, of recently finished frames.
+  double latency_p50;
+  /// 99th percentile latency, in seconds, of recently finished frames.
+  double latency_p99;
+  /// Largest latency, in seconds, of recently finished frames.
+  double latency_max;
+};
+
+/**
+ * \class latency_channel <sprokit/pipeline/latency_feedback.h>
+ *
+ * \brief Adaptive admission control for one source of a pipeline.
+ *
+ * Frames are identified by a key which increases from frame to frame,
+ * such as a frame number. Finishing a frame also forgets every earlier
+ * frame still in flight, since those were lost along the way.
+ *
+ * \note All methods are thread safe.
+ */
+class SPROKIT_PIPELINE_EXPORT latency_channel
+{
+public:
+  typedef int64_t key_t;
+
+  /**
+   * \brief Get the channel with a given name, creating it if needed.
+   *
+   * Channels live until the program exits, so their statistics remain
+   * available after the pipeline is gone.
+   */
+  static std::shared_ptr< latency_channel > get( std::string const& name );
+
+  /**
+   * \brief Get the statistics of every channel.
+   *
+   * \returns Pairs of channel name and statistics, sorted by name.
+   */
+  static std::vector< std::pair< std::string, latency_statistics_t > >
+  all_statistics();
+
+  latency_channel();
+
+  /**
+   * \brief Set the latency budget.
+   *
+   * \param seconds Largest end-to-end latency to aim for.
+   */
+  void set_budget( double seconds );
+
+  /// Get the latency budget, in seconds.
+  double budget() const;
+
+  /// Forget all frames in flight and reset the counters and limit.
+  void reset();
+
+  /**
+   * \brief Decide whether the source should send a frame.
+   *
+   * \param key The key of the frame.
+   *
+   * \returns True if the frame should be sent; false if it should be
+   * dropped, which is counted.
+   */
+  bool admit( key_t key );
+
+  /**
+   * \brief Report that a frame has made it through the pipeline.
+   *
+   * \param key The key passed to admit(). Keys that were not admitted
+   * are ignored.
+   */
+  void complete( key_t key );
+
+  /// Get the current statistics.
+  latency_statistics_t statistics() const;
+
+private:
+  typedef std::chrono::steady_clock clock;
+
+  mutable std::mutex m_mutex;
+
+  double m_budget;
+  double m_limit;
+
+  // Send times of the frames in flight
+  std::map< key_t, clock::time_point > m_in_flight;
+
+  // Frames admitted before this have seen the last cut in the limit
+  key_t m_cut_barrier;
+  key_t m_last_admitted;
+
+  std::deque< double > m_recent;
+
+  size_t m_admitted;
+  size_t m_dropped;
+  size_t m_completed;
+};
+
+typedef std::shared_ptr< latency_channel > latency_channel_t;
+
+}
+
+#endif // SPROKIT_PIPELINE_LATENCY_FEEDBACK_H
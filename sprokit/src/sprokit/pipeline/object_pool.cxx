@@ -0,0 +1,245 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "object_pool.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <set>
+
+#include <cstdint>
+
+/**
+ * \file object_pool.cxx
+ *
+ * \brief Implementation of the pooled allocator.
+ */
+
+namespace sprokit {
+
+namespace {
+
+// Blocks are rounded up to a multiple of this, which also keeps them
+// aligned as operator new would
+size_t const granularity = 16;
+
+// Blocks larger than this always come from the heap
+size_t const max_pooled_size = 256;
+
+size_t const num_classes = max_pooled_size / granularity;
+
+// Most blocks one thread keeps per size
+size_t const max_cached = 1024;
+
+struct free_block
+{
+  free_block* next;
+};
+
+// Counters are only written by the owning thread, and read by
+// object_pool_statistics(), so need no read-modify-write
+class counter
+{
+public:
+  counter() : m_value( 0 ) {}
+
+  void add( uint64_t n = 1 )
+  {
+    m_value.store( m_value.load( std::memory_order_relaxed ) + n,
+                   std::memory_order_relaxed );
+  }
+
+  void sub( uint64_t n = 1 )
+  {
+    m_value.store( m_value.load( std::memory_order_relaxed ) - n,
+                   std::memory_order_relaxed );
+  }
+
+  uint64_t get() const { return m_value.load( std::memory_order_relaxed ); }
+
+private:
+  std::atomic< uint64_t > m_value;
+};
+
+struct thread_cache;
+
+// All live thread caches, and the totals of those that are gone. Never
+// destroyed, so threads may exit during static destruction.
+struct registry
+{
+  std::mutex mutex;
+  std::set< thread_cache* > caches;
+  object_pool_statistics_t retired;
+
+  static registry& instance()
+  {
+    static registry* const reg = new registry;
+    return *reg;
+  }
+};
+
+// ----------------------------------------------------------------------------
+struct thread_cache
+{
+  thread_cache()
+  {
+    registry& reg = registry::instance();
+    std::lock_guard< std::mutex > lock( reg.mutex );
+    reg.caches.insert( this );
+  }
+
+  ~thread_cache()
+  {
+    registry& reg = registry::instance();
+    std::lock_guard< std::mutex > lock( reg.mutex );
+
+    for ( size_t i = 0; i < num_classes; ++i )
+    {
+      while ( free_block* const block = lists[ i ] )
+      {
+        lists[ i ] = block->next;
+        ::operator delete( block );
+        released.add();
+      }
+    }
+
+    reg.retired.allocated += allocated.get();
+    reg.retired.reused += reused.get();
+    reg.retired.returned += returned.get();
+    reg.retired.released += released.get();
+    reg.caches.erase( this );
+  }
+
+  free_block* lists[ num_classes ] = {};
+  size_t counts[ num_classes ] = {};
+
+  counter allocated;
+  counter reused;
+  counter returned;
+  counter released;
+  counter cached;
+};
+
+// State of the calling thread's cache; trivially destructible, so it
+// may still be read after the cache itself is gone
+enum cache_state_t { cache_none, cache_live, cache_destroyed };
+thread_local cache_state_t cache_state = cache_none;
+
+struct thread_cache_owner
+{
+  thread_cache cache;
+
+  thread_cache_owner() { cache_state = cache_live; }
+  ~thread_cache_owner() { cache_state = cache_destroyed; }
+};
+
+// ----------------------------------------------------------------------------
+thread_cache*
+get_cache()
+{
+  if ( cache_state == cache_destroyed )
+  {
+    return nullptr;
+  }
+
+  static thread_local thread_cache_owner owner;
+  return &owner.cache;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+size_class( size_t size )
+{
+  return ( size ? size - 1 : 0 ) / granularity;
+}
+
+}
+
+// ----------------------------------------------------------------------------
+void*
+pool_allocate( size_t size )
+{
+  if ( size > max_pooled_size )
+  {
+    return ::operator new( size );
+  }
+
+  size_t const index = size_class( size );
+  thread_cache* const cache = get_cache();
+  if ( !cache )
+  {
+    return ::operator new( ( index + 1 ) * granularity );
+  }
+
+  cache->allocated.add();
+
+  if ( free_block* const block = cache->lists[ index ] )
+  {
+    cache->lists[ index ] = block->next;
+    --cache->counts[ index ];
+    cache->reused.add();
+    cache->cached.sub();
+    return block;
+  }
+
+  return ::operator new( ( index + 1 ) * granularity );
+}
+
+// ----------------------------------------------------------------------------
+void
+pool_deallocate( void* ptr, size_t size ) noexcept
+{
+  if ( !ptr )
+  {
+    return;
+  }
+
+  if ( size > max_pooled_size )
+  {
+    ::operator delete( ptr );
+    return;
+  }
+
+  size_t const index = size_class( size );
+  thread_cache* const cache = get_cache();
+  if ( !cache || cache->counts[ index ] >= max_cached )
+  {
+    ::operator delete( ptr );
+    if ( cache )
+    {
+      cache->released.add();
+    }
+    return;
+  }
+
+  free_block* const block = static_cast< free_block* >( ptr );
+  block->next = cache->lists[ index ];
+  cache->lists[ index ] = block;
+  ++cache->counts[ index ];
+  cache->returned.add();
+  cache->cached.add();
+}
+
+// ----------------------------------------------------------------------------
+object_pool_statistics_t
+object_pool_statistics()
+{
+  registry& reg = registry::instance();
+  std::lock_guard< std::mutex > lock( reg.mutex );
+
+  object_pool_statistics_t stats = reg.retired;
+  for ( thread_cache const* const cache : reg.caches )
+  {
+    stats.allocated += cache->allocated.get();
+    stats.reused += cache->reused.get();
+    stats.returned += cache->returned.get();
+    stats.released += cache->released.get();
+    stats.cached += cache->cached.get();
+  }
+
+  return stats;
+}
+
+}
@@ -0,0 +1,163 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef SPROKIT_PIPELINE_OBJECT_POOL_H
+#define SPROKIT_PIPELINE_OBJECT_POOL_H
+
+#include <sprokit/pipeline/sprokit_pipeline_export.h>
+
+#include <memory>
+
+#include <cstddef>
+
+/**
+ * \file object_pool.h
+ *
+ * \brief Pooled allocation for small, frequently created pipeline objects.
+ *
+ * Datums and stamps are created for every frame on every port, and
+ * usually freed soon after by another thread. Blocks for them come from
+ * per-thread free lists, sorted by size, instead of the heap; a freed
+ * block goes on the free list of the thread that frees it. Each list
+ * holds a bounded number of blocks and the rest go back to the heap, so
+ * a thread that only frees does not collect memory without limit.
+ */
+
+namespace sprokit {
+
+/**
+ * \class object_pool_statistics_t <sprokit/pipeline/object_pool.h>
+ *
+ * \brief Counters for the pooled allocator, summed over all threads.
+ */
+class object_pool_statistics_t
+{
+public:
+  object_pool_statistics_t()
+    : allocated( 0 )
+    , reused( 0 )
+    , returned( 0 )
+    , released( 0 )
+    , cached( 0 )
+  {
+  }
+
+  /// The number of blocks requested.
+  size_t allocated;
+  /// The number of requests served from a free list.
+  size_t reused;
+  /// The number of freed blocks kept on a free list.
+  size_t returned;
+  /// The number of freed blocks given back to the heap.
+  size_t released;
+  /// The number of blocks currently on free lists.
+  size_t cached;
+};
+
+/**
+ * \brief Allocate a block from the calling thread's pool.
+ *
+ * \param size The size of the block, in bytes.
+ *
+ * \returns Memory suitably aligned for any object of \p size bytes.
+ */
+SPROKIT_PIPELINE_EXPORT void* pool_allocate( size_t size );
+
+/**
+ * \brief Give a block back to the calling thread's pool.
+ *
+ * \param ptr A block from pool_allocate(), possibly from another thread.
+ * \param size The size passed to pool_allocate().
+ */
+SPROKIT_PIPELINE_EXPORT void pool_deallocate( void* ptr, size_t size ) noexcept;
+
+/**
+ * \brief Get the counters of the pooled allocator.
+ *
+ * \returns A snapshot of the counters of all threads.
+ */
+SPROKIT_PIPELINE_EXPORT object_pool_statistics_t object_pool_statistics();
+
+/**
+ * \class pool_allocator <sprokit/pipeline/object_pool.h>
+ *
+ * \brief Standard allocator using pool_allocate().
+ */
+template < typename T >
+class pool_allocator
+{
+public:
+  typedef T value_type;
+
+  pool_allocator() noexcept
+  {
+  }
+
+  template < typename U >
+  pool_allocator( pool_allocator< U > const& ) noexcept
+  {
+  }
+
+  T* allocate( size_t n )
+  {
+    return static_cast< T* >( pool_allocate( n * sizeof( T ) ) );
+  }
+
+  void deallocate( T* ptr, size_t n ) noexcept
+  {
+    pool_deallocate( ptr, n * sizeof( T ) );
+  }
+};
+
+template < typename T, typename U >
+bool
+operator==( pool_allocator< T > const&, pool_allocator< U > const& ) noexcept
+{
+  return true;
+}
+
+template < typename T, typename U >
+bool
+operator!=( pool_allocator< T > const&, pool_allocator< U > const& ) noexcept
+{
+  return false;
+}
+
+/**
+ * \brief Create a shared object whose object and control block are pooled.
+ *
+ * Unlike std::allocate_shared, the object is constructed by \p construct,
+ * which is called with a block of \c sizeof(T) bytes and must
+ * placement-new the object in it, so a class may use this with its own
+ * private constructors.
+ *
+ * \param construct Function constructing the object in the block given.
+ *
+ * \returns A shared pointer that puts the object back in the pool.
+ */
+template < typename T, typename Construct >
+std::shared_ptr< T >
+make_pooled_shared( Construct construct )
+{
+  void* const mem = pool_allocate( sizeof( T ) );
+
+  T* obj;
+  try
+  {
+    obj = construct( mem );
+  }
+  catch ( ... )
+  {
+    pool_deallocate( mem, sizeof( T ) );
+    throw;
+  }
+
+  return std::shared_ptr< T >( obj,
+    []( T* p ) { p->~T(); pool_deallocate( p, sizeof( T ) ); },
+    pool_allocator< T >() );
+}
+
+}
+
+#endif // SPROKIT_PIPELINE_OBJECT_POOL_H
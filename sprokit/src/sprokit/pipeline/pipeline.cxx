@@ -17,6 +17,11 @@
 #include <boost/graph/directed_graph.hpp>
 #include <boost/graph/topological_sort.hpp>
 
+#include <boost/chrono/duration.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <functional>
 #include <map>
 #include <queue>
@@ -24,6 +29,7 @@
 #include <stdexcept>
 #include <stack>
 #include <string>
+#include <thread>
 #include <vector>
 #include <sstream>
 #include <memory>
@@ -139,6 +145,7 @@ class pipeline::priv
     void check_for_processes() const;
     void map_cluster_connections();
     void configure_processes();
+    void resolve_data_dep_connections(process::name_t const& name, process_t const& proc);
     void check_for_data_dep_ports() const;
     void propagate_pinned_types();
     void check_for_untyped_ports() const;
@@ -147,6 +154,10 @@ class pipeline::priv
     void check_for_dag() const;
     void initialize_processes();
     void check_port_frequencies() const;
+    void fuse_processes();
+
+    void run_setup_step(processes_t const& procs,
+                        std::function<void (process_t const&)> const& step) const;
 
     void ensure_setup() const;
 
@@ -208,6 +219,8 @@ class pipeline::priv
 
   private:
   static kwiver::vital::config_block_key_t const config_non_blocking;
+    static kwiver::vital::config_block_key_t const config_fuse;
+    static kwiver::vital::config_block_key_t const config_setup_threads;
     static kwiver::vital::config_block_key_t const config_edge;
     static kwiver::vital::config_block_key_t const config_edge_type;
     static kwiver::vital::config_block_key_t const config_edge_conn;
@@ -217,6 +230,8 @@ class pipeline::priv
 
 // Process property
 kwiver::vital::config_block_key_t const pipeline::priv::config_non_blocking = kwiver::vital::config_block_key_t("_non_blocking");
+kwiver::vital::config_block_key_t const pipeline::priv::config_fuse         = kwiver::vital::config_block_key_t("_fuse");
+kwiver::vital::config_block_key_t const pipeline::priv::config_setup_threads = kwiver::vital::config_block_key_t("_setup_threads");
 
 // Pipeline properties
 kwiver::vital::config_block_key_t const pipeline::priv::config_edge         = kwiver::vital::config_block_key_t("_edge");
@@ -504,6 +519,7 @@ ::setup_pipeline()
     d->check_for_dag();
     d->initialize_processes();
     d->check_port_frequencies();
+    d->fuse_processes();
   }
   catch (...)
   {
@@ -1145,6 +1161,72 @@ ::get_python_processes() const
   return python_processes;
 }
 
+// ------------------------------------------------------------------
+connections_statistics_t
+pipeline
+::connection_statistics() const
+{
+  d->ensure_setup();
+
+  connections_statistics_t stats;
+
+  for (size_t i = 0; i < d->connections.size(); ++i)
+  {
+    edge_t const& e = d->edge_map[i];
+
+    if (e)
+    {
+      stats.push_back(connection_statistics_t(d->connections[i], e->statistics()));
+    }
+  }
+
+  return stats;
+}
+
+// ------------------------------------------------------------------
+process_states_t
+pipeline
+::save_state() const
+{
+  d->ensure_setup();
+
+  process_states_t states;
+
+  for (auto const& p : d->process_map)
+  {
+    std::string state = p.second->save_state();
+
+    if (!state.empty())
+    {
+      states[p.first] = std::move(state);
+    }
+  }
+
+  return states;
+}
+
+// ------------------------------------------------------------------
+void
+pipeline
+::restore_state(process_states_t const& states)
+{
+  d->ensure_setup();
+
+  for (auto const& s : states)
+  {
+    auto const i = d->process_map.find(s.first);
+
+    if (i == d->process_map.end())
+    {
+      LOG_WARN( d->m_logger, "Skipping saved state of process \""
+                << s.first << "\" which is not in the pipeline" );
+      continue;
+    }
+
+    i->second->restore_state(s.second);
+  }
+}
+
 // ------------------------------------------------------------------
 pipeline::priv
 ::priv(pipeline* pipe, kwiver::vital::config_block_sptr conf)
@@ -1555,65 +1637,103 @@ void
 pipeline::priv
 ::configure_processes()
 {
-  // Configure processes.
-  for (process_map_t::value_type const& proc_data : process_map)
+  auto const configure = [this](process_t const& proc)
   {
-    process::name_t const& name = proc_data.first;
-    process_t const& proc = proc_data.second;
-    process::connections_t unresolved_connections;
-
-    // Configure the process.
     proc->configure();
 
-    bool resolved_types = false;
+    LOG_DEBUG( m_logger, "Configured process \"" << proc->name() << "\" in "
+               << boost::chrono::duration<double>(proc->statistics().configure_time).count()
+               << " s" );
+  };
+
+  size_t const threads = config->get_value<size_t>(config_setup_threads, 1);
 
-    // Resolve any data dependent connections.
-    for (process::connection_t const& data_dep_connection : data_dep_connections)
+  if (threads > 1)
+  {
+    processes_t procs;
+    for (process_map_t::value_type const& proc_data : process_map)
     {
-      process::port_addr_t const& data_addr = data_dep_connection.first;
-      process::port_addr_t const& downstream_addr = data_dep_connection.second;
+      procs.push_back(proc_data.second);
+    }
 
-      process::name_t const& data_name = data_addr.first;
-      process::port_t const& data_port = data_addr.second;
-      process::name_t const& downstream_name = downstream_addr.first;
-      process::port_t const& downstream_port = downstream_addr.second;
+    // Configure processes concurrently, then resolve data dependent
+    // connections once every process has configured.
+    run_setup_step(procs, configure);
 
-      // if this is a connection from this process...
-      if (name == data_name)
-      {
-        process::port_info_t const info = proc->output_port_info(data_port);
+    for (process_map_t::value_type const& proc_data : process_map)
+    {
+      resolve_data_dep_connections(proc_data.first, proc_data.second);
+    }
+  }
+  else
+  {
+    // Configure processes in name order, resolving each one's data
+    // dependent connections before the next is configured, so that a
+    // connection which fails to resolve stops setup before any later
+    // process is configured.
+    for (process_map_t::value_type const& proc_data : process_map)
+    {
+      configure(proc_data.second);
+      resolve_data_dep_connections(proc_data.first, proc_data.second);
+    }
+  }
 
-        // The process should have resolved all data dependent ports
-        // by now. It is an error if there are still some around.
-        if (info->type == process::type_data_dependent)
-        {
-          VITAL_THROW( untyped_data_dependent_exception,
-                       data_name, data_port);
-        }
+  // Configure clusters.
+  for (cluster_map_t::value_type const& cluster_data : cluster_map)
+  {
+    process_cluster_t const& cluster = cluster_data.second;
 
-        resolved_types = true;
+    cluster->configure();
+  }
+}
 
-        q->connect(data_name, data_port,
-                   downstream_name, downstream_port);
-      }
-      else
+// ------------------------------------------------------------------
+void
+pipeline::priv
+::resolve_data_dep_connections(process::name_t const& name, process_t const& proc)
+{
+  process::connections_t unresolved_connections;
+
+  bool resolved_types = false;
+
+  // Resolve any data dependent connections.
+  for (process::connection_t const& data_dep_connection : data_dep_connections)
+  {
+    process::port_addr_t const& data_addr = data_dep_connection.first;
+    process::port_addr_t const& downstream_addr = data_dep_connection.second;
+
+    process::name_t const& data_name = data_addr.first;
+    process::port_t const& data_port = data_addr.second;
+    process::name_t const& downstream_name = downstream_addr.first;
+    process::port_t const& downstream_port = downstream_addr.second;
+
+    // if this is a connection from this process...
+    if (name == data_name)
+    {
+      process::port_info_t const info = proc->output_port_info(data_port);
+
+      // The process should have resolved all data dependent ports
+      // by now. It is an error if there are still some around.
+      if (info->type == process::type_data_dependent)
       {
-        unresolved_connections.push_back(data_dep_connection);
+        VITAL_THROW( untyped_data_dependent_exception,
+                     data_name, data_port);
       }
-    } // end for
 
-    if (resolved_types)
+      resolved_types = true;
+
+      q->connect(data_name, data_port,
+                 downstream_name, downstream_port);
+    }
+    else
     {
-      data_dep_connections = unresolved_connections;
+      unresolved_connections.push_back(data_dep_connection);
     }
   } // end for
 
-  // Configure clusters.
-  for (cluster_map_t::value_type const& cluster_data : cluster_map)
+  if (resolved_types)
   {
-    process_cluster_t const& cluster = cluster_data.second;
-
-    cluster->configure();
+    data_dep_connections = unresolved_connections;
   }
 }
 
@@ -2049,12 +2169,114 @@ ::initialize_processes()
 {
   process::names_t const names = q->process_names();
 
-  // Initialize processes.
+  processes_t procs;
   for (process::name_t const& name : names)
   {
-    process_t const proc = q->process_by_name(name);
+    procs.push_back(q->process_by_name(name));
+  }
 
+  // Initialize processes.
+  run_setup_step(procs, [this](process_t const& proc)
+  {
     proc->init();
+
+    LOG_DEBUG( m_logger, "Initialized process \"" << proc->name() << "\" in "
+               << boost::chrono::duration<double>(proc->statistics().init_time).count()
+               << " s" );
+  });
+}
+
+// ------------------------------------------------------------------
+/*
+ * Run a setup step, such as configuring, on each process. With
+ * _setup_threads above one, processes are handled concurrently, since
+ * many load large models. Processes which cannot leave the thread they
+ * were created in, because they run Python or declare no_threads, are
+ * handled in order on the calling thread meanwhile. Once a step fails
+ * no more are started, and the error is rethrown when the running ones
+ * have finished.
+ */
+void
+pipeline::priv
+::run_setup_step(processes_t const& procs,
+                 std::function<void (process_t const&)> const& step) const
+{
+  size_t const threads = config->get_value<size_t>(config_setup_threads, 1);
+
+  processes_t serial;
+  processes_t parallel;
+
+  for (process_t const& proc : procs)
+  {
+    process::properties_t const props = proc->properties();
+
+    if ((threads > 1) &&
+        !props.count(process::property_no_threads) &&
+        !props.count(process::property_python))
+    {
+      parallel.push_back(proc);
+    }
+    else
+    {
+      serial.push_back(proc);
+    }
+  }
+
+  std::vector<std::exception_ptr> errors(parallel.size());
+  std::atomic<size_t> next(0);
+  std::atomic<bool> failed(false);
+
+  auto const worker = [&]()
+  {
+    for (size_t i = next++; (i < parallel.size()) && !failed; i = next++)
+    {
+      try
+      {
+        step(parallel[i]);
+      }
+      catch (...)
+      {
+        errors[i] = std::current_exception();
+        failed = true;
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (size_t t = 0; t < std::min(threads, parallel.size()); ++t)
+  {
+    pool.emplace_back(worker);
+  }
+
+  std::exception_ptr serial_error;
+  try
+  {
+    for (process_t const& proc : serial)
+    {
+      step(proc);
+    }
+  }
+  catch (...)
+  {
+    serial_error = std::current_exception();
+  }
+
+  for (std::thread& t : pool)
+  {
+    t.join();
+  }
+
+  if (serial_error)
+  {
+    std::rethrow_exception(serial_error);
+  }
+
+  for (std::exception_ptr const& error : errors)
+  {
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
   }
 }
 
@@ -2207,6 +2429,128 @@ ::check_port_frequencies() const
   }
 }
 
+// ------------------------------------------------------------------
+/*
+ * Find chains of processes where each fusable process takes all of its
+ * input from the one before it, which sends all of its output to it,
+ * and have the first process of each chain step the rest. Schedulers
+ * then run a chain as one unit and data moves along it without waiting
+ * on another thread.
+ */
+void
+pipeline::priv
+::fuse_processes()
+{
+  if (!config->get_value<bool>(config_fuse, false))
+  {
+    return;
+  }
+
+  process::port_frequency_t const one(1);
+
+  // The process fused onto each process
+  std::map<process::name_t, process::name_t> next;
+  std::set<process::name_t> fused;
+
+  for (process_map_t::value_type const& entry : process_map)
+  {
+    process::name_t const& name = entry.first;
+    process_t const& proc = entry.second;
+    process::properties_t const props = proc->properties();
+
+    if (!props.count(process::property_fusable) ||
+        props.count(process::property_unsync_input) ||
+        props.count(process::property_python))
+    {
+      continue;
+    }
+
+    process::name_t upstream_name;
+    bool fusable = true;
+
+    for (process::connection_t const& connection : connections)
+    {
+      process::port_addr_t const& upstream_addr = connection.first;
+      process::port_addr_t const& downstream_addr = connection.second;
+
+      if (downstream_addr.first != name)
+      {
+        continue;
+      }
+
+      process_t const up_proc = process_map[upstream_addr.first];
+      edge_t const e = q->edge_for_connection(upstream_addr.first, upstream_addr.second,
+                                              downstream_addr.first, downstream_addr.second);
+
+      // One upstream process, with one datum per step each way
+      if ((!upstream_name.empty() && (upstream_name != upstream_addr.first)) ||
+          !e || !e->makes_dependency() ||
+          (proc->input_port_info(downstream_addr.second)->frequency != one) ||
+          (up_proc->output_port_info(upstream_addr.second)->frequency != one))
+      {
+        fusable = false;
+        break;
+      }
+
+      upstream_name = upstream_addr.first;
+    }
+
+    if (!fusable || upstream_name.empty())
+    {
+      continue;
+    }
+
+    process::properties_t const up_props = process_map[upstream_name]->properties();
+
+    if (up_props.count(process::property_unsync_output) ||
+        up_props.count(process::property_python))
+    {
+      continue;
+    }
+
+    // The upstream process must not send anything elsewhere.
+    for (process::connection_t const& connection : connections)
+    {
+      if ((connection.first.first == upstream_name) &&
+          (connection.second.first != name))
+      {
+        fusable = false;
+        break;
+      }
+    }
+
+    if (fusable)
+    {
+      next[upstream_name] = name;
+      fused.insert(name);
+    }
+  }
+
+  for (std::map<process::name_t, process::name_t>::value_type const& link : next)
+  {
+    process::name_t const& head = link.first;
+
+    if (fused.count(head))
+    {
+      continue;
+    }
+
+    processes_t chain;
+    std::string names;
+
+    for (std::map<process::name_t, process::name_t>::const_iterator i = next.find(head);
+         i != next.end(); i = next.find(i->second))
+    {
+      chain.push_back(process_map[i->second]);
+      names += " " + i->second;
+    }
+
+    process_map[head]->fuse(chain);
+
+    LOG_DEBUG( m_logger, "Fused onto process \"" << head << "\":" << names );
+  }
+}
+
 // ------------------------------------------------------------------
 void
 pipeline::priv
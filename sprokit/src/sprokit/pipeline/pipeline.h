@@ -7,11 +7,17 @@
 
 #include <sprokit/pipeline/sprokit_pipeline_export.h>
 
+#include "edge.h"
 #include "process.h"
 #include "types.h"
 
 #include <vital/noncopyable.h>
 
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 /**
  * \file pipeline.h
  *
@@ -20,6 +26,13 @@
 
 namespace sprokit {
 
+/// The statistics for the edge carrying a connection.
+typedef std::pair<process::connection_t, edge_statistics_t> connection_statistics_t;
+/// Statistics for a group of connections.
+typedef std::vector<connection_statistics_t> connections_statistics_t;
+/// The saved state of processes, by process name.
+typedef std::map<process::name_t, std::string> process_states_t;
+
 /**
  * \class pipeline pipeline.h <sprokit/pipeline/pipeline.h>
  *
@@ -477,6 +490,49 @@ class SPROKIT_PIPELINE_EXPORT pipeline
      */
     processes_t get_python_processes() const;
 
+    /**
+     * \brief Get the occupancy and blocking statistics for all edges.
+     *
+     * This may be called while the pipeline is running to monitor
+     * where data is backing up.
+     *
+     * \throws pipeline_not_setup_exception Thrown when the pipeline has not been setup.
+     * \throws pipeline_not_ready_exception Thrown when the pipeline has not been setup successfully.
+     *
+     * \returns The statistics for the edge of each connection in the pipeline.
+     */
+    connections_statistics_t connection_statistics() const;
+
+    /**
+     * \brief Save the internal state of all processes.
+     *
+     * Each process is saved between two of its steps, so this may be
+     * called while the pipeline is running. The result is not a consistent
+     * cut through the pipeline, though: processes are saved one after
+     * another, and data waiting in edges is not saved.
+     *
+     * \throws pipeline_not_setup_exception Thrown when the pipeline has not been setup.
+     * \throws pipeline_not_ready_exception Thrown when the pipeline has not been setup successfully.
+     *
+     * \returns The state of each process which keeps any.
+     */
+    process_states_t save_state() const;
+
+    /**
+     * \brief Restore the internal state of processes.
+     *
+     * This should be called after the pipeline is setup and before it is
+     * started. States for processes which are not in the pipeline are
+     * skipped with a warning, so a snapshot can be restored into a
+     * pipeline whose layout has since changed.
+     *
+     * \throws pipeline_not_setup_exception Thrown when the pipeline has not been setup.
+     * \throws pipeline_not_ready_exception Thrown when the pipeline has not been setup successfully.
+     *
+     * \param states The states returned by \ref save_state.
+     */
+    void restore_state(process_states_t const& states);
+
   private:
     friend class scheduler;
     SPROKIT_PIPELINE_NO_EXPORT void start();
@@ -18,6 +18,8 @@
 #include <boost/thread/locks.hpp>
 #include <boost/thread/shared_mutex.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <map>
 #include <utility>
 #include <memory>
@@ -48,6 +50,7 @@ process::property_t const process::property_unsync_input = property_t("_unsync_i
 process::property_t const process::property_unsync_output = property_t("_unsync_output");
 process::property_t const process::property_instrumented = property_t("_instrumented");
 process::property_t const process::property_python = property_t("_python");
+process::property_t const process::property_fusable = property_t("_fusable");
 
 process::port_t const process::port_heartbeat = port_t("_heartbeat");
 
@@ -124,6 +127,7 @@ class process::priv
     void connect_output_port(port_t const& port, edge_t const& edge);
 
     datum_t check_required_input();
+    bool fused_input_ready() const;
     void grab_from_input_edges();
     void push_to_output_edges(datum_t const& dat) const;
     bool required_outputs_done() const;
@@ -225,6 +229,18 @@ class process::priv
     // List of properties that are associated with this object
     properties_t m_properties;
 
+    // Processes stepped after each step of this one, and whether this
+    // one is stepped by an upstream process
+    processes_t fused;
+    bool is_fused;
+
+    // Step counters; written by the stepping thread, read by anyone
+    std::atomic<size_t> steps;
+    std::atomic<process_statistics_t::duration_t::rep> step_time;
+
+    process_statistics_t::duration_t configure_time;
+    process_statistics_t::duration_t init_time;
+
     static kwiver::vital::config_block_value_t const default_name;
 };
 
@@ -248,8 +264,12 @@ ::configure()
                  d->name);
   }
 
+  typedef boost::chrono::high_resolution_clock setup_clock_t;
+  setup_clock_t::time_point const start = setup_clock_t::now();
+
   _configure();
 
+  d->configure_time = setup_clock_t::now() - start;
   d->configured = true;
 }
 
@@ -270,8 +290,12 @@ ::init()
                  d->name);
   }
 
+  typedef boost::chrono::high_resolution_clock setup_clock_t;
+  setup_clock_t::time_point const start = setup_clock_t::now();
+
   _init();
 
+  d->init_time = setup_clock_t::now() - start;
   d->initialized = true;
 }
 
@@ -295,6 +319,12 @@ ::reset()
   d->configured = false;
   d->initialized = false;
   d->core_frequency.reset();
+
+  d->fused.clear();
+  d->is_fused = false;
+
+  d->steps = 0;
+  d->step_time = 0;
 }
 
 // ------------------------------------------------------------------
@@ -317,6 +347,9 @@ ::step()
   /// \todo Make reentrant.
   /// \todo Are there any pre-_step actions?
 
+  typedef boost::chrono::high_resolution_clock step_clock_t;
+  step_clock_t::time_point const start = step_clock_t::now();
+
   bool complete = false;
 
   if (d->is_complete)
@@ -374,6 +407,20 @@ ::step()
 
     mark_process_as_complete();
   }
+
+  d->step_time += (step_clock_t::now() - start).count();
+  ++d->steps;
+
+  // Step the processes fused onto this one for as long as they have
+  // input. Each only receives from the one before it, so one pass
+  // drains the chain.
+  for (process_t const& fused : d->fused)
+  {
+    while (fused->d->fused_input_ready())
+    {
+      fused->step();
+    }
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -718,6 +765,21 @@ ::_reconfigure(kwiver::vital::config_block_sptr const& /*conf*/)
 {
 }
 
+// ------------------------------------------------------------------
+std::string
+process
+::_save_state()
+{
+  return std::string();
+}
+
+// ------------------------------------------------------------------
+void
+process
+::_restore_state(std::string const& /*state*/)
+{
+}
+
 // ------------------------------------------------------------------
 process::properties_t
 process
@@ -1399,6 +1461,46 @@ ::count_output_port_edges(port_t const& port) const
   return edges.size();
 }
 
+// ------------------------------------------------------------------
+size_t
+process
+::count_output_port_data(port_t const& port) const
+{
+  if (!d->output_ports.count(port))
+  {
+    VITAL_THROW( no_such_port_exception,
+                 d->name, port);
+  }
+
+  priv::shared_lock_t lock(d->output_edges_mut);
+
+  (void)lock;
+
+  priv::output_edge_map_t::const_iterator const e = d->output_edges.find(port);
+
+  if (e == d->output_edges.end())
+  {
+    return size_t(0);
+  }
+
+  priv::mutex_t& mut = d->output_mutexes[port];
+
+  priv::shared_lock_t const port_lock(mut);
+
+  (void)port_lock;
+
+  priv::output_port_info_t const& info = *e->second;
+
+  size_t count = 0;
+
+  for (edge_t const& edge : info.edges)
+  {
+    count = std::max(count, edge->datum_count());
+  }
+
+  return count;
+}
+
 // ------------------------------------------------------------------
 edge_datum_t
 process
@@ -1426,6 +1528,126 @@ ::peek_at_port(port_t const& port, size_t idx) const
   return edge->peek_datum(idx);
 }
 
+// ------------------------------------------------------------------
+kwiver::vital::optional<edge_statistics_t>
+process
+::input_port_edge_statistics(port_t const& port) const
+{
+  if (!d->input_ports.count(port))
+  {
+    VITAL_THROW( no_such_port_exception,
+                 d->name, port);
+  }
+
+  priv::input_edge_map_t::const_iterator const e = d->input_edges.find(port);
+
+  if (e == d->input_edges.end())
+  {
+    return kwiver::vital::optional<edge_statistics_t>();
+  }
+
+  return e->second->edge->statistics();
+}
+
+// ------------------------------------------------------------------
+processes_t
+process
+::fused_processes() const
+{
+  return d->fused;
+}
+
+// ------------------------------------------------------------------
+bool
+process
+::is_fused() const
+{
+  return d->is_fused;
+}
+
+// ------------------------------------------------------------------
+kwiver::vital::config_block_sptr
+process
+::special_config() const
+{
+  kwiver::vital::config_block_sptr const conf = kwiver::vital::config_block::empty_config();
+
+  for (kwiver::vital::config_block_key_t const& key : d->conf->available_values())
+  {
+    if (!key.empty() && (key[0] == '_'))
+    {
+      conf->set_value(key, d->conf->get_value<kwiver::vital::config_block_value_t>(key));
+    }
+  }
+
+  return conf;
+}
+
+// ------------------------------------------------------------------
+process_statistics_t
+process
+::statistics() const
+{
+  process_statistics_t stats;
+
+  stats.steps = d->steps;
+  stats.step_time = process_statistics_t::duration_t(d->step_time.load());
+  stats.configure_time = d->configure_time;
+  stats.init_time = d->init_time;
+
+  return stats;
+}
+
+// ------------------------------------------------------------------
+std::string
+process
+::save_state()
+{
+  if (!d->initialized)
+  {
+    VITAL_THROW( uninitialized_exception,
+                 d->name);
+  }
+
+  // Wait for the current step, if any, to finish.
+  priv::unique_lock_t const lock(d->reconfigure_mut);
+
+  (void)lock;
+
+  return _save_state();
+}
+
+// ------------------------------------------------------------------
+void
+process
+::restore_state(std::string const& state)
+{
+  if (!d->initialized)
+  {
+    VITAL_THROW( uninitialized_exception,
+                 d->name);
+  }
+
+  priv::unique_lock_t const lock(d->reconfigure_mut);
+
+  (void)lock;
+
+  _restore_state(state);
+}
+
+// ------------------------------------------------------------------
+void
+process
+::fuse(processes_t const& downstream)
+{
+  d->fused = downstream;
+
+  for (process_t const& proc : downstream)
+  {
+    proc->d->is_fused = true;
+  }
+}
+
 // ------------------------------------------------------------------
 datum_t
 process
@@ -1463,14 +1685,41 @@ ::grab_from_port(port_t const& port) const
   return edge->get_datum();
 }
 
+// ------------------------------------------------------------------
+kwiver::vital::optional<edge_datum_t>
+process
+::try_grab_from_port(port_t const& port, edge::duration_t const& timeout) const
+{
+  if (!d->input_ports.count(port))
+  {
+    VITAL_THROW( no_such_port_exception,
+                 d->name, port);
+  }
+
+  priv::input_edge_map_t::const_iterator const e = d->input_edges.find(port);
+
+  if (e == d->input_edges.end())
+  {
+    static std::string const reason = "Data was requested from the port";
+
+    VITAL_THROW( missing_connection_exception,
+                 d->name, port, reason);
+  }
+
+  priv::input_port_info_t const& info = *e->second;
+  edge_t const& edge = info.edge;
+
+  return edge->try_get_datum(timeout);
+}
+
 // ------------------------------------------------------------------
 datum_t
 process
 ::grab_datum_from_port(port_t const& port) const
 {
-  edge_datum_t const edat = grab_from_port(port);
+  edge_datum_t edat = grab_from_port(port);
 
-  return edat.datum;
+  return std::move(edat.datum);
 }
 
 // ------------------------------------------------------------------
@@ -1896,6 +2145,12 @@ ::priv(process* proc,kwiver::vital::config_block_sptr const& c)
   , check_input_level(check_valid)
   , stamp_for_inputs()
   , m_logger( kwiver::vital::get_logger( "sprokit.process" ))
+  , fused()
+  , is_fused(false)
+  , steps(0)
+  , step_time(0)
+  , configure_time(process_statistics_t::duration_t::zero())
+  , init_time(process_statistics_t::duration_t::zero())
 {
 }
 
@@ -2256,6 +2511,32 @@ ::required_outputs_done() const
   return true;
 }
 
+// ------------------------------------------------------------------
+/*
+ * A fused process is stepped only when every connected input has data,
+ * so its step never waits for input that only the stepping thread
+ * could provide.
+ */
+bool
+process::priv
+::fused_input_ready() const
+{
+  if (is_complete || input_edges.empty())
+  {
+    return false;
+  }
+
+  for (auto const& port_edge : input_edges)
+  {
+    if (!port_edge.second->edge->has_data())
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 // ------------------------------------------------------------------
 /* Return tag name if flow dependent port.
  * Return empty string if there is no tag.
@@ -45,6 +45,35 @@ namespace sprokit {
 /// A group of processes.
 typedef std::vector<process_t> processes_t;
 
+/**
+ * \class process_statistics_t <sprokit/pipeline/process.h>
+ *
+ * \brief Step counters collected by a \ref process.
+ */
+class process_statistics_t
+{
+public:
+  typedef boost::chrono::high_resolution_clock::duration duration_t;
+
+  process_statistics_t()
+    : steps( 0 )
+    , step_time( duration_t::zero() )
+    , configure_time( duration_t::zero() )
+    , init_time( duration_t::zero() )
+  {
+  }
+
+  /// The number of times the process has been stepped.
+  size_t steps;
+  /// Total time spent in the steps of the process, including time
+  /// blocked on its edges but not the steps of processes fused onto it.
+  duration_t step_time;
+  /// Time spent configuring the process.
+  duration_t configure_time;
+  /// Time spent initializing the process.
+  duration_t init_time;
+};
+
 /**
  * \class process process.h <sprokit/pipeline/process.h>
  *
@@ -418,6 +447,86 @@ class SPROKIT_PIPELINE_EXPORT process
      */
     port_info_t input_port_info(port_t const& port);
 
+    /**
+     * \brief Get the statistics of the edge connected to an input port.
+     *
+     * This may be called from any thread while the pipeline is running,
+     * e.g. by an instrumentation provider that exports queue depths.
+     *
+     * \throws no_such_port_exception Thrown when \p port does not exist on the process.
+     *
+     * \param port The port to query.
+     *
+     * \returns The statistics of the edge, or nothing if the port is not connected.
+     */
+    kwiver::vital::optional<edge_statistics_t> input_port_edge_statistics(port_t const& port) const;
+
+    /**
+     * \brief Query for the processes fused onto this one.
+     *
+     * \returns The downstream processes stepped at the end of each step of
+     * this process, in order, or nothing if none are fused onto it.
+     */
+    processes_t fused_processes() const;
+
+    /**
+     * \brief Query whether the process is fused onto an upstream process.
+     *
+     * Schedulers must not step a fused process themselves; the process
+     * it is fused onto steps it.
+     *
+     * \returns True if another process steps this one.
+     */
+    bool is_fused() const;
+
+    /**
+     * \brief Get the special entries of the process configuration.
+     *
+     * Special entries start with an underscore, such as \c _non_blocking,
+     * and are settings for the pipeline and scheduler rather than the
+     * process itself.
+     *
+     * \returns A copy of the special entries.
+     */
+    kwiver::vital::config_block_sptr special_config() const;
+
+    /**
+     * \brief Get the step counters of the process.
+     *
+     * This may be called while the pipeline is running.
+     *
+     * \returns The number of steps taken and the time spent in them, and
+     * the time taken to configure and initialize the process.
+     */
+    process_statistics_t statistics() const;
+
+    /**
+     * \brief Save the internal state of the process.
+     *
+     * The state is what a process learns from the data it has seen, such
+     * as active tracks or a background model, which would take a while to
+     * rebuild if the pipeline were restarted. This waits for any step in
+     * progress to finish, so may be called while the pipeline is running.
+     *
+     * \throws uninitialized_exception Thrown if called before \ref init.
+     *
+     * \returns The state, or an empty string if the process keeps none.
+     */
+    std::string save_state();
+
+    /**
+     * \brief Restore state saved by \ref save_state.
+     *
+     * This is meant to be called after the pipeline is set up and before
+     * it is started, on a process configured like the one that saved the
+     * state.
+     *
+     * \throws uninitialized_exception Thrown if called before \ref init.
+     *
+     * \param state The state to restore.
+     */
+    void restore_state(std::string const& state);
+
     /**
      * \brief Query for information about an output port on the process.
      *
@@ -550,6 +659,20 @@ class SPROKIT_PIPELINE_EXPORT process
     /// Indicates the process is written in Python
     static property_t const property_python;
 
+    /**
+     * \brief A property which indicates that the process is cheap enough to be
+     * stepped by its upstream process.
+     *
+     * A pipeline configured with \c _pipeline:_fuse fuses such a process
+     * onto its upstream process when that is its only source of input and
+     * it is the only destination of that process' output. The upstream
+     * process then steps it after every one of its own steps, with no
+     * scheduling in between. The process must take one datum from every
+     * connected input port and push at most one datum to each output port
+     * per step, since nothing drains its output edges while it steps.
+     */
+    static property_t const property_fusable;
+
     /// The name of the heartbeat port.
     static port_t const port_heartbeat;
 
@@ -782,6 +905,28 @@ class SPROKIT_PIPELINE_EXPORT process
      */
     virtual void _reconfigure(kwiver::vital::config_block_sptr const& conf);
 
+    /**
+     * \brief Subclass state saving.
+     *
+     * Processes which keep state from step to step may override this to
+     * serialize it, typically with a \c data_serializer algorithm. This
+     * is never called while the process is stepping. The default keeps no
+     * state.
+     *
+     * \returns The state of the process.
+     */
+    virtual std::string _save_state();
+
+    /**
+     * \brief Subclass state restoring.
+     *
+     * The inverse of \ref _save_state. This is called after \ref _init
+     * and before the first step. The default does nothing.
+     *
+     * \param state The state returned by \ref _save_state.
+     */
+    virtual void _restore_state(std::string const& state);
+
     /**
      * \brief Subclass property query method.
      *
@@ -1111,6 +1256,23 @@ class SPROKIT_PIPELINE_EXPORT process
      */
     size_t count_output_port_edges(port_t const& port) const;
 
+    /**
+     * \brief Get the number of data waiting on an output port.
+     *
+     * This method returns the most data held by any of the edges
+     * connected to the port, that is, how far the slowest consumer of
+     * the port is behind. This is useful to send work to the least
+     * loaded of several consumers.
+     *
+     * \param port The port to get the count for.
+     *
+     * \throws no_such_port_exception if the named port does not exist.
+     *
+     * \returns The number of data waiting in the edges of \p port, or
+     * zero if it is not connected.
+     */
+    size_t count_output_port_data(port_t const& port) const;
+
     /**
      * \brief Peek at an edge datum packet from a port.
      *
@@ -1180,6 +1342,26 @@ class SPROKIT_PIPELINE_EXPORT process
      */
     datum_t grab_datum_from_port(port_t const& port) const;
 
+    /**
+     * \brief Grab an edge datum packet from a port if one arrives in time.
+     *
+     * This method returns the top edge datum from the edge queue
+     * connected to this port, waiting at most \p timeout for one to
+     * become available. A zero \p timeout only takes a datum which is
+     * already waiting.
+     *
+     * \param port The port to get data from.
+     * \param timeout The maximum amount of time to wait.
+     *
+     * \throws no_such_port_exception if the named port does not exist.
+     * \throws missing_connection_exception if port not connected.
+     *
+     * \returns The datum available on the port, or nothing if none
+     * arrived within \p timeout.
+     */
+    kwiver::vital::optional<edge_datum_t> try_grab_from_port(port_t const& port,
+                                                             edge::duration_t const& timeout) const;
+
     /**
      * \brief Grab a datum from a port as a certain type.
      *
@@ -1215,6 +1397,26 @@ class SPROKIT_PIPELINE_EXPORT process
     template <typename T>
     T try_grab_from_port_as(port_t const& port) const;
 
+    /**
+     * \brief Grab a datum from a port as a certain type, moving it if possible.
+     *
+     * This behaves like grab_from_port_as(), except that when this process
+     * holds the only reference to the datum taken from the edge, the value
+     * is moved out of the datum rather than copied. Data from edges which
+     * fan out to several processes is shared and is copied as usual; use
+     * grab_datum_from_port() with datum::get_datum_ref() to read such data
+     * without copying it.
+     *
+     * \param port The port to get data from.
+     *
+     * \throws no_such_port_exception if the named port does not exist.
+     * \throws missing_connection_exception if port not connected.
+     *
+     * \returns The datum from the port.
+     */
+    template <typename T>
+    T grab_datum_moved_as(port_t const& port) const;
+
     /**
      * \brief Grab an input as a specific type.
      *
@@ -1449,6 +1651,7 @@ SCOPED_INSTRUMENTATION(reconfigure);
 
     friend class pipeline;
     SPROKIT_PIPELINE_NO_EXPORT void set_core_frequency(port_frequency_t const& frequency);
+    SPROKIT_PIPELINE_NO_EXPORT void fuse(processes_t const& downstream);
     SPROKIT_PIPELINE_NO_EXPORT void reconfigure(kwiver::vital::config_block_sptr const& conf);
 
     friend class process_cluster;
@@ -1487,6 +1690,15 @@ ::try_grab_from_port_as(port_t const& port) const
           : T{} );
 }
 
+// ----------------------------------------------------------------------------
+template <typename T>
+T
+process
+::grab_datum_moved_as(port_t const& port) const
+{
+  return datum::take_datum<T>(grab_datum_from_port(port));
+}
+
 // ----------------------------------------------------------------------------
 template <typename T>
 T
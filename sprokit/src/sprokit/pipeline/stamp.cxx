@@ -3,6 +3,7 @@
 // https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
 
 #include "stamp.h"
+#include "object_pool.h"
 
 #include <stdexcept>
 
@@ -19,7 +20,10 @@ stamp_t
 stamp
 ::new_stamp(increment_t increment)
 {
-  return stamp_t(new stamp(increment, 0));
+  return make_pooled_shared<stamp>([&](void* mem)
+  {
+    return new (mem) stamp(increment, 0);
+  });
 }
 
 stamp_t
@@ -33,7 +37,10 @@ ::incremented_stamp(stamp_t const& st)
     throw std::runtime_error(reason);
   }
 
-  return stamp_t(new stamp(st->m_increment, st->m_index + st->m_increment));
+  return make_pooled_shared<stamp>([&](void* mem)
+  {
+    return new (mem) stamp(st->m_increment, st->m_index + st->m_increment);
+  });
 }
 
 bool
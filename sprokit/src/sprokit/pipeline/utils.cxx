@@ -20,6 +20,7 @@
 
 #ifdef __linux__
 #define NAME_THREAD_USING_PRCTL
+#define SCHEDULE_THREAD_USING_LINUX
 #endif
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -41,6 +42,19 @@
 #include <sys/prctl.h>
 #endif
 
+#ifdef SCHEDULE_THREAD_USING_LINUX
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <fstream>
+#endif
+
+#include <algorithm>
+#include <sstream>
+
 #if defined(_WIN32) || defined(_WIN64)
 
 #include <windows.h>
@@ -114,6 +128,129 @@ name_thread(thread_name_t const& name)
   return ret;
 }
 
+// ----------------------------------------------------------------------------
+bool
+parse_cpu_list(std::string const& spec, cpu_list_t& cpus)
+{
+  cpus.clear();
+
+  std::istringstream sstr(spec);
+  std::string range;
+
+  while (std::getline(sstr, range, ','))
+  {
+    // Allow whitespace around entries, and the trailing newline of the
+    // kernel's files.
+    range.erase(0, range.find_first_not_of(" \t\n"));
+    range.erase(range.find_last_not_of(" \t\n") + 1);
+
+    unsigned first;
+    unsigned last;
+    char dash;
+    std::istringstream rstr(range);
+
+    if (!(rstr >> first))
+    {
+      return false;
+    }
+
+    last = first;
+
+    if (rstr >> dash)
+    {
+      if ((dash != '-') || !(rstr >> last) || (last < first))
+      {
+        return false;
+      }
+    }
+
+    if (!rstr.eof())
+    {
+      return false;
+    }
+
+    for (unsigned cpu = first; cpu <= last; ++cpu)
+    {
+      cpus.push_back(cpu);
+    }
+  }
+
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+  return !cpus.empty();
+}
+
+// ----------------------------------------------------------------------------
+cpu_list_t
+numa_node_cpus(unsigned node)
+{
+  cpu_list_t cpus;
+
+#ifdef SCHEDULE_THREAD_USING_LINUX
+  std::ostringstream path;
+  path << "/sys/devices/system/node/node" << node << "/cpulist";
+
+  std::ifstream fin(path.str().c_str());
+  std::string spec;
+
+  if (!std::getline(fin, spec) || !parse_cpu_list(spec, cpus))
+  {
+    cpus.clear();
+  }
+#else
+  (void)node;
+#endif
+
+  return cpus;
+}
+
+// ----------------------------------------------------------------------------
+bool
+pin_thread(cpu_list_t const& cpus)
+{
+#ifdef SCHEDULE_THREAD_USING_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+
+  for (unsigned const cpu : cpus)
+  {
+    if (cpu >= CPU_SETSIZE)
+    {
+      return false;
+    }
+
+    CPU_SET(cpu, &set);
+  }
+
+  int const ret = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+
+  return (ret == 0);
+#else
+  (void)cpus;
+
+  return false;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+bool
+set_thread_priority(int priority)
+{
+#ifdef SCHEDULE_THREAD_USING_LINUX
+  // Linux keeps a niceness per thread, addressed by its thread id.
+  id_t const tid = static_cast<id_t>(syscall(SYS_gettid));
+
+  int const ret = setpriority(PRIO_PROCESS, tid, priority);
+
+  return (ret == 0);
+#else
+  (void)priority;
+
+  return false;
+#endif
+}
+
 // ----------------------------------------------------------------------------
 #ifdef NAME_THREAD_USING_PRCTL
 bool
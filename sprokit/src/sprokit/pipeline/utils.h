@@ -15,6 +15,7 @@
 
 #include <string>
 #include <typeinfo>
+#include <vector>
 
 namespace sprokit {
 
@@ -37,6 +38,63 @@ typedef std::string thread_name_t;
  */
 SPROKIT_PIPELINE_EXPORT bool name_thread(thread_name_t const& name);
 
+/// The type for a list of CPU numbers.
+typedef std::vector<unsigned> cpu_list_t;
+
+/**
+ * \brief Parse a list of CPUs.
+ *
+ * The list is written as for \c taskset(1) and the kernel's \c cpulist
+ * files: comma separated CPU numbers and inclusive ranges, such as
+ * \c "0-3,8,10-11".
+ *
+ * \param spec The text to parse.
+ * \param cpus Set to the CPUs listed, sorted and without duplicates.
+ *
+ * \returns True if \p spec is a valid, non-empty list, false otherwise.
+ */
+SPROKIT_PIPELINE_EXPORT bool parse_cpu_list(std::string const& spec, cpu_list_t& cpus);
+
+/**
+ * \brief Get the CPUs of a NUMA node.
+ *
+ * \note Only supported on Linux.
+ *
+ * \param node The number of the node.
+ *
+ * \returns The CPUs of the node, or an empty list if it is not known.
+ */
+SPROKIT_PIPELINE_EXPORT cpu_list_t numa_node_cpus(unsigned node);
+
+/**
+ * \brief Restrict the thread that the function was called from to some CPUs.
+ *
+ * Memory the thread allocates afterwards is normally placed on the NUMA
+ * node of the CPU it first touches it from, so pinning a thread to the
+ * CPUs of one node also keeps its data on that node.
+ *
+ * \note Only supported on Linux.
+ *
+ * \param cpus The CPUs the thread may run on.
+ *
+ * \returns True if the affinity was successfully set, false otherwise.
+ */
+SPROKIT_PIPELINE_EXPORT bool pin_thread(cpu_list_t const& cpus);
+
+/**
+ * \brief Set the scheduling priority of the thread that the function was
+ * called from.
+ *
+ * \note Only supported on Linux. Raising the priority above the default
+ * requires \c CAP_SYS_NICE or a suitable \c RLIMIT_NICE.
+ *
+ * \param priority The niceness of the thread, from -20 (most favorable)
+ * to 19 (least favorable), as for \c nice(1).
+ *
+ * \returns True if the priority was successfully set, false otherwise.
+ */
+SPROKIT_PIPELINE_EXPORT bool set_thread_priority(int priority);
+
 } // end namespace
 
 #endif // SPROKIT_PIPELINE_UTILS_H
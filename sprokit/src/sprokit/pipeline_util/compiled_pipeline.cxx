@@ -0,0 +1,379 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "compiled_pipeline.h"
+
+#include <vital/exceptions/io.h>
+#include <vital/logger/logger.h>
+#include <vital/util/file_md5.h>
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace sprokit {
+
+namespace {
+
+// First line of every compiled pipeline; bump the version if the layout changes
+std::string const compiled_header = "kwiver-compiled-pipeline 1";
+
+// ------------------------------------------------------------------
+// Strings are written as their length, a colon and their bytes, so
+// they may hold any character. Everything else is a number.
+class compiled_writer
+{
+public:
+  explicit compiled_writer( std::ostream& out )
+    : m_out( out )
+  {
+  }
+
+  void string( std::string const& s )
+  {
+    m_out << s.size() << ':' << s << ' ';
+  }
+
+  void strings( std::vector< std::string > const& list )
+  {
+    m_out << list.size() << ' ';
+    for ( auto const& s : list )
+    {
+      string( s );
+    }
+  }
+
+  void location( kwiver::vital::source_location const& loc )
+  {
+    if ( ! loc.valid() )
+    {
+      m_out << "-1 0\n";
+      return;
+    }
+
+    auto const known = m_file_index.find( loc.file() );
+    size_t index = m_files.size();
+    if ( known == m_file_index.end() )
+    {
+      m_file_index[ loc.file() ] = index;
+      m_files.push_back( loc.file() );
+    }
+    else
+    {
+      index = known->second;
+    }
+
+    m_out << index << ' ' << loc.line() << '\n';
+  }
+
+  void values( config_values_t const& values )
+  {
+    m_out << values.size() << '\n';
+    for ( auto const& v : values )
+    {
+      strings( v.key_path );
+      strings( v.flags );
+      string( v.value );
+      location( v.loc );
+    }
+  }
+
+  void block( pipe_block const& b )
+  {
+    if ( auto const* const conf = kwiver::vital::get_if< config_pipe_block >( &b ) )
+    {
+      m_out << "c ";
+      strings( conf->key );
+      values( conf->values );
+      location( conf->loc );
+    }
+    else if ( auto const* const proc = kwiver::vital::get_if< process_pipe_block >( &b ) )
+    {
+      m_out << "p ";
+      string( proc->name );
+      string( proc->type );
+      values( proc->config_values );
+      location( proc->loc );
+    }
+    else if ( auto const* const conn = kwiver::vital::get_if< connect_pipe_block >( &b ) )
+    {
+      m_out << "k ";
+      string( conn->from.first );
+      string( conn->from.second );
+      string( conn->to.first );
+      string( conn->to.second );
+      location( conn->loc );
+    }
+  }
+
+  /// Files referred to by the locations written so far
+  std::vector< std::string > const& files() const { return m_files; }
+
+private:
+  std::ostream& m_out;
+  std::vector< std::string > m_files;
+  std::map< std::string, size_t > m_file_index;
+};
+
+// ------------------------------------------------------------------
+class compiled_reader
+{
+public:
+  compiled_reader( std::istream& in, std::string const& path )
+    : m_in( in ),
+      m_path( path )
+  {
+  }
+
+  size_t number()
+  {
+    size_t n;
+    if ( ! ( m_in >> n ) )
+    {
+      truncated();
+    }
+    return n;
+  }
+
+  std::string string()
+  {
+    size_t const size = number();
+    if ( m_in.get() != ':' )
+    {
+      truncated();
+    }
+
+    std::string s( size, '\0' );
+    if ( size && ! m_in.read( &s[0], size ) )
+    {
+      truncated();
+    }
+    return s;
+  }
+
+  std::vector< std::string > strings()
+  {
+    std::vector< std::string > list( number() );
+    for ( auto& s : list )
+    {
+      s = string();
+    }
+    return list;
+  }
+
+  void files( std::vector< std::string > const& names )
+  {
+    m_files.clear();
+    for ( auto const& name : names )
+    {
+      m_files.push_back( std::make_shared< std::string >( name ) );
+    }
+  }
+
+  kwiver::vital::source_location location()
+  {
+    long index;
+    int line;
+    if ( ! ( m_in >> index >> line ) )
+    {
+      truncated();
+    }
+
+    if ( index < 0 )
+    {
+      return kwiver::vital::source_location();
+    }
+    if ( static_cast< size_t >( index ) >= m_files.size() )
+    {
+      VITAL_THROW( kwiver::vital::invalid_file, m_path,
+                   "Compiled pipeline refers to an unknown source file" );
+    }
+    return kwiver::vital::source_location( m_files[ index ], line );
+  }
+
+  config_values_t values()
+  {
+    config_values_t values( number() );
+    for ( auto& v : values )
+    {
+      v.key_path = strings();
+      v.flags = strings();
+      v.value = string();
+      v.loc = location();
+    }
+    return values;
+  }
+
+  pipe_block block()
+  {
+    char type;
+    if ( ! ( m_in >> type ) )
+    {
+      truncated();
+    }
+
+    switch ( type )
+    {
+      case 'c':
+      {
+        config_pipe_block conf;
+        conf.key = strings();
+        conf.values = values();
+        conf.loc = location();
+        return conf;
+      }
+      case 'p':
+      {
+        process_pipe_block proc;
+        proc.name = string();
+        proc.type = string();
+        proc.config_values = values();
+        proc.loc = location();
+        return proc;
+      }
+      case 'k':
+      {
+        connect_pipe_block conn;
+        conn.from.first = string();
+        conn.from.second = string();
+        conn.to.first = string();
+        conn.to.second = string();
+        conn.loc = location();
+        return conn;
+      }
+      default:
+        VITAL_THROW( kwiver::vital::invalid_file, m_path,
+                     "Malformed compiled pipeline block" );
+    }
+  }
+
+private:
+  [[noreturn]] void truncated()
+  {
+    VITAL_THROW( kwiver::vital::invalid_file, m_path,
+                 "Compiled pipeline is truncated" );
+  }
+
+  std::istream& m_in;
+  std::string const m_path;
+  std::vector< std::shared_ptr< std::string > > m_files;
+};
+
+} // end namespace
+
+// ------------------------------------------------------------------
+void
+write_compiled_pipeline( std::string const& path,
+                         pipe_blocks const& blocks,
+                         std::string const& key )
+{
+  // The source files are only known once the blocks are written, but
+  // are needed first when reading, so the blocks go after them.
+  std::ostringstream body;
+  compiled_writer writer( body );
+
+  body << blocks.size() << '\n';
+  for ( auto const& b : blocks )
+  {
+    writer.block( b );
+  }
+
+  std::string const tmp_path = path + ".tmp";
+
+  {
+    std::ofstream out( tmp_path.c_str(), std::ios::binary | std::ios::trunc );
+    if ( ! out )
+    {
+      VITAL_THROW( kwiver::vital::file_write_exception, tmp_path,
+                   "Could not open file for writing" );
+    }
+
+    compiled_writer header( out );
+    out << compiled_header << "\n";
+    header.string( key );
+    out << "\n" << writer.files().size() << "\n";
+    for ( auto const& file : writer.files() )
+    {
+      // Locations which are not files, such as settings given on the
+      // command line, have an empty sum
+      header.string( file );
+      header.string( kwiver::vital::file_md5( file ) );
+      out << "\n";
+    }
+    out << body.str();
+
+    out.close();
+    if ( ! out )
+    {
+      VITAL_THROW( kwiver::vital::file_write_exception, tmp_path,
+                   "Could not write compiled pipeline" );
+    }
+  }
+
+  if ( std::rename( tmp_path.c_str(), path.c_str() ) != 0 )
+  {
+    std::remove( tmp_path.c_str() );
+    VITAL_THROW( kwiver::vital::file_write_exception, path,
+                 "Could not replace previous compiled pipeline" );
+  }
+}
+
+// ------------------------------------------------------------------
+bool
+read_compiled_pipeline( std::string const& path,
+                        std::string const& key,
+                        pipe_blocks& blocks )
+{
+  auto logger = kwiver::vital::get_logger( "sprokit.compiled_pipeline" );
+
+  std::ifstream in( path.c_str(), std::ios::binary );
+  if ( ! in )
+  {
+    return false;
+  }
+
+  std::string header;
+  std::getline( in, header );
+  if ( header != compiled_header )
+  {
+    VITAL_THROW( kwiver::vital::invalid_file, path,
+                 "Not a compiled pipeline" );
+  }
+
+  compiled_reader reader( in, path );
+
+  if ( reader.string() != key )
+  {
+    LOG_DEBUG( logger, "Compiled pipeline " << path
+               << " was built from other inputs" );
+    return false;
+  }
+
+  std::vector< std::string > files( reader.number() );
+  for ( auto& file : files )
+  {
+    file = reader.string();
+    if ( reader.string() != kwiver::vital::file_md5( file ) )
+    {
+      LOG_DEBUG( logger, "Compiled pipeline " << path
+                 << " is out of date with " << file );
+      return false;
+    }
+  }
+  reader.files( files );
+
+  pipe_blocks result( reader.number() );
+  for ( auto& b : result )
+  {
+    b = reader.block();
+  }
+
+  blocks.swap( result );
+  return true;
+}
+
+} // end namespace
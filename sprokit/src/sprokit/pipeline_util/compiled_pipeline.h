@@ -0,0 +1,66 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef SPROKIT_PIPELINE_UTIL_COMPILED_PIPELINE_H
+#define SPROKIT_PIPELINE_UTIL_COMPILED_PIPELINE_H
+
+#include <sprokit/pipeline_util/sprokit_pipeline_util_export.h>
+
+#include <sprokit/pipeline_util/pipe_declaration_types.h>
+
+#include <string>
+
+/**
+ * \file compiled_pipeline.h
+ *
+ * \brief Caching parsed pipe blocks, so a pipeline launched many times
+ * is parsed once.
+ */
+
+namespace sprokit {
+
+/**
+ * \brief Write parsed pipe blocks to a compiled pipeline file.
+ *
+ * The blocks are written with their source locations, along with the
+ * MD5 sum of every file they came from and a key naming the inputs,
+ * such as the pipe file and search path, that produced them. Blocks
+ * from files are expected; include directives, relative paths and
+ * comments have already been resolved by the parser, so loading the
+ * file needs none of that. The file is written next to \p path and
+ * then renamed over it.
+ *
+ * \throws kwiver::vital::file_write_exception Thrown if the file cannot be written.
+ *
+ * \param path The compiled pipeline file.
+ * \param blocks The blocks returned by pipeline_builder::pipeline_blocks().
+ * \param key Description of the inputs the blocks were parsed from.
+ */
+SPROKIT_PIPELINE_UTIL_EXPORT
+void write_compiled_pipeline( std::string const& path,
+                              pipe_blocks const& blocks,
+                              std::string const& key );
+
+/**
+ * \brief Read a compiled pipeline file if it is up to date.
+ *
+ * The file is up to date if it was written with the same \p key and
+ * none of the files the blocks came from have changed since.
+ *
+ * \throws kwiver::vital::invalid_file Thrown if the file is not a compiled pipeline or is truncated.
+ *
+ * \param path The compiled pipeline file.
+ * \param key Description of the inputs, as given to write_compiled_pipeline().
+ * \param blocks Set to the blocks in the file when it is up to date.
+ *
+ * \returns True if the file exists and is up to date.
+ */
+SPROKIT_PIPELINE_UTIL_EXPORT
+bool read_compiled_pipeline( std::string const& path,
+                             std::string const& key,
+                             pipe_blocks& blocks );
+
+} // end namespace
+
+#endif // SPROKIT_PIPELINE_UTIL_COMPILED_PIPELINE_H
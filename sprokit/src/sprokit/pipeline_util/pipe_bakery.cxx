@@ -19,7 +19,11 @@
 #include <sprokit/pipeline/process_cluster.h>
 #include <sprokit/pipeline/process_factory.h>
 
+#include <algorithm>
+#include <cctype>
+#include <map>
 #include <memory>
+#include <sstream>
 
 /**
  * \file pipe_bakery.cxx
@@ -32,6 +36,14 @@ namespace sprokit {
 namespace {
 
 static kwiver::vital::config_block_key_t const config_pipeline_key = kwiver::vital::config_block_key_t( "_pipeline" );
+static kwiver::vital::config_block_key_t const config_replicas_key = kwiver::vital::config_block_key_t( "_replicas" );
+
+static process::type_t const distribute_type = process::type_t( "distribute" );
+static process::type_t const collate_type = process::type_t( "collate" );
+static process::type_t const sink_type = process::type_t( "sink" );
+
+static void expand_replicas( bakery_base& bakery,
+                             kwiver::vital::config_block_sptr const& global_conf );
 
 } // end anonymous
 
@@ -70,6 +82,9 @@ bake_pipe_blocks( pipe_blocks const& blocks )
 
   pipe = std::make_shared< pipeline > ( pipeline_conf );
 
+  // Replace replicated processes with their distribute/collate farms.
+  expand_replicas( bakery, global_conf );
+
   // Create processes.
   {
     for( bakery_base::process_decl_t const & decl : bakery.m_processes )
@@ -175,4 +190,259 @@ pipe_bakery
 {
 }
 
+namespace {
+
+// ------------------------------------------------------------------
+size_t
+replica_count( process::name_t const& name,
+               kwiver::vital::config_block_sptr const& global_conf )
+{
+  kwiver::vital::config_block_key_t const key =
+    name + kwiver::vital::config_block::block_sep() + config_replicas_key;
+
+  if ( ! global_conf->has_value( key ) )
+  {
+    return 1;
+  }
+
+  std::string const value = global_conf->get_value< std::string >( key );
+
+  if ( value.empty() ||
+       ! std::all_of( value.begin(), value.end(),
+                      []( char c ) { return std::isdigit( static_cast< unsigned char >( c ) ); } ) )
+  {
+    VITAL_THROW( invalid_replicas_exception, name,
+                 "the replica count \"" + value + "\" is not a positive integer" );
+  }
+
+  std::istringstream sstr( value );
+  size_t count = 0;
+  sstr >> count;
+
+  if ( count == 0 )
+  {
+    VITAL_THROW( invalid_replicas_exception, name,
+                 "the replica count must be at least one" );
+  }
+
+  return count;
+}
+
+// ------------------------------------------------------------------
+/**
+ * @brief Name of a replica group.
+ *
+ * Group names are zero padded so that the distribute and collate
+ * processes, which walk their ports in sorted order, agree on the
+ * order of the replicas.
+ */
+std::string
+replica_group( size_t idx, size_t count )
+{
+  std::string const last = std::to_string( count - 1 );
+  std::string group = std::to_string( idx );
+
+  return std::string( last.size() - group.size(), '0' ) + group;
+}
+
+// ------------------------------------------------------------------
+/**
+ * @brief Expand processes declared with \c _replicas.
+ *
+ * A process declared with <tt>:_replicas N</tt> (N > 1) is replaced by
+ * N copies of the process sharing its configuration. A \c distribute
+ * process is placed in front of the copies and deals each input stream
+ * out round-robin and a \c collate process behind them reassembles
+ * the outputs in the same order, so downstream processes see the
+ * original stamp order.
+ *
+ * For a process named \c name the following processes are created:
+ *
+ *   - \c name/distribute receives every input connection of \c name.
+ *   - \c name/replica<i> are the copies of the process.
+ *   - \c name/collate provides every output connection of \c name.
+ *
+ * The status of the first input stream clocks the collate process;
+ * status ports of any other input streams are terminated in \c sink
+ * processes.
+ */
+void
+expand_replicas( bakery_base& bakery,
+                 kwiver::vital::config_block_sptr const& global_conf )
+{
+  typedef std::map< process::name_t, size_t > replicas_t;
+
+  replicas_t replicas;
+
+  for ( bakery_base::process_decl_t const& decl : bakery.m_processes )
+  {
+    size_t const count = replica_count( decl.first, global_conf );
+
+    if ( count > 1 )
+    {
+      replicas[ decl.first ] = count;
+    }
+  }
+
+  if ( replicas.empty() )
+  {
+    return;
+  }
+
+  process::port_t const sep = process::port_t( "/" );
+  kwiver::vital::config_block_key_t const block_sep = kwiver::vital::config_block::block_sep();
+
+  bakery_base::process_decls_t processes;
+  process::connections_t farm_connections;
+  process::connections_t connections;
+
+  for ( bakery_base::process_decl_t const& decl : bakery.m_processes )
+  {
+    process::name_t const& name = decl.first;
+    replicas_t::const_iterator const rep = replicas.find( name );
+
+    if ( rep == replicas.end() )
+    {
+      processes.push_back( decl );
+      continue;
+    }
+
+    size_t const count = rep->second;
+    process::name_t const dist_name = name + sep + "distribute";
+    process::name_t const coll_name = name + sep + "collate";
+
+    // Collect the ports of the process which are connected, in file order.
+    process::ports_t inputs;
+    process::ports_t outputs;
+
+    for ( process::connection_t const& conn : bakery.m_connections )
+    {
+      if ( conn.second.first == name &&
+           std::find( inputs.begin(), inputs.end(), conn.second.second ) == inputs.end() )
+      {
+        inputs.push_back( conn.second.second );
+      }
+
+      if ( conn.first.first == name &&
+           std::find( outputs.begin(), outputs.end(), conn.first.second ) == outputs.end() )
+      {
+        outputs.push_back( conn.first.second );
+      }
+    }
+
+    if ( inputs.empty() )
+    {
+      VITAL_THROW( invalid_replicas_exception, name,
+                   "a replicated process must have at least one connected input" );
+    }
+
+    processes.push_back( bakery_base::process_decl_t( dist_name, distribute_type ) );
+
+    if ( ! outputs.empty() )
+    {
+      processes.push_back( bakery_base::process_decl_t( coll_name, collate_type ) );
+    }
+
+    // The status ports must be connected before any other port of the
+    // same tag so that the dynamic ports get created.
+    process::port_t const clock_port = "status" + sep + inputs.front();
+
+    for ( process::port_t const& output : outputs )
+    {
+      farm_connections.push_back( process::connection_t(
+        process::port_addr_t( dist_name, clock_port ),
+        process::port_addr_t( coll_name, "status" + sep + output ) ) );
+    }
+
+    for ( size_t i = 1; i < inputs.size(); ++i )
+    {
+      process::name_t const sink_name = name + sep + "status" + sep + inputs[ i ];
+
+      processes.push_back( bakery_base::process_decl_t( sink_name, sink_type ) );
+      farm_connections.push_back( process::connection_t(
+        process::port_addr_t( dist_name, "status" + sep + inputs[ i ] ),
+        process::port_addr_t( sink_name, "sink" ) ) );
+    }
+
+    if ( outputs.empty() )
+    {
+      process::name_t const sink_name = name + sep + "status" + sep + inputs.front();
+
+      processes.push_back( bakery_base::process_decl_t( sink_name, sink_type ) );
+      farm_connections.push_back( process::connection_t(
+        process::port_addr_t( dist_name, clock_port ),
+        process::port_addr_t( sink_name, "sink" ) ) );
+    }
+
+    // Create the replicas with a copy of the original configuration.
+    kwiver::vital::config_block_sptr const proc_conf = global_conf->subblock( name );
+    kwiver::vital::config_block_keys_t const keys = proc_conf->available_values();
+
+    for ( size_t i = 0; i < count; ++i )
+    {
+      std::string const group = replica_group( i, count );
+      process::name_t const replica_name = name + sep + "replica" + group;
+
+      for ( kwiver::vital::config_block_key_t const& key : keys )
+      {
+        if ( key == config_replicas_key )
+        {
+          continue;
+        }
+
+        kwiver::vital::config_block_key_t const replica_key = replica_name + block_sep + key;
+
+        global_conf->set_value( replica_key, proc_conf->get_value< std::string >( key ) );
+
+        if ( proc_conf->is_read_only( key ) )
+        {
+          global_conf->mark_read_only( replica_key );
+        }
+      }
+
+      processes.push_back( bakery_base::process_decl_t( replica_name, decl.second ) );
+
+      for ( process::port_t const& input : inputs )
+      {
+        farm_connections.push_back( process::connection_t(
+          process::port_addr_t( dist_name, "dist" + sep + input + sep + group ),
+          process::port_addr_t( replica_name, input ) ) );
+      }
+
+      for ( process::port_t const& output : outputs )
+      {
+        farm_connections.push_back( process::connection_t(
+          process::port_addr_t( replica_name, output ),
+          process::port_addr_t( coll_name, "coll" + sep + output + sep + group ) ) );
+      }
+    }
+  }
+
+  // Reroute the original connections through the farms.
+  for ( process::connection_t const& conn : bakery.m_connections )
+  {
+    process::port_addr_t up = conn.first;
+    process::port_addr_t down = conn.second;
+
+    if ( replicas.count( up.first ) )
+    {
+      up = process::port_addr_t( up.first + sep + "collate", "res" + sep + up.second );
+    }
+
+    if ( replicas.count( down.first ) )
+    {
+      down = process::port_addr_t( down.first + sep + "distribute", "src" + sep + down.second );
+    }
+
+    connections.push_back( process::connection_t( up, down ) );
+  }
+
+  connections.insert( connections.begin(), farm_connections.begin(), farm_connections.end() );
+
+  bakery.m_processes.swap( processes );
+  bakery.m_connections.swap( connections );
+}
+
+} // end anonymous
+
 }
@@ -180,6 +180,28 @@ config_flag_mismatch_exception
 {
 }
 
+// ------------------------------------------------------------------
+invalid_replicas_exception
+::invalid_replicas_exception( process::name_t const& name,
+                              std::string const&     reason ) noexcept
+  : pipe_bakery_exception()
+  , m_name( name )
+  , m_reason( reason )
+{
+  std::stringstream sstr;
+
+  sstr  << "The \'" << m_name << "\' process "
+                                "cannot be replicated: "
+        << m_reason;
+
+  m_what = sstr.str();
+}
+
+invalid_replicas_exception
+::~invalid_replicas_exception() noexcept
+{
+}
+
 // ------------------------------------------------------------------
 relativepath_exception
 ::relativepath_exception( const std::string&                    msg,
@@ -222,4 +244,27 @@ provider_error_exception::
   ~provider_error_exception() noexcept
 { }
 
+// ------------------------------------------------------------------
+partition_exception::
+partition_exception( const std::string&                    msg,
+                     const kwiver::vital::source_location& loc ) noexcept
+  : pipe_bakery_exception()
+{
+  std::stringstream sstr;
+
+  sstr << msg << " at " << loc;
+  m_what = sstr.str();
+}
+
+partition_exception::
+partition_exception( const std::string& msg ) noexcept
+  : pipe_bakery_exception()
+{
+  m_what = msg;
+}
+
+partition_exception::
+~partition_exception() noexcept
+{ }
+
 } // end namespace
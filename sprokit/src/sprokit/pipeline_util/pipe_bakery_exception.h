@@ -276,6 +276,37 @@ class SPROKIT_PIPELINE_UTIL_EXPORT config_flag_mismatch_exception
     std::string const m_reason;
 };
 
+// ------------------------------------------------------------------
+/**
+ * \class invalid_replicas_exception pipe_bakery_exception.h <sprokit/pipeline_util/pipe_bakery_exception.h>
+ *
+ * \brief The exception thrown when a process cannot be replicated as requested.
+ *
+ * \ingroup exceptions
+ */
+class SPROKIT_PIPELINE_UTIL_EXPORT invalid_replicas_exception
+  : public pipe_bakery_exception
+{
+  public:
+    /**
+     * \brief Constructor.
+     *
+     * \param name The name of the replicated process.
+     * \param reason The reason the replication is invalid.
+     */
+    invalid_replicas_exception(process::name_t const& name, std::string const& reason) noexcept;
+    /**
+     * \brief Destructor.
+     */
+    virtual ~invalid_replicas_exception() noexcept;
+
+    /// The name of the replicated process.
+    process::name_t const m_name;
+
+    /// The reason the replication is invalid.
+    std::string const m_reason;
+};
+
 // ------------------------------------------------------------------
 class SPROKIT_PIPELINE_UTIL_EXPORT relativepath_exception
   : public pipe_bakery_exception
@@ -314,6 +345,33 @@ class SPROKIT_PIPELINE_UTIL_EXPORT provider_error_exception
 
 };
 
+// ------------------------------------------------------------------
+/**
+ * \class partition_exception pipe_bakery_exception.h <sprokit/pipeline_util/pipe_bakery_exception.h>
+ *
+ * \brief The exception thrown when a pipeline cannot be split over nodes.
+ *
+ * \ingroup exceptions
+ */
+class SPROKIT_PIPELINE_UTIL_EXPORT partition_exception
+  : public pipe_bakery_exception
+{
+public:
+  /**
+   * \brief Constructor.
+   */
+  partition_exception( const std::string& msg,
+                       const kwiver::vital::source_location& loc) noexcept;
+
+  partition_exception( const std::string& msg ) noexcept;
+
+  /**
+   * \brief Destructor.
+   */
+  virtual ~partition_exception() noexcept;
+
+};
+
 }
 
 #endif // SPROKIT_PIPELINE_UTIL_PIPE_BAKERY_EXCEPTION_H
@@ -105,6 +105,14 @@ ::load_cluster( kwiver::vital::path_t const& def_file )
   m_cluster_blocks = the_parser.parse_cluster( input, def_file );
 }
 
+// ------------------------------------------------------------------
+void
+pipeline_builder
+::load_blocks( sprokit::pipe_blocks const& blocks )
+{
+  m_blocks = blocks;
+}
+
 // ------------------------------------------------------------------
 void
 pipeline_builder
@@ -102,6 +102,17 @@ class SPROKIT_PIPELINE_UTIL_EXPORT pipeline_builder
    */
   void load_supplement( kwiver::vital::path_t const& path );
 
+  /**
+   * \brief Load pipe blocks which have already been parsed.
+   *
+   * This method replaces the internal representation of the pipeline
+   * with blocks parsed earlier, such as those read from a compiled
+   * pipeline file. Supplements and settings may be added afterwards.
+   *
+   * \param blocks The pipe blocks.
+   */
+  void load_blocks( sprokit::pipe_blocks const& blocks );
+
   /**
    * \brief Add single config entry
    *
@@ -0,0 +1,315 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "pipeline_partition.h"
+
+#include "pipe_bakery.h"
+#include "pipe_bakery_exception.h"
+
+#include <vital/config/config_block.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace sprokit {
+
+namespace {
+
+static kwiver::vital::config_block_key_t const config_node = "_node";
+static kwiver::vital::config_block_key_t const config_nodes = "_pipeline:_nodes";
+static kwiver::vital::config_block_key_t const config_default_node = "_pipeline:_default_node";
+static kwiver::vital::config_block_key_t const config_node_port = "_pipeline:_node_port";
+static kwiver::vital::config_block_key_t const config_node_serialization = "_pipeline:_node_serialization";
+
+// Message and element names of the serializer ports at a cut
+static std::string const cut_message = "data";
+static std::string const cut_element = "data/datum";
+
+// ----------------------------------------------------------------------------
+// A connection crossing nodes. Data from one port going to several
+// processes on another node is sent there once.
+struct cut_t
+{
+  process::port_addr_t from;
+  std::string from_node;
+  std::string to_node;
+  std::vector< connect_pipe_block > connections;
+};
+
+// ----------------------------------------------------------------------------
+class partition
+{
+public:
+  explicit partition( pipe_blocks const& blocks );
+
+  std::string const& node_of( process::name_t const& name,
+                              kwiver::vital::source_location const& loc ) const;
+
+  kwiver::vital::config_block_sptr config;
+  std::string default_node;
+
+  // Node of each process
+  std::map< process::name_t, std::string > nodes;
+
+  // Nodes in order of their first process
+  std::vector< std::string > node_order;
+
+  std::vector< cut_t > cuts;
+};
+
+// ----------------------------------------------------------------------------
+partition
+::partition( pipe_blocks const& blocks )
+  : config( extract_configuration( blocks ) )
+  , default_node( config->get_value< std::string >( config_default_node, "main" ) )
+{
+  node_order.push_back( default_node );
+
+  for ( auto const& block : blocks )
+  {
+    auto const* const proc = kwiver::vital::get_if< process_pipe_block >( &block );
+    if ( ! proc )
+    {
+      continue;
+    }
+
+    std::string const node = config->get_value< std::string >(
+      proc->name + kwiver::vital::config_block::block_sep() + config_node,
+      default_node );
+
+    nodes[ proc->name ] = node;
+    if ( std::find( node_order.begin(), node_order.end(), node ) == node_order.end() )
+    {
+      node_order.push_back( node );
+    }
+  }
+
+  // The default node may have been named only to be the default
+  bool default_used = false;
+  for ( auto const& n : nodes )
+  {
+    default_used = default_used || ( n.second == default_node );
+  }
+  if ( ! default_used )
+  {
+    node_order.erase( node_order.begin() );
+  }
+
+  std::map< std::pair< process::port_addr_t, std::string >, size_t > cut_index;
+
+  for ( auto const& block : blocks )
+  {
+    auto const* const conn = kwiver::vital::get_if< connect_pipe_block >( &block );
+    if ( ! conn )
+    {
+      continue;
+    }
+
+    std::string const& from_node = node_of( conn->from.first, conn->loc );
+    std::string const& to_node = node_of( conn->to.first, conn->loc );
+
+    if ( from_node == to_node )
+    {
+      continue;
+    }
+
+    auto const key = std::make_pair( conn->from, to_node );
+    auto const i = cut_index.find( key );
+
+    if ( i == cut_index.end() )
+    {
+      cut_index[ key ] = cuts.size();
+      cuts.push_back( cut_t{ conn->from, from_node, to_node, { *conn } } );
+    }
+    else
+    {
+      cuts[ i->second ].connections.push_back( *conn );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+std::string const&
+partition
+::node_of( process::name_t const& name,
+           kwiver::vital::source_location const& loc ) const
+{
+  auto const i = nodes.find( name );
+  if ( i == nodes.end() )
+  {
+    VITAL_THROW( partition_exception,
+                 "Connection to process \"" + name + "\" which is not defined",
+                 loc );
+  }
+  return i->second;
+}
+
+// ----------------------------------------------------------------------------
+config_value_t
+make_value( std::string const& key, std::string const& value,
+            kwiver::vital::source_location const& loc )
+{
+  config_value_t cv;
+  cv.key_path.push_back( key );
+  cv.value = value;
+  cv.loc = loc;
+  return cv;
+}
+
+// ----------------------------------------------------------------------------
+process_pipe_block
+make_process( process::name_t const& name, process::type_t const& type,
+              config_values_t const& values,
+              kwiver::vital::source_location const& loc )
+{
+  process_pipe_block block;
+  block.name = name;
+  block.type = type;
+  block.config_values = values;
+  block.loc = loc;
+  return block;
+}
+
+// ----------------------------------------------------------------------------
+connect_pipe_block
+make_connect( process::port_addr_t const& from, process::port_addr_t const& to,
+              kwiver::vital::source_location const& loc )
+{
+  connect_pipe_block block;
+  block.from = from;
+  block.to = to;
+  block.loc = loc;
+  return block;
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+pipeline_nodes_t
+pipeline_nodes( pipe_blocks const& blocks )
+{
+  partition const part( blocks );
+  kwiver::vital::config_block_sptr const nodes_config =
+    part.config->subblock( config_nodes );
+
+  pipeline_nodes_t nodes;
+
+  for ( auto const& name : part.node_order )
+  {
+    pipeline_node_t node;
+    node.name = name;
+    node.host = nodes_config->get_value< std::string >(
+      name + kwiver::vital::config_block::block_sep() + "host", "localhost" );
+    node.launch = nodes_config->get_value< std::string >(
+      name + kwiver::vital::config_block::block_sep() + "launch", "" );
+    nodes.push_back( node );
+  }
+
+  return nodes;
+}
+
+// ----------------------------------------------------------------------------
+pipe_blocks
+partition_pipe_blocks( pipe_blocks const& blocks, std::string const& node )
+{
+  partition const part( blocks );
+
+  if ( std::find( part.node_order.begin(), part.node_order.end(), node ) ==
+       part.node_order.end() )
+  {
+    VITAL_THROW( partition_exception,
+                 "No process of the pipeline runs on node \"" + node + "\"" );
+  }
+
+  kwiver::vital::config_block_sptr const nodes_config =
+    part.config->subblock( config_nodes );
+  int const base_port = part.config->get_value< int >( config_node_port, 5600 );
+  std::string const serialization = part.config->get_value< std::string >(
+    config_node_serialization, "protobuf" );
+
+  pipe_blocks result;
+
+  for ( auto const& block : blocks )
+  {
+    if ( auto const* const proc = kwiver::vital::get_if< process_pipe_block >( &block ) )
+    {
+      if ( part.nodes.at( proc->name ) == node )
+      {
+        result.push_back( block );
+      }
+    }
+    else if ( auto const* const conn = kwiver::vital::get_if< connect_pipe_block >( &block ) )
+    {
+      if ( part.nodes.at( conn->from.first ) == node &&
+           part.nodes.at( conn->to.first ) == node )
+      {
+        result.push_back( block );
+      }
+    }
+    else
+    {
+      // Every node sees the whole configuration
+      result.push_back( block );
+    }
+  }
+
+  for ( size_t i = 0; i < part.cuts.size(); ++i )
+  {
+    cut_t const& cut = part.cuts[ i ];
+    auto const& loc = cut.connections.front().loc;
+    std::string const prefix = "_cut" + std::to_string( i ) + "_";
+    std::string const port = std::to_string( base_port + static_cast< int >( i ) );
+
+    config_values_t ser_values;
+    ser_values.push_back( make_value( "serialization_type", serialization, loc ) );
+
+    if ( cut.from_node == node )
+    {
+      process::name_t const ser = prefix + "serialize";
+      process::name_t const send = prefix + "send";
+
+      config_values_t send_values;
+      send_values.push_back( make_value( "mode", "push", loc ) );
+      send_values.push_back( make_value( "port", port, loc ) );
+      send_values.push_back( make_value( "end_of_stream", "true", loc ) );
+
+      result.push_back( make_process( ser, "serializer", ser_values, loc ) );
+      result.push_back( make_process( send, "zmq_transport_send", send_values, loc ) );
+      result.push_back( make_connect( cut.from, { ser, cut_element }, loc ) );
+      result.push_back( make_connect( { ser, cut_message },
+                                      { send, "serialized_message" }, loc ) );
+    }
+    else if ( cut.to_node == node )
+    {
+      process::name_t const receive = prefix + "receive";
+      process::name_t const deser = prefix + "deserialize";
+
+      config_values_t receive_values;
+      receive_values.push_back( make_value( "mode", "pull", loc ) );
+      receive_values.push_back( make_value( "port", port, loc ) );
+      receive_values.push_back( make_value(
+        "connect_host",
+        nodes_config->get_value< std::string >(
+          cut.from_node + kwiver::vital::config_block::block_sep() + "host",
+          "localhost" ),
+        loc ) );
+      receive_values.push_back( make_value( "end_of_stream", "true", loc ) );
+
+      result.push_back( make_process( receive, "zmq_transport_receive", receive_values, loc ) );
+      result.push_back( make_process( deser, "deserializer", ser_values, loc ) );
+      result.push_back( make_connect( { receive, "serialized_message" },
+                                      { deser, cut_message }, loc ) );
+
+      for ( auto const& conn : cut.connections )
+      {
+        result.push_back( make_connect( { deser, cut_element }, conn.to, conn.loc ) );
+      }
+    }
+  }
+
+  return result;
+}
+
+} // end namespace
@@ -0,0 +1,102 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef SPROKIT_PIPELINE_UTIL_PIPELINE_PARTITION_H
+#define SPROKIT_PIPELINE_UTIL_PIPELINE_PARTITION_H
+
+#include <sprokit/pipeline_util/sprokit_pipeline_util_export.h>
+
+#include <sprokit/pipeline_util/pipe_declaration_types.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * \file pipeline_partition.h
+ *
+ * \brief Splitting one pipeline over several nodes.
+ *
+ * Processes are assigned to a node with the special \c _node config
+ * entry; processes without one run on the default node. Each node runs
+ * its own pipeline, built from the same pipe file. Where a connection
+ * crosses from one node to another, the upstream node serializes the
+ * data and sends it with a \c zmq_transport_send process, and the
+ * downstream node receives and deserializes it. The end of the data is
+ * sent along, so every part completes when the original pipeline would.
+ *
+ * Nodes are described in the \c _pipeline:_nodes config block:
+ *
+\code
+config _pipeline:_nodes
+   gpu1:host = gpu1.example.com
+   gpu1:launch = ssh gpu1.example.com
+\endcode
+ *
+ * The following \c _pipeline entries control the split:
+ *
+ * \li \c _default_node The node of processes without \c _node. The
+ * default is "main".
+ * \li \c _node_port The first TCP port used for connections between
+ * nodes; each connection crossing nodes uses the next one. The default
+ * is 5600.
+ * \li \c _node_serialization The serialization used between nodes. The
+ * default is "protobuf".
+ */
+
+namespace sprokit {
+
+/// A node which runs part of a pipeline.
+struct pipeline_node_t
+{
+  /// The name of the node, as used with \c _node.
+  std::string name;
+
+  /// The host other nodes connect to, from \c _nodes:<name>:host.
+  std::string host;
+
+  /// The command which runs a program on the node, such as an ssh
+  /// command, from \c _nodes:<name>:launch. Empty to run locally.
+  std::string launch;
+};
+
+typedef std::vector< pipeline_node_t > pipeline_nodes_t;
+
+/**
+ * \brief Get the nodes a pipeline runs on.
+ *
+ * \throws partition_exception Thrown when a connection refers to an
+ * unknown process.
+ *
+ * \param blocks The blocks of the whole pipeline.
+ *
+ * \returns The nodes with at least one process, the default node first
+ * and the others in order of their first process.
+ */
+SPROKIT_PIPELINE_UTIL_EXPORT
+pipeline_nodes_t pipeline_nodes( pipe_blocks const& blocks );
+
+/**
+ * \brief Get the part of a pipeline which runs on one node.
+ *
+ * The result holds the config blocks of the whole pipeline, the
+ * process blocks of the processes on the node, the connections between
+ * them, and the transport processes and connections for the connections
+ * to and from other nodes. Every node numbers the connections crossing
+ * nodes the same way, so the parts agree on the ports they use.
+ *
+ * \throws partition_exception Thrown when the node runs no process, or a
+ * connection refers to an unknown process.
+ *
+ * \param blocks The blocks of the whole pipeline.
+ * \param node The name of the node.
+ *
+ * \returns The blocks of the part of the pipeline on \p node.
+ */
+SPROKIT_PIPELINE_UTIL_EXPORT
+pipe_blocks partition_pipe_blocks( pipe_blocks const& blocks,
+                                   std::string const& node );
+
+} // end namespace
+
+#endif // SPROKIT_PIPELINE_UTIL_PIPELINE_PARTITION_H
@@ -0,0 +1,195 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "pipeline_snapshot.h"
+
+#include <vital/exceptions/io.h>
+#include <vital/logger/logger.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+
+namespace sprokit {
+
+namespace {
+
+// First line of every snapshot file; bump the version if the layout changes
+std::string const snapshot_header = "kwiver-pipeline-snapshot 1";
+
+}
+
+// ------------------------------------------------------------------
+void
+write_pipeline_snapshot( std::string const& path,
+                         process_states_t const& states )
+{
+  std::string const tmp_path = path + ".tmp";
+
+  {
+    std::ofstream out( tmp_path.c_str(), std::ios::binary | std::ios::trunc );
+    if ( ! out )
+    {
+      VITAL_THROW( kwiver::vital::file_write_exception, tmp_path,
+                   "Could not open file for writing" );
+    }
+
+    // Each entry is a line with the lengths of the process name and its
+    // state, followed by both; states are binary and may hold newlines.
+    out << snapshot_header << "\n";
+    for ( auto const& s : states )
+    {
+      out << s.first.size() << " " << s.second.size() << "\n"
+          << s.first << s.second << "\n";
+    }
+
+    out.close();
+    if ( ! out )
+    {
+      VITAL_THROW( kwiver::vital::file_write_exception, tmp_path,
+                   "Could not write snapshot" );
+    }
+  }
+
+  if ( std::rename( tmp_path.c_str(), path.c_str() ) != 0 )
+  {
+    std::remove( tmp_path.c_str() );
+    VITAL_THROW( kwiver::vital::file_write_exception, path,
+                 "Could not replace previous snapshot" );
+  }
+}
+
+// ------------------------------------------------------------------
+process_states_t
+read_pipeline_snapshot( std::string const& path )
+{
+  std::ifstream in( path.c_str(), std::ios::binary );
+  if ( ! in )
+  {
+    VITAL_THROW( kwiver::vital::file_not_found_exception, path,
+                 "Could not open snapshot" );
+  }
+
+  std::string header;
+  std::getline( in, header );
+  if ( header != snapshot_header )
+  {
+    VITAL_THROW( kwiver::vital::invalid_file, path,
+                 "Not a pipeline snapshot" );
+  }
+
+  process_states_t states;
+  size_t name_size;
+  size_t state_size;
+
+  while ( in >> name_size >> state_size )
+  {
+    if ( in.get() != '\n' )
+    {
+      break;
+    }
+
+    std::string name( name_size, '\0' );
+    std::string state( state_size, '\0' );
+    in.read( &name[0], name_size );
+    in.read( &state[0], state_size );
+
+    if ( ! in || in.get() != '\n' )
+    {
+      VITAL_THROW( kwiver::vital::invalid_file, path,
+                   "Snapshot is truncated" );
+    }
+
+    states[ name ] = std::move( state );
+  }
+
+  if ( ! in.eof() )
+  {
+    VITAL_THROW( kwiver::vital::invalid_file, path,
+                 "Malformed snapshot entry" );
+  }
+
+  return states;
+}
+
+// ------------------------------------------------------------------
+pipeline_checkpointer
+::pipeline_checkpointer( pipeline_t const& pipe,
+                         std::string const& path,
+                         double interval )
+  : m_pipe( pipe )
+  , m_path( path )
+  , m_interval( interval )
+  , m_stopping( false )
+{
+  m_thread = std::thread( &pipeline_checkpointer::run, this );
+}
+
+pipeline_checkpointer
+::~pipeline_checkpointer()
+{
+  stop();
+}
+
+// ------------------------------------------------------------------
+void
+pipeline_checkpointer
+::stop( bool final_snapshot )
+{
+  {
+    std::lock_guard< std::mutex > const lock( m_mutex );
+    m_stopping = true;
+  }
+  m_cond.notify_all();
+
+  if ( m_thread.joinable() )
+  {
+    m_thread.join();
+
+    if ( final_snapshot )
+    {
+      checkpoint();
+    }
+  }
+}
+
+// ------------------------------------------------------------------
+void
+pipeline_checkpointer
+::run()
+{
+  auto const period = std::chrono::duration_cast< std::chrono::steady_clock::duration >(
+    std::chrono::duration< double >( m_interval ) );
+  auto next = std::chrono::steady_clock::now() + period;
+
+  std::unique_lock< std::mutex > lock( m_mutex );
+  while ( ! m_cond.wait_until( lock, next, [this] { return m_stopping; } ) )
+  {
+    lock.unlock();
+    checkpoint();
+    lock.lock();
+
+    next += period;
+  }
+}
+
+// ------------------------------------------------------------------
+void
+pipeline_checkpointer
+::checkpoint()
+{
+  auto logger = kwiver::vital::get_logger( "sprokit.pipeline_checkpointer" );
+
+  try
+  {
+    write_pipeline_snapshot( m_path, m_pipe->save_state() );
+    LOG_DEBUG( logger, "Wrote pipeline snapshot to " << m_path );
+  }
+  catch ( std::exception const& e )
+  {
+    LOG_WARN( logger, "Could not write pipeline snapshot: " << e.what() );
+  }
+}
+
+} // end namespace
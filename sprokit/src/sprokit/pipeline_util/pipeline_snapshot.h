@@ -0,0 +1,104 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef SPROKIT_PIPELINE_UTIL_PIPELINE_SNAPSHOT_H
+#define SPROKIT_PIPELINE_UTIL_PIPELINE_SNAPSHOT_H
+
+#include <sprokit/pipeline_util/sprokit_pipeline_util_export.h>
+
+#include <sprokit/pipeline/pipeline.h>
+#include <sprokit/pipeline/types.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * \file pipeline_snapshot.h
+ *
+ * \brief Saving and restoring the state of a pipeline, so a restarted
+ * pipeline picks up where the previous one left off.
+ */
+
+namespace sprokit {
+
+/**
+ * \brief Write the state of a pipeline to a snapshot file.
+ *
+ * The file is written next to \p path and then renamed over it, so a
+ * crash while writing leaves the previous snapshot in place.
+ *
+ * \throws kwiver::vital::file_write_exception Thrown if the file cannot be written.
+ *
+ * \param path The snapshot file.
+ * \param states The states returned by pipeline::save_state().
+ */
+SPROKIT_PIPELINE_UTIL_EXPORT
+void write_pipeline_snapshot( std::string const& path,
+                              process_states_t const& states );
+
+/**
+ * \brief Read a snapshot file written by write_pipeline_snapshot().
+ *
+ * \throws kwiver::vital::file_not_found_exception Thrown if the file does not exist.
+ * \throws kwiver::vital::invalid_file Thrown if the file is not a snapshot or is truncated.
+ *
+ * \param path The snapshot file.
+ *
+ * \returns The states to pass to pipeline::restore_state().
+ */
+SPROKIT_PIPELINE_UTIL_EXPORT
+process_states_t read_pipeline_snapshot( std::string const& path );
+
+// ==================================================================
+/**
+ * \brief Periodically write snapshots of a running pipeline.
+ *
+ * A thread saves the pipeline state every \c interval seconds until
+ * the checkpointer is stopped or destroyed. Failures are logged rather
+ * than thrown, since a missed checkpoint should not stop the pipeline.
+ */
+class SPROKIT_PIPELINE_UTIL_EXPORT pipeline_checkpointer
+{
+public:
+  /**
+   * \brief Start checkpointing.
+   *
+   * \param pipe The pipeline, which must be setup.
+   * \param path The snapshot file.
+   * \param interval Seconds between snapshots.
+   */
+  pipeline_checkpointer( pipeline_t const& pipe,
+                         std::string const& path,
+                         double interval );
+  ~pipeline_checkpointer();
+
+  /**
+   * \brief Stop checkpointing.
+   *
+   * \param final_snapshot Whether to write one last snapshot, such as
+   * when the pipeline has finished normally.
+   */
+  void stop( bool final_snapshot = false );
+
+private:
+  void run();
+  void checkpoint();
+
+  pipeline_t const m_pipe;
+  std::string const m_path;
+  double const m_interval;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  bool m_stopping;
+
+  std::thread m_thread;
+};
+
+} // end namespace
+
+#endif // SPROKIT_PIPELINE_UTIL_PIPELINE_SNAPSHOT_H
@@ -0,0 +1,454 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/**
+ * \file
+ *
+ * \brief Benchmarks of the per-datum overhead of pipelines.
+ *
+ * Each test builds a synthetic pipeline of \c pass, \c distribute and
+ * \c multiplexer processes between a source which stamps each datum with
+ * the time it was sent and sinks which record when it arrived. The
+ * pipeline is run under the scheduler named in the test instance for
+ * several edge configurations, reporting datums per second at the sinks,
+ * the mean latency per edge and the CPU time per datum. Latency includes
+ * queueing, which the edge capacity bounds.
+ *
+ * Rates depend on the machine, so they are only checked against a floor
+ * given as the second argument; zero only reports them.
+ */
+
+#include <test_common.h>
+
+#include <vital/config/config_block.h>
+#include <vital/plugin_loader/plugin_manager.h>
+
+#include <sprokit/pipeline/datum.h>
+#include <sprokit/pipeline/edge.h>
+#include <sprokit/pipeline/pipeline.h>
+#include <sprokit/pipeline/process.h>
+#include <sprokit/pipeline/process_factory.h>
+#include <sprokit/pipeline/scheduler.h>
+#include <sprokit/pipeline/scheduler_factory.h>
+
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <cstdlib>
+
+#define TEST_ARGS (sprokit::scheduler::type_t const& scheduler_type, double min_rate)
+
+DECLARE_TEST_MAP();
+
+static std::string const test_sep = "-";
+
+int
+main(int argc, char* argv[])
+{
+  CHECK_ARGS(2);
+
+  testname_t const full_testname = argv[1];
+
+  size_t const sep_pos = full_testname.find(test_sep);
+
+  if (sep_pos == testname_t::npos)
+  {
+    TEST_ERROR("Unexpected test name format: " << full_testname);
+
+    return EXIT_FAILURE;
+  }
+
+  testname_t const testname = full_testname.substr(0, sep_pos);
+  sprokit::scheduler::type_t const scheduler_type = full_testname.substr(sep_pos + test_sep.length());
+  double const min_rate = std::atof(argv[2]);
+
+  RUN_TEST(testname, scheduler_type, min_rate);
+}
+
+namespace
+{
+
+typedef std::chrono::steady_clock bench_clock_t;
+typedef bench_clock_t::rep ticks_t;
+
+/// Number of datums sent by the source of each run.
+size_t const datum_count = 2000;
+
+/// The arrivals recorded by the sinks of one run.
+class benchmark_results
+{
+  public:
+    benchmark_results();
+
+    void record(ticks_t latency);
+
+    std::mutex mutex;
+    size_t count;
+    ticks_t total_latency;
+};
+
+typedef std::shared_ptr<benchmark_results> benchmark_results_t;
+
+/// Sends the current time as each datum.
+class benchmark_source
+  : public sprokit::process
+{
+  public:
+    benchmark_source(kwiver::vital::config_block_sptr const& config, size_t count);
+
+  protected:
+    void _step() override;
+
+  private:
+    size_t m_remaining;
+};
+
+/// Records the time since each datum was sent.
+class benchmark_sink
+  : public sprokit::process
+{
+  public:
+    benchmark_sink(kwiver::vital::config_block_sptr const& config,
+                   benchmark_results_t const& results);
+
+  protected:
+    void _step() override;
+
+  private:
+    benchmark_results_t const m_results;
+};
+
+/// A pipeline to benchmark and what to expect from it.
+struct benchmark_pipeline
+{
+  sprokit::pipeline_t pipeline;
+  benchmark_results_t results;
+  /// The number of edges from the source to a sink.
+  size_t hops;
+  /// The number of datums all sinks receive together.
+  size_t expected;
+};
+
+/// One configuration of every edge of a pipeline.
+struct edge_setting
+{
+  char const* label;
+  size_t capacity;
+  char const* impl;
+};
+
+std::vector<edge_setting> const edge_settings = {
+  { "unbounded", 0, "deque" },
+  { "capacity-1", 1, "deque" },
+  { "capacity-10", 10, "deque" },
+  { "ring-10", 10, "spsc_ring" } };
+
+sprokit::process::port_type_t const type_ticks = sprokit::process::port_type_t("benchmark_ticks");
+sprokit::process::port_t const port_ticks = sprokit::process::port_t("ticks");
+
+size_t const pass_chain_length = 8;
+size_t const branch_count = 4;
+
+sprokit::process_t create_process(sprokit::process::type_t const& type,
+                                  sprokit::process::name_t const& name);
+benchmark_pipeline create_benchmark_pipeline(edge_setting const& setting);
+void add_endpoints(benchmark_pipeline& bench, size_t sinks);
+void run_benchmark(char const* topology,
+                   sprokit::scheduler::type_t const& scheduler_type,
+                   double min_rate,
+                   edge_setting const& setting,
+                   benchmark_pipeline const& bench);
+
+} // end namespace
+
+// ------------------------------------------------------------------
+// source -> pass x 8 -> sink
+IMPLEMENT_TEST(chain)
+{
+  for (edge_setting const& setting : edge_settings)
+  {
+    benchmark_pipeline bench = create_benchmark_pipeline(setting);
+    add_endpoints(bench, 1);
+
+    sprokit::process::name_t upstream = "source";
+    sprokit::process::port_t upstream_port = port_ticks;
+
+    for (size_t i = 0; i < pass_chain_length; ++i)
+    {
+      sprokit::process::name_t const name = "pass" + std::to_string(i);
+
+      bench.pipeline->add_process(create_process("pass", name));
+      bench.pipeline->connect(upstream, upstream_port, name, "pass");
+
+      upstream = name;
+      upstream_port = "pass";
+    }
+
+    bench.pipeline->connect(upstream, upstream_port, "sink0", port_ticks);
+    bench.hops = pass_chain_length + 1;
+    bench.expected = datum_count;
+
+    run_benchmark("chain", scheduler_type, min_rate, setting, bench);
+  }
+}
+
+// ------------------------------------------------------------------
+// source -> 4 x (pass -> sink), every branch receiving every datum
+IMPLEMENT_TEST(fan_out)
+{
+  for (edge_setting const& setting : edge_settings)
+  {
+    benchmark_pipeline bench = create_benchmark_pipeline(setting);
+    add_endpoints(bench, branch_count);
+
+    for (size_t i = 0; i < branch_count; ++i)
+    {
+      sprokit::process::name_t const name = "pass" + std::to_string(i);
+
+      bench.pipeline->add_process(create_process("pass", name));
+      bench.pipeline->connect("source", port_ticks, name, "pass");
+      bench.pipeline->connect(name, "pass", "sink" + std::to_string(i), port_ticks);
+    }
+
+    bench.hops = 2;
+    bench.expected = datum_count * branch_count;
+
+    run_benchmark("fan_out", scheduler_type, min_rate, setting, bench);
+  }
+}
+
+// ------------------------------------------------------------------
+// source -> distribute -> 4 x pass -> multiplexer -> sink, each datum
+// taking one branch. The distribute output is unsynchronized, so this only
+// runs under the threaded schedulers.
+IMPLEMENT_TEST(diamond)
+{
+  for (edge_setting const& setting : edge_settings)
+  {
+    benchmark_pipeline bench = create_benchmark_pipeline(setting);
+    add_endpoints(bench, 1);
+
+    bench.pipeline->add_process(create_process("distribute", "distribute"));
+    bench.pipeline->add_process(create_process("multiplexer", "mux"));
+    bench.pipeline->add_process(create_process("sink", "status_sink"));
+
+    bench.pipeline->connect("distribute", "status/ticks", "status_sink", "sink");
+    bench.pipeline->connect("source", port_ticks, "distribute", "src/ticks");
+
+    for (size_t i = 0; i < branch_count; ++i)
+    {
+      std::string const branch(1, static_cast<char>('A' + i));
+      sprokit::process::name_t const name = "pass" + branch;
+
+      bench.pipeline->add_process(create_process("pass", name));
+      bench.pipeline->connect("distribute", "dist/ticks/" + branch, name, "pass");
+      bench.pipeline->connect(name, "pass", "mux", "ticks/" + branch);
+    }
+
+    bench.pipeline->connect("mux", "ticks", "sink0", port_ticks);
+    bench.hops = 4;
+    bench.expected = datum_count;
+
+    run_benchmark("diamond", scheduler_type, min_rate, setting, bench);
+  }
+}
+
+namespace
+{
+
+// ------------------------------------------------------------------
+sprokit::process_t
+create_process(sprokit::process::type_t const& type, sprokit::process::name_t const& name)
+{
+  kwiver::vital::plugin_manager& vpm = kwiver::vital::plugin_manager::instance();
+  vpm.load_all_plugins();
+
+  return sprokit::create_process(type, name, kwiver::vital::config_block::empty_config());
+}
+
+// ------------------------------------------------------------------
+benchmark_pipeline
+create_benchmark_pipeline(edge_setting const& setting)
+{
+  kwiver::vital::config_block_sptr const config = kwiver::vital::config_block::empty_config();
+  kwiver::vital::config_block_key_t const edge_block =
+    kwiver::vital::config_block_key_t("_edge") + kwiver::vital::config_block::block_sep();
+
+  config->set_value(edge_block + sprokit::edge::config_capacity, setting.capacity);
+  config->set_value(edge_block + sprokit::edge::config_impl, setting.impl);
+
+  benchmark_pipeline bench;
+  bench.pipeline = std::make_shared<sprokit::pipeline>(config);
+  bench.results = std::make_shared<benchmark_results>();
+  bench.hops = 0;
+  bench.expected = 0;
+  return bench;
+}
+
+// ------------------------------------------------------------------
+// Add the source and sinks named "sink0", "sink1", ...
+void
+add_endpoints(benchmark_pipeline& bench, size_t sinks)
+{
+  kwiver::vital::config_block_sptr const source_config = kwiver::vital::config_block::empty_config();
+  source_config->set_value(sprokit::process::config_name, "source");
+  bench.pipeline->add_process(std::make_shared<benchmark_source>(source_config, datum_count));
+
+  for (size_t i = 0; i < sinks; ++i)
+  {
+    kwiver::vital::config_block_sptr const sink_config = kwiver::vital::config_block::empty_config();
+    sink_config->set_value(sprokit::process::config_name, "sink" + std::to_string(i));
+    bench.pipeline->add_process(std::make_shared<benchmark_sink>(sink_config, bench.results));
+  }
+}
+
+// ------------------------------------------------------------------
+void
+run_benchmark(char const* topology,
+              sprokit::scheduler::type_t const& scheduler_type,
+              double min_rate,
+              edge_setting const& setting,
+              benchmark_pipeline const& bench)
+{
+  bench.pipeline->setup_pipeline();
+
+  sprokit::scheduler_t const scheduler = sprokit::create_scheduler(scheduler_type, bench.pipeline);
+
+  std::clock_t const cpu_start = std::clock();
+  bench_clock_t::time_point const start = bench_clock_t::now();
+
+  scheduler->start();
+  scheduler->wait();
+
+  double const elapsed = std::chrono::duration<double>(bench_clock_t::now() - start).count();
+  double const cpu = static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+  std::lock_guard<std::mutex> const lock(bench.results->mutex);
+  size_t const count = bench.results->count;
+
+  if (count != bench.expected)
+  {
+    TEST_ERROR(topology << " " << setting.label << ": "
+               "Expected " << bench.expected << " datums at the sinks, "
+               "received " << count);
+    return;
+  }
+
+  double const rate = count / elapsed;
+  double const hop_latency =
+    std::chrono::duration<double, std::micro>(
+      bench_clock_t::duration(bench.results->total_latency)).count() /
+    (count * bench.hops);
+
+  std::cout << std::left << std::setw(8) << topology
+            << std::setw(20) << scheduler_type
+            << std::setw(12) << setting.label
+            << std::right << std::fixed
+            << std::setprecision(0) << std::setw(10) << rate << " datums/s"
+            << std::setprecision(2) << std::setw(10) << hop_latency << " us/hop"
+            << std::setw(10) << 1e6 * cpu / count << " us CPU/datum"
+            << std::endl;
+
+  if (min_rate > 0.0 && rate < min_rate)
+  {
+    TEST_ERROR(topology << " " << setting.label << ": "
+               "Rate of " << rate << " datums/s is below the minimum of " << min_rate);
+  }
+}
+
+// ------------------------------------------------------------------
+benchmark_results
+::benchmark_results()
+  : count(0)
+  , total_latency(0)
+{
+}
+
+// ------------------------------------------------------------------
+void
+benchmark_results
+::record(ticks_t latency)
+{
+  std::lock_guard<std::mutex> const lock(mutex);
+
+  ++count;
+  total_latency += latency;
+}
+
+// ------------------------------------------------------------------
+benchmark_source
+::benchmark_source(kwiver::vital::config_block_sptr const& config, size_t count)
+  : process(config)
+  , m_remaining(count)
+{
+  port_flags_t required;
+
+  required.insert(flag_required);
+
+  declare_output_port(
+    port_ticks,
+    type_ticks,
+    required,
+    port_description_t("The time at which each datum was sent."));
+}
+
+// ------------------------------------------------------------------
+void
+benchmark_source
+::_step()
+{
+  sprokit::datum_t dat;
+
+  if (!m_remaining)
+  {
+    mark_process_as_complete();
+    dat = sprokit::datum::complete_datum();
+  }
+  else
+  {
+    --m_remaining;
+    dat = sprokit::datum::new_datum<ticks_t>(bench_clock_t::now().time_since_epoch().count());
+  }
+
+  push_datum_to_port(port_ticks, dat);
+
+  process::_step();
+}
+
+// ------------------------------------------------------------------
+benchmark_sink
+::benchmark_sink(kwiver::vital::config_block_sptr const& config,
+                 benchmark_results_t const& results)
+  : process(config)
+  , m_results(results)
+{
+  port_flags_t required;
+
+  required.insert(flag_required);
+
+  declare_input_port(
+    port_ticks,
+    type_ticks,
+    required,
+    port_description_t("The time at which each datum was sent."));
+}
+
+// ------------------------------------------------------------------
+void
+benchmark_sink
+::_step()
+{
+  ticks_t const sent = grab_from_port_as<ticks_t>(port_ticks);
+
+  m_results->record(bench_clock_t::now().time_since_epoch().count() - sent);
+
+  process::_step();
+}
+
+} // end namespace
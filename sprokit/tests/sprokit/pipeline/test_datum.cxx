@@ -5,6 +5,10 @@
 #include <test_common.h>
 
 #include <sprokit/pipeline/datum.h>
+#include <sprokit/pipeline/object_pool.h>
+
+#include <thread>
+#include <vector>
 
 #define TEST_ARGS ()
 
@@ -124,6 +128,81 @@ IMPLEMENT_TEST(new)
                    "retrieving an int as a string");
 }
 
+IMPLEMENT_TEST(get_datum_ref)
+{
+  sprokit::datum_t const dat = sprokit::datum::new_datum(std::vector<int>(100, 1));
+
+  std::vector<int> const& ref1 = dat->get_datum_ref<std::vector<int> >();
+  std::vector<int> const& ref2 = dat->get_datum_ref<std::vector<int> >();
+
+  if (&ref1 != &ref2)
+  {
+    TEST_ERROR("Referencing a datum twice did not give the same object");
+  }
+
+  if (ref1.size() != 100)
+  {
+    TEST_ERROR("Did not get same value out as put into datum");
+  }
+
+  EXPECT_EXCEPTION(sprokit::bad_datum_cast_exception,
+                   dat->get_datum_ref<std::string>(),
+                   "referencing a vector as a string");
+
+  sprokit::datum_t const empty = sprokit::datum::empty_datum();
+
+  EXPECT_EXCEPTION(sprokit::bad_datum_cast_exception,
+                   empty->get_datum_ref<int>(),
+                   "referencing a value in an empty datum");
+}
+
+IMPLEMENT_TEST(take_datum_unique)
+{
+  sprokit::datum_t dat = sprokit::datum::new_datum(std::vector<int>(100, 1));
+
+  int const* const storage = dat->get_datum_ref<std::vector<int> >().data();
+
+  std::vector<int> const taken = sprokit::datum::take_datum<std::vector<int> >(std::move(dat));
+
+  if (taken.size() != 100)
+  {
+    TEST_ERROR("Did not get same value out as put into datum");
+  }
+
+  if (taken.data() != storage)
+  {
+    TEST_ERROR("A uniquely owned datum was copied instead of moved");
+  }
+}
+
+IMPLEMENT_TEST(take_datum_shared)
+{
+  sprokit::datum_t const dat = sprokit::datum::new_datum(std::vector<int>(100, 1));
+
+  int const* const storage = dat->get_datum_ref<std::vector<int> >().data();
+
+  std::vector<int> const taken = sprokit::datum::take_datum<std::vector<int> >(dat);
+
+  if (taken.size() != 100)
+  {
+    TEST_ERROR("Did not get same value out as put into datum");
+  }
+
+  if (taken.data() == storage)
+  {
+    TEST_ERROR("A shared datum was moved from");
+  }
+
+  if (dat->get_datum_ref<std::vector<int> >().size() != 100)
+  {
+    TEST_ERROR("A shared datum was modified when taken");
+  }
+
+  EXPECT_EXCEPTION(sprokit::bad_datum_cast_exception,
+                   sprokit::datum::take_datum<std::string>(dat),
+                   "taking a vector as a string");
+}
+
 IMPLEMENT_TEST(equality)
 {
   sprokit::datum_t const empty1 = sprokit::datum::empty_datum();
@@ -227,3 +306,54 @@ IMPLEMENT_TEST(equality)
 
 #undef test_inequality
 }
+
+IMPLEMENT_TEST(pooled)
+{
+  // Warm up this thread's pool
+  sprokit::datum::new_datum(0);
+
+  sprokit::object_pool_statistics_t const before = sprokit::object_pool_statistics();
+
+  for (int i = 0; i < 100; ++i)
+  {
+    sprokit::datum_t const dat = sprokit::datum::new_datum(i);
+
+    if (dat->get_datum<int>() != i)
+    {
+      TEST_ERROR("Did not get the value of a pooled datum");
+    }
+  }
+
+  sprokit::object_pool_statistics_t const after = sprokit::object_pool_statistics();
+
+  if (after.allocated < before.allocated + 100)
+  {
+    TEST_ERROR("Datum allocations were not counted");
+  }
+
+  if (after.reused < before.reused + 100)
+  {
+    TEST_ERROR("Freed datums were not reused");
+  }
+
+  // Datums freed on another thread go back to that thread's pool
+  std::vector<sprokit::datum_t> data;
+
+  for (int i = 0; i < 100; ++i)
+  {
+    data.push_back(sprokit::datum::new_datum(i));
+  }
+
+  std::thread consumer([&data]()
+  {
+    data.clear();
+  });
+  consumer.join();
+
+  sprokit::object_pool_statistics_t const joined = sprokit::object_pool_statistics();
+
+  if (joined.released < after.released + 100)
+  {
+    TEST_ERROR("Blocks cached by an exited thread were not released");
+  }
+}
@@ -567,6 +567,390 @@ IMPLEMENT_TEST(try_get_datum)
   check_time(duration, WAIT_DURATION, "trying to get a datum from an edge");
 }
 
+IMPLEMENT_TEST(invalid_impl)
+{
+  kwiver::vital::config_block_sptr const config = kwiver::vital::config_block::empty_config();
+
+  config->set_value(sprokit::edge::config_impl, "not_an_impl");
+
+  EXPECT_EXCEPTION(sprokit::invalid_edge_impl_exception,
+                   std::make_shared<sprokit::edge>(config),
+                   "requesting an unknown edge implementation");
+}
+
+static kwiver::vital::config_block_sptr ring_config(size_t capacity);
+
+IMPLEMENT_TEST(ring_capacity)
+{
+  sprokit::edge_t const edge = std::make_shared<sprokit::edge>(ring_config(1));
+
+  sprokit::stamp::increment_t const inc = sprokit::stamp::increment_t(1);
+
+  sprokit::datum_t const dat1 = sprokit::datum::empty_datum();
+  sprokit::datum_t const dat2 = sprokit::datum::complete_datum();
+  sprokit::stamp_t const stamp1 = sprokit::stamp::new_stamp(inc);
+  sprokit::stamp_t const stamp2 = sprokit::stamp::incremented_stamp(stamp1);
+
+  sprokit::edge_datum_t const edat1 = sprokit::edge_datum_t(dat1, stamp1);
+  sprokit::edge_datum_t const edat2 = sprokit::edge_datum_t(dat2, stamp2);
+
+  // Fill the edge.
+  edge->push_datum(edat1);
+
+  if (!edge->full_of_data())
+  {
+    TEST_ERROR("A ring edge at capacity is not full");
+  }
+
+  boost::thread thread = boost::thread(std::bind(&push_datum, edge, edat2));
+
+  // Give the other thread some time.
+  boost::this_thread::sleep_for(WAIT_DURATION);
+
+  // Make sure the edge still is at capacity.
+  if (edge->datum_count() != 1)
+  {
+    TEST_ERROR("A datum was pushed into a full ring edge");
+  }
+
+  // Let the other thread go (it should have been parked).
+  sprokit::edge_datum_t const get_edat = edge->get_datum();
+
+  if (get_edat != edat1)
+  {
+    TEST_ERROR("The ring edge did not return the first datum");
+  }
+
+  // Make sure the other thread completes.
+  thread.join();
+
+  if (edge->peek_datum() != edat2)
+  {
+    TEST_ERROR("The other thread did not push into the ring edge");
+  }
+}
+
+IMPLEMENT_TEST(ring_try_push_datum)
+{
+  sprokit::edge_t const edge = std::make_shared<sprokit::edge>(ring_config(1));
+
+  sprokit::stamp::increment_t const inc = sprokit::stamp::increment_t(1);
+
+  sprokit::datum_t const dat = sprokit::datum::empty_datum();
+  sprokit::stamp_t const stamp = sprokit::stamp::new_stamp(inc);
+
+  sprokit::edge_datum_t const edat = sprokit::edge_datum_t(dat, stamp);
+
+  edge->push_datum(edat);
+
+  time_point_t const start = time_clock_t::now();
+
+  // This should be blocking.
+  bool const pushed = edge->try_push_datum(edat, WAIT_DURATION);
+
+  time_point_t const end = time_clock_t::now();
+
+  if (pushed)
+  {
+    TEST_ERROR("Returned true when a push into a ring edge should have timed out");
+  }
+
+  check_time(end - start, WAIT_DURATION, "trying to push into a full ring edge");
+
+  edge->pop_datum();
+
+  kwiver::vital::optional<sprokit::edge_datum_t> const opt_datum =
+    edge->try_get_datum(sprokit::edge::duration_t(0));
+
+  if (opt_datum)
+  {
+    TEST_ERROR("Returned a datum from an empty ring edge");
+  }
+}
+
+static void push_sequence(sprokit::edge_t edge, size_t count);
+
+IMPLEMENT_TEST(ring_ordering)
+{
+  static size_t const count = 10000;
+
+  sprokit::edge_t const edge = std::make_shared<sprokit::edge>(ring_config(3));
+
+  boost::thread thread = boost::thread(std::bind(&push_sequence, edge, count));
+
+  sprokit::stamp_t expected = sprokit::stamp::new_stamp(1);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    sprokit::edge_datum_t const edat = edge->get_datum();
+
+    if (*edat.stamp != *expected)
+    {
+      TEST_ERROR("The ring edge reordered data at element " << i);
+      break;
+    }
+
+    expected = sprokit::stamp::incremented_stamp(expected);
+  }
+
+  thread.join();
+
+  if (edge->has_data())
+  {
+    TEST_ERROR("The ring edge has data after all of it was consumed");
+  }
+}
+
+IMPLEMENT_TEST(ring_downstream_complete)
+{
+  sprokit::edge_t const edge = std::make_shared<sprokit::edge>(ring_config(2));
+
+  sprokit::edge_datum_t const edat =
+    sprokit::edge_datum_t(sprokit::datum::empty_datum(), sprokit::stamp::new_stamp(1));
+
+  edge->push_datum(edat);
+  edge->push_datum(edat);
+
+  edge->mark_downstream_as_complete();
+
+  if (edge->has_data())
+  {
+    TEST_ERROR("A complete ring edge still has data");
+  }
+
+  // Pushing into a complete edge is a no-op.
+  edge->push_datum(edat);
+
+  if (edge->has_data())
+  {
+    TEST_ERROR("A complete ring edge accepted data");
+  }
+
+  EXPECT_EXCEPTION(sprokit::datum_requested_after_complete,
+                   edge->get_datum(),
+                   "requesting a datum after downstream requested completion");
+}
+
+IMPLEMENT_TEST(ring_unbounded_fallback)
+{
+  sprokit::edge_t const edge = std::make_shared<sprokit::edge>(ring_config(0));
+
+  sprokit::edge_datum_t const edat =
+    sprokit::edge_datum_t(sprokit::datum::empty_datum(), sprokit::stamp::new_stamp(1));
+
+  // An unbounded edge cannot be a ring; it should never become full.
+  for (size_t i = 0; i < 100; ++i)
+  {
+    edge->push_datum(edat);
+  }
+
+  if (edge->full_of_data())
+  {
+    TEST_ERROR("An unbounded edge became full");
+  }
+
+  if (edge->datum_count() != 100)
+  {
+    TEST_ERROR("An unbounded edge lost data");
+  }
+}
+
+static void check_sole_owner(sprokit::edge_t const& edge, char const* const impl);
+
+IMPLEMENT_TEST(get_datum_sole_owner)
+{
+  check_sole_owner(std::make_shared<sprokit::edge>(), "deque");
+}
+
+IMPLEMENT_TEST(ring_get_datum_sole_owner)
+{
+  check_sole_owner(std::make_shared<sprokit::edge>(ring_config(2)), "spsc_ring");
+}
+
+static void check_statistics(sprokit::edge_t const& edge, char const* const impl);
+
+IMPLEMENT_TEST(statistics)
+{
+  kwiver::vital::config_block_sptr const config = kwiver::vital::config_block::empty_config();
+
+  config->set_value(sprokit::edge::config_capacity, 4);
+
+  check_statistics(std::make_shared<sprokit::edge>(config), "deque");
+}
+
+IMPLEMENT_TEST(ring_statistics)
+{
+  check_statistics(std::make_shared<sprokit::edge>(ring_config(4)), "spsc_ring");
+}
+
+IMPLEMENT_TEST(statistics_blocked_time)
+{
+  kwiver::vital::config_block_sptr const config = kwiver::vital::config_block::empty_config();
+
+  config->set_value(sprokit::edge::config_capacity, 1);
+
+  sprokit::edge_t const edge = std::make_shared<sprokit::edge>(config);
+
+  sprokit::edge_datum_t const edat =
+    sprokit::edge_datum_t(sprokit::datum::empty_datum(), sprokit::stamp::new_stamp(1));
+
+  edge->push_datum(edat);
+
+  // This times out after blocking.
+  edge->try_push_datum(edat, WAIT_DURATION);
+
+  edge->pop_datum();
+
+  // This times out after blocking.
+  edge->try_get_datum(WAIT_DURATION);
+
+  sprokit::edge_statistics_t const stats = edge->statistics();
+
+  check_time(duration_t(stats.push_blocked_time), WAIT_DURATION,
+             "recording the time blocked pushing");
+  check_time(duration_t(stats.pop_blocked_time), WAIT_DURATION,
+             "recording the time blocked popping");
+}
+
+IMPLEMENT_TEST(statistics_dropped)
+{
+  kwiver::vital::config_block_sptr const config = kwiver::vital::config_block::empty_config();
+
+  config->set_value(sprokit::edge::config_capacity, 1);
+  config->set_value(sprokit::edge::config_blocking, false);
+
+  sprokit::edge_t const edge = std::make_shared<sprokit::edge>(config);
+
+  sprokit::edge_datum_t const edat =
+    sprokit::edge_datum_t(sprokit::datum::new_datum(1), sprokit::stamp::new_stamp(1));
+
+  edge->push_datum(edat);
+  edge->push_datum(edat);
+  edge->push_datum(edat);
+
+  sprokit::edge_statistics_t const stats = edge->statistics();
+
+  if (stats.pushed != 1)
+  {
+    TEST_ERROR("A non-blocking edge recorded " << stats.pushed << " pushes "
+               "instead of 1");
+  }
+
+  if (stats.dropped != 2)
+  {
+    TEST_ERROR("A non-blocking edge recorded " << stats.dropped << " drops "
+               "instead of 2");
+  }
+}
+
+void
+check_sole_owner(sprokit::edge_t const& edge, char const* const impl)
+{
+  edge->push_datum(sprokit::edge_datum_t(sprokit::datum::new_datum(1),
+                                         sprokit::stamp::new_stamp(1)));
+
+  sprokit::edge_datum_t const get_edat = edge->get_datum();
+
+  if (get_edat.datum.use_count() != 1)
+  {
+    TEST_ERROR("The " << impl << " edge kept a reference to a datum "
+               "after a get");
+  }
+
+  edge->push_datum(sprokit::edge_datum_t(sprokit::datum::new_datum(2),
+                                         sprokit::stamp::new_stamp(1)));
+
+  kwiver::vital::optional<sprokit::edge_datum_t> const try_edat =
+    edge->try_get_datum(sprokit::edge::duration_t::zero());
+
+  if (!try_edat || try_edat->datum.use_count() != 1)
+  {
+    TEST_ERROR("The " << impl << " edge kept a reference to a datum "
+               "after a try get");
+  }
+}
+
+void
+check_statistics(sprokit::edge_t const& edge, char const* const impl)
+{
+  sprokit::edge_datum_t const edat =
+    sprokit::edge_datum_t(sprokit::datum::empty_datum(), sprokit::stamp::new_stamp(1));
+
+  edge->push_datum(edat);
+  edge->push_datum(edat);
+  edge->push_datum(edat);
+  edge->get_datum();
+  edge->pop_datum();
+  edge->push_datum(edat);
+
+  sprokit::edge_statistics_t const stats = edge->statistics();
+
+  if (stats.pushed != 4)
+  {
+    TEST_ERROR("The " << impl << " edge recorded " << stats.pushed
+               << " pushes instead of 4");
+  }
+
+  if (stats.popped != 2)
+  {
+    TEST_ERROR("The " << impl << " edge recorded " << stats.popped
+               << " pops instead of 2");
+  }
+
+  if (stats.max_depth != 3)
+  {
+    TEST_ERROR("The " << impl << " edge recorded a maximum depth of "
+               << stats.max_depth << " instead of 3");
+  }
+
+  // One bin per depth from empty to full.
+  if (stats.depth_histogram.size() != 5)
+  {
+    TEST_ERROR("The " << impl << " edge has " << stats.depth_histogram.size()
+               << " histogram bins instead of 5");
+    return;
+  }
+
+  // Pushes saw depths of 0, 1, 2 and then 1.
+  if ((stats.depth_histogram[0] != 1) ||
+      (stats.depth_histogram[1] != 2) ||
+      (stats.depth_histogram[2] != 1) ||
+      (stats.depth_histogram[3] != 0))
+  {
+    TEST_ERROR("The " << impl << " edge recorded the wrong depth histogram");
+  }
+
+  if (stats.mean_depth() != 1.0)
+  {
+    TEST_ERROR("The " << impl << " edge has a mean depth of "
+               << stats.mean_depth() << " instead of 1");
+  }
+}
+
+kwiver::vital::config_block_sptr
+ring_config(size_t capacity)
+{
+  kwiver::vital::config_block_sptr const config = kwiver::vital::config_block::empty_config();
+
+  config->set_value(sprokit::edge::config_capacity, capacity);
+  config->set_value(sprokit::edge::config_impl, "spsc_ring");
+
+  return config;
+}
+
+void
+push_sequence(sprokit::edge_t edge, size_t count)
+{
+  sprokit::stamp_t stamp = sprokit::stamp::new_stamp(1);
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    edge->push_datum(sprokit::edge_datum_t(sprokit::datum::empty_datum(), stamp));
+
+    stamp = sprokit::stamp::incremented_stamp(stamp);
+  }
+}
+
 void
 push_datum(sprokit::edge_t edge, sprokit::edge_datum_t edat)
 {
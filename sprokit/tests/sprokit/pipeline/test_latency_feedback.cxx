@@ -0,0 +1,137 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include <test_common.h>
+
+#include <sprokit/pipeline/latency_feedback.h>
+
+#include <chrono>
+#include <thread>
+
+#define TEST_ARGS ()
+
+DECLARE_TEST_MAP();
+
+int
+main(int argc, char* argv[])
+{
+  CHECK_ARGS(1);
+
+  testname_t const testname = argv[1];
+
+  RUN_TEST(testname);
+}
+
+IMPLEMENT_TEST(shared_by_name)
+{
+  sprokit::latency_channel_t const a = sprokit::latency_channel::get("shared");
+  sprokit::latency_channel_t const b = sprokit::latency_channel::get("shared");
+  sprokit::latency_channel_t const c = sprokit::latency_channel::get("other");
+
+  if (a != b)
+  {
+    TEST_ERROR("Channels with the same name are not shared");
+  }
+
+  if (a == c)
+  {
+    TEST_ERROR("Channels with different names are shared");
+  }
+}
+
+IMPLEMENT_TEST(drops_when_full)
+{
+  sprokit::latency_channel channel;
+  channel.set_budget(10.0);
+
+  size_t const limit = channel.statistics().limit;
+
+  for (sprokit::latency_channel::key_t key = 0; key < 100; ++key)
+  {
+    channel.admit(key);
+  }
+
+  sprokit::latency_statistics_t stats = channel.statistics();
+
+  if (stats.admitted != limit || stats.in_flight != limit)
+  {
+    TEST_ERROR("More frames than the limit were admitted");
+  }
+
+  if (stats.dropped != 100 - limit)
+  {
+    TEST_ERROR("Frames over the limit were not counted as dropped");
+  }
+
+  // Finishing a frame forgets those sent before it
+  channel.complete(static_cast<sprokit::latency_channel::key_t>(limit / 2));
+
+  stats = channel.statistics();
+
+  if (stats.completed != 1 || stats.in_flight != limit - limit / 2 - 1)
+  {
+    TEST_ERROR("Finishing a frame did not retire earlier frames");
+  }
+
+  // Unknown and dropped frames are ignored
+  channel.complete(99);
+
+  if (channel.statistics().completed != 1)
+  {
+    TEST_ERROR("Finishing a dropped frame was counted");
+  }
+}
+
+IMPLEMENT_TEST(adapts_to_budget)
+{
+  sprokit::latency_channel channel;
+  channel.set_budget(0.01);
+
+  size_t const initial = channel.statistics().limit;
+
+  // A slow frame cuts the limit once
+  channel.admit(0);
+  channel.admit(1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  channel.complete(0);
+  channel.complete(1);
+
+  size_t const cut = channel.statistics().limit;
+
+  if (cut >= initial)
+  {
+    TEST_ERROR("A frame over budget did not reduce the limit");
+  }
+
+  if (cut < initial * 6 / 10)
+  {
+    TEST_ERROR("Frames sent before a cut reduced the limit again");
+  }
+
+  if (channel.statistics().latency_p99 < 0.01)
+  {
+    TEST_ERROR("The latency of slow frames was not recorded");
+  }
+
+  // Fast frames let it grow again
+  for (sprokit::latency_channel::key_t key = 2; key < 2000; ++key)
+  {
+    channel.admit(key);
+    channel.complete(key);
+  }
+
+  if (channel.statistics().limit <= cut)
+  {
+    TEST_ERROR("Frames within budget did not raise the limit");
+  }
+
+  channel.reset();
+
+  sprokit::latency_statistics_t const stats = channel.statistics();
+
+  if (stats.limit != initial || stats.admitted || stats.completed)
+  {
+    TEST_ERROR("Resetting did not clear the channel");
+  }
+}
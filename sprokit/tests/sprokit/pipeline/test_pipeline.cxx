@@ -33,6 +33,7 @@
 #include <vital/config/config_block.h>
 #include <vital/util/string.h>
 
+#include <sprokit/pipeline/datum.h>
 #include <sprokit/pipeline/pipeline.h>
 #include <sprokit/pipeline/pipeline_exception.h>
 #include <sprokit/pipeline/process.h>
@@ -481,6 +482,51 @@ IMPLEMENT_TEST( setup_pipeline_type_force_any_upstream )
 }
 
 
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( setup_pipeline_parallel )
+{
+  sprokit::process::type_t const proc_type = sprokit::process::type_t( "numbers" );
+  sprokit::process::type_t const proc_type2 = sprokit::process::type_t( "flow_dependent" );
+  sprokit::process::type_t const proc_type3 = sprokit::process::type_t( "sink" );
+
+  sprokit::process::name_t const proc_name = sprokit::process::name_t( "data" );
+  sprokit::process::name_t const proc_name2 = sprokit::process::name_t( "flow" );
+  sprokit::process::name_t const proc_name3 = sprokit::process::name_t( "sink" );
+
+  sprokit::process_t const process = create_process( proc_type, proc_name );
+  sprokit::process_t const process2 = create_process( proc_type2, proc_name2 );
+  sprokit::process_t const process3 = create_process( proc_type3, proc_name3 );
+
+  kwiver::vital::config_block_sptr const config = kwiver::vital::config_block::empty_config();
+  config->set_value( "_setup_threads", "4" );
+
+  sprokit::pipeline_t const pipeline = std::make_shared< sprokit::pipeline > ( config );
+
+  pipeline->add_process( process );
+  pipeline->add_process( process2 );
+  pipeline->add_process( process3 );
+
+  sprokit::process::port_t const port_name = sprokit::process::port_t( "number" );
+  sprokit::process::port_t const port_name2i = sprokit::process::port_t( "input" );
+  sprokit::process::port_t const port_name2o = sprokit::process::port_t( "output" );
+  sprokit::process::port_t const port_name3 = sprokit::process::port_t( "sink" );
+
+  pipeline->connect( proc_name, port_name,
+                     proc_name2, port_name2i );
+  pipeline->connect( proc_name2, port_name2o,
+                     proc_name3, port_name3 );
+
+  pipeline->setup_pipeline();
+
+  for ( auto const& proc : { process, process2, process3 } )
+  {
+    EXPECT_EXCEPTION( sprokit::reinitialization_exception,
+                      proc->init(),
+                      "initializing a process set up in parallel" );
+  }
+}
+
+
 // ------------------------------------------------------------------
 IMPLEMENT_TEST( setup_pipeline_type_force_any_downstream )
 {
@@ -802,6 +848,86 @@ IMPLEMENT_TEST( setup_pipeline_data_dependent_set )
 }
 
 
+// ------------------------------------------------------------------
+class record_configure_process :
+  public sprokit::process
+{
+public:
+  record_configure_process( kwiver::vital::config_block_sptr const& conf );
+  ~record_configure_process();
+
+  static port_t const port_input;
+
+  bool m_configured;
+
+
+protected:
+  void _configure();
+};
+
+
+// ------------------------------------------------------------------
+static void
+test_data_dependent_configure_order( char const* setup_threads,
+                                     bool expect_configured )
+{
+  sprokit::process::type_t const proc_type = sprokit::process::type_t( "data_dependent" );
+
+  sprokit::process::name_t const proc_name = sprokit::process::name_t( "data" );
+  sprokit::process::name_t const proc_name2 = sprokit::process::name_t( "sink" );
+
+  // The upstream leaves its output untyped, so resolving its connection fails.
+  kwiver::vital::config_block_sptr const conf = kwiver::vital::config_block::empty_config();
+  conf->set_value( "set_on_configure", "false" );
+
+  kwiver::vital::config_block_sptr const conf2 = kwiver::vital::config_block::empty_config();
+  conf2->set_value( sprokit::process::config_name, proc_name2 );
+
+  sprokit::process_t const process = create_process( proc_type, proc_name, conf );
+  auto const process2 = std::make_shared< record_configure_process > ( conf2 );
+
+  kwiver::vital::config_block_sptr const config = kwiver::vital::config_block::empty_config();
+  config->set_value( "_setup_threads", setup_threads );
+
+  sprokit::pipeline_t const pipeline = std::make_shared< sprokit::pipeline > ( config );
+
+  pipeline->add_process( process );
+  pipeline->add_process( process2 );
+
+  sprokit::process::port_t const port_name = sprokit::process::port_t( "output" );
+
+  pipeline->connect( proc_name, port_name,
+                     proc_name2, record_configure_process::port_input );
+
+  EXPECT_EXCEPTION( sprokit::untyped_data_dependent_exception,
+                    pipeline->setup_pipeline(),
+                    "a data dependent port is not resolved after configure" );
+
+  if ( process2->m_configured != expect_configured )
+  {
+    TEST_ERROR( "The process after the failing data dependent upstream was "
+                << ( expect_configured ? "not " : "" ) << "configured" );
+  }
+}
+
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( setup_pipeline_data_dependent_configure_order )
+{
+  // Set up serially, the connections of "data" are resolved before "sink"
+  // is configured, so the failure stops setup before reaching "sink".
+  test_data_dependent_configure_order( "1", false );
+}
+
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( setup_pipeline_data_dependent_configure_parallel )
+{
+  // Configured in parallel, connections are only resolved afterwards.
+  test_data_dependent_configure_order( "4", true );
+}
+
+
 // ------------------------------------------------------------------
 IMPLEMENT_TEST( setup_pipeline_data_dependent_set_reject )
 {
@@ -1164,6 +1290,217 @@ IMPLEMENT_TEST( setup_pipeline_frequency_connect )
 }
 
 
+// ------------------------------------------------------------------
+class fusable_process :
+  public sprokit::process
+{
+public:
+  fusable_process( kwiver::vital::config_block_sptr const& conf );
+  ~fusable_process();
+
+  static kwiver::vital::config_block_key_t const config_inputs;
+  static kwiver::vital::config_block_key_t const config_frequency;
+  static port_t const port_output;
+
+
+protected:
+  void _step();
+  properties_t _properties() const;
+
+
+private:
+  size_t m_inputs;
+};
+
+
+// ------------------------------------------------------------------
+static sprokit::process_t
+create_fusable_process( sprokit::process::name_t const& name,
+                        size_t inputs = 1,
+                        size_t frequency = 1 )
+{
+  kwiver::vital::config_block_sptr const conf = kwiver::vital::config_block::empty_config();
+
+  conf->set_value( sprokit::process::config_name, name );
+  conf->set_value( fusable_process::config_inputs, inputs );
+  conf->set_value( fusable_process::config_frequency, frequency );
+
+  return std::make_shared< fusable_process > ( conf );
+}
+
+
+// ------------------------------------------------------------------
+static sprokit::pipeline_t
+create_fuse_pipeline( bool fuse )
+{
+  kwiver::vital::config_block_sptr const config = kwiver::vital::config_block::empty_config();
+  config->set_value( "_fuse", fuse );
+
+  return std::make_shared< sprokit::pipeline > ( config );
+}
+
+
+// ------------------------------------------------------------------
+static void
+expect_fused( sprokit::process_t const& head,
+              sprokit::processes_t const& expect )
+{
+  sprokit::processes_t const fused = head->fused_processes();
+
+  if ( fused != expect )
+  {
+    TEST_ERROR( "Process \"" << head->name() << "\" has " << fused.size()
+                << " processes fused onto it rather than " << expect.size() );
+  }
+
+  if ( head->is_fused() )
+  {
+    TEST_ERROR( "Process \"" << head->name() << "\" is fused but heads a chain" );
+  }
+
+  for ( sprokit::process_t const& proc : expect )
+  {
+    if ( !proc->is_fused() )
+    {
+      TEST_ERROR( "Process \"" << proc->name() << "\" was not marked as fused" );
+    }
+  }
+}
+
+
+// ------------------------------------------------------------------
+static void
+expect_unfused( sprokit::processes_t const& procs )
+{
+  for ( sprokit::process_t const& proc : procs )
+  {
+    if ( proc->is_fused() || !proc->fused_processes().empty() )
+    {
+      TEST_ERROR( "Process \"" << proc->name() << "\" was fused" );
+    }
+  }
+}
+
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( setup_pipeline_fuse_chain )
+{
+  for ( bool const fuse : { false, true } )
+  {
+    sprokit::process_t const source = create_process( "numbers", "source" );
+    sprokit::process_t const pass1 = create_fusable_process( "pass1" );
+    sprokit::process_t const pass2 = create_fusable_process( "pass2" );
+    sprokit::process_t const sink = create_process( "take_number", "sink" );
+
+    sprokit::pipeline_t const pipeline = create_fuse_pipeline( fuse );
+
+    pipeline->add_process( source );
+    pipeline->add_process( pass1 );
+    pipeline->add_process( pass2 );
+    pipeline->add_process( sink );
+
+    pipeline->connect( "source", "number", "pass1", "in0" );
+    pipeline->connect( "pass1", fusable_process::port_output, "pass2", "in0" );
+    pipeline->connect( "pass2", fusable_process::port_output, "sink", "number" );
+
+    pipeline->setup_pipeline();
+
+    if ( fuse )
+    {
+      // The sink is not fusable, so the chain ends before it
+      expect_fused( source, { pass1, pass2 } );
+      expect_unfused( { sink } );
+    }
+    else
+    {
+      expect_unfused( { source, pass1, pass2, sink } );
+    }
+  }
+}
+
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( setup_pipeline_fuse_fan_out )
+{
+  sprokit::process_t const source = create_process( "numbers", "source" );
+  sprokit::process_t const pass1 = create_fusable_process( "pass1" );
+  sprokit::process_t const pass2 = create_fusable_process( "pass2" );
+  sprokit::process_t const sink1 = create_process( "take_number", "sink1" );
+  sprokit::process_t const sink2 = create_process( "take_number", "sink2" );
+
+  sprokit::pipeline_t const pipeline = create_fuse_pipeline( true );
+
+  pipeline->add_process( source );
+  pipeline->add_process( pass1 );
+  pipeline->add_process( pass2 );
+  pipeline->add_process( sink1 );
+  pipeline->add_process( sink2 );
+
+  // The source sends its output to two processes
+  pipeline->connect( "source", "number", "pass1", "in0" );
+  pipeline->connect( "source", "number", "pass2", "in0" );
+  pipeline->connect( "pass1", fusable_process::port_output, "sink1", "number" );
+  pipeline->connect( "pass2", fusable_process::port_output, "sink2", "number" );
+
+  pipeline->setup_pipeline();
+
+  expect_unfused( { source, pass1, pass2, sink1, sink2 } );
+}
+
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( setup_pipeline_fuse_multiple_upstream )
+{
+  sprokit::process_t const source1 = create_process( "numbers", "source1" );
+  sprokit::process_t const source2 = create_process( "numbers", "source2" );
+  sprokit::process_t const join = create_fusable_process( "join", 2 );
+  sprokit::process_t const pass = create_fusable_process( "pass" );
+  sprokit::process_t const sink = create_process( "take_number", "sink" );
+
+  sprokit::pipeline_t const pipeline = create_fuse_pipeline( true );
+
+  pipeline->add_process( source1 );
+  pipeline->add_process( source2 );
+  pipeline->add_process( join );
+  pipeline->add_process( pass );
+  pipeline->add_process( sink );
+
+  pipeline->connect( "source1", "number", "join", "in0" );
+  pipeline->connect( "source2", "number", "join", "in1" );
+  pipeline->connect( "join", fusable_process::port_output, "pass", "in0" );
+  pipeline->connect( "pass", fusable_process::port_output, "sink", "number" );
+
+  pipeline->setup_pipeline();
+
+  // The join has two upstream processes, but what follows it may still be
+  // fused onto it
+  expect_fused( join, { pass } );
+  expect_unfused( { source1, source2, sink } );
+}
+
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( setup_pipeline_fuse_frequency )
+{
+  sprokit::process_t const source = create_process( "numbers", "source" );
+  sprokit::process_t const slow = create_fusable_process( "slow", 1, 2 );
+  sprokit::process_t const sink = create_process( "take_number", "sink" );
+
+  sprokit::pipeline_t const pipeline = create_fuse_pipeline( true );
+
+  pipeline->add_process( source );
+  pipeline->add_process( slow );
+  pipeline->add_process( sink );
+
+  pipeline->connect( "source", "number", "slow", "in0" );
+  pipeline->connect( "slow", fusable_process::port_output, "sink", "number" );
+
+  pipeline->setup_pipeline();
+
+  expect_unfused( { source, slow, sink } );
+}
+
+
 // ------------------------------------------------------------------
 IMPLEMENT_TEST( setup_pipeline_frequency_linear )
 {
@@ -1564,6 +1901,109 @@ IMPLEMENT_TEST( setup_pipeline )
   pipeline->setup_pipeline();
 }
 
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( connection_statistics_before_setup )
+{
+  sprokit::pipeline_t const pipeline = create_pipeline();
+
+  EXPECT_EXCEPTION( sprokit::pipeline_not_setup_exception,
+                    pipeline->connection_statistics(),
+                    "requesting connection statistics before setup" );
+}
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( connection_statistics )
+{
+  sprokit::process::type_t const proc_typeu = sprokit::process::type_t( "numbers" );
+  sprokit::process::type_t const proc_typet = sprokit::process::type_t( "sink" );
+
+  sprokit::process::name_t const proc_nameu = sprokit::process::name_t( "upstream" );
+  sprokit::process::name_t const proc_namet = sprokit::process::name_t( "terminal" );
+
+  sprokit::process_t const processu = create_process( proc_typeu, proc_nameu );
+  sprokit::process_t const processt = create_process( proc_typet, proc_namet );
+
+  sprokit::pipeline_t const pipeline = create_pipeline();
+
+  pipeline->add_process( processu );
+  pipeline->add_process( processt );
+
+  sprokit::process::port_t const port_nameu = sprokit::process::port_t( "number" );
+  sprokit::process::port_t const port_namet = sprokit::process::port_t( "sink" );
+
+  pipeline->connect( proc_nameu, port_nameu,
+                     proc_namet, port_namet );
+
+  pipeline->setup_pipeline();
+
+  sprokit::connections_statistics_t const stats = pipeline->connection_statistics();
+
+  if ( stats.size() != 1 )
+  {
+    TEST_ERROR( "Expected statistics for 1 connection, got " << stats.size() );
+    return;
+  }
+
+  sprokit::process::connection_t const& conn = stats[0].first;
+
+  if ( ( conn.first.first != proc_nameu ) || ( conn.first.second != port_nameu ) ||
+       ( conn.second.first != proc_namet ) || ( conn.second.second != port_namet ) )
+  {
+    TEST_ERROR( "The statistics are for the wrong connection" );
+  }
+
+  if ( stats[0].second.pushed != 0 )
+  {
+    TEST_ERROR( "An edge which has not run reports pushed data" );
+  }
+}
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( save_state_before_setup )
+{
+  sprokit::pipeline_t const pipeline = create_pipeline();
+
+  EXPECT_EXCEPTION( sprokit::pipeline_not_setup_exception,
+                    pipeline->save_state(),
+                    "saving state before setup" );
+}
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( save_restore_state )
+{
+  sprokit::process::type_t const proc_typeu = sprokit::process::type_t( "numbers" );
+  sprokit::process::type_t const proc_typet = sprokit::process::type_t( "sink" );
+
+  sprokit::process::name_t const proc_nameu = sprokit::process::name_t( "upstream" );
+  sprokit::process::name_t const proc_namet = sprokit::process::name_t( "terminal" );
+
+  sprokit::process_t const processu = create_process( proc_typeu, proc_nameu );
+  sprokit::process_t const processt = create_process( proc_typet, proc_namet );
+
+  sprokit::pipeline_t const pipeline = create_pipeline();
+
+  pipeline->add_process( processu );
+  pipeline->add_process( processt );
+
+  pipeline->connect( proc_nameu, sprokit::process::port_t( "number" ),
+                     proc_namet, sprokit::process::port_t( "sink" ) );
+
+  pipeline->setup_pipeline();
+
+  sprokit::process_states_t const states = pipeline->save_state();
+
+  if ( !states.empty() )
+  {
+    TEST_ERROR( "Processes without state saved some" );
+  }
+
+  // State for processes which are not in the pipeline is skipped.
+  sprokit::process_states_t stale;
+  stale[ "removed" ] = "state";
+
+  pipeline->restore_state( stale );
+}
+
 static sprokit::scheduler_t create_scheduler( sprokit::pipeline_t const& pipe );
 
 
@@ -2088,3 +2528,116 @@ ::_add_process( name_t const& name_, type_t const& type_, kwiver::vital::config_
 {
   add_process( name_, type_, config );
 }
+
+
+sprokit::process::port_t const record_configure_process::port_input =
+  sprokit::process::port_t( "input" );
+
+record_configure_process
+::record_configure_process( kwiver::vital::config_block_sptr const& conf )
+  : process( conf ),
+  m_configured( false )
+{
+  declare_input_port(
+    port_input,
+    type_flow_dependent + port_type_t( "tag" ),
+    port_flags_t(),
+    port_description_t( "An input port" ) );
+}
+
+
+record_configure_process
+::~record_configure_process()
+{
+}
+
+
+void
+record_configure_process
+::_configure()
+{
+  m_configured = true;
+
+  process::_configure();
+}
+
+
+kwiver::vital::config_block_key_t const fusable_process::config_inputs =
+  kwiver::vital::config_block_key_t( "inputs" );
+kwiver::vital::config_block_key_t const fusable_process::config_frequency =
+  kwiver::vital::config_block_key_t( "frequency" );
+sprokit::process::port_t const fusable_process::port_output =
+  sprokit::process::port_t( "out" );
+
+fusable_process
+::fusable_process( kwiver::vital::config_block_sptr const& conf )
+  : process( conf ),
+  m_inputs( conf->get_value< size_t > ( config_inputs ) )
+{
+  port_frequency_t const frequency( conf->get_value< size_t > ( config_frequency ) );
+
+  port_flags_t required;
+  required.insert( flag_required );
+
+  for ( size_t i = 0; i < m_inputs; ++i )
+  {
+    declare_input_port(
+      "in" + std::to_string( i ),
+      "integer",
+      required,
+      port_description_t( "An input passed on when it is the first" ),
+      frequency );
+  }
+
+  declare_output_port(
+    port_output,
+    "integer",
+    required,
+    port_description_t( "The first input" ),
+    frequency );
+}
+
+
+fusable_process
+::~fusable_process()
+{
+}
+
+
+void
+fusable_process
+::_step()
+{
+  sprokit::datum_t dat;
+
+  for ( size_t i = 0; i < m_inputs; ++i )
+  {
+    sprokit::datum_t const in = grab_datum_from_port( "in" + std::to_string( i ) );
+
+    if ( !dat )
+    {
+      dat = in;
+    }
+  }
+
+  push_datum_to_port( port_output, dat );
+
+  if ( dat->type() == sprokit::datum::complete )
+  {
+    mark_process_as_complete();
+  }
+
+  process::_step();
+}
+
+
+sprokit::process::properties_t
+fusable_process
+::_properties() const
+{
+  properties_t consts = process::_properties();
+
+  consts.insert( property_fusable );
+
+  return consts;
+}
@@ -7,6 +7,7 @@
 #include <vital/config/config_block.h>
 #include <vital/plugin_loader/plugin_manager.h>
 
+#include <sprokit/pipeline/datum.h>
 #include <sprokit/pipeline/pipeline.h>
 #include <sprokit/pipeline/process.h>
 #include <sprokit/pipeline/process_factory.h>
@@ -18,6 +19,7 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -367,6 +369,53 @@ IMPLEMENT_TEST(multiplier_pipeline)
   }
 }
 
+class fusable_pass_process
+  : public sprokit::process
+{
+  public:
+    fusable_pass_process(kwiver::vital::config_block_sptr const& config);
+    ~fusable_pass_process();
+
+    static port_t const port_input;
+    static port_t const port_output;
+
+  protected:
+    void _step();
+    properties_t _properties() const;
+};
+
+static std::vector<std::string> run_pass_chain(sprokit::scheduler::type_t const& scheduler_type,
+                                               bool fuse);
+
+IMPLEMENT_TEST(fused_pipeline)
+{
+  int32_t const start_value = 10;
+  int32_t const end_value = 30;
+
+  std::vector<std::string> expected;
+  for (int32_t i = start_value; i < end_value; ++i)
+  {
+    expected.push_back(lexical_cast<std::string>(i));
+  }
+
+  std::vector<std::string> const unfused = run_pass_chain(scheduler_type, false);
+  std::vector<std::string> const fused = run_pass_chain(scheduler_type, true);
+
+  if (unfused != expected)
+  {
+    TEST_ERROR("Unexpected output from the unfused pipeline: "
+               "Expected " << expected.size() << " lines, "
+               "received " << unfused.size());
+  }
+
+  if (fused != unfused)
+  {
+    TEST_ERROR("The fused pipeline gave different output: "
+               "Expected " << unfused.size() << " lines, "
+               "received " << fused.size());
+  }
+}
+
 IMPLEMENT_TEST(multiplier_cluster_pipeline)
 {
   sprokit::process::type_t const proc_typeu = sprokit::process::type_t("numbers");
@@ -607,6 +656,98 @@ IMPLEMENT_TEST(frequency_pipeline)
   }
 }
 
+IMPLEMENT_TEST(branch_priority_pipeline)
+{
+  sprokit::process::type_t const proc_typeu = sprokit::process::type_t("numbers");
+  sprokit::process::type_t const proc_typet = sprokit::process::type_t("print_number");
+
+  sprokit::process::name_t const proc_nameu = sprokit::process::name_t("upstream");
+  sprokit::process::name_t const proc_namef = sprokit::process::name_t("display");
+  sprokit::process::name_t const proc_names = sprokit::process::name_t("archive");
+
+  std::string const output_pathf = "test-run-branch_priority_pipeline-" + scheduler_type + "-display.txt";
+  std::string const output_paths = "test-run-branch_priority_pipeline-" + scheduler_type + "-archive.txt";
+
+  int32_t const start_value = 10;
+  int32_t const end_value = 20;
+
+  {
+    kwiver::vital::config_block_sptr const configu = kwiver::vital::config_block::empty_config();
+
+    configu->set_value("start", lexical_cast<kwiver::vital::config_block_value_t>(start_value));
+    configu->set_value("end", lexical_cast<kwiver::vital::config_block_value_t>(end_value));
+
+    // The display branch runs first; the archive branch lags behind.
+    kwiver::vital::config_block_sptr const configf = kwiver::vital::config_block::empty_config();
+
+    configf->set_value("output", output_pathf);
+    configf->set_value("_schedule_priority", "10");
+
+    kwiver::vital::config_block_sptr const configs = kwiver::vital::config_block::empty_config();
+
+    configs->set_value("output", output_paths);
+    configs->set_value("_schedule_priority", "-5");
+
+    sprokit::process_t const processu = create_process(proc_typeu, proc_nameu, configu);
+    sprokit::process_t const processf = create_process(proc_typet, proc_namef, configf);
+    sprokit::process_t const processs = create_process(proc_typet, proc_names, configs);
+
+    sprokit::pipeline_t const pipeline = create_pipeline();
+
+    pipeline->add_process(processu);
+    pipeline->add_process(processf);
+    pipeline->add_process(processs);
+
+    sprokit::process::port_t const port_name = sprokit::process::port_t("number");
+
+    pipeline->connect(proc_nameu, port_name,
+                      proc_namef, port_name);
+    pipeline->connect(proc_nameu, port_name,
+                      proc_names, port_name);
+
+    pipeline->setup_pipeline();
+
+    sprokit::scheduler_t const scheduler = sprokit::create_scheduler(scheduler_type, pipeline);
+
+    scheduler->start();
+    scheduler->wait();
+  }
+
+  // Priorities change the order of steps, never what each branch receives.
+  for (std::string const& output_path : { output_pathf, output_paths })
+  {
+    std::ifstream fin(output_path.c_str());
+
+    if (!fin.good())
+    {
+      TEST_ERROR("Could not open the output file " << output_path);
+      continue;
+    }
+
+    std::string line;
+
+    for (int32_t i = start_value; i < end_value; ++i)
+    {
+      if (!std::getline(fin, line))
+      {
+        TEST_ERROR("Failed to read a line from " << output_path);
+      }
+
+      if (kwiver::vital::config_block_value_t(line) != lexical_cast<kwiver::vital::config_block_value_t>(i))
+      {
+        TEST_ERROR("Did not get expected value in " << output_path << ": "
+                   "Expected: " << i << " "
+                   "Received: " << line);
+      }
+    }
+
+    if (std::getline(fin, line))
+    {
+      TEST_ERROR("More results than expected in " << output_path);
+    }
+  }
+}
+
 sprokit::process_t
 create_process(sprokit::process::type_t const& type, sprokit::process::name_t const& name, kwiver::vital::config_block_sptr config)
 {
@@ -621,3 +762,138 @@ create_pipeline()
 {
   return std::make_shared<sprokit::pipeline>();
 }
+
+std::vector<std::string>
+run_pass_chain(sprokit::scheduler::type_t const& scheduler_type, bool fuse)
+{
+  std::string const output_path = "test-run-fused_pipeline-" + scheduler_type +
+    (fuse ? "-fused" : "-unfused") + "-print_number.txt";
+
+  {
+    kwiver::vital::config_block_sptr const configu = kwiver::vital::config_block::empty_config();
+
+    configu->set_value("start", 10);
+    configu->set_value("end", 30);
+
+    kwiver::vital::config_block_sptr const configt = kwiver::vital::config_block::empty_config();
+
+    configt->set_value("output", output_path);
+
+    sprokit::process_t const processu = create_process("numbers", "upstream", configu);
+    sprokit::process_t const processt = create_process("print_number", "terminal", configt);
+
+    sprokit::processes_t passes;
+    for (std::string const name : { "pass1", "pass2" })
+    {
+      kwiver::vital::config_block_sptr const configp = kwiver::vital::config_block::empty_config();
+
+      configp->set_value(sprokit::process::config_name, name);
+
+      passes.push_back(std::make_shared<fusable_pass_process>(configp));
+    }
+
+    kwiver::vital::config_block_sptr const config = kwiver::vital::config_block::empty_config();
+
+    config->set_value("_fuse", fuse);
+
+    sprokit::pipeline_t const pipeline = std::make_shared<sprokit::pipeline>(config);
+
+    pipeline->add_process(processu);
+    pipeline->add_process(passes[0]);
+    pipeline->add_process(passes[1]);
+    pipeline->add_process(processt);
+
+    pipeline->connect("upstream", "number",
+                      "pass1", fusable_pass_process::port_input);
+    pipeline->connect("pass1", fusable_pass_process::port_output,
+                      "pass2", fusable_pass_process::port_input);
+    pipeline->connect("pass2", fusable_pass_process::port_output,
+                      "terminal", "number");
+
+    pipeline->setup_pipeline();
+
+    if (processu->fused_processes() != (fuse ? passes : sprokit::processes_t()))
+    {
+      TEST_ERROR("The pass processes were " << (fuse ? "not " : "")
+                 << "fused onto the upstream process");
+    }
+
+    sprokit::scheduler_t const scheduler = sprokit::create_scheduler(scheduler_type, pipeline);
+
+    scheduler->start();
+    scheduler->wait();
+  }
+
+  std::ifstream fin(output_path.c_str());
+
+  if (!fin.good())
+  {
+    TEST_ERROR("Could not open " << output_path);
+  }
+
+  std::vector<std::string> lines;
+  std::string line;
+
+  while (std::getline(fin, line))
+  {
+    lines.push_back(line);
+  }
+
+  return lines;
+}
+
+sprokit::process::port_t const fusable_pass_process::port_input = sprokit::process::port_t("input");
+sprokit::process::port_t const fusable_pass_process::port_output = sprokit::process::port_t("output");
+
+fusable_pass_process
+::fusable_pass_process(kwiver::vital::config_block_sptr const& config)
+  : process(config)
+{
+  port_flags_t required;
+
+  required.insert(flag_required);
+
+  declare_input_port(
+    port_input,
+    "integer",
+    required,
+    port_description_t("The number to pass."));
+
+  declare_output_port(
+    port_output,
+    "integer",
+    required,
+    port_description_t("The passed number."));
+}
+
+fusable_pass_process
+::~fusable_pass_process()
+{
+}
+
+void
+fusable_pass_process
+::_step()
+{
+  sprokit::datum_t const dat = grab_datum_from_port(port_input);
+
+  push_datum_to_port(port_output, dat);
+
+  if (dat->type() == sprokit::datum::complete)
+  {
+    mark_process_as_complete();
+  }
+
+  process::_step();
+}
+
+sprokit::process::properties_t
+fusable_pass_process
+::_properties() const
+{
+  properties_t consts = process::_properties();
+
+  consts.insert(property_fusable);
+
+  return consts;
+}
@@ -4,12 +4,15 @@
 
 #include <test_common.h>
 
+#include <sprokit/pipeline_util/compiled_pipeline.h>
 #include <sprokit/pipeline_util/pipeline_builder.h>
 #include <sprokit/pipeline_util/pipe_bakery.h>
 #include <sprokit/pipeline_util/pipe_bakery_exception.h>
+#include <sprokit/pipeline_util/pipeline_partition.h>
 #include <sprokit/pipeline_util/load_pipe_exception.h>
 
 #include <sprokit/pipeline/pipeline.h>
+#include <sprokit/pipeline/pipeline_exception.h>
 #include <sprokit/pipeline/process_cluster.h>
 #include <sprokit/pipeline/process_factory.h>
 #include <sprokit/pipeline/scheduler.h>
@@ -525,6 +528,220 @@ IMPLEMENT_TEST( pipeline_multiplier )
   /// \todo Verify the connections are done properly.
 }
 
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( pipeline_replicas )
+{
+  kwiver::vital::plugin_manager::instance().load_all_plugins();
+  sprokit::pipeline_builder builder;
+  builder.load_pipeline( pipe_file );
+  sprokit::pipeline_t const pipeline = builder.pipeline();
+
+  if ( ! pipeline )
+  {
+    TEST_ERROR( "A pipeline was not created" );
+
+    return;
+  }
+
+  pipeline->process_by_name( "multiply/distribute" );
+  pipeline->process_by_name( "multiply/replica0" );
+  pipeline->process_by_name( "multiply/replica1" );
+  pipeline->process_by_name( "multiply/replica2" );
+  pipeline->process_by_name( "multiply/collate" );
+  pipeline->process_by_name( "multiply/status/factor2" );
+
+  EXPECT_EXCEPTION( sprokit::no_such_process_exception,
+                    pipeline->process_by_name( "multiply" ),
+                    "requesting a process which was replicated" );
+
+  pipeline->setup_pipeline();
+
+  sprokit::scheduler_t const scheduler =
+    sprokit::create_scheduler( sprokit::scheduler_factory::default_type, pipeline );
+
+  scheduler->start();
+  scheduler->wait();
+
+  std::ifstream fin( "test-pipe_bakery-pipeline_replicas.txt" );
+
+  if ( ! fin.good() )
+  {
+    TEST_ERROR( "Could not open the output file" );
+  }
+
+  std::string line;
+
+  for ( int32_t i = 10; i < 30; ++i )
+  {
+    if ( ! std::getline( fin, line ) )
+    {
+      TEST_ERROR( "Failed to read a line from the file" );
+    }
+
+    std::stringstream str;
+    str << ( i * i );
+    if ( kwiver::vital::config_block_value_t( line ) != str.str() )
+    {
+      TEST_ERROR( "Did not get expected value: Expected: "
+                  << ( i * i ) << " Received: " << line );
+    }
+  }
+
+  if ( std::getline( fin, line ) )
+  {
+    TEST_ERROR( "More results than expected in the file" );
+  }
+}
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( pipeline_replicas_invalid )
+{
+  kwiver::vital::plugin_manager::instance().load_all_plugins();
+  sprokit::pipe_blocks const blocks = load_pipe_blocks_from_file( pipe_file );
+
+  EXPECT_EXCEPTION( sprokit::invalid_replicas_exception,
+                    sprokit::bake_pipe_blocks( blocks ),
+                    "baking a pipeline with an invalid replica count" );
+}
+
+// ------------------------------------------------------------------
+static void
+count_blocks( sprokit::pipe_blocks const& blocks,
+              size_t& processes, size_t& connections )
+{
+  processes = 0;
+  connections = 0;
+
+  for ( auto const& block : blocks )
+  {
+    processes += ( kwiver::vital::get_if< sprokit::process_pipe_block >( &block ) ? 1 : 0 );
+    connections += ( kwiver::vital::get_if< sprokit::connect_pipe_block >( &block ) ? 1 : 0 );
+  }
+}
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( pipeline_partition )
+{
+  sprokit::pipe_blocks const blocks = load_pipe_blocks_from_file( pipe_file );
+
+  sprokit::pipeline_nodes_t const nodes = sprokit::pipeline_nodes( blocks );
+
+  if ( nodes.size() != 2 ||
+       nodes[0].name != "front" || nodes[0].host != "localhost" ||
+       ! nodes[0].launch.empty() ||
+       nodes[1].name != "gpu" || nodes[1].host != "gpu.example.com" ||
+       nodes[1].launch != "ssh gpu.example.com" )
+  {
+    TEST_ERROR( "The nodes of the pipeline were not found" );
+  }
+
+  size_t processes;
+  size_t connections;
+
+  // source, sink and log, the sender for source.output and the receiver
+  // for detect.output, which feeds both sink and log
+  sprokit::pipe_blocks const front = sprokit::partition_pipe_blocks( blocks, "front" );
+  count_blocks( front, processes, connections );
+
+  if ( processes != 7 || connections != 6 )
+  {
+    TEST_ERROR( "The front node has " << processes << " processes and "
+                << connections << " connections; expected 7 and 6" );
+  }
+
+  kwiver::vital::config_block_sptr const front_conf =
+    sprokit::extract_configuration( front );
+
+  if ( front_conf->get_value< std::string >( "_cut1_receive:connect_host" ) != "gpu.example.com" ||
+       front_conf->get_value< int >( "_cut1_receive:port" ) != 6001 ||
+       front_conf->get_value< int >( "_cut0_send:port" ) != 6000 )
+  {
+    TEST_ERROR( "The transport on the front node is not configured correctly" );
+  }
+
+  sprokit::pipe_blocks const gpu = sprokit::partition_pipe_blocks( blocks, "gpu" );
+  count_blocks( gpu, processes, connections );
+
+  if ( processes != 5 || connections != 4 )
+  {
+    TEST_ERROR( "The gpu node has " << processes << " processes and "
+                << connections << " connections; expected 5 and 4" );
+  }
+
+  kwiver::vital::config_block_sptr const gpu_conf =
+    sprokit::extract_configuration( gpu );
+
+  if ( gpu_conf->get_value< std::string >( "_cut0_receive:connect_host" ) != "localhost" ||
+       gpu_conf->get_value< std::string >( "_cut0_deserialize:serialization_type" ) != "protobuf" )
+  {
+    TEST_ERROR( "The transport on the gpu node is not configured correctly" );
+  }
+
+  EXPECT_EXCEPTION( sprokit::partition_exception,
+                    sprokit::partition_pipe_blocks( blocks, "nowhere" ),
+                    "partitioning for a node without processes" );
+}
+
+// ------------------------------------------------------------------
+IMPLEMENT_TEST( compiled_pipeline )
+{
+  // Work on a copy, which is changed to make the compiled pipeline stale
+  kwiver::vital::path_t const copy = "test-compiled_pipeline.pipe";
+  kwiver::vital::path_t const compiled = "test-compiled_pipeline.pipec";
+  kwiversys::SystemTools::CopyFileAlways( pipe_file, copy );
+
+  sprokit::pipe_blocks const blocks = load_pipe_blocks_from_file( copy );
+  sprokit::write_compiled_pipeline( compiled, blocks, "inputs" );
+
+  sprokit::pipe_blocks loaded;
+  if ( ! sprokit::read_compiled_pipeline( compiled, "inputs", loaded ) )
+  {
+    TEST_ERROR( "The compiled pipeline was not loaded" );
+  }
+
+  size_t processes;
+  size_t connections;
+  count_blocks( loaded, processes, connections );
+
+  if ( loaded.size() != blocks.size() || processes != 2 || connections != 1 )
+  {
+    TEST_ERROR( "The compiled pipeline has " << loaded.size() << " blocks, "
+                << processes << " processes and " << connections
+                << " connections; expected " << blocks.size() << ", 2 and 1" );
+  }
+
+  kwiver::vital::config_block_sptr const expected = sprokit::extract_configuration( blocks );
+  kwiver::vital::config_block_sptr const conf = sprokit::extract_configuration( loaded );
+
+  for ( auto const& key : expected->available_values() )
+  {
+    if ( ! conf->has_value( key ) ||
+         conf->get_value< std::string >( key ) != expected->get_value< std::string >( key ) ||
+         conf->is_read_only( key ) != expected->is_read_only( key ) )
+    {
+      TEST_ERROR( "The value of " << key << " was not compiled correctly" );
+    }
+  }
+
+  if ( sprokit::read_compiled_pipeline( compiled, "other inputs", loaded ) )
+  {
+    TEST_ERROR( "A compiled pipeline for other inputs was loaded" );
+  }
+
+  {
+    std::ofstream change( copy, std::ios::app );
+    change << "\n# changed\n";
+  }
+
+  if ( sprokit::read_compiled_pipeline( compiled, "inputs", loaded ) )
+  {
+    TEST_ERROR( "A compiled pipeline older than its source was loaded" );
+  }
+
+  kwiversys::SystemTools::RemoveFile( copy );
+  kwiversys::SystemTools::RemoveFile( compiled );
+}
+
 // ------------------------------------------------------------------
 IMPLEMENT_TEST( cluster_multiplier )
 {
@@ -0,0 +1,224 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef INCL_ELEMENT_BINARY_IO_H
+#define INCL_ELEMENT_BINARY_IO_H
+
+///
+/// Binary encoding of column values for track_oracle snapshots.
+///
+/// Arithmetic and enum values, strings, and vectors of strings or of
+/// non-bool arithmetic values are written as their native bytes (lengths
+/// as uint64_t), and string_symbols as their text; everything else is
+/// written as a length-prefixed string from the column's
+/// kwiver_io_base::to_stream() and read back through from_str().  The
+/// bytes are host-order; the snapshot header records the byte order.
+///
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <track_oracle/core/kwiver_io_base.h>
+#include <track_oracle/core/string_symbol.h>
+
+namespace kwiver {
+namespace track_oracle {
+
+namespace binary_io {
+
+inline void
+write_bytes( std::ostream& os, const void* p, size_t n )
+{
+  os.write( static_cast< const char* >( p ), static_cast< std::streamsize >( n ));
+}
+
+// copy n bytes from p to dst and advance p; false if fewer than n are left
+inline bool
+read_bytes( const char*& p, const char* end, void* dst, size_t n )
+{
+  if ( static_cast< size_t >( end - p ) < n )
+  {
+    return false;
+  }
+  std::memcpy( dst, p, n );
+  p += n;
+  return true;
+}
+
+template< typename T >
+void
+write_pod( std::ostream& os, const T& val )
+{
+  write_bytes( os, &val, sizeof( T ));
+}
+
+template< typename T >
+bool
+read_pod( const char*& p, const char* end, T& val )
+{
+  return read_bytes( p, end, &val, sizeof( T ));
+}
+
+inline void
+write_string( std::ostream& os, const std::string& s )
+{
+  write_pod< uint64_t >( os, s.size() );
+  write_bytes( os, s.data(), s.size() );
+}
+
+inline bool
+read_string( const char*& p, const char* end, std::string& s )
+{
+  uint64_t n;
+  if ( ( ! read_pod( p, end, n )) || ( static_cast< uint64_t >( end - p ) < n ))
+  {
+    return false;
+  }
+  s.assign( p, static_cast< size_t >( n ));
+  p += n;
+  return true;
+}
+
+} // ...binary_io
+
+// The general case: the text representation of the column's io handler.
+// read() returns false only if the data is truncated; a value the io
+// handler can't parse sets ok to false.
+
+template< typename T, typename Enable = void >
+struct element_binary_io
+{
+  static void write( std::ostream& os, const T& val, const kwiver_io_base<T>& io )
+  {
+    std::ostringstream oss;
+    io.to_stream( oss, val );
+    binary_io::write_string( os, oss.str() );
+  }
+
+  static bool read( const char*& p, const char* end, T& val, const kwiver_io_base<T>& io, bool& ok )
+  {
+    std::string s;
+    if ( ! binary_io::read_string( p, end, s ))
+    {
+      return false;
+    }
+    ok = io.from_str( s, val );
+    return true;
+  }
+};
+
+template< typename T >
+struct element_binary_io< T, typename std::enable_if< std::is_arithmetic<T>::value || std::is_enum<T>::value >::type >
+{
+  static void write( std::ostream& os, const T& val, const kwiver_io_base<T>& )
+  {
+    binary_io::write_pod( os, val );
+  }
+
+  static bool read( const char*& p, const char* end, T& val, const kwiver_io_base<T>&, bool& ok )
+  {
+    ok = true;
+    return binary_io::read_pod( p, end, val );
+  }
+};
+
+template<>
+struct element_binary_io< std::string >
+{
+  static void write( std::ostream& os, const std::string& val, const kwiver_io_base<std::string>& )
+  {
+    binary_io::write_string( os, val );
+  }
+
+  static bool read( const char*& p, const char* end, std::string& val, const kwiver_io_base<std::string>&, bool& ok )
+  {
+    ok = true;
+    return binary_io::read_string( p, end, val );
+  }
+};
+
+template<>
+struct element_binary_io< string_symbol >
+{
+  static void write( std::ostream& os, const string_symbol& val, const kwiver_io_base<string_symbol>& )
+  {
+    binary_io::write_string( os, val.str() );
+  }
+
+  static bool read( const char*& p, const char* end, string_symbol& val, const kwiver_io_base<string_symbol>&, bool& ok )
+  {
+    ok = true;
+    std::string s;
+    if ( ! binary_io::read_string( p, end, s ))
+    {
+      return false;
+    }
+    val = string_symbol( s );
+    return true;
+  }
+};
+
+template< typename T >
+struct element_binary_io< std::vector<T>, typename std::enable_if< std::is_arithmetic<T>::value && ! std::is_same<T, bool>::value >::type >
+{
+  static void write( std::ostream& os, const std::vector<T>& val, const kwiver_io_base< std::vector<T> >& )
+  {
+    binary_io::write_pod< uint64_t >( os, val.size() );
+    if ( ! val.empty() )
+    {
+      binary_io::write_bytes( os, &val[0], val.size() * sizeof( T ));
+    }
+  }
+
+  static bool read( const char*& p, const char* end, std::vector<T>& val, const kwiver_io_base< std::vector<T> >&, bool& ok )
+  {
+    ok = true;
+    uint64_t n;
+    if ( ( ! binary_io::read_pod( p, end, n )) || ( static_cast< uint64_t >( end - p ) / sizeof( T ) < n ))
+    {
+      return false;
+    }
+    val.resize( static_cast< size_t >( n ));
+    return ( n == 0 ) || binary_io::read_bytes( p, end, &val[0], val.size() * sizeof( T ));
+  }
+};
+
+template<>
+struct element_binary_io< std::vector< std::string > >
+{
+  static void write( std::ostream& os, const std::vector< std::string >& val, const kwiver_io_base< std::vector< std::string > >& )
+  {
+    binary_io::write_pod< uint64_t >( os, val.size() );
+    for (size_t i=0; i<val.size(); ++i)
+    {
+      binary_io::write_string( os, val[i] );
+    }
+  }
+
+  static bool read( const char*& p, const char* end, std::vector< std::string >& val, const kwiver_io_base< std::vector< std::string > >&, bool& ok )
+  {
+    ok = true;
+    uint64_t n;
+    if ( ( ! binary_io::read_pod( p, end, n )) || ( static_cast< uint64_t >( end - p ) / sizeof( uint64_t ) < n ))
+    {
+      return false;
+    }
+    val.resize( static_cast< size_t >( n ));
+    for (size_t i=0; i<val.size(); ++i)
+    {
+      if ( ! binary_io::read_string( p, end, val[i] )) return false;
+    }
+    return true;
+  }
+};
+
+} // ...track_oracle
+} // ...kwiver
+
+#endif
@@ -0,0 +1,427 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef INCL_ELEMENT_COLUMN_H
+#define INCL_ELEMENT_COLUMN_H
+
+///
+/// The values of one data column, keyed by row handle.
+///
+/// A column is held either in a std::map (the MAP storage), which costs a
+/// tree node per value but nothing for the rows without a value, or in
+/// DENSE storage: a handle -> slot index covering the range of handles the
+/// column has seen, a bitmap of the rows holding a value, and the values
+/// themselves in contiguous chunks of slots.  Row handles are allocated
+/// sequentially, so for columns set on most rows in their range the dense
+/// storage takes much less memory and exists() is a bit test.
+///
+/// Values are never moved once inserted, under either storage, so
+/// references returned by get() stay valid until the value is erased or the
+/// storage type is changed.
+///
+
+#include <track_oracle/core/track_oracle_api_types.h>
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace kwiver {
+namespace track_oracle {
+
+enum element_storage_type { STORAGE_MAP, STORAGE_DENSE };
+
+template< typename T >
+class element_column
+{
+public:
+  explicit element_column( element_storage_type t = STORAGE_MAP )
+    : type( t ), base( 0 ), n_slots( 0 ), n_values( 0 )
+  {}
+
+  element_storage_type storage_type() const { return this->type; }
+
+  // Move the values into storage of type t
+  void set_storage_type( element_storage_type t );
+
+  size_t size() const { return this->n_values; }
+
+  bool exists( oracle_entry_handle_type h ) const;
+
+  // flags for each handle of the sorted list
+  std::vector< bool > exists( const std::vector< oracle_entry_handle_type >& sorted_hlist ) const;
+
+  // the value at h, or null if absent
+  const T* find( oracle_entry_handle_type h ) const;
+  T* find( oracle_entry_handle_type h );
+
+  // the value at h, first set to default_value if absent
+  T& get( oracle_entry_handle_type h, const T& default_value );
+
+  // set the value at h
+  void set( oracle_entry_handle_type h, const T& val );
+
+  // set the value at h if absent; returns true if it was set
+  bool insert( oracle_entry_handle_type h, const T& val );
+
+  // returns true if there was a value at h
+  bool erase( oracle_entry_handle_type h );
+
+  // the first row, in handle order, whose value satisfies pred, or
+  // INVALID_ROW_HANDLE
+  template< typename Pred >
+  oracle_entry_handle_type find_if( Pred pred ) const;
+
+  // call f( handle, value ) for each row in handle order
+  template< typename F >
+  void for_each( F f ) const;
+
+private:
+  typedef uint32_t slot_type;
+  static const size_t chunk_size = 1024;
+
+  element_storage_type type;
+
+  // STORAGE_MAP
+  std::map< oracle_entry_handle_type, T > values_map;
+
+  // STORAGE_DENSE; slots and present are indexed by (handle - base)
+  oracle_entry_handle_type base;
+  std::vector< slot_type > slots;
+  std::vector< bool > present;
+  std::vector< std::unique_ptr< T[] > > chunks;
+  std::vector< slot_type > free_slots;
+  size_t n_slots;
+
+  size_t n_values;
+
+  bool dense_has( oracle_entry_handle_type h ) const
+  {
+    return ( h >= this->base ) &&
+           ( h - this->base < this->present.size() ) &&
+           this->present[ h - this->base ];
+  }
+  T& slot_value( slot_type s ) const
+  {
+    return this->chunks[ s / chunk_size ][ s % chunk_size ];
+  }
+  T& dense_add( oracle_entry_handle_type h, const T& val );
+  void dense_clear();
+};
+
+template< typename T >
+void
+element_column<T>
+::set_storage_type( element_storage_type t )
+{
+  if ( t == this->type )
+  {
+    return;
+  }
+
+  element_column<T> moved( t );
+  this->for_each( [&moved]( oracle_entry_handle_type h, const T& val ) { moved.set( h, val ); } );
+  *this = std::move( moved );
+}
+
+template< typename T >
+bool
+element_column<T>
+::exists( oracle_entry_handle_type h ) const
+{
+  return ( this->type == STORAGE_DENSE )
+    ? this->dense_has( h )
+    : ( this->values_map.find( h ) != this->values_map.end() );
+}
+
+template< typename T >
+std::vector< bool >
+element_column<T>
+::exists( const std::vector< oracle_entry_handle_type >& sorted_hlist ) const
+{
+  std::vector< bool > ret( sorted_hlist.size(), false );
+  if (sorted_hlist.empty())
+  {
+    return ret;
+  }
+
+  if ( this->type == STORAGE_DENSE )
+  {
+    for (size_t i=0; i<sorted_hlist.size(); ++i)
+    {
+      ret[i] = this->dense_has( sorted_hlist[i] );
+    }
+    return ret;
+  }
+
+  size_t ret_index(0), hlist_size( sorted_hlist.size() );
+  typename std::map<oracle_entry_handle_type, T>::const_iterator p = this->values_map.lower_bound( sorted_hlist[0] );
+  typename std::map<oracle_entry_handle_type, T>::const_iterator e = this->values_map.end();
+
+  bool keep_going = (p != e) && (ret_index < hlist_size);
+  while (keep_going)
+  {
+    //
+    // each time through the loop, we either
+    //
+    // 1) if p->first < sorted_hlist[ret_index], increment p
+    //
+    // or
+    //
+    // 2) if p->first == sorted_hlist[ret_index], set return flag and increment both
+    //
+    // or
+    //
+    // 3) if p->first > sorted_hlist[ret_index], increment ret_index
+
+    oracle_entry_handle_type left(p->first), right( sorted_hlist[ ret_index ]);
+    if (left < right)
+    {
+      keep_going = (++p != e);
+    }
+    else if (left == right)
+    {
+      ret[ ret_index ] = true;
+      keep_going = ((++p != e) && (++ret_index < hlist_size));
+    }
+    else
+    {
+      keep_going = (++ret_index < hlist_size);
+    }
+
+  }
+
+  return ret;
+}
+
+template< typename T >
+const T*
+element_column<T>
+::find( oracle_entry_handle_type h ) const
+{
+  if ( this->type == STORAGE_DENSE )
+  {
+    return this->dense_has( h ) ? &this->slot_value( this->slots[ h - this->base ] ) : 0;
+  }
+  typename std::map<oracle_entry_handle_type, T>::const_iterator p = this->values_map.find( h );
+  return ( p == this->values_map.end() ) ? 0 : &p->second;
+}
+
+template< typename T >
+T*
+element_column<T>
+::find( oracle_entry_handle_type h )
+{
+  return const_cast< T* >( static_cast< const element_column<T>* >( this )->find( h ) );
+}
+
+template< typename T >
+T&
+element_column<T>
+::get( oracle_entry_handle_type h, const T& default_value )
+{
+  if ( this->type == STORAGE_DENSE )
+  {
+    T* p = this->find( h );
+    return p ? *p : this->dense_add( h, default_value );
+  }
+  typename std::map<oracle_entry_handle_type, T>::iterator p = this->values_map.lower_bound( h );
+  if ( ( p == this->values_map.end() ) || ( p->first != h ))
+  {
+    p = this->values_map.insert( p, std::make_pair( h, default_value ));
+    ++this->n_values;
+  }
+  return p->second;
+}
+
+template< typename T >
+void
+element_column<T>
+::set( oracle_entry_handle_type h, const T& val )
+{
+  T* p = this->find( h );
+  if ( p )
+  {
+    *p = val;
+  }
+  else if ( this->type == STORAGE_DENSE )
+  {
+    this->dense_add( h, val );
+  }
+  else
+  {
+    this->values_map.insert( std::make_pair( h, val ));
+    ++this->n_values;
+  }
+}
+
+template< typename T >
+bool
+element_column<T>
+::insert( oracle_entry_handle_type h, const T& val )
+{
+  if ( this->exists( h ))
+  {
+    return false;
+  }
+  this->set( h, val );
+  return true;
+}
+
+template< typename T >
+bool
+element_column<T>
+::erase( oracle_entry_handle_type h )
+{
+  if ( this->type == STORAGE_MAP )
+  {
+    size_t c = this->values_map.erase( h );
+    this->n_values -= c;
+    return (c != 0);
+  }
+
+  if ( ! this->dense_has( h ))
+  {
+    return false;
+  }
+  size_t i = h - this->base;
+  slot_type s = this->slots[ i ];
+  this->present[ i ] = false;
+  this->slot_value( s ) = T();
+  this->free_slots.push_back( s );
+  if ( --this->n_values == 0 )
+  {
+    this->dense_clear();
+  }
+  return true;
+}
+
+template< typename T >
+template< typename Pred >
+oracle_entry_handle_type
+element_column<T>
+::find_if( Pred pred ) const
+{
+  if ( this->type == STORAGE_MAP )
+  {
+    for (typename std::map<oracle_entry_handle_type, T>::const_iterator i = this->values_map.begin();
+         i != this->values_map.end();
+         ++i )
+    {
+      if ( pred( i->second ))
+      {
+        return i->first;
+      }
+    }
+    return INVALID_ROW_HANDLE;
+  }
+
+  for (size_t i=0; i<this->present.size(); ++i)
+  {
+    if ( this->present[i] && pred( this->slot_value( this->slots[i] )))
+    {
+      return this->base + i;
+    }
+  }
+  return INVALID_ROW_HANDLE;
+}
+
+template< typename T >
+template< typename F >
+void
+element_column<T>
+::for_each( F f ) const
+{
+  if ( this->type == STORAGE_MAP )
+  {
+    for (typename std::map<oracle_entry_handle_type, T>::const_iterator i = this->values_map.begin();
+         i != this->values_map.end();
+         ++i )
+    {
+      f( i->first, i->second );
+    }
+    return;
+  }
+
+  for (size_t i=0; i<this->present.size(); ++i)
+  {
+    if ( this->present[i] )
+    {
+      f( this->base + i, this->slot_value( this->slots[i] ));
+    }
+  }
+}
+
+template< typename T >
+T&
+element_column<T>
+::dense_add( oracle_entry_handle_type h, const T& val )
+{
+  if ( this->present.empty() )
+  {
+    this->base = h;
+  }
+  else if ( h < this->base )
+  {
+    // extend the index down to h
+    size_t grow = this->base - h;
+    this->slots.insert( this->slots.begin(), grow, 0 );
+    this->present.insert( this->present.begin(), grow, false );
+    this->base = h;
+  }
+  size_t i = h - this->base;
+  if ( i >= this->present.size() )
+  {
+    this->slots.resize( i+1, 0 );
+    this->present.resize( i+1, false );
+  }
+
+  slot_type s;
+  if ( ! this->free_slots.empty() )
+  {
+    s = this->free_slots.back();
+    this->free_slots.pop_back();
+  }
+  else
+  {
+    if ( this->n_slots == std::numeric_limits< slot_type >::max() )
+    {
+      throw std::runtime_error( "Too many values for a dense track_oracle column" );
+    }
+    s = static_cast< slot_type >( this->n_slots++ );
+    if ( s / chunk_size == this->chunks.size() )
+    {
+      this->chunks.emplace_back( new T[ chunk_size ] );
+    }
+  }
+
+  this->slots[ i ] = s;
+  this->present[ i ] = true;
+  ++this->n_values;
+  T& ref = this->slot_value( s );
+  ref = val;
+  return ref;
+}
+
+template< typename T >
+void
+element_column<T>
+::dense_clear()
+{
+  this->base = 0;
+  this->slots.clear();
+  this->present.clear();
+  this->chunks.clear();
+  this->free_slots.clear();
+  this->n_slots = 0;
+  this->n_values = 0;
+}
+
+} // ...track_oracle
+} // ...kwiver
+
+#endif
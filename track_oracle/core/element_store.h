@@ -13,6 +13,7 @@
 
 #include <track_oracle/core/track_oracle_api_types.h>
 #include <track_oracle/core/element_store_base.h>
+#include <track_oracle/core/element_column.h>
 #include <track_oracle/core/kwiver_io_base.h>
 
 class TiXmlElement;
@@ -24,7 +25,7 @@ template< typename T >
 class element_store: public element_store_base
 {
 public:
-  explicit element_store( const element_descriptor& e );
+  explicit element_store( const element_descriptor& e, element_storage_type t = STORAGE_MAP );
   element_store( const element_descriptor& e, kwiver_io_base<T>* io_base );
   virtual ~element_store();
   void set_io_handler( kwiver_io_base<T>* io_base );
@@ -47,7 +48,13 @@ class element_store: public element_store_base
   virtual std::vector<std::string> csv_headers() const;
   virtual void set_to_default_value( const oracle_entry_handle_type& h );
 
-  std::map< oracle_entry_handle_type, T> storage;
+  virtual void write_binary( std::ostream& os, const std::vector< oracle_entry_handle_type >& rows ) const;
+  virtual bool read_binary( const char*& p, const char* end, const std::vector< oracle_entry_handle_type >& rows );
+
+  virtual element_storage_type get_storage_type() const;
+  virtual void set_storage_type( element_storage_type t );
+
+  element_column< T > storage;
   const T& get_default_value() const;
   void set_default_value( const T& val );
 
@@ -6,6 +6,8 @@
 
 #include <tinyxml.h>
 
+#include <track_oracle/core/element_binary_io.h>
+
 #include <vital/logger/logger.h>
 static kwiver::vital::logger_handle_t local_logger( kwiver::vital::get_logger( __FILE__ ) );
 
@@ -16,8 +18,8 @@ namespace track_oracle {
 
 template< typename T >
 element_store<T>
-::element_store( const element_descriptor& e )
-  : element_store_base( e ), default_value_ptr(0), io_base_ptr( new kwiver_io_base<T>( e.name ))
+::element_store( const element_descriptor& e, element_storage_type t )
+  : element_store_base( e ), storage( t ), default_value_ptr(0), io_base_ptr( new kwiver_io_base<T>( e.name ))
 {}
 
 template< typename T >
@@ -73,8 +75,7 @@ bool
 element_store<T>
 ::exists( const oracle_entry_handle_type& h ) const
 {
-  typename map<oracle_entry_handle_type, T>::const_iterator p = this->storage.find( h );
-  return (p != this->storage.end() );
+  return this->storage.exists( h );
 }
 
 template< typename T >
@@ -82,50 +83,7 @@ vector< bool >
 element_store<T>
 ::exists( const vector< oracle_entry_handle_type>& sorted_hlist ) const
 {
-  vector< bool > ret( sorted_hlist.size(), false );
-  if (sorted_hlist.empty())
-  {
-    return ret;
-  }
-
-  size_t ret_index(0), hlist_size( sorted_hlist.size() );
-  typename map<oracle_entry_handle_type, T>::const_iterator p = this->storage.lower_bound( sorted_hlist[0] );
-  typename map<oracle_entry_handle_type, T>::const_iterator e = this->storage.end();
-
-  bool keep_going = (p != e) && (ret_index < hlist_size);
-  while (keep_going)
-  {
-    //
-    // each time through the loop, we either
-    //
-    // 1) if p->first < sorted_hlist[ret_index], increment p
-    //
-    // or
-    //
-    // 2) if p->first == sorted_hlist[ret_index], set return flag and increment both
-    //
-    // or
-    //
-    // 3) if p->first > sorted_hlist[ret_index], increment ret_index
-
-    oracle_entry_handle_type left(p->first), right( sorted_hlist[ ret_index ]);
-    if (left < right)
-    {
-      keep_going = (++p != e);
-    }
-    else if (left == right)
-    {
-      ret[ ret_index ] = true;
-      keep_going = ((++p != e) && (++ret_index < hlist_size));
-    }
-    else
-    {
-      keep_going = (++ret_index < hlist_size);
-    }
-
-  }
-
-  return ret;
+  return this->storage.exists( sorted_hlist );
 }
 
 template< typename T>
@@ -145,10 +103,10 @@ ::copy_value( const oracle_entry_handle_type& src,
     return false;
   }
 
-  typename map<oracle_entry_handle_type, T>::iterator p = this->storage.find( src );
-  if ( p == this->storage.end() ) return false;
+  const T* p = this->storage.find( src );
+  if ( ! p ) return false;
 
-  this->storage.insert( make_pair( dst, p->second ));
+  this->storage.insert( dst, *p );
   return true;
 }
 
@@ -173,8 +131,7 @@ bool
 element_store<T>
 ::remove( const oracle_entry_handle_type& h )
 {
-  size_t c = this->storage.erase( h );
-  return (c != 0);
+  return this->storage.erase( h );
 }
 
 template< typename T >
@@ -182,10 +139,10 @@ ostream&
 element_store<T>
 ::emit_as_kwiver( ostream& os, const oracle_entry_handle_type& h, const string& indent ) const
 {
-  typename map<oracle_entry_handle_type, T>::const_iterator p = this->storage.find( h );
-  if ( p != this->storage.end() )
+  const T* p = this->storage.find( h );
+  if ( p )
   {
-    this->io_base_ptr->write_xml( os, indent, p->second );
+    this->io_base_ptr->write_xml( os, indent, *p );
   }
   return os;
 }
@@ -195,10 +152,10 @@ ostream&
 element_store<T>
 ::emit_as_csv( ostream& os, const oracle_entry_handle_type& h, bool emit_default_if_missing ) const
 {
-  typename map<oracle_entry_handle_type, T>::const_iterator p = this->storage.find( h );
-  if ( p != this->storage.end() )
+  const T* p = this->storage.find( h );
+  if ( p )
   {
-    this->io_base_ptr->to_csv( os, p->second );
+    this->io_base_ptr->to_csv( os, *p );
   }
   else
   {
@@ -229,7 +186,7 @@ ::read_kwiver_xml_to_row( const oracle_entry_handle_type& h, const TiXmlElement*
     LOG_ERROR( local_logger, "Couldn't parse instance of " << this->get_descriptor().name << " at row " << e->Row() );
     return false;
   }
-  this->storage[ h ] = val;
+  this->storage.set( h, val );
   return true;
 }
 
@@ -244,7 +201,7 @@ ::read_csv_to_row( const oracle_entry_handle_type& h, const map< string, string>
     LOG_ERROR( local_logger, "Couldn't parse instance of " << this->get_descriptor().name << " from CSV" );
     return false;
   }
-  this->storage[ h ] = val;
+  this->storage.set( h, val );
   return true;
 }
 
@@ -282,7 +239,76 @@ void
 element_store<T>
 ::set_to_default_value( const oracle_entry_handle_type& h )
 {
-  this->storage[ h ] = this->get_default_value();
+  this->storage.set( h, this->get_default_value() );
+}
+
+template< typename T >
+void
+element_store<T>
+::write_binary( ostream& os, const vector< oracle_entry_handle_type >& rows ) const
+{
+  vector< uint64_t > present;
+  for (size_t i=0; i<rows.size(); ++i)
+  {
+    if ( this->storage.exists( rows[i] )) present.push_back( i );
+  }
+
+  binary_io::write_pod< uint64_t >( os, present.size() );
+  for (size_t i=0; i<present.size(); ++i)
+  {
+    binary_io::write_pod( os, present[i] );
+    element_binary_io<T>::write( os, *this->storage.find( rows[ present[i] ] ), *this->io_base_ptr );
+  }
+}
+
+template< typename T >
+bool
+element_store<T>
+::read_binary( const char*& p, const char* end, const vector< oracle_entry_handle_type >& rows )
+{
+  uint64_t n;
+  if ( ! binary_io::read_pod( p, end, n )) return false;
+
+  size_t n_failed = 0;
+  for (uint64_t i=0; i<n; ++i)
+  {
+    uint64_t index;
+    T val = T();
+    bool ok;
+    if ( ( ! binary_io::read_pod( p, end, index )) || ( index >= rows.size() )) return false;
+    if ( ! element_binary_io<T>::read( p, end, val, *this->io_base_ptr, ok )) return false;
+    if ( ok )
+    {
+      this->storage.set( rows[ index ], val );
+    }
+    else
+    {
+      ++n_failed;
+    }
+  }
+
+  if ( n_failed > 0 )
+  {
+    LOG_WARN( local_logger, "Couldn't parse " << n_failed << " of " << n << " instances of "
+              << this->get_descriptor().name << " from a snapshot" );
+  }
+  return true;
+}
+
+template< typename T >
+element_storage_type
+element_store<T>
+::get_storage_type() const
+{
+  return this->storage.storage_type();
+}
+
+template< typename T >
+void
+element_store<T>
+::set_storage_type( element_storage_type t )
+{
+  this->storage.set_storage_type( t );
 }
 
 //
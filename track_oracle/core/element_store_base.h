@@ -8,6 +8,8 @@
 #include <vital/vital_config.h>
 #include <track_oracle/core/track_oracle_export.h>
 
+#include <boost/thread/shared_mutex.hpp>
+
 ///
 /// The base class for data columns in track_oracle.
 /// Serves several purposes:
@@ -16,9 +18,13 @@
 /// can be available without needing the type
 /// (3) Provides the XML output prototype
 /// (4) Provides the kwiver i/o interface
+/// (5) holds the reader/writer lock track_oracle_core takes around
+/// accesses to the column
+/// (6) Provides the binary snapshot i/o interface
 
 #include <track_oracle/core/track_oracle_api_types.h>
 #include <track_oracle/core/element_descriptor.h>
+#include <track_oracle/core/element_column.h>
 
 class  TiXmlElement;
 
@@ -33,6 +39,7 @@ class TRACK_ORACLE_EXPORT element_store_base
   virtual ~element_store_base();
 
   const element_descriptor& get_descriptor() const;
+  boost::shared_mutex& column_lock() const { return this->lock; }
   virtual bool exists( const track_handle_type& h ) const = 0;
   virtual bool exists( const frame_handle_type& h ) const = 0;
   virtual bool exists( const oracle_entry_handle_type& h ) const = 0;
@@ -46,12 +53,22 @@ class TRACK_ORACLE_EXPORT element_store_base
   virtual std::vector<std::string> csv_headers() const = 0;
   virtual void set_to_default_value( const oracle_entry_handle_type& h ) = 0;
 
+  // binary snapshot i/o: the values at rows, keyed by their index in rows;
+  // read_binary advances p and returns false if the data is malformed
+  virtual void write_binary( std::ostream& os, const std::vector< oracle_entry_handle_type >& rows ) const = 0;
+  virtual bool read_binary( const char*& p, const char* end, const std::vector< oracle_entry_handle_type >& rows ) = 0;
+
+  // map or dense storage of the values; see element_column.h
+  virtual element_storage_type get_storage_type() const = 0;
+  virtual void set_storage_type( element_storage_type t ) = 0;
+
   virtual bool remove( const track_handle_type& h ) = 0;
   virtual bool remove( const frame_handle_type& h ) = 0;
   virtual bool remove( const oracle_entry_handle_type& h ) = 0;
 
 private:
   element_descriptor d;
+  mutable boost::shared_mutex lock;
 };
 
 } // ...track_oracle
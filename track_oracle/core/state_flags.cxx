@@ -4,6 +4,8 @@
 
 #include "state_flags.h"
 
+#include <deque>
+#include <limits>
 #include <string>
 #include <sstream>
 #include <mutex>
@@ -19,6 +21,7 @@
 #include <vital/logger/logger.h>
 static kwiver::vital::logger_handle_t main_logger( kwiver::vital::get_logger( __FILE__ ) );
 
+using std::deque;
 using std::map;
 using std::string;
 using std::pair;
@@ -41,16 +44,27 @@ struct state_flags_backend
   string_index_map_t component_map;
   map< size_t, string_index_map_t > status_maps;
 
+  // the interned status vectors, with trailing zeros trimmed; a
+  // state_flag_type holds an index into flag_sets
+  deque< vector< size_t > > flag_sets;
+  map< vector< size_t >, uint32_t > flag_set_codes;
+
   state_flags_backend() :
     special_slot_zero_tag( "_invalid_component" )
   {
     component_map[ special_slot_zero_tag ] = 0;
+    flag_sets.push_back( vector< size_t >() );
+    flag_set_codes[ vector< size_t >() ] = 0;
   }
 
   static state_flags_backend& get_instance();
 
   pair< size_t, size_t > set_flag( const string& component, const string& status );
-  map< string, string > get_map( const vector< size_t >& data );
+
+  // the code of the flag set with the component at status (0 to clear it)
+  uint32_t set_status( uint32_t code, size_t component_index, size_t status_index );
+
+  map< string, string > get_map( uint32_t code );
 
 private:
   static state_flags_backend* impl;
@@ -106,13 +120,47 @@ ::set_flag( const string& component, const string& status )
   return make_pair( component_probe->second, status_probe->second );
 }
 
+uint32_t
+state_flags_backend
+::set_status( uint32_t code, size_t component_index, size_t status_index )
+{
+  std::lock_guard< std::mutex > lock( this->api_lock );
+
+  vector< size_t > data = this->flag_sets[ code ];
+  if ( component_index >= data.size() )
+  {
+    if ( status_index == 0 ) return code;
+    data.resize( component_index+1, 0 ); // 0 is always invalid
+  }
+  data[ component_index ] = status_index;
+  while ( ( ! data.empty() ) && ( data.back() == 0 ))
+  {
+    data.pop_back();
+  }
+
+  map< vector< size_t >, uint32_t >::const_iterator probe = this->flag_set_codes.find( data );
+  if ( probe != this->flag_set_codes.end() )
+  {
+    return probe->second;
+  }
+  if ( this->flag_sets.size() > std::numeric_limits< uint32_t >::max() )
+  {
+    throw runtime_error( "Too many distinct state flag sets" );
+  }
+  uint32_t new_code = static_cast< uint32_t >( this->flag_sets.size() );
+  this->flag_sets.push_back( data );
+  this->flag_set_codes[ data ] = new_code;
+  return new_code;
+}
+
 map< string, string >
 state_flags_backend
-::get_map( const vector<size_t>& data )
+::get_map( uint32_t code )
 {
   std::lock_guard< std::mutex > lock( api_lock );
 
   map< string, string > ret;
+  const vector< size_t >& data = this->flag_sets[ code ];
 
   for ( sim_cit component = this->component_map.begin();
         component != this->component_map.end();
@@ -186,22 +234,7 @@ ::set_flag( const string& component, const string& status )
 
   // both members of ci are indices; if ci = (5,7) that means data[5] == 7.
   pair< size_t, size_t > ci = state_flags_backend::get_instance().set_flag( component, status );
-
-  // expand vector if necessary
-  // n=3: [0 1 2] ;
-  // n' = 6: [0 1 2 3 4 5]  -> ci.first = 5; 5-3+1
-  // n=0: []
-  // n' = 1: [0] -> ci.first = 0; 0 - 0 +1
-  size_t n = this->data.size();
-  if ( ci.first >= n )
-  {
-    for (size_t i=0; i < ci.first-n+1; ++i)
-    {
-      this->data.push_back( 0 ); // 0 is always invalid
-    }
-  }
-
-  this->data[ ci.first ] = ci.second;
+  this->code = state_flags_backend::get_instance().set_status( this->code, ci.first, ci.second );
 }
 
 void
@@ -209,26 +242,14 @@ state_flag_type
 ::clear_flag( const string& component )
 {
   pair< size_t, size_t> ci = state_flags_backend::get_instance().set_flag( component, "" );
-  this->data[ ci.first ] = 0;
+  this->code = state_flags_backend::get_instance().set_status( this->code, ci.first, 0 );
 }
 
 map< string, string >
 state_flag_type
 ::get_flags() const
 {
-  return state_flags_backend::get_instance().get_map( this->data );
-}
-
-bool
-state_flag_type
-::operator==( const state_flag_type& rhs ) const
-{
-  if (this->data.size() != rhs.data.size()) return false;
-  for (size_t i=0; i<this->data.size(); ++i)
-  {
-    if (this->data[i] != rhs.data[i]) return false;
-  }
-  return true;
+  return state_flags_backend::get_instance().get_map( this->code );
 }
 
 ostream& operator<<( ostream& os, const state_flag_type& t )
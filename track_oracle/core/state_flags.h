@@ -32,12 +32,19 @@
 /// strings), the numeric values in the data term are irrelevant from
 /// session to session.
 ///
+/// Even the vector is more than most rows need, since a column typically
+/// holds a handful of distinct flag sets.  So the sidebar also interns
+/// the vectors themselves, and a state_flag_type is just the 32-bit code
+/// of its vector; code zero is no flags.  Setting or clearing a flag
+/// looks up the new vector's code, and two flag sets are equal exactly
+/// when their codes are.
 ///
 ///
 
 #include <vital/vital_config.h>
 #include <track_oracle/core/track_oracle_export.h>
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -52,13 +59,15 @@ namespace track_oracle {
 
 struct TRACK_ORACLE_EXPORT state_flag_type
 {
+  state_flag_type(): code( 0 ) {}
+
   void set_flag( const std::string& component, const std::string& status = "" );
   void clear_flag( const std::string& component );
   std::map< std::string, std::string > get_flags() const;
-  bool operator==( const state_flag_type& rhs ) const;
+  bool operator==( const state_flag_type& rhs ) const { return this->code == rhs.code; }
 
 private:
-  std::vector<size_t> data;
+  uint32_t code;
 };
 
 TRACK_ORACLE_EXPORT std::ostream& operator<<( std::ostream& os, const state_flag_type& t );
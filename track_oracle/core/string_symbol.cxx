@@ -0,0 +1,146 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "string_symbol.h"
+
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <boost/thread/shared_mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+using std::deque;
+using std::istream;
+using std::ostream;
+using std::string;
+using std::unordered_map;
+
+namespace // anon
+{
+
+//
+// The strings live in a deque, which doesn't move them as it grows, so
+// str() can hand out references; the map points back into it.
+//
+
+class symbol_table
+{
+public:
+  static symbol_table& get_instance();
+
+  uint32_t intern( const string& s );
+  const string& lookup( uint32_t code ) const;
+  size_t size() const;
+
+private:
+  symbol_table() { this->strings.push_back( "" ); this->codes[ "" ] = 0; }
+
+  typedef boost::shared_lock< boost::shared_mutex > read_lock;
+  typedef boost::unique_lock< boost::shared_mutex > write_lock;
+
+  mutable boost::shared_mutex lock;
+  deque< string > strings;
+  unordered_map< string, uint32_t > codes;
+};
+
+symbol_table&
+symbol_table
+::get_instance()
+{
+  // never destroyed, so symbols in static objects outlive it safely
+  static symbol_table* impl = new symbol_table();
+  return *impl;
+}
+
+uint32_t
+symbol_table
+::intern( const string& s )
+{
+  if ( s.empty() ) return 0;
+  {
+    read_lock r( this->lock );
+    unordered_map< string, uint32_t >::const_iterator p = this->codes.find( s );
+    if ( p != this->codes.end() ) return p->second;
+  }
+
+  write_lock w( this->lock );
+  unordered_map< string, uint32_t >::const_iterator p = this->codes.find( s );
+  if ( p != this->codes.end() ) return p->second;
+  if ( this->strings.size() > std::numeric_limits< uint32_t >::max() )
+  {
+    throw std::runtime_error( "string_symbol: symbol table is full" );
+  }
+  uint32_t code = static_cast< uint32_t >( this->strings.size() );
+  this->strings.push_back( s );
+  this->codes[ s ] = code;
+  return code;
+}
+
+const string&
+symbol_table
+::lookup( uint32_t code ) const
+{
+  read_lock r( this->lock );
+  return this->strings[ code ];
+}
+
+size_t
+symbol_table
+::size() const
+{
+  read_lock r( this->lock );
+  return this->strings.size();
+}
+
+} // anon
+
+namespace kwiver {
+namespace track_oracle {
+
+string_symbol
+::string_symbol( const string& s )
+  : code( symbol_table::get_instance().intern( s ))
+{}
+
+string_symbol
+::string_symbol( const char* s )
+  : code( symbol_table::get_instance().intern( s ))
+{}
+
+const string&
+string_symbol
+::str() const
+{
+  return symbol_table::get_instance().lookup( this->code );
+}
+
+size_t
+string_symbol
+::n_symbols()
+{
+  return symbol_table::get_instance().size();
+}
+
+ostream&
+operator<<( ostream& os, const string_symbol& s )
+{
+  os << s.str();
+  return os;
+}
+
+istream&
+operator>>( istream& is, string_symbol& s )
+{
+  string text;
+  if ( is >> text )
+  {
+    s = string_symbol( text );
+  }
+  return is;
+}
+
+} // ...track_oracle
+} // ...kwiver
@@ -0,0 +1,66 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef INCL_STRING_SYMBOL_H
+#define INCL_STRING_SYMBOL_H
+
+///
+/// A dictionary-encoded string, for columns drawing on a small vocabulary
+/// (track styles, source tags, activity names...) across many rows.
+///
+/// Each distinct string is stored once, in a process-wide symbol table,
+/// and a string_symbol holds only its 32-bit code in that table; code
+/// zero is the empty string.  Codes are assigned in order of first use
+/// and never reused, so they mean nothing from session to session, but
+/// within a session two symbols are equal exactly when their codes are:
+/// equality tests (and so track_field::lookup) are integer compares.
+///
+/// Reading and writing (CSV, XML, snapshots) go through the text, so files
+/// are the same as for a std::string column.
+///
+
+#include <vital/vital_config.h>
+#include <track_oracle/core/track_oracle_export.h>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+namespace kwiver {
+namespace track_oracle {
+
+class TRACK_ORACLE_EXPORT string_symbol
+{
+public:
+  string_symbol(): code( 0 ) {}
+  string_symbol( const std::string& s );
+  string_symbol( const char* s );
+
+  // the text; valid for the life of the process
+  const std::string& str() const;
+  operator const std::string&() const { return this->str(); }
+
+  uint32_t get_code() const { return this->code; }
+  bool empty() const { return this->code == 0; }
+
+  friend bool operator==( const string_symbol& lhs, const string_symbol& rhs ) { return lhs.code == rhs.code; }
+  friend bool operator!=( const string_symbol& lhs, const string_symbol& rhs ) { return lhs.code != rhs.code; }
+
+  // by code, not alphabetically
+  friend bool operator<( const string_symbol& lhs, const string_symbol& rhs ) { return lhs.code < rhs.code; }
+
+  // the number of distinct strings seen so far, including the empty string
+  static size_t n_symbols();
+
+private:
+  uint32_t code;
+};
+
+TRACK_ORACLE_EXPORT std::ostream& operator<<( std::ostream& os, const string_symbol& s );
+TRACK_ORACLE_EXPORT std::istream& operator>>( std::istream& is, string_symbol& s );
+
+} // ...track_oracle
+} // ...kwiver
+
+#endif
@@ -69,6 +69,55 @@ ::get_mutable_element_store_base( field_handle_type f )
   return track_oracle_core::get_instance().get_mutable_element_store_base( f );
 }
 
+element_storage_type
+track_oracle_core
+::get_default_storage_type()
+{
+  return track_oracle_core::get_instance().get_default_storage_type();
+}
+
+void
+track_oracle_core
+::set_default_storage_type( element_storage_type t )
+{
+  track_oracle_core::get_instance().set_default_storage_type( t );
+}
+
+element_storage_type
+track_oracle_core
+::get_storage_type( field_handle_type f )
+{
+  return track_oracle_core::get_instance().get_storage_type( f );
+}
+
+void
+track_oracle_core
+::set_storage_type( field_handle_type f, element_storage_type t )
+{
+  track_oracle_core::get_instance().set_storage_type( f, t );
+}
+
+void
+track_oracle_core
+::freeze()
+{
+  track_oracle_core::get_instance().freeze();
+}
+
+void
+track_oracle_core
+::thaw()
+{
+  track_oracle_core::get_instance().thaw();
+}
+
+bool
+track_oracle_core
+::is_frozen()
+{
+  return track_oracle_core::get_instance().is_frozen();
+}
+
 bool
 track_oracle_core
 ::field_has_row( oracle_entry_handle_type row, field_handle_type field )
@@ -253,6 +302,35 @@ ::clone_nonsystem_fields( const oracle_entry_handle_type& src,
   return track_oracle_core::get_instance().clone_nonsystem_fields( src, dst );
 }
 
+frame_handle_list_type
+track_oracle_core
+::lookup_frames( field_handle_type time_field,
+                 unsigned long long t_begin,
+                 unsigned long long t_end )
+{
+  return track_oracle_core::get_instance().lookup_frames( time_field, t_begin, t_end,
+                                                          INVALID_FIELD_HANDLE, vgl_box_2d< double >() );
+}
+
+frame_handle_list_type
+track_oracle_core
+::lookup_frames( field_handle_type box_field,
+                 const vgl_box_2d< double >& box )
+{
+  return track_oracle_core::get_instance().lookup_frames( INVALID_FIELD_HANDLE, 0, 0, box_field, box );
+}
+
+frame_handle_list_type
+track_oracle_core
+::lookup_frames( field_handle_type time_field,
+                 unsigned long long t_begin,
+                 unsigned long long t_end,
+                 field_handle_type box_field,
+                 const vgl_box_2d< double >& box )
+{
+  return track_oracle_core::get_instance().lookup_frames( time_field, t_begin, t_end, box_field, box );
+}
+
 bool
 track_oracle_core
 ::write_kwiver( ostream& os, const track_handle_list_type& tracks )
@@ -260,6 +338,20 @@ ::write_kwiver( ostream& os, const track_handle_list_type& tracks )
   return track_oracle_core::get_instance().write_kwiver( os, tracks );
 }
 
+bool
+track_oracle_core
+::write_snapshot( ostream& os, const track_handle_list_type& tracks )
+{
+  return track_oracle_core::get_instance().write_snapshot( os, tracks );
+}
+
+bool
+track_oracle_core
+::read_snapshot( const char* data, size_t size, track_handle_list_type& tracks )
+{
+  return track_oracle_core::get_instance().read_snapshot( data, size, tracks );
+}
+
 bool
 track_oracle_core
 ::write_csv( ostream& os, const track_handle_list_type& tracks, bool csv_v1_semantics )
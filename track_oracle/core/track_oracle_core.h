@@ -15,6 +15,9 @@
 
 #include <track_oracle/core/track_oracle_api_types.h>
 #include <track_oracle/core/element_descriptor.h>
+#include <track_oracle/core/element_column.h>
+
+#include <vgl/vgl_box_2d.h>
 
 namespace kwiver {
 namespace track_oracle {
@@ -46,6 +49,34 @@ class TRACK_ORACLE_EXPORT track_oracle_core
   static element_store_base* get_mutable_element_store_base( field_handle_type f );
   template< typename T > static field_handle_type create_element( const element_descriptor& e );
 
+  //
+  // storage of the data columns: STORAGE_MAP or STORAGE_DENSE (see element_column.h.)
+  // The default applies to the columns created after it is set; setting the
+  // storage of an existing column moves its values and invalidates references
+  // to them.
+  //
+
+  static element_storage_type get_default_storage_type();
+  static void set_default_storage_type( element_storage_type t );
+  static element_storage_type get_storage_type( field_handle_type f );
+  static void set_storage_type( field_handle_type f, element_storage_type t );
+
+  //
+  // Once the data is loaded, freeze() makes the oracle read-only: reads no
+  // longer take any locks, and any call adding, changing or removing a
+  // value (including get_field() on a row without a value) throws until
+  // thaw() is called.  Domains may still be created while frozen.
+  //
+  // Each column has its own reader/writer lock, so threads working on
+  // different fields don't wait on each other.  The locks guard the
+  // columns, not the values: the caller orders writes through the
+  // reference returned by get_field() against other readers of that value.
+  //
+
+  static void freeze();
+  static void thaw();
+  static bool is_frozen();
+
   static bool field_has_row( oracle_entry_handle_type row, field_handle_type field );
   template< typename T > static T& get_field( oracle_entry_handle_type track, field_handle_type field );
   template< typename T > static oracle_entry_handle_type lookup( field_handle_type field, const T& val, domain_handle_type domain );
@@ -72,12 +103,46 @@ class TRACK_ORACLE_EXPORT track_oracle_core
   static handle_list_type frame_to_generic_handle_list( const frame_handle_list_type& handles );
 
   static frame_handle_list_type get_frames( const track_handle_type& t );
+
+  //
+  // The frames of any track, sorted by handle, whose time_field value
+  // (an unsigned or unsigned long long column, e.g. timestamp_usecs or
+  // frame_number) is in [t_begin, t_end], and / or whose box_field box
+  // (a vgl_box_2d<double> column, e.g. bounding_box) intersects box.
+  //
+  // The queries use a sorted index over the time column and a grid over
+  // the box column.  While frozen, each index is built on first use and
+  // kept until thaw(); otherwise, each call builds the indices it needs.
+  //
+
+  static frame_handle_list_type lookup_frames( field_handle_type time_field,
+                                               unsigned long long t_begin,
+                                               unsigned long long t_end );
+  static frame_handle_list_type lookup_frames( field_handle_type box_field,
+                                               const vgl_box_2d< double >& box );
+  static frame_handle_list_type lookup_frames( field_handle_type time_field,
+                                               unsigned long long t_begin,
+                                               unsigned long long t_end,
+                                               field_handle_type box_field,
+                                               const vgl_box_2d< double >& box );
   static void set_frames( const track_handle_type& t, const frame_handle_list_type& f );
   static size_t get_n_frames( const track_handle_type& t );
 
   static bool write_kwiver( std::ostream& os, const track_handle_list_type& tracks );
   static bool write_csv( std::ostream& os, const track_handle_list_type& tracks, bool csv_v1_semantics = false );
 
+  //
+  // A snapshot is the tracks' non-system columns in a binary layout which
+  // loads without parsing text, for example from a memory-mapped file
+  // shared by several processes.  Columns missing from the oracle are
+  // created if a column of the same type has been created, and skipped
+  // otherwise.  Snapshots aren't portable across byte order or compilers
+  // (columns are matched by their typeid strings.)
+  //
+
+  static bool write_snapshot( std::ostream& os, const track_handle_list_type& tracks );
+  static bool read_snapshot( const char* data, size_t size, track_handle_list_type& tracks );
+
   static csv_handler_map_type get_csv_handler_map( const std::vector< std::string >& headers );
 
   static bool clone_nonsystem_fields( const track_handle_type& src,
@@ -7,14 +7,20 @@
 #include <stdexcept>
 #include <limits>
 #include <algorithm>
+#include <iterator>
 
 #include <typeinfo>
+#include <cstring>
+#include <sstream>
 
 #include <vul/vul_timer.h>
 #include <vul/vul_sprintf.h>
 
 #include <vgl/vgl_box_2d.h>
 
+#include <track_oracle/core/element_binary_io.h>
+#include <track_oracle/core/track_oracle_frame_index.h>
+
 #include <vital/logger/logger.h>
 static kwiver::vital::logger_handle_t main_logger( kwiver::vital::get_logger( __FILE__ ) );
 
@@ -119,7 +125,8 @@ namespace track_oracle {
 
 track_oracle_core_impl
 ::track_oracle_core_impl()
-  : field_count(0), row_count(1000), last_domain_allocated( DOMAIN_ALL )
+  : field_count(0), row_count(1000), last_domain_allocated( DOMAIN_ALL ),
+    default_storage_type( STORAGE_MAP ), frozen( false )
 {
   // create some system tables: __parent_track, __frame_list
   {
@@ -141,11 +148,83 @@ ::track_oracle_core_impl()
   }
 }
 
+track_oracle_core_impl::read_lock
+track_oracle_core_impl
+::lock_for_reading( rw_mutex& m ) const
+{
+  return
+    this->frozen
+    ? read_lock( m, boost::defer_lock )
+    : read_lock( m );
+}
+
+track_oracle_core_impl::write_lock
+track_oracle_core_impl
+::lock_for_writing( rw_mutex& m, const char* what ) const
+{
+  if ( this->frozen )
+  {
+    throw runtime_error( string( "track_oracle is frozen; can't " ) + what );
+  }
+  return write_lock( m );
+}
+
+vector< track_oracle_core_impl::read_lock >
+track_oracle_core_impl
+::lock_columns_for_reading() const
+{
+  vector< read_lock > locks;
+  if ( ! this->frozen )
+  {
+    locks.reserve( this->element_pool.size() );
+    for (auto const& p: this->element_pool)
+    {
+      locks.emplace_back( p.second->column_lock() );
+    }
+  }
+  return locks;
+}
+
+void
+track_oracle_core_impl
+::freeze()
+{
+  write_lock pool( this->pool_lock );
+  if ( this->frozen ) return;
+
+  // wait for the changes in flight; they can't start again once frozen
+  // is set because they all take the pool lock first
+  for (auto const& p: this->element_pool)
+  {
+    write_lock column( p.second->column_lock() );
+  }
+  this->frozen = true;
+}
+
+void
+track_oracle_core_impl
+::thaw()
+{
+  write_lock pool( this->pool_lock );
+  this->frozen = false;
+
+  std::lock_guard< std::mutex > indices( this->index_lock );
+  this->time_indices.clear();
+  this->box_indices.clear();
+}
+
+bool
+track_oracle_core_impl
+::is_frozen() const
+{
+  return this->frozen;
+}
+
 vector< field_handle_type >
 track_oracle_core_impl
 ::get_all_field_handles() const
 {
- std::lock_guard< std::mutex > lock( this->api_lock );
+ read_lock pool( this->lock_for_reading( this->pool_lock ));
  vector< field_handle_type > ret;
  for (auto const& p: this->name_pool)
  {
@@ -170,7 +249,7 @@ field_handle_type
 track_oracle_core_impl
 ::lookup_by_name( const string& name ) const
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
   return this->unlocked_lookup_by_name( name );
 }
 
@@ -183,11 +262,35 @@ ::lookup_required_field( const string& fn ) const
   return probe->second;
 }
 
+field_handle_type
+track_oracle_core_impl
+::unlocked_create_element( const element_descriptor& e, column_factory_type make_store )
+{
+  // first double-check the name is available
+  field_handle_type f = this->unlocked_lookup_by_name( e.name );
+  if (f != INVALID_FIELD_HANDLE)
+  {
+    ostringstream oss;
+    oss << "Duplicate creation of field named '" << e.name << "'\n";
+    throw runtime_error( oss.str() );
+  }
+
+  // create entry in name pool; assign field handle
+  f = ++this->field_count;
+  this->name_pool[ e.name ] = f;
+  // create entry in element pool
+  this->element_pool[ f ] = make_store( e, this->default_storage_type );
+  this->column_factories[ e.typeid_str ] = make_store;
+
+  // all done
+  return f;
+}
+
 element_descriptor
 track_oracle_core_impl
 ::get_element_descriptor( field_handle_type f ) const
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
   map< field_handle_type, element_store_base* >::const_iterator probe = this->element_pool.find( f );
   return
     ( probe != this->element_pool.end() )
@@ -199,7 +302,7 @@ const element_store_base*
 track_oracle_core_impl
 ::get_element_store_base( field_handle_type f ) const
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
   map< field_handle_type, element_store_base* >::const_iterator probe = this->element_pool.find( f );
   return
     ( probe != this->element_pool.end() )
@@ -211,7 +314,7 @@ element_store_base*
 track_oracle_core_impl
 ::get_mutable_element_store_base( field_handle_type f ) const
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
   map< field_handle_type, element_store_base* >::const_iterator probe = this->element_pool.find( f );
   return
     ( probe != this->element_pool.end() )
@@ -219,6 +322,51 @@ ::get_mutable_element_store_base( field_handle_type f ) const
     : 0;
 }
 
+element_storage_type
+track_oracle_core_impl
+::get_default_storage_type() const
+{
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  return this->default_storage_type;
+}
+
+void
+track_oracle_core_impl
+::set_default_storage_type( element_storage_type t )
+{
+  // only read when creating columns, which can't happen while frozen
+  write_lock pool( this->pool_lock );
+  this->default_storage_type = t;
+}
+
+element_storage_type
+track_oracle_core_impl
+::get_storage_type( field_handle_type f ) const
+{
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  map< field_handle_type, element_store_base* >::const_iterator probe = this->element_pool.find( f );
+  if ( probe == this->element_pool.end() )
+  {
+    throw runtime_error( "get_storage_type: no such field" );
+  }
+  read_lock column( this->lock_for_reading( probe->second->column_lock() ));
+  return probe->second->get_storage_type();
+}
+
+void
+track_oracle_core_impl
+::set_storage_type( field_handle_type f, element_storage_type t )
+{
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  map< field_handle_type, element_store_base* >::const_iterator probe = this->element_pool.find( f );
+  if ( probe == this->element_pool.end() )
+  {
+    throw runtime_error( "set_storage_type: no such field" );
+  }
+  write_lock column( this->lock_for_writing( probe->second->column_lock(), "set_storage_type" ));
+  probe->second->set_storage_type( t );
+}
+
 bool
 track_oracle_core_impl
 ::unlocked_field_has_row( oracle_entry_handle_type row, field_handle_type field ) const
@@ -229,6 +377,7 @@ ::unlocked_field_has_row( oracle_entry_handle_type row, field_handle_type field
   {
     throw runtime_error( "Attempted field_has_row on non-existent field" );
   }
+  read_lock column( this->lock_for_reading( probe->second->column_lock() ));
   return probe->second->exists( row );
 }
 
@@ -236,7 +385,7 @@ bool
 track_oracle_core_impl
 ::field_has_row( oracle_entry_handle_type row, field_handle_type field )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
   return this->unlocked_field_has_row( row, field );
 }
 
@@ -244,12 +393,13 @@ vector< field_handle_type >
 track_oracle_core_impl
 ::fields_at_row( oracle_entry_handle_type row ) const
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
   vector< field_handle_type > ret;
   for (map< field_handle_type, element_store_base* >::const_iterator i = this->element_pool.begin();
        i != this->element_pool.end();
        ++i)
   {
+    read_lock column( this->lock_for_reading( i->second->column_lock() ));
     if (i->second->exists( row ))
     {
       ret.push_back( i->first );
@@ -262,7 +412,7 @@ vector< vector< field_handle_type > >
 track_oracle_core_impl
 ::fields_at_rows( const vector<oracle_entry_handle_type>& rows ) const
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
   vector< vector< field_handle_type > > ret( rows.size() );
 
   vector< oracle_entry_handle_type > sorted_rows( rows );
@@ -272,6 +422,7 @@ ::fields_at_rows( const vector<oracle_entry_handle_type>& rows ) const
        i != this->element_pool.end();
        ++i)
   {
+    read_lock column( this->lock_for_reading( i->second->column_lock() ));
     auto exists_list = i->second->exists( rows );
     for (size_t j=0; j<exists_list.size(); ++j)
     {
@@ -288,7 +439,6 @@ oracle_entry_handle_type
 track_oracle_core_impl
 ::get_next_handle()
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
   return ++this->row_count;
 }
 
@@ -296,7 +446,7 @@ handle_list_type
 track_oracle_core_impl
 ::get_domain( domain_handle_type domain )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock domains( this->domain_lock );
   handle_list_type ret;
 
   //
@@ -328,7 +478,7 @@ domain_handle_type
 track_oracle_core_impl
 ::lookup_domain( const string& domain_name, bool create_if_not_found )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  write_lock domains( this->domain_lock );
   map< string, domain_handle_type >::iterator probe =  this->domain_names.find( domain_name );
 
   // return if found
@@ -348,7 +498,7 @@ domain_handle_type
 track_oracle_core_impl
 ::create_domain( )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  write_lock domains( this->domain_lock );
   // pre-incrementing ensures that DOMAIN_ALL can never be allocated
   domain_handle_type h = ++this->last_domain_allocated;
   this->domain_names[ vul_sprintf("anon_domain_%d", static_cast<int>( h )) ] = h;
@@ -361,7 +511,7 @@ domain_handle_type
 track_oracle_core_impl
 ::create_domain( const handle_list_type& handles )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  write_lock domains( this->domain_lock );
   // pre-incrementing ensures that DOMAIN_ALL can never be allocated
   domain_handle_type h = ++this->last_domain_allocated;
   this->domain_names[ vul_sprintf("anon_domain_%d", static_cast<int>( h )) ] = h;
@@ -377,6 +527,7 @@ ::unlocked_remove_row( oracle_entry_handle_type row )
        i != this->element_pool.end();
        ++i)
   {
+    write_lock column( this->lock_for_writing( i->second->column_lock(), "remove a row" ));
     i->second->remove( row );
   }
 }
@@ -385,7 +536,7 @@ bool
 track_oracle_core_impl
 ::is_domain_defined( const domain_handle_type& domain )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock domains( this->domain_lock );
 
   return (this->domain_pool.find( domain ) != this->domain_pool.end() );
 }
@@ -394,7 +545,12 @@ bool
 track_oracle_core_impl
 ::release_domain( const domain_handle_type& domain )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  if ( this->frozen )
+  {
+    throw runtime_error( "track_oracle is frozen; can't release_domain" );
+  }
+  write_lock domains( this->domain_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
 
   map< domain_handle_type, handle_list_type >::iterator probe = this->domain_pool.find( domain );
   if (probe == this->domain_pool.end())
@@ -405,23 +561,24 @@ ::release_domain( const domain_handle_type& domain )
 
   field_handle_type flh = this->unlocked_lookup_by_name( "__frame_list" );
   if ( flh == INVALID_FIELD_HANDLE ) throw runtime_error( "Lost __frame_list" );
-  const pair< map< oracle_entry_handle_type, frame_handle_list_type >*, frame_handle_list_type >& frame_list_lookup
-    = this->lookup_table< frame_handle_list_type >( flh );
-  const map<oracle_entry_handle_type, frame_handle_list_type>& frame_lists = *frame_list_lookup.first;
+  const element_store< frame_handle_list_type >* frame_list_store
+    = this->lookup_store< frame_handle_list_type >( flh );
+  const element_column< frame_handle_list_type >& frame_lists = frame_list_store->storage;
 
   handle_list_type rows_to_delete;
 
   // get the list of handles to be deleted
   handle_list_type handles = this->domain_pool[ domain ];
 
+  read_lock frame_list_lock( this->lock_for_reading( frame_list_store->column_lock() ));
   for (size_t i=0; i<handles.size(); ++i)
   {
     rows_to_delete.push_back( handles[i] );
     // get the frame list (if any)
-    map< oracle_entry_handle_type, frame_handle_list_type >::const_iterator frame_probe = frame_lists.find( handles[i] );
-    if (frame_probe != frame_lists.end() )
+    const frame_handle_list_type* frame_probe = frame_lists.find( handles[i] );
+    if ( frame_probe )
     {
-      const frame_handle_list_type& frames = frame_probe->second;
+      const frame_handle_list_type& frames = *frame_probe;
       for (size_t j=0; j<frames.size(); ++j)
       {
         rows_to_delete.push_back( frames[j].row );
@@ -429,6 +586,8 @@ ::release_domain( const domain_handle_type& domain )
     }
   }
 
+  frame_list_lock.unlock();
+
   // erase them
   for (size_t i=0; i<rows_to_delete.size(); ++i)
   {
@@ -456,7 +615,7 @@ bool
 track_oracle_core_impl
 ::add_to_domain( const handle_list_type& handles, const domain_handle_type& domain )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  write_lock domains( this->domain_lock );
   map< domain_handle_type, handle_list_type >::iterator i = domain_pool.find( domain );
   if ( i == domain_pool.end() ) return false;
   i->second.insert( i->second.end(), handles.begin(), handles.end() );
@@ -467,7 +626,7 @@ bool
 track_oracle_core_impl
 ::add_to_domain( const track_handle_type& track, const domain_handle_type& domain )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  write_lock domains( this->domain_lock );
   map< domain_handle_type, handle_list_type >::iterator i = domain_pool.find( domain );
   if ( i == domain_pool.end() ) return false;
   i->second.push_back( track.row );
@@ -478,7 +637,7 @@ bool
 track_oracle_core_impl
 ::set_domain( const handle_list_type& handles, domain_handle_type domain )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  write_lock domains( this->domain_lock );
   map< domain_handle_type, handle_list_type >::iterator i = domain_pool.find( domain );
   if ( i == domain_pool.end() ) return false;
   i->second = handles;
@@ -487,16 +646,24 @@ ::set_domain( const handle_list_type& handles, domain_handle_type domain )
 
 frame_handle_list_type
 track_oracle_core_impl
-::unlocked_get_frames( const track_handle_type& t )
+::unlocked_get_frames( const track_handle_type& t ) const
 {
-  return this->unlocked_get_field<frame_handle_list_type>( t.row, this->lookup_required_field( "__frame_list" ));
+  const element_store< frame_handle_list_type >* es_ptr
+    = this->lookup_store< frame_handle_list_type >( this->lookup_required_field( "__frame_list" ));
+  const frame_handle_list_type* frames = es_ptr->storage.find( t.row );
+  return
+    frames
+    ? *frames
+    : frame_handle_list_type();
 }
 
 frame_handle_list_type
 track_oracle_core_impl
 ::get_frames( const track_handle_type& t )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  const element_store_base* es_ptr = this->element_pool.at( this->lookup_required_field( "__frame_list" ));
+  read_lock column( this->lock_for_reading( es_ptr->column_lock() ));
   return this->unlocked_get_frames( t );
 }
 
@@ -504,16 +671,150 @@ void
 track_oracle_core_impl
 ::set_frames( const track_handle_type& t, const frame_handle_list_type& frames )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
-  this->unlocked_get_field< frame_handle_list_type >( t.row, this->lookup_required_field( "__frame_list" )) = frames;
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  element_store< frame_handle_list_type >* es_ptr
+    = this->lookup_store< frame_handle_list_type >( this->lookup_required_field( "__frame_list" ));
+  write_lock column( this->lock_for_writing( es_ptr->column_lock(), "set_frames" ));
+  es_ptr->storage.set( t.row, frames );
+}
+
+namespace // anon
+{
+
+// append the (value, row) pairs of the frame rows of the column, if it
+// holds T; false if it doesn't
+template< typename T, typename V >
+bool
+collect_frame_values( const element_store_base* b,
+                      const element_column< oracle_entry_handle_type >& parent_tracks,
+                      vector< pair< V, oracle_entry_handle_type > >& entries )
+{
+  const element_store< T >* es = dynamic_cast< const element_store< T >* >( b );
+  if ( ! es ) return false;
+  es->storage.for_each(
+    [&]( oracle_entry_handle_type row, const T& val )
+    {
+      if ( parent_tracks.exists( row )) entries.push_back( make_pair( V( val ), row ));
+    } );
+  return true;
+}
+
+} // anon
+
+std::shared_ptr< const frame_time_index >
+track_oracle_core_impl
+::get_time_index( field_handle_type f )
+{
+  const bool cached = this->frozen;
+  std::unique_lock< std::mutex > indices;
+  if ( cached )
+  {
+    indices = std::unique_lock< std::mutex >( this->index_lock );
+    auto probe = this->time_indices.find( f );
+    if ( probe != this->time_indices.end() ) return probe->second;
+  }
+
+  map< field_handle_type, element_store_base* >::const_iterator probe = this->element_pool.find( f );
+  if ( probe == this->element_pool.end() ) throw runtime_error( "lookup_frames: no such time field" );
+  const element_store< oracle_entry_handle_type >* parents =
+    this->lookup_store< oracle_entry_handle_type >( this->lookup_required_field( "__parent_track" ));
+  read_lock column( this->lock_for_reading( probe->second->column_lock() ));
+  read_lock parents_column( this->lock_for_reading( parents->column_lock() ));
+
+  vector< frame_time_index::entry_type > entries;
+  if ( ( ! collect_frame_values< unsigned long long >( probe->second, parents->storage, entries )) &&
+       ( ! collect_frame_values< unsigned >( probe->second, parents->storage, entries )))
+  {
+    throw runtime_error( "lookup_frames: time field '" + probe->second->get_descriptor().name +
+                         "' is neither unsigned nor unsigned long long" );
+  }
+
+  std::shared_ptr< const frame_time_index > index = std::make_shared< const frame_time_index >( std::move( entries ));
+  if ( cached ) this->time_indices[ f ] = index;
+  return index;
+}
+
+std::shared_ptr< const frame_box_grid >
+track_oracle_core_impl
+::get_box_index( field_handle_type f )
+{
+  const bool cached = this->frozen;
+  std::unique_lock< std::mutex > indices;
+  if ( cached )
+  {
+    indices = std::unique_lock< std::mutex >( this->index_lock );
+    auto probe = this->box_indices.find( f );
+    if ( probe != this->box_indices.end() ) return probe->second;
+  }
+
+  map< field_handle_type, element_store_base* >::const_iterator probe = this->element_pool.find( f );
+  if ( probe == this->element_pool.end() ) throw runtime_error( "lookup_frames: no such box field" );
+  const element_store< oracle_entry_handle_type >* parents =
+    this->lookup_store< oracle_entry_handle_type >( this->lookup_required_field( "__parent_track" ));
+  read_lock column( this->lock_for_reading( probe->second->column_lock() ));
+  read_lock parents_column( this->lock_for_reading( parents->column_lock() ));
+
+  vector< frame_box_grid::entry_type > entries;
+  if ( ! collect_frame_values< vgl_box_2d< double > >( probe->second, parents->storage, entries ))
+  {
+    throw runtime_error( "lookup_frames: box field '" + probe->second->get_descriptor().name +
+                         "' is not a vgl_box_2d<double>" );
+  }
+
+  std::shared_ptr< const frame_box_grid > index = std::make_shared< const frame_box_grid >( entries );
+  if ( cached ) this->box_indices[ f ] = index;
+  return index;
+}
+
+frame_handle_list_type
+track_oracle_core_impl
+::lookup_frames( field_handle_type time_field,
+                 unsigned long long t_begin,
+                 unsigned long long t_end,
+                 field_handle_type box_field,
+                 const vgl_box_2d< double >& box )
+{
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+
+  vector< oracle_entry_handle_type > rows;
+  if ( time_field != INVALID_FIELD_HANDLE )
+  {
+    rows = this->get_time_index( time_field )->rows_in( t_begin, t_end );
+  }
+  if ( box_field != INVALID_FIELD_HANDLE )
+  {
+    vector< oracle_entry_handle_type > in_box = this->get_box_index( box_field )->rows_intersecting( box );
+    if ( time_field == INVALID_FIELD_HANDLE )
+    {
+      rows.swap( in_box );
+    }
+    else
+    {
+      vector< oracle_entry_handle_type > both;
+      std::set_intersection( rows.begin(), rows.end(), in_box.begin(), in_box.end(), std::back_inserter( both ));
+      rows.swap( both );
+    }
+  }
+
+  frame_handle_list_type ret;
+  ret.reserve( rows.size() );
+  for (size_t i=0; i<rows.size(); ++i)
+  {
+    ret.push_back( frame_handle_type( rows[i] ));
+  }
+  return ret;
 }
 
 size_t
 track_oracle_core_impl
 ::get_n_frames( const track_handle_type& t )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
-  return this->unlocked_get_field< frame_handle_list_type >( t.row, this->lookup_required_field( "__frame_list" )).size();
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  const element_store< frame_handle_list_type >* es_ptr
+    = this->lookup_store< frame_handle_list_type >( this->lookup_required_field( "__frame_list" ));
+  read_lock column( this->lock_for_reading( es_ptr->column_lock() ));
+  const frame_handle_list_type* frames = es_ptr->storage.find( t.row );
+  return frames ? frames->size() : 0;
 }
 
 bool
@@ -532,7 +833,7 @@ ::clone_nonsystem_fields( const oracle_entry_handle_type& src,
     return false;
   }
 
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
   bool all_okay = true;
   for ( map< field_handle_type, element_store_base* >::iterator i = this->element_pool.begin();
         i != this->element_pool.end();
@@ -540,7 +841,11 @@ ::clone_nonsystem_fields( const oracle_entry_handle_type& src,
   {
     const element_descriptor& ed = i->second->get_descriptor();
     if ( ed.role == element_descriptor::SYSTEM ) continue;
-    if ( ! i->second->exists( src )) continue;
+    {
+      read_lock column( this->lock_for_reading( i->second->column_lock() ));
+      if ( ! i->second->exists( src )) continue;
+    }
+    write_lock column( this->lock_for_writing( i->second->column_lock(), "clone_nonsystem_fields" ));
     all_okay &= i->second->copy_value( src, dst );
   }
   return all_okay;
@@ -606,9 +911,9 @@ ::emit_pool_as_csv( ostream& os,
         map< field_handle_type, element_store_base* >::const_iterator pt_probe = this->element_pool.find( pt_fh );
         element_store<oracle_entry_handle_type>* es_ptr = dynamic_cast< element_store<oracle_entry_handle_type>*>( pt_probe->second );
         if ( ! es_ptr ) throw runtime_error ("Bad column cast looking for external id" );
-        map< oracle_entry_handle_type, oracle_entry_handle_type >::const_iterator pt_row_probe = es_ptr->storage.find( row );
-        if ( pt_row_probe == es_ptr->storage.end() ) throw runtime_error( "Frame has no parent track?" );
-        emitted_row = pt_row_probe->second;
+        const oracle_entry_handle_type* pt_row_probe = es_ptr->storage.find( row );
+        if ( ! pt_row_probe ) throw runtime_error( "Frame has no parent track?" );
+        emitted_row = *pt_row_probe;
       }
 
       p->second->emit_as_csv( os, emitted_row, output_order[i].emit_default_if_absent );
@@ -627,7 +932,8 @@ bool
 track_oracle_core_impl
 ::write_kwiver( ostream& os, const track_handle_list_type& tracks )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  vector< read_lock > columns( this->lock_columns_for_reading() );
   os << "<kwiver>\n"
      << "<!--\n"
      << "  File of " << tracks.size() << " tracks emitted by track_oracle's kwiver writer\n"
@@ -663,6 +969,242 @@ ::write_kwiver( ostream& os, const track_handle_list_type& tracks )
   return true;
 }
 
+//
+// Snapshot layout (host byte order; counts and lengths are uint64_t,
+// strings are a length and then the bytes):
+//
+// "KWTOSNAP", uint32_t version, uint32_t byte order mark
+// number of tracks, number of frames, and the frame count of each track
+// number of columns, and then for each column:
+//   name, description, typeid string, uint32_t role, byte count,
+//   and the values (element_store_base::write_binary)
+//
+// Values are keyed by their row's index in the snapshot: tracks first,
+// then the frames of each track in order.  The SYSTEM columns aren't
+// written; the reader recreates them from the frame counts.
+//
+
+namespace // anon
+{
+
+const char snapshot_magic[] = "KWTOSNAP";
+const size_t snapshot_magic_len = 8;
+const uint32_t snapshot_version = 1;
+const uint32_t snapshot_byte_order_mark = 0x01020304;
+
+struct snapshot_column
+{
+  element_descriptor ed;
+  const char* begin;
+  const char* end;
+};
+
+} // anon
+
+bool
+track_oracle_core_impl
+::write_snapshot( ostream& os, const track_handle_list_type& tracks )
+{
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  vector< read_lock > columns( this->lock_columns_for_reading() );
+
+  vector< oracle_entry_handle_type > rows;
+  vector< uint64_t > n_frames;
+  for (size_t i=0; i<tracks.size(); ++i)
+  {
+    rows.push_back( tracks[i].row );
+  }
+  for (size_t i=0; i<tracks.size(); ++i)
+  {
+    frame_handle_list_type frames = this->unlocked_get_frames( tracks[i] );
+    n_frames.push_back( frames.size() );
+    for (size_t j=0; j<frames.size(); ++j)
+    {
+      rows.push_back( frames[j].row );
+    }
+  }
+
+  binary_io::write_bytes( os, snapshot_magic, snapshot_magic_len );
+  binary_io::write_pod( os, snapshot_version );
+  binary_io::write_pod( os, snapshot_byte_order_mark );
+  binary_io::write_pod< uint64_t >( os, tracks.size() );
+  binary_io::write_pod< uint64_t >( os, rows.size() - tracks.size() );
+  for (size_t i=0; i<n_frames.size(); ++i)
+  {
+    binary_io::write_pod( os, n_frames[i] );
+  }
+
+  vector< const element_store_base* > stores;
+  for (map< field_handle_type, element_store_base* >::const_iterator i = this->element_pool.begin();
+       i != this->element_pool.end();
+       ++i)
+  {
+    if ( i->second->get_descriptor().role != element_descriptor::SYSTEM ) stores.push_back( i->second );
+  }
+
+  binary_io::write_pod< uint64_t >( os, stores.size() );
+  for (size_t i=0; i<stores.size(); ++i)
+  {
+    const element_descriptor& ed = stores[i]->get_descriptor();
+    ostringstream values;
+    stores[i]->write_binary( values, rows );
+
+    binary_io::write_string( os, ed.name );
+    binary_io::write_string( os, ed.description );
+    binary_io::write_string( os, ed.typeid_str );
+    binary_io::write_pod< uint32_t >( os, ed.role );
+    binary_io::write_string( os, values.str() );
+  }
+
+  return static_cast< bool >( os );
+}
+
+bool
+track_oracle_core_impl
+::read_snapshot( const char* data, size_t size, track_handle_list_type& tracks )
+{
+  const char* p = data;
+  const char* end = data + size;
+
+  uint32_t version, byte_order_mark;
+  if ( ( size < snapshot_magic_len ) || ( std::memcmp( p, snapshot_magic, snapshot_magic_len ) != 0 ))
+  {
+    LOG_ERROR( main_logger, "Not a track_oracle snapshot" );
+    return false;
+  }
+  p += snapshot_magic_len;
+  if ( ( ! binary_io::read_pod( p, end, version )) || ( ! binary_io::read_pod( p, end, byte_order_mark )))
+  {
+    LOG_ERROR( main_logger, "Truncated track_oracle snapshot header" );
+    return false;
+  }
+  if ( version != snapshot_version )
+  {
+    LOG_ERROR( main_logger, "Can't read track_oracle snapshot version " << version
+               << "; expecting " << snapshot_version );
+    return false;
+  }
+  if ( byte_order_mark != snapshot_byte_order_mark )
+  {
+    LOG_ERROR( main_logger, "track_oracle snapshot was written with a different byte order" );
+    return false;
+  }
+
+  // read the structure before creating any rows
+  uint64_t n_tracks, n_frames_total, n_columns;
+  if ( ( ! binary_io::read_pod( p, end, n_tracks )) ||
+       ( ! binary_io::read_pod( p, end, n_frames_total )) ||
+       ( static_cast< uint64_t >( end - p ) / sizeof( uint64_t ) < n_tracks ))
+  {
+    LOG_ERROR( main_logger, "Truncated track_oracle snapshot" );
+    return false;
+  }
+  vector< uint64_t > n_frames( static_cast< size_t >( n_tracks ));
+  uint64_t frame_sum = 0;
+  for (size_t i=0; i<n_frames.size(); ++i)
+  {
+    binary_io::read_pod( p, end, n_frames[i] );
+    frame_sum += n_frames[i];
+  }
+  if ( frame_sum != n_frames_total )
+  {
+    LOG_ERROR( main_logger, "track_oracle snapshot frame counts don't add up" );
+    return false;
+  }
+
+  vector< snapshot_column > snapshot_columns;
+  bool okay = binary_io::read_pod( p, end, n_columns );
+  for (uint64_t i=0; okay && (i<n_columns); ++i)
+  {
+    snapshot_column c;
+    uint32_t role;
+    uint64_t n_bytes;
+    okay =
+      binary_io::read_string( p, end, c.ed.name ) &&
+      binary_io::read_string( p, end, c.ed.description ) &&
+      binary_io::read_string( p, end, c.ed.typeid_str ) &&
+      binary_io::read_pod( p, end, role ) &&
+      binary_io::read_pod( p, end, n_bytes ) &&
+      ( static_cast< uint64_t >( end - p ) >= n_bytes );
+    if ( okay )
+    {
+      c.ed.role = static_cast< element_descriptor::element_role >( role );
+      c.begin = p;
+      c.end = p + n_bytes;
+      p = c.end;
+      snapshot_columns.push_back( c );
+    }
+  }
+  if ( ! okay )
+  {
+    LOG_ERROR( main_logger, "Truncated track_oracle snapshot column" );
+    return false;
+  }
+
+  write_lock pool( this->lock_for_writing( this->pool_lock, "read_snapshot" ));
+
+  // create the rows and the system fields linking them
+  element_store< frame_handle_list_type >* frame_lists =
+    this->lookup_store< frame_handle_list_type >( this->lookup_required_field( "__frame_list" ));
+  element_store< oracle_entry_handle_type >* parent_tracks =
+    this->lookup_store< oracle_entry_handle_type >( this->lookup_required_field( "__parent_track" ));
+
+  vector< oracle_entry_handle_type > rows( static_cast< size_t >( n_tracks + n_frames_total ));
+  for (size_t i=0; i<n_tracks; ++i)
+  {
+    rows[i] = this->get_next_handle();
+  }
+  size_t frame_index = static_cast< size_t >( n_tracks );
+  for (size_t i=0; i<n_tracks; ++i)
+  {
+    frame_handle_list_type frames;
+    for (uint64_t j=0; j<n_frames[i]; ++j)
+    {
+      oracle_entry_handle_type f = this->get_next_handle();
+      rows[ frame_index++ ] = f;
+      frames.push_back( frame_handle_type( f ));
+      parent_tracks->storage.set( f, rows[i] );
+    }
+    frame_lists->storage.set( rows[i], frames );
+    tracks.push_back( track_handle_type( rows[i] ));
+  }
+
+  // fill in the columns, creating those we know the type of
+  for (size_t i=0; i<snapshot_columns.size(); ++i)
+  {
+    const snapshot_column& c = snapshot_columns[i];
+    field_handle_type fh = this->unlocked_lookup_by_name( c.ed.name );
+    if ( fh == INVALID_FIELD_HANDLE )
+    {
+      map< string, column_factory_type >::const_iterator probe = this->column_factories.find( c.ed.typeid_str );
+      if ( probe == this->column_factories.end() )
+      {
+        LOG_WARN( main_logger, "Skipping snapshot column '" << c.ed.name << "': no column of type "
+                  << c.ed.typeid_str << " has been created" );
+        continue;
+      }
+      fh = this->unlocked_create_element( c.ed, probe->second );
+    }
+
+    element_store_base* b = this->element_pool[ fh ];
+    if ( b->get_descriptor().typeid_str != c.ed.typeid_str )
+    {
+      LOG_WARN( main_logger, "Skipping snapshot column '" << c.ed.name << "': type " << c.ed.typeid_str
+                << " doesn't match existing type " << b->get_descriptor().typeid_str );
+      continue;
+    }
+
+    const char* values = c.begin;
+    if ( ( ! b->read_binary( values, c.end, rows )) || ( values != c.end ))
+    {
+      LOG_ERROR( main_logger, "Malformed values for snapshot column '" << c.ed.name << "'" );
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void
 track_oracle_core_impl
 ::get_csv_columns( const oracle_entry_handle_type& row,
@@ -688,7 +1230,8 @@ bool
 track_oracle_core_impl
 ::write_csv( ostream& os, const track_handle_list_type& tracks, bool csv_v1_semantics )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  vector< read_lock > columns( this->lock_columns_for_reading() );
 
   field_handle_type world_gcs_fh = this->unlocked_lookup_by_name( "world_gcs" );
   if ( world_gcs_fh == INVALID_FIELD_HANDLE )
@@ -751,7 +1294,7 @@ ::write_csv( ostream& os, const track_handle_list_type& tracks, bool csv_v1_sema
     bool gcs_in_track = track_headers.find( world_gcs_fh ) != track_headers.end();
     if ( ! ( gcs_in_frame || gcs_in_track ))
     {
-      frame_headers[ world_gcs_fh ] = this->element_pool[ world_gcs_fh ]->csv_headers();
+      frame_headers[ world_gcs_fh ] = this->element_pool.at( world_gcs_fh )->csv_headers();
     }
   }
 
@@ -928,7 +1471,8 @@ csv_handler_map_type
 track_oracle_core_impl
 ::get_csv_handler_map( const vector< string >& headers )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  vector< read_lock > columns( this->lock_columns_for_reading() );
 
   map< string, field_handle_type > header_map;
   map< size_t, size_t > header_claimed_map;
@@ -972,7 +1516,7 @@ ::get_csv_handler_map( const vector< string >& headers )
       if ( check_p->second != INVALID_FIELD_HANDLE )
       {
         // whoops: name the offenders
-        const element_descriptor& that_ed = this->element_pool[ check_p->second ]->get_descriptor();
+        const element_descriptor& that_ed = this->element_pool.at( check_p->second )->get_descriptor();
         throw runtime_error( "CSV header collision: header '" + element_headers[j] + "' is claimed by both "
                                  + this_ed.name + " and " + that_ed.name );
       }
@@ -8,9 +8,12 @@
 #include <vital/vital_config.h>
 #include <track_oracle/core/track_oracle_export.h>
 
+#include <atomic>
 #include <map>
-#include <string>
+#include <memory>
 #include <mutex>
+#include <string>
+#include <boost/thread/shared_mutex.hpp>
 
 #include <track_oracle/core/track_oracle_core.h>
 #include <track_oracle/core/element_store.h>
@@ -47,6 +50,8 @@ namespace kwiver {
 namespace track_oracle {
 
 struct xml_output_helper;
+class frame_time_index;
+class frame_box_grid;
 
 class TRACK_ORACLE_EXPORT track_oracle_core_impl
 {
@@ -63,30 +68,78 @@ class TRACK_ORACLE_EXPORT track_oracle_core_impl
   std::map< field_handle_type, element_store_base* > element_pool;
   std::map< std::string, field_handle_type > name_pool;
   unsigned field_count;
-  unsigned row_count;
+  std::atomic< unsigned > row_count;
 
   std::map< domain_handle_type, handle_list_type > domain_pool;
   std::map< std::string, domain_handle_type > domain_names;
   domain_handle_type last_domain_allocated;
 
+  // storage of the columns created from now on
+  element_storage_type default_storage_type;
+
+  // Creates an empty column of a type, keyed by the type's typeid string.
+  // Registered for each type a column is created for, so that reading a
+  // snapshot can create the columns of those types which haven't been
+  // declared yet.
+  typedef element_store_base* (*column_factory_type)( const element_descriptor& e, element_storage_type t );
+  std::map< std::string, column_factory_type > column_factories;
+
   track_oracle_core_impl( const track_oracle_core_impl& ); // no cpctor
   track_oracle_core_impl operator=( const track_oracle_core_impl& ); // no op=
 
-  // Given a field (column) index, return the map of that column's data
+  // Given a field (column) index, return the storage of that column's data
   // Always create if not found; also return the table's default value
-  template< typename T > std::pair< std::map<oracle_entry_handle_type, T>*, T > lookup_table( field_handle_type field );
-
-  // giant mutex for a blunt approach to thread safety
-  mutable std::mutex api_lock;
+  template< typename T > std::pair< element_column<T>*, T > lookup_table( field_handle_type field );
+
+  // Given a field (column) index, return its typed element store; throws if
+  // the field doesn't exist or has another type
+  template< typename T > element_store<T>* lookup_store( field_handle_type field ) const;
+
+  // Thread safety:
+  //
+  // pool_lock guards element_pool, name_pool, field_count and
+  // default_storage_type; each data column has its own reader/writer lock
+  // (element_store_base::column_lock()); domain_lock guards the domains.
+  // Locks are taken in the order domain, pool, column, and a thread holds
+  // the write lock of at most one column at a time.
+  //
+  // While frozen, the fields and their columns are read-only: readers take
+  // no pool or column locks, and anything which would change a column or
+  // create one throws.
+  typedef boost::shared_mutex rw_mutex;
+  typedef boost::shared_lock< rw_mutex > read_lock;
+  typedef boost::unique_lock< rw_mutex > write_lock;
+
+  mutable rw_mutex pool_lock;
+  mutable rw_mutex domain_lock;
+  std::atomic< bool > frozen;
+
+  // a shared lock on m, not taken if frozen
+  read_lock lock_for_reading( rw_mutex& m ) const;
+  // an exclusive lock on m; throws if frozen
+  write_lock lock_for_writing( rw_mutex& m, const char* what ) const;
+  // shared locks on every column, for reading many fields of many rows
+  std::vector< read_lock > lock_columns_for_reading() const;
 
   // throws if the field doesn't exist
   field_handle_type lookup_required_field( const std::string& fn ) const;
 
+  // The indices of lookup_frames, built on first use while frozen and
+  // dropped by thaw(); index_lock guards the maps.  When not frozen, each
+  // call builds its own.  Called with the pool lock held.
+  std::map< field_handle_type, std::shared_ptr< const frame_time_index > > time_indices;
+  std::map< field_handle_type, std::shared_ptr< const frame_box_grid > > box_indices;
+  std::mutex index_lock;
+  std::shared_ptr< const frame_time_index > get_time_index( field_handle_type f );
+  std::shared_ptr< const frame_box_grid > get_box_index( field_handle_type f );
+
   // unlocked versions of API calls which are also called internally
   template< typename T > field_handle_type unlocked_create_element( const element_descriptor& e );
+  field_handle_type unlocked_create_element( const element_descriptor& e, column_factory_type make_store );
   field_handle_type unlocked_lookup_by_name( const std::string& name ) const;
   template< typename T > T& unlocked_get_field( oracle_entry_handle_type track, field_handle_type field );
-  frame_handle_list_type unlocked_get_frames( const track_handle_type& t );
+  // the frames of t, or an empty list; never adds a row to __frame_list
+  frame_handle_list_type unlocked_get_frames( const track_handle_type& t ) const;
   bool unlocked_field_has_row( oracle_entry_handle_type row, field_handle_type field ) const;
   void emit_pool_as_kwiver( std::ostream& os, const std::string& indent, oracle_entry_handle_type row ) const;
   void emit_pool_as_csv( std::ostream& os,
@@ -113,6 +166,12 @@ class TRACK_ORACLE_EXPORT track_oracle_core_impl
   const element_store_base* get_element_store_base( field_handle_type f ) const;
   element_store_base* get_mutable_element_store_base( field_handle_type f ) const;
 
+  // map or dense storage for new columns, or for an existing column
+  element_storage_type get_default_storage_type() const;
+  void set_default_storage_type( element_storage_type t );
+  element_storage_type get_storage_type( field_handle_type f ) const;
+  void set_storage_type( field_handle_type f, element_storage_type t );
+
   std::map< element_descriptor, field_handle_type > get_fields() const;
 
   // Given a field handle, does the row (track or frame) have an entry?
@@ -144,6 +203,15 @@ class TRACK_ORACLE_EXPORT track_oracle_core_impl
   // return the row containing the value-- return first if multiple; probably should alert somehow
   template< typename T> oracle_entry_handle_type lookup( field_handle_type field, const T& val, domain_handle_type domain );
 
+  // return the frames, sorted by handle, whose time_field value is in
+  // [t_begin, t_end] and whose box_field box intersects box; either test
+  // is skipped if its field is INVALID_FIELD_HANDLE
+  frame_handle_list_type lookup_frames( field_handle_type time_field,
+                                        unsigned long long t_begin,
+                                        unsigned long long t_end,
+                                        field_handle_type box_field,
+                                        const vgl_box_2d< double >& box );
+
   // return the frames associated with the handle without requiring a specific schema
   frame_handle_list_type get_frames( const track_handle_type& t );
 
@@ -163,9 +231,24 @@ class TRACK_ORACLE_EXPORT track_oracle_core_impl
   bool add_to_domain( const track_handle_type& track, const domain_handle_type& domain );
   bool set_domain( const handle_list_type& handles, domain_handle_type domain );
 
+  // Make the fields read-only, so that reading them takes no locks; for
+  // after loading.  Waits for the calls changing a column to finish.
+  void freeze();
+
+  // Allow changes again; must not be called while other threads read.
+  void thaw();
+
+  bool is_frozen() const;
+
   // emit the list of tracks as kwiver XML
   bool write_kwiver( std::ostream& os, const track_handle_list_type& tracks );
 
+  // emit the list of tracks as a binary snapshot
+  bool write_snapshot( std::ostream& os, const track_handle_list_type& tracks );
+
+  // create the tracks of the snapshot in data; appends them to tracks
+  bool read_snapshot( const char* data, size_t size, track_handle_list_type& tracks );
+
   // emit the list of tracks as CSV
   bool write_csv( std::ostream& os, const track_handle_list_type& tracks, bool csv_v1_semantics );
 
@@ -62,30 +62,21 @@ struct default_value_handler< false, T >
   }
 };
 
+template< typename T >
+element_store_base*
+create_element_store( const element_descriptor& e, element_storage_type t )
+{
+  element_store<T> *es = new element_store<T>( e, t );
+  es->set_default_value( default_value_handler< is_initializable_with_zero<T>::value, T>::default_type_value() );
+  return es;
+}
+
 template< typename T >
 field_handle_type
 track_oracle_core_impl
 ::unlocked_create_element( const element_descriptor& e )
 {
-  // first double-check the name is available
-  field_handle_type f = this->unlocked_lookup_by_name( e.name );
-  if (f != INVALID_FIELD_HANDLE)
-  {
-    ostringstream oss;
-    oss << "Duplicate creation of field named '" << e.name << "'\n";
-    throw runtime_error( oss.str() );
-  }
-
-  // create entry in name pool; assign field handle
-  f = ++this->field_count;
-  this->name_pool[ e.name ] = f;
-  // create entry in element pool
-  element_store<T> *es = new element_store<T>( e );
-  es->set_default_value( default_value_handler< is_initializable_with_zero<T>::value, T>::default_type_value() );
-  this->element_pool[ f ] = es;
-
-  // all done
-  return f;
+  return this->unlocked_create_element( e, &create_element_store<T> );
 }
 
 template< typename T >
@@ -93,16 +84,16 @@ field_handle_type
 track_oracle_core_impl
 ::create_element( const element_descriptor& e )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
+  write_lock pool( this->lock_for_writing( this->pool_lock, "create_element" ));
   return this->unlocked_create_element<T>( e );
 }
 
 template< typename T >
-pair< map<oracle_entry_handle_type, T>*, T >
+element_store<T>*
 track_oracle_core_impl
-::lookup_table( field_handle_type field )
+::lookup_store( field_handle_type field ) const
 {
-  map< field_handle_type, element_store_base* >::iterator probe = this->element_pool.find( field );
+  map< field_handle_type, element_store_base* >::const_iterator probe = this->element_pool.find( field );
   if (probe == this->element_pool.end())
   {
     throw runtime_error( "Lost an element pool for a field?" );
@@ -118,7 +109,16 @@ ::lookup_table( field_handle_type field )
     LOG_ERROR( main_logger, "About to throw exception '" << oss.str() << "'" );
     throw runtime_error( oss.str() );
   }
-  pair< map< oracle_entry_handle_type, T>*, T> ret( &es_ptr->storage, es_ptr->get_default_value() );
+  return es_ptr;
+}
+
+template< typename T >
+pair< element_column<T>*, T >
+track_oracle_core_impl
+::lookup_table( field_handle_type field )
+{
+  element_store<T>* es_ptr = this->lookup_store<T>( field );
+  pair< element_column<T>*, T> ret( &es_ptr->storage, es_ptr->get_default_value() );
   return ret;
 }
 
@@ -127,9 +127,10 @@ void
 track_oracle_core_impl
 ::remove_field( oracle_entry_handle_type row, field_handle_type field )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
-  pair< map< oracle_entry_handle_type, T >*, T > probe = this->lookup_table<T>( field );
-  probe.first->erase( row );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  element_store<T>* es_ptr = this->lookup_store<T>( field );
+  write_lock column( this->lock_for_writing( es_ptr->column_lock(), "remove_field" ));
+  es_ptr->storage.erase( row );
 }
 
 template< typename T >
@@ -137,15 +138,8 @@ T&
 track_oracle_core_impl
 ::unlocked_get_field( oracle_entry_handle_type track, field_handle_type field )
 {
-  pair< map< oracle_entry_handle_type, T >*, T > probe = this->lookup_table<T>( field );
-  map< oracle_entry_handle_type, T >& data_column = *(probe.first);
-  size_t before = data_column.size();
-  T& ref = data_column[ track ];
-  if ( before != data_column.size() )
-  {
-    ref = probe.second;
-  }
-  return ref;
+  element_store<T>* es_ptr = this->lookup_store<T>( field );
+  return es_ptr->storage.get( track, es_ptr->get_default_value() );
 }
 
 template< typename T >
@@ -153,8 +147,22 @@ T&
 track_oracle_core_impl
 ::get_field( oracle_entry_handle_type track, field_handle_type field )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
-  return this->unlocked_get_field<T>( track, field );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  element_store<T>* es_ptr = this->lookup_store<T>( field );
+
+  // most calls are for rows which already have a value, which only need
+  // to read the column
+  {
+    read_lock column( this->lock_for_reading( es_ptr->column_lock() ));
+    T* p = es_ptr->storage.find( track );
+    if ( p )
+    {
+      return *p;
+    }
+  }
+
+  write_lock column( this->lock_for_writing( es_ptr->column_lock(), "get_field on a row without a value" ));
+  return es_ptr->storage.get( track, es_ptr->get_default_value() );
 }
 
 template< typename T >
@@ -162,13 +170,14 @@ pair< bool, T >
 track_oracle_core_impl
 ::get( oracle_entry_handle_type row, field_handle_type field )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
-  const pair< map< oracle_entry_handle_type, T >*, T> f_probe = this->lookup_table<T>( field );
-  typename map< oracle_entry_handle_type, T >::const_iterator probe = f_probe.first->find( row );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  const element_store<T>* es_ptr = this->lookup_store<T>( field );
+  read_lock column( this->lock_for_reading( es_ptr->column_lock() ));
+  const T* probe = es_ptr->storage.find( row );
   return
-    ( probe == f_probe.first->end() )
-    ? make_pair( false, f_probe.second )
-    : make_pair( true, probe->second );
+    ( ! probe )
+    ? make_pair( false, es_ptr->get_default_value() )
+    : make_pair( true, *probe );
 }
 
 template< typename T >
@@ -176,20 +185,14 @@ oracle_entry_handle_type
 track_oracle_core_impl
 ::lookup( field_handle_type field, const T& val, domain_handle_type domain )
 {
-  std::lock_guard< std::mutex > lock( this->api_lock );
-  pair< map< oracle_entry_handle_type, T >*, T > probe = this->lookup_table<T>( field );
-  map< oracle_entry_handle_type, T >& data_column = *(probe.first);
+  read_lock domains( this->domain_lock );
+  read_lock pool( this->lock_for_reading( this->pool_lock ));
+  const element_store<T>* es_ptr = this->lookup_store<T>( field );
+  read_lock column( this->lock_for_reading( es_ptr->column_lock() ));
+  const element_column<T>& data_column = es_ptr->storage;
   if ( domain == DOMAIN_ALL )
   {
-    for (typename map< oracle_entry_handle_type, T>::const_iterator i = data_column.begin();
-         i != data_column.end();
-         ++i )
-    {
-      if ( i->second == val )
-      {
-        return i->first;
-      }
-    }
+    return data_column.find_if( [&val]( const T& v ) { return v == val; } );
   }
   else
   {
@@ -199,9 +202,8 @@ ::lookup( field_handle_type field, const T& val, domain_handle_type domain )
       const handle_list_type& handle_list = i->second;
       for (unsigned j=0; j < handle_list.size(); ++j )
       {
-        typename map< oracle_entry_handle_type, T>::const_iterator h_probe
-          = data_column.find( handle_list[j] );
-        if ( ( h_probe != data_column.end() ) && ( h_probe->second == val ))
+        const T* h_probe = data_column.find( handle_list[j] );
+        if ( h_probe && ( *h_probe == val ))
         {
           return handle_list[j];
         }
@@ -0,0 +1,171 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "track_oracle_frame_index.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+using std::max;
+using std::min;
+using std::numeric_limits;
+using std::vector;
+
+namespace // anon
+{
+
+bool
+is_empty_box( const vgl_box_2d< double >& b )
+{
+  return ! (( b.min_x() <= b.max_x() ) && ( b.min_y() <= b.max_y() ));
+}
+
+bool
+boxes_intersect( const vgl_box_2d< double >& a, const vgl_box_2d< double >& b )
+{
+  return ( a.min_x() <= b.max_x() ) && ( b.min_x() <= a.max_x() ) &&
+         ( a.min_y() <= b.max_y() ) && ( b.min_y() <= a.max_y() );
+}
+
+bool
+earlier_than( const ::kwiver::track_oracle::frame_time_index::entry_type& e, unsigned long long t )
+{
+  return e.first < t;
+}
+
+bool
+later_than( unsigned long long t, const ::kwiver::track_oracle::frame_time_index::entry_type& e )
+{
+  return t < e.first;
+}
+
+// cells per side, at most this many
+const size_t max_cells_per_side = 1024;
+
+} // anon
+
+namespace kwiver {
+namespace track_oracle {
+
+frame_time_index
+::frame_time_index( vector< entry_type > e )
+  : entries( std::move( e ))
+{
+  std::sort( this->entries.begin(), this->entries.end() );
+}
+
+vector< oracle_entry_handle_type >
+frame_time_index
+::rows_in( unsigned long long t_begin, unsigned long long t_end ) const
+{
+  vector< oracle_entry_handle_type > ret;
+  if ( t_begin > t_end ) return ret;
+
+  vector< entry_type >::const_iterator b =
+    std::lower_bound( this->entries.begin(), this->entries.end(), t_begin, earlier_than );
+  vector< entry_type >::const_iterator e =
+    std::upper_bound( b, this->entries.end(), t_end, later_than );
+  for ( ; b != e; ++b )
+  {
+    ret.push_back( b->second );
+  }
+  std::sort( ret.begin(), ret.end() );
+  return ret;
+}
+
+frame_box_grid
+::frame_box_grid( const vector< entry_type >& all_entries )
+  : x0( 0 ), y0( 0 ), cell_w( 1 ), cell_h( 1 ), nx( 0 ), ny( 0 )
+{
+  double x1 = -numeric_limits< double >::max(), y1 = -numeric_limits< double >::max();
+  double sum_w = 0, sum_h = 0;
+  this->x0 = numeric_limits< double >::max();
+  this->y0 = numeric_limits< double >::max();
+  for (size_t i=0; i<all_entries.size(); ++i)
+  {
+    const vgl_box_2d< double >& b = all_entries[i].first;
+    if ( is_empty_box( b )) continue;
+    this->entries.push_back( all_entries[i] );
+    this->x0 = min( this->x0, b.min_x() );
+    this->y0 = min( this->y0, b.min_y() );
+    x1 = max( x1, b.max_x() );
+    y1 = max( y1, b.max_y() );
+    sum_w += b.max_x() - b.min_x();
+    sum_h += b.max_y() - b.min_y();
+  }
+  if ( this->entries.empty() ) return;
+
+  // a few boxes per cell, but cells no smaller than the average box, so
+  // that each box lands in a handful of cells
+  const size_t n = this->entries.size();
+  const size_t side = min( max_cells_per_side, max< size_t >( 1, static_cast< size_t >( std::sqrt( n / 4.0 ))));
+  this->cell_w = max( ( x1 - this->x0 ) / side, sum_w / n );
+  this->cell_h = max( ( y1 - this->y0 ) / side, sum_h / n );
+  if ( ! ( this->cell_w > 0 )) this->cell_w = 1;
+  if ( ! ( this->cell_h > 0 )) this->cell_h = 1;
+  this->nx = min( side, static_cast< size_t >(( x1 - this->x0 ) / this->cell_w ) + 1 );
+  this->ny = min( side, static_cast< size_t >(( y1 - this->y0 ) / this->cell_h ) + 1 );
+
+  this->cells.resize( this->nx * this->ny );
+  for (size_t i=0; i<n; ++i)
+  {
+    const vgl_box_2d< double >& b = this->entries[i].first;
+    for (size_t y = this->cell_y( b.min_y() ); y <= this->cell_y( b.max_y() ); ++y)
+    {
+      for (size_t x = this->cell_x( b.min_x() ); x <= this->cell_x( b.max_x() ); ++x)
+      {
+        this->cells[ y * this->nx + x ].push_back( static_cast< uint32_t >( i ));
+      }
+    }
+  }
+}
+
+size_t
+frame_box_grid
+::cell_x( double x ) const
+{
+  double c = std::floor( ( x - this->x0 ) / this->cell_w );
+  return ( c <= 0 ) ? 0 : min( this->nx - 1, static_cast< size_t >( c ));
+}
+
+size_t
+frame_box_grid
+::cell_y( double y ) const
+{
+  double c = std::floor( ( y - this->y0 ) / this->cell_h );
+  return ( c <= 0 ) ? 0 : min( this->ny - 1, static_cast< size_t >( c ));
+}
+
+vector< oracle_entry_handle_type >
+frame_box_grid
+::rows_intersecting( const vgl_box_2d< double >& box ) const
+{
+  vector< oracle_entry_handle_type > ret;
+  if ( this->entries.empty() || is_empty_box( box )) return ret;
+
+  vector< uint32_t > candidates;
+  for (size_t y = this->cell_y( box.min_y() ); y <= this->cell_y( box.max_y() ); ++y)
+  {
+    for (size_t x = this->cell_x( box.min_x() ); x <= this->cell_x( box.max_x() ); ++x)
+    {
+      const vector< uint32_t >& c = this->cells[ y * this->nx + x ];
+      candidates.insert( candidates.end(), c.begin(), c.end() );
+    }
+  }
+  std::sort( candidates.begin(), candidates.end() );
+  candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+  for (size_t i=0; i<candidates.size(); ++i)
+  {
+    const entry_type& e = this->entries[ candidates[i] ];
+    if ( boxes_intersect( e.first, box )) ret.push_back( e.second );
+  }
+  std::sort( ret.begin(), ret.end() );
+  return ret;
+}
+
+} // ...track_oracle
+} // ...kwiver
@@ -0,0 +1,77 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef INCL_TRACK_ORACLE_FRAME_INDEX_H
+#define INCL_TRACK_ORACLE_FRAME_INDEX_H
+
+///
+/// Secondary indices over the frame rows of a column, for the
+/// track_oracle_core::lookup_frames queries.
+///
+/// frame_time_index holds the (time, row) pairs of a time column sorted by
+/// time, so the frames in a window are a binary search away.
+///
+/// frame_box_grid buckets the boxes of a box column into a uniform grid
+/// over their extent, sized for a few boxes per cell; a query checks only
+/// the boxes of the cells it overlaps.
+///
+/// Both are built from a snapshot of the column and don't follow later
+/// changes to it.  The handles are opaque to both, so either can index
+/// anything else keyed by an integer.
+///
+
+#include <vital/vital_config.h>
+#include <track_oracle/core/track_oracle_export.h>
+
+#include <track_oracle/core/track_oracle_api_types.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <vgl/vgl_box_2d.h>
+
+namespace kwiver {
+namespace track_oracle {
+
+class TRACK_ORACLE_EXPORT frame_time_index
+{
+public:
+  typedef std::pair< unsigned long long, oracle_entry_handle_type > entry_type;
+
+  explicit frame_time_index( std::vector< entry_type > entries );
+
+  // rows whose time is in [t_begin, t_end], sorted by handle
+  std::vector< oracle_entry_handle_type > rows_in( unsigned long long t_begin, unsigned long long t_end ) const;
+
+private:
+  std::vector< entry_type > entries;
+};
+
+class TRACK_ORACLE_EXPORT frame_box_grid
+{
+public:
+  typedef std::pair< vgl_box_2d< double >, oracle_entry_handle_type > entry_type;
+
+  // empty boxes are dropped
+  explicit frame_box_grid( const std::vector< entry_type >& entries );
+
+  // rows whose box intersects box (including touching it), sorted by handle
+  std::vector< oracle_entry_handle_type > rows_intersecting( const vgl_box_2d< double >& box ) const;
+
+private:
+  std::vector< entry_type > entries;
+  double x0, y0, cell_w, cell_h;
+  size_t nx, ny;
+  // indices into entries of the boxes overlapping each cell, row-major
+  std::vector< std::vector< uint32_t > > cells;
+
+  size_t cell_x( double x ) const;
+  size_t cell_y( double y ) const;
+};
+
+} // ...track_oracle
+} // ...kwiver
+
+#endif
@@ -14,6 +14,7 @@
 #include <vital/types/uid.h>
 
 #include <track_oracle/core/state_flags.h>
+#include <track_oracle/core/string_symbol.h>
 
 #include <vital/vital_config.h>
 #include <track_oracle/core/track_oracle_export.h>
@@ -57,6 +58,7 @@ TRACK_ORACLE_INSTANTIATE_OLD_STYLE_DEFAULT_OUTPUT(unsigned int);
 TRACK_ORACLE_INSTANTIATE_OLD_STYLE_DEFAULT_OUTPUT(unsigned long);
 TRACK_ORACLE_INSTANTIATE_OLD_STYLE_DEFAULT_OUTPUT(unsigned long long);
 TRACK_ORACLE_INSTANTIATE_OLD_STYLE_DEFAULT_OUTPUT(std::string);
+TRACK_ORACLE_INSTANTIATE_OLD_STYLE_DEFAULT_OUTPUT(kwiver::track_oracle::string_symbol);
 TRACK_ORACLE_INSTANTIATE_OLD_STYLE_DEFAULT_OUTPUT(vgl_box_2d<unsigned>);
 TRACK_ORACLE_INSTANTIATE_OLD_STYLE_DEFAULT_OUTPUT(vgl_box_2d<double>);
 TRACK_ORACLE_INSTANTIATE_OLD_STYLE_DEFAULT_OUTPUT(vgl_point_2d<double>);
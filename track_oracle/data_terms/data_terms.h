@@ -38,6 +38,7 @@
 
 #include <iostream>
 #include <track_oracle/data_terms/data_terms_common.h>
+#include <track_oracle/core/string_symbol.h>
 
 #include <vgl/vgl_point_2d.h>
 #include <vgl/vgl_box_2d.h>
@@ -94,7 +95,7 @@ namespace tracking {
   DECL_DT_W_STR( longitude, double, "longitude, -180 to 180" );
   DECL_DT_RW_STRXMLCSV( time_stamp, vital::timestamp, "timestamp (carries both time and framenumber); epoch is data-dependent" );
   DECL_DT_RW_STR( track_uuid, vital::uid, "UUID associated with the track" );
-  DECL_DT( track_style, std::string, "track_style, typically indicating the source (tracker, detector, etc.)" );
+  DECL_DT( track_style, string_symbol, "track_style, typically indicating the source (tracker, detector, etc.)" );
 
 } // ...tracking
 
@@ -170,10 +170,10 @@ ::set_event_track_data( const track_handle_type& new_track,
     }
     else
     {
-      pair< bool, string > track_style_probe = track_style_field.get( new_track.row );
+      pair< bool, string_symbol > track_style_probe = track_style_field.get( new_track.row );
       if ( track_style_probe.first )
       {
-        msgs.add_msg( "event_adapter: no track style specified; using style '"+track_style_probe.second+"' from source" );
+        msgs.add_msg( "event_adapter: no track style specified; using style '"+track_style_probe.second.str()+"' from source" );
       }
       else
       {
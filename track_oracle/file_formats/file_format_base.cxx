@@ -4,6 +4,8 @@
 
 #include "file_format_base.h"
 
+#include <algorithm>
+
 #include <kwiversys/RegularExpression.hxx>
 
 #include <vul/vul_file.h>
@@ -91,6 +93,55 @@ glob_to_regexp_string( const string& glob )
 namespace kwiver {
 namespace track_oracle {
 
+file_format_reader_opts_base&
+file_format_reader_opts_base
+::operator=( const file_format_reader_opts_base& other )
+{
+  this->projection = other.projection;
+  return *this;
+}
+
+file_format_reader_opts_base&
+file_format_reader_opts_base
+::set_projection( const track_base_impl& schema )
+{
+  vector< field_handle_type > fields;
+  map< field_handle_type, track_base_impl::schema_position_type > elements = schema.list_schema_elements();
+  for (map< field_handle_type, track_base_impl::schema_position_type >::const_iterator i = elements.begin();
+       i != elements.end();
+       ++i)
+  {
+    fields.push_back( i->first );
+  }
+  return this->set_projection( fields );
+}
+
+file_format_reader_opts_base&
+file_format_reader_opts_base
+::set_projection( const vector< field_handle_type >& fields )
+{
+  this->projection = fields;
+  std::sort( this->projection.begin(), this->projection.end() );
+  this->projection.erase( std::unique( this->projection.begin(), this->projection.end() ), this->projection.end() );
+  return *this;
+}
+
+file_format_reader_opts_base&
+file_format_reader_opts_base
+::clear_projection()
+{
+  this->projection.clear();
+  return *this;
+}
+
+bool
+file_format_reader_opts_base
+::loads_field( field_handle_type f ) const
+{
+  return this->projection.empty() ||
+    std::binary_search( this->projection.begin(), this->projection.end(), f );
+}
+
 file_format_base
 ::file_format_base( file_format_enum fmt,
                     const string& desc
@@ -66,14 +66,30 @@ enum file_format_operation
 
 struct TRACK_ORACLE_FORMAT_BASE_EXPORT file_format_reader_opts_base
 {
-  // empty base class for format-specific reader options
-  virtual file_format_reader_opts_base& reset() { return *this; } // restore options to a known state
+  // base class for format-specific reader options
+  virtual file_format_reader_opts_base& reset() { return this->clear_projection(); } // restore options to a known state
 
   // make op= virtual so we can assign into the manager's map like this:
   // file_format_manager::reader_options( TF_APIX ) = apix_reader_opts().set_verbose( true );
   // ... and not have the derived class sliced to the base
-  virtual file_format_reader_opts_base& operator=( const file_format_reader_opts_base& /*other*/) { return *this;}
+  virtual file_format_reader_opts_base& operator=( const file_format_reader_opts_base& other );
   virtual ~file_format_reader_opts_base() {}
+
+  // A projected load: readers which support it store only the fields
+  // of the projection, skipping the work of parsing and holding the rest.
+  // Fields a reader needs to assemble the tracks (e.g. the kw18 track ID)
+  // are still stored.  An empty projection (the default) loads everything.
+  file_format_reader_opts_base& set_projection( const track_base_impl& schema );
+  file_format_reader_opts_base& set_projection( const std::vector< field_handle_type >& fields );
+  file_format_reader_opts_base& clear_projection();
+  const std::vector< field_handle_type >& get_projection() const { return this->projection; }
+
+  // true if the reader should store field f
+  bool loads_field( field_handle_type f ) const;
+
+private:
+  // sorted
+  std::vector< field_handle_type > projection;
 };
 
 class TRACK_ORACLE_FORMAT_BASE_EXPORT file_format_base
@@ -9,6 +9,9 @@
 #include <stdexcept>
 #include <sstream>
 #include <mutex>
+#include <thread>
+#include <atomic>
+#include <algorithm>
 #include <vul/vul_string.h>
 #include <vul/vul_file.h>
 
@@ -41,6 +44,7 @@
 #endif
 #include <track_oracle/file_formats/track_csv/file_format_csv.h>
 #include <track_oracle/file_formats/track_kwiver/file_format_kwiver.h>
+#include <track_oracle/file_formats/track_kwiver/file_format_kwiver_snapshot.h>
 #include <track_oracle/core/schema_algorithm.h>
 
 #include <vital/logger/logger.h>
@@ -119,6 +123,7 @@ ::file_format_manager_impl()
 #endif
   formats[ TF_CSV ] = new file_format_csv();
   formats[ TF_KWIVER ] = new file_format_kwiver();
+  formats[ TF_KWIVER_SNAPSHOT ] = new file_format_kwiver_snapshot();
 #ifdef KWIVER_ENABLE_KPF
   formats[ TF_KPF_GEOM ] = new file_format_kpf_geom();
 #endif
@@ -346,6 +351,91 @@ ::detect_format( const string& fn )
 bool
 file_format_manager
 ::read( const string& fn, track_handle_list_type& tracks )
+{
+  file_format_enum f = TF_INVALID_TYPE;
+  bool rc = unrecorded_read( fn, tracks, f );
+  if (rc && (f != TF_INVALID_TYPE))
+  {
+    file_format_schema_type::record_track_source( tracks, fn, f );
+  }
+  return rc;
+}
+
+bool
+file_format_manager
+::read_many( const vector< string >& fns, track_handle_list_type& tracks, size_t n_threads )
+{
+  if ( n_threads == 0 )
+  {
+    n_threads = std::max( std::thread::hardware_concurrency(), 1u );
+  }
+  n_threads = std::min( n_threads, fns.size() );
+
+  // make sure the formats exist before the workers race to create them
+  get_instance();
+
+  // each file is read into its own track list; the rows they refer to are
+  // allocated from the oracle's (atomic) handle counter and so are unique
+  // across threads
+  vector< track_handle_list_type > staged( fns.size() );
+  vector< file_format_enum > formats( fns.size(), TF_INVALID_TYPE );
+  vector< char > okay( fns.size(), 0 );
+  std::atomic< size_t > next_file( 0 );
+
+  auto worker = [&]()
+  {
+    for (size_t i = next_file++; i < fns.size(); i = next_file++)
+    {
+      try
+      {
+        okay[i] = unrecorded_read( fns[i], staged[i], formats[i] );
+      }
+      catch (const std::exception& e)
+      {
+        LOG_ERROR( main_logger, "FileFormatManager: exception reading '" << fns[i] << "': " << e.what() );
+      }
+    }
+  };
+
+  vector< std::thread > threads;
+  for (size_t i=1; i<n_threads; ++i)
+  {
+    threads.push_back( std::thread( worker ));
+  }
+  worker();
+  for (auto& t: threads)
+  {
+    t.join();
+  }
+
+  // merge in the order of the files, so the source file IDs and the order
+  // of the tracks are the same as reading the files one after another
+  bool all_okay = true;
+  size_t n_tracks = tracks.size();
+  for (size_t i=0; i<fns.size(); ++i)
+  {
+    n_tracks += staged[i].size();
+  }
+  tracks.reserve( n_tracks );
+  for (size_t i=0; i<fns.size(); ++i)
+  {
+    if ( ! okay[i] )
+    {
+      all_okay = false;
+      continue;
+    }
+    if ( formats[i] != TF_INVALID_TYPE )
+    {
+      file_format_schema_type::record_track_source( staged[i], fns[i], formats[i] );
+    }
+    tracks.insert( tracks.end(), staged[i].begin(), staged[i].end() );
+  }
+  return all_okay;
+}
+
+bool
+file_format_manager
+::unrecorded_read( const string& fn, track_handle_list_type& tracks, file_format_enum& f )
 {
   {
     ifstream is_check( fn.c_str() );
@@ -361,7 +451,7 @@ ::read( const string& fn, track_handle_list_type& tracks )
     return true;
   }
 
-  file_format_enum f = get_instance().detect_format( fn );
+  f = get_instance().detect_format( fn );
   if (f == TF_INVALID_TYPE) return false;
 
   file_format_base* b = get_instance().get_format( f );
@@ -371,12 +461,7 @@ ::read( const string& fn, track_handle_list_type& tracks )
     return false;
   }
 
-  bool rc = b->read( fn, tracks );
-  if (rc)
-  {
-    file_format_schema_type::record_track_source( tracks, fn, f );
-  }
-  return rc;
+  return b->read( fn, tracks );
 }
 
 bool
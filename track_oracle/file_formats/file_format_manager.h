@@ -66,6 +66,17 @@
 /// [...]
 ///
 ///
+/// 5) You're scoring, and only need the frame numbers and boxes; the
+/// kw18 and CSV readers will skip storing the other columns:
+///
+/// [...]
+/// my_scoring_schema s;  // frame_number and bounding_box
+/// file_format_manager::options( TF_KW18 ).set_projection( s );
+/// bool okay = file_format_manager::read( filename, the_tracks );
+/// file_format_manager::default_options( TF_KW18 );
+/// [...]
+///
+///
 
 #include <vital/vital_config.h>
 #include <track_oracle/file_formats/track_oracle_file_formats_export.h>
@@ -124,6 +135,14 @@ class TRACK_ORACLE_FILE_FORMATS_EXPORT file_format_manager
   // stored in each of the file_format_base derived objects
   static bool read( const std::string& fn, track_handle_list_type& tracks );
 
+  // read the tracks from many files, parsing up to n_threads files at a
+  // time (0 means one per core.)  The tracks are appended in the order of
+  // the files, as if each had been passed to read() in turn.  Returns false
+  // if any file fails to read; the tracks of the others are still returned.
+  static bool read_many( const std::vector< std::string >& fns,
+                         track_handle_list_type& tracks,
+                         size_t n_threads = 0 );
+
   // write the tracks to the file.  If explicit_format is not TF_INVALID_TYPE,
   // use that format regardless of filename; if it is TF_INVALID_TYPE, deduce the
   // format from the filename (failing unless we get exactly one matching format.)
@@ -154,6 +173,9 @@ class TRACK_ORACLE_FILE_FORMATS_EXPORT file_format_manager
 private:
 
   static file_format_manager_impl& get_instance();
+
+  // read() without recording the track source; f is set to the format read
+  static bool unrecorded_read( const std::string& fn, track_handle_list_type& tracks, file_format_enum& f );
   static file_format_manager_impl* impl;
 };
 
@@ -38,6 +38,7 @@ ::to_string( file_format_enum f )
   case TF_KWIVER:         return "kwiver";
   case TF_KPF_GEOM:       return "kpf-geom";
   case TF_KPF_ACT:       return "kpf-act";
+  case TF_KWIVER_SNAPSHOT: return "kwiver-snapshot";
   case TF_INVALID_TYPE:   return "invalid";
   }
   return "invalid";
@@ -63,6 +64,7 @@ ::from_string( const string& s )
   else if ( s == file_format_type::to_string( TF_KWIVER ))  return TF_KWIVER;
   else if ( s == file_format_type::to_string( TF_KPF_GEOM ))    return TF_KPF_GEOM;
   else if ( s == file_format_type::to_string( TF_KPF_ACT ))    return TF_KPF_ACT;
+  else if ( s == file_format_type::to_string( TF_KWIVER_SNAPSHOT ))  return TF_KWIVER_SNAPSHOT;
   else return TF_INVALID_TYPE;
 }
 
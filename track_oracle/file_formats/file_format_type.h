@@ -55,6 +55,7 @@ enum file_format_enum
   TF_KWIVER,
   TF_KPF_GEOM,
   TF_KPF_ACT,
+  TF_KWIVER_SNAPSHOT,
   TF_INVALID_TYPE   // must always be last entry
 };
 
@@ -44,6 +44,7 @@ apix_reader_opts&
 apix_reader_opts
 ::operator=( const file_format_reader_opts_base& rhs_base )
 {
+  file_format_reader_opts_base::operator=( rhs_base );
   const apix_reader_opts* rhs = dynamic_cast<const apix_reader_opts*>(&rhs_base);
 
   if (rhs)
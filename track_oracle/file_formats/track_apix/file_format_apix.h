@@ -20,7 +20,7 @@ struct TRACK_APIX_EXPORT apix_reader_opts: public file_format_reader_opts_base
 
   apix_reader_opts& set_verbose( bool v ) { this->verbose = v; return *this; }
   apix_reader_opts& operator=( const file_format_reader_opts_base& rhs );
-  virtual apix_reader_opts& reset() { set_verbose( false ); return *this; }
+  virtual apix_reader_opts& reset() { file_format_reader_opts_base::reset(); set_verbose( false ); return *this; }
   apix_reader_opts() { reset(); }
 };
 
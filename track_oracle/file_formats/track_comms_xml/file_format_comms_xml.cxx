@@ -140,6 +140,7 @@ comms_xml_reader_opts&
 comms_xml_reader_opts
 ::operator=( const file_format_reader_opts_base& rhs_base )
 {
+  file_format_reader_opts_base::operator=( rhs_base );
   const comms_xml_reader_opts* rhs = dynamic_cast<const comms_xml_reader_opts*>(&rhs_base);
 
   if (rhs)
@@ -173,16 +174,28 @@ ::read( const string& fn,
 {
   track_comms_xml_type comms_xml;
 
-  TiXmlDocument doc( fn.c_str() );
-  if ( ! doc.LoadFile() )
+  // stream the thRecv messages one at a time rather than loading the document
+  std::ifstream is( fn.c_str() );
+  if ( ! is )
   {
-    LOG_ERROR( main_logger, "COMMS XML file '" << fn << "': TinyXML failed to load document");
+    LOG_ERROR( main_logger, "COMMS XML file '" << fn << "': couldn't open");
     return false;
   }
+  xml_tokenizer::element_stream messages( is, "thRecv", vector< string >() );
+  string message_text;
 
-  TiXmlNode* thRecv = 0;
-  while( (thRecv = doc.IterateChildren( "thRecv", thRecv )) )
+  while( messages.next( message_text ))
   {
+    TiXmlDocument message_doc;
+    message_doc.Parse( message_text.c_str() );
+    if ( message_doc.Error() )
+    {
+      LOG_ERROR( main_logger, "COMMS XML file '" << fn << "': TinyXML failed to parse the message at line "
+                 << messages.line() << ": " << message_doc.ErrorDesc() );
+      return false;
+    }
+    TiXmlNode* thRecv = message_doc.RootElement();
+
     TiXmlNode* r = thRecv->FirstChild( "VIRATQueryResp" );
     if (!r) continue;
 
@@ -211,6 +224,12 @@ ::read( const string& fn,
     }
   }
 
+  if ( messages.failed() )
+  {
+    LOG_ERROR( main_logger, "COMMS XML file '" << fn << "': malformed XML");
+    return false;
+  }
+
   // all done!
   return true;
 
@@ -23,7 +23,7 @@ struct TRACK_COMMS_XML_EXPORT comms_xml_reader_opts: public file_format_reader_o
 
   comms_xml_reader_opts& set_comms_qid( const std::string& s ) { this->comms_qid = s; return *this; }
   comms_xml_reader_opts& operator=( const file_format_reader_opts_base& rhs_base );
-  virtual comms_xml_reader_opts& reset() { set_comms_qid( "" ); return *this; }
+  virtual comms_xml_reader_opts& reset() { file_format_reader_opts_base::reset(); set_comms_qid( "" ); return *this; }
   comms_xml_reader_opts() { reset(); }
 };
 
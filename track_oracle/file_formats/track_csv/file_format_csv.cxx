@@ -78,16 +78,14 @@ struct redundant_object_helper_type
   // then copy over into local header-value maps and parse directly into the
   // row.
 
-  redundant_object_helper_type()
+  // Objects outside the reader's projection are left null and skipped.
+
+  explicit redundant_object_helper_type( const file_format_reader_opts_base& opts )
   {
-    field_handle_type world_location_fh = track_oracle_core::lookup_by_name( dt::tracking::world_location::c.name );
-    this->world_location_store = track_oracle_core::get_mutable_element_store_base( world_location_fh );
-    field_handle_type obj_location_fh = track_oracle_core::lookup_by_name( dt::tracking::obj_location::c.name );
-    this->obj_location_store = track_oracle_core::get_mutable_element_store_base( obj_location_fh );
-    field_handle_type bounding_box_fh = track_oracle_core::lookup_by_name( dt::tracking::bounding_box::c.name );
-    this->bounding_box_store = track_oracle_core::get_mutable_element_store_base( bounding_box_fh );
-    field_handle_type track_uuid_fh = track_oracle_core::lookup_by_name( dt::tracking::track_uuid::c.name );
-    this->track_uuid_store = track_oracle_core::get_mutable_element_store_base( track_uuid_fh );
+    this->world_location_store = projected_store( dt::tracking::world_location::c.name, opts );
+    this->obj_location_store = projected_store( dt::tracking::obj_location::c.name, opts );
+    this->bounding_box_store = projected_store( dt::tracking::bounding_box::c.name, opts );
+    this->track_uuid_store = projected_store( dt::tracking::track_uuid::c.name, opts );
   }
 
   void apply_at_row( oracle_entry_handle_type row,
@@ -110,7 +108,7 @@ struct redundant_object_helper_type
         (world_xyz_probes[1] != header_value_map.end()) &&
         (! world_xyz_probes[1]->second.empty() ));
 
-    if ( have_world_xy )
+    if ( have_world_xy && this->world_location_store )
     {
       map<string, string> local_hv_map;
       local_hv_map[ "world_location_x" ] = world_xyz_probes[0]->second;
@@ -135,7 +133,7 @@ struct redundant_object_helper_type
         (obj_xy_probes[1] != header_value_map.end()) &&
         (! obj_xy_probes[1]->second.empty()) );
 
-    if ( have_obj_xy )
+    if ( have_obj_xy && this->obj_location_store )
     {
       map<string, string> local_hv_map;
       local_hv_map[ "obj_location_x" ] = obj_xy_probes[0]->second;
@@ -160,7 +158,7 @@ struct redundant_object_helper_type
         && (bbox_probes[i] != header_value_map.end())
         && ( ! bbox_probes[i]->second.empty() );
     }
-    if ( have_bbox )
+    if ( have_bbox && this->bounding_box_store )
     {
       map<string, string> local_hv_map;
       local_hv_map[ "bounding_box_ul_x" ] = bbox_probes[0]->second;
@@ -176,7 +174,8 @@ struct redundant_object_helper_type
 
     map<string, string>::const_iterator unique_id_probe = header_value_map.find( "unique_id" );
     if ( ( unique_id_probe != header_value_map.end() )
-         && (! unique_id_probe->second.empty() ))
+         && (! unique_id_probe->second.empty() )
+         && this->track_uuid_store )
     {
       map<string, string> local_hv_map;
       local_hv_map[ "track_uuid" ] = unique_id_probe->second;
@@ -186,6 +185,12 @@ struct redundant_object_helper_type
   }
 
 private:
+  static element_store_base* projected_store( const string& name, const file_format_reader_opts_base& opts )
+  {
+    field_handle_type fh = track_oracle_core::lookup_by_name( name );
+    return opts.loads_field( fh ) ? track_oracle_core::get_mutable_element_store_base( fh ) : 0;
+  }
+
   element_store_base* world_location_store;
   element_store_base* obj_location_store;
   element_store_base* bounding_box_store;
@@ -329,12 +334,26 @@ ::internal_stream_read( istream& is, size_t file_size, track_handle_list_type& t
 
   csv_handler_map_type m = track_oracle_core::get_csv_handler_map( headers );
 
+  // drop the columns outside the projection (if any); the sequence and
+  // frame columns above are still used to assemble the tracks
+  for (csv_handler_map_type::iterator i = m.begin(); i != m.end(); )
+  {
+    if ( this->null_opts.loads_field( i->first ))
+    {
+      ++i;
+    }
+    else
+    {
+      m.erase( i++ );
+    }
+  }
+
   // key is either _track_sequence (new-style) or external-id (old-style)
   map< size_t, track_handle_type > sequence_to_handle_map;
   track_handle_type current_track_handle;
 
   // various legacy hacks
-  redundant_object_helper_type redundant_object_helper;
+  redundant_object_helper_type redundant_object_helper( this->null_opts );
 
   // use the schema object mostly as a proxy to create tracks and frames
   track_csv_type track;
@@ -133,6 +133,37 @@ struct kw18_line_parser
   }
 };
 
+// which of the kw18 frame fields the reader stores; the external ID is
+// always stored, since it groups the lines into tracks
+
+struct kw18_projection
+{
+  bool fg_mask_area, track_location, obj_x, obj_y, obj_location;
+  bool velocity_x, velocity_y, bounding_box;
+  bool world_x, world_y, world_z, world_location;
+  bool timestamp_usecs, frame_number, relevancy;
+
+  kw18_projection( const ::kwiver::track_oracle::track_kw18_type& kw18,
+                   const ::kwiver::track_oracle::track_field< double >& relevancy_field,
+                   const ::kwiver::track_oracle::kw18_reader_opts& opts )
+    : fg_mask_area( opts.loads_field( kw18.fg_mask_area.get_field_handle() )),
+      track_location( opts.loads_field( kw18.track_location.get_field_handle() )),
+      obj_x( opts.loads_field( kw18.obj_x.get_field_handle() )),
+      obj_y( opts.loads_field( kw18.obj_y.get_field_handle() )),
+      obj_location( opts.loads_field( kw18.obj_location.get_field_handle() )),
+      velocity_x( opts.loads_field( kw18.velocity_x.get_field_handle() )),
+      velocity_y( opts.loads_field( kw18.velocity_y.get_field_handle() )),
+      bounding_box( opts.loads_field( kw18.bounding_box.get_field_handle() )),
+      world_x( opts.loads_field( kw18.world_x.get_field_handle() )),
+      world_y( opts.loads_field( kw18.world_y.get_field_handle() )),
+      world_z( opts.loads_field( kw18.world_z.get_field_handle() )),
+      world_location( opts.loads_field( kw18.world_location.get_field_handle() )),
+      timestamp_usecs( opts.loads_field( kw18.timestamp_usecs.get_field_handle() )),
+      frame_number( opts.loads_field( kw18.frame_number.get_field_handle() )),
+      relevancy( opts.loads_field( relevancy_field.get_field_handle() ))
+  {}
+};
+
 template< typename T >
 typename ::kwiver::track_oracle::track_field<T>::Type
 logged_get_field( ::kwiver::track_oracle::track_field<T>& tf,
@@ -176,6 +207,7 @@ kw18_reader_opts&
 kw18_reader_opts
 ::operator=( const file_format_reader_opts_base& rhs_base )
 {
+  file_format_reader_opts_base::operator=( rhs_base );
   const kw18_reader_opts* rhs = dynamic_cast< const kw18_reader_opts*>( &rhs_base );
   if (rhs)
   {
@@ -240,6 +272,7 @@ ::internal_stream_read( istream& is,
   string tmp;
   kw18_line_parser p( this->opts );
   track_field< double > relevancy( "relevancy" );
+  const kw18_projection load( kw18, relevancy, this->opts );
 
   bool current_external_id_valid = false;
   unsigned current_external_id = 0;
@@ -291,32 +324,35 @@ ::internal_stream_read( istream& is,
 
     frame_handle_type current_frame = kw18.create_frame();
 
-    kw18[ current_frame ].fg_mask_area() = p.area;
-    kw18[ current_frame ].frame_number() = static_cast<unsigned>( p.dbl_frame_num );
+    if ( load.fg_mask_area ) kw18[ current_frame ].fg_mask_area() = p.area;
+    if ( load.frame_number ) kw18[ current_frame ].frame_number() = static_cast<unsigned>( p.dbl_frame_num );
 
     // if timestamp < 0 (usually == -1), do not set!
-    if (p.timestamp >= 0)
+    if ( load.timestamp_usecs && (p.timestamp >= 0))
     {
       kw18[ current_frame ].timestamp_usecs() =
         static_cast<unsigned long long>( p.timestamp * 1000 * 1000 );
     }
-    kw18[ current_frame ].track_location() = vgl_point_2d<double>( p.loc_x, p.loc_y );
-    kw18[ current_frame ].velocity_x() = p.vel_x;
-    kw18[ current_frame ].velocity_y() = p.vel_y;
-    kw18[ current_frame ].obj_x() = p.obj_loc_x;
-    kw18[ current_frame ].obj_y() = p.obj_loc_y;
-    kw18[ current_frame ].obj_location() = vgl_point_2d<double>( p.obj_loc_x, p.obj_loc_y );
-    kw18[ current_frame ].bounding_box() =
-      vgl_box_2d<double>(
-        vgl_point_2d<double>( p.bb_c1_x, p.bb_c1_y ),
-        vgl_point_2d<double>( p.bb_c2_x, p.bb_c2_y ));
-    kw18[ current_frame ].world_x() = p.world_x;
-    kw18[ current_frame ].world_y() = p.world_y;
-    kw18[ current_frame ].world_z() = p.world_z;
-    kw18[ current_frame ].world_location() = vgl_point_3d<double>( p.world_x, p.world_y, p.world_z );
+    if ( load.track_location ) kw18[ current_frame ].track_location() = vgl_point_2d<double>( p.loc_x, p.loc_y );
+    if ( load.velocity_x ) kw18[ current_frame ].velocity_x() = p.vel_x;
+    if ( load.velocity_y ) kw18[ current_frame ].velocity_y() = p.vel_y;
+    if ( load.obj_x ) kw18[ current_frame ].obj_x() = p.obj_loc_x;
+    if ( load.obj_y ) kw18[ current_frame ].obj_y() = p.obj_loc_y;
+    if ( load.obj_location ) kw18[ current_frame ].obj_location() = vgl_point_2d<double>( p.obj_loc_x, p.obj_loc_y );
+    if ( load.bounding_box )
+    {
+      kw18[ current_frame ].bounding_box() =
+        vgl_box_2d<double>(
+          vgl_point_2d<double>( p.bb_c1_x, p.bb_c1_y ),
+          vgl_point_2d<double>( p.bb_c2_x, p.bb_c2_y ));
+    }
+    if ( load.world_x ) kw18[ current_frame ].world_x() = p.world_x;
+    if ( load.world_y ) kw18[ current_frame ].world_y() = p.world_y;
+    if ( load.world_z ) kw18[ current_frame ].world_z() = p.world_z;
+    if ( load.world_location ) kw18[ current_frame ].world_location() = vgl_point_3d<double>( p.world_x, p.world_y, p.world_z );
 
     // kw19 hacks
-    if (this->opts.kw19_hack)
+    if ( this->opts.kw19_hack && load.relevancy )
     {
       relevancy( current_frame.row ) = p.kw19;
     }
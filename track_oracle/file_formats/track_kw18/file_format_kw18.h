@@ -20,7 +20,7 @@ struct TRACK_KW18_EXPORT kw18_reader_opts: public file_format_reader_opts_base
 
   kw18_reader_opts& set_kw19_hack( bool b ) { this->kw19_hack = b; return *this; }
 
-  virtual kw18_reader_opts& reset() { set_kw19_hack( false ); return *this; }
+  virtual kw18_reader_opts& reset() { file_format_reader_opts_base::reset(); set_kw19_hack( false ); return *this; }
   kw18_reader_opts() { reset(); }
   kw18_reader_opts& operator=( const file_format_reader_opts_base& rhs );
 };
@@ -0,0 +1,82 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "file_format_kwiver_snapshot.h"
+
+#include <fstream>
+#include <iterator>
+
+#include <track_oracle/core/track_oracle_core.h>
+
+#include <vital/util/mapped_file.h>
+
+#include <vital/logger/logger.h>
+static kwiver::vital::logger_handle_t main_logger( kwiver::vital::get_logger( __FILE__ ) );
+
+using std::ifstream;
+using std::istream;
+using std::istreambuf_iterator;
+using std::ofstream;
+using std::ostream;
+using std::string;
+
+namespace kwiver {
+namespace track_oracle {
+
+bool
+file_format_kwiver_snapshot
+::inspect_file( const string& fn ) const
+{
+  ifstream is( fn.c_str(), ifstream::binary );
+  char magic[8];
+  return is.read( magic, sizeof( magic )) && ( string( magic, sizeof( magic )) == "KWTOSNAP" );
+}
+
+bool
+file_format_kwiver_snapshot
+::read( const string& fn,
+        track_handle_list_type& tracks ) const
+{
+  ::kwiver::vital::mapped_file f;
+  if ( ! f.open( fn ))
+  {
+    LOG_ERROR( main_logger, "Couldn't map kwiver snapshot '" << fn << "'" );
+    return false;
+  }
+  if ( ! track_oracle_core::read_snapshot( f.data(), f.size(), tracks ))
+  {
+    LOG_ERROR( main_logger, "Couldn't read kwiver snapshot '" << fn << "'" );
+    return false;
+  }
+  return true;
+}
+
+bool
+file_format_kwiver_snapshot
+::read( istream& is,
+        track_handle_list_type& tracks ) const
+{
+  string data( (istreambuf_iterator<char>( is )), istreambuf_iterator<char>() );
+  return track_oracle_core::read_snapshot( data.data(), data.size(), tracks );
+}
+
+bool
+file_format_kwiver_snapshot
+::write( const string& fn,
+         const track_handle_list_type& tracks ) const
+{
+  ofstream ofs( fn.c_str(), ofstream::binary );
+  return ofs && this->write( ofs, tracks );
+}
+
+bool
+file_format_kwiver_snapshot
+::write( ostream& os,
+         const track_handle_list_type& tracks ) const
+{
+  return track_oracle_core::write_snapshot( os, tracks );
+}
+
+} // ...track_oracle
+} // ...kwiver
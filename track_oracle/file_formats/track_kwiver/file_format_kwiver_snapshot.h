@@ -0,0 +1,64 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef INCL_FILE_FORMAT_KWIVER_SNAPSHOT_H
+#define INCL_FILE_FORMAT_KWIVER_SNAPSHOT_H
+
+///
+/// Binary snapshots of track_oracle tracks; see
+/// track_oracle_core::write_snapshot.  Files are memory-mapped for
+/// reading, so processes loading the same snapshot share its pages in
+/// the page cache.
+///
+
+#include <vital/vital_config.h>
+#include <track_oracle/file_formats/track_kwiver/track_kwiver_export.h>
+
+#include <track_oracle/file_formats/file_format_base.h>
+#include <track_oracle/file_formats/track_kwiver/track_kwiver.h>
+
+namespace kwiver {
+namespace track_oracle {
+
+class TRACK_KWIVER_EXPORT file_format_kwiver_snapshot: public file_format_base
+{
+public:
+  file_format_kwiver_snapshot(): file_format_base( TF_KWIVER_SNAPSHOT, "Kitware kwiver binary snapshot" )
+  {
+    this->globs.push_back( "*.kwsnap" );
+  }
+  virtual ~file_format_kwiver_snapshot() {}
+
+  virtual int supported_operations() const { return FF_READ | FF_WRITE; }
+
+  // return a dynamically-allocated instance of the schema
+  virtual track_base_impl* schema_instance() const { return new track_kwiver_type(); }
+
+  // Inspect the file and return true if it is of this format
+  virtual bool inspect_file( const std::string& fn ) const;
+
+  using file_format_base::read;
+
+  // read tracks from the file
+  virtual bool read( const std::string& fn,
+                     track_handle_list_type& tracks ) const;
+
+  // read tracks from a stream
+  virtual bool read( std::istream& is,
+                     track_handle_list_type& tracks ) const;
+
+  // write tracks to the file
+  virtual bool write( const std::string& fn,
+                      const track_handle_list_type& tracks ) const;
+
+  // write tracks to a stream
+  virtual bool write( std::ostream& os,
+                      const track_handle_list_type& tracks ) const;
+
+};
+
+} // ...track_oracle
+} // ...kwiver
+
+#endif
@@ -19,6 +19,7 @@
 #include <vital/logger/logger.h>
 static kwiver::vital::logger_handle_t main_logger( kwiver::vital::get_logger( __FILE__ ) );
 
+using std::ifstream;
 using std::istringstream;
 using std::map;
 using std::ofstream;
@@ -59,6 +60,7 @@ kwxml_reader_opts&
 kwxml_reader_opts
 ::operator=( const file_format_reader_opts_base& rhs_base )
 {
+  file_format_reader_opts_base::operator=( rhs_base );
   const kwxml_reader_opts* rhs = dynamic_cast<const kwxml_reader_opts*>(&rhs_base);
 
   if (rhs)
@@ -90,42 +92,33 @@ file_format_kwxml
 ::read( const string& fn,
         track_handle_list_type& tracks ) const
 {
-  // dig through the XML wrappers...
+  // Stream the track elements one at a time rather than loading the
+  // document.  The queryResults.xml files don't have a root node, and just
+  // have a series of "track" nodes, so look for tracks at any depth.
 
-  LOG_INFO( main_logger, "TinyXML loading '" << fn << "': start" );
-  TiXmlDocument doc( fn.c_str() );
-  TiXmlHandle doc_handle( &doc );
-  if ( ! doc.LoadFile() )
+  ifstream is( fn.c_str() );
+  if ( ! is )
   {
-    LOG_ERROR( main_logger,"TinyXML (KWXML) couldn't load '" << fn << "'; skipping\n");
+    LOG_ERROR( main_logger,"Couldn't open '" << fn << "'; skipping\n");
     return false;
   }
-  LOG_INFO( main_logger, "TinyXML loading '" << fn << "': complete" );
+  xml_tokenizer::element_stream track_elements( is, "track" );
+  string track_text;
 
-  TiXmlNode* xml_root = doc.RootElement();
-  if ( ! xml_root )
-  {
-    LOG_ERROR( main_logger,"Couldn't load root element from '" << fn << "'; skipping\n");
-    return false;
-  }
-  // The queryResults.xml files don't have a root node, and just have
-  // a series of "track" nodes. Luckily, tinyXML will happily deal
-  // with these malformed "xml" files: we just have to treat the
-  // document as the root node.
-  if ( string("track") == xml_root->Value() )
-  {
-    xml_root = &doc;
-  }
-
-  TiXmlNode* xml_track_objects = 0;
   track_kwxml_type kwxml;
   logging_map_type wmap( main_logger, KWIVER_LOGGER_SITE );
 
-  while( (xml_track_objects = xml_root->IterateChildren( xml_track_objects )) )
+  while ( track_elements.next( track_text ))
   {
-    // only interested in track nodes
-    const string object_str("track");
-    if (xml_track_objects->Value() != object_str) continue;
+    TiXmlDocument track_doc;
+    track_doc.Parse( track_text.c_str() );
+    if ( track_doc.Error() )
+    {
+      LOG_ERROR( main_logger,"TinyXML (KWXML) couldn't parse the track at line " << track_elements.line()
+                 << " of '" << fn << "': " << track_doc.ErrorDesc() << "; skipping\n");
+      return false;
+    }
+    TiXmlNode* xml_track_objects = track_doc.RootElement();
 
     // The frameNumberOrigin and offset variables are deprecated and no longer
     // used. Therefore, we won go through the problem of reading them.
@@ -991,6 +984,12 @@ ::read( const string& fn,
 
   wmap.dump_msgs();
 
+  if ( track_elements.failed() )
+  {
+    LOG_ERROR( main_logger,"Malformed XML in '" << fn << "'\n");
+    return false;
+  }
+
   // all done!
   return true;
 
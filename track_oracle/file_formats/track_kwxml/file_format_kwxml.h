@@ -24,7 +24,7 @@ struct TRACK_KWXML_EXPORT kwxml_reader_opts: public file_format_reader_opts_base
     return *this;
   }
   kwxml_reader_opts& operator=( const file_format_reader_opts_base& rhs_base );
-  virtual kwxml_reader_opts& reset() { set_track_style_filter( "" ); return *this; }
+  virtual kwxml_reader_opts& reset() { file_format_reader_opts_base::reset(); set_track_style_filter( "" ); return *this; }
   kwxml_reader_opts(){ reset(); }
 };
 
@@ -31,7 +31,7 @@ struct TRACK_KWXML_EXPORT track_kwxml_type: public track_base< track_kwxml_type
   track_field< unsigned >& video_id;
   track_field< std::string >& time_stamp;
   track_field< dt::events::source_track_ids> source_track_ids;
-  track_field< std::string >& track_style;
+  track_field< string_symbol >& track_style;
 
   // part of the great Track Unification Effort
   // ...xgtf
@@ -86,7 +86,7 @@ struct TRACK_KWXML_EXPORT track_kwxml_type: public track_base< track_kwxml_type
   track_kwxml_type():
     video_id( Track.add_field< unsigned >("video_id")),
     time_stamp( Track.add_field< std::string >("time_stamp_str")),
-    track_style(Track.add_field< std::string >("track_style")),
+    track_style(Track.add_field< string_symbol >("track_style")),
 
     activity(Track.add_field< int >("activity")),
     activity_probability(Track.add_field< double >("activity_probability")),
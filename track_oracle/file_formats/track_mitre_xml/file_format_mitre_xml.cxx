@@ -40,28 +40,27 @@ ::read( const string& fn,
 {
   track_mitre_xml_type mitre_xml;
 
-  TiXmlDocument doc( fn.c_str() );
-  if ( ! doc.LoadFile() )
+  // stream the children of the root (the frames) one at a time rather than
+  // loading the document
+  std::ifstream is( fn.c_str() );
+  if ( ! is )
   {
-    LOG_ERROR( main_logger, "MITRE XML file '" << fn << "': TinyXML failed to load document");
+    LOG_ERROR( main_logger, "MITRE XML file '" << fn << "': couldn't open");
     return false;
   }
+  xml_tokenizer::element_stream frames( is, "*", vector< string >( 1, "*" ));
+  string frame_text;
 
-  TiXmlNode* xmlRoot = doc.RootElement();
-  if ( ! xmlRoot )
-  {
-    LOG_INFO( main_logger, "MITRE XML file '" << fn << "': TinyXML found no root node?");
-    return false;
-  }
-
-  TiXmlNode* xmlTrackObjects = 0;
   bool first_loop = true;
-  while( (xmlTrackObjects = xmlRoot->IterateChildren( xmlTrackObjects )) )
+  while( frames.next( frame_text ))
   {
-    TiXmlElement* e = xmlTrackObjects->ToElement();
-    if (!e)
+    TiXmlDocument frame_doc;
+    frame_doc.Parse( frame_text.c_str() );
+    TiXmlElement* e = frame_doc.RootElement();
+    if ( frame_doc.Error() || !e )
     {
-      LOG_ERROR( main_logger, "MITRE XML file '" << fn << "': TinyXML couldn't cast to element?");
+      LOG_ERROR( main_logger, "MITRE XML file '" << fn << "': TinyXML failed to parse the element at line "
+                 << frames.line() );
       return false;
     }
 
@@ -71,27 +70,27 @@ ::read( const string& fn,
     // Get the data from the element...
     if (e->QueryIntAttribute( "frameNumber", &frameNumber) != TIXML_SUCCESS)
     {
-      LOG_INFO( main_logger, "MITRE XML file '" << fn << "': row " << e->Row() << ": no frameNumber?");
+      LOG_INFO( main_logger, "MITRE XML file '" << fn << "': line " << frames.line() << ": no frameNumber?");
       return false;
     }
     if (e->QueryDoubleAttribute( "height", &height ) != TIXML_SUCCESS )
     {
-      LOG_INFO( main_logger, "MITRE XML file '" << fn << "': row " << e->Row() << ": no height?");
+      LOG_INFO( main_logger, "MITRE XML file '" << fn << "': line " << frames.line() << ": no height?");
       return false;
       }
     if (e->QueryDoubleAttribute( "width", &width ) != TIXML_SUCCESS )
     {
-      LOG_INFO( main_logger, "MITRE XML file '" << fn << "': row " << e->Row() << ": no width?");
+      LOG_INFO( main_logger, "MITRE XML file '" << fn << "': line " << frames.line() << ": no width?");
       return false;
     }
     if (e->QueryDoubleAttribute( "x", &x ) != TIXML_SUCCESS )
     {
-      LOG_INFO( main_logger, "MITRE XML file '" << fn << "': row " << e->Row() << ": no x?");
+      LOG_INFO( main_logger, "MITRE XML file '" << fn << "': line " << frames.line() << ": no x?");
       return false;
     }
     if (e->QueryDoubleAttribute( "y", &y ) != TIXML_SUCCESS )
     {
-      LOG_INFO( main_logger, "MITRE XML file '" << fn << "': row " << e->Row() << ": no y?");
+      LOG_INFO( main_logger, "MITRE XML file '" << fn << "': line " << frames.line() << ": no y?");
       return false;
     }
 
@@ -111,6 +110,12 @@ ::read( const string& fn,
 
   } // ...while more frames
 
+  if ( frames.failed() )
+  {
+    LOG_ERROR( main_logger, "MITRE XML file '" << fn << "': malformed XML");
+    return false;
+  }
+
   // all done!
   return true;
 
@@ -526,34 +526,6 @@ extract_viper_activities( const named_nodes_t& named_nodes,
   return true;
 }
 
-xml_node_t*
-doc_to_source_node( const string& filename, xml_document_t& doc )
-{
-  xml_node_t* xml_root = doc.RootElement();
-  if ( !xml_root )
-  {
-    LOG_ERROR( main_logger, "Couldn't load root element from '" << filename << "'; skippig" );
-    return 0;
-  }
-
-  xml_node_t* xml_data = xml_root->FirstChild( "data" );
-  if ( !xml_data )
-  {
-    LOG_ERROR( main_logger, "Couldn't find the 'data' child in '" << filename << "'; skipping" );
-    return 0;
-  }
-
-  // ...down to the sourcefile node.  For now, assume a single sourcefile
-  xml_node_t* xml_source = xml_data->FirstChild( "sourcefile" );
-  if ( !xml_source )
-  {
-    LOG_ERROR( main_logger, "Couldn't find the 'sourcefile' child in '" << filename << "'; skipping" );
-    return 0;
-  }
-
-  return xml_source;
-}
-
 } // anon
 
 namespace kwiver {
@@ -563,6 +535,7 @@ xgtf_reader_opts&
 xgtf_reader_opts
 ::operator=( const file_format_reader_opts_base& rhs_base )
 {
+  file_format_reader_opts_base::operator=( rhs_base );
   const xgtf_reader_opts* rhs = dynamic_cast<const xgtf_reader_opts*>(&rhs_base);
 
   if (rhs)
@@ -604,34 +577,37 @@ ::read( const string& fn,
 
   tracks.clear();
 
-  // dig through the XML wrappers...
-  xml_document_t doc( fn.c_str() );
-  xml_handle_t doc_handle( &doc );
-
-  if ( !doc.LoadFile() )
-  {
-    LOG_ERROR( main_logger, "TinyXML couldn't load '" << fn << "'; skipping" );
-    LOG_ERROR( main_logger, "Error description: " << doc.ErrorDesc() );
-    LOG_ERROR( main_logger, "Error location: row " << doc.ErrorRow() << "; col " << doc.ErrorCol() );
-    return false;
-  }
-
-  xml_node_t* xml_source = doc_to_source_node( fn, doc );
-
-  if ( !xml_source )
+  // Stream the objects of the sourcefile one at a time rather than loading
+  // the document.  For now, assume a single sourcefile.
+  std::ifstream is( fn.c_str() );
+  if ( !is )
   {
+    LOG_ERROR( main_logger, "Couldn't open '" << fn << "'; skipping" );
     return false;
   }
+  xml_tokenizer::element_stream objects( is, "object", { "*", "data", "sourcefile" } );
+  string object_text;
 
   // does this xml file contain activity or appearance annotations?
   xgtf_style style = ACTIVITY;
 
-  xml_node_t* xml_viper_object = 0;
-  while ( ( xml_viper_object = xml_source->IterateChildren( xml_viper_object ) ) )
+  while ( objects.next( object_text ) )
   {
-    // only interested in Object nodes
-    const string object_str( "object" );
-    if ( xml_viper_object->Value() != object_str ) continue;
+    if ( objects.parent_index() > 0 )
+    {
+      break;
+    }
+
+    xml_document_t object_doc;
+    object_doc.Parse( object_text.c_str() );
+    if ( object_doc.Error() )
+    {
+      LOG_ERROR( main_logger, "TinyXML couldn't parse the object at line " << objects.line()
+                 << " of '" << fn << "'; skipping" );
+      LOG_ERROR( main_logger, "Error description: " << object_doc.ErrorDesc() );
+      return false;
+    }
+    xml_node_t* xml_viper_object = object_doc.RootElement();
 
     //
     // Consider the VIPER format.  Each child of a sourcefile has:
@@ -821,7 +797,13 @@ ::read( const string& fn,
     // 7) Delete the original track we saved in track_oracle...
     // double-check    xgtf(this_track).remove_me();
 
-  } // ...for each sourcefile
+  } // ...for each object
+
+  if ( objects.failed() )
+  {
+    LOG_ERROR( main_logger, "Malformed XML in '" << fn << "'" );
+    return false;
+  }
 
   if ( !warnings.empty() )
   {
@@ -20,7 +20,7 @@ struct TRACK_XGTF_EXPORT xgtf_reader_opts: public file_format_reader_opts_base
 
   xgtf_reader_opts& set_promote_pvmoving( bool p ) { this->promote_pvmoving = p; return *this; }
   xgtf_reader_opts& operator=( const file_format_reader_opts_base& rhs_base );
-  virtual xgtf_reader_opts& reset() { set_promote_pvmoving( false ); return *this; }
+  virtual xgtf_reader_opts& reset() { file_format_reader_opts_base::reset(); set_promote_pvmoving( false ); return *this; }
   xgtf_reader_opts() { reset(); }
 };
 
@@ -0,0 +1,287 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "track_overlap.h"
+
+#include <track_oracle/core/track_oracle_core.h>
+#include <track_oracle/core/track_oracle_frame_index.h>
+#include <track_oracle/core/track_field.h>
+#include <track_oracle/data_terms/data_terms.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+using std::make_pair;
+using std::max;
+using std::min;
+using std::pair;
+using std::vector;
+
+namespace // anon
+{
+
+namespace to = ::kwiver::track_oracle;
+
+struct frame_entry
+{
+  unsigned long long t;
+  bool has_box;
+  vgl_box_2d< double > box;
+
+  bool operator<( const frame_entry& rhs ) const { return this->t < rhs.t; }
+};
+
+bool
+earlier_than( const frame_entry& e, unsigned long long t )
+{
+  return e.t < t;
+}
+
+struct track_frames
+{
+  // sorted by time
+  vector< frame_entry > frames;
+  // the box covering all the frame boxes; empty if there are none
+  vgl_box_2d< double > extent;
+};
+
+class frame_reader
+{
+public:
+  explicit frame_reader( to::track_overlap_options::time_key_type k ): key( k ) {}
+
+  track_frames read( const to::track_handle_type& t ) const;
+
+private:
+  to::track_overlap_options::time_key_type key;
+  to::track_field< to::dt::tracking::timestamp_usecs > timestamp_usecs;
+  to::track_field< to::dt::tracking::frame_number > frame_number;
+  to::track_field< to::dt::tracking::bounding_box > bounding_box;
+};
+
+track_frames
+frame_reader
+::read( const to::track_handle_type& t ) const
+{
+  track_frames ret;
+  const to::frame_handle_list_type frames = to::track_oracle_core::get_frames( t );
+  ret.frames.reserve( frames.size() );
+  for (size_t i=0; i<frames.size(); ++i)
+  {
+    frame_entry e;
+    if ( this->key == to::track_overlap_options::TIMESTAMP_USECS )
+    {
+      pair< bool, unsigned long long > p = this->timestamp_usecs.get( frames[i].row );
+      if ( ! p.first ) continue;
+      e.t = p.second;
+    }
+    else
+    {
+      pair< bool, unsigned > p = this->frame_number.get( frames[i].row );
+      if ( ! p.first ) continue;
+      e.t = p.second;
+    }
+
+    pair< bool, vgl_box_2d< double > > b = this->bounding_box.get( frames[i].row );
+    e.has_box = b.first && ( ! b.second.is_empty() );
+    if ( e.has_box )
+    {
+      e.box = b.second;
+      ret.extent =
+        ret.extent.is_empty()
+        ? e.box
+        : vgl_box_2d< double >( min( ret.extent.min_x(), e.box.min_x() ), max( ret.extent.max_x(), e.box.max_x() ),
+                                min( ret.extent.min_y(), e.box.min_y() ), max( ret.extent.max_y(), e.box.max_y() ));
+    }
+    ret.frames.push_back( e );
+  }
+  std::stable_sort( ret.frames.begin(), ret.frames.end() );
+  return ret;
+}
+
+//
+// Walk the two frame lists in time order from the start of their common
+// span, measuring the frames at the same time.  Returns true if any
+// matched.
+//
+
+bool
+merge_frames( const track_frames& a, const track_frames& b, double min_iou, to::track_pair_overlap& o )
+{
+  if ( a.frames.empty() || b.frames.empty() ||
+       ( a.frames.back().t < b.frames.front().t ) ||
+       ( b.frames.back().t < a.frames.front().t ))
+  {
+    return false;
+  }
+
+  vector< frame_entry >::const_iterator i =
+    std::lower_bound( a.frames.begin(), a.frames.end(), b.frames.front().t, earlier_than );
+  vector< frame_entry >::const_iterator j =
+    std::lower_bound( b.frames.begin(), b.frames.end(), a.frames.front().t, earlier_than );
+  while ( ( i != a.frames.end() ) && ( j != b.frames.end() ))
+  {
+    if ( i->t < j->t )
+    {
+      ++i;
+    }
+    else if ( j->t < i->t )
+    {
+      ++j;
+    }
+    else
+    {
+      double iou = ( i->has_box && j->has_box ) ? to::box_iou( i->box, j->box ) : 0.0;
+      ++o.n_common_frames;
+      o.iou_sum += iou;
+      if ( ( iou > 0.0 ) && ( iou >= min_iou ))
+      {
+        if ( o.n_matched_frames++ == 0 )
+        {
+          o.first_matched = i->t;
+        }
+        o.last_matched = i->t;
+      }
+      ++i;
+      ++j;
+    }
+  }
+  return ( o.n_matched_frames > 0 );
+}
+
+//
+// Call f(i) for each i in [0, n) from n_threads threads; the first
+// exception thrown stops the workers and is rethrown here.
+//
+
+template< typename F >
+void
+parallel_for( size_t n, size_t n_threads, F f )
+{
+  std::atomic< size_t > next( 0 );
+  std::exception_ptr error;
+  std::mutex error_lock;
+
+  auto worker = [&]()
+  {
+    try
+    {
+      for (size_t i = next++; i < n; i = next++)
+      {
+        f( i );
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard< std::mutex > lock( error_lock );
+      if ( ! error )
+      {
+        error = std::current_exception();
+      }
+      next = n;
+    }
+  };
+
+  vector< std::thread > threads;
+  for (size_t i=1; i<min( n_threads, n ); ++i)
+  {
+    threads.push_back( std::thread( worker ));
+  }
+  worker();
+  for (auto& t: threads)
+  {
+    t.join();
+  }
+  if ( error )
+  {
+    std::rethrow_exception( error );
+  }
+}
+
+} // anon
+
+namespace kwiver {
+namespace track_oracle {
+
+double
+box_iou( const vgl_box_2d< double >& a, const vgl_box_2d< double >& b )
+{
+  if ( a.is_empty() || b.is_empty() )
+  {
+    return 0.0;
+  }
+  double w = min( a.max_x(), b.max_x() ) - max( a.min_x(), b.min_x() );
+  double h = min( a.max_y(), b.max_y() ) - max( a.min_y(), b.min_y() );
+  if ( ( w <= 0.0 ) || ( h <= 0.0 ))
+  {
+    return 0.0;
+  }
+  double i = w * h;
+  double u = ( a.width() * a.height() ) + ( b.width() * b.height() ) - i;
+  return ( u > 0.0 ) ? ( i / u ) : 0.0;
+}
+
+vector< track_pair_overlap >
+compute_track_overlaps( const track_handle_list_type& truth,
+                        const track_handle_list_type& computed,
+                        const track_overlap_options& opts )
+{
+  const size_t n_threads =
+    ( opts.n_threads == 0 )
+    ? max( std::thread::hardware_concurrency(), 1u )
+    : opts.n_threads;
+
+  // read every track's frames once
+  const frame_reader reader( opts.time_key );
+  vector< track_frames > truth_frames( truth.size() ), computed_frames( computed.size() );
+  parallel_for( truth.size() + computed.size(), n_threads, [&]( size_t i ) {
+      if ( i < truth.size() )
+      {
+        truth_frames[i] = reader.read( truth[i] );
+      }
+      else
+      {
+        computed_frames[ i - truth.size() ] = reader.read( computed[ i - truth.size() ] );
+      }
+    } );
+
+  // the grid holds the index of each computed track with a box; a track
+  // with none can't match anything
+  vector< frame_box_grid::entry_type > extents;
+  for (size_t i=0; i<computed.size(); ++i)
+  {
+    extents.push_back( make_pair( computed_frames[i].extent, static_cast< oracle_entry_handle_type >( i )));
+  }
+  const frame_box_grid grid( extents );
+
+  vector< vector< track_pair_overlap > > pairs( truth.size() );
+  parallel_for( truth.size(), n_threads, [&]( size_t i ) {
+      // candidates come back in computed-list order
+      vector< oracle_entry_handle_type > candidates = grid.rows_intersecting( truth_frames[i].extent );
+      for (size_t c=0; c<candidates.size(); ++c)
+      {
+        track_pair_overlap o;
+        o.truth = truth[i];
+        o.computed = computed[ candidates[c] ];
+        if ( merge_frames( truth_frames[i], computed_frames[ candidates[c] ], opts.min_iou, o ))
+        {
+          pairs[i].push_back( o );
+        }
+      }
+    } );
+
+  vector< track_pair_overlap > ret;
+  for (size_t i=0; i<pairs.size(); ++i)
+  {
+    ret.insert( ret.end(), pairs[i].begin(), pairs[i].end() );
+  }
+  return ret;
+}
+
+} // ...track_oracle
+} // ...kwiver
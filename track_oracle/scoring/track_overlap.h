@@ -0,0 +1,95 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef INCL_TRACK_OVERLAP_H
+#define INCL_TRACK_OVERLAP_H
+
+///
+/// Frame-by-frame overlap between two sets of tracks, typically ground
+/// truth and computed, as the input to track association and scoring.
+///
+/// Each track's frames are read once into a list sorted by time.  Pairs
+/// are proposed by a grid over the computed tracks' overall boxes, so
+/// tracks that are never near each other are never compared; each
+/// proposed pair is then measured by merging the two frame lists.  The
+/// truth tracks are divided among worker threads.
+///
+
+#include <vital/vital_config.h>
+#include <track_oracle/scoring/track_oracle_scoring_export.h>
+
+#include <track_oracle/core/track_oracle_api_types.h>
+
+#include <vector>
+
+#include <vgl/vgl_box_2d.h>
+
+namespace kwiver {
+namespace track_oracle {
+
+struct TRACK_ORACLE_SCORING_EXPORT track_overlap_options
+{
+  enum time_key_type { TIMESTAMP_USECS, FRAME_NUMBER };
+
+  // the frame field which pairs up the frames of two tracks
+  time_key_type time_key;
+
+  // common frames whose boxes have an IoU of at least this (and
+  // above zero) are matched
+  double min_iou;
+
+  // worker threads; 0 for std::thread::hardware_concurrency()
+  size_t n_threads;
+
+  track_overlap_options()
+    : time_key( TIMESTAMP_USECS ), min_iou( 0.0 ), n_threads( 0 )
+  {}
+};
+
+struct TRACK_ORACLE_SCORING_EXPORT track_pair_overlap
+{
+  track_handle_type truth;
+  track_handle_type computed;
+
+  // frames at the same time in both tracks
+  size_t n_common_frames;
+
+  // common frames whose boxes match
+  size_t n_matched_frames;
+
+  // the IoU summed over the common frames; frames without a box count as 0
+  double iou_sum;
+
+  // the times of the first and last matched frames
+  unsigned long long first_matched;
+  unsigned long long last_matched;
+
+  track_pair_overlap()
+    : n_common_frames( 0 ), n_matched_frames( 0 ), iou_sum( 0.0 ),
+      first_matched( 0 ), last_matched( 0 )
+  {}
+
+  double mean_iou() const
+  {
+    return ( this->n_common_frames == 0 ) ? 0.0 : this->iou_sum / this->n_common_frames;
+  }
+};
+
+// intersection over union; 0 if either box is empty
+TRACK_ORACLE_SCORING_EXPORT
+double box_iou( const vgl_box_2d< double >& a, const vgl_box_2d< double >& b );
+
+// The pairs with at least one matched frame, ordered by the position of
+// the truth track in truth and then of the computed track in computed.
+// Frames without the time key are ignored.
+TRACK_ORACLE_SCORING_EXPORT
+std::vector< track_pair_overlap >
+compute_track_overlaps( const track_handle_list_type& truth,
+                        const track_handle_list_type& computed,
+                        const track_overlap_options& opts = track_overlap_options() );
+
+} // ...track_oracle
+} // ...kwiver
+
+#endif
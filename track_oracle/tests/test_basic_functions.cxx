@@ -11,8 +11,17 @@
 
 #include <track_oracle/core/track_oracle_core.h>
 #include <track_oracle/core/track_base.h>
+#include <track_oracle/core/state_flags.h>
+#include <track_oracle/core/string_symbol.h>
 #include <track_oracle/data_terms/data_terms.h>
 
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 namespace to = ::kwiver::track_oracle;
 
 namespace { //anon
@@ -173,3 +182,238 @@ TEST(track_oracle, data_term_transfer)
 
   } // ...testing cross-schema transfer
 }
+
+// ------------------------------------------------------------------
+TEST(track_oracle, dense_storage)
+{
+  // columns created while the default is dense are dense
+  const auto old_default = to::track_oracle_core::get_default_storage_type();
+  to::track_oracle_core::set_default_storage_type( to::STORAGE_DENSE );
+  to::track_field< double > score( "dense_storage_test_score" );
+  to::track_oracle_core::set_default_storage_type( old_default );
+
+  const auto fh = score.get_field_handle();
+  EXPECT_EQ( to::track_oracle_core::get_storage_type( fh ), to::STORAGE_DENSE );
+
+  demo_track_alpha alpha;
+  to::track_handle_type h = alpha.create();
+  std::vector< to::frame_handle_type > frames;
+  const size_t n_frames( 3000 );
+  for (size_t j=0; j<n_frames; ++j)
+  {
+    frames.push_back( alpha( h ).create_frame() );
+    // every third frame has no score
+    if ( j % 3 != 0 )
+    {
+      score( frames.back().row ) = 0.5 * j;
+    }
+  }
+
+  // references stay valid as the column grows
+  double& first_score = score( frames[1].row );
+  to::track_handle_type h2 = alpha.create();
+  for (size_t j=0; j<n_frames; ++j)
+  {
+    score( alpha( h2 ).create_frame().row ) = 1.0;
+  }
+  EXPECT_EQ( first_score, 0.5 );
+  first_score = 0.25;
+  EXPECT_EQ( score( frames[1].row ), 0.25 );
+  score( frames[1].row ) = 0.5;
+
+  for (int pass=0; pass<2; ++pass)
+  {
+    for (size_t j=0; j<n_frames; ++j)
+    {
+      const auto row = frames[j].row;
+      EXPECT_EQ( score.exists( row ), j % 3 != 0 ) << "pass " << pass << " frame " << j;
+      const auto probe = score.get( row );
+      EXPECT_EQ( probe.first, j % 3 != 0 );
+      if ( probe.first )
+      {
+        EXPECT_EQ( probe.second, 0.5 * j );
+      }
+    }
+    EXPECT_EQ( score.lookup( 0.5 * 7, to::DOMAIN_ALL ), frames[7].row );
+    EXPECT_EQ( score.lookup( -1.0, to::DOMAIN_ALL ), to::INVALID_ROW_HANDLE );
+
+    // the values are kept when the column moves to map storage
+    to::track_oracle_core::set_storage_type( fh, to::STORAGE_MAP );
+    EXPECT_EQ( to::track_oracle_core::get_storage_type( fh ), to::STORAGE_MAP );
+  }
+
+  to::track_oracle_core::set_storage_type( fh, to::STORAGE_DENSE );
+  score.remove_at_row( frames[1].row );
+  EXPECT_FALSE( score.exists( frames[1].row ));
+  score( frames[1].row ) = 2.0;
+  EXPECT_EQ( score( frames[1].row ), 2.0 );
+}
+
+// ------------------------------------------------------------------
+TEST(track_oracle, snapshot_round_trip)
+{
+  demo_track_beta beta;
+  to::track_field< to::dt::tracking::bounding_box > box;
+  to::track_field< std::string > label( "snapshot_test_label" );
+
+  to::track_handle_list_type tracks;
+  const size_t n_tracks(3);
+  for (size_t i=0; i<n_tracks; ++i)
+  {
+    to::track_handle_type h = beta.create();
+    beta( h ).t_id() = index2trackID( i );
+    label( h.row ) = "track number " + std::to_string( i );
+    // track i has i frames
+    for (size_t j=0; j<i; ++j)
+    {
+      to::frame_handle_type f = beta( h ).create_frame();
+      beta[ f ].f_id() = index2frameNum( j );
+      beta[ f ].f_ts() = index2timestamp( j );
+      box( f.row ) = vgl_box_2d<double>( 10.0*j, 10.0*j+5, 20.0, 40.0 );
+    }
+    tracks.push_back( h );
+  }
+
+  std::stringstream ss;
+  ASSERT_TRUE( to::track_oracle_core::write_snapshot( ss, tracks ));
+  const std::string snapshot( ss.str() );
+
+  to::track_handle_list_type loaded;
+  ASSERT_TRUE( to::track_oracle_core::read_snapshot( snapshot.data(), snapshot.size(), loaded ));
+  ASSERT_EQ( loaded.size(), n_tracks );
+  for (size_t i=0; i<n_tracks; ++i)
+  {
+    const auto& h = loaded[i];
+    EXPECT_NE( h.row, tracks[i].row );
+    EXPECT_EQ( beta( h ).t_id(), index2trackID( i ));
+    EXPECT_EQ( label( h.row ), "track number " + std::to_string( i ));
+
+    auto frames = to::track_oracle_core::get_frames( h );
+    ASSERT_EQ( frames.size(), i );
+    for (size_t j=0; j<i; ++j)
+    {
+      const auto& f = frames[j];
+      EXPECT_EQ( beta[ f ].f_id(), index2frameNum( j ));
+      EXPECT_EQ( beta[ f ].f_ts(), index2timestamp( j ));
+      EXPECT_EQ( box( f.row ).min_x(), 10.0*j );
+      EXPECT_EQ( box( f.row ).max_y(), 40.0 );
+      EXPECT_FALSE( label.exists( f.row ));
+    }
+  }
+
+  // truncated or foreign data is rejected without creating tracks
+  to::track_handle_list_type rejected;
+  EXPECT_FALSE( to::track_oracle_core::read_snapshot( snapshot.data(), snapshot.size() / 2, rejected ));
+  EXPECT_FALSE( to::track_oracle_core::read_snapshot( "<kwiver>", 8, rejected ));
+  EXPECT_TRUE( rejected.empty() );
+}
+
+// ------------------------------------------------------------------
+TEST(track_oracle, lookup_frames)
+{
+  demo_track_beta beta;
+  to::track_field< to::dt::tracking::bounding_box > box;
+
+  // frame j of each track is at timestamp index2timestamp( j ), in a box
+  // moving right by 10 pixels per frame; tracks are 100 pixels apart
+  const size_t n_tracks(4), n_frames(10);
+  to::frame_handle_list_type expected_time, expected_box, expected_both;
+  for (size_t i=0; i<n_tracks; ++i)
+  {
+    to::track_handle_type h = beta.create();
+    for (size_t j=0; j<n_frames; ++j)
+    {
+      to::frame_handle_type f = beta( h ).create_frame();
+      beta[ f ].f_ts() = index2timestamp( j );
+      box( f.row ) = vgl_box_2d<double>( 10.0*j, 10.0*j+5, 100.0*i, 100.0*i+50 );
+
+      const bool in_time = ( j >= 2 ) && ( j <= 4 );
+      const bool in_box = ( i == 1 ) && ( j >= 3 );
+      if ( in_time ) expected_time.push_back( f );
+      if ( in_box ) expected_box.push_back( f );
+      if ( in_time && in_box ) expected_both.push_back( f );
+    }
+  }
+
+  const auto ts_fh = beta.f_ts.get_field_handle();
+  const auto box_fh = box.get_field_handle();
+  const vgl_box_2d<double> query( 30.0, 1000.0, 120.0, 130.0 );
+
+  auto rows = []( const to::frame_handle_list_type& frames )
+  {
+    std::vector< to::oracle_entry_handle_type > ret;
+    for (const auto& f: frames) ret.push_back( f.row );
+    return ret;
+  };
+
+  // frames from the other tests have timestamps too, but their boxes are
+  // outside the query
+  for (int pass=0; pass<2; ++pass)
+  {
+    if ( pass == 1 ) to::track_oracle_core::freeze();
+
+    auto in_time = rows( to::track_oracle_core::lookup_frames( ts_fh, index2timestamp( 2 ), index2timestamp( 4 )));
+    for (const auto& f: expected_time)
+    {
+      EXPECT_TRUE( std::binary_search( in_time.begin(), in_time.end(), f.row ));
+    }
+    EXPECT_EQ( rows( to::track_oracle_core::lookup_frames( box_fh, query )), rows( expected_box ));
+    EXPECT_EQ( rows( to::track_oracle_core::lookup_frames( ts_fh, index2timestamp( 2 ), index2timestamp( 4 ), box_fh, query )),
+               rows( expected_both ));
+    EXPECT_TRUE( to::track_oracle_core::lookup_frames( ts_fh, index2timestamp( 4 ), index2timestamp( 2 )).empty() );
+    EXPECT_THROW( to::track_oracle_core::lookup_frames( box_fh, 0, 1 ), std::runtime_error );
+  }
+  to::track_oracle_core::thaw();
+}
+
+// ------------------------------------------------------------------
+TEST(track_oracle, dictionary_encoded_fields)
+{
+  // each distinct string is stored once
+  const to::string_symbol a( "tracker" ), b( std::string( "tracker" )), c( "detector" );
+  EXPECT_EQ( a, b );
+  EXPECT_EQ( a.get_code(), b.get_code() );
+  EXPECT_NE( a, c );
+  EXPECT_EQ( a.str(), "tracker" );
+  EXPECT_TRUE( to::string_symbol().empty() );
+  EXPECT_TRUE( to::string_symbol( "" ).empty() );
+  const size_t n = to::string_symbol::n_symbols();
+  EXPECT_EQ( to::string_symbol( "detector" ), c );
+  EXPECT_EQ( to::string_symbol::n_symbols(), n );
+
+  demo_track_beta beta;
+  to::track_field< to::dt::tracking::track_style > style;
+  to::track_field< to::dt::utility::state_flags > flags;
+  to::track_handle_type t1 = beta.create(), t2 = beta.create();
+  style( t1.row ) = "tracker";
+  style( t2.row ) = std::string( "detector" );
+  EXPECT_EQ( style.lookup( c, to::DOMAIN_ALL ), t2.row );
+
+  // the column reads and writes the text
+  std::ostringstream oss;
+  oss << style.io( t1.row );
+  EXPECT_NE( oss.str().find( "tracker" ), std::string::npos );
+
+  // flag sets are interned too: the same flags compare equal however
+  // they were reached
+  to::state_flag_type f1, f2;
+  f1.set_flag( "origin", "truth" );
+  f1.set_flag( "matched" );
+  f2.set_flag( "matched" );
+  f2.set_flag( "aoi", "in" );
+  f2.set_flag( "origin", "truth" );
+  EXPECT_FALSE( f1 == f2 );
+  f2.clear_flag( "aoi" );
+  EXPECT_TRUE( f1 == f2 );
+  EXPECT_TRUE( f2.get_flags() == ( std::map< std::string, std::string >{ { "matched", "" }, { "origin", "truth" } } ));
+  f1.clear_flag( "origin" );
+  f1.clear_flag( "matched" );
+  EXPECT_TRUE( f1 == to::state_flag_type() );
+  EXPECT_TRUE( f1.get_flags().empty() );
+
+  flags( t1.row ) = f2;
+  std::istringstream iss( "origin:truth|matched" );
+  to::state_flag_type parsed;
+  iss >> parsed;
+  EXPECT_EQ( flags.lookup( parsed, to::DOMAIN_ALL ), t1.row );
+}
@@ -11,6 +11,7 @@
 #include <vector>
 #include <thread>
 #include <sstream>
+#include <set>
 
 #include <gtest/gtest.h>
 #include <test_gtest.h>
@@ -21,6 +22,7 @@
 #include <track_oracle/core/track_oracle_core.h>
 #include <track_oracle/core/track_base.h>
 #include <track_oracle/data_terms/data_terms.h>
+#include <track_oracle/file_formats/file_format_base.h>
 #include <track_oracle/file_formats/file_format_manager.h>
 
 namespace to = ::kwiver::track_oracle;
@@ -154,3 +156,119 @@ TEST( track_oracle, track_oracle_threadsafe )
     }
   } // ...for up to max_threads
 }
+
+TEST( track_oracle, frozen_reads )
+{
+  string track_file = g_data_dir + "/" + kw18_tracks;
+  to::track_handle_list_type tracks;
+  bool rc = to::file_format_manager::read( track_file, tracks );
+  EXPECT_TRUE( rc ) << " reading from '" << track_file << "'";
+  ASSERT_FALSE( tracks.empty() );
+  track_stats reference( tracks );
+
+  to::track_oracle_core::freeze();
+  EXPECT_TRUE( to::track_oracle_core::is_frozen() );
+
+  const size_t n_threads = 4; // arbitrary
+  vector< track_stats > stats( n_threads );
+  vector< thread > threads;
+  for (size_t i=0; i<n_threads; ++i)
+  {
+    threads.push_back( thread( [&stats, &tracks, i]() { stats[i].set( tracks ); } ));
+  }
+  for (auto& t: threads)
+  {
+    t.join();
+  }
+  for (size_t i=0; i<n_threads; ++i)
+  {
+    ostringstream oss;
+    oss << "Frozen thread " << i+1 << " / " << n_threads;
+    reference.compare( stats[i], oss.str() );
+  }
+
+  // changes throw until thawed
+  EXPECT_THROW( to::track_field< double >( "frozen_reads_test_score" ), std::runtime_error );
+  to::track_field< vgl_box_2d<double> > bounding_box( "bounding_box" );
+  EXPECT_FALSE( bounding_box.exists( tracks[0].row ));
+  EXPECT_THROW( bounding_box( tracks[0].row ), std::runtime_error );
+  EXPECT_THROW( to::track_oracle_core::set_frames( tracks[0], to::frame_handle_list_type() ),
+                std::runtime_error );
+
+  to::track_oracle_core::thaw();
+  EXPECT_FALSE( to::track_oracle_core::is_frozen() );
+  to::track_field< double > thawed_score( "frozen_reads_test_score" );
+  thawed_score( tracks[0].row ) = 1.0;
+  EXPECT_EQ( thawed_score( tracks[0].row ), 1.0 );
+}
+
+TEST( track_oracle, read_many )
+{
+  string track_file = g_data_dir + "/" + kw18_tracks;
+  to::track_handle_list_type tracks;
+  bool rc = to::file_format_manager::read( track_file, tracks );
+  EXPECT_TRUE( rc ) << " reading from '" << track_file << "'";
+  track_stats reference( tracks );
+
+  const size_t n_files = 6; // arbitrary
+  vector< string > fns( n_files, track_file );
+  to::track_handle_list_type all_tracks;
+  rc = to::file_format_manager::read_many( fns, all_tracks, 3 );
+  EXPECT_TRUE( rc );
+  ASSERT_EQ( all_tracks.size(), n_files * reference.n_tracks );
+
+  // each file's tracks are contiguous and were given their own rows
+  std::set< to::oracle_entry_handle_type > rows;
+  for (size_t i=0; i<n_files; ++i)
+  {
+    to::track_handle_list_type file_tracks( all_tracks.begin() + i * reference.n_tracks,
+                                            all_tracks.begin() + (i+1) * reference.n_tracks );
+    ostringstream oss;
+    oss << "File " << i+1 << " / " << n_files;
+    reference.compare( track_stats( file_tracks ), oss.str() );
+    for (const auto& t: file_tracks)
+    {
+      rows.insert( t.row );
+    }
+  }
+  EXPECT_EQ( rows.size(), all_tracks.size() );
+
+  // a missing file fails the batch but not the files around it
+  fns = { track_file, g_data_dir + "/no-such-file.kw18", track_file };
+  all_tracks.clear();
+  EXPECT_FALSE( to::file_format_manager::read_many( fns, all_tracks ));
+  EXPECT_EQ( all_tracks.size(), 2 * reference.n_tracks );
+}
+
+TEST( track_oracle, projected_load )
+{
+  string track_file = g_data_dir + "/" + kw18_tracks;
+  to::track_handle_list_type tracks;
+  bool rc = to::file_format_manager::read( track_file, tracks );
+  EXPECT_TRUE( rc ) << " reading from '" << track_file << "'";
+  track_stats reference( tracks );
+
+  // only the frame numbers and boxes
+  to::track_field< to::dt::tracking::frame_number > frame_number;
+  to::track_field< to::dt::tracking::bounding_box > bounding_box;
+  to::track_field< to::dt::tracking::world_location > world_location;
+  to::file_format_manager::options( to::TF_KW18 ).set_projection(
+    { frame_number.get_field_handle(), bounding_box.get_field_handle() } );
+
+  to::track_handle_list_type projected;
+  rc = to::file_format_manager::read( track_file, projected );
+  to::file_format_manager::default_options( to::TF_KW18 );
+  EXPECT_TRUE( rc ) << " reading from '" << track_file << "'";
+  reference.compare( track_stats( projected ), "projected load" );
+
+  ASSERT_FALSE( projected.empty() );
+  for (const auto& f: to::track_oracle_core::get_frames( projected[0] ))
+  {
+    EXPECT_TRUE( frame_number.exists( f.row ));
+    EXPECT_FALSE( world_location.exists( f.row ));
+  }
+  for (const auto& f: to::track_oracle_core::get_frames( tracks[0] ))
+  {
+    EXPECT_TRUE( world_location.exists( f.row ));
+  }
+}
@@ -0,0 +1,194 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/**
+ * \file
+ * \brief Test track overlap computations
+ */
+
+#include <gtest/gtest.h>
+
+#include <track_oracle/core/track_oracle_core.h>
+#include <track_oracle/core/track_base.h>
+#include <track_oracle/data_terms/data_terms.h>
+#include <track_oracle/scoring/track_overlap.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+namespace to = ::kwiver::track_oracle;
+
+using std::map;
+using std::vector;
+
+namespace { //anon
+
+struct overlap_track: public to::track_base< overlap_track >
+{
+  to::track_field< to::dt::tracking::external_id > id;
+  to::track_field< to::dt::tracking::frame_number > frame_number;
+  to::track_field< to::dt::tracking::timestamp_usecs > timestamp_usecs;
+  to::track_field< to::dt::tracking::bounding_box > bounding_box;
+
+  overlap_track()
+  {
+    Track.add_field( id );
+    Frame.add_field( frame_number );
+    Frame.add_field( timestamp_usecs );
+    Frame.add_field( bounding_box );
+  }
+};
+
+// a track on frames [first, first+n) moving from (x, y) by (dx, dy) per
+// frame; every third frame has no box if gaps is set
+to::track_handle_type
+make_track( overlap_track& schema, unsigned first, unsigned n,
+            double x, double y, double dx, double dy, bool gaps )
+{
+  to::track_handle_type t = schema.create();
+  for (unsigned i=0; i<n; ++i)
+  {
+    to::frame_handle_type f = schema( t ).create_frame();
+    schema[ f ].frame_number() = first + i;
+    schema[ f ].timestamp_usecs() = ( first + i ) * 1000ULL;
+    if ( ! ( gaps && ( i % 3 == 2 )))
+    {
+      schema[ f ].bounding_box() =
+        vgl_box_2d<double>( x + i*dx, x + i*dx + 20, y + i*dy, y + i*dy + 40 );
+    }
+  }
+  return t;
+}
+
+// every pair, by brute force
+vector< to::track_pair_overlap >
+all_pairs( overlap_track& schema,
+           const to::track_handle_list_type& truth,
+           const to::track_handle_list_type& computed,
+           double min_iou )
+{
+  vector< to::track_pair_overlap > ret;
+  for (const auto& t: truth)
+  {
+    for (const auto& c: computed)
+    {
+      map< unsigned, to::frame_handle_type > c_frames;
+      for (const auto& f: to::track_oracle_core::get_frames( c ))
+      {
+        c_frames[ schema[ f ].frame_number() ] = f;
+      }
+
+      to::track_pair_overlap o;
+      o.truth = t;
+      o.computed = c;
+      for (const auto& f: to::track_oracle_core::get_frames( t ))
+      {
+        unsigned fn = schema[ f ].frame_number();
+        auto p = c_frames.find( fn );
+        if ( p == c_frames.end() ) continue;
+        ++o.n_common_frames;
+        double iou = 0;
+        if ( schema[ f ].bounding_box.exists() && schema[ p->second ].bounding_box.exists() )
+        {
+          iou = to::box_iou( schema[ f ].bounding_box(), schema[ p->second ].bounding_box() );
+        }
+        o.iou_sum += iou;
+        if ( ( iou > 0 ) && ( iou >= min_iou ))
+        {
+          if ( o.n_matched_frames++ == 0 ) o.first_matched = fn;
+          o.last_matched = fn;
+        }
+      }
+      if ( o.n_matched_frames > 0 )
+      {
+        ret.push_back( o );
+      }
+    }
+  }
+  return ret;
+}
+
+void
+expect_same( const vector< to::track_pair_overlap >& lhs,
+             const vector< to::track_pair_overlap >& rhs,
+             unsigned long long time_scale )
+{
+  ASSERT_EQ( lhs.size(), rhs.size() );
+  for (size_t i=0; i<lhs.size(); ++i)
+  {
+    EXPECT_EQ( lhs[i].truth, rhs[i].truth );
+    EXPECT_EQ( lhs[i].computed, rhs[i].computed );
+    EXPECT_EQ( lhs[i].n_common_frames, rhs[i].n_common_frames );
+    EXPECT_EQ( lhs[i].n_matched_frames, rhs[i].n_matched_frames );
+    EXPECT_NEAR( lhs[i].iou_sum, rhs[i].iou_sum, 1.0e-9 );
+    EXPECT_EQ( lhs[i].first_matched, rhs[i].first_matched * time_scale );
+    EXPECT_EQ( lhs[i].last_matched, rhs[i].last_matched * time_scale );
+  }
+}
+
+} // anon
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ------------------------------------------------------------------
+TEST(track_oracle, box_iou)
+{
+  const vgl_box_2d<double> a( 0.0, 10.0, 0.0, 10.0 ), b( 5.0, 15.0, 0.0, 10.0 ), c( 10.0, 20.0, 0.0, 10.0 );
+  EXPECT_DOUBLE_EQ( to::box_iou( a, a ), 1.0 );
+  EXPECT_DOUBLE_EQ( to::box_iou( a, b ), 50.0 / 150.0 );
+  EXPECT_DOUBLE_EQ( to::box_iou( a, c ), 0.0 );
+  EXPECT_DOUBLE_EQ( to::box_iou( a, vgl_box_2d<double>() ), 0.0 );
+}
+
+// ------------------------------------------------------------------
+TEST(track_oracle, track_overlaps)
+{
+  overlap_track schema;
+  std::mt19937 rng( 1234 );
+  std::uniform_real_distribution< double > pos( 0.0, 2000.0 ), step( -5.0, 5.0 ), jitter( -8.0, 8.0 );
+  std::uniform_int_distribution< unsigned > start( 0, 400 ), len( 1, 120 );
+
+  // computed tracks follow the truth tracks loosely, or wander on their own
+  to::track_handle_list_type truth, computed;
+  for (size_t i=0; i<60; ++i)
+  {
+    unsigned first = start( rng ), n = len( rng );
+    double x = pos( rng ), y = pos( rng ), dx = step( rng ), dy = step( rng );
+    truth.push_back( make_track( schema, first, n, x, y, dx, dy, i % 4 == 0 ));
+    computed.push_back( make_track( schema, first + n/4, n, x + jitter( rng ) + n/4*dx, y + jitter( rng ) + n/4*dy,
+                                    dx, dy, i % 5 == 0 ));
+    computed.push_back( make_track( schema, start( rng ), len( rng ), pos( rng ), pos( rng ),
+                                    step( rng ), step( rng ), false ));
+  }
+  // a computed track without boxes matches nothing
+  to::track_handle_type boxless = schema.create();
+  schema[ schema( boxless ).create_frame() ].frame_number() = 10;
+  computed.push_back( boxless );
+
+  for (double min_iou: { 0.0, 0.5 })
+  {
+    vector< to::track_pair_overlap > expected = all_pairs( schema, truth, computed, min_iou );
+    EXPECT_FALSE( expected.empty() );
+
+    to::track_overlap_options opts;
+    opts.min_iou = min_iou;
+    for (size_t n_threads: { 1, 4 })
+    {
+      opts.n_threads = n_threads;
+      opts.time_key = to::track_overlap_options::FRAME_NUMBER;
+      expect_same( to::compute_track_overlaps( truth, computed, opts ), expected, 1 );
+      opts.time_key = to::track_overlap_options::TIMESTAMP_USECS;
+      expect_same( to::compute_track_overlaps( truth, computed, opts ), expected, 1000 );
+    }
+  }
+
+  EXPECT_TRUE( to::compute_track_overlaps( truth, to::track_handle_list_type() ).empty() );
+}
@@ -0,0 +1,138 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/**
+ * \file
+ * \brief Test streaming elements out of XML
+ */
+
+#include <gtest/gtest.h>
+
+#include <track_oracle/utils/tokenizers.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace xt = ::kwiver::track_oracle::xml_tokenizer;
+
+using std::istringstream;
+using std::string;
+using std::vector;
+
+namespace { //anon
+
+vector< string >
+all_elements( xt::element_stream& s )
+{
+  vector< string > ret;
+  string e;
+  while ( s.next( e ))
+  {
+    ret.push_back( e );
+  }
+  return ret;
+}
+
+const string viper_text =
+  "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+  "<!DOCTYPE viper [ <!ENTITY x \"<object>\"> ]>\n"
+  "<viper>\n"
+  "  <config><object name=\"config\"/></config>\n"
+  "  <data>\n"
+  "    <sourcefile filename=\"a>b\">\n"
+  "      <!-- <object id=\"commented\"/> -->\n"
+  "      <object id=\"0\" name='>'><attribute><object id=\"inner\"/></attribute></object>\n"
+  "      <object id=\"1\"/>\n"
+  "      <![CDATA[ <object id=\"cdata\"/> ]]>\n"
+  "    </sourcefile>\n"
+  "    <sourcefile><object id=\"2\"></object></sourcefile>\n"
+  "  </data>\n"
+  "</viper>\n";
+
+} // anon
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+TEST( track_oracle, xml_element_stream_by_path )
+{
+  istringstream iss( viper_text );
+  xt::element_stream s( iss, "object", { "*", "data", "sourcefile" } );
+
+  string e;
+  ASSERT_TRUE( s.next( e ));
+  EXPECT_EQ( e, "<object id=\"0\" name='>'><attribute><object id=\"inner\"/></attribute></object>" );
+  EXPECT_EQ( s.line(), 8 );
+  EXPECT_EQ( s.parent_index(), 0 );
+
+  ASSERT_TRUE( s.next( e ));
+  EXPECT_EQ( e, "<object id=\"1\"/>" );
+  EXPECT_EQ( s.parent_index(), 0 );
+
+  ASSERT_TRUE( s.next( e ));
+  EXPECT_EQ( e, "<object id=\"2\"></object>" );
+  EXPECT_EQ( s.line(), 12 );
+  EXPECT_EQ( s.parent_index(), 1 );
+
+  EXPECT_FALSE( s.next( e ));
+  EXPECT_FALSE( s.failed() );
+}
+
+TEST( track_oracle, xml_element_stream_any_depth )
+{
+  istringstream iss( viper_text );
+  xt::element_stream s( iss, "object" );
+  vector< string > elements = all_elements( s );
+  EXPECT_FALSE( s.failed() );
+  ASSERT_EQ( elements.size(), 4 );
+  EXPECT_EQ( elements[0], "<object name=\"config\"/>" );
+  EXPECT_EQ( elements[3], "<object id=\"2\"></object>" );
+
+  // documents without a single root element
+  istringstream tracks( "<track id=\"1\">\n<!-- x -->\n</track>\n<track id=\"2\"/>" );
+  xt::element_stream t( tracks, "track" );
+  elements = all_elements( t );
+  EXPECT_FALSE( t.failed() );
+  ASSERT_EQ( elements.size(), 2 );
+  EXPECT_EQ( elements[0], "<track id=\"1\">\n<!-- x -->\n</track>" );
+}
+
+TEST( track_oracle, xml_element_stream_children )
+{
+  istringstream iss( "<root><a x=\"1\"/>text<b><c/></b></root>" );
+  xt::element_stream s( iss, "*", { "*" } );
+  vector< string > elements = all_elements( s );
+  EXPECT_FALSE( s.failed() );
+  ASSERT_EQ( elements.size(), 2 );
+  EXPECT_EQ( elements[0], "<a x=\"1\"/>" );
+  EXPECT_EQ( elements[1], "<b><c/></b>" );
+
+  istringstream top( "<thRecv n=\"1\"/><thRecv n=\"2\"><thRecv n=\"3\"/></thRecv>" );
+  xt::element_stream t( top, "thRecv", vector< string >() );
+  EXPECT_EQ( all_elements( t ).size(), 2 );
+}
+
+TEST( track_oracle, xml_element_stream_malformed )
+{
+  istringstream mismatched( "<root><a></b></root>" );
+  xt::element_stream s( mismatched, "a" );
+  EXPECT_TRUE( all_elements( s ).empty() );
+  EXPECT_TRUE( s.failed() );
+
+  istringstream truncated( "<root><a/><a>" );
+  xt::element_stream t( truncated, "a" );
+  EXPECT_EQ( all_elements( t ).size(), 1 );
+  EXPECT_TRUE( t.failed() );
+
+  istringstream unterminated( "<root><!-- never closed </root>" );
+  xt::element_stream u( unterminated, "a" );
+  EXPECT_TRUE( all_elements( u ).empty() );
+  EXPECT_TRUE( u.failed() );
+}
@@ -5,6 +5,7 @@
 #include "tokenizers.h"
 
 #include <istream>
+#include <streambuf>
 
 #include <vital/logger/logger.h>
 static kwiver::vital::logger_handle_t main_logger( kwiver::vital::get_logger( __FILE__ ) );
@@ -198,6 +199,204 @@ first_n_tokens( const string& fn, size_t n )
 
 }
 
+element_stream
+::element_stream( istream& s, const string& n )
+  : is( s ), name( n ), any_depth( true ),
+    cur_line( 1 ), element_line( 0 ), n_parents( 0 ), element_parent( 0 ), bad( false )
+{
+}
+
+element_stream
+::element_stream( istream& s, const string& n, const vector< string >& p )
+  : is( s ), name( n ), parent_path( p ), any_depth( false ),
+    cur_line( 1 ), element_line( 0 ), n_parents( 0 ), element_parent( 0 ), bad( false )
+{
+}
+
+bool
+element_stream
+::get( char& c )
+{
+  std::streambuf* sb = this->is.rdbuf();
+  if ( ! sb ) return false;
+  int ch = sb->sbumpc();
+  if ( ch == std::char_traits< char >::eof() ) return false;
+  c = static_cast< char >( ch );
+  if ( c == '\n' ) ++this->cur_line;
+  return true;
+}
+
+bool
+element_stream
+::read_markup( string& markup )
+{
+  // the '<' has been read; read up to and including the closing '>'
+  markup.assign( 1, '<' );
+  char c;
+  if ( ! this->get( c )) return false;
+  markup += c;
+
+  string end;
+  size_t min_size = 0;
+  if ( c == '?' )
+  {
+    end = "?>";
+    min_size = 4;
+  }
+  else if ( c == '!' )
+  {
+    if ( ! this->get( c )) return false;
+    markup += c;
+    if ( c == '-' )
+    {
+      end = "-->";
+      min_size = 7;
+    }
+    else if ( c == '[' )
+    {
+      end = "]]>";
+      min_size = 12;
+    }
+  }
+
+  if ( ! end.empty() )
+  {
+    while (( markup.size() < min_size ) ||
+           ( markup.compare( markup.size() - end.size(), end.size(), end ) != 0 ))
+    {
+      if ( ! this->get( c )) return false;
+      markup += c;
+    }
+    return true;
+  }
+
+  // a tag or a declaration: the first '>' outside quotes (and, for
+  // declarations, outside an internal subset in brackets)
+  char quote = 0;
+  int brackets = 0;
+  while ( quote || brackets || ( c != '>' ))
+  {
+    if ( quote )
+    {
+      if ( c == quote ) quote = 0;
+    }
+    else if (( c == '"' ) || ( c == '\'' ))
+    {
+      quote = c;
+    }
+    else if ( markup[1] == '!' )
+    {
+      if ( c == '[' ) ++brackets;
+      if (( c == ']' ) && brackets ) --brackets;
+    }
+    if ( ! this->get( c )) return false;
+    markup += c;
+  }
+  return true;
+}
+
+bool
+element_stream
+::selects( const string& tag ) const
+{
+  if (( this->name != "*" ) && ( tag != this->name )) return false;
+  if ( this->any_depth ) return true;
+  if ( this->open_elements.size() != this->parent_path.size() ) return false;
+  for (size_t i=0; i<this->parent_path.size(); ++i)
+  {
+    if (( this->parent_path[i] != "*" ) && ( this->parent_path[i] != this->open_elements[i] )) return false;
+  }
+  return true;
+}
+
+bool
+element_stream
+::is_parent( const string& tag ) const
+{
+  if ( this->any_depth || this->parent_path.empty() ) return false;
+  if ( this->open_elements.size() + 1 != this->parent_path.size() ) return false;
+  for (size_t i=0; i<this->parent_path.size(); ++i)
+  {
+    const string& t = ( i < this->open_elements.size() ) ? this->open_elements[i] : tag;
+    if (( this->parent_path[i] != "*" ) && ( this->parent_path[i] != t )) return false;
+  }
+  return true;
+}
+
+bool
+element_stream
+::next( string& element )
+{
+  element.clear();
+  bool capturing = false;
+  size_t capture_depth = 0;
+  string markup;
+  char c;
+  while ( this->get( c ))
+  {
+    if ( c != '<' )
+    {
+      if ( capturing ) element += c;
+      continue;
+    }
+
+    const size_t markup_line = this->cur_line;
+    if ( ! this->read_markup( markup ))
+    {
+      LOG_ERROR( main_logger, "XML element stream: unterminated markup at line " << markup_line );
+      this->bad = true;
+      return false;
+    }
+    if ( capturing ) element += markup;
+
+    // comments, CDATA, declarations, processing instructions
+    if (( markup[1] == '!' ) || ( markup[1] == '?' )) continue;
+
+    const size_t name_start = ( markup[1] == '/' ) ? 2 : 1;
+    const string tag = markup.substr( name_start, markup.find_first_of( " \t\r\n/>", name_start ) - name_start );
+
+    if ( markup[1] == '/' )
+    {
+      if ( this->open_elements.empty() || ( this->open_elements.back() != tag ))
+      {
+        LOG_ERROR( main_logger, "XML element stream: unexpected end tag '" << markup << "' at line " << markup_line );
+        this->bad = true;
+        return false;
+      }
+      this->open_elements.pop_back();
+      if ( capturing && ( this->open_elements.size() == capture_depth )) return true;
+      continue;
+    }
+
+    const bool empty_element = ( markup[ markup.size()-2 ] == '/' );
+    if ( ! capturing )
+    {
+      if ( this->selects( tag ))
+      {
+        capturing = true;
+        capture_depth = this->open_elements.size();
+        element = markup;
+        this->element_line = markup_line;
+        this->element_parent = this->n_parents ? this->n_parents - 1 : 0;
+        if ( empty_element ) return true;
+      }
+      else if ( this->is_parent( tag ))
+      {
+        ++this->n_parents;
+      }
+    }
+    if ( ! empty_element ) this->open_elements.push_back( tag );
+  }
+
+  if ( capturing || ! this->open_elements.empty() )
+  {
+    LOG_ERROR( main_logger, "XML element stream: stream ended inside element '"
+               << ( this->open_elements.empty() ? this->name : this->open_elements.back() ) << "'" );
+    this->bad = true;
+  }
+  return false;
+}
+
 } //...xml_tokenizer
 
 namespace csv_tokenizer {
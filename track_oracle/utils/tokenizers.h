@@ -24,6 +24,62 @@ namespace csv_tokenizer
 namespace xml_tokenizer
 {
   TRACK_ORACLE_TOKENIZERS_EXPORT std::vector< std::string > first_n_tokens( const std::string& fn, size_t n = 1 );
+
+  //
+  // Pull the text of selected elements out of an XML stream one element at
+  // a time, so that readers can parse (e.g. with TinyXML) and convert each
+  // track as it is reached rather than holding the whole document as a DOM.
+  //
+  // Elements are selected by name and either anywhere in the document or
+  // by the path of their parents from the document level; "*" matches any
+  // name.  Elements inside a selected element are returned as part of its
+  // text, never on their own.  Comments, CDATA sections, processing
+  // instructions and declarations are skipped outside selected elements and
+  // kept inside them.
+  //
+
+  class TRACK_ORACLE_TOKENIZERS_EXPORT element_stream
+  {
+  public:
+    // select the elements called name anywhere in the document
+    element_stream( std::istream& is, const std::string& name );
+
+    // select the elements called name whose parents, from the outermost,
+    // are parent_path (empty for elements at the document level)
+    element_stream( std::istream& is, const std::string& name, const std::vector< std::string >& parent_path );
+
+    // the text of the next selected element, from the '<' of its start tag
+    // to the '>' of its end tag; false at the end of the stream or if the
+    // XML is malformed (see failed())
+    bool next( std::string& element );
+
+    // line (from 1) of the start tag of the last element returned; line
+    // numbers from parsing the element's text are relative to this line
+    size_t line() const { return this->element_line; }
+
+    // for elements selected by path, the number of parent elements opened
+    // before the parent of the last element returned (so 0 for the elements
+    // of the first parent)
+    size_t parent_index() const { return this->element_parent; }
+
+    // true if next() stopped on malformed XML rather than at the end
+    bool failed() const { return this->bad; }
+
+  private:
+    std::istream& is;
+    std::string name;
+    std::vector< std::string > parent_path;
+    bool any_depth;
+
+    std::vector< std::string > open_elements;
+    size_t cur_line, element_line, n_parents, element_parent;
+    bool bad;
+
+    bool get( char& c );
+    bool read_markup( std::string& markup );
+    bool selects( const std::string& tag ) const;
+    bool is_parent( const std::string& tag ) const;
+  };
 };
 
 } // ...track_oracle
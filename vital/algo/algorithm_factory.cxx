@@ -16,7 +16,7 @@ has_algorithm_impl_name( std::string const& type_name,
   // Get list of factories for the algo_name
   kwiver::vital::plugin_manager& vpm =
     kwiver::vital::plugin_manager::instance();
-  auto fact_list = vpm.get_factories( type_name );
+  auto fact_list = vpm.get_factories( type_name, impl_name );
 
   // Find the one that provides the impl_name
   for( kwiver::vital::plugin_factory_handle_t a_fact : fact_list )
@@ -40,7 +40,7 @@ create_algorithm( std::string const& algo_name,
   // Get list of factories for the algo_name
   kwiver::vital::plugin_manager& vpm =
     kwiver::vital::plugin_manager::instance();
-  auto fact_list = vpm.get_factories( algo_name );
+  auto fact_list = vpm.get_factories( algo_name, impl_name );
 
   // Find the one that provides the impl_name
   for( kwiver::vital::plugin_factory_handle_t a_fact : fact_list )
@@ -26,6 +26,49 @@ ::data_serializer()
   attach_logger( "data_serializer" );
 }
 
+// ----------------------------------------------------------------------------
+message_parts
+data_serializer
+::serialize_parts( const vital::any& element )
+{
+  message_parts parts;
+  add_message_part( parts, serialize( element ) );
+  return parts;
+}
+
+// ----------------------------------------------------------------------------
+void
+add_message_part( message_parts& parts,
+                  std::shared_ptr< std::string const > const& message )
+{
+  parts.push_back( { message->data(), message->size(), message } );
+}
+
+// ----------------------------------------------------------------------------
+size_t
+message_size( message_parts const& parts )
+{
+  size_t size = 0;
+  for( auto const& part : parts )
+  {
+    size += part.size;
+  }
+  return size;
+}
+
+// ----------------------------------------------------------------------------
+std::string
+join_message_parts( message_parts const& parts )
+{
+  std::string message;
+  message.reserve( message_size( parts ) );
+  for( auto const& part : parts )
+  {
+    message.append( part.data, part.size );
+  }
+  return message;
+}
+
 } // namespace algo
 
 } // namespace vital
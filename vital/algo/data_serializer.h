@@ -16,6 +16,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace kwiver {
 
@@ -23,6 +24,34 @@ namespace vital {
 
 namespace algo {
 
+/// Contiguous bytes of a serialized message
+///
+/// The bytes remain valid for as long as \c owner is held. The owner may be
+/// the string the bytes were serialized into, or the data item itself when
+/// the bytes are its own memory.
+struct message_part
+{
+  char const* data;
+  size_t size;
+  std::shared_ptr< void const > owner;
+};
+
+/// Serialized message as a sequence of parts, to be sent in order
+using message_parts = std::vector< message_part >;
+
+/// Append a part holding the whole of \p message to \p parts
+VITAL_ALGO_EXPORT void
+add_message_part( message_parts& parts,
+                  std::shared_ptr< std::string const > const& message );
+
+/// Total number of bytes of \p parts
+VITAL_ALGO_EXPORT size_t
+message_size( message_parts const& parts );
+
+/// Concatenate \p parts into a single byte string
+VITAL_ALGO_EXPORT std::string
+join_message_parts( message_parts const& parts );
+
 /// An abstract base class serializing and deserializing.
 ///
 /// This class represents a pair of methods that serialize and
@@ -102,6 +131,25 @@ class VITAL_ALGO_EXPORT data_serializer
   /// @throws kwiver::vital::serialization - for unexpected element name
   virtual vital::any deserialize( const std::string& message ) = 0;
 
+  /// Serialize the item into a sequence of byte ranges.
+  ///
+  /// The concatenation of the parts is the byte string returned by \c
+  /// serialize(), so either may be passed to \c deserialize(). The parts
+  /// may refer to the memory of the data item instead of copies of it,
+  /// which lets transports send large items without copying them into a
+  /// single buffer.
+  ///
+  /// The default implementation returns the result of \c serialize() as a
+  /// single part.
+  ///
+  /// @param element Data item to be serialized.
+  ///
+  /// @return Parts of the serialized data item.
+  ///
+  /// @throws kwiver::vital::bad_any_cast
+  /// @throws kwiver::vital::serialization - for unexpected element name
+  virtual message_parts serialize_parts( const vital::any& element );
+
   virtual void set_configuration( kwiver::vital::config_block_sptr config ) {}
   virtual bool
   check_configuration( config_block_sptr config ) const { return true; }
@@ -0,0 +1,31 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief descriptor_index algorithm definition instantiation
+
+#include "descriptor_index.h"
+#include <vital/algo/algorithm.txx>
+
+namespace kwiver {
+
+namespace vital {
+
+namespace algo {
+
+descriptor_index
+::descriptor_index()
+{
+  attach_logger( "algo.descriptor_index" );
+}
+
+} // namespace algo
+
+} // namespace vital
+
+} // namespace kwiver
+
+/// \cond DoxygenSuppress
+INSTANTIATE_ALGORITHM_DEF( kwiver::vital::algo::descriptor_index );
+/// \endcond
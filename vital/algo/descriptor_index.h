@@ -0,0 +1,93 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Interface for descriptor_index \link
+/// kwiver::vital::algo::algorithm_def algorithm definition \endlink.
+
+#ifndef VITAL_ALGO_DESCRIPTOR_INDEX_H_
+#define VITAL_ALGO_DESCRIPTOR_INDEX_H_
+
+#include <vital/algo/algorithm.h>
+#include <vital/types/descriptor.h>
+#include <vital/vital_config.h>
+
+#include <string>
+#include <vector>
+
+namespace kwiver {
+
+namespace vital {
+
+namespace algo {
+
+/// An abstract base class for searching a collection of descriptors
+///
+/// Descriptors are added to the index incrementally and identified by the
+/// order in which they were added: the first descriptor added has index 0.
+/// All descriptors in an index must have the same size.  Queries find the
+/// descriptors nearest to each of a batch of query descriptors, which
+/// implementations may answer approximately to search large collections
+/// quickly.
+class VITAL_ALGO_EXPORT descriptor_index
+  : public kwiver::vital::algorithm_def< descriptor_index >
+{
+public:
+  /// Return the name of this algorithm
+  static std::string static_type_name() { return "descriptor_index"; }
+
+  /// Add descriptors to the index
+  ///
+  /// The descriptors are given the indices following those already in the
+  /// index, in order.
+  ///
+  /// \param [in] descriptors the descriptors to add
+  /// \throws invalid_value if a descriptor is null or its size differs from
+  ///         the descriptors already in the index
+  virtual void add( std::vector< descriptor_sptr > const& descriptors ) = 0;
+
+  /// Return the number of descriptors in the index
+  virtual size_t size() const = 0;
+
+  /// Remove all descriptors from the index
+  virtual void clear() = 0;
+
+  /// Find the K nearest descriptors of each query descriptor
+  ///
+  /// \param [in] queries the descriptors to search for
+  /// \param [in] K the number of nearest descriptors for each query
+  /// \param [out] indices the indices of the nearest descriptors of each
+  ///              query, nearest first
+  /// \param [out] distances the Euclidean distance to each nearest descriptor
+  virtual void find_nearest(
+    std::vector< descriptor_sptr > const& queries,
+    size_t K,
+    std::vector< std::vector< size_t > >& indices,
+    std::vector< std::vector< double > >& distances ) const = 0;
+
+  /// Write the index to a file
+  ///
+  /// \throws file_write_exception if the file cannot be written
+  virtual void save( std::string const& filename ) const = 0;
+
+  /// Replace the index with one read from a file written by save()
+  ///
+  /// \throws file_not_found_exception if the file does not exist
+  /// \throws invalid_file if the file is not a valid index
+  virtual void load( std::string const& filename ) = 0;
+
+protected:
+  descriptor_index();
+};
+
+/// Shared pointer for descriptor_index algorithm definition class
+typedef std::shared_ptr< descriptor_index > descriptor_index_sptr;
+
+} // namespace algo
+
+} // namespace vital
+
+} // namespace kwiver
+
+#endif // VITAL_ALGO_DESCRIPTOR_INDEX_H_
@@ -33,6 +33,11 @@ class VITAL_ALGO_EXPORT dynamic_configuration
   ///
   /// \brief This method returns dynamic configuration values. a valid config
   ///        block is returned even if there are not values being returned.
+  ///
+  /// Implementations that keep returning the same block and update its
+  /// values in place let callers hold config_value_handle objects on it:
+  /// the new values then reach the callers, converted once per change,
+  /// without them calling this method again.
   virtual config_block_sptr get_dynamic_configuration() = 0;
 
 protected:
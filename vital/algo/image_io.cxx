@@ -8,12 +8,15 @@
 #include "image_io.h"
 
 #include <vital/algo/algorithm.txx>
+#include <vital/exceptions/image.h>
 #include <vital/exceptions/io.h>
 #include <vital/vital_config.h>
 #include <vital/vital_types.h>
 
 #include <kwiversys/SystemTools.hxx>
 
+#include <algorithm>
+
 /// \cond DoxygenSuppress
 INSTANTIATE_ALGORITHM_DEF( kwiver::vital::algo::image_io );
 /// \endcond
@@ -49,6 +52,26 @@ ::load( std::string const& filename ) const
   return this->load_( filename );
 }
 
+image_container_sptr
+image_io
+::load_window( std::string const& filename,
+               unsigned x_offset, unsigned y_offset,
+               unsigned width, unsigned height, unsigned level ) const
+{
+  // Make sure that the given file path exists and is a file.
+  if( !kwiversys::SystemTools::FileExists( filename ) )
+  {
+    VITAL_THROW( path_not_exists, filename );
+  }
+  else if( kwiversys::SystemTools::FileIsDirectory( filename ) )
+  {
+    VITAL_THROW( path_not_a_file, filename );
+  }
+
+  return this->load_window_( filename, x_offset, y_offset,
+                             width, height, level );
+}
+
 void
 image_io
 ::save( std::string const& filename, image_container_sptr data ) const
@@ -110,6 +133,40 @@ ::load_metadata_( VITAL_UNUSED std::string const& filename ) const
   return nullptr;
 }
 
+image_container_sptr
+image_io
+::load_window_( std::string const& filename,
+                unsigned x_offset, unsigned y_offset,
+                unsigned width, unsigned height, unsigned level ) const
+{
+  auto const full = this->load_( filename );
+  auto const& img = full->get_image();
+
+  if( !width || !height ||
+      size_t{ x_offset } + width > img.width() ||
+      size_t{ y_offset } + height > img.height() )
+  {
+    VITAL_THROW( image_size_mismatch_exception,
+                 "Window does not fit in the image",
+                 img.width(), img.height(),
+                 size_t{ x_offset } + width, size_t{ y_offset } + height );
+  }
+
+  // Take every step-th pixel of the window without copying
+  auto const step = ptrdiff_t{ 1 } << std::min( level, 31u );
+  auto const window = img.crop( x_offset, y_offset, width, height );
+  image const decimated(
+    window.memory(), window.first_pixel(),
+    ( width + step - 1 ) / step, ( height + step - 1 ) / step,
+    window.depth(),
+    window.w_step() * step, window.h_step() * step, window.d_step(),
+    window.pixel_traits() );
+
+  auto const result = std::make_shared< simple_image_container >( decimated );
+  result->set_metadata( full->get_metadata() );
+  return result;
+}
+
 } // namespace algo
 
 } // namespace vital
@@ -62,6 +62,38 @@ class VITAL_ALGO_EXPORT image_io
   kwiver::vital::image_container_sptr load(
     std::string const& filename ) const;
 
+  /// Load a window of an image from a file, optionally at reduced resolution
+  ///
+  /// This allows tiles of a very large image to be processed without
+  /// loading all of it. The window is given in full resolution pixels and
+  /// is returned reduced by a factor of 2^\p level in each dimension.
+  /// Implementations that support it read only the window from the file,
+  /// using overviews stored in the file where available. The default
+  /// loads the whole image and returns a view of every 2^\p level-th pixel
+  /// of the window.
+  ///
+  /// \throws kwiver::vital::path_not_exists Thrown when the given path does not
+  /// exist.
+  ///
+  /// \throws kwiver::vital::path_not_a_file Thrown when the given path does
+  ///    not point to a file (i.e. it points to a directory).
+  ///
+  /// \throws kwiver::vital::image_size_mismatch_exception Thrown when the
+  ///    window is empty or does not fit in the image.
+  ///
+  /// \param filename the path to the file to load
+  /// \param x_offset column of the first pixel of the window
+  /// \param y_offset row of the first pixel of the window
+  /// \param width width of the window
+  /// \param height height of the window
+  /// \param level decimation level, less than 32; the image returned is
+  ///    ceil(width / 2^level) by ceil(height / 2^level) pixels
+  /// \returns an image container refering to the loaded window
+  kwiver::vital::image_container_sptr load_window(
+    std::string const& filename,
+    unsigned x_offset, unsigned y_offset, unsigned width, unsigned height,
+    unsigned level = 0 ) const;
+
   /// Save image to a file
   ///
   /// Image file format is based on file extension.
@@ -115,6 +147,23 @@ class VITAL_ALGO_EXPORT image_io
   virtual kwiver::vital::image_container_sptr load_(
     std::string const& filename ) const = 0;
 
+  /// Implementation specific windowed load functionality.
+  ///
+  /// The default implementation loads the whole image with load_() and
+  /// returns a view of the window.
+  ///
+  /// \param filename the path to the file the load
+  /// \param x_offset column of the first pixel of the window
+  /// \param y_offset row of the first pixel of the window
+  /// \param width width of the window
+  /// \param height height of the window
+  /// \param level decimation level
+  /// \returns an image container refering to the loaded window
+  virtual kwiver::vital::image_container_sptr load_window_(
+    std::string const& filename,
+    unsigned x_offset, unsigned y_offset, unsigned width, unsigned height,
+    unsigned level ) const;
+
   /// Implementation specific save functionality.
   ///
   /// Concrete implementations of image_io class must provide an
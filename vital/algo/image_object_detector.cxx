@@ -20,6 +20,20 @@ ::image_object_detector()
   attach_logger( "algo.image_object_detector" ); // specify a logger
 }
 
+// ----------------------------------------------------------------------------
+std::vector< detected_object_set_sptr >
+image_object_detector
+::batch_detect( std::vector< image_container_sptr > const& images ) const
+{
+  std::vector< detected_object_set_sptr > detections;
+  detections.reserve( images.size() );
+  for( auto const& image : images )
+  {
+    detections.push_back( detect( image ) );
+  }
+  return detections;
+}
+
 } // namespace algo
 
 } // namespace vital
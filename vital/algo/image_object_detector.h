@@ -41,6 +41,17 @@ class VITAL_ALGO_EXPORT image_object_detector
   virtual detected_object_set_sptr
   detect( image_container_sptr image_data ) const = 0;
 
+  /// Find all objects on each of a batch of images
+  ///
+  /// Detectors which can process several images together, such as a network
+  /// run on a batch of inputs, override this to amortize the cost of each
+  /// evaluation.  The default implementation calls detect() on each image.
+  ///
+  /// \param images the images to process
+  /// \returns the detected objects of each image, in the same order
+  virtual std::vector< detected_object_set_sptr >
+  batch_detect( std::vector< image_container_sptr > const& images ) const;
+
 protected:
   image_object_detector();
 };
@@ -32,6 +32,22 @@ ::set_video_input( video_input_sptr input )
   m_video_input = input;
 }
 
+// ----------------------------------------------------------------------------
+std::vector< track_sptr >
+interpolate_track
+::batch_interpolate( std::vector< track_sptr > const& tracks )
+{
+  std::vector< track_sptr > result;
+  result.reserve( tracks.size() );
+  for( auto const& t : tracks )
+  {
+    result.push_back( interpolate( t ) );
+    do_callback( static_cast< int >( result.size() ),
+                 static_cast< int >( tracks.size() ) );
+  }
+  return result;
+}
+
 // ----------------------------------------------------------------------------
 void
 interpolate_track
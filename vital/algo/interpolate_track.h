@@ -47,6 +47,18 @@ class VITAL_ALGO_EXPORT interpolate_track
   /// @return Output track with missing states filled in.
   virtual track_sptr interpolate( track_sptr init_states ) = 0;
 
+  /// Interpolate the states of each of a batch of tracks
+  ///
+  /// Interpolators which can fill several tracks at once, for instance in
+  /// parallel, override this to do so. The default implementation calls
+  /// interpolate() on each track and reports progress per track.
+  ///
+  /// @param tracks Tracks to interpolate.
+  ///
+  /// @return Interpolated tracks, in the same order.
+  virtual std::vector< track_sptr >
+  batch_interpolate( std::vector< track_sptr > const& tracks );
+
   /// Typedef for the callback function signature
   typedef std::function< void ( int, int ) > progress_callback_t;
 
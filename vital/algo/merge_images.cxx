@@ -20,6 +20,15 @@ ::merge_images()
   attach_logger( "merge_images" );
 }
 
+kwiver::vital::image_container_sptr
+merge_images
+::merge( kwiver::vital::image_container_sptr image1,
+         kwiver::vital::image_container_sptr image2,
+         VITAL_UNUSED kwiver::vital::image_memory_pool& pool ) const
+{
+  return this->merge( image1, image2 );
+}
+
 } // namespace algo
 
 } // namespace vital
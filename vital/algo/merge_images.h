@@ -10,6 +10,7 @@
 
 #include <vital/algo/algorithm.h>
 #include <vital/types/image_container.h>
+#include <vital/types/image_memory_pool.h>
 
 namespace kwiver {
 
@@ -30,6 +31,16 @@ class VITAL_ALGO_EXPORT merge_images
   merge( kwiver::vital::image_container_sptr image1,
          kwiver::vital::image_container_sptr image2 ) const = 0;
 
+  /// Merge images into memory taken from a pool
+  ///
+  /// Callers which merge a stream of equally sized images pass their own
+  /// pool so that the memory of each output is reused once it is released.
+  /// The default implementation ignores the pool.
+  virtual kwiver::vital::image_container_sptr
+  merge( kwiver::vital::image_container_sptr image1,
+         kwiver::vital::image_container_sptr image2,
+         kwiver::vital::image_memory_pool& pool ) const;
+
 protected:
   merge_images();
 };
@@ -20,6 +20,22 @@ ::nearest_neighbors()
   attach_logger( "algo.nearest_neighbors" );
 }
 
+// ----------------------------------------------------------------------------
+void
+nearest_neighbors
+::find_within_radius_points(
+  std::vector< vital::point_3d >& vec,
+  double r,
+  std::vector< std::vector< int > >& indices ) const
+{
+  indices.resize( vec.size() );
+  for( size_t i = 0; i < vec.size(); ++i )
+  {
+    indices[ i ].clear();
+    this->find_within_radius( vec[ i ], r, indices[ i ] );
+  }
+}
+
 } // namespace algo
 
 } // namespace vital
@@ -13,6 +13,8 @@
 
 #include <vital/types/point.h>
 
+#include <vector>
+
 namespace kwiver {
 
 namespace vital {
@@ -69,6 +71,21 @@ class VITAL_ALGO_EXPORT nearest_neighbors
     double r,
     std::vector< int >& indices ) const = 0;
 
+  /// Find all the nearest neighbors within a radius of each target point
+  /// against the points in the search tree.
+  ///
+  /// The default implementation calls find_within_radius() for each point in
+  /// turn. Implementations whose queries are thread safe should override it
+  /// to run them in parallel.
+  ///
+  /// /param [in] vec the points to search against
+  /// /param [in] r the radius of the sphere to search over
+  /// /param [out] indices the indices for the nearest points to each point
+  virtual void find_within_radius_points(
+    std::vector< vital::point_3d >& vec,
+    double r,
+    std::vector< std::vector< int > >& indices ) const;
+
 protected:
   nearest_neighbors();
 };
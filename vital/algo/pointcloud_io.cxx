@@ -11,6 +11,8 @@
 #include <vital/algo/algorithm.txx>
 #include <vital/exceptions/io.h>
 
+#include <algorithm>
+
 /// \cond DoxygenSuppress
 INSTANTIATE_ALGORITHM_DEF( kwiver::vital::algo::pointcloud_io );
 /// \endcond
@@ -24,11 +26,12 @@ pointcloud_io
   attach_logger( "algo.pointcloud_io" );
 }
 
-pointcloud_d
-pointcloud_io
-  ::load( std::string const& filename ) const
+namespace {
+
+// Make sure that the given file path exists and is a file.
+void
+check_input_path( std::string const& filename )
 {
-  // Make sure that the given file path exists and is a file.
   if( !kwiversys::SystemTools::FileExists( filename ) )
   {
     VITAL_THROW( path_not_exists, filename );
@@ -37,25 +40,13 @@ pointcloud_io
   {
     VITAL_THROW( path_not_a_file, filename );
   }
-
-  return this->load_( filename );
-}
-
-void
-pointcloud_io
-  ::set_local_geo_cs( vital::local_geo_cs const& lgcs )
-{
-  LOG_WARN( logger(), "Setting local geo cs is not implemented." );
 }
 
+// Make sure that the given file path's containing directory exists and is
+// actually a directory, and that the path is not a directory.
 void
-pointcloud_io
-  ::save( vital::path_t const& filename,
-          std::vector< vital::vector_3d > const& points,
-          std::vector< vital::rgb_color > const& colors )
+check_output_path( std::string const& filename )
 {
-  // Make sure that the given file path's containing directory exists and is
-  // actually a directory.
   std::string containing_dir = kwiversys::SystemTools::GetFilenamePath(
     kwiversys::SystemTools::CollapseFullPath( filename ) );
 
@@ -73,6 +64,92 @@ pointcloud_io
   {
     VITAL_THROW( path_not_a_file, filename );
   }
+}
+
+} // namespace
+
+pointcloud_d
+pointcloud_io
+  ::load( std::string const& filename ) const
+{
+  check_input_path( filename );
+
+  return this->load_( filename );
+}
+
+void
+pointcloud_io
+  ::load_chunks( std::string const& filename, size_t chunk_size,
+                 chunk_sink_t const& sink ) const
+{
+  check_input_path( filename );
+
+  this->load_chunks_( filename, std::max< size_t >( chunk_size, 1 ), sink );
+}
+
+void
+pointcloud_io
+  ::save_chunks( std::string const& filename, chunk_source_t const& source )
+{
+  check_output_path( filename );
+
+  this->save_chunks_( filename, source );
+}
+
+void
+pointcloud_io
+  ::load_chunks_( vital::path_t const& filename, size_t chunk_size,
+                  chunk_sink_t const& sink ) const
+{
+  auto const cloud = this->load_( filename );
+  auto const& positions = cloud.get_positions();
+  auto const& colors = cloud.get_colors();
+
+  std::vector< vector_3d > chunk_points;
+  std::vector< rgb_color > chunk_colors;
+  for( size_t begin = 0; begin < positions.size(); begin += chunk_size )
+  {
+    auto const end = std::min( positions.size(), begin + chunk_size );
+    chunk_points.assign( positions.begin() + begin, positions.begin() + end );
+    if( !colors.empty() )
+    {
+      chunk_colors.assign( colors.begin() + begin, colors.begin() + end );
+    }
+    sink( chunk_points, chunk_colors );
+  }
+}
+
+void
+pointcloud_io
+  ::save_chunks_( vital::path_t const& filename,
+                  chunk_source_t const& source ) const
+{
+  std::vector< vector_3d > points;
+  std::vector< rgb_color > colors;
+  std::vector< vector_3d > chunk_points;
+  std::vector< rgb_color > chunk_colors;
+  while( source( chunk_points, chunk_colors ) )
+  {
+    points.insert( points.end(), chunk_points.begin(), chunk_points.end() );
+    colors.insert( colors.end(), chunk_colors.begin(), chunk_colors.end() );
+  }
+  this->save_( filename, points, colors );
+}
+
+void
+pointcloud_io
+  ::set_local_geo_cs( vital::local_geo_cs const& lgcs )
+{
+  LOG_WARN( logger(), "Setting local geo cs is not implemented." );
+}
+
+void
+pointcloud_io
+  ::save( vital::path_t const& filename,
+          std::vector< vital::vector_3d > const& points,
+          std::vector< vital::rgb_color > const& colors )
+{
+  check_output_path( filename );
 
   this->save_( filename, points, colors );
 }
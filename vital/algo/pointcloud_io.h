@@ -14,6 +14,7 @@
 #include <vital/types/pointcloud.h>
 
 #include <fstream>
+#include <functional>
 #include <string>
 
 namespace kwiver {
@@ -68,6 +69,61 @@ class VITAL_ALGO_EXPORT pointcloud_io
   void save( std::string const& filename,
              vital::landmark_map_sptr const& landmarks );
 
+  /// Function given each chunk of points read by load_chunks()
+  ///
+  /// The colors are empty if the file has none.
+  using chunk_sink_t =
+    std::function< void ( std::vector< vital::vector_3d > const& points,
+                          std::vector< vital::rgb_color > const& colors ) >;
+
+  /// Function asked for each chunk of points written by save_chunks()
+  ///
+  /// It replaces the contents of \p points, and of \p colors if the cloud
+  /// has colors, with the next chunk, and returns false once there are no
+  /// more points.  Every chunk must have colors if the first one does.
+  using chunk_source_t =
+    std::function< bool ( std::vector< vital::vector_3d >& points,
+                          std::vector< vital::rgb_color >& colors ) >;
+
+  /// Load a point cloud from a file in chunks
+  ///
+  /// Points are passed to \p sink in file order, in chunks of
+  /// \p chunk_size points except for the last, so that clouds larger than
+  /// memory can be processed.  Implementations which cannot stream read the
+  /// whole cloud and then split it.
+  ///
+  /// \throws kwiver::vital::path_not_exists Thrown when the given path does
+  ///    not exist.
+  ///
+  /// \throws kwiver::vital::path_not_a_file Thrown when the given path does
+  ///    not point to a file (i.e. it points to a directory).
+  ///
+  /// \param filename the path to the file to load
+  /// \param chunk_size the number of points in each chunk
+  /// \param sink function given each chunk
+  void load_chunks( std::string const& filename, size_t chunk_size,
+                    chunk_sink_t const& sink ) const;
+
+  /// Save a point cloud to a file in chunks
+  ///
+  /// Points are taken from \p source until it returns false, so that clouds
+  /// larger than memory can be written.  Implementations which cannot stream
+  /// gather the whole cloud and then save it.
+  ///
+  /// \throws kwiver::vital::path_not_exists Thrown when the given path's
+  ///    containing directory does not exist.
+  ///
+  /// \throws kwiver::vital::path_not_a_directory Thrown when the given
+  ///    path's containing directory is not a directory.
+  ///
+  /// \throws kwiver::vital::path_not_a_file Thrown when the given path does
+  ///    not point to a file (i.e. it points to a directory).
+  ///
+  /// \param filename the path to the file to save
+  /// \param source function asked for each chunk
+  void save_chunks( std::string const& filename,
+                    chunk_source_t const& source );
+
   /// Set local geo coordinate system for the pointcloud
   ///
   /// \param lgcs the target local geo coordinate system
@@ -82,6 +138,12 @@ class VITAL_ALGO_EXPORT pointcloud_io
   virtual void save_( vital::path_t const& filename,
                       std::vector< vital::vector_3d > const& points,
                       std::vector< vital::rgb_color > const& colors ) const = 0;
+
+  virtual void load_chunks_( vital::path_t const& filename, size_t chunk_size,
+                             chunk_sink_t const& sink ) const;
+
+  virtual void save_chunks_( vital::path_t const& filename,
+                             chunk_source_t const& source ) const;
 };
 
 /// Shared pointer type for generic write_object_track_set definition type.
@@ -9,6 +9,7 @@
 #include <vital/algo/resection_camera.h>
 
 #include <vital/range/iota.h>
+#include <vital/util/thread_pool.h>
 
 /// \cond DoxygenSuppress
 INSTANTIATE_ALGORITHM_DEF( kwiver::vital::algo::resection_camera );
@@ -20,6 +21,32 @@ namespace vital {
 
 namespace algo {
 
+namespace {
+
+// ----------------------------------------------------------------------------
+// Gather the image and world points of the landmarks seen in a frame
+void
+gather_correspondences(
+  frame_id_t frame_id, landmark_map::map_landmark_t const& landmarks,
+  feature_track_set const& tracks,
+  std::vector< vector_3d >& world_points,
+  std::vector< vector_2d >& camera_points,
+  std::vector< landmark_id_t >& ids_used )
+{
+  for( auto const& fts : tracks.frame_feature_track_states( frame_id ) )
+  {
+    auto lmi = landmarks.find( fts->track()->id() );
+    if( lmi != landmarks.end() )
+    {
+      world_points.emplace_back( lmi->second->loc() );
+      camera_points.emplace_back( fts->feature->loc() );
+      ids_used.push_back( lmi->first );
+    }
+  }
+}
+
+} // namespace
+
 // ----------------------------------------------------------------------------
 resection_camera
 ::resection_camera()
@@ -63,20 +90,8 @@ ::resection( frame_id_t frame_id,
 
   auto const inliers_pointer = ( inliers ? &inliers_mask : nullptr );
 
-  auto const& real_landmarks = landmarks->landmarks();
-  for( auto const& fts : tracks->frame_feature_track_states( frame_id ) )
-  {
-    auto lmi = real_landmarks.find( fts->track()->id() );
-    if( lmi != real_landmarks.end() )
-    {
-      world_points.emplace_back( lmi->second->loc() );
-      camera_points.emplace_back( fts->feature->loc() );
-      if( inliers )
-      {
-        ids_used.push_back( lmi->first );
-      }
-    }
-  }
+  gather_correspondences( frame_id, landmarks->landmarks(), *tracks,
+                          world_points, camera_points, ids_used );
 
   // Resection camera using point correspondences and initial calibration guess
   auto result = resection( camera_points, world_points, cal, inliers_pointer );
@@ -93,6 +108,70 @@ ::resection( frame_id_t frame_id,
   return result;
 }
 
+// ----------------------------------------------------------------------------
+camera_map::map_camera_t
+resection_camera
+::resection( std::vector< frame_id_t > const& frame_ids,
+             landmark_map_sptr landmarks,
+             feature_track_set_sptr tracks,
+             kwiver::vital::camera_intrinsics_sptr cal,
+             std::map< frame_id_t,
+                       std::unordered_set< landmark_id_t > >* inliers ) const
+{
+  struct frame_data
+  {
+    std::vector< vector_3d > world_points;
+    std::vector< vector_2d > camera_points;
+    std::vector< landmark_id_t > ids_used;
+    std::vector< bool > inliers_mask;
+    camera_perspective_sptr camera;
+  };
+
+  // Track sets may build indices on demand, so they are read serially
+  auto const& real_landmarks = landmarks->landmarks();
+  auto data = std::vector< frame_data >( frame_ids.size() );
+  for( auto const i : range::iota( frame_ids.size() ) )
+  {
+    gather_correspondences( frame_ids[ i ], real_landmarks, *tracks,
+                            data[ i ].world_points, data[ i ].camera_points,
+                            data[ i ].ids_used );
+  }
+
+  thread_pool::instance().parallel_for(
+    data.size(), 1,
+    [ & ]( size_t begin, size_t end ){
+      for( auto i = begin; i < end; ++i )
+      {
+        auto& d = data[ i ];
+        d.camera = resection( d.camera_points, d.world_points, cal,
+                              inliers ? &d.inliers_mask : nullptr );
+      }
+    } );
+
+  camera_map::map_camera_t cameras;
+  for( auto const i : range::iota( frame_ids.size() ) )
+  {
+    auto const& d = data[ i ];
+    if( !d.camera )
+    {
+      continue;
+    }
+    cameras[ frame_ids[ i ] ] = d.camera;
+    if( inliers )
+    {
+      auto& frame_inliers = ( *inliers )[ frame_ids[ i ] ];
+      for( auto const j : range::iota( d.ids_used.size() ) )
+      {
+        if( d.inliers_mask[ j ] )
+        {
+          frame_inliers.insert( d.ids_used[ j ] );
+        }
+      }
+    }
+  }
+  return cameras;
+}
+
 } // namespace algo
 
 } // namespace vital
@@ -10,10 +10,12 @@
 
 #include <vital/algo/algorithm.h>
 
+#include <vital/types/camera_map.h>
 #include <vital/types/camera_perspective.h>
 #include <vital/types/feature_track_set.h>
 #include <vital/types/landmark_map.h>
 
+#include <map>
 #include <unordered_set>
 #include <vector>
 
@@ -100,6 +102,30 @@ class VITAL_ALGO_EXPORT resection_camera
     kwiver::vital::camera_intrinsics_sptr initial_calibration,
     std::unordered_set< landmark_id_t >* inliers = nullptr ) const;
 
+  /// Estimate camera parameters for many frames from landmarks and tracks.
+  ///
+  /// This resections the camera of each frame in \p frame_ids as the
+  /// function above does, on the vital thread pool. Use it to register many
+  /// frames against an existing reconstruction. Implementations of the
+  /// point based resection() must be safe to call concurrently.
+  ///
+  /// \param [in] frame_ids frame numbers for which to estimate cameras
+  /// \param [in] landmarks 3D landmarks locations to constrain cameras
+  /// \param [in] tracks 2D feature tracks in image coordinates
+  /// \param [in] initial_calibration
+  ///   initial guess on intrinsic parameters of the cameras
+  /// \param [out] inliers landmark identifiers of inliers of each frame
+  /// \return estimated cameras of the frames for which resection succeeded
+  virtual
+  kwiver::vital::camera_map::map_camera_t
+  resection(
+    std::vector< kwiver::vital::frame_id_t > const& frame_ids,
+    kwiver::vital::landmark_map_sptr landmarks,
+    kwiver::vital::feature_track_set_sptr tracks,
+    kwiver::vital::camera_intrinsics_sptr initial_calibration,
+    std::map< frame_id_t, std::unordered_set< landmark_id_t > >* inliers =
+      nullptr ) const;
+
 protected:
   resection_camera();
 };
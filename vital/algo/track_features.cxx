@@ -7,6 +7,7 @@
 
 #include <vital/algo/algorithm.txx>
 #include <vital/algo/track_features.h>
+#include <vital/vital_config.h>
 
 namespace kwiver {
 
@@ -20,6 +21,16 @@ ::track_features()
   attach_logger( "algo.track_features" );
 }
 
+// ----------------------------------------------------------------------------
+bool
+track_features
+::prefetch( VITAL_UNUSED frame_id_t frame_number,
+            VITAL_UNUSED image_container_sptr image_data,
+            VITAL_UNUSED image_container_sptr mask ) const
+{
+  return false;
+}
+
 } // namespace algo
 
 } // namespace vital
@@ -48,6 +48,25 @@ class VITAL_ALGO_EXPORT track_features
          image_container_sptr image_data,
          image_container_sptr mask = {} ) const = 0;
 
+  /// Offer a frame which will later be passed to track()
+  ///
+  /// This allows an implementation to begin work on the frame which does not
+  /// depend on the tracks, such as feature detection, in the background while
+  /// earlier frames are tracked. The result of track() must not depend on
+  /// whether a frame was prefetched. The default implementation does nothing
+  /// and returns false.
+  ///
+  /// \param [in] frame_number the frame number of the future frame
+  /// \param [in] image_data the image pixels for the future frame
+  /// \param [in] mask Optional mask image, as for track()
+  /// \returns true if the frame was accepted, or false if the implementation
+  ///          does not prefetch or has no capacity left; a caller should stop
+  ///          reading ahead until a prefetched frame has been tracked.
+  virtual bool
+  prefetch( frame_id_t frame_number,
+            image_container_sptr image_data,
+            image_container_sptr mask = {} ) const;
+
 protected:
   track_features();
 };
@@ -110,7 +110,10 @@ class VITAL_ALGO_EXPORT video_output
   ///
   /// This method writes the raw image to the video stream. There is no
   /// guarantee that this functions correctly when intermixed with non-raw
-  /// images.
+  /// images, except that implementations should allow a video started with
+  /// non-raw images to continue with raw images from one whose
+  /// \c is_keyframe is set, when the output encodes with the same codec and
+  /// settings as the raw images.
   virtual void add_image( video_raw_image const& image );
 
   /// Add metadata collection to the video stream.
@@ -9,9 +9,11 @@
 #include <vital/util/demangle.h>
 
 #include <memory>
+#include <new>
 #include <typeinfo>
 #include <type_traits>
 
+#include <cstddef>
 #include <cstring>
 
 namespace kwiver {
@@ -22,6 +24,11 @@ namespace vital {
 /// @brief Class that contains *any* data type.
 ///
 /// This class represents a single data item of indeterminate type.
+///
+/// Values of up to small_size bytes (less the pointer for the type's
+/// virtual table) whose move constructor does not throw, e.g. \c bool,
+/// \c double, timestamps and shared pointers, are stored inside the
+/// object itself; larger values are allocated on the heap.
 class any
 {
   template < typename T >
@@ -34,6 +41,7 @@ class any
   /// @brief Create empty object.
   ///
   any() noexcept
+    : m_content{ nullptr }
   {
   }
 
@@ -45,10 +53,9 @@ class any
   /// @param value Data item (value and type) to be held in new object.
   template < typename T, non_self< T > = nullptr >
   any( T&& value )
+    : m_content{ create< typename std::decay< T >::type >(
+                   &m_buffer, std::forward< T >( value ) ) }
   {
-    using value_t = typename std::decay< T >::type;
-    this->m_content.reset(
-      new internal_typed< value_t >{ std::forward< T >( value ) } );
   }
 
   /// @brief Create new object from existing object.
@@ -58,7 +65,8 @@ class any
   ///
   /// @param other Object to copy type and value from.
   any( any const& other )
-    : m_content{ other.m_content ? other.m_content->clone() : nullptr }
+    : m_content{ other.m_content ? other.m_content->clone( &m_buffer )
+                                 : nullptr }
   {
   }
 
@@ -70,12 +78,14 @@ class any
   ///
   /// @param other Object to move type and value from.
   any( any&& other ) noexcept
+    : m_content{ nullptr }
   {
-    this->swap( other );
+    this->take( other );
   }
 
   ~any() noexcept
   {
+    this->clear();
   }
 
   /// @brief Swap value and type.
@@ -88,7 +98,32 @@ class any
   /// @return Modified current (this) object.
   any& swap( any& rhs ) noexcept
   {
-    this->m_content.swap( rhs.m_content );
+    any temp;
+    temp.take( rhs );
+    rhs.take( *this );
+    this->take( temp );
+    return *this;
+  }
+
+  /// @brief Copy assignment operator.
+  ///
+  /// @param rhs Object to copy type and value from.
+  ///
+  /// @return Reference to this object.
+  any& operator=( any const& rhs )
+  {
+    any{ rhs }.swap( *this );
+    return *this;
+  }
+
+  /// @brief Move assignment operator.
+  ///
+  /// @param rhs Object to move type and value from.
+  ///
+  /// @return Reference to this object.
+  any& operator=( any&& rhs ) noexcept
+  {
+    any{ std::move( rhs ) }.swap( *this );
     return *this;
   }
 
@@ -124,7 +159,15 @@ class any
   ///
   void clear() noexcept
   {
-    m_content.reset();
+    if ( this->is_local() )
+    {
+      m_content->~internal();
+    }
+    else
+    {
+      delete m_content;
+    }
+    m_content = nullptr;
   }
 
   /// @brief Get typeid for current value.
@@ -171,7 +214,13 @@ class any
     return demangle( this->type().name() );
   }
 
+  /// Size of the buffer for values stored in the object itself.
+  static constexpr std::size_t small_size = 32 + sizeof( void* );
+
 private:
+  using buffer_t =
+    typename std::aligned_storage< small_size, alignof( void* ) >::type;
+
   // --------------------------------------------------------------------------
   // Base class for representing content
   class internal
@@ -179,7 +228,12 @@ class any
   public:
     virtual ~internal() { }
     virtual std::type_info const& type() const noexcept = 0;
-    virtual internal* clone() const = 0;
+
+    // Copy into buffer if it fits, else onto the heap
+    virtual internal* clone( buffer_t* buffer ) const = 0;
+
+    // Move into buffer; only called for content stored in a buffer
+    virtual internal* move( buffer_t* buffer ) noexcept = 0;
   };
 
   // --------------------------------------------------------------------------
@@ -195,9 +249,14 @@ class any
       return typeid(T);
     }
 
-    virtual internal* clone() const
+    virtual internal* clone( buffer_t* buffer ) const
     {
-      return new internal_typed{ m_any_data };
+      return any::create< T >( buffer, m_any_data );
+    }
+
+    virtual internal* move( buffer_t* buffer ) noexcept
+    {
+      return new ( buffer ) internal_typed{ std::move( m_any_data ) };
     }
 
     T m_any_data;
@@ -219,16 +278,56 @@ class any
   template < typename T >
   internal_typed< T >* content()
   {
-    return static_cast< internal_typed< T >* >( this->m_content.get() );
+    return static_cast< internal_typed< T >* >( this->m_content );
   }
 
   template < typename T >
   internal_typed< T > const* content() const
   {
-    return static_cast< internal_typed< T >* >( this->m_content.get() );
+    return static_cast< internal_typed< T >* >( this->m_content );
+  }
+
+  // True if values of type T are stored in the buffer
+  template < typename T >
+  static constexpr bool stored_locally()
+  {
+    return sizeof( internal_typed< T > ) <= sizeof( buffer_t ) &&
+           alignof( internal_typed< T > ) <= alignof( buffer_t ) &&
+           std::is_nothrow_move_constructible< T >::value;
+  }
+
+  template < typename T, typename U >
+  static internal* create( buffer_t* buffer, U&& value )
+  {
+    if ( stored_locally< T >() )
+    {
+      return new ( buffer ) internal_typed< T >{ std::forward< U >( value ) };
+    }
+    return new internal_typed< T >{ std::forward< U >( value ) };
+  }
+
+  bool is_local() const noexcept
+  {
+    return static_cast< void const* >( m_content ) == &m_buffer;
+  }
+
+  // Move the content of other into this object, which must be empty
+  void take( any& other ) noexcept
+  {
+    if ( other.is_local() )
+    {
+      m_content = other.m_content->move( &m_buffer );
+      other.clear();
+    }
+    else
+    {
+      m_content = other.m_content;
+      other.m_content = nullptr;
+    }
   }
 
-  std::unique_ptr< internal > m_content;
+  internal* m_content;
+  buffer_t m_buffer;
 };
 
 // ----------------------------------------------------------------------------
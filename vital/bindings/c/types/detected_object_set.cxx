@@ -16,7 +16,9 @@
 #include <vital/bindings/c/helpers/c_utils.h>
 #include <vital/bindings/c/helpers/detected_object.h>
 
+#include <map>
 #include <memory>
+#include <string>
 
 namespace kwiver {
 namespace vital_c {
@@ -27,6 +29,7 @@ SharedPointerCache< kwiver::vital::detected_object_set, vital_detected_object_se
 } }
 
 typedef std::vector< kwiver::vital::detected_object_sptr > vector_t;
+typedef std::map< std::string, int32_t > class_index_t;
 
 // ==================================================================
 // These two functions support C++ access to the SPTR_CACHE.
@@ -194,3 +197,88 @@ void vital_detected_object_set_select_class_threshold( vital_detected_object_set
     }
   );
 }
+
+// ------------------------------------------------------------------
+size_t vital_detected_object_set_get_boxes( vital_detected_object_set_t* set,
+                                            double* boxes,
+                                            double* confidences,
+                                            size_t capacity )
+{
+  STANDARD_CATCH(
+    "vital_detected_object_set_get_boxes", 0,
+
+    auto const sptr = kwiver::vital_c::DOBJ_SET_SPTR_CACHE.get( set );
+    size_t n = 0;
+    for ( auto const& det : *sptr )
+    {
+      if ( n < capacity )
+      {
+        if ( boxes )
+        {
+          auto const bbox = det->bounding_box();
+          boxes[ 4 * n + 0 ] = bbox.min_x();
+          boxes[ 4 * n + 1 ] = bbox.min_y();
+          boxes[ 4 * n + 2 ] = bbox.max_x();
+          boxes[ 4 * n + 3 ] = bbox.max_y();
+        }
+        if ( confidences )
+        {
+          confidences[n] = det->confidence();
+        }
+      }
+      ++n;
+    }
+    return n;
+    );
+  return 0;
+}
+
+// ------------------------------------------------------------------
+size_t vital_detected_object_set_get_classes( vital_detected_object_set_t* set,
+                                              char const* const* class_names,
+                                              size_t num_class_names,
+                                              int32_t* class_ids,
+                                              double* scores,
+                                              size_t capacity )
+{
+  STANDARD_CATCH(
+    "vital_detected_object_set_get_classes", 0,
+
+    class_index_t index;
+    for ( size_t i = 0; i < num_class_names; ++i )
+    {
+      index.emplace( class_names[i], static_cast< int32_t >( i ) );
+    }
+
+    auto const sptr = kwiver::vital_c::DOBJ_SET_SPTR_CACHE.get( set );
+    size_t n = 0;
+    for ( auto const& det : *sptr )
+    {
+      if ( n < capacity )
+      {
+        int32_t id = -1;
+        double score = 0.0;
+        auto const type = det->type();
+        if ( type && type->size() )
+        {
+          std::string name;
+          type->get_most_likely( name, score );
+          auto const it = index.find( name );
+          if ( it != index.end() )
+          {
+            id = it->second;
+          }
+          else
+          {
+            score = 0.0;
+          }
+        }
+        if ( class_ids ) class_ids[n] = id;
+        if ( scores ) scores[n] = score;
+      }
+      ++n;
+    }
+    return n;
+    );
+  return 0;
+}
@@ -20,6 +20,7 @@ extern "C"
 #include <vital/bindings/c/types/detected_object_set.h>
 
 #include <stddef.h>
+#include <stdint.h>
 
 /// VITAL Image opaque structure
 typedef struct vital_detected_object_set_s vital_detected_object_set_t;
@@ -54,6 +55,53 @@ void vital_detected_object_set_select_class_threshold( vital_detected_object_set
                                                        vital_detected_object_t*** output,
                                                        size_t* length );
 
+/**
+ * @brief Get the box and confidence of every detection in one call.
+ *
+ * Each box is written as four values: min x, min y, max x and max y.
+ * Detections are written in the order of the set, and at most @p capacity
+ * are written; either array may be null if it is not wanted.  Calling with a
+ * capacity of 0 gives the size to allocate.
+ *
+ * @param set Detection set
+ * @param[out] boxes Array of at least 4 * @p capacity values, or null
+ * @param[out] confidences Array of at least @p capacity values, or null
+ * @param capacity Number of detections the arrays can hold
+ *
+ * @return Number of detections in the set, which may exceed @p capacity
+ */
+VITAL_C_EXPORT
+size_t vital_detected_object_set_get_boxes( vital_detected_object_set_t* set,
+                                            double* boxes,
+                                            double* confidences,
+                                            size_t capacity );
+
+/**
+ * @brief Get the most likely class of every detection in one call.
+ *
+ * Classes are reported as indices into @p class_names, so that callers
+ * resolve names once rather than per detection.  Detections without a class,
+ * or whose most likely class is not in @p class_names, get a class id of -1
+ * and a score of 0.  Detections are in the same order as for
+ * vital_detected_object_set_get_boxes().
+ *
+ * @param set Detection set
+ * @param class_names Names of the classes of interest
+ * @param num_class_names Number of entries in @p class_names
+ * @param[out] class_ids Array of at least @p capacity ids, or null
+ * @param[out] scores Array of at least @p capacity scores, or null
+ * @param capacity Number of detections the arrays can hold
+ *
+ * @return Number of detections in the set, which may exceed @p capacity
+ */
+VITAL_C_EXPORT
+size_t vital_detected_object_set_get_classes( vital_detected_object_set_t* set,
+                                              char const* const* class_names,
+                                              size_t num_class_names,
+                                              int32_t* class_ids,
+                                              double* scores,
+                                              size_t capacity );
+
 #ifdef __cplusplus
 }
 #endif
@@ -186,3 +186,23 @@ PT_ACCESSOR( size_t, num_bytes )
 PT_ACCESSOR( vital_image_pixel_type_t, type )
 
 #undef PT_ACCESSOR
+
+/// Get the whole memory layout of an image in one call
+void vital_image_get_layout( vital_image_t* image,
+                             vital_image_layout_t* layout )
+{
+  STANDARD_CATCH(
+    "C::image::get_layout", 0,
+    auto* img = reinterpret_cast<kwiver::vital::image*>( image );
+    layout->first_pixel = img->first_pixel();
+    layout->width = img->width();
+    layout->height = img->height();
+    layout->depth = img->depth();
+    layout->w_step = img->w_step();
+    layout->h_step = img->h_step();
+    layout->d_step = img->d_step();
+    layout->pixel_type =
+      static_cast<vital_image_pixel_type_t>( img->pixel_traits().type );
+    layout->pixel_num_bytes = img->pixel_traits().num_bytes;
+  );
+}
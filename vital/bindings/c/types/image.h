@@ -33,6 +33,25 @@ enum vital_image_pixel_type_t {VITAL_PIXEL_UNKNOWN = 0,
                                VITAL_PIXEL_FLOAT = 3,
                                VITAL_PIXEL_BOOL = 4};
 
+/// Memory layout of an image, for reading its pixels in place
+/**
+ * Pixel (i, j, k) is at
+ * first_pixel + (i * w_step + j * h_step + k * d_step) * pixel_num_bytes.
+ * Steps are counted in pixels and may be negative, for example for an image
+ * which is a flipped view of another.
+ */
+typedef struct vital_image_layout_s {
+  void* first_pixel;
+  size_t width;
+  size_t height;
+  size_t depth;
+  int64_t w_step;
+  int64_t h_step;
+  int64_t d_step;
+  enum vital_image_pixel_type_t pixel_type;
+  size_t pixel_num_bytes;
+} vital_image_layout_t;
+
 /// Create a new, empty image
 VITAL_C_EXPORT
 vital_image_t* vital_image_new();
@@ -141,7 +160,19 @@ size_t vital_image_h_step( vital_image_t* image );
 VITAL_C_EXPORT
 size_t vital_image_d_step( vital_image_t* image );
 
-/// Get image d_step
+/// Get the whole memory layout of an image in one call
+/**
+ * The pixels are not copied; \c first_pixel stays valid for as long as the
+ * image, or another image sharing its memory, exists.
+ *
+ * @param image The image to describe
+ * @param[out] layout Set to the layout of \p image
+ */
+VITAL_C_EXPORT
+void vital_image_get_layout( vital_image_t* image,
+                             vital_image_layout_t* layout );
+
+/// Check if the image pixels are contiguous in memory
 VITAL_C_EXPORT
 bool vital_image_is_contiguous( vital_image_t* image );
 
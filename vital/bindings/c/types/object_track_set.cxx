@@ -80,3 +80,52 @@ vital_object_trackset_new( size_t length, vital_track_t **tracks,
   return 0;
 }
 
+
+/// Get the box and confidence of every object track state in one call
+size_t
+vital_object_trackset_get_detections( vital_trackset_t const *trackset,
+                                      double *boxes, double *confidences,
+                                      size_t capacity,
+                                      vital_error_handle_t *eh )
+{
+  STANDARD_CATCH(
+    "vital_object_trackset_get_detections", eh,
+    auto ts_sptr = vital_c::TRACK_SET_SPTR_CACHE.get( trackset );
+    size_t n = 0;
+    for( auto const& t : ts_sptr->tracks() )
+    {
+      for( auto const& ts : *t )
+      {
+        if( n < capacity )
+        {
+          auto const ots =
+            std::dynamic_pointer_cast< vital::object_track_state >( ts );
+          auto const det = ( ots ? ots->detection() : nullptr );
+          if( boxes )
+          {
+            double* const b = boxes + 4 * n;
+            if( det )
+            {
+              auto const bbox = det->bounding_box();
+              b[0] = bbox.min_x();
+              b[1] = bbox.min_y();
+              b[2] = bbox.max_x();
+              b[3] = bbox.max_y();
+            }
+            else
+            {
+              b[0] = b[1] = b[2] = b[3] = 0.0;
+            }
+          }
+          if( confidences )
+          {
+            confidences[n] = ( det ? det->confidence() : 0.0 );
+          }
+        }
+        ++n;
+      }
+    }
+    return n;
+  );
+  return 0;
+}
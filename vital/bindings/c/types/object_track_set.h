@@ -68,6 +68,28 @@ vital_trackset_t*
 vital_object_trackset_new( size_t length, vital_track_t **tracks,
                            vital_error_handle_t *eh );
 
+/// Get the box and confidence of every object track state in one call
+/**
+ * States are written in the same order as by vital_trackset_get_states(), so
+ * its track ID and frame arrays line up with these.  Each box is written as
+ * four values: min x, min y, max x and max y.  States without a detection
+ * are written as zero boxes with zero confidence.  At most \p capacity
+ * states are written; either array may be null if it is not wanted.
+ *
+ * \param trackset the object track set instance
+ * \param[out] boxes array of at least 4 * \p capacity values, or null
+ * \param[out] confidences array of at least \p capacity values, or null
+ * \param capacity number of states the arrays can hold
+ * \param eh Vital error handle instance
+ * \returns number of track states in the set, which may exceed \p capacity
+ */
+VITAL_C_EXPORT
+size_t
+vital_object_trackset_get_detections( vital_trackset_t const *trackset,
+                                      double *boxes, double *confidences,
+                                      size_t capacity,
+                                      vital_error_handle_t *eh );
+
 #ifdef __cplusplus
 }
 #endif
@@ -222,6 +222,33 @@ vital_trackset_get_track( vital_trackset_t const *trackset, int64_t tid,
   return 0;
 }
 
+/// Get the track ID and frame of every track state in the set in one call
+size_t
+vital_trackset_get_states( vital_trackset_t const *trackset,
+                           int64_t *track_ids, int64_t *frames,
+                           size_t capacity, vital_error_handle_t *eh )
+{
+  STANDARD_CATCH(
+    "vital_trackset_get_states", eh,
+    auto ts_sptr = vital_c::TRACK_SET_SPTR_CACHE.get( trackset );
+    size_t n = 0;
+    for( auto const& t : ts_sptr->tracks() )
+    {
+      for( auto const& ts : *t )
+      {
+        if( n < capacity )
+        {
+          if( track_ids ) track_ids[n] = t->id();
+          if( frames ) frames[n] = ts->frame();
+        }
+        ++n;
+      }
+    }
+    return n;
+  );
+  return 0;
+}
+
 /// Create a vital_track_set_t around an existing shared pointer.
 vital_trackset_t*
 vital_track_set_new_from_sptr( kwiver::vital::track_set_sptr ts_sptr,
@@ -173,6 +173,27 @@ vital_track_t*
 vital_trackset_get_track( vital_trackset_t const *trackset, int64_t tid,
                           vital_error_handle_t *eh );
 
+/// Get the track ID and frame of every track state in the set in one call
+/**
+ * Track states are written track by track, in the order of the tracks in the
+ * set and of the states within each track, so entry \c i of each array
+ * describes the same state.  At most \p capacity states are written; either
+ * array may be null if it is not wanted.  Calling with a capacity of 0 gives
+ * the size to allocate.
+ *
+ * \param trackset the track set instance
+ * \param[out] track_ids array of at least \p capacity track IDs, or null
+ * \param[out] frames array of at least \p capacity frame IDs, or null
+ * \param capacity number of states the arrays can hold
+ * \param eh Vital error handle instance
+ * \returns number of track states in the set, which may exceed \p capacity
+ */
+VITAL_C_EXPORT
+size_t
+vital_trackset_get_states( vital_trackset_t const *trackset,
+                           int64_t *track_ids, int64_t *frames,
+                           size_t capacity, vital_error_handle_t *eh );
+
 #ifdef __cplusplus
 }
 #endif
@@ -151,6 +151,7 @@ ::unset_value( config_block_key_t const& key )
 
     m_store.erase( i );
     m_descr_store.erase( j );
+    ++m_generation;
 
     if ( k != m_def_store.end() )
     {
@@ -261,6 +262,19 @@ ::has_value( config_block_key_t const& key ) const
   return ( 0 != m_store.count( key ) );
 }
 
+// ----------------------------------------------------------------------------
+uint64_t
+config_block
+::generation() const
+{
+  if ( m_parent )
+  {
+    return m_parent->generation();
+  }
+
+  return m_generation;
+}
+
 // ----------------------------------------------------------------------------
 // Internal constructor
 config_block
@@ -270,7 +284,8 @@ ::config_block( config_block_key_t const& name, config_block_sptr parent )
     m_store(),
     m_descr_store(),
     m_ro_list(),
-    m_def_store()
+    m_def_store(),
+    m_generation( 0 )
 {
 }
 
@@ -332,7 +347,20 @@ ::i_set_value( config_block_key_t const&          key,
     }
 
     config_block_value_t temp( value );
-    m_store[key] = string_trim( temp ); // trim value in place. Leading and trailing blanks are evil!
+    string_trim( temp ); // trim value in place. Leading and trailing blanks are evil!
+
+    // Only count real changes, so readers caching parsed values keep them
+    auto const i = m_store.find( key );
+    if ( i == m_store.end() )
+    {
+      m_store.emplace( key, temp );
+      ++m_generation;
+    }
+    else if ( i->second != temp )
+    {
+      i->second = temp;
+      ++m_generation;
+    }
 
     // Only assign the description given if there is no stored description
     // for this key, or the given description is non-zero.
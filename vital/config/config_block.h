@@ -17,6 +17,7 @@
 #include "config_block_exception.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <set>
 #include <string>
@@ -377,6 +378,18 @@ class VITAL_CONFIG_EXPORT config_block
   /// \return \b true if the location is available.
   bool get_location( config_block_key_t const& key, kwiver::vital::source_location& loc ) const;
 
+  /// Get the number of changes made to the values of this block.
+  ///
+  /// The count goes up whenever a value is set to a new string or is
+  /// unset, so a reader that parsed values when the count was \c n need
+  /// not parse them again while it is still \c n. A view made with
+  /// subblock_view() reports the count of the block it views.
+  ///
+  /// \sa config_value_handle
+  ///
+  /// \returns Change count of the underlying block.
+  uint64_t generation() const;
+
 private:
   /// Internal constructor
   VITAL_CONFIG_NO_EXPORT config_block( config_block_key_t const& name, config_block_sptr parent );
@@ -443,6 +456,9 @@ class VITAL_CONFIG_EXPORT config_block
 
   // location where key was defined.
   location_t m_def_store;
+
+  // number of changes to m_store
+  uint64_t m_generation;
 };
 
 // ----------------------------------------------------------------------------
@@ -0,0 +1,152 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// @file
+/// \brief Typed, cached access to one \link kwiver::vital::config_block
+/// configuration \endlink value
+
+#ifndef KWIVER_CONFIG_VALUE_HANDLE_H_
+#define KWIVER_CONFIG_VALUE_HANDLE_H_
+
+#include "config_block.h"
+
+#include <cstdint>
+
+namespace kwiver {
+
+namespace vital {
+
+// ----------------------------------------------------------------------------
+/// Typed handle to one value of a config block.
+///
+/// config_block::get_value() finds the key and converts its string on
+/// every call. A handle does that once and keeps the converted value,
+/// converting again only after the block's generation() has moved on,
+/// i.e. after some value in the block was changed. Code that reads its
+/// settings per frame can hold handles instead of querying the block:
+///
+/// \code
+/// // in set_configuration()
+/// m_threshold = config_value_handle< double >( config, "threshold", 0.5 );
+///
+/// // per frame
+/// if ( score > *m_threshold ) ...
+/// \endcode
+///
+/// Since the handle shares the block, changes made to it later (by
+/// sprokit reconfiguration, or by the source behind a
+/// dynamic_configuration algorithm) reach the handle without the reader
+/// asking for them; update() tells the reader when that has happened.
+///
+/// Like config_block itself, a handle is not synchronized; it must not
+/// be read from one thread while the block is changed from another.
+///
+/// \tparam T Type of the value, as for config_block::get_value().
+template < typename T >
+class config_value_handle
+{
+public:
+  /// Create a handle bound to no block.
+  config_value_handle()
+    : m_has_default( false ),
+      m_default(),
+      m_value(),
+      m_generation( 0 ),
+      m_valid( false )
+  { }
+
+  /// Create a handle to a value that must be present.
+  ///
+  /// \param block Config block to read; shared with the handle.
+  /// \param key Key of the value in \p block.
+  config_value_handle( config_block_sptr block, config_block_key_t const& key )
+    : m_block( block ),
+      m_key( key ),
+      m_has_default( false ),
+      m_default(),
+      m_value(),
+      m_generation( 0 ),
+      m_valid( false )
+  { }
+
+  /// Create a handle to a value with a default.
+  ///
+  /// \param block Config block to read; shared with the handle.
+  /// \param key Key of the value in \p block.
+  /// \param def Value to use when \p key is absent or can not be converted.
+  config_value_handle( config_block_sptr block, config_block_key_t const& key,
+                       T const& def )
+    : m_block( block ),
+      m_key( key ),
+      m_has_default( true ),
+      m_default( def ),
+      m_value(),
+      m_generation( 0 ),
+      m_valid( false )
+  { }
+
+  /// Get the current value.
+  ///
+  /// \throws no_such_configuration_value_exception
+  ///   Thrown if the handle has no default and the key is absent.
+  /// \throws bad_config_block_cast_exception
+  ///   Thrown if the handle has no default and the value can not be
+  ///   converted to \c T.
+  T const& get() const
+  {
+    this->refresh();
+    return m_value;
+  }
+
+  T const& operator*() const { return this->get(); }
+  T const* operator->() const { return &this->get(); }
+
+  /// Bring the cached value up to date.
+  ///
+  /// \returns \b true if the block has changed since the value was last
+  ///   read (or it was never read), \b false otherwise. The value itself
+  ///   may be the same if another key was changed.
+  bool update()
+  {
+    return this->refresh();
+  }
+
+  /// Key of the value.
+  config_block_key_t const& key() const { return m_key; }
+
+  /// Config block the value is read from.
+  config_block_sptr const& block() const { return m_block; }
+
+private:
+  bool refresh() const
+  {
+    uint64_t const generation = m_block->generation();
+    if ( m_valid && generation == m_generation )
+    {
+      return false;
+    }
+
+    m_value = m_has_default
+      ? m_block->get_value< T >( m_key, m_default )
+      : m_block->get_value< T >( m_key );
+    m_generation = generation;
+    m_valid = true;
+    return true;
+  }
+
+  config_block_sptr m_block;
+  config_block_key_t m_key;
+  bool m_has_default;
+  T m_default;
+
+  mutable T m_value;
+  mutable uint64_t m_generation;
+  mutable bool m_valid;
+};
+
+} // namespace vital
+
+} // namespace kwiver
+
+#endif
@@ -6,6 +6,7 @@
 /// \brief vital config_block tests
 
 #include <vital/config/config_block.h>
+#include <vital/config/config_value_handle.h>
 #include <vital/util/enum_converter.h>
 #include <vital/types/vector.h>
 
@@ -546,3 +547,42 @@ TEST(config_block, as_vector)
     EXPECT_EQ( i + 1, values[i] );
   }
 }
+
+// ----------------------------------------------------------------------------
+TEST(config_block, value_handle)
+{
+  config_block_sptr const config = config_block::empty_config();
+  config->set_value( keya, 1.5 );
+
+  config_value_handle< double > a( config, keya );
+  config_value_handle< int > b( config, keyb, 7 );
+
+  EXPECT_EQ( 1.5, *a );
+  EXPECT_EQ( 7, *b );
+  EXPECT_FALSE( a.update() );
+
+  // setting the same string again is not a change
+  auto const generation = config->generation();
+  config->set_value( keya, "1.5" );
+  EXPECT_EQ( generation, config->generation() );
+  EXPECT_FALSE( a.update() );
+
+  // changes made through a view reach handles on the block, and back
+  auto const view = config->subblock_view( block1_name );
+  config_value_handle< int > c( view, keyc, 0 );
+  EXPECT_EQ( 0, *c );
+
+  config->set_value( block1_name + config_block::block_sep() + keyc, 3 );
+  config->set_value( keyb, 2 );
+  view->set_value( keya, "ignored" );
+  EXPECT_TRUE( a.update() );
+  EXPECT_EQ( 1.5, *a );
+  EXPECT_EQ( 2, *b );
+  EXPECT_EQ( 3, *c );
+
+  config->unset_value( keyb );
+  EXPECT_EQ( 7, *b );
+
+  config->unset_value( keya );
+  EXPECT_THROW( a.get(), no_such_configuration_value_exception );
+}
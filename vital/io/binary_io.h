@@ -0,0 +1,94 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Helpers shared by the compact binary file formats of vital/io
+///
+/// This header is private to the vital library and is not installed.
+
+#ifndef VITAL_IO_BINARY_IO_H_
+#define VITAL_IO_BINARY_IO_H_
+
+#include <vital/exceptions.h>
+#include <vital/vital_types.h>
+
+#include <kwiversys/SystemTools.hxx>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace kwiver {
+namespace vital {
+namespace detail {
+
+// ----------------------------------------------------------------------------
+inline bool
+host_is_little_endian()
+{
+  uint16_t const value = 1;
+  unsigned char first;
+  std::memcpy( &first, &value, 1 );
+  return first == 1;
+}
+
+// ----------------------------------------------------------------------------
+// Append a little-endian value to a buffer
+template < typename T >
+void
+put_little_endian( std::string& buffer, T value )
+{
+  char bytes[ sizeof( T ) ];
+  std::memcpy( bytes, &value, sizeof( T ) );
+  if( !host_is_little_endian() )
+  {
+    std::reverse( bytes, bytes + sizeof( T ) );
+  }
+  buffer.append( bytes, sizeof( T ) );
+}
+
+// ----------------------------------------------------------------------------
+// Read a little-endian value from memory
+template < typename T >
+T
+get_little_endian( char const* p )
+{
+  char bytes[ sizeof( T ) ];
+  std::memcpy( bytes, p, sizeof( T ) );
+  if( !host_is_little_endian() )
+  {
+    std::reverse( bytes, bytes + sizeof( T ) );
+  }
+  T value;
+  std::memcpy( &value, bytes, sizeof( T ) );
+  return value;
+}
+
+// ----------------------------------------------------------------------------
+// Check that an output file can be created at a path
+inline void
+check_output_file( path_t const& file_path )
+{
+  if( kwiversys::SystemTools::FileIsDirectory( file_path ) )
+  {
+    VITAL_THROW( file_write_exception, file_path,
+                 "Path given is a directory, can not write file." );
+  }
+
+  std::string const parent_dir = kwiversys::SystemTools::GetFilenamePath(
+    kwiversys::SystemTools::CollapseFullPath( file_path ) );
+  if( !kwiversys::SystemTools::FileIsDirectory( parent_dir ) &&
+      !kwiversys::SystemTools::MakeDirectory( parent_dir ) )
+  {
+    VITAL_THROW( file_write_exception, parent_dir,
+                 "Attempted directory creation, but no directory created!" );
+  }
+}
+
+} // namespace detail
+} // namespace vital
+} // namespace kwiver
+
+#endif // VITAL_IO_BINARY_IO_H_
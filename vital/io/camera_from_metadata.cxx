@@ -8,7 +8,9 @@
 #include "camera_from_metadata.h"
 
 #include <vital/math_constants.h>
+#include <vital/types/geodesy.h>
 #include <vital/types/metadata_traits.h>
+#include <vital/util/thread_pool.h>
 #include <vital/vital_config.h>
 
 namespace kwiver {
@@ -176,6 +178,72 @@ intrinsics_from_metadata(metadata const& md,
     (focal_len, pp, 1.0, 0.0, Eigen::VectorXd(), image_width, image_height);
 }
 
+namespace {
+
+/// Get the camera rotation from the platform and sensor angles of metadata
+///
+/// \return True only if all the angles needed are present
+bool
+rotation_from_metadata(metadata const& md, rotation_d& rotation)
+{
+  bool has_platform_yaw = false;
+  bool has_platform_pitch = false;
+  bool has_platform_roll = false;
+  bool has_sensor_yaw = false;
+  bool has_sensor_pitch = false;
+
+  double platform_yaw = 0.0, platform_pitch = 0.0, platform_roll = 0.0;
+  if (auto& mdi = md.find(VITAL_META_PLATFORM_HEADING_ANGLE))
+  {
+    platform_yaw = mdi.get< double >();
+    has_platform_yaw = true;
+  }
+  if (auto& mdi = md.find(VITAL_META_PLATFORM_PITCH_ANGLE))
+  {
+    platform_pitch = mdi.get< double >();
+    has_platform_pitch = true;
+  }
+  if (auto& mdi = md.find(VITAL_META_PLATFORM_ROLL_ANGLE))
+  {
+    platform_roll = mdi.get< double >();
+    has_platform_roll = true;
+  }
+  double sensor_yaw = 0.0, sensor_pitch = 0.0, sensor_roll = 0.0;
+  if (auto& mdi = md.find(VITAL_META_SENSOR_REL_AZ_ANGLE))
+  {
+    sensor_yaw = mdi.get< double >();
+    has_sensor_yaw = true;
+  }
+  if (auto& mdi = md.find(VITAL_META_SENSOR_REL_EL_ANGLE))
+  {
+    sensor_pitch = mdi.get< double >();
+    has_sensor_pitch = true;
+  }
+  if (auto& mdi = md.find(VITAL_META_SENSOR_REL_ROLL_ANGLE))
+  {
+    sensor_roll = mdi.get< double >();
+  }
+
+  if (has_platform_yaw && has_platform_pitch && has_platform_roll &&
+      has_sensor_yaw && has_sensor_pitch &&
+      // Sensor roll is ignored here on purpose.
+      // It is fixed on some platforms to zero.
+      !(std::isnan(platform_yaw) || std::isnan(platform_pitch) ||
+        std::isnan(platform_roll) || std::isnan(sensor_yaw) ||
+        std::isnan(sensor_pitch) || std::isnan(sensor_roll)))
+  {
+    // Only set the camera's rotation if all metadata angles are present
+
+    rotation =
+      uas_ypr_to_rotation( platform_yaw, platform_pitch, platform_roll,
+                           sensor_yaw,   sensor_pitch,   sensor_roll );
+    return true;
+  }
+  return false;
+}
+
+} // end anonymous namespace
+
 /// Use a sequence of metadata objects to initialize a sequence of cameras
 std::map<frame_id_t, camera_sptr>
 initialize_cameras_with_metadata(std::map<frame_id_t,
@@ -183,11 +251,10 @@ initialize_cameras_with_metadata(std::map<frame_id_t,
                                  simple_camera_perspective const& base_camera,
                                  local_geo_cs& lgcs,
                                  bool init_intrinsics,
-                                 rotation_d const& rot_offset)
+                    VITAL_UNUSED rotation_d const& rot_offset)
 {
   std::map<frame_id_t, camera_sptr> cam_map;
   vector_3d mean(0, 0, 0);
-  simple_camera_perspective active_cam(base_camera);
 
   bool update_local_origin = false;
   if (lgcs.origin().is_empty() && !md_map.empty())
@@ -215,27 +282,106 @@ initialize_cameras_with_metadata(std::map<frame_id_t,
       }
     }
   }
+
+  std::vector<std::pair<frame_id_t, metadata const*>> packets;
   for (auto const& p : md_map)
   {
-    auto md = p.second;
-    if (!md)
+    if (p.second)
     {
-      continue;
+      packets.emplace_back(p.first, p.second.get());
     }
-    if (init_intrinsics)
+  }
+  size_t const n = packets.size();
+
+  // extract what each packet provides, in parallel; locations are left in
+  // the CRS of the metadata for now
+  auto const base_K = base_camera.get_intrinsics();
+  std::vector<camera_intrinsics_sptr> intrinsics(n);
+  std::vector<rotation_d> rotations(n);
+  std::vector<char> has_rotation(n, 0);
+  std::vector<vector_3d> locations(n);
+  std::vector<int> location_crs(n, -1);
+  thread_pool::instance().parallel_for(
+    n, 64,
+    [&](size_t begin, size_t end)
     {
-      auto K = base_camera.get_intrinsics();
-      K = intrinsics_from_metadata(*md, K->image_width(), K->image_height());
-      if (K)
+      for (size_t i = begin; i < end; ++i)
       {
-        active_cam.set_intrinsics(K);
+        metadata const& md = *packets[i].second;
+        if (init_intrinsics)
+        {
+          intrinsics[i] = intrinsics_from_metadata(md, base_K->image_width(),
+                                                   base_K->image_height());
+        }
+        has_rotation[i] = rotation_from_metadata(md, rotations[i]);
+        if (auto& mdi = md.find(VITAL_META_SENSOR_LOCATION))
+        {
+          auto const gloc = mdi.get< geo_point >();
+          locations[i] = gloc.location();
+          location_crs[i] = gloc.crs();
+        }
+      }
+    });
+
+  // convert the locations to the CRS of the origin, with one conversion
+  // call for all the locations in each other CRS
+  if (!lgcs.origin().is_empty())
+  {
+    int const origin_crs = lgcs.origin().crs();
+    vector_3d const origin = lgcs.origin().location();
+
+    std::map<int, std::vector<size_t>> by_crs;
+    for (size_t i = 0; i < n; ++i)
+    {
+      if (location_crs[i] >= 0 && location_crs[i] != origin_crs)
+      {
+        by_crs[location_crs[i]].push_back(i);
       }
     }
-    if (update_camera_from_metadata(*md, lgcs, active_cam, rot_offset))
+    for (auto const& c : by_crs)
+    {
+      std::vector<vector_3d> points;
+      points.reserve(c.second.size());
+      for (auto const i : c.second)
+      {
+        points.push_back(locations[i]);
+      }
+      geo_conv(points.data(), points.size(), c.first, origin_crs);
+      for (size_t j = 0; j < points.size(); ++j)
+      {
+        locations[c.second[j]] = points[j];
+      }
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+      locations[i] -= origin;
+    }
+  }
+
+  // frames missing part of the pose keep it from the frame before, so
+  // the cameras are built in order
+  simple_camera_perspective active_cam(base_camera);
+  for (size_t i = 0; i < n; ++i)
+  {
+    if (intrinsics[i])
+    {
+      active_cam.set_intrinsics(intrinsics[i]);
+    }
+    bool const has_location = location_crs[i] >= 0;
+    if (has_rotation[i])
+    {
+      active_cam.set_rotation(rotations[i]);
+    }
+    if (has_location)
+    {
+      active_cam.set_center(locations[i]);
+    }
+    if (has_rotation[i] || has_location)
     {
       mean += active_cam.center();
-      cam_map[p.first] =
-        std::make_shared<simple_camera_perspective>(active_cam);
+      cam_map.emplace_hint(cam_map.end(), packets[i].first,
+        std::make_shared<simple_camera_perspective>(active_cam));
     }
   }
 
@@ -272,59 +418,10 @@ update_camera_from_metadata(metadata const& md,
   bool rotation_set = false;
   bool translation_set = false;
 
-  bool has_platform_yaw = false;
-  bool has_platform_pitch = false;
-  bool has_platform_roll = false;
-  bool has_sensor_yaw = false;
-  bool has_sensor_pitch = false;
-
-  double platform_yaw = 0.0, platform_pitch = 0.0, platform_roll = 0.0;
-  if (auto& mdi = md.find(VITAL_META_PLATFORM_HEADING_ANGLE))
+  rotation_d rotation;
+  if (rotation_from_metadata(md, rotation))
   {
-    platform_yaw = mdi.get< double >();
-    has_platform_yaw = true;
-  }
-  if (auto& mdi = md.find(VITAL_META_PLATFORM_PITCH_ANGLE))
-  {
-    platform_pitch = mdi.get< double >();
-    has_platform_pitch = true;
-  }
-  if (auto& mdi = md.find(VITAL_META_PLATFORM_ROLL_ANGLE))
-  {
-    platform_roll = mdi.get< double >();
-    has_platform_roll = true;
-  }
-  double sensor_yaw = 0.0, sensor_pitch = 0.0, sensor_roll = 0.0;
-  if (auto& mdi = md.find(VITAL_META_SENSOR_REL_AZ_ANGLE))
-  {
-    sensor_yaw = mdi.get< double >();
-    has_sensor_yaw = true;
-  }
-  if (auto& mdi = md.find(VITAL_META_SENSOR_REL_EL_ANGLE))
-  {
-    sensor_pitch = mdi.get< double >();
-    has_sensor_pitch = true;
-  }
-  if (auto& mdi = md.find(VITAL_META_SENSOR_REL_ROLL_ANGLE))
-  {
-    sensor_roll = mdi.get< double >();
-  }
-
-  if (has_platform_yaw && has_platform_pitch && has_platform_roll &&
-      has_sensor_yaw && has_sensor_pitch &&
-      // Sensor roll is ignored here on purpose.
-      // It is fixed on some platforms to zero.
-      !(std::isnan(platform_yaw) || std::isnan(platform_pitch) ||
-        std::isnan(platform_roll) || std::isnan(sensor_yaw) ||
-        std::isnan(sensor_pitch) || std::isnan(sensor_roll)))
-  {
-    // Only set the camera's rotation if all metadata angles are present
-
-    auto const rotation =
-      uas_ypr_to_rotation( platform_yaw, platform_pitch, platform_roll,
-                           sensor_yaw,   sensor_pitch,   sensor_roll );
     cam.set_rotation( rotation );
-
     rotation_set = true;
   }
 
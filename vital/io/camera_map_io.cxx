@@ -6,14 +6,58 @@
 /// \brief Implementation of camera map io functions
 
 #include "camera_map_io.h"
+#include "binary_io.h"
 #include "camera_io.h"
 #include <vital/exceptions.h>
+#include <vital/util/mapped_file.h>
+#include <vital/util/thread_pool.h>
 
 #include <kwiversys/SystemTools.hxx>
 
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
 namespace kwiver {
 namespace vital {
 
+using detail::check_output_file;
+using detail::get_little_endian;
+using detail::put_little_endian;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Compact binary camera (KWC) format
+//
+// A KWC file is a 40-byte header followed by six blocks:
+// - the frame ids of the cameras as 8-byte integers, in increasing order
+// - the index of the intrinsics of each camera as 8-byte integers
+// - the center of each camera as 3 doubles
+// - the rotation of each camera as a quaternion of 4 doubles (w, x, y, z)
+// - the center covariance of each camera as the 6 doubles of its upper
+//   triangle, by column
+// - the intrinsics, one 64-byte record for each intrinsics object shared
+//   by the cameras: the focal length, principal point (x, y), aspect ratio
+//   and skew as doubles, the image width and height as 4-byte integers,
+//   and the index of the first distortion coefficient and the number of
+//   coefficients as 8-byte integers
+// - the distortion coefficients of all intrinsics as doubles
+// Cameras are stored by column so that each value of a camera is found
+// from its index alone.  All numbers are little-endian.
+
+constexpr char kwc_magic[8] = { 'K', 'W', 'V', 'R', 'C', 'A', 'M', 'S' };
+constexpr uint32_t kwc_version = 1;
+
+constexpr size_t kwc_header_size = 40;
+constexpr size_t kwc_camera_size = 8 + 8 + 24 + 32 + 48;
+constexpr size_t kwc_intrinsics_size = 64;
+constexpr size_t kwc_coeff_size = 8;
+
+} // end namespace
+
 /// Load a camera map from krtd files stored in a directory.
 camera_map_sptr
 read_krtd_files( std::vector< path_t > const& img_files, path_t const& dir )
@@ -23,17 +67,39 @@ read_krtd_files( std::vector< path_t > const& img_files, path_t const& dir )
     VITAL_THROW( path_not_exists, dir );
   }
 
-  camera_map::map_camera_t cameras;
+  // Exceptions must not escape the pool threads, so each is kept to be
+  // thrown here in file order
+  std::vector< camera_perspective_sptr > read( img_files.size() );
+  std::vector< std::exception_ptr > errors( img_files.size() );
+  thread_pool::instance().parallel_for( img_files.size(), 16,
+    [ & ]( size_t begin, size_t end )
+    {
+      for ( size_t fid = begin; fid < end; ++fid )
+      {
+        try
+        {
+          read[fid] = read_krtd_file( img_files[fid], dir );
+        }
+        catch ( const file_not_found_exception& )
+        {
+        }
+        catch ( ... )
+        {
+          errors[fid] = std::current_exception();
+        }
+      }
+    } );
 
+  camera_map::map_camera_t cameras;
   for ( size_t fid = 0; fid < img_files.size(); ++fid )
   {
-    try
+    if ( errors[fid] )
     {
-      cameras[fid] = read_krtd_file( img_files[fid], dir );
+      std::rethrow_exception( errors[fid] );
     }
-    catch ( const file_not_found_exception& )
+    if ( read[fid] )
     {
-      continue;
+      cameras[fid] = read[fid];
     }
   }
 
@@ -45,4 +111,362 @@ read_krtd_files( std::vector< path_t > const& img_files, path_t const& dir )
   return camera_map_sptr( new simple_camera_map( cameras ) );
 }
 
+// ----------------------------------------------------------------------------
+void
+write_kwc( std::ostream& os, camera_map const& cameras )
+{
+  auto const all_cameras = cameras.cameras();
+
+  std::string frames, intrinsic_ids, centers, rotations, covars;
+  std::string intrinsics, coeffs;
+  std::unordered_map< camera_intrinsics const*, uint64_t > intrinsics_index;
+  uint64_t num_coeffs = 0;
+
+  for( auto const& c : all_cameras )
+  {
+    auto const cam =
+      std::dynamic_pointer_cast< camera_perspective >( c.second );
+    if( !cam )
+    {
+      VITAL_THROW( invalid_data, "Camera of frame " +
+                                 std::to_string( c.first ) +
+                                 " is not a perspective camera" );
+    }
+
+    // Intrinsics are written once for all the cameras which share them
+    auto const K = cam->intrinsics();
+    auto const inserted =
+      intrinsics_index.emplace( K.get(), intrinsics_index.size() );
+    if( inserted.second )
+    {
+      auto const pp = K->principal_point();
+      auto const dist = K->dist_coeffs();
+      put_little_endian< double >( intrinsics, K->focal_length() );
+      put_little_endian< double >( intrinsics, pp.x() );
+      put_little_endian< double >( intrinsics, pp.y() );
+      put_little_endian< double >( intrinsics, K->aspect_ratio() );
+      put_little_endian< double >( intrinsics, K->skew() );
+      put_little_endian< uint32_t >( intrinsics, K->image_width() );
+      put_little_endian< uint32_t >( intrinsics, K->image_height() );
+      put_little_endian< uint64_t >( intrinsics, num_coeffs );
+      put_little_endian< uint64_t >( intrinsics, dist.size() );
+      for( auto const d : dist )
+      {
+        put_little_endian< double >( coeffs, d );
+      }
+      num_coeffs += dist.size();
+    }
+
+    auto const center = cam->center();
+    auto const q = cam->rotation().quaternion();
+    auto const covar = cam->center_covar();
+    put_little_endian< int64_t >( frames, c.first );
+    put_little_endian< uint64_t >( intrinsic_ids, inserted.first->second );
+    for( unsigned i = 0; i < 3; ++i )
+    {
+      put_little_endian< double >( centers, center[ i ] );
+    }
+    put_little_endian< double >( rotations, q.w() );
+    put_little_endian< double >( rotations, q.x() );
+    put_little_endian< double >( rotations, q.y() );
+    put_little_endian< double >( rotations, q.z() );
+    for( unsigned j = 0; j < 3; ++j )
+    {
+      for( unsigned i = 0; i <= j; ++i )
+      {
+        put_little_endian< double >( covars, covar( i, j ) );
+      }
+    }
+  }
+
+  std::string header;
+  header.append( kwc_magic, sizeof( kwc_magic ) );
+  put_little_endian< uint32_t >( header, kwc_version );
+  put_little_endian< uint32_t >( header, 0 );
+  put_little_endian< uint64_t >( header, all_cameras.size() );
+  put_little_endian< uint64_t >( header, intrinsics_index.size() );
+  put_little_endian< uint64_t >( header, num_coeffs );
+
+  for( auto const* block : { &header, &frames, &intrinsic_ids, &centers,
+                             &rotations, &covars, &intrinsics, &coeffs } )
+  {
+    os.write( block->data(), static_cast< std::streamsize >( block->size() ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+write_kwc( path_t const& file_path, camera_map const& cameras )
+{
+  check_output_file( file_path );
+  std::ofstream output_stream( file_path.c_str(), std::ios::binary );
+  if( !output_stream )
+  {
+    VITAL_THROW( file_write_exception, file_path,
+                 "Could not open file at given path." );
+  }
+  write_kwc( output_stream, cameras );
+  if( !output_stream )
+  {
+    VITAL_THROW( file_write_exception, file_path,
+                 "Could not write the file." );
+  }
+}
+
+// ----------------------------------------------------------------------------
+camera_map_sptr
+read_kwc( path_t const& file_path )
+{
+  return kwc_reader{ file_path }.read_all();
+}
+
+// ----------------------------------------------------------------------------
+class kwc_reader::priv
+{
+public:
+  // Find the blocks of the data, calling error with a reason if they are
+  // not valid
+  template < typename Error >
+  void parse( Error const& error );
+
+  // Read intrinsics record i
+  camera_intrinsics_sptr read_intrinsics( uint64_t i ) const;
+
+  // Read camera i, with the given intrinsics
+  camera_perspective_sptr read_camera( uint64_t i,
+                                       camera_intrinsics_sptr const& K ) const;
+
+  // Index of the intrinsics of camera i
+  uint64_t intrinsics_of( uint64_t i ) const
+  {
+    return get_little_endian< uint64_t >( intrinsic_ids + i * 8 );
+  }
+
+  mapped_file file;
+  std::string buffer;
+
+  char const* data = nullptr;
+  size_t size = 0;
+
+  char const* intrinsic_ids = nullptr;
+  char const* centers = nullptr;
+  char const* rotations = nullptr;
+  char const* covars = nullptr;
+  char const* intrinsics = nullptr;
+  char const* coeffs = nullptr;
+
+  std::vector< frame_id_t > frames;
+  uint64_t num_intrinsics = 0;
+  uint64_t num_coeffs = 0;
+};
+
+// ----------------------------------------------------------------------------
+template < typename Error >
+void
+kwc_reader::priv
+::parse( Error const& error )
+{
+  if( size < kwc_header_size ||
+      !std::equal( kwc_magic, kwc_magic + sizeof( kwc_magic ), data ) )
+  {
+    error( "Data is not KWC cameras" );
+  }
+  if( get_little_endian< uint32_t >( data + 8 ) != kwc_version )
+  {
+    error( "Unsupported KWC version" );
+  }
+
+  auto const num_cameras = get_little_endian< uint64_t >( data + 16 );
+  num_intrinsics = get_little_endian< uint64_t >( data + 24 );
+  num_coeffs = get_little_endian< uint64_t >( data + 32 );
+
+  // Check the block sizes without overflowing
+  auto const available = size - kwc_header_size;
+  if( num_cameras > available / kwc_camera_size ||
+      num_intrinsics > available / kwc_intrinsics_size ||
+      num_coeffs > available / kwc_coeff_size ||
+      num_cameras * kwc_camera_size + num_intrinsics * kwc_intrinsics_size +
+      num_coeffs * kwc_coeff_size != available )
+  {
+    error( "KWC block sizes do not match data" );
+  }
+
+  char const* const frame_ids = data + kwc_header_size;
+  intrinsic_ids = frame_ids + num_cameras * 8;
+  centers = intrinsic_ids + num_cameras * 8;
+  rotations = centers + num_cameras * 24;
+  covars = rotations + num_cameras * 32;
+  intrinsics = covars + num_cameras * 48;
+  coeffs = intrinsics + num_intrinsics * kwc_intrinsics_size;
+
+  frames.reserve( num_cameras );
+  for( uint64_t i = 0; i < num_cameras; ++i )
+  {
+    frames.push_back( get_little_endian< int64_t >( frame_ids + i * 8 ) );
+    if( ( i && frames[ i ] <= frames[ i - 1 ] ) ||
+        intrinsics_of( i ) >= num_intrinsics )
+    {
+      error( "KWC cameras are not valid" );
+    }
+  }
+
+  for( uint64_t i = 0; i < num_intrinsics; ++i )
+  {
+    char const* const p = intrinsics + i * kwc_intrinsics_size;
+    auto const first = get_little_endian< uint64_t >( p + 48 );
+    auto const count = get_little_endian< uint64_t >( p + 56 );
+    if( first > num_coeffs || count > num_coeffs - first )
+    {
+      error( "KWC intrinsics are not valid" );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+camera_intrinsics_sptr
+kwc_reader::priv
+::read_intrinsics( uint64_t i ) const
+{
+  char const* const p = intrinsics + i * kwc_intrinsics_size;
+  auto const first = get_little_endian< uint64_t >( p + 48 );
+  auto const count = get_little_endian< uint64_t >( p + 56 );
+
+  Eigen::VectorXd dist( static_cast< Eigen::Index >( count ) );
+  for( uint64_t n = 0; n < count; ++n )
+  {
+    dist[ static_cast< Eigen::Index >( n ) ] =
+      get_little_endian< double >( coeffs + ( first + n ) * kwc_coeff_size );
+  }
+
+  return std::make_shared< simple_camera_intrinsics >(
+    get_little_endian< double >( p ),
+    vector_2d{ get_little_endian< double >( p + 8 ),
+               get_little_endian< double >( p + 16 ) },
+    get_little_endian< double >( p + 24 ),
+    get_little_endian< double >( p + 32 ),
+    dist,
+    get_little_endian< uint32_t >( p + 40 ),
+    get_little_endian< uint32_t >( p + 44 ) );
+}
+
+// ----------------------------------------------------------------------------
+camera_perspective_sptr
+kwc_reader::priv
+::read_camera( uint64_t i, camera_intrinsics_sptr const& K ) const
+{
+  char const* const c = centers + i * 24;
+  char const* const r = rotations + i * 32;
+  char const* const v = covars + i * 48;
+
+  vector_3d const center{ get_little_endian< double >( c ),
+                          get_little_endian< double >( c + 8 ),
+                          get_little_endian< double >( c + 16 ) };
+  rotation_d const rotation{
+    Eigen::Quaterniond{ get_little_endian< double >( r ),
+                        get_little_endian< double >( r + 8 ),
+                        get_little_endian< double >( r + 16 ),
+                        get_little_endian< double >( r + 24 ) } };
+
+  covariance_3d covar;
+  unsigned n = 0;
+  for( unsigned col = 0; col < 3; ++col )
+  {
+    for( unsigned row = 0; row <= col; ++row )
+    {
+      covar( row, col ) = get_little_endian< double >( v + 8 * n++ );
+    }
+  }
+
+  auto cam = std::make_shared< simple_camera_perspective >( center, rotation,
+                                                            K );
+  cam->set_center_covar( covar );
+  return cam;
+}
+
+// ----------------------------------------------------------------------------
+kwc_reader
+::kwc_reader( path_t const& file_path )
+  : d{ new priv }
+{
+  if( !kwiversys::SystemTools::FileExists( file_path ) )
+  {
+    VITAL_THROW( file_not_found_exception, file_path, "File does not exist." );
+  }
+  if( !d->file.open( file_path ) )
+  {
+    VITAL_THROW( file_not_found_exception, file_path,
+                 "File could not be mapped." );
+  }
+
+  d->data = d->file.data();
+  d->size = d->file.size();
+  d->parse( [ & ]( std::string const& reason ){
+    VITAL_THROW( invalid_file, file_path, reason ); } );
+}
+
+// ----------------------------------------------------------------------------
+kwc_reader
+::kwc_reader( std::istream& is )
+  : d{ new priv }
+{
+  d->buffer.assign( std::istreambuf_iterator< char >( is ),
+                    std::istreambuf_iterator< char >() );
+  d->data = d->buffer.data();
+  d->size = d->buffer.size();
+  d->parse( []( std::string const& reason ){
+    VITAL_THROW( invalid_data, reason ); } );
+}
+
+// ----------------------------------------------------------------------------
+kwc_reader
+::~kwc_reader()
+{
+}
+
+// ----------------------------------------------------------------------------
+std::vector< frame_id_t > const&
+kwc_reader
+::frames() const
+{
+  return d->frames;
+}
+
+// ----------------------------------------------------------------------------
+camera_map_sptr
+kwc_reader
+::read_all() const
+{
+  std::vector< camera_intrinsics_sptr > intrinsics;
+  intrinsics.reserve( d->num_intrinsics );
+  for( uint64_t i = 0; i < d->num_intrinsics; ++i )
+  {
+    intrinsics.push_back( d->read_intrinsics( i ) );
+  }
+
+  camera_map::map_camera_t cameras;
+  for( uint64_t i = 0; i < d->frames.size(); ++i )
+  {
+    cameras.emplace_hint(
+      cameras.end(), d->frames[ i ],
+      d->read_camera( i, intrinsics[ d->intrinsics_of( i ) ] ) );
+  }
+  return std::make_shared< simple_camera_map >( cameras );
+}
+
+// ----------------------------------------------------------------------------
+camera_perspective_sptr
+kwc_reader
+::read_frame( frame_id_t frame ) const
+{
+  auto const it =
+    std::lower_bound( d->frames.begin(), d->frames.end(), frame );
+  if( it == d->frames.end() || *it != frame )
+  {
+    return nullptr;
+  }
+
+  auto const i = static_cast< uint64_t >( it - d->frames.begin() );
+  return d->read_camera( i, d->read_intrinsics( d->intrinsics_of( i ) ) );
+}
+
 } } // end namespace vital
@@ -9,9 +9,12 @@
 #define VITAL_CAMERA_MAP_IO_H_
 
 #include <vital/types/camera_map.h>
+#include <vital/types/camera_perspective.h>
 
 #include <vital/vital_types.h>
 
+#include <iosfwd>
+#include <memory>
 #include <vector>
 
 namespace  kwiver {
@@ -28,12 +31,87 @@ namespace vital {
 /// \throw path_not_exists
 ///   The specified directory does not exist
 ///
+/// The files are parsed in parallel.
+///
 /// \param img_files a list of image files
 /// \param dir directory path containing krtd files for the given images
 /// \return a new camera map created after parsing all krtd files
 camera_map_sptr
 VITAL_EXPORT read_krtd_files( std::vector< path_t > const& img_files, path_t const& dir );
 
+/// Write perspective cameras to a compact binary KWC stream opened in binary
+/// mode
+///
+/// KWC files hold a whole camera map in one file, as little-endian columns
+/// of frame ids, positions, orientations and center covariances, with the
+/// intrinsics stored once for each intrinsics object the cameras share.
+/// They may be read without parsing, and by frame with kwc_reader.
+///
+/// \throws invalid_data
+///    Thrown when a camera is not a perspective camera.
+///
+/// \param os      The stream to write to.
+/// \param cameras The cameras to write.
+void
+VITAL_EXPORT write_kwc( std::ostream& os, camera_map const& cameras );
+
+/// Write perspective cameras to a compact binary KWC file
+///
+/// \throws file_write_exception
+///    Thrown when something prevents output of the file.
+/// \throws invalid_data
+///    Thrown when a camera is not a perspective camera.
+void
+VITAL_EXPORT write_kwc( path_t const& file_path, camera_map const& cameras );
+
+/// Read a camera map from a compact binary KWC file
+///
+/// \throws invalid_file
+///    Thrown when the file is not a valid KWC file.
+camera_map_sptr
+VITAL_EXPORT read_kwc( path_t const& file_path );
+
+/// Random access reader of compact binary KWC camera data
+///
+/// Files are memory mapped, so that reading the camera of a frame only
+/// touches the values of that camera and its intrinsics.
+class VITAL_EXPORT kwc_reader
+{
+public:
+  /// Map the KWC file at \p file_path
+  ///
+  /// \throws file_not_found_exception
+  ///    Thrown when the file could not be opened.
+  /// \throws invalid_file
+  ///    Thrown when the file is not a valid KWC file.
+  explicit kwc_reader( path_t const& file_path );
+
+  /// Read the KWC data remaining in \p is
+  ///
+  /// \throws invalid_data
+  ///    Thrown when the data is not valid KWC data.
+  explicit kwc_reader( std::istream& is );
+
+  ~kwc_reader();
+
+  /// Frames with cameras, in increasing order
+  std::vector< frame_id_t > const& frames() const;
+
+  /// Read all the cameras
+  ///
+  /// Cameras which shared intrinsics when written share them again.
+  camera_map_sptr read_all() const;
+
+  /// Read the camera of frame \p frame
+  ///
+  /// \returns the camera, or null if there is none for that frame.
+  camera_perspective_sptr read_frame( frame_id_t frame ) const;
+
+private:
+  class priv;
+  std::unique_ptr< priv > d;
+};
+
 } } // end namespace vital
 
 #endif // VITAL_CAMERA_MAP_IO_H_
@@ -8,8 +8,11 @@
 /// Uses the PLY file format
 
 #include "landmark_map_io.h"
+#include "binary_io.h"
 
 #include <vital/exceptions.h>
+#include <vital/util/mapped_file.h>
+#include <vital/util/thread_pool.h>
 #include <kwiversys/SystemTools.hxx>
 
 #include <algorithm>
@@ -21,6 +24,132 @@
 namespace kwiver {
 namespace vital {
 
+using detail::check_output_file;
+using detail::get_little_endian;
+using detail::put_little_endian;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Compact binary landmark (KWL) format
+//
+// A KWL file is a 24-byte header followed by one block per value of the
+// landmarks, each holding the value of every landmark in increasing order
+// of id:
+// - the landmark id as an 8-byte integer
+// - the location and the normal, each as 3 doubles
+// - the covariance as the 6 doubles of its upper triangle, by column
+// - the scale and the cosine of the largest observation angle as doubles
+// - the number of observations as a 4-byte integer
+// - the color as 3 bytes (red, green, blue)
+// All numbers are little-endian.
+
+constexpr char kwl_magic[8] = { 'K', 'W', 'V', 'R', 'L', 'M', 'K', 'S' };
+constexpr uint32_t kwl_version = 1;
+
+constexpr size_t kwl_header_size = 24;
+constexpr size_t kwl_landmark_size = 8 + 24 + 24 + 48 + 8 + 8 + 4 + 3;
+
+// Landmarks decoded by each task when reading
+constexpr size_t kwl_chunk_size = 4096;
+
+// ----------------------------------------------------------------------------
+// Decode the landmarks of KWL data, calling error with a reason if it is not
+// valid
+template < typename Error >
+landmark_map_sptr
+parse_kwl( char const* data, size_t size, Error const& error )
+{
+  if( size < kwl_header_size ||
+      !std::equal( kwl_magic, kwl_magic + sizeof( kwl_magic ), data ) )
+  {
+    error( "Data is not KWL landmarks" );
+  }
+  if( get_little_endian< uint32_t >( data + 8 ) != kwl_version )
+  {
+    error( "Unsupported KWL version" );
+  }
+
+  auto const n = get_little_endian< uint64_t >( data + 16 );
+  if( n > ( size - kwl_header_size ) / kwl_landmark_size ||
+      n * kwl_landmark_size != size - kwl_header_size )
+  {
+    error( "KWL block sizes do not match data" );
+  }
+
+  char const* const ids = data + kwl_header_size;
+  char const* const locs = ids + n * 8;
+  char const* const normals = locs + n * 24;
+  char const* const covars = normals + n * 24;
+  char const* const scales = covars + n * 48;
+  char const* const cos_angles = scales + n * 8;
+  char const* const observations = cos_angles + n * 8;
+  char const* const colors = observations + n * 4;
+
+  for( uint64_t i = 1; i < n; ++i )
+  {
+    if( get_little_endian< int64_t >( ids + i * 8 ) <=
+        get_little_endian< int64_t >( ids + ( i - 1 ) * 8 ) )
+    {
+      error( "KWL landmark ids are not in increasing order" );
+    }
+  }
+
+  auto const get_vector = []( char const* p ){
+    return vector_3d{ get_little_endian< double >( p ),
+                      get_little_endian< double >( p + 8 ),
+                      get_little_endian< double >( p + 16 ) };
+  };
+
+  // Allocating the landmarks dominates, so it is spread over the pool
+  std::vector< landmark_sptr > decoded( n );
+  thread_pool::instance().parallel_for( n, kwl_chunk_size,
+    [ & ]( size_t begin, size_t end )
+    {
+      for( size_t i = begin; i < end; ++i )
+      {
+        auto lm = std::make_shared< landmark_d >(
+          get_vector( locs + i * 24 ),
+          get_little_endian< double >( scales + i * 8 ) );
+        lm->set_normal( get_vector( normals + i * 24 ) );
+
+        covariance_3d covar;
+        unsigned k = 0;
+        for( unsigned c = 0; c < 3; ++c )
+        {
+          for( unsigned r = 0; r <= c; ++r )
+          {
+            covar( r, c ) =
+              get_little_endian< double >( covars + i * 48 + 8 * k++ );
+          }
+        }
+        lm->set_covar( covar );
+
+        lm->set_cos_observation_angle(
+          get_little_endian< double >( cos_angles + i * 8 ) );
+        lm->set_observations(
+          get_little_endian< uint32_t >( observations + i * 4 ) );
+
+        auto const* const rgb =
+          reinterpret_cast< unsigned char const* >( colors + i * 3 );
+        lm->set_color( rgb_color{ rgb[ 0 ], rgb[ 1 ], rgb[ 2 ] } );
+
+        decoded[ i ] = lm;
+      }
+    } );
+
+  landmark_map::map_landmark_t landmarks;
+  for( uint64_t i = 0; i < n; ++i )
+  {
+    landmarks.emplace_hint( landmarks.end(),
+                            get_little_endian< int64_t >( ids + i * 8 ),
+                            std::move( decoded[ i ] ) );
+  }
+  return std::make_shared< simple_landmark_map >( landmarks );
+}
+
+} // end namespace
+
 /// Output the given \c landmark_map object to the specified PLY file path
 void
 write_ply_file( landmark_map_sptr const&  landmarks,
@@ -289,4 +418,104 @@ read_ply_file( path_t const& file_path )
   return landmark_map_sptr( new simple_landmark_map( landmarks ) );
 } // read_ply_file
 
+// ----------------------------------------------------------------------------
+void
+write_kwl( std::ostream& os, landmark_map const& landmarks )
+{
+  auto const all_landmarks = landmarks.landmarks();
+
+  std::string ids, locs, normals, covars, scales, cos_angles;
+  std::string observations, colors;
+  for( auto const& l : all_landmarks )
+  {
+    auto const& lm = *l.second;
+    auto const loc = lm.loc();
+    auto const normal = lm.normal();
+    auto const covar = lm.covar();
+    auto const color = lm.color();
+
+    put_little_endian< int64_t >( ids, l.first );
+    for( unsigned i = 0; i < 3; ++i )
+    {
+      put_little_endian< double >( locs, loc[ i ] );
+      put_little_endian< double >( normals, normal[ i ] );
+    }
+    for( unsigned c = 0; c < 3; ++c )
+    {
+      for( unsigned r = 0; r <= c; ++r )
+      {
+        put_little_endian< double >( covars, covar( r, c ) );
+      }
+    }
+    put_little_endian< double >( scales, lm.scale() );
+    put_little_endian< double >( cos_angles, lm.cos_obs_angle() );
+    put_little_endian< uint32_t >( observations, lm.observations() );
+    colors.push_back( static_cast< char >( color.r ) );
+    colors.push_back( static_cast< char >( color.g ) );
+    colors.push_back( static_cast< char >( color.b ) );
+  }
+
+  std::string header;
+  header.append( kwl_magic, sizeof( kwl_magic ) );
+  put_little_endian< uint32_t >( header, kwl_version );
+  put_little_endian< uint32_t >( header, 0 );
+  put_little_endian< uint64_t >( header, all_landmarks.size() );
+
+  for( auto const* block : { &header, &ids, &locs, &normals, &covars,
+                             &scales, &cos_angles, &observations, &colors } )
+  {
+    os.write( block->data(), static_cast< std::streamsize >( block->size() ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+write_kwl( path_t const& file_path, landmark_map const& landmarks )
+{
+  check_output_file( file_path );
+  std::ofstream output_stream( file_path.c_str(), std::ios::binary );
+  if( !output_stream )
+  {
+    VITAL_THROW( file_write_exception, file_path,
+                 "Could not open file at given path." );
+  }
+  write_kwl( output_stream, landmarks );
+  if( !output_stream )
+  {
+    VITAL_THROW( file_write_exception, file_path,
+                 "Could not write the file." );
+  }
+}
+
+// ----------------------------------------------------------------------------
+landmark_map_sptr
+read_kwl( std::istream& is )
+{
+  std::string const buffer{ std::istreambuf_iterator< char >( is ),
+                            std::istreambuf_iterator< char >() };
+  return parse_kwl( buffer.data(), buffer.size(),
+    []( std::string const& reason ){
+      VITAL_THROW( invalid_data, reason ); } );
+}
+
+// ----------------------------------------------------------------------------
+landmark_map_sptr
+read_kwl( path_t const& file_path )
+{
+  if( !kwiversys::SystemTools::FileExists( file_path ) )
+  {
+    VITAL_THROW( file_not_found_exception, file_path, "File does not exist." );
+  }
+
+  mapped_file file;
+  if( !file.open( file_path ) )
+  {
+    VITAL_THROW( file_not_found_exception, file_path,
+                 "File could not be mapped." );
+  }
+  return parse_kwl( file.data(), file.size(),
+    [ & ]( std::string const& reason ){
+      VITAL_THROW( invalid_file, file_path, reason ); } );
+}
+
 } } // end namespace
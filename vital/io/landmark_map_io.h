@@ -14,6 +14,8 @@
 
 #include <vital/types/landmark_map.h>
 
+#include <iosfwd>
+
 namespace kwiver {
 namespace vital {
 
@@ -44,6 +46,42 @@ VITAL_EXPORT write_ply_file( landmark_map_sptr const& landmarks,
 landmark_map_sptr
 VITAL_EXPORT read_ply_file( path_t const& file_path );
 
+/// Write landmarks to a compact binary KWL stream opened in binary mode
+///
+/// KWL files hold all the values of the landmarks, including scale,
+/// normal, covariance and observation statistics, as little-endian columns.
+/// They are read without parsing, which is much faster than PLY for large
+/// reconstructions.
+///
+/// \param os        The stream to write to.
+/// \param landmarks The landmarks to write.
+void
+VITAL_EXPORT write_kwl( std::ostream& os, landmark_map const& landmarks );
+
+/// Write landmarks to a compact binary KWL file
+///
+/// \throws file_write_exception
+///    Thrown when something prevents output of the file.
+void
+VITAL_EXPORT write_kwl( path_t const& file_path,
+                        landmark_map const& landmarks );
+
+/// Read landmarks from a compact binary KWL stream opened in binary mode
+///
+/// \throws invalid_data
+///    Thrown when the data is not valid KWL data.
+landmark_map_sptr
+VITAL_EXPORT read_kwl( std::istream& is );
+
+/// Read landmarks from a compact binary KWL file
+///
+/// \throws file_not_found_exception
+///    Thrown when the file could not be opened.
+/// \throws invalid_file
+///    Thrown when the file is not a valid KWL file.
+landmark_map_sptr
+VITAL_EXPORT read_kwl( path_t const& file_path );
+
 } } // end namespace
 
 #endif // VITAL_LANDMARK_MAP_IO_H_
@@ -7,12 +7,20 @@
 
 #include "mesh_io.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <limits>
 
 #include <vital/exceptions.h>
 #include <vital/logger/logger.h>
+#include <vital/util/mapped_file.h>
+#include <vital/util/thread_pool.h>
 #include <kwiversys/SystemTools.hxx>
 
 namespace kwiver {
@@ -73,6 +81,785 @@ check_input_file(const std::string& filename)
   }
 }
 
+
+// ----------------------------------------------------------------------------
+// PLY parsing
+
+// Number of PLY element instances parsed by a thread at a time
+constexpr size_t ply_chunk_size = 4096;
+
+/// Scalar types of PLY properties
+enum class ply_type
+{
+  none, int8, uint8, int16, uint16, int32, uint32, float32, float64
+};
+
+/// A property of a PLY element, either a scalar or a list of scalars
+struct ply_property
+{
+  std::string name;
+  ply_type type;
+  ply_type count_type; // none unless this is a list
+};
+
+/// An element of a PLY file, such as the vertices or the faces
+struct ply_element
+{
+  std::string name;
+  size_t count;
+  std::vector<ply_property> properties;
+};
+
+/// The format and elements declared by a PLY header
+struct ply_header
+{
+  enum format_t { ASCII, BINARY_LITTLE_ENDIAN, BINARY_BIG_ENDIAN };
+
+  format_t format = ASCII;
+  std::vector<ply_element> elements;
+};
+
+/// Convert a PLY type name to a type
+ply_type
+parse_ply_type(const std::string& name)
+{
+  if (name == "char" || name == "int8") return ply_type::int8;
+  if (name == "uchar" || name == "uint8") return ply_type::uint8;
+  if (name == "short" || name == "int16") return ply_type::int16;
+  if (name == "ushort" || name == "uint16") return ply_type::uint16;
+  if (name == "int" || name == "int32") return ply_type::int32;
+  if (name == "uint" || name == "uint32") return ply_type::uint32;
+  if (name == "float" || name == "float32") return ply_type::float32;
+  if (name == "double" || name == "float64") return ply_type::float64;
+  VITAL_THROW( invalid_data, "Unknown PLY property type: " + name );
+}
+
+/// Number of bytes of a binary PLY scalar
+size_t
+ply_type_size(ply_type type)
+{
+  switch (type)
+  {
+    case ply_type::int8:
+    case ply_type::uint8:   return 1;
+    case ply_type::int16:
+    case ply_type::uint16:  return 2;
+    case ply_type::int32:
+    case ply_type::uint32:
+    case ply_type::float32: return 4;
+    case ply_type::float64: return 8;
+    default:                return 0;
+  }
+}
+
+/// Check if this machine stores numbers little-endian
+bool
+host_is_little_endian()
+{
+  uint16_t const value = 1;
+  unsigned char first;
+  std::memcpy(&first, &value, 1);
+  return first == 1;
+}
+
+/// Read a binary scalar of type \p T, reversing the bytes if \p swap
+template <typename T>
+T
+read_binary(const char* p, bool swap)
+{
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, p, sizeof(T));
+  if (swap)
+  {
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+  T value;
+  std::memcpy(&value, bytes, sizeof(T));
+  return value;
+}
+
+/// Read a binary PLY scalar as a double
+double
+read_ply_binary(const char* p, ply_type type, bool swap)
+{
+  switch (type)
+  {
+    case ply_type::int8:    return read_binary<int8_t>(p, swap);
+    case ply_type::uint8:   return read_binary<uint8_t>(p, swap);
+    case ply_type::int16:   return read_binary<int16_t>(p, swap);
+    case ply_type::uint16:  return read_binary<uint16_t>(p, swap);
+    case ply_type::int32:   return read_binary<int32_t>(p, swap);
+    case ply_type::uint32:  return read_binary<uint32_t>(p, swap);
+    case ply_type::float32: return read_binary<float>(p, swap);
+    case ply_type::float64: return read_binary<double>(p, swap);
+    default:                return 0.0;
+  }
+}
+
+/// Read a binary PLY scalar as a vertex index
+unsigned int
+read_ply_index(const char* p, ply_type type, bool swap)
+{
+  switch (type)
+  {
+    case ply_type::int8:    return read_binary<int8_t>(p, swap);
+    case ply_type::uint8:   return read_binary<uint8_t>(p, swap);
+    case ply_type::int16:   return read_binary<int16_t>(p, swap);
+    case ply_type::uint16:  return read_binary<uint16_t>(p, swap);
+    case ply_type::int32:   return read_binary<int32_t>(p, swap);
+    case ply_type::uint32:  return read_binary<uint32_t>(p, swap);
+    default:
+      return static_cast<unsigned int>(read_ply_binary(p, type, swap));
+  }
+}
+
+/// Parse a PLY header from the start of \p data
+///
+/// Headers which declare no properties for an element, as in some legacy
+/// ASCII files, are accepted; see read_ply_vertices() and read_ply_faces().
+///
+/// \returns the number of bytes of the header, including end_header
+size_t
+parse_ply_header(const char* data, size_t size, ply_header& header)
+{
+  const char* const end = data + size;
+  const char* line = data;
+  bool first = true;
+  while (line < end)
+  {
+    const char* const eol = std::find(line, end, '\n');
+    std::istringstream ss(std::string(line, eol));
+    line = (eol < end ? eol + 1 : end);
+
+    std::string keyword;
+    ss >> keyword;
+    if (first)
+    {
+      if (keyword != "ply")
+      {
+        VITAL_THROW( invalid_data, "Missing PLY magic number" );
+      }
+      first = false;
+    }
+    else if (keyword == "format")
+    {
+      std::string format;
+      ss >> format;
+      if (format == "ascii")
+      {
+        header.format = ply_header::ASCII;
+      }
+      else if (format == "binary_little_endian")
+      {
+        header.format = ply_header::BINARY_LITTLE_ENDIAN;
+      }
+      else if (format == "binary_big_endian")
+      {
+        header.format = ply_header::BINARY_BIG_ENDIAN;
+      }
+      else
+      {
+        VITAL_THROW( invalid_data, "Unknown PLY format: " + format );
+      }
+    }
+    else if (keyword == "element")
+    {
+      ply_element element;
+      if (!(ss >> element.name >> element.count))
+      {
+        VITAL_THROW( invalid_data, "Malformed PLY element declaration" );
+      }
+      header.elements.push_back(element);
+    }
+    else if (keyword == "property")
+    {
+      if (header.elements.empty())
+      {
+        VITAL_THROW( invalid_data, "PLY property declared before element" );
+      }
+      ply_property property;
+      std::string type;
+      ss >> type;
+      if (type == "list")
+      {
+        std::string count_type;
+        ss >> count_type >> type;
+        property.count_type = parse_ply_type(count_type);
+      }
+      else
+      {
+        property.count_type = ply_type::none;
+      }
+      property.type = parse_ply_type(type);
+      ss >> property.name;
+      header.elements.back().properties.push_back(property);
+    }
+    else if (keyword == "end_header")
+    {
+      return static_cast<size_t>(line - data);
+    }
+    // comment, obj_info, and blank lines are ignored
+  }
+  VITAL_THROW( invalid_data, "PLY header has no end_header" );
+}
+
+/// Find the index of the scalar property named \p name, or -1
+int
+find_ply_property(const ply_element& element, const char* name)
+{
+  for (size_t i = 0; i < element.properties.size(); ++i)
+  {
+    if (element.properties[i].name == name &&
+        element.properties[i].count_type == ply_type::none)
+    {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+/// Find the index of the list of vertex indices of a face element, or -1
+int
+find_ply_face_indices(const ply_element& element)
+{
+  int first_list = -1;
+  for (size_t i = 0; i < element.properties.size(); ++i)
+  {
+    auto const& property = element.properties[i];
+    if (property.count_type == ply_type::none)
+    {
+      continue;
+    }
+    if (property.name == "vertex_indices" || property.name == "vertex_index")
+    {
+      return static_cast<int>(i);
+    }
+    if (first_list < 0)
+    {
+      first_list = static_cast<int>(i);
+    }
+  }
+  return first_list;
+}
+
+/// Find the start of each non-blank line of the ASCII body of a PLY file
+///
+/// Stops after \p max_lines lines, which are appended to \p lines.
+/// \returns the position after the last line found
+const char*
+find_ply_lines(const char* begin, const char* end, size_t max_lines,
+               std::vector<const char*>& lines)
+{
+  const char* p = begin;
+  for (size_t n = 0; n < max_lines && p < end; )
+  {
+    const char* const eol = static_cast<const char*>(
+      std::memchr(p, '\n', static_cast<size_t>(end - p)));
+    const char* const next = eol ? eol + 1 : end;
+    if (std::find_if(p, next, [](char c){ return !std::isspace(
+                       static_cast<unsigned char>(c)); }) != next)
+    {
+      lines.push_back(p);
+      ++n;
+    }
+    p = next;
+  }
+  lines.push_back(p);
+  return p;
+}
+
+/// Parse the next number on an ASCII line, failing at the end of the line
+bool
+parse_ply_ascii(const char*& p, const char* eol, double& value)
+{
+  while (p < eol && (*p == ' ' || *p == '\t' || *p == '\r'))
+  {
+    ++p;
+  }
+  if (p >= eol)
+  {
+    return false;
+  }
+  char* last;
+  value = std::strtod(p, &last);
+  if (last == p || last > eol)
+  {
+    return false;
+  }
+  p = last;
+  return true;
+}
+
+/// Parameters common to reading a binary or ASCII element
+struct ply_reader
+{
+  const ply_header& header;
+  const char* pos;
+  const char* end;
+
+  bool binary() const { return header.format != ply_header::ASCII; }
+  bool swap() const
+  {
+    return (header.format == ply_header::BINARY_LITTLE_ENDIAN) !=
+           host_is_little_endian();
+  }
+};
+
+/// Byte size of an instance of a binary element of only scalar properties
+///
+/// \returns zero if the element has list properties
+size_t
+ply_fixed_size(const ply_element& element)
+{
+  size_t size = 0;
+  for (auto const& property : element.properties)
+  {
+    if (property.count_type != ply_type::none)
+    {
+      return 0;
+    }
+    size += ply_type_size(property.type);
+  }
+  return size;
+}
+
+/// Skip over the instances of an element which is not needed
+void
+skip_ply_element(ply_reader& reader, const ply_element& element)
+{
+  if (!reader.binary())
+  {
+    std::vector<const char*> lines;
+    reader.pos = find_ply_lines(reader.pos, reader.end, element.count, lines);
+    return;
+  }
+
+  if (size_t const fixed = ply_fixed_size(element))
+  {
+    if (static_cast<size_t>(reader.end - reader.pos) < fixed * element.count)
+    {
+      VITAL_THROW( invalid_data, "PLY data ends in element " + element.name );
+    }
+    reader.pos += fixed * element.count;
+    return;
+  }
+
+  bool const swap = reader.swap();
+  for (size_t i = 0; i < element.count; ++i)
+  {
+    for (auto const& property : element.properties)
+    {
+      size_t const value_size = ply_type_size(property.type);
+      size_t count = 1;
+      if (property.count_type != ply_type::none)
+      {
+        size_t const count_size = ply_type_size(property.count_type);
+        if (static_cast<size_t>(reader.end - reader.pos) < count_size)
+        {
+          VITAL_THROW( invalid_data,
+                       "PLY data ends in element " + element.name );
+        }
+        count = read_ply_index(reader.pos, property.count_type, swap);
+        reader.pos += count_size;
+      }
+      if (static_cast<size_t>(reader.end - reader.pos) < count * value_size)
+      {
+        VITAL_THROW( invalid_data,
+                     "PLY data ends in element " + element.name );
+      }
+      reader.pos += count * value_size;
+    }
+  }
+}
+
+/// Read the vertex positions of a PLY vertex element
+///
+/// Vertices are decoded in parallel.  An ASCII element without declared
+/// properties is read as the first three values of each line.
+void
+read_ply_vertices(ply_reader& reader, const ply_element& element,
+                  mesh_vertex_array<3>& verts)
+{
+  int coord[3] = { find_ply_property(element, "x"),
+                   find_ply_property(element, "y"),
+                   find_ply_property(element, "z") };
+  if (element.properties.empty() && !reader.binary())
+  {
+    coord[0] = 0;
+    coord[1] = 1;
+    coord[2] = 2;
+  }
+  if (coord[0] < 0 || coord[1] < 0 || coord[2] < 0)
+  {
+    VITAL_THROW( invalid_data, "PLY vertices have no x, y, and z" );
+  }
+
+  size_t const fixed = ply_fixed_size(element);
+  if (reader.binary() && fixed == 0)
+  {
+    VITAL_THROW( invalid_data, "PLY vertices with list properties "
+                               "are not supported" );
+  }
+
+  std::atomic<bool> failed{false};
+  if (reader.binary())
+  {
+    if (static_cast<size_t>(reader.end - reader.pos) < fixed * element.count)
+    {
+      VITAL_THROW( invalid_data, "PLY data ends in vertices" );
+    }
+
+    size_t offset[3];
+    ply_type type[3];
+    for (unsigned c = 0; c < 3; ++c)
+    {
+      offset[c] = 0;
+      for (int p = 0; p < coord[c]; ++p)
+      {
+        offset[c] += ply_type_size(element.properties[p].type);
+      }
+      type[c] = element.properties[coord[c]].type;
+    }
+
+    const char* const data = reader.pos;
+    bool const swap = reader.swap();
+    thread_pool::instance().parallel_for(
+      element.count, ply_chunk_size,
+      [&](size_t begin, size_t end)
+      {
+        for (size_t v = begin; v < end; ++v)
+        {
+          const char* const instance = data + v * fixed;
+          vector_3d& vert = verts[static_cast<unsigned int>(v)];
+          for (unsigned c = 0; c < 3; ++c)
+          {
+            vert[c] = read_ply_binary(instance + offset[c], type[c], swap);
+          }
+        }
+      });
+    reader.pos += fixed * element.count;
+    return;
+  }
+
+  std::vector<const char*> lines;
+  reader.pos = find_ply_lines(reader.pos, reader.end, element.count, lines);
+  if (lines.size() != element.count + 1)
+  {
+    VITAL_THROW( invalid_data, "PLY data ends in vertices" );
+  }
+  int const last = std::max(coord[0], std::max(coord[1], coord[2]));
+  thread_pool::instance().parallel_for(
+    element.count, ply_chunk_size,
+    [&](size_t begin, size_t end)
+    {
+      for (size_t v = begin; v < end; ++v)
+      {
+        const char* p = lines[v];
+        const char* const eol = lines[v + 1];
+        vector_3d& vert = verts[static_cast<unsigned int>(v)];
+        double value;
+        for (int i = 0; i <= last; ++i)
+        {
+          if (!parse_ply_ascii(p, eol, value))
+          {
+            failed = true;
+            return;
+          }
+          for (unsigned c = 0; c < 3; ++c)
+          {
+            if (coord[c] == i)
+            {
+              vert[c] = value;
+            }
+          }
+        }
+      }
+    });
+  if (failed)
+  {
+    VITAL_THROW( invalid_data, "Malformed PLY vertex" );
+  }
+}
+
+/// Read the vertex index lists of a PLY face element
+///
+/// ASCII faces are decoded in parallel into per chunk buffers which are then
+/// concatenated.  Binary faces have variable size, so they are decoded in
+/// order.  An ASCII element without declared properties is read as a vertex
+/// count followed by the indices.
+std::unique_ptr<mesh_polygon_face_array>
+read_ply_faces(ply_reader& reader, const ply_element& element)
+{
+  int index_property = find_ply_face_indices(element);
+  if (element.properties.empty() && !reader.binary())
+  {
+    index_property = 0;
+  }
+  if (index_property < 0)
+  {
+    VITAL_THROW( invalid_data, "PLY faces have no vertex indices" );
+  }
+
+  std::vector<unsigned int> offsets;
+  std::vector<unsigned int> indices;
+  offsets.reserve(element.count + 1);
+  offsets.push_back(0);
+
+  if (reader.binary())
+  {
+    bool const swap = reader.swap();
+    for (size_t f = 0; f < element.count; ++f)
+    {
+      for (size_t i = 0; i < element.properties.size(); ++i)
+      {
+        auto const& property = element.properties[i];
+        size_t const value_size = ply_type_size(property.type);
+        size_t count = 1;
+        if (property.count_type != ply_type::none)
+        {
+          size_t const count_size = ply_type_size(property.count_type);
+          if (static_cast<size_t>(reader.end - reader.pos) < count_size)
+          {
+            VITAL_THROW( invalid_data, "PLY data ends in faces" );
+          }
+          count = read_ply_index(reader.pos, property.count_type, swap);
+          reader.pos += count_size;
+        }
+        if (static_cast<size_t>(reader.end - reader.pos) < count * value_size)
+        {
+          VITAL_THROW( invalid_data, "PLY data ends in faces" );
+        }
+        if (static_cast<int>(i) == index_property)
+        {
+          for (size_t v = 0; v < count; ++v)
+          {
+            indices.push_back(read_ply_index(reader.pos + v * value_size,
+                                             property.type, swap));
+          }
+        }
+        reader.pos += count * value_size;
+      }
+      offsets.push_back(static_cast<unsigned int>(indices.size()));
+    }
+    return std::unique_ptr<mesh_polygon_face_array>(
+      new mesh_polygon_face_array(std::move(offsets), std::move(indices)));
+  }
+
+  std::vector<const char*> lines;
+  reader.pos = find_ply_lines(reader.pos, reader.end, element.count, lines);
+  if (lines.size() != element.count + 1)
+  {
+    VITAL_THROW( invalid_data, "PLY data ends in faces" );
+  }
+  size_t const num_chunks =
+    (element.count + ply_chunk_size - 1) / ply_chunk_size;
+  std::vector<std::vector<unsigned int> > chunk_counts(num_chunks);
+  std::vector<std::vector<unsigned int> > chunk_indices(num_chunks);
+  std::atomic<bool> failed{false};
+  thread_pool::instance().parallel_for(
+    element.count, ply_chunk_size,
+    [&](size_t begin, size_t end)
+    {
+      std::vector<unsigned int>& counts = chunk_counts[begin / ply_chunk_size];
+      std::vector<unsigned int>& face_indices =
+        chunk_indices[begin / ply_chunk_size];
+      counts.reserve(end - begin);
+      face_indices.reserve(3 * (end - begin));
+      for (size_t f = begin; f < end; ++f)
+      {
+        const char* p = lines[f];
+        const char* const eol = lines[f + 1];
+        double value;
+        for (int i = 0; i <= index_property; ++i)
+        {
+          size_t count = 1;
+          bool const is_list =
+            element.properties.empty() ||
+            element.properties[i].count_type != ply_type::none;
+          if (is_list)
+          {
+            if (!parse_ply_ascii(p, eol, value) || value < 0.0)
+            {
+              failed = true;
+              return;
+            }
+            count = static_cast<size_t>(value);
+          }
+          if (i == index_property)
+          {
+            counts.push_back(static_cast<unsigned int>(count));
+          }
+          for (size_t v = 0; v < count; ++v)
+          {
+            if (!parse_ply_ascii(p, eol, value))
+            {
+              failed = true;
+              return;
+            }
+            if (i == index_property)
+            {
+              face_indices.push_back(static_cast<unsigned int>(value));
+            }
+          }
+        }
+      }
+    });
+  if (failed)
+  {
+    VITAL_THROW( invalid_data, "Malformed PLY face" );
+  }
+
+  size_t num_indices = 0;
+  for (auto const& chunk : chunk_indices)
+  {
+    num_indices += chunk.size();
+  }
+  indices.reserve(num_indices);
+  for (size_t c = 0; c < num_chunks; ++c)
+  {
+    for (unsigned int count : chunk_counts[c])
+    {
+      offsets.push_back(offsets.back() + count);
+    }
+    indices.insert(indices.end(),
+                   chunk_indices[c].begin(), chunk_indices[c].end());
+    std::vector<unsigned int>().swap(chunk_indices[c]);
+  }
+  return std::unique_ptr<mesh_polygon_face_array>(
+    new mesh_polygon_face_array(std::move(offsets), std::move(indices)));
+}
+
+/// Read a mesh from the bytes of a PLY file
+mesh_sptr
+read_ply_data(const char* data, size_t size)
+{
+  ply_header header;
+  size_t const header_size = parse_ply_header(data, size, header);
+  ply_reader reader{ header, data + header_size, data + size };
+
+  std::unique_ptr<mesh_vertex_array<3> > verts(new mesh_vertex_array<3>);
+  std::unique_ptr<mesh_face_array_base> faces(new mesh_polygon_face_array);
+  for (auto const& element : header.elements)
+  {
+    if (element.name == "vertex")
+    {
+      verts.reset(new mesh_vertex_array<3>(
+        static_cast<unsigned int>(element.count)));
+      read_ply_vertices(reader, element, *verts);
+    }
+    else if (element.name == "face")
+    {
+      faces = read_ply_faces(reader, element);
+    }
+    else
+    {
+      skip_ply_element(reader, element);
+    }
+  }
+
+  return std::make_shared<mesh>(std::move(verts),
+                                compact_face_array(std::move(faces)));
+}
+
+/// Write a scalar in little-endian byte order
+template <typename T>
+void
+write_little_endian(std::ostream& os, T value)
+{
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  if (!host_is_little_endian())
+  {
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+  os.write(bytes, sizeof(T));
+}
+
+/// Write 32-bit values in little-endian byte order
+void
+write_little_endian_block(std::ostream& os, const std::vector<uint32_t>& values)
+{
+  if (!host_is_little_endian())
+  {
+    for (auto const value : values)
+    {
+      write_little_endian(os, value);
+    }
+    return;
+  }
+  os.write(reinterpret_cast<const char*>(values.data()),
+           static_cast<std::streamsize>(values.size() * sizeof(uint32_t)));
+}
+
+// ----------------------------------------------------------------------------
+// Compact binary mesh (KWM) format
+//
+// A KWM file is a 40-byte header followed by the vertex positions as
+// little-endian doubles, three per vertex.  If every face has the same
+// number of vertices (the regularity) the vertex indices of all faces
+// follow as little-endian 32-bit integers.  Otherwise the vertex count of
+// each face follows, then the vertex indices of all faces.  The layout of
+// each block matches the storage of mesh_vertex_array<3>,
+// mesh_regular_face_array<s> and the indices of mesh_polygon_face_array, so
+// reading is a copy of mapped memory.
+
+/// The header of a KWM file
+struct kwm_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t regularity;
+  uint64_t num_verts;
+  uint64_t num_faces;
+  uint64_t num_indices;
+};
+
+constexpr char kwm_magic[8] = { 'K', 'W', 'V', 'R', 'M', 'E', 'S', 'H' };
+constexpr uint32_t kwm_version = 1;
+
+// Number of vertex indices buffered between writes
+constexpr size_t kwm_buffer_size = 1 << 16;
+
+static_assert(sizeof(kwm_header) == 40, "unexpected KWM header padding");
+static_assert(sizeof(vector_3d) == 3 * sizeof(double),
+              "vertex storage must be packed to map vertices");
+static_assert(sizeof(unsigned int) == sizeof(uint32_t),
+              "vertex indices must be 32 bits to map faces");
+
+/// Copy \p count little-endian values of type \p T from mapped memory
+template <typename T>
+void
+copy_little_endian(const char* src, size_t count, void* dest)
+{
+  if (host_is_little_endian())
+  {
+    std::memcpy(dest, src, count * sizeof(T));
+    return;
+  }
+  char* const bytes = static_cast<char*>(dest);
+  for (size_t i = 0; i < count; ++i)
+  {
+    T const value = read_binary<T>(src + i * sizeof(T), true);
+    std::memcpy(bytes + i * sizeof(T), &value, sizeof(T));
+  }
+}
+
+/// Copy the faces of a KWM file with \p s vertices per face
+template <unsigned s>
+std::unique_ptr<mesh_face_array_base>
+read_kwm_regular_faces(const char* data, size_t num_faces)
+{
+  static_assert(sizeof(mesh_regular_face<s>) == s * sizeof(unsigned int),
+                "face storage must be packed to map faces");
+  std::unique_ptr<mesh_regular_face_array<s> > faces(
+    new mesh_regular_face_array<s>(static_cast<unsigned int>(num_faces)));
+  if (num_faces)
+  {
+    copy_little_endian<uint32_t>(data, num_faces * s, &(*faces)[0]);
+  }
+  return std::move(faces);
+}
+
 }
 
 /// Read a mesh from a file, determine type from extension
@@ -88,7 +875,11 @@ read_mesh(const std::string& filename)
   }
   else if (ext == ".ply")
   {
-    return read_ply(input_stream);
+    return read_ply(filename);
+  }
+  else if (ext == ".kwm")
+  {
+    return read_kwm(filename);
   }
   else if (ext == ".obj")
   {
@@ -114,25 +905,28 @@ read_ply2(std::istream& is)
   unsigned int num_verts, num_faces;
   is >> num_verts >> num_faces;
   std::unique_ptr<mesh_vertex_array<3> > verts(new mesh_vertex_array<3>(num_verts));
-  std::unique_ptr<mesh_face_array > faces(new mesh_face_array(num_faces));
+  std::unique_ptr<mesh_polygon_face_array> faces(new mesh_polygon_face_array);
+  faces->reserve(num_faces, 3 * num_faces);
   for (unsigned int v=0; v<num_verts; ++v)
   {
     vector_3d& vert = (*verts)[v];
     is >> vert[0] >> vert[1] >> vert[2];
   }
+  std::vector<unsigned int> face;
   for (unsigned int f=0; f<num_faces; ++f)
   {
-    std::vector<unsigned int>& face = (*faces)[f];
     unsigned int cnt;
     is >> cnt;
-    face.resize(cnt,0);
+    face.assign(cnt,0);
     for (unsigned int v=0; v<cnt; ++v)
     {
       is >> face[v];
     }
+    faces->push_back(face);
   }
 
-  return std::make_shared<mesh>(std::move(verts), std::move(faces));
+  return std::make_shared<mesh>(std::move(verts),
+                                compact_face_array(std::move(faces)));
 }
 
 /// Read a mesh from a PLY file
@@ -140,60 +934,283 @@ mesh_sptr
 read_ply(const std::string& filename)
 {
   check_input_file(filename);
-  std::ifstream input_stream(filename.c_str());
-  return read_ply(input_stream);
+  mapped_file file(filename);
+  if (!file.is_open())
+  {
+    VITAL_THROW( file_not_read_exception, filename,
+                 "Could not map file at given path." );
+  }
+  return read_ply_data(file.data(), file.size());
 }
 
 /// Read a mesh from a PLY stream
 mesh_sptr read_ply(std::istream& is)
 {
-  unsigned int num_verts, num_faces;
-  std::string str;
-  is >> str;
-  bool done=false;
-  while (!done)
+  std::ostringstream ss;
+  ss << is.rdbuf();
+  std::string const data = ss.str();
+  return read_ply_data(data.data(), data.size());
+}
+
+/// Write a mesh to a PLY file
+void
+write_ply(const std::string& filename, const mesh& mesh, bool binary)
+{
+  check_output_file(filename);
+  std::ofstream output_stream(filename.c_str(), std::ios::binary);
+  write_ply(output_stream, mesh, binary);
+}
+
+/// Write a mesh to a PLY stream
+void
+write_ply(std::ostream& os, const mesh& mesh, bool binary)
+{
+  const mesh_vertex_array_base& verts = mesh.vertices();
+  const mesh_face_array_base& faces = mesh.faces();
+
+  // use a byte for the vertex count unless some face is too large
+  unsigned int max_face_verts = faces.regularity();
+  for (unsigned int f=0; max_face_verts == 0 && f<faces.size(); ++f)
   {
-    is >> str;
-    if (str.compare("element")==0)
+    max_face_verts = std::max(max_face_verts, faces.num_verts(f));
+  }
+  bool const byte_counts = max_face_verts <= std::numeric_limits<uint8_t>::max();
+
+  os << "ply\n"
+     << "format " << (binary ? "binary_little_endian" : "ascii") << " 1.0\n"
+     << "element vertex " << verts.size() << '\n'
+     << "property double x\n"
+     << "property double y\n"
+     << "property double z\n"
+     << "element face " << faces.size() << '\n'
+     << "property list " << (byte_counts ? "uchar" : "uint")
+     << " uint vertex_indices\n"
+     << "end_header\n";
+
+  if (!binary)
+  {
+    for (unsigned int v=0; v<verts.size(); ++v)
     {
-      is >> str;
-      if (str.compare("vertex")==0)
-      {
-        is >> num_verts;
-      }
-      else if (str.compare("face")==0)
+      os << verts(v,0) << ' '
+         << verts(v,1) << ' '
+         << verts(v,2) << '\n';
+    }
+    for (unsigned int f=0; f<faces.size(); ++f)
+    {
+      os << faces.num_verts(f);
+      for (unsigned int v=0; v<faces.num_verts(f); ++v)
       {
-        is >> num_faces;
+        os << ' ' << faces(f,v);
       }
+      os << '\n';
     }
-    else if (str.compare("end_header")==0)
+    return;
+  }
+
+  for (unsigned int v=0; v<verts.size(); ++v)
+  {
+    for (unsigned int i=0; i<3; ++i)
     {
-      done = true;
+      write_little_endian<double>(os, i < verts.dim() ? verts(v,i) : 0.0);
     }
   }
-  std::unique_ptr<mesh_vertex_array<3> > verts(new mesh_vertex_array<3>(num_verts));
-  std::unique_ptr<mesh_face_array > faces(new mesh_face_array(num_faces));
-  for (unsigned int v=0; v<num_verts; ++v)
+  for (unsigned int f=0; f<faces.size(); ++f)
   {
-    vector_3d& vert = (*verts)[v];
-    is >> vert[0] >> vert[1] >> vert[2];
-    is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    unsigned int const n = faces.num_verts(f);
+    if (byte_counts)
+    {
+      write_little_endian<uint8_t>(os, static_cast<uint8_t>(n));
+    }
+    else
+    {
+      write_little_endian<uint32_t>(os, n);
+    }
+    for (unsigned int v=0; v<n; ++v)
+    {
+      write_little_endian<uint32_t>(os, faces(f,v));
+    }
   }
-  for (unsigned int f=0; f<num_faces; ++f)
+}
+
+/// Read a mesh from a compact binary KWM file
+mesh_sptr
+read_kwm(const std::string& filename)
+{
+  check_input_file(filename);
+  mapped_file file(filename);
+  if (!file.is_open())
   {
-    std::vector<unsigned int>& face = (*faces)[f];
-    unsigned int cnt;
-    is >> cnt;
-    face.resize(cnt,0);
-    for (unsigned int v=0; v<cnt; ++v)
+    VITAL_THROW( file_not_read_exception, filename,
+                 "Could not map file at given path." );
+  }
+
+  kwm_header header;
+  if (file.size() < sizeof(header))
+  {
+    VITAL_THROW( invalid_file, filename, "File is too small for a KWM header" );
+  }
+  const char* const data = file.data();
+  std::memcpy(header.magic, data, sizeof(header.magic));
+  if (!std::equal(header.magic, header.magic + 8, kwm_magic))
+  {
+    VITAL_THROW( invalid_file, filename, "File is not a KWM mesh" );
+  }
+  header.version = read_binary<uint32_t>(data + 8, !host_is_little_endian());
+  header.regularity = read_binary<uint32_t>(data + 12, !host_is_little_endian());
+  header.num_verts = read_binary<uint64_t>(data + 16, !host_is_little_endian());
+  header.num_faces = read_binary<uint64_t>(data + 24, !host_is_little_endian());
+  header.num_indices = read_binary<uint64_t>(data + 32, !host_is_little_endian());
+  if (header.version != kwm_version)
+  {
+    VITAL_THROW( invalid_file, filename, "Unsupported KWM version" );
+  }
+
+  size_t const max_count = std::numeric_limits<unsigned int>::max();
+  uint64_t const num_counts = header.regularity ? 0 : header.num_faces;
+  uint64_t const expected_size =
+    sizeof(header) + header.num_verts * 3 * sizeof(double) +
+    (num_counts + header.num_indices) * sizeof(uint32_t);
+  if (header.num_verts > max_count || header.num_faces > max_count ||
+      header.num_indices > max_count ||
+      (header.regularity &&
+       header.num_indices != header.num_faces * header.regularity) ||
+      file.size() != expected_size)
+  {
+    VITAL_THROW( invalid_file, filename, "KWM block sizes do not match file" );
+  }
+
+  const char* p = data + sizeof(header);
+  std::unique_ptr<mesh_vertex_array<3> > verts(
+    new mesh_vertex_array<3>(static_cast<unsigned int>(header.num_verts)));
+  if (header.num_verts)
+  {
+    copy_little_endian<double>(p, header.num_verts * 3, &(*verts)[0]);
+  }
+  p += header.num_verts * 3 * sizeof(double);
+
+  std::unique_ptr<mesh_face_array_base> faces;
+  switch (header.regularity)
+  {
+    case 3:
+      faces = read_kwm_regular_faces<3>(p, header.num_faces);
+      break;
+    case 4:
+      faces = read_kwm_regular_faces<4>(p, header.num_faces);
+      break;
+    default:
     {
-      is >> face[v];
+      std::vector<unsigned int> offsets(header.num_faces + 1, 0);
+      for (unsigned int f=0; f<header.num_faces; ++f)
+      {
+        uint32_t const n = header.regularity
+          ? header.regularity
+          : read_binary<uint32_t>(p + f * sizeof(uint32_t),
+                                  !host_is_little_endian());
+        if (header.num_indices - offsets[f] < n)
+        {
+          VITAL_THROW( invalid_file, filename,
+                       "KWM face counts do not match indices" );
+        }
+        offsets[f + 1] = offsets[f] + n;
+      }
+      if (offsets.back() != header.num_indices)
+      {
+        VITAL_THROW( invalid_file, filename,
+                     "KWM face counts do not match indices" );
+      }
+      std::vector<unsigned int> indices(header.num_indices);
+      if (header.num_indices)
+      {
+        copy_little_endian<uint32_t>(p + num_counts * sizeof(uint32_t),
+                                     header.num_indices, indices.data());
+      }
+      std::unique_ptr<mesh_face_array_base> irregular(
+        new mesh_polygon_face_array(std::move(offsets), std::move(indices)));
+      faces = compact_face_array(std::move(irregular));
+      break;
     }
   }
 
   return std::make_shared<mesh>(std::move(verts), std::move(faces));
 }
 
+/// Write a mesh to a compact binary KWM file
+void
+write_kwm(const std::string& filename, const mesh& mesh)
+{
+  check_output_file(filename);
+  std::ofstream output_stream(filename.c_str(), std::ios::binary);
+  write_kwm(output_stream, mesh);
+}
+
+/// Write a mesh to a compact binary KWM stream
+void
+write_kwm(std::ostream& os, const mesh& mesh)
+{
+  const mesh_vertex_array_base& verts = mesh.vertices();
+  const mesh_face_array_base& faces = mesh.faces();
+  unsigned int const regularity = faces.regularity();
+
+  uint64_t num_indices = 0;
+  for (unsigned int f=0; f<faces.size(); ++f)
+  {
+    num_indices += faces.num_verts(f);
+  }
+
+  os.write(kwm_magic, sizeof(kwm_magic));
+  write_little_endian<uint32_t>(os, kwm_version);
+  write_little_endian<uint32_t>(os, regularity);
+  write_little_endian<uint64_t>(os, verts.size());
+  write_little_endian<uint64_t>(os, faces.size());
+  write_little_endian<uint64_t>(os, num_indices);
+
+  auto const* const verts3 = dynamic_cast<const mesh_vertex_array<3>*>(&verts);
+  if (verts3 && verts.size() && host_is_little_endian())
+  {
+    os.write(reinterpret_cast<const char*>(&(*verts3)[0]),
+             static_cast<std::streamsize>(verts.size() * sizeof(vector_3d)));
+  }
+  else
+  {
+    for (unsigned int v=0; v<verts.size(); ++v)
+    {
+      for (unsigned int i=0; i<3; ++i)
+      {
+        write_little_endian<double>(os, i < verts.dim() ? verts(v,i) : 0.0);
+      }
+    }
+  }
+
+  // write in blocks to avoid a stream call per index
+  std::vector<uint32_t> buffer;
+  buffer.reserve(kwm_buffer_size);
+  auto const push = [&](uint32_t value)
+  {
+    buffer.push_back(value);
+    if (buffer.size() == kwm_buffer_size)
+    {
+      write_little_endian_block(os, buffer);
+      buffer.clear();
+    }
+  };
+
+  if (!regularity)
+  {
+    for (unsigned int f=0; f<faces.size(); ++f)
+    {
+      push(faces.num_verts(f));
+    }
+  }
+  for (unsigned int f=0; f<faces.size(); ++f)
+  {
+    for (unsigned int v=0; v<faces.num_verts(f); ++v)
+    {
+      push(faces(f,v));
+    }
+  }
+  write_little_endian_block(os, buffer);
+}
+
 /// Write a mesh to a PLY2 file
 void
 write_ply2(const std::string& filename, const mesh& mesh)
@@ -272,7 +1289,7 @@ read_obj(std::istream& is)
 {
   logger_handle_t logger(get_logger( "vital.mesh_io.read_obj" ));
   std::unique_ptr<mesh_vertex_array<3> > verts(new mesh_vertex_array<3>);
-  std::unique_ptr<mesh_face_array> faces(new mesh_face_array);
+  std::unique_ptr<mesh_polygon_face_array> faces(new mesh_polygon_face_array);
   std::vector<vector_3d> normals;
   std::vector<vector_2d> tex;
   std::string last_group = "ungrouped";
@@ -388,7 +1405,8 @@ read_obj(std::istream& is)
     verts->set_normals(normals);
   }
 
-  mesh_sptr m = std::make_shared<mesh>(std::move(verts), std::move(faces));
+  mesh_sptr m = std::make_shared<mesh>(std::move(verts),
+                                       compact_face_array(std::move(faces)));
   m->set_tex_coords(tex);
   return m;
 }
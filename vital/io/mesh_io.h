@@ -5,7 +5,11 @@
 /// \file
 /// \brief File IO functions for a \ref kwiver::vital::mesh
 ///
-/// Functions provide IO in multiple formats including OBJ, PLY, KML
+/// Functions provide IO in multiple formats including OBJ, PLY, KML, and
+/// the compact binary KWM format
+///
+/// Readers return the faces of triangle meshes as a
+/// mesh_regular_face_array<3> and other faces as a mesh_polygon_face_array.
 
 #ifndef VITAL_MESH_IO_H_
 #define VITAL_MESH_IO_H_
@@ -23,13 +27,46 @@ VITAL_EXPORT
 mesh_sptr read_mesh(const std::string& filename);
 
 /// Read a mesh from a PLY file
+///
+/// ASCII, binary little-endian, and binary big-endian files are supported.
+/// The file is memory mapped, and the vertices, and the faces of ASCII
+/// files, are parsed in parallel.
 VITAL_EXPORT
 mesh_sptr read_ply(const std::string& filename);
 
-/// Read a mesh from a PLY file
+/// Read a mesh from a PLY stream
 VITAL_EXPORT
 mesh_sptr read_ply(std::istream& is);
 
+/// Write a mesh to a PLY stream, optionally in binary little-endian format
+///
+/// Binary output must go to a stream opened in binary mode.
+VITAL_EXPORT
+void write_ply(std::ostream& os, const mesh& mesh, bool binary = false);
+
+/// Write a mesh to a PLY file, optionally in binary little-endian format
+VITAL_EXPORT
+void write_ply(const std::string& filename, const mesh& mesh,
+               bool binary = false);
+
+/// Read a mesh from a compact binary KWM file
+///
+/// KWM files store vertices and faces in the memory layout of
+/// mesh_vertex_array<3> and mesh_polygon_face_array or
+/// mesh_regular_face_array, so the file is memory mapped and copied into the
+/// mesh without parsing.  Triangle and quad meshes are read as regular face
+/// arrays.
+VITAL_EXPORT
+mesh_sptr read_kwm(const std::string& filename);
+
+/// Write a mesh to a compact binary KWM stream opened in binary mode
+VITAL_EXPORT
+void write_kwm(std::ostream& os, const mesh& mesh);
+
+/// Write a mesh to a compact binary KWM file
+VITAL_EXPORT
+void write_kwm(const std::string& filename, const mesh& mesh);
+
 /// Read a mesh from a PLY2 stream
 VITAL_EXPORT
 mesh_sptr read_ply2(std::istream& is);
@@ -0,0 +1,280 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of file IO functions for a
+///        \ref kwiver::vital::pointcloud
+
+#include "pointcloud_io.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include <vital/exceptions.h>
+#include <vital/util/mapped_file.h>
+#include <kwiversys/SystemTools.hxx>
+
+namespace kwiver {
+namespace vital {
+
+namespace {
+
+// A KWP file is a 24-byte header followed by the positions as three
+// little-endian floats or doubles per point, then the colors as three
+// bytes per point if present, then the intensities as a byte per point if
+// present.
+
+/// Flags of the contents of a KWP file
+enum kwp_flags : uint32_t
+{
+  KWP_FLOAT = 1,
+  KWP_COLORS = 2,
+  KWP_INTENSITIES = 4,
+};
+
+constexpr char kwp_magic[8] = { 'K', 'W', 'V', 'R', 'P', 'C', 'L', 'D' };
+constexpr uint32_t kwp_version = 1;
+constexpr size_t kwp_header_size = 24;
+
+static_assert(sizeof(rgb_color) == 3, "color storage must be packed");
+static_assert(sizeof(Eigen::Matrix<float, 3, 1>) == 3 * sizeof(float),
+              "float position storage must be packed");
+static_assert(sizeof(vector_3d) == 3 * sizeof(double),
+              "double position storage must be packed");
+
+/// Check if this machine stores numbers little-endian
+bool
+host_is_little_endian()
+{
+  uint16_t const value = 1;
+  unsigned char first;
+  std::memcpy(&first, &value, 1);
+  return first == 1;
+}
+
+/// Copy \p count little-endian values of type \p T
+template <typename T>
+void
+copy_little_endian(const char* src, size_t count, void* dest)
+{
+  std::memcpy(dest, src, count * sizeof(T));
+  if (!host_is_little_endian())
+  {
+    char* bytes = static_cast<char*>(dest);
+    for (size_t i = 0; i < count; ++i, bytes += sizeof(T))
+    {
+      std::reverse(bytes, bytes + sizeof(T));
+    }
+  }
+}
+
+/// Write a scalar in little-endian byte order
+template <typename T>
+void
+write_little_endian(std::ostream& os, T value)
+{
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  if (!host_is_little_endian())
+  {
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+  os.write(bytes, sizeof(T));
+}
+
+/// Write a block of values in little-endian byte order
+template <typename T>
+void
+write_little_endian_block(std::ostream& os, const T* values, size_t count)
+{
+  if (!host_is_little_endian())
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      write_little_endian(os, values[i]);
+    }
+    return;
+  }
+  os.write(reinterpret_cast<const char*>(values),
+           static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+/// Copy the positions, colors and intensities of a KWP file
+template <typename T>
+pointcloud_sptr
+read_kwp_data(const char* p, size_t num_points, uint32_t flags)
+{
+  std::vector<Eigen::Matrix<T, 3, 1> > positions(num_points);
+  if (num_points)
+  {
+    copy_little_endian<T>(p, 3 * num_points, positions.data());
+  }
+  p += 3 * sizeof(T) * num_points;
+  auto cloud = std::make_shared<pointcloud_<T> >(positions);
+
+  if (flags & KWP_COLORS)
+  {
+    std::vector<rgb_color> colors(num_points);
+    std::memcpy(colors.data(), p, 3 * num_points);
+    p += 3 * num_points;
+    cloud->set_color(colors);
+  }
+  if (flags & KWP_INTENSITIES)
+  {
+    cloud->set_intensities(std::vector<uint8_t>(p, p + num_points));
+  }
+  return cloud;
+}
+
+}
+
+/// Read a point cloud from a compact binary KWP file
+pointcloud_sptr
+read_kwp(const std::string& filename)
+{
+  if ( ! kwiversys::SystemTools::FileExists( filename ) )
+  {
+    VITAL_THROW( file_not_found_exception, filename, "File does not exist." );
+  }
+  mapped_file file(filename);
+  if (!file.is_open())
+  {
+    VITAL_THROW( file_not_read_exception, filename,
+                 "Could not map file at given path." );
+  }
+  if (file.size() < kwp_header_size ||
+      !std::equal(kwp_magic, kwp_magic + 8, file.data()))
+  {
+    VITAL_THROW( invalid_file, filename, "File is not a KWP point cloud" );
+  }
+
+  uint32_t version, flags;
+  uint64_t num_points;
+  copy_little_endian<uint32_t>(file.data() + 8, 1, &version);
+  copy_little_endian<uint32_t>(file.data() + 12, 1, &flags);
+  copy_little_endian<uint64_t>(file.data() + 16, 1, &num_points);
+  if (version != kwp_version)
+  {
+    VITAL_THROW( invalid_file, filename, "Unsupported KWP version" );
+  }
+
+  uint64_t const point_size =
+    3 * ((flags & KWP_FLOAT) ? sizeof(float) : sizeof(double)) +
+    ((flags & KWP_COLORS) ? 3 : 0) + ((flags & KWP_INTENSITIES) ? 1 : 0);
+  if (num_points > (file.size() - kwp_header_size) / point_size ||
+      file.size() != kwp_header_size + num_points * point_size)
+  {
+    VITAL_THROW( invalid_file, filename, "KWP block sizes do not match file" );
+  }
+
+  const char* const data = file.data() + kwp_header_size;
+  if (flags & KWP_FLOAT)
+  {
+    return read_kwp_data<float>(data, num_points, flags);
+  }
+  return read_kwp_data<double>(data, num_points, flags);
+}
+
+/// Write a point cloud to a compact binary KWP file
+void
+write_kwp(const std::string& filename, const pointcloud& cloud)
+{
+  if ( kwiversys::SystemTools::FileIsDirectory( filename ) )
+  {
+    VITAL_THROW( file_write_exception, filename,
+                 "Path given is a directory, can not write file." );
+  }
+  std::string parent_dir = kwiversys::SystemTools::GetFilenamePath(
+    kwiversys::SystemTools::CollapseFullPath( filename ) );
+  if ( ! kwiversys::SystemTools::FileIsDirectory( parent_dir ) )
+  {
+    if ( ! kwiversys::SystemTools::MakeDirectory( parent_dir ) )
+    {
+      VITAL_THROW( file_write_exception, parent_dir,
+                   "Attempted directory creation, but no directory created!" );
+    }
+  }
+
+  std::ofstream output_stream(filename.c_str(), std::ios::binary);
+  if ( ! output_stream )
+  {
+    VITAL_THROW( file_write_exception, filename,
+                 "Could not open file for writing." );
+  }
+  write_kwp(output_stream, cloud);
+}
+
+/// Write a point cloud to a compact binary KWP stream
+void
+write_kwp(std::ostream& os, const pointcloud& cloud)
+{
+  // write the native positions of the standard precisions, otherwise doubles
+  auto const* const cloud_f = dynamic_cast<const pointcloud_f*>(&cloud);
+  auto const* const cloud_d = dynamic_cast<const pointcloud_d*>(&cloud);
+  std::vector<vector_3d> converted;
+  if (!cloud_f && !cloud_d)
+  {
+    converted = cloud.positions();
+  }
+  size_t const num_points = cloud_f ? cloud_f->get_positions().size()
+                          : cloud_d ? cloud_d->get_positions().size()
+                          : converted.size();
+
+  std::vector<rgb_color> const colors = cloud.colors();
+  std::vector<uint8_t> const intensities = cloud.intensities();
+  if ((cloud.has_colors() && colors.size() != num_points) ||
+      (cloud.has_intensities() && intensities.size() != num_points))
+  {
+    VITAL_THROW( invalid_data,
+                 "Point cloud colors or intensities do not match positions" );
+  }
+
+  uint32_t flags = cloud_f ? KWP_FLOAT : 0;
+  if (cloud.has_colors())
+  {
+    flags |= KWP_COLORS;
+  }
+  if (cloud.has_intensities())
+  {
+    flags |= KWP_INTENSITIES;
+  }
+
+  os.write(kwp_magic, sizeof(kwp_magic));
+  write_little_endian<uint32_t>(os, kwp_version);
+  write_little_endian<uint32_t>(os, flags);
+  write_little_endian<uint64_t>(os, num_points);
+
+  if (num_points)
+  {
+    if (cloud_f)
+    {
+      write_little_endian_block(os, cloud_f->get_positions()[0].data(),
+                                3 * num_points);
+    }
+    else if (cloud_d)
+    {
+      write_little_endian_block(os, cloud_d->get_positions()[0].data(),
+                                3 * num_points);
+    }
+    else
+    {
+      write_little_endian_block(os, converted[0].data(), 3 * num_points);
+    }
+  }
+  if (flags & KWP_COLORS)
+  {
+    os.write(reinterpret_cast<const char*>(colors.data()),
+             static_cast<std::streamsize>(3 * num_points));
+  }
+  if (flags & KWP_INTENSITIES)
+  {
+    os.write(reinterpret_cast<const char*>(intensities.data()),
+             static_cast<std::streamsize>(num_points));
+  }
+}
+
+} // end namespace vital
+} // end namespace kwiver
@@ -0,0 +1,44 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief File IO functions for a \ref kwiver::vital::pointcloud
+///
+/// Functions provide IO in the compact binary KWP format
+
+#ifndef VITAL_POINTCLOUD_IO_H_
+#define VITAL_POINTCLOUD_IO_H_
+
+#include <vital/vital_config.h>
+#include <vital/vital_export.h>
+
+#include <vital/types/pointcloud.h>
+
+#include <iosfwd>
+#include <string>
+
+namespace kwiver {
+namespace vital {
+
+/// Read a point cloud from a compact binary KWP file
+///
+/// KWP files store positions, and optionally colors and intensities, in the
+/// memory layout of pointcloud_, so the file is memory mapped and copied
+/// into the point cloud without parsing.  The point cloud has the precision
+/// with which it was written.
+VITAL_EXPORT
+pointcloud_sptr read_kwp(const std::string& filename);
+
+/// Write a point cloud to a compact binary KWP stream opened in binary mode
+VITAL_EXPORT
+void write_kwp(std::ostream& os, const pointcloud& cloud);
+
+/// Write a point cloud to a compact binary KWP file
+VITAL_EXPORT
+void write_kwp(const std::string& filename, const pointcloud& cloud);
+
+} // end namespace vital
+} // end namespace kwiver
+
+#endif // VITAL_POINTCLOUD_IO_H_
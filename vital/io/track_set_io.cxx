@@ -8,21 +8,82 @@
 /// \todo Describe format here.
 
 #include "track_set_io.h"
+#include "binary_io.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 #include <map>
 
 #include <vital/exceptions.h>
 #include <vital/types/feature.h>
 #include <vital/types/descriptor.h>
+#include <vital/util/mapped_file.h>
 #include <kwiversys/SystemTools.hxx>
 
 namespace kwiver {
 namespace vital {
 
+using detail::check_output_file;
+using detail::get_little_endian;
+using detail::put_little_endian;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Compact binary object track (KWT) format
+//
+// A KWT file is a 56-byte header followed by four blocks:
+// - the frame index, one 24-byte entry per frame in increasing order of
+//   frame: the frame id, and the index of its first state and first score
+// - the track states, one 72-byte record per state, ordered by frame and
+//   then by track id: the track id, frame id and time, the bounding box
+//   (min x, min y, max x, max y) and confidence of the detection as
+//   doubles, the number of class scores of the detection, and flags
+// - the class scores of all states in state order, as 16-byte pairs of a
+//   class name index and a score
+// - the class names, each terminated by a null character
+// All numbers are little-endian.
+
+/// The header of a KWT file
+struct kwt_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t num_frames;
+  uint64_t num_states;
+  uint64_t num_scores;
+  uint64_t num_names;
+  uint64_t names_size;
+};
+
+constexpr char kwt_magic[8] = { 'K', 'W', 'V', 'R', 'T', 'R', 'K', 'S' };
+constexpr uint32_t kwt_version = 1;
+
+constexpr size_t kwt_header_size = 56;
+constexpr size_t kwt_frame_size = 24;
+constexpr size_t kwt_state_size = 72;
+constexpr size_t kwt_score_size = 16;
+
+// Flags of a KWT state record
+constexpr uint32_t kwt_has_detection = 1 << 0;
+constexpr uint32_t kwt_has_type = 1 << 1;
+
+// Bytes of records buffered between writes
+constexpr size_t kwt_buffer_size = 1 << 20;
+
+static_assert( sizeof( kwt_header ) == kwt_header_size,
+               "unexpected KWT header padding" );
+
+} // end namespace
+
 // ----------------------------------------------------------------------------
 /// Read in a track file, producing a track_set
 track_set_sptr
@@ -289,4 +350,447 @@ write_feature_track_file( feature_track_set_sptr const& tracks,
   ofile.close();
 } // write_track_file
 
+// ----------------------------------------------------------------------------
+void
+write_kwt( std::ostream& os, object_track_set const& tracks )
+{
+  // Order the states by frame, then by track id
+  struct state_ref
+  {
+    track_id_t track;
+    object_track_state const* state;
+  };
+
+  std::vector< state_ref > states;
+  auto all_tracks = tracks.tracks();
+  std::sort( all_tracks.begin(), all_tracks.end(),
+    []( track_sptr const& a, track_sptr const& b ){
+      return a->id() < b->id(); } );
+  for( auto const& trk : all_tracks )
+  {
+    for( auto const& ts : *trk )
+    {
+      auto const ots = dynamic_cast< object_track_state const* >( ts.get() );
+      if( !ots )
+      {
+        VITAL_THROW( invalid_data, "Track " + std::to_string( trk->id() ) +
+                                   " has a state which is not an object "
+                                   "track state" );
+      }
+      states.push_back( { trk->id(), ots } );
+    }
+  }
+  std::stable_sort( states.begin(), states.end(),
+    []( state_ref const& a, state_ref const& b ){
+      return a.state->frame() < b.state->frame(); } );
+
+  // Number the class names, and index the first state of each frame
+  std::unordered_map< std::string const*, uint64_t > name_index;
+  std::string names;
+  std::string frames;
+  uint64_t num_frames = 0;
+  uint64_t num_scores = 0;
+  for( size_t i = 0; i < states.size(); ++i )
+  {
+    auto const frame = states[ i ].state->frame();
+    if( i == 0 || frame != states[ i - 1 ].state->frame() )
+    {
+      put_little_endian< int64_t >( frames, frame );
+      put_little_endian< uint64_t >( frames, i );
+      put_little_endian< uint64_t >( frames, num_scores );
+      ++num_frames;
+    }
+
+    auto const det = states[ i ].state->detection();
+    if( auto const type = ( det ? det->type() : nullptr ) )
+    {
+      for( auto const& entry : *type )
+      {
+        if( name_index.emplace( entry.first, name_index.size() ).second )
+        {
+          names.append( *entry.first );
+          names.push_back( '\0' );
+        }
+      }
+      num_scores += type->size();
+    }
+  }
+
+  std::string buffer;
+  buffer.append( kwt_magic, sizeof( kwt_magic ) );
+  put_little_endian< uint32_t >( buffer, kwt_version );
+  put_little_endian< uint32_t >( buffer, 0 );
+  put_little_endian< uint64_t >( buffer, num_frames );
+  put_little_endian< uint64_t >( buffer, states.size() );
+  put_little_endian< uint64_t >( buffer, num_scores );
+  put_little_endian< uint64_t >( buffer, name_index.size() );
+  put_little_endian< uint64_t >( buffer, names.size() );
+  os.write( buffer.data(), static_cast< std::streamsize >( buffer.size() ) );
+  os.write( frames.data(), static_cast< std::streamsize >( frames.size() ) );
+
+  // Write records in blocks to avoid a stream call per value
+  buffer.clear();
+  auto const flush = [ & ]( bool force )
+  {
+    if( force || buffer.size() >= kwt_buffer_size )
+    {
+      os.write( buffer.data(),
+                static_cast< std::streamsize >( buffer.size() ) );
+      buffer.clear();
+    }
+  };
+
+  for( auto const& s : states )
+  {
+    auto const det = s.state->detection();
+    auto const type = ( det ? det->type() : nullptr );
+    auto const bbox = ( det ? det->bounding_box() : bounding_box_d{} );
+    put_little_endian< int64_t >( buffer, s.track );
+    put_little_endian< int64_t >( buffer, s.state->frame() );
+    put_little_endian< int64_t >( buffer, s.state->time() );
+    put_little_endian< double >( buffer, det ? bbox.min_x() : 0.0 );
+    put_little_endian< double >( buffer, det ? bbox.min_y() : 0.0 );
+    put_little_endian< double >( buffer, det ? bbox.max_x() : 0.0 );
+    put_little_endian< double >( buffer, det ? bbox.max_y() : 0.0 );
+    put_little_endian< double >( buffer, det ? det->confidence() : 0.0 );
+    put_little_endian< uint32_t >(
+      buffer, static_cast< uint32_t >( type ? type->size() : 0 ) );
+    put_little_endian< uint32_t >(
+      buffer, ( det ? kwt_has_detection : 0 ) | ( type ? kwt_has_type : 0 ) );
+    flush( false );
+  }
+
+  for( auto const& s : states )
+  {
+    auto const det = s.state->detection();
+    if( auto const type = ( det ? det->type() : nullptr ) )
+    {
+      for( auto const& entry : *type )
+      {
+        put_little_endian< uint64_t >( buffer, name_index[ entry.first ] );
+        put_little_endian< double >( buffer, entry.second );
+      }
+      flush( false );
+    }
+  }
+
+  buffer.append( names );
+  flush( true );
+}
+
+// ----------------------------------------------------------------------------
+void
+write_kwt( path_t const& file_path, object_track_set const& tracks )
+{
+  check_output_file( file_path );
+  std::ofstream output_stream( file_path.c_str(), std::ios::binary );
+  if( !output_stream )
+  {
+    VITAL_THROW( file_write_exception, file_path,
+                 "Could not open file at given path." );
+  }
+  write_kwt( output_stream, tracks );
+  if( !output_stream )
+  {
+    VITAL_THROW( file_write_exception, file_path,
+                 "Could not write the file." );
+  }
+}
+
+// ----------------------------------------------------------------------------
+object_track_set_sptr
+read_kwt( path_t const& file_path )
+{
+  return kwt_reader{ file_path }.read_all();
+}
+
+// ----------------------------------------------------------------------------
+class kwt_reader::priv
+{
+public:
+  // Find the blocks of the data, calling error with a reason if they are
+  // not valid
+  template < typename Error >
+  void parse( Error const& error );
+
+  // Read state i, whose first class score is score i, advancing score past
+  // its class scores
+  std::shared_ptr< object_track_state > read_state( uint64_t i, uint64_t& score,
+                                      track_id_t& track ) const;
+
+  mapped_file file;
+  std::string buffer;
+
+  char const* data = nullptr;
+  size_t size = 0;
+
+  char const* frame_index = nullptr;
+  char const* states = nullptr;
+  char const* scores = nullptr;
+
+  std::vector< frame_id_t > frames;
+  uint64_t num_states = 0;
+  uint64_t num_scores = 0;
+  std::vector< detected_object_type::class_id_t > names;
+};
+
+// ----------------------------------------------------------------------------
+template < typename Error >
+void
+kwt_reader::priv
+::parse( Error const& error )
+{
+  if( size < kwt_header_size ||
+      !std::equal( kwt_magic, kwt_magic + sizeof( kwt_magic ), data ) )
+  {
+    error( "Data is not KWT object tracks" );
+  }
+  if( get_little_endian< uint32_t >( data + 8 ) != kwt_version )
+  {
+    error( "Unsupported KWT version" );
+  }
+
+  auto const num_frames = get_little_endian< uint64_t >( data + 16 );
+  num_states = get_little_endian< uint64_t >( data + 24 );
+  num_scores = get_little_endian< uint64_t >( data + 32 );
+  auto const num_names = get_little_endian< uint64_t >( data + 40 );
+  auto const names_size = get_little_endian< uint64_t >( data + 48 );
+
+  // Check the block sizes without overflowing
+  auto const available = size - kwt_header_size;
+  if( num_frames > available / kwt_frame_size ||
+      num_states > available / kwt_state_size ||
+      num_scores > available / kwt_score_size ||
+      names_size > available ||
+      num_frames * kwt_frame_size + num_states * kwt_state_size +
+      num_scores * kwt_score_size + names_size != available ||
+      num_frames > num_states )
+  {
+    error( "KWT block sizes do not match data" );
+  }
+
+  frame_index = data + kwt_header_size;
+  states = frame_index + num_frames * kwt_frame_size;
+  scores = states + num_states * kwt_state_size;
+  char const* const name_data = scores + num_scores * kwt_score_size;
+
+  frames.reserve( num_frames );
+  for( uint64_t f = 0; f < num_frames; ++f )
+  {
+    char const* const entry = frame_index + f * kwt_frame_size;
+    frames.push_back( get_little_endian< int64_t >( entry ) );
+    if( ( f && frames[ f ] <= frames[ f - 1 ] ) ||
+        get_little_endian< uint64_t >( entry + 8 ) >= num_states ||
+        get_little_endian< uint64_t >( entry + 16 ) > num_scores )
+    {
+      error( "KWT frame index is not valid" );
+    }
+  }
+  if( num_states && ( !num_frames ||
+                      get_little_endian< uint64_t >( frame_index + 8 ) ) )
+  {
+    error( "KWT frame index is not valid" );
+  }
+
+  // Class names are interned, as class_map does
+  char const* name = name_data;
+  char const* const names_end = name_data + names_size;
+  for( uint64_t n = 0; n < num_names; ++n )
+  {
+    auto const end = static_cast< char const* >(
+      std::memchr( name, '\0', static_cast< size_t >( names_end - name ) ) );
+    if( !end )
+    {
+      error( "KWT class names are not valid" );
+    }
+    names.push_back(
+      detected_object_type::class_id( std::string( name, end ) ) );
+    name = end + 1;
+  }
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< object_track_state >
+kwt_reader::priv
+::read_state( uint64_t i, uint64_t& score, track_id_t& track ) const
+{
+  char const* const p = states + i * kwt_state_size;
+  track = get_little_endian< int64_t >( p );
+  auto const frame = get_little_endian< int64_t >( p + 8 );
+  auto const time = get_little_endian< int64_t >( p + 16 );
+  auto const count = get_little_endian< uint32_t >( p + 64 );
+  auto const flags = get_little_endian< uint32_t >( p + 68 );
+
+  if( count > num_scores - score )
+  {
+    VITAL_THROW( invalid_data, "KWT class scores do not match states" );
+  }
+
+  detected_object_sptr det;
+  if( flags & kwt_has_detection )
+  {
+    detected_object_type_sptr type;
+    if( flags & kwt_has_type )
+    {
+      type = std::make_shared< detected_object_type >();
+      for( uint32_t n = 0; n < count; ++n, ++score )
+      {
+        char const* const entry = scores + score * kwt_score_size;
+        auto const name = get_little_endian< uint64_t >( entry );
+        if( name >= names.size() )
+        {
+          VITAL_THROW( invalid_data, "KWT class score has no class name" );
+        }
+        type->set_score( names[ name ],
+                         get_little_endian< double >( entry + 8 ) );
+      }
+    }
+    else
+    {
+      score += count;
+    }
+
+    bounding_box_d const bbox{ get_little_endian< double >( p + 24 ),
+                               get_little_endian< double >( p + 32 ),
+                               get_little_endian< double >( p + 40 ),
+                               get_little_endian< double >( p + 48 ) };
+    det = std::make_shared< detected_object >(
+      bbox, get_little_endian< double >( p + 56 ), type );
+  }
+  else
+  {
+    score += count;
+  }
+
+  return std::make_shared< object_track_state >( frame, time, det );
+}
+
+// ----------------------------------------------------------------------------
+kwt_reader
+::kwt_reader( path_t const& file_path )
+  : d{ new priv }
+{
+  if( !kwiversys::SystemTools::FileExists( file_path ) )
+  {
+    VITAL_THROW( file_not_found_exception, file_path, "File does not exist." );
+  }
+  if( !d->file.open( file_path ) )
+  {
+    VITAL_THROW( file_not_found_exception, file_path,
+                 "File could not be mapped." );
+  }
+
+  d->data = d->file.data();
+  d->size = d->file.size();
+  d->parse( [ & ]( std::string const& reason ){
+    VITAL_THROW( invalid_file, file_path, reason ); } );
+}
+
+// ----------------------------------------------------------------------------
+kwt_reader
+::kwt_reader( std::istream& is )
+  : d{ new priv }
+{
+  d->buffer.assign( std::istreambuf_iterator< char >( is ),
+                    std::istreambuf_iterator< char >() );
+  d->data = d->buffer.data();
+  d->size = d->buffer.size();
+  d->parse( []( std::string const& reason ){
+    VITAL_THROW( invalid_data, reason ); } );
+}
+
+// ----------------------------------------------------------------------------
+kwt_reader
+::~kwt_reader()
+{
+}
+
+// ----------------------------------------------------------------------------
+std::vector< frame_id_t > const&
+kwt_reader
+::frames() const
+{
+  return d->frames;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+kwt_reader
+::num_states() const
+{
+  return static_cast< size_t >( d->num_states );
+}
+
+// ----------------------------------------------------------------------------
+object_track_set_sptr
+kwt_reader
+::read_all() const
+{
+  std::map< track_id_t, track_sptr > tracks;
+  track_sptr last;
+  uint64_t score = 0;
+  for( uint64_t i = 0; i < d->num_states; ++i )
+  {
+    track_id_t id;
+    auto const state = d->read_state( i, score, id );
+    if( !last || last->id() != id )
+    {
+      auto& trk = tracks[ id ];
+      if( !trk )
+      {
+        trk = track::create();
+        trk->set_id( id );
+      }
+      last = trk;
+    }
+    if( !last->append( state ) )
+    {
+      VITAL_THROW( invalid_data, "KWT track " + std::to_string( id ) +
+                                 " has states out of order" );
+    }
+  }
+
+  std::vector< track_sptr > result;
+  result.reserve( tracks.size() );
+  for( auto const& t : tracks )
+  {
+    result.push_back( t.second );
+  }
+  return std::make_shared< object_track_set >( result );
+}
+
+// ----------------------------------------------------------------------------
+object_track_set_sptr
+kwt_reader
+::read_frame( frame_id_t frame ) const
+{
+  std::vector< track_sptr > result;
+
+  auto const& frames = d->frames;
+  auto const it = std::lower_bound( frames.begin(), frames.end(), frame );
+  if( it != frames.end() && *it == frame )
+  {
+    auto const f = static_cast< size_t >( it - frames.begin() );
+    char const* const entry = d->frame_index + f * kwt_frame_size;
+    auto const first = get_little_endian< uint64_t >( entry + 8 );
+    auto score = get_little_endian< uint64_t >( entry + 16 );
+    auto const last =
+      ( f + 1 < frames.size()
+        ? get_little_endian< uint64_t >( entry + kwt_frame_size + 8 )
+        : d->num_states );
+
+    for( auto i = first; i < last; ++i )
+    {
+      track_id_t id;
+      auto const state = d->read_state( i, score, id );
+      auto trk = track::create();
+      trk->set_id( id );
+      trk->append( state );
+      result.push_back( trk );
+    }
+  }
+
+  return std::make_shared< object_track_set >( result );
+}
+
 } } // end namespace
@@ -13,6 +13,11 @@
 #include <vital/vital_export.h>
 
 #include <vital/types/feature_track_set.h>
+#include <vital/types/object_track_set.h>
+
+#include <iosfwd>
+#include <memory>
+#include <vector>
 
 namespace kwiver {
 namespace vital {
@@ -82,6 +87,79 @@ void
 VITAL_EXPORT write_feature_track_file( feature_track_set_sptr const&  tracks,
                                        path_t const&                  file_path );
 
+/// Write object tracks to a compact binary KWT stream opened in binary mode
+///
+/// KWT files hold the states of object tracks with their detections,
+/// including class scores, as fixed size little-endian records ordered by
+/// frame, with an index of the frames. They are meant for intermediate
+/// results which are read back by a program, and may be read without
+/// parsing and by frame with kwt_reader.
+///
+/// \param os     The stream to write to.
+/// \param tracks The tracks to write.
+void
+VITAL_EXPORT write_kwt( std::ostream& os, object_track_set const& tracks );
+
+/// Write object tracks to a compact binary KWT file
+///
+/// \throws file_write_exception
+///    Thrown when something prevents output of the file.
+void
+VITAL_EXPORT write_kwt( path_t const& file_path,
+                        object_track_set const& tracks );
+
+/// Read object tracks from a compact binary KWT file
+///
+/// \throws invalid_file
+///    Thrown when the file is not a valid KWT file.
+object_track_set_sptr
+VITAL_EXPORT read_kwt( path_t const& file_path );
+
+/// Random access reader of compact binary KWT object track data
+///
+/// Files are memory mapped, so that reading the states of a frame only
+/// touches the records of that frame.
+class VITAL_EXPORT kwt_reader
+{
+public:
+  /// Map the KWT file at \p file_path
+  ///
+  /// \throws file_not_found_exception
+  ///    Thrown when the file could not be opened.
+  /// \throws invalid_file
+  ///    Thrown when the file is not a valid KWT file.
+  explicit kwt_reader( path_t const& file_path );
+
+  /// Read the KWT data remaining in \p is
+  ///
+  /// \throws invalid_data
+  ///    Thrown when the data is not valid KWT data.
+  explicit kwt_reader( std::istream& is );
+
+  ~kwt_reader();
+
+  /// Frames with track states, in increasing order
+  std::vector< frame_id_t > const& frames() const;
+
+  /// Number of track states on all frames
+  size_t num_states() const;
+
+  /// Read the tracks with all their states
+  ///
+  /// Tracks are ordered by id.
+  object_track_set_sptr read_all() const;
+
+  /// Read the states on frame \p frame
+  ///
+  /// \returns a set of tracks, ordered by id, which each have the one state
+  ///          of the track on that frame.
+  object_track_set_sptr read_frame( frame_id_t frame ) const;
+
+private:
+  class priv;
+  std::unique_ptr< priv > d;
+};
+
 } } // end namespace
 
 #endif // VITAL_TRACK_SET_IO_H_
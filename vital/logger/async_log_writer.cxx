@@ -0,0 +1,244 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "async_log_writer.h"
+
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace kwiver {
+namespace vital {
+namespace logger_ns {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+size_t
+ring_size( size_t capacity )
+{
+  size_t size = 2;
+  while ( size < capacity )
+  {
+    size <<= 1;
+  }
+  return size;
+}
+
+// Most records the writer puts out under one hold of the stream lock
+size_t const max_batch = 256;
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+// One slot of the ring. The sequence number tells producers and the
+// consumer whose turn it is (Vyukov's bounded MPMC queue).
+struct async_log_writer::cell
+{
+  std::atomic< size_t > sequence;
+  record data;
+};
+
+// ----------------------------------------------------------------------------
+async_log_writer
+::async_log_writer( std::ostream& stream, std::mutex& stream_lock,
+                    size_t capacity )
+  : m_stream( stream ),
+    m_stream_lock( stream_lock ),
+    m_cells( new cell[ ring_size( capacity ) ] ),
+    m_mask( ring_size( capacity ) - 1 ),
+    m_enqueue_pos( 0 ),
+    m_dequeue_pos( 0 ),
+    m_pushed( 0 ),
+    m_written( 0 ),
+    m_sleeping( false ),
+    m_stop( false )
+{
+  for ( size_t i = 0; i <= m_mask; ++i )
+  {
+    m_cells[ i ].sequence.store( i, std::memory_order_relaxed );
+  }
+
+  m_thread = std::thread( &async_log_writer::run, this );
+}
+
+// ----------------------------------------------------------------------------
+async_log_writer
+::~async_log_writer()
+{
+  {
+    std::lock_guard< std::mutex > lock( m_wait_lock );
+    m_stop = true;
+  }
+  m_wake.notify_one();
+  m_thread.join();
+}
+
+// ----------------------------------------------------------------------------
+uint64_t
+async_log_writer
+::push( record&& rec )
+{
+  // Ring is full; let the writer make room rather than lose the message
+  size_t pos;
+  while ( ! try_push( rec, pos ) )
+  {
+    std::unique_lock< std::mutex > lock( m_wait_lock );
+    m_progress.wait_for( lock, std::chrono::milliseconds( 1 ) );
+  }
+
+  ++m_pushed;
+  if ( m_sleeping )
+  {
+    std::lock_guard< std::mutex > lock( m_wait_lock );
+    m_wake.notify_one();
+  }
+
+  // The writer takes records in ring order, so this one is out once that
+  // many records have been written
+  return pos + 1;
+}
+
+// ----------------------------------------------------------------------------
+void
+async_log_writer
+::flush()
+{
+  // Count slots claimed rather than m_pushed, which lags behind the ring
+  flush( m_enqueue_pos.load() );
+}
+
+// ----------------------------------------------------------------------------
+void
+async_log_writer
+::flush( uint64_t ticket )
+{
+  std::unique_lock< std::mutex > lock( m_wait_lock );
+  m_progress.wait( lock, [this, ticket] { return m_written >= ticket; } );
+}
+
+// ----------------------------------------------------------------------------
+void
+async_log_writer
+::write( std::ostream& stream, record const& rec )
+{
+  using namespace std::chrono;
+
+  std::time_t const t = clock_t::to_time_t( rec.time );
+  auto const ms =
+    duration_cast< milliseconds >( rec.time.time_since_epoch() ).count() % 1000;
+
+  char buf[64];
+  strftime( buf, sizeof( buf ), "%Y-%m-%d %H:%M:%S", localtime( &t ) );
+
+  // Ensure that multi-line messages still get the time and level prefix
+  char const* const level_str = kwiver_logger::get_level_string( rec.level );
+  std::istringstream ss( rec.message );
+  std::string msg_part;
+  while ( getline( ss, msg_part ) )
+  {
+    stream << buf
+           << '.' << std::setfill( '0' ) << std::setw( 3 ) << ms
+           << ' ' << level_str << ' ' << rec.location << msg_part << '\n';
+  }
+}
+
+// ----------------------------------------------------------------------------
+bool
+async_log_writer
+::try_push( record& rec, size_t& pos )
+{
+  pos = m_enqueue_pos.load( std::memory_order_relaxed );
+  cell* c;
+  for (;;)
+  {
+    c = &m_cells[ pos & m_mask ];
+    size_t const seq = c->sequence.load( std::memory_order_acquire );
+    auto const diff =
+      static_cast< std::ptrdiff_t >( seq ) - static_cast< std::ptrdiff_t >( pos );
+    if ( diff == 0 )
+    {
+      if ( m_enqueue_pos.compare_exchange_weak(
+             pos, pos + 1, std::memory_order_relaxed ) )
+      {
+        break;
+      }
+    }
+    else if ( diff < 0 )
+    {
+      return false; // full
+    }
+    else
+    {
+      pos = m_enqueue_pos.load( std::memory_order_relaxed );
+    }
+  }
+
+  c->data = std::move( rec );
+  c->sequence.store( pos + 1, std::memory_order_release );
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+bool
+async_log_writer
+::try_pop( record& rec )
+{
+  // There is only one consumer, so no need to compete for the position
+  size_t const pos = m_dequeue_pos.load( std::memory_order_relaxed );
+  cell& c = m_cells[ pos & m_mask ];
+  if ( c.sequence.load( std::memory_order_acquire ) != pos + 1 )
+  {
+    return false; // empty, or the producer has not finished the slot
+  }
+
+  rec = std::move( c.data );
+  m_dequeue_pos.store( pos + 1, std::memory_order_relaxed );
+  c.sequence.store( pos + m_mask + 1, std::memory_order_release );
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+async_log_writer
+::run()
+{
+  record rec;
+  for (;;)
+  {
+    uint64_t count = 0;
+    if ( try_pop( rec ) )
+    {
+      std::lock_guard< std::mutex > lock( m_stream_lock );
+      do
+      {
+        write( m_stream, rec );
+        ++count;
+      }
+      while ( count < max_batch && try_pop( rec ) );
+      m_stream.flush();
+    }
+
+    if ( count )
+    {
+      m_written += count;
+      std::lock_guard< std::mutex > lock( m_wait_lock );
+      m_progress.notify_all();
+      continue;
+    }
+
+    // Ring is empty; sleep until a push or the destructor wakes us
+    std::unique_lock< std::mutex > lock( m_wait_lock );
+    if ( m_stop )
+    {
+      return;
+    }
+
+    m_sleeping = true;
+    m_wake.wait( lock, [this] { return m_stop || m_written < m_pushed; } );
+    m_sleeping = false;
+  }
+}
+
+} } } // end namespace
@@ -0,0 +1,115 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#ifndef KWIVER_ASYNC_LOG_WRITER_H_
+#define KWIVER_ASYNC_LOG_WRITER_H_
+
+#include <vital/logger/vital_logger_export.h>
+#include "kwiver_logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+namespace kwiver {
+namespace vital {
+namespace logger_ns {
+
+// ----------------------------------------------------------------------------
+/// @brief Background writer for log messages.
+///
+/// Log calls push a record (level, time of the call, location and message
+/// text) into a fixed size lock-free ring, and a single background thread
+/// formats the records and writes them to the stream. A push takes no
+/// lock unless the writer thread is asleep and has to be woken.
+///
+/// When the ring is full the caller waits for the writer to catch up,
+/// so messages are never dropped and keep their order.
+class VITAL_LOGGER_EXPORT async_log_writer
+{
+public:
+  typedef std::chrono::system_clock clock_t;
+
+  /// One log message.
+  struct record
+  {
+    kwiver_logger::log_level_t level;
+    clock_t::time_point time;
+    std::string location;
+    std::string message;
+  };
+
+  /// @brief Create writer and start its thread.
+  ///
+  /// @param stream Stream to write to. Access to it is serialized with
+  ///   @p stream_lock, which synchronous writers of the same stream
+  ///   should also hold.
+  /// @param stream_lock Mutex guarding @p stream.
+  /// @param capacity Number of records the ring holds; rounded up to a
+  ///   power of two.
+  async_log_writer( std::ostream& stream, std::mutex& stream_lock,
+                    size_t capacity = 8192 );
+
+  /// Write out all queued records and stop the thread.
+  ~async_log_writer();
+
+  /// @brief Queue a record for writing.
+  ///
+  /// @return Ticket to pass to flush() to wait for this record.
+  uint64_t push( record&& rec );
+
+  /// Wait until every record pushed so far has been written.
+  void flush();
+
+  /// Wait until the record with @p ticket, and every record pushed before
+  /// it, has been written.
+  void flush( uint64_t ticket );
+
+  /// @brief Format a record to a stream.
+  ///
+  /// Each line of a multi-line message gets its own time and level
+  /// prefix. The caller must hold the stream lock.
+  static void write( std::ostream& stream, record const& rec );
+
+private:
+  struct cell;
+
+  bool try_push( record& rec, size_t& pos );
+  bool try_pop( record& rec );
+  void run();
+
+  std::ostream& m_stream;
+  std::mutex& m_stream_lock;
+
+  std::unique_ptr< cell[] > m_cells;
+  size_t const m_mask;
+
+  // ring positions
+  std::atomic< size_t > m_enqueue_pos;
+  std::atomic< size_t > m_dequeue_pos;
+
+  // records pushed, for waking the writer, and written, in ring order, for
+  // flush()
+  std::atomic< uint64_t > m_pushed;
+  std::atomic< uint64_t > m_written;
+
+  // the writer sleeps here when the ring is empty
+  std::mutex m_wait_lock;
+  std::condition_variable m_wake;
+  std::condition_variable m_progress;
+  std::atomic< bool > m_sleeping;
+  std::atomic< bool > m_stop;
+
+  std::thread m_thread;
+};
+
+} } } // end namespace
+
+#endif
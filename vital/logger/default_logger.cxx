@@ -4,13 +4,14 @@
 
 #include <vital/logger/vital_logger_export.h>
 #include "default_logger.h"
+#include "async_log_writer.h"
 #include "kwiver_logger.h"
 #include <kwiversys/SystemTools.hxx>
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <chrono>
-#include <iomanip>
 #include <iostream>
 #include <string.h>
 #include <algorithm>
@@ -179,41 +180,24 @@ class default_logger :
                        std::string const&  msg,
                        std::string const& location )
   {
-    static std::mutex lock;
-
-    using namespace std::chrono;
-
-    // Format this message on the stream
-
-    // Get the current time in milliseconds, creating a formatted
-    // string for log message.
-    high_resolution_clock::time_point p = high_resolution_clock::now();
-
-    milliseconds ms = duration_cast<milliseconds>(p.time_since_epoch());
-
-    seconds s = duration_cast<seconds>(ms);
-    std::time_t t = s.count();
-    std::size_t fractional_seconds = ms.count() % 1000;
-
-    // Ensure that multi-line messages still get the time and level prefix
-    std::string  const level_str = get_level_string( level );
-    std::string msg_part;
-    std::istringstream ss( msg );
-
-    char buf[1024];
-    time(&t);
-    strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime(&t));
+    // Take the time now, not when the message gets written
+    async_log_writer::record rec{ level, async_log_writer::clock_t::now(),
+                                  location, msg };
 
+    if ( async_log_writer* writer = get_async_writer() )
     {
-      std::lock_guard< std::mutex > guard( lock ); // serialize access to stream
-      std::ostream* str = &get_stream();
-      while ( getline( ss, msg_part ) )
+      auto const ticket = writer->push( std::move( rec ) );
+
+      // Make sure errors are out before the program can act on them
+      if ( level >= LEVEL_ERROR )
       {
-        *str << buf
-             << '.' << std::setfill('0') << std::setw(3) << fractional_seconds
-             << ' ' << level_str << ' ' << location << msg_part << '\n';
+        writer->flush( ticket );
       }
+      return;
     }
+
+    std::lock_guard< std::mutex > guard( stream_lock() ); // serialize access to stream
+    async_log_writer::write( get_stream(), rec );
   }
 
   // --------------------------------------------------------------------------
@@ -230,11 +214,57 @@ class default_logger :
   }
 
   // --------------------------------------------------------------------------
-  std::ostream& get_stream()
+  static std::ostream& get_stream()
   {
     return *s_output_stream;
   }
 
+  // --------------------------------------------------------------------------
+  static std::mutex& stream_lock()
+  {
+    static std::mutex lock;
+    return lock;
+  }
+
+  // --------------------------------------------------------------------------
+  // The background writer shared by all default loggers, or null if
+  // output is synchronous. Set KWIVER_DEFAULT_LOG_ASYNC to turn it on.
+  static async_log_writer* get_async_writer()
+  {
+    struct holder
+    {
+      holder()
+      {
+        std::string async;
+        if ( kwiversys::SystemTools::GetEnv( "KWIVER_DEFAULT_LOG_ASYNC", async ) )
+        {
+          std::transform( async.begin(), async.end(), async.begin(), ::tolower );
+          if ( "1" == async || "on" == async || "yes" == async || "true" == async )
+          {
+            writer.reset( new async_log_writer( get_stream(), stream_lock() ) );
+          }
+        }
+      }
+
+      // Messages logged from here on are written directly, while the
+      // writer drains the ring as it is destroyed
+      ~holder()
+      {
+        s_async_closed = true;
+      }
+
+      std::unique_ptr< async_log_writer > writer;
+    };
+
+    if ( s_async_closed )
+    {
+      return nullptr;
+    }
+
+    static holder instance;
+    return instance.writer.get();
+  }
+
   // ##################################################################
   log_level_t                  m_logLevel;       // current logging level
 
@@ -242,11 +272,14 @@ class default_logger :
 
   static std::ostream*         s_output_stream;
 
+  static std::atomic< bool >   s_async_closed;
+
 }; // end class logger
 
 // -- STATIC data --
 // Set up default logging stream
 std::ostream* default_logger::s_output_stream = &std::cerr;
+std::atomic< bool > default_logger::s_async_closed( false );
 
 // ----------------------------------------------------------------------------
 logger_handle_t
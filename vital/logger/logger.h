@@ -96,6 +96,27 @@
 ///
 /// <P>Other underlying loggers may have different configuration procedures.</P>
 ///
+/// <h3>Default logger</H3>
+///
+/// <P>The default logger writes to standard error in the calling thread.
+/// If the environment variable \b KWIVER_DEFAULT_LOG_ASYNC is set to a
+/// true value (1, on, yes, true), messages are instead put in a
+/// lock-free ring and written by a background thread, so a log call
+/// costs the caller little more than formatting the message. Messages at
+/// ERROR level and above wait until everything logged before them has
+/// been written, so they are not lost if the program then stops.
+/// Everything still queued at exit is written out.</P>
+///
+/// <h2>Compile-time level</h2>
+///
+/// <P>Defining \b KWIVER_LOG_COMPILE_LEVEL to one of the
+/// kwiver_logger::log_level_t values, e.g. with
+/// <code>-DKWIVER_LOG_COMPILE_LEVEL=kwiver::vital::kwiver_logger::LEVEL_INFO</code>,
+/// removes the LOG_ macros below that level from the code entirely;
+/// neither the level test nor the message formatting is left in the
+/// compiled code. This is meant for per-frame code paths in release
+/// builds. The default keeps every level.</P>
+///
 /// <h2>Example</h2>
 ///
 /// \code
@@ -136,11 +157,23 @@ logger_handle_t VITAL_LOGGER_EXPORT get_logger( const char * const name );
 logger_handle_t VITAL_LOGGER_EXPORT get_logger( std::string const& name );
 //@}
 
+// Lowest level compiled into the LOG_ macros; see the Logger page
+#ifndef KWIVER_LOG_COMPILE_LEVEL
+#define KWIVER_LOG_COMPILE_LEVEL ::kwiver::vital::kwiver_logger::LEVEL_TRACE
+#endif
+
+// True if messages at level \p lev are compiled in. This is a constant
+// expression, so the compiler drops the whole macro body when false.
+#define KWIVER_LOG_LEVEL_COMPILED( lev )                 \
+  ( ::kwiver::vital::kwiver_logger::LEVEL_ ## lev >=    \
+    ( KWIVER_LOG_COMPILE_LEVEL ) )
+
 /// Logs a message with the ERROR level.
 /// @param logger the logger to be used
 /// @param msg the message string to log.
 #define LOG_ERROR( logger, msg ) do {                        \
-    if ( logger->is_error_enabled() ) {                      \
+    if ( KWIVER_LOG_LEVEL_COMPILED( ERROR ) &&               \
+         logger->is_error_enabled() ) {                      \
       std::stringstream _oss_; _oss_ << msg;                 \
       logger->log_error( _oss_.str(), KWIVER_LOGGER_SITE ); } \
 } while ( 0 )
@@ -149,7 +182,8 @@ logger_handle_t VITAL_LOGGER_EXPORT get_logger( std::string const& name );
 /// @param logger the logger to be used
 /// @param msg the message string to log.
 #define LOG_WARN( logger, msg ) do {                        \
-    if ( logger->is_warn_enabled() ) {                      \
+    if ( KWIVER_LOG_LEVEL_COMPILED( WARN ) &&                \
+         logger->is_warn_enabled() ) {                      \
       std::stringstream _oss_; _oss_ << msg;                \
       logger->log_warn( _oss_.str(), KWIVER_LOGGER_SITE ); } \
 } while ( 0 )
@@ -158,7 +192,8 @@ logger_handle_t VITAL_LOGGER_EXPORT get_logger( std::string const& name );
 /// @param logger the logger to be used
 /// @param msg the message string to log.
 #define LOG_INFO( logger, msg ) do {                        \
-    if ( logger->is_info_enabled() ) {                      \
+    if ( KWIVER_LOG_LEVEL_COMPILED( INFO ) &&                \
+         logger->is_info_enabled() ) {                      \
       std::stringstream _oss_; _oss_ << msg;                \
       logger->log_info( _oss_.str(), KWIVER_LOGGER_SITE ); } \
 } while ( 0 )
@@ -167,7 +202,8 @@ logger_handle_t VITAL_LOGGER_EXPORT get_logger( std::string const& name );
 /// @param logger the logger to be used
 /// @param msg the message string to log.
 #define LOG_DEBUG( logger, msg ) do {                        \
-    if ( logger->is_debug_enabled() ) {                      \
+    if ( KWIVER_LOG_LEVEL_COMPILED( DEBUG ) &&               \
+         logger->is_debug_enabled() ) {                      \
       std::stringstream _oss_; _oss_ << msg;                 \
       logger->log_debug( _oss_.str(), KWIVER_LOGGER_SITE ); } \
 } while ( 0 )
@@ -176,7 +212,8 @@ logger_handle_t VITAL_LOGGER_EXPORT get_logger( std::string const& name );
 /// @param logger the logger to be used
 /// @param msg the message string to log.
 #define LOG_TRACE( logger, msg ) do {                        \
-    if ( logger->is_trace_enabled() ) {                      \
+    if ( KWIVER_LOG_LEVEL_COMPILED( TRACE ) &&               \
+         logger->is_trace_enabled() ) {                      \
       std::stringstream _oss_; _oss_ << msg;                 \
       logger->log_trace( _oss_.str(), KWIVER_LOGGER_SITE ); } \
 } while ( 0 )
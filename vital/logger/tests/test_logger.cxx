@@ -3,12 +3,18 @@
 // https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
 
 #include <vital/logger/logger.h>
+#include <vital/logger/async_log_writer.h>
 
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <cstdlib>
 #include <functional>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 using namespace kwiver::vital;
 
@@ -94,6 +100,135 @@ TEST(logger, output)
   LOG_ASSERT( log2, false, "This should generate an ERROR message." );
 }
 
+// ----------------------------------------------------------------------------
+TEST(logger, async_writer)
+{
+  std::stringstream out;
+  std::mutex out_lock;
+
+  {
+    // Small ring so the producers also have to wait for room
+    logger_ns::async_log_writer writer( out, out_lock, 16 );
+
+    std::vector< std::thread > threads;
+    for ( int t = 0; t < 4; ++t )
+    {
+      threads.emplace_back( [&writer, t] {
+        for ( int i = 0; i < 500; ++i )
+        {
+          std::stringstream msg;
+          msg << "thread " << t << " message " << i;
+          writer.push( { kwiver_logger::LEVEL_INFO,
+                         logger_ns::async_log_writer::clock_t::now(),
+                         "", msg.str() } );
+        }
+      } );
+    }
+    for ( auto& thread : threads )
+    {
+      thread.join();
+    }
+
+    writer.push( { kwiver_logger::LEVEL_ERROR,
+                   logger_ns::async_log_writer::clock_t::now(),
+                   "file.cxx(12): ", "first line\nsecond line" } );
+    writer.flush();
+
+    std::lock_guard< std::mutex > lock( out_lock );
+    std::string const text = out.str();
+    EXPECT_EQ( 2002, std::count( text.begin(), text.end(), '\n' ) );
+    EXPECT_NE( std::string::npos,
+               text.find( " ERROR file.cxx(12): second line\n" ) );
+  }
+
+  // Each thread's messages come out in the order they were logged
+  std::vector< int > next( 4, 0 );
+  std::string line;
+  while ( std::getline( out, line ) )
+  {
+    int t, i;
+    auto const pos = line.find( "thread " );
+    if ( pos != std::string::npos &&
+         std::sscanf( line.c_str() + pos, "thread %d message %d", &t, &i ) == 2 )
+    {
+      EXPECT_EQ( next[ t ]++, i );
+    }
+  }
+  EXPECT_EQ( std::vector< int >( 4, 500 ), next );
+}
+
+// ----------------------------------------------------------------------------
+TEST(logger, async_writer_flush_ticket)
+{
+  std::stringstream out;
+  std::mutex out_lock;
+  logger_ns::async_log_writer writer( out, out_lock, 16 );
+
+  // Each thread's own record is out once its flush returns, however the
+  // pushes of the other threads interleave with it
+  std::atomic< int > missing( 0 );
+  std::vector< std::thread > threads;
+  for ( int t = 0; t < 4; ++t )
+  {
+    threads.emplace_back( [&, t] {
+      for ( int i = 0; i < 200; ++i )
+      {
+        std::stringstream msg;
+        msg << "thread " << t << " message " << i << '\n';
+        auto const ticket =
+          writer.push( { kwiver_logger::LEVEL_ERROR,
+                         logger_ns::async_log_writer::clock_t::now(),
+                         "", msg.str() } );
+        writer.flush( ticket );
+
+        std::lock_guard< std::mutex > lock( out_lock );
+        if ( out.str().find( msg.str() ) == std::string::npos )
+        {
+          ++missing;
+        }
+      }
+    } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ( 0, missing );
+}
+
+// ----------------------------------------------------------------------------
+namespace {
+
+int formatted = 0;
+
+int count_format()
+{
+  return ++formatted;
+}
+
+} // end namespace
+
+#undef KWIVER_LOG_COMPILE_LEVEL
+#define KWIVER_LOG_COMPILE_LEVEL kwiver_logger::LEVEL_INFO
+
+TEST(logger, compile_level)
+{
+  logger_handle_t log2 = get_logger( "main.logger2" );
+  log2->set_level( kwiver_logger::LEVEL_TRACE );
+
+  formatted = 0;
+  LOG_TRACE( log2, "stripped " << count_format() );
+  LOG_DEBUG( log2, "stripped " << count_format() );
+  EXPECT_EQ( 0, formatted );
+
+  LOG_INFO( log2, "kept " << count_format() );
+  EXPECT_EQ( 1, formatted );
+
+  // Run-time checks are unaffected
+  EXPECT_TRUE( IS_DEBUG_ENABLED( log2 ) );
+}
+
 //
 // Need to test
 //
@@ -15,6 +15,9 @@
 #include <kwiversys/DynamicLoader.hxx>
 #include <kwiversys/SystemTools.hxx>
 
+#include <cstdio>
+#include <fstream>
+#include <set>
 #include <sstream>
 
 namespace kwiver {
@@ -27,6 +30,18 @@ using DL =  kwiversys::DynamicLoader;
 using library_t =  DL::LibraryHandle;
 using function_t = DL::SymbolPointer;
 
+static char const* manifest_header( "# kwiver plugin manifest v2" );
+
+// ----------------------------------------------------------------------------
+/// @brief What the manifest records about one plugin file.
+struct manifest_entry
+{
+  long mtime;
+  unsigned long size;
+  // interface types it registers, with the plugin names under each
+  std::map< std::string, std::set< std::string > > interfaces;
+};
+
 } // end anon namespace
 
 // ----------------------------------------------------------------------------
@@ -48,8 +63,16 @@ class plugin_loader_impl
 
   void load_known_modules();
   void look_in_directory( std::string const& directory);
+  void consider_module( std::string const& path);
   void load_from_module( std::string const& path);
 
+  void load_deferred( std::string const& interface_type );
+  void load_deferred( std::string const& interface_type,
+                      std::string const& plugin_name );
+  void load_all_deferred();
+  void read_manifest();
+  void write_manifest();
+
   void print( std::ostream& str ) const;
 
   plugin_loader* m_parent;
@@ -78,6 +101,26 @@ class plugin_loader_impl
 
   std::vector< plugin_filter_handle_t > m_filters;
 
+  // Manifest cache; disabled if the file name is empty
+  std::string m_manifest_file;
+  std::map< std::string, manifest_entry > m_manifest;
+  bool m_manifest_read { false };
+  bool m_manifest_dirty { false };
+
+  // Set while a module registers its factories
+  bool m_registering { false };
+
+  // Factories registered by the file being scanned, if it is tracked
+  bool m_tracking { false };
+  plugin_factory_vector_t m_current_factories;
+
+  // Files found through the manifest but not yet loaded, by file and
+  // by the interface types they provide
+  std::set< std::string > m_deferred;
+  std::map< std::string, std::set< std::string > > m_deferred_by_interface;
+  std::map< std::pair< std::string, std::string >,
+            std::set< std::string > > m_deferred_by_name;
+
 }; // end class plugin_loader_impl
 
 // ----------------------------------------------------------------------------
@@ -99,6 +142,27 @@ ::get_factories( std::string const& type_name ) const
 {
   static plugin_factory_vector_t empty; // needed for error case
 
+  m_impl->load_deferred( type_name );
+
+  auto const it = m_impl->m_plugin_map.find(type_name);
+  if ( it == m_impl->m_plugin_map.end() )
+  {
+    return empty;
+  }
+
+  return it->second;
+}
+
+// ----------------------------------------------------------------------------
+plugin_factory_vector_t const&
+plugin_loader
+::get_factories( std::string const& type_name,
+                 std::string const& plugin_name ) const
+{
+  static plugin_factory_vector_t empty; // needed for error case
+
+  m_impl->load_deferred( type_name, plugin_name );
+
   auto const it = m_impl->m_plugin_map.find(type_name);
   if ( it == m_impl->m_plugin_map.end() )
   {
@@ -141,6 +205,13 @@ ::add_factory( plugin_factory* fact )
   // Add factory to rest of its family
   m_impl->m_plugin_map[interface_type].push_back( fact_handle );
 
+  // Names are often attached after this call returns, so the manifest
+  // entry is filled in once the whole file has registered.
+  if ( m_impl->m_tracking )
+  {
+    m_impl->m_current_factories.push_back( fact_handle );
+  }
+
   LOG_TRACE( m_logger,
              "Adding plugin to create interface: \"" << demangle( interface_type )
              << "\" from derived type: \"" << demangle( concrete_type )
@@ -154,6 +225,7 @@ plugin_map_t const&
 plugin_loader
 ::get_plugin_map() const
 {
+  m_impl->load_all_deferred();
   return m_impl->m_plugin_map;
 }
 
@@ -183,6 +255,7 @@ ::get_file_list() const
 {
   std::vector< std::string > retval;
 
+  m_impl->load_all_deferred();
   for( auto const& it : m_impl->m_library_map )
   {
     retval.push_back( it.first );
@@ -212,6 +285,7 @@ plugin_module_map_t const&
 plugin_loader
 ::get_module_map() const
 {
+  m_impl->load_all_deferred();
   return m_impl->m_module_map;
 }
 
@@ -221,6 +295,7 @@ plugin_loader
 ::load_plugins()
 {
   m_impl->load_known_modules();
+  m_impl->write_manifest();
 }
 
 // ----------------------------------------------------------------------------
@@ -233,6 +308,8 @@ ::load_plugins( path_list_t const& dirpath )
   {
     m_impl->look_in_directory( module_dir );
   }
+
+  m_impl->write_manifest();
 }
 
 // ----------------------------------------------------------------------------
@@ -303,7 +380,7 @@ ::look_in_directory( path_t const& dir_path )
       // Check that we're looking a file
       if ( ! ST::FileIsDirectory( file ) )
       {
-        load_from_module( file );
+        consider_module( file );
       }
       else
       {
@@ -314,6 +391,317 @@ ::look_in_directory( path_t const& dir_path )
   } // end for
 } // plugin_loader_impl::look_in_directory
 
+// ----------------------------------------------------------------------------
+/// \brief Load or defer a module found while scanning a directory.
+///
+/// A module whose time and size match its manifest entry is deferred
+/// until one of the interface types it registers is asked for; any
+/// other module is loaded now and its manifest entry brought up to date.
+///
+/// @param path Name of module to consider.
+void
+plugin_loader_impl
+::consider_module( path_t const& path )
+{
+  if ( m_manifest_file.empty() )
+  {
+    load_from_module( path );
+    return;
+  }
+
+  read_manifest();
+
+  // Already loaded or deferred through another search path entry
+  if ( m_library_map.count( path ) || m_deferred.count( path ) )
+  {
+    return;
+  }
+
+  long const mtime = ST::ModifiedTime( path );
+  unsigned long const size = ST::FileLength( path );
+
+  auto const it = m_manifest.find( path );
+  if ( it != m_manifest.end() &&
+       it->second.mtime == mtime && it->second.size == size )
+  {
+    LOG_DEBUG( m_parent->m_logger, "Deferring load of plugins from: " << path );
+
+    m_deferred.insert( path );
+    for ( auto const& iface : it->second.interfaces )
+    {
+      m_deferred_by_interface[iface.first].insert( path );
+      for ( auto const& name : iface.second )
+      {
+        m_deferred_by_name[{ iface.first, name }].insert( path );
+      }
+    }
+    return;
+  }
+
+  manifest_entry entry;
+  entry.mtime = mtime;
+  entry.size = size;
+
+  m_tracking = true;
+  try
+  {
+    load_from_module( path );
+  }
+  catch ( ... )
+  {
+    m_tracking = false;
+    m_current_factories.clear();
+    throw;
+  }
+  m_tracking = false;
+
+  for ( auto const& fact : m_current_factories )
+  {
+    std::string interface_type;
+    fact->get_attribute( plugin_factory::INTERFACE_TYPE, interface_type );
+    auto& names = entry.interfaces[interface_type];
+
+    std::string name;
+    if ( fact->get_attribute( plugin_factory::PLUGIN_NAME, name ) )
+    {
+      names.insert( name );
+    }
+  }
+  m_current_factories.clear();
+
+  // Only remember modules that could be opened; the rest are retried
+  // on the next scan.
+  if ( m_library_map.count( path ) )
+  {
+    m_manifest[path] = entry;
+  }
+  else
+  {
+    m_manifest.erase( path );
+  }
+  m_manifest_dirty = true;
+}
+
+// ----------------------------------------------------------------------------
+/// \brief Load the deferred modules that provide an interface type.
+void
+plugin_loader_impl
+::load_deferred( std::string const& interface_type )
+{
+  if ( m_registering )
+  {
+    return;
+  }
+
+  auto const it = m_deferred_by_interface.find( interface_type );
+  if ( it == m_deferred_by_interface.end() )
+  {
+    return;
+  }
+
+  std::set< std::string > const files = it->second;
+  m_deferred_by_interface.erase( it );
+
+  for ( auto const& f : files )
+  {
+    // A module providing several interfaces is only loaded once
+    if ( m_deferred.erase( f ) )
+    {
+      load_from_module( f );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+/// \brief Load the deferred modules that provide one implementation.
+///
+/// If the manifest does not list the plugin name, every deferred
+/// module providing the interface type is loaded, so a plugin that
+/// registers its name some other way is still found.
+void
+plugin_loader_impl
+::load_deferred( std::string const& interface_type,
+                 std::string const& plugin_name )
+{
+  if ( m_registering || m_deferred.empty() )
+  {
+    return;
+  }
+
+  auto const it = m_deferred_by_name.find( { interface_type, plugin_name } );
+  if ( it == m_deferred_by_name.end() )
+  {
+    load_deferred( interface_type );
+    return;
+  }
+
+  // The entry is kept, so asking again does not fall back on loading
+  // the whole interface.
+  for ( auto const& f : it->second )
+  {
+    if ( m_deferred.erase( f ) )
+    {
+      load_from_module( f );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+/// \brief Load all deferred modules.
+void
+plugin_loader_impl
+::load_all_deferred()
+{
+  if ( m_registering )
+  {
+    return;
+  }
+
+  m_deferred_by_interface.clear();
+  m_deferred_by_name.clear();
+
+  std::set< std::string > pending;
+  pending.swap( m_deferred );
+  for ( auto const& f : pending )
+  {
+    load_from_module( f );
+  }
+}
+
+// ----------------------------------------------------------------------------
+/// \brief Read the manifest file, once.
+///
+/// A missing file is an empty manifest; an unreadable one is ignored,
+/// which only costs loading everything this time.
+void
+plugin_loader_impl
+::read_manifest()
+{
+  if ( m_manifest_read )
+  {
+    return;
+  }
+  m_manifest_read = true;
+
+  std::ifstream ifs( m_manifest_file );
+  if ( ! ifs )
+  {
+    return;
+  }
+
+  std::string line;
+  if ( ! std::getline( ifs, line ) || line != manifest_header )
+  {
+    LOG_WARN( m_parent->m_logger, "Ignoring plugin manifest \"" << m_manifest_file
+              << "\" with unexpected header" );
+    m_manifest_dirty = true;
+    return;
+  }
+
+  manifest_entry* current( nullptr );
+  std::set< std::string >* names( nullptr );
+  while ( std::getline( ifs, line ) )
+  {
+    std::istringstream iss( line );
+    std::string keyword;
+    iss >> keyword;
+
+    if ( keyword == "module" )
+    {
+      manifest_entry entry;
+      std::string path;
+      if ( ( iss >> entry.mtime >> entry.size ) &&
+           std::getline( iss >> std::ws, path ) && ! path.empty() )
+      {
+        current = &( m_manifest[path] = entry );
+        names = nullptr;
+        continue;
+      }
+    }
+    else if ( keyword == "interface" && current )
+    {
+      std::string iface;
+      if ( std::getline( iss >> std::ws, iface ) && ! iface.empty() )
+      {
+        names = &current->interfaces[iface];
+        continue;
+      }
+    }
+    else if ( keyword == "name" && names )
+    {
+      std::string name;
+      if ( std::getline( iss >> std::ws, name ) && ! name.empty() )
+      {
+        names->insert( name );
+        continue;
+      }
+    }
+
+    LOG_WARN( m_parent->m_logger, "Ignoring plugin manifest \"" << m_manifest_file
+              << "\" with malformed line: " << line );
+    m_manifest.clear();
+    m_manifest_dirty = true;
+    return;
+  }
+}
+
+// ----------------------------------------------------------------------------
+/// \brief Write the manifest file if it has changed.
+///
+/// The manifest is written to a temporary file and renamed over the
+/// old one, so concurrent processes never read a partial manifest.
+void
+plugin_loader_impl
+::write_manifest()
+{
+  if ( m_manifest_file.empty() || ! m_manifest_dirty )
+  {
+    return;
+  }
+
+  std::string const tmp_file = m_manifest_file + ".tmp";
+  {
+    std::ofstream ofs( tmp_file );
+    ofs << manifest_header << "\n";
+    for ( auto const& it : m_manifest )
+    {
+      if ( ! ST::FileExists( it.first ) )
+      {
+        continue;
+      }
+
+      ofs << "module " << it.second.mtime << " " << it.second.size
+          << " " << it.first << "\n";
+      for ( auto const& iface : it.second.interfaces )
+      {
+        ofs << "interface " << iface.first << "\n";
+        for ( auto const& name : iface.second )
+        {
+          ofs << "name " << name << "\n";
+        }
+      }
+    }
+
+    if ( ! ofs )
+    {
+      LOG_WARN( m_parent->m_logger, "Unable to write plugin manifest \""
+                << tmp_file << "\"" );
+      ST::RemoveFile( tmp_file );
+      return;
+    }
+  }
+
+  if ( std::rename( tmp_file.c_str(), m_manifest_file.c_str() ) != 0 )
+  {
+    LOG_WARN( m_parent->m_logger, "Unable to replace plugin manifest \""
+              << m_manifest_file << "\"" );
+    ST::RemoveFile( tmp_file );
+    return;
+  }
+
+  m_manifest_dirty = false;
+}
+
 // ----------------------------------------------------------------------------
 /// \brief Load single module from shared object / DLL
 ///
@@ -372,7 +760,20 @@ ::load_from_module( path_t const& path )
 
   reg_fp_t reg_fp = reinterpret_cast< reg_fp_t > ( fp );
 
-  ( *reg_fp )( m_parent ); // register plugins
+  // Filters look at the plugin map while factories are added; they
+  // must see only what is loaded so far, as with an eager load, rather
+  // than pull in every deferred module.
+  m_registering = true;
+  try
+  {
+    ( *reg_fp )( m_parent ); // register plugins
+  }
+  catch ( ... )
+  {
+    m_registering = false;
+    throw;
+  }
+  m_registering = false;
 }
 
 // ----------------------------------------------------------------------------
@@ -390,4 +791,23 @@ ::add_filter( plugin_filter_handle_t f )
   m_impl->m_filters.push_back( f );
 }
 
+// ----------------------------------------------------------------------------
+void plugin_loader
+::set_manifest_file( path_t const& file )
+{
+  m_impl->m_manifest_file = file;
+  m_impl->m_manifest.clear();
+  m_impl->m_manifest_read = false;
+  m_impl->m_manifest_dirty = false;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< std::string >
+plugin_loader
+::get_deferred_file_list() const
+{
+  return std::vector< std::string >( m_impl->m_deferred.begin(),
+                                     m_impl->m_deferred.end() );
+}
+
 } } // end namespace
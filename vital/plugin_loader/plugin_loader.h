@@ -110,6 +110,21 @@ class VITAL_VPM_EXPORT plugin_loader
   /// @return Vector of factories. (vector may be empty)
   plugin_factory_vector_t const& get_factories( std::string const& type_name ) const;
 
+  /// @brief Get list of factories for one implementation.
+  ///
+  /// This method returns the same list as get_factories( type_name ),
+  /// except that of the plugin files deferred through the manifest
+  /// (see set_manifest_file()), only those providing \a plugin_name
+  /// are loaded. The list is therefore only guaranteed to contain the
+  /// factory whose plugin name is \a plugin_name, if there is one.
+  ///
+  /// @param type_name Type name of the interface required
+  /// @param plugin_name Plugin name of the implementation required
+  ///
+  /// @return Vector of factories. (vector may be empty)
+  plugin_factory_vector_t const& get_factories( std::string const& type_name,
+                                                std::string const& plugin_name ) const;
+
   /// @brief Add factory to manager.
   ///
   /// This method adds the specified plugin factory to the plugin
@@ -183,6 +198,36 @@ class VITAL_VPM_EXPORT plugin_loader
   void clear_filters();
   void add_filter( plugin_filter_handle_t f );
 
+  /// @brief Cache plugin registrations in a manifest file.
+  ///
+  /// With a manifest, load_plugins() records the interface types each
+  /// plugin file registers factories for, along with the file's
+  /// modification time and size. On later runs a plugin file whose
+  /// time and size still match its manifest entry is not opened when
+  /// its directory is scanned. Instead it is opened the first time
+  /// factories for one of its interface types are requested, or when
+  /// the full plugin or module map or file list is requested. New or
+  /// changed files are opened during the scan as before, and the
+  /// manifest is rewritten to match them. The plugin names registered
+  /// under each interface type are recorded too, so the two argument
+  /// get_factories() can open only the file providing one plugin.
+  ///
+  /// is_module_loaded() only reports the modules opened so far.
+  ///
+  /// An empty name (the default) disables the manifest. Set it before
+  /// calling load_plugins().
+  ///
+  /// @param file Name of the manifest file; created if absent.
+  void set_manifest_file( path_t const& file );
+
+  /// @brief Get list of files not yet loaded.
+  ///
+  /// This method returns the list of plugin files which were found
+  /// through the manifest and have not been loaded yet.
+  ///
+  /// @return List of file names.
+  std::vector< std::string > get_deferred_file_list() const;
+
 protected:
   friend class plugin_loader_impl;
 
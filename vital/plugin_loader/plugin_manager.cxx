@@ -24,6 +24,7 @@ namespace { // anonymous
 typedef kwiversys::SystemTools ST;
 
 static char const* environment_variable_name( "KWIVER_PLUGIN_PATH" );
+static char const* manifest_variable_name( "KWIVER_PLUGIN_MANIFEST" );
 static std::string const register_function_name = std::string( "register_factories" );
 
 // Default module directory locations. Values defined in CMake configuration.
@@ -54,6 +55,7 @@ class plugin_manager::priv
   kwiver::vital::logger_handle_t m_logger;
 
   path_list_t m_search_paths;
+  std::string m_manifest_file;
 };
 
 // ----------------------------------------------------------------------------
@@ -102,6 +104,10 @@ plugin_manager()
 
   // Add paths to the real loader
   m_priv->m_loader->add_search_path( m_priv->m_search_paths );
+
+  // Cache plugin registrations if a manifest is named
+  ST::GetEnv( manifest_variable_name, m_priv->m_manifest_file );
+  m_priv->m_loader->set_manifest_file( m_priv->m_manifest_file );
 }
 
 plugin_manager
@@ -242,6 +248,13 @@ get_factories( std::string const& type_name )
   return m_priv->m_loader->get_factories( type_name );
 }
 
+// ----------------------------------------------------------------------------
+plugin_factory_vector_t const& plugin_manager::
+get_factories( std::string const& type_name, std::string const& plugin_name )
+{
+  return m_priv->m_loader->get_factories( type_name, plugin_name );
+}
+
 // ----------------------------------------------------------------------------
 plugin_map_t const& plugin_manager::
 plugin_map()
@@ -265,6 +278,7 @@ reload_plugins()
 
   // Add paths to the real loader
   m_priv->m_loader->add_search_path( m_priv->m_search_paths );
+  m_priv->m_loader->set_manifest_file( m_priv->m_manifest_file );
 
   load_all_plugins();
 }
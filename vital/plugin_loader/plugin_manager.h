@@ -150,6 +150,21 @@ class VITAL_VPM_EXPORT plugin_manager
   /// @return Vector of factories. (vector may be empty)
   plugin_factory_vector_t const& get_factories( std::string const& type_name );
 
+  /// @brief Get list of factories for one implementation.
+  ///
+  /// This method returns a list of factories for the interface type
+  /// which is only guaranteed to contain the one whose plugin name is
+  /// \a plugin_name. When plugins are deferred through a manifest
+  /// (KWIVER_PLUGIN_MANIFEST), only the file providing that plugin is
+  /// loaded.
+  ///
+  /// @param type_name Type name of the interface required
+  /// @param plugin_name Plugin name of the implementation required
+  ///
+  /// @return Vector of factories. (vector may be empty)
+  plugin_factory_vector_t const& get_factories( std::string const& type_name,
+                                                std::string const& plugin_name );
+
   /// @brief Get list of factories for interface type.
   ///
   /// This method returns a list of pointer to factory methods that
@@ -299,7 +314,10 @@ class implementation_factory
     // Get singleton plugin manager
     kwiver::vital::plugin_manager& pm = kwiver::vital::plugin_manager::instance();
 
-    auto fact_list = pm.get_factories( typeid( I ).name() );
+    // Selecting by name lets the manager load only the plugin file needed
+    auto fact_list = ( m_attr == plugin_factory::PLUGIN_NAME )
+      ? pm.get_factories( typeid( I ).name(), value )
+      : pm.get_factories( typeid( I ).name() );
     // Scan fact_list for CONCRETE_TYPE
     for( kwiver::vital::plugin_factory_handle_t a_fact : fact_list )
     {
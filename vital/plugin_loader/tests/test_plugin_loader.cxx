@@ -2,10 +2,17 @@
 // OSI-approved BSD 3-Clause License. See top-level LICENSE file or
 // https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
 
+#include <test_tmpfn.h>
+
+#include <vital/plugin_loader/plugin_loader.h>
 #include <vital/plugin_loader/plugin_manager.h>
 
+#include <kwiversys/SystemTools.hxx>
+
 #include <gtest/gtest.h>
 
+#include <fstream>
+
 using namespace kwiver::vital;
 
 // ----------------------------------------------------------------------------
@@ -28,6 +35,89 @@ TEST(plugin_loader, module_marking)
   EXPECT_TRUE( vpm.is_module_loaded( module ) );
 }
 
+// ----------------------------------------------------------------------------
+TEST(plugin_loader, manifest_cache)
+{
+  using ST = kwiversys::SystemTools;
+
+  auto const dir = kwiver::testing::temp_file_name( "plugin_manifest-", "" );
+  ASSERT_TRUE( ST::MakeDirectory( dir ) );
+
+  auto const manifest = dir + "/manifest.txt";
+  auto const module = dir + "/fake_module.so";
+  auto const other_module = dir + "/other_fake_module.so";
+  for ( auto const& m : { module, other_module } )
+  {
+    std::ofstream ofs( m );
+    ofs << "not really a shared library\n";
+  }
+  {
+    std::ofstream ofs( manifest );
+    ofs << "# kwiver plugin manifest v2\n"
+        << "module " << ST::ModifiedTime( module ) << " "
+        << ST::FileLength( module ) << " " << module << "\n"
+        << "interface fake_interface\n"
+        << "name fake_impl\n"
+        << "module " << ST::ModifiedTime( other_module ) << " "
+        << ST::FileLength( other_module ) << " " << other_module << "\n"
+        << "interface fake_interface\n"
+        << "name other_impl\n";
+  }
+
+  // Up-to-date entry: not opened until its interface is asked for
+  {
+    plugin_loader loader( "register_factories", ".so" );
+    loader.set_manifest_file( manifest );
+    loader.load_plugins( path_list_t{ dir } );
+
+    EXPECT_EQ( 2u, loader.get_deferred_file_list().size() );
+
+    EXPECT_TRUE( loader.get_factories( "other_interface" ).empty() );
+    EXPECT_EQ( 2u, loader.get_deferred_file_list().size() );
+
+    EXPECT_TRUE( loader.get_factories( "fake_interface", "other_impl" ).empty() );
+    EXPECT_EQ( std::vector< std::string >{ module },
+               loader.get_deferred_file_list() );
+
+    EXPECT_TRUE( loader.get_factories( "fake_interface" ).empty() );
+    EXPECT_TRUE( loader.get_deferred_file_list().empty() );
+  }
+
+  // Unknown plugin name: everything providing the interface is loaded
+  {
+    plugin_loader loader( "register_factories", ".so" );
+    loader.set_manifest_file( manifest );
+    loader.load_plugins( path_list_t{ dir } );
+
+    EXPECT_TRUE( loader.get_factories( "fake_interface", "no_impl" ).empty() );
+    EXPECT_TRUE( loader.get_deferred_file_list().empty() );
+  }
+
+  // Changed file: opened during the scan
+  {
+    std::ofstream ofs( module, std::ios::app );
+    ofs << "changed\n";
+  }
+  {
+    plugin_loader loader( "register_factories", ".so" );
+    loader.set_manifest_file( manifest );
+    loader.load_plugins( path_list_t{ dir } );
+
+    EXPECT_EQ( std::vector< std::string >{ other_module },
+               loader.get_deferred_file_list() );
+  }
+
+  // No manifest: nothing is ever deferred
+  {
+    plugin_loader loader( "register_factories", ".so" );
+    loader.load_plugins( path_list_t{ dir } );
+
+    EXPECT_TRUE( loader.get_deferred_file_list().empty() );
+  }
+
+  ST::RemoveADirectory( dir );
+}
+
 // Tests to add
 //
 // - Load known file and test to see if contents are as expected.
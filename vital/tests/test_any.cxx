@@ -56,3 +56,82 @@ TEST(any, api)
   any_double = 3456; // convert to int
   EXPECT_EQ( 3456, kwiver::vital::any_cast<int>( any_double ) );
 }
+
+// ----------------------------------------------------------------------------
+namespace {
+
+// Counts live instances, to check that every stored value is destroyed
+template < size_t N >
+struct tracked
+{
+  tracked( int v ) : value( v ) { ++count; }
+  tracked( tracked const& other ) : value( other.value ) { ++count; }
+  tracked( tracked&& other ) noexcept : value( other.value ) { ++count; }
+  ~tracked() { --count; }
+
+  int value;
+  char padding[ N ];
+
+  static int count;
+};
+
+template < size_t N > int tracked< N >::count = 0;
+
+using small_value = tracked< 8 >;
+using large_value = tracked< 256 >;
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+TEST(any, small_and_large_values)
+{
+  using kwiver::vital::any;
+  using kwiver::vital::any_cast;
+
+  {
+    any a_small{ small_value{ 1 } };
+    any a_large{ large_value{ 2 } };
+    EXPECT_EQ( 1, small_value::count );
+    EXPECT_EQ( 1, large_value::count );
+
+    // Copies
+    any b_small = a_small;
+    any b_large = a_large;
+    EXPECT_EQ( 2, small_value::count );
+    EXPECT_EQ( 2, large_value::count );
+    EXPECT_EQ( 1, any_cast< small_value >( b_small ).value );
+    EXPECT_EQ( 2, any_cast< large_value >( b_large ).value );
+
+    // Moves leave the source empty
+    any c_small = std::move( b_small );
+    any c_large = std::move( b_large );
+    EXPECT_TRUE( b_small.empty() );
+    EXPECT_TRUE( b_large.empty() );
+    EXPECT_EQ( 2, small_value::count );
+    EXPECT_EQ( 2, large_value::count );
+
+    // Swap between a value in the object and one on the heap
+    c_small.swap( c_large );
+    EXPECT_EQ( 2, any_cast< large_value >( c_small ).value );
+    EXPECT_EQ( 1, any_cast< small_value >( c_large ).value );
+
+    // Assignment replaces (and destroys) the old value
+    c_small = a_small;
+    c_large = 3.5;
+    EXPECT_EQ( 2, small_value::count );
+    EXPECT_EQ( 1, large_value::count );
+    EXPECT_DOUBLE_EQ( 3.5, any_cast< double >( c_large ) );
+
+    any const d_const{ a_large };
+    c_large = d_const;
+    EXPECT_EQ( 2, any_cast< large_value >( c_large ).value );
+
+    // Modifying through a pointer changes only that object
+    any_cast< small_value >( &c_small )->value = 7;
+    EXPECT_EQ( 1, any_cast< small_value >( a_small ).value );
+    EXPECT_EQ( 7, any_cast< small_value >( c_small ).value );
+  }
+
+  EXPECT_EQ( 0, small_value::count );
+  EXPECT_EQ( 0, large_value::count );
+}
@@ -9,6 +9,8 @@
 
 #include <vital/io/camera_from_metadata.h>
 #include <vital/types/camera_rpc.h>
+#include <vital/types/geodesy.h>
+#include <arrows/proj/geo_conv.h>
 #include <vital/types/metadata_traits.h>
 
 #include <iostream>
@@ -160,3 +162,61 @@ TEST(camera_from_metadata, projection)
   }
 }
 
+
+// ----------------------------------------------------------------------------
+TEST(camera_from_metadata, initialize_cameras)
+{
+  static auto geo_conv = kwiver::arrows::proj::geo_conversion{};
+  set_geo_conv( &geo_conv );
+
+  std::map< frame_id_t, metadata_sptr > md_map;
+  for( frame_id_t f = 0; f < 200; ++f )
+  {
+    auto md = std::make_shared< metadata >();
+    md->add< VITAL_META_SENSOR_LOCATION >(
+      geo_point{ vector_3d{ -73.75 + f * 1e-4, 42.85, 300.0 + f },
+                 SRID::lat_lon_WGS84 } );
+    md->add< VITAL_META_SENSOR_HORIZONTAL_FOV >( 20.0 + f * 0.01 );
+    // some frames have no orientation, and keep that of the frame before
+    if( f % 7 != 3 )
+    {
+      md->add< VITAL_META_PLATFORM_HEADING_ANGLE >( f * 0.5 );
+      md->add< VITAL_META_PLATFORM_PITCH_ANGLE >( 1.0 );
+      md->add< VITAL_META_PLATFORM_ROLL_ANGLE >( -2.0 );
+      md->add< VITAL_META_SENSOR_REL_AZ_ANGLE >( 10.0 );
+      md->add< VITAL_META_SENSOR_REL_EL_ANGLE >( -45.0 );
+      md->add< VITAL_META_SENSOR_REL_ROLL_ANGLE >( 0.0 );
+    }
+    md_map[ f ] = md;
+  }
+  md_map[ 200 ] = nullptr;
+
+  simple_camera_intrinsics K{ 1000, { 640, 360 } };
+  K.set_image_width( 1280 );
+  K.set_image_height( 720 );
+  simple_camera_perspective base_camera{ vector_3d::Zero(), rotation_d{}, K };
+
+  local_geo_cs lgcs;
+  auto const cams =
+    initialize_cameras_with_metadata( md_map, base_camera, lgcs );
+  ASSERT_EQ( 200, cams.size() );
+  ASSERT_FALSE( lgcs.origin().is_empty() );
+
+  // the same as updating one camera after the other
+  simple_camera_perspective expected{ base_camera };
+  for( frame_id_t f = 0; f < 200; ++f )
+  {
+    auto const& md = *md_map[ f ];
+    expected.set_intrinsics( intrinsics_from_metadata( md, 1280, 720 ) );
+    ASSERT_TRUE( update_camera_from_metadata( md, lgcs, expected ) );
+
+    auto const cam =
+      std::dynamic_pointer_cast< simple_camera_perspective >( cams.at( f ) );
+    ASSERT_TRUE( cam );
+    EXPECT_MATRIX_NEAR( expected.center(), cam->center(), 1e-9 );
+    EXPECT_MATRIX_NEAR( expected.rotation().matrix(),
+                        cam->rotation().matrix(), 1e-12 );
+    EXPECT_DOUBLE_EQ( expected.intrinsics()->focal_length(),
+                      cam->intrinsics()->focal_length() );
+  }
+}
@@ -8,6 +8,7 @@
 #include <test_eigen.h>
 
 #include <vital/types/camera_intrinsics.h>
+#include <vital/types/undistortion_grid.h>
 
 using namespace kwiver::vital;
 
@@ -120,3 +121,46 @@ TEST(camera_intrinsics, is_map_valid)
   // this point is at infinity, so it's always invalid
   EXPECT_FALSE(K.is_map_valid(vector_3d(2.0, 1.0, 0.0)));
 }
+
+// ----------------------------------------------------------------------------
+TEST(camera_intrinsics, undistortion_grid)
+{
+  vector_2d pp{ 330, 250 };
+  vector_3d d = { -0.1, 0.01, 0.001 };
+  auto K = std::make_shared<simple_camera_intrinsics>(
+    1000.0, pp, 1.0, 0.0, d, 640, 480 );
+
+  undistortion_grid grid{ *K };
+  EXPECT_EQ( 8, grid.spacing() );
+  EXPECT_TRUE( grid.matches( *K ) );
+
+  // Grid points are exact and points between them are close
+  EXPECT_MATRIX_NEAR( K->unmap( vector_2d{ 0, 0 } ),
+                      grid.unmap( vector_2d{ 0, 0 } ), 1e-12 );
+  EXPECT_MATRIX_NEAR( K->unmap( vector_2d{ 640, 480 } ),
+                      grid.unmap( vector_2d{ 640, 480 } ), 1e-12 );
+  for ( double y = 0.5; y < 480; y += 37.3 )
+  {
+    for ( double x = 0.25; x < 640; x += 41.7 )
+    {
+      vector_2d const pt{ x, y };
+      EXPECT_MATRIX_NEAR( K->unmap( pt ), grid.unmap( pt ), 1e-5 );
+    }
+  }
+
+  // Points outside the image are exact
+  vector_2d const outside{ -20.5, 500.25 };
+  EXPECT_MATRIX_NEAR( K->unmap( outside ), grid.unmap( outside ), 1e-12 );
+
+  // The grid is kept until the intrinsics change
+  auto const cached = cached_undistortion_grid( K );
+  EXPECT_EQ( cached, cached_undistortion_grid( K ) );
+  EXPECT_NE( cached, cached_undistortion_grid( K, 4 ) );
+
+  K->set_dist_coeffs( vector_3d{ -0.05, 0.0, 0.0 } );
+  EXPECT_FALSE( cached->matches( *K ) );
+  auto const changed = cached_undistortion_grid( K );
+  EXPECT_NE( cached, changed );
+  EXPECT_MATRIX_NEAR( K->unmap( vector_2d{ 100.5, 200.5 } ),
+                      changed->unmap( vector_2d{ 100.5, 200.5 } ), 1e-5 );
+}
@@ -0,0 +1,267 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test camera map and landmark map io functions
+
+#include <test_eigen.h>
+#include <test_tmpfn.h>
+
+#include <vital/exceptions.h>
+#include <vital/io/camera_io.h>
+#include <vital/io/camera_map_io.h>
+#include <vital/io/landmark_map_io.h>
+
+#include <kwiversys/SystemTools.hxx>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <sstream>
+
+using namespace kwiver::vital;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Cameras on every third frame, alternating between two shared intrinsics
+camera_map_sptr
+make_cameras()
+{
+  Eigen::VectorXd dist( 2 );
+  dist << 0.1, -0.01;
+  camera_intrinsics_sptr const K[] = {
+    std::make_shared< simple_camera_intrinsics >(
+      1000.0, vector_2d{ 640, 360 }, 1.1, 0.01, dist, 1280, 720 ),
+    std::make_shared< simple_camera_intrinsics >(
+      500.0, vector_2d{ 320, 240 } ) };
+
+  camera_map::map_camera_t cameras;
+  for( frame_id_t f = 0; f < 30; f += 3 )
+  {
+    auto cam = std::make_shared< simple_camera_perspective >(
+      vector_3d{ 1.0 * f, -2.0 * f, 10.0 + f },
+      rotation_d{ vector_3d{ 0.01 * f, 0.2, -0.1 } }, K[ f % 2 ] );
+    covariance_3d covar;
+    covar( 0, 1 ) = 0.5 * f;
+    covar( 2, 2 ) = 2.0;
+    cam->set_center_covar( covar );
+    cameras[ f ] = cam;
+  }
+  return std::make_shared< simple_camera_map >( cameras );
+}
+
+// ----------------------------------------------------------------------------
+void
+expect_same_camera( camera_sptr const& expected, camera_sptr const& actual )
+{
+  auto const e = std::dynamic_pointer_cast< camera_perspective >( expected );
+  auto const a = std::dynamic_pointer_cast< camera_perspective >( actual );
+  ASSERT_TRUE( e );
+  ASSERT_TRUE( a );
+  EXPECT_MATRIX_EQ( e->center(), a->center() );
+  EXPECT_MATRIX_EQ( e->rotation().matrix(), a->rotation().matrix() );
+  EXPECT_MATRIX_EQ( e->center_covar().matrix(), a->center_covar().matrix() );
+  EXPECT_MATRIX_EQ( e->intrinsics()->as_matrix(),
+                    a->intrinsics()->as_matrix() );
+  EXPECT_EQ( e->intrinsics()->dist_coeffs(), a->intrinsics()->dist_coeffs() );
+  EXPECT_EQ( e->intrinsics()->image_width(),
+             a->intrinsics()->image_width() );
+  EXPECT_EQ( e->intrinsics()->image_height(),
+             a->intrinsics()->image_height() );
+}
+
+// ----------------------------------------------------------------------------
+landmark_map_sptr
+make_landmarks()
+{
+  landmark_map::map_landmark_t landmarks;
+  for( landmark_id_t id = 5; id < 5000; id += 7 )
+  {
+    auto lm = std::make_shared< landmark_d >(
+      vector_3d{ 0.5 * id, -1.0 * id, 3.0 }, 0.1 * id );
+    lm->set_normal( vector_3d{ 0.0, 0.6, 0.8 } );
+    covariance_3d covar( 0.25 );
+    covar( 1, 2 ) = 0.125;
+    lm->set_covar( covar );
+    lm->set_color( rgb_color{ static_cast< uint8_t >( id ), 20, 255 } );
+    lm->set_observations( static_cast< unsigned >( id % 11 ) );
+    lm->set_cos_observation_angle( 0.75 );
+    landmarks[ id ] = lm;
+  }
+  return std::make_shared< simple_landmark_map >( landmarks );
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+TEST(camera_map_io, kwc_round_trip)
+{
+  auto const cameras = make_cameras();
+
+  std::stringstream str;
+  write_kwc( str, *cameras );
+
+  auto const file_name = kwiver::testing::temp_file_name( "test-", ".kwc" );
+  write_kwc( file_name, *cameras );
+
+  kwc_reader const stream_reader{ str };
+  kwc_reader const file_reader{ file_name };
+  for( auto const* reader : { &stream_reader, &file_reader } )
+  {
+    auto const result = reader->read_all()->cameras();
+    auto const expected = cameras->cameras();
+    ASSERT_EQ( expected.size(), result.size() );
+    for( auto const& c : expected )
+    {
+      SCOPED_TRACE( c.first );
+      ASSERT_EQ( 1, result.count( c.first ) );
+      expect_same_camera( c.second, result.at( c.first ) );
+    }
+
+    // Shared intrinsics are shared again
+    auto const intrinsics = [ & ]( frame_id_t f ){
+      return std::dynamic_pointer_cast< camera_perspective >(
+        result.at( f ) )->intrinsics();
+    };
+    EXPECT_EQ( intrinsics( 0 ), intrinsics( 6 ) );
+    EXPECT_NE( intrinsics( 0 ), intrinsics( 3 ) );
+  }
+
+  std::remove( file_name.c_str() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(camera_map_io, kwc_read_frame)
+{
+  auto const cameras = make_cameras()->cameras();
+
+  std::stringstream str;
+  write_kwc( str, simple_camera_map{ cameras } );
+  kwc_reader const reader{ str };
+
+  ASSERT_EQ( cameras.size(), reader.frames().size() );
+  for( frame_id_t f = -1; f < 32; ++f )
+  {
+    SCOPED_TRACE( f );
+    auto const actual = reader.read_frame( f );
+    auto const expected = cameras.find( f );
+    if( expected == cameras.end() )
+    {
+      EXPECT_FALSE( actual );
+    }
+    else
+    {
+      expect_same_camera( expected->second, actual );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(camera_map_io, kwc_invalid_data)
+{
+  std::stringstream str;
+  write_kwc( str, *make_cameras() );
+  auto const data = str.str();
+
+  for( auto const& bad :
+       { std::string{}, std::string{ "not a KWC file" },
+         data.substr( 0, data.size() - 1 ), data + "x" } )
+  {
+    std::istringstream in{ bad };
+    EXPECT_THROW( kwc_reader{ in }, invalid_data );
+  }
+
+  EXPECT_THROW( kwc_reader{ "/no/such/file.kwc" }, file_not_found_exception );
+
+  std::stringstream empty;
+  write_kwc( empty, simple_camera_map{} );
+  kwc_reader const reader{ empty };
+  EXPECT_TRUE( reader.frames().empty() );
+  EXPECT_EQ( 0, reader.read_all()->size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(camera_map_io, read_krtd_files)
+{
+  auto const cameras = make_cameras()->cameras();
+  auto const dir = kwiver::testing::temp_file_name( "test-", "-krtd" );
+
+  // One image for each frame, only some of which have cameras
+  std::vector< path_t > images;
+  for( frame_id_t f = 0; f < 30; ++f )
+  {
+    images.push_back( "frame" + std::to_string( f ) + ".png" );
+    auto const c = cameras.find( f );
+    if( c != cameras.end() )
+    {
+      write_krtd_file(
+        *std::dynamic_pointer_cast< camera_perspective >( c->second ),
+        dir + "/frame" + std::to_string( f ) + ".krtd" );
+    }
+  }
+
+  auto const result = read_krtd_files( images, dir )->cameras();
+  ASSERT_EQ( cameras.size(), result.size() );
+  for( auto const& c : cameras )
+  {
+    SCOPED_TRACE( c.first );
+    ASSERT_EQ( 1, result.count( c.first ) );
+    auto const e = std::dynamic_pointer_cast< camera_perspective >( c.second );
+    auto const a =
+      std::dynamic_pointer_cast< camera_perspective >( result.at( c.first ) );
+    EXPECT_MATRIX_NEAR( e->center(), a->center(), 1e-6 );
+    EXPECT_MATRIX_NEAR( e->intrinsics()->as_matrix(),
+                        a->intrinsics()->as_matrix(), 1e-6 );
+  }
+
+  kwiversys::SystemTools::RemoveADirectory( dir );
+}
+
+// ----------------------------------------------------------------------------
+TEST(camera_map_io, kwl_round_trip)
+{
+  auto const landmarks = make_landmarks();
+
+  auto const file_name = kwiver::testing::temp_file_name( "test-", ".kwl" );
+  write_kwl( file_name, *landmarks );
+
+  std::stringstream str;
+  write_kwl( str, *landmarks );
+
+  for( auto const& result : { read_kwl( str ), read_kwl( file_name ) } )
+  {
+    auto const expected = landmarks->landmarks();
+    auto const actual = result->landmarks();
+    ASSERT_EQ( expected.size(), actual.size() );
+    for( auto const& l : expected )
+    {
+      SCOPED_TRACE( l.first );
+      ASSERT_EQ( 1, actual.count( l.first ) );
+      auto const& e = *l.second;
+      auto const& a = *actual.at( l.first );
+      EXPECT_MATRIX_EQ( e.loc(), a.loc() );
+      EXPECT_MATRIX_EQ( e.normal(), a.normal() );
+      EXPECT_MATRIX_EQ( e.covar().matrix(), a.covar().matrix() );
+      EXPECT_EQ( e.scale(), a.scale() );
+      EXPECT_EQ( e.color(), a.color() );
+      EXPECT_EQ( e.observations(), a.observations() );
+      EXPECT_EQ( e.cos_obs_angle(), a.cos_obs_angle() );
+    }
+  }
+
+  std::remove( file_name.c_str() );
+
+  std::istringstream bad{ "not a KWL file" };
+  EXPECT_THROW( read_kwl( bad ), invalid_data );
+  EXPECT_THROW( read_kwl( path_t{ "/no/such/file.kwl" } ),
+                file_not_found_exception );
+}
@@ -8,6 +8,7 @@
 #include <test_eigen.h>
 
 #include <vital/types/camera_perspective.h>
+#include <vital/types/dense_camera_perspective_map.h>
 #include <vital/io/camera_io.h>
 
 #include <iostream>
@@ -102,3 +103,74 @@ TEST(camera_perspective, projection)
   test( { 0, 1, -2 } );
   test( { 5, -42, 67 } );
 }
+
+// ----------------------------------------------------------------------------
+TEST(camera_perspective, batch_projection)
+{
+  simple_camera_intrinsics::vector_t dist( 8 );
+  dist << -0.2, 0.05, 0.001, -0.002, 0.01, 0.1, 0.02, 0.003;
+  simple_camera_intrinsics K{ 1000, { 300, 400 }, 0.9, 0.1, dist };
+  simple_camera_perspective cam{ vector_3d{ 3, -4, 7 }, rotation_d{}, K };
+  cam.look_at( vector_3d{ 0, 1, -2 } );
+
+  matrix_Xx3d pts( 4, 3 );
+  pts << 1, 2, 3,
+         0, 1, -2,
+         5, -42, 67,
+         0.5, 0.5, -1;
+
+  matrix_Xx2d const proj = cam.project_points( pts );
+  ASSERT_EQ( pts.rows(), proj.rows() );
+
+  for ( Eigen::Index i = 0; i < pts.rows(); ++i )
+  {
+    vector_2d const batch_pt = proj.row( i ).transpose();
+    EXPECT_MATRIX_NEAR( cam.project( vector_3d( pts.row( i ).transpose() ) ),
+                        batch_pt, 1e-9 )
+      << "Batch projection should match projecting each point";
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(camera_perspective, dense_map)
+{
+  auto const K = std::make_shared< simple_camera_intrinsics >(
+    1000, vector_2d{ 300, 400 } );
+  simple_camera_perspective_map cams;
+  for ( frame_id_t f = 0; f < 3; ++f )
+  {
+    cams.insert( f, std::make_shared< simple_camera_perspective >(
+      vector_3d{ double( f ), 0, 0 }, rotation_d{}, K ) );
+  }
+
+  dense_camera_perspective_map dense( cams );
+  ASSERT_EQ( 3, dense.size() );
+  EXPECT_EQ( ( std::vector< frame_id_t >{ 0, 1, 2 } ), dense.frame_ids() );
+
+  // the map keeps its own intrinsics, still shared between its cameras
+  auto const* cam1 = dense.find( 1 );
+  ASSERT_NE( nullptr, cam1 );
+  EXPECT_NE( K, cam1->intrinsics() );
+  EXPECT_EQ( dense.find( 0 )->intrinsics(), cam1->intrinsics() );
+  K->set_focal_length( 500 );
+  EXPECT_EQ( 1000, cam1->intrinsics()->focal_length() );
+
+  // a copy is a snapshot, unchanged by later changes to the map
+  dense_camera_perspective_map const snapshot = dense;
+  dense.insert( 1, simple_camera_perspective{
+    vector_3d{ 0, 1, 0 }, rotation_d{}, K } );
+  EXPECT_TRUE( dense.erase( 2 ) );
+  EXPECT_EQ( 2, dense.size() );
+  EXPECT_EQ( vector_3d( 0, 1, 0 ), dense.find( 1 )->center() );
+  EXPECT_EQ( 500, dense.find( 1 )->intrinsics()->focal_length() );
+  EXPECT_EQ( 3, snapshot.size() );
+  EXPECT_EQ( vector_3d( 1, 0, 0 ), snapshot.find( 1 )->center() );
+
+  // restoring the cameras returns new cameras sharing new intrinsics
+  auto const restored = snapshot.T_cameras();
+  ASSERT_EQ( 3, restored.size() );
+  EXPECT_EQ( restored.at( 0 )->intrinsics(), restored.at( 2 )->intrinsics() );
+  EXPECT_NE( snapshot.find( 0 )->intrinsics(),
+             restored.at( 0 )->intrinsics() );
+  EXPECT_EQ( 1000, restored.at( 1 )->intrinsics()->focal_length() );
+}
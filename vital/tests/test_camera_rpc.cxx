@@ -121,6 +121,36 @@ TEST_F(camera_rpc, back_projection)
   }
 }
 
+// ----------------------------------------------------------------------------
+TEST_F(camera_rpc, batch_projection)
+{
+  kwiver::vital::path_t test_rpc_file = data_dir + "/" + good_rpc_file;
+  auto cam = read_rpc( test_rpc_file );
+
+  // Enough points to be split among several tasks
+  std::vector<kwiver::vital::vector_3d> points;
+  std::vector<double> elevs;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    auto const& pt = test_points[i % test_points.size()];
+    points.push_back( pt + kwiver::vital::vector_3d( 1e-6 * i, -1e-6 * i, 0.01 * i ) );
+    elevs.push_back( points.back()[2] );
+  }
+
+  std::vector<kwiver::vital::vector_2d> img_pts( points.size() );
+  cam.project( points.data(), img_pts.data(), points.size() );
+
+  std::vector<kwiver::vital::vector_3d> new_pts( points.size() );
+  cam.back_project( img_pts.data(), elevs.data(), new_pts.data(), points.size() );
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_MATRIX_NEAR( img_pts[i], cam.project( points[i] ), 1e-8 );
+    EXPECT_MATRIX_NEAR( new_pts[i], cam.back_project( img_pts[i], elevs[i] ), 1e-8 );
+    EXPECT_MATRIX_NEAR( new_pts[i], points[i], epsilon );
+  }
+}
+
 // ----------------------------------------------------------------------------
 TEST_F(camera_rpc, read_missing_image_dimension)
 {
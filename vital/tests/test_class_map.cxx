@@ -12,6 +12,8 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+
 using namespace kwiver::vital;
 
 namespace {
@@ -22,12 +24,16 @@ std::vector<std::string> const names =
 std::vector<double> const scores  = { 0.65, 0.6, 0.07, 0.055, 0.005 };
 
 struct test_class_map_tag {};
+struct test_class_id_tag {};
 
 }
 
 template class kwiver::vital::class_map< test_class_map_tag >;
 using test_class_map = class_map< test_class_map_tag >;
 
+template class kwiver::vital::class_map< test_class_id_tag >;
+using test_class_id_map = class_map< test_class_id_tag >;
+
 // ----------------------------------------------------------------------------
 int main(int argc, char** argv)
 {
@@ -114,3 +120,93 @@ TEST(class_map, name_pool)
   }
 
 }
+
+// ----------------------------------------------------------------------------
+TEST(class_map, class_ids)
+{
+  test_class_id_map cm( names, scores );
+
+  // Ids are given in the order names are first seen
+  for ( size_t i = 0; i < names.size(); ++i )
+  {
+    SCOPED_TRACE( names[i] );
+
+    auto const id = test_class_id_map::class_id( names[i] );
+    EXPECT_EQ( i, id );
+    EXPECT_EQ( names[i], test_class_id_map::class_name( id ) );
+    EXPECT_TRUE( cm.has_class_id( id ) );
+    EXPECT_EQ( scores[i], cm.score( id ) );
+  }
+
+  test_class_id_map::class_id_t id;
+  EXPECT_FALSE( test_class_id_map::find_class_id( "unseen", id ) );
+  EXPECT_FALSE( cm.has_class_name( "unseen" ) );
+  EXPECT_THROW( cm.score( "unseen" ), std::runtime_error );
+  EXPECT_THROW( test_class_id_map::class_name( 100 ), std::out_of_range );
+
+  auto const new_id = test_class_id_map::class_id( "new" );
+  EXPECT_TRUE( test_class_id_map::find_class_id( "new", id ) );
+  EXPECT_EQ( new_id, id );
+  EXPECT_FALSE( cm.has_class_id( new_id ) );
+  EXPECT_THROW( cm.score( new_id ), std::runtime_error );
+
+  cm.set_score( new_id, 0.5 );
+  EXPECT_EQ( 0.5, cm.score( "new" ) );
+  EXPECT_EQ( 6, cm.size() );
+
+  cm.delete_score( "person" );
+  EXPECT_FALSE( cm.has_class_id( test_class_id_map::class_id( "person" ) ) );
+  EXPECT_EQ( 5, cm.size() );
+
+  // Iteration gives each remaining class once
+  size_t count = 0;
+  for ( auto const& entry : cm )
+  {
+    EXPECT_EQ( entry.second, cm.score( *entry.first ) );
+    ++count;
+  }
+  EXPECT_EQ( cm.size(), count );
+}
+
+// ----------------------------------------------------------------------------
+TEST(class_map, concurrent_names)
+{
+  constexpr size_t num_threads = 8;
+  constexpr size_t num_names = 200;
+
+  std::vector< std::vector< test_class_id_map::class_id_t > > ids(
+    num_threads );
+  std::vector< std::thread > threads;
+  for ( size_t t = 0; t < num_threads; ++t )
+  {
+    threads.emplace_back(
+      [ t, &ids ]()
+      {
+        // Every thread sees every name, in a different order
+        for ( size_t i = 0; i < num_names; ++i )
+        {
+          auto const n = ( i * 7 + t * 13 ) % num_names;
+          auto const name = "concurrent-" + std::to_string( n );
+          test_class_id_map cm( name, 1.0 );
+          ids[ t ].push_back( test_class_id_map::class_id( name ) );
+          EXPECT_EQ( name, test_class_id_map::class_name( ids[ t ].back() ) );
+          EXPECT_TRUE( cm.has_class_id( ids[ t ].back() ) );
+        }
+      } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  // Each name gets a single id
+  for ( size_t t = 0; t < num_threads; ++t )
+  {
+    for ( size_t i = 0; i < num_names; ++i )
+    {
+      auto const n = ( i * 7 + t * 13 ) % num_names;
+      auto const name = "concurrent-" + std::to_string( n );
+      EXPECT_EQ( test_class_id_map::class_id( name ), ids[ t ][ i ] );
+    }
+  }
+}
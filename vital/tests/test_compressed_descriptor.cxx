@@ -0,0 +1,185 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Tests for compressed descriptor types.
+
+#include <gtest/gtest.h>
+
+#include <vital/types/compressed_descriptor.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace kwiver::vital;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< descriptor_dynamic< double > >
+random_descriptor( std::mt19937& rng, size_t size )
+{
+  std::normal_distribution< double > dist( 0.0, 1.0 );
+  auto const desc = std::make_shared< descriptor_dynamic< double > >( size );
+  for( size_t i = 0; i < size; ++i )
+  {
+    desc->raw_data()[ i ] = dist( rng );
+  }
+  return desc;
+}
+
+// ----------------------------------------------------------------------------
+double
+squared_distance( std::vector< double > const& a, std::vector< double > const& b )
+{
+  double sum = 0.0;
+  for( size_t i = 0; i < a.size(); ++i )
+  {
+    sum += ( a[ i ] - b[ i ] ) * ( a[ i ] - b[ i ] );
+  }
+  return sum;
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+TEST( compressed_descriptor, half_conversion )
+{
+  EXPECT_EQ( 0x0000, float_to_half( 0.0f ) );
+  EXPECT_EQ( 0x8000, float_to_half( -0.0f ) );
+  EXPECT_EQ( 0x3c00, float_to_half( 1.0f ) );
+  EXPECT_EQ( 0xc000, float_to_half( -2.0f ) );
+  EXPECT_EQ( 0x7bff, float_to_half( 65504.0f ) );
+  EXPECT_EQ( 0x7c00, float_to_half( 65520.0f ) );
+  EXPECT_EQ( 0x7c00, float_to_half( std::numeric_limits< float >::infinity() ) );
+  EXPECT_EQ( 0x0001, float_to_half( std::ldexp( 1.0f, -24 ) ) );
+  EXPECT_EQ( 0x0000, float_to_half( std::ldexp( 1.0f, -26 ) ) );
+  // Ties round to even
+  EXPECT_EQ( 0x3c00, float_to_half( 1.0f + std::ldexp( 1.0f, -11 ) ) );
+  EXPECT_EQ( 0x3c02, float_to_half( 1.0f + 3 * std::ldexp( 1.0f, -11 ) ) );
+  EXPECT_TRUE( std::isnan( half_to_float( float_to_half( std::nanf( "" ) ) ) ) );
+
+  // Every finite half survives a round trip
+  for( uint32_t h = 0; h < 0x10000; ++h )
+  {
+    if( ( h & 0x7c00 ) != 0x7c00 )
+    {
+      ASSERT_EQ( h, float_to_half( half_to_float( static_cast< uint16_t >( h ) ) ) );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST( compressed_descriptor, float16 )
+{
+  std::mt19937 rng( 1 );
+  auto const dense = random_descriptor( rng, 64 );
+  auto const query = random_descriptor( rng, 64 );
+  descriptor_float16 const desc( dense->raw_data(), dense->size() );
+
+  ASSERT_EQ( 64, desc.size() );
+  EXPECT_EQ( 128, desc.num_bytes() );
+  EXPECT_EQ( typeid( descriptor_float16 ), desc.data_type() );
+
+  auto const decoded = desc.as_double();
+  for( size_t i = 0; i < decoded.size(); ++i )
+  {
+    EXPECT_NEAR( dense->raw_data()[ i ], decoded[ i ],
+                 std::abs( dense->raw_data()[ i ] ) * 1e-3 + 1e-7 );
+  }
+
+  EXPECT_DOUBLE_EQ( squared_distance( decoded, query->as_double() ),
+                    desc.squared_distance( *query ) );
+
+  auto const copy = desc.clone();
+  EXPECT_TRUE( desc == *copy );
+}
+
+// ----------------------------------------------------------------------------
+TEST( compressed_descriptor, int8 )
+{
+  std::mt19937 rng( 2 );
+  auto const dense = random_descriptor( rng, 100 );
+  auto const query = random_descriptor( rng, 100 );
+  descriptor_int8 const desc( dense->raw_data(), dense->size() );
+
+  ASSERT_EQ( 100, desc.size() );
+  EXPECT_EQ( 108, desc.num_bytes() );
+
+  auto const values = dense->as_double();
+  auto const range = std::minmax_element( values.begin(), values.end() );
+  auto const decoded = desc.as_double();
+  for( size_t i = 0; i < decoded.size(); ++i )
+  {
+    EXPECT_NEAR( values[ i ], decoded[ i ],
+                 ( *range.second - *range.first ) / 254.0 );
+  }
+
+  EXPECT_NEAR( squared_distance( decoded, query->as_double() ),
+               desc.squared_distance( *query ), 1e-9 );
+
+  descriptor_int8 const rebuilt(
+    desc.offset(), desc.scale(),
+    std::vector< int8_t >( desc.codes(), desc.codes() + desc.size() ) );
+  EXPECT_TRUE( desc == rebuilt );
+
+  // A constant descriptor decodes exactly
+  std::vector< double > constant( 5, 3.5 );
+  descriptor_int8 const flat( constant.data(), constant.size() );
+  EXPECT_EQ( constant, flat.as_double() );
+}
+
+// ----------------------------------------------------------------------------
+TEST( compressed_descriptor, product_quantizer )
+{
+  std::mt19937 rng( 3 );
+  std::vector< descriptor_sptr > samples;
+  for( size_t i = 0; i < 1000; ++i )
+  {
+    samples.push_back( random_descriptor( rng, 16 ) );
+  }
+
+  EXPECT_THROW( product_quantizer::train( samples, 5 ), invalid_value );
+  EXPECT_THROW( product_quantizer::train( {}, 4 ), invalid_value );
+
+  auto const pq = product_quantizer::train( samples, 8, 10 );
+  ASSERT_EQ( 16, pq->dimension() );
+  ASSERT_EQ( 8, pq->subspaces() );
+
+  double encoded_error = 0.0;
+  double total = 0.0;
+  for( auto const& s : samples )
+  {
+    auto const code = pq->encode( *s );
+    ASSERT_EQ( 8, code->num_bytes() );
+    ASSERT_EQ( 16, code->size() );
+    encoded_error += code->squared_distance( *s );
+    total += squared_distance( s->as_double(),
+                               std::vector< double >( 16, 0.0 ) );
+  }
+  // Two dimensional subspaces with 256 centroids each keep most of the signal
+  EXPECT_LT( encoded_error, 0.1 * total );
+
+  // Table lookups agree with decoding
+  auto const query = random_descriptor( rng, 16 );
+  auto const table = pq->distance_table( query->raw_data() );
+  auto const code = pq->encode( *samples[ 7 ] );
+  EXPECT_NEAR( squared_distance( code->as_double(), query->as_double() ),
+               code->squared_distance( table ), 1e-9 );
+  EXPECT_NEAR( code->squared_distance( table ),
+               code->squared_distance( *query ), 1e-9 );
+
+  EXPECT_THROW( pq->encode( *random_descriptor( rng, 8 ) ), invalid_value );
+  EXPECT_THROW( descriptor_pq( pq, { 1, 2, 3 } ), invalid_value );
+}
@@ -0,0 +1,136 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Tests for packed_descriptor_set.
+
+#include <gtest/gtest.h>
+
+#include <vital/types/packed_descriptor_set.h>
+
+using namespace kwiver::vital;
+
+// ----------------------------------------------------------------------------
+int
+main( int argc, char* argv[] )
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST( descriptor_set_packed, construct_default )
+{
+  packed_descriptor_set< float > ds;
+  EXPECT_TRUE( ds.empty() );
+  EXPECT_EQ( 0, ds.size() );
+  EXPECT_TRUE( ds.descriptors().empty() );
+  EXPECT_THROW( ds.at( 0 ), std::out_of_range );
+}
+
+// ----------------------------------------------------------------------------
+TEST( descriptor_set_packed, construct_vector )
+{
+  packed_descriptor_set< int > ds( { 0, 1, 2, 10, 11, 12 }, 3 );
+  ASSERT_EQ( 2, ds.size() );
+  EXPECT_EQ( 3, ds.dimension() );
+  EXPECT_EQ( 3, ds.stride() );
+  EXPECT_EQ( 10, ds.row( 1 )[ 0 ] );
+
+  auto const d = ds.at( 1 );
+  ASSERT_EQ( 3, d->size() );
+  EXPECT_EQ( typeid( int ), d->data_type() );
+  EXPECT_EQ( ( std::vector< double >{ 10, 11, 12 } ), d->as_double() );
+
+  // Views refer to the packed buffer rather than copying it
+  auto const view = std::dynamic_pointer_cast< descriptor_array_of< int > >( d );
+  ASSERT_TRUE( view );
+  EXPECT_EQ( ds.row( 1 ), view->raw_data() );
+
+  // Clones do not
+  auto const clone = d->clone();
+  EXPECT_TRUE( *d == *clone );
+  EXPECT_NE( d->as_bytes(), clone->as_bytes() );
+
+  EXPECT_THROW( ds.at( 2 ), std::out_of_range );
+  EXPECT_THROW( packed_descriptor_set< int >( { 0, 1, 2, 3 }, 3 ),
+                invalid_value );
+}
+
+// ----------------------------------------------------------------------------
+TEST( descriptor_set_packed, construct_strided )
+{
+  // Two descriptors of dimension 2, padded to 3 elements each
+  std::shared_ptr< double > buffer( new double[ 6 ]{ 1, 2, -1, 3, 4, -1 },
+                                    std::default_delete< double[] >() );
+  packed_descriptor_set< double > ds( buffer, 2, 2, 3 );
+  ASSERT_EQ( 2, ds.size() );
+  EXPECT_EQ( ( std::vector< double >{ 3, 4 } ), ds.at( 1 )->as_double() );
+
+  // Views keep the buffer alive after the set is gone
+  descriptor_sptr d;
+  {
+    packed_descriptor_set< double > scoped( buffer, 2, 2, 3 );
+    d = scoped.at( 0 );
+  }
+  buffer.reset();
+  EXPECT_EQ( ( std::vector< double >{ 1, 2 } ), d->as_double() );
+
+  EXPECT_THROW( packed_descriptor_set< double >( ds.buffer(), 2, 3, 2 ),
+                invalid_value );
+}
+
+// ----------------------------------------------------------------------------
+TEST( descriptor_set_packed, range_based_loop )
+{
+  packed_descriptor_set< int > ds( { 0, 0, 1, 1, 2, 2 }, 2 );
+  size_t i = 0;
+  for( descriptor_sptr const d : ds )
+  {
+    EXPECT_EQ( d->size(), 2 );
+    EXPECT_EQ( d->as_double()[0], i );
+    EXPECT_EQ( d->as_double()[1], i );
+    ++i;
+  }
+  EXPECT_EQ( i, 3 );
+
+  auto const& cds = ds;
+  i = 0;
+  for( auto it = cds.cbegin(); it != cds.cend(); ++it )
+  {
+    EXPECT_EQ( ( *it )->as_double()[0], i );
+    ++i;
+  }
+  EXPECT_EQ( i, 3 );
+}
+
+// ----------------------------------------------------------------------------
+TEST( descriptor_set_packed, from )
+{
+  std::vector< descriptor_sptr > dsptr_vec;
+  for( int i = 0; i < 3; ++i )
+  {
+    auto const d = std::make_shared< descriptor_fixed< uint8_t, 2 > >();
+    d->raw_data()[ 0 ] = static_cast< uint8_t >( i );
+    d->raw_data()[ 1 ] = static_cast< uint8_t >( i * 2 );
+    dsptr_vec.push_back( d );
+  }
+  simple_descriptor_set simple( dsptr_vec );
+
+  auto const packed = packed_descriptor_set< uint8_t >::from( simple );
+  ASSERT_EQ( 3, packed->size() );
+  EXPECT_EQ( 2, packed->dimension() );
+  for( size_t i = 0; i < 3; ++i )
+  {
+    EXPECT_TRUE( *dsptr_vec[ i ] == *packed->at( i ) );
+  }
+
+  // Repacking a packed set shares its buffer
+  auto const repacked = packed_descriptor_set< uint8_t >::from( *packed );
+  EXPECT_EQ( packed->raw_data(), repacked->raw_data() );
+
+  // Descriptors of another type cannot be packed
+  EXPECT_THROW( packed_descriptor_set< float >::from( simple ),
+                invalid_value );
+}
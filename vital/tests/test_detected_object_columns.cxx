@@ -0,0 +1,327 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test detected_object_columns class
+
+#include <vital/types/detected_object_columns.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+using namespace kwiver::vital;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Non-maximum suppression comparing each candidate with each kept object
+std::vector< detected_object_sptr >
+reference_nms( std::vector< detected_object_sptr > sorted, double threshold )
+{
+  std::vector< detected_object_sptr > result;
+  for ( auto const& det : sorted )
+  {
+    auto const bbox = det->bounding_box();
+    bool suppressed = false;
+    for ( auto const& other : result )
+    {
+      auto const other_bbox = other->bounding_box();
+      auto const overlap = intersection( bbox, other_bbox );
+      if ( ! overlap.is_valid() )
+      {
+        continue;
+      }
+      double const overlap_area = overlap.area();
+      double const union_area =
+        bbox.area() + other_bbox.area() - overlap_area;
+      if ( union_area > 0 && overlap_area / union_area > threshold )
+      {
+        suppressed = true;
+        break;
+      }
+    }
+    if ( ! suppressed )
+    {
+      result.push_back( det );
+    }
+  }
+  return result;
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_columns, columns)
+{
+  auto const dot = std::make_shared< detected_object_type >(
+    std::vector< std::string >{ "columns-a", "columns-b" },
+    std::vector< double >{ 0.25, 0.75 } );
+
+  detected_object_set set;
+  set.add( std::make_shared< detected_object >(
+    bounding_box_d{ 1, 2, 3, 4 }, 0.5, dot ) );
+  set.add( std::make_shared< detected_object >(
+    bounding_box_d{ 5, 6, 7, 8 }, 0.9 ) );
+
+  detected_object_columns const columns( set );
+  ASSERT_EQ( 2, columns.size() );
+  EXPECT_EQ( ( std::vector< double >{ 1, 5 } ), columns.min_x() );
+  EXPECT_EQ( ( std::vector< double >{ 2, 6 } ), columns.min_y() );
+  EXPECT_EQ( ( std::vector< double >{ 3, 7 } ), columns.max_x() );
+  EXPECT_EQ( ( std::vector< double >{ 4, 8 } ), columns.max_y() );
+  EXPECT_EQ( ( std::vector< double >{ 0.5, 0.9 } ), columns.confidence() );
+
+  auto const a = detected_object_type::class_id( "columns-a" );
+  auto const b = detected_object_type::class_id( "columns-b" );
+  EXPECT_EQ( b, columns.most_likely_class()[ 0 ] );
+  EXPECT_EQ( detected_object_columns::no_class,
+             columns.most_likely_class()[ 1 ] );
+  EXPECT_EQ( 0.25, columns.score( 0, a ) );
+  EXPECT_EQ( 0.75, columns.score( 0, b ) );
+  EXPECT_TRUE( std::isnan( columns.score( 1, a ) ) );
+
+  EXPECT_EQ( ( std::vector< size_t >{ 1, 0 } ), columns.select() );
+  EXPECT_EQ( ( std::vector< size_t >{ 1 } ), columns.select( 0.6 ) );
+  EXPECT_EQ( ( std::vector< size_t >{ 0 } ), columns.select( a ) );
+  EXPECT_TRUE( columns.select( b, 0.8 ).empty() );
+
+  auto const subset = columns.make_set( { 1, 0 } );
+  ASSERT_EQ( 2, subset->size() );
+  EXPECT_EQ( set.at( 1 ), subset->at( 0 ) );
+  EXPECT_EQ( set.at( 0 ), subset->at( 1 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_columns, null_detection)
+{
+  detected_object_set set{ { nullptr,
+                             std::make_shared< detected_object >(
+                               bounding_box_d{ 0, 0, 1, 1 }, 0.5 ) } };
+
+  detected_object_columns const columns( set );
+  EXPECT_TRUE( std::isnan( columns.confidence()[ 0 ] ) );
+  EXPECT_EQ( ( std::vector< size_t >{ 1 } ), columns.select() );
+  EXPECT_EQ( ( std::vector< size_t >{ 1 } ),
+             columns.non_max_suppression( 0.5 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_columns, non_max_suppression)
+{
+  std::mt19937 rng( 3 );
+  std::uniform_real_distribution< double > position( 0.0, 1000.0 );
+  std::uniform_real_distribution< double > size( 5.0, 60.0 );
+  std::uniform_real_distribution< double > confidence( 0.0, 1.0 );
+
+  detected_object_set set;
+  for ( int i = 0; i < 2000; ++i )
+  {
+    auto const x = position( rng );
+    auto const y = position( rng );
+    set.add( std::make_shared< detected_object >(
+      bounding_box_d{ x, y, x + size( rng ), y + size( rng ) },
+      confidence( rng ) ) );
+  }
+
+  // The kept detections span several comparison blocks
+  for ( double const threshold : { 0.0, 0.3, 0.7 } )
+  {
+    SCOPED_TRACE( threshold );
+
+    auto const sorted = set.select( 0.0 );
+    auto const expected = reference_nms(
+      std::vector< detected_object_sptr >( sorted->begin(), sorted->end() ),
+      threshold );
+    auto const actual = set.non_max_suppression( threshold );
+
+    ASSERT_EQ( expected.size(), actual->size() );
+    EXPECT_GT( expected.size(), 64 );
+    for ( size_t i = 0; i < expected.size(); ++i )
+    {
+      EXPECT_EQ( expected[ i ], actual->at( i ) );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_columns, non_max_suppression_mixed_sizes)
+{
+  // Boxes much larger than the grid cells, and boxes touching at an edge
+  std::mt19937 rng( 5 );
+  std::uniform_real_distribution< double > position( -500.0, 500.0 );
+  std::uniform_real_distribution< double > size( 1.0, 20.0 );
+  std::uniform_real_distribution< double > confidence( 0.0, 1.0 );
+
+  detected_object_set set;
+  for ( int i = 0; i < 1000; ++i )
+  {
+    auto const x = std::round( position( rng ) );
+    auto const y = std::round( position( rng ) );
+    auto const scale = ( i % 50 == 0 ? 20.0 : 1.0 );
+    set.add( std::make_shared< detected_object >(
+      bounding_box_d{ x, y, x + std::round( scale * size( rng ) ),
+                      y + std::round( scale * size( rng ) ) },
+      confidence( rng ) ) );
+  }
+
+  for ( double const threshold : { 0.0, 0.5 } )
+  {
+    SCOPED_TRACE( threshold );
+
+    auto const sorted = set.select( 0.0 );
+    auto const expected = reference_nms(
+      std::vector< detected_object_sptr >( sorted->begin(), sorted->end() ),
+      threshold );
+    auto const actual = set.non_max_suppression( threshold );
+
+    ASSERT_EQ( expected.size(), actual->size() );
+    for ( size_t i = 0; i < expected.size(); ++i )
+    {
+      EXPECT_EQ( expected[ i ], actual->at( i ) );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_columns, iou)
+{
+  detected_object_set set;
+  set.add( std::make_shared< detected_object >(
+    bounding_box_d{ 0, 0, 2, 2 }, 0.9 ) );
+  set.add( std::make_shared< detected_object >(
+    bounding_box_d{ 1, 0, 3, 2 }, 0.8 ) );
+  set.add( std::make_shared< detected_object >(
+    bounding_box_d{ 5, 5, 6, 6 }, 0.7 ) );
+
+  detected_object_columns const columns( set );
+  EXPECT_DOUBLE_EQ( 1.0 / 3.0, columns.iou( 0, 1 ) );
+  EXPECT_DOUBLE_EQ( 1.0, columns.iou( 0, 0 ) );
+  EXPECT_EQ( 0.0, columns.iou( 0, 2 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_columns, soft_non_max_suppression)
+{
+  detected_object_set set;
+  set.add( std::make_shared< detected_object >(
+    bounding_box_d{ 0, 0, 2, 2 }, 0.9 ) );
+  set.add( std::make_shared< detected_object >(
+    bounding_box_d{ 1, 0, 3, 2 }, 0.8 ) );
+  set.add( std::make_shared< detected_object >(
+    bounding_box_d{ 5, 5, 6, 6 }, 0.7 ) );
+
+  detected_object_columns const columns( set );
+  auto const candidates = columns.select();
+
+  // Linear decay only applies above the threshold
+  auto linear =
+    columns.soft_non_max_suppression( candidates, false, 0.5, 0.5, 0.001 );
+  ASSERT_EQ( 3, linear.size() );
+  EXPECT_EQ( 0, linear[ 0 ].first );
+  EXPECT_EQ( 0.8, linear[ 1 ].second );
+
+  linear =
+    columns.soft_non_max_suppression( candidates, false, 0.3, 0.5, 0.001 );
+  ASSERT_EQ( 3, linear.size() );
+  EXPECT_EQ( 2, linear[ 1 ].first );
+  EXPECT_EQ( 1, linear[ 2 ].first );
+  EXPECT_DOUBLE_EQ( 0.8 * 2.0 / 3.0, linear[ 2 ].second );
+
+  // Gaussian decay applies to any overlap
+  auto const gaussian =
+    columns.soft_non_max_suppression( candidates, true, 0.5, 0.5, 0.001 );
+  ASSERT_EQ( 3, gaussian.size() );
+  EXPECT_EQ( 2, gaussian[ 1 ].first );
+  EXPECT_EQ( 1, gaussian[ 2 ].first );
+  EXPECT_DOUBLE_EQ( 0.8 * std::exp( -( 1.0 / 9.0 ) / 0.5 ),
+                    gaussian[ 2 ].second );
+
+  // Decayed detections below the score threshold are dropped
+  auto const dropped =
+    columns.soft_non_max_suppression( candidates, false, 0.3, 0.5, 0.6 );
+  ASSERT_EQ( 2, dropped.size() );
+  EXPECT_EQ( 0, dropped[ 0 ].first );
+  EXPECT_EQ( 2, dropped[ 1 ].first );
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_columns, soft_non_max_suppression_grid)
+{
+  // The grid used for many candidates must find the same neighbors
+  std::mt19937 rng( 11 );
+  std::uniform_real_distribution< double > position( 0.0, 400.0 );
+  std::uniform_real_distribution< double > size( 5.0, 40.0 );
+  std::uniform_real_distribution< double > confidence( 0.0, 1.0 );
+
+  detected_object_set set;
+  for ( int i = 0; i < 600; ++i )
+  {
+    auto const x = position( rng );
+    auto const y = position( rng );
+    set.add( std::make_shared< detected_object >(
+      bounding_box_d{ x, y, x + size( rng ), y + size( rng ) },
+      confidence( rng ) ) );
+  }
+
+  detected_object_columns const columns( set );
+  auto const candidates = columns.select();
+  auto const actual =
+    columns.soft_non_max_suppression( candidates, true, 0.5, 0.5, 0.1 );
+
+  // Reference implementation, comparing each pair of detections
+  std::vector< double > scores;
+  for ( auto const i : candidates )
+  {
+    scores.push_back( columns.confidence()[ i ] );
+  }
+  std::vector< std::pair< size_t, double > > expected;
+  std::vector< bool > alive( candidates.size(), true );
+  for ( size_t p = 0; p < candidates.size(); ++p )
+  {
+    alive[ p ] = scores[ p ] >= 0.1;
+  }
+  for ( ;; )
+  {
+    size_t best = candidates.size();
+    for ( size_t p = 0; p < candidates.size(); ++p )
+    {
+      if ( alive[ p ] && ( best == candidates.size() ||
+                           scores[ p ] > scores[ best ] ) )
+      {
+        best = p;
+      }
+    }
+    if ( best == candidates.size() )
+    {
+      break;
+    }
+    alive[ best ] = false;
+    expected.emplace_back( candidates[ best ], scores[ best ] );
+    for ( size_t p = 0; p < candidates.size(); ++p )
+    {
+      auto const overlap = columns.iou( candidates[ best ], candidates[ p ] );
+      if ( alive[ p ] && overlap > 0.0 )
+      {
+        scores[ p ] *= std::exp( -( overlap * overlap ) / 0.5 );
+        alive[ p ] = scores[ p ] >= 0.1;
+      }
+    }
+  }
+
+  ASSERT_EQ( expected.size(), actual.size() );
+  for ( size_t i = 0; i < expected.size(); ++i )
+  {
+    EXPECT_EQ( expected[ i ].first, actual[ i ].first );
+    EXPECT_DOUBLE_EQ( expected[ i ].second, actual[ i ].second );
+  }
+}
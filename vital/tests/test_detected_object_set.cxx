@@ -6,6 +6,7 @@
 /// \brief test detected_object class
 
 #include <vital/types/detected_object_set.h>
+#include <vital/types/detected_object_set_util.h>
 
 #include <gtest/gtest.h>
 
@@ -147,3 +148,74 @@ TEST(detected_object_set, clone_2)
 
   EXPECT_EQ( 1, do_set.clone()->size() );
 }
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_set, non_max_suppression)
+{
+  detected_object_set do_set;
+  do_set.add( std::make_shared<detected_object>(
+    bounding_box_d{ 0, 0, 10, 10 }, 0.5 ) );
+  do_set.add( std::make_shared<detected_object>(
+    bounding_box_d{ 1, 0, 11, 10 }, 0.9 ) );
+  do_set.add( std::make_shared<detected_object>(
+    bounding_box_d{ 5, 0, 15, 10 }, 0.7 ) );
+  do_set.add( std::make_shared<detected_object>(
+    bounding_box_d{ 50, 50, 60, 60 }, 0.1 ) );
+
+  // IoU of the first two is 9 / 11, of the second and third 6 / 14
+  auto selected = do_set.non_max_suppression( 0.5 );
+  ASSERT_EQ( 3, selected->size() );
+  EXPECT_EQ( 0.9, selected->at( 0 )->confidence() );
+  EXPECT_EQ( 0.7, selected->at( 1 )->confidence() );
+  EXPECT_EQ( 0.1, selected->at( 2 )->confidence() );
+
+  selected = do_set.non_max_suppression( 0.3 );
+  ASSERT_EQ( 2, selected->size() );
+  EXPECT_EQ( 0.9, selected->at( 0 )->confidence() );
+  EXPECT_EQ( 0.1, selected->at( 1 )->confidence() );
+
+  EXPECT_EQ( 4, do_set.non_max_suppression( 1.0 )->size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(detected_object_set, non_max_suppression_options)
+{
+  auto const cat = std::make_shared<detected_object_type>( "cat", 1.0 );
+  auto const dog = std::make_shared<detected_object_type>( "dog", 1.0 );
+
+  detected_object_set set;
+  set.add( std::make_shared<detected_object>(
+    bounding_box_d{ 0, 0, 10, 10 }, 0.9, cat ) );
+  set.add( std::make_shared<detected_object>(
+    bounding_box_d{ 1, 0, 11, 10 }, 0.8, dog ) );
+  set.add( std::make_shared<detected_object>(
+    bounding_box_d{ 0, 1, 10, 11 }, 0.7, cat ) );
+
+  // Greedy suppression across classes
+  auto result = non_max_suppression( set );
+  ASSERT_EQ( 1, result->size() );
+  EXPECT_EQ( set.at( 0 ), result->at( 0 ) );
+
+  // Class-aware suppression only between the cats
+  nms_options options;
+  options.class_aware = true;
+  result = non_max_suppression( set, options );
+  ASSERT_EQ( 2, result->size() );
+  EXPECT_EQ( set.at( 0 ), result->at( 0 ) );
+  EXPECT_EQ( set.at( 1 ), result->at( 1 ) );
+
+  // Soft suppression decays clones of the overlapping detections
+  options.class_aware = false;
+  options.method = nms_method::soft_linear;
+  result = non_max_suppression( set, options );
+  ASSERT_EQ( 3, result->size() );
+  EXPECT_EQ( set.at( 0 ), result->at( 0 ) );
+  EXPECT_NE( set.at( 1 ), result->at( 1 ) );
+  EXPECT_LT( result->at( 1 )->confidence(), 0.8 );
+  EXPECT_EQ( 0.8, set.at( 1 )->confidence() );
+  EXPECT_GE( result->at( 1 )->confidence(), result->at( 2 )->confidence() );
+
+  options.score_threshold = 0.5;
+  result = non_max_suppression( set, options );
+  ASSERT_EQ( 1, result->size() );
+}
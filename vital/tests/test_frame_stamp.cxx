@@ -0,0 +1,135 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief core frame_stamp class tests
+
+#include <vital/types/frame_stamp.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+
+using kwiver::vital::frame_stamp;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST(frame_stamp, api)
+{
+  frame_stamp fs;
+
+  EXPECT_FALSE( fs.is_valid() );
+  EXPECT_FALSE( fs.has_valid_time() );
+  EXPECT_FALSE( fs.has_valid_frame() );
+  EXPECT_EQ( 0, fs.stream() );
+
+  frame_stamp const fsv( 5000000, 2, 7 );
+
+  EXPECT_TRUE( fsv.is_valid() );
+  EXPECT_EQ( 5000000, fsv.time_usec() );
+  EXPECT_EQ( 2, fsv.frame() );
+  EXPECT_EQ( 7, fsv.stream() );
+
+  fs.set_frame( 123 ).set_stream( 65535 );
+  EXPECT_FALSE( fs.has_valid_time() );
+  EXPECT_EQ( 123, fs.frame() );
+  EXPECT_EQ( 65535, fs.stream() );
+
+  fs.set_time_usec( -10 );
+  EXPECT_TRUE( fs.is_valid() );
+  EXPECT_EQ( -10, fs.time_usec() );
+
+  fs.set_frame( frame_stamp::max_frame );
+  EXPECT_EQ( frame_stamp::max_frame, fs.frame() );
+  EXPECT_EQ( 65535, fs.stream() );
+
+  // Frames out of range are not valid
+  fs.set_frame( -1 );
+  EXPECT_FALSE( fs.has_valid_frame() );
+  fs.set_frame( frame_stamp::max_frame + 1 );
+  EXPECT_FALSE( fs.has_valid_frame() );
+  EXPECT_EQ( 65535, fs.stream() );
+
+  fs.set_frame( 4 ).set_invalid();
+  EXPECT_FALSE( fs.has_valid_time() );
+  EXPECT_FALSE( fs.has_valid_frame() );
+  EXPECT_EQ( 65535, fs.stream() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(frame_stamp, timestamp)
+{
+  kwiver::vital::timestamp ts( 5000000, 123 );
+  ts.set_time_domain_index( 3 );
+
+  frame_stamp const fs( ts );
+  EXPECT_EQ( 5000000, fs.time_usec() );
+  EXPECT_EQ( 123, fs.frame() );
+  EXPECT_EQ( 3, fs.stream() );
+  EXPECT_EQ( ts, fs.to_timestamp() );
+  EXPECT_EQ( 3, fs.to_timestamp().get_time_domain_index() );
+
+  kwiver::vital::timestamp frame_only;
+  frame_only.set_frame( 9 );
+  frame_stamp const fsf( frame_only );
+  EXPECT_FALSE( fsf.has_valid_time() );
+  EXPECT_EQ( 9, fsf.frame() );
+
+  auto const back = fsf.to_timestamp();
+  EXPECT_FALSE( back.has_valid_time() );
+  EXPECT_EQ( 9, back.get_frame() );
+
+  EXPECT_FALSE( frame_stamp( kwiver::vital::timestamp() ).has_valid_frame() );
+  EXPECT_FALSE( frame_stamp().to_timestamp().is_valid() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(frame_stamp, comparisons)
+{
+  frame_stamp const fs( 5000000, 123 );
+
+  EXPECT_EQ( fs, frame_stamp( 5000000, 123 ) );
+  EXPECT_NE( fs, frame_stamp( 5000000, 123, 1 ) );
+  EXPECT_NE( fs, frame_stamp( 5000001, 123 ) );
+  EXPECT_EQ( fs.key(), frame_stamp( 5000001, 123 ).key() );
+
+  // Ordered by stream, then frame, then time, with invalid values last
+  std::vector< frame_stamp > const ordered = {
+    frame_stamp( -5, 0 ),
+    frame_stamp( 4000000, 122 ),
+    frame_stamp( 5000000, 122 ),
+    frame_stamp( 3000000, 123 ),
+    frame_stamp( 5000000, 123 ),
+    frame_stamp().set_frame( 123 ),
+    frame_stamp( 0, 0 ).set_frame( -1 ),
+    frame_stamp(),
+    frame_stamp( 0, 0, 1 ),
+    frame_stamp().set_stream( 1 ),
+  };
+
+  for ( size_t i = 0; i < ordered.size(); ++i )
+  {
+    for ( size_t j = 0; j < ordered.size(); ++j )
+    {
+      SCOPED_TRACE( ::testing::Message() << i << " vs " << j );
+      EXPECT_EQ( i < j, ordered[ i ] < ordered[ j ] );
+      EXPECT_EQ( i > j, ordered[ i ] > ordered[ j ] );
+      EXPECT_EQ( i <= j, ordered[ i ] <= ordered[ j ] );
+      EXPECT_EQ( i >= j, ordered[ i ] >= ordered[ j ] );
+      EXPECT_EQ( i == j, ordered[ i ] == ordered[ j ] );
+    }
+  }
+
+  std::unordered_set< frame_stamp > const set( ordered.begin(), ordered.end() );
+  EXPECT_EQ( ordered.size(), set.size() );
+  EXPECT_EQ( 1, set.count( frame_stamp( 5000000, 123 ) ) );
+}
@@ -164,3 +164,46 @@ TEST(geodesy, descriptions)
   EXPECT_EQ( "WGS84", get( desc_wgs84_ups_s, "ellipse" ) );
   EXPECT_EQ( "stere", get( desc_wgs84_ups_s, "projection" ) );
 }
+
+// ----------------------------------------------------------------------------
+TEST(geodesy, batch_conversion)
+{
+  using namespace kwiver::vital;
+
+  plugin_manager::instance().load_all_plugins();
+
+  constexpr auto crs_utm_18n = SRID::UTM_WGS84_north + 18;
+
+  auto const points_2d = std::vector< vector_2d >{ loc1, loc2, loc3 };
+  auto const result_2d =
+    geo_conv( points_2d, SRID::lat_lon_WGS84, crs_utm_18n );
+
+  ASSERT_EQ( points_2d.size(), result_2d.size() );
+  for ( size_t i = 0; i < points_2d.size(); ++i )
+  {
+    auto const expected =
+      geo_conv( points_2d[ i ], SRID::lat_lon_WGS84, crs_utm_18n );
+    EXPECT_NEAR( expected[ 0 ], result_2d[ i ][ 0 ], 1e-6 );
+    EXPECT_NEAR( expected[ 1 ], result_2d[ i ][ 1 ], 1e-6 );
+  }
+
+  auto points_3d = std::vector< vector_3d >{
+    { loc1[ 0 ], loc1[ 1 ], 100.0 },
+    { loc2[ 0 ], loc2[ 1 ], -25.0 } };
+  auto const original_3d = points_3d;
+  geo_conv( points_3d.data(), points_3d.size(),
+            SRID::lat_lon_WGS84, crs_utm_18n );
+
+  for ( size_t i = 0; i < points_3d.size(); ++i )
+  {
+    auto const expected =
+      geo_conv( original_3d[ i ], SRID::lat_lon_WGS84, crs_utm_18n );
+    EXPECT_NEAR( expected[ 0 ], points_3d[ i ][ 0 ], 1e-6 );
+    EXPECT_NEAR( expected[ 1 ], points_3d[ i ][ 1 ], 1e-6 );
+    EXPECT_NEAR( expected[ 2 ], points_3d[ i ][ 2 ], 1e-6 );
+  }
+
+  EXPECT_TRUE(
+    geo_conv( std::vector< vector_2d >{},
+              SRID::lat_lon_WGS84, crs_utm_18n ).empty() );
+}
@@ -347,6 +347,52 @@ TEST(image, copy_from)
   EXPECT_EQ( data, img4.first_pixel() )
     << "Deep copying with the correct size should not reallocate memory";
   EXPECT_TRUE( equal_content( img1, img4 ) );
+
+  // copy between interleaved, planar and channel-reversed layouts
+  image_of<uint16_t> img5{ w, h, d, true };
+  image_of<uint16_t> img6{ w, h, d, false };
+  image_of<uint16_t> img7{ w, h, d, true };
+  cast_image( img1, img5 );
+  img6.copy_from( img5 );
+  EXPECT_TRUE( equal_content( img5, img6 ) );
+  img7.copy_from( img6.reverse_channels() );
+  EXPECT_TRUE( equal_content( img6.reverse_channels(), img7 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(image, reverse_channels)
+{
+  constexpr static unsigned w = 100, h = 200, d = 3;
+  for ( bool const interleave : { false, true } )
+  {
+    image_of<byte> img{ w, h, d, interleave };
+    for ( unsigned k = 0; k < d; ++k )
+    {
+      for ( unsigned j = 0; j < h; ++j )
+      {
+        for ( unsigned i = 0; i < w; ++i )
+        {
+          img( i, j, k ) = value_at<w, h>( i, j, k );
+        }
+      }
+    }
+
+    image const rev = img.reverse_channels();
+    EXPECT_EQ( img.memory(), rev.memory() )
+      << "Reversed view should share the same memory";
+    for ( unsigned k = 0; k < d; ++k )
+    {
+      for ( unsigned j = 0; j < h; ++j )
+      {
+        for ( unsigned i = 0; i < w; ++i )
+        {
+          ASSERT_EQ( img( i, j, d - 1 - k ), rev.at<byte>( i, j, k ) );
+        }
+      }
+    }
+    EXPECT_EQ( img.first_pixel(), rev.reverse_channels().first_pixel() );
+    EXPECT_TRUE( equal_content( img, rev.reverse_channels() ) );
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -539,6 +585,56 @@ TEST(image, cast_image)
   EXPECT_EQ( img1.d_step(), img2.d_step() );
 }
 
+// ----------------------------------------------------------------------------
+TEST(image, cast_image_layouts)
+{
+  constexpr static unsigned w = 37, h = 21, d = 3;
+  image_of<byte> img_in{ w, h, d, true };
+  for ( unsigned k = 0; k < d; ++k )
+  {
+    for ( unsigned j = 0; j < h; ++j )
+    {
+      for ( unsigned i = 0; i < w; ++i )
+      {
+        img_in( i, j, k ) = value_at<w, h>( i, j, k );
+      }
+    }
+  }
+
+  // interleaved to planar with a conversion
+  image_of<float> img_planar{ w, h, d, false };
+  cast_image( img_in, img_planar );
+  EXPECT_EQ( 1, img_planar.w_step() );
+  for ( unsigned k = 0; k < d; ++k )
+  {
+    for ( unsigned j = 0; j < h; ++j )
+    {
+      for ( unsigned i = 0; i < w; ++i )
+      {
+        ASSERT_EQ( static_cast<float>( img_in( i, j, k ) ),
+                   img_planar( i, j, k ) );
+      }
+    }
+  }
+
+  // the same layout as one flat array
+  image_of<float> img_interleaved{ w, h, d, true };
+  cast_image( img_in, img_interleaved );
+  EXPECT_TRUE( equal_content( img_planar, img_interleaved ) );
+
+  // the same pixel traits are deep copied
+  image_of<unsigned char> img_copy;
+  cast_image( img_in, img_copy );
+  EXPECT_NE( img_in.first_pixel(), img_copy.first_pixel() );
+  EXPECT_TRUE( equal_content( img_in, img_copy ) );
+
+  // in place on a view with negative steps
+  image_of<byte> img_reversed{ img_in.reverse_channels() };
+  transform_image( img_reversed, []( byte b ) { return byte( b + 1 ); } );
+  EXPECT_EQ( static_cast<byte>( value_at<w, h>( 2, 3, 0 ) + 1 ),
+             img_in( 2, 3, 0 ) );
+}
+
 // ----------------------------------------------------------------------------
 template <typename T, int Depth>
 struct image_type
@@ -576,3 +672,23 @@ TYPED_TEST(get_image, crop)
 
   test_get_image_crop<pix_t>( img_cont );
 }
+
+// ----------------------------------------------------------------------------
+TEST(image_container, conversion_cache)
+{
+  image_of<byte> img{ 10, 20, 3 };
+  simple_image_container container{ img };
+  EXPECT_EQ( nullptr, container.get_conversion( "test" ) );
+
+  auto const value = std::make_shared< int >( 42 );
+  container.set_conversion( "test", value );
+  EXPECT_EQ( value, container.get_conversion( "test" ) );
+  EXPECT_EQ( nullptr, container.get_conversion( "other" ) );
+
+  // copies start without conversions
+  simple_image_container copy{ container };
+  EXPECT_EQ( nullptr, copy.get_conversion( "test" ) );
+
+  container.clear_conversions();
+  EXPECT_EQ( nullptr, container.get_conversion( "test" ) );
+}
@@ -0,0 +1,165 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test image chip extraction
+
+#include <vital/types/image_chips.h>
+
+#include <vital/exceptions/base.h>
+#include <vital/exceptions/image.h>
+
+#include <gtest/gtest.h>
+
+using namespace kwiver::vital;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+image_of< uint8_t >
+make_test_image()
+{
+  // a horizontal ramp in the first channel and a vertical ramp in the second
+  image_of< uint8_t > img{ 64, 48, 2, true };
+  for( size_t j = 0; j < img.height(); ++j )
+  {
+    for( size_t i = 0; i < img.width(); ++i )
+    {
+      img( i, j, 0 ) = static_cast< uint8_t >( i );
+      img( i, j, 1 ) = static_cast< uint8_t >( j );
+    }
+  }
+  return img;
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_chips, layout)
+{
+  auto const img = make_test_image();
+  chip_extraction_options options;
+  options.width = 8;
+  options.height = 4;
+
+  std::vector< bounding_box_d > const boxes{
+    { 0, 0, 8, 4 }, { 10, 20, 18, 24 }, { 30, 10, 38, 14 } };
+  auto const batch = extract_image_chips( img, boxes, options );
+  ASSERT_EQ( 3, batch.count );
+  ASSERT_EQ( 2, batch.depth );
+  ASSERT_EQ( 8, batch.data.width() );
+  ASSERT_EQ( 4, batch.data.height() );
+  ASSERT_EQ( 6, batch.data.depth() );
+
+  // the batch is contiguous, by chip, channel, row and column
+  EXPECT_TRUE( batch.data.is_contiguous() );
+  float const* data = batch.data.first_pixel();
+  for( size_t n = 0; n < boxes.size(); ++n )
+  {
+    auto const chip = batch.chip( n );
+    ASSERT_EQ( 2, chip.depth() );
+    for( size_t c = 0; c < 2; ++c )
+    {
+      for( size_t j = 0; j < 4; ++j )
+      {
+        for( size_t i = 0; i < 8; ++i )
+        {
+          // boxes the size of the chip are copied exactly
+          auto const x = static_cast< size_t >( boxes[ n ].min_x() ) + i;
+          auto const y = static_cast< size_t >( boxes[ n ].min_y() ) + j;
+          EXPECT_EQ( img( x, y, c ), chip( i, j, c ) );
+          EXPECT_EQ( chip( i, j, c ), *data++ );
+        }
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_chips, resize_and_normalize)
+{
+  auto const img = make_test_image();
+  chip_extraction_options options;
+  options.width = 4;
+  options.height = 4;
+  options.scale = 0.5;
+  options.mean = { 1.0, 2.0 };
+  options.std_dev = { 2.0 };
+
+  // downsampling by two samples between each pair of pixels
+  auto const batch = extract_image_chips( img, { { 16, 8, 24, 16 } }, options );
+  ASSERT_EQ( 1, batch.count );
+  auto const chip = batch.chip( 0 );
+  for( size_t j = 0; j < 4; ++j )
+  {
+    for( size_t i = 0; i < 4; ++i )
+    {
+      auto const x = 16.5 + 2.0 * i;
+      auto const y = 8.5 + 2.0 * j;
+      EXPECT_FLOAT_EQ( ( 0.5 * x - 1.0 ) / 2.0, chip( i, j, 0 ) );
+      EXPECT_FLOAT_EQ( ( 0.5 * y - 2.0 ) / 2.0, chip( i, j, 1 ) );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_chips, context_and_edges)
+{
+  auto const img = make_test_image();
+  chip_extraction_options options;
+  options.width = 8;
+  options.height = 8;
+  options.context = 0.5;
+
+  // the box grows to ( -4, -4 ) - ( 12, 12 ), past the top left corner
+  auto const batch = extract_image_chips( img, { { 0, 0, 8, 8 } }, options );
+  auto const chip = batch.chip( 0 );
+  EXPECT_FLOAT_EQ( 0.0f, chip( 0, 0, 0 ) );
+  EXPECT_FLOAT_EQ( 0.0f, chip( 1, 0, 0 ) );
+  EXPECT_FLOAT_EQ( 0.5f, chip( 2, 0, 0 ) );
+  EXPECT_FLOAT_EQ( 10.5f, chip( 7, 0, 0 ) );
+  EXPECT_FLOAT_EQ( 0.0f, chip( 0, 1, 1 ) );
+  EXPECT_FLOAT_EQ( 10.5f, chip( 0, 7, 1 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_chips, invalid_boxes)
+{
+  auto const img = make_test_image();
+  chip_extraction_options options;
+  options.width = 4;
+  options.height = 4;
+  options.mean = { 100.0 };
+
+  auto const batch =
+    extract_image_chips( img, { bounding_box_d{}, { 0, 0, 4, 4 } }, options );
+  ASSERT_EQ( 2, batch.count );
+  EXPECT_EQ( 0.0f, batch.chip( 0 )( 0, 0, 0 ) );
+  EXPECT_EQ( 0.0f, batch.chip( 0 )( 3, 3, 1 ) );
+  EXPECT_EQ( -100.0f, batch.chip( 1 )( 0, 0, 0 ) );
+
+  EXPECT_EQ( 0, extract_image_chips( img, {}, options ).count );
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_chips, errors)
+{
+  auto const img = make_test_image();
+  chip_extraction_options options;
+  options.mean = { 1.0, 2.0, 3.0 };
+  EXPECT_THROW( extract_image_chips( img, { { 0, 0, 4, 4 } }, options ),
+                invalid_value );
+
+  image_of< int16_t > const signed_img{ 8, 8 };
+  EXPECT_THROW(
+    extract_image_chips( signed_img, { { 0, 0, 4, 4 } } ),
+    image_type_mismatch_exception );
+}
@@ -0,0 +1,106 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test image memory pool
+
+#include <vital/types/image_memory_pool.h>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+using namespace kwiver::vital;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_memory_pool, recycle)
+{
+  image_memory_pool pool;
+
+  auto mem = pool.acquire( 1024 );
+  ASSERT_NE( nullptr, mem );
+  EXPECT_EQ( 1024, mem->size() );
+  auto const data = mem->data();
+
+  mem.reset();
+  EXPECT_EQ( 1024, pool.statistics().cached_bytes );
+
+  mem = pool.acquire( 1024 );
+  EXPECT_EQ( data, mem->data() );
+
+  auto const stats = pool.statistics();
+  EXPECT_EQ( 1, stats.hits );
+  EXPECT_EQ( 1, stats.misses );
+  EXPECT_EQ( 1, stats.recycled );
+  EXPECT_EQ( 0, stats.cached_bytes );
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_memory_pool, size_mismatch)
+{
+  image_memory_pool pool;
+
+  pool.acquire( 1024 );
+  auto const mem = pool.acquire( 2048 );
+  EXPECT_EQ( 2048, mem->size() );
+
+  auto const stats = pool.statistics();
+  EXPECT_EQ( 0, stats.hits );
+  EXPECT_EQ( 2, stats.misses );
+  EXPECT_EQ( 1024, stats.cached_bytes );
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_memory_pool, limit)
+{
+  image_memory_pool pool( 1536 );
+
+  auto first = pool.acquire( 1024 );
+  auto second = pool.acquire( 1024 );
+  first.reset();
+  second.reset();
+
+  auto stats = pool.statistics();
+  EXPECT_EQ( 1, stats.recycled );
+  EXPECT_EQ( 1, stats.discarded );
+  EXPECT_EQ( 1024, stats.cached_bytes );
+
+  pool.set_max_cached_bytes( 512 );
+  EXPECT_EQ( 0, pool.statistics().cached_bytes );
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_memory_pool, outlive_pool)
+{
+  image_memory_sptr mem;
+  {
+    image_memory_pool pool;
+    mem = pool.acquire( 1024 );
+  }
+
+  // Memory must remain usable after the pool is gone
+  static_cast< char* >( mem->data() )[ 1023 ] = 42;
+  EXPECT_EQ( 42, static_cast< char* >( mem->data() )[ 1023 ] );
+  mem.reset();
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_memory_pool, image)
+{
+  image_memory_pool pool;
+
+  auto const mem = pool.acquire( 4 * 3 * 3 );
+  image_of< uint8_t > img( mem, static_cast< uint8_t* >( mem->data() ),
+                           4, 3, 3, 3, 12, 1 );
+  img( 3, 2, 2 ) = 7;
+  EXPECT_EQ( 7, img( 3, 2, 2 ) );
+  EXPECT_EQ( mem, img.memory() );
+}
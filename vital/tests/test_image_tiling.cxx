@@ -0,0 +1,108 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test image tiling
+
+#include <vital/types/image_tiling.h>
+
+#include <vital/exceptions/base.h>
+
+#include <gtest/gtest.h>
+
+using namespace kwiver::vital;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_tiling, layout)
+{
+  image_tiling tiling{ 250, 100, 100, 60, 20 };
+  ASSERT_EQ( 3, tiling.columns() );
+  ASSERT_EQ( 2, tiling.rows() );
+  ASSERT_EQ( 6, tiling.size() );
+
+  EXPECT_EQ( bounding_box_i( 0, 0, 100, 60 ), tiling.tile( 0 ) );
+  EXPECT_EQ( bounding_box_i( 80, 0, 180, 60 ), tiling.tile( 1 ) );
+  // the last tile in a row ends at the edge of the image
+  EXPECT_EQ( bounding_box_i( 150, 0, 250, 60 ), tiling.tile( 2 ) );
+  EXPECT_EQ( bounding_box_i( 0, 40, 100, 100 ), tiling.tile( 3 ) );
+
+  EXPECT_EQ( bounding_box_i( 0, 0, 90, 50 ), tiling.core( 0 ) );
+  EXPECT_EQ( bounding_box_i( 90, 0, 165, 50 ), tiling.core( 1 ) );
+  EXPECT_EQ( bounding_box_i( 165, 50, 250, 100 ), tiling.core( 5 ) );
+
+  size_t count = 0;
+  for( auto const& tile : tiling )
+  {
+    EXPECT_EQ( tiling.tile( count ), tile );
+    ++count;
+  }
+  EXPECT_EQ( tiling.size(), count );
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_tiling, cores_partition_region)
+{
+  bounding_box_i const region{ 13, 7, 313, 207 };
+  image_tiling tiling{ region, 64, 48, 16 };
+
+  double area = 0.0;
+  for( size_t i = 0; i < tiling.size(); ++i )
+  {
+    auto const tile = tiling.tile( i );
+    auto const core = tiling.core( i );
+    EXPECT_EQ( 64, tile.width() );
+    EXPECT_EQ( 48, tile.height() );
+    EXPECT_EQ( core, intersection( core, tile ) );
+    EXPECT_EQ( tile, intersection( tile, region ) );
+    area += core.area();
+    for( size_t j = 0; j < i; ++j )
+    {
+      auto const other = intersection( core, tiling.core( j ) );
+      EXPECT_TRUE( !other.is_valid() || other.area() == 0.0 );
+    }
+  }
+  EXPECT_EQ( region.area(), area );
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_tiling, small_region)
+{
+  image_tiling tiling{ 30, 20, 100, 100, 10 };
+  ASSERT_EQ( 1, tiling.size() );
+  EXPECT_EQ( bounding_box_i( 0, 0, 30, 20 ), tiling.tile( 0 ) );
+  EXPECT_EQ( bounding_box_i( 0, 0, 30, 20 ), tiling.core( 0 ) );
+
+  EXPECT_EQ( 0, ( image_tiling{ 0, 20, 10, 10 } ).size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_tiling, view)
+{
+  image_of< uint8_t > img{ 50, 40, 3 };
+  img( 30, 25, 1 ) = 42;
+
+  image_tiling tiling{ 50, 40, 20, 20, 5 };
+  auto const view = tiling.view( img, tiling.columns() + 2 );
+  EXPECT_EQ( 20, view.width() );
+  EXPECT_EQ( 20, view.height() );
+  EXPECT_EQ( 3, view.depth() );
+  EXPECT_EQ( img.memory(), view.memory() );
+
+  auto const tile = tiling.tile( tiling.columns() + 2 );
+  EXPECT_EQ( 42, view.at< uint8_t >( 30 - tile.min_x(), 25 - tile.min_y(), 1 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(image_tiling, invalid)
+{
+  EXPECT_THROW( image_tiling( 100, 100, 0, 10 ), invalid_value );
+  EXPECT_THROW( image_tiling( 100, 100, 10, 10, 10 ), invalid_value );
+}
@@ -5,6 +5,7 @@
 /// \file
 /// \brief test core landmark class
 
+#include <vital/types/dense_landmark_map.h>
 #include <vital/types/landmark.h>
 
 #include <gtest/gtest.h>
@@ -94,3 +95,41 @@ TEST(landmark, template_print)
   EXPECT_EQ( original.get_cos_obs_angle(), from_output.get_cos_obs_angle() );
   // EXPECT_EQ( original.get_covar(), from_output.get_covar() );
 }
+
+// ----------------------------------------------------------------------------
+TEST(landmark, dense_map)
+{
+  using namespace kwiver::vital;
+
+  landmark_map::map_landmark_t lms;
+  lms[ 7 ] = std::make_shared< landmark_d >( vector_3d( 7, 0, 0 ) );
+  lms[ 2 ] = std::make_shared< landmark_d >( vector_3d( 2, 0, 0 ) );
+
+  dense_landmark_map dense( lms );
+  dense.insert( 4, landmark_d( vector_3d( 4, 0, 0 ) ) );
+  ASSERT_EQ( 3, dense.size() );
+  EXPECT_EQ( ( std::vector< landmark_id_t >{ 2, 4, 7 } ), dense.ids() );
+  ASSERT_NE( nullptr, dense.find( 4 ) );
+  EXPECT_EQ( vector_3d( 4, 0, 0 ), dense.find( 4 )->loc() );
+  EXPECT_EQ( nullptr, dense.find( 5 ) );
+
+  // a copy is a snapshot, unchanged by later changes to the map
+  dense_landmark_map const snapshot = dense;
+  dense.insert( 4, landmark_d( vector_3d( 0, 4, 0 ) ) );
+  EXPECT_TRUE( dense.erase( 2 ) );
+  EXPECT_FALSE( dense.erase( 2 ) );
+  EXPECT_EQ( 2, dense.size() );
+  EXPECT_EQ( vector_3d( 0, 4, 0 ), dense.find( 4 )->loc() );
+  EXPECT_EQ( 3, snapshot.size() );
+  EXPECT_EQ( vector_3d( 4, 0, 0 ), snapshot.find( 4 )->loc() );
+
+  // landmarks returned are copies
+  auto out = snapshot.landmarks();
+  std::static_pointer_cast< landmark_d >( out[ 7 ] )->set_loc( vector_3d::Zero() );
+  EXPECT_EQ( vector_3d( 7, 0, 0 ), snapshot.find( 7 )->loc() );
+
+  // restoring the snapshot undoes the changes
+  dense = snapshot;
+  EXPECT_EQ( 3, dense.size() );
+  EXPECT_EQ( vector_3d( 2, 0, 0 ), dense.find( 2 )->loc() );
+}
@@ -137,6 +137,92 @@ TEST ( mesh, append_with_shift )
   }
 }
 
+// ----------------------------------------------------------------------------
+TEST ( mesh, polygon_face_array )
+{
+  std::vector< std::vector< unsigned int > > list =
+  { { 0, 1, 2 }, { 2, 3, 4, 5 }, { 5, 6, 7, 8, 9 } };
+  mesh_polygon_face_array faces( list );
+
+  EXPECT_EQ( 0, faces.regularity() );
+  ASSERT_EQ( list.size(), faces.size() );
+  EXPECT_EQ( std::vector< unsigned int >( { 0, 3, 7, 12 } ),
+             faces.offsets() );
+  for( unsigned int i = 0; i < list.size(); i++ )
+  {
+    ASSERT_EQ( list[ i ].size(), faces.num_verts( i ) );
+    for( unsigned int j = 0; j < list[ i ].size(); j++ )
+    {
+      EXPECT_EQ( list[ i ][ j ], faces( i, j ) );
+      EXPECT_EQ( list[ i ][ j ], faces.face( i )[ j ] );
+    }
+  }
+
+  faces.flip_orientation( 1 );
+  EXPECT_EQ( 5, faces( 1, 0 ) );
+  EXPECT_EQ( 2, faces( 1, 3 ) );
+  EXPECT_EQ( 5, faces( 2, 0 ) );
+
+  // copies of other face arrays and appends of any type match
+  mesh_face_array generic( list );
+  mesh_polygon_face_array copy( generic );
+  EXPECT_TRUE( copy.approx_equal( generic ) );
+
+  copy.append( faces, 10 );
+  copy.append( mesh_regular_face_array< 3 >( { { 1, 2, 3 } } ), 20 );
+  ASSERT_EQ( 7, copy.size() );
+  EXPECT_EQ( 15, copy( 4, 0 ) );
+  EXPECT_EQ( 21, copy( 6, 0 ) );
+  EXPECT_EQ( copy.indices().size(), copy.offsets().back() );
+
+  generic.append( copy, 0 );
+  ASSERT_EQ( 10, generic.size() );
+  EXPECT_EQ( 23, generic( 9, 2 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( mesh, compact_face_array )
+{
+  std::unique_ptr< mesh_polygon_face_array > tris(
+    new mesh_polygon_face_array( { { 0, 1, 2 }, { 2, 1, 3 } } ) );
+  tris->make_group( "first" );
+  tris->push_back( std::vector< unsigned int >{ 3, 4, 5 } );
+  tris->make_group( "second" );
+
+  auto compact = compact_face_array( std::move( tris ) );
+  ASSERT_EQ( 3, compact->regularity() );
+  ASSERT_EQ( 3, compact->size() );
+  EXPECT_EQ( 3, compact->operator()( 1, 2 ) );
+  EXPECT_EQ( ( std::set< unsigned int >{ 0, 1 } ),
+             compact->group_face_set( "first" ) );
+  EXPECT_EQ( ( std::set< unsigned int >{ 2 } ),
+             compact->group_face_set( "second" ) );
+
+  std::unique_ptr< mesh_face_array_base > mixed(
+    new mesh_polygon_face_array( { { 0, 1, 2 }, { 2, 1, 3, 4 } } ) );
+  auto const* const mixed_ptr = mixed.get();
+  EXPECT_EQ( mixed_ptr, compact_face_array( std::move( mixed ) ).get() );
+}
+
+// ----------------------------------------------------------------------------
+TEST ( mesh, merge_mixed_faces )
+{
+  mesh_sptr cube = kwiver::testing::cube_mesh( 1.0 );
+  mesh tris( std::unique_ptr< mesh_vertex_array_base >(
+               new mesh_vertex_array< 3 >( { { 0, 0, 0 }, { 1, 0, 0 },
+                                             { 0, 1, 0 } } ) ),
+             std::unique_ptr< mesh_face_array_base >(
+               new mesh_regular_face_array< 3 >( { { 0, 1, 2 } } ) ) );
+
+  unsigned int const cube_verts = cube->num_verts();
+  tris.merge( *cube );
+  EXPECT_NE( nullptr,
+             dynamic_cast< mesh_polygon_face_array const* >( &tris.faces() ) );
+  ASSERT_EQ( 1 + cube->num_faces(), tris.num_faces() );
+  EXPECT_EQ( 3 + cube_verts, tris.num_verts() );
+  EXPECT_EQ( cube->faces()( 0, 0 ) + 3, tris.faces()( 1, 0 ) );
+}
+
 // ----------------------------------------------------------------------------
 TEST ( mesh, half_edges )
 {
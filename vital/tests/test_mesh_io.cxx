@@ -6,6 +6,7 @@
 /// \brief test core mesh_io functionality
 
 #include <fstream>
+#include <sstream>
 
 #include <kwiversys/SystemTools.hxx>
 #include <tests/test_gtest.h>
@@ -139,3 +140,211 @@ TEST_F(mesh_io, write_vrml_not_triangular)
 
   kwiversys::SystemTools::RemoveADirectory( "temp" );
 }
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// A mesh of triangles, stored as a regular face array
+mesh_sptr
+triangle_mesh()
+{
+  mesh_sptr cube = kwiver::testing::cube_mesh( 1.0 );
+  std::unique_ptr< mesh_regular_face_array< 3 > > tris(
+    new mesh_regular_face_array< 3 > );
+  auto const& quads = cube->faces();
+  for( unsigned int f = 0; f < quads.size(); ++f )
+  {
+    tris->push_back( { quads( f, 0 ), quads( f, 1 ), quads( f, 2 ) } );
+    tris->push_back( { quads( f, 0 ), quads( f, 2 ), quads( f, 3 ) } );
+  }
+  cube->set_faces( std::move( tris ) );
+  return cube;
+}
+
+} // end anonymous namespace
+
+// ----------------------------------------------------------------------------
+TEST_F(mesh_io, read_write_ply)
+{
+  mesh_sptr original = kwiver::testing::cube_mesh( 1.0 );
+  original->set_faces( std::unique_ptr<mesh_face_array_base>(
+    new mesh_face_array( original->faces() ) ) );
+
+  for( bool binary : { false, true } )
+  {
+    std::string path = "temp/cube_mesh.ply";
+    write_ply( path, *original, binary );
+    mesh_sptr copy = read_ply( path );
+    EXPECT_TRUE( original->approx_equal( *copy ) ) << "binary: " << binary;
+
+    std::ifstream stream( path.c_str(), std::ios::binary );
+    mesh_sptr stream_copy = read_ply( stream );
+    EXPECT_TRUE( original->approx_equal( *stream_copy ) )
+      << "binary: " << binary;
+  }
+
+  kwiversys::SystemTools::RemoveADirectory( "temp" );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F(mesh_io, read_ply_properties)
+{
+  // float coordinates in a nonstandard order among other properties, and
+  // an element which is not used
+  std::stringstream ss;
+  ss << "ply\n"
+     << "format ascii 1.0\n"
+     << "comment made by hand\n"
+     << "element vertex 3\n"
+     << "property uchar red\n"
+     << "property float z\n"
+     << "property float x\n"
+     << "property float y\n"
+     << "element face 1\n"
+     << "property uchar flags\n"
+     << "property list uchar int vertex_indices\n"
+     << "element edge 1\n"
+     << "property int vertex1\n"
+     << "property int vertex2\n"
+     << "end_header\n"
+     << "255 3 1 2\n"
+     << "0 6 4 5\n"
+     << "\n"
+     << "128 9 7 8\n"
+     << "1 3 2 1 0\n"
+     << "0 1\n";
+  mesh_sptr m = read_ply( ss );
+  ASSERT_EQ( 3, m->num_verts() );
+  ASSERT_EQ( 1, m->num_faces() );
+  auto const& verts = m->vertices();
+  for( unsigned int v = 0; v < 3; ++v )
+  {
+    for( unsigned int i = 0; i < 3; ++i )
+    {
+      EXPECT_EQ( 3 * v + i + 1, verts( v, i ) );
+    }
+  }
+  auto const& faces = m->faces();
+  ASSERT_EQ( 3, faces.num_verts( 0 ) );
+  EXPECT_EQ( 2, faces( 0, 0 ) );
+  EXPECT_EQ( 1, faces( 0, 1 ) );
+  EXPECT_EQ( 0, faces( 0, 2 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F(mesh_io, read_ply_binary_big_endian)
+{
+  std::string data = "ply\n"
+                     "format binary_big_endian 1.0\n"
+                     "element vertex 1\n"
+                     "property short x\n"
+                     "property short y\n"
+                     "property short z\n"
+                     "element face 1\n"
+                     "property list uchar ushort vertex_indices\n"
+                     "end_header\n";
+  char const body[] = { 0, 1, 1, 0, -1, -1, 3, 0, 0, 0, 0, 0, 0 };
+  data.append( body, sizeof( body ) );
+
+  std::stringstream ss( data );
+  mesh_sptr m = read_ply( ss );
+  ASSERT_EQ( 1, m->num_verts() );
+  EXPECT_EQ( 1, m->vertices()( 0, 0 ) );
+  EXPECT_EQ( 256, m->vertices()( 0, 1 ) );
+  EXPECT_EQ( -1, m->vertices()( 0, 2 ) );
+  ASSERT_EQ( 1, m->num_faces() );
+  EXPECT_EQ( 3, m->faces().num_verts( 0 ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F(mesh_io, read_ply_truncated)
+{
+  std::stringstream ascii( "ply\nformat ascii 1.0\nelement vertex 2\n"
+                           "property float x\nproperty float y\n"
+                           "property float z\nend_header\n0 0 0\n1 1\n" );
+  EXPECT_THROW( read_ply( ascii ), invalid_data );
+
+  std::stringstream binary( "ply\nformat binary_little_endian 1.0\n"
+                            "element vertex 2\nproperty float x\n"
+                            "property float y\nproperty float z\n"
+                            "end_header\n0123" );
+  EXPECT_THROW( read_ply( binary ), invalid_data );
+
+  std::stringstream not_ply( "solid cube\n" );
+  EXPECT_THROW( read_ply( not_ply ), invalid_data );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F(mesh_io, read_write_kwm)
+{
+  mesh_sptr irregular = kwiver::testing::cube_mesh( 1.0 );
+  irregular->set_faces( std::unique_ptr<mesh_face_array_base>(
+    new mesh_face_array( irregular->faces() ) ) );
+
+  for( auto const& original :
+       { irregular, kwiver::testing::cube_mesh( 1.0 ), triangle_mesh() } )
+  {
+    std::string path = "temp/cube_mesh.kwm";
+    write_kwm( path, *original );
+    mesh_sptr copy = read_mesh( path );
+    ASSERT_NE( nullptr, copy );
+    EXPECT_EQ( original->faces().regularity(), copy->faces().regularity() );
+    EXPECT_TRUE( original->approx_equal( *copy ) );
+  }
+
+  mesh empty_mesh( std::unique_ptr< mesh_vertex_array_base >(
+                     new mesh_vertex_array< 3 > ),
+                   std::unique_ptr< mesh_face_array_base >(
+                     new mesh_face_array ) );
+  write_kwm( "temp/empty.kwm", empty_mesh );
+  mesh_sptr empty_copy = read_kwm( "temp/empty.kwm" );
+  EXPECT_EQ( 0, empty_copy->num_verts() );
+  EXPECT_EQ( 0, empty_copy->num_faces() );
+
+  // a file cut short is rejected rather than read past its end
+  {
+    std::ofstream truncated( "temp/truncated.kwm", std::ios::binary );
+    std::ostringstream ss;
+    write_kwm( ss, *triangle_mesh() );
+    std::string const data = ss.str();
+    truncated.write( data.data(), data.size() - 4 );
+  }
+  EXPECT_THROW( read_kwm( "temp/truncated.kwm" ), invalid_file );
+
+  kwiversys::SystemTools::RemoveADirectory( "temp" );
+}
+
+// ----------------------------------------------------------------------------
+TEST_F(mesh_io, read_triangles_as_regular)
+{
+  mesh_sptr original = triangle_mesh();
+  // stored as polygons, triangles still read back as a triangle array
+  mesh polygons( *original );
+  polygons.set_faces( std::unique_ptr<mesh_face_array_base>(
+    new mesh_polygon_face_array( original->faces() ) ) );
+
+  for( std::string const ext : { ".ply", ".ply2", ".obj", ".kwm" } )
+  {
+    std::string path = "temp/triangle_mesh" + ext;
+    if( ext == ".ply" ) write_ply( path, polygons, true );
+    else if( ext == ".ply2" ) write_ply2( path, polygons );
+    else if( ext == ".obj" ) write_obj( path, polygons );
+    else write_kwm( path, polygons );
+
+    mesh_sptr copy = read_mesh( path );
+    ASSERT_NE( nullptr, copy ) << ext;
+    EXPECT_EQ( 3, copy->faces().regularity() ) << ext;
+    EXPECT_TRUE( original->approx_equal( *copy ) ) << ext;
+    auto const& tris =
+      static_cast< mesh_regular_face_array< 3 > const& >( copy->faces() );
+    for( unsigned int f = 0; f < original->num_faces(); ++f )
+    {
+      for( unsigned int i = 0; i < 3; ++i )
+      {
+        EXPECT_EQ( original->faces()( f, i ), tris[ f ][ i ] ) << ext;
+      }
+    }
+  }
+
+  kwiversys::SystemTools::RemoveADirectory( "temp" );
+}
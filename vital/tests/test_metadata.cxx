@@ -98,3 +98,57 @@ TEST( metadata, add_metadata )
   EXPECT_EQ( 3, meta_collection.size() );
   EXPECT_FALSE( meta_collection.empty() );
 }
+
+// ----------------------------------------------------------------------------
+TEST( metadata, replace_erase_iterate )
+{
+  metadata meta_collection;
+  meta_collection.add< VITAL_META_UNIX_TIMESTAMP >( 1 );
+  meta_collection.add< VITAL_META_METADATA_ORIGIN >( "origin" );
+  meta_collection.add< VITAL_META_PLATFORM_HEADING_ANGLE >( 1.0 );
+  meta_collection.add< VITAL_META_UNIX_TIMESTAMP >( 2 );
+
+  // Adding an existing tag replaces its item
+  EXPECT_EQ( 3, meta_collection.size() );
+  EXPECT_EQ( 2,
+             meta_collection.find( VITAL_META_UNIX_TIMESTAMP ).as_uint64() );
+
+  // Items are visited in order of tag
+  auto prev_tag = VITAL_META_UNKNOWN;
+  for( auto const& entry : meta_collection )
+  {
+    EXPECT_LT( prev_tag, entry.first );
+    EXPECT_EQ( entry.first, entry.second->tag() );
+    prev_tag = entry.first;
+  }
+
+  EXPECT_TRUE( meta_collection.erase( VITAL_META_METADATA_ORIGIN ) );
+  EXPECT_FALSE( meta_collection.erase( VITAL_META_METADATA_ORIGIN ) );
+  EXPECT_FALSE( meta_collection.has( VITAL_META_METADATA_ORIGIN ) );
+  EXPECT_FALSE( meta_collection.find( VITAL_META_METADATA_ORIGIN ) );
+  EXPECT_EQ( 2, meta_collection.size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST( metadata, copy_metadata )
+{
+  metadata original;
+  original.add< VITAL_META_METADATA_ORIGIN >( "origin" );
+  original.add< VITAL_META_PLATFORM_HEADING_ANGLE >( 1.0 );
+
+  // Copies share the (immutable) items of the original
+  metadata copy{ original };
+  EXPECT_EQ( &original.find( VITAL_META_METADATA_ORIGIN ),
+             &copy.find( VITAL_META_METADATA_ORIGIN ) );
+
+  // Changes to a copy do not affect the original
+  copy.add< VITAL_META_PLATFORM_HEADING_ANGLE >( 2.0 );
+  copy.erase( VITAL_META_METADATA_ORIGIN );
+  EXPECT_EQ( 1.0,
+             original.find( VITAL_META_PLATFORM_HEADING_ANGLE ).as_double() );
+  EXPECT_EQ( 2.0, copy.find( VITAL_META_PLATFORM_HEADING_ANGLE ).as_double() );
+  EXPECT_TRUE( original.has( VITAL_META_METADATA_ORIGIN ) );
+
+  std::unique_ptr< metadata > clone{ original.clone() };
+  EXPECT_TRUE( test_equal_content( original, *clone ) );
+}
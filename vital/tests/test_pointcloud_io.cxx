@@ -0,0 +1,90 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test core pointcloud_io functionality
+
+#include <fstream>
+#include <sstream>
+
+#include <kwiversys/SystemTools.hxx>
+#include <tests/test_gtest.h>
+#include <vital/exceptions.h>
+
+#include <vital/io/pointcloud_io.h>
+
+#include <gtest/gtest.h>
+
+using namespace kwiver::vital;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST(pointcloud_io, read_write_kwp_double)
+{
+  pointcloud_d original( { { 1.0, 2.0, 3.0 }, { -4.5, 5.25, 1e10 } } );
+  original.set_color( { { 255, 0, 10 }, { 1, 2, 3 } } );
+  original.set_intensities( { 7, 200 } );
+
+  std::string const path = "temp/cloud.kwp";
+  write_kwp( path, original );
+  pointcloud_sptr copy = read_kwp( path );
+
+  ASSERT_NE( nullptr, copy );
+  EXPECT_EQ( typeid( double ), copy->data_type() );
+  EXPECT_EQ( original.positions(), copy->positions() );
+  ASSERT_TRUE( copy->has_colors() );
+  auto const colors = copy->colors();
+  EXPECT_EQ( original.colors(), colors );
+  EXPECT_EQ( original.intensities(), copy->intensities() );
+
+  kwiversys::SystemTools::RemoveADirectory( "temp" );
+}
+
+// ----------------------------------------------------------------------------
+TEST(pointcloud_io, read_write_kwp_float)
+{
+  pointcloud_f original( { { 1.5f, 2.0f, 3.0f } } );
+
+  std::string const path = "temp/cloud.kwp";
+  write_kwp( path, original );
+  pointcloud_sptr copy = read_kwp( path );
+
+  ASSERT_NE( nullptr, copy );
+  EXPECT_EQ( typeid( float ), copy->data_type() );
+  EXPECT_EQ( original.positions(), copy->positions() );
+  EXPECT_FALSE( copy->has_colors() );
+  EXPECT_FALSE( copy->has_intensities() );
+
+  kwiversys::SystemTools::RemoveADirectory( "temp" );
+}
+
+// ----------------------------------------------------------------------------
+TEST(pointcloud_io, read_invalid_kwp)
+{
+  EXPECT_THROW( read_kwp( "nonexistant.kwp" ), file_not_found_exception );
+
+  kwiversys::SystemTools::MakeDirectory( "temp" );
+  {
+    std::ofstream bad( "temp/bad.kwp", std::ios::binary );
+    bad << "not a point cloud at all";
+  }
+  EXPECT_THROW( read_kwp( "temp/bad.kwp" ), invalid_file );
+
+  {
+    std::ostringstream ss;
+    write_kwp( ss, pointcloud_d( { { 1.0, 2.0, 3.0 } } ) );
+    std::string const data = ss.str();
+    std::ofstream truncated( "temp/truncated.kwp", std::ios::binary );
+    truncated.write( data.data(), data.size() - 1 );
+  }
+  EXPECT_THROW( read_kwp( "temp/truncated.kwp" ), invalid_file );
+
+  kwiversys::SystemTools::RemoveADirectory( "temp" );
+}
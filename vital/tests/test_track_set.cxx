@@ -4,6 +4,8 @@
 
 #include <vital/tests/test_track_set.h>
 
+#include <vital/types/object_track_set.h>
+
 // ----------------------------------------------------------------------------
 int main( int argc, char** argv )
 {
@@ -46,3 +48,93 @@ TEST(track_set, merge_functions)
   EXPECT_FALSE( test_set_3->empty() );
   ASSERT_EQ( 4, test_set_3->size() );
 }
+
+// ----------------------------------------------------------------------------
+TEST(object_track_set, new_track_states)
+{
+  using namespace kwiver::vital;
+
+  auto make_track = []( track_id_t id, std::vector< frame_id_t > frames ){
+    auto t = track::create();
+    t->set_id( id );
+    for( auto const f : frames )
+    {
+      t->append( std::make_shared< object_track_state >( f, f * 10 ) );
+    }
+    return t;
+  };
+
+  auto const unchanged = make_track( 1, { 0, 1, 2 } );
+  auto const extended = make_track( 2, { 1, 2 } );
+  auto const stale = make_track( 3, { 0 } );
+  object_track_set const before{ { unchanged, extended, stale } };
+
+  auto const extended2 = extended->clone( clone_type::SHALLOW );
+  extended2->append( std::make_shared< object_track_state >( 3, 30 ) );
+  auto const created = make_track( 4, { 3 } );
+  object_track_set const after{
+    { unchanged, extended2, stale->clone(), created } };
+
+  auto const delta = new_track_states( before, after );
+  ASSERT_EQ( 2, delta->size() );
+
+  // New states are copies, leaving the states of the output tracks alone
+  for( auto const id : { track_id_t{ 2 }, track_id_t{ 4 } } )
+  {
+    auto const t = delta->get_track( id );
+    ASSERT_TRUE( t );
+    ASSERT_EQ( 1, t->size() );
+    EXPECT_EQ( 3, t->front()->frame() );
+    EXPECT_EQ( 30, std::static_pointer_cast< object_track_state >(
+                     t->front() )->time() );
+    EXPECT_EQ( t, t->front()->track() );
+    EXPECT_EQ( after.get_track( id ), after.get_track( id )->back()->track() );
+  }
+
+  EXPECT_TRUE( new_track_states( after, after )->empty() );
+  EXPECT_EQ( 4, new_track_states( object_track_set{}, after )->size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(object_track_set, retain_tracks)
+{
+  using namespace kwiver::vital;
+
+  auto make_track = []( track_id_t id, frame_id_t first, frame_id_t last ){
+    auto t = track::create();
+    t->set_id( id );
+    for( auto f = first; f <= last; ++f )
+    {
+      t->append( std::make_shared< object_track_state >( f, f * 10 ) );
+    }
+    return t;
+  };
+
+  auto const stale = make_track( 1, 0, 4 );
+  auto const recent = make_track( 2, 5, 7 );
+  auto const lengthy = make_track( 3, 0, 10 );
+  object_track_set const tracks{ { stale, recent, lengthy } };
+
+  std::vector< track_sptr > terminated;
+  auto const active = retain_tracks( tracks, 10, 5, 4, terminated );
+  ASSERT_EQ( 1, terminated.size() );
+  EXPECT_EQ( stale, terminated[ 0 ] );
+
+  ASSERT_EQ( 2, active->size() );
+  EXPECT_EQ( recent, active->get_track( 2 ) );
+
+  auto const trimmed = active->get_track( 3 );
+  ASSERT_TRUE( trimmed );
+  EXPECT_NE( lengthy, trimmed );
+  ASSERT_EQ( 4, trimmed->size() );
+  EXPECT_EQ( 7, trimmed->first_frame() );
+  EXPECT_EQ( 10, trimmed->last_frame() );
+  EXPECT_EQ( trimmed, trimmed->back()->track() );
+  EXPECT_EQ( 11, lengthy->size() );
+
+  // Zero limits keep everything
+  terminated.clear();
+  auto const all = retain_tracks( tracks, 100, 0, 0, terminated );
+  EXPECT_TRUE( terminated.empty() );
+  EXPECT_EQ( tracks.tracks(), all->tracks() );
+}
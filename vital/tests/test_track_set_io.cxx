@@ -0,0 +1,190 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test KWT object track io functions
+
+#include <test_tmpfn.h>
+
+#include <vital/exceptions.h>
+#include <vital/io/track_set_io.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <sstream>
+
+using namespace kwiver::vital;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Tracks with and without detections and class scores, with gaps
+object_track_set_sptr
+make_tracks()
+{
+  std::vector< track_sptr > tracks;
+  for( track_id_t id : { 7, 2, 11 } )
+  {
+    auto trk = track::create();
+    trk->set_id( id );
+    for( frame_id_t f = id % 3; f < 20; f += 1 + id % 2 )
+    {
+      detected_object_sptr det;
+      if( f % 4 )
+      {
+        detected_object_type_sptr type;
+        if( f % 3 )
+        {
+          type = std::make_shared< detected_object_type >();
+          type->set_score( "kwt_class_" + std::to_string( f % 5 ), 0.1 * f );
+          type->set_score( "kwt_class_" + std::to_string( id ), 1.0 / id );
+        }
+        det = std::make_shared< detected_object >(
+          bounding_box_d{ 1.5 * f, 2.0 * id, 1.5 * f + 10, 2.0 * id + 7.25 },
+          0.01 * f, type );
+      }
+      trk->append(
+        std::make_shared< object_track_state >( f, f * 1000 + id, det ) );
+    }
+    tracks.push_back( trk );
+  }
+  return std::make_shared< object_track_set >( tracks );
+}
+
+// ----------------------------------------------------------------------------
+void
+expect_same_state( track_state_sptr const& expected,
+                   track_state_sptr const& actual )
+{
+  auto const es = std::dynamic_pointer_cast< object_track_state >( expected );
+  auto const as = std::dynamic_pointer_cast< object_track_state >( actual );
+  ASSERT_TRUE( es && as );
+  EXPECT_EQ( es->frame(), as->frame() );
+  EXPECT_EQ( es->time(), as->time() );
+
+  auto const ed = es->detection();
+  auto const ad = as->detection();
+  ASSERT_EQ( !ed, !ad );
+  if( !ed )
+  {
+    return;
+  }
+  EXPECT_EQ( ed->bounding_box(), ad->bounding_box() );
+  EXPECT_EQ( ed->confidence(), ad->confidence() );
+
+  auto const et = ed->type();
+  auto const at = ad->type();
+  ASSERT_EQ( !et, !at );
+  if( et )
+  {
+    EXPECT_EQ( et->class_names(), at->class_names() );
+    for( auto const& name : et->class_names() )
+    {
+      EXPECT_EQ( et->score( name ), at->score( name ) );
+    }
+  }
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+TEST(track_set_io, kwt_round_trip)
+{
+  auto const tracks = make_tracks();
+
+  std::stringstream str;
+  write_kwt( str, *tracks );
+
+  auto const file_name = kwiver::testing::temp_file_name( "test-", ".kwt" );
+  write_kwt( file_name, *tracks );
+
+  kwt_reader const stream_reader{ str };
+  kwt_reader const file_reader{ file_name };
+  for( auto const* reader : { &stream_reader, &file_reader } )
+  {
+    auto const result = reader->read_all();
+    ASSERT_EQ( tracks->size(), result->size() );
+    for( auto const& expected : tracks->tracks() )
+    {
+      auto const actual = result->get_track( expected->id() );
+      ASSERT_TRUE( actual );
+      ASSERT_EQ( expected->size(), actual->size() );
+      for( auto e = expected->begin(), a = actual->begin();
+           e != expected->end(); ++e, ++a )
+      {
+        expect_same_state( *e, *a );
+      }
+    }
+  }
+
+  EXPECT_EQ( tracks->all_frame_ids(),
+             std::set< frame_id_t >( file_reader.frames().begin(),
+                                     file_reader.frames().end() ) );
+  std::remove( file_name.c_str() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(track_set_io, kwt_read_frame)
+{
+  auto const tracks = make_tracks();
+
+  std::stringstream str;
+  write_kwt( str, *tracks );
+  kwt_reader const reader{ str };
+
+  size_t states = 0;
+  for( frame_id_t f = 0; f < 22; ++f )
+  {
+    SCOPED_TRACE( f );
+
+    auto const expected = tracks->frame_states( f );
+    auto const actual = reader.read_frame( f );
+    ASSERT_EQ( expected.size(), actual->size() );
+    states += expected.size();
+
+    track_id_t last_id = -1;
+    for( auto const& trk : actual->tracks() )
+    {
+      ASSERT_EQ( 1, trk->size() );
+      EXPECT_LT( last_id, trk->id() );
+      last_id = trk->id();
+      expect_same_state( *tracks->get_track( trk->id() )->find( f ),
+                         trk->front() );
+    }
+  }
+  EXPECT_EQ( states, reader.num_states() );
+  EXPECT_EQ( 0, reader.read_frame( -1 )->size() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(track_set_io, kwt_invalid_data)
+{
+  std::stringstream str;
+  write_kwt( str, *make_tracks() );
+  auto const data = str.str();
+
+  for( auto const& bad :
+       { std::string{}, std::string{ "not a KWT file" },
+         data.substr( 0, data.size() - 1 ), data + "x" } )
+  {
+    std::istringstream in{ bad };
+    EXPECT_THROW( kwt_reader{ in }, invalid_data );
+  }
+
+  EXPECT_THROW( kwt_reader{ "/no/such/file.kwt" }, file_not_found_exception );
+
+  std::stringstream empty;
+  write_kwt( empty, object_track_set{} );
+  kwt_reader const reader{ empty };
+  EXPECT_TRUE( reader.frames().empty() );
+  EXPECT_EQ( 0, reader.read_all()->size() );
+}
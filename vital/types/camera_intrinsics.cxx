@@ -55,6 +55,19 @@ ::map( const vector_3d& norm_hpt ) const
                                norm_hpt[1] / norm_hpt[2] ) );
 }
 
+/// Map 3D points in camera coordinates into actual image coordinates
+matrix_Xx2d
+camera_intrinsics
+::map_points( const matrix_Xx3d& norm_hpts ) const
+{
+  matrix_Xx2d pts( norm_hpts.rows(), 2 );
+  for ( Eigen::Index i = 0; i < norm_hpts.rows(); ++i )
+  {
+    pts.row( i ) = this->map( vector_3d( norm_hpts.row( i ).transpose() ) );
+  }
+  return pts;
+}
+
 /// Unmap actual image coordinates back into normalized image coordinates
 vector_2d
 camera_intrinsics
@@ -228,6 +241,57 @@ ::distort( const vector_2d& norm_pt ) const
   return scale * norm_pt + offset;
 }
 
+/// Map 3D points in camera coordinates into actual image coordinates
+matrix_Xx2d
+simple_camera_intrinsics
+::map_points( const matrix_Xx3d& norm_hpts ) const
+{
+  // The same distortion as distortion_scale_offset(), applied to whole
+  // columns of coordinates
+  const Eigen::ArrayXd x = norm_hpts.col( 0 ).array() / norm_hpts.col( 2 ).array();
+  const Eigen::ArrayXd y = norm_hpts.col( 1 ).array() / norm_hpts.col( 2 ).array();
+  Eigen::ArrayXd dx = x;
+  Eigen::ArrayXd dy = y;
+
+  const vector_t& d = dist_coeffs_;
+  if ( d.rows() > 0 )
+  {
+    const Eigen::ArrayXd x2 = x * x;
+    const Eigen::ArrayXd y2 = y * y;
+    const Eigen::ArrayXd r2 = x2 + y2;
+
+    Eigen::ArrayXd scale = 1.0 + r2 * d[0];
+    if ( d.rows() > 1 )
+    {
+      const Eigen::ArrayXd r4 = r2 * r2;
+      scale += r4 * d[1];
+      if ( d.rows() > 4 )
+      {
+        const Eigen::ArrayXd r6 = r2 * r4;
+        scale += r6 * d[4];
+        if ( d.rows() > 7 )
+        {
+          scale /= 1.0 + r2 * d[5] + r4 * d[6] + r6 * d[7];
+        }
+      }
+    }
+
+    dx = x * scale;
+    dy = y * scale;
+    if ( d.rows() > 3 )
+    {
+      const Eigen::ArrayXd two_xy = 2.0 * x * y;
+      dx += d[2] * two_xy + d[3] * ( r2 + 2.0 * x2 );
+      dy += d[3] * two_xy + d[2] * ( r2 + 2.0 * y2 );
+    }
+  }
+
+  matrix_Xx2d pts( norm_hpts.rows(), 2 );
+  pts.col( 0 ) = ( dx * focal_length_ + dy * skew_ + principal_point_.x() ).matrix();
+  pts.col( 1 ) = ( dy * focal_length_ / aspect_ratio_ + principal_point_.y() ).matrix();
+  return pts;
+}
+
 /// Unnap distorted normalized coordinates into normalized coordinates
 vector_2d
 simple_camera_intrinsics
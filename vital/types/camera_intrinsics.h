@@ -68,6 +68,13 @@ class VITAL_EXPORT camera_intrinsics
   /// Map a 3D point in camera coordinates into actual image coordinates
   virtual vector_2d map(const vector_3d& norm_hpt) const;
 
+  /// Map 3D points in camera coordinates into actual image coordinates
+  ///
+  ///  Each row of \p norm_hpts is a point, and the result has a row of
+  ///  image coordinates for each. The default implementation maps one
+  ///  point at a time.
+  virtual matrix_Xx2d map_points(const matrix_Xx3d& norm_hpts) const;
+
   /// Unmap actual image coordinates back into normalized image coordinates
   ///
   ///  This function applies both application of the inverse calibration matrix
@@ -221,6 +228,12 @@ class VITAL_EXPORT simple_camera_intrinsics :
     max_distort_radius_sq_ = compute_max_distort_radius_sq();
   }
 
+  /// Map 3D points in camera coordinates into actual image coordinates
+  ///
+  ///  This applies the distortion to all points at once with array
+  ///  operations.
+  virtual matrix_Xx2d map_points(const matrix_Xx3d& norm_hpts) const;
+
   /// Map normalized image coordinates into distorted coordinates
   virtual vector_2d distort(const vector_2d& norm_pt) const;
 
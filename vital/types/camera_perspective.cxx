@@ -57,6 +57,17 @@ ::project( const vector_3d& pt ) const
   return this->intrinsics()->map( this->rotation() * ( pt - this->center() ));
 }
 
+/// Project 3D points into 2D image points
+matrix_Xx2d
+camera_perspective
+::project_points( const matrix_Xx3d& pts ) const
+{
+  const matrix_Xx3d cam_pts =
+    ( pts.rowwise() - this->center().transpose() ) *
+    this->rotation().matrix().transpose();
+  return this->intrinsics()->map_points( cam_pts );
+}
+
 /// Compute the distance of the 3D point to the image plane
 double
 camera_perspective
@@ -86,6 +86,15 @@ class VITAL_EXPORT camera_perspective : public camera
   /// Project a 3D point into a 2D image point
   virtual vector_2d project( const vector_3d& pt ) const;
 
+  /// Project 3D points into 2D image points
+  ///
+  /// Each row of \p pts is a point, and the result has a row of image
+  /// coordinates for each. The points are moved into the camera frame with
+  /// one matrix product and then mapped by camera_intrinsics::map_points(),
+  /// which applies the distortion to all of them at once for simple
+  /// intrinsics.
+  matrix_Xx2d project_points( const matrix_Xx3d& pts ) const;
+
   /// Compute the distance of the 3D point to the image plane
   ///
   ///  Points with negative depth are behind the camera
@@ -8,6 +8,7 @@
 
 #include <vital/types/camera_rpc.h>
 #include <vital/io/eigen_io.h>
+#include <vital/util/thread_pool.h>
 #include <Eigen/Geometry>
 
 #include <iomanip>
@@ -15,6 +16,14 @@
 namespace kwiver {
 namespace vital {
 
+namespace {
+
+// Points handled by one task of a batch, and evaluated together by one
+// matrix product when projecting
+constexpr size_t batch_chunk_size = 256;
+
+} // end namespace
+
 camera_rpc
 ::camera_rpc()
   : m_logger( kwiver::vital::get_logger( "vital.camera_rpc" ) )
@@ -47,6 +56,17 @@ ::back_project( const vector_2d& image_pt, double elev ) const
     ( image_pt - image_offset() ).cwiseQuotient( image_scale() );
   auto norm_elev = ( elev - world_offset()[2] ) / world_scale()[2];
 
+  vector_3d rslt = back_project_normalized( norm_pt, norm_elev, rpc_coeffs() );
+
+  return rslt.cwiseProduct( this->world_scale() ) + this->world_offset();
+}
+
+/// Back project a normalized image point to a normalized elevation
+vector_3d
+camera_rpc
+::back_project_normalized( const vector_2d& norm_pt, double norm_elev,
+                           const rpc_matrix& coeffs ) const
+{
   // Use a first order approximation to the RPC to initialize.
   // This sets all non-linear terms of the RPC to zero and then forms
   // a least squares solution to invert the mapping.
@@ -54,15 +74,15 @@ ::back_project( const vector_2d& image_pt, double elev ) const
   vector_3d rslt( 0., 0., norm_elev );
   vector_2d b;
 
-  A.block<1, 2>( 0, 0 ) = rpc_coeffs().block<1, 2>( 0, 1 )
-                           - norm_pt[0] * rpc_coeffs().block<1, 2>( 1, 1 );
-  A.block<1, 2>( 1, 0 ) = rpc_coeffs().block<1, 2>( 2, 1 );
-                           - norm_pt[1] * rpc_coeffs().block<1, 2>( 3, 1 );
+  A.block<1, 2>( 0, 0 ) = coeffs.block<1, 2>( 0, 1 )
+                           - norm_pt[0] * coeffs.block<1, 2>( 1, 1 );
+  A.block<1, 2>( 1, 0 ) = coeffs.block<1, 2>( 2, 1 );
+                           - norm_pt[1] * coeffs.block<1, 2>( 3, 1 );
 
-  b[0] = ( rpc_coeffs()( 1, 0 ) + norm_elev*rpc_coeffs()( 1, 3 ) )*norm_pt[0]
-         - ( rpc_coeffs()( 0, 0 ) + norm_elev*rpc_coeffs()( 0, 3 ) );
-  b[1] = ( rpc_coeffs()( 3, 0 ) + norm_elev*rpc_coeffs()( 3, 3 ) )*norm_pt[1]
-         - ( rpc_coeffs()( 2, 0 ) + norm_elev*rpc_coeffs()( 2, 3 ) );
+  b[0] = ( coeffs( 1, 0 ) + norm_elev*coeffs( 1, 3 ) )*norm_pt[0]
+         - ( coeffs( 0, 0 ) + norm_elev*coeffs( 0, 3 ) );
+  b[1] = ( coeffs( 3, 0 ) + norm_elev*coeffs( 3, 3 ) )*norm_pt[1]
+         - ( coeffs( 2, 0 ) + norm_elev*coeffs( 2, 3 ) );
 
   rslt.head(2) = A.colPivHouseholderQr().solve( b );
 
@@ -83,7 +103,71 @@ ::back_project( const vector_2d& image_pt, double elev ) const
     }
   }
 
-  return rslt.cwiseProduct( this->world_scale() ) + this->world_offset();
+  return rslt;
+}
+
+/// Project an array of 3D points into 2D image points
+void
+camera_rpc
+::project( const vector_3d* pts, vector_2d* image_pts, size_t count ) const
+{
+  // Fetch the model once rather than for every point
+  rpc_matrix const coeffs = rpc_coeffs();
+  vector_3d const w_scale = world_scale();
+  vector_3d const w_offset = world_offset();
+  vector_2d const i_scale = image_scale();
+  vector_2d const i_offset = image_offset();
+
+  thread_pool::instance().parallel_for(
+    count, batch_chunk_size,
+    [&]( size_t begin, size_t end )
+    {
+      // One column of powers per point, so the four polynomials of the
+      // whole chunk are one matrix product
+      Eigen::Matrix<double, 20, Eigen::Dynamic> powers( 20, end - begin );
+      for ( size_t i = begin; i < end; ++i )
+      {
+        powers.col( i - begin ) =
+          power_vector( ( pts[i] - w_offset ).cwiseQuotient( w_scale ) );
+      }
+
+      Eigen::Matrix<double, 4, Eigen::Dynamic> const polys = coeffs * powers;
+
+      for ( size_t i = begin; i < end; ++i )
+      {
+        auto const p = polys.col( i - begin );
+        vector_2d const image_pt( p[0] / p[1], p[2] / p[3] );
+        image_pts[i] = image_pt.cwiseProduct( i_scale ) + i_offset;
+      }
+    } );
+}
+
+/// Project an array of 2D image points back to 3D points in space
+void
+camera_rpc
+::back_project( const vector_2d* image_pts, const double* elevs,
+                vector_3d* pts, size_t count ) const
+{
+  rpc_matrix const coeffs = rpc_coeffs();
+  vector_3d const w_scale = world_scale();
+  vector_3d const w_offset = world_offset();
+  vector_2d const i_scale = image_scale();
+  vector_2d const i_offset = image_offset();
+
+  thread_pool::instance().parallel_for(
+    count, batch_chunk_size,
+    [&]( size_t begin, size_t end )
+    {
+      for ( size_t i = begin; i < end; ++i )
+      {
+        vector_2d const norm_pt =
+          ( image_pts[i] - i_offset ).cwiseQuotient( i_scale );
+        double const norm_elev = ( elevs[i] - w_offset[2] ) / w_scale[2];
+
+        pts[i] = back_project_normalized( norm_pt, norm_elev, coeffs )
+                   .cwiseProduct( w_scale ) + w_offset;
+      }
+    } );
 }
 
 Eigen::Matrix<double, 20, 1>
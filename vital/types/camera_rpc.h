@@ -70,9 +70,39 @@ class VITAL_EXPORT camera_rpc : public camera
   /// Project a 2D image back to a 3D point in space
   virtual vector_3d back_project( const vector_2d& image_pt, double elev ) const;
 
+  /// Project an array of 3D points into 2D image points
+  ///
+  /// This gives the same results as projecting each point in turn, but
+  /// evaluates the polynomials for many points with each matrix product
+  /// and spreads the points over the threads of the vital thread pool.
+  ///
+  /// \param pts The \p count points to project.
+  /// \param image_pts Receives the \p count projected points.
+  /// \param count The number of points.
+  void project( const vector_3d* pts, vector_2d* image_pts,
+                size_t count ) const;
+
+  /// Project an array of 2D image points back to 3D points in space
+  ///
+  /// This gives the same results as back projecting each point in turn,
+  /// using the threads of the vital thread pool.
+  ///
+  /// \param image_pts The \p count image points to back project.
+  /// \param elevs The elevation of each point.
+  /// \param pts Receives the \p count back projected points.
+  /// \param count The number of points.
+  void back_project( const vector_2d* image_pts, const double* elevs,
+                     vector_3d* pts, size_t count ) const;
+
 protected:
   camera_rpc();
 
+  // Back project a normalized image point to a normalized elevation,
+  // using RPC coefficients the caller has already fetched
+  vector_3d back_project_normalized( const vector_2d& norm_pt,
+                                     double norm_elev,
+                                     const rpc_matrix& coeffs ) const;
+
   // Compute the Jacobian of the RPC at the given normalized world point
   // Currently this only computes the 2x2 Jacobian for X and Y parameters.
   // This function also returns the normalized projected point
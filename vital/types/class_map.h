@@ -11,10 +11,9 @@
 #include <vital/signal.h>
 
 #include <limits>
-#include <map>
 #include <memory>
-#include <mutex>
-#include <unordered_set>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace kwiver {
@@ -40,14 +39,22 @@ namespace vital {
 /// Note that the list of possible names is managed through a class
 /// static string pool. Every effort has been made to make this pool
 /// externally unmutable. Your cooperation is appreciated.
+///
+/// Each name in the pool is also given a class id, a small integer in the
+/// order the names were first seen. Scores are kept in a vector ordered by
+/// class id, and may be accessed by id to avoid looking up names. Looking
+/// up a name which is already in the pool does not take a lock.
 template < typename T >
 class class_map
 {
 public:
   static constexpr double INVALID_SCORE = std::numeric_limits< double >::min();
 
-  using class_map_t = std::map< std::string const*, double >;
-  using class_const_iterator_t = class_map_t::const_iterator;
+  /// Identifier of a class name in the pool
+  using class_id_t = unsigned;
+
+  using class_map_t = std::vector< std::pair< std::string const*, double > >;
+  using class_const_iterator_t = typename class_map_t::const_iterator;
 
   /// @brief Create an empty object.
   ///
@@ -103,6 +110,31 @@ class class_map
   /// @return Score for selected class_name.
   double score( const std::string& class_name ) const;
 
+  /// @brief Determine if a class id is present.
+  ///
+  /// @param class_id Class id to test.
+  ///
+  /// @return \b true if the class with this id is present.
+  bool has_class_id( class_id_t class_id ) const;
+
+  /// @brief Get score for specific class id.
+  ///
+  /// @param class_id Return score for this entry.
+  ///
+  /// @throws std::runtime_error If the class with this id is not
+  /// associated with this object.
+  ///
+  /// @return Score for selected class.
+  double score( class_id_t class_id ) const;
+
+  /// @brief Get the class ids of this object.
+  ///
+  /// The ids are in increasing order, which is also the order in which
+  /// begin() and end() visit the classes.
+  ///
+  /// @return Class ids of this object.
+  std::vector< class_id_t > const& class_ids() const { return m_ids; }
+
   /// @brief Get max class name.
   ///
   /// This method returns the most likely class for this object.
@@ -144,6 +176,14 @@ class class_map
   /// @param score Score value for class_name
   void set_score( const std::string& class_name, double score );
 
+  /// @brief Set score for a class id.
+  ///
+  /// @param class_id Class id, as returned by class_id().
+  /// @param score Score value for the class
+  ///
+  /// @throws std::out_of_range If no class name has this id.
+  void set_score( class_id_t class_id, double score );
+
   /// @brief Remove score and class_name.
   ///
   /// This method removes the type entry for the specified
@@ -181,8 +221,7 @@ class class_map
   /// @brief Get start iterator to all class/score pairs.
   ///
   /// This method returns an iterator that may be used to iterate over all
-  /// class/score pairs. The order in which items will be seen by this iterator
-  /// is unspecified.
+  /// class/score pairs. Items are seen in increasing order of class id.
   ///
   /// @return Start iterator to all class/score pairs.
   ///
@@ -204,6 +243,34 @@ class class_map
   class_const_iterator_t cend() const;
   //@}
 
+  /// @brief Get the id of a class name.
+  ///
+  /// The name is added to the pool of class names if it is not already
+  /// there.
+  ///
+  /// @param class_name Class name.
+  ///
+  /// @return Id of the class name.
+  static class_id_t class_id( const std::string& class_name );
+
+  /// @brief Get the id of a class name if it is in the pool.
+  ///
+  /// @param class_name Class name.
+  /// @param[out] class_id Id of the class name, if found.
+  ///
+  /// @return \b true if the class name is in the pool.
+  static bool find_class_id( const std::string& class_name,
+                             class_id_t& class_id );
+
+  /// @brief Get the class name with an id.
+  ///
+  /// @param class_id Class id.
+  ///
+  /// @throws std::out_of_range If no class name has this id.
+  ///
+  /// @return Class name, which remains valid for the life of the program.
+  static std::string const& class_name( class_id_t class_id );
+
   /// @brief Get list of all class_names in use.
   ///
   /// This method returns an ordered vector of all class_name strings.
@@ -230,24 +297,19 @@ class class_map
   static signal< std::string const& > class_name_added;
 
 private:
-  const std::string* find_string( const std::string& str ) const;
+  struct name_registry;
 
-  /// Set of possible classes for this object.
-  ///
-  /// This map represents the ordered set of possibilities for this
-  /// object along with the class names.
-  class_map_t m_classes;
+  /// Shared pool of class names, which readers use without a lock.
+  static name_registry& registry();
 
-  /// @brief Set of all class_names used.
-  ///
-  /// This set of strings represents the superset of all class_names
-  /// used to classify objects. Strings are added to this set when a
-  /// previously unseen class_name is passed to the CTOR or
-  /// set_score().
-  static std::unordered_set< std::string > s_master_name_set;
+  /// Position of a class id in m_ids, or where it would be inserted
+  size_t position( class_id_t class_id ) const;
 
-  // Used to control access to shared resources
-  static std::mutex s_table_mutex;
+  /// Ids of the classes of this object, in increasing order.
+  std::vector< class_id_t > m_ids;
+
+  /// Class names and scores of this object, in the order of m_ids.
+  class_map_t m_classes;
 };
 
 } // namespace vital
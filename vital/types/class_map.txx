@@ -8,6 +8,11 @@
 #include <sstream>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace kwiver {
 
@@ -19,15 +24,143 @@ signal< std::string const& >
 class_map< T >
 ::class_name_added;
 
+// ----------------------------------------------------------------------------
+/// @brief Shared pool of class names.
+///
+/// Names are only ever added, so readers use the pool without a lock. A name
+/// is stored and indexed before the count which makes it visible is
+/// published. Names live in chunks which double in size and never move, and
+/// names are found through an open addressing hash table of ids which is
+/// replaced by one twice the size when half full. Replaced tables are kept,
+/// since readers may still be probing them. Adding N names thus takes O(N)
+/// time and memory in all.
 template < typename T >
-std::unordered_set< std::string >
-class_map< T >
-::s_master_name_set;
+struct class_map< T >::name_registry
+{
+  /// Size of the first chunk of names; each chunk is twice the previous one
+  static constexpr size_t first_chunk = 64;
+  static constexpr size_t max_chunks = 32;
 
-template < typename T >
-std::mutex
-class_map< T >
-::s_table_mutex;
+  /// Hash table from names to ids
+  struct index
+  {
+    explicit index( size_t size )
+      : mask( size - 1 ),
+        slots( new std::atomic< class_id_t >[ size ] )
+    {
+      for ( size_t i = 0; i < size; ++i )
+      {
+        slots[ i ].store( 0, std::memory_order_relaxed );
+      }
+    }
+
+    size_t const mask;
+
+    /// One more than the id of the name in each slot, or 0 if empty
+    std::unique_ptr< std::atomic< class_id_t >[] > slots;
+  };
+
+  name_registry()
+  {
+    indexes.emplace_back( new index{ 2 * first_chunk } );
+    current.store( indexes.back().get(), std::memory_order_relaxed );
+  }
+
+  /// Chunk holding an id; chunk k holds the ids from first_chunk * (2^k - 1)
+  static size_t chunk_of( class_id_t id )
+  {
+    size_t const j = id / first_chunk + 1;
+    size_t k = 0;
+    while ( j >> ( k + 1 ) )
+    {
+      ++k;
+    }
+    return k;
+  }
+
+  /// Name of a visible id
+  std::string const& name( class_id_t id ) const
+  {
+    auto const k = chunk_of( id );
+    return chunks[ k ][ id - first_chunk * ( ( size_t{ 1 } << k ) - 1 ) ];
+  }
+
+  /// Find the id of a name, if it was visible in the current index
+  bool find( std::string const& class_name, class_id_t& id ) const
+  {
+    auto const& idx = *current.load( std::memory_order_acquire );
+    for ( size_t i = std::hash< std::string >{}( class_name ) & idx.mask;;
+          i = ( i + 1 ) & idx.mask )
+    {
+      auto const slot = idx.slots[ i ].load( std::memory_order_acquire );
+      if ( ! slot )
+      {
+        return false;
+      }
+      if ( name( slot - 1 ) == class_name )
+      {
+        id = slot - 1;
+        return true;
+      }
+    }
+  }
+
+  /// Put an id in a table which has room for it
+  void insert( index& idx, class_id_t id )
+  {
+    size_t i = std::hash< std::string >{}( name( id ) ) & idx.mask;
+    while ( idx.slots[ i ].load( std::memory_order_relaxed ) )
+    {
+      i = ( i + 1 ) & idx.mask;
+    }
+    idx.slots[ i ].store( id + 1, std::memory_order_release );
+  }
+
+  /// Add a name which is not in the pool; the caller must hold mutex
+  class_id_t add( std::string const& class_name )
+  {
+    auto const id = static_cast< class_id_t >( count.load() );
+
+    // Store the name, starting a new chunk if the last one is full
+    auto const k = chunk_of( id );
+    if ( ! chunks[ k ] )
+    {
+      chunks[ k ].reset( new std::string[ first_chunk << k ] );
+    }
+    chunks[ k ][ id - first_chunk * ( ( size_t{ 1 } << k ) - 1 ) ] =
+      class_name;
+
+    // Index it, replacing a half full table with one twice the size
+    auto idx = indexes.back().get();
+    if ( 2 * ( size_t{ id } + 1 ) > idx->mask + 1 )
+    {
+      indexes.emplace_back( new index{ 2 * ( idx->mask + 1 ) } );
+      idx = indexes.back().get();
+      for ( class_id_t i = 0; i < id; ++i )
+      {
+        insert( *idx, i );
+      }
+    }
+    insert( *idx, id );
+    current.store( idx, std::memory_order_release );
+
+    count.store( size_t{ id } + 1, std::memory_order_release );
+    return id;
+  }
+
+  /// Serializes adding names
+  std::mutex mutex;
+
+  /// Names, by id
+  std::unique_ptr< std::string[] > chunks[ max_chunks ];
+
+  /// Number of names visible to readers
+  std::atomic< size_t > count{ 0 };
+
+  /// Latest hash table, and every one before it, guarded by mutex
+  std::atomic< index* > current;
+  std::vector< std::unique_ptr< index > > indexes;
+};
 
 namespace {
 
@@ -104,14 +237,8 @@ bool
 class_map< T >
 ::has_class_name( const std::string& class_name ) const
 {
-  try
-  {
-    const std::string* str_ptr = find_string( class_name );
-    return ( 0 != m_classes.count( str_ptr ) );
-  }
-  catch ( ... ) {}
-
-  return false;
+  class_id_t id;
+  return find_class_id( class_name, id ) && has_class_id( id );
 }
 
 // ----------------------------------------------------------------------------
@@ -120,9 +247,16 @@ double
 class_map< T >
 ::score( const std::string& class_name ) const
 {
-  const std::string* str_ptr = find_string( class_name );
+  class_id_t id;
+  if ( ! find_class_id( class_name, id ) )
+  {
+    // Name not associated with any object
+    std::stringstream sstr;
+    sstr << "Class name \"" << class_name << "\" is not associated with any object";
+    throw std::runtime_error( sstr.str() );
+  }
 
-  if ( 0 == m_classes.count( str_ptr ) )
+  if ( ! has_class_id( id ) )
   {
     // Name not associated with this object
     std::stringstream sstr;
@@ -130,8 +264,34 @@ ::score( const std::string& class_name ) const
     throw std::runtime_error( sstr.str() );
   }
 
-  auto it = m_classes.find( str_ptr );
-  return it->second; // return score
+  return m_classes[ position( id ) ].second;
+}
+
+// ----------------------------------------------------------------------------
+template < typename T >
+bool
+class_map< T >
+::has_class_id( class_id_t class_id ) const
+{
+  auto const i = position( class_id );
+  return i < m_ids.size() && m_ids[ i ] == class_id;
+}
+
+// ----------------------------------------------------------------------------
+template < typename T >
+double
+class_map< T >
+::score( class_id_t class_id ) const
+{
+  if ( ! has_class_id( class_id ) )
+  {
+    // Id not associated with this object
+    std::stringstream sstr;
+    sstr << "Class id " << class_id << " is not associated with this object";
+    throw std::runtime_error( sstr.str() );
+  }
+
+  return m_classes[ position( class_id ) ].second;
 }
 
 // ----------------------------------------------------------------------------
@@ -176,22 +336,27 @@ void
 class_map< T >
 ::set_score( const std::string& class_name, double score )
 {
-  // Check to see if class_name is in the master set.
-  // If not, add it
-  std::lock_guard< std::mutex > lock{ s_table_mutex };
-  auto it = s_master_name_set.find( class_name );
-  if ( it == s_master_name_set.end() )
+  // Adds class_name to the master set if it is not there
+  set_score( class_id( class_name ), score );
+}
+
+// ----------------------------------------------------------------------------
+template < typename T >
+void
+class_map< T >
+::set_score( class_id_t class_id, double score )
+{
+  auto const i = position( class_id );
+  if ( i < m_ids.size() && m_ids[ i ] == class_id )
   {
-    auto result = s_master_name_set.insert( class_name );
-    class_name_added( class_name );
-    it = result.first;
+    m_classes[ i ].second = score;
+    return;
   }
 
-  // Resolve string to canonical pointer
-  const std::string* str_ptr = &(*it);
-
-  // Insert new entry into map
-  m_classes[str_ptr] = score;
+  // Insert new entry, keeping the ids in order
+  auto const name = &class_name( class_id );
+  m_ids.insert( m_ids.begin() + i, class_id );
+  m_classes.insert( m_classes.begin() + i, { name, score } );
 }
 
 // ----------------------------------------------------------------------------
@@ -200,8 +365,16 @@ void
 class_map< T >
 ::delete_score( const std::string& class_name )
 {
-  auto str_ptr = find_string( class_name );
-  if ( 0 == m_classes.count( str_ptr ) )
+  class_id_t id;
+  if ( ! find_class_id( class_name, id ) )
+  {
+    // Name not associated with any object
+    std::stringstream sstr;
+    sstr << "Class name \"" << class_name << "\" is not associated with any object";
+    throw std::runtime_error( sstr.str() );
+  }
+
+  if ( ! has_class_id( id ) )
   {
     // Name not associated with this object
     std::stringstream sstr;
@@ -209,7 +382,9 @@ ::delete_score( const std::string& class_name )
     throw std::runtime_error( sstr.str() );
   }
 
-  m_classes.erase( str_ptr );
+  auto const i = position( id );
+  m_ids.erase( m_ids.begin() + i );
+  m_classes.erase( m_classes.begin() + i );
 }
 
 // ----------------------------------------------------------------------------
@@ -221,7 +396,7 @@ ::class_names( double threshold ) const
   std::vector< std::pair< const std::string*, double > > items( m_classes.begin(), m_classes.end() );
 
   // sort map by value descending order
-  std::sort( items.begin(), items.end(), more_second< const std::string*, double > () );
+  std::stable_sort( items.begin(), items.end(), more_second< const std::string*, double > () );
 
   std::vector< std::string > list;
 
@@ -285,34 +460,77 @@ ::cend() const
 }
 
 // ----------------------------------------------------------------------------
-/// @brief Resolve string to pointer.
-///
-/// This method resolves the supplied string to a pointer to the
-/// canonical version in the master set. This is needed because the
-/// class_names in this class refer to these strings by address, so we
-/// need an address to look up in the map.
-///
-/// @param str String to resolve
-///
-/// @return Address of string in master list.
-///
-/// @throws std::runtime_error if the string is not in the global set.
 template < typename T >
-const std::string*
+size_t
 class_map< T >
-::find_string( const std::string& str ) const
+::position( class_id_t class_id ) const
 {
-  std::lock_guard< std::mutex > lock{ s_table_mutex };
-  auto it = s_master_name_set.find( str );
-  if ( it == s_master_name_set.end() )
+  return static_cast< size_t >(
+    std::lower_bound( m_ids.begin(), m_ids.end(), class_id ) - m_ids.begin() );
+}
+
+// ----------------------------------------------------------------------------
+template < typename T >
+typename class_map< T >::name_registry&
+class_map< T >
+::registry()
+{
+  static name_registry instance;
+  return instance;
+}
+
+// ----------------------------------------------------------------------------
+template < typename T >
+bool
+class_map< T >
+::find_class_id( const std::string& class_name, class_id_t& class_id )
+{
+  return registry().find( class_name, class_id );
+}
+
+// ----------------------------------------------------------------------------
+template < typename T >
+typename class_map< T >::class_id_t
+class_map< T >
+::class_id( const std::string& class_name )
+{
+  class_id_t id;
+  if ( find_class_id( class_name, id ) )
+  {
+    return id;
+  }
+
+  // Add the name under the lock, unless another thread just did
+  {
+    auto& reg = registry();
+    std::lock_guard< std::mutex > lock{ reg.mutex };
+    if ( reg.find( class_name, id ) )
+    {
+      return id;
+    }
+    id = reg.add( class_name );
+  }
+
+  // Slots may use this class, so call them without the lock
+  class_name_added( class_name );
+  return id;
+}
+
+// ----------------------------------------------------------------------------
+template < typename T >
+std::string const&
+class_map< T >
+::class_name( class_id_t class_id )
+{
+  auto const& reg = registry();
+  if ( class_id >= reg.count.load( std::memory_order_acquire ) )
   {
-    // Name not associated with any object
     std::stringstream sstr;
-    sstr << "Class name \"" << str << "\" is not associated with any object";
-    throw std::runtime_error( sstr.str() );
+    sstr << "No class name has id " << class_id;
+    throw std::out_of_range( sstr.str() );
   }
 
-  return &(*it);
+  return reg.name( class_id );
 }
 
 // ----------------------------------------------------------------------------
@@ -321,11 +539,15 @@ std::vector< std::string >
 class_map< T >
 ::all_class_names()
 {
-  auto out = []() -> std::vector< std::string >
+  auto const& reg = registry();
+  auto const count = reg.count.load( std::memory_order_acquire );
+
+  std::vector< std::string > out;
+  out.reserve( count );
+  for ( size_t id = 0; id < count; ++id )
   {
-    std::lock_guard< std::mutex > lock{ s_table_mutex };
-    return { s_master_name_set.begin(), s_master_name_set.end() };
-  }();
+    out.push_back( reg.name( static_cast< class_id_t >( id ) ) );
+  }
 
   std::sort( out.begin(), out.end() );
   return out;
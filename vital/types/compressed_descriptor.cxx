@@ -0,0 +1,523 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of compressed descriptor types
+
+#include "compressed_descriptor.h"
+
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+namespace kwiver {
+namespace vital {
+
+constexpr size_t descriptor_int8::header_size;
+constexpr size_t product_quantizer::num_centroids;
+
+// ----------------------------------------------------------------------------
+uint16_t
+float_to_half( float value )
+{
+  uint32_t f;
+  std::memcpy( &f, &value, sizeof( f ) );
+
+  uint16_t const sign = static_cast< uint16_t >( ( f >> 16 ) & 0x8000 );
+  uint32_t abs = f & 0x7fffffff;
+
+  if( abs >= 0x47800000 )
+  {
+    // Too large for a half, infinite or NaN; keep NaN quiet
+    return sign | ( abs > 0x7f800000 ? 0x7e00 : 0x7c00 );
+  }
+  if( abs < 0x38800000 )
+  {
+    // Subnormal or zero: adding 0.5 aligns the half mantissa with the low
+    // bits of the float, which the addition rounds to nearest even
+    float scaled;
+    std::memcpy( &scaled, &abs, sizeof( scaled ) );
+    scaled += 0.5f;
+    std::memcpy( &abs, &scaled, sizeof( abs ) );
+    return sign | static_cast< uint16_t >( abs - 0x3f000000 );
+  }
+
+  // Normal: rebias the exponent and round the mantissa to nearest even,
+  // which may carry into the exponent and up to infinity
+  uint32_t const odd = ( abs >> 13 ) & 1;
+  abs += 0xc8000fff + odd;
+  return sign | static_cast< uint16_t >( abs >> 13 );
+}
+
+// ----------------------------------------------------------------------------
+float
+half_to_float( uint16_t value )
+{
+  uint32_t const sign = static_cast< uint32_t >( value & 0x8000 ) << 16;
+  uint32_t const exponent = ( value >> 10 ) & 0x1f;
+  uint32_t const mantissa = value & 0x3ff;
+
+  if( exponent == 0 )
+  {
+    float const magnitude = std::ldexp( static_cast< float >( mantissa ), -24 );
+    return sign ? -magnitude : magnitude;
+  }
+
+  uint32_t const f = exponent == 0x1f
+    ? sign | 0x7f800000 | ( mantissa << 13 )
+    : sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 );
+  float result;
+  std::memcpy( &result, &f, sizeof( result ) );
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< double >
+compressed_descriptor
+::as_double() const
+{
+  std::vector< double > result( this->size() );
+  this->decode( result.data() );
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+double
+compressed_descriptor
+::squared_distance( descriptor const& other ) const
+{
+  if( other.size() != this->size() )
+  {
+    VITAL_THROW( invalid_value,
+                 "Descriptors must be the same size to compute a distance" );
+  }
+
+  if( auto const dense =
+        dynamic_cast< descriptor_array_of< double > const* >( &other ) )
+  {
+    return this->squared_distance( dense->raw_data() );
+  }
+  return this->squared_distance( other.as_double().data() );
+}
+
+// ----------------------------------------------------------------------------
+descriptor_float16
+::descriptor_float16( double const* data, size_t len )
+  : data_( len )
+{
+  for( size_t i = 0; i < len; ++i )
+  {
+    data_[ i ] = float_to_half( static_cast< float >( data[ i ] ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+descriptor_float16
+::descriptor_float16( std::vector< uint16_t > halves )
+  : data_( std::move( halves ) )
+{
+}
+
+// ----------------------------------------------------------------------------
+descriptor_sptr
+descriptor_float16
+::clone() const
+{
+  return std::make_shared< descriptor_float16 >( data_ );
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_float16
+::decode( double* out ) const
+{
+  for( auto const h : data_ )
+  {
+    *out++ = half_to_float( h );
+  }
+}
+
+// ----------------------------------------------------------------------------
+double
+descriptor_float16
+::squared_distance( double const* query ) const
+{
+  double sum = 0.0;
+  for( size_t i = 0; i < data_.size(); ++i )
+  {
+    double const d = half_to_float( data_[ i ] ) - query[ i ];
+    sum += d * d;
+  }
+  return sum;
+}
+
+// ----------------------------------------------------------------------------
+descriptor_int8
+::descriptor_int8( double const* data, size_t len )
+  : data_( header_size + len )
+{
+  auto const range = std::minmax_element( data, data + len );
+  float offset = 0.0f;
+  float scale = 0.0f;
+  if( len )
+  {
+    offset = static_cast< float >( 0.5 * ( *range.first + *range.second ) );
+    scale = static_cast< float >( ( *range.second - *range.first ) / 254.0 );
+  }
+  std::memcpy( data_.data(), &offset, sizeof( offset ) );
+  std::memcpy( data_.data() + sizeof( offset ), &scale, sizeof( scale ) );
+
+  auto* const out = reinterpret_cast< int8_t* >( data_.data() + header_size );
+  for( size_t i = 0; i < len; ++i )
+  {
+    double const code =
+      scale > 0.0f ? std::round( ( data[ i ] - offset ) / scale ) : 0.0;
+    out[ i ] = static_cast< int8_t >( std::max( -127.0, std::min( 127.0, code ) ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+descriptor_int8
+::descriptor_int8( float offset, float scale, std::vector< int8_t > const& codes )
+  : data_( header_size + codes.size() )
+{
+  std::memcpy( data_.data(), &offset, sizeof( offset ) );
+  std::memcpy( data_.data() + sizeof( offset ), &scale, sizeof( scale ) );
+  std::memcpy( data_.data() + header_size, codes.data(), codes.size() );
+}
+
+// ----------------------------------------------------------------------------
+descriptor_sptr
+descriptor_int8
+::clone() const
+{
+  return std::make_shared< descriptor_int8 >( *this );
+}
+
+// ----------------------------------------------------------------------------
+float
+descriptor_int8
+::offset() const
+{
+  float result;
+  std::memcpy( &result, data_.data(), sizeof( result ) );
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+float
+descriptor_int8
+::scale() const
+{
+  float result;
+  std::memcpy( &result, data_.data() + sizeof( float ), sizeof( result ) );
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_int8
+::decode( double* out ) const
+{
+  double const offset = this->offset();
+  double const scale = this->scale();
+  auto const* const c = this->codes();
+  for( size_t i = 0; i < this->size(); ++i )
+  {
+    out[ i ] = offset + scale * c[ i ];
+  }
+}
+
+// ----------------------------------------------------------------------------
+double
+descriptor_int8
+::squared_distance( double const* query ) const
+{
+  double const offset = this->offset();
+  double const scale = this->scale();
+  auto const* const c = this->codes();
+  double sum = 0.0;
+  for( size_t i = 0; i < this->size(); ++i )
+  {
+    double const d = offset + scale * c[ i ] - query[ i ];
+    sum += d * d;
+  }
+  return sum;
+}
+
+// ----------------------------------------------------------------------------
+descriptor_pq
+::descriptor_pq( product_quantizer_sptr quantizer, std::vector< uint8_t > codes )
+  : quantizer_( std::move( quantizer ) ),
+    codes_( std::move( codes ) )
+{
+  if( !quantizer_ || codes_.size() != quantizer_->subspaces() )
+  {
+    VITAL_THROW( invalid_value,
+                 "Product quantized descriptor needs one code per subspace" );
+  }
+}
+
+// ----------------------------------------------------------------------------
+std::size_t
+descriptor_pq
+::size() const
+{
+  return quantizer_->dimension();
+}
+
+// ----------------------------------------------------------------------------
+descriptor_sptr
+descriptor_pq
+::clone() const
+{
+  return std::make_shared< descriptor_pq >( *this );
+}
+
+// ----------------------------------------------------------------------------
+void
+descriptor_pq
+::decode( double* out ) const
+{
+  quantizer_->decode( codes_.data(), out );
+}
+
+// ----------------------------------------------------------------------------
+double
+descriptor_pq
+::squared_distance( double const* query ) const
+{
+  size_t const sub_dim = quantizer_->dimension() / quantizer_->subspaces();
+  auto const& centroids = quantizer_->centroids();
+  double sum = 0.0;
+  for( size_t m = 0; m < codes_.size(); ++m )
+  {
+    float const* c = centroids.data() +
+      ( m * product_quantizer::num_centroids + codes_[ m ] ) * sub_dim;
+    for( size_t j = 0; j < sub_dim; ++j, ++query )
+    {
+      double const d = c[ j ] - *query;
+      sum += d * d;
+    }
+  }
+  return sum;
+}
+
+// ----------------------------------------------------------------------------
+double
+descriptor_pq
+::squared_distance( std::vector< double > const& table ) const
+{
+  double sum = 0.0;
+  for( size_t m = 0; m < codes_.size(); ++m )
+  {
+    sum += table[ m * product_quantizer::num_centroids + codes_[ m ] ];
+  }
+  return sum;
+}
+
+// ----------------------------------------------------------------------------
+product_quantizer
+::product_quantizer( size_t dimension, size_t subspaces,
+                     std::vector< float > centroids )
+  : dimension_( dimension ),
+    subspaces_( subspaces ),
+    centroids_( std::move( centroids ) )
+{
+  if( !subspaces || dimension % subspaces ||
+      centroids_.size() != num_centroids * dimension )
+  {
+    VITAL_THROW( invalid_value,
+                 "Product quantizer centroids do not match its dimension "
+                 "and subspaces" );
+  }
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< product_quantizer >
+product_quantizer
+::train( std::vector< descriptor_sptr > const& samples, size_t subspaces,
+         unsigned iterations, unsigned seed )
+{
+  if( samples.empty() || !samples[ 0 ] )
+  {
+    VITAL_THROW( invalid_value,
+                 "Product quantizer training needs sample descriptors" );
+  }
+
+  size_t const dimension = samples[ 0 ]->size();
+  if( !subspaces || dimension % subspaces )
+  {
+    VITAL_THROW( invalid_value,
+                 "Product quantizer subspaces must divide the descriptor "
+                 "dimension" );
+  }
+
+  size_t const n = samples.size();
+  std::vector< double > data;
+  data.reserve( n * dimension );
+  for( auto const& s : samples )
+  {
+    if( !s || s->size() != dimension )
+    {
+      VITAL_THROW( invalid_value,
+                   "Product quantizer samples must have the same size" );
+    }
+    auto const values = s->as_double();
+    data.insert( data.end(), values.begin(), values.end() );
+  }
+
+  size_t const sub_dim = dimension / subspaces;
+  std::vector< float > centroids( num_centroids * dimension );
+
+  // Each subspace is clustered independently with Lloyd's k-means
+  thread_pool::instance().parallel_for( subspaces, 1,
+    [ & ]( size_t begin, size_t end )
+  {
+    for( size_t m = begin; m < end; ++m )
+    {
+      auto const part = [ & ]( size_t i ){
+        return data.data() + i * dimension + m * sub_dim;
+      };
+
+      // Seed with distinct random samples, repeated if there are too few
+      std::vector< size_t > order( n );
+      std::iota( order.begin(), order.end(), 0 );
+      std::shuffle( order.begin(), order.end(), std::mt19937( seed + m ) );
+      std::vector< double > means( num_centroids * sub_dim );
+      for( size_t k = 0; k < num_centroids; ++k )
+      {
+        std::copy( part( order[ k % n ] ), part( order[ k % n ] ) + sub_dim,
+                   means.begin() + k * sub_dim );
+      }
+
+      std::vector< size_t > assignment( n );
+      std::vector< double > sums( num_centroids * sub_dim );
+      std::vector< size_t > counts( num_centroids );
+      for( unsigned it = 0; it < iterations; ++it )
+      {
+        bool changed = false;
+        for( size_t i = 0; i < n; ++i )
+        {
+          double best = std::numeric_limits< double >::max();
+          size_t best_k = 0;
+          for( size_t k = 0; k < num_centroids; ++k )
+          {
+            double dist = 0.0;
+            for( size_t j = 0; j < sub_dim; ++j )
+            {
+              double const d = part( i )[ j ] - means[ k * sub_dim + j ];
+              dist += d * d;
+            }
+            if( dist < best )
+            {
+              best = dist;
+              best_k = k;
+            }
+          }
+          changed |= ( it == 0 || assignment[ i ] != best_k );
+          assignment[ i ] = best_k;
+        }
+        if( !changed )
+        {
+          break;
+        }
+
+        // Empty clusters keep their previous centroid
+        std::fill( sums.begin(), sums.end(), 0.0 );
+        std::fill( counts.begin(), counts.end(), 0 );
+        for( size_t i = 0; i < n; ++i )
+        {
+          auto const k = assignment[ i ];
+          ++counts[ k ];
+          for( size_t j = 0; j < sub_dim; ++j )
+          {
+            sums[ k * sub_dim + j ] += part( i )[ j ];
+          }
+        }
+        for( size_t k = 0; k < num_centroids; ++k )
+        {
+          for( size_t j = 0; counts[ k ] && j < sub_dim; ++j )
+          {
+            means[ k * sub_dim + j ] = sums[ k * sub_dim + j ] / counts[ k ];
+          }
+        }
+      }
+
+      std::copy( means.begin(), means.end(),
+                 centroids.begin() + m * num_centroids * sub_dim );
+    }
+  } );
+
+  return std::make_shared< product_quantizer >(
+    dimension, subspaces, std::move( centroids ) );
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< descriptor_pq >
+product_quantizer
+::encode( descriptor const& desc ) const
+{
+  if( desc.size() != dimension_ )
+  {
+    VITAL_THROW( invalid_value,
+                 "Descriptor size does not match the product quantizer" );
+  }
+
+  auto const query = desc.as_double();
+  auto const table = this->distance_table( query.data() );
+  std::vector< uint8_t > codes( subspaces_ );
+  for( size_t m = 0; m < subspaces_; ++m )
+  {
+    auto const first = table.begin() + m * num_centroids;
+    codes[ m ] = static_cast< uint8_t >(
+      std::min_element( first, first + num_centroids ) - first );
+  }
+  return std::make_shared< descriptor_pq >( shared_from_this(),
+                                            std::move( codes ) );
+}
+
+// ----------------------------------------------------------------------------
+void
+product_quantizer
+::decode( uint8_t const* codes, double* out ) const
+{
+  size_t const sub_dim = dimension_ / subspaces_;
+  for( size_t m = 0; m < subspaces_; ++m )
+  {
+    float const* c =
+      centroids_.data() + ( m * num_centroids + codes[ m ] ) * sub_dim;
+    out = std::copy( c, c + sub_dim, out );
+  }
+}
+
+// ----------------------------------------------------------------------------
+std::vector< double >
+product_quantizer
+::distance_table( double const* query ) const
+{
+  size_t const sub_dim = dimension_ / subspaces_;
+  std::vector< double > table( subspaces_ * num_centroids );
+  float const* c = centroids_.data();
+  for( size_t m = 0; m < subspaces_; ++m, query += sub_dim )
+  {
+    for( size_t k = 0; k < num_centroids; ++k, c += sub_dim )
+    {
+      double dist = 0.0;
+      for( size_t j = 0; j < sub_dim; ++j )
+      {
+        double const d = c[ j ] - query[ j ];
+        dist += d * d;
+      }
+      table[ m * num_centroids + k ] = dist;
+    }
+  }
+  return table;
+}
+
+} } // end namespace vital
@@ -0,0 +1,254 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Descriptors stored in compact lossy encodings
+
+#ifndef VITAL_COMPRESSED_DESCRIPTOR_H_
+#define VITAL_COMPRESSED_DESCRIPTOR_H_
+
+#include <vital/types/descriptor.h>
+
+#include <memory>
+#include <vector>
+
+#include <cstdint>
+
+namespace kwiver {
+namespace vital {
+
+/// Convert \p value to IEEE 754 half precision, rounding to nearest even
+VITAL_EXPORT uint16_t float_to_half( float value );
+
+/// Convert the IEEE 754 half precision \p value to single precision
+VITAL_EXPORT float half_to_float( uint16_t value );
+
+// ----------------------------------------------------------------------------
+/// Base class of descriptors stored in a lossy compressed encoding
+///
+/// size() is the number of elements of the decoded descriptor, while
+/// as_bytes() and num_bytes() refer to the encoded data. data_type() returns
+/// the type of the descriptor class, which identifies the encoding. Distances
+/// to a dense query are computed one decoded element at a time, without
+/// building the decoded descriptor.
+class VITAL_EXPORT compressed_descriptor
+  : public descriptor
+{
+public:
+  /// Decode the descriptor into \p out, which must hold size() elements
+  virtual void decode( double* out ) const = 0;
+
+  /// Return the decoded descriptor
+  std::vector< double > as_double() const override;
+
+  /// Squared Euclidean distance to the size() elements at \p query
+  virtual double squared_distance( double const* query ) const = 0;
+
+  /// Squared Euclidean distance to a descriptor of the same size
+  ///
+  /// \throws invalid_value If the sizes differ.
+  double squared_distance( descriptor const& other ) const;
+};
+
+// ----------------------------------------------------------------------------
+/// A descriptor stored as half precision floats
+///
+/// Halves the storage of a float descriptor, with a relative error of at
+/// most 2^-11 for values between about 6e-5 and 65504 in magnitude.
+class VITAL_EXPORT descriptor_float16
+  : public compressed_descriptor
+{
+public:
+  /// Encode the \p len elements at \p data
+  descriptor_float16( double const* data, size_t len );
+
+  /// Construct from already encoded half precision values
+  explicit descriptor_float16( std::vector< uint16_t > halves );
+
+  std::type_info const& data_type() const override
+  { return typeid( descriptor_float16 ); }
+
+  std::size_t size() const override { return data_.size(); }
+  std::size_t num_bytes() const override
+  { return data_.size() * sizeof( uint16_t ); }
+  byte const* as_bytes() const override
+  { return reinterpret_cast< byte const* >( data_.data() ); }
+
+  descriptor_sptr clone() const override;
+
+  /// Return a pointer to the encoded half precision values
+  uint16_t const* raw_data() const { return data_.data(); }
+
+  void decode( double* out ) const override;
+  double squared_distance( double const* query ) const override;
+  using compressed_descriptor::squared_distance;
+
+protected:
+  std::vector< uint16_t > data_;
+};
+
+// ----------------------------------------------------------------------------
+/// A descriptor linearly quantized to signed bytes
+///
+/// Element i decodes to offset() + scale() * code(i), with codes in
+/// [-127, 127] spanning the range of the encoded values, so the error is at
+/// most 1/254 of that range. The encoded bytes are the offset and scale as
+/// floats followed by the codes.
+class VITAL_EXPORT descriptor_int8
+  : public compressed_descriptor
+{
+public:
+  /// Encode the \p len elements at \p data
+  descriptor_int8( double const* data, size_t len );
+
+  /// Construct from already encoded codes
+  descriptor_int8( float offset, float scale, std::vector< int8_t > const& codes );
+
+  std::type_info const& data_type() const override
+  { return typeid( descriptor_int8 ); }
+
+  std::size_t size() const override { return data_.size() - header_size; }
+  std::size_t num_bytes() const override { return data_.size(); }
+  byte const* as_bytes() const override { return data_.data(); }
+
+  descriptor_sptr clone() const override;
+
+  /// The value of code 0
+  float offset() const;
+
+  /// The difference between the values of consecutive codes
+  float scale() const;
+
+  /// Return a pointer to the size() codes
+  int8_t const* codes() const
+  { return reinterpret_cast< int8_t const* >( data_.data() + header_size ); }
+
+  void decode( double* out ) const override;
+  double squared_distance( double const* query ) const override;
+  using compressed_descriptor::squared_distance;
+
+protected:
+  static constexpr size_t header_size = 2 * sizeof( float );
+
+  std::vector< byte > data_;
+};
+
+class product_quantizer;
+typedef std::shared_ptr< product_quantizer const > product_quantizer_sptr;
+
+// ----------------------------------------------------------------------------
+/// A descriptor encoded by a product quantizer
+///
+/// Each code selects the centroid of one subspace of the quantizer. The
+/// encoded bytes are the codes alone, so descriptors are only comparable with
+/// others encoded by the same quantizer.
+class VITAL_EXPORT descriptor_pq
+  : public compressed_descriptor
+{
+public:
+  /// Construct from codes of \p quantizer
+  ///
+  /// \throws invalid_value If the number of codes differs from the number of
+  ///                       subspaces of \p quantizer.
+  descriptor_pq( product_quantizer_sptr quantizer, std::vector< uint8_t > codes );
+
+  std::type_info const& data_type() const override
+  { return typeid( descriptor_pq ); }
+
+  std::size_t size() const override;
+  std::size_t num_bytes() const override { return codes_.size(); }
+  byte const* as_bytes() const override { return codes_.data(); }
+
+  descriptor_sptr clone() const override;
+
+  /// The quantizer which encoded this descriptor
+  product_quantizer_sptr const& quantizer() const { return quantizer_; }
+
+  /// Return a pointer to the code of each subspace
+  uint8_t const* codes() const { return codes_.data(); }
+
+  void decode( double* out ) const override;
+  double squared_distance( double const* query ) const override;
+  using compressed_descriptor::squared_distance;
+
+  /// Squared Euclidean distance from the query of a table returned by
+  /// product_quantizer::distance_table()
+  double squared_distance( std::vector< double > const& table ) const;
+
+protected:
+  product_quantizer_sptr quantizer_;
+  std::vector< uint8_t > codes_;
+};
+
+// ----------------------------------------------------------------------------
+/// Product quantizer for compressing descriptors to one byte per subspace
+///
+/// The descriptor dimensions are split into subspaces of equal size, and the
+/// part of a descriptor in each subspace is replaced by the index of the
+/// nearest of num_centroids centroids learned for that subspace by k-means.
+/// Distances from a query to many encoded descriptors are computed with a
+/// table of the distances from each part of the query to each centroid.
+class VITAL_EXPORT product_quantizer
+  : public std::enable_shared_from_this< product_quantizer >
+{
+public:
+  /// The number of centroids in each subspace
+  static constexpr size_t num_centroids = 256;
+
+  /// Construct from centroids
+  ///
+  /// \param dimension Number of elements in each descriptor.
+  /// \param subspaces Number of subspaces, which must divide \p dimension.
+  /// \param centroids The num_centroids centroids of each subspace in turn,
+  ///                  each of dimension / subspaces elements.
+  /// \throws invalid_value If the sizes are inconsistent.
+  product_quantizer( size_t dimension, size_t subspaces,
+                     std::vector< float > centroids );
+
+  /// Learn a quantizer from sample descriptors
+  ///
+  /// The subspaces are clustered in parallel. With fewer samples than
+  /// num_centroids, some centroids are duplicates.
+  ///
+  /// \throws invalid_value If there are no samples, a sample is null or its
+  ///                       size differs, or \p subspaces does not divide it.
+  static std::shared_ptr< product_quantizer >
+  train( std::vector< descriptor_sptr > const& samples, size_t subspaces,
+         unsigned iterations = 20, unsigned seed = 0 );
+
+  /// The number of elements in each descriptor
+  size_t dimension() const { return dimension_; }
+
+  /// The number of subspaces, and of codes in each encoded descriptor
+  size_t subspaces() const { return subspaces_; }
+
+  /// The centroids of each subspace in turn
+  std::vector< float > const& centroids() const { return centroids_; }
+
+  /// Encode a descriptor
+  ///
+  /// The quantizer must be owned by a shared pointer, which the encoded
+  /// descriptor shares.
+  ///
+  /// \throws invalid_value If the size of \p desc differs from dimension().
+  std::shared_ptr< descriptor_pq > encode( descriptor const& desc ) const;
+
+  /// Decode \p codes into the dimension() elements at \p out
+  void decode( uint8_t const* codes, double* out ) const;
+
+  /// Squared distances from each part of \p query to each centroid
+  ///
+  /// \param query The dimension() elements of the query.
+  /// \returns num_centroids distances for each subspace in turn.
+  std::vector< double > distance_table( double const* query ) const;
+
+protected:
+  size_t dimension_;
+  size_t subspaces_;
+  std::vector< float > centroids_;
+};
+
+} } // end namespace vital
+
+#endif // VITAL_COMPRESSED_DESCRIPTOR_H_
@@ -0,0 +1,239 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of \link kwiver::vital::dense_camera_perspective_map
+/// dense_camera_perspective_map \endlink class
+
+#include "dense_camera_perspective_map.h"
+
+#include <algorithm>
+#include <map>
+
+namespace kwiver {
+namespace vital {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+/// Clones intrinsics, cloning intrinsics shared by several cameras once
+class intrinsics_cloner
+{
+public:
+  camera_intrinsics_sptr operator()( camera_intrinsics_sptr const& K )
+  {
+    if( !K )
+    {
+      return K;
+    }
+
+    auto& clone = clones_[ K.get() ];
+    if( !clone )
+    {
+      clone = K->clone();
+    }
+    return clone;
+  }
+
+private:
+  std::map< camera_intrinsics const*, camera_intrinsics_sptr > clones_;
+};
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+template < class Map >
+void
+dense_camera_perspective_map
+::set_cameras( Map const& cameras )
+{
+  storage& s = *data_;
+  s.frames.reserve( cameras.size() );
+  s.values.reserve( cameras.size() );
+
+  // std::map is already ordered by frame
+  intrinsics_cloner clone_intrinsics;
+  for( auto const& c : cameras )
+  {
+    auto const cam =
+      std::dynamic_pointer_cast< camera_perspective >( c.second );
+    if( cam )
+    {
+      s.frames.push_back( c.first );
+      s.values.emplace_back( *cam );
+      s.values.back().set_intrinsics( clone_intrinsics( cam->intrinsics() ) );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+template < class Map >
+void
+dense_camera_perspective_map
+::get_cameras( Map& cameras ) const
+{
+  intrinsics_cloner clone_intrinsics;
+  for( size_t i = 0; i < data_->frames.size(); ++i )
+  {
+    auto const cam =
+      std::make_shared< simple_camera_perspective >( data_->values[ i ] );
+    cam->set_intrinsics( clone_intrinsics( cam->intrinsics() ) );
+    cameras.emplace_hint( cameras.end(), data_->frames[ i ], cam );
+  }
+}
+
+// ----------------------------------------------------------------------------
+dense_camera_perspective_map
+::dense_camera_perspective_map()
+  : data_( std::make_shared< storage >() )
+{
+}
+
+// ----------------------------------------------------------------------------
+dense_camera_perspective_map
+::dense_camera_perspective_map( map_camera_t const& cameras )
+  : data_( std::make_shared< storage >() )
+{
+  set_cameras( cameras );
+}
+
+// ----------------------------------------------------------------------------
+dense_camera_perspective_map
+::dense_camera_perspective_map( simple_camera_perspective_map const& cameras )
+  : data_( std::make_shared< storage >() )
+{
+  set_cameras( cameras.T_cameras() );
+}
+
+// ----------------------------------------------------------------------------
+size_t
+dense_camera_perspective_map
+::size() const
+{
+  return data_->frames.size();
+}
+
+// ----------------------------------------------------------------------------
+camera_map::map_camera_t
+dense_camera_perspective_map
+::cameras() const
+{
+  map_camera_t cams;
+  get_cameras( cams );
+  return cams;
+}
+
+// ----------------------------------------------------------------------------
+simple_camera_perspective_map::frame_to_T_sptr_map
+dense_camera_perspective_map
+::T_cameras() const
+{
+  simple_camera_perspective_map::frame_to_T_sptr_map cams;
+  get_cameras( cams );
+  return cams;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< frame_id_t > const&
+dense_camera_perspective_map
+::frame_ids() const
+{
+  return data_->frames;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< simple_camera_perspective > const&
+dense_camera_perspective_map
+::values() const
+{
+  return data_->values;
+}
+
+// ----------------------------------------------------------------------------
+simple_camera_perspective const*
+dense_camera_perspective_map
+::find( frame_id_t fid ) const
+{
+  auto const& frames = data_->frames;
+  auto const i = std::lower_bound( frames.begin(), frames.end(), fid );
+  if( i == frames.end() || *i != fid )
+  {
+    return nullptr;
+  }
+  return &data_->values[ i - frames.begin() ];
+}
+
+// ----------------------------------------------------------------------------
+void
+dense_camera_perspective_map
+::insert( frame_id_t fid, camera_perspective const& cam )
+{
+  simple_camera_perspective value( cam );
+  if( auto const K = cam.intrinsics() )
+  {
+    value.set_intrinsics( K->clone() );
+  }
+
+  storage& s = detach();
+
+  // cameras are usually added in frame order
+  if( s.frames.empty() || s.frames.back() < fid )
+  {
+    s.frames.push_back( fid );
+    s.values.push_back( value );
+    return;
+  }
+
+  auto const i = std::lower_bound( s.frames.begin(), s.frames.end(), fid );
+  auto const v = s.values.begin() + ( i - s.frames.begin() );
+  if( *i == fid )
+  {
+    *v = value;
+  }
+  else
+  {
+    s.values.insert( v, value );
+    s.frames.insert( i, fid );
+  }
+}
+
+// ----------------------------------------------------------------------------
+bool
+dense_camera_perspective_map
+::erase( frame_id_t fid )
+{
+  if( !find( fid ) )
+  {
+    return false;
+  }
+
+  storage& s = detach();
+  auto const i = std::lower_bound( s.frames.begin(), s.frames.end(), fid );
+  s.values.erase( s.values.begin() + ( i - s.frames.begin() ) );
+  s.frames.erase( i );
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+dense_camera_perspective_map
+::clear()
+{
+  data_ = std::make_shared< storage >();
+}
+
+// ----------------------------------------------------------------------------
+dense_camera_perspective_map::storage&
+dense_camera_perspective_map
+::detach()
+{
+  // the intrinsics are never modified, so copies of the storage share them
+  if( data_.use_count() > 1 )
+  {
+    data_ = std::make_shared< storage >( *data_ );
+  }
+  return *data_;
+}
+
+} } // end namespace vital
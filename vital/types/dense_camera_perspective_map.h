@@ -0,0 +1,111 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header file for a perspective camera map with contiguous storage
+
+#ifndef VITAL_DENSE_CAMERA_PERSPECTIVE_MAP_H_
+#define VITAL_DENSE_CAMERA_PERSPECTIVE_MAP_H_
+
+#include "camera_perspective_map.h"
+
+#include <vital/vital_export.h>
+
+#include <vector>
+
+namespace kwiver {
+namespace vital {
+
+// ----------------------------------------------------------------------------
+/// A camera_map that stores simple_camera_perspective values contiguously
+///
+/// Cameras are kept in two parallel vectors ordered by frame, so looking
+/// one up is a binary search and walking them touches contiguous memory.
+/// Copies of the map share their storage until one of them is modified, so
+/// copying a map to save it before a change, and assigning the copy back to
+/// undo the change, take constant time.
+///
+/// The cameras are values. The map keeps its own copies of the intrinsics,
+/// with cameras that shared intrinsics when added still sharing a copy.
+/// cameras() and T_cameras() return new cameras with new intrinsics, shared
+/// the same way, so changing them does not change the map or its copies.
+class VITAL_EXPORT dense_camera_perspective_map :
+  public camera_map
+{
+public:
+  /// Default Constructor
+  dense_camera_perspective_map();
+
+  /// Constructor from a std::map of cameras
+  ///
+  /// Only perspective cameras are added to the map. All others are ignored.
+  explicit dense_camera_perspective_map( map_camera_t const& cameras );
+
+  /// Constructor from a map of simple perspective cameras
+  explicit dense_camera_perspective_map(
+    simple_camera_perspective_map const& cameras );
+
+  /// Return the number of cameras in the map
+  size_t size() const override;
+
+  /// Return a map from integer IDs to new copies of the cameras
+  map_camera_t cameras() const override;
+
+  /// Return a map from integer IDs to new copies of the cameras
+  simple_camera_perspective_map::frame_to_T_sptr_map T_cameras() const;
+
+  /// Return the frame IDs in increasing order
+  std::vector< frame_id_t > const& frame_ids() const;
+
+  /// Return the cameras in the order of frame_ids()
+  ///
+  /// The intrinsics of these cameras belong to the map and must not be
+  /// modified.
+  std::vector< simple_camera_perspective > const& values() const;
+
+  /// Find a camera in the map
+  ///
+  /// \param [in] fid the frame id of the camera to return
+  /// \return     the camera, or null if it is not found; the pointer is
+  ///             valid until the map is next modified, and the intrinsics
+  ///             of the camera must not be modified
+  simple_camera_perspective const* find( frame_id_t fid ) const;
+
+  /// Insert a camera into the map, replacing any with the same frame id
+  ///
+  /// \param [in] fid the frame id of the camera to insert
+  /// \param [in] cam the camera, whose value and intrinsics are copied
+  void insert( frame_id_t fid, camera_perspective const& cam );
+
+  /// Erase a camera from the map
+  ///
+  /// \param [in] fid the frame id of the camera to erase
+  /// \return     true if the camera was in the map
+  bool erase( frame_id_t fid );
+
+  /// Clear the map of all cameras
+  void clear();
+
+private:
+  struct storage
+  {
+    std::vector< frame_id_t > frames;
+    std::vector< simple_camera_perspective > values;
+  };
+
+  /// Get storage not shared with any other map, copying it if needed
+  storage& detach();
+
+  template < class Map >
+  void set_cameras( Map const& cameras );
+
+  template < class Map >
+  void get_cameras( Map& cameras ) const;
+
+  std::shared_ptr< storage > data_;
+};
+
+} } // end namespace vital
+
+#endif // VITAL_DENSE_CAMERA_PERSPECTIVE_MAP_H_
@@ -0,0 +1,159 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of \link kwiver::vital::dense_landmark_map
+/// dense_landmark_map \endlink class
+
+#include "dense_landmark_map.h"
+
+#include <algorithm>
+
+namespace kwiver {
+namespace vital {
+
+// ----------------------------------------------------------------------------
+dense_landmark_map
+::dense_landmark_map()
+  : data_( std::make_shared< storage >() )
+{
+}
+
+// ----------------------------------------------------------------------------
+dense_landmark_map
+::dense_landmark_map( map_landmark_t const& landmarks )
+  : data_( std::make_shared< storage >() )
+{
+  data_->ids.reserve( landmarks.size() );
+  data_->values.reserve( landmarks.size() );
+
+  // std::map is already ordered by id
+  for( auto const& lm : landmarks )
+  {
+    if( lm.second )
+    {
+      data_->ids.push_back( lm.first );
+      data_->values.emplace_back( *lm.second );
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+size_t
+dense_landmark_map
+::size() const
+{
+  return data_->ids.size();
+}
+
+// ----------------------------------------------------------------------------
+landmark_map::map_landmark_t
+dense_landmark_map
+::landmarks() const
+{
+  map_landmark_t lms;
+  for( size_t i = 0; i < data_->ids.size(); ++i )
+  {
+    lms.emplace_hint( lms.end(), data_->ids[ i ],
+                      std::make_shared< landmark_d >( data_->values[ i ] ) );
+  }
+  return lms;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< landmark_id_t > const&
+dense_landmark_map
+::ids() const
+{
+  return data_->ids;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< landmark_d > const&
+dense_landmark_map
+::values() const
+{
+  return data_->values;
+}
+
+// ----------------------------------------------------------------------------
+landmark_d const*
+dense_landmark_map
+::find( landmark_id_t id ) const
+{
+  auto const& ids = data_->ids;
+  auto const i = std::lower_bound( ids.begin(), ids.end(), id );
+  if( i == ids.end() || *i != id )
+  {
+    return nullptr;
+  }
+  return &data_->values[ i - ids.begin() ];
+}
+
+// ----------------------------------------------------------------------------
+void
+dense_landmark_map
+::insert( landmark_id_t id, landmark const& lm )
+{
+  storage& s = detach();
+
+  // new landmarks usually have the largest id so far
+  if( s.ids.empty() || s.ids.back() < id )
+  {
+    s.ids.push_back( id );
+    s.values.emplace_back( lm );
+    return;
+  }
+
+  auto const i = std::lower_bound( s.ids.begin(), s.ids.end(), id );
+  auto const v = s.values.begin() + ( i - s.ids.begin() );
+  if( *i == id )
+  {
+    *v = landmark_d( lm );
+  }
+  else
+  {
+    s.values.insert( v, landmark_d( lm ) );
+    s.ids.insert( i, id );
+  }
+}
+
+// ----------------------------------------------------------------------------
+bool
+dense_landmark_map
+::erase( landmark_id_t id )
+{
+  if( !find( id ) )
+  {
+    return false;
+  }
+
+  storage& s = detach();
+  auto const i = std::lower_bound( s.ids.begin(), s.ids.end(), id );
+  s.values.erase( s.values.begin() + ( i - s.ids.begin() ) );
+  s.ids.erase( i );
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+dense_landmark_map
+::clear()
+{
+  data_ = std::make_shared< storage >();
+}
+
+// ----------------------------------------------------------------------------
+dense_landmark_map::storage&
+dense_landmark_map
+::detach()
+{
+  if( data_.use_count() > 1 )
+  {
+    data_ = std::make_shared< storage >( *data_ );
+  }
+  return *data_;
+}
+
+} } // end namespace vital
@@ -0,0 +1,90 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header file for a landmark map with contiguous storage
+
+#ifndef VITAL_DENSE_LANDMARK_MAP_H_
+#define VITAL_DENSE_LANDMARK_MAP_H_
+
+#include "landmark_map.h"
+
+#include <vital/vital_export.h>
+
+#include <vector>
+
+namespace kwiver {
+namespace vital {
+
+// ----------------------------------------------------------------------------
+/// A landmark_map that stores landmark_d values contiguously
+///
+/// Landmarks are kept in two parallel vectors ordered by ID, so looking one
+/// up is a binary search and walking them touches contiguous memory.
+/// Copies of the map share their storage until one of them is modified, so
+/// copying a map to save it before a change, and assigning the copy back to
+/// undo the change, take constant time.
+///
+/// The landmarks are values: landmarks() returns new landmark objects, and
+/// changing those does not change the map or any of its copies.
+class VITAL_EXPORT dense_landmark_map :
+  public landmark_map
+{
+public:
+  /// Default Constructor
+  dense_landmark_map();
+
+  /// Constructor from a std::map of landmarks, copying their values
+  explicit dense_landmark_map( map_landmark_t const& landmarks );
+
+  /// Return the number of landmarks in the map
+  size_t size() const override;
+
+  /// Return a map from integer IDs to new copies of the landmarks
+  map_landmark_t landmarks() const override;
+
+  /// Return the landmark IDs in increasing order
+  std::vector< landmark_id_t > const& ids() const;
+
+  /// Return the landmarks in the order of ids()
+  std::vector< landmark_d > const& values() const;
+
+  /// Find a landmark in the map
+  ///
+  /// \param [in] id the id of the landmark to return
+  /// \return     the landmark, or null if it is not found; the pointer is
+  ///             valid until the map is next modified
+  landmark_d const* find( landmark_id_t id ) const;
+
+  /// Insert a landmark into the map, replacing any with the same id
+  ///
+  /// \param [in] id the id of the landmark to insert
+  /// \param [in] lm the landmark, whose value is copied
+  void insert( landmark_id_t id, landmark const& lm );
+
+  /// Erase a landmark from the map
+  ///
+  /// \param [in] id the id of the landmark to erase
+  /// \return     true if the landmark was in the map
+  bool erase( landmark_id_t id );
+
+  /// Clear the map of all landmarks
+  void clear();
+
+private:
+  struct storage
+  {
+    std::vector< landmark_id_t > ids;
+    std::vector< landmark_d > values;
+  };
+
+  /// Get storage not shared with any other map, copying it if needed
+  storage& detach();
+
+  std::shared_ptr< storage > data_;
+};
+
+} } // end namespace vital
+
+#endif // VITAL_DENSE_LANDMARK_MAP_H_
@@ -12,6 +12,7 @@
 #include <vital/vital_config.h>
 #include <vital/vital_types.h>
 #include <vital/exceptions.h>
+#include <vital/util/memory_accounting.h>
 
 #include <iostream>
 #include <limits>
@@ -163,7 +164,9 @@ class descriptor_array_of :
 /// A representation of a descriptor of fixed type and size
 template < typename T, unsigned N >
 class descriptor_fixed :
-  public descriptor_array_of< T >
+  public descriptor_array_of< T >,
+  private memory_accounted< descriptor_fixed< T, N >,
+                            memory_category::descriptor >
 {
 public:
   /// Default Constructor
@@ -205,24 +208,53 @@ class descriptor_fixed :
 /// A representation of a descriptor of fixed type and variable size
 template < typename T >
 class descriptor_dynamic :
-  public descriptor_array_of< T >
+  public descriptor_array_of< T >,
+  private memory_accounted< descriptor_dynamic< T >,
+                            memory_category::descriptor >
 {
 public:
   /// Constructor
   descriptor_dynamic< T > (size_t len)
   : data_( new T[len] ),
   length_( len ),
-  node_id_(std::numeric_limits<unsigned int>::max()) { }
+  node_id_(std::numeric_limits<unsigned int>::max())
+  {
+    memory_accounting::allocate( memory_category::descriptor,
+                                 len * sizeof(T), 0 );
+  }
 
   descriptor_dynamic< T > (size_t len, T* dat)
   : length_( len )
   {
     data_ = new T[len];
     memmove( data_, dat, len*sizeof(T) );
+    memory_accounting::allocate( memory_category::descriptor,
+                                 len * sizeof(T), 0 );
+  }
+
+  /// Copy Constructor
+  descriptor_dynamic< T > (descriptor_dynamic< T > const& other)
+  : descriptor_array_of< T >( other ),
+  memory_accounted< descriptor_dynamic< T >,
+                    memory_category::descriptor >( other ),
+  data_( new T[other.length_] ),
+  length_( other.length_ ),
+  node_id_( other.node_id_ )
+  {
+    memcpy( data_, other.data_, length_ * sizeof(T) );
+    memory_accounting::allocate( memory_category::descriptor,
+                                 length_ * sizeof(T), 0 );
   }
 
+  descriptor_dynamic< T >& operator=( descriptor_dynamic< T > const& ) = delete;
+
   /// Destructor
-  virtual ~descriptor_dynamic< T > ( ) { delete [] data_; }
+  virtual ~descriptor_dynamic< T > ( )
+  {
+    delete [] data_;
+    memory_accounting::release( memory_category::descriptor,
+                                length_ * sizeof(T), 0 );
+  }
 
   /// The number of elements of the underlying type
   std::size_t size() const { return length_; }
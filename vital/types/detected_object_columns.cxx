@@ -0,0 +1,547 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of detected_object_columns
+
+#include "detected_object_columns.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+
+namespace kwiver {
+namespace vital {
+
+constexpr detected_object_columns::class_id_t detected_object_columns::no_class;
+
+namespace {
+
+// Number of kept boxes compared with a candidate between checks for a hit
+constexpr size_t nms_block = 32;
+
+// Number of candidates from which suppression uses a grid
+constexpr size_t nms_grid_min = 256;
+
+// Number of grid cells above which a box is compared with every query
+constexpr int64_t max_box_cells = 64;
+
+// ----------------------------------------------------------------------------
+// Sort indices by decreasing value, keeping the order of equal values
+void
+sort_descending( std::vector< size_t >& indices,
+                 std::vector< double > const& values )
+{
+  std::stable_sort( indices.begin(), indices.end(),
+    [ &values ]( size_t a, size_t b ){ return values[ a ] > values[ b ]; } );
+}
+
+// ----------------------------------------------------------------------------
+// Uniform grid of square cells over which boxes are spread
+//
+// Each box is listed in every cell its closed extent touches, so any two
+// boxes that intersect, even at an edge, share a cell. Boxes spanning many
+// cells are kept in a separate list instead, and compared with every query.
+class box_grid
+{
+public:
+  explicit box_grid( double cell_size ) : m_cell_size( cell_size ) {}
+
+  // Add box id, with the given extent.
+  void insert( size_t id, double min_x, double min_y,
+               double max_x, double max_y )
+  {
+    int64_t x0, y0, x1, y1;
+    if ( ! cells( min_x, min_y, max_x, max_y, x0, y0, x1, y1 ) )
+    {
+      m_large.push_back( id );
+      return;
+    }
+    for ( auto y = y0; y <= y1; ++y )
+    {
+      for ( auto x = x0; x <= x1; ++x )
+      {
+        m_cells[ key( x, y ) ].push_back( id );
+      }
+    }
+    m_all.push_back( id );
+  }
+
+  // Call f( id ) for the boxes that may intersect an extent until it
+  // returns true; ids spread over several cells may be visited more than
+  // once.
+  template < typename F >
+  void visit( double min_x, double min_y, double max_x, double max_y,
+              F const& f ) const
+  {
+    for ( auto const id : m_large )
+    {
+      if ( f( id ) ) { return; }
+    }
+
+    int64_t x0, y0, x1, y1;
+    if ( ! cells( min_x, min_y, max_x, max_y, x0, y0, x1, y1 ) )
+    {
+      for ( auto const id : m_all )
+      {
+        if ( f( id ) ) { return; }
+      }
+      return;
+    }
+    for ( auto y = y0; y <= y1; ++y )
+    {
+      for ( auto x = x0; x <= x1; ++x )
+      {
+        auto const cell = m_cells.find( key( x, y ) );
+        if ( cell == m_cells.end() )
+        {
+          continue;
+        }
+        for ( auto const id : cell->second )
+        {
+          if ( f( id ) ) { return; }
+        }
+      }
+    }
+  }
+
+private:
+  // Range of cells touched by an extent; false if there are too many
+  bool cells( double min_x, double min_y, double max_x, double max_y,
+              int64_t& x0, int64_t& y0, int64_t& x1, int64_t& y1 ) const
+  {
+    double const limit = static_cast< double >( max_box_cells );
+    double const fx0 = std::floor( min_x / m_cell_size );
+    double const fy0 = std::floor( min_y / m_cell_size );
+    double const fx1 = std::floor( max_x / m_cell_size );
+    double const fy1 = std::floor( max_y / m_cell_size );
+    if ( !( ( fx1 - fx0 + 1 ) * ( fy1 - fy0 + 1 ) <= limit ) ||
+        std::abs( fx0 ) > 1e15 || std::abs( fy0 ) > 1e15 )
+    {
+      return false;
+    }
+    x0 = static_cast< int64_t >( fx0 );
+    y0 = static_cast< int64_t >( fy0 );
+    x1 = std::max( x0, static_cast< int64_t >( fx1 ) );
+    y1 = std::max( y0, static_cast< int64_t >( fy1 ) );
+    return true;
+  }
+
+  static uint64_t key( int64_t x, int64_t y )
+  {
+    return ( static_cast< uint64_t >( x ) << 32 ) ^
+           ( static_cast< uint64_t >( y ) & 0xffffffff );
+  }
+
+  double m_cell_size;
+  std::unordered_map< uint64_t, std::vector< size_t > > m_cells;
+  std::vector< size_t > m_large;
+  std::vector< size_t > m_all;
+};
+
+// ----------------------------------------------------------------------------
+// Size of grid cells for the boxes at indices, or zero to not use a grid
+double
+grid_cell_size( std::vector< size_t > const& indices,
+                std::vector< double > const& min_x,
+                std::vector< double > const& min_y,
+                std::vector< double > const& max_x,
+                std::vector< double > const& max_y )
+{
+  if ( indices.size() < nms_grid_min )
+  {
+    return 0.0;
+  }
+
+  // Cells about the size of a typical box keep the lists short
+  double sum = 0.0;
+  for ( auto const i : indices )
+  {
+    sum += std::max( max_x[ i ] - min_x[ i ], max_y[ i ] - min_y[ i ] );
+  }
+  auto const size = sum / static_cast< double >( indices.size() );
+  return ( std::isfinite( size ) && size > 0.0 ? size : 0.0 );
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+detected_object_columns
+::detected_object_columns( detected_object_set const& set )
+{
+  auto const n = set.size();
+  m_objects.reserve( n );
+  m_min_x.reserve( n );
+  m_min_y.reserve( n );
+  m_max_x.reserve( n );
+  m_max_y.reserve( n );
+  m_confidence.reserve( n );
+  m_most_likely.reserve( n );
+  m_class_offset.reserve( n + 1 );
+  m_class_offset.push_back( 0 );
+
+  for ( size_t i = 0; i < n; ++i )
+  {
+    auto const& det = set.at( i );
+    m_objects.push_back( det );
+
+    if ( ! det )
+    {
+      m_min_x.push_back( 0.0 );
+      m_min_y.push_back( 0.0 );
+      m_max_x.push_back( 0.0 );
+      m_max_y.push_back( 0.0 );
+      m_confidence.push_back( std::numeric_limits< double >::quiet_NaN() );
+      m_most_likely.push_back( no_class );
+      m_class_offset.push_back( m_class_id.size() );
+      continue;
+    }
+
+    auto const bbox = det->bounding_box();
+    m_min_x.push_back( bbox.min_x() );
+    m_min_y.push_back( bbox.min_y() );
+    m_max_x.push_back( bbox.max_x() );
+    m_max_y.push_back( bbox.max_y() );
+    m_confidence.push_back( det->confidence() );
+
+    // The most likely class is the first with the highest score, as for
+    // detected_object_type::get_most_likely()
+    class_id_t best = no_class;
+    if ( auto const type = det->type() )
+    {
+      auto const& ids = type->class_ids();
+      auto id = ids.begin();
+      double best_score = 0.0;
+      for ( auto const& entry : *type )
+      {
+        if ( best == no_class || entry.second > best_score )
+        {
+          best = *id;
+          best_score = entry.second;
+        }
+        m_class_id.push_back( *id );
+        m_class_score.push_back( entry.second );
+        ++id;
+      }
+    }
+    m_most_likely.push_back( best );
+    m_class_offset.push_back( m_class_id.size() );
+  }
+}
+
+// ----------------------------------------------------------------------------
+double
+detected_object_columns
+::score( size_t i, class_id_t class_id ) const
+{
+  auto const first = m_class_id.begin() + m_class_offset[ i ];
+  auto const last = m_class_id.begin() + m_class_offset[ i + 1 ];
+  auto const it = std::lower_bound( first, last, class_id );
+  if ( it == last || *it != class_id )
+  {
+    return std::numeric_limits< double >::quiet_NaN();
+  }
+  return m_class_score[ static_cast< size_t >( it - m_class_id.begin() ) ];
+}
+
+// ----------------------------------------------------------------------------
+std::vector< size_t >
+detected_object_columns
+::select( double threshold ) const
+{
+  std::vector< size_t > result;
+  for ( size_t i = 0; i < m_confidence.size(); ++i )
+  {
+    if ( m_confidence[ i ] >= threshold )
+    {
+      result.push_back( i );
+    }
+  }
+
+  sort_descending( result, m_confidence );
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< size_t >
+detected_object_columns
+::select( class_id_t class_id, double threshold ) const
+{
+  std::vector< size_t > result;
+  std::vector< double > scores( size() );
+  for ( size_t i = 0; i < size(); ++i )
+  {
+    scores[ i ] = score( i, class_id );
+    if ( scores[ i ] >= threshold )
+    {
+      result.push_back( i );
+    }
+  }
+
+  sort_descending( result, scores );
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< size_t >
+detected_object_columns
+::non_max_suppression( double iou_threshold ) const
+{
+  std::vector< size_t > order;
+  for ( size_t i = 0; i < size(); ++i )
+  {
+    if ( ! std::isnan( m_confidence[ i ] ) )
+    {
+      order.push_back( i );
+    }
+  }
+
+  sort_descending( order, m_confidence );
+  return non_max_suppression( order, iou_threshold );
+}
+
+// ----------------------------------------------------------------------------
+std::vector< size_t >
+detected_object_columns
+::non_max_suppression( std::vector< size_t > const& order,
+                       double iou_threshold ) const
+{
+  std::vector< size_t > result;
+
+  // Boxes of the kept detections, packed so the inner loop is contiguous
+  std::vector< double > k_min_x, k_min_y, k_max_x, k_max_y, k_area;
+
+  // Whether kept box k suppresses a candidate, written without branches so
+  // that loops over it can be vectorized
+  auto const suppresses =
+    [ & ]( size_t k, double min_x, double min_y, double max_x, double max_y,
+           double area ) -> bool
+    {
+      double const i_min_x = std::max( min_x, k_min_x[ k ] );
+      double const i_min_y = std::max( min_y, k_min_y[ k ] );
+      double const i_max_x = std::min( max_x, k_max_x[ k ] );
+      double const i_max_y = std::min( max_y, k_max_y[ k ] );
+      double const overlap_area =
+        ( i_max_x - i_min_x ) * ( i_max_y - i_min_y );
+      double const union_area = area + k_area[ k ] - overlap_area;
+
+      bool const overlaps = ( i_min_x <= i_max_x ) & ( i_min_y <= i_max_y );
+      return overlaps & ( union_area > 0 ) &
+             ( overlap_area / union_area > iou_threshold );
+    };
+
+  auto const cell_size =
+    grid_cell_size( order, m_min_x, m_min_y, m_max_x, m_max_y );
+  box_grid grid( cell_size );
+
+  for ( auto const i : order )
+  {
+    double const min_x = m_min_x[ i ];
+    double const min_y = m_min_y[ i ];
+    double const max_x = m_max_x[ i ];
+    double const max_y = m_max_y[ i ];
+    double const area = ( max_x - min_x ) * ( max_y - min_y );
+
+    bool suppressed = false;
+    if ( cell_size > 0.0 )
+    {
+      // Only kept boxes sharing a grid cell can overlap this one
+      grid.visit( min_x, min_y, max_x, max_y,
+        [ & ]( size_t k ){
+          suppressed = suppresses( k, min_x, min_y, max_x, max_y, area );
+          return suppressed;
+        } );
+    }
+    else
+    {
+      // Compare with blocks of kept boxes and stop at the first block with
+      // a hit
+      auto const kept = result.size();
+      for ( size_t b = 0; b < kept && ! suppressed; b += nms_block )
+      {
+        auto const e = std::min( kept, b + nms_block );
+        for ( size_t k = b; k < e; ++k )
+        {
+          suppressed |= suppresses( k, min_x, min_y, max_x, max_y, area );
+        }
+      }
+    }
+
+    if ( ! suppressed )
+    {
+      if ( cell_size > 0.0 )
+      {
+        grid.insert( result.size(), min_x, min_y, max_x, max_y );
+      }
+      result.push_back( i );
+      k_min_x.push_back( min_x );
+      k_min_y.push_back( min_y );
+      k_max_x.push_back( max_x );
+      k_max_y.push_back( max_y );
+      k_area.push_back( area );
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< std::pair< size_t, double > >
+detected_object_columns
+::soft_non_max_suppression( std::vector< size_t > const& candidates,
+                            bool gaussian, double iou_threshold,
+                            double sigma, double score_threshold ) const
+{
+  std::vector< std::pair< size_t, double > > result;
+
+  // Current score of each candidate, by position in candidates
+  auto const n = candidates.size();
+  std::vector< double > scores( n );
+  std::vector< char > alive( n, 0 );
+
+  // Highest score first, then the earliest candidate
+  using entry = std::pair< double, size_t >;
+  auto const lower = []( entry const& a, entry const& b )
+  {
+    return a.first < b.first || ( a.first == b.first && a.second > b.second );
+  };
+  std::priority_queue< entry, std::vector< entry >, decltype( lower ) >
+    queue( lower );
+
+  for ( size_t p = 0; p < n; ++p )
+  {
+    scores[ p ] = m_confidence[ candidates[ p ] ];
+    if ( scores[ p ] >= score_threshold )
+    {
+      alive[ p ] = 1;
+      queue.push( { scores[ p ], p } );
+    }
+  }
+
+  // Neighbors of a kept box are found in a grid of all candidate boxes
+  auto const cell_size =
+    grid_cell_size( candidates, m_min_x, m_min_y, m_max_x, m_max_y );
+  box_grid grid( cell_size );
+  if ( cell_size > 0.0 )
+  {
+    for ( size_t p = 0; p < n; ++p )
+    {
+      auto const i = candidates[ p ];
+      grid.insert( p, m_min_x[ i ], m_min_y[ i ], m_max_x[ i ], m_max_y[ i ] );
+    }
+  }
+
+  std::vector< char > visited( n, 0 );
+  std::vector< size_t > neighbors;
+
+  while ( ! queue.empty() )
+  {
+    auto const top = queue.top();
+    queue.pop();
+
+    // Entries are left behind when a score decays
+    auto const p = top.second;
+    if ( ! alive[ p ] || scores[ p ] != top.first )
+    {
+      continue;
+    }
+    alive[ p ] = 0;
+    auto const i = candidates[ p ];
+    result.emplace_back( i, scores[ p ] );
+
+    neighbors.clear();
+    auto const add_neighbor = [ & ]( size_t q )
+    {
+      if ( alive[ q ] && ! visited[ q ] )
+      {
+        visited[ q ] = 1;
+        neighbors.push_back( q );
+      }
+      return false;
+    };
+    if ( cell_size > 0.0 )
+    {
+      grid.visit( m_min_x[ i ], m_min_y[ i ], m_max_x[ i ], m_max_y[ i ],
+                  add_neighbor );
+    }
+    else
+    {
+      for ( size_t q = 0; q < n; ++q )
+      {
+        add_neighbor( q );
+      }
+    }
+
+    for ( auto const q : neighbors )
+    {
+      visited[ q ] = 0;
+
+      auto const overlap = iou( i, candidates[ q ] );
+      double weight = 1.0;
+      if ( gaussian )
+      {
+        weight = std::exp( -( overlap * overlap ) / sigma );
+      }
+      else if ( overlap > iou_threshold )
+      {
+        weight = 1.0 - overlap;
+      }
+      if ( overlap <= 0.0 || weight == 1.0 )
+      {
+        continue;
+      }
+
+      scores[ q ] *= weight;
+      if ( scores[ q ] < score_threshold )
+      {
+        alive[ q ] = 0;
+      }
+      else
+      {
+        queue.push( { scores[ q ], q } );
+      }
+    }
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+double
+detected_object_columns
+::iou( size_t a, size_t b ) const
+{
+  double const i_min_x = std::max( m_min_x[ a ], m_min_x[ b ] );
+  double const i_min_y = std::max( m_min_y[ a ], m_min_y[ b ] );
+  double const i_max_x = std::min( m_max_x[ a ], m_max_x[ b ] );
+  double const i_max_y = std::min( m_max_y[ a ], m_max_y[ b ] );
+  if ( !( i_min_x <= i_max_x && i_min_y <= i_max_y ) )
+  {
+    return 0.0;
+  }
+
+  double const overlap_area = ( i_max_x - i_min_x ) * ( i_max_y - i_min_y );
+  double const union_area =
+    ( m_max_x[ a ] - m_min_x[ a ] ) * ( m_max_y[ a ] - m_min_y[ a ] ) +
+    ( m_max_x[ b ] - m_min_x[ b ] ) * ( m_max_y[ b ] - m_min_y[ b ] ) -
+    overlap_area;
+  return ( union_area > 0.0 ? overlap_area / union_area : 0.0 );
+}
+
+// ----------------------------------------------------------------------------
+detected_object_set_sptr
+detected_object_columns
+::make_set( std::vector< size_t > const& indices ) const
+{
+  std::vector< detected_object_sptr > objects;
+  objects.reserve( indices.size() );
+  for ( auto const i : indices )
+  {
+    objects.push_back( m_objects[ i ] );
+  }
+  return std::make_shared< detected_object_set >( objects );
+}
+
+} } // end namespace
@@ -0,0 +1,146 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Interface for detected_object_columns
+
+#ifndef VITAL_DETECTED_OBJECT_COLUMNS_H_
+#define VITAL_DETECTED_OBJECT_COLUMNS_H_
+
+#include <vital/vital_export.h>
+
+#include <vital/types/detected_object_set.h>
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace kwiver {
+namespace vital {
+
+// ----------------------------------------------------------------------------
+/// Columnar view of the detections of a set.
+///
+/// This class copies the bounding boxes, confidences and class scores of a
+/// set of detections into contiguous arrays, one value per detection, so that
+/// bulk operations such as selection and non-maximum suppression can run over
+/// them without following a pointer per detection. Detections are referred
+/// to by their index in the source set. The objects themselves are kept only
+/// by pointer, and are gathered into a new set by make_set() once the
+/// operations are done.
+///
+/// The columns are a snapshot; later changes to the detections are not seen.
+/// Null detections have a NaN confidence and no classes, so they are never
+/// selected.
+class VITAL_EXPORT detected_object_columns
+{
+public:
+  using class_id_t = detected_object_type::class_id_t;
+
+  static constexpr class_id_t no_class =
+    std::numeric_limits< class_id_t >::max();
+
+  /// Create columns for the detections of \p set.
+  explicit detected_object_columns( detected_object_set const& set );
+
+  /// Number of detections.
+  size_t size() const { return m_objects.size(); }
+
+  /// \name Columns indexed by detection
+  ///@{
+  std::vector< double > const& min_x() const { return m_min_x; }
+  std::vector< double > const& min_y() const { return m_min_y; }
+  std::vector< double > const& max_x() const { return m_max_x; }
+  std::vector< double > const& max_y() const { return m_max_y; }
+  std::vector< double > const& confidence() const { return m_confidence; }
+
+  /// Most likely class of each detection, or no_class if it has none.
+  std::vector< class_id_t > const& most_likely_class() const
+  { return m_most_likely; }
+  ///@}
+
+  /// Score of detection \p i for class \p class_id.
+  ///
+  /// \return The score, or NaN if the detection does not have the class.
+  double score( size_t i, class_id_t class_id ) const;
+
+  /// The detection at index \p i.
+  detected_object_sptr object( size_t i ) const { return m_objects[ i ]; }
+
+  /// Indices of detections with a confidence of at least \p threshold.
+  ///
+  /// The indices are ordered by decreasing confidence, and by index among
+  /// equal confidences.
+  std::vector< size_t > select(
+    double threshold = detected_object_type::INVALID_SCORE ) const;
+
+  /// Indices of detections with a score of at least \p threshold for class
+  /// \p class_id.
+  ///
+  /// The indices are ordered by decreasing score, and by index among equal
+  /// scores.
+  std::vector< size_t > select(
+    class_id_t class_id,
+    double threshold = detected_object_type::INVALID_SCORE ) const;
+
+  /// Indices of detections not suppressed by a more confident one.
+  ///
+  /// Candidates are taken in order of decreasing confidence, and each is
+  /// kept unless its box overlaps that of a kept detection with an
+  /// intersection over union greater than \p iou_threshold.
+  std::vector< size_t > non_max_suppression( double iou_threshold ) const;
+
+  /// Thin out the detections at \p order, taken in that order, as
+  /// non_max_suppression() does.
+  ///
+  /// Long lists are sped up by binning the kept boxes in a uniform grid, so
+  /// that each candidate is only compared with kept boxes near it.
+  std::vector< size_t > non_max_suppression(
+    std::vector< size_t > const& order, double iou_threshold ) const;
+
+  /// Soft non-maximum suppression of the detections at \p candidates.
+  ///
+  /// Rather than removing the detections overlapping a kept one, their
+  /// scores are decayed: by a factor of (1 - IoU) for an IoU above
+  /// \p iou_threshold, or, if \p gaussian is set, by exp(-IoU^2 / \p sigma)
+  /// for any overlap. The detection with the highest remaining score is kept
+  /// next, and detections whose score falls below \p score_threshold are
+  /// dropped. Initial scores are the confidences.
+  ///
+  /// \return Indices of the kept detections with their decayed scores, in
+  ///         the order they were kept.
+  std::vector< std::pair< size_t, double > > soft_non_max_suppression(
+    std::vector< size_t > const& candidates, bool gaussian,
+    double iou_threshold, double sigma, double score_threshold ) const;
+
+  /// Intersection over union of the boxes of detections \p a and \p b.
+  ///
+  /// \return The ratio, or zero if the boxes do not intersect.
+  double iou( size_t a, size_t b ) const;
+
+  /// Gather the detections at \p indices, in that order, into a new set.
+  ///
+  /// The set shares the detection objects with the source set.
+  detected_object_set_sptr make_set( std::vector< size_t > const& indices ) const;
+
+private:
+  std::vector< detected_object_sptr > m_objects;
+
+  std::vector< double > m_min_x;
+  std::vector< double > m_min_y;
+  std::vector< double > m_max_x;
+  std::vector< double > m_max_y;
+  std::vector< double > m_confidence;
+  std::vector< class_id_t > m_most_likely;
+
+  /// Class scores of detection i are at [m_class_offset[i],
+  /// m_class_offset[i + 1]) of m_class_id and m_class_score, by class id.
+  std::vector< size_t > m_class_offset;
+  std::vector< class_id_t > m_class_id;
+  std::vector< double > m_class_score;
+};
+
+} } // end namespace
+
+#endif // VITAL_DETECTED_OBJECT_COLUMNS_H_
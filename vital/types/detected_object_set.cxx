@@ -3,6 +3,7 @@
 // https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
 
 #include "detected_object_set.h"
+#include "detected_object_columns.h"
 #include "bounding_box.h"
 
 #include <algorithm>
@@ -11,37 +12,6 @@
 namespace kwiver {
 namespace vital {
 
-// ----------------------------------------------------------------------------
-namespace {
-
-struct descending_confidence
-{
-  bool operator()( detected_object_sptr const& a, detected_object_sptr const& b ) const
-  {
-    if( a && !b )
-    {
-      return true;
-    }
-    else if( !a )
-    {
-      return false;
-    }
-    return a->confidence() > b->confidence();
-  }
-};
-
-template < typename T1, typename T2 >
-struct more_first
-{
-  typedef std::pair< T1, T2 > type;
-  bool operator()( type const& a, type const& b ) const
-  {
-    return a.first > b.first;
-  }
-};
-
-} // end namespace
-
 // ----------------------------------------------------------------------------
 detected_object_set::
 detected_object_set()
@@ -124,19 +94,8 @@ select( double threshold ) const
 {
   // The main list can get out of order if somebody updates the
   // confidence value of a detection directly
-  std::vector< detected_object_sptr> vect;
-
-  auto ie =  cend();
-  for ( auto ix = cbegin(); ix != ie; ++ix )
-  {
-    if ( (*ix)->confidence() >= threshold )
-    {
-      vect.push_back( *ix );
-    }
-  }
-
-  std::sort( vect.begin(), vect.end(), descending_confidence() );
-  return std::make_shared< detected_object_set > (vect);
+  detected_object_columns const columns( *this );
+  return columns.make_set( columns.select( threshold ) );
 }
 
 // ----------------------------------------------------------------------------
@@ -144,53 +103,24 @@ detected_object_set_sptr
 detected_object_set::
 select( const std::string& class_name, double threshold )const
 {
-  // Intermediate sortable data structure
-  std::vector< std::pair< double, detected_object_sptr > > data;
-
-  // Create a sortable list by selecting
-  auto ie = cend();
-  for ( auto ix = cbegin(); ix != ie; ++ix )
+  // A name which was never used cannot be the class of any object
+  detected_object_type::class_id_t class_id;
+  if ( ! detected_object_type::find_class_id( class_name, class_id ) )
   {
-    auto obj_type = (*ix)->type();
-    if ( ! obj_type )
-    {
-      continue;  // Must have a type assigned
-    }
-
-    double score(0);
-    try
-    {
-      score = obj_type->score( class_name );
-    }
-    catch (const std::runtime_error& )
-    {
-      // Object did not have the desired class_name. This not fatal,
-      // but since we are looking for that name, there is some
-      // expectation that it is present.
-
-      //+ maybe log something?
-      continue;
-    }
-
-    // Select those not below threshold
-    if ( score >= threshold )
-    {
-      data.push_back( std::pair< double, detected_object_sptr >( score, *ix ) );
-    }
-  } // end foreach
-
-  // Sort on score
-  std::sort( data.begin(), data.end(), more_first< double,  detected_object_sptr >() );
-
-  // Create new vector for return
-  std::vector< detected_object_sptr > vect;
-
-  for( auto i : data )
-  {
-    vect.push_back( i.second );
+    return std::make_shared< detected_object_set >();
   }
 
-  return std::make_shared< detected_object_set > (vect);
+  detected_object_columns const columns( *this );
+  return columns.make_set( columns.select( class_id, threshold ) );
+}
+
+// ----------------------------------------------------------------------------
+detected_object_set_sptr
+detected_object_set::
+non_max_suppression( double iou_threshold ) const
+{
+  detected_object_columns const columns( *this );
+  return columns.make_set( columns.non_max_suppression( iou_threshold ) );
 }
 
 // ----------------------------------------------------------------------------
@@ -140,6 +140,22 @@ class VITAL_EXPORT detected_object_set
     const std::string& class_name,
     double threshold = detected_object_type::INVALID_SCORE ) const;
 
+  /// Select detections that are not suppressed by a more confident one.
+  ///
+  /// This method returns the detections ordered by confidence value, from
+  /// high to low, leaving out each detection whose bounding box overlaps
+  /// that of a more confident selected detection with an intersection over
+  /// union greater than \p iou_threshold. Classes are not considered.
+  ///
+  /// The returned vector refers to the actual detections in the set, as for
+  /// select().
+  ///
+  /// \param iou_threshold
+  ///   Largest intersection over union allowed between selected detections.
+  ///
+  /// \return List of detections.
+  detected_object_set_sptr non_max_suppression( double iou_threshold ) const;
+
   /// Scale all detection locations by some scale factor.
   ///
   /// This method changes the bounding boxes within all stored detections by
@@ -4,6 +4,12 @@
 
 #include "detected_object_set_util.h"
 
+#include <vital/types/detected_object_columns.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
 namespace kwiver {
 namespace vital {
 
@@ -44,4 +50,67 @@ shift_detections( detected_object_set_sptr dos,
   }
 }
 
+// ----------------------------------------------------------------------------
+detected_object_set_sptr
+non_max_suppression( detected_object_set const& dos,
+                     nms_options const& options )
+{
+  detected_object_columns const columns( dos );
+  auto const candidates =
+    columns.select( -std::numeric_limits< double >::infinity() );
+
+  // Split candidates by class, keeping them ordered by confidence
+  std::map< detected_object_columns::class_id_t,
+            std::vector< size_t > > groups;
+  for( auto const i : candidates )
+  {
+    auto const id =
+      ( options.class_aware ? columns.most_likely_class()[ i ]
+                            : detected_object_columns::no_class );
+    groups[ id ].push_back( i );
+  }
+
+  // Rank of each candidate, and score it is left with
+  std::vector< std::pair< size_t, double > > kept;
+  for( auto const& group : groups )
+  {
+    if( options.method == nms_method::greedy )
+    {
+      for( auto const i :
+           columns.non_max_suppression( group.second, options.iou_threshold ) )
+      {
+        kept.emplace_back( i, columns.confidence()[ i ] );
+      }
+    }
+    else
+    {
+      auto const result = columns.soft_non_max_suppression(
+        group.second, options.method == nms_method::soft_gaussian,
+        options.iou_threshold, options.sigma, options.score_threshold );
+      kept.insert( kept.end(), result.begin(), result.end() );
+    }
+  }
+
+  // Merge the groups by score, and by position in the input among ties
+  std::stable_sort( kept.begin(), kept.end(),
+    []( std::pair< size_t, double > const& a,
+        std::pair< size_t, double > const& b ){
+      return a.second > b.second ||
+             ( a.second == b.second && a.first < b.first );
+    } );
+
+  auto result = std::make_shared< detected_object_set >();
+  for( auto const& k : kept )
+  {
+    auto det = columns.object( k.first );
+    if( k.second != det->confidence() )
+    {
+      det = det->clone();
+      det->set_confidence( k.second );
+    }
+    result->add( det );
+  }
+  return result;
+}
+
 } } // end namespace
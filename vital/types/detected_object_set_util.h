@@ -37,6 +37,52 @@ void VITAL_EXPORT
 shift_detections( detected_object_set_sptr dos,
                   double col_shift, double row_shift );
 
+/// Method of non-maximum suppression.
+enum class nms_method
+{
+  /// Remove detections overlapping a more confident one
+  greedy,
+  /// Decay the confidence of overlapping detections by (1 - IoU)
+  soft_linear,
+  /// Decay the confidence of overlapping detections by exp(-IoU^2 / sigma)
+  soft_gaussian,
+};
+
+/// Options of non_max_suppression().
+struct nms_options
+{
+  nms_method method = nms_method::greedy;
+
+  /// Intersection over union above which a detection is suppressed, or, with
+  /// soft_linear, decayed
+  double iou_threshold = 0.5;
+
+  /// Spread of the soft_gaussian decay
+  double sigma = 0.5;
+
+  /// Decayed confidence below which a detection is dropped by soft methods
+  double score_threshold = 0.001;
+
+  /// Only let detections suppress others with the same most likely class
+  bool class_aware = false;
+};
+
+/// @brief Thin out overlapping detections.
+///
+/// Detections are considered in order of decreasing confidence. With the
+/// greedy method, this is detected_object_set::non_max_suppression(). The
+/// soft methods instead lower the confidence of detections overlapping a kept
+/// one; detections whose confidence changes are cloned, so the input set is
+/// not modified.
+///
+/// @param dos Detections to thin out
+/// @param options How detections are suppressed
+///
+/// @return The kept detections, in order of decreasing (decayed) confidence.
+VITAL_EXPORT detected_object_set_sptr
+non_max_suppression( detected_object_set const& dos,
+                     nms_options const& options = {} );
+
 } } // end namespace
 
 #endif // VITAL_DETECTED_OBJECT_SET_UTIL_H
@@ -32,7 +32,10 @@ using feature_track_set_frame_data_sptr =
 
 // ----------------------------------------------------------------------------
 /// A derived track_state for feature tracks
-class VITAL_EXPORT feature_track_state : public track_state
+class VITAL_EXPORT feature_track_state
+  : public track_state,
+    private memory_accounted< feature_track_state,
+                              memory_category::track_state, track_state >
 {
 public:
   //@{
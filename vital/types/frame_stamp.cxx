@@ -0,0 +1,39 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "frame_stamp.h"
+
+namespace kwiver {
+namespace vital {
+
+constexpr frame_id_t frame_stamp::max_frame;
+constexpr frame_stamp::stream_t frame_stamp::max_stream;
+
+// ----------------------------------------------------------------------------
+std::ostream&
+operator<<( std::ostream& str, frame_stamp const& obj )
+{
+  str << "fs(f: ";
+  if ( obj.has_valid_frame() )
+  {
+    str << obj.frame();
+  }
+  else
+  {
+    str << "<inv>";
+  }
+  str << ", t: ";
+  if ( obj.has_valid_time() )
+  {
+    str << obj.time_usec();
+  }
+  else
+  {
+    str << "<inv>";
+  }
+  str << ", s: " << obj.stream() << ")";
+  return str;
+}
+
+} } // end namespace
@@ -0,0 +1,195 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Compact frame stamp combining frame, time and stream
+
+#ifndef VITAL_TYPES_FRAME_STAMP_H_
+#define VITAL_TYPES_FRAME_STAMP_H_
+
+#include <vital/types/timestamp.h>
+
+#include <vital/vital_export.h>
+#include <vital/vital_types.h>
+
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+namespace kwiver {
+namespace vital {
+
+// ----------------------------------------------------------------------------
+/// \brief Frame number, time and stream of a frame in 16 bytes.
+///
+/// This is a trivially copyable alternative to \ref timestamp for code which
+/// handles a stamp for every frame, such as synchronizing or reordering
+/// frames. The frame number and stream are packed into one 64-bit key, so
+/// two stamps are compared with at most two integer compares.
+///
+/// The stream identifies the source of the frame when several videos pass
+/// through the same pipeline, and corresponds to the time domain index of a
+/// timestamp. Frame numbers from zero to max_frame and streams from zero to
+/// max_stream are supported. Frames and times may each be invalid, as in a
+/// timestamp.
+///
+/// Stamps are ordered by stream, then frame number, then time, with
+/// invalid frames and times after valid ones. Unlike timestamp, any two
+/// stamps are comparable, so they can be used as keys of ordered
+/// containers.
+class VITAL_EXPORT frame_stamp
+{
+public:
+  typedef uint16_t stream_t;
+
+  static constexpr frame_id_t max_frame = ( frame_id_t{ 1 } << 48 ) - 2;
+  static constexpr stream_t max_stream = std::numeric_limits< stream_t >::max();
+
+  /// Create a stamp with invalid time and frame on stream zero.
+  constexpr frame_stamp()
+    : m_time( invalid_time ), m_key( invalid_frame )
+  { }
+
+  /// Create a stamp with valid time and frame.
+  ///
+  /// \param t Time in microseconds
+  /// \param f Frame number, from zero to max_frame
+  /// \param s Stream of the frame
+  constexpr frame_stamp( time_usec_t t, frame_id_t f, stream_t s = 0 )
+    : m_time( t ), m_key( pack( f, s ) )
+  { }
+
+  /// Create a stamp from a timestamp.
+  ///
+  /// The stream is the time domain index of the timestamp. Frame numbers
+  /// and time domain indices out of range are not valid.
+  explicit frame_stamp( timestamp const& ts )
+    : m_time( ts.has_valid_time() ? ts.get_time_usec() : invalid_time ),
+      m_key( invalid_frame )
+  {
+    auto const domain = ts.get_time_domain_index();
+    if ( domain >= 0 && domain <= max_stream )
+    {
+      m_key = pack( ts.has_valid_frame() ? ts.get_frame() : -1,
+                    static_cast< stream_t >( domain ) );
+    }
+  }
+
+  /// Convert to a timestamp in the time domain of the stream.
+  timestamp to_timestamp() const
+  {
+    timestamp ts;
+    if ( has_valid_time() )
+    {
+      ts.set_time_usec( m_time );
+    }
+    if ( has_valid_frame() )
+    {
+      ts.set_frame( frame() );
+    }
+    ts.set_time_domain_index( stream() );
+    return ts;
+  }
+
+  constexpr bool has_valid_time() const { return m_time != invalid_time; }
+  constexpr bool has_valid_frame() const
+  { return ( m_key & frame_mask ) != invalid_frame; }
+  constexpr bool is_valid() const
+  { return has_valid_time() && has_valid_frame(); }
+
+  /// Time in microseconds; undetermined if the time is not valid.
+  constexpr time_usec_t time_usec() const { return m_time; }
+
+  /// Frame number; undetermined if the frame is not valid.
+  constexpr frame_id_t frame() const
+  { return static_cast< frame_id_t >( m_key & frame_mask ); }
+
+  constexpr stream_t stream() const
+  { return static_cast< stream_t >( m_key >> frame_bits ); }
+
+  /// Stream and frame number packed in one value.
+  ///
+  /// Keys of valid frames of one stream increase with the frame number.
+  /// Frames of the same stream and number have the same key.
+  constexpr uint64_t key() const { return m_key; }
+
+  frame_stamp& set_time_usec( time_usec_t t )
+  { m_time = t; return *this; }
+  frame_stamp& set_frame( frame_id_t f )
+  { m_key = pack( f, stream() ); return *this; }
+  frame_stamp& set_stream( stream_t s )
+  { m_key = pack_key( m_key & frame_mask, s ); return *this; }
+  frame_stamp& set_invalid()
+  { m_time = invalid_time; m_key |= frame_mask; return *this; }
+
+  constexpr bool operator==( frame_stamp const& rhs ) const
+  { return m_key == rhs.m_key && m_time == rhs.m_time; }
+  constexpr bool operator!=( frame_stamp const& rhs ) const
+  { return !( *this == rhs ); }
+  constexpr bool operator<( frame_stamp const& rhs ) const
+  {
+    return m_key != rhs.m_key
+           ? m_key < rhs.m_key
+           : time_order( m_time ) < time_order( rhs.m_time );
+  }
+  constexpr bool operator>( frame_stamp const& rhs ) const
+  { return rhs < *this; }
+  constexpr bool operator<=( frame_stamp const& rhs ) const
+  { return !( rhs < *this ); }
+  constexpr bool operator>=( frame_stamp const& rhs ) const
+  { return !( *this < rhs ); }
+
+private:
+  static constexpr int frame_bits = 48;
+  static constexpr uint64_t frame_mask = ( uint64_t{ 1 } << frame_bits ) - 1;
+  static constexpr uint64_t invalid_frame = frame_mask;
+  static constexpr time_usec_t invalid_time =
+    std::numeric_limits< time_usec_t >::min();
+
+  // Map times to unsigned values in the same order, except that the
+  // invalid time, which is the lowest, becomes the highest
+  static constexpr uint64_t time_order( time_usec_t t )
+  { return ( static_cast< uint64_t >( t ) ^ ( uint64_t{ 1 } << 63 ) ) - 1; }
+
+  static constexpr uint64_t pack_key( uint64_t f, stream_t s )
+  { return ( static_cast< uint64_t >( s ) << frame_bits ) | f; }
+  static constexpr uint64_t pack( frame_id_t f, stream_t s )
+  {
+    return pack_key( ( f >= 0 && f <= max_frame )
+                     ? static_cast< uint64_t >( f ) : invalid_frame, s );
+  }
+
+  time_usec_t m_time;
+  uint64_t m_key;
+};
+
+static_assert( sizeof( frame_stamp ) == 16,
+               "frame_stamp should be 16 bytes" );
+static_assert( std::is_trivially_copyable< frame_stamp >::value,
+               "frame_stamp should be trivially copyable" );
+
+// ----------------------------------------------------------------------------
+VITAL_EXPORT std::ostream& operator<<( std::ostream& str,
+                                       frame_stamp const& obj );
+
+} } // end namespace
+
+namespace std {
+
+// ----------------------------------------------------------------------------
+template <>
+struct hash< kwiver::vital::frame_stamp >
+{
+  size_t operator()( kwiver::vital::frame_stamp const& s ) const
+  {
+    auto const t = static_cast< uint64_t >( s.time_usec() );
+    return std::hash< uint64_t >{}( s.key() ^ ( t * 0x9e3779b97f4a7c15ull ) );
+  }
+};
+
+} // end namespace std
+
+#endif // VITAL_TYPES_FRAME_STAMP_H_
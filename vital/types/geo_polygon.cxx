@@ -62,13 +62,9 @@ ::polygon( int crs ) const
   auto const i = m_poly.find( crs );
   if ( i == m_poly.end() )
   {
-    auto new_poly = geo_raw_polygon_t{};
-    auto const verts = polygon().get_vertices();
-
-    for ( auto& v : verts )
-    {
-      new_poly.push_back( geo_conv( v, m_original_crs, crs ) );
-    }
+    auto const new_poly =
+      geo_raw_polygon_t( geo_conv( polygon().get_vertices(),
+                                   m_original_crs, crs ) );
     m_poly.emplace( crs, new_poly );
     return new_poly;
   }
@@ -80,6 +80,50 @@ geo_conv( vector_3d const& point, int from, int to )
   return ( *c )( point, from, to );
 }
 
+// ----------------------------------------------------------------------------
+void
+geo_conv( vector_2d* points, size_t count, int from, int to )
+{
+  auto const c = s_geo_conv.load();
+  if ( !c )
+  {
+    throw std::runtime_error( "No geo-conversion functor is registered" );
+  }
+
+  ( *c )( points, count, from, to );
+}
+
+// ----------------------------------------------------------------------------
+void
+geo_conv( vector_3d* points, size_t count, int from, int to )
+{
+  auto const c = s_geo_conv.load();
+  if ( !c )
+  {
+    throw std::runtime_error( "No geo-conversion functor is registered" );
+  }
+
+  ( *c )( points, count, from, to );
+}
+
+// ----------------------------------------------------------------------------
+std::vector< vector_2d >
+geo_conv( std::vector< vector_2d > const& points, int from, int to )
+{
+  auto result = points;
+  geo_conv( result.data(), result.size(), from, to );
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+std::vector< vector_3d >
+geo_conv( std::vector< vector_3d > const& points, int from, int to )
+{
+  auto result = points;
+  geo_conv( result.data(), result.size(), from, to );
+  return result;
+}
+
 // ----------------------------------------------------------------------------
 utm_ups_zone_t
 utm_ups_zone( double lon, double lat )
@@ -14,6 +14,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace kwiver {
 namespace vital {
@@ -60,6 +61,27 @@ class geo_conversion
   virtual vector_2d operator()( vector_2d const& point, int from, int to ) = 0;
   virtual vector_3d operator()( vector_3d const& point, int from, int to ) = 0;
 
+  //@{
+  /// Convert \p count points in place. Implementations should override
+  /// these to convert the whole array at once; the defaults convert one
+  /// point at a time.
+  virtual void operator()( vector_2d* points, size_t count, int from, int to )
+  {
+    for ( size_t i = 0; i < count; ++i )
+    {
+      points[ i ] = ( *this )( points[ i ], from, to );
+    }
+  }
+
+  virtual void operator()( vector_3d* points, size_t count, int from, int to )
+  {
+    for ( size_t i = 0; i < count; ++i )
+    {
+      points[ i ] = ( *this )( points[ i ], from, to );
+    }
+  }
+  //@}
+
 protected:
   virtual ~geo_conversion() = default;
 };
@@ -92,6 +114,28 @@ VITAL_EXPORT vector_2d geo_conv( vector_2d const& point, int from, int to );
 VITAL_EXPORT vector_3d geo_conv( vector_3d const& point, int from, int to );
 //@}
 
+//@{
+/// \brief Convert many geo-coordinates.
+///
+/// This converts an array of raw geo-coordinates from one CRS to another, as
+/// geo_conv() does for a single point, but with one call to the conversion
+/// functor. Prefer this when converting many points, such as the vertices of
+/// a polygon or the cells of a grid.
+///
+/// The pointer overloads convert \p count points in place; if the conversion
+/// fails, the contents of \p points are unspecified.
+///
+/// \throws std::runtime_error
+///   Thrown if the conversion of any point fails or if no conversion function
+///   has been registered.
+VITAL_EXPORT void geo_conv( vector_2d* points, size_t count, int from, int to );
+VITAL_EXPORT void geo_conv( vector_3d* points, size_t count, int from, int to );
+VITAL_EXPORT std::vector< vector_2d > geo_conv(
+  std::vector< vector_2d > const& points, int from, int to );
+VITAL_EXPORT std::vector< vector_3d > geo_conv(
+  std::vector< vector_3d > const& points, int from, int to );
+//@}
+
 /// UTM/UPS zone specification.
 struct utm_ups_zone_t
 {
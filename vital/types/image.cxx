@@ -6,6 +6,11 @@
 /// \brief core image class implementation
 
 #include "image.h"
+
+#include <vital/util/memory_accounting.h>
+
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <utility>
 
@@ -72,25 +77,31 @@ std::ostream& operator<<(std::ostream& os, image_pixel_traits const& pt)
 image_memory
 ::image_memory()
   : data_( 0 ),
-    size_( 0 )
+    size_( 0 ),
+    accounted_size_( 0 )
 {
+  memory_accounting::allocate( memory_category::image, 0 );
 }
 
 /// Constructor - allocated n bytes
 image_memory
 ::image_memory( size_t n )
   : data_( new char[n] ),
-    size_( n )
+    size_( n ),
+    accounted_size_( n )
 {
+  memory_accounting::allocate( memory_category::image, n );
 }
 
 /// Copy Constructor
 image_memory
 ::image_memory( const image_memory& other )
   : data_( new char[other.size()] ),
-    size_( other.size() )
+    size_( other.size() ),
+    accounted_size_( other.size() )
 {
   std::memcpy( data_, other.data_, size_ );
+  memory_accounting::allocate( memory_category::image, size_ );
 }
 
 /// Destructor
@@ -98,6 +109,7 @@ image_memory
 ::~image_memory()
 {
   delete [] reinterpret_cast< char* > ( data_ );
+  memory_accounting::release( memory_category::image, accounted_size_ );
 }
 
 /// Assignment operator
@@ -122,6 +134,7 @@ ::operator=( const image_memory& other )
   }
 
   std::memcpy( data_, other.data_, size_ );
+  update_accounting();
   return *this;
 }
 
@@ -133,6 +146,19 @@ ::data()
   return data_;
 }
 
+/// Report the current size to memory accounting
+void
+image_memory
+::update_accounting()
+{
+  if ( size_ != accounted_size_ )
+  {
+    memory_accounting::allocate( memory_category::image, size_, 0 );
+    memory_accounting::release( memory_category::image, accounted_size_, 0 );
+    accounted_size_ = size_;
+  }
+}
+
 // ----------------------------------------------------------------------------
 
 /// Default Constructor
@@ -296,6 +322,50 @@ ::is_contiguous() const
          sizes[2].first == static_cast<ptrdiff_t>(sizes[0].second * sizes[1].second);
 }
 
+namespace {
+
+/// Copy \p count pixels of \p N bytes between strided locations
+///
+/// A size known at compile time turns the copy of each pixel into a single
+/// move.
+template <size_t N>
+void
+copy_pixels( const byte* src, ptrdiff_t src_step,
+             byte* dst, ptrdiff_t dst_step, size_t count )
+{
+  for ( size_t i = 0; i < count; ++i, src += src_step, dst += dst_step )
+  {
+    std::memcpy( dst, src, N );
+  }
+}
+
+/// Copy \p count pixels of \p num_bytes bytes between strided locations
+void
+copy_pixels( size_t num_bytes, const byte* src, ptrdiff_t src_step,
+             byte* dst, ptrdiff_t dst_step, size_t count )
+{
+  ptrdiff_t const pixel_step = static_cast<ptrdiff_t>( num_bytes );
+  if ( src_step == pixel_step && dst_step == pixel_step )
+  {
+    std::memcpy( dst, src, count * num_bytes );
+    return;
+  }
+  switch ( num_bytes )
+  {
+    case 1: copy_pixels<1>( src, src_step, dst, dst_step, count ); return;
+    case 2: copy_pixels<2>( src, src_step, dst, dst_step, count ); return;
+    case 4: copy_pixels<4>( src, src_step, dst, dst_step, count ); return;
+    case 8: copy_pixels<8>( src, src_step, dst, dst_step, count ); return;
+    default: break;
+  }
+  for ( size_t i = 0; i < count; ++i, src += src_step, dst += dst_step )
+  {
+    std::memcpy( dst, src, num_bytes );
+  }
+}
+
+} // end anonymous namespace
+
 /// Deep copy the image data from another image into this one
 void
 image
@@ -335,18 +405,25 @@ ::copy_from( const image& other )
     return;
   }
 
-  for ( unsigned int d = 0; d < depth_; ++d, o_data += o_d_step, data += d_step )
+  // traverse in the memory order of this image, smallest step innermost
+  struct dimension { ptrdiff_t step; ptrdiff_t o_step; size_t size; };
+  dimension dims[3] = { { w_step, o_w_step, width_ },
+                        { h_step, o_h_step, height_ },
+                        { d_step, o_d_step, depth_ } };
+  std::sort( dims, dims + 3,
+             []( dimension const& a, dimension const& b )
+             { return std::abs( a.step ) < std::abs( b.step ); } );
+
+  for ( size_t i2 = 0; i2 < dims[2].size;
+        ++i2, o_data += dims[2].o_step, data += dims[2].step )
   {
     const byte* o_row = o_data;
     byte* row = data;
-    for ( unsigned int h = 0; h < height_; ++h, o_row += o_h_step, row += h_step )
+    for ( size_t i1 = 0; i1 < dims[1].size;
+          ++i1, o_row += dims[1].o_step, row += dims[1].step )
     {
-      const byte* o_pixel = o_row;
-      byte* pixel = row;
-      for ( unsigned int w = 0; w < width_; ++w, o_pixel += o_w_step, pixel += w_step )
-      {
-        std::memcpy(pixel, o_pixel, pixel_traits_.num_bytes);
-      }
+      copy_pixels( pixel_traits_.num_bytes, o_row, dims[0].o_step,
+                   row, dims[0].step, dims[0].size );
     }
   }
 }
@@ -392,6 +469,25 @@ ::crop(size_t x_offset, size_t y_offset, size_t width, size_t height) const
                 this->pixel_traits() );
 }
 
+/// Get a view of the image with the order of the channels reversed.
+image
+image
+::reverse_channels() const
+{
+  if( this->depth() < 2 )
+  {
+    return *this;
+  }
+  auto last_channel = reinterpret_cast< const char* >( this->first_pixel() );
+  last_channel +=
+    static_cast< ptrdiff_t >( this->pixel_traits().num_bytes ) *
+    this->d_step() * static_cast< ptrdiff_t >( this->depth() - 1 );
+  return image( this->memory(), last_channel,
+                this->width(), this->height(), this->depth(),
+                this->w_step(), this->h_step(), -this->d_step(),
+                this->pixel_traits() );
+}
+
 /// Compare to images to see if the pixels have the same values.
 bool
 equal_content( const image& img1, const image& img2 )
@@ -187,11 +187,21 @@ class VITAL_EXPORT image_memory
   size_t size() const { return size_; }
 
 protected:
+  /// Report the current size_ to memory accounting
+  ///
+  /// Derived classes which set size_ themselves call this afterward, so that
+  /// the memory they wrap is accounted as image memory.
+  void update_accounting();
+
   /// The image data
   void* data_;
 
   /// The number of bytes allocated
   size_t size_;
+
+private:
+  /// The number of bytes reported to memory accounting
+  size_t accounted_size_;
 };
 
 /// Shared pointer for base image_memory type
@@ -483,6 +493,13 @@ class VITAL_EXPORT image
   /// \param height height of the crop region
   image crop(size_t x_offset, size_t y_offset, size_t width, size_t height) const;
 
+  /// Get a view of the image with the order of the channels reversed.
+  ///
+  /// The view shares memory with the original image and steps through the
+  /// channels backwards, so an RGB image is viewed as BGR and vice versa
+  /// without a deep copy.
+  image reverse_channels() const;
+
 protected:
   /// Smart pointer to memory viewed by this class
   image_memory_sptr data_;
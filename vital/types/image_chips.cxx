@@ -0,0 +1,207 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of image chip extraction
+
+#include "image_chips.h"
+
+#include <vital/exceptions/base.h>
+#include <vital/exceptions/image.h>
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace kwiver {
+namespace vital {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+/// Where one row or column of a chip samples the image
+struct sample_position
+{
+  ptrdiff_t offset0;
+  ptrdiff_t offset1;
+  float weight1;
+};
+
+// ----------------------------------------------------------------------------
+/// Compute the sample positions of the chip pixels along one image axis
+void
+sample_positions( double lo, double extent, size_t count, size_t size,
+                  ptrdiff_t step, std::vector< sample_position >& positions )
+{
+  positions.resize( count );
+  double const last = static_cast< double >( size - 1 );
+  for( size_t i = 0; i < count; ++i )
+  {
+    // sample at the center of each chip pixel
+    double x = lo + ( i + 0.5 ) * extent / count - 0.5;
+    x = std::min( std::max( x, 0.0 ), last );
+    auto const x0 = static_cast< size_t >( x );
+    auto const x1 = std::min( x0 + 1, size - 1 );
+    positions[ i ] = { static_cast< ptrdiff_t >( x0 ) * step,
+                       static_cast< ptrdiff_t >( x1 ) * step,
+                       static_cast< float >( x - x0 ) };
+  }
+}
+
+// ----------------------------------------------------------------------------
+/// Extract the chip of one box
+///
+/// Each channel is normalized as value * gain + bias.
+template < typename T >
+void
+extract_chip( image const& img, bounding_box_d const& box,
+              chip_extraction_options const& options,
+              std::vector< float > const& gain,
+              std::vector< float > const& bias,
+              float* out )
+{
+  auto const plane_size = options.width * options.height;
+  auto const depth = img.depth();
+  if( !box.is_valid() || !img.width() || !img.height() )
+  {
+    std::fill( out, out + plane_size * depth, 0.0f );
+    return;
+  }
+
+  auto const dx = box.width() * options.context;
+  auto const dy = box.height() * options.context;
+  std::vector< sample_position > cols, rows;
+  sample_positions( box.min_x() - dx, box.width() + 2.0 * dx, options.width,
+                    img.width(), img.w_step(), cols );
+  sample_positions( box.min_y() - dy, box.height() + 2.0 * dy, options.height,
+                    img.height(), img.h_step(), rows );
+
+  auto const* const first = static_cast< T const* >( img.first_pixel() );
+  for( size_t c = 0; c < depth; ++c )
+  {
+    auto const* const plane =
+      first + static_cast< ptrdiff_t >( c ) * img.d_step();
+    for( auto const& r : rows )
+    {
+      auto const* const row0 = plane + r.offset0;
+      auto const* const row1 = plane + r.offset1;
+      for( auto const& s : cols )
+      {
+        auto const top =
+          ( 1.0f - s.weight1 ) * static_cast< float >( row0[ s.offset0 ] ) +
+          s.weight1 * static_cast< float >( row0[ s.offset1 ] );
+        auto const bottom =
+          ( 1.0f - s.weight1 ) * static_cast< float >( row1[ s.offset0 ] ) +
+          s.weight1 * static_cast< float >( row1[ s.offset1 ] );
+        auto const value = ( 1.0f - r.weight1 ) * top + r.weight1 * bottom;
+        *out++ = value * gain[ c ] + bias[ c ];
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+/// Return one value of a per-channel option for each of \p depth channels
+std::vector< double >
+channel_values( std::vector< double > const& values, size_t depth,
+                double default_value, char const* name )
+{
+  if( values.empty() )
+  {
+    return std::vector< double >( depth, default_value );
+  }
+  if( values.size() == 1 )
+  {
+    return std::vector< double >( depth, values[ 0 ] );
+  }
+  if( values.size() != depth )
+  {
+    VITAL_THROW( invalid_value,
+                 std::string( "Chip extraction needs one " ) + name +
+                 " value or one for each of the " + std::to_string( depth ) +
+                 " image channels" );
+  }
+  return values;
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+image_of< float >
+image_chip_batch
+::chip( size_t i ) const
+{
+  auto const plane_size = data.width() * data.height();
+  return image_of< float >( data.memory(),
+                            data.first_pixel() + i * depth * plane_size,
+                            data.width(), data.height(), depth,
+                            1, data.width(), plane_size );
+}
+
+// ----------------------------------------------------------------------------
+image_chip_batch
+extract_image_chips( image const& img,
+                     std::vector< bounding_box_d > const& boxes,
+                     chip_extraction_options const& options )
+{
+  void ( *extract )( image const&, bounding_box_d const&,
+                     chip_extraction_options const&,
+                     std::vector< float > const&,
+                     std::vector< float > const&, float* ) = nullptr;
+
+#define EXTRACT_CASE( T )                                            \
+  if( img.pixel_traits() == image_pixel_traits_of< T >() )           \
+  {                                                                  \
+    extract = &extract_chip< T >;                                    \
+  }
+  EXTRACT_CASE( uint8_t )
+  EXTRACT_CASE( uint16_t )
+  EXTRACT_CASE( uint32_t )
+  EXTRACT_CASE( float )
+  EXTRACT_CASE( double )
+#undef EXTRACT_CASE
+
+  if( !extract )
+  {
+    VITAL_THROW( image_type_mismatch_exception,
+                 "Chip extraction does not support this pixel type" );
+  }
+
+  auto const depth = img.depth();
+  auto const mean = channel_values( options.mean, depth, 0.0, "mean" );
+  auto const std_dev =
+    channel_values( options.std_dev, depth, 1.0, "standard deviation" );
+  std::vector< float > gain( depth ), bias( depth );
+  for( size_t c = 0; c < depth; ++c )
+  {
+    gain[ c ] = static_cast< float >( options.scale / std_dev[ c ] );
+    bias[ c ] = static_cast< float >( -mean[ c ] / std_dev[ c ] );
+  }
+
+  image_chip_batch batch;
+  batch.count = boxes.size();
+  batch.depth = depth;
+  if( boxes.empty() || !options.width || !options.height || !depth )
+  {
+    return batch;
+  }
+
+  batch.data = image_of< float >( options.width, options.height,
+                                  boxes.size() * depth );
+  auto* const out = batch.data.first_pixel();
+  auto const chip_size = options.width * options.height * depth;
+  thread_pool::instance().parallel_for(
+    boxes.size(), 1,
+    [ & ]( size_t begin, size_t end ){
+      for( size_t i = begin; i < end; ++i )
+      {
+        extract( img, boxes[ i ], options, gain, bias,
+                 out + i * chip_size );
+      }
+    } );
+  return batch;
+}
+
+} } // end namespace vital
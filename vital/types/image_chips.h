@@ -0,0 +1,95 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header file for extracting batches of image chips
+
+#ifndef VITAL_IMAGE_CHIPS_H_
+#define VITAL_IMAGE_CHIPS_H_
+
+#include <vital/types/bounding_box.h>
+#include <vital/types/image.h>
+
+#include <vital/vital_export.h>
+
+#include <vector>
+
+namespace kwiver {
+namespace vital {
+
+// ----------------------------------------------------------------------------
+/// Options for extract_image_chips()
+struct VITAL_EXPORT chip_extraction_options
+{
+  /// Width in pixels of each chip
+  size_t width = 224;
+
+  /// Height in pixels of each chip
+  size_t height = 224;
+
+  /// Fraction of the box width and height added on each side as context
+  double context = 0.0;
+
+  /// Factor applied to pixel values before normalization
+  double scale = 1.0;
+
+  /// Value subtracted from each channel after scaling
+  ///
+  /// This holds either no values, one value for all channels, or one value
+  /// for each channel of the image.
+  std::vector< double > mean;
+
+  /// Value each channel is divided by after subtracting the mean
+  ///
+  /// This holds either no values, one value for all channels, or one value
+  /// for each channel of the image.
+  std::vector< double > std_dev;
+};
+
+// ----------------------------------------------------------------------------
+/// A batch of image chips of the same size and depth
+///
+/// The chips are stored in one planar float image whose channels are the
+/// channels of each chip in turn. The data is thus one contiguous block
+/// laid out by chip, channel, row and column, which is the layout expected
+/// by most descriptor networks.
+struct VITAL_EXPORT image_chip_batch
+{
+  /// All chips, with depth() channels for each chip
+  image_of< float > data;
+
+  /// Number of chips in the batch
+  size_t count = 0;
+
+  /// Number of channels in each chip
+  size_t depth = 0;
+
+  /// Return an image sharing the memory of a chip in the batch
+  image_of< float > chip( size_t i ) const;
+};
+
+/// Crop, resize and normalize regions of an image into a batch of chips
+///
+/// Each box is enlarged by the context of \p options and sampled
+/// bilinearly into a chip of the requested size, with pixels past the edge
+/// of the image taken from the nearest edge pixel. The chips are extracted
+/// in parallel on the vital thread pool, directly into the batch memory.
+/// Chips of invalid boxes are filled with zeros.
+///
+/// \param img     the image to extract chips from, of any unsigned integer
+///                or floating point pixel type
+/// \param boxes   the regions of the image to extract, in pixels
+/// \param options the size of the chips and how to normalize them
+/// \return        the batch with one chip for each box, in order
+/// \throws image_type_mismatch_exception if the pixel type is not supported
+/// \throws invalid_value if the mean or standard deviation has the wrong
+///         number of values
+VITAL_EXPORT image_chip_batch
+extract_image_chips( image const& img,
+                     std::vector< bounding_box_d > const& boxes,
+                     chip_extraction_options const& options = {} );
+
+} } // end namespace vital
+
+#endif // VITAL_IMAGE_CHIPS_H_
@@ -13,6 +13,10 @@
 #include <vital/types/image.h>
 #include <vital/types/metadata.h>
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
 namespace kwiver {
@@ -63,9 +67,59 @@ class image_container
   /// Set metadata associated with this image
   virtual void set_metadata(metadata_sptr md) { md_ = md; }
 
+  /// Get a converted representation of this image, if one was stored
+  ///
+  /// Conversions to the image types of other libraries which must copy the
+  /// pixels may store their result with set_conversion(), under a key naming
+  /// the target type and any options, so that converting the same container
+  /// again is free.
+  ///
+  /// \param key the name of the converted representation
+  /// \returns the stored representation, or nullptr if there is none
+  std::shared_ptr<void> get_conversion(std::string const& key) const
+  {
+    std::lock_guard<std::mutex> lock(conversions_.mutex);
+    auto const it = conversions_.items.find(key);
+    return it == conversions_.items.end() ? nullptr : it->second;
+  }
+
+  /// Store a converted representation of this image
+  ///
+  /// \param key the name of the converted representation
+  /// \param value the converted representation
+  void set_conversion(std::string const& key,
+                      std::shared_ptr<void> value) const
+  {
+    std::lock_guard<std::mutex> lock(conversions_.mutex);
+    conversions_.items[key] = std::move(value);
+  }
+
+  /// Discard all stored converted representations
+  ///
+  /// Code which modifies the pixels of this container through get_image()
+  /// must call this so that later conversions see the change.
+  void clear_conversions() const
+  {
+    std::lock_guard<std::mutex> lock(conversions_.mutex);
+    conversions_.items.clear();
+  }
+
 protected:
   /// optional metadata
   metadata_sptr md_;
+
+private:
+  /// Converted representations, which are not copied with the container
+  struct conversion_cache
+  {
+    conversion_cache() = default;
+    conversion_cache(conversion_cache const&) {}
+    conversion_cache& operator=(conversion_cache const&) { return *this; }
+
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<void>> items;
+  };
+  mutable conversion_cache conversions_;
 };
 
 /// Shared pointer for base image_container type
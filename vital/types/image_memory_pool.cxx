@@ -0,0 +1,225 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of a pool of recyclable image memory
+
+#include "image_memory_pool.h"
+
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace kwiver {
+namespace vital {
+
+constexpr size_t image_memory_pool::default_max_cached_bytes;
+
+// ----------------------------------------------------------------------------
+class image_memory_pool::priv
+{
+public:
+  priv( size_t max_cached_bytes )
+    : max_cached_bytes( max_cached_bytes )
+  {
+  }
+
+  ~priv()
+  {
+    free_until( 0 );
+  }
+
+  class memory;
+
+  char* take( size_t n );
+  void give( char* data, size_t n );
+  void free_until( size_t limit );
+
+  mutable std::mutex mutex;
+  std::multimap< size_t, char* > buffers;
+  size_t max_cached_bytes;
+  image_memory_pool_statistics stats;
+};
+
+// ----------------------------------------------------------------------------
+/// Image memory which hands its buffer back to its pool when destroyed
+class image_memory_pool::priv::memory
+  : public image_memory
+{
+public:
+  memory( std::shared_ptr< priv > pool, char* data, size_t n )
+    : pool_( std::move( pool ) )
+  {
+    data_ = data;
+    size_ = n;
+    update_accounting();
+  }
+
+  memory( memory const& ) = delete;
+  memory& operator=( memory const& ) = delete;
+
+  virtual ~memory()
+  {
+    pool_->give( static_cast< char* >( data_ ), size_ );
+
+    // The base class must not free the buffer
+    data_ = nullptr;
+  }
+
+private:
+  std::shared_ptr< priv > pool_;
+};
+
+// ----------------------------------------------------------------------------
+char*
+image_memory_pool::priv
+::take( size_t n )
+{
+  {
+    std::lock_guard< std::mutex > lock( mutex );
+
+    auto const it = buffers.find( n );
+    if ( it != buffers.end() )
+    {
+      auto const data = it->second;
+      buffers.erase( it );
+      stats.cached_bytes -= n;
+      ++stats.hits;
+      return data;
+    }
+
+    ++stats.misses;
+  }
+
+  // Allocate outside the lock
+  return new char[ n ];
+}
+
+// ----------------------------------------------------------------------------
+void
+image_memory_pool::priv
+::give( char* data, size_t n )
+{
+  {
+    std::lock_guard< std::mutex > lock( mutex );
+
+    if ( stats.cached_bytes + n <= max_cached_bytes )
+    {
+      buffers.emplace( n, data );
+      stats.cached_bytes += n;
+      ++stats.recycled;
+      return;
+    }
+
+    ++stats.discarded;
+  }
+
+  delete [] data;
+}
+
+// ----------------------------------------------------------------------------
+void
+image_memory_pool::priv
+::free_until( size_t limit )
+{
+  std::vector< char* > freed;
+  {
+    std::lock_guard< std::mutex > lock( mutex );
+
+    // Free the largest buffers first
+    while ( stats.cached_bytes > limit )
+    {
+      auto const it = std::prev( buffers.end() );
+      stats.cached_bytes -= it->first;
+      freed.push_back( it->second );
+      buffers.erase( it );
+    }
+  }
+
+  for ( auto const data : freed )
+  {
+    delete [] data;
+  }
+}
+
+// ----------------------------------------------------------------------------
+image_memory_pool
+::image_memory_pool( size_t max_cached_bytes )
+  : d( std::make_shared< priv >( max_cached_bytes ) )
+{
+}
+
+// ----------------------------------------------------------------------------
+image_memory_pool
+::~image_memory_pool()
+{
+  // Memory still in use keeps d alive, and is freed when released
+  set_max_cached_bytes( 0 );
+}
+
+// ----------------------------------------------------------------------------
+image_memory_sptr
+image_memory_pool
+::acquire( size_t n )
+{
+  if ( n == 0 )
+  {
+    return std::make_shared< image_memory >();
+  }
+
+  auto const data = d->take( n );
+  return std::make_shared< priv::memory >( d, data, n );
+}
+
+// ----------------------------------------------------------------------------
+void
+image_memory_pool
+::clear()
+{
+  d->free_until( 0 );
+}
+
+// ----------------------------------------------------------------------------
+size_t
+image_memory_pool
+::max_cached_bytes() const
+{
+  std::lock_guard< std::mutex > lock( d->mutex );
+  return d->max_cached_bytes;
+}
+
+// ----------------------------------------------------------------------------
+void
+image_memory_pool
+::set_max_cached_bytes( size_t n )
+{
+  {
+    std::lock_guard< std::mutex > lock( d->mutex );
+    d->max_cached_bytes = n;
+  }
+  d->free_until( n );
+}
+
+// ----------------------------------------------------------------------------
+image_memory_pool_statistics
+image_memory_pool
+::statistics() const
+{
+  std::lock_guard< std::mutex > lock( d->mutex );
+  return d->stats;
+}
+
+// ----------------------------------------------------------------------------
+image_memory_pool&
+image_memory_pool
+::instance()
+{
+  static image_memory_pool pool;
+  return pool;
+}
+
+} // namespace vital
+} // namespace kwiver
@@ -0,0 +1,98 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Interface for a pool of recyclable image memory
+
+#ifndef VITAL_IMAGE_MEMORY_POOL_H_
+#define VITAL_IMAGE_MEMORY_POOL_H_
+
+#include <vital/types/image.h>
+
+#include <vital/vital_export.h>
+
+#include <memory>
+
+#include <cstddef>
+
+namespace kwiver {
+namespace vital {
+
+/// Counters describing how well an image_memory_pool is being reused
+struct VITAL_EXPORT image_memory_pool_statistics
+{
+  /// Number of requests served by a cached buffer
+  size_t hits = 0;
+  /// Number of requests which had to allocate a new buffer
+  size_t misses = 0;
+  /// Number of buffers returned to the cache on release
+  size_t recycled = 0;
+  /// Number of buffers freed on release because the cache was full
+  size_t discarded = 0;
+  /// Number of bytes currently held by the cache
+  size_t cached_bytes = 0;
+};
+
+// ----------------------------------------------------------------------------
+/// A thread-safe cache of image buffers.
+///
+/// Memory acquired from the pool behaves like any other image_memory, but
+/// when the last reference to it is released the buffer is returned to the
+/// pool instead of being freed. A later request for the same number of bytes
+/// then reuses the buffer. This avoids allocator churn in code that produces
+/// a stream of equally sized images, such as video readers.
+///
+/// Buffers are matched by exact size and are allocated with the same
+/// alignment as a plain image_memory. The pool may be destroyed while some
+/// of its memory is still in use; that memory is then freed normally.
+class VITAL_EXPORT image_memory_pool
+{
+public:
+  /// Default limit on the number of bytes held by the cache
+  static constexpr size_t default_max_cached_bytes = size_t{ 512 } << 20;
+
+  /// Constructor
+  ///
+  /// \param max_cached_bytes
+  ///   Largest number of bytes the pool may hold in unused buffers.
+  explicit image_memory_pool(
+    size_t max_cached_bytes = default_max_cached_bytes );
+
+  /// Destructor
+  ~image_memory_pool();
+
+  image_memory_pool( image_memory_pool const& ) = delete;
+  image_memory_pool& operator=( image_memory_pool const& ) = delete;
+
+  /// Get memory for an image, reusing a cached buffer if possible.
+  ///
+  /// \param n Number of bytes required.
+  image_memory_sptr acquire( size_t n );
+
+  /// Free all cached buffers.
+  void clear();
+
+  /// Get the limit on the number of bytes held by the cache.
+  size_t max_cached_bytes() const;
+
+  /// Set the limit on the number of bytes held by the cache.
+  ///
+  /// Cached buffers are freed as needed to honor a lower limit.
+  void set_max_cached_bytes( size_t n );
+
+  /// Get the usage counters accumulated so far.
+  image_memory_pool_statistics statistics() const;
+
+  /// Get the process-wide pool shared by the video readers.
+  static image_memory_pool& instance();
+
+private:
+  class priv;
+  std::shared_ptr< priv > d;
+};
+
+} // namespace vital
+} // namespace kwiver
+
+#endif
@@ -0,0 +1,118 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of dividing an image region into overlapping tiles
+
+#include "image_tiling.h"
+
+#include <vital/exceptions/base.h>
+
+namespace kwiver {
+namespace vital {
+
+// ----------------------------------------------------------------------------
+image_tiling
+::image_tiling( bounding_box_i const& region,
+                size_t tile_width, size_t tile_height, size_t overlap )
+  : m_region( region )
+{
+  if( tile_width == 0 || tile_height == 0 )
+  {
+    VITAL_THROW( invalid_value, "Tile sizes must be positive" );
+  }
+  if( overlap >= tile_width || overlap >= tile_height )
+  {
+    VITAL_THROW( invalid_value,
+                 "Tile overlap must be smaller than the tile size" );
+  }
+  if( region.is_valid() )
+  {
+    m_columns = place( region.min_x(), region.max_x(), tile_width, overlap );
+    m_rows = place( region.min_y(), region.max_y(), tile_height, overlap );
+  }
+}
+
+// ----------------------------------------------------------------------------
+image_tiling
+::image_tiling( size_t image_width, size_t image_height,
+                size_t tile_width, size_t tile_height, size_t overlap )
+  : image_tiling( bounding_box_i( 0, 0, static_cast< int >( image_width ),
+                                  static_cast< int >( image_height ) ),
+                  tile_width, tile_height, overlap )
+{
+}
+
+// ----------------------------------------------------------------------------
+bounding_box_i
+image_tiling
+::tile( size_t index ) const
+{
+  auto const& column = m_columns[ index % m_columns.size() ];
+  auto const& row = m_rows[ index / m_columns.size() ];
+  return bounding_box_i( column.start, row.start, column.end, row.end );
+}
+
+// ----------------------------------------------------------------------------
+bounding_box_i
+image_tiling
+::core( size_t index ) const
+{
+  auto const& column = m_columns[ index % m_columns.size() ];
+  auto const& row = m_rows[ index / m_columns.size() ];
+  return bounding_box_i( column.core_start, row.core_start,
+                         column.core_end, row.core_end );
+}
+
+// ----------------------------------------------------------------------------
+image
+image_tiling
+::view( image const& img, size_t index ) const
+{
+  auto const box = tile( index );
+  return img.crop( static_cast< size_t >( box.min_x() ),
+                   static_cast< size_t >( box.min_y() ),
+                   static_cast< size_t >( box.width() ),
+                   static_cast< size_t >( box.height() ) );
+}
+
+// ----------------------------------------------------------------------------
+std::vector< image_tiling::span >
+image_tiling
+::place( int start, int end, size_t tile_size, size_t overlap )
+{
+  std::vector< span > spans;
+  int const length = end - start;
+  if( length <= 0 )
+  {
+    return spans;
+  }
+
+  int const size = static_cast< int >( tile_size );
+  if( length <= size )
+  {
+    spans.push_back( { start, end, start, end } );
+    return spans;
+  }
+
+  // the last tile is moved back to end at the edge of the region
+  int const step = size - static_cast< int >( overlap );
+  int const count = ( length - size + step - 1 ) / step + 1;
+  for( int i = 0; i < count; ++i )
+  {
+    int const tile_start = ( i + 1 < count ? start + i * step : end - size );
+    spans.push_back( { tile_start, tile_start + size, start, end } );
+  }
+
+  // split each overlap at its middle
+  for( size_t i = 1; i < spans.size(); ++i )
+  {
+    int const cut = ( spans[ i ].start + spans[ i - 1 ].end ) / 2;
+    spans[ i - 1 ].core_end = cut;
+    spans[ i ].core_start = cut;
+  }
+  return spans;
+}
+
+} } // end namespace vital
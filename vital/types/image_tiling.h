@@ -0,0 +1,134 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Interface for dividing an image region into overlapping tiles
+
+#ifndef VITAL_IMAGE_TILING_H_
+#define VITAL_IMAGE_TILING_H_
+
+#include <vital/types/bounding_box.h>
+#include <vital/types/image.h>
+
+#include <vital/vital_export.h>
+
+#include <iterator>
+#include <vector>
+
+#include <cstddef>
+
+namespace kwiver {
+namespace vital {
+
+// ----------------------------------------------------------------------------
+/// A layout of overlapping tiles covering a region of an image.
+///
+/// Tiles are placed in rows from the top left of the region, each a fixed
+/// step from the last, where the step is the tile size less the overlap.
+/// The last tile of each row and column is moved back to end at the edge of
+/// the region, so every tile has the full tile size unless the region itself
+/// is smaller. Tiles are numbered in row-major order.
+///
+/// Each tile also has a core, the part of the tile that is closer to its
+/// center than to the center of any neighboring tile. The cores partition
+/// the region, so results computed on each tile may be merged by keeping
+/// those of its core.
+///
+/// All boxes are in pixel coordinates of the full image, with the maximum
+/// corner one past the last pixel.
+class VITAL_EXPORT image_tiling
+{
+public:
+  /// Iterator over the tile boxes of a tiling
+  class const_iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = bounding_box_i;
+    using difference_type = std::ptrdiff_t;
+    using pointer = bounding_box_i const*;
+    using reference = bounding_box_i;
+
+    const_iterator( image_tiling const& tiling, size_t index )
+      : m_tiling( &tiling ), m_index( index ) {}
+
+    bounding_box_i operator*() const { return m_tiling->tile( m_index ); }
+    const_iterator& operator++() { ++m_index; return *this; }
+    const_iterator operator++( int )
+    { const_iterator result = *this; ++m_index; return result; }
+
+    /// The index of the tile this refers to
+    size_t index() const { return m_index; }
+
+    bool operator==( const_iterator const& other ) const
+    { return m_index == other.m_index; }
+    bool operator!=( const_iterator const& other ) const
+    { return m_index != other.m_index; }
+
+  private:
+    image_tiling const* m_tiling;
+    size_t m_index;
+  };
+
+  /// Constructor
+  ///
+  /// \param region Region of interest to cover with tiles.
+  /// \param tile_width Width of each tile in pixels.
+  /// \param tile_height Height of each tile in pixels.
+  /// \param overlap Number of pixels shared by neighboring tiles.
+  ///
+  /// \throws invalid_value if a tile size is zero or the overlap is not
+  ///         smaller than both tile sizes.
+  image_tiling( bounding_box_i const& region,
+                size_t tile_width, size_t tile_height, size_t overlap = 0 );
+
+  /// Constructor for tiles covering a whole image
+  image_tiling( size_t image_width, size_t image_height,
+                size_t tile_width, size_t tile_height, size_t overlap = 0 );
+
+  /// The region covered by the tiles
+  bounding_box_i region() const { return m_region; }
+
+  /// Number of tiles
+  size_t size() const { return m_columns.size() * m_rows.size(); }
+
+  /// Number of tiles in each row
+  size_t columns() const { return m_columns.size(); }
+
+  /// Number of rows of tiles
+  size_t rows() const { return m_rows.size(); }
+
+  /// The box of tile \p index
+  bounding_box_i tile( size_t index ) const;
+
+  /// The core of tile \p index; the cores of all tiles partition the region
+  bounding_box_i core( size_t index ) const;
+
+  /// A view of tile \p index in \p img, which shares its memory
+  image view( image const& img, size_t index ) const;
+
+  const_iterator begin() const { return const_iterator( *this, 0 ); }
+  const_iterator end() const { return const_iterator( *this, size() ); }
+
+private:
+  /// Placement of the tiles along one axis
+  struct span
+  {
+    int start;
+    int end;
+    int core_start;
+    int core_end;
+  };
+
+  static std::vector< span > place( int start, int end,
+                                    size_t tile_size, size_t overlap );
+
+  bounding_box_i m_region;
+  std::vector< span > m_columns;
+  std::vector< span > m_rows;
+};
+
+} } // end namespace vital
+
+#endif // VITAL_IMAGE_TILING_H_
@@ -31,6 +31,10 @@ typedef Eigen::Matrix< double, 4, 3 > matrix_4x3d;
 typedef Eigen::Matrix< float, 4, 3 >  matrix_4x3f;
 typedef Eigen::Matrix< double, 4, 4 > matrix_4x4d;
 typedef Eigen::Matrix< float, 4, 4 >  matrix_4x4f;
+
+/// One point per row, so that each coordinate is contiguous
+typedef Eigen::Matrix< double, Eigen::Dynamic, 2 > matrix_Xx2d;
+typedef Eigen::Matrix< double, Eigen::Dynamic, 3 > matrix_Xx3d;
 /// \endcond
 
 } } // end namespace vital
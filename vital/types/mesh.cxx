@@ -289,9 +289,11 @@ ::append( const mesh_face_array_base& other, unsigned int ind_shift )
 
   const unsigned int new_begin = static_cast< unsigned int >( faces_.size() );
 
-  if( other.regularity() == 0 )
+  const mesh_face_array* const fs_ptr =
+    dynamic_cast< const mesh_face_array* >( &other );
+  if( fs_ptr )
   {
-    const mesh_face_array& fs = static_cast< const mesh_face_array& >( other );
+    const mesh_face_array& fs = *fs_ptr;
     faces_.insert( faces_.end(), fs.faces_.begin(), fs.faces_.end() );
 
     if( ind_shift > 0 )
@@ -320,6 +322,132 @@ ::append( const mesh_face_array_base& other, unsigned int ind_shift )
   }
 }
 
+/// Constructor (from face offsets and concatenated vertex indices)
+mesh_polygon_face_array
+::mesh_polygon_face_array( std::vector< unsigned int > offsets,
+                           std::vector< unsigned int > indices )
+  : offsets_( std::move( offsets ) ),
+    indices_( std::move( indices ) )
+{
+  assert( !offsets_.empty() && offsets_.front() == 0 );
+  assert( offsets_.back() == indices_.size() );
+}
+
+/// Constructor (from a vector)
+mesh_polygon_face_array
+::mesh_polygon_face_array(
+  const std::vector< std::vector< unsigned int > >& faces )
+  : offsets_( 1, 0 )
+{
+  offsets_.reserve( faces.size() + 1 );
+  for( auto const& f : faces )
+  {
+    this->push_back( f );
+  }
+}
+
+/// Constructor (from an initializer list)
+mesh_polygon_face_array
+::mesh_polygon_face_array(
+  const std::initializer_list< std::vector< unsigned int > >& faces )
+  : offsets_( 1, 0 )
+{
+  offsets_.reserve( faces.size() + 1 );
+  for( auto const& f : faces )
+  {
+    this->push_back( f );
+  }
+}
+
+/// Construct from base class
+mesh_polygon_face_array
+::mesh_polygon_face_array( const mesh_face_array_base& fb )
+  : mesh_face_array_base( fb ), offsets_( 1, 0 )
+{
+  offsets_.reserve( fb.size() + 1 );
+  for( unsigned int i = 0; i < fb.size(); ++i )
+  {
+    for( unsigned int j = 0; j < fb.num_verts( i ); ++j )
+    {
+      indices_.push_back( fb( i, j ) );
+    }
+    offsets_.push_back( static_cast< unsigned int >( indices_.size() ) );
+  }
+}
+
+/// Checks approximate equality
+bool
+mesh_polygon_face_array
+::approx_equal( mesh_face_array_base const& other, double epsilon ) const
+{
+  if( mesh_face_array_base::approx_equal( other, epsilon ) == false )
+  {
+    return false;
+  }
+
+  for( unsigned int i = 0; i < size(); i++ )
+  {
+    if( num_verts( i ) != other.num_verts( i ) )
+    {
+      return false;
+    }
+    for( unsigned int j = 0; j < num_verts( i ); j++ )
+    {
+      if( ( *this )( i, j ) != other( i, j ) )
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/// Append this array of faces
+void
+mesh_polygon_face_array
+::append( const mesh_face_array_base& other, unsigned int ind_shift )
+{
+  mesh_face_array_base::append( other, ind_shift );
+
+  const size_t new_begin = indices_.size();
+  const mesh_polygon_face_array* const fs =
+    dynamic_cast< const mesh_polygon_face_array* >( &other );
+  if( fs )
+  {
+    const unsigned int offset_shift =
+      static_cast< unsigned int >( new_begin );
+    const size_t num_offsets = fs->offsets_.size();
+    offsets_.reserve( offsets_.size() + num_offsets - 1 );
+    for( size_t f = 1; f < num_offsets; ++f )
+    {
+      offsets_.push_back( fs->offsets_[ f ] + offset_shift );
+    }
+    indices_.insert( indices_.end(),
+                     fs->indices_.begin(), fs->indices_.end() );
+  }
+  else
+  {
+    offsets_.reserve( offsets_.size() + other.size() );
+    for( unsigned int i = 0; i < other.size(); ++i )
+    {
+      for( unsigned int j = 0; j < other.num_verts( i ); ++j )
+      {
+        indices_.push_back( other( i, j ) );
+      }
+      offsets_.push_back( static_cast< unsigned int >( indices_.size() ) );
+    }
+  }
+
+  if( ind_shift > 0 )
+  {
+    for( size_t i = new_begin; i < indices_.size(); ++i )
+    {
+      indices_[ i ] += ind_shift;
+    }
+  }
+}
+
 /// Checks approximate equality
 template < unsigned int s >
 bool
@@ -364,12 +492,52 @@ merge_face_arrays( const mesh_face_array_base& f1,
   }
   else
   {
-    f.reset( new mesh_face_array( f1 ) );
+    f.reset( new mesh_polygon_face_array( f1 ) );
   }
   f->append( f2, ind_shift );
   return f;
 }
 
+/// Store the faces in the most compact array for their shape
+std::unique_ptr< mesh_face_array_base >
+compact_face_array( std::unique_ptr< mesh_face_array_base > faces )
+{
+  if( !faces || faces->regularity() != 0 )
+  {
+    return faces;
+  }
+
+  const unsigned int num_faces = faces->size();
+  for( unsigned int f = 0; f < num_faces; ++f )
+  {
+    if( faces->num_verts( f ) != 3 )
+    {
+      return faces;
+    }
+  }
+
+  // replay the groups so that each ends after the same face
+  std::unique_ptr< mesh_regular_face_array< 3 > > tris(
+    new mesh_regular_face_array< 3 > );
+  tris->reserve( num_faces );
+  const auto& groups = faces->groups();
+  size_t g = 0;
+  for( unsigned int f = 0; f < num_faces; ++f )
+  {
+    const mesh_face_array_base& fa = *faces;
+    tris->push_back( mesh_tri( fa( f, 0 ), fa( f, 1 ), fa( f, 2 ) ) );
+    for(; g < groups.size() && groups[ g ].second <= f + 1; ++g )
+    {
+      tris->make_group( groups[ g ].first );
+    }
+  }
+  if( faces->has_normals() )
+  {
+    tris->set_normals( faces->normals() );
+  }
+  return std::move( tris );
+}
+
 // ----------------------------------------------------------------------------
 // Mesh edges
 
@@ -11,6 +11,7 @@
 #ifndef VITAL_MESH_H_
 #define VITAL_MESH_H_
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <vector>
@@ -358,6 +359,16 @@ class VITAL_EXPORT mesh_face_array_base
   const std::vector< std::pair< std::string, unsigned int > >&
   groups() const { return groups_; }
 
+  /// Set the groups
+  ///
+  /// Each group is given by its name and the index of its last face + 1
+  void
+  set_groups( const std::vector< std::pair< std::string, unsigned int > >& g )
+  {
+    assert( g.empty() || g.back().second <= this->size() );
+    groups_ = g;
+  }
+
 protected:
   /// named groups of adjacent faces (a partition of the face array)
   ///
@@ -477,6 +488,138 @@ class VITAL_EXPORT mesh_face_array : public mesh_face_array_base
   operator[]( unsigned int f ) const { return faces_[ f ]; }
 };
 
+/// An array of mesh faces of arbitrary size stored contiguously
+///
+/// The vertex indices of all faces are stored in a single array, and face
+/// \c f occupies indices [offsets()[f], offsets()[f+1]) of it.  Unlike
+/// mesh_face_array, this requires no allocation per face, so it is compact,
+/// cache friendly and cheap to copy.
+class VITAL_EXPORT mesh_polygon_face_array : public mesh_face_array_base
+{
+  std::vector< unsigned int > offsets_;
+  std::vector< unsigned int > indices_;
+
+public:
+  /// Default Constructor
+  mesh_polygon_face_array() : offsets_( 1, 0 ) {}
+
+  /// Constructor (from face offsets and concatenated vertex indices)
+  ///
+  /// \p offsets must have one more entry than the number of faces, start at
+  /// zero, and end at the number of \p indices.
+  mesh_polygon_face_array( std::vector< unsigned int > offsets,
+                           std::vector< unsigned int > indices );
+
+  /// Constructor (from a vector)
+  mesh_polygon_face_array(
+    const std::vector< std::vector< unsigned int > >& faces );
+
+  /// Constructor (from an initializer list)
+  mesh_polygon_face_array(
+    const std::initializer_list< std::vector< unsigned int > >& faces );
+
+  /// Construct from base class
+  explicit mesh_polygon_face_array( const mesh_face_array_base& fb );
+
+  /// Checks approximate equality
+  bool approx_equal( mesh_face_array_base const& other,
+                     double epsilon = 1e-6 ) const;
+
+  /// returns the number of vertices per face if the same for all faces, zero
+  /// otherwise
+  virtual unsigned int
+  regularity() const { return 0; }
+
+  /// returns the number of faces
+  virtual unsigned int
+  size() const { return static_cast< unsigned int >( offsets_.size() - 1 ); }
+
+  /// returns the number of vertices in face \param f
+  virtual unsigned int
+  num_verts( unsigned int f ) const
+  {
+    return offsets_[ f + 1 ] - offsets_[ f ];
+  }
+
+  /// Access a vertex index by face index and within-face index
+  virtual unsigned int
+  operator()( unsigned int f, unsigned int i ) const
+  {
+    return indices_[ offsets_[ f ] + i ];
+  }
+
+  /// Flip a face over, inverting its orientation
+  virtual void
+  flip_orientation( unsigned int f )
+  {
+    std::reverse( indices_.begin() + offsets_[ f ],
+                  indices_.begin() + offsets_[ f + 1 ] );
+    mesh_face_array_base::flip_orientation( f );
+  }
+
+  /// Produce a clone of this object (dynamic copy)
+  virtual mesh_face_array_base*
+  clone() const
+  {
+    return new mesh_polygon_face_array( *this );
+  }
+
+  /// Append this array of faces
+  ///
+  /// Optionally shift the indices in \param other by \param ind_shift
+  virtual void append( const mesh_face_array_base& other,
+                       unsigned int ind_shift = 0 );
+
+  /// Reserve storage for \p num_faces faces with \p num_indices indices
+  void
+  reserve( unsigned int num_faces, unsigned int num_indices )
+  {
+    offsets_.reserve( num_faces + 1 );
+    indices_.reserve( num_indices );
+  }
+
+  /// Add a face with \p n vertex indices starting at \p verts
+  void
+  push_back( const unsigned int* verts, unsigned int n )
+  {
+    indices_.insert( indices_.end(), verts, verts + n );
+    offsets_.push_back( static_cast< unsigned int >( indices_.size() ) );
+  }
+
+  /// Add a face to the array
+  void
+  push_back( const std::vector< unsigned int >& f )
+  {
+    this->push_back( f.data(), static_cast< unsigned int >( f.size() ) );
+  }
+
+  /// Add a face to the array
+  template < unsigned int s >
+  void
+  push_back( const mesh_regular_face< s >& f )
+  {
+    for( unsigned int i = 0; i < s; ++i )
+    {
+      indices_.push_back( f[ i ] );
+    }
+    offsets_.push_back( static_cast< unsigned int >( indices_.size() ) );
+  }
+
+  /// Access the vertex indices of face \param f
+  unsigned int*
+  face( unsigned int f ) { return indices_.data() + offsets_[ f ]; }
+  const unsigned int*
+  face( unsigned int f ) const { return indices_.data() + offsets_[ f ]; }
+
+  /// Access the offset of each face into the indices, and the total count
+  const std::vector< unsigned int >&
+  offsets() const { return offsets_; }
+
+  /// Access the concatenated vertex indices of all faces
+  const std::vector< unsigned int >&
+  indices() const { return indices_; }
+};
+
 /// An array of mesh faces of arbitrary size
 template < unsigned int s >
 class mesh_regular_face_array : public mesh_face_array_base
@@ -570,6 +713,10 @@ class mesh_regular_face_array : public mesh_face_array_base
     }
   }
 
+  /// Reserve storage for \p num_faces faces
+  void
+  reserve( unsigned int num_faces ) { faces_.reserve( num_faces ); }
+
   /// Add a face to the array
   void
   push_back( const mesh_regular_face< s >& f ) { faces_.push_back( f ); }
@@ -606,6 +753,15 @@ merge_face_arrays( const mesh_face_array_base& f1,
                    const mesh_face_array_base& f2,
                    unsigned int ind_shift = 0 );
 
+/// Store the faces in the most compact array for their shape
+///
+/// If every face is a triangle, the faces, normals and groups are copied to
+/// a mesh_regular_face_array<3> so that triangle algorithms can use them
+/// directly.  Otherwise \param faces is returned unchanged.
+VITAL_EXPORT
+std::unique_ptr< mesh_face_array_base >
+compact_face_array( std::unique_ptr< mesh_face_array_base > faces );
+
 // ----------------------------------------------------------------------------
 // Mesh edges
 
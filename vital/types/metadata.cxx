@@ -10,6 +10,7 @@
 #include <vital/types/metadata_traits.h>
 #include <vital/util/demangle.h>
 
+#include <algorithm>
 #include <typeindex>
 
 namespace kwiver {
@@ -29,6 +30,16 @@ struct print_visitor {
   std::ostream& os;
 };
 
+// ----------------------------------------------------------------------------
+// Comparison for searching a sorted metadata_map_t by tag
+struct item_tag_less {
+  bool operator()( metadata::metadata_map_t::value_type const& item,
+                   vital_metadata_tag tag ) const
+  {
+    return item.first < tag;
+  }
+};
+
 // ----------------------------------------------------------------------------
 struct convert_from_any_visitor {
   template< class T >
@@ -175,20 +186,14 @@ ::metadata()
 // ----------------------------------------------------------------------------
 metadata
 ::metadata( metadata const& other )
-{
-  for( auto const& md_item : other.m_metadata_map )
-  {
-    // Add a copy of the other metadata map's items
-    add_copy( md_item.second );
-  }
-}
+  : m_metadata_map( other.m_metadata_map )
+{ }
 
 // ----------------------------------------------------------------------------
 metadata&
 metadata::operator=( metadata const& other )
 {
-  auto copy = other;
-  *this = std::move( copy );
+  m_metadata_map = other.m_metadata_map;
   return *this;
 }
 
@@ -210,12 +215,26 @@ ::add( std::unique_ptr< metadata_item >&& item )
     throw std::invalid_argument{ "null pointer" };
   }
 
+  this->insert( item_ptr{ std::move( item ) } );
+}
+
+// ----------------------------------------------------------------------------
+void
+metadata
+::insert( item_ptr&& item )
+{
   auto const tag = item->tag();
-#ifdef VITAL_STD_MAP_UNIQUE_PTR_ALLOWED
-  this->m_metadata_map[ tag ] = std::move( item );
-#else
-  this->m_metadata_map[ tag ] = item_ptr{ item.release() };
-#endif
+  auto const it = std::lower_bound( m_metadata_map.begin(),
+                                    m_metadata_map.end(),
+                                    tag, item_tag_less{} );
+  if( it != m_metadata_map.end() && it->first == tag )
+  {
+    it->second = std::move( item );
+  }
+  else
+  {
+    m_metadata_map.emplace( it, tag, std::move( item ) );
+  }
 }
 
 // ----------------------------------------------------------------------------
@@ -231,7 +250,7 @@ ::add_copy( std::shared_ptr<metadata_item const> const& item )
   // Since the design intent for this map is that the metadata
   // collection owns the elements, we will clone the item passed in.
   // The original parameter will be freed eventually.
-  this->m_metadata_map[ item->tag() ] = item_ptr{ item->clone() };
+  this->insert( item_ptr{ item->clone() } );
 }
 
 // ----------------------------------------------------------------------------
@@ -251,7 +270,7 @@ bool
 metadata
 ::has( vital_metadata_tag tag ) const
 {
-  return m_metadata_map.find( tag ) != m_metadata_map.end();
+  return this->find_item( tag ) != m_metadata_map.end();
 }
 
 // ----------------------------------------------------------------------------
@@ -261,7 +280,7 @@ ::find( vital_metadata_tag tag ) const
 {
   static metadata_item unknown_item{ VITAL_META_UNKNOWN, 0 };
 
-  const_iterator_t it = m_metadata_map.find( tag );
+  const_iterator_t it = this->find_item( tag );
   if ( it == m_metadata_map.end() )
   {
     return unknown_item;
@@ -275,7 +294,26 @@ bool
 metadata
 ::erase( vital_metadata_tag tag )
 {
-  return m_metadata_map.erase( tag ) > 0;
+  auto const it = this->find_item( tag );
+  if( it == m_metadata_map.end() )
+  {
+    return false;
+  }
+
+  m_metadata_map.erase( it );
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+metadata::const_iterator_t
+metadata
+::find_item( vital_metadata_tag tag ) const
+{
+  auto const it = std::lower_bound( m_metadata_map.begin(),
+                                    m_metadata_map.end(),
+                                    tag, item_tag_less{} );
+  return ( it != m_metadata_map.end() && it->first == tag )
+         ? it : m_metadata_map.end();
 }
 
 // ----------------------------------------------------------------------------
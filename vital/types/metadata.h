@@ -16,6 +16,7 @@
 #include <vital/types/metadata_tags.h>
 #include <vital/types/metadata_traits.h>
 #include <vital/types/timestamp.h>
+#include <vital/util/memory_accounting.h>
 #include <vital/util/visit.h>
 #include <vital/vital_export.h>
 
@@ -95,6 +96,7 @@ convert_data< any >( vital_metadata_tag tag, any const& data );
 
 // ----------------------------------------------------------------------------
 class VITAL_EXPORT metadata_item
+  : private memory_accounted< metadata_item, memory_category::metadata >
 {
 public:
   /// \throws logic_error If \p data's type does not match \p tag.
@@ -227,17 +229,13 @@ class VITAL_EXPORT metadata_item
 class VITAL_EXPORT metadata
 {
 public:
-// The design for this collection requires that the elements in the
-// collection are owned by the collection and are only returned by
-// value. This is why the std::unique_ptr is used. Unfortunately, not
-// all stdc implementations support maps with unique_ptrs. The
-// following is done to work around this limitation.
-#ifdef VITAL_STD_MAP_UNIQUE_PTR_ALLOWED
-  using item_ptr = std::unique_ptr< metadata_item >;
-#else
-  using item_ptr = std::shared_ptr< metadata_item >;
-#endif
-  using metadata_map_t = std::map< vital_metadata_tag, item_ptr >;
+// Items are owned by the collection and cannot be modified once added, so
+// copies of a collection share them rather than cloning each one. Items are
+// kept in a vector sorted by tag, which is compact and cheap to copy for the
+// few dozen items typical of one frame.
+  using item_ptr = std::shared_ptr< metadata_item const >;
+  using metadata_map_t =
+    std::vector< std::pair< vital_metadata_tag, item_ptr > >;
   using const_iterator_t = metadata_map_t::const_iterator;
 
   metadata();
@@ -419,6 +417,12 @@ class VITAL_EXPORT metadata
   static std::string format_string( std::string const& val );
 
 private:
+  // Add item, replacing any existing item with the same tag.
+  void insert( item_ptr&& item );
+
+  // Return the position of the item with the given tag, or end().
+  const_iterator_t find_item( vital_metadata_tag tag ) const;
+
   metadata_map_t m_metadata_map;
 }; // end class metadata
 
@@ -9,6 +9,7 @@
 #include "object_track_set.h"
 
 #include <limits>
+#include <unordered_map>
 
 namespace kwiver {
 namespace vital {
@@ -59,4 +60,89 @@ object_track_state::clone ( clone_type ct ) const
   }
 }
 
+// ----------------------------------------------------------------------------
+object_track_set_sptr
+new_track_states( object_track_set const& before,
+                  object_track_set const& after )
+{
+  std::unordered_map< track_id_t, track_sptr > old_tracks;
+  for( auto const& t : before.tracks() )
+  {
+    old_tracks.emplace( t->id(), t );
+  }
+
+  std::vector< track_sptr > result;
+  for( auto const& t : after.tracks() )
+  {
+    auto const old = old_tracks.find( t->id() );
+    if( old != old_tracks.end() && old->second == t )
+    {
+      continue;
+    }
+
+    // Find the states past the old version of the track
+    auto first = t->begin();
+    if( old != old_tracks.end() && !old->second->empty() )
+    {
+      auto const last_frame = old->second->last_frame();
+      first = t->end();
+      while( first != t->begin() && ( *( first - 1 ) )->frame() > last_frame )
+      {
+        --first;
+      }
+    }
+    if( first == t->end() )
+    {
+      continue;
+    }
+
+    auto delta = track::create( t->data() );
+    delta->set_id( t->id() );
+    for( ; first != t->end(); ++first )
+    {
+      delta->append( ( *first )->clone( clone_type::SHALLOW ) );
+    }
+    result.push_back( delta );
+  }
+
+  return std::make_shared< object_track_set >( result );
+}
+
+// ----------------------------------------------------------------------------
+object_track_set_sptr
+retain_tracks( object_track_set const& tracks, frame_id_t frame,
+               frame_id_t max_gap, size_t max_states,
+               std::vector< track_sptr >& terminated )
+{
+  std::vector< track_sptr > active;
+  for( auto const& t : tracks.tracks() )
+  {
+    if( max_gap > 0 && !t->empty() && frame - t->last_frame() > max_gap )
+    {
+      terminated.push_back( t );
+    }
+    else if( max_states > 0 && t->size() > max_states )
+    {
+      auto trimmed = track::create( t->data() );
+      trimmed->set_id( t->id() );
+      if( auto const attrs = t->attributes() )
+      {
+        trimmed->set_attributes( attrs->clone() );
+      }
+      for( auto ts = t->end() - static_cast< ptrdiff_t >( max_states );
+           ts != t->end(); ++ts )
+      {
+        trimmed->append( ( *ts )->clone( clone_type::SHALLOW ) );
+      }
+      active.push_back( trimmed );
+    }
+    else
+    {
+      active.push_back( t );
+    }
+  }
+
+  return std::make_shared< object_track_set >( active );
+}
+
 } } // end namespace vital
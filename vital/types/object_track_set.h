@@ -29,7 +29,10 @@ namespace vital {
 
 // ----------------------------------------------------------------------------
 /// A derived track_state for object tracks
-class VITAL_EXPORT object_track_state : public track_state
+class VITAL_EXPORT object_track_state
+  : public track_state,
+    private memory_accounted< object_track_state,
+                              memory_category::track_state, track_state >
 {
 public:
   object_track_state() = default;
@@ -164,6 +167,35 @@ class VITAL_EXPORT object_track_set : public track_set
 /// Shared pointer for object_track_set type
 typedef std::shared_ptr< object_track_set > object_track_set_sptr;
 
+/// Find the track states added between two versions of a set of tracks
+///
+/// Tracks are updated by replacing them with a new version, so tracks of
+/// \p after which are also in \p before are unchanged and are skipped
+/// without looking at their states. The work done is proportional to the
+/// number of tracks plus the number of states added.
+///
+/// \returns a set holding, for each track of \p after which is new or has
+///          states past the last frame of its version in \p before, a track
+///          with the same id and shallow copies of those states.
+VITAL_EXPORT object_track_set_sptr
+new_track_states( object_track_set const& before,
+                  object_track_set const& after );
+
+/// Apply a retention policy to the tracks of a long running tracker
+///
+/// Tracks whose last state is more than \p max_gap frames before \p frame
+/// are terminated: they are removed from the set and appended to
+/// \p terminated. The remaining tracks with more than \p max_states states
+/// are replaced by a track with the same id holding shallow copies of the
+/// last \p max_states states. A limit of zero disables either rule, and
+/// tracks which are left alone are shared with \p tracks.
+///
+/// \returns the tracks still active.
+VITAL_EXPORT object_track_set_sptr
+retain_tracks( object_track_set const& tracks, frame_id_t frame,
+               frame_id_t max_gap, size_t max_states,
+               std::vector< track_sptr >& terminated );
+
 /// Helper to iterate over the states of a track as object track states
 ///
 /// This object is an instance of a range transform adapter that can be applied
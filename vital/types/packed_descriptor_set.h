@@ -0,0 +1,279 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Contiguous descriptor_set storage and descriptor row views
+
+#ifndef VITAL_PACKED_DESCRIPTOR_SET_H_
+#define VITAL_PACKED_DESCRIPTOR_SET_H_
+
+#include "descriptor_set.h"
+
+#include <vital/exceptions.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace kwiver {
+namespace vital {
+
+// ----------------------------------------------------------------------------
+/// A descriptor referring to a row of a larger buffer of type T
+///
+/// The view shares ownership of the buffer, so it stays valid after the set
+/// it was taken from is destroyed. Writes through raw_data() modify the
+/// buffer. The node_id belongs to the view, not the buffer.
+template < typename T >
+class descriptor_view :
+  public descriptor_array_of< T >
+{
+public:
+  /// Constructor
+  ///
+  /// \param data Pointer to the first element, sharing ownership of the
+  ///             buffer which holds it.
+  /// \param len Number of elements in the descriptor.
+  descriptor_view< T > ( std::shared_ptr< T > data, size_t len )
+  : data_( std::move( data ) ),
+    length_( len ),
+    node_id_( std::numeric_limits< unsigned int >::max() ) { }
+
+  /// The number of elements of the underlying type
+  std::size_t size() const { return length_; }
+
+  /// Return an pointer to the raw data array
+  T* raw_data() { return data_.get(); }
+
+  /// Return an pointer to the raw data array
+  const T* raw_data() const { return data_.get(); }
+
+  /// Return an independent copy of the referenced data
+  virtual descriptor_sptr clone() const
+  {
+    return std::make_shared< descriptor_dynamic< T > >( length_, data_.get() );
+  }
+
+  virtual unsigned int node_id() const { return node_id_; }
+
+  virtual bool set_node_id( unsigned int node_id )
+  {
+    node_id_ = node_id;
+    return true;
+  }
+
+protected:
+  /// pointer to the first element
+  std::shared_ptr< T > data_;
+  /// length of data array
+  size_t length_;
+  /// node id
+  unsigned int node_id_;
+};
+
+// ----------------------------------------------------------------------------
+/// A descriptor set storing all descriptors in one row-major buffer
+///
+/// Every descriptor has the same type and dimension. Rows are \c stride()
+/// elements apart, which may exceed \c dimension() when wrapping a padded
+/// buffer. Descriptors returned by at(), descriptors() and iteration are
+/// views into the buffer rather than copies, so code which can work on the
+/// buffer directly, such as matchers, should use raw_data() and row() instead.
+template < typename T >
+class packed_descriptor_set :
+  public descriptor_set
+{
+public:
+  using element_t = T;
+
+  /// Construct an empty set of descriptors with \p dim elements each
+  explicit packed_descriptor_set( size_t dim = 0 )
+    : size_( 0 ), dim_( dim ), stride_( dim )
+  {}
+
+  /// Construct from \p data holding descriptors of \p dim elements each
+  ///
+  /// \throws invalid_value If the size of \p data is not a multiple of
+  ///                       \p dim.
+  packed_descriptor_set( std::vector< T > data, size_t dim )
+    : size_( 0 ), dim_( dim ), stride_( dim )
+  {
+    if( dim ? ( data.size() % dim ) : !data.empty() )
+    {
+      VITAL_THROW( invalid_value,
+                   "packed descriptor data is not a multiple of the "
+                   "descriptor dimension" );
+    }
+    size_ = dim ? data.size() / dim : 0;
+
+    auto const owner = std::make_shared< std::vector< T > >( std::move( data ) );
+    data_ = std::shared_ptr< T >( owner, owner->data() );
+  }
+
+  /// Wrap an existing buffer without copying it
+  ///
+  /// \param data Pointer to the first row, sharing ownership of the buffer.
+  /// \param count Number of descriptors in the buffer.
+  /// \param dim Number of elements in each descriptor.
+  /// \param stride Number of elements from the start of one row to the next.
+  packed_descriptor_set( std::shared_ptr< T > data,
+                         size_t count, size_t dim, size_t stride )
+    : data_( std::move( data ) ), size_( count ), dim_( dim ),
+      stride_( stride )
+  {
+    if( stride < dim )
+    {
+      VITAL_THROW( invalid_value,
+                   "packed descriptor stride is less than the dimension" );
+    }
+  }
+
+  /// Gather any descriptor set into contiguous storage
+  ///
+  /// \throws invalid_value If a descriptor is null, is not an array of T, or
+  ///                       differs in dimension from the first.
+  static std::shared_ptr< packed_descriptor_set< T > >
+  from( descriptor_set const& other )
+  {
+    if( auto const packed =
+          dynamic_cast< packed_descriptor_set< T > const* >( &other ) )
+    {
+      return std::make_shared< packed_descriptor_set< T > >( *packed );
+    }
+
+    auto const desc = other.descriptors();
+    auto const dim = desc.empty() || !desc[ 0 ] ? 0 : desc[ 0 ]->size();
+    std::vector< T > data( desc.size() * dim );
+    auto out = data.begin();
+    for( auto const& d : desc )
+    {
+      auto const da = dynamic_cast< descriptor_array_of< T > const* >( d.get() );
+      if( !da || da->size() != dim )
+      {
+        VITAL_THROW( invalid_value,
+                     "mismatch type or size when packing descriptors" );
+      }
+      out = std::copy( da->begin(), da->end(), out );
+    }
+    return std::make_shared< packed_descriptor_set< T > >(
+      std::move( data ), dim );
+  }
+
+  /// Get the number of elements in this set.
+  size_t size() const override { return size_; }
+
+  /// Whether or not this set is empty.
+  bool empty() const override { return size_ == 0; }
+
+  /// The number of elements in each descriptor
+  size_t dimension() const { return dim_; }
+
+  /// The number of elements from the start of one descriptor to the next
+  size_t stride() const { return stride_; }
+
+  /// Return a pointer to the first element of the first descriptor
+  T* raw_data() { return data_.get(); }
+
+  /// Return a pointer to the first element of the first descriptor
+  T const* raw_data() const { return data_.get(); }
+
+  /// Return the shared buffer, for consumers which must extend its lifetime
+  std::shared_ptr< T > const& buffer() const { return data_; }
+
+  /// Return a pointer to the first element of descriptor \p index
+  T* row( size_t index ) { return data_.get() + index * stride_; }
+
+  /// Return a pointer to the first element of descriptor \p index
+  T const* row( size_t index ) const { return data_.get() + index * stride_; }
+
+  //@{
+  /// Return a view of the descriptor at the specified index.
+  /// @param index 0-based index to access.
+  /// @throws std::out_of_range If position is not within the range of objects
+  ///                           in container.
+  descriptor_sptr at( size_t index ) override
+  {
+    return make_view( checked( index ) );
+  }
+
+  descriptor_sptr const at( size_t index ) const override
+  {
+    return make_view( checked( index ) );
+  }
+  //@}
+
+  /// Return views of every descriptor
+  std::vector< descriptor_sptr > descriptors() const override
+  {
+    std::vector< descriptor_sptr > desc;
+    desc.reserve( size_ );
+    for( size_t i = 0; i < size_; ++i )
+    {
+      desc.push_back( make_view( i ) );
+    }
+    return desc;
+  }
+
+protected:
+  /// Next value function for non-const iteration.
+  iterator::next_value_func_t get_iter_next_func() override
+  {
+    size_t index = 0;
+    descriptor_sptr d_sptr;
+    return [ index, d_sptr, this ] () mutable -> iterator::reference {
+      if( index >= size_ )
+      {
+        VITAL_THROW( stop_iteration_exception, "descriptor_set" );
+      }
+      d_sptr = make_view( index++ );
+      return d_sptr;
+    };
+  }
+
+  /// Next value function for const iteration.
+  const_iterator::next_value_func_t get_const_iter_next_func() const override
+  {
+    size_t index = 0;
+    descriptor_sptr d_sptr;
+    return [ index, d_sptr, this ] () mutable -> const_iterator::reference {
+      if( index >= size_ )
+      {
+        VITAL_THROW( stop_iteration_exception, "descriptor_set" );
+      }
+      d_sptr = make_view( index++ );
+      return d_sptr;
+    };
+  }
+
+  size_t checked( size_t index ) const
+  {
+    if( index >= size_ )
+    {
+      throw std::out_of_range( std::to_string( index ) );
+    }
+    return index;
+  }
+
+  descriptor_sptr make_view( size_t index ) const
+  {
+    return std::make_shared< descriptor_view< T > >(
+      std::shared_ptr< T >( data_, data_.get() + index * stride_ ), dim_ );
+  }
+
+  /// The descriptor buffer
+  std::shared_ptr< T > data_;
+  /// The number of descriptors
+  size_t size_;
+  /// The number of elements in each descriptor
+  size_t dim_;
+  /// The number of elements between descriptors
+  size_t stride_;
+};
+
+} } // end namespace vital
+
+#endif // VITAL_PACKED_DESCRIPTOR_SET_H_
@@ -10,6 +10,7 @@
 #define VITAL_TRACK_H_
 
 #include <vital/attribute_set.h>
+#include <vital/util/memory_accounting.h>
 #include <vital/vital_config.h>
 #include <vital/vital_export.h>
 #include <vital/vital_types.h>
@@ -49,6 +50,7 @@ class VITAL_EXPORT track_ref : public std::weak_ptr< track >
 // ----------------------------------------------------------------------------
 /// Empty base class for data associated with a track state.
 class VITAL_EXPORT track_state
+  : private memory_accounted< track_state, memory_category::track_state >
 {
 public:
   friend class track;
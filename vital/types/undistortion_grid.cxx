@@ -0,0 +1,155 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of \link kwiver::vital::undistortion_grid
+/// undistortion_grid \endlink class
+
+#include "undistortion_grid.h"
+
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <typeinfo>
+
+namespace kwiver {
+namespace vital {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+struct cache_entry
+{
+  std::weak_ptr< camera_intrinsics > intrinsics;
+  undistortion_grid_sptr grid;
+};
+
+std::mutex cache_mutex;
+std::map< camera_intrinsics const*, cache_entry > cache;
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+undistortion_grid
+::undistortion_grid( camera_intrinsics const& intrinsics, unsigned spacing )
+  : intrinsics_( intrinsics.clone() ),
+    spacing_( std::max( spacing, 1u ) ),
+    cols_( 0 ),
+    rows_( 0 )
+{
+  auto const width = intrinsics.image_width();
+  auto const height = intrinsics.image_height();
+  if( !width || !height )
+  {
+    // without an image size, every point is unmapped exactly
+    return;
+  }
+
+  // the grid covers the image, with one more point past the last pixel
+  cols_ = ( width + spacing_ - 1 ) / spacing_ + 1;
+  rows_ = ( height + spacing_ - 1 ) / spacing_ + 1;
+  points_.resize( cols_ * rows_ );
+
+  thread_pool::instance().parallel_for(
+    rows_, 4,
+    [ & ]( size_t begin, size_t end ){
+      for( size_t r = begin; r < end; ++r )
+      {
+        for( size_t c = 0; c < cols_; ++c )
+        {
+          points_[ r * cols_ + c ] = intrinsics_->unmap(
+            vector_2d( static_cast< double >( c * spacing_ ),
+                       static_cast< double >( r * spacing_ ) ) );
+        }
+      }
+    } );
+}
+
+// ----------------------------------------------------------------------------
+vector_2d
+undistortion_grid
+::unmap( vector_2d const& pt ) const
+{
+  double const x = pt.x() / spacing_;
+  double const y = pt.y() / spacing_;
+  if( !( x >= 0.0 && y >= 0.0 &&
+         x <= static_cast< double >( cols_ ) - 1.0 &&
+         y <= static_cast< double >( rows_ ) - 1.0 ) )
+  {
+    return intrinsics_->unmap( pt );
+  }
+
+  // the cell containing the point, with the last row and column of grid
+  // points only as the far corners of cells
+  auto const c = std::min( static_cast< size_t >( x ), cols_ - 2 );
+  auto const r = std::min( static_cast< size_t >( y ), rows_ - 2 );
+  double const u = x - static_cast< double >( c );
+  double const v = y - static_cast< double >( r );
+
+  auto const* const p = &points_[ r * cols_ + c ];
+  return ( 1.0 - v ) * ( ( 1.0 - u ) * p[ 0 ] + u * p[ 1 ] ) +
+         v * ( ( 1.0 - u ) * p[ cols_ ] + u * p[ cols_ + 1 ] );
+}
+
+// ----------------------------------------------------------------------------
+bool
+undistortion_grid
+::matches( camera_intrinsics const& intrinsics ) const
+{
+  auto const& k = *intrinsics_;
+  return typeid( k ) == typeid( intrinsics ) &&
+         k.focal_length() == intrinsics.focal_length() &&
+         k.principal_point() == intrinsics.principal_point() &&
+         k.aspect_ratio() == intrinsics.aspect_ratio() &&
+         k.skew() == intrinsics.skew() &&
+         k.image_width() == intrinsics.image_width() &&
+         k.image_height() == intrinsics.image_height() &&
+         k.dist_coeffs() == intrinsics.dist_coeffs();
+}
+
+// ----------------------------------------------------------------------------
+undistortion_grid_sptr
+cached_undistortion_grid( camera_intrinsics_sptr const& intrinsics,
+                          unsigned spacing )
+{
+  if( !intrinsics )
+  {
+    return nullptr;
+  }
+
+  {
+    std::lock_guard< std::mutex > lock( cache_mutex );
+    auto const i = cache.find( intrinsics.get() );
+    if( i != cache.end() &&
+        i->second.intrinsics.lock() == intrinsics &&
+        i->second.grid->spacing() == std::max( spacing, 1u ) &&
+        i->second.grid->matches( *intrinsics ) )
+    {
+      return i->second.grid;
+    }
+  }
+
+  // computed without holding the lock, so other intrinsics are not held up
+  auto const grid =
+    std::make_shared< undistortion_grid const >( *intrinsics, spacing );
+
+  std::lock_guard< std::mutex > lock( cache_mutex );
+  for( auto i = cache.begin(); i != cache.end(); )
+  {
+    if( i->second.intrinsics.expired() )
+    {
+      i = cache.erase( i );
+    }
+    else
+    {
+      ++i;
+    }
+  }
+  cache[ intrinsics.get() ] = { intrinsics, grid };
+  return grid;
+}
+
+} } // end namespace vital
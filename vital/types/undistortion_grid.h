@@ -0,0 +1,77 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Header file for a lookup grid of camera undistortion
+
+#ifndef VITAL_UNDISTORTION_GRID_H_
+#define VITAL_UNDISTORTION_GRID_H_
+
+#include "camera_intrinsics.h"
+
+#include <vital/vital_export.h>
+
+#include <memory>
+#include <vector>
+
+namespace kwiver {
+namespace vital {
+
+class undistortion_grid;
+/// typedef for an undistortion grid shared pointer
+typedef std::shared_ptr< undistortion_grid const > undistortion_grid_sptr;
+
+// ----------------------------------------------------------------------------
+/// A lookup grid of camera_intrinsics::unmap over the image of a camera
+///
+/// Undistortion has no closed form, so unmap() solves for each point
+/// iteratively. This grid unmaps the image coordinates at every
+/// \c spacing pixels once, and unmaps other points by bilinear
+/// interpolation of those. Points outside the image are unmapped exactly.
+/// Use it for mapping many pixels of images from cameras with fixed
+/// intrinsics, where an approximation is good enough.
+class VITAL_EXPORT undistortion_grid
+{
+public:
+  /// Constructor
+  ///
+  /// \param intrinsics the intrinsics to unmap with, which are copied
+  /// \param spacing    the distance in pixels between grid points
+  explicit undistortion_grid( camera_intrinsics const& intrinsics,
+                              unsigned spacing = 8 );
+
+  /// Unmap image coordinates into normalized image coordinates
+  vector_2d unmap( vector_2d const& pt ) const;
+
+  /// Return the distance in pixels between grid points
+  unsigned spacing() const { return spacing_; }
+
+  /// Return true if the grid was built from intrinsics equal to these
+  bool matches( camera_intrinsics const& intrinsics ) const;
+
+private:
+  camera_intrinsics_sptr intrinsics_;
+  unsigned spacing_;
+  size_t cols_;
+  size_t rows_;
+  /// Unmapped grid points, row by row
+  std::vector< vector_2d > points_;
+};
+
+/// Get the undistortion grid of an intrinsics instance
+///
+/// The grid is computed on first use and kept for as long as the
+/// intrinsics exist, so that each frame of a camera with fixed intrinsics
+/// uses the same grid. It is computed again if the intrinsics have changed.
+/// This function may be called from several threads.
+///
+/// \param intrinsics the intrinsics to get the grid for
+/// \param spacing    the distance in pixels between grid points
+VITAL_EXPORT undistortion_grid_sptr
+cached_undistortion_grid( camera_intrinsics_sptr const& intrinsics,
+                          unsigned spacing = 8 );
+
+} } // end namespace vital
+
+#endif // VITAL_UNDISTORTION_GRID_H_
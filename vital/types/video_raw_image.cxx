@@ -11,6 +11,8 @@ namespace kwiver {
 
 namespace vital {
 
+video_raw_image::video_raw_image() : is_keyframe{ false } {}
+
 video_raw_image::~video_raw_image() {}
 
 } // namespace vital
@@ -20,7 +20,15 @@ namespace vital {
 /// Base class for holding a single frame of unprocessed image data.
 struct VITAL_EXPORT video_raw_image
 {
+  video_raw_image();
   virtual ~video_raw_image();
+
+  /// True if a video can be started with this frame.
+  ///
+  /// This means that neither this frame nor any later frame depends on data
+  /// from before it, so raw images from this one on can be copied to a video
+  /// which was written up to here some other way.
+  bool is_keyframe;
 };
 
 using video_raw_image_sptr = std::shared_ptr< video_raw_image >;
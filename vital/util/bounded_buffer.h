@@ -8,7 +8,9 @@
 #ifndef KWIVER_VITAL_UTIL_BOUNDED_BUFFER_H_
 #define KWIVER_VITAL_UTIL_BOUNDED_BUFFER_H_
 
+#include <chrono>
 #include <condition_variable> //+ c++11 required
+#include <functional>
 #include <mutex>
 #include <vector>
 #include <stdexcept>
@@ -23,12 +25,20 @@ namespace vital {
 ///
 /// This class represents a fixed size bounded buffer designed for
 /// communication between threads.
+///
+/// A watermark callback can be installed to be told when the buffer
+/// fills up to a given number of elements and when it drains back down,
+/// so that a producer can apply backpressure without polling.
 template <class T>
 class bounded_buffer : private vital::noncopyable
 {
 public:
   typedef std::unique_lock<std::mutex> lock;
 
+  /// Watermark callback; called with \b true when the high watermark
+  /// is reached and with \b false when the low watermark is reached.
+  typedef std::function< void( bool ) > watermark_callback_t;
+
   bounded_buffer( int size )
   : begin(0),
     end(0),
@@ -51,9 +61,10 @@ class bounded_buffer : private vital::noncopyable
     begin = 0;
     end = 0;
     buffered = 0;
+    above_high = false;
 
     // just in case
-    buffer_not_full.notify_one();
+    buffer_not_full.notify_all();
   }
 
   /// @brief Send element to buffer.
@@ -71,11 +82,48 @@ class bounded_buffer : private vital::noncopyable
       buffer_not_full.wait(lk);
     }
 
-    circular_buf[end] = m;
-    end = (end+1) % circular_buf.size();
-    ++buffered;
+    push( m, lk );
+  }
 
-    buffer_not_empty.notify_one();
+  /// @brief Send element to buffer, waiting at most \p timeout.
+  ///
+  /// @param[in] m Element to add to buffer.
+  /// @param[in] timeout Longest time to wait for space in the buffer.
+  ///
+  /// @return \b true if the element was added, \b false if there was
+  /// still no space after \p timeout.
+  template < class Rep, class Period >
+  bool Send (T const& m, std::chrono::duration< Rep, Period > const& timeout)
+  {
+    lock lk(monitor);
+    if ( ! buffer_not_full.wait_for( lk, timeout,
+                                     [this]{ return buffered < circular_buf.size(); } ) )
+    {
+      return false;
+    }
+
+    push( m, lk );
+    return true;
+  }
+
+  /// @brief Send element to buffer if there is space.
+  ///
+  /// This method never waits.
+  ///
+  /// @param[in] m Element to add to buffer.
+  ///
+  /// @return \b true if the element was added, \b false if the
+  /// buffer was full.
+  bool TrySend (T const& m)
+  {
+    lock lk(monitor);
+    if (buffered == circular_buf.size())
+    {
+      return false;
+    }
+
+    push( m, lk );
+    return true;
   }
 
   /// @brief Receive element from buffer.
@@ -92,14 +140,52 @@ class bounded_buffer : private vital::noncopyable
       buffer_not_empty.wait(lk);
     }
 
-    T i = circular_buf[begin];
-    begin = (begin+1) % circular_buf.size();
-    --buffered;
-
-    buffer_not_full.notify_one();
+    T i;
+    pop( i, lk );
     return i;
   }
 
+  /// @brief Receive element from buffer, waiting at most \p timeout.
+  ///
+  /// @param[out] m The oldest element in the buffer.
+  /// @param[in] timeout Longest time to wait for an element.
+  ///
+  /// @return \b true if an element was received, \b false if the
+  /// buffer was still empty after \p timeout.
+  template < class Rep, class Period >
+  bool Receive (T& m, std::chrono::duration< Rep, Period > const& timeout)
+  {
+    lock lk(monitor);
+    if ( ! buffer_not_empty.wait_for( lk, timeout,
+                                      [this]{ return buffered > 0; } ) )
+    {
+      return false;
+    }
+
+    pop( m, lk );
+    return true;
+  }
+
+  /// @brief Receive element from buffer if there is one.
+  ///
+  /// This method never waits.
+  ///
+  /// @param[out] m The oldest element in the buffer.
+  ///
+  /// @return \b true if an element was received, \b false if the
+  /// buffer was empty.
+  bool TryReceive (T& m)
+  {
+    lock lk(monitor);
+    if (buffered == 0)
+    {
+      return false;
+    }
+
+    pop( m, lk );
+    return true;
+  }
+
   /// @brief Test if buffer is empty.
   ///
   /// This method indicates if the buffer is empty.  A polling approach
@@ -122,11 +208,95 @@ class bounded_buffer : private vital::noncopyable
     return  (buffered == circular_buf.size());
   }
 
+  /// @brief Number of elements in the buffer.
+  size_t Size() const
+  {
+    return buffered;
+  }
+
+  /// @brief Number of elements the buffer can hold.
+  size_t Capacity() const
+  {
+    return circular_buf.size();
+  }
+
+  /// @brief Set watermark callback.
+  ///
+  /// The callback is called with \b true by the thread whose send
+  /// brings the buffer up to \p high elements, and then with \b false
+  /// by the thread whose receive brings it back down to \p low
+  /// elements. The callback is called without the buffer locked, so it
+  /// may send to or receive from the buffer, but it should return
+  /// quickly since the sending or receiving thread waits for it.
+  ///
+  /// @param[in] notify Callback, or an empty function to remove it.
+  /// @param[in] high High watermark, from 1 to the buffer capacity.
+  /// @param[in] low Low watermark, less than \p high.
+  ///
+  /// @throws std::invalid_argument if the watermarks are out of range.
+  void SetWatermarks( watermark_callback_t notify, size_t high, size_t low )
+  {
+    if ( high < 1 || high > circular_buf.size() || low >= high )
+    {
+      throw std::invalid_argument( "Invalid watermarks specified for bounded_buffer." );
+    }
+
+    lock lk(monitor);
+    watermark_notify = std::move( notify );
+    high_watermark = high;
+    low_watermark = low;
+    above_high = false;
+  }
+
 private:
+  void push( T const& m, lock& lk )
+  {
+    circular_buf[end] = m;
+    end = (end+1) % circular_buf.size();
+    ++buffered;
+
+    bool const notify = watermark_notify && ! above_high &&
+                        buffered >= high_watermark;
+    above_high = above_high || notify;
+    auto const callback = ( notify ? watermark_notify : watermark_callback_t{} );
+
+    lk.unlock();
+    buffer_not_empty.notify_one();
+    if ( notify )
+    {
+      callback( true );
+    }
+  }
+
+  void pop( T& m, lock& lk )
+  {
+    m = std::move( circular_buf[begin] );
+    circular_buf[begin] = T();
+    begin = (begin+1) % circular_buf.size();
+    --buffered;
+
+    bool const notify = watermark_notify && above_high &&
+                        buffered <= low_watermark;
+    above_high = above_high && ! notify;
+    auto const callback = ( notify ? watermark_notify : watermark_callback_t{} );
+
+    lk.unlock();
+    buffer_not_full.notify_one();
+    if ( notify )
+    {
+      callback( false );
+    }
+  }
+
   size_t begin, end, buffered;
   std::vector< T > circular_buf;
   std::condition_variable buffer_not_full, buffer_not_empty;
   std::mutex monitor;
+
+  watermark_callback_t watermark_notify;
+  size_t high_watermark = 0;
+  size_t low_watermark = 0;
+  bool above_high = false;
 };
 
 } } // end namespace
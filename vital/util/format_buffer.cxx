@@ -0,0 +1,222 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "format_buffer.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <locale>
+
+namespace kwiver {
+namespace vital {
+
+namespace {
+
+// Longest text of a formatted number
+constexpr size_t max_number_size = 64;
+
+// Largest precision for which whole values are formatted as integers
+constexpr int max_integer_precision = 15;
+
+// ----------------------------------------------------------------------------
+// Write the digits of value backwards, ending at end
+char*
+format_digits( unsigned long long value, char* end )
+{
+  do
+  {
+    *--end = static_cast< char >( '0' + value % 10 );
+    value /= 10;
+  } while( value );
+  return end;
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+format_buffer
+::format_buffer( std::ostream& stream, size_t capacity )
+  : m_stream( stream ),
+    m_capacity( capacity > max_number_size ? capacity : max_number_size ),
+    m_precision( static_cast< int >( stream.precision() ) )
+{
+  m_buffer.reserve( m_capacity );
+
+  auto const flags = stream.flags();
+  auto const special = std::ios_base::floatfield | std::ios_base::showpos |
+                       std::ios_base::showpoint | std::ios_base::uppercase |
+                       std::ios_base::showbase;
+  auto const base = flags & std::ios_base::basefield;
+  m_default_format =
+    !( flags & special ) && ( !base || base == std::ios_base::dec ) &&
+    stream.width() == 0 && stream.getloc().name() == "C";
+  if( m_precision <= 0 )
+  {
+    m_precision = 1;
+  }
+  m_integer_limit = ( m_precision <= max_integer_precision
+                      ? std::pow( 10.0, m_precision ) : 0.0 );
+
+  m_fallback.copyfmt( stream );
+}
+
+// ----------------------------------------------------------------------------
+format_buffer
+::~format_buffer()
+{
+  flush();
+}
+
+// ----------------------------------------------------------------------------
+void
+format_buffer
+::flush()
+{
+  if( !m_buffer.empty() )
+  {
+    m_stream.write( m_buffer.data(),
+                    static_cast< std::streamsize >( m_buffer.size() ) );
+    m_buffer.clear();
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+format_buffer
+::reserve( size_t n )
+{
+  if( m_buffer.size() + n > m_capacity )
+  {
+    flush();
+  }
+}
+
+// ----------------------------------------------------------------------------
+format_buffer&
+format_buffer
+::operator<<( char c )
+{
+  reserve( 1 );
+  m_buffer.push_back( c );
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+format_buffer&
+format_buffer
+::operator<<( char const* s )
+{
+  auto const n = std::strlen( s );
+  reserve( n );
+  m_buffer.append( s, n );
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+format_buffer&
+format_buffer
+::operator<<( std::string const& s )
+{
+  reserve( s.size() );
+  m_buffer.append( s );
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+format_buffer&
+format_buffer
+::put_signed( long long value )
+{
+  if( !m_default_format )
+  {
+    m_fallback.str( {} );
+    m_fallback << value;
+    return *this << m_fallback.str();
+  }
+
+  char text[ max_number_size ];
+  auto const end = text + sizeof( text );
+  auto const magnitude =
+    ( value < 0 ? 0ull - static_cast< unsigned long long >( value )
+                : static_cast< unsigned long long >( value ) );
+  auto begin = format_digits( magnitude, end );
+  if( value < 0 )
+  {
+    *--begin = '-';
+  }
+
+  reserve( static_cast< size_t >( end - begin ) );
+  m_buffer.append( begin, end );
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+format_buffer&
+format_buffer
+::put_unsigned( unsigned long long value )
+{
+  if( !m_default_format )
+  {
+    m_fallback.str( {} );
+    m_fallback << value;
+    return *this << m_fallback.str();
+  }
+
+  char text[ max_number_size ];
+  auto const end = text + sizeof( text );
+  auto const begin = format_digits( value, end );
+
+  reserve( static_cast< size_t >( end - begin ) );
+  m_buffer.append( begin, end );
+  return *this;
+}
+
+// ----------------------------------------------------------------------------
+format_buffer&
+format_buffer
+::operator<<( float value )
+{
+  // Streams format float as double
+  return *this << static_cast< double >( value );
+}
+
+// ----------------------------------------------------------------------------
+format_buffer&
+format_buffer
+::operator<<( double value )
+{
+  if( !m_default_format )
+  {
+    m_fallback.str( {} );
+    m_fallback << value;
+    return *this << m_fallback.str();
+  }
+
+  // Whole numbers with no more digits than the precision print as integers
+  if( std::fabs( value ) < m_integer_limit && value == std::trunc( value ) )
+  {
+    if( value == 0.0 )
+    {
+      return *this << ( std::signbit( value ) ? "-0" : "0" );
+    }
+    return put_signed( static_cast< long long >( value ) );
+  }
+
+  reserve( max_number_size );
+  char text[ max_number_size ];
+  auto const n =
+    std::snprintf( text, sizeof( text ), "%.*g", m_precision, value );
+  if( n < 0 || static_cast< size_t >( n ) >= sizeof( text ) )
+  {
+    m_fallback.str( {} );
+    m_fallback << value;
+    return *this << m_fallback.str();
+  }
+  m_buffer.append( text, static_cast< size_t >( n ) );
+  return *this;
+}
+
+} // ...vital
+} // ...kwiver
@@ -0,0 +1,79 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Buffered formatting of text for an output stream
+
+#ifndef KWIVER_VITAL_UTIL_FORMAT_BUFFER_H
+#define KWIVER_VITAL_UTIL_FORMAT_BUFFER_H
+
+#include <vital/util/vital_util_export.h>
+
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <string>
+
+namespace kwiver {
+namespace vital {
+
+/// Text formatting into a large buffer written to a stream in blocks
+///
+/// Values are formatted as the stream would format them with its settings
+/// at construction, but without the per-value overhead of the stream
+/// insertion operators. Integers, and floating point values in the default
+/// notation, are formatted directly. The buffer is written to the stream
+/// when it fills, when flush() is called, and on destruction. Unlike
+/// std::endl, newlines do not flush the stream.
+class VITAL_UTIL_EXPORT format_buffer
+{
+public:
+  /// Format text for \p stream, buffering about \p capacity bytes
+  explicit format_buffer( std::ostream& stream, size_t capacity = 1 << 20 );
+
+  ~format_buffer();
+
+  format_buffer( format_buffer const& ) = delete;
+  format_buffer& operator=( format_buffer const& ) = delete;
+
+  /// Write the buffered text to the stream
+  void flush();
+
+  format_buffer& operator<<( char c );
+  format_buffer& operator<<( char const* s );
+  format_buffer& operator<<( std::string const& s );
+  format_buffer& operator<<( int value ) { return put_signed( value ); }
+  format_buffer& operator<<( long value ) { return put_signed( value ); }
+  format_buffer& operator<<( long long value ) { return put_signed( value ); }
+  format_buffer& operator<<( unsigned value ) { return put_unsigned( value ); }
+  format_buffer& operator<<( unsigned long value )
+  { return put_unsigned( value ); }
+  format_buffer& operator<<( unsigned long long value )
+  { return put_unsigned( value ); }
+  format_buffer& operator<<( float value );
+  format_buffer& operator<<( double value );
+
+private:
+  format_buffer& put_signed( long long value );
+  format_buffer& put_unsigned( unsigned long long value );
+
+  // Make room for at least n more characters
+  void reserve( size_t n );
+
+  std::ostream& m_stream;
+  std::string m_buffer;
+  size_t m_capacity;
+
+  // Settings of the stream for numbers; values are formatted by a copy of
+  // the stream unless it uses the default notation
+  int m_precision;
+  double m_integer_limit;
+  bool m_default_format;
+  std::ostringstream m_fallback;
+};
+
+} // ...vital
+} // ...kwiver
+
+#endif
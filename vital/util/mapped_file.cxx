@@ -0,0 +1,189 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "mapped_file.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace kwiver {
+namespace vital {
+
+// ----------------------------------------------------------------------------
+mapped_file
+::mapped_file( std::string const& path )
+{
+  open( path );
+}
+
+// ----------------------------------------------------------------------------
+mapped_file
+::~mapped_file()
+{
+  close();
+}
+
+// ----------------------------------------------------------------------------
+mapped_file
+::mapped_file( mapped_file&& other ) noexcept
+{
+  *this = std::move( other );
+}
+
+// ----------------------------------------------------------------------------
+mapped_file&
+mapped_file
+::operator=( mapped_file&& other ) noexcept
+{
+  if( this != &other )
+  {
+    close();
+    std::swap( m_data, other.m_data );
+    std::swap( m_size, other.m_size );
+    std::swap( m_open, other.m_open );
+#ifdef _WIN32
+    std::swap( m_file, other.m_file );
+    std::swap( m_mapping, other.m_mapping );
+#endif
+  }
+  return *this;
+}
+
+#ifdef _WIN32
+
+// ----------------------------------------------------------------------------
+bool
+mapped_file
+::open( std::string const& path )
+{
+  close();
+
+  HANDLE const file =
+    CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                 OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr );
+  if( file == INVALID_HANDLE_VALUE )
+  {
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  if( !GetFileSizeEx( file, &size ) )
+  {
+    CloseHandle( file );
+    return false;
+  }
+  m_file = file;
+  m_size = static_cast< size_t >( size.QuadPart );
+  m_open = true;
+  if( m_size == 0 )
+  {
+    return true;
+  }
+
+  m_mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0,
+                                  nullptr );
+  if( m_mapping )
+  {
+    m_data = static_cast< char const* >(
+      MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+  }
+  if( !m_data )
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+mapped_file
+::close()
+{
+  if( m_data )
+  {
+    UnmapViewOfFile( m_data );
+  }
+  if( m_mapping )
+  {
+    CloseHandle( m_mapping );
+  }
+  if( m_file )
+  {
+    CloseHandle( m_file );
+  }
+  m_data = nullptr;
+  m_mapping = nullptr;
+  m_file = nullptr;
+  m_size = 0;
+  m_open = false;
+}
+
+#else
+
+// ----------------------------------------------------------------------------
+bool
+mapped_file
+::open( std::string const& path )
+{
+  close();
+
+  int const fd = ::open( path.c_str(), O_RDONLY );
+  if( fd < 0 )
+  {
+    return false;
+  }
+
+  struct stat st;
+  if( fstat( fd, &st ) != 0 || !S_ISREG( st.st_mode ) )
+  {
+    ::close( fd );
+    return false;
+  }
+
+  m_size = static_cast< size_t >( st.st_size );
+  if( m_size > 0 )
+  {
+    void* const ptr = mmap( nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    if( ptr == MAP_FAILED )
+    {
+      ::close( fd );
+      m_size = 0;
+      return false;
+    }
+    m_data = static_cast< char const* >( ptr );
+  }
+
+  // the mapping keeps its own reference to the file
+  ::close( fd );
+  m_open = true;
+  return true;
+}
+
+// ----------------------------------------------------------------------------
+void
+mapped_file
+::close()
+{
+  if( m_data )
+  {
+    munmap( const_cast< char* >( m_data ), m_size );
+  }
+  m_data = nullptr;
+  m_size = 0;
+  m_open = false;
+}
+
+#endif
+
+} // ...vital
+} // ...kwiver
@@ -0,0 +1,73 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Read-only memory mapping of a file
+
+#ifndef KWIVER_VITAL_UTIL_MAPPED_FILE_H
+#define KWIVER_VITAL_UTIL_MAPPED_FILE_H
+
+#include <vital/util/vital_util_export.h>
+
+#include <cstddef>
+#include <string>
+
+namespace kwiver {
+namespace vital {
+
+/// A read-only view of the contents of a file mapped into memory
+///
+/// The pages of the file are loaded by the operating system on first access,
+/// so opening a large file is cheap and reading it costs no more than
+/// touching the bytes needed.  The mapping is released when the object is
+/// destroyed or closed.
+class VITAL_UTIL_EXPORT mapped_file
+{
+public:
+  /// Construct with no file mapped
+  mapped_file() = default;
+
+  /// Map the file at \p path; check is_open() for success
+  explicit mapped_file( std::string const& path );
+
+  ~mapped_file();
+
+  mapped_file( mapped_file const& ) = delete;
+  mapped_file& operator=( mapped_file const& ) = delete;
+
+  mapped_file( mapped_file&& other ) noexcept;
+  mapped_file& operator=( mapped_file&& other ) noexcept;
+
+  /// Map the file at \p path, releasing any current mapping
+  ///
+  /// \returns true on success.  An empty file opens successfully with a
+  ///          null data() pointer.
+  bool open( std::string const& path );
+
+  /// Release the current mapping
+  void close();
+
+  /// Check if a file is mapped
+  bool is_open() const { return m_open; }
+
+  /// Pointer to the first byte of the file
+  char const* data() const { return m_data; }
+
+  /// Number of bytes in the file
+  size_t size() const { return m_size; }
+
+private:
+  char const* m_data = nullptr;
+  size_t m_size = 0;
+  bool m_open = false;
+#ifdef _WIN32
+  void* m_file = nullptr;
+  void* m_mapping = nullptr;
+#endif
+};
+
+} // ...vital
+} // ...kwiver
+
+#endif
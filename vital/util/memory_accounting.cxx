@@ -0,0 +1,127 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of memory accounting
+
+#include "memory_accounting.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+namespace kwiver {
+namespace vital {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+struct category_counters
+{
+  std::atomic< int64_t > live_bytes;
+  std::atomic< int64_t > live_count;
+  std::atomic< int64_t > peak_bytes;
+  std::atomic< uint64_t > total_count;
+};
+
+// Zero-initialized before any dynamic initialization, so objects created
+// during static initialization can be accounted
+category_counters g_counters[ num_memory_categories ];
+
+// ----------------------------------------------------------------------------
+category_counters&
+counters( memory_category category )
+{
+  return g_counters[ static_cast< size_t >( category ) ];
+}
+
+} // namespace <anonymous>
+
+// ----------------------------------------------------------------------------
+bool
+memory_accounting
+::enabled()
+{
+  static bool const enabled = []{
+    auto const value = std::getenv( "KWIVER_MEMORY_ACCOUNTING" );
+    return value && *value && std::strcmp( value, "0" );
+  }();
+  return enabled;
+}
+
+// ----------------------------------------------------------------------------
+void
+memory_accounting
+::allocate( memory_category category, size_t bytes, size_t count )
+{
+  if( !enabled() )
+  {
+    return;
+  }
+
+  auto& c = counters( category );
+  auto const live =
+    c.live_bytes.fetch_add( static_cast< int64_t >( bytes ),
+                            std::memory_order_relaxed ) +
+    static_cast< int64_t >( bytes );
+  c.live_count.fetch_add( static_cast< int64_t >( count ),
+                          std::memory_order_relaxed );
+  c.total_count.fetch_add( count, std::memory_order_relaxed );
+
+  auto peak = c.peak_bytes.load( std::memory_order_relaxed );
+  while( live > peak &&
+         !c.peak_bytes.compare_exchange_weak( peak, live,
+                                              std::memory_order_relaxed ) )
+  {}
+}
+
+// ----------------------------------------------------------------------------
+void
+memory_accounting
+::release( memory_category category, size_t bytes, size_t count )
+{
+  if( !enabled() )
+  {
+    return;
+  }
+
+  auto& c = counters( category );
+  c.live_bytes.fetch_sub( static_cast< int64_t >( bytes ),
+                          std::memory_order_relaxed );
+  c.live_count.fetch_sub( static_cast< int64_t >( count ),
+                          std::memory_order_relaxed );
+}
+
+// ----------------------------------------------------------------------------
+memory_usage
+memory_accounting
+::usage( memory_category category )
+{
+  auto const& c = counters( category );
+
+  memory_usage result;
+  result.live_bytes = c.live_bytes.load( std::memory_order_relaxed );
+  result.live_count = c.live_count.load( std::memory_order_relaxed );
+  result.peak_bytes = c.peak_bytes.load( std::memory_order_relaxed );
+  result.total_count = c.total_count.load( std::memory_order_relaxed );
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+char const*
+memory_accounting
+::name( memory_category category )
+{
+  switch( category )
+  {
+    case memory_category::image:       return "image";
+    case memory_category::descriptor:  return "descriptor";
+    case memory_category::track_state: return "track_state";
+    case memory_category::metadata:    return "metadata";
+  }
+  return "unknown";
+}
+
+} // ...vital
+} // ...kwiver
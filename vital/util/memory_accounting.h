@@ -0,0 +1,122 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Accounting of the memory held by vital data types
+
+#ifndef KWIVER_VITAL_UTIL_MEMORY_ACCOUNTING_H
+#define KWIVER_VITAL_UTIL_MEMORY_ACCOUNTING_H
+
+#include <vital/util/vital_util_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace kwiver {
+namespace vital {
+
+/// Kinds of data whose memory is accounted
+enum class memory_category
+{
+  image,
+  descriptor,
+  track_state,
+  metadata,
+};
+
+/// Number of values of memory_category
+constexpr size_t num_memory_categories = 4;
+
+/// Memory held by one category of data
+struct memory_usage
+{
+  /// Bytes currently held
+  int64_t live_bytes = 0;
+  /// Objects currently alive
+  int64_t live_count = 0;
+  /// Largest value of live_bytes so far
+  int64_t peak_bytes = 0;
+  /// Objects created so far
+  uint64_t total_count = 0;
+};
+
+/// Process-wide counts of the bytes and objects held by vital data types
+///
+/// Image memory, descriptors, track states and metadata items report their
+/// construction and destruction here.  Accounting is off unless the
+/// KWIVER_MEMORY_ACCOUNTING environment variable is set to a value other than
+/// 0 when the process first reports, and stays in that state for the life of
+/// the process so that every release matches an allocation.  When off, a
+/// report costs one test of a flag.
+///
+/// Bytes are those of the objects themselves and any buffers they own, such
+/// as pixels or descriptor values; data that is shared, such as the feature
+/// of a feature track state, is accounted under its own category.
+class VITAL_UTIL_EXPORT memory_accounting
+{
+public:
+  /// Check if accounting is on
+  static bool enabled();
+
+  /// Record that \p count objects holding \p bytes were created
+  static void allocate( memory_category category,
+                        size_t bytes, size_t count = 1 );
+
+  /// Record that \p count objects holding \p bytes were destroyed
+  static void release( memory_category category,
+                       size_t bytes, size_t count = 1 );
+
+  /// Get the memory currently held by a category
+  static memory_usage usage( memory_category category );
+
+  /// Get the name of a category, as used in exported metrics
+  static char const* name( memory_category category );
+};
+
+namespace memory_accounting_detail {
+
+template < class T > struct size_of { static constexpr size_t value = sizeof( T ); };
+template <> struct size_of< void > { static constexpr size_t value = 0; };
+
+} // ...memory_accounting_detail
+
+// ----------------------------------------------------------------------------
+/// Empty base class which accounts the size of \p Self for each object
+///
+/// Deriving from this adds no storage.  A class derived from one which is
+/// already accounted passes that class as \p Base, so that only the bytes it
+/// adds are accounted and each object is counted once.  Buffers the object
+/// owns must be accounted separately.
+template < class Self, memory_category Category, class Base = void >
+class memory_accounted
+{
+protected:
+  memory_accounted()
+  {
+    memory_accounting::allocate( Category, bytes(), count() );
+  }
+
+  memory_accounted( memory_accounted const& ) : memory_accounted() {}
+
+  memory_accounted& operator=( memory_accounted const& ) { return *this; }
+
+  ~memory_accounted()
+  {
+    memory_accounting::release( Category, bytes(), count() );
+  }
+
+private:
+  static size_t bytes()
+  {
+    return sizeof( Self ) - memory_accounting_detail::size_of< Base >::value;
+  }
+
+  static size_t count() { return std::is_void< Base >::value ? 1 : 0; }
+};
+
+} // ...vital
+} // ...kwiver
+
+#endif
@@ -0,0 +1,79 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "resource_cache.h"
+
+#include <kwiversys/SystemTools.hxx>
+
+namespace kwiver {
+namespace vital {
+
+// ----------------------------------------------------------------------------
+resource_cache&
+resource_cache
+::instance()
+{
+  static resource_cache cache;
+  return cache;
+}
+
+// ----------------------------------------------------------------------------
+std::string
+resource_cache
+::file_key( std::string const& path, std::string const& params )
+{
+  auto const full_path = kwiversys::SystemTools::CollapseFullPath( path );
+  auto const mtime = kwiversys::SystemTools::ModifiedTime( full_path );
+  return full_path + '\n' + std::to_string( mtime ) + '\n' + params;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+resource_cache
+::size() const
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+
+  size_t count = 0;
+  for( auto const& e : m_entries )
+  {
+    if( !e.second->resource.expired() )
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+
+// ----------------------------------------------------------------------------
+std::shared_ptr< resource_cache::entry >
+resource_cache
+::find_entry( std::type_index type, std::string const& key )
+{
+  std::lock_guard< std::mutex > lock( m_mutex );
+
+  // Drop entries whose resources have been released, other than those
+  // being loaded, so that the map does not grow with every key ever used
+  for( auto i = m_entries.begin(); i != m_entries.end(); )
+  {
+    if( i->second.use_count() == 1 && i->second->resource.expired() )
+    {
+      i = m_entries.erase( i );
+    }
+    else
+    {
+      ++i;
+    }
+  }
+
+  auto& e = m_entries[ key_t( type, key ) ];
+  if( !e )
+  {
+    e = std::make_shared< entry >();
+  }
+  return e;
+}
+
+} // ...vital
+} // ...kwiver
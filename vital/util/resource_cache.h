@@ -0,0 +1,108 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Process-wide cache of shared read-only resources such as models
+
+#ifndef KWIVER_VITAL_UTIL_RESOURCE_CACHE_H
+#define KWIVER_VITAL_UTIL_RESOURCE_CACHE_H
+
+#include <vital/noncopyable.h>
+#include <vital/util/vital_util_export.h>
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <utility>
+
+namespace kwiver {
+namespace vital {
+
+/// Process-wide cache of large immutable resources shared between instances
+///
+/// Algorithms which load a model, vocabulary or lookup table from a file ask
+/// the cache for it by a key naming the file and the parameters it is loaded
+/// with.  The first request runs the given loader; later requests for the
+/// same type and key, from any thread, get the same object until every
+/// handle to it is released, after which it is freed and the next request
+/// loads it again.  The cache only holds weak references, so it never keeps
+/// a resource alive on its own.
+///
+/// Resources are handed out as pointers to const, since they are shared by
+/// instances which may run concurrently.  Concurrent requests for the same
+/// resource wait for a single load; requests for other resources are not
+/// blocked by it.
+///
+/// \code
+///  auto model = resource_cache::instance().get< model_t >(
+///    resource_cache::file_key( path, std::to_string( levels ) ),
+///    [ & ]{ return load_model( path, levels ); } );
+/// \endcode
+class VITAL_UTIL_EXPORT resource_cache
+  : private kwiver::vital::noncopyable
+{
+public:
+  /// Access the singleton instance of this class
+  static resource_cache& instance();
+
+  /// Get a shared resource, loading it if it is not already held
+  ///
+  /// \param key names the resource among those of type \p T
+  /// \param load makes the resource; may throw, in which case nothing is
+  ///             cached and the exception is passed on
+  /// \returns the shared resource, or null if \p load returned null
+  template < typename T >
+  std::shared_ptr< T const >
+  get( std::string const& key,
+       std::function< std::shared_ptr< T > () > const& load )
+  {
+    auto const e = find_entry( typeid( T ), key );
+
+    std::lock_guard< std::mutex > lock( e->load_mutex );
+    auto resource = std::static_pointer_cast< T const >( e->resource.lock() );
+    if( !resource )
+    {
+      resource = load();
+      e->resource = resource;
+    }
+    return resource;
+  }
+
+  /// Make a key for a resource loaded from a file
+  ///
+  /// The key holds the absolute path of the file and its modification time,
+  /// so that different relative paths to one file share a resource and a
+  /// file replaced on disk is loaded again, followed by \p params, which
+  /// should describe any load parameters that change the resource.
+  static std::string file_key( std::string const& path,
+                               std::string const& params = {} );
+
+  /// Number of resources currently held by at least one handle
+  size_t size() const;
+
+private:
+  resource_cache() = default;
+
+  struct entry
+  {
+    std::mutex load_mutex;
+    std::weak_ptr< void const > resource;
+  };
+
+  using key_t = std::pair< std::type_index, std::string >;
+
+  std::shared_ptr< entry > find_entry( std::type_index type,
+                                       std::string const& key );
+
+  mutable std::mutex m_mutex;
+  std::map< key_t, std::shared_ptr< entry > > m_entries;
+};
+
+} // ...vital
+} // ...kwiver
+
+#endif
@@ -0,0 +1,122 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test util format_buffer class
+
+#include <vital/util/format_buffer.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+
+using namespace kwiver::vital;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Write values both through a format_buffer and straight to a stream
+template < typename... Args >
+void
+expect_same_text( std::ostream& ( *setup )( std::ostream& ), Args... args )
+{
+  std::ostringstream expected;
+  std::ostringstream actual;
+  setup( expected );
+  setup( actual );
+
+  using expand = int[];
+  ( void ) expand{ 0, ( expected << args << '|', 0 )... };
+  {
+    format_buffer buffer{ actual, 16 };
+    ( void ) expand{ 0, ( buffer << args << '|', 0 )... };
+  }
+  EXPECT_EQ( expected.str(), actual.str() );
+}
+
+// ----------------------------------------------------------------------------
+std::ostream&
+no_setup( std::ostream& s )
+{
+  return s;
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST(format_buffer, integers)
+{
+  expect_same_text( no_setup, 0, -1, 42, std::numeric_limits< int >::min(),
+                    std::numeric_limits< long long >::min(),
+                    std::numeric_limits< long long >::max(),
+                    std::numeric_limits< unsigned long long >::max(),
+                    17u, 18ul );
+}
+
+// ----------------------------------------------------------------------------
+TEST(format_buffer, doubles)
+{
+  double const special[] = {
+    0.0, -0.0, 1.0, -1.0, 0.5, 123456.0, 1234567.0, 999999.5, 1e-5, 1e300,
+    0.1, 2.0 / 3.0, 1e15, -1e16, 1234.5678,
+    std::numeric_limits< double >::infinity(),
+    -std::numeric_limits< double >::infinity(),
+    std::numeric_limits< double >::denorm_min() };
+  for( auto const v : special )
+  {
+    SCOPED_TRACE( v );
+    expect_same_text( no_setup, v, static_cast< float >( v ) );
+  }
+
+  std::mt19937 rng( 2 );
+  std::uniform_real_distribution< double > value( -1e4, 1e4 );
+  for( int i = 0; i < 1000; ++i )
+  {
+    auto const v = value( rng );
+    expect_same_text( no_setup, v, std::round( v ), v * 1e-9 );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(format_buffer, stream_settings)
+{
+  // Settings of the stream are honored
+  expect_same_text(
+    []( std::ostream& s ) -> std::ostream& { return s << std::setprecision( 12 ); },
+    2.0 / 3.0, 123456789012.0, 1234567890123.0, 5 );
+  expect_same_text(
+    []( std::ostream& s ) -> std::ostream& { return s << std::fixed; },
+    2.0 / 3.0, 1e10, 7 );
+  expect_same_text(
+    []( std::ostream& s ) -> std::ostream& { return s << std::hex; },
+    255, 1.5 );
+  expect_same_text(
+    []( std::ostream& s ) -> std::ostream& { return s << std::setprecision( 0 ); },
+    2.0 / 3.0, 25.0 );
+}
+
+// ----------------------------------------------------------------------------
+TEST(format_buffer, text)
+{
+  std::ostringstream out;
+  {
+    format_buffer buffer{ out, 8 };
+    buffer << "some text" << ' ' << std::string( 100, 'x' ) << '\n';
+    buffer.flush();
+    EXPECT_EQ( "some text " + std::string( 100, 'x' ) + "\n", out.str() );
+    buffer << "more";
+  }
+  EXPECT_EQ( "some text " + std::string( 100, 'x' ) + "\nmore", out.str() );
+}
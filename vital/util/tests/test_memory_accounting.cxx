@@ -0,0 +1,153 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test accounting of the memory held by vital types
+
+#include <vital/util/memory_accounting.h>
+
+#include <vital/types/descriptor.h>
+#include <vital/types/feature_track_set.h>
+#include <vital/types/image.h>
+#include <vital/types/metadata.h>
+#include <vital/types/object_track_set.h>
+
+#include <kwiversys/SystemTools.hxx>
+
+#include <gtest/gtest.h>
+
+using namespace kwiver::vital;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  // Accounting is decided on the first report, so must be enabled first
+  kwiversys::SystemTools::PutEnv( "KWIVER_MEMORY_ACCOUNTING=1" );
+
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Change in the usage of a category since construction
+class usage_delta
+{
+public:
+  explicit usage_delta( memory_category category )
+    : m_category( category ),
+      m_start( memory_accounting::usage( category ) )
+  {}
+
+  int64_t bytes() const
+  {
+    return memory_accounting::usage( m_category ).live_bytes -
+           m_start.live_bytes;
+  }
+
+  int64_t count() const
+  {
+    return memory_accounting::usage( m_category ).live_count -
+           m_start.live_count;
+  }
+
+private:
+  memory_category m_category;
+  memory_usage m_start;
+};
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+TEST(memory_accounting, enabled)
+{
+  EXPECT_TRUE( memory_accounting::enabled() );
+  EXPECT_STREQ( "image", memory_accounting::name( memory_category::image ) );
+  EXPECT_STREQ( "track_state",
+                memory_accounting::name( memory_category::track_state ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(memory_accounting, image)
+{
+  usage_delta const delta{ memory_category::image };
+  auto const peak = memory_accounting::usage( memory_category::image );
+  {
+    image_of< uint8_t > a{ 100, 50, 3 };
+    EXPECT_EQ( 15000, delta.bytes() );
+    EXPECT_EQ( 1, delta.count() );
+
+    image b;
+    b.copy_from( a );
+    EXPECT_EQ( 30000, delta.bytes() );
+    EXPECT_EQ( 2, delta.count() );
+
+    // Images sharing memory are accounted once
+    image c = a;
+    EXPECT_EQ( 30000, delta.bytes() );
+
+    image_memory m{ 10 };
+    m = *a.memory();
+    EXPECT_EQ( 45000, delta.bytes() );
+    EXPECT_EQ( 3, delta.count() );
+  }
+  EXPECT_EQ( 0, delta.bytes() );
+  EXPECT_EQ( 0, delta.count() );
+  EXPECT_LE( peak.peak_bytes + 45000,
+             memory_accounting::usage( memory_category::image ).peak_bytes );
+}
+
+// ----------------------------------------------------------------------------
+TEST(memory_accounting, descriptor)
+{
+  usage_delta const delta{ memory_category::descriptor };
+  {
+    descriptor_dynamic< float > d{ 128 };
+    auto const e = d.clone();
+    descriptor_fixed< uint8_t, 32 > f;
+    EXPECT_EQ( 3, delta.count() );
+    EXPECT_EQ( 2 * ( sizeof( d ) + 128 * sizeof( float ) ) + sizeof( f ),
+               static_cast< size_t >( delta.bytes() ) );
+  }
+  EXPECT_EQ( 0, delta.bytes() );
+  EXPECT_EQ( 0, delta.count() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(memory_accounting, track_state)
+{
+  usage_delta const delta{ memory_category::track_state };
+  {
+    track_state t{ 1 };
+    feature_track_state f{ 2 };
+    auto const g = f.clone();
+    object_track_state o;
+    EXPECT_EQ( 4, delta.count() );
+    EXPECT_EQ( sizeof( t ) + 2 * sizeof( f ) + sizeof( o ),
+               static_cast< size_t >( delta.bytes() ) );
+  }
+  EXPECT_EQ( 0, delta.bytes() );
+  EXPECT_EQ( 0, delta.count() );
+}
+
+// ----------------------------------------------------------------------------
+TEST(memory_accounting, metadata)
+{
+  usage_delta const delta{ memory_category::metadata };
+  {
+    metadata md;
+    md.add< VITAL_META_UNIX_TIMESTAMP >( 1 );
+    md.add< VITAL_META_MISSION_ID >( "mission" );
+    EXPECT_EQ( 2, delta.count() );
+
+    // Copies share their items
+    metadata const copy{ md };
+    EXPECT_EQ( 2, delta.count() );
+    EXPECT_EQ( 2 * sizeof( metadata_item ),
+               static_cast< size_t >( delta.bytes() ) );
+  }
+  EXPECT_EQ( 0, delta.bytes() );
+  EXPECT_EQ( 0, delta.count() );
+}
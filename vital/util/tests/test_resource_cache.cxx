@@ -0,0 +1,121 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test the shared resource cache
+
+#include <vital/util/resource_cache.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace kwiver::vital;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+struct model
+{
+  explicit model( int v ) : value{ v } {}
+  int value;
+};
+
+}
+
+// ----------------------------------------------------------------------------
+TEST(resource_cache, shared_while_held)
+{
+  auto& cache = resource_cache::instance();
+  int loads = 0;
+  auto const load = [ & ]{ ++loads; return std::make_shared< model >( 7 ); };
+
+  auto a = cache.get< model >( "shared", load );
+  auto b = cache.get< model >( "shared", load );
+  ASSERT_TRUE( a );
+  EXPECT_EQ( a, b );
+  EXPECT_EQ( 7, a->value );
+  EXPECT_EQ( 1, loads );
+  EXPECT_EQ( 1, cache.size() );
+
+  // Other keys and other types are separate resources
+  auto c = cache.get< model >( "other", load );
+  auto d = cache.get< int >( "shared",
+                             []{ return std::make_shared< int >( 3 ); } );
+  EXPECT_NE( a, c );
+  EXPECT_EQ( 3, *d );
+  EXPECT_EQ( 2, loads );
+  EXPECT_EQ( 3, cache.size() );
+
+  // Once released the resource is freed and loaded again when next asked for
+  a.reset();
+  b.reset();
+  c.reset();
+  d.reset();
+  EXPECT_EQ( 0, cache.size() );
+
+  auto e = cache.get< model >( "shared", load );
+  EXPECT_EQ( 3, loads );
+}
+
+// ----------------------------------------------------------------------------
+TEST(resource_cache, failed_load)
+{
+  auto& cache = resource_cache::instance();
+
+  EXPECT_THROW(
+    cache.get< model >( "failed",
+                        []() -> std::shared_ptr< model > {
+                          throw std::runtime_error( "no model" );
+                        } ),
+    std::runtime_error );
+
+  EXPECT_EQ( nullptr,
+             cache.get< model >( "failed",
+                                 []{ return std::shared_ptr< model >(); } ) );
+
+  auto m = cache.get< model >( "failed",
+                               []{ return std::make_shared< model >( 1 ); } );
+  ASSERT_TRUE( m );
+  EXPECT_EQ( 1, m->value );
+}
+
+// ----------------------------------------------------------------------------
+TEST(resource_cache, concurrent_load)
+{
+  auto& cache = resource_cache::instance();
+  std::atomic< int > loads{ 0 };
+
+  std::vector< std::shared_ptr< model const > > models( 8 );
+  std::vector< std::thread > threads;
+  for( size_t i = 0; i < models.size(); ++i )
+  {
+    threads.emplace_back( [ &, i ]{
+      models[ i ] = cache.get< model >( "concurrent", [ & ]{
+        ++loads;
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        return std::make_shared< model >( 5 );
+      } );
+    } );
+  }
+  for( auto& t : threads )
+  {
+    t.join();
+  }
+
+  EXPECT_EQ( 1, loads );
+  for( auto const& m : models )
+  {
+    EXPECT_EQ( models[ 0 ], m );
+  }
+}
@@ -0,0 +1,223 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test util text_lines functions
+
+#include <vital/util/text_lines.h>
+
+#include <vital/util/data_stream_reader.h>
+#include <vital/util/tokenize.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+using namespace kwiver::vital;
+
+namespace {
+
+// ----------------------------------------------------------------------------
+text_span
+make_span( std::string const& s )
+{
+  return { s.data(), s.data() + s.size() };
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+// ----------------------------------------------------------------------------
+TEST(text_lines, data_lines)
+{
+  // Lines must match those of data_stream_reader
+  std::string const text =
+    "first line\n"
+    "second line \t\r\n"
+    "  \n"
+    "# comment\n"
+    "\n"
+    "foo bar # trailing comment\n"
+    "last";
+
+  std::stringstream str{ text };
+  data_stream_reader dsr{ str };
+
+  auto pos = text.data();
+  auto const end = text.data() + text.size();
+  text_span line;
+  std::string expected;
+  while( dsr.getline( expected ) )
+  {
+    ASSERT_TRUE( next_data_line( pos, end, line ) );
+    EXPECT_EQ( expected, line.str() );
+    EXPECT_EQ( dsr.line_number(), line_number( text.data(), line.begin ) );
+  }
+  EXPECT_FALSE( next_data_line( pos, end, line ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(text_lines, split_line_chunks)
+{
+  std::string text;
+  for( int i = 0; i < 1000; ++i )
+  {
+    text += std::to_string( i ) + "\n";
+  }
+  auto const begin = text.data();
+  auto const end = text.data() + text.size();
+
+  for( size_t const count : { 1, 2, 7, 64, 5000 } )
+  {
+    SCOPED_TRACE( count );
+
+    auto const chunks = split_line_chunks( begin, end, count );
+    ASSERT_GE( chunks.size(), 2 );
+    EXPECT_LE( chunks.size(), count + 1 );
+    EXPECT_EQ( begin, chunks.front() );
+    EXPECT_EQ( end, chunks.back() );
+    for( size_t i = 1; i < chunks.size(); ++i )
+    {
+      EXPECT_LT( chunks[ i - 1 ], chunks[ i ] );
+      if( i + 1 < chunks.size() )
+      {
+        EXPECT_EQ( '\n', chunks[ i ][ -1 ] );
+      }
+    }
+  }
+
+  auto const empty = split_line_chunks( begin, begin, 4 );
+  EXPECT_EQ( ( std::vector< char const* >{ begin, begin } ), empty );
+}
+
+// ----------------------------------------------------------------------------
+TEST(text_lines, tokenize_span)
+{
+  for( std::string const line : { "a  b c", " a,b,,c ", "", "abc", ",," } )
+  {
+    for( bool const trim : { false, true } )
+    {
+      SCOPED_TRACE( "\"" + line + "\"" );
+
+      std::vector< std::string > expected;
+      tokenize( line, expected, " ,", trim );
+
+      std::vector< text_span > tokens;
+      tokenize_span( make_span( line ), tokens, " ,", trim );
+
+      ASSERT_EQ( expected.size(), tokens.size() );
+      for( size_t i = 0; i < tokens.size(); ++i )
+      {
+        EXPECT_EQ( expected[ i ], tokens[ i ].str() );
+      }
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(text_lines, span_to_double)
+{
+  for( std::string const token :
+       { "0", "-0", "1", "+2.5", "-17.125", "0.1", "123456.789", ".5",
+         "5.", "1e3", "1.5E-7", "-2e+22", "1e23", "12345678901234567890",
+         "0.000000000000000000000001", "9007199254740993", "1e", "1.5x",
+         "x", "", "inf", "-nan", "0x1p3", " 42", "1e99999" } )
+  {
+    SCOPED_TRACE( "\"" + token + "\"" );
+
+    double const expected = std::atof( token.c_str() );
+    double const actual = span_to_double( make_span( token ) );
+    if( std::isnan( expected ) )
+    {
+      EXPECT_TRUE( std::isnan( actual ) );
+    }
+    else
+    {
+      EXPECT_EQ( expected, actual );
+      EXPECT_EQ( std::signbit( expected ), std::signbit( actual ) );
+    }
+  }
+
+  // Printed doubles must read back exactly
+  std::mt19937 rng( 1 );
+  std::uniform_real_distribution< double > value( -1e6, 1e6 );
+  for( int i = 0; i < 10000; ++i )
+  {
+    std::ostringstream str;
+    str.precision( 1 + i % 17 );
+    str << value( rng );
+    auto const token = str.str();
+    ASSERT_EQ( std::atof( token.c_str() ), span_to_double( make_span( token ) ) )
+      << token;
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(text_lines, span_to_integer)
+{
+  for( std::string const token :
+       { "0", "-12", "+7", "12.9", "42abc", "", "x", " 5",
+         "123456789012345678901" } )
+  {
+    SCOPED_TRACE( "\"" + token + "\"" );
+    EXPECT_EQ( std::atoll( token.c_str() ),
+               span_to_integer( make_span( token ) ) );
+  }
+}
+
+// ----------------------------------------------------------------------------
+TEST(text_lines, parse_data_lines)
+{
+  // Enough text to be split into several chunks
+  std::string text;
+  int const count = 400000;
+  for( int i = 0; i < count; ++i )
+  {
+    text += std::to_string( i ) + ( i % 5 ? " # number\n" : "\n\n" );
+  }
+  auto const begin = text.data();
+  auto const end = text.data() + text.size();
+  ASSERT_GT( split_line_chunks( begin, end, 4 ).size(), 2 );
+
+  auto const values = parse_data_lines< long long >(
+    begin, end,
+    []( text_span const& line, std::vector< long long >& out )
+    {
+      out.push_back( span_to_integer( line ) );
+    } );
+  ASSERT_EQ( count, values.size() );
+  for( int i = 0; i < count; ++i )
+  {
+    ASSERT_EQ( i, values[ i ] );
+  }
+
+  // The first failing line in the text is the one reported
+  try
+  {
+    parse_data_lines< int >(
+      begin, end,
+      []( text_span const& line, std::vector< int >& )
+      {
+        if( span_to_integer( line ) % 100000 == 99999 )
+        {
+          throw std::runtime_error( line.str() );
+        }
+      } );
+    FAIL() << "Expected an exception";
+  }
+  catch( std::runtime_error const& e )
+  {
+    EXPECT_EQ( std::string( "99999" ), e.what() );
+  }
+}
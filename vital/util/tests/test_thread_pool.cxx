@@ -9,6 +9,14 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 using namespace kwiver::vital;
@@ -61,6 +69,190 @@ TEST_P(thread_pool_backend, run_jobs)
   }
 }
 
+// ----------------------------------------------------------------------------
+TEST_P(thread_pool_backend, parallel_for)
+{
+  thread_pool::instance().set_backend( GetParam() );
+
+  std::vector<unsigned> counts( 1000, 0 );
+  auto func = [&counts]( size_t begin, size_t end )
+  {
+    for ( auto i = begin; i < end; ++i )
+    {
+      ++counts[i];
+    }
+  };
+  thread_pool::instance().parallel_for( counts.size(), 7, func );
+  EXPECT_EQ( std::vector<unsigned>( 1000, 1 ), counts );
+
+  // nested calls from every worker thread must not deadlock
+  std::vector<std::future<void> > futures;
+  std::vector<std::vector<unsigned> > nested_counts(
+    thread_pool::instance().num_threads() * 2,
+    std::vector<unsigned>( 100, 0 ) );
+  for ( auto& nc : nested_counts )
+  {
+    futures.push_back( thread_pool::instance().enqueue( [&nc]()
+    {
+      thread_pool::instance().parallel_for( nc.size(), 3,
+        [&nc]( size_t begin, size_t end )
+        {
+          for ( auto i = begin; i < end; ++i )
+          {
+            ++nc[i];
+          }
+        } );
+    } ) );
+  }
+  for ( auto& f : futures )
+  {
+    f.get();
+  }
+  for ( auto const& nc : nested_counts )
+  {
+    EXPECT_EQ( std::vector<unsigned>( 100, 1 ), nc );
+  }
+
+  // an empty range calls nothing
+  thread_pool::instance().parallel_for( 0, 7, func );
+}
+
+// ----------------------------------------------------------------------------
+TEST_P(thread_pool_backend, parallel_reduce)
+{
+  thread_pool::instance().set_backend( GetParam() );
+
+  auto sum = []( size_t begin, size_t end )
+  {
+    unsigned long long s = 0;
+    for ( auto i = begin; i < end; ++i )
+    {
+      s += i;
+    }
+    return s;
+  };
+  auto add = []( unsigned long long a, unsigned long long b )
+  {
+    return a + b;
+  };
+  EXPECT_EQ( 4999950000ull,
+             thread_pool::instance().parallel_reduce(
+               100000, 7, 0ull, sum, add ) );
+
+  // partial results are folded in chunk order
+  auto concat = []( std::vector<size_t> a, std::vector<size_t> b )
+  {
+    a.insert( a.end(), b.begin(), b.end() );
+    return a;
+  };
+  auto firsts = thread_pool::instance().parallel_reduce(
+    20, 3, std::vector<size_t>{},
+    []( size_t begin, size_t ) { return std::vector<size_t>{ begin }; },
+    concat );
+  EXPECT_EQ( ( std::vector<size_t>{ 0, 3, 6, 9, 12, 15, 18 } ), firsts );
+
+  // an empty range gives the initial value
+  EXPECT_EQ( 5ull,
+             thread_pool::instance().parallel_reduce( 0, 7, 5ull, sum, add ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST_P(thread_pool_backend, parallel_sort)
+{
+  thread_pool::instance().set_backend( GetParam() );
+
+  std::mt19937 rng( 42 );
+  std::vector<int> values( 10007 );
+  for ( auto& v : values )
+  {
+    v = static_cast<int>( rng() % 1000 );
+  }
+  auto expected = values;
+  std::sort( expected.begin(), expected.end() );
+
+  auto sorted = values;
+  thread_pool::instance().parallel_sort( sorted.begin(), sorted.end() );
+  EXPECT_EQ( expected, sorted );
+
+  sorted = values;
+  thread_pool::instance().parallel_sort( sorted.begin(), sorted.end(),
+                                         std::greater<int>(), 100 );
+  EXPECT_EQ( std::vector<int>( expected.rbegin(), expected.rend() ), sorted );
+}
+
+// ----------------------------------------------------------------------------
+TEST_P(thread_pool_backend, parallel_exceptions)
+{
+  thread_pool::instance().set_backend( GetParam() );
+
+  // an exception from any chunk, including one run by the calling thread,
+  // is rethrown only once no chunk is still running
+  for ( size_t const bad_chunk : { size_t{ 0 }, size_t{ 50 }, size_t{ 99 } } )
+  {
+    SCOPED_TRACE( "Throwing in chunk " + std::to_string( bad_chunk ) );
+
+    std::atomic<int> running{ 0 };
+    std::atomic<size_t> started{ 0 };
+    auto func = [&]( size_t begin, size_t )
+    {
+      ++running;
+      ++started;
+      std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+      --running;
+      if ( begin == bad_chunk )
+      {
+        throw std::runtime_error( "chunk failed" );
+      }
+    };
+    EXPECT_THROW( thread_pool::instance().parallel_for( 100, 1, func ),
+                  std::runtime_error );
+    EXPECT_EQ( 0, running );
+
+    // no chunk starts after the call returns
+    auto const started_at_return = started.load();
+    std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    EXPECT_EQ( started_at_return, started );
+  }
+
+  auto throw_from_reduce = []( size_t begin, size_t ) -> int
+  {
+    if ( begin == 21 )
+    {
+      throw std::out_of_range( "chunk failed" );
+    }
+    return 1;
+  };
+  EXPECT_THROW( thread_pool::instance().parallel_reduce(
+                  100, 7, 0, throw_from_reduce, std::plus<int>() ),
+                std::out_of_range );
+
+  std::vector<int> values( 1000 );
+  std::iota( values.begin(), values.end(), 0 );
+  auto throwing_less = []( int a, int b )
+  {
+    if ( a == 500 || b == 500 )
+    {
+      throw std::logic_error( "bad comparison" );
+    }
+    return a < b;
+  };
+  EXPECT_THROW( thread_pool::instance().parallel_sort(
+                  values.begin(), values.end(), throwing_less, 10 ),
+                std::logic_error );
+
+  // the pool is still usable afterwards
+  std::vector<unsigned> counts( 100, 0 );
+  thread_pool::instance().parallel_for( counts.size(), 3,
+    [&counts]( size_t begin, size_t end )
+    {
+      for ( auto i = begin; i < end; ++i )
+      {
+        ++counts[i];
+      }
+    } );
+  EXPECT_EQ( std::vector<unsigned>( 100, 1 ), counts );
+}
+
 // ----------------------------------------------------------------------------
 INSTANTIATE_TEST_CASE_P(
   ,
@@ -0,0 +1,95 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief test util scoped tracing
+
+#include <vital/util/trace.h>
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace kwiver::vital;
+
+// ----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  ::testing::InitGoogleTest( &argc, argv );
+  return RUN_ALL_TESTS();
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+size_t
+count( std::string const& text, std::string const& what )
+{
+  size_t n = 0;
+  for ( auto pos = text.find( what ); pos != std::string::npos;
+        pos = text.find( what, pos + what.size() ) )
+  {
+    ++n;
+  }
+  return n;
+}
+
+// ----------------------------------------------------------------------------
+std::string
+trace_text()
+{
+  std::ostringstream out;
+  write_trace( out );
+  return out.str();
+}
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+TEST(trace, disabled)
+{
+  set_trace_enabled( false );
+  clear_trace();
+
+  {
+    KWIVER_TRACE_SCOPE( "not recorded" );
+  }
+
+  EXPECT_EQ( 0, count( trace_text(), "not recorded" ) );
+}
+
+// ----------------------------------------------------------------------------
+TEST(trace, scopes)
+{
+  set_trace_enabled( true );
+  clear_trace();
+
+  {
+    KWIVER_TRACE_SCOPE( "outer" );
+    for ( int i = 0; i < 3; ++i )
+    {
+      KWIVER_TRACE_SCOPE( "inner \"quoted\"" );
+    }
+  }
+
+  std::thread worker( [] { KWIVER_TRACE_SCOPE( "worker" ); } );
+  worker.join();
+
+  set_trace_enabled( false );
+
+  auto const text = trace_text();
+  EXPECT_EQ( 0, text.find( "{\"traceEvents\":[" ) );
+  EXPECT_EQ( 1, count( text, "\"name\":\"outer\"" ) );
+  EXPECT_EQ( 3, count( text, "\"name\":\"inner \\\"quoted\\\"\"" ) );
+  EXPECT_EQ( 1, count( text, "\"name\":\"worker\"" ) );
+  EXPECT_EQ( 5, count( text, "\"ph\":\"X\"" ) );
+
+  // One name record for each of the two threads
+  EXPECT_EQ( 2, count( text, "\"ph\":\"M\"" ) );
+
+  clear_trace();
+  EXPECT_EQ( 0, count( trace_text(), "\"ph\":\"X\"" ) );
+}
@@ -0,0 +1,264 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "text_lines.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace kwiver {
+namespace vital {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// White space as removed by right_trim()
+bool
+is_blank( char c )
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+         c == '\f' || c == '\v';
+}
+
+// ----------------------------------------------------------------------------
+bool
+is_digit( char c )
+{
+  return c >= '0' && c <= '9';
+}
+
+// ----------------------------------------------------------------------------
+// Skip the leading white space std::atof skips
+char const*
+skip_space( char const* p, char const* end )
+{
+  while( p < end && is_blank( *p ) )
+  {
+    ++p;
+  }
+  return p;
+}
+
+// Mantissas up to this size convert to double exactly
+constexpr uint64_t max_exact_mantissa = uint64_t{ 1 } << 53;
+
+// Powers of ten which double represents exactly
+constexpr double exact_powers[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+constexpr int max_exact_power = 22;
+
+} // end namespace
+
+// ----------------------------------------------------------------------------
+std::vector< char const* >
+split_line_chunks( char const* begin, char const* end, size_t count )
+{
+  std::vector< char const* > result{ begin };
+  auto const size = static_cast< size_t >( end - begin );
+  count = std::max< size_t >( count, 1 );
+
+  for( size_t i = 1; i < count; ++i )
+  {
+    auto const target = begin + size / count * i;
+    if( target < result.back() )
+    {
+      continue;
+    }
+
+    auto const eol = static_cast< char const* >(
+      std::memchr( target, '\n', static_cast< size_t >( end - target ) ) );
+    if( !eol || eol + 1 >= end )
+    {
+      break;
+    }
+    if( eol + 1 > result.back() )
+    {
+      result.push_back( eol + 1 );
+    }
+  }
+
+  if( end > result.back() || result.size() == 1 )
+  {
+    result.push_back( end );
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------------
+bool
+next_data_line( char const*& pos, char const* end, text_span& line )
+{
+  while( pos < end )
+  {
+    auto const eol = static_cast< char const* >(
+      std::memchr( pos, '\n', static_cast< size_t >( end - pos ) ) );
+    auto const line_end = ( eol ? eol : end );
+
+    line.begin = pos;
+    line.end = static_cast< char const* >(
+      std::memchr( pos, '#', static_cast< size_t >( line_end - pos ) ) );
+    if( !line.end )
+    {
+      line.end = line_end;
+    }
+    while( line.end > line.begin && is_blank( line.end[ -1 ] ) )
+    {
+      --line.end;
+    }
+
+    pos = ( eol ? eol + 1 : end );
+    if( !line.empty() )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+// ----------------------------------------------------------------------------
+size_t
+line_number( char const* begin, char const* pos )
+{
+  return 1 + static_cast< size_t >( std::count( begin, pos, '\n' ) );
+}
+
+// ----------------------------------------------------------------------------
+void
+tokenize_span( text_span const& line, std::vector< text_span >& tokens,
+               std::string const& delimiters, bool trim_empty )
+{
+  bool is_delimiter[ 256 ] = {};
+  for( auto const c : delimiters )
+  {
+    is_delimiter[ static_cast< unsigned char >( c ) ] = true;
+  }
+
+  auto first = line.begin;
+  for( auto p = line.begin; ; ++p )
+  {
+    if( p == line.end || is_delimiter[ static_cast< unsigned char >( *p ) ] )
+    {
+      if( p != first || !trim_empty )
+      {
+        tokens.push_back( { first, p } );
+      }
+      if( p == line.end )
+      {
+        break;
+      }
+      first = p + 1;
+    }
+  }
+}
+
+// ----------------------------------------------------------------------------
+double
+span_to_double( text_span const& token )
+{
+  // Parse [sign]digits[.digits][e[sign]digits] filling the whole token
+  auto p = skip_space( token.begin, token.end );
+  bool const negative = ( p < token.end && *p == '-' );
+  if( p < token.end && ( *p == '-' || *p == '+' ) )
+  {
+    ++p;
+  }
+
+  uint64_t mantissa = 0;
+  int digits = 0;
+  int exponent = 0;
+  bool any_digits = false;
+  for( ; p < token.end && is_digit( *p ); ++p, any_digits = true )
+  {
+    if( mantissa || *p != '0' )
+    {
+      mantissa = mantissa * 10 + static_cast< uint64_t >( *p - '0' );
+      ++digits;
+    }
+  }
+  if( p < token.end && *p == '.' )
+  {
+    for( ++p; p < token.end && is_digit( *p ); ++p, any_digits = true )
+    {
+      if( mantissa || *p != '0' )
+      {
+        mantissa = mantissa * 10 + static_cast< uint64_t >( *p - '0' );
+        ++digits;
+      }
+      --exponent;
+    }
+  }
+  if( any_digits && p < token.end && ( *p == 'e' || *p == 'E' ) )
+  {
+    ++p;
+    bool const negative_exponent = ( p < token.end && *p == '-' );
+    if( p < token.end && ( *p == '-' || *p == '+' ) )
+    {
+      ++p;
+    }
+    int value = 0;
+    bool any_exponent_digits = false;
+    for( ; p < token.end && is_digit( *p ) && value < 10000; ++p )
+    {
+      value = value * 10 + ( *p - '0' );
+      any_exponent_digits = true;
+    }
+    if( !any_exponent_digits )
+    {
+      p = token.begin; // leave it to strtod
+    }
+    exponent += ( negative_exponent ? -value : value );
+  }
+
+  // A product or quotient of two exact values is correctly rounded
+  if( any_digits && p == token.end && digits <= 19 &&
+      mantissa <= max_exact_mantissa &&
+      ( mantissa == 0 ||
+        ( exponent >= -max_exact_power && exponent <= max_exact_power ) ) )
+  {
+    auto value = static_cast< double >( mantissa );
+    if( exponent < 0 )
+    {
+      value /= exact_powers[ -exponent ];
+    }
+    else
+    {
+      value *= exact_powers[ exponent ];
+    }
+    return ( negative ? -value : value );
+  }
+
+  return std::atof( token.str().c_str() );
+}
+
+// ----------------------------------------------------------------------------
+long long
+span_to_integer( text_span const& token )
+{
+  auto p = skip_space( token.begin, token.end );
+  bool const negative = ( p < token.end && *p == '-' );
+  if( p < token.end && ( *p == '-' || *p == '+' ) )
+  {
+    ++p;
+  }
+
+  // Values of up to 18 digits cannot overflow
+  long long value = 0;
+  int digits = 0;
+  for( ; p < token.end && is_digit( *p ); ++p, ++digits )
+  {
+    value = value * 10 + ( *p - '0' );
+  }
+  if( digits > 18 )
+  {
+    return std::atoll( token.str().c_str() );
+  }
+  return ( negative ? -value : value );
+}
+
+} // ...vital
+} // ...kwiver
@@ -0,0 +1,150 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Parsing of lines of text held in memory
+
+#ifndef KWIVER_VITAL_UTIL_TEXT_LINES_H
+#define KWIVER_VITAL_UTIL_TEXT_LINES_H
+
+#include <vital/util/vital_util_export.h>
+
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace kwiver {
+namespace vital {
+
+/// A range of characters within a text buffer
+struct text_span
+{
+  char const* begin;
+  char const* end;
+
+  size_t size() const { return static_cast< size_t >( end - begin ); }
+  bool empty() const { return begin == end; }
+  std::string str() const { return std::string( begin, end ); }
+};
+
+/// Split a text buffer into about \p count chunks of whole lines
+///
+/// Chunks are meant to be parsed independently, for instance within
+/// thread_pool::parallel_for.  Each boundary but the first is just past a
+/// newline.
+///
+/// \returns \p count + 1 boundaries, or fewer if the text has few lines.
+///          Chunk i runs from element i to element i + 1.
+VITAL_UTIL_EXPORT std::vector< char const* >
+split_line_chunks( char const* begin, char const* end, size_t count );
+
+/// Find the next data line of a text buffer
+///
+/// Lines are edited as data_stream_reader edits them: shell comments and
+/// trailing white space are removed, and lines left blank are skipped.
+///
+/// \param[in,out] pos Position to search from, moved past the line found
+/// \param end End of the text
+/// \param[out] line The edited line
+///
+/// \returns false if there are no more data lines.
+VITAL_UTIL_EXPORT bool
+next_data_line( char const*& pos, char const* end, text_span& line );
+
+/// One-based number of the line holding \p pos of the text at \p begin
+VITAL_UTIL_EXPORT size_t
+line_number( char const* begin, char const* pos );
+
+/// Split a line into tokens at any of \p delimiters
+///
+/// This behaves as tokenize() does, without copying the tokens.
+VITAL_UTIL_EXPORT void
+tokenize_span( text_span const& line, std::vector< text_span >& tokens,
+               std::string const& delimiters, bool trim_empty );
+
+/// Value of a token, as read by std::atof
+///
+/// Plain decimal numbers are converted without copying the token, giving
+/// the same correctly rounded value as the standard library.
+VITAL_UTIL_EXPORT double
+span_to_double( text_span const& token );
+
+/// Value of a token, as read by std::atoll
+VITAL_UTIL_EXPORT long long
+span_to_integer( text_span const& token );
+
+/// Parse the data lines of a text buffer in parallel
+///
+/// The text is split into chunks of lines which are parsed on the vital
+/// thread pool.  \p parse is called as parse( line, records ) for each data
+/// line, in order within its chunk, and appends what it reads to records.
+/// If parsing throws, the exception of the earliest chunk is rethrown.
+///
+/// \returns the records of all chunks, in the order of the text.
+template < typename Record, typename F >
+std::vector< Record >
+parse_data_lines( char const* begin, char const* end, F const& parse )
+{
+  // Chunks of about a megabyte are enough to keep every thread busy
+  auto const size = static_cast< size_t >( end - begin );
+  auto const threads = thread_pool::instance().num_threads();
+  auto const count =
+    std::max< size_t >( 1, std::min( threads * 4, size >> 20 ) );
+  auto const chunks = split_line_chunks( begin, end, count );
+
+  std::vector< std::vector< Record > > records( chunks.size() - 1 );
+  std::vector< std::exception_ptr > errors( records.size() );
+  thread_pool::instance().parallel_for(
+    records.size(), 1,
+    [ & ]( size_t first, size_t last )
+    {
+      for( auto i = first; i < last; ++i )
+      {
+        try
+        {
+          auto pos = chunks[ i ];
+          text_span line;
+          while( next_data_line( pos, chunks[ i + 1 ], line ) )
+          {
+            parse( line, records[ i ] );
+          }
+        }
+        catch( ... )
+        {
+          errors[ i ] = std::current_exception();
+        }
+      }
+    } );
+
+  for( auto const& error : errors )
+  {
+    if( error )
+    {
+      std::rethrow_exception( error );
+    }
+  }
+
+  std::vector< Record > result;
+  if( !records.empty() )
+  {
+    result = std::move( records.front() );
+  }
+  for( size_t i = 1; i < records.size(); ++i )
+  {
+    result.insert( result.end(),
+                   std::make_move_iterator( records[ i ].begin() ),
+                   std::make_move_iterator( records[ i ].end() ) );
+  }
+  return result;
+}
+
+} // ...vital
+} // ...kwiver
+
+#endif
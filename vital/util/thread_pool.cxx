@@ -15,6 +15,7 @@
 #include <vital/util/thread_pool_builtin_backend.h>
 #include <vital/util/thread_pool_gcd_backend.h>
 #include <vital/util/thread_pool_sync_backend.h>
+#include <vital/util/thread_pool_work_stealing_backend.h>
 #include <vital/logger/logger.h>
 
 namespace kwiver {
@@ -74,6 +75,10 @@ thread_pool::available_backends()
     thread_pool_gcd_backend::static_name,
 #endif
     thread_pool_builtin_backend::static_name,
+    thread_pool_work_stealing_backend::static_name,
+#ifdef __linux__
+    thread_pool_pinned_work_stealing_backend::static_name,
+#endif
     thread_pool_sync_backend::static_name
   };
 
@@ -95,6 +100,10 @@ void thread_pool::set_backend(std::string const& backend_name)
   TRY_BACKEND( thread_pool_gcd_backend )
 #endif
   TRY_BACKEND( thread_pool_builtin_backend )
+  TRY_BACKEND( thread_pool_work_stealing_backend )
+#ifdef __linux__
+  TRY_BACKEND( thread_pool_pinned_work_stealing_backend )
+#endif
   TRY_BACKEND( thread_pool_sync_backend )
   // final "else" case
   {
@@ -16,9 +16,16 @@
 #include <vital/noncopyable.h>
 #include <vital/util/vital_util_export.h>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -80,6 +87,44 @@ class VITAL_UTIL_EXPORT thread_pool
   auto enqueue(F&& f, Args&&... args)
     -> std::future<typename std::result_of<F(Args...)>::type>;
 
+  /// Call \p f(begin, end) over consecutive chunks of [0, \p count)
+  ///
+  /// Chunks of up to \p chunk_size elements are divided among the worker
+  /// threads and the calling thread, and this blocks until all are done.
+  /// Since the calling thread takes chunks too and waits only for chunks
+  /// already in progress, this may be safely called from within a task,
+  /// even when every worker thread is busy.
+  ///
+  /// If \p f throws, no further chunks are started, and once the chunks
+  /// already running have finished, the first exception thrown is
+  /// rethrown on the calling thread.
+  template<class F>
+  void parallel_for(size_t count, size_t chunk_size, F const& f);
+
+  /// Combine \p f(begin, end) over consecutive chunks of [0, \p count)
+  ///
+  /// Each chunk of up to \p chunk_size elements is mapped to a partial
+  /// result by \p f as in parallel_for, and the partial results are then
+  /// folded, starting from \p init, with \p reduce(T, T) in chunk order.
+  /// The result therefore depends on \p chunk_size but not on the number
+  /// of threads or on the order in which chunks happen to run.
+  template<class T, class F, class R>
+  T parallel_reduce(size_t count, size_t chunk_size, T init,
+                    F const& f, R const& reduce);
+
+  /// Sort [\p first, \p last) with \p comp on the threads of the pool
+  ///
+  /// Chunks of up to \p chunk_size elements are sorted in parallel and
+  /// then merged pairwise, also in parallel.  Like std::sort, this is
+  /// not stable.
+  template<class RandomIt, class Compare>
+  void parallel_sort(RandomIt first, RandomIt last, Compare comp,
+                     size_t chunk_size=4096);
+
+  /// Sort [\p first, \p last) with operator< on the threads of the pool
+  template<class RandomIt>
+  void parallel_sort(RandomIt first, RandomIt last);
+
   /// A base class for thread pool backend implementations
   class VITAL_UTIL_EXPORT backend
     : private kwiver::vital::noncopyable
@@ -139,6 +184,154 @@ auto thread_pool::enqueue(F&& f, Args&&... args)
   return res;
 }
 
+/// Call a function over chunks of a range on the threads of the pool
+template<class F>
+void thread_pool::parallel_for(size_t count, size_t chunk_size, F const& f)
+{
+  struct state_t
+  {
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    size_t remaining;
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+
+  chunk_size = std::max<size_t>(chunk_size, 1);
+  const size_t chunks = (count + chunk_size - 1) / chunk_size;
+  auto state = std::make_shared<state_t>();
+  state->remaining = chunks;
+
+  // tasks which start after all chunks are taken only touch the shared
+  // state; once a chunk throws, the remaining chunks are taken but skipped
+  const F* fp = &f;
+  auto work = [state, fp, count, chunk_size, chunks]()
+  {
+    for (size_t c = state->next++; c < chunks; c = state->next++)
+    {
+      std::exception_ptr error;
+      if (!state->failed)
+      {
+        try
+        {
+          const size_t begin = c * chunk_size;
+          (*fp)(begin, std::min(count, begin + chunk_size));
+        }
+        catch (...)
+        {
+          error = std::current_exception();
+          state->failed = true;
+        }
+      }
+
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (error && !state->error)
+      {
+        state->error = error;
+      }
+      if (--state->remaining == 0)
+      {
+        state->done.notify_all();
+      }
+    }
+  };
+
+  const size_t helpers = chunks ? std::min(this->num_threads(), chunks - 1) : 0;
+  for (size_t i = 0; i < helpers; ++i)
+  {
+    this->enqueue_task(work);
+  }
+  work();
+
+  // wait for every chunk, even after a failure, since helpers may still be
+  // calling f, and only then report the first exception thrown
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&state]() { return state->remaining == 0; });
+  if (state->error)
+  {
+    std::rethrow_exception(state->error);
+  }
+}
+
+/// Reduce a function over chunks of a range on the threads of the pool
+template<class T, class F, class R>
+T thread_pool::parallel_reduce(size_t count, size_t chunk_size, T init,
+                               F const& f, R const& reduce)
+{
+  chunk_size = std::max<size_t>(chunk_size, 1);
+  const size_t chunks = (count + chunk_size - 1) / chunk_size;
+
+  // one slot per chunk, so no two chunks write the same element (a deque,
+  // since std::vector<bool> packs its elements into shared words)
+  std::deque<T> partials(chunks, init);
+  this->parallel_for(chunks, 1,
+    [&partials, &f, count, chunk_size](size_t first, size_t last)
+  {
+    for (size_t c = first; c < last; ++c)
+    {
+      const size_t begin = c * chunk_size;
+      partials[c] = f(begin, std::min(count, begin + chunk_size));
+    }
+  });
+
+  for (auto& p : partials)
+  {
+    init = reduce(std::move(init), std::move(p));
+  }
+  return init;
+}
+
+/// Sort a range on the threads of the pool
+template<class RandomIt, class Compare>
+void thread_pool::parallel_sort(RandomIt first, RandomIt last, Compare comp,
+                                size_t chunk_size)
+{
+  chunk_size = std::max<size_t>(chunk_size, 1);
+  const size_t count = static_cast<size_t>(last - first);
+  if (count <= chunk_size)
+  {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  const size_t chunks = (count + chunk_size - 1) / chunk_size;
+  this->parallel_for(chunks, 1,
+    [first, count, chunk_size, &comp](size_t begin, size_t end)
+  {
+    for (size_t c = begin; c < end; ++c)
+    {
+      std::sort(first + c * chunk_size,
+                first + std::min(count, (c + 1) * chunk_size), comp);
+    }
+  });
+
+  // merge runs of width elements into runs of twice that
+  for (size_t width = chunk_size; width < count; width *= 2)
+  {
+    const size_t pairs = (count + 2 * width - 1) / (2 * width);
+    this->parallel_for(pairs, 1,
+      [first, count, width, &comp](size_t begin, size_t end)
+    {
+      for (size_t p = begin; p < end; ++p)
+      {
+        const size_t lo = p * 2 * width;
+        const size_t mid = std::min(count, lo + width);
+        const size_t hi = std::min(count, lo + 2 * width);
+        std::inplace_merge(first + lo, first + mid, first + hi, comp);
+      }
+    });
+  }
+}
+
+/// Sort a range with operator< on the threads of the pool
+template<class RandomIt>
+void thread_pool::parallel_sort(RandomIt first, RandomIt last)
+{
+  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+  this->parallel_sort(first, last, std::less<value_type>());
+}
+
 } }   // end namespace
 
 #endif
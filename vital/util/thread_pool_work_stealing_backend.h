@@ -0,0 +1,374 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Implementation of a work-stealing thread pool backend
+///
+/// Each worker owns a deque of tasks.  Tasks enqueued from a worker go to
+/// the back of its own deque and it runs them newest first, so nested
+/// work (e.g. parallel_for inside a task) stays on a warm cache without
+/// touching any shared lock.  Tasks enqueued from other threads are dealt
+/// round-robin to the workers.  An idle worker steals the older half of
+/// another worker's deque in one go, so a burst of small tasks spreads
+/// out in a few steals rather than one lock round trip per task.
+
+#ifndef KWIVER_VITAL_THREAD_POOL_WORK_STEALING_BACKEND_H_
+#define KWIVER_VITAL_THREAD_POOL_WORK_STEALING_BACKEND_H_
+
+#include <vital/util/thread_pool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace kwiver {
+namespace vital {
+
+/// A thread pool backend with a task deque per worker and work stealing
+class thread_pool_work_stealing_backend
+  : public thread_pool::backend
+{
+public:
+  /// Constructor
+  ///
+  /// If \p pin is true, worker threads are pinned to the allowed CPUs
+  /// in NUMA node order (Linux only; otherwise ignored).
+  thread_pool_work_stealing_backend(
+    size_t num_threads=std::thread::hardware_concurrency(),
+    bool pin=false)
+    : pending(0), sleepers(0), next_queue(0), stop(false)
+  {
+    num_threads = std::max<size_t>(num_threads, 1);
+    if(pin)
+    {
+      cpus = cpus_by_numa_node();
+    }
+    for(size_t i=0; i<num_threads; ++i)
+    {
+      queues.emplace_back(new worker_queue);
+    }
+    for(size_t i=0; i<num_threads; ++i)
+    {
+      workers.emplace_back([this, i] { thread_worker_loop(i); });
+    }
+  }
+
+  /// Destructor
+  ~thread_pool_work_stealing_backend()
+  {
+    {
+      std::unique_lock<std::mutex> lock(sleep_mutex);
+      stop = true;
+    }
+    wake.notify_all();
+    for(std::thread &worker : workers)
+    {
+      worker.join();
+    }
+  }
+
+  /// The name of this backend
+  static constexpr const char* static_name = "Work-stealing";
+
+  /// Enqueue a void() task
+  void enqueue_task(std::function<void()> func);
+
+  /// Returns the number of worker threads
+  size_t num_threads() const { return workers.size(); }
+
+  /// Returns the name of this backend
+  virtual const char* name() const { return static_name; }
+
+protected:
+  /// The tasks owned by one worker
+  struct worker_queue
+  {
+    std::mutex mutex;
+    std::deque< std::function<void()> > tasks;
+  };
+
+  /// This function is executed in each thread to endlessly process tasks
+  void thread_worker_loop(size_t index);
+
+  /// Take the newest task from a worker's own deque
+  bool pop_local(size_t index, std::function<void()>& task);
+
+  /// Take the older half of another worker's deque
+  bool steal(size_t index, std::function<void()>& task);
+
+  /// Which pool, if any, the calling thread is a worker of, and its index
+  struct worker_slot
+  {
+    thread_pool_work_stealing_backend const* pool;
+    size_t index;
+  };
+  static worker_slot& this_thread_slot();
+
+  /// The CPUs this process may run on, grouped by NUMA node
+  static std::vector<int> cpus_by_numa_node();
+
+  /// One task deque per worker
+  std::vector< std::unique_ptr<worker_queue> > queues;
+
+  /// The collection of threads in the pool
+  std::vector<std::thread> workers;
+
+  /// CPUs to pin workers to; empty for no pinning
+  std::vector<int> cpus;
+
+  /// Number of tasks enqueued but not yet taken (briefly negative when a
+  /// task is taken before its enqueue is counted)
+  std::atomic<std::ptrdiff_t> pending;
+
+  /// Number of workers waiting for tasks
+  std::atomic<size_t> sleepers;
+
+  /// Next deque to deal a task from another thread to
+  std::atomic<size_t> next_queue;
+
+  /// Mutex and condition variable for idle workers to wait on
+  std::mutex sleep_mutex;
+  std::condition_variable wake;
+
+  /// Flag to indicate that the processing loop should terminate
+  std::atomic<bool> stop;
+};
+
+/// A work-stealing backend with workers pinned to CPUs by NUMA node
+class thread_pool_pinned_work_stealing_backend
+  : public thread_pool_work_stealing_backend
+{
+public:
+  /// Constructor
+  thread_pool_pinned_work_stealing_backend(
+    size_t num_threads=std::thread::hardware_concurrency())
+    : thread_pool_work_stealing_backend(num_threads, true)
+  {
+  }
+
+  /// The name of this backend
+  static constexpr const char* static_name = "Work-stealing (NUMA pinned)";
+
+  /// Returns the name of this backend
+  virtual const char* name() const { return static_name; }
+};
+
+/// Which pool, if any, the calling thread is a worker of, and its index
+inline thread_pool_work_stealing_backend::worker_slot&
+thread_pool_work_stealing_backend
+::this_thread_slot()
+{
+  static thread_local worker_slot slot = { nullptr, 0 };
+  return slot;
+}
+
+/// This function is executed in each thread to endlessly process tasks
+inline void
+thread_pool_work_stealing_backend
+::thread_worker_loop(size_t index)
+{
+#ifdef __linux__
+  // consecutive workers share a node, and steal from their neighbours first
+  if(!cpus.empty())
+  {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpus[index % cpus.size()], &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+  }
+#endif
+
+  this_thread_slot() = { this, index };
+
+  // loop forever
+  for(;;)
+  {
+    std::function<void()> task;
+    if(pop_local(index, task) || steal(index, task))
+    {
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(this->sleep_mutex);
+    ++this->sleepers;
+    this->wake.wait(lock,
+      [this]{ return this->stop || this->pending > 0; });
+    --this->sleepers;
+    if(this->stop && this->pending <= 0)
+      return;
+  }
+}
+
+/// Take the newest task from a worker's own deque
+inline bool
+thread_pool_work_stealing_backend
+::pop_local(size_t index, std::function<void()>& task)
+{
+  worker_queue& q = *queues[index];
+  std::lock_guard<std::mutex> lock(q.mutex);
+  if(q.tasks.empty())
+  {
+    return false;
+  }
+  task = std::move(q.tasks.back());
+  q.tasks.pop_back();
+  --pending;
+  return true;
+}
+
+/// Take the older half of another worker's deque
+inline bool
+thread_pool_work_stealing_backend
+::steal(size_t index, std::function<void()>& task)
+{
+  const size_t n = queues.size();
+  for(size_t k=1; k<n; ++k)
+  {
+    std::vector< std::function<void()> > batch;
+    {
+      worker_queue& victim = *queues[(index + k) % n];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      const size_t count = (victim.tasks.size() + 1) / 2;
+      for(size_t i=0; i<count; ++i)
+      {
+        batch.push_back(std::move(victim.tasks.front()));
+        victim.tasks.pop_front();
+      }
+    }
+    if(batch.empty())
+    {
+      continue;
+    }
+
+    // run the oldest now, keep the rest in their original order
+    task = std::move(batch.front());
+    --pending;
+    if(batch.size() > 1)
+    {
+      worker_queue& own = *queues[index];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      own.tasks.insert(own.tasks.begin(),
+                       std::make_move_iterator(batch.begin() + 1),
+                       std::make_move_iterator(batch.end()));
+    }
+    return true;
+  }
+  return false;
+}
+
+/// Enqueue a void function in the thread pool
+inline void
+thread_pool_work_stealing_backend
+::enqueue_task(std::function<void()> func)
+{
+  // don't allow enqueueing after stopping the pool
+  if(stop)
+  {
+    throw std::runtime_error("enqueue on stopped thread_pool");
+  }
+
+  // workers keep their own tasks; other threads deal them out
+  worker_slot const& slot = this_thread_slot();
+  const size_t index = slot.pool == this ? slot.index
+                                         : next_queue++ % queues.size();
+  {
+    worker_queue& q = *queues[index];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    q.tasks.push_back(std::move(func));
+  }
+
+  // only take the shared lock when a worker may be waiting on it
+  ++pending;
+  if(sleepers > 0)
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    wake.notify_one();
+  }
+}
+
+/// The CPUs this process may run on, grouped by NUMA node
+inline std::vector<int>
+thread_pool_work_stealing_backend
+::cpus_by_numa_node()
+{
+  std::vector<int> result;
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if(sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+  {
+    return result;
+  }
+
+  std::vector<bool> seen(CPU_SETSIZE, false);
+  auto add = [&](int cpu)
+  {
+    if(cpu >= 0 && cpu < CPU_SETSIZE && !seen[cpu] && CPU_ISSET(cpu, &allowed))
+    {
+      seen[cpu] = true;
+      result.push_back(cpu);
+    }
+  };
+
+  // each node lists its CPUs as ranges, e.g. "0-3,8-11"
+  for(int node=0; ; ++node)
+  {
+    std::ifstream ifs("/sys/devices/system/node/node" +
+                      std::to_string(node) + "/cpulist");
+    std::string list;
+    if(!std::getline(ifs, list))
+    {
+      break;
+    }
+
+    std::istringstream ranges(list);
+    std::string range;
+    while(std::getline(ranges, range, ','))
+    {
+      int first = 0, last = 0;
+      char dash = 0;
+      std::istringstream iss(range);
+      if(!(iss >> first))
+      {
+        continue;
+      }
+      last = (iss >> dash >> last) ? last : first;
+      for(int cpu=first; cpu<=last; ++cpu)
+      {
+        add(cpu);
+      }
+    }
+  }
+
+  // anything not listed under a node (or no NUMA information at all)
+  for(int cpu=0; cpu<CPU_SETSIZE; ++cpu)
+  {
+    add(cpu);
+  }
+#endif
+  return result;
+}
+
+} }   // end namespace
+
+#endif
@@ -0,0 +1,228 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+#include "trace.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace kwiver {
+namespace vital {
+
+namespace {
+
+// Most spans kept per thread; older ones are overwritten
+size_t const max_spans = 1 << 16;
+
+struct span
+{
+  char const* label;
+  trace_detail::clock::time_point start;
+  trace_detail::clock::time_point end;
+};
+
+// ----------------------------------------------------------------------------
+// Spans of one thread. Only that thread adds to it; the lock is there
+// for write_trace() and clear_trace(), so it is never contended for long.
+struct thread_trace
+{
+  explicit thread_trace( size_t id ) : id( id ), next( 0 ) {}
+
+  std::mutex mutex;
+  size_t const id;
+  std::vector< span > spans;
+  size_t next; // where the next span goes once spans is full
+};
+
+// ----------------------------------------------------------------------------
+// The traces of all threads that ever recorded a span. Never destroyed,
+// so scopes may still close during static destruction.
+struct registry
+{
+  std::mutex mutex;
+  std::vector< std::unique_ptr< thread_trace > > threads;
+
+  static registry& instance()
+  {
+    static registry* const reg = new registry;
+    return *reg;
+  }
+};
+
+// ----------------------------------------------------------------------------
+thread_trace&
+this_thread_trace()
+{
+  static thread_local thread_trace* trace = nullptr;
+  if ( !trace )
+  {
+    registry& reg = registry::instance();
+    std::lock_guard< std::mutex > lock( reg.mutex );
+    reg.threads.emplace_back( new thread_trace( reg.threads.size() + 1 ) );
+    trace = reg.threads.back().get();
+  }
+  return *trace;
+}
+
+// ----------------------------------------------------------------------------
+void
+write_json_string( std::ostream& stream, char const* s )
+{
+  stream << '"';
+  for ( ; *s; ++s )
+  {
+    unsigned char const c = static_cast< unsigned char >( *s );
+    if ( c == '"' || c == '\\' )
+    {
+      stream << '\\' << *s;
+    }
+    else if ( c < 0x20 )
+    {
+      static char const hex[] = "0123456789abcdef";
+      stream << "\\u00" << hex[ c >> 4 ] << hex[ c & 0xf ];
+    }
+    else
+    {
+      stream << *s;
+    }
+  }
+  stream << '"';
+}
+
+// ----------------------------------------------------------------------------
+// Turn tracing on at startup if KWIVER_TRACE is set
+struct enable_from_environment
+{
+  enable_from_environment()
+  {
+    char const* const value = std::getenv( "KWIVER_TRACE" );
+    if ( value && *value && std::string( value ) != "0" )
+    {
+      set_trace_enabled( true );
+    }
+  }
+} const enable_from_environment_instance;
+
+} // end namespace
+
+namespace trace_detail {
+
+std::atomic< bool > enabled( false );
+
+// ----------------------------------------------------------------------------
+void
+record( char const* label, clock::time_point start, clock::time_point end )
+{
+  thread_trace& trace = this_thread_trace();
+  std::lock_guard< std::mutex > lock( trace.mutex );
+
+  span const s = { label, start, end };
+  if ( trace.spans.size() < max_spans )
+  {
+    trace.spans.push_back( s );
+  }
+  else
+  {
+    trace.spans[ trace.next ] = s;
+    trace.next = ( trace.next + 1 ) % max_spans;
+  }
+}
+
+} // namespace trace_detail
+
+// ----------------------------------------------------------------------------
+void
+set_trace_enabled( bool enabled )
+{
+  trace_detail::enabled.store( enabled, std::memory_order_relaxed );
+}
+
+// ----------------------------------------------------------------------------
+void
+clear_trace()
+{
+  registry& reg = registry::instance();
+  std::lock_guard< std::mutex > reg_lock( reg.mutex );
+
+  for ( auto const& trace : reg.threads )
+  {
+    std::lock_guard< std::mutex > lock( trace->mutex );
+    trace->spans.clear();
+    trace->next = 0;
+  }
+}
+
+// ----------------------------------------------------------------------------
+void
+write_trace( std::ostream& stream )
+{
+  using namespace std::chrono;
+
+  // Copy the spans so scopes closing meanwhile wait as little as possible
+  std::vector< std::pair< size_t, std::vector< span > > > threads;
+  {
+    registry& reg = registry::instance();
+    std::lock_guard< std::mutex > reg_lock( reg.mutex );
+
+    for ( auto const& trace : reg.threads )
+    {
+      std::lock_guard< std::mutex > lock( trace->mutex );
+      threads.emplace_back( trace->id, trace->spans );
+    }
+  }
+
+  // Times are given relative to the earliest span
+  trace_detail::clock::time_point epoch = trace_detail::clock::time_point::max();
+  for ( auto const& t : threads )
+  {
+    for ( auto const& s : t.second )
+    {
+      epoch = std::min( epoch, s.start );
+    }
+  }
+
+  auto const to_us = []( trace_detail::clock::duration d )
+  {
+    return duration_cast< duration< double, std::micro > >( d ).count();
+  };
+
+  std::ios::fmtflags const flags = stream.flags();
+  std::streamsize const precision = stream.precision();
+  stream << std::fixed << std::setprecision( 3 );
+
+  stream << "{\"traceEvents\":[";
+  bool first = true;
+  for ( auto const& t : threads )
+  {
+    if ( t.second.empty() )
+    {
+      continue;
+    }
+
+    stream << ( first ? "\n" : ",\n" )
+           << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+           << t.first << ",\"args\":{\"name\":\"thread " << t.first << "\"}}";
+    first = false;
+
+    for ( auto const& s : t.second )
+    {
+      stream << ",\n{\"name\":";
+      write_json_string( stream, s.label );
+      stream << ",\"cat\":\"kwiver\",\"ph\":\"X\",\"pid\":1,\"tid\":" << t.first
+             << ",\"ts\":" << to_us( s.start - epoch )
+             << ",\"dur\":" << to_us( s.end - s.start ) << "}";
+    }
+  }
+  stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  stream.flags( flags );
+  stream.precision( precision );
+}
+
+} } // end namespace
@@ -0,0 +1,120 @@
+// This file is part of KWIVER, and is distributed under the
+// OSI-approved BSD 3-Clause License. See top-level LICENSE file or
+// https://github.com/Kitware/kwiver/blob/master/LICENSE for details.
+
+/// \file
+/// \brief Lightweight scoped tracing of algorithm stages
+
+#ifndef KWIVER_VITAL_UTIL_TRACE_H
+#define KWIVER_VITAL_UTIL_TRACE_H
+
+#include <vital/util/vital_util_export.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace kwiver {
+namespace vital {
+
+/// \defgroup trace Scoped tracing
+///
+/// Code marks the stages it wants to see in a trace with a scope:
+///
+/// \code
+/// void detect_features::detect( ... ) const
+/// {
+///   KWIVER_TRACE_SCOPE( "ocv::detect_features" );
+///   ...
+///   {
+///     KWIVER_TRACE_SCOPE( "ocv::detect_features::convert" );
+///     ...
+///   }
+/// }
+/// \endcode
+///
+/// While tracing is off (the default) a scope costs one relaxed atomic
+/// load. While it is on, each scope records its label, start time and
+/// duration in a ring of the most recent spans kept by the calling
+/// thread; nested scopes show up nested in the trace. Labels must be
+/// string literals or otherwise outlive the trace.
+///
+/// write_trace() writes all threads' spans in the Chrome trace event
+/// JSON format, which chrome://tracing and https://ui.perfetto.dev can
+/// display. pipeline_runner does this with its --trace option; tracing
+/// is also turned on at startup if the environment variable
+/// KWIVER_TRACE is set.
+/// @{
+
+/// Turn recording of trace scopes on or off
+VITAL_UTIL_EXPORT void set_trace_enabled( bool enabled );
+
+/// Discard all recorded spans
+VITAL_UTIL_EXPORT void clear_trace();
+
+/// Write recorded spans as Chrome trace event JSON
+VITAL_UTIL_EXPORT void write_trace( std::ostream& stream );
+
+namespace trace_detail {
+
+typedef std::chrono::steady_clock clock;
+
+extern VITAL_UTIL_EXPORT std::atomic< bool > enabled;
+
+VITAL_UTIL_EXPORT void record( char const* label,
+                               clock::time_point start,
+                               clock::time_point end );
+
+} // namespace trace_detail
+
+/// Check if trace scopes are being recorded
+inline bool
+trace_enabled()
+{
+  return trace_detail::enabled.load( std::memory_order_relaxed );
+}
+
+// ----------------------------------------------------------------------------
+/// Record the time from construction to destruction as a trace span
+class trace_scope
+{
+public:
+  explicit trace_scope( char const* label )
+    : m_label( trace_enabled() ? label : nullptr )
+  {
+    if ( m_label )
+    {
+      m_start = trace_detail::clock::now();
+    }
+  }
+
+  ~trace_scope()
+  {
+    if ( m_label )
+    {
+      trace_detail::record( m_label, m_start, trace_detail::clock::now() );
+    }
+  }
+
+  trace_scope( trace_scope const& ) = delete;
+  trace_scope& operator=( trace_scope const& ) = delete;
+
+private:
+  char const* const m_label;
+  trace_detail::clock::time_point m_start;
+};
+
+#define KWIVER_TRACE_CONCAT_I( a, b ) a ## b
+#define KWIVER_TRACE_CONCAT( a, b ) KWIVER_TRACE_CONCAT_I( a, b )
+
+/// Trace the rest of the enclosing scope under \p label
+#define KWIVER_TRACE_SCOPE( label )                                     \
+  ::kwiver::vital::trace_scope                                          \
+  KWIVER_TRACE_CONCAT( _kwiver_trace_scope_, __LINE__ )( label )
+
+/// @}
+
+} } // end namespace
+
+#endif
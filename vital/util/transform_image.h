@@ -10,10 +10,83 @@
 
 #include <vital/types/image.h>
 #include <cstdlib>
+#include <type_traits>
 
 namespace kwiver {
 namespace vital {
 
+namespace detail {
+
+/// Find the position of the width, height and depth in memory order
+///
+/// \param img Image whose memory order is used
+/// \param dim_idx Positions of the width, height and depth, where [0] has
+///                the smallest distance between values and [2] the greatest
+inline void dimension_order( image const& img, size_t dim_idx[3] )
+{
+  bool wBh = std::abs(img.w_step()) < std::abs(img.h_step()),
+       dBh = std::abs(img.d_step()) < std::abs(img.h_step()),
+       dBw = std::abs(img.d_step()) < std::abs(img.w_step());
+  dim_idx[0] = static_cast<size_t>( ! wBh ) + static_cast<size_t>(dBw);
+  dim_idx[1] = static_cast<size_t>(wBh) + static_cast<size_t>(dBh);
+  dim_idx[2] = static_cast<size_t>( ! dBw ) + static_cast<size_t>( ! dBh );
+}
+
+/// Order the sizes and steps of an image from smallest to largest step
+inline void traversal_order( image const& img,
+                             size_t side_len[3], ptrdiff_t step_size[3] )
+{
+  size_t dim_idx[3];
+  dimension_order( img, dim_idx );
+
+  side_len[dim_idx[0]] = img.width();
+  side_len[dim_idx[1]] = img.height();
+  side_len[dim_idx[2]] = img.depth();
+  step_size[dim_idx[0]] = img.w_step();
+  step_size[dim_idx[1]] = img.h_step();
+  step_size[dim_idx[2]] = img.d_step();
+}
+
+/// Order the steps of two images by the memory order of the first
+///
+/// \p other_step receives the steps of \p other in the same order.
+inline void traversal_order( image const& img,
+                             size_t side_len[3], ptrdiff_t step_size[3],
+                             image const& other, ptrdiff_t other_step[3] )
+{
+  size_t dim_idx[3];
+  dimension_order( img, dim_idx );
+
+  traversal_order( img, side_len, step_size );
+  other_step[dim_idx[0]] = other.w_step();
+  other_step[dim_idx[1]] = other.h_step();
+  other_step[dim_idx[2]] = other.d_step();
+}
+
+/// Apply a unary function in place to \p count values at unit stride
+///
+/// The loop has no strides so that the compiler can vectorize it.
+template <typename T, typename OP>
+inline void transform_span( T* data, size_t count, OP& op )
+{
+  for ( size_t i = 0; i < count; ++i )
+  {
+    data[i] = op( data[i] );
+  }
+}
+
+/// Apply a unary function to \p count values at unit stride
+template <typename T1, typename T2, typename OP>
+inline void transform_span( T1 const* in, T2* out, size_t count, OP& op )
+{
+  for ( size_t i = 0; i < count; ++i )
+  {
+    out[i] = op( in[i] );
+  }
+}
+
+} // end namespace detail
+
 /// Transform a given image in place given a unary function
 ///
 /// Apply a given unary function to all pixels in the image. This is guarateed
@@ -50,24 +123,17 @@ namespace vital {
 template <typename T, typename OP>
 void transform_image( image_of<T>& img, OP op )
 {
-  // determine which order to traverse dimensions
-  // [0] -> smalled distance between values
-  // [2] -> greatest distance between values
+  // contiguous memory is traversed as one flat array
+  if ( img.is_contiguous() )
+  {
+    detail::transform_span( img.first_pixel(),
+                            img.width() * img.height() * img.depth(), op );
+    return;
+  }
+
   size_t side_len[3];
   ptrdiff_t step_size[3];
-  bool wBh = std::abs(img.w_step()) < std::abs(img.h_step()),
-       dBh = std::abs(img.d_step()) < std::abs(img.h_step()),
-       dBw = std::abs(img.d_step()) < std::abs(img.w_step());
-  size_t w_idx = static_cast<size_t>( ! wBh ) + static_cast<size_t>(dBw),
-         h_idx = static_cast<size_t>(wBh) + static_cast<size_t>(dBh),
-         d_idx = static_cast<size_t>( ! dBw ) + static_cast<size_t>( ! dBh );
-
-  side_len[w_idx] = img.width();
-  side_len[h_idx] = img.height();
-  side_len[d_idx] = img.depth();
-  step_size[w_idx] = img.w_step();
-  step_size[h_idx] = img.h_step();
-  step_size[d_idx] = img.d_step();
+  detail::traversal_order( img, side_len, step_size );
 
   // position index with a dimension
   unsigned i0, i1, i2;
@@ -80,6 +146,11 @@ void transform_image( image_of<T>& img, OP op )
     d1_s = d2_s;
     for ( i1 = 0; i1 < side_len[1]; ++i1, d1_s += step_size[1] )
     {
+      if ( step_size[0] == 1 )
+      {
+        detail::transform_span( d1_s, side_len[0], op );
+        continue;
+      }
       d0_s = d1_s;
       for ( i0 = 0; i0 < side_len[0]; ++i0, d0_s += step_size[0] )
       {
@@ -98,27 +169,50 @@ void transform_image( image_of<T>& img, OP op )
 template <typename T1, typename T2, typename OP>
 void transform_image( image_of<T1> const& img_in, image_of<T2>& img_out, OP op )
 {
-  const unsigned width = static_cast<unsigned int>(img_in.width());
-  const unsigned height = static_cast<unsigned int>(img_in.height());
-  const unsigned depth = static_cast<unsigned int>(img_in.depth());
-
   // make sure the output image has the same size as the input image
-  img_out.set_size(width, height, depth);
+  img_out.set_size( img_in.width(), img_in.height(), img_in.depth() );
+
+  // contiguous images with the same layout are traversed as flat arrays
+  if ( img_in.w_step() == img_out.w_step() &&
+       img_in.h_step() == img_out.h_step() &&
+       img_in.d_step() == img_out.d_step() &&
+       img_out.is_contiguous() )
+  {
+    detail::transform_span( img_in.first_pixel(), img_out.first_pixel(),
+                            img_in.width() * img_in.height() * img_in.depth(),
+                            op );
+    return;
+  }
+
+  // traverse in the memory order of the output image
+  size_t side_len[3];
+  ptrdiff_t step_size[3];
+  ptrdiff_t in_step[3];
+  detail::traversal_order( img_out, side_len, step_size, img_in, in_step );
+
   // Pointers to the first pixel of the current dimension iteration
   T1 const* d0_i, * d1_i, * d2_i;
   T2* d0_o, * d1_o, * d2_o;
 
   d2_i = img_in.first_pixel();
   d2_o = img_out.first_pixel();
-  for ( unsigned i2 = 0; i2 < depth; ++i2, d2_i += img_in.d_step(), d2_o += img_out.d_step() )
+  for ( unsigned i2 = 0; i2 < side_len[2];
+        ++i2, d2_i += in_step[2], d2_o += step_size[2] )
   {
     d1_i = d2_i;
     d1_o = d2_o;
-    for ( unsigned i1 = 0; i1 < height; ++i1, d1_i += img_in.h_step(), d1_o += img_out.h_step() )
+    for ( unsigned i1 = 0; i1 < side_len[1];
+          ++i1, d1_i += in_step[1], d1_o += step_size[1] )
     {
+      if ( in_step[0] == 1 && step_size[0] == 1 )
+      {
+        detail::transform_span( d1_i, d1_o, side_len[0], op );
+        continue;
+      }
       d0_i = d1_i;
       d0_o = d1_o;
-      for ( unsigned i0 = 0; i0 < width; ++i0, d0_i += img_in.w_step(), d0_o += img_out.w_step() )
+      for ( unsigned i0 = 0; i0 < side_len[0];
+            ++i0, d0_i += in_step[0], d0_o += step_size[0] )
       {
         *d0_o = op( *d0_i );
       }
@@ -140,11 +234,38 @@ struct cast_pixel<T1, bool>
   bool operator () (T1 const& v) const { return v != T1(0); }
 };
 
+namespace detail {
+
+/// Cast between pixel types of different traits
+template <typename T1, typename T2>
+void cast_image( image_of<T1> const& img_in, image_of<T2>& img_out,
+                 std::false_type )
+{
+  transform_image(img_in, img_out, cast_pixel<T1,T2>());
+}
+
+/// Cast between pixel types of the same traits, which is a plain copy
+template <typename T1, typename T2>
+void cast_image( image_of<T1> const& img_in, image_of<T2>& img_out,
+                 std::true_type )
+{
+  img_out.copy_from(img_in);
+}
+
+} // end namespace detail
+
 /// Static cast an image of one type to that of another type
+///
+/// Types with the same pixel traits are copied without converting each
+/// value.
 template <typename T1, typename T2>
 void cast_image( image_of<T1> const& img_in, image_of<T2>& img_out )
 {
-  transform_image(img_in, img_out, cast_pixel<T1,T2>());
+  using same_traits = std::integral_constant<bool,
+    image_pixel_traits_of<T1>::static_type ==
+      image_pixel_traits_of<T2>::static_type &&
+    sizeof(T1) == sizeof(T2)>;
+  detail::cast_image(img_in, img_out, same_traits());
 }
 
 /// Static cast an image of unknown type to a known type
@@ -204,24 +325,9 @@ void cast_image( image const& img_in, image_of<T>& img_out )
 template <typename T, typename OP>
 void foreach_pixel( image_of<T> const& img, OP op )
 {
-  // determine which order to traverse dimensions
-  // [0] -> smalled distance between values
-  // [2] -> greatest distance between values
   size_t side_len[3];
   ptrdiff_t step_size[3];
-  bool wBh = std::abs(img.w_step()) < std::abs(img.h_step()),
-       dBh = std::abs(img.d_step()) < std::abs(img.h_step()),
-       dBw = std::abs(img.d_step()) < std::abs(img.w_step());
-  size_t w_idx = static_cast<size_t>( ! wBh ) + static_cast<size_t>(dBw),
-         h_idx = static_cast<size_t>(wBh) + static_cast<size_t>(dBh),
-         d_idx = static_cast<size_t>( ! dBw ) + static_cast<size_t>( ! dBh );
-
-  side_len[w_idx] = img.width();
-  side_len[h_idx] = img.height();
-  side_len[d_idx] = img.depth();
-  step_size[w_idx] = img.w_step();
-  step_size[h_idx] = img.h_step();
-  step_size[d_idx] = img.d_step();
+  detail::traversal_order( img, side_len, step_size );
 
   // position index with a dimension
   unsigned i0, i1, i2;